@@ -23,7 +23,7 @@ import os
 import string
 import sys
 import textwrap
-from typing import cast, List, Mapping, Union
+from typing import cast, Dict, List, Mapping, Union
 
 from . import ast
 from . import bson
@@ -957,6 +957,7 @@ class _CppSourceFileWriter(_CppFileWriterBase):
         cpp_type = cpp_type_info.get_type_name()
 
         self._writer.write_line('std::vector<%s> values;' % (cpp_type))
+        self._writer.write_line('values.reserve(sequence.objs.size());')
         self._writer.write_empty_line()
 
         # TODO: add support for sequence length checks, today we allow an empty document sequence
@@ -1100,39 +1101,55 @@ class _CppSourceFileWriter(_CppFileWriterBase):
             field_usage_check.add_store("fieldName")
             self._writer.write_empty_line()
 
-            first_field = True
+            # Dispatch on the length of the field name first, so that each field name is only
+            # compared against the known fields of the same length.
+            fields_by_length = {}  # type: Dict[int, List[ast.Field]]
             for field in struct.fields:
                 # Do not parse chained fields as fields since they are actually chained types.
                 if field.chained and not field.chained_struct_field:
                     continue
 
-                field_predicate = 'fieldName == %s' % (_get_field_constant_name(field))
+                fields_by_length.setdefault(len(field.name), []).append(field)
 
-                with self._predicate(field_predicate, not first_field):
+            if fields_by_length:
+                with self._block('switch (fieldName.size()) {', '}'):
+                    for length in sorted(fields_by_length):
+                        with self._block('case %d: {' % (length), '}'):
+                            first_field = True
+                            for field in fields_by_length[length]:
+                                field_predicate = 'fieldName == %s' % (
+                                    _get_field_constant_name(field))
 
-                    if field.ignore:
-                        field_usage_check.add(field, "element")
+                                with self._predicate(field_predicate, not first_field):
 
-                        self._writer.write_line('// ignore field')
-                    else:
-                        self.gen_field_deserializer(field, bson_object, "element",
-                                                    field_usage_check)
+                                    if field.ignore:
+                                        field_usage_check.add(field, "element")
+
+                                        self._writer.write_line('// ignore field')
+                                    else:
+                                        self.gen_field_deserializer(field, bson_object, "element",
+                                                                    field_usage_check)
+
+                                    self._writer.write_line('continue;')
+
+                                first_field = False
 
-                if first_field:
-                    first_field = False
+                            self._writer.write_line('break;')
 
             # End of for fields
-            # Generate strict check for extranous fields
+            # Generate strict check for extranous fields, which only fields that matched none of
+            # the known fields above reach
             if struct.strict:
-                with self._block('else {', '}'):
-                    # For commands, check if this a well known command field that the IDL parser
-                    # should ignore regardless of strict mode.
-                    command_predicate = None
-                    if isinstance(struct, ast.Command):
-                        command_predicate = "!mongo::isGenericArgument(fieldName)"
+                self._writer.write_empty_line()
+
+                # For commands, check if this a well known command field that the IDL parser
+                # should ignore regardless of strict mode.
+                command_predicate = None
+                if isinstance(struct, ast.Command):
+                    command_predicate = "!mongo::isGenericArgument(fieldName)"
 
-                    with self._predicate(command_predicate):
-                        self._writer.write_line('ctxt.throwUnknownField(fieldName);')
+                with self._predicate(command_predicate):
+                    self._writer.write_line('ctxt.throwUnknownField(fieldName);')
 
         # Parse chained structs if not inlined
         # Parse chained types always here
@@ -0,0 +1,71 @@
+/**
+ * Tests the $approxCountDistinct and $approxPercentile accumulators, which return exact results for
+ * small groups, and estimates within a small error for large ones.
+ */
+(function() {
+    "use strict";
+    const coll = db.approx_accumulators;
+
+    coll.drop();
+
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 10000; i++) {
+        bulk.insert({small: i % 2, user: i % 5000, latency: i, tiny: i % 5});
+    }
+    assert.writeOK(bulk.execute());
+
+    // Small groups are counted and interpolated exactly.
+    let results = coll.aggregate([
+                          {$match: {user: {$lt: 5}}},
+                          {
+                            $group: {
+                                _id: null,
+                                users: {$approxCountDistinct: "$user"},
+                                median: {$approxPercentile: {input: "$tiny", p: 0.5}},
+                                bounds: {$approxPercentile: {input: "$tiny", p: [0, 1]}}
+                            }
+                          }
+                      ])
+                      .toArray();
+    assert.eq(1, results.length, tojson(results));
+    assert.eq(5, results[0].users, tojson(results));
+    assert.eq(2, results[0].median, tojson(results));
+    assert.eq([0, 4], results[0].bounds, tojson(results));
+
+    // Large groups are estimated.
+    results = coll.aggregate([{
+                                 $group: {
+                                     _id: "$small",
+                                     users: {$approxCountDistinct: "$user"},
+                                     p99: {$approxPercentile: {input: "$latency", p: 0.99}}
+                                 }
+                             }])
+                  .toArray();
+    assert.eq(2, results.length, tojson(results));
+    for (let result of results) {
+        assert.lt(Math.abs(result.users - 2500), 75, tojson(result));
+        assert.lt(Math.abs(result.p99 - 9900), 50, tojson(result));
+    }
+
+    // The percentiles must be valid and the same for every document of a group.
+    assert.commandFailedWithCode(
+        db.runCommand({
+            aggregate: coll.getName(),
+            pipeline: [{$group: {_id: null, p: {$approxPercentile: {input: "$latency", p: 2}}}}],
+            cursor: {}
+        }),
+        51536);
+    assert.commandFailedWithCode(
+        db.runCommand({
+            aggregate: coll.getName(),
+            pipeline: [{$group: {_id: null, p: {$approxPercentile: {input: "$latency", p: "$x"}}}}],
+            cursor: {}
+        }),
+        51536);
+    assert.commandFailedWithCode(db.runCommand({
+        aggregate: coll.getName(),
+        pipeline: [{$group: {_id: null, p: {$approxPercentile: "$latency"}}}],
+        cursor: {}
+    }),
+                                 51534);
+}());
@@ -60,6 +60,11 @@
 
     assertErrorCode(coll, pipeline, ErrorCodes.DuplicateKey);
 
+    // The indexes are built once all of the documents have been written, and the output
+    // collection is left untouched if that fails.
+    assert.eq(0, targetColl.find().itcount());
+    assert.eq(2, targetColl.getIndexes().length);
+
     // Rerun a similar test, except populate the target collection with a document that conflics
     // with one out of the pipeline. In this case, there is no unique key violation since the target
     // collection will be dropped before renaming the source collection.
@@ -72,6 +77,23 @@
     assert.eq(1, targetColl.find().itcount());
     assert.eq(2, targetColl.getIndexes().length);
 
+    //
+    // Test that the indexes built after writing many documents to the temp collection are usable.
+    //
+    coll.drop();
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 1000; i++) {
+        bulk.insert({_id: i, a: i % 10, b: i});
+    }
+    assert.writeOK(bulk.execute());
+    targetColl.drop();
+    assert.commandWorked(targetColl.createIndex({a: 1, b: -1}));
+
+    coll.aggregate(pipeline);
+    assert.eq(1000, targetColl.find().itcount());
+    assert.eq(100, targetColl.find({a: 3}).hint({a: 1, b: -1}).itcount());
+    assert.eq(2, targetColl.getIndexes().length);
+
     //
     // Test that an $out aggregation succeeds even if the _id is stripped out and the "uniqueKey"
     // is the document key.
@@ -0,0 +1,44 @@
+// Tests that a $project at the front of the pipeline which only includes or excludes fields is
+// applied by the $cursor stage to the documents returned by the query system, and that it produces
+// the same results as when it is run as a pipeline stage.
+// @tags: [do_not_wrap_aggregations_in_facets]
+(function() {
+    "use strict";
+
+    load("jstests/aggregation/extras/utils.js");  // For arrayEq.
+
+    const coll = db.project_applied_by_cursor;
+    coll.drop();
+
+    assert.writeOK(coll.insert({_id: 0, a: [1, {b: 2, c: 3}, [{b: 4, c: 5}], {d: 6}], c: 7}));
+    assert.writeOK(coll.insert({_id: 1, a: {b: 8, c: 9}, c: {d: 10}, e: "x"}));
+    assert.writeOK(coll.insert({_id: 2, a: 11, e: "y"}));
+
+    /**
+     * Runs 'projection' as the first stage after a $match, and checks that it is applied by the
+     * $cursor stage when the collection is not sharded. Its results must match those of the same
+     * projection placed after a stage which prevents it from being pushed down.
+     */
+    function assertProjectionAppliedByCursor(projection) {
+        const pipeline = [{$match: {_id: {$gte: 0}}}, {$project: projection}, {$addFields: {z: 1}}];
+        const explain = coll.explain().aggregate(pipeline);
+        if (!explain.hasOwnProperty("shards")) {
+            assert(explain.stages[0].$cursor.hasOwnProperty("projection"), tojson(explain));
+            assert(!explain.stages.some((stage) => stage.hasOwnProperty("$project")),
+                   tojson(explain));
+        }
+
+        const unpushedPipeline =
+            [{$match: {_id: {$gte: 0}}}, {$addFields: {z: 1}}, {$project: projection}];
+        const expected = coll.aggregate(unpushedPipeline).toArray().map((doc) => {
+            doc.z = 1;
+            return doc;
+        });
+        assert(arrayEq(expected, coll.aggregate(pipeline).toArray()));
+    }
+
+    assertProjectionAppliedByCursor({"a.b": false, c: false});
+    assertProjectionAppliedByCursor({e: false});
+    assertProjectionAppliedByCursor({_id: true, "a.b": true, c: true});
+    assertProjectionAppliedByCursor({_id: false, "c.d": true, e: true});
+}());
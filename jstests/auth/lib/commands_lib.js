@@ -1403,6 +1403,30 @@ var authCommandsLib = {
               },
           ]
         },
+        {
+          testname: "aggregate_opSamples",
+          command: {aggregate: 1, pipeline: [{$opSamples: {}}], cursor: {}},
+          skipSharded: true,
+          testcases: [
+              {
+                runOnDb: adminDbName,
+                roles: roles_monitoring,
+                privileges: [{resource: {cluster: true}, actions: ["inprog"]}]
+              },
+          ]
+        },
+        {
+          testname: "aggregate_queryShapeStats",
+          command: {aggregate: 1, pipeline: [{$queryShapeStats: {}}], cursor: {}},
+          skipSharded: true,
+          testcases: [
+              {
+                runOnDb: adminDbName,
+                roles: roles_monitoring,
+                privileges: [{resource: {cluster: true}, actions: ["top"]}]
+              },
+          ]
+        },
         {
           testname: "aggregate_currentOp_allUsers_true",
           command: {aggregate: 1, pipeline: [{$currentOp: {allUsers: true}}], cursor: {}},
@@ -0,0 +1,83 @@
+// Tests that a client may start a SASL conversation as part of isMaster, and continue it with
+// saslContinue without running saslStart.
+// @tags: [requires_sharding]
+(function() {
+    "use strict";
+
+    // client-first-message for users 'admin' and 'nobody', and a client-final-message with a
+    // bogus proof, encoded in base64.
+    const kAdminFirstMessage = "biwsbj1hZG1pbixyPWMzQmxZM1ZzWVhScGRtVnViMjVqWlE9PQ==";
+    const kNobodyFirstMessage = "biwsbj1ub2JvZHkscj1jM0JsWTNWc1lYUnBkbVZ1YjI1alpRPT0=";
+    const kBogusFinalMessage = "Yz1iaXdzLHI9YzNCbFkzVnNZWFJwZG1WdWIyNWpaUT09LHA9QUFBQQ==";
+
+    function speculativeIsMaster(conn, firstMessage) {
+        return conn.getDB("admin").runCommand({
+            isMaster: 1,
+            speculativeAuthenticate: {
+                saslStart: 1,
+                mechanism: "SCRAM-SHA-256",
+                payload: BinData(0, firstMessage),
+                db: "admin"
+            }
+        });
+    }
+
+    function runTest(conn) {
+        const admin = conn.getDB("admin");
+        assert.commandWorked(admin.runCommand(
+            {createUser: "admin", pwd: "pwd", roles: ["root"], mechanisms: ["SCRAM-SHA-256"]}));
+
+        // The first step of the conversation is returned along with isMaster.
+        let other = new Mongo(conn.host);
+        let res = assert.commandWorked(speculativeIsMaster(other, kAdminFirstMessage));
+        assert(res.ismaster, tojson(res));
+        assert.eq(1, res.speculativeAuthenticate.conversationId, tojson(res));
+        assert.eq(false, res.speculativeAuthenticate.done, tojson(res));
+        assert(res.speculativeAuthenticate.hasOwnProperty("payload"), tojson(res));
+
+        // The conversation continues with saslContinue, which verifies the proof.
+        assert.commandFailedWithCode(other.getDB("admin").runCommand({
+            saslContinue: 1,
+            conversationId: 1,
+            payload: BinData(0, kBogusFinalMessage)
+        }),
+                                     ErrorCodes.AuthenticationFailed);
+
+        // Without a speculative start, there is no conversation to continue.
+        other = new Mongo(conn.host);
+        assert.commandFailedWithCode(other.getDB("admin").runCommand({
+            saslContinue: 1,
+            conversationId: 1,
+            payload: BinData(0, kBogusFinalMessage)
+        }),
+                                     ErrorCodes.ProtocolError);
+
+        // Failing to start the conversation does not fail isMaster.
+        res = assert.commandWorked(speculativeIsMaster(other, kNobodyFirstMessage));
+        assert(res.ismaster, tojson(res));
+        assert.eq(undefined, res.speculativeAuthenticate, tojson(res));
+
+        // Only saslStart may be run speculatively.
+        assert.commandFailedWithCode(admin.runCommand({
+            isMaster: 1,
+            speculativeAuthenticate:
+                {saslContinue: 1, conversationId: 1, payload: BinData(0, kBogusFinalMessage)}
+        }),
+                                     ErrorCodes.BadValue);
+
+        // Authenticating normally, which skips the empty final SCRAM exchange, still works.
+        other = new Mongo(conn.host);
+        assert(other.getDB("admin").auth("admin", "pwd"));
+        assert.commandWorked(other.getDB("test").runCommand({find: "foo"}));
+    }
+
+    // Test standalone.
+    const m = MongoRunner.runMongod({auth: ""});
+    runTest(m);
+    MongoRunner.stopMongod(m);
+
+    // Test mongos.
+    const st = new ShardingTest({shards: 1, mongos: 1, config: 1, keyFile: "jstests/libs/key1"});
+    runTest(st.s0);
+    st.stop();
+})();
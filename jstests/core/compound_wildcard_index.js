@@ -0,0 +1,62 @@
+/**
+ * Tests that a compound wildcard index, whose regular fields precede the wildcard field, returns
+ * correct results and bounds its scans on those regular fields.
+ */
+(function() {
+    "use strict";
+
+    load("jstests/aggregation/extras/utils.js");  // For arrayEq.
+    load("jstests/libs/analyze_plan.js");         // For getPlanStages.
+
+    const assertArrayEq = (l, r) => assert(arrayEq(l, r), tojson(l) + " != " + tojson(r));
+
+    const coll = db.compound_wildcard_index;
+    coll.drop();
+
+    const kIndexKey = {tenantId: 1, "attrs.$**": 1};
+    assert.commandWorked(coll.createIndex(kIndexKey));
+
+    for (let tenantId = 0; tenantId < 10; ++tenantId) {
+        for (let i = 0; i < 20; ++i) {
+            assert.writeOK(coll.insert(
+                {tenantId: tenantId, attrs: {color: (i % 2 ? "red" : "blue"), size: [i, i + 1]}}));
+        }
+    }
+    assert.writeOK(coll.insert({attrs: {color: "red"}}));
+
+    function assertUsesIndexWithTenantBounds(query, tenantBounds) {
+        const explain = assert.commandWorked(coll.find(query).explain());
+        const ixScans = getPlanStages(explain.queryPlanner.winningPlan, "IXSCAN");
+        assert.eq(1, ixScans.length, tojson(explain));
+        assert.eq(ixScans[0].keyPattern.tenantId, 1, tojson(ixScans[0]));
+        assert.eq(ixScans[0].indexBounds.tenantId, tenantBounds, tojson(ixScans[0]));
+    }
+
+    // Queries on the regular field and a wildcard path are bounded on both.
+    let query = {tenantId: 3, "attrs.color": "red"};
+    assertUsesIndexWithTenantBounds(query, ["[3.0, 3.0]"]);
+    assertArrayEq(coll.find(query).hint(kIndexKey).toArray(),
+                  coll.find(query).hint({$natural: 1}).toArray());
+    assert.eq(10, coll.find(query).itcount());
+
+    query = {tenantId: {$in: [1, 2]}, "attrs.size": {$gte: 19}};
+    assertUsesIndexWithTenantBounds(query, ["[1.0, 1.0]", "[2.0, 2.0]"]);
+    assertArrayEq(coll.find(query).toArray(), coll.find(query).hint({$natural: 1}).toArray());
+    assert.eq(4, coll.find(query).itcount());
+
+    // Without a predicate on the regular field, the scan spans all of its values, including the
+    // null that is stored when it is missing.
+    query = {"attrs.color": "red"};
+    assertUsesIndexWithTenantBounds(query, ["[MinKey, MaxKey]"]);
+    assert.eq(101, coll.find(query).itcount());
+    assert.eq(1, coll.find({tenantId: null, "attrs.color": "red"}).itcount());
+
+    // A query on the regular field alone cannot use the index.
+    const explain = assert.commandWorked(coll.find({tenantId: 3}).explain());
+    assert(isCollscan(db, explain.queryPlanner.winningPlan), tojson(explain));
+
+    // The regular fields of a compound wildcard index may not be arrays.
+    assert.writeErrorWithCode(coll.insert({tenantId: [1, 2], attrs: {color: "red"}}), 51533);
+    assert.writeErrorWithCode(coll.insert({tenantId: [], attrs: {color: "red"}}), 51533);
+    assert.eq(0, coll.find({tenantId: {$type: "array"}}).itcount());
+})();
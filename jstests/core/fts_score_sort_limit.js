@@ -0,0 +1,65 @@
+// Tests that sorting $text results by text score with a limit returns the best scoring documents,
+// and that only the documents which can be among them are fetched.
+(function() {
+    "use strict";
+
+    const coll = db.fts_score_sort_limit;
+    coll.drop();
+
+    // Many documents mention "common" once, a few mention it more often and so score higher.
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 300; i++) {
+        bulk.insert({_id: i, a: "common filler text number " + i + (i % 7 === 0 ? " rare" : "")});
+    }
+    for (let i = 0; i < 5; i++) {
+        bulk.insert({_id: 1000 + i, a: "common " + "common ".repeat(i + 1) + "rare"});
+    }
+    assert.writeOK(bulk.execute());
+    assert.commandWorked(coll.createIndex({a: "text"}));
+
+    function scores(cursor) {
+        return cursor.toArray().map(doc => doc.score);
+    }
+
+    function sortedByScore(search) {
+        return coll.find({$text: {$search: search}}, {score: {$meta: "textScore"}}).sort({
+            score: {$meta: "textScore"}
+        });
+    }
+
+    function textOrStages(stage) {
+        if (!stage) {
+            return [];
+        }
+        if (stage.stage === "TEXT_OR") {
+            return [stage];
+        }
+        let found = textOrStages(stage.inputStage);
+        (stage.inputStages || []).forEach(child => found = found.concat(textOrStages(child)));
+        (stage.shards || [])
+            .forEach(shard => found = found.concat(textOrStages(shard.executionStages)));
+        return found;
+    }
+
+    ["common", "common rare", "rare filler", "common number 17"].forEach(function(search) {
+        const all = scores(sortedByScore(search));
+        [1, 3, 10].forEach(function(limit) {
+            assert.eq(all.slice(0, limit), scores(sortedByScore(search).limit(limit)), search);
+            assert.eq(all.slice(2, 2 + limit),
+                      scores(sortedByScore(search).skip(2).limit(limit)),
+                      search);
+        });
+    });
+
+    // With a single term, reading stops as soon as the limit is reached.
+    const explain = sortedByScore("common").limit(3).explain("executionStats");
+    const stages = textOrStages(explain.executionStats.executionStages);
+    assert.gt(stages.length, 0, tojson(explain));
+    stages.forEach(stage => assert.lte(stage.fetches, 3, tojson(explain)));
+
+    // Negated terms and phrases are filtered after scoring, so every match is still scored.
+    assert.eq(scores(sortedByScore("common -filler")).slice(0, 2),
+              scores(sortedByScore("common -filler").limit(2)));
+    assert.eq(scores(sortedByScore("\"common common\"")).slice(0, 2),
+              scores(sortedByScore("\"common common\"").limit(2)));
+})();
@@ -0,0 +1,60 @@
+// Tests that a 2dsphere $geoNear over a dense cluster surrounded by sparse points returns every
+// document exactly once and in order, while the search annuli adapt to the changing density and
+// skip the coarse cells that earlier annuli already scanned.
+// @tags: [requires_getmore]
+(function() {
+    "use strict";
+
+    const coll = db.geo_s2near_dense_cluster;
+    coll.drop();
+
+    const bulk = coll.initializeUnorderedBulkOp();
+    let numDocs = 0;
+    // A dense cluster of points around the origin.
+    for (let i = 0; i < 40; i++) {
+        for (let j = 0; j < 40; j++) {
+            bulk.insert({geo: {type: "Point", coordinates: [i * 0.0005, j * 0.0005]}});
+            numDocs++;
+        }
+    }
+    // Sparse points much further away.
+    for (let i = 1; i <= 40; i++) {
+        bulk.insert({geo: {type: "Point", coordinates: [i, -i / 2]}});
+        numDocs++;
+    }
+    // A large polygon, which is indexed by coarse cells shared by many annuli.
+    bulk.insert({
+        geo: {
+            type: "Polygon",
+            coordinates: [[[-5, -5], [-5, -10], [-10, -10], [-10, -5], [-5, -5]]]
+        },
+        polygon: true
+    });
+    numDocs++;
+    assert.writeOK(bulk.execute());
+    assert.commandWorked(coll.createIndex({geo: "2dsphere"}));
+
+    const results =
+        coll.aggregate([
+                {
+                  $geoNear: {
+                      near: {type: "Point", coordinates: [0.01, 0.01]},
+                      distanceField: "dist",
+                      spherical: true
+                  }
+                },
+                {$project: {dist: 1, polygon: 1}}
+            ])
+            .toArray();
+
+    assert.eq(numDocs, results.length);
+    const ids = new Set();
+    for (let i = 0; i < results.length; i++) {
+        assert(!ids.has(results[i]._id.str), tojson(results[i]));
+        ids.add(results[i]._id.str);
+        if (i > 0) {
+            assert.lte(results[i - 1].dist, results[i].dist, tojson(results[i]));
+        }
+    }
+    assert.eq(1, results.filter(doc => doc.polygon).length);
+})();
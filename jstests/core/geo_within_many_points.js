@@ -0,0 +1,57 @@
+// Tests that $geoWithin a polygon with many vertices returns the right points once the polygon has
+// been checked against enough points for the server to index it, both with and without a
+// geospatial index.
+(function() {
+    "use strict";
+
+    const coll = db.geo_within_many_points;
+    coll.drop();
+
+    // An approximate circle of radius 1 degree around [10, 10].
+    const kNumVertices = 1000;
+    const ring = [];
+    for (let i = 0; i < kNumVertices; i++) {
+        const angle = 2 * Math.PI * i / kNumVertices;
+        ring.push([10 + Math.cos(angle), 10 + Math.sin(angle)]);
+    }
+    ring.push(ring[0]);
+
+    // Points well inside and well outside of the circle, as well as on the boundary itself.
+    const bulk = coll.initializeUnorderedBulkOp();
+    let numInside = 0;
+    for (let x = -20; x <= 20; x++) {
+        for (let y = -20; y <= 20; y++) {
+            const dist = Math.sqrt(x * x + y * y) / 10;
+            if (Math.abs(dist - 1) < 0.1) {
+                continue;
+            }
+            const inside = dist < 1;
+            numInside += inside ? 1 : 0;
+            bulk.insert({loc: [10 + x / 10, 10 + y / 10], inside: inside});
+        }
+    }
+    for (let i = 0; i < kNumVertices; i += 50) {
+        bulk.insert({loc: ring[i], inside: true, vertex: true});
+        numInside++;
+    }
+    assert.writeOK(bulk.execute());
+
+    function checkWithin(query) {
+        const results = coll.find({loc: {$geoWithin: query}}).toArray();
+        assert.eq(numInside, results.length);
+        results.forEach(doc => assert(doc.inside, tojson(doc)));
+    }
+
+    const geoJSONQuery = {$geometry: {type: "Polygon", coordinates: [ring]}};
+    const legacyQuery = {$polygon: ring.slice(0, kNumVertices)};
+
+    checkWithin(geoJSONQuery);
+    checkWithin(legacyQuery);
+
+    assert.commandWorked(coll.createIndex({loc: "2dsphere"}));
+    checkWithin(geoJSONQuery);
+    assert.commandWorked(coll.dropIndexes());
+
+    assert.commandWorked(coll.createIndex({loc: "2d"}));
+    checkWithin(legacyQuery);
+})();
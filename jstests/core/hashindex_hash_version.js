@@ -0,0 +1,54 @@
+// Tests hashed indexes created with hashVersion 1, which hash keys with MurmurHash3 instead of MD5.
+//
+// @tags: [assumes_no_implicit_index_creation]
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    const coll = db.hashindex_hash_version;
+    coll.drop();
+
+    // Only supported hash versions may be chosen, and only for hashed indexes.
+    assert.commandFailedWithCode(coll.createIndex({a: "hashed"}, {hashVersion: 2}),
+                                 ErrorCodes.CannotCreateIndex);
+    assert.commandFailedWithCode(coll.createIndex({a: "hashed"}, {hashVersion: "1"}),
+                                 ErrorCodes.TypeMismatch);
+    assert.commandFailedWithCode(coll.createIndex({a: 1}, {hashVersion: 1}), ErrorCodes.BadValue);
+
+    assert.commandWorked(coll.createIndex({a: "hashed"}, {hashVersion: 1}));
+    const spec = coll.getIndexes().find(index => index.name === "a_hashed");
+    assert.eq(1, spec.hashVersion, tojson(spec));
+
+    for (let i = 0; i < 20; ++i) {
+        assert.writeOK(coll.insert({_id: i, a: i}));
+    }
+    assert.writeOK(coll.insert({_id: 20, a: 3.1}));
+    assert.writeOK(coll.insert({_id: 21, a: null}));
+    assert.writeOK(coll.insert({_id: 22}));
+    assert.writeOK(coll.insert({_id: 23, a: {b: "str"}}));
+
+    // Point lookups must compute their bounds with the index's hash function.
+    function assertUsesHashedIndex(query, expectedIds) {
+        const results = coll.find(query).hint({a: "hashed"}).toArray().map(doc => doc._id);
+        assert.sameMembers(expectedIds, results, tojson(query));
+
+        const explain = coll.find(query).hint({a: "hashed"}).explain();
+        assert(isIxscan(db, explain.queryPlanner.winningPlan), tojson(explain));
+    }
+
+    assertUsesHashedIndex({a: 3}, [3]);
+    assertUsesHashedIndex({a: 3.1}, [20]);
+    assertUsesHashedIndex({a: {$in: [1, 5, 19, 100]}}, [1, 5, 19]);
+    assertUsesHashedIndex({a: null}, [21, 22]);
+    assertUsesHashedIndex({a: {b: "str"}}, [23]);
+
+    // Updates and removes keep the index in step with the documents.
+    assert.writeOK(coll.update({_id: 3}, {$set: {a: 300}}));
+    assertUsesHashedIndex({a: 3}, []);
+    assertUsesHashedIndex({a: 300}, [3]);
+    assert.writeOK(coll.remove({a: 300}));
+    assertUsesHashedIndex({a: 300}, []);
+
+    assert.commandWorked(coll.validate(true));
+})();
@@ -99,11 +99,20 @@
     assert.commandFailedWithCode(coll.createIndex({"$**": "wildcard"}),
                                  ErrorCodes.CannotCreateIndex);
 
-    // Cannot create a compound wildcard index.
+    // Cannot create a compound wildcard index unless the wildcard field is its only and last field.
     assert.commandFailedWithCode(coll.createIndex({"$**": 1, "a": 1}),
                                  ErrorCodes.CannotCreateIndex);
-    assert.commandFailedWithCode(coll.createIndex({"a": 1, "$**": 1}),
+    assert.commandFailedWithCode(coll.createIndex({"a.$**": 1, "$**": 1}),
                                  ErrorCodes.CannotCreateIndex);
+    assert.commandFailedWithCode(coll.createIndex({"a": -1, "$**": 1}),
+                                 ErrorCodes.CannotCreateIndex);
+    assert.commandWorked(coll.createIndex({"a": 1, "$**": 1}));
+    assert.commandWorked(coll.dropIndex({"a": 1, "$**": 1}));
+
+    // Cannot combine a compound wildcard index with a "wildcardProjection".
+    assert.commandFailedWithCode(
+        createIndexHelper({"a": 1, "$**": 1}, {name: kIndexName, wildcardProjection: {b: 1}}),
+        ErrorCodes.FailedToParse);
 
     // Cannot create an wildcard index with an invalid spec.
     assert.commandFailedWithCode(coll.createIndex({"a.$**.$**": 1}), ErrorCodes.CannotCreateIndex);
@@ -0,0 +1,68 @@
+/**
+ * Tests that a large $in over _id values is answered by a BATCHED_IDHACK stage, which returns the
+ * matching documents whatever the order and duplication of the values, and that smaller or more
+ * complex queries keep being planned.
+ */
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    const conn = MongoRunner.runMongod({setParameter: {internalQueryBatchedIdHackMinKeys: 10}});
+    assert.neq(null, conn, "mongod was unable to start up");
+    const testDB = conn.getDB("test");
+    const coll = testDB.batched_idhack;
+
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 500; i++) {
+        bulk.insert({_id: (i * 37) % 500, a: i});
+    }
+    bulk.insert({_id: "str", a: -1});
+    bulk.insert({_id: {x: 1}, a: -2});
+    assert.writeOK(bulk.execute());
+
+    // Unsorted, duplicated and missing values, of several types.
+    const ids = [];
+    for (let i = 600; i >= 0; i -= 3) {
+        ids.push(i);
+        ids.push(i);
+    }
+    ids.push("str", {x: 1}, "missing", NumberLong(4), 8.0);
+    const kExpected = 167 + 4;
+
+    const explain = coll.find({_id: {$in: ids}}).explain("executionStats");
+    assert(planHasStage(testDB, explain.queryPlanner.winningPlan, "BATCHED_IDHACK"),
+           tojson(explain));
+    assert.eq(kExpected, explain.executionStats.nReturned, tojson(explain));
+    assert.eq(kExpected, explain.executionStats.totalDocsExamined, tojson(explain));
+
+    // The results match those of the regular plan, which the sort forces.
+    const results = coll.find({_id: {$in: ids}}).batchSize(7).toArray();
+    const sortedResults = coll.find({_id: {$in: ids}}).sort({_id: 1}).toArray();
+    assert.eq(kExpected, sortedResults.length);
+    const toSortedStrings = docs => docs.map(doc => tojson(doc)).sort();
+    assert.eq(toSortedStrings(sortedResults), toSortedStrings(results));
+
+    // Projections and returnKey still work.
+    coll.find({_id: {$in: ids}}, {_id: 0, a: 1}).forEach(doc => assert.eq(["a"], Object.keys(doc)));
+    coll.find({_id: {$in: ids}}).returnKey().forEach(doc => assert.eq(["_id"], Object.keys(doc)));
+
+    // Small lists, sorts, limits and additional predicates use the regular plans.
+    for (let cursor of [coll.find({_id: {$in: [1, 2, 3]}}),
+                        coll.find({_id: {$in: ids}}).sort({_id: 1}),
+                        coll.find({_id: {$in: ids}}).limit(5),
+                        coll.find({_id: {$in: ids}, a: {$gte: 0}})]) {
+        const plan = cursor.explain().queryPlanner.winningPlan;
+        assert(!planHasStage(testDB, plan, "BATCHED_IDHACK"), tojson(plan));
+    }
+    assert.eq(5, coll.find({_id: {$in: ids}}).limit(5).itcount());
+
+    // A value of zero disables the stage.
+    assert.commandWorked(
+        testDB.adminCommand({setParameter: 1, internalQueryBatchedIdHackMinKeys: 0}));
+    const plan = coll.find({_id: {$in: ids}}).explain().queryPlanner.winningPlan;
+    assert(!planHasStage(testDB, plan, "BATCHED_IDHACK"), tojson(plan));
+    assert.eq(kExpected, coll.find({_id: {$in: ids}}).itcount());
+
+    MongoRunner.stopMongod(conn);
+}());
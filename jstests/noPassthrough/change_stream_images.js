@@ -0,0 +1,86 @@
+// Tests that a collection created with "recordChangeStreamImages" returns the versions of a
+// document as of each update to change streams, rather than the current version of the document.
+// @tags: [requires_replication, requires_journaling, uses_change_streams]
+(function() {
+    "use strict";
+
+    // For supportsMajorityReadConcern().
+    load("jstests/multiVersion/libs/causal_consistency_helpers.js");
+
+    if (!supportsMajorityReadConcern()) {
+        jsTestLog("Skipping test since storage engine doesn't support majority read concern.");
+        return;
+    }
+
+    const rst = new ReplSetTest({nodes: 1});
+    rst.startSet();
+    rst.initiate();
+
+    const db = rst.getPrimary().getDB("test");
+    const coll = db[jsTestName()];
+    assert.commandWorked(db.createCollection(coll.getName(), {recordChangeStreamImages: true}));
+
+    // The images are kept in a TTL collection on the config database.
+    const indexes = db.getSiblingDB("config").change_stream_images.getIndexes();
+    assert(indexes.some((index) => index.key.wall === 1 && index.expireAfterSeconds > 0),
+           tojson(indexes));
+
+    function updateEvents(spec, numEvents) {
+        const cursor = coll.watch([{$match: {operationType: "update"}}], spec);
+        let events = [];
+        assert.soon(function() {
+            while (cursor.hasNext()) {
+                events.push(cursor.next());
+            }
+            return events.length >= numEvents;
+        });
+        cursor.close();
+        return events;
+    }
+
+    const startAtOperationTime = db.getMongo().getClusterTime().clusterTime;
+    assert.writeOK(coll.insert({_id: 0, a: 0}));
+    assert.writeOK(coll.update({_id: 0}, {$set: {a: 1}}));
+    assert.writeOK(coll.update({_id: 0}, {$set: {a: 2}}));
+
+    // Each update returns the document as of that update, not its current version.
+    let events = updateEvents(
+        {startAtOperationTime: startAtOperationTime, fullDocument: "updateLookup"}, 2);
+    assert.docEq({_id: 0, a: 1}, events[0].fullDocument, tojson(events));
+    assert.docEq({_id: 0, a: 2}, events[1].fullDocument, tojson(events));
+    assert.eq(undefined, events[0].fullDocumentBeforeChange, tojson(events));
+
+    // The version of the document before each update is returned on request.
+    events = updateEvents(
+        {startAtOperationTime: startAtOperationTime, fullDocumentBeforeChange: "whenAvailable"},
+        2);
+    assert.docEq({_id: 0, a: 0}, events[0].fullDocumentBeforeChange, tojson(events));
+    assert.docEq({_id: 0, a: 1}, events[1].fullDocumentBeforeChange, tojson(events));
+    assert.eq(undefined, events[0].fullDocument, tojson(events));
+
+    // The image is still returned after the document is deleted.
+    assert.writeOK(coll.remove({_id: 0}));
+    events = updateEvents(
+        {startAtOperationTime: startAtOperationTime, fullDocument: "updateLookup"}, 2);
+    assert.docEq({_id: 0, a: 2}, events[1].fullDocument, tojson(events));
+
+    // Once recording is turned off, updates fall back to looking up the current version, and
+    // there is no version from before the update.
+    assert.commandWorked(db.runCommand({collMod: coll.getName(), recordChangeStreamImages: false}));
+    const offTime = db.getMongo().getClusterTime().clusterTime;
+    assert.writeOK(coll.insert({_id: 1, a: 0}));
+    assert.writeOK(coll.update({_id: 1}, {$set: {a: 1}}));
+    assert.writeOK(coll.update({_id: 1}, {$set: {a: 2}}));
+    events = updateEvents({
+        startAtOperationTime: offTime,
+        fullDocument: "updateLookup",
+        fullDocumentBeforeChange: "whenAvailable"
+    },
+                          2);
+    assert.docEq({_id: 1, a: 2}, events[0].fullDocument, tojson(events));
+    assert.eq(null, events[0].fullDocumentBeforeChange, tojson(events));
+
+    assert.throws(() => coll.watch([], {fullDocumentBeforeChange: "required"}));
+
+    rst.stopSet();
+}());
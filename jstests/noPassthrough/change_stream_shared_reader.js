@@ -0,0 +1,92 @@
+// Tests that change streams which share an oplog reader each see all the events on their namespace,
+// and that a change stream which falls too far behind the others fails with a resumable error.
+// @tags: [requires_replication, requires_journaling, uses_change_streams]
+(function() {
+    "use strict";
+
+    // For supportsMajorityReadConcern().
+    load("jstests/multiVersion/libs/causal_consistency_helpers.js");
+
+    if (!supportsMajorityReadConcern()) {
+        jsTestLog("Skipping test since storage engine doesn't support majority read concern.");
+        return;
+    }
+
+    const rst = new ReplSetTest(
+        {nodes: 1, nodeOptions: {setParameter: {internalChangeStreamUseSharedReader: true}}});
+    rst.startSet();
+    rst.initiate();
+
+    const db = rst.getPrimary().getDB("test");
+    const coll = db[jsTestName()];
+    assert.commandWorked(db.createCollection(coll.getName()));
+
+    function openStream(spec) {
+        const res = assert.commandWorked(db.runCommand(
+            {aggregate: coll.getName(), pipeline: [{$changeStream: spec || {}}], cursor: {}}));
+        assert.eq(0, res.cursor.firstBatch.length, tojson(res));
+        return res.cursor.id;
+    }
+
+    function getMore(cursorId) {
+        return db.runCommand({getMore: cursorId, collection: coll.getName(), maxTimeMS: 1000});
+    }
+
+    function nextEvents(cursorId, numEvents) {
+        let events = [];
+        assert.soon(function() {
+            events = events.concat(assert.commandWorked(getMore(cursorId)).cursor.nextBatch);
+            return events.length >= numEvents;
+        });
+        assert.eq(numEvents, events.length, tojson(events));
+        return events;
+    }
+
+    // Every change stream sees every event, whichever of them reads it from the oplog.
+    const streams = [openStream(), openStream(), openStream({fullDocument: "updateLookup"})];
+    for (let i = 0; i < 5; ++i) {
+        assert.writeOK(coll.insert({_id: i}));
+    }
+    assert.writeOK(coll.update({_id: 0}, {$set: {updated: true}}));
+    streams.forEach(function(cursorId, streamIndex) {
+        const events = nextEvents(cursorId, 6);
+        events.slice(0, 5).forEach(function(event, i) {
+            assert.eq("insert", event.operationType, tojson(event));
+            assert.eq({_id: i}, event.documentKey, tojson(event));
+        });
+        assert.eq("update", events[5].operationType, tojson(events[5]));
+
+        // The post-image lookup is still done for each change stream individually.
+        assert.eq(streamIndex === 2 ? {_id: 0, updated: true} : undefined,
+                  events[5].fullDocument,
+                  tojson(events[5]));
+    });
+    assert.commandWorked(db.runCommand({killCursors: coll.getName(), cursors: streams}));
+
+    // A change stream which does not keep up with the others loses its subscription.
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalChangeStreamSharedReaderMaxQueuedEvents: 3}));
+    const fast = openStream();
+    const slow = openStream();
+    assert.writeOK(coll.insert({_id: "first"}));
+    const firstEvent = nextEvents(slow, 1)[0];
+    assert.eq("first", firstEvent.documentKey._id, tojson(firstEvent));
+    for (let i = 0; i < 5; ++i) {
+        assert.writeOK(coll.insert({_id: "lag" + i}));
+    }
+    nextEvents(fast, 6);
+    assert.commandFailedWithCode(getMore(slow), ErrorCodes.ChangeStreamSubscriptionLost);
+
+    // The lagging change stream can resume from the last event it saw.
+    const resumed = assert.commandWorked(db.runCommand({
+        aggregate: coll.getName(),
+        pipeline: [{$changeStream: {resumeAfter: firstEvent._id}}],
+        cursor: {}
+    }));
+    const resumedEvents = resumed.cursor.firstBatch.concat(
+        nextEvents(resumed.cursor.id, 5 - resumed.cursor.firstBatch.length));
+    assert.eq(["lag0", "lag1", "lag2", "lag3", "lag4"],
+              resumedEvents.map(event => event.documentKey._id));
+
+    rst.stopSet();
+}());
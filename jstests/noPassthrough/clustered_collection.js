@@ -0,0 +1,50 @@
+/**
+ * Tests that a collection created with "clustered" stores its documents by their integer _id,
+ * rejects other _ids and duplicates, and answers _id queries without consulting the _id index.
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+    "use strict";
+
+    const conn = MongoRunner.runMongod({});
+    assert.neq(null, conn, "mongod was unable to start up");
+    const testDB = conn.getDB("test");
+    const coll = testDB.clustered;
+
+    assert.commandWorked(testDB.createCollection(coll.getName(), {clustered: true}));
+    assert.commandFailedWithCode(
+        testDB.createCollection("cappedClustered", {clustered: true, capped: true, size: 4096}),
+        ErrorCodes.BadValue);
+
+    // Documents are returned in _id order regardless of the order of insertion.
+    for (let i of [5, -3, 100, 0, NumberLong(42), 7.0]) {
+        assert.writeOK(coll.insert({_id: i, x: 1}));
+    }
+    assert.eq([-3, 0, 5, 7, 42, 100], coll.find().toArray().map(doc => Number(doc._id)));
+
+    // Only integral _ids are accepted, and an _id may only be inserted once.
+    assert.writeErrorWithCode(coll.insert({_id: ObjectId()}), ErrorCodes.BadValue);
+    assert.writeErrorWithCode(coll.insert({_id: "str"}), ErrorCodes.BadValue);
+    assert.writeErrorWithCode(coll.insert({_id: 1.5}), ErrorCodes.BadValue);
+    assert.writeErrorWithCode(coll.insert({_id: 5}), ErrorCodes.DuplicateKey);
+    assert.writeErrorWithCode(coll.insert({_id: NumberInt(5)}), ErrorCodes.DuplicateKey);
+    assert.eq(6, coll.find().itcount());
+
+    // An _id lookup reads the document directly.
+    const explain = coll.find({_id: 42}).explain("executionStats");
+    assert.eq(1, explain.executionStats.nReturned, tojson(explain));
+    assert.eq(0, explain.executionStats.totalKeysExamined, tojson(explain));
+    assert.eq(1, explain.executionStats.totalDocsExamined, tojson(explain));
+    assert.eq(0, coll.find({_id: 43}).itcount());
+
+    // Range queries and updates keep working.
+    assert.eq(3, coll.find({_id: {$gte: 5, $lt: 100}}).itcount());
+    assert.writeOK(coll.update({_id: 0}, {$set: {x: 2}}));
+    assert.eq(2, coll.findOne({_id: 0}).x);
+    assert.writeOK(coll.remove({_id: 0}));
+    assert.eq(null, coll.findOne({_id: 0}));
+
+    assert.eq(true, coll.exists().options.clustered);
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,58 @@
+/**
+ * Tests that compact with {online: true} compacts a collection while reads and writes to it
+ * continue, and reports its progress in currentOp.
+ * @tags: [requires_wiredtiger, requires_persistence]
+ */
+(function() {
+    "use strict";
+
+    const conn = MongoRunner.runMongod({setParameter: {onlineCompactPauseMillis: 2000}});
+    assert.neq(null, conn, "mongod was unable to start up");
+    const testDB = conn.getDB("test");
+    const coll = testDB.compact_online;
+
+    assert.commandWorked(coll.createIndex({a: 1}));
+    assert.commandWorked(coll.createIndex({b: 1}));
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 10000; i++) {
+        bulk.insert({_id: i, a: i, b: "x".repeat(100)});
+    }
+    assert.writeOK(bulk.execute());
+    assert.writeOK(coll.remove({_id: {$mod: [2, 0]}}));
+
+    const awaitCompact = startParallelShell(function() {
+        const res = db.getSiblingDB("test").runCommand({compact: "compact_online", online: true});
+        assert.commandWorked(res);
+        assert.gte(res.bytesFreed, 0, tojson(res));
+    }, conn.port);
+
+    // The compaction pauses between its tables, long enough to observe it in currentOp.
+    let op;
+    assert.soon(function() {
+        const ops = testDB.currentOp({"command.compact": "compact_online"}).inprog;
+        if (ops.length === 0 || !ops[0].progress) {
+            return false;
+        }
+        op = ops[0];
+        return true;
+    }, "online compact did not report its progress");
+    assert.eq("Online compact", op.msg.substring(0, "Online compact".length), tojson(op));
+    assert.eq(3, op.progress.total, tojson(op));
+
+    // Reads and writes to the collection are not blocked by the compaction.
+    assert.writeOK(coll.insert({_id: "during", a: -1}));
+    assert.eq(1, coll.find({a: -1}).itcount());
+    assert.commandWorked(coll.createIndex({c: 1}));
+
+    awaitCompact();
+
+    assert.eq(5001, coll.find().itcount());
+    assert.eq(5001, coll.find().hint({a: 1}).itcount());
+    assert.eq(5000, coll.find({b: {$exists: true}}).hint({b: 1}).itcount());
+
+    // Online compaction requires the collection to exist.
+    assert.commandFailedWithCode(testDB.runCommand({compact: "missing", online: true}),
+                                 ErrorCodes.NamespaceNotFound);
+
+    MongoRunner.stopMongod(conn);
+}());
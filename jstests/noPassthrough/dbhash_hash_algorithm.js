@@ -0,0 +1,66 @@
+/**
+ * Tests that dbHash computes the same md5 and murmur3 hashes whether or not the documents are
+ * hashed by worker threads.
+ */
+(function() {
+    "use strict";
+
+    function hashDatabase(conn, hashAlgorithm) {
+        const cmd = {dbHash: 1};
+        if (hashAlgorithm !== undefined) {
+            cmd.hashAlgorithm = hashAlgorithm;
+        }
+        return assert.commandWorked(conn.getDB("test").runCommand(cmd));
+    }
+
+    function populate(conn) {
+        const testDB = conn.getDB("test");
+        const str = "x".repeat(1024);
+
+        // Large enough to be hashed in several chunks.
+        const bulk = testDB.large.initializeUnorderedBulkOp();
+        for (let i = 0; i < 3000; i++) {
+            bulk.insert({_id: i, str: str});
+        }
+        assert.writeOK(bulk.execute());
+
+        assert.writeOK(testDB.small.insert({_id: 0}));
+        assert.commandWorked(testDB.createCollection("capped", {capped: true, size: 4096}));
+        assert.writeOK(testDB.capped.insert({_id: 0}));
+        assert.commandWorked(testDB.createCollection("empty"));
+    }
+
+    const inline = MongoRunner.runMongod({});
+    assert.neq(null, inline, "mongod was unable to start up");
+    const workers = MongoRunner.runMongod({setParameter: {internalDbHashWorkerThreads: 4}});
+    assert.neq(null, workers, "mongod was unable to start up");
+
+    populate(inline);
+    populate(workers);
+
+    // md5 is the default.
+    const md5 = hashDatabase(inline);
+    assert.eq(md5.md5, hashDatabase(inline, "md5").md5);
+    assert.eq(undefined, md5.murmur3, tojson(md5));
+
+    const murmur3 = hashDatabase(inline, "murmur3");
+    assert.eq(undefined, murmur3.md5, tojson(murmur3));
+    assert.eq(32, murmur3.murmur3.length, tojson(murmur3));
+    assert.neq(md5.collections.large, murmur3.collections.large);
+
+    for (let [expected, hashAlgorithm] of [[md5, "md5"], [murmur3, "murmur3"]]) {
+        const res = hashDatabase(workers, hashAlgorithm);
+        assert.eq(expected.collections, res.collections, tojson(res));
+        assert.eq(expected[hashAlgorithm], res[hashAlgorithm], tojson(res));
+    }
+
+    // The murmur3 hash of a collection changes with its contents.
+    assert.writeOK(inline.getDB("test").large.update({_id: 1500}, {$set: {str: "y"}}));
+    assert.neq(murmur3.collections.large, hashDatabase(inline, "murmur3").collections.large);
+
+    assert.commandFailed(inline.getDB("test").runCommand({dbHash: 1, hashAlgorithm: "sha1"}));
+    assert.commandFailed(inline.getDB("test").runCommand({dbHash: 1, hashAlgorithm: 1}));
+
+    MongoRunner.stopMongod(inline);
+    MongoRunner.stopMongod(workers);
+}());
@@ -0,0 +1,55 @@
+/**
+ * Tests that a FETCH stage which reads its documents in batches in RecordId order returns the same
+ * documents, in the same order, as one which reads each document as soon as its RecordId arrives.
+ */
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    const conn = MongoRunner.runMongod({setParameter: {internalQueryFetchBatchSize: 7}});
+    assert.neq(null, conn, "mongod was unable to start up");
+    const testDB = conn.getDB("test");
+    const coll = testDB.fetch_batched;
+
+    // Insert in an order that differs from the order of the index on 'a', so the RecordIds the
+    // index scan returns are not sorted.
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 200; i++) {
+        bulk.insert({_id: i, a: (i * 37) % 200, b: i % 3});
+    }
+    assert.writeOK(bulk.execute());
+    assert.commandWorked(coll.createIndex({a: 1}));
+
+    function runQueries() {
+        return [
+            coll.find({a: {$gte: 10, $lt: 150}}).sort({a: 1}).toArray(),
+            coll.find({a: {$gte: 10}, b: 1}).sort({a: -1}).toArray(),
+            coll.find({a: {$lt: 100}}).sort({a: 1}).skip(5).limit(20).toArray(),
+            coll.find({a: {$gte: 0}}).sort({a: 1}).batchSize(3).toArray(),
+        ];
+    }
+
+    const batched = runQueries();
+    assert.eq(140, batched[0].length);
+    for (let i = 1; i < batched[0].length; i++) {
+        assert.lt(batched[0][i - 1].a, batched[0][i].a, tojson(batched[0]));
+    }
+
+    assert.commandWorked(testDB.adminCommand({setParameter: 1, internalQueryFetchBatchSize: 0}));
+    assert.eq(runQueries(), batched);
+    assert.commandWorked(testDB.adminCommand({setParameter: 1, internalQueryFetchBatchSize: 7}));
+
+    const explain = coll.find({a: {$gte: 10, $lt: 150}}).sort({a: 1}).explain("executionStats");
+    const fetchStage = getPlanStage(explain.executionStats.executionStages, "FETCH");
+    assert.neq(null, fetchStage, tojson(explain));
+    assert.eq(140 / 7, fetchStage.batchesFetched, tojson(fetchStage));
+
+    // Updates and deletes find their documents through a batched FETCH as well.
+    assert.writeOK(coll.update({a: {$lt: 20}}, {$inc: {b: 10}}, {multi: true}));
+    assert.eq(20, coll.find({b: {$gte: 10}}).itcount());
+    assert.writeOK(coll.remove({a: {$gte: 190}}));
+    assert.eq(190, coll.find({a: {$gte: 0}}).itcount());
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -164,5 +164,20 @@
     // Test non-command.
     assert.commandFailed(testColl.runCommand("IHopeNobodyEverMakesThisACommand"));
     lastHistogram = checkHistogramDiff(0, 0, 1);
+
+    // Percentiles are reported for every histogram, and are ordered.
+    ["reads", "writes", "commands"].forEach(function(type) {
+        const percentiles = lastHistogram[type].percentiles;
+        assert.lte(percentiles.p50, percentiles.p95, tojson(lastHistogram));
+        assert.lte(percentiles.p95, percentiles.p99, tojson(lastHistogram));
+        assert.lte(percentiles.p99, percentiles.p999, tojson(lastHistogram));
+        assert.gt(percentiles.p999, 0, tojson(lastHistogram));
+    });
+
+    // Ticket waits are reported alongside the global lock statistics. Whether any are recorded
+    // depends on the storage engine throttling concurrency with tickets.
+    const ticketWaits = testDB.serverStatus().globalLock.ticketWaits;
+    assert(ticketWaits.read.hasOwnProperty("percentiles"), tojson(ticketWaits));
+    assert(ticketWaits.write.hasOwnProperty("percentiles"), tojson(ticketWaits));
     MongoRunner.stopMongod(mongo);
 }());
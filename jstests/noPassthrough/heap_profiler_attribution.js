@@ -0,0 +1,50 @@
+// Tests that the sampling heap profiler charges sampled allocations to the command and namespace
+// that made them, with and without stacks.
+(function() {
+    "use strict";
+
+    function runTest(lowOverhead) {
+        const conn = MongoRunner.runMongod({
+            setParameter: {
+                heapProfilingEnabled: true,
+                heapProfilingSampleIntervalBytes: 1024,
+                heapProfilingLowOverhead: lowOverhead
+            }
+        });
+        assert.neq(null, conn, "mongod was unable to start up");
+        const testDB = conn.getDB("test");
+
+        const payload = "x".repeat(16 * 1024);
+        for (let i = 0; i < 100; i++) {
+            assert.writeOK(testDB.coll.insert({_id: i, payload: payload}));
+        }
+
+        const heapProfile = assert.commandWorked(testDB.serverStatus()).heapProfile;
+        assert.gt(heapProfile.stats.numAttributions, 0, tojson(heapProfile));
+        assert(heapProfile.attributions.hasOwnProperty("insert"), tojson(heapProfile));
+        assert(heapProfile.attributions.insert.hasOwnProperty("test.coll"), tojson(heapProfile));
+        assert.eq(lowOverhead, !heapProfile.hasOwnProperty("stacks"), tojson(heapProfile));
+        if (lowOverhead) {
+            assert.eq(0, heapProfile.stats.numStacks, tojson(heapProfile));
+        }
+
+        MongoRunner.stopMongod(conn);
+    }
+
+    // The heap profiler and its parameters only exist in non-Windows builds using tcmalloc.
+    if (_isWindows()) {
+        jsTestLog("Skipping test as the heap profiler is not available on Windows");
+        return;
+    }
+    const conn = MongoRunner.runMongod();
+    assert.neq(null, conn, "mongod was unable to start up");
+    const hasTcmalloc = assert.commandWorked(conn.adminCommand({serverStatus: 1})).tcmalloc;
+    MongoRunner.stopMongod(conn);
+    if (!hasTcmalloc) {
+        jsTestLog("Skipping test as the heap profiler is not available");
+        return;
+    }
+
+    runTest(false);
+    runTest(true);
+}());
@@ -0,0 +1,59 @@
+/**
+ * Tests that a background index build which bulk loads its keys applies the writes made to the
+ * collection while it scans, whether they touch documents the scan has already indexed or not.
+ * @tags: [requires_document_locking]
+ */
+(function() {
+    "use strict";
+
+    load("jstests/libs/check_log.js");
+
+    const conn = MongoRunner.runMongod({});
+    assert.neq(null, conn, "mongod was unable to start up");
+    const testDB = conn.getDB("test");
+    const coll = testDB.hybrid_index_build;
+
+    function runTest(hybrid) {
+        assert.commandWorked(
+            testDB.adminCommand({setParameter: 1, enableHybridIndexBuilds: hybrid}));
+        coll.drop();
+        for (let i = 0; i < 100; i++) {
+            assert.writeOK(coll.insert({_id: i, i: i, a: i}));
+        }
+
+        assert.commandWorked(testDB.adminCommand(
+            {configureFailPoint: "hangAfterIndexBuildOf", mode: "alwaysOn", data: {i: 50}}));
+        const awaitBuild = startParallelShell(function() {
+            assert.commandWorked(
+                db.hybrid_index_build.createIndex({a: 1}, {background: true, name: "a_1"}));
+        }, conn.port);
+        checkLog.contains(conn, "Hanging after index build of i=50");
+
+        // Write to documents on both sides of the collection scan.
+        assert.writeOK(coll.update({i: {$lt: 50}}, {$set: {a: [-1, -2]}}, {multi: true}));
+        assert.writeOK(coll.update({i: {$gt: 50}}, {$inc: {a: 1000}}, {multi: true}));
+        assert.writeOK(coll.remove({i: {$in: [10, 60]}}));
+        assert.writeOK(coll.insert({_id: 100, i: 100, a: -1}));
+
+        assert.commandWorked(
+            testDB.adminCommand({configureFailPoint: "hangAfterIndexBuildOf", mode: "off"}));
+        awaitBuild();
+
+        const res = assert.commandWorked(coll.validate({full: true}));
+        assert(res.valid, tojson(res));
+        assert.eq(99, coll.find().hint({a: 1}).itcount());
+        assert.eq(50, coll.find({a: -1}).hint({a: 1}).itcount());
+        assert.eq(49, coll.find({a: -2}).hint({a: 1}).itcount());
+        assert.eq(48, coll.find({a: {$gt: 1000}}).hint({a: 1}).itcount());
+        assert.eq(1, coll.find({a: 50}).hint({a: 1}).itcount());
+
+        // The concurrent updates made the index multikey.
+        const explain = coll.find({a: -1}).hint({a: 1}).explain();
+        assert(tojson(explain).includes('"isMultiKey" : true'), tojson(explain));
+    }
+
+    runTest(true);
+    runTest(false);
+
+    MongoRunner.stopMongod(conn);
+}());
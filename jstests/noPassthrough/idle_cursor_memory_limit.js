@@ -0,0 +1,64 @@
+// Tests that idle cursors report the memory held by their buffered results in $currentOp, and that
+// the least recently used of them are killed once they hold more than idleCursorMemoryLimitBytes.
+(function() {
+    "use strict";
+
+    // We're testing the client cursor monitor thread, so make it run with a higher frequency.
+    const options = {setParameter: {clientCursorMonitorFrequencySecs: 0}};
+    const conn = MongoRunner.runMongod(options);
+    assert.neq(conn, null, `Mongod failed to start up with options ${tojson(options)}`);
+    const db = conn.getDB("test");
+    const adminDB = conn.getDB("admin");
+    const coll = db.idle_cursor_memory_limit;
+
+    const padding = "x".repeat(1024);
+    for (let i = 0; i < 100; ++i) {
+        assert.writeOK(coll.insert({_id: i, padding: padding}));
+    }
+
+    function idleCursorMemUsage(cursorId) {
+        const result = adminDB
+                           .aggregate([
+                               {$currentOp: {localOps: true, idleCursors: true}},
+                               {$match: {type: "idleCursor", "cursor.cursorId": cursorId}}
+                           ])
+                           .toArray();
+        assert.eq(result.length, 1, tojson(result));
+        return result[0].cursor.memUsageBytes;
+    }
+
+    // Both a blocking $sort in an aggregation and a blocking SORT stage in a find hold all of their
+    // input until they are exhausted.
+    const aggCursorId = assert
+                            .commandWorked(db.runCommand({
+                                aggregate: coll.getName(),
+                                pipeline: [{$sort: {_id: -1}}],
+                                cursor: {batchSize: 1}
+                            }))
+                            .cursor.id;
+    sleep(10);
+    const findCursorId =
+        assert
+            .commandWorked(
+                db.runCommand({find: coll.getName(), sort: {padding: 1, _id: 1}, batchSize: 1}))
+            .cursor.id;
+
+    const aggMemUsage = idleCursorMemUsage(aggCursorId);
+    const findMemUsage = idleCursorMemUsage(findCursorId);
+    assert.gt(aggMemUsage, 100 * padding.length, "aggregation cursor reported too little memory");
+    assert.gt(findMemUsage, 100 * padding.length, "find cursor reported too little memory");
+
+    // With a limit that only the most recently used cursor fits in, the older one is killed.
+    assert.commandWorked(
+        adminDB.runCommand({setParameter: 1, idleCursorMemoryLimitBytes: findMemUsage}));
+    assert.soon(() => db.serverStatus().metrics.cursor.killedForMemory == 1);
+    assert.commandFailedWithCode(db.runCommand({getMore: aggCursorId, collection: coll.getName()}),
+                                 ErrorCodes.CursorNotFound);
+
+    const getMore = assert.commandWorked(
+        db.runCommand({getMore: findCursorId, collection: coll.getName(), batchSize: 1}));
+    assert.eq(getMore.cursor.nextBatch.length, 1, tojson(getMore));
+    assert.eq(db.serverStatus().metrics.cursor.killedForMemory, 1);
+
+    MongoRunner.stopMongod(conn);
+}());
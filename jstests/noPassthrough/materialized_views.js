@@ -0,0 +1,106 @@
+/**
+ * Tests that materialized views are kept up to date with the changes to the collection they are
+ * defined on, both incrementally and by full refresh.
+ */
+(function() {
+    'use strict';
+
+    const conn = MongoRunner.runMongod({setParameter: {materializedViewRefreshIntervalSecs: 1}});
+    assert.neq(null, conn, 'mongod was unable to start up');
+
+    const testDB = conn.getDB('test');
+    const coll = testDB.source;
+    coll.drop();
+
+    for (let i = 0; i < 10; ++i) {
+        assert.writeOK(coll.insert({_id: i, k: i % 3, v: i}));
+    }
+
+    // A view whose stages map each document to its own result.
+    assert.commandWorked(testDB.runCommand({
+        create: 'perDocument',
+        viewOn: 'source',
+        pipeline: [{$match: {v: {$gte: 5}}}, {$project: {v: 1}}],
+        materialized: true
+    }));
+
+    // A view ending in a $group of $sum accumulators.
+    assert.commandWorked(testDB.runCommand({
+        create: 'grouped',
+        viewOn: 'source',
+        pipeline: [{$group: {_id: '$k', total: {$sum: '$v'}, count: {$sum: 1}}}],
+        materialized: true
+    }));
+
+    // A view which can only be maintained by recomputing it.
+    assert.commandWorked(testDB.runCommand({
+        create: 'sorted',
+        viewOn: 'source',
+        pipeline: [{$sort: {v: -1}}, {$limit: 2}, {$project: {_id: 1}}],
+        materialized: true
+    }));
+
+    const listed = testDB.getCollectionInfos({name: 'grouped'});
+    assert.eq(1, listed.length, tojson(listed));
+    assert.eq(true, listed[0].options.materialized, tojson(listed));
+
+    function expected(viewName) {
+        const view = testDB.getCollectionInfos({name: viewName})[0];
+        return coll.aggregate(view.options.pipeline).toArray();
+    }
+
+    function assertUpToDate(viewName) {
+        assert.soon(
+            function() {
+                const actual = testDB[viewName].find().toArray();
+                return bsonWoCompare(actual.sort(bsonWoCompare),
+                                     expected(viewName).sort(bsonWoCompare)) === 0;
+            },
+            function() {
+                return viewName + ' is ' + tojson(testDB[viewName].find().toArray()) +
+                    ' rather than ' + tojson(expected(viewName));
+            });
+    }
+
+    function assertAllUpToDate() {
+        assertUpToDate('perDocument');
+        assertUpToDate('grouped');
+        assertUpToDate('sorted');
+    }
+
+    assertAllUpToDate();
+
+    // Inserts, updates which move documents between groups and deletes are all reflected.
+    assert.writeOK(coll.insert({_id: 10, k: 1, v: 100}));
+    assert.writeOK(coll.update({_id: 2}, {$set: {k: 0, v: 7}}));
+    assert.writeOK(coll.update({_id: 9}, {$set: {v: 1}}));
+    assert.writeOK(coll.remove({_id: 5}));
+    assertAllUpToDate();
+
+    // Removing every document of a group removes the group.
+    assert.writeOK(coll.remove({k: 2}));
+    assertAllUpToDate();
+    assert.eq(0, testDB.grouped.find({_id: 2}).itcount());
+
+    // The bookkeeping field of the backing collection is never returned.
+    testDB.grouped.find().forEach(function(doc) {
+        assert(!doc.hasOwnProperty('__materializedCount'), tojson(doc));
+    });
+
+    // Dropping the source empties the views.
+    coll.drop();
+    assertAllUpToDate();
+
+    // Dropping a view drops its backing collections.
+    assert(testDB.grouped.drop());
+    assert.soon(function() {
+        return testDB.getCollectionNames().filter(name => name.startsWith('grouped.')).length ===
+            0;
+    });
+
+    // 'materialized' is only allowed on views.
+    assert.commandFailedWithCode(testDB.runCommand({create: 'notAView', materialized: true}),
+                                 ErrorCodes.BadValue);
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,87 @@
+/**
+ * Tests that mapReduce produces the same results when its map phase runs on the map worker threads
+ * enabled by internalMapReduceMapWorkerThreads.
+ */
+(function() {
+    "use strict";
+
+    const kNumDocs = 20000;
+    const kNumKeys = 7;
+
+    const conn = MongoRunner.runMongod({setParameter: {internalMapReduceMapWorkerThreads: 4}});
+    assert.neq(null, conn, "mongod was unable to start up");
+    const testDB = conn.getDB("test");
+    const coll = testDB.mr_parallel_map;
+
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < kNumDocs; i++) {
+        bulk.insert({_id: i, key: i % kNumKeys, x: 1});
+    }
+    assert.writeOK(bulk.execute());
+
+    const map = function() {
+        emit(this.key, {count: this.x, scaled: this.x * factor});
+    };
+    const reduce = function(key, values) {
+        const result = {count: 0, scaled: 0};
+        values.forEach(function(value) {
+            result.count += value.count;
+            result.scaled += value.scaled;
+        });
+        return result;
+    };
+
+    function checkResults(results, numDocs) {
+        assert.eq(kNumKeys, results.length, tojson(results));
+        let total = 0;
+        results.forEach(function(result) {
+            total += result.value.count;
+            assert.eq(2 * result.value.count, result.value.scaled, tojson(result));
+        });
+        assert.eq(numDocs, total, tojson(results));
+    }
+
+    // Inline output.
+    let res = assert.commandWorked(testDB.runCommand({
+        mapReduce: coll.getName(),
+        map: map,
+        reduce: reduce,
+        scope: {factor: 2},
+        out: {inline: 1}
+    }));
+    assert.eq(kNumDocs, res.counts.input, tojson(res));
+    assert.eq(kNumDocs, res.counts.emit, tojson(res));
+    checkResults(res.results, kNumDocs);
+
+    // Output to a collection, with a query and a limit.
+    res = assert.commandWorked(testDB.runCommand({
+        mapReduce: coll.getName(),
+        map: map,
+        reduce: reduce,
+        scope: {factor: 2},
+        query: {_id: {$gte: 1000}},
+        sort: {_id: 1},
+        limit: 5000,
+        out: "mr_parallel_map_out"
+    }));
+    assert.eq(5000, res.counts.input, tojson(res));
+    checkResults(testDB.mr_parallel_map_out.find().toArray(), 5000);
+
+    // An error thrown by a map function running on a worker fails the command.
+    const err = assert.commandFailed(testDB.runCommand({
+        mapReduce: coll.getName(),
+        map: function() {
+            if (this._id === 12345) {
+                throw new Error("map failure");
+            }
+            emit(this.key, 1);
+        },
+        reduce: function(key, values) {
+            return Array.sum(values);
+        },
+        out: {inline: 1}
+    }));
+    assert(tojson(err).includes("map failure"), tojson(err));
+
+    MongoRunner.stopMongod(conn);
+}());
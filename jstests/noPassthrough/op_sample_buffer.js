@@ -0,0 +1,77 @@
+/**
+ * Tests that operations chosen by 'opSampleBufferSampleRate' have their profiler entries, including
+ * plan statistics, recorded in memory and returned by the $opSamples aggregation stage, without
+ * any writes to system.profile.
+ */
+(function() {
+    "use strict";
+
+    load("jstests/noPassthrough/libs/server_parameter_helpers.js");
+
+    testNumericServerParameter("opSampleBufferSampleRate",
+                               true,   // is Startup Param
+                               true,   // is runtime param
+                               0.0,    // default value
+                               0.5,    // valid, non-default value
+                               true,   // has lower bound
+                               -0.1,   // out of bound value (below lower bound)
+                               true,   // has upper limit
+                               1.1);   // out of bounds value (above upper bound)
+
+    const conn = MongoRunner.runMongod();
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    const adminDB = conn.getDB("admin");
+    const testDB = conn.getDB("test");
+    const coll = testDB.op_sample_buffer;
+
+    function getSamples(filter) {
+        return adminDB.aggregate([{$opSamples: {}}, {$match: filter}]).toArray();
+    }
+
+    assert.commandWorked(coll.insert([{_id: 0, a: 0}, {_id: 1, a: 1}, {_id: 2, a: 1}]));
+    assert.commandWorked(coll.createIndex({a: 1}));
+
+    // Nothing is sampled by default.
+    assert.eq(2, coll.find({a: 1}).comment("unsampled").itcount());
+    assert.eq(0, getSamples({"command.comment": "unsampled"}).length);
+
+    // With every operation sampled, finds are recorded along with their plan statistics.
+    assert.commandWorked(adminDB.runCommand({setParameter: 1, opSampleBufferSampleRate: 1.0}));
+    assert.eq(2, coll.find({a: 1}).comment("sampled").itcount());
+
+    const samples = getSamples({"command.comment": "sampled"});
+    assert.eq(1, samples.length, tojson(samples));
+    const sample = samples[0];
+    assert.eq(coll.getFullName(), sample.ns, tojson(sample));
+    assert.eq("IXSCAN { a: 1 }", sample.planSummary, tojson(sample));
+    assert.eq(2, sample.keysExamined, tojson(sample));
+    assert.eq(2, sample.docsExamined, tojson(sample));
+    assert(sample.hasOwnProperty("execStats"), tojson(sample));
+    assert(sample.hasOwnProperty("ts"), tojson(sample));
+
+    // Sampling does not write to the profiler collection.
+    assert.eq(0, testDB.system.profile.find().itcount());
+
+    // The buffer keeps only the most recent samples.
+    for (let i = 0; i < 1100; ++i) {
+        assert.eq(1, coll.find({_id: 0}).comment("filler").itcount());
+    }
+    assert.eq(0, getSamples({"command.comment": "sampled"}).length);
+    const fillers = getSamples({"command.comment": "filler"});
+    assert.gt(fillers.length, 1000, fillers.length);
+    assert.lte(fillers.length, 1024, fillers.length);
+    for (let i = 1; i < fillers.length; ++i) {
+        assert.lte(fillers[i - 1].ts, fillers[i].ts);
+    }
+
+    // $opSamples must be run against the admin database with {aggregate: 1}.
+    assert.commandFailedWithCode(
+        testDB.runCommand({aggregate: 1, pipeline: [{$opSamples: {}}], cursor: {}}),
+        ErrorCodes.InvalidNamespace);
+    assert.commandFailedWithCode(
+        adminDB.runCommand({aggregate: 1, pipeline: [{$opSamples: {a: 1}}], cursor: {}}),
+        ErrorCodes.FailedToParse);
+
+    MongoRunner.stopMongod(conn);
+}());
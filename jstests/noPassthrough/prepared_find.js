@@ -0,0 +1,81 @@
+/**
+ * Tests that finds prepared with placeholders in their filters return the same results as the
+ * finds with the values of their parameters in place of the placeholders.
+ */
+(function() {
+    'use strict';
+
+    const conn = MongoRunner.runMongod({});
+    assert.neq(null, conn, 'mongod was unable to start up');
+
+    const testDB = conn.getDB('test');
+    const coll = testDB.prepared_find;
+    coll.drop();
+
+    for (let i = 0; i < 20; ++i) {
+        assert.writeOK(coll.insert({_id: i, a: i % 4, b: i}));
+    }
+    assert.commandWorked(coll.createIndex({a: 1}));
+
+    function prepare(cmd) {
+        const res = assert.commandWorked(testDB.runCommand(cmd));
+        assert.eq('number', typeof res.statementId, tojson(res));
+        return res;
+    }
+
+    function execute(statementId, parameters) {
+        const res = assert.commandWorked(
+            testDB.runCommand({executePrepared: statementId, parameters: parameters}));
+        return new DBCommandCursor(testDB, res).toArray();
+    }
+
+    const range = prepare({
+        prepareFind: coll.getName(),
+        filter: {a: {$param: 'a'}, b: {$gte: {$param: 'low'}, $lt: {$param: 'high'}}},
+        sort: {b: 1}
+    });
+    assert.eq(['a', 'low', 'high'], range.parameters, tojson(range));
+
+    for (let a = 0; a < 4; ++a) {
+        const parameters = {a: a, low: 2, high: 15};
+        assert.eq(coll.find({a: a, b: {$gte: 2, $lt: 15}}).sort({b: 1}).toArray(),
+                  execute(range.statementId, parameters));
+    }
+
+    // Prepared finds on _id still look up the document by _id.
+    const byId = prepare({prepareFind: coll.getName(), filter: {_id: {$param: 'id'}}});
+    assert.eq([{_id: 7, a: 3, b: 7}], execute(byId.statementId, {id: 7}));
+
+    // Results which do not fit in the first batch are returned through getMore.
+    const all =
+        prepare({prepareFind: coll.getName(), filter: {b: {$gte: {$param: 'low'}}}, batchSize: 2});
+    assert.eq(18, execute(all.statementId, {low: 2}).length);
+
+    // Parameters must all be given values, and only parameters may be given values.
+    assert.commandFailedWithCode(
+        testDB.runCommand({executePrepared: range.statementId, parameters: {a: 1}}),
+        ErrorCodes.BadValue);
+    assert.commandFailedWithCode(
+        testDB.runCommand({executePrepared: byId.statementId, parameters: {id: 1, other: 2}}),
+        ErrorCodes.BadValue);
+
+    // Placeholders may only stand for values which are compared against.
+    assert.commandFailedWithCode(
+        testDB.runCommand({prepareFind: coll.getName(), filter: {a: {$in: {$param: 'a'}}}}),
+        ErrorCodes.BadValue);
+
+    // Prepared finds may only be run by their id on their database.
+    assert.commandFailedWithCode(testDB.runCommand({executePrepared: NumberLong(-1)}),
+                                 ErrorCodes.NoSuchKey);
+    assert.commandFailedWithCode(
+        conn.getDB('other').runCommand({executePrepared: byId.statementId, parameters: {id: 1}}),
+        ErrorCodes.InvalidNamespace);
+
+    // Views do not support prepared finds.
+    assert.commandWorked(testDB.createView('view', coll.getName(), []));
+    assert.commandFailedWithCode(
+        testDB.runCommand({prepareFind: 'view', filter: {a: {$param: 'a'}}}),
+        ErrorCodes.CommandNotSupportedOnView);
+
+    MongoRunner.stopMongod(conn);
+}());
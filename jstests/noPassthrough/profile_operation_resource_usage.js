@@ -0,0 +1,43 @@
+// Tests that the CPU time and disk I/O used by an operation are reported in the profiler and
+// accumulated in serverStatus, on platforms which can measure them per thread.
+// @tags: [requires_profiling]
+
+(function() {
+    "use strict";
+
+    load("jstests/libs/profiler.js");
+
+    const conn = MongoRunner.runMongod();
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    const testDB = conn.getDB("test");
+    const coll = testDB.getCollection("coll");
+
+    if (testDB.hostInfo().os.type !== "Linux") {
+        jsTestLog("Skipping test since per-thread resource usage is only measured on Linux");
+        MongoRunner.stopMongod(conn);
+        return;
+    }
+
+    for (let i = 0; i < 100; ++i) {
+        assert.writeOK(coll.insert({a: i}));
+    }
+
+    const before = testDB.serverStatus().metrics.operation;
+
+    testDB.setProfilingLevel(2);
+    assert.eq(100, coll.find({a: {$gte: 0}}).itcount());
+
+    const profileObj = getLatestProfilerEntry(testDB, {op: "query", ns: coll.getFullName()});
+    assert(profileObj.hasOwnProperty("cpuNanos"), tojson(profileObj));
+    assert.gte(profileObj.cpuNanos, 0, tojson(profileObj));
+    assert.gte(profileObj.storageBlockReads, 0, tojson(profileObj));
+    assert.gte(profileObj.storageBlockWrites, 0, tojson(profileObj));
+
+    const after = testDB.serverStatus().metrics.operation;
+    assert.gt(after.cpuNanos, before.cpuNanos, tojson(after));
+    assert.gte(after.storageBlockReads, before.storageBlockReads, tojson(after));
+    assert.gte(after.storageBlockWrites, before.storageBlockWrites, tojson(after));
+
+    MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,80 @@
+/**
+ * Tests that find commands served from the query result cache return the same results as running
+ * the query, and that writes to the collection invalidate the cached results.
+ */
+(function() {
+    'use strict';
+
+    const conn = MongoRunner.runMongod({setParameter: {internalQueryResultCacheEnabled: true}});
+    assert.neq(null, conn, 'mongod was unable to start up');
+
+    const testDB = conn.getDB('test');
+    const coll = testDB.query_result_cache;
+    coll.drop();
+
+    for (let i = 0; i < 10; ++i) {
+        assert.writeOK(coll.insert({_id: i, a: i % 2}));
+    }
+
+    function resultCacheMetrics() {
+        return testDB.serverStatus().metrics.query.resultCache;
+    }
+
+    function findOdd() {
+        return coll.find({a: 1}).sort({_id: 1}).toArray();
+    }
+
+    const before = resultCacheMetrics();
+    assert.eq(5, findOdd().length);
+    assert.eq(before.misses + 1, resultCacheMetrics().misses);
+    assert.eq(before.insertions + 1, resultCacheMetrics().insertions);
+
+    // Repeating the query is served from the cache.
+    assert.eq(5, findOdd().length);
+    assert.eq(before.hits + 1, resultCacheMetrics().hits);
+
+    let explain = coll.find({a: 1}).sort({_id: 1}).explain();
+    assert.eq(true, explain.resultCacheHit, tojson(explain));
+
+    // A query with a different filter value is cached separately.
+    assert.eq(5, coll.find({a: 0}).sort({_id: 1}).itcount());
+    assert.eq(before.hits + 1, resultCacheMetrics().hits);
+
+    // Options which do not change the results do not change the key.
+    assert.eq(5, coll.find({a: 1}).sort({_id: 1}).comment('dashboard').itcount());
+    assert.eq(before.hits + 2, resultCacheMetrics().hits);
+
+    // Inserts, updates and deletes all invalidate the cached results.
+    assert.writeOK(coll.insert({_id: 10, a: 1}));
+    assert.eq(6, findOdd().length);
+
+    assert.writeOK(coll.update({_id: 1}, {$set: {a: 0}}));
+    assert.eq(5, findOdd().length);
+
+    assert.writeOK(coll.remove({_id: 3}));
+    assert.eq(4, findOdd().length);
+    assert.eq(before.hits + 2, resultCacheMetrics().hits);
+
+    explain = coll.find({a: 1}).sort({_id: 1}).explain();
+    assert.eq(true, explain.resultCacheHit, tojson(explain));
+    assert.eq(4, findOdd().length);
+    assert.eq(before.hits + 3, resultCacheMetrics().hits);
+
+    // Creating an index invalidates the cached results.
+    assert.commandWorked(coll.createIndex({a: 1}));
+    explain = coll.find({a: 1}).sort({_id: 1}).explain();
+    assert.eq(false, explain.resultCacheHit, tojson(explain));
+
+    // Results which do not fit in the first batch are not cached.
+    const insertionsBefore = resultCacheMetrics().insertions;
+    assert.eq(11, coll.find().batchSize(2).itcount());
+    assert.eq(11, coll.find().batchSize(2).itcount());
+    assert.eq(insertionsBefore, resultCacheMetrics().insertions);
+
+    // Dropping and recreating the collection starts from an empty cache.
+    coll.drop();
+    assert.writeOK(coll.insert({_id: 0, a: 1}));
+    assert.eq(1, findOdd().length);
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,69 @@
+/**
+ * Tests that the $queryShapeStats aggregation stage reports statistics per query shape, and that
+ * the number of shapes tracked is bounded by 'queryShapeStatsMaxEntries'.
+ */
+(function() {
+    "use strict";
+
+    const conn = MongoRunner.runMongod();
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    const adminDB = conn.getDB("admin");
+    const testDB = conn.getDB("test");
+    const coll = testDB.query_shape_stats;
+
+    function getShapeStats() {
+        return adminDB.aggregate([{$queryShapeStats: {}}, {$match: {ns: coll.getFullName()}}])
+            .toArray();
+    }
+
+    for (let i = 0; i < 10; ++i) {
+        assert.commandWorked(coll.insert({_id: i, a: i, b: i % 2}));
+    }
+    assert.commandWorked(coll.createIndex({a: 1}));
+
+    // Queries of the same shape with different values share an entry.
+    for (let i = 0; i < 5; ++i) {
+        assert.eq(1, coll.find({a: i}).itcount());
+    }
+    assert.eq(5, coll.find({b: 1}).itcount());
+
+    let stats = getShapeStats();
+    assert.eq(2, stats.length, tojson(stats));
+
+    // Only the shape on 'a' uses the index.
+    const aStats = stats.find(shape => shape.keysExamined > 0);
+    assert.neq(undefined, aStats, tojson(stats));
+    assert.eq(5, aStats.count, tojson(aStats));
+    assert.eq(5, aStats.keysExamined, tojson(aStats));
+    assert.eq(5, aStats.docsExamined, tojson(aStats));
+    assert.eq(5, aStats.nreturned, tojson(aStats));
+    assert.gte(aStats.totalMicros, aStats.maxMicros, tojson(aStats));
+    assert.eq(5, aStats.histogram.reduce((total, bucket) => total + bucket.count, 0));
+
+    const bStats = stats.find(shape => shape.queryHash !== aStats.queryHash);
+    assert.eq(1, bStats.count, tojson(bStats));
+    assert.eq(10, bStats.docsExamined, tojson(bStats));
+    assert.eq(5, bStats.nreturned, tojson(bStats));
+
+    // The shapes are reported most expensive first.
+    stats = adminDB.aggregate([{$queryShapeStats: {}}]).toArray();
+    for (let i = 1; i < stats.length; ++i) {
+        assert.gte(stats[i - 1].totalMicros, stats[i].totalMicros, tojson(stats));
+    }
+
+    // Lowering the limit bounds the number of shapes tracked.
+    assert.commandWorked(adminDB.runCommand({setParameter: 1, queryShapeStatsMaxEntries: 2}));
+    assert.eq(0, coll.find({a: 1, b: 1}).itcount());
+    assert.eq(1, coll.find({a: {$gt: 8}}).itcount());
+    assert.lte(adminDB.aggregate([{$queryShapeStats: {}}]).itcount(), 2);
+
+    assert.commandFailed(adminDB.runCommand({setParameter: 1, queryShapeStatsMaxEntries: -1}));
+
+    // $queryShapeStats must be run against the admin database with {aggregate: 1}.
+    assert.commandFailedWithCode(
+        testDB.runCommand({aggregate: 1, pipeline: [{$queryShapeStats: {}}], cursor: {}}),
+        ErrorCodes.InvalidNamespace);
+
+    MongoRunner.stopMongod(conn);
+}());
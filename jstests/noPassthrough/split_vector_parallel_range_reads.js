@@ -0,0 +1,57 @@
+/**
+ * Tests that the split points splitVector returns for an unsharded collection divide it into
+ * ranges which concurrent readers can scan independently, each document being read exactly once.
+ * This is what range-split parallel dump tools rely on.
+ */
+(function() {
+    'use strict';
+
+    const conn = MongoRunner.runMongod();
+    assert.neq(null, conn, 'mongod was unable to start up');
+
+    const testDB = conn.getDB('test');
+    const coll = testDB.split_vector_parallel_range_reads;
+    const kNumDocs = 10000;
+    const kNumReaders = 4;
+
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < kNumDocs; ++i) {
+        bulk.insert({_id: i, padding: 'x'.repeat(100)});
+    }
+    assert.writeOK(bulk.execute());
+
+    const res = assert.commandWorked(testDB.runCommand({
+        splitVector: coll.getFullName(),
+        keyPattern: {_id: 1},
+        maxChunkObjects: kNumDocs / kNumReaders,
+        // Only the object count should limit the ranges.
+        maxChunkSizeBytes: coll.dataSize()
+    }));
+    assert.eq(kNumReaders - 1, res.splitKeys.length, tojson(res));
+
+    // Each reader scans [min, max) of one range and records the ids it saw.
+    const bounds = [{_id: MinKey}].concat(res.splitKeys).concat([{_id: MaxKey}]);
+    const readers = [];
+    for (let i = 0; i < kNumReaders; ++i) {
+        readers.push(startParallelShell(
+            'const test = db.getSiblingDB("test");' +
+                'const ids = test.split_vector_parallel_range_reads.find()' +
+                '.min(' + tojson(bounds[i]) + ').max(' + tojson(bounds[i + 1]) + ')' +
+                '.hint({_id: 1}).toArray().map(doc => doc._id);' +
+                'assert.writeOK(test.range_reads.insert({reader: ' + i + ', ids: ids}));',
+            conn.port));
+    }
+    readers.forEach(awaitShell => awaitShell());
+
+    const seen = new Set();
+    testDB.range_reads.find().forEach(function(result) {
+        assert.gt(result.ids.length, 0, tojson(result.reader));
+        result.ids.forEach(function(id) {
+            assert(!seen.has(id), 'document ' + id + ' was read by more than one reader');
+            seen.add(id);
+        });
+    });
+    assert.eq(kNumDocs, seen.size);
+
+    MongoRunner.stopMongod(conn);
+}());
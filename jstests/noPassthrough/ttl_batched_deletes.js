@@ -0,0 +1,62 @@
+// Tests that the TTL monitor deletes expired documents in batches from several collections, and
+// that it drops a collection whose documents have all expired when its TTL index allows it.
+(function() {
+    "use strict";
+
+    var runner = MongoRunner.runMongod(
+        {setParameter: {ttlMonitorSleepSecs: 1, ttlMonitorBatchSize: 10, ttlMonitorNumWorkers: 2}});
+    var db = runner.getDB("test");
+
+    var past = new Date(new Date().getTime() - 3600 * 1000);
+    var future = new Date(new Date().getTime() + 3600 * 1000);
+
+    // Several collections, each with more expired documents than fit in a batch.
+    for (var i = 0; i < 3; i++) {
+        var coll = db["ttl_batched_" + i];
+        coll.drop();
+        assert.commandWorked(coll.createIndex({x: 1}, {expireAfterSeconds: 0}));
+
+        var bulk = coll.initializeUnorderedBulkOp();
+        for (var j = 0; j < 100; j++) {
+            bulk.insert({x: past});
+        }
+        bulk.insert({x: future});
+        assert.writeOK(bulk.execute());
+    }
+
+    // A time bucket which expires as a whole, and one which still has a live document.
+    var expiredBucket = db.ttl_bucket_expired;
+    var liveBucket = db.ttl_bucket_live;
+    [expiredBucket, liveBucket].forEach(function(coll) {
+        coll.drop();
+        assert.commandWorked(
+            coll.createIndex({x: 1}, {expireAfterSeconds: 0, expireCollection: true}));
+        for (var j = 0; j < 20; j++) {
+            assert.writeOK(coll.insert({x: past}));
+        }
+    });
+    assert.writeOK(liveBucket.insert({x: future}));
+
+    var droppedBefore = db.serverStatus().metrics.ttl.droppedCollections;
+
+    assert.soon(function() {
+        for (var i = 0; i < 3; i++) {
+            if (db["ttl_batched_" + i].count() !== 1) {
+                return false;
+            }
+        }
+        return liveBucket.count() === 1 &&
+            db.getCollectionNames().indexOf(expiredBucket.getName()) < 0;
+    }, "TTL monitor did not delete the expired documents");
+
+    assert.eq(droppedBefore + 1, db.serverStatus().metrics.ttl.droppedCollections);
+    assert.eq(1, liveBucket.find({x: future}).itcount());
+
+    // The whole collection may only expire by an index on every document.
+    assert.commandFailedWithCode(
+        db.ttl_bucket_sparse.createIndex(
+            {x: 1}, {expireAfterSeconds: 0, expireCollection: true, sparse: true}),
+        ErrorCodes.CannotCreateIndex);
+
+    MongoRunner.stopMongod(runner);
+})();
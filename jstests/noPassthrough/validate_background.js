@@ -0,0 +1,61 @@
+/**
+ * Tests that validate with background:true succeeds while writes to the collection go on, with and
+ * without worker threads.
+ * @tags: [requires_document_locking]
+ */
+(function() {
+    "use strict";
+
+    function runTest(conn) {
+        const testDB = conn.getDB("test");
+        const coll = testDB.validate_background;
+        coll.drop();
+
+        const bulk = coll.initializeUnorderedBulkOp();
+        for (let i = 0; i < 5000; i++) {
+            bulk.insert({_id: i, a: i, b: [i, i + 1], s: "x".repeat(i % 100)});
+        }
+        assert.writeOK(bulk.execute());
+        assert.commandWorked(coll.createIndex({a: 1}));
+        assert.commandWorked(coll.createIndex({b: 1}));
+        assert.commandWorked(
+            coll.createIndex({s: 1}, {partialFilterExpression: {a: {$gt: 2500}}}));
+
+        let res = assert.commandWorked(coll.validate({background: true}));
+        assert(res.valid, tojson(res));
+        assert.eq(5000, res.nrecords, tojson(res));
+        assert.eq(5000, res.keysPerIndex[coll.getFullName() + ".$a_1"], tojson(res));
+
+        // Writes go on while the collection is being validated.
+        const awaitWrites = startParallelShell(function() {
+            const coll = db.getSiblingDB("test").validate_background;
+            for (let i = 0; i < 2000; i++) {
+                assert.writeOK(coll.insert({_id: 5000 + i, a: i, b: [i]}));
+                assert.writeOK(coll.update({_id: i}, {$inc: {a: 1}}));
+                assert.writeOK(coll.remove({_id: 2500 + i}));
+            }
+        }, conn.port);
+        for (let i = 0; i < 10; i++) {
+            res = assert.commandWorked(coll.validate({background: true}));
+            assert(res.valid, tojson(res));
+        }
+        awaitWrites();
+
+        res = assert.commandWorked(coll.validate({background: true}));
+        assert(res.valid, tojson(res));
+        assert.eq(coll.find().itcount(), res.nrecords, tojson(res));
+
+        assert.commandFailedWithCode(coll.validate({background: true, full: true}),
+                                     ErrorCodes.CommandFailed);
+    }
+
+    let conn = MongoRunner.runMongod({});
+    assert.neq(null, conn, "mongod was unable to start up");
+    runTest(conn);
+    MongoRunner.stopMongod(conn);
+
+    conn = MongoRunner.runMongod({setParameter: {internalValidateWorkerThreads: 4}});
+    assert.neq(null, conn, "mongod was unable to start up");
+    runTest(conn);
+    MongoRunner.stopMongod(conn);
+}());
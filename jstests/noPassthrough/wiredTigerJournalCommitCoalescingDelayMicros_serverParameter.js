@@ -0,0 +1,19 @@
+// Tests the wiredTigerJournalCommitCoalescingDelayMicros server parameter.
+// @tags: [requires_wiredtiger]
+
+(function() {
+    'use strict';
+
+    load("jstests/noPassthrough/libs/server_parameter_helpers.js");
+
+    // Valid parameter values are in the range [0, 100000].
+    testNumericServerParameter("wiredTigerJournalCommitCoalescingDelayMicros",
+                               true /*isStartupParameter*/,
+                               true /*isRuntimeParameter*/,
+                               0 /*defaultValue*/,
+                               500 /*nonDefaultValidValue*/,
+                               true /*hasLowerBound*/,
+                               -1 /*lowerOutOfBounds*/,
+                               true /*hasUpperBound*/,
+                               100001 /*upperOutOfBounds*/);
+})();
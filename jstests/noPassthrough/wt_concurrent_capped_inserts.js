@@ -0,0 +1,41 @@
+/**
+ * Tests that with wiredTigerConcurrentCappedInserts concurrent inserts into a capped collection
+ * keep it within its maximum size, and its documents in insertion order.
+ * @tags: [requires_wiredtiger, requires_capped]
+ */
+(function() {
+    "use strict";
+
+    const kNumWriters = 4;
+    const kDocsPerWriter = 2000;
+    const kMaxSize = 64 * 1024;
+
+    const conn = MongoRunner.runMongod({setParameter: {wiredTigerConcurrentCappedInserts: true}});
+    assert.neq(null, conn, "mongod was unable to start up");
+    const testDB = conn.getDB("test");
+    assert.commandWorked(testDB.createCollection("capped", {capped: true, size: kMaxSize}));
+
+    let awaitWriters = [];
+    for (let w = 0; w < kNumWriters; w++) {
+        const insertDocs = "for (let i = 0; i < " + kDocsPerWriter + "; i++) {" +
+            "assert.writeOK(db.capped.insert({w: " + w + ", i: i, pad: 'x'.repeat(100)}));}";
+        awaitWriters.push(startParallelShell(insertDocs, conn.port));
+    }
+    awaitWriters.forEach((awaitWriter) => awaitWriter());
+
+    // Excess documents are removed in the background.
+    assert.soon(() => testDB.capped.dataSize() <= kMaxSize, () => tojson(testDB.capped.stats()));
+    assert.gt(testDB.capped.count(), 0);
+
+    // The documents of each writer are in the order it inserted them.
+    let lastOfWriter = {};
+    testDB.capped.find().forEach(function(doc) {
+        if (lastOfWriter.hasOwnProperty(doc.w)) {
+            assert.lt(lastOfWriter[doc.w], doc.i, tojson(doc));
+        }
+        lastOfWriter[doc.w] = doc.i;
+    });
+    assert.eq(kDocsPerWriter - 1, testDB.capped.find().sort({$natural: -1}).next().i);
+
+    MongoRunner.stopMongod(conn);
+}());
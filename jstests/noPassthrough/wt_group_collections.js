@@ -0,0 +1,67 @@
+/**
+ * Tests that with --groupCollections the collections and indexes of a database share WiredTiger
+ * tables, and that dropping one of them leaves the others and their entries in place.
+ * @tags: [requires_persistence, requires_wiredtiger]
+ */
+(function() {
+    "use strict";
+
+    const kNumCollections = 10;
+
+    let conn = MongoRunner.runMongod({groupCollections: ""});
+    assert.neq(null, conn, "mongod was unable to start up");
+    let testDB = conn.getDB("test");
+
+    for (let i = 0; i < kNumCollections; i++) {
+        const coll = testDB["coll" + i];
+        for (let j = 0; j < 10; j++) {
+            assert.writeOK(coll.insert({_id: j, a: i}));
+        }
+        assert.commandWorked(coll.createIndex({a: 1}));
+    }
+    assert.commandWorked(testDB.createCollection("capped", {capped: true, size: 4096}));
+
+    function checkTables() {
+        const stats = testDB.coll0.stats();
+        for (let i = 1; i < kNumCollections; i++) {
+            const other = testDB["coll" + i].stats();
+            assert.eq(stats.wiredTiger.uri, other.wiredTiger.uri, tojson(other));
+            assert.eq(stats.indexDetails.a_1.uri, other.indexDetails.a_1.uri, tojson(other));
+        }
+        assert.neq(stats.wiredTiger.uri, testDB.capped.stats().wiredTiger.uri);
+    }
+
+    function checkCounts(expectedCollections) {
+        for (let i = 0; i < kNumCollections; i++) {
+            const coll = testDB["coll" + i];
+            const expected = expectedCollections.includes(i) ? 10 : 0;
+            assert.eq(expected, coll.count(), coll.getFullName());
+            assert.eq(expected, coll.find().itcount(), coll.getFullName());
+            assert.eq(expected, coll.find({a: i}).hint({a: 1}).itcount(), coll.getFullName());
+        }
+    }
+
+    checkTables();
+    checkCounts([...Array(kNumCollections).keys()]);
+
+    // Dropping a collection and an index only removes their entries from the shared tables.
+    assert(testDB.coll1.drop());
+    assert.commandWorked(testDB.coll2.dropIndex({a: 1}));
+    assert.commandWorked(testDB.coll2.createIndex({a: 1}));
+    checkCounts([0, 2, 3, 4, 5, 6, 7, 8, 9]);
+
+    // A recreated collection starts out empty.
+    assert.writeOK(testDB.coll1.insert({_id: 0, a: 1}));
+    assert.eq(1, testDB.coll1.find().itcount());
+    assert(testDB.coll1.drop());
+
+    MongoRunner.stopMongod(conn);
+    conn = MongoRunner.runMongod({restart: conn, groupCollections: ""});
+    assert.neq(null, conn, "mongod was unable to restart");
+    testDB = conn.getDB("test");
+
+    checkCounts([0, 2, 3, 4, 5, 6, 7, 8, 9]);
+    assert.commandWorked(testDB.dropDatabase());
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,42 @@
+/**
+ * Tests that collections whose largest RecordId is loaded on first use, rather than at startup,
+ * keep their counts and hand out new RecordIds which do not collide with the existing ones.
+ * @tags: [requires_persistence, requires_wiredtiger]
+ */
+(function() {
+    "use strict";
+
+    let conn = MongoRunner.runMongod();
+    assert.neq(null, conn, "mongod was unable to start up");
+    let testDB = conn.getDB("test");
+
+    for (let i = 0; i < 100; i++) {
+        assert.writeOK(testDB.full.insert({_id: i}));
+    }
+    assert.commandWorked(testDB.createCollection("empty"));
+
+    MongoRunner.stopMongod(conn);
+    conn = MongoRunner.runMongod({
+        restart: conn,
+        cleanData: false,
+        setParameter: {wiredTigerLazyRecordStoreInit: true}
+    });
+    assert.neq(null, conn, "mongod was unable to restart");
+    testDB = conn.getDB("test");
+
+    // Inserting first loads the largest RecordId, so the new documents follow the old ones.
+    for (let i = 100; i < 150; i++) {
+        assert.writeOK(testDB.full.insert({_id: i}));
+    }
+    assert.eq(150, testDB.full.count());
+    assert.eq(150, testDB.full.find().itcount());
+    const ids = testDB.full.find().sort({$natural: 1}).toArray().map(doc => doc._id);
+    assert.eq(Array.from({length: 150}, (v, i) => i), ids);
+
+    assert.eq(0, testDB.empty.count());
+    assert.writeOK(testDB.empty.insert({_id: 0}));
+    assert.eq(1, testDB.empty.count());
+
+    assert.commandWorked(testDB.full.validate(true));
+    MongoRunner.stopMongod(conn);
+})();
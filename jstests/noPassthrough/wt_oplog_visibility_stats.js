@@ -0,0 +1,60 @@
+/**
+ * Tests that serverStatus reports the journal flushes the oplog manager makes to publish oplog
+ * visibility, and that their group commit window is bounded by
+ * wiredTigerOplogGroupCommitMaxWindowMicros.
+ * @tags: [requires_replication, requires_wiredtiger]
+ */
+(function() {
+    "use strict";
+
+    load("jstests/noPassthrough/libs/server_parameter_helpers.js");
+
+    // Valid parameter values are in the range [0, 100000].
+    testNumericServerParameter("wiredTigerOplogGroupCommitMaxWindowMicros",
+                               true /*isStartupParameter*/,
+                               true /*isRuntimeParameter*/,
+                               1000 /*defaultValue*/,
+                               500 /*nonDefaultValidValue*/,
+                               true /*hasLowerBound*/,
+                               -1 /*lowerOutOfBounds*/,
+                               true /*hasUpperBound*/,
+                               100001 /*upperOutOfBounds*/);
+
+    const rst = new ReplSetTest({nodes: 1});
+    rst.startSet();
+    rst.initiate();
+    const primary = rst.getPrimary();
+    const testDB = primary.getDB("test");
+
+    function getStats() {
+        return assert.commandWorked(testDB.adminCommand({serverStatus: 1}))
+            .wiredTiger.oplogVisibility;
+    }
+
+    const before = getStats();
+    assert.eq(9, Object.keys(before.waitersPerFlush).length, tojson(before));
+
+    // Readers waiting for their own writes make the oplog manager flush on their behalf.
+    const session = primary.startSession({causalConsistency: true});
+    const sessionColl = session.getDatabase("test").coll;
+    for (let i = 0; i < 20; i++) {
+        assert.commandWorked(sessionColl.insert({_id: i}, {writeConcern: {w: "majority"}}));
+        assert.eq(1, sessionColl.find({_id: i}).readConcern("majority").itcount());
+    }
+
+    const after = getStats();
+    assert.gt(after.flushes, before.flushes, tojson(after));
+    assert.gte(after.totalFlushMicros, before.totalFlushMicros, tojson(after));
+    assert.lte(after.groupCommitWindowMicros, 1000, tojson(after));
+    const bucketTotal = Object.values(after.waitersPerFlush).reduce((a, b) => a + b, 0);
+    assert.eq(after.flushes, bucketTotal, tojson(after));
+
+    // Disabling group commit flushes as soon as an operation waits.
+    assert.commandWorked(
+        testDB.adminCommand({setParameter: 1, wiredTigerOplogGroupCommitMaxWindowMicros: 0}));
+    assert.commandWorked(sessionColl.insert({_id: "last"}, {writeConcern: {w: "majority"}}));
+    assert.eq(0, getStats().groupCommitWindowMicros);
+
+    session.endSession();
+    rst.stopSet();
+})();
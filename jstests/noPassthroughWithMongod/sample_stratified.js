@@ -0,0 +1,45 @@
+// Tests that a $sample which is too large for a random cursor, but within
+// internalQueryStratifiedSampleMaxRatio of the collection, takes one document from each stratum of
+// a collection scan.
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    const coll = db.sample_stratified;
+    coll.drop();
+
+    let docsToInsert = [];
+    for (let i = 0; i < 1000; ++i) {
+        docsToInsert.push({_id: i});
+    }
+    assert.commandWorked(coll.insert(docsToInsert));
+
+    const originalRatio =
+        assert
+            .commandWorked(
+                db.adminCommand({getParameter: 1, internalQueryStratifiedSampleMaxRatio: 1}))
+            .internalQueryStratifiedSampleMaxRatio;
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryStratifiedSampleMaxRatio: 0.5}));
+
+    try {
+        // Each of the 200 strata holds five consecutive documents, and contributes exactly one of
+        // them. The documents come back in the order they were inserted.
+        const sample = coll.aggregate([{$sample: {size: 200}}]).toArray();
+        assert.eq(200, sample.length);
+        sample.forEach((doc, i) => assert.eq(i, Math.floor(doc._id / 5), tojson(sample)));
+
+        let explain = coll.explain().aggregate([{$sample: {size: 200}}]);
+        assert.neq([], getAggPlanStages(explain, "MULTI_ITERATOR"), tojson(explain));
+        assert.neq([], getAggPlanStages(explain, "$sampleFromRandomCursor"), tojson(explain));
+
+        // Larger samples still sort the whole collection by random values.
+        explain = coll.explain().aggregate([{$sample: {size: 600}}]);
+        assert.eq([], getAggPlanStages(explain, "MULTI_ITERATOR"), tojson(explain));
+        assert.eq(600, coll.aggregate([{$sample: {size: 600}}]).itcount());
+    } finally {
+        assert.commandWorked(db.adminCommand(
+            {setParameter: 1, internalQueryStratifiedSampleMaxRatio: originalRatio}));
+    }
+}());
@@ -0,0 +1,55 @@
+/**
+ * Tests the 'cacheResident' WiredTiger option of collections and indexes, which pins their tables
+ * in the cache, and the 'readOnce' option of find, which gives the data a query reads a low cache
+ * priority.
+ */
+(function() {
+    'use strict';
+
+    // Skip this test if not running with the "wiredTiger" storage engine.
+    if (db.serverStatus().storageEngine.name !== 'wiredTiger') {
+        jsTest.log('Skipping test because storageEngine is not "wiredTiger"');
+        return;
+    }
+
+    const coll = db.wt_cache_resident_and_read_once;
+    coll.drop();
+
+    assert.commandWorked(
+        db.createCollection(coll.getName(), {storageEngine: {wiredTiger: {cacheResident: true}}}));
+    assert.commandWorked(
+        coll.createIndex({a: 1}, {storageEngine: {wiredTiger: {cacheResident: true}}}));
+    assert.commandWorked(coll.createIndex({b: 1}));
+
+    const stats = assert.commandWorked(coll.stats());
+    assert(stats.wiredTiger.creationString.includes('cache_resident=true'), tojson(stats));
+    assert(stats.indexDetails.a_1.creationString.includes('cache_resident=true'), tojson(stats));
+    assert(stats.indexDetails.b_1.creationString.includes('cache_resident=false'), tojson(stats));
+
+    assert.commandFailed(
+        coll.createIndex({c: 1}, {storageEngine: {wiredTiger: {cacheResident: 1}}}));
+
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 1000; i++) {
+        bulk.insert({_id: i, a: i, b: i % 10});
+    }
+    assert.writeOK(bulk.execute());
+
+    // A read-once query sees the same data as any other, including in its getMores.
+    let res = assert.commandWorked(
+        db.runCommand({find: coll.getName(), filter: {}, readOnce: true, batchSize: 10}));
+    let count = res.cursor.firstBatch.length;
+    while (res.cursor.id != 0) {
+        res = assert.commandWorked(
+            db.runCommand({getMore: res.cursor.id, collection: coll.getName(), batchSize: 100}));
+        count += res.cursor.nextBatch.length;
+    }
+    assert.eq(1000, count);
+
+    res = assert.commandWorked(
+        db.runCommand({find: coll.getName(), filter: {a: {$gte: 990}}, readOnce: true}));
+    assert.eq(10, res.cursor.firstBatch.length);
+
+    assert.commandFailedWithCode(db.runCommand({find: coll.getName(), readOnce: 1}),
+                                 ErrorCodes.FailedToParse);
+})();
@@ -200,8 +200,33 @@
         forEachSecondary(secondary => checkLogAllConsistent(secondary, true));
     }
 
+    // Check a whole database, several collections at a time.
+    function databaseTestConsistent() {
+        let master = replSet.getPrimary();
+        clearLog();
+
+        let db = master.getDB(dbName);
+        for (let i = 0; i < 4; i++) {
+            addEnoughForMultipleBatches(db[collName + i]);
+        }
+        assert.commandWorked(
+            db.runCommand({dbCheck: 1, maxConcurrentCollections: 3, maxCountPerSecond: 20000}));
+
+        awaitDbCheckCompletion(db);
+
+        forEachNode(node => checkLogAllConsistent(node));
+
+        assert.commandFailedWithCode(db.runCommand({dbCheck: 1, maxConcurrentCollections: 0}),
+                                     ErrorCodes.InvalidOptions);
+
+        for (let i = 0; i < 4; i++) {
+            db[collName + i].drop();
+        }
+    }
+
     simpleTestConsistent();
     concurrentTestConsistent();
+    databaseTestConsistent();
 
     // Test the various other parameters.
     function testDbCheckParameters() {
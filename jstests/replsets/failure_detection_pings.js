@@ -0,0 +1,51 @@
+/**
+ * Tests that secondaries sending failure detection pings to the primary elect a new primary soon
+ * after it crashes, without waiting for the election timeout, and report how long it took them to
+ * notice.
+ */
+(function() {
+    "use strict";
+
+    load("jstests/libs/check_log.js");
+
+    const kSIGKILL = 9;
+    const rst = new ReplSetTest({
+        name: "failure_detection_pings",
+        nodes: [{}, {rsConfig: {priority: 0}}, {}],
+        nodeOptions: {
+            setParameter: {
+                failureDetectionPingIntervalMillis: 100,
+                logComponentVerbosity: tojson({replication: {heartbeats: 1}}),
+            }
+        },
+    });
+    rst.startSet();
+
+    // Make sure there are no election timeouts firing for the duration of the test, so that only
+    // failure detection can get a new primary elected.
+    const config = rst.getReplSetConfig();
+    config.settings = {electionTimeoutMillis: 12 * 60 * 60 * 1000};
+    rst.initiate(config);
+
+    const primary = rst.getPrimary();
+    const candidate = rst.nodes[2];
+    checkLog.contains(candidate, "Starting failure detection pings to " + primary.host);
+
+    // Let the candidate collect enough replies to know how regularly the primary answers.
+    sleep(3 * 1000);
+
+    rst.stop(primary, kSIGKILL, {allowedExitCode: MongoRunner.EXIT_SIGKILL});
+    assert.soon(() => candidate.adminCommand({isMaster: 1}).ismaster,
+                "the secondary did not take over from the crashed primary",
+                60 * 1000);
+
+    const detectionLatency =
+        assert.commandWorked(candidate.adminCommand({serverStatus: 1}))
+            .metrics.repl.failureDetection.detectionLatency;
+    assert.gte(detectionLatency.num, 1, tojson(detectionLatency));
+    assert.lt(detectionLatency.totalMillis,
+              10 * 1000 * detectionLatency.num,
+              tojson(detectionLatency));
+
+    rst.stopSet();
+})();
@@ -0,0 +1,59 @@
+/**
+ * Tests that initial sync applies the oplog entries it buffered both when they fit in the memory
+ * of the initial sync oplog buffer and when they spill into the temporary collection.
+ */
+(function() {
+    "use strict";
+    load("jstests/libs/check_log.js");
+
+    const kNumDocs = 2000;
+    const largeStr = new Array(1024).join('a');
+
+    function runTest(maxMemoryMB, checkBuffered) {
+        const replSet = new ReplSetTest({nodes: [{}, {rsConfig: {priority: 0, votes: 0}}]});
+        replSet.startSet();
+        replSet.initiate();
+        const primary = replSet.getPrimary();
+        const coll = primary.getDB('test').foo;
+        assert.writeOK(coll.insert({_id: -1}));
+
+        // Add a node that hangs before copying databases, so that every write below is fetched
+        // and buffered before it is applied.
+        const secondary =
+            replSet.add({setParameter: {initialSyncOplogBufferMaxMemoryMB: maxMemoryMB}});
+        secondary.setSlaveOk();
+        assert.commandWorked(secondary.getDB('admin').runCommand(
+            {configureFailPoint: 'initialSyncHangBeforeCopyingDatabases', mode: 'alwaysOn'}));
+        replSet.reInitiate();
+        checkLog.contains(
+            secondary, 'initial sync - initialSyncHangBeforeCopyingDatabases fail point enabled');
+
+        const bulk = coll.initializeUnorderedBulkOp();
+        for (let i = 0; i < kNumDocs; i++) {
+            bulk.insert({_id: i, x: largeStr});
+        }
+        assert.writeOK(bulk.execute());
+        assert.writeOK(coll.update({}, {$set: {updated: true}}, {multi: true}));
+
+        const tempBuffer = secondary.getDB('local').temp_oplog_buffer;
+        assert.soon(() => checkBuffered(tempBuffer.find().itcount()),
+                    () => "unexpected number of spilled entries: " + tempBuffer.find().itcount());
+
+        assert.commandWorked(secondary.adminCommand(
+            {configureFailPoint: 'initialSyncHangBeforeCopyingDatabases', mode: 'off'}));
+        replSet.awaitSecondaryNodes();
+        replSet.awaitReplication();
+
+        const secondaryColl = secondary.getDB('test').foo;
+        assert.eq(kNumDocs + 1, secondaryColl.find().itcount());
+        assert.eq(kNumDocs + 1, secondaryColl.find({updated: true}).itcount());
+        assert.eq(0, tempBuffer.find().itcount(), "Oplog buffer was not dropped after sync");
+        replSet.stopSet();
+    }
+
+    // Without memory, every buffered entry is written to the collection.
+    runTest(0, (numSpilled) => numSpilled >= 2 * kNumDocs);
+
+    // With 1MB of memory, the first entries are held in memory and the rest are spilled.
+    runTest(1, (numSpilled) => numSpilled > 0 && numSpilled < 2 * kNumDocs);
+})();
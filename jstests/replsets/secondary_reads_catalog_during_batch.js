@@ -0,0 +1,52 @@
+/**
+ * Tests that reads of the catalog on a secondary, which take no collection snapshot, do not wait
+ * for batch application: listCollections, listDatabases and an aggregation with a $lookup return
+ * while a batch is paused holding the PBWM lock.
+ */
+(function() {
+    "use strict";
+
+    load('jstests/replsets/libs/secondary_reads_test.js');
+
+    const name = "secondaryReadsCatalogDuringBatch";
+    const collName = "testColl";
+    let secondaryReadsTest = new SecondaryReadsTest(name);
+
+    let primaryDB = secondaryReadsTest.getPrimaryDB();
+    let secondaryDB = secondaryReadsTest.getSecondaryDB();
+
+    if (!primaryDB.serverStatus().storageEngine.supportsSnapshotReadConcern) {
+        secondaryReadsTest.stop();
+        return;
+    }
+
+    assert.commandWorked(primaryDB.runCommand({create: collName}));
+    assert.commandWorked(primaryDB.runCommand({create: "other"}));
+    assert.commandWorked(primaryDB.getCollection(collName).insert({_id: 0, x: 0}));
+    secondaryReadsTest.getReplset().awaitLastOpCommitted();
+
+    // Prevent a batch from completing on the secondary.
+    let pauseAwait = secondaryReadsTest.pauseSecondaryBatchApplication();
+    assert.commandWorked(primaryDB.getCollection(collName).insert({_id: 1, x: 1}));
+    pauseAwait();
+
+    const kTimeoutMS = 10 * 1000;
+    let res = assert.commandWorked(
+        secondaryDB.runCommand({listCollections: 1, nameOnly: true, maxTimeMS: kTimeoutMS}));
+    assert.eq(2, res.cursor.firstBatch.length, tojson(res));
+
+    res = assert.commandWorked(secondaryDB.adminCommand({listDatabases: 1, maxTimeMS: kTimeoutMS}));
+    assert(res.databases.some((db) => db.name === name), tojson(res));
+
+    // The aggregation reads at the last applied timestamp, before the paused batch.
+    res = assert.commandWorked(secondaryDB.runCommand({
+        aggregate: collName,
+        pipeline: [{$lookup: {from: "other", localField: "x", foreignField: "x", as: "o"}}],
+        cursor: {},
+        maxTimeMS: kTimeoutMS
+    }));
+    assert.eq(1, res.cursor.firstBatch.length, tojson(res));
+
+    secondaryReadsTest.resumeSecondaryBatchApplication();
+    secondaryReadsTest.stop();
+})();
@@ -0,0 +1,85 @@
+/**
+ * Test that a transaction whose operations exceed 'transactionOplogEntrySizeLimitBytes' is written
+ * as a chain of applyOps oplog entries, and that secondaries apply the whole chain.
+ *
+ * @tags: [uses_transactions]
+ */
+(function() {
+    "use strict";
+
+    const dbName = "test";
+    const collName = "transaction_split_oplog_entries";
+
+    const rst = new ReplSetTest({
+        name: collName,
+        nodes: [{}, {rsConfig: {priority: 0}}],
+        nodeOptions: {setParameter: {transactionOplogEntrySizeLimitBytes: 1024}}
+    });
+    rst.startSet();
+    rst.initiate();
+
+    const primary = rst.getPrimary();
+    const secondary = rst.getSecondary();
+    const testDB = primary.getDB(dbName);
+    assert.commandWorked(testDB.runCommand({create: collName, writeConcern: {w: "majority"}}));
+
+    const session = primary.startSession();
+    const sessionColl = session.getDatabase(dbName).getCollection(collName);
+    const kNumDocs = 20;
+    const padding = "x".repeat(200);
+
+    session.startTransaction();
+    for (let i = 0; i < kNumDocs; ++i) {
+        assert.commandWorked(sessionColl.insert({_id: i, padding: padding}));
+    }
+    session.commitTransaction();
+
+    // The final entry of the transaction is the one recorded in the transaction table. Walking its
+    // 'prevOpTime' chain back reaches every entry of the transaction.
+    const oplog = primary.getDB("local").oplog.rs;
+    const txnRecord =
+        primary.getDB("config").transactions.findOne({"_id.id": session.getSessionId().id});
+    assert.neq(null, txnRecord);
+    assert.eq("committed", txnRecord.state, tojson(txnRecord));
+
+    let entries = [];
+    let opTime = txnRecord.lastWriteOpTime;
+    while (opTime.ts.getTime() !== 0) {
+        const entry = oplog.findOne({ts: opTime.ts});
+        assert.neq(null, entry, tojson(opTime));
+        entries.unshift(entry);
+        opTime = entry.prevOpTime;
+    }
+    assert.gt(entries.length, 1, tojson(entries));
+
+    let numOps = 0;
+    entries.forEach(function(entry, i) {
+        assert.eq(i, entry.stmtId, tojson(entry));
+        assert.eq(i < entries.length - 1, entry.o.partialTxn === true, tojson(entry));
+        assert.lte(Object.bsonsize({applyOps: entry.o.applyOps}), 1024 + 200, tojson(entry));
+        numOps += entry.o.applyOps.length;
+    });
+    assert.eq(kNumDocs, numOps);
+
+    // The secondary applies every operation of the transaction and records the final entry in its
+    // transaction table.
+    rst.awaitReplication();
+    assert.eq(kNumDocs, secondary.getDB(dbName).getCollection(collName).find().itcount());
+    const secondaryTxnRecord =
+        secondary.getDB("config").transactions.findOne({"_id.id": session.getSessionId().id});
+    assert.eq(txnRecord.lastWriteOpTime, secondaryTxnRecord.lastWriteOpTime);
+    assert.eq("committed", secondaryTxnRecord.state, tojson(secondaryTxnRecord));
+
+    // A small transaction is still written as a single entry.
+    session.startTransaction();
+    assert.commandWorked(sessionColl.insert({_id: kNumDocs}));
+    session.commitTransaction();
+    const smallTxnRecord =
+        primary.getDB("config").transactions.findOne({"_id.id": session.getSessionId().id});
+    const smallEntry = oplog.findOne({ts: smallTxnRecord.lastWriteOpTime.ts});
+    assert.eq(undefined, smallEntry.o.partialTxn, tojson(smallEntry));
+    assert.eq(0, smallEntry.prevOpTime.ts.getTime(), tojson(smallEntry));
+
+    session.endSession();
+    rst.stopSet();
+}());
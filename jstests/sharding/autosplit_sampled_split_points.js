@@ -0,0 +1,52 @@
+/**
+ * Tests that the autosplitter estimates the split points of a chunk from sampled documents when a
+ * full chunk holds many documents, and that chunks still split when sampling is turned off.
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+    'use strict';
+    load('jstests/libs/check_log.js');
+    load('jstests/sharding/autosplit_include.js');
+
+    const st = new ShardingTest({
+        shards: 1,
+        mongos: 1,
+        other: {
+            chunkSize: 1,
+            enableAutoSplit: true,
+            shardOptions: {setParameter: {splitVectorMaxSampledDocs: 2000}}
+        }
+    });
+
+    const mongos = st.s0;
+    const config = mongos.getDB("config");
+    const shard = st.shard0;
+    assert.commandWorked(mongos.adminCommand({enableSharding: "test"}));
+    assert.commandWorked(
+        shard.adminCommand({setParameter: 1, logComponentVerbosity: {sharding: {verbosity: 1}}}));
+
+    // A 1MB chunk of these documents holds far more of them than 2000.
+    function insertUntilSplit(coll) {
+        assert.commandWorked(mongos.adminCommand({shardCollection: coll + "", key: {x: 1}}));
+        let i = 0;
+        while (config.chunks.count({ns: coll + ""}) === 1) {
+            assert.lt(i, 400000, "chunk was not split");
+            const bulk = coll.initializeUnorderedBulkOp();
+            for (let j = 0; j < 10000; j++, i++) {
+                bulk.insert({x: i});
+            }
+            assert.writeOK(bulk.execute());
+            waitForOngoingChunkSplits(st);
+        }
+    }
+
+    insertUntilSplit(mongos.getCollection("test.sampled"));
+    checkLog.contains(shard, "split points for chunk test.sampled");
+
+    assert.commandWorked(shard.adminCommand({setParameter: 1, autoSplitSampleSplitPoints: false}));
+    insertUntilSplit(mongos.getCollection("test.scanned"));
+    const log = assert.commandWorked(shard.adminCommand({getLog: "global"})).log;
+    assert(!log.some(line => line.includes("split points for chunk test.scanned")), tojson(log));
+
+    st.stop();
+})();
@@ -0,0 +1,63 @@
+// Tests that a sharded change stream returns events from one shard while another shard's oplog is
+// idle, without relying on the periodic no-op writer, because primaries with an idle oplog report
+// their cluster time as the progress of their oplog scans.
+// @tags: [uses_change_streams]
+(function() {
+    "use strict";
+
+    // For supportsMajorityReadConcern().
+    load("jstests/multiVersion/libs/causal_consistency_helpers.js");
+
+    if (!supportsMajorityReadConcern()) {
+        jsTestLog("Skipping test since storage engine doesn't support majority read concern.");
+        return;
+    }
+
+    const st = new ShardingTest({
+        shards: 2,
+        rs: {nodes: 1, enableMajorityReadConcern: '', setParameter: {writePeriodicNoops: false}}
+    });
+
+    const mongosDB = st.s0.getDB(jsTestName());
+    const mongosColl = mongosDB[jsTestName()];
+
+    assert.commandWorked(mongosDB.adminCommand({enableSharding: mongosDB.getName()}));
+    st.ensurePrimaryShard(mongosDB.getName(), st.rs0.getURL());
+    assert.commandWorked(
+        mongosDB.adminCommand({shardCollection: mongosColl.getFullName(), key: {_id: 1}}));
+    assert.commandWorked(
+        mongosDB.adminCommand({split: mongosColl.getFullName(), middle: {_id: 0}}));
+    assert.commandWorked(mongosDB.adminCommand(
+        {moveChunk: mongosColl.getFullName(), find: {_id: 1}, to: st.rs1.getURL()}));
+
+    function setReportIdleOplogClusterTime(value) {
+        for (let rs of [st.rs0, st.rs1]) {
+            assert.commandWorked(rs.getPrimary().adminCommand(
+                {setParameter: 1, reportIdleOplogClusterTime: value}));
+        }
+    }
+
+    // Only shard 1 is written to; shard 0 stays idle and has no no-op writes to advance it.
+    let changeStream = mongosColl.watch([], {maxAwaitTimeMS: 500});
+    assert.writeOK(mongosColl.insert({_id: 1}, {writeConcern: {w: "majority"}}));
+    assert.soon(() => changeStream.hasNext(), "expected to see the insert on shard 1");
+    assert.eq({_id: 1}, changeStream.next().documentKey);
+    changeStream.close();
+
+    // Without the idle shard's progress, the same stream cannot return the event.
+    setReportIdleOplogClusterTime(false);
+    changeStream = mongosColl.watch([], {maxAwaitTimeMS: 500});
+    assert.writeOK(mongosColl.insert({_id: 2}, {writeConcern: {w: "majority"}}));
+    const deadline = Date.now() + 3000;
+    while (Date.now() < deadline) {
+        assert(!changeStream.hasNext(), "returned an event without shard 0 reporting progress");
+    }
+
+    // Once the idle shard reports its progress again, the event is returned.
+    setReportIdleOplogClusterTime(true);
+    assert.soon(() => changeStream.hasNext(), "expected to see the insert once shard 0 reports");
+    assert.eq({_id: 2}, changeStream.next().documentKey);
+    changeStream.close();
+
+    st.stop();
+})();
@@ -0,0 +1,65 @@
+/**
+ * Tests that shards report the writes to their chunks through _shardsvrGetChunkLoadStatistics,
+ * which the balancer uses when balancerLoadImbalanceThreshold is set.
+ */
+(function() {
+    'use strict';
+
+    const st = new ShardingTest({shards: 1, rs: {nodes: 1}});
+
+    const mongosDB = st.s.getDB('test');
+    const coll = mongosDB.chunk_load_statistics;
+
+    st.shardColl(coll, {a: 1}, {a: 100}, false, mongosDB.getName());
+
+    const shardAdmin = st.rs0.getPrimary().getDB('admin');
+
+    // Returns the reported chunks of the test collection, ignoring other sharded collections such
+    // as config.system.sessions.
+    function reportedChunks(res) {
+        const entries = res.collections.filter(entry => entry.ns === coll.getFullName());
+        assert.lte(entries.length, 1, tojson(res));
+        return entries.length ? entries[0].chunks : [];
+    }
+
+    // The first report starts the measurement.
+    let res = assert.commandWorked(shardAdmin.runCommand({_shardsvrGetChunkLoadStatistics: 1}));
+    assert.eq(0, res.windowMillis, tojson(res));
+    assert.eq([], reportedChunks(res), tojson(res));
+
+    // Write more to the upper chunk than to the lower one.
+    for (let i = 0; i < 10; ++i) {
+        assert.writeOK(coll.insert({a: 100 + i}));
+    }
+    assert.writeOK(coll.insert({a: 0}));
+    assert.writeOK(coll.update({a: 100}, {$set: {b: 1}}));
+    assert.writeOK(coll.remove({a: 101}));
+
+    res = assert.commandWorked(shardAdmin.runCommand({_shardsvrGetChunkLoadStatistics: 1}));
+    assert.gt(res.ops, 0, tojson(res));
+    assert.gt(res.bytes, 0, tojson(res));
+
+    const chunks = reportedChunks(res);
+    assert.eq(2, chunks.length, tojson(res));
+    assert.eq({a: 100}, chunks[0].min, tojson(res));
+    assert.eq(12, chunks[0].ops, tojson(res));
+    assert.eq({a: MinKey}, chunks[1].min, tojson(res));
+    assert.eq(1, chunks[1].ops, tojson(res));
+
+    // The statistics were reset by the previous report.
+    res = assert.commandWorked(shardAdmin.runCommand(
+        {_shardsvrGetChunkLoadStatistics: 1, maxChunksPerCollection: 1}));
+    assert.eq([], reportedChunks(res), tojson(res));
+
+    // The command is only available on shards.
+    assert.commandFailed(st.s.adminCommand({_shardsvrGetChunkLoadStatistics: 1}));
+
+    // Load balancing can be turned on on the config server.
+    assert.commandWorked(st.configRS.getPrimary().adminCommand(
+        {setParameter: 1, balancerLoadImbalanceThreshold: 2}));
+    assert.commandFailedWithCode(st.configRS.getPrimary().adminCommand(
+                                     {setParameter: 1, balancerLoadImbalanceThreshold: 0.5}),
+                                 ErrorCodes.BadValue);
+
+    st.stop();
+}());
@@ -0,0 +1,67 @@
+// Tests that when maxConcurrentChunkMigrationsPerShard is raised, a shard can donate chunks of
+// different collections at the same time, and that throttled cloning still completes.
+
+load('./jstests/libs/chunk_manipulation_util.js');
+
+(function() {
+    'use strict';
+
+    var staticMongod = MongoRunner.runMongod({});  // For startParallelOps.
+
+    var st = new ShardingTest({mongos: 1, shards: 3});
+    assert.commandWorked(st.s0.adminCommand({enableSharding: 'TestDB'}));
+    st.ensurePrimaryShard('TestDB', st.shard0.shardName);
+
+    var testDB = st.s0.getDB('TestDB');
+
+    ['Coll0', 'Coll1'].forEach(function(collName) {
+        var ns = 'TestDB.' + collName;
+        assert.commandWorked(st.s0.adminCommand({shardCollection: ns, key: {Key: 1}}));
+        assert.commandWorked(st.s0.adminCommand({split: ns, middle: {Key: 0}}));
+
+        var bulk = testDB[collName].initializeUnorderedBulkOp();
+        for (var i = -100; i < 100; i++) {
+            bulk.insert({Key: i, Value: 'x'.repeat(1024)});
+        }
+        assert.writeOK(bulk.execute());
+    });
+
+    assert.commandWorked(st.shard0.adminCommand({
+        setParameter: 1,
+        maxConcurrentChunkMigrationsPerShard: 2,
+        migrationCloneMaxBytesPerSec: 1 << 20
+    }));
+
+    // Returns the number of moveChunk operations on the donor, which reached the specified step
+    function numMoveChunksAtStep(stepNumber) {
+        const stepOps = st.shard0.getDB('admin').aggregate([
+            {$currentOp: {allUsers: true}},
+            {$match: {'command.moveChunk': {$exists: true}, msg: {$regex: '^step ' + stepNumber}}}
+        ]);
+        return stepOps.itcount();
+    }
+
+    pauseMoveChunkAtStep(st.shard0, moveChunkStepNames.reachedSteadyState);
+
+    var joinMoveChunk0 = moveChunkParallel(
+        staticMongod, st.s0.host, {Key: 1}, null, 'TestDB.Coll0', st.shard1.shardName);
+    var joinMoveChunk1 = moveChunkParallel(
+        staticMongod, st.s0.host, {Key: 1}, null, 'TestDB.Coll1', st.shard2.shardName);
+
+    assert.soon(function() {
+        return numMoveChunksAtStep(moveChunkStepNames.reachedSteadyState) === 2;
+    });
+
+    unpauseMoveChunkAtStep(st.shard0, moveChunkStepNames.reachedSteadyState);
+
+    joinMoveChunk0();
+    joinMoveChunk1();
+
+    assert.eq(200, testDB.Coll0.find().itcount());
+    assert.eq(200, testDB.Coll1.find().itcount());
+    assert.eq(100, st.shard1.getDB('TestDB').Coll0.find().itcount());
+    assert.eq(100, st.shard2.getDB('TestDB').Coll1.find().itcount());
+
+    st.stop();
+    MongoRunner.stopMongod(staticMongod);
+})();
@@ -0,0 +1,58 @@
+/**
+ * Tests that when internalQueryMaxGroupExchangeConsumers is set, the merging half of a $group is
+ * partitioned by group key across several shards, and that the results match those of a $group
+ * completed by a single merger.
+ */
+(function() {
+    'use strict';
+
+    const st = new ShardingTest({shards: 3, rs: {nodes: 1}});
+
+    const mongosDB = st.s.getDB('test');
+    const coll = mongosDB.group_exchange;
+
+    st.shardColl(coll, {a: 1}, {a: 100}, {a: 100}, mongosDB.getName());
+    assert.commandWorked(mongosDB.adminCommand(
+        {moveChunk: coll.getFullName(), find: {a: 0}, to: st.shard2.shardName}));
+
+    // Spread every group across the shards, and give equal group keys different numeric types.
+    let bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 300; ++i) {
+        bulk.insert({a: i, k: (i % 2 === 0 ? NumberInt(i % 17) : i % 17), v: i});
+    }
+    assert.commandWorked(bulk.execute());
+
+    const pipeline = [
+        {$group: {_id: '$k', total: {$sum: '$v'}, avg: {$avg: '$v'}, count: {$sum: 1}}},
+        {$match: {count: {$gt: 10}}},
+        {$sort: {_id: 1}}
+    ];
+
+    const expected = coll.aggregate(pipeline).toArray();
+    assert.eq(17, expected.length, tojson(expected));
+
+    assert.commandWorked(
+        mongosDB.adminCommand({setParameter: 1, internalQueryMaxGroupExchangeConsumers: 3}));
+
+    const explain = coll.explain().aggregate(pipeline);
+    assert.eq('exchange', explain.mergeType, tojson(explain));
+    assert.eq('keyRange', explain.splitPipeline.exchange.policy, tojson(explain));
+    assert.eq({_id: 'hashed'}, explain.splitPipeline.exchange.key, tojson(explain));
+    assert.eq(3, explain.splitPipeline.exchange.consumerShards.length, tojson(explain));
+
+    assert.eq(expected, coll.aggregate(pipeline).toArray());
+
+    // Stages which need the whole stream are left to the final merge.
+    assert.eq(expected.slice(0, 5),
+              coll.aggregate(pipeline.concat([{$limit: 5}]), {cursor: {batchSize: 2}}).toArray());
+
+    // A non-simple collation falls back to a single merger.
+    const collated =
+        coll.explain().aggregate(pipeline, {collation: {locale: 'en_US', strength: 2}});
+    assert.neq('exchange', collated.mergeType, tojson(collated));
+
+    assert.commandWorked(
+        mongosDB.adminCommand({setParameter: 1, internalQueryMaxGroupExchangeConsumers: 0}));
+
+    st.stop();
+}());
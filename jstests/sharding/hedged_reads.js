@@ -0,0 +1,50 @@
+// Tests that reads which mongos hedges to a second secondary of the shards return the same results
+// as unhedged reads, including for cursors which need getMores on the host which answered.
+(function() {
+    'use strict';
+
+    var st = new ShardingTest({
+        shards: {rs0: {nodes: 3}, rs1: {nodes: 3}},
+        mongos: 1,
+        other: {
+            mongosOptions: {
+                setParameter: {
+                    readHedgingEnabled: true,
+                    readHedgingDelayPercentile: 1,
+                    readHedgingMinDelayMS: 0
+                }
+            }
+        }
+    });
+
+    var testDB = st.s0.getDB('test');
+    assert.commandWorked(st.s0.adminCommand({enableSharding: 'test'}));
+    st.ensurePrimaryShard('test', st.shard0.shardName);
+    assert.commandWorked(st.s0.adminCommand({shardCollection: 'test.user', key: {x: 1}}));
+    assert.commandWorked(st.s0.adminCommand({split: 'test.user', middle: {x: 50}}));
+    assert.commandWorked(
+        st.s0.adminCommand({moveChunk: 'test.user', find: {x: 50}, to: st.shard1.shardName}));
+
+    var bulk = testDB.user.initializeUnorderedBulkOp();
+    for (var i = 0; i < 100; i++) {
+        bulk.insert({x: i, y: i % 7});
+    }
+    assert.writeOK(bulk.execute({w: 3}));
+
+    // The first reads record the latencies from which the hedging delay is computed; with the
+    // lowest percentile and no minimum delay most of the following ones are hedged.
+    for (var round = 0; round < 50; round++) {
+        assert.eq(100, testDB.user.find().readPref('secondary').batchSize(7).itcount());
+        assert.eq(50, testDB.user.find({x: {$gte: 50}}).readPref('secondary').itcount());
+        assert.eq(100, testDB.user.find().readPref('secondary').count());
+
+        var distinct = assert.commandWorked(
+            testDB.runCommand({distinct: 'user', key: 'y', $readPreference: {mode: 'nearest'}}));
+        assert.eq(7, distinct.values.length, tojson(distinct));
+    }
+
+    // Reads from primaries are never hedged and still succeed.
+    assert.eq(100, testDB.user.find().readPref('primary').itcount());
+
+    st.stop();
+})();
@@ -0,0 +1,79 @@
+// Tests that reshardCollection changes the shard key of a collection while writes to it continue,
+// without losing or duplicating any document.
+load('jstests/libs/parallelTester.js');
+
+(function() {
+    'use strict';
+
+    var s = new ShardingTest({shards: 3, other: {enableBalancer: false}});
+
+    var dbname = "test";
+    var ns = dbname + ".foo";
+    var db = s.getDB(dbname);
+
+    assert.commandWorked(db.adminCommand({enablesharding: dbname}));
+    s.ensurePrimaryShard(dbname, s.shard0.shardName);
+    assert.commandWorked(db.adminCommand({shardcollection: ns, key: {a: 1}}));
+    assert.commandWorked(db.adminCommand({split: ns, middle: {a: 500}}));
+    assert.commandWorked(
+        db.adminCommand({moveChunk: ns, find: {a: 500}, to: s.shard1.shardName}));
+
+    var bulk = db.foo.initializeUnorderedBulkOp();
+    for (var i = 0; i < 1000; i++) {
+        bulk.insert({_id: i, a: i, b: (i * 7) % 1000, c: 0});
+    }
+    assert.writeOK(bulk.execute());
+    assert.commandWorked(db.foo.createIndex({c: 1}));
+
+    var oldEpoch = s.config.collections.findOne({_id: ns}).lastmodEpoch;
+
+    // Keep writing to the collection while it is resharded.
+    var writer = new ScopedThread(function(host, ns, stopAt) {
+        var coll = new Mongo(host).getCollection(ns);
+        var i = 0;
+        while (Date.now() < stopAt) {
+            assert.writeOK(coll.update({_id: i % 1000}, {$inc: {c: 1}}));
+            assert.writeOK(coll.insert({_id: 1000 + i, a: 1000 + i, b: 1000 + i, c: 1}));
+            assert.writeOK(coll.remove({_id: 1000 + i}));
+            i++;
+        }
+        return i;
+    }, s.s0.host, ns, Date.now() + 5 * 1000);
+    writer.start();
+
+    assert.commandWorked(db.adminCommand({reshardCollection: ns, key: {b: 1}}));
+
+    writer.join();
+    var numWrites = writer.returnData();
+
+    var coll = s.config.collections.findOne({_id: ns});
+    assert.eq({b: 1}, coll.key, tojson(coll));
+    assert.neq(oldEpoch, coll.lastmodEpoch, tojson(coll));
+    assert.eq(null, s.config.collections.findOne({_id: dbname + ".tmp.reshard.foo"}));
+    assert.eq(0, s.config.chunks.count({ns: dbname + ".tmp.reshard.foo"}));
+    assert.eq(0, s.config.chunks.count({ns: ns, min: {a: MinKey}}));
+    assert.lt(1, s.config.chunks.count({ns: ns}));
+
+    // Every document is still there exactly once, including the writes made during resharding.
+    assert.eq(1000, db.foo.find().itcount());
+    var totalIncrements = 0;
+    db.foo.find().forEach(function(doc) {
+        totalIncrements += doc.c;
+    });
+    assert.eq(numWrites, totalIncrements);
+
+    // The documents are spread by the new key and the indexes were kept.
+    assert.eq(1, db.foo.find({b: 42}).itcount());
+    assert.eq(1, db.foo.find({b: 42}).explain().queryPlanner.winningPlan.shards.length);
+    assert(db.foo.getIndexes().some(index => bsonWoCompare(index.key, {c: 1}) === 0));
+
+    // Resharding by the current key or an unsharded collection is not allowed.
+    assert.commandFailedWithCode(db.adminCommand({reshardCollection: ns, key: {b: 1}}),
+                                 ErrorCodes.InvalidOptions);
+    assert.writeOK(db.bar.insert({a: 0}));
+    assert.commandFailedWithCode(
+        db.adminCommand({reshardCollection: dbname + ".bar", key: {a: 1}}),
+        ErrorCodes.NamespaceNotSharded);
+
+    s.stop();
+})();
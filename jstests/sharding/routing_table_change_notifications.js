@@ -0,0 +1,45 @@
+// Tests that with routingTableChangeNotificationsEnabled, a mongos refreshes its cached routing
+// table as soon as a chunk is migrated through another mongos, so that its next request is not
+// routed with the stale routing table.
+(function() {
+    'use strict';
+
+    var st = new ShardingTest({
+        shards: 2,
+        mongos: 2,
+        other: {mongosOptions: {setParameter: {routingTableChangeNotificationsEnabled: true}}}
+    });
+
+    var testNs = 'test.foo';
+    assert.commandWorked(st.s0.adminCommand({enableSharding: 'test'}));
+    st.ensurePrimaryShard('test', st.shard0.shardName);
+    assert.commandWorked(st.s0.adminCommand({shardCollection: testNs, key: {_id: 1}}));
+    assert.commandWorked(st.s0.adminCommand({split: testNs, middle: {_id: 0}}));
+    assert.writeOK(st.s0.getCollection(testNs).insert({_id: -1}));
+    assert.writeOK(st.s0.getCollection(testNs).insert({_id: 1}));
+
+    // Load the routing table on the second mongos.
+    assert.eq(2, st.s1.getCollection(testNs).find().itcount());
+
+    function catalogCacheStats() {
+        return assert.commandWorked(st.s1.adminCommand({serverStatus: 1}))
+            .shardingStatistics.catalogCache;
+    }
+    var before = catalogCacheStats();
+
+    assert.commandWorked(st.s0.adminCommand(
+        {moveChunk: testNs, find: {_id: 1}, to: st.shard1.shardName, _waitForDelete: true}));
+
+    // The second mongos starts refreshing without having been sent a request.
+    assert.soon(function() {
+        return catalogCacheStats().countRefreshesStartedByChangeNotifications >
+            before.countRefreshesStartedByChangeNotifications;
+    });
+
+    // So its next request is routed with the new routing table right away.
+    var staleConfigErrors = catalogCacheStats().countStaleConfigErrors;
+    assert.eq(1, st.s1.getCollection(testNs).find({_id: 1}).itcount());
+    assert.eq(staleConfigErrors, catalogCacheStats().countStaleConfigErrors);
+
+    st.stop();
+})();
@@ -0,0 +1,55 @@
+// Tests that shardCollection with a presplitSample creates initial chunks whose bounds are computed
+// from the sample and distributes them across the shards before any data is loaded.
+(function() {
+    'use strict';
+
+    var s = new ShardingTest({shards: 3});
+
+    var dbname = "test";
+    var db = s.getDB(dbname);
+
+    assert.commandWorked(db.adminCommand({enablesharding: dbname}));
+    s.ensurePrimaryShard(dbname, s.shard1.shardName);
+
+    var sample = [];
+    for (var i = 0; i < 600; i++) {
+        sample.push({_id: i, a: i * 10});
+    }
+
+    assert.commandWorked(db.adminCommand({
+        shardcollection: dbname + ".foo",
+        key: {a: 1},
+        numInitialChunks: 6,
+        presplitSample: sample
+    }));
+
+    assert.eq(6, s.config.chunks.count({ns: "test.foo"}));
+    s.config.shards.find().forEach(function(shard) {
+        assert.eq(2, s.config.chunks.count({ns: "test.foo", shard: shard._id}), tojson(shard));
+    });
+    assert.eq(1, s.config.chunks.count({ns: "test.foo", min: {a: 1000}, max: {a: 2000}}));
+
+    // Loading the sampled data spreads it evenly across the shards without any migrations.
+    var bulk = db.foo.initializeUnorderedBulkOp();
+    for (var i = 0; i < 600; i++) {
+        bulk.insert({_id: i, a: i * 10});
+    }
+    assert.writeOK(bulk.execute());
+    [s.shard0, s.shard1, s.shard2].forEach(function(shard) {
+        assert.eq(200, shard.getDB(dbname).foo.find().itcount(), shard.shardName);
+    });
+
+    // Pre-splitting a collection which already contains data is not allowed.
+    assert.writeOK(db.bar.insert({a: 0}));
+    assert.commandFailedWithCode(
+        db.adminCommand({shardcollection: dbname + ".bar", key: {a: 1}, presplitSample: sample}),
+        ErrorCodes.InvalidOptions);
+
+    // Hashed shard keys are always pre-split evenly.
+    assert.commandFailedWithCode(
+        db.adminCommand(
+            {shardcollection: dbname + ".baz", key: {a: "hashed"}, presplitSample: sample}),
+        ErrorCodes.InvalidOptions);
+
+    s.stop();
+})();
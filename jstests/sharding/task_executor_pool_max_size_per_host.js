@@ -0,0 +1,62 @@
+// Tests that ShardingTaskExecutorPoolMaxSizePerHost bounds the connections from all the sharding
+// task executor pools of a mongos to a shard, and that requests beyond it queue rather than fail.
+(function() {
+    'use strict';
+
+    var st = new ShardingTest({
+        shards: 1,
+        mongos: 1,
+        other: {
+            mongosOptions: {
+                setParameter: {taskExecutorPoolSize: 2, ShardingTaskExecutorPoolMaxSizePerHost: 2}
+            }
+        }
+    });
+
+    var testDB = st.s0.getDB('test');
+    assert.writeOK(testDB.coll.insert({_id: 0}));
+
+    function checkPoolSizes() {
+        var stats = assert.commandWorked(st.s0.adminCommand({connPoolStats: 1}));
+        Object.keys(stats.pools).forEach(function(poolName) {
+            if (poolName.indexOf('TaskExecutorPool-') < 0) {
+                return;
+            }
+            var pool = stats.pools[poolName];
+            Object.keys(pool).forEach(function(host) {
+                if (typeof pool[host] !== 'object') {
+                    return;
+                }
+                // Each of the two pools gets one of the two connections allowed per host.
+                var open = pool[host].inUse + pool[host].available + pool[host].refreshing;
+                assert.lte(open, 1, poolName + ' ' + host + ': ' + tojson(stats));
+            });
+        });
+    }
+
+    var awaitShells = [];
+    for (var i = 0; i < 6; i++) {
+        awaitShells.push(startParallelShell(function() {
+            for (var j = 0; j < 5; j++) {
+                assert.eq(1, db.getSiblingDB('test').coll.find({
+                    $where: function() {
+                        sleep(100);
+                        return true;
+                    }
+                }).itcount());
+            }
+        }, st.s0.port));
+    }
+
+    for (var k = 0; k < 10; k++) {
+        checkPoolSizes();
+        sleep(200);
+    }
+
+    awaitShells.forEach(function(awaitShell) {
+        awaitShell();
+    });
+    checkPoolSizes();
+
+    st.stop();
+})();
@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_field_index.h"
+
+#include <string>
+
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+struct BSONFieldIndex::Shape {
+    // The field names in document order, to tell apart shapes whose hashes collide.
+    std::vector<std::string> fieldNames;
+
+    // The position of the first field with each name.
+    StringMap<std::size_t> positions;
+};
+
+namespace {
+
+using ShapeCache = LRUCache<uint64_t, std::shared_ptr<const BSONFieldIndex::Shape>>;
+
+ShapeCache& shapeCacheForThisThread() {
+    static thread_local ShapeCache cache(BSONFieldIndex::kShapeCacheSize);
+    return cache;
+}
+
+// FNV-1a over the field names, each followed by its terminating NUL so that {ab: 1, c: 1} and
+// {a: 1, bc: 1} hash differently.
+uint64_t hashFieldName(uint64_t hash, StringData name) {
+    const uint64_t kPrime = 1099511628211ULL;
+    for (char c : name) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * kPrime;
+    }
+    return hash * kPrime;
+}
+
+bool hasFieldNames(const BSONFieldIndex::Shape& shape, const std::vector<BSONElement>& elements) {
+    if (shape.fieldNames.size() != elements.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < elements.size(); i++) {
+        if (elements[i].fieldNameStringData() != shape.fieldNames[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+constexpr int BSONFieldIndex::kMinLookups;
+constexpr std::size_t BSONFieldIndex::kShapeCacheSize;
+
+BSONFieldIndex::BSONFieldIndex(const BSONObj& obj) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto&& elem : obj) {
+        _elements.push_back(elem);
+        hash = hashFieldName(hash, elem.fieldNameStringData());
+    }
+
+    auto& cache = shapeCacheForThisThread();
+    auto it = cache.find(hash);
+    if (it != cache.end() && hasFieldNames(*it->second, _elements)) {
+        _shape = it->second;
+        return;
+    }
+
+    auto shape = std::make_shared<Shape>();
+    shape->fieldNames.reserve(_elements.size());
+    for (std::size_t i = 0; i < _elements.size(); i++) {
+        auto name = _elements[i].fieldNameStringData();
+        shape->fieldNames.push_back(name.toString());
+        if (shape->positions.find(name) == shape->positions.end()) {
+            shape->positions[name] = i;
+        }
+    }
+    _shape = shape;
+    cache.add(hash, std::move(shape));
+}
+
+BSONFieldIndex::~BSONFieldIndex() = default;
+
+BSONElement BSONFieldIndex::getField(StringData name) const {
+    auto it = _shape->positions.find(name);
+    if (it == _shape->positions.end()) {
+        return BSONElement();
+    }
+    return _elements[it->second];
+}
+
+}  // namespace mongo
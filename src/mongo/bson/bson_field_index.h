@@ -0,0 +1,83 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * Indexes the top-level fields of one BSONObj by name, so that looking up several fields of the
+ * same document costs a single pass over it rather than a linear scan per field.
+ *
+ * Documents in a collection tend to share a few shapes, i.e. sequences of field names. The table
+ * from field name to position is built once per shape and kept in a small per-thread LRU cache
+ * keyed by a hash of the field names, so indexing a document of an already seen shape only walks
+ * its elements once. The indexed BSONObj must outlive the BSONFieldIndex.
+ */
+class BSONFieldIndex {
+    MONGO_DISALLOW_COPYING(BSONFieldIndex);
+
+public:
+    /**
+     * Below this many lookups on one document, BSONObj::getField() is cheaper than building an
+     * index.
+     */
+    static constexpr int kMinLookups = 3;
+
+    /**
+     * The number of shapes each thread remembers.
+     */
+    static constexpr std::size_t kShapeCacheSize = 16;
+
+    struct Shape;
+
+    explicit BSONFieldIndex(const BSONObj& obj);
+    ~BSONFieldIndex();
+
+    /**
+     * Returns the first top-level field named 'name', or an EOO element if there is no such
+     * field. This is the same element BSONObj::getField() would return.
+     */
+    BSONElement getField(StringData name) const;
+
+private:
+    std::vector<BSONElement> _elements;
+    std::shared_ptr<const Shape> _shape;
+};
+
+}  // namespace mongo
@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_field_index.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(BSONFieldIndexTest, FindsTheSameElementsAsGetField) {
+    BSONObj obj = BSON("a" << 1 << "b"
+                           << "two"
+                           << "c"
+                           << BSON("d" << 3)
+                           << ""
+                           << 4);
+    BSONFieldIndex index(obj);
+    for (StringData name : {"a"_sd, "b"_sd, "c"_sd, ""_sd}) {
+        ASSERT_EQ(obj.getField(name).rawdata(), index.getField(name).rawdata());
+    }
+    ASSERT(index.getField("d").eoo());
+    ASSERT(index.getField("c.d").eoo());
+}
+
+TEST(BSONFieldIndexTest, ReturnsFirstOfDuplicateFields) {
+    BSONObj obj = BSON("a" << 1 << "a" << 2);
+    BSONFieldIndex index(obj);
+    ASSERT_EQ(1, index.getField("a").numberInt());
+}
+
+TEST(BSONFieldIndexTest, EmptyObject) {
+    BSONFieldIndex index(BSONObj{});
+    ASSERT(index.getField("a").eoo());
+}
+
+TEST(BSONFieldIndexTest, DocumentsOfTheSameShapeUseTheirOwnElements) {
+    BSONObj first = BSON("a" << 1 << "b"
+                             << "short");
+    BSONObj second = BSON("a" << 2 << "b"
+                              << "a much longer string");
+    BSONFieldIndex firstIndex(first);
+    BSONFieldIndex secondIndex(second);
+    ASSERT_EQ(1, firstIndex.getField("a").numberInt());
+    ASSERT_EQ("short", firstIndex.getField("b").valueStringData());
+    ASSERT_EQ(2, secondIndex.getField("a").numberInt());
+    ASSERT_EQ("a much longer string", secondIndex.getField("b").valueStringData());
+}
+
+TEST(BSONFieldIndexTest, SplittingFieldNamesDifferentlyIsADifferentShape) {
+    BSONObj first = BSON("ab" << 1 << "c" << 2);
+    BSONObj second = BSON("a" << 1 << "bc" << 2);
+    BSONFieldIndex firstIndex(first);
+    BSONFieldIndex secondIndex(second);
+    ASSERT(secondIndex.getField("ab").eoo());
+    ASSERT_EQ(2, secondIndex.getField("bc").numberInt());
+    ASSERT_EQ(1, firstIndex.getField("ab").numberInt());
+}
+
+TEST(BSONFieldIndexTest, ShapesEvictedFromTheCacheRemainUsable) {
+    BSONObj obj = BSON("x" << 1);
+    BSONFieldIndex index(obj);
+    for (std::size_t i = 0; i <= BSONFieldIndex::kShapeCacheSize; i++) {
+        BSONObj other = BSON(std::to_string(i) << 1);
+        BSONFieldIndex otherIndex(other);
+        ASSERT_EQ(1, otherIndex.getField(std::to_string(i)).numberInt());
+    }
+    ASSERT_EQ(1, index.getField("x").numberInt());
+}
+
+}  // namespace
+}  // namespace mongo
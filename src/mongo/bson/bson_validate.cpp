@@ -35,6 +35,7 @@
 #include "mongo/bson/bson_depth.h"
 #include "mongo/bson/bson_validate.h"
 #include "mongo/bson/oid.h"
+#include "mongo/db/fts/unicode/byte_vector.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/platform/decimal128.h"
@@ -67,6 +68,29 @@ Status NOINLINE_DECL makeError(StringData baseMsg, BSONElement idElem, StringDat
     return Status(ErrorCodes::InvalidBSON, msg);
 }
 
+/**
+ * Returns a pointer to the first NUL byte in the 'len' bytes starting at 'ptr', or nullptr if there
+ * is none.
+ *
+ * Field names are typically shorter than a vector register, so where vector instructions are
+ * available the bytes are scanned in-line a vector at a time. This avoids the call overhead of
+ * memchr() for every element. memchr() only handles a tail shorter than a vector.
+ */
+inline const char* findNul(const char* ptr, uint64_t len) {
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+    using unicode::ByteVector;
+    while (len >= static_cast<uint64_t>(ByteVector::size)) {
+        const auto mask = ByteVector::load(ptr).compareEQ(0).maskAny();
+        if (mask) {
+            return ptr + ByteVector::countInitialZeros(mask);
+        }
+        ptr += ByteVector::size;
+        len -= ByteVector::size;
+    }
+#endif
+    return static_cast<const char*>(memchr(ptr, 0, len));
+}
+
 class Buffer {
 public:
     Buffer(const char* buffer, uint64_t maxLength, BSONVersion version)
@@ -89,10 +113,10 @@ public:
      * reading, if it exists. Otherwise, it should be empty.
      */
     Status readCString(StringData elemName, StringData* out) {
-        const void* x = memchr(_buffer + _position, 0, _maxLength - _position);
+        const char* x = findNul(_buffer + _position, _maxLength - _position);
         if (!x)
             return makeError("no end of c-string", _idElem, elemName);
-        uint64_t len = static_cast<uint64_t>(static_cast<const char*>(x) - (_buffer + _position));
+        uint64_t len = static_cast<uint64_t>(x - (_buffer + _position));
 
         StringData data(_buffer + _position, len);
         _position += len + 1;
@@ -354,4 +354,20 @@ TEST(BSONValidateBool, BoolValuesAreValidated) {
     }
 }
 
+TEST(BSONValidateFast, FieldNamesOfAllLengthsAreValidated) {
+    // Cover field names which end within, at the edge of, and beyond the first few vectors' worth
+    // of bytes.
+    for (size_t len = 1; len < 70; ++len) {
+        const std::string fieldName(len, 'f');
+        BSONObj obj = BSON(fieldName << 1 << "x" << fieldName);
+        ASSERT_OK(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+
+        // Cut the buffer off inside the first field name, so that it has no terminating NUL.
+        for (size_t cut = 5; cut < 5 + len; ++cut) {
+            ASSERT_EQ(ErrorCodes::InvalidBSON,
+                      validateBSON(obj.objdata(), cut, BSONVersion::kLatest));
+        }
+    }
+}
+
 }  // namespace
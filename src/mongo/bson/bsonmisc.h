@@ -31,6 +31,7 @@
 
 #include "mongo/bson/bsonelement.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -245,19 +246,22 @@ private:
    used in conjuction with BSONObjBuilder, allows for proper buffer size to prevent crazy memory
    usage
  */
+/**
+ * Remembers the sizes of recently built objects so that builders for similar objects can allocate
+ * a large enough buffer up front instead of growing it by doubling. The sizes may be recorded and
+ * read concurrently, e.g. by a tracker shared between all operations on one index.
+ */
 class BSONSizeTracker {
 public:
     BSONSizeTracker() {
-        _pos = 0;
         for (int i = 0; i < SIZE; i++)
-            _sizes[i] = 512;  // this is the default, so just be consistent
+            _sizes[i].store(512);  // this is the default, so just be consistent
     }
 
     ~BSONSizeTracker() {}
 
     void got(int size) {
-        _sizes[_pos] = size;
-        _pos = (_pos + 1) % SIZE;  // thread safe at least on certain compilers
+        _sizes[_pos.fetchAndAdd(1) % SIZE].store(size);
     }
 
     /**
@@ -266,16 +270,17 @@ public:
     int getSize() const {
         int x = 16;  // sane min
         for (int i = 0; i < SIZE; i++) {
-            if (_sizes[i] > x)
-                x = _sizes[i];
+            int size = _sizes[i].load();
+            if (size > x)
+                x = size;
         }
         return x;
     }
 
 private:
     enum { SIZE = 10 };
-    int _pos;
-    int _sizes[SIZE];
+    AtomicWord<unsigned> _pos{0};
+    AtomicWord<int> _sizes[SIZE];
 };
 
 // considers order
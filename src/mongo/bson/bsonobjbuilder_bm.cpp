@@ -49,4 +49,57 @@ void BM_arrayBuilder(benchmark::State& state) {
 
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 
+namespace {
+// Appends 'numFields' fields shaped like a small command reply or index key: a short name and an
+// int, string or double value, about 20 bytes each.
+void appendFields(BSONObjBuilder* builder, int64_t numFields) {
+    for (int64_t i = 0; i < numFields; i++) {
+        switch (i % 3) {
+            case 0:
+                builder->append("field", static_cast<int>(i));
+                break;
+            case 1:
+                builder->append("name", "value");
+                break;
+            case 2:
+                builder->append("ratio", 0.5);
+                break;
+        }
+    }
+}
+}  // namespace
+
+// Builds each object in a buffer which starts at the default size and doubles as it fills.
+void BM_objBuilderDefaultSize(benchmark::State& state) {
+    size_t totalBytes = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        BSONObjBuilder builder;
+        appendFields(&builder, state.range(0));
+        BSONObj obj = builder.obj();
+        totalBytes += obj.objsize();
+        benchmark::DoNotOptimize(obj);
+    }
+    state.SetBytesProcessed(totalBytes);
+}
+
+// Builds each object in a buffer sized from the objects built before it, as the index key
+// generators and the command reply path do.
+void BM_objBuilderSizeTracker(benchmark::State& state) {
+    BSONSizeTracker tracker;
+    size_t totalBytes = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        BSONObjBuilder builder(tracker);
+        appendFields(&builder, state.range(0));
+        BSONObj obj = builder.obj();
+        totalBytes += obj.objsize();
+        benchmark::DoNotOptimize(obj);
+    }
+    state.SetBytesProcessed(totalBytes);
+}
+
+BENCHMARK(BM_objBuilderDefaultSize)->Ranges({{{1}, {10'000}}});
+BENCHMARK(BM_objBuilderSizeTracker)->Ranges({{{1}, {10'000}}});
+
 }  // namespace mongo
@@ -508,6 +508,21 @@ TEST(BSONObjBuilderTest, SizeChecks) {
     }
 }
 
+TEST(BSONObjBuilderTest, SizeTrackerPresizesLaterBuilders) {
+    BSONSizeTracker tracker;
+    int objSize;
+    {
+        BSONObjBuilder builder(tracker);
+        for (int i = 0; i < 1000; i++) {
+            builder.append(std::to_string(i), i);
+        }
+        objSize = builder.done().objsize();
+    }
+    ASSERT_EQ(objSize, tracker.getSize());
+
+    BSONObjBuilder builder(tracker);
+    ASSERT_GTE(builder.bb().getSize(), objSize);
+}
 
 }  // namespace
 }  // namespace mongo
@@ -172,6 +172,8 @@ const char* typeName(BinDataType type) {
             return "UUID";
         case MD5Type:
             return "MD5";
+        case Column:
+            return "Column";
         case bdtCustom:
             return "Custom";
         default:
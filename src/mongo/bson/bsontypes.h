@@ -159,6 +159,7 @@ enum BinDataType {
     bdtUUID = 3,             /* deprecated */
     newUUID = 4,             /* language-independent UUID format across all drivers */
     MD5Type = 5,
+    Column = 7, /* delta-of-delta encoded values, see bson/util/bson_column.h */
     bdtCustom = 128
 };
 
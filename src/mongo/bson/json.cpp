@@ -32,6 +32,7 @@
 #include <cstdint>
 
 #include "mongo/base/parse_number.h"
+#include "mongo/db/fts/unicode/byte_vector.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/platform/decimal128.h"
 #include "mongo/platform/strtoll.h"
@@ -65,8 +66,6 @@ enum {
     ID_RESERVE_SIZE = 64,
     PAT_RESERVE_SIZE = 4096,
     OPT_RESERVE_SIZE = 64,
-    FIELD_RESERVE_SIZE = 4096,
-    STRINGVAL_RESERVE_SIZE = 4096,
     BINDATA_RESERVE_SIZE = 4096,
     BINDATATYPE_RESERVE_SIZE = 4096,
     NS_RESERVE_SIZE = 64,
@@ -80,6 +79,36 @@ static const char *LBRACE = "{", *RBRACE = "}", *LBRACKET = "[", *RBRACKET = "]"
                   *RPAREN = ")", *COLON = ":", *COMMA = ",", *FORWARDSLASH = "/",
                   *SINGLEQUOTE = "'", *DOUBLEQUOTE = "\"";
 
+namespace {
+
+/**
+ * Returns the first character in [begin, end) which JParse::chars() must look at individually
+ * inside a string quoted by 'quote': the closing quote, a backslash or a control character.
+ */
+const char* findSpecialStringChar(const char* begin, const char* end, char quote) {
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+    using unicode::ByteVector;
+    // A byte is a control character exactly when none of its top three bits are set.
+    const ByteVector highBits(static_cast<ByteVector::Scalar>(0xE0));
+    while (end - begin >= ByteVector::size) {
+        auto word = ByteVector::load(begin);
+        auto mask = (word.compareEQ(quote) | word.compareEQ('\\') | (word & highBits).compareEQ(0))
+                        .maskAny();
+        if (mask) {
+            return begin + ByteVector::countInitialZeros(mask);
+        }
+        begin += ByteVector::size;
+    }
+#endif
+    while (begin < end && *begin != quote && *begin != '\\' &&
+           !(0x00 <= *begin && *begin <= 0x1F)) {
+        ++begin;
+    }
+    return begin;
+}
+
+}  // namespace
+
 JParse::JParse(StringData str)
     : _buf(str.rawData()), _input(_buf), _input_end(_input + str.size()) {}
 
@@ -95,6 +124,29 @@ Status JParse::parseError(StringData msg) {
 
 Status JParse::value(StringData fieldName, BSONObjBuilder& builder) {
     MONGO_JSON_DEBUG("fieldName: " << fieldName);
+
+    // Plain numbers and strings, the bulk of most documents, can be told apart from every keyword
+    // below by their first character, so skip trying each keyword in turn.
+    const char* first = _input;
+    while (first < _input_end && isspace(*reinterpret_cast<const unsigned char*>(first))) {
+        ++first;
+    }
+    if (first < _input_end) {
+        if (isdigit(*reinterpret_cast<const unsigned char*>(first)) ||
+            (*first == '-' && !peekToken("-Infinity"))) {
+            return number(fieldName, builder);
+        }
+        if (*first == '"' || *first == '\'') {
+            std::string valueString;
+            Status ret = quotedString(&valueString);
+            if (ret != Status::OK()) {
+                return ret;
+            }
+            builder.append(fieldName, valueString);
+            return Status::OK();
+        }
+    }
+
     if (peekToken(LBRACE)) {
         Status ret = object(fieldName, builder);
         if (ret != Status::OK()) {
@@ -152,7 +204,6 @@ Status JParse::value(StringData fieldName, BSONObjBuilder& builder) {
         }
     } else if (peekToken(DOUBLEQUOTE) || peekToken(SINGLEQUOTE)) {
         std::string valueString;
-        valueString.reserve(STRINGVAL_RESERVE_SIZE);
         Status ret = quotedString(&valueString);
         if (ret != Status::OK()) {
             return ret;
@@ -202,7 +253,6 @@ Status JParse::object(StringData fieldName, BSONObjBuilder& builder, bool subObj
 
     // Special object
     std::string firstField;
-    firstField.reserve(FIELD_RESERVE_SIZE);
     Status ret = field(&firstField);
     if (ret != Status::OK()) {
         return ret;
@@ -316,7 +366,6 @@ Status JParse::object(StringData fieldName, BSONObjBuilder& builder, bool subObj
         }
         while (readToken(COMMA)) {
             std::string fieldName;
-            fieldName.reserve(FIELD_RESERVE_SIZE);
             Status fieldRet = field(&fieldName);
             if (fieldRet != Status::OK()) {
                 return fieldRet;
@@ -430,7 +479,6 @@ Status JParse::dateObject(StringData fieldName, BSONObjBuilder& builder) {
         date = dateRet.getValue();
     } else if (readToken(LBRACE)) {
         std::string fieldName;
-        fieldName.reserve(FIELD_RESERVE_SIZE);
         Status ret = field(&fieldName);
         if (ret != Status::OK()) {
             return ret;
@@ -1005,6 +1053,23 @@ Status JParse::number(StringData fieldName, BSONObjBuilder& builder) {
     long long retll;
     double retd;
 
+    // Most numbers are integers, which don't need parsing as a double as well. A number continuing
+    // with any of these characters may still be one, e.g. 1.5, 1e3 or the hex float 0x1p3.
+    errno = 0;
+    retll = strtoll(_input, &endptrll, 10);
+    if (endptrll != _input && errno != ERANGE && endptrll < _input_end &&
+        !strchr(".eExX", *endptrll)) {
+        if (retll == static_cast<int>(retll)) {
+            MONGO_JSON_DEBUG("Type: 32 bit int");
+            builder.append(fieldName, static_cast<int>(retll));
+        } else {
+            MONGO_JSON_DEBUG("Type: 64 bit int");
+            builder.append(fieldName, retll);
+        }
+        _input = endptrll;
+        return Status::OK();
+    }
+
     // reset errno to make sure that we are getting it from strtod
     errno = 0;
     // SERVER-11920: We should use parseNumberFromString here, but that function requires that
@@ -1100,8 +1165,21 @@ Status JParse::chars(std::string* result, const char* terminalSet, const char* a
     if (_input >= _input_end) {
         return parseError("Unexpected end of input");
     }
+    // Inside a quoted string, runs of ordinary characters are copied in bulk.
+    const bool quoted = allowedSet == NULL && terminalSet[0] != '\0' && terminalSet[1] == '\0';
     const char* q = _input;
-    while (q < _input_end && !match(*q, terminalSet)) {
+    while (q < _input_end) {
+        if (quoted) {
+            const char* special = findSpecialStringChar(q, _input_end, *terminalSet);
+            result->append(q, special);
+            q = special;
+            if (q >= _input_end) {
+                break;
+            }
+        }
+        if (match(*q, terminalSet)) {
+            break;
+        }
         MONGO_JSON_DEBUG("q: " << q);
         if (allowedSet != NULL) {
             if (!match(*q, allowedSet)) {
@@ -1247,7 +1325,6 @@ bool JParse::readTokenImpl(const char* token, bool advance) {
 bool JParse::readField(StringData expectedField) {
     MONGO_JSON_DEBUG("expectedField: " << expectedField);
     std::string nextField;
-    nextField.reserve(FIELD_RESERVE_SIZE);
     Status ret = field(&nextField);
     if (ret != Status::OK()) {
         return false;
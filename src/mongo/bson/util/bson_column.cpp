@@ -0,0 +1,355 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/util/bson_column.h"
+
+#include <cstring>
+
+#include "mongo/base/data_type_endian.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/ftdc/varint.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+namespace {
+
+// Element type byte followed by the little-endian value count.
+const std::size_t kHeaderSize = sizeof(std::int8_t) + sizeof(std::uint32_t);
+
+// Upper bound on the number of values in a column. Zero runs let a few bytes describe a very
+// long column, so bound the decode work a single element can ask for.
+const std::uint32_t kMaxValues = BSONObjMaxUserSize;
+
+std::uint64_t zigzagEncode(std::uint64_t value) {
+    return (value << 1) ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(value) >> 63);
+}
+
+std::uint64_t zigzagDecode(std::uint64_t value) {
+    return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+std::uint64_t rawValue(const BSONElement& elem) {
+    switch (elem.type()) {
+        case NumberInt:
+            return static_cast<std::uint64_t>(static_cast<std::int64_t>(elem._numberInt()));
+        case NumberLong:
+            return static_cast<std::uint64_t>(elem._numberLong());
+        case Date:
+            return static_cast<std::uint64_t>(elem.date().toMillisSinceEpoch());
+        case bsonTimestamp:
+            return elem.timestamp().asULL();
+        case NumberDouble: {
+            double d = elem._numberDouble();
+            std::uint64_t bits;
+            std::memcpy(&bits, &d, sizeof(bits));
+            return bits;
+        }
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+}  // namespace
+
+bool BSONColumnBuilder::isSupportedType(BSONType type) {
+    switch (type) {
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+        case Date:
+        case bsonTimestamp:
+            return true;
+        default:
+            return false;
+    }
+}
+
+BSONColumnBuilder::BSONColumnBuilder(BSONType type) : _type(type), _db(kHeaderSize) {
+    invariant(isSupportedType(type));
+    auto status = _db.writeAndAdvance<std::int8_t>(static_cast<std::int8_t>(type));
+    invariant(status.isOK());
+
+    // The count is filled in by finish().
+    status = _db.writeAndAdvance<LittleEndian<std::uint32_t>>(0);
+    invariant(status.isOK());
+}
+
+Status BSONColumnBuilder::append(const BSONElement& elem) {
+    invariant(!_finished);
+
+    if (elem.type() != _type) {
+        return {ErrorCodes::TypeMismatch,
+                str::stream() << "Cannot append a value of type " << typeName(elem.type())
+                              << " to a column of type "
+                              << typeName(_type)};
+    }
+
+    if (_count == kMaxValues) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "A column cannot hold more than " << kMaxValues << " values"};
+    }
+
+    return _appendRaw(rawValue(elem));
+}
+
+Status BSONColumnBuilder::_appendRaw(std::uint64_t value) {
+    // All arithmetic is modulo 2^64 so that any bit pattern, including doubles, round-trips.
+    std::uint64_t delta = value - _prevValue;
+    std::uint64_t deltaOfDelta = delta - _prevDelta;
+    _prevValue = value;
+    _prevDelta = delta;
+    ++_count;
+
+    if (deltaOfDelta == 0) {
+        ++_zeroesCount;
+        return Status::OK();
+    }
+
+    auto status = _flushZeroes();
+    if (!status.isOK()) {
+        return status;
+    }
+
+    return _db.writeAndAdvance(FTDCVarInt(zigzagEncode(deltaOfDelta)));
+}
+
+Status BSONColumnBuilder::_flushZeroes() {
+    if (_zeroesCount == 0) {
+        return Status::OK();
+    }
+
+    auto s1 = _db.writeAndAdvance(FTDCVarInt(0));
+    if (!s1.isOK()) {
+        return s1;
+    }
+
+    auto s2 = _db.writeAndAdvance(FTDCVarInt(_zeroesCount - 1));
+    if (!s2.isOK()) {
+        return s2;
+    }
+
+    _zeroesCount = 0;
+    return Status::OK();
+}
+
+Status BSONColumnBuilder::finish(StringData fieldName, BSONObjBuilder* builder) {
+    invariant(!_finished);
+    _finished = true;
+
+    auto status = _flushZeroes();
+    if (!status.isOK()) {
+        return status;
+    }
+
+    auto cursor = _db.getCursor();
+    status = cursor.write<LittleEndian<std::uint32_t>>(_count, sizeof(std::int8_t));
+    if (!status.isOK()) {
+        return status;
+    }
+
+    builder->appendBinData(
+        fieldName, static_cast<int>(cursor.length()), BinDataType::Column, cursor.data());
+    return Status::OK();
+}
+
+StatusWith<BSONColumn> BSONColumn::parse(const BSONElement& elem) {
+    if (elem.type() != BinData || elem.binDataType() != BinDataType::Column) {
+        return {ErrorCodes::TypeMismatch,
+                str::stream() << "Expected a BinData column but found " << elem.toString()};
+    }
+
+    int length;
+    const char* data = elem.binData(length);
+    ConstDataRangeCursor cursor(data, data + length);
+
+    auto swType = cursor.readAndAdvance<std::int8_t>();
+    if (!swType.isOK()) {
+        return swType.getStatus();
+    }
+
+    auto type = static_cast<BSONType>(swType.getValue());
+    if (!BSONColumnBuilder::isSupportedType(type)) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Unsupported column value type " << swType.getValue()};
+    }
+
+    auto swCount = cursor.readAndAdvance<LittleEndian<std::uint32_t>>();
+    if (!swCount.isOK()) {
+        return swCount.getStatus();
+    }
+
+    std::uint32_t count = swCount.getValue();
+    if (count > kMaxValues) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Column value count " << count << " exceeds the limit of "
+                              << kMaxValues};
+    }
+
+    BSONColumn column(type, cursor, count);
+
+    // Decode the stream once so that iterating over the column can never fail.
+    auto it = column.begin();
+    while (it.more()) {
+        auto status = it._decodeNext();
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
+    if (it._zeroesCount != 0 || it._cursor.length() != 0) {
+        return {ErrorCodes::BadValue, "Column data does not match its value count"};
+    }
+
+    return column;
+}
+
+void BSONColumn::Iterator::next() {
+    auto status = _decodeNext();
+    invariant(status.isOK());
+}
+
+Status BSONColumn::Iterator::_decodeNext() {
+    invariant(_remaining > 0);
+
+    std::uint64_t encoded = 0;
+    if (_zeroesCount) {
+        --_zeroesCount;
+    } else {
+        auto swEncoded = _cursor.readAndAdvance<FTDCVarInt>();
+        if (!swEncoded.isOK()) {
+            return swEncoded.getStatus();
+        }
+
+        encoded = swEncoded.getValue();
+
+        if (encoded == 0) {
+            auto swZeroes = _cursor.readAndAdvance<FTDCVarInt>();
+            if (!swZeroes.isOK()) {
+                return swZeroes.getStatus();
+            }
+
+            _zeroesCount = swZeroes.getValue();
+            if (_zeroesCount >= _remaining) {
+                return {ErrorCodes::BadValue, "Column zero run exceeds its value count"};
+            }
+        }
+    }
+
+    _delta += zigzagDecode(encoded);
+    _value += _delta;
+    --_remaining;
+
+    return Status::OK();
+}
+
+long long BSONColumn::Iterator::numberLong() const {
+    switch (_type) {
+        case NumberDouble:
+            return static_cast<long long>(numberDouble());
+        case bsonTimestamp:
+            return timestamp().asLL();
+        default:
+            return static_cast<long long>(_value);
+    }
+}
+
+double BSONColumn::Iterator::numberDouble() const {
+    switch (_type) {
+        case NumberDouble: {
+            double d;
+            std::memcpy(&d, &_value, sizeof(d));
+            return d;
+        }
+        case bsonTimestamp:
+            return static_cast<double>(timestamp().asULL());
+        default:
+            return static_cast<double>(static_cast<long long>(_value));
+    }
+}
+
+Date_t BSONColumn::Iterator::date() const {
+    return Date_t::fromMillisSinceEpoch(static_cast<long long>(_value));
+}
+
+Timestamp BSONColumn::Iterator::timestamp() const {
+    return Timestamp(static_cast<unsigned long long>(_value));
+}
+
+void BSONColumn::Iterator::appendTo(StringData fieldName, BSONObjBuilder* builder) const {
+    switch (_type) {
+        case NumberInt:
+            builder->append(fieldName, static_cast<int>(numberLong()));
+            break;
+        case NumberLong:
+            builder->append(fieldName, numberLong());
+            break;
+        case NumberDouble:
+            builder->append(fieldName, numberDouble());
+            break;
+        case Date:
+            builder->appendDate(fieldName, date());
+            break;
+        case bsonTimestamp:
+            builder->append(fieldName, timestamp());
+            break;
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+void BSONColumn::appendTo(BSONArrayBuilder* builder) const {
+    auto it = begin();
+    while (it.more()) {
+        it.next();
+        switch (_type) {
+            case NumberInt:
+                builder->append(static_cast<int>(it.numberLong()));
+                break;
+            case NumberLong:
+                builder->append(it.numberLong());
+                break;
+            case NumberDouble:
+                builder->append(it.numberDouble());
+                break;
+            case Date:
+                builder->append(it.date());
+                break;
+            case bsonTimestamp:
+                builder->append(it.timestamp());
+                break;
+            default:
+                MONGO_UNREACHABLE;
+        }
+    }
+}
+
+}  // namespace mongo
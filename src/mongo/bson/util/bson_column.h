@@ -0,0 +1,201 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "mongo/base/data_builder.h"
+#include "mongo/base/data_range_cursor.h"
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsontypes.h"
+
+namespace mongo {
+
+class BSONArrayBuilder;
+class BSONObjBuilder;
+
+/**
+ * Encodes a homogeneous sequence of numeric, Date or Timestamp values as a BinData element of
+ * subtype BinDataType::Column.
+ *
+ * Values are stored with the same scheme FTDC uses for its metric chunks: each value is reduced
+ * to the difference between consecutive deltas (delta-of-delta), zig-zag encoded so that small
+ * negative differences stay small, and written as an FTDCVarInt. Runs of zeros are written as
+ * the pair (0, count - 1). Regularly spaced timestamps and slowly changing counters therefore
+ * take about one byte per run rather than eight bytes per value.
+ *
+ * Layout: int8 element type, little-endian uint32 value count, then the varint stream.
+ *
+ * Doubles are encoded by their bit pattern, so every supported type round-trips exactly.
+ */
+class BSONColumnBuilder {
+    BSONColumnBuilder(const BSONColumnBuilder&) = delete;
+    BSONColumnBuilder& operator=(const BSONColumnBuilder&) = delete;
+
+public:
+    /**
+     * Returns true if values of 'type' can be stored in a column: NumberInt, NumberLong,
+     * NumberDouble, Date and Timestamp.
+     */
+    static bool isSupportedType(BSONType type);
+
+    /**
+     * Creates a builder for values of 'type', which must satisfy isSupportedType().
+     */
+    explicit BSONColumnBuilder(BSONType type);
+
+    /**
+     * Appends the value of 'elem'. Returns ErrorCodes::TypeMismatch if 'elem' is not of the type
+     * this builder was created with.
+     */
+    Status append(const BSONElement& elem);
+
+    /**
+     * Number of values appended so far.
+     */
+    std::uint32_t size() const {
+        return _count;
+    }
+
+    /**
+     * Appends the encoded column to 'builder' as a BinData field named 'fieldName'. May only be
+     * called once.
+     */
+    Status finish(StringData fieldName, BSONObjBuilder* builder);
+
+private:
+    Status _appendRaw(std::uint64_t value);
+    Status _flushZeroes();
+
+    const BSONType _type;
+    DataBuilder _db;
+
+    std::uint32_t _count = 0;
+    std::uint32_t _zeroesCount = 0;
+    std::uint64_t _prevValue = 0;
+    std::uint64_t _prevDelta = 0;
+    bool _finished = false;
+};
+
+/**
+ * Read-only view of a column produced by BSONColumnBuilder. Values are decoded one at a time
+ * through an Iterator, so callers such as the matcher and the aggregation pipeline can scan a
+ * column without materializing a BSONElement per value.
+ *
+ * The view does not own its data; the BSONObj holding the BinData element must outlive it.
+ */
+class BSONColumn {
+public:
+    /**
+     * Validates that 'elem' is a well formed column and returns a view over it. The entire
+     * stream is checked here so that iteration cannot fail.
+     */
+    static StatusWith<BSONColumn> parse(const BSONElement& elem);
+
+    class Iterator {
+    public:
+        bool more() const {
+            return _remaining > 0;
+        }
+
+        /**
+         * Decodes the next value. Must only be called while more() returns true.
+         */
+        void next();
+
+        /**
+         * Accessors for the value decoded by the last call to next().
+         */
+        std::uint64_t raw() const {
+            return _value;
+        }
+        long long numberLong() const;
+        double numberDouble() const;
+        Date_t date() const;
+        Timestamp timestamp() const;
+
+        /**
+         * Appends the current value as a regular BSON element of the column's type.
+         */
+        void appendTo(StringData fieldName, BSONObjBuilder* builder) const;
+
+    private:
+        friend class BSONColumn;
+
+        Iterator(BSONType type, ConstDataRangeCursor cursor, std::uint32_t count)
+            : _type(type), _cursor(cursor), _remaining(count) {}
+
+        Status _decodeNext();
+
+        BSONType _type;
+        ConstDataRangeCursor _cursor;
+        std::uint32_t _remaining;
+        std::uint64_t _zeroesCount = 0;
+        std::uint64_t _value = 0;
+        std::uint64_t _delta = 0;
+    };
+
+    /**
+     * Returns an iterator positioned before the first value.
+     */
+    Iterator begin() const {
+        return Iterator(_type, _values, _count);
+    }
+
+    /**
+     * BSON type of every value in the column.
+     */
+    BSONType type() const {
+        return _type;
+    }
+
+    /**
+     * Number of values in the column.
+     */
+    std::uint32_t size() const {
+        return _count;
+    }
+
+    /**
+     * Decodes every value into 'builder' as regular BSON elements.
+     */
+    void appendTo(BSONArrayBuilder* builder) const;
+
+private:
+    BSONColumn(BSONType type, ConstDataRangeCursor values, std::uint32_t count)
+        : _type(type), _values(values), _count(count) {}
+
+    BSONType _type;
+    ConstDataRangeCursor _values;
+    std::uint32_t _count;
+};
+
+}  // namespace mongo
@@ -0,0 +1,185 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <limits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/util/bson_column.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+// Encodes every element of 'values' into one column and returns the object holding it.
+BSONObj buildColumn(BSONType type, const BSONArray& values) {
+    BSONColumnBuilder cb(type);
+    for (auto&& elem : values) {
+        ASSERT_OK(cb.append(elem));
+    }
+
+    BSONObjBuilder bob;
+    ASSERT_OK(cb.finish("c", &bob));
+    return bob.obj();
+}
+
+void assertRoundTrips(BSONType type, const BSONArray& values) {
+    BSONObj obj = buildColumn(type, values);
+    auto swColumn = BSONColumn::parse(obj["c"]);
+    ASSERT_OK(swColumn.getStatus());
+
+    const auto& column = swColumn.getValue();
+    ASSERT_EQ(type, column.type());
+    ASSERT_EQ(static_cast<std::uint32_t>(values.nFields()), column.size());
+
+    BSONArrayBuilder decoded;
+    column.appendTo(&decoded);
+    ASSERT_BSONOBJ_EQ(values, decoded.arr());
+}
+
+TEST(BSONColumnTest, EmptyColumn) {
+    assertRoundTrips(NumberLong, BSONArray());
+}
+
+TEST(BSONColumnTest, RoundTripsEachSupportedType) {
+    assertRoundTrips(NumberInt,
+                     BSON_ARRAY(0 << 1 << -1 << std::numeric_limits<int>::max()
+                                  << std::numeric_limits<int>::min()));
+    assertRoundTrips(NumberLong,
+                     BSON_ARRAY(5LL << 7LL << std::numeric_limits<long long>::max()
+                                    << std::numeric_limits<long long>::min()
+                                    << 0LL));
+    assertRoundTrips(NumberDouble,
+                     BSON_ARRAY(1.5 << -0.0 << 20.25 << std::numeric_limits<double>::infinity()
+                                    << std::numeric_limits<double>::denorm_min()));
+    assertRoundTrips(Date,
+                     BSON_ARRAY(Date_t::fromMillisSinceEpoch(1000)
+                                << Date_t::fromMillisSinceEpoch(2000)
+                                << Date_t::fromMillisSinceEpoch(-5)));
+    assertRoundTrips(bsonTimestamp,
+                     BSON_ARRAY(Timestamp(10, 1) << Timestamp(10, 2) << Timestamp(11, 0)));
+}
+
+TEST(BSONColumnTest, RegularSeriesCompressesToARun) {
+    BSONColumnBuilder cb(Date);
+    const int kCount = 1000;
+    for (int i = 0; i < kCount; ++i) {
+        BSONObj obj = BSON("t" << Date_t::fromMillisSinceEpoch(1500000000000LL + i * 1000LL));
+        ASSERT_OK(cb.append(obj["t"]));
+    }
+
+    BSONObjBuilder bob;
+    ASSERT_OK(cb.finish("c", &bob));
+    BSONObj obj = bob.obj();
+
+    // The first two values are stored explicitly; every later delta-of-delta is zero and
+    // collapses into a single run.
+    int length;
+    obj["c"].binData(length);
+    ASSERT_LT(length, 32);
+
+    auto swColumn = BSONColumn::parse(obj["c"]);
+    ASSERT_OK(swColumn.getStatus());
+
+    auto it = swColumn.getValue().begin();
+    for (int i = 0; i < kCount; ++i) {
+        ASSERT(it.more());
+        it.next();
+        ASSERT_EQ(Date_t::fromMillisSinceEpoch(1500000000000LL + i * 1000LL), it.date());
+    }
+    ASSERT_FALSE(it.more());
+}
+
+TEST(BSONColumnTest, IteratorConvertsNumericValues) {
+    BSONObj obj = buildColumn(NumberInt, BSON_ARRAY(3 << -4));
+    auto it = BSONColumn::parse(obj["c"]).getValue().begin();
+
+    it.next();
+    ASSERT_EQ(3LL, it.numberLong());
+    ASSERT_EQ(3.0, it.numberDouble());
+
+    it.next();
+    ASSERT_EQ(-4LL, it.numberLong());
+    ASSERT_EQ(-4.0, it.numberDouble());
+}
+
+TEST(BSONColumnTest, AppendRejectsMismatchedType) {
+    BSONColumnBuilder cb(NumberLong);
+    BSONObj obj = BSON("a" << 1 << "b"
+                           << "str");
+    ASSERT_EQ(ErrorCodes::TypeMismatch, cb.append(obj["a"]));
+    ASSERT_EQ(ErrorCodes::TypeMismatch, cb.append(obj["b"]));
+    ASSERT_EQ(0U, cb.size());
+}
+
+TEST(BSONColumnTest, ParseRejectsOtherElements) {
+    BSONObjBuilder bob;
+    bob.append("a", 1);
+    bob.appendBinData("b", 3, BinDataGeneral, "abc");
+    BSONObj obj = bob.obj();
+
+    ASSERT_EQ(ErrorCodes::TypeMismatch, BSONColumn::parse(obj["a"]).getStatus());
+    ASSERT_EQ(ErrorCodes::TypeMismatch, BSONColumn::parse(obj["b"]).getStatus());
+}
+
+TEST(BSONColumnTest, ParseRejectsTruncatedData) {
+    BSONObj good = buildColumn(NumberLong, BSON_ARRAY(100LL << 250LL << 1LL));
+    int length;
+    const char* data = good["c"].binData(length);
+
+    for (int truncated = 0; truncated < length; ++truncated) {
+        BSONObjBuilder bob;
+        bob.appendBinData("c", truncated, BinDataType::Column, data);
+        BSONObj bad = bob.obj();
+        ASSERT_NOT_OK(BSONColumn::parse(bad["c"]).getStatus());
+    }
+}
+
+TEST(BSONColumnTest, ParseRejectsZeroRunLongerThanCount) {
+    // Type NumberLong, count 2, then a zero run claiming three values.
+    const char data[] = {NumberLong, 2, 0, 0, 0, 0, 2};
+    BSONObjBuilder bob;
+    bob.appendBinData("c", sizeof(data), BinDataType::Column, data);
+    BSONObj obj = bob.obj();
+
+    ASSERT_EQ(ErrorCodes::BadValue, BSONColumn::parse(obj["c"]).getStatus());
+}
+
+TEST(BSONColumnTest, ParseRejectsTrailingBytes) {
+    // Type NumberLong, count 1, value 1 (zig-zag 2), then a stray byte.
+    const char data[] = {NumberLong, 1, 0, 0, 0, 2, 2};
+    BSONObjBuilder bob;
+    bob.appendBinData("c", sizeof(data), BinDataType::Column, data);
+    BSONObj obj = bob.obj();
+
+    ASSERT_EQ(ErrorCodes::BadValue, BSONColumn::parse(obj["c"]).getStatus());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -298,6 +298,16 @@ public:
     /**
      * Reserve room for some number of bytes to be claimed at a later time.
      */
+    /**
+     * Grows the buffer, if needed, so that 'bytes' more bytes can be appended without
+     * reallocating. Unlike reserveBytes(), the space is not held back from later appends.
+     */
+    void ensureCapacity(int bytes) {
+        int minSize = l + reservedBytes + bytes;
+        if (minSize > size)
+            grow_reallocate(minSize);
+    }
+
     void reserveBytes(int bytes) {
         int minSize = l + reservedBytes + bytes;
         if (minSize > size)
@@ -124,4 +124,16 @@ TEST(Builder, AppendUnsignedLongLong) {
 TEST(Builder, AppendShort) {
     testStringBuilderIntegral<short>();
 }
+
+TEST(Builder, EnsureCapacityAvoidsReallocation) {
+    BufBuilder bb;
+    bb.appendNum(1);
+    bb.ensureCapacity(1024 * 1024);
+    const char* buf = bb.buf();
+    for (int i = 0; i < 1024 * 1024 / 4; i++) {
+        bb.appendNum(i);
+    }
+    ASSERT_EQ(buf, bb.buf());
+    ASSERT_EQ(bb.len(), 4 + 1024 * 1024);
+}
 }
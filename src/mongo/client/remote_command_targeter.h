@@ -107,6 +107,14 @@ public:
      */
     virtual void markHostUnreachable(const HostAndPort& host, const Status& status) = 0;
 
+    /**
+     * Reports to the targeter that an operation was sent to 'host', or that one which was sent to
+     * it completed after 'latency', successfully or not, so that it can prefer less loaded hosts
+     * when several match a read preference.
+     */
+    virtual void markOperationStarted(const HostAndPort& host) = 0;
+    virtual void markOperationFinished(const HostAndPort& host, Milliseconds latency) = 0;
+
 protected:
     RemoteCommandTargeter() = default;
 };
@@ -65,6 +65,14 @@ public:
         _mock->markHostUnreachable(host, status);
     }
 
+    void markOperationStarted(const HostAndPort& host) override {
+        _mock->markOperationStarted(host);
+    }
+
+    void markOperationFinished(const HostAndPort& host, Milliseconds latency) override {
+        _mock->markOperationFinished(host, latency);
+    }
+
 private:
     const std::shared_ptr<RemoteCommandTargeter> _mock;
 };
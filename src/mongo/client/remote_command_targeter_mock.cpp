@@ -68,6 +68,11 @@ void RemoteCommandTargeterMock::markHostNotMaster(const HostAndPort& host, const
 void RemoteCommandTargeterMock::markHostUnreachable(const HostAndPort& host, const Status& status) {
 }
 
+void RemoteCommandTargeterMock::markOperationStarted(const HostAndPort& host) {}
+
+void RemoteCommandTargeterMock::markOperationFinished(const HostAndPort& host,
+                                                      Milliseconds latency) {}
+
 void RemoteCommandTargeterMock::setConnectionStringReturnValue(const ConnectionString returnValue) {
     _connectionStringReturnValue = std::move(returnValue);
 }
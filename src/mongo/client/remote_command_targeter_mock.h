@@ -70,6 +70,16 @@ public:
      */
     void markHostUnreachable(const HostAndPort& host, const Status& status) override;
 
+    /**
+     * No-op for the mock.
+     */
+    void markOperationStarted(const HostAndPort& host) override;
+
+    /**
+     * No-op for the mock.
+     */
+    void markOperationFinished(const HostAndPort& host, Milliseconds latency) override;
+
     /**
      * Sets the return value for the next call to connectionString.
      */
@@ -100,4 +100,16 @@ void RemoteCommandTargeterRS::markHostUnreachable(const HostAndPort& host, const
     _rsMonitor->failedHost(host, status);
 }
 
+void RemoteCommandTargeterRS::markOperationStarted(const HostAndPort& host) {
+    invariant(_rsMonitor);
+
+    _rsMonitor->operationStarted(host);
+}
+
+void RemoteCommandTargeterRS::markOperationFinished(const HostAndPort& host, Milliseconds latency) {
+    invariant(_rsMonitor);
+
+    _rsMonitor->operationFinished(host, latency);
+}
+
 }  // namespace mongo
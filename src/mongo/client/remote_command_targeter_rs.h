@@ -62,6 +62,10 @@ public:
 
     void markHostUnreachable(const HostAndPort& host, const Status& status) override;
 
+    void markOperationStarted(const HostAndPort& host) override;
+
+    void markOperationFinished(const HostAndPort& host, Milliseconds latency) override;
+
 private:
     // Name of the replica set which this targeter maintains
     const std::string _rsName;
@@ -62,4 +62,13 @@ void RemoteCommandTargeterStandalone::markHostUnreachable(const HostAndPort& hos
     dassert(host == _hostAndPort);
 }
 
+void RemoteCommandTargeterStandalone::markOperationStarted(const HostAndPort& host) {
+    dassert(host == _hostAndPort);
+}
+
+void RemoteCommandTargeterStandalone::markOperationFinished(const HostAndPort& host,
+                                                            Milliseconds latency) {
+    dassert(host == _hostAndPort);
+}
+
 }  // namespace mongo
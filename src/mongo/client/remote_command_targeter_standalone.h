@@ -53,6 +53,10 @@ public:
 
     void markHostUnreachable(const HostAndPort& host, const Status& status) override;
 
+    void markOperationStarted(const HostAndPort& host) override;
+
+    void markOperationFinished(const HostAndPort& host, Milliseconds latency) override;
+
 private:
     const HostAndPort _hostAndPort;
 };
@@ -96,6 +96,7 @@ AtomicBool areRefreshRetriesDisabledForTest{false};  // Only true in tests.
 // TODO: Move to ReplicaSetMonitorManager
 ReplicaSetMonitor::ConfigChangeHook asyncConfigChangeHook;
 ReplicaSetMonitor::ConfigChangeHook syncConfigChangeHook;
+ReplicaSetMonitor::PrimaryChangeHook primaryChangeHook;
 
 //
 // Helpers for stl algorithms
@@ -338,6 +339,25 @@ void ReplicaSetMonitor::failedHost(const HostAndPort& host, const Status& status
     DEV _state->checkInvariants();
 }
 
+void ReplicaSetMonitor::operationStarted(const HostAndPort& host) {
+    stdx::lock_guard<stdx::mutex> lk(_state->mutex);
+    Node* node = _state->findNode(host);
+    if (node)
+        ++node->inFlightOperations;
+}
+
+void ReplicaSetMonitor::operationFinished(const HostAndPort& host, Milliseconds latency) {
+    stdx::lock_guard<stdx::mutex> lk(_state->mutex);
+    Node* node = _state->findNode(host);
+    if (!node)
+        return;
+
+    // The node may have been removed and added back since the operation was started.
+    if (node->inFlightOperations > 0)
+        --node->inFlightOperations;
+    node->updateOperationLatency(durationCount<Microseconds>(latency));
+}
+
 bool ReplicaSetMonitor::isPrimary(const HostAndPort& host) const {
     stdx::lock_guard<stdx::mutex> lk(_state->mutex);
     Node* node = _state->findNode(host);
@@ -421,6 +441,11 @@ void ReplicaSetMonitor::setSynchronousConfigChangeHook(ConfigChangeHook hook) {
     syncConfigChangeHook = hook;
 }
 
+void ReplicaSetMonitor::setPrimaryChangeHook(PrimaryChangeHook hook) {
+    invariant(!primaryChangeHook);
+    primaryChangeHook = hook;
+}
+
 // TODO move to correct order with non-statics before pushing
 void ReplicaSetMonitor::appendInfo(BSONObjBuilder& bsonObjBuilder) const {
     stdx::lock_guard<stdx::mutex> lk(_state->mutex);
@@ -463,6 +488,7 @@ void ReplicaSetMonitor::cleanup() {
     globalRSMonitorManager.removeAllMonitors();
     asyncConfigChangeHook = ReplicaSetMonitor::ConfigChangeHook();
     syncConfigChangeHook = ReplicaSetMonitor::ConfigChangeHook();
+    primaryChangeHook = ReplicaSetMonitor::PrimaryChangeHook();
 }
 
 void ReplicaSetMonitor::disableRefreshRetries_forTest() {
@@ -797,6 +823,12 @@ Status Refresher::receivedIsMasterFromMaster(const HostAndPort& from, const IsMa
     _scan->unconfirmedReplies.clear();
 
     _scan->foundUpMaster = true;
+
+    if (reply.host != _set->lastSeenMaster && primaryChangeHook) {
+        // Call from a separate thread for the same reasons as the asyncConfigChangeHook.
+        stdx::thread bg(primaryChangeHook, _set->name, reply.host);
+        bg.detach();
+    }
     _set->lastSeenMaster = reply.host;
 
     return Status::OK();
@@ -936,7 +968,8 @@ void IsMasterReply::parse(const BSONObj& obj) {
     }
 }
 
-Node::Node(const HostAndPort& host) : host(host), latencyMicros(unknownLatency) {}
+Node::Node(const HostAndPort& host)
+    : host(host), latencyMicros(unknownLatency), operationLatencyMicros(unknownLatency) {}
 
 void Node::markFailed(const Status& status) {
     if (isUp) {
@@ -1010,6 +1043,24 @@ void Node::update(const IsMasterReply& reply) {
     lastWriteDateUpdateTime = Date_t::now();
 }
 
+void Node::updateOperationLatency(int64_t latency) {
+    if (latency < 0)
+        return;
+
+    if (operationLatencyMicros == unknownLatency) {
+        operationLatencyMicros = latency;
+    } else {
+        // update latency with smoothed moving average (1/4th the delta), as for the ping time
+        operationLatencyMicros += (latency - operationLatencyMicros) / 4;
+    }
+}
+
+double Node::loadScore() const {
+    const int64_t latency =
+        operationLatencyMicros != unknownLatency ? operationLatencyMicros : latencyMicros;
+    return static_cast<double>(latency) * (inFlightOperations + 1);
+}
+
 SetState::SetState(StringData name, const std::set<HostAndPort>& seedNodes)
     : name(name.toString()),
       consecutiveFailedScans(0),
@@ -1175,8 +1226,17 @@ HostAndPort SetState::getMatchingHost(const ReadPreferenceSetting& criteria) con
                     // only in tests
                     return matchingNodes[roundRobin++ % matchingNodes.size()]->host;
                 } else {
-                    // normal case
-                    return matchingNodes[rand.nextInt32(matchingNodes.size())]->host;
+                    // normal case: of two of them picked at random, use the least loaded, which
+                    // avoids piling onto a slow node without sending everything to the fastest
+                    const size_t first = rand.nextInt32(matchingNodes.size());
+                    if (matchingNodes.size() == 1) {
+                        return matchingNodes[first]->host;
+                    }
+                    const size_t second = (first + 1 + rand.nextInt32(matchingNodes.size() - 1)) %
+                        matchingNodes.size();
+                    return matchingNodes[second]->loadScore() < matchingNodes[first]->loadScore()
+                        ? matchingNodes[second]->host
+                        : matchingNodes[first]->host;
                 };
             }
 
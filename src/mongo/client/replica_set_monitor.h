@@ -62,6 +62,9 @@ public:
     typedef stdx::function<void(const std::string& setName, const std::string& newConnectionString)>
         ConfigChangeHook;
 
+    typedef stdx::function<void(const std::string& setName, const HostAndPort& newPrimary)>
+        PrimaryChangeHook;
+
     /**
      * Initializes local state.
      *
@@ -119,6 +122,17 @@ public:
      */
     void failedHost(const HostAndPort& host, const Status& status);
 
+    /**
+     * Notifies this Monitor that an operation has been sent to the specified host, or that one has
+     * completed after 'latency'. Among the hosts matching a read preference, those with slower or
+     * more outstanding operations are selected less often.
+     *
+     * Every call to operationStarted must be followed by one to operationFinished for the same
+     * host, whether or not the operation succeeded.
+     */
+    void operationStarted(const HostAndPort& host);
+    void operationFinished(const HostAndPort& host, Milliseconds latency);
+
     /**
      * Returns true if this node is the master based ONLY on local data. Be careful, return may
      * be stale.
@@ -217,6 +231,18 @@ public:
      */
     static void setSynchronousConfigChangeHook(ConfigChangeHook hook);
 
+    /**
+     * Sets the hook to be called whenever a monitor finds a different primary for its replica set
+     * than the last one it saw, including the first primary it finds. Currently only 1 globally, so
+     * this asserts if one already exists.
+     *
+     * The hook will be called from a fresh thread. It is responsible for initializing any
+     * thread-local state and ensuring that no exceptions escape.
+     *
+     * The hook must not be changed while the program has multiple threads.
+     */
+    static void setPrimaryChangeHook(PrimaryChangeHook hook);
+
     /**
      * Permanently stops all monitoring on replica sets and clears all cached information
      * as well. As a consequence, NEVER call this if you have other threads that have a
@@ -122,6 +122,18 @@ public:
          */
         void update(const IsMasterReply& reply);
 
+        /**
+         * Updates the smoothed latency of the operations run on this node with one which completed.
+         */
+        void updateOperationLatency(int64_t latencyMicros);
+
+        /**
+         * Returns the expected time for an operation sent to this node to complete, from its
+         * operation latency, or its ping time until an operation latency is known, scaled by the
+         * number of operations already in flight to it. Lower is better.
+         */
+        double loadScore() const;
+
         HostAndPort host;
         bool isUp{false};
         bool isMaster{false};
@@ -133,6 +145,13 @@ public:
         Date_t lastWriteDateUpdateTime{};  // set to the local system's time at the time of updating
                                            // lastWriteDate
         repl::OpTime opTime{};             // from isMasterReply
+
+        // Smoothed latency of the operations this process ran on the node, as reported through
+        // ReplicaSetMonitor::operationFinished.
+        int64_t operationLatencyMicros{};
+
+        // Number of operations sent to the node by this process which have not yet completed.
+        int inFlightOperations{};
     };
 
     typedef std::vector<Node> Nodes;
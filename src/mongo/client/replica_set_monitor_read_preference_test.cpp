@@ -298,6 +298,45 @@ TEST(ReplSetMonitorReadPref, NearestOneLocal) {
     ASSERT(!isPrimarySelected);
 }
 
+TEST(ReplSetMonitorReadPref, SecOnlyAvoidsLoadedNode) {
+    vector<Node> nodes = getThreeMemberWithTags();
+    TagSet tags(getDefaultTagSet());
+
+    nodes[0].latencyMicros = 1 * 1000;
+    nodes[2].latencyMicros = 1 * 1000;
+    nodes[0].inFlightOperations = 10;
+
+    for (int i = 0; i < 20; i++) {
+        bool isPrimarySelected = true;
+        HostAndPort host =
+            selectNode(nodes, mongo::ReadPreference::SecondaryOnly, tags, 3, &isPrimarySelected);
+
+        ASSERT_EQUALS("c", host.host());
+        ASSERT(!isPrimarySelected);
+    }
+}
+
+TEST(ReplSetMonitorReadPref, SecOnlyAvoidsSlowNode) {
+    vector<Node> nodes = getThreeMemberWithTags();
+    TagSet tags(getDefaultTagSet());
+
+    nodes[0].latencyMicros = 1 * 1000;
+    nodes[2].latencyMicros = 2 * 1000;
+
+    // The node with the lowest ping time is picked on its operation latency once it is known.
+    nodes[0].updateOperationLatency(50 * 1000);
+    nodes[2].updateOperationLatency(5 * 1000);
+
+    for (int i = 0; i < 20; i++) {
+        bool isPrimarySelected = true;
+        HostAndPort host =
+            selectNode(nodes, mongo::ReadPreference::SecondaryOnly, tags, 3, &isPrimarySelected);
+
+        ASSERT_EQUALS("c", host.host());
+        ASSERT(!isPrimarySelected);
+    }
+}
+
 TEST(ReplSetMonitorReadPref, PriOnlyWithTagsNoMatch) {
     vector<Node> nodes = getThreeMemberWithTags();
     TagSet tags(getP2TagSet());
@@ -217,6 +217,27 @@ void asyncSaslConversation(auth::RunCommandHook runCommand,
                 return handler(status);
             }
 
+            // A server which honors skipEmptyExchange finishes as soon as it has verified the
+            // client's proof, so the client takes its final step without sending its output.
+            if (!session->isDone() && serverResponse[saslCommandDoneFieldName].trueValue()) {
+                std::string payload;
+                BSONType type;
+                status = saslExtractPayload(serverResponse, &payload, &type);
+                if (!status.isOK()) {
+                    return handler(status);
+                }
+
+                std::string unusedPayload;
+                status = session->step(payload, &unusedPayload);
+                if (!status.isOK()) {
+                    return handler(status);
+                }
+                if (!session->isDone()) {
+                    return handler({ErrorCodes::ProtocolError, "Server finished before client."});
+                }
+                return handler(std::move(response));
+            }
+
             // Exit if we have finished
             if (session->isDone()) {
                 bool isServerDone = serverResponse[saslCommandDoneFieldName].trueValue();
@@ -271,9 +292,16 @@ void saslClientAuthenticateImpl(auth::RunCommandHook runCommand,
     if (!status.isOK())
         return handler(std::move(status));
 
-    BSONObj saslFirstCommandPrefix =
-        BSON(saslStartCommandName << 1 << saslCommandMechanismFieldName
-                                  << session->getParameter(SaslClientSession::parameterMechanism));
+    const auto mechanismName = session->getParameter(SaslClientSession::parameterMechanism);
+    BSONObjBuilder saslFirstCommandBuilder;
+    saslFirstCommandBuilder.append(saslStartCommandName, 1);
+    saslFirstCommandBuilder.append(saslCommandMechanismFieldName, mechanismName);
+    if (mechanismName.startsWith("SCRAM-")) {
+        // Servers which do not know of the option ignore it, and expect the empty final message.
+        saslFirstCommandBuilder.append(saslCommandOptionsFieldName,
+                                       BSON(saslCommandSkipEmptyExchangeFieldName << true));
+    }
+    BSONObj saslFirstCommandPrefix = saslFirstCommandBuilder.obj();
     BSONObj inputObj = BSON(saslCommandPayloadFieldName << "");
     asyncSaslConversation(runCommand,
                           session,
@@ -114,6 +114,16 @@ MONGO_INITIALIZER_GENERAL(SetupInternalSecurityUser,
 
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(authorizationManagerCacheSize, int, 100);
 
+// Number of independently locked partitions among which the user cache and its capacity are split.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(authorizationManagerCachePartitions, int, 8)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0) {
+            return Status(ErrorCodes::BadValue,
+                          "authorizationManagerCachePartitions must be strictly positive");
+        }
+        return Status::OK();
+    });
+
 class PinnedUserSetParameter final : public ServerParameter {
 public:
     PinnedUserSetParameter()
@@ -244,9 +254,15 @@ MONGO_REGISTER_SHIM(AuthorizationManager::create)()->std::unique_ptr<Authorizati
  * mutex.  At that point, the thread can make its modifications to the cache and let the guard
  * go out of scope.
  *
- * All updates by guards using a fetch-phase are totally ordered with respect to one another,
- * and all guards using no fetch phase are totally ordered with respect to one another, but
- * there is not a total ordering among all guard objects.
+ * Alternatively, a thread which misses a user in the cache may enter a fetch phase for that user
+ * alone, by first wait()ing until otherUpdateOfUserInFetchPhase() is false, and then calling
+ * beginUserFetchPhase().  Fetch phases for different users proceed concurrently, so that a burst
+ * of new connections does not wait on the fetch of each user in turn.
+ *
+ * All updates by guards using a fetch-phase for all users are totally ordered with respect to
+ * all other fetch-phase updates, updates by guards fetching the same user are totally ordered
+ * with respect to one another, and all guards using no fetch phase are totally ordered with
+ * respect to one another, but there is not a total ordering among all guard objects.
  *
  * The cached data has an associated counter, called the cache generation.  If the cache
  * generation changes while a guard is in fetch phase, the fetched data should not be stored
@@ -274,17 +290,31 @@ public:
             _lock.lock();
         }
         if (_isThisGuardInFetchPhase) {
-            fassert(17190, _authzManager->_isFetchPhaseBusy);
-            _authzManager->_isFetchPhaseBusy = false;
+            if (_fetchingUser) {
+                fassert(51530, _authzManager->_usersBeingFetched.erase(*_fetchingUser) == 1);
+            } else {
+                fassert(17190, _authzManager->_isFetchPhaseBusy);
+                _authzManager->_isFetchPhaseBusy = false;
+            }
             _authzManager->_fetchPhaseIsReady.notify_all();
         }
     }
 
     /**
-     * Returns true of the authzManager reports that it is in fetch phase.
+     * Returns true of the authzManager reports that it is in fetch phase, for all users or any
+     * single one.
      */
     bool otherUpdateInFetchPhase() const {
-        return _authzManager->_isFetchPhaseBusy;
+        return _authzManager->_isFetchPhaseBusy || !_authzManager->_usersBeingFetched.empty();
+    }
+
+    /**
+     * Returns true if the authzManager reports that it is in a fetch phase which may update the
+     * cached 'userName'.
+     */
+    bool otherUpdateOfUserInFetchPhase(const UserName& userName) const {
+        return _authzManager->_isFetchPhaseBusy ||
+            _authzManager->_usersBeingFetched.count(userName);
     }
 
     /**
@@ -308,10 +338,23 @@ public:
      * Sets up the fetch phase without releasing _authzManager->_cacheMutex
      */
     void beginFetchPhaseNoYield() {
-        fassert(17191, !_authzManager->_isFetchPhaseBusy);
+        fassert(17191, !otherUpdateInFetchPhase());
         _isThisGuardInFetchPhase = true;
         _authzManager->_isFetchPhaseBusy = true;
-        _startGeneration = _authzManager->_fetchGeneration;
+        _startGeneration = _authzManager->_invalidationGeneration;
+    }
+
+    /**
+     * Enters fetch phase for 'userName' alone, releasing the _authzManager->_cacheMutex after
+     * recording the current cache generation.
+     */
+    void beginUserFetchPhase(const UserName& userName) {
+        fassert(51531, !otherUpdateOfUserInFetchPhase(userName));
+        _isThisGuardInFetchPhase = true;
+        _fetchingUser = userName;
+        _authzManager->_usersBeingFetched.insert(userName);
+        _startGeneration = _authzManager->_invalidationGeneration;
+        _lock.unlock();
     }
 
     /**
@@ -330,20 +373,21 @@ public:
     }
 
     /**
-     * Returns true if _authzManager->_fetchGeneration remained the same while this guard was
-     * in fetch phase.  Behavior is undefined if this guard never entered fetch phase.
+     * Returns true if no part of the cache was invalidated while this guard was in fetch phase.
+     * Behavior is undefined if this guard never entered fetch phase.
      *
-     * If this returns true, do not update the cached data with this
+     * If this returns false, do not update the cached data with this
      */
     bool isSameCacheGeneration() const {
         fassert(17223, _isThisGuardInFetchPhase);
         fassert(17231, _lock.owns_lock());
-        return _startGeneration == _authzManager->_fetchGeneration;
+        return _startGeneration == _authzManager->_invalidationGeneration;
     }
 
 private:
-    OID _startGeneration;
+    uint64_t _startGeneration = 0;
     bool _isThisGuardInFetchPhase;
+    boost::optional<UserName> _fetchingUser;
     AuthorizationManagerImpl* _authzManager;
     std::unique_ptr<AuthzManagerExternalState::StateLock> _stateLock;
     stdx::unique_lock<stdx::mutex> _lock;
@@ -359,7 +403,9 @@ AuthorizationManagerImpl::AuthorizationManagerImpl(
       _privilegeDocsExist(false),
       _externalState(std::move(externalState)),
       _version(schemaVersionInvalid),
-      _userCache(authorizationManagerCacheSize, UserCacheInvalidator()),
+      _userCache(authorizationManagerCachePartitions,
+                 authorizationManagerCacheSize,
+                 UserCacheInvalidator()),
       _fetchGeneration(OID::gen()),
       _isFetchPhaseBusy(false) {}
 
@@ -550,7 +596,7 @@ StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* o
     }
 
     while ((boost::none == (cachedUser = _userCache.get(userName))) &&
-           guard.otherUpdateInFetchPhase()) {
+           guard.otherUpdateOfUserInFetchPhase(userName)) {
         guard.wait();
     }
 
@@ -558,7 +604,7 @@ StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* o
         return returnUser(cachedUser);
     }
 
-    guard.beginFetchPhase();
+    guard.beginUserFetchPhase(userName);
     // If there's still no user in the cache, then we need to go to disk. Take the slow path.
     LOG(1) << "Getting user " << userName << " from disk";
     auto ret = _acquireUserSlowPath(guard, opCtx, userName);
@@ -731,7 +777,7 @@ Status AuthorizationManagerImpl::_fetchUserV2(OperationContext* opCtx,
 void AuthorizationManagerImpl::invalidateUserByName(OperationContext* opCtx,
                                                     const UserName& userName) {
     CacheGuard guard(opCtx, this);
-    _updateCacheGeneration_inlock(guard);
+    _updateCacheGenerationForInvalidation_inlock(guard);
     _userCache.invalidate(userName);
 
     _recachePinnedUsers(guard, opCtx);
@@ -739,7 +785,7 @@ void AuthorizationManagerImpl::invalidateUserByName(OperationContext* opCtx,
 
 void AuthorizationManagerImpl::invalidateUsersFromDB(OperationContext* opCtx, StringData dbname) {
     CacheGuard guard(opCtx, this);
-    _updateCacheGeneration_inlock(guard);
+    _updateCacheGenerationForInvalidation_inlock(guard);
     _userCache.invalidateIf(
         [&](const UserName& user, const User*) { return user.getDB() == dbname; });
 
@@ -754,7 +800,7 @@ void AuthorizationManagerImpl::invalidateUserCache(OperationContext* opCtx) {
 }
 
 void AuthorizationManagerImpl::_invalidateUserCache_inlock(const CacheGuard& guard) {
-    _updateCacheGeneration_inlock(guard);
+    _updateCacheGenerationForInvalidation_inlock(guard);
     _userCache.invalidateIf([](const UserName& a, const User*) { return true; });
 
     // Reread the schema version before acquiring the next user.
@@ -843,6 +889,12 @@ void AuthorizationManagerImpl::_updateCacheGeneration_inlock(const CacheGuard&)
     _fetchGeneration = OID::gen();
 }
 
+void AuthorizationManagerImpl::_updateCacheGenerationForInvalidation_inlock(
+    const CacheGuard& guard) {
+    _updateCacheGeneration_inlock(guard);
+    ++_invalidationGeneration;
+}
+
 void AuthorizationManagerImpl::_invalidateRelevantCacheData(OperationContext* opCtx,
                                                             const char* op,
                                                             const NamespaceString& ns,
@@ -52,6 +52,7 @@
 #include "mongo/stdx/functional.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/invalidating_lru_cache.h"
 
 namespace mongo {
@@ -167,6 +168,11 @@ private:
      */
     void _updateCacheGeneration_inlock(const CacheGuard&);
 
+    /**
+     * Updates _cacheGeneration and records that data fetched until now may be out of date.
+     */
+    void _updateCacheGenerationForInvalidation_inlock(const CacheGuard&);
+
 
     void _recachePinnedUsers(CacheGuard& guard, OperationContext* opCtx);
 
@@ -223,34 +229,52 @@ private:
      * go to disk to read user privilege documents whenever possible.  Every User object
      * has a reference count - the AuthorizationManager must not delete a User object in the
      * cache unless its reference count is zero.
+     *
+     * Partitioned by user name so that the lookups of new connections do not all serialize on
+     * one mutex, which is not held by lookups once the user is cached.
      */
     struct UserCacheInvalidator {
         void operator()(User* user);
     };
 
-    InvalidatingLRUCache<UserName, User, UserCacheInvalidator> _userCache;
+    PartitionedInvalidatingLRUCache<UserName, User, UserCacheInvalidator> _userCache;
     std::vector<UserHandle> _pinnedUsers;
 
     /**
-     * Protects _cacheGeneration, _version and _isFetchPhaseBusy.  Manipulated
-     * via CacheGuard.
+     * Protects _cacheGeneration, _invalidationGeneration, _version, _isFetchPhaseBusy and
+     * _usersBeingFetched.  Manipulated via CacheGuard.
      */
     stdx::mutex _cacheWriteMutex;
 
     /**
      * Current generation of cached data.  Updated every time part of the cache gets
-     * invalidated.  Protected by CacheGuard.
+     * invalidated or a user gets fetched.  Protected by CacheGuard.
      */
     OID _fetchGeneration;
 
     /**
-     * True if there is an update to the _userCache in progress, and that update is currently in
-     * the "fetch phase", during which it does not hold the _cacheMutex.
+     * Number of times part of the cache got invalidated.  Data fetched while it changed must not
+     * be cached.  Protected by CacheGuard.
+     */
+    uint64_t _invalidationGeneration = 0;
+
+    /**
+     * True if there is an update to the _userCache in progress which excludes all others, and
+     * that update is currently in the "fetch phase", during which it does not hold the
+     * _cacheMutex.
      *
      * Manipulated via CacheGuard.
      */
     bool _isFetchPhaseBusy;
 
+    /**
+     * Users being fetched into the _userCache by acquireUser().  Different users are fetched
+     * concurrently, but each one by a single thread.
+     *
+     * Manipulated via CacheGuard.
+     */
+    stdx::unordered_set<UserName> _usersBeingFetched;
+
     /**
      * Condition used to signal that it is OK for another CacheGuard to enter a fetch phase.
      * Manipulated via CacheGuard.
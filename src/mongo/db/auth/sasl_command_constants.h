@@ -53,6 +53,17 @@ constexpr auto saslCommandDoneFieldName = "done"_sd;
 /// Name of parameter to saslStart command indiciating the client's desired sasl mechanism.
 constexpr auto saslCommandMechanismFieldName = "mechanism"_sd;
 
+/// Name of the optional saslStart parameter containing mechanism specific options.
+constexpr auto saslCommandOptionsFieldName = "options"_sd;
+
+/// Name of the SCRAM option asking the server to complete the conversation as soon as it has
+/// verified the client's proof, rather than waiting for an empty final client message.
+constexpr auto saslCommandSkipEmptyExchangeFieldName = "skipEmptyExchange"_sd;
+
+/// Name of the isMaster parameter containing a saslStart command to run as part of the connection
+/// handshake, and of the field of the isMaster reply which contains its reply.
+constexpr auto saslCommandSpeculativeAuthenticateFieldName = "speculativeAuthenticate"_sd;
+
 /// In the event that saslStart supplies an unsupported mechanism, the server responds with a
 /// field by this name, with a list of supported mechanisms.
 constexpr auto saslCommandMechanismListFieldName = "supportedMechanisms"_sd;
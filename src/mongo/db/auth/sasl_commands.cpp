@@ -45,6 +45,7 @@
 #include "mongo/db/auth/authz_manager_external_state_mock.h"
 #include "mongo/db/auth/authz_session_external_state_mock.h"
 #include "mongo/db/auth/sasl_command_constants.h"
+#include "mongo/db/auth/sasl_mechanism_registry.h"
 #include "mongo/db/auth/sasl_options.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands.h"
@@ -238,6 +239,17 @@ StatusWith<std::unique_ptr<AuthenticationSession>> doSaslStart(OperationContext*
         return swMech.getStatus();
     }
 
+    BSONElement options = cmdObj[saslCommandOptionsFieldName];
+    if (!options.eoo()) {
+        if (options.type() != Object) {
+            return Status(ErrorCodes::TypeMismatch,
+                          str::stream() << "Wrong type for field; expected object for " << options);
+        }
+        status = swMech.getValue()->setOptions(options.Obj());
+        if (!status.isOK())
+            return status;
+    }
+
     auto session = std::make_unique<AuthenticationSession>(std::move(swMech.getValue()));
     Status statusStep = doSaslStep(opCtx, session.get(), cmdObj, result);
     if (!statusStep.isOK()) {
@@ -261,6 +273,51 @@ Status doSaslContinue(OperationContext* opCtx,
     return doSaslStep(opCtx, session, cmdObj, result);
 }
 
+void doSpeculativeSaslStart(OperationContext* opCtx,
+                            const BSONObj& isMasterCmd,
+                            BSONObjBuilder* result) {
+    BSONElement element = isMasterCmd[saslCommandSpeculativeAuthenticateFieldName];
+    if (element.eoo()) {
+        return;
+    }
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << "Wrong type for field; expected object for " << element,
+            element.type() == Object);
+
+    const BSONObj cmdObj = element.Obj();
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "Only " << saslStartCommandName
+                          << " may be run speculatively, found: "
+                          << cmdObj.firstElementFieldName(),
+            cmdObj.firstElementFieldNameStringData() == saslStartCommandName);
+
+    std::string db;
+    uassertStatusOK(bsonExtractStringField(cmdObj, saslCommandUserDBFieldName, &db));
+
+    Client* client = opCtx->getClient();
+    AuthenticationSession::set(client, std::unique_ptr<AuthenticationSession>());
+
+    BSONObjBuilder saslStartResult;
+    auto swSession = doSaslStart(opCtx, db, cmdObj, &saslStartResult);
+    if (!swSession.isOK()) {
+        LOG(1) << "Speculative authentication failed, the client will retry with "
+               << saslStartCommandName << ": " << swSession.getStatus();
+        return;
+    }
+    auto session = std::move(swSession.getValue());
+
+    auto& mechanism = session->getMechanism();
+    if (mechanism.isDone()) {
+        audit::logAuthentication(client,
+                                 mechanism.mechanismName(),
+                                 UserName(mechanism.getPrincipalName(), db),
+                                 ErrorCodes::OK);
+    } else {
+        AuthenticationSession::swap(client, session);
+    }
+    result->append(saslCommandSpeculativeAuthenticateFieldName, saslStartResult.obj());
+}
+
 CmdSaslStart::CmdSaslStart() : BasicCommand(saslStartCommandName) {}
 CmdSaslStart::~CmdSaslStart() {}
 
@@ -351,5 +408,10 @@ MONGO_INITIALIZER(PreSaslCommands)
     return Status::OK();
 }
 
+MONGO_INITIALIZER(SpeculativeSaslStartFunction)(InitializerContext* context) {
+    speculativeSaslStart = doSpeculativeSaslStart;
+    return Status::OK();
+}
+
 }  // namespace
 }  // namespace mongo
@@ -47,6 +47,12 @@ const auto getSASLServerMechanismRegistry =
     ServiceContext::declareDecoration<std::unique_ptr<SASLServerMechanismRegistry>>();
 }  // namespace
 
+void (*speculativeSaslStart)(OperationContext* opCtx,
+                             const BSONObj& isMasterCmd,
+                             BSONObjBuilder* builder) = [](OperationContext*,
+                                                           const BSONObj&,
+                                                           BSONObjBuilder*) {};
+
 SASLServerMechanismRegistry& SASLServerMechanismRegistry::get(ServiceContext* serviceContext) {
     auto& uptr = getSASLServerMechanismRegistry(serviceContext);
     invariant(uptr);
@@ -135,6 +135,14 @@ public:
         return requestedUser == authenticatedUser;
     }
 
+    /**
+     * Applies the mechanism specific "options" supplied by the client along with the first step
+     * of the conversation. Mechanisms which have no options ignore them.
+     */
+    virtual Status setOptions(const BSONObj& options) {
+        return Status::OK();
+    }
+
     /**
      * Performs a single step of a SASL exchange. Takes an input provided by a client,
      * and either returns an error, or a response to be sent back.
@@ -348,4 +356,17 @@ public:
                            });
     }
 };
+
+/**
+ * If isMasterCmd contains a field called 'speculativeAuthenticate' holding a saslStart command,
+ * runs its first step on behalf of the connection and populates 'builder' with its reply under
+ * the same name, saving a round trip before the client continues the conversation with
+ * saslContinue. Failing to start the conversation is not an error: the reply is omitted, and the
+ * client starts over with saslStart.
+ *
+ * Installed by the SASL authentication commands, so that isMaster does not have to link them.
+ */
+extern void (*speculativeSaslStart)(OperationContext* opCtx,
+                                    const BSONObj& isMasterCmd,
+                                    BSONObjBuilder* builder);
 }  // namespace mongo
@@ -39,8 +39,10 @@
 #include "mongo/base/init.h"
 #include "mongo/base/status.h"
 #include "mongo/base/string_data.h"
+#include "mongo/bson/util/bson_extract.h"
 #include "mongo/crypto/mechanism_scram.h"
 #include "mongo/crypto/sha1_block.h"
+#include "mongo/db/auth/sasl_command_constants.h"
 #include "mongo/db/auth/sasl_mechanism_policies.h"
 #include "mongo/db/auth/sasl_mechanism_registry.h"
 #include "mongo/db/auth/sasl_options.h"
@@ -74,6 +76,12 @@ StatusWith<std::tuple<bool, std::string>> SaslSCRAMServerMechanism<Policy>::step
     return std::make_tuple(true, std::string{});
 }
 
+template <typename Policy>
+Status SaslSCRAMServerMechanism<Policy>::setOptions(const BSONObj& options) {
+    return bsonExtractBooleanFieldWithDefault(
+        options, saslCommandSkipEmptyExchangeFieldName, false, &_skipEmptyExchange);
+}
+
 /*
  * RFC 5802 specifies that in SCRAM user names characters ',' and '=' are encoded as
  * =2C and =3D respectively.
@@ -334,7 +342,9 @@ StatusWith<std::tuple<bool, std::string>> SaslSCRAMServerMechanism<Policy>::_sec
     // ServerSignature := HMAC(ServerKey, AuthMessage)
     sb << "v=" << _secrets.generateServerSignature(_authMessage);
 
-    return std::make_tuple(false, sb.str());
+    // The client's proof has been verified, so a client which will check the server signature
+    // without answering it does not need to be made to send the empty third message.
+    return std::make_tuple(_skipEmptyExchange, sb.str());
 }
 
 template class SaslSCRAMServerMechanism<SCRAMSHA1Policy>;
@@ -58,6 +58,12 @@ public:
     StatusWith<std::tuple<bool, std::string>> stepImpl(OperationContext* opCtx,
                                                        StringData inputData);
 
+    /**
+     * Accepts the "skipEmptyExchange" option, with which the conversation completes with the
+     * server-final-message instead of after an additional empty client message.
+     */
+    Status setOptions(const BSONObj& options) final;
+
     StatusWith<std::string> saslPrep(StringData str) const {
         if (std::is_same<SHA1Block, HashBlock>::value) {
             return str.toString();
@@ -85,6 +91,8 @@ private:
 
     // client and server nonce concatenated
     std::string _nonce;
+
+    bool _skipEmptyExchange{false};
 };
 
 extern template class SaslSCRAMServerMechanism<SCRAMSHA1Policy>;
@@ -404,6 +404,42 @@ TEST_F(SCRAMFixture, testSCRAM) {
     ASSERT_EQ(goalState, runSteps());
 }
 
+TEST_F(SCRAMFixture, testSCRAMWithSkipEmptyExchange) {
+    ASSERT_OK(authzManagerExternalState->insertPrivilegeDocument(
+        opCtx.get(), generateSCRAMUserDocument("sajack", "sajack"), BSONObj()));
+
+    saslClientSession->setParameter(NativeSaslClientSession::parameterUser, "sajack");
+    saslClientSession->setParameter(NativeSaslClientSession::parameterPassword,
+                                    createPasswordDigest("sajack", "sajack"));
+
+    ASSERT_OK(saslClientSession->initialize());
+    ASSERT_OK(saslServerSession->setOptions(BSON("skipEmptyExchange" << true)));
+
+    std::string clientOutput;
+    std::string serverOutput;
+    for (size_t step = 1; step <= 2; step++) {
+        ASSERT_FALSE(saslServerSession->isDone());
+        ASSERT_OK(saslClientSession->step(serverOutput, &clientOutput));
+        ASSERT_FALSE(saslClientSession->isDone());
+
+        auto swServerResult = saslServerSession->step(opCtx.get(), clientOutput);
+        ASSERT_OK(swServerResult.getStatus());
+        serverOutput = std::move(swServerResult.getValue());
+    }
+
+    // The server completes upon verifying the client's proof, and the client completes upon
+    // verifying the server's signature, without sending anything further.
+    ASSERT_TRUE(saslServerSession->isDone());
+    ASSERT_OK(saslClientSession->step(serverOutput, &clientOutput));
+    ASSERT_TRUE(saslClientSession->isDone());
+}
+
+TEST_F(SCRAMFixture, testSCRAMWithInvalidSkipEmptyExchange) {
+    ASSERT_EQ(ErrorCodes::TypeMismatch,
+              saslServerSession->setOptions(BSON("skipEmptyExchange"
+                                                 << "yes")));
+}
+
 TEST_F(SCRAMFixture, testSCRAMWithChannelBindingSupportedByClient) {
     ASSERT_OK(authzManagerExternalState->insertPrivilegeDocument(
         opCtx.get(), generateSCRAMUserDocument("sajack", "sajack"), BSONObj()));
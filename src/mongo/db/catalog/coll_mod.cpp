@@ -77,6 +77,7 @@ struct CollModRequest {
     std::string collValidationLevel = {};
     BSONElement usePowerOf2Sizes = {};
     BSONElement noPadding = {};
+    BSONElement recordChangeStreamImages = {};
 };
 
 StatusWith<CollModRequest> parseCollModRequest(OperationContext* opCtx,
@@ -210,6 +211,8 @@ StatusWith<CollModRequest> parseCollModRequest(OperationContext* opCtx,
                 return statusW.getStatus();
 
             cmr.collValidationAction = e.String();
+        } else if (fieldName == "recordChangeStreamImages" && !isView) {
+            cmr.recordChangeStreamImages = e;
         } else if (fieldName == "pipeline") {
             if (!isView) {
                 return Status(ErrorCodes::InvalidOptions,
@@ -417,6 +420,9 @@ Status _collModInternal(OperationContext* opCtx,
     if (!cmr.collValidationLevel.empty())
         invariant(coll->setValidationLevel(opCtx, cmr.collValidationLevel));
 
+    if (!cmr.recordChangeStreamImages.eoo())
+        coll->setRecordChangeStreamImages(opCtx, cmr.recordChangeStreamImages.trueValue());
+
     // UsePowerof2Sizes
     if (!cmr.usePowerOf2Sizes.eoo())
         setCollectionOptionFlag(opCtx, coll, cmr.usePowerOf2Sizes, result);
@@ -319,6 +319,9 @@ public:
                                        StringData newLevel,
                                        StringData newAction) = 0;
 
+        virtual bool getRecordChangeStreamImages() const = 0;
+        virtual void setRecordChangeStreamImages(OperationContext* opCtx, bool record) = 0;
+
         virtual bool isCapped() const = 0;
 
         virtual std::shared_ptr<CappedInsertNotifier> getCappedInsertNotifier() const = 0;
@@ -654,6 +657,21 @@ public:
         return this->_impl().updateValidator(opCtx, newValidator, newLevel, newAction);
     }
 
+    /**
+     * Returns whether updates to this collection record the pre- and post-images of the updated
+     * document for change streams.
+     */
+    inline bool getRecordChangeStreamImages() const {
+        return this->_impl().getRecordChangeStreamImages();
+    }
+
+    /**
+     * Requires an exclusive lock on the collection.
+     */
+    inline void setRecordChangeStreamImages(OperationContext* const opCtx, const bool record) {
+        return this->_impl().setRecordChangeStreamImages(opCtx, record);
+    }
+
     // -----------
 
     //
@@ -152,6 +152,11 @@ public:
      */
     virtual void setIsTemp(OperationContext* opCtx, bool isTemp) = 0;
 
+    /**
+     * Updates the 'recordChangeStreamImages' setting for this collection.
+     */
+    virtual void setRecordChangeStreamImages(OperationContext* opCtx, bool record) = 0;
+
     /**
      * Compare the UUID argument to the UUID obtained from the metadata. Return true if they
      * are equal, false otherwise. uuid can become a CollectionUUID once MMAPv1 is removed.
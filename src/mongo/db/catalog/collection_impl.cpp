@@ -55,8 +55,10 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/schema/compiled_json_schema.h"
 #include "mongo/db/op_observer.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/ops/update_request.h"
@@ -107,6 +109,10 @@ MONGO_FAIL_POINT_DEFINE(failCollectionInserts);
 // their OpTime and oplog entry.
 MONGO_FAIL_POINT_DEFINE(hangAfterCollectionInserts);
 
+// When true, documents are checked against a $jsonSchema validator by a compiled walk of the
+// document, if the schema only uses the keywords it supports, rather than by the match expression.
+MONGO_EXPORT_SERVER_PARAMETER(internalCompileJSONSchemaValidators, bool, true);
+
 // Uses the collator factory to convert the BSON representation of a collator to a
 // CollatorInterface. Returns null if the BSONObj is empty. We expect the stored collation to be
 // valid, since it gets validated on collection create.
@@ -154,7 +160,8 @@ CollectionImpl::CollectionImpl(Collection* _this_init,
       _details(details),
       _recordStore(recordStore),
       _dbce(dbce),
-      _needCappedLock(supportsDocLocking() && _recordStore->isCapped() && _ns.db() != "local"),
+      _needCappedLock(supportsDocLocking() && _recordStore->isCapped() && _ns.db() != "local" &&
+                      !_recordStore->supportsConcurrentCappedInserts()),
       _infoCache(_this_init, _ns),
       _indexCatalog(std::make_unique<IndexCatalogImpl>(_this_init,
                                                        getCatalogEntry()->getMaxAllowedIndexes())),
@@ -162,10 +169,12 @@ CollectionImpl::CollectionImpl(Collection* _this_init,
       _validatorDoc(_details->getCollectionOptions(opCtx).validator.getOwned()),
       _validator(uassertStatusOK(
           parseValidator(opCtx, _validatorDoc, MatchExpressionParser::kAllowAllSpecialFeatures))),
+      _compiledValidator(_validator ? CompiledJSONSchema::compile(_validatorDoc) : nullptr),
       _validationAction(uassertStatusOK(
           parseValidationAction(_details->getCollectionOptions(opCtx).validationAction))),
       _validationLevel(uassertStatusOK(
           parseValidationLevel(_details->getCollectionOptions(opCtx).validationLevel))),
+      _recordChangeStreamImages(_details->getCollectionOptions(opCtx).recordChangeStreamImages),
       _cursorManager(_ns),
       _cappedNotifier(_recordStore->isCapped() ? stdx::make_unique<CappedInsertNotifier>()
                                                : nullptr),
@@ -247,8 +256,12 @@ Status CollectionImpl::checkValidation(OperationContext* opCtx, const BSONObj& d
     if (documentValidationDisabled(opCtx))
         return Status::OK();
 
-    if (_validator->matchesBSON(document))
+    if (_compiledValidator && internalCompileJSONSchemaValidators.load()) {
+        if (_compiledValidator->matches(document))
+            return Status::OK();
+    } else if (_validator->matchesBSON(document)) {
         return Status::OK();
+    }
 
     if (_validationAction == ValidationAction::WARN) {
         warning() << "Document would fail validation"
@@ -368,6 +381,7 @@ Status CollectionImpl::insertDocuments(OperationContext* opCtx,
 
     getGlobalServiceContext()->getOpObserver()->onInserts(
         opCtx, ns(), uuid(), begin, end, fromMigrate);
+    _infoCache.notifyOfWrite(opCtx);
 
     opCtx->recoveryUnit()->onCommit(
         [this](boost::optional<Timestamp>) { notifyCappedWaitersIfNeeded(); });
@@ -450,6 +464,7 @@ Status CollectionImpl::insertDocument(OperationContext* opCtx,
 
     getGlobalServiceContext()->getOpObserver()->onInserts(
         opCtx, ns(), uuid(), inserts.begin(), inserts.end(), false);
+    _infoCache.notifyOfWrite(opCtx);
 
     opCtx->recoveryUnit()->onCommit(
         [this](boost::optional<Timestamp>) { notifyCappedWaitersIfNeeded(); });
@@ -577,6 +592,7 @@ void CollectionImpl::deleteDocument(OperationContext* opCtx,
 
     getGlobalServiceContext()->getOpObserver()->onDelete(
         opCtx, ns(), uuid(), stmtId, fromMigrate, deletedDoc);
+    _infoCache.notifyOfWrite(opCtx);
 }
 
 Counter64 moveCounter;
@@ -649,6 +665,11 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
             IndexCatalogEntry* entry = ii.catalogEntry(descriptor);
             IndexAccessMethod* iam = ii.accessMethod(descriptor);
 
+            if (auto interceptor = entry->indexBuildInterceptor()) {
+                interceptor->sideWrite(opCtx, oldLocation, &oldDoc.value());
+                continue;
+            }
+
             InsertDeleteOptions options;
             _indexCatalog->prepareInsertDeleteOptions(opCtx, descriptor, &options);
             UpdateTicket* updateTicket = new UpdateTicket();
@@ -674,6 +695,9 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
         while (ii.more()) {
             IndexDescriptor* descriptor = ii.next();
             IndexAccessMethod* iam = ii.accessMethod(descriptor);
+            if (!updateTickets.map().count(descriptor)) {
+                continue;
+            }
 
             int64_t keysInserted;
             int64_t keysDeleted;
@@ -691,7 +715,9 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
 
     invariant(uuid());
     OplogUpdateEntryArgs entryArgs(*args, ns(), *uuid());
+    entryArgs.recordChangeStreamImages = _recordChangeStreamImages;
     getGlobalServiceContext()->getOpObserver()->onUpdate(opCtx, entryArgs);
+    _infoCache.notifyOfWrite(opCtx);
 
     return {oldLocation};
 }
@@ -714,6 +740,10 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
     invariant(oldRec.snapshotId() == opCtx->recoveryUnit()->getSnapshotId());
     invariant(updateWithDamagesSupported());
 
+    if (_recordChangeStreamImages && !args->preImageDoc) {
+        args->preImageDoc = oldRec.value().toBson().getOwned();
+    }
+
     auto newRecStatus =
         _recordStore->updateWithDamages(opCtx, loc, oldRec.value(), damageSource, damages);
 
@@ -722,7 +752,9 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
 
         invariant(uuid());
         OplogUpdateEntryArgs entryArgs(*args, ns(), *uuid());
+        entryArgs.recordChangeStreamImages = _recordChangeStreamImages;
         getGlobalServiceContext()->getOpObserver()->onUpdate(opCtx, entryArgs);
+        _infoCache.notifyOfWrite(opCtx);
     }
     return newRecStatus;
 }
@@ -796,6 +828,7 @@ Status CollectionImpl::truncate(OperationContext* opCtx) {
     auto status = _recordStore->truncate(opCtx);
     if (!status.isOK())
         return status;
+    _infoCache.notifyOfWrite(opCtx);
 
     // 4) re-create indexes
     for (size_t i = 0; i < indexSpecs.size(); i++) {
@@ -815,6 +848,7 @@ void CollectionImpl::cappedTruncateAfter(OperationContext* opCtx, RecordId end,
 
     _cursorManager.invalidateAll(opCtx, false, "capped collection truncated");
     _recordStore->cappedTruncateAfter(opCtx, end, inclusive);
+    _infoCache.notifyOfWrite(opCtx);
 }
 
 Status CollectionImpl::setValidator(OperationContext* opCtx, BSONObj validatorDoc) {
@@ -836,12 +870,15 @@ Status CollectionImpl::setValidator(OperationContext* opCtx, BSONObj validatorDo
     opCtx->recoveryUnit()->onRollback([
         this,
         oldValidator = std::move(_validator),
+        oldCompiledValidator = std::move(_compiledValidator),
         oldValidatorDoc = std::move(_validatorDoc)
     ]() mutable {
         this->_validator = std::move(oldValidator);
+        this->_compiledValidator = std::move(oldCompiledValidator);
         this->_validatorDoc = std::move(oldValidatorDoc);
     });
     _validator = std::move(statusWithMatcher.getValue());
+    _compiledValidator = _validator ? CompiledJSONSchema::compile(validatorDoc) : nullptr;
     _validatorDoc = std::move(validatorDoc);
     return Status::OK();
 }
@@ -943,11 +980,13 @@ Status CollectionImpl::updateValidator(OperationContext* opCtx,
     opCtx->recoveryUnit()->onRollback([
         this,
         oldValidator = std::move(_validator),
+        oldCompiledValidator = std::move(_compiledValidator),
         oldValidatorDoc = std::move(_validatorDoc),
         oldValidationLevel = _validationLevel,
         oldValidationAction = _validationAction
     ]() mutable {
         this->_validator = std::move(oldValidator);
+        this->_compiledValidator = std::move(oldCompiledValidator);
         this->_validatorDoc = std::move(oldValidatorDoc);
         this->_validationLevel = oldValidationLevel;
         this->_validationAction = oldValidationAction;
@@ -962,6 +1001,7 @@ Status CollectionImpl::updateValidator(OperationContext* opCtx,
         return validatorSW.getStatus();
     }
     _validator = std::move(validatorSW.getValue());
+    _compiledValidator = _validator ? CompiledJSONSchema::compile(_validatorDoc) : nullptr;
 
     auto levelSW = parseValidationLevel(newLevel);
     if (!levelSW.isOK()) {
@@ -978,6 +1018,18 @@ Status CollectionImpl::updateValidator(OperationContext* opCtx,
     return Status::OK();
 }
 
+void CollectionImpl::setRecordChangeStreamImages(OperationContext* opCtx, bool record) {
+    invariant(opCtx->lockState()->isCollectionLockedForMode(ns().toString(), MODE_X));
+
+    auto oldRecordChangeStreamImages = _recordChangeStreamImages;
+    _recordChangeStreamImages = record;
+
+    _details->setRecordChangeStreamImages(opCtx, record);
+    opCtx->recoveryUnit()->onRollback([this, oldRecordChangeStreamImages]() {
+        this->_recordChangeStreamImages = oldRecordChangeStreamImages;
+    });
+}
+
 const CollatorInterface* CollectionImpl::getDefaultCollator() const {
     return _collator.get();
 }
@@ -992,17 +1044,20 @@ void _validateRecordStore(OperationContext* opCtx,
                           bool background,
                           RecordStoreValidateAdaptor* indexValidator,
                           ValidateResults* results,
-                          BSONObjBuilder* output) {
+                          BSONObjBuilder* output,
+                          int64_t* numRecords) {
 
     // Validate RecordStore and, if `level == kValidateFull`, use the RecordStore's validate
-    // function.
+    // function. A background validation reads the records in its snapshot while writes go on, so
+    // their number is counted rather than taken from the record store.
     if (background) {
-        indexValidator->traverseRecordStore(recordStore, level, results, output);
+        indexValidator->traverseRecordStore(recordStore, level, results, output, numRecords);
     } else {
         auto status = recordStore->validate(opCtx, level, indexValidator, results, output);
         // RecordStore::validate always returns Status::OK(). Errors are reported through
         // `results`.
         dassert(status.isOK());
+        *numRecords = recordStore->numRecords(opCtx);
     }
 }
 
@@ -1074,7 +1129,7 @@ void _markIndexEntriesInvalid(ValidateResultsMap* indexNsResultsMap, ValidateRes
 
 void _validateIndexKeyCount(OperationContext* opCtx,
                             IndexCatalog* indexCatalog,
-                            RecordStore* recordStore,
+                            int64_t numRecords,
                             RecordStoreValidateAdaptor* indexValidator,
                             ValidateResultsMap* indexNsResultsMap) {
 
@@ -1084,8 +1139,7 @@ void _validateIndexKeyCount(OperationContext* opCtx,
         ValidateResults& curIndexResults = (*indexNsResultsMap)[descriptor->indexNamespace()];
 
         if (curIndexResults.valid) {
-            indexValidator->validateIndexKeyCount(
-                descriptor, recordStore->numRecords(opCtx), curIndexResults);
+            indexValidator->validateIndexKeyCount(descriptor, numRecords, curIndexResults);
         }
     }
 }
@@ -1198,7 +1252,7 @@ Status CollectionImpl::validate(OperationContext* opCtx,
         BSONObjBuilder keysPerIndex;  // not using subObjStart to be exception safe
         IndexConsistency indexConsistency(
             opCtx, _this, ns(), _recordStore, std::move(collLk), background);
-        RecordStoreValidateAdaptor indexValidator = RecordStoreValidateAdaptor(
+        RecordStoreValidateAdaptor indexValidator(
             opCtx, &indexConsistency, level, _indexCatalog.get(), &indexNsResultsMap);
 
         // Validate the record store
@@ -1206,8 +1260,9 @@ Status CollectionImpl::validate(OperationContext* opCtx,
             << " (UUID: " << (uuid() ? uuid()->toString() : "none") << ")";
         log(LogComponent::kIndex) << "validating collection " << ns().toString() << uuidString
                                   << endl;
+        int64_t numRecords = 0;
         _validateRecordStore(
-            opCtx, _recordStore, level, background, &indexValidator, results, output);
+            opCtx, _recordStore, level, background, &indexValidator, results, output, &numRecords);
 
         // Validate in-memory catalog information with the persisted info.
         _validateCatalogEntry(opCtx, this, _validatorDoc, results);
@@ -1230,7 +1285,7 @@ Status CollectionImpl::validate(OperationContext* opCtx,
         // Validate index key count.
         if (results->valid) {
             _validateIndexKeyCount(
-                opCtx, _indexCatalog.get(), _recordStore, &indexValidator, &indexNsResultsMap);
+                opCtx, _indexCatalog.get(), numRecords, &indexValidator, &indexNsResultsMap);
         }
 
         // Report the validation results for the user to see
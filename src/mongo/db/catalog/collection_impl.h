@@ -35,6 +35,7 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 
 namespace mongo {
+class CompiledJSONSchema;
 class IndexConsistency;
 class UUIDCatalog;
 class CollectionImpl final : virtual public Collection::Impl, virtual CappedCallback {
@@ -299,6 +300,12 @@ public:
                            StringData newLevel,
                            StringData newAction) final;
 
+    bool getRecordChangeStreamImages() const final {
+        return _recordChangeStreamImages;
+    }
+
+    void setRecordChangeStreamImages(OperationContext* opCtx, bool record) final;
+
     // -----------
 
     //
@@ -410,9 +417,15 @@ private:
     // Points into _validatorDoc. Null means no filter.
     std::unique_ptr<MatchExpression> _validator;
 
+    // Checks documents against _validator in a single pass if it is a $jsonSchema which can be
+    // compiled. Null otherwise.
+    std::unique_ptr<CompiledJSONSchema> _compiledValidator;
+
     ValidationAction _validationAction;
     ValidationLevel _validationLevel;
 
+    bool _recordChangeStreamImages;
+
     // this is mutable because read only users of the Collection class
     // use it keep state.  This seems valid as const correctness of Collection
     // should be about the data.
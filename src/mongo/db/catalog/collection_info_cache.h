@@ -31,6 +31,7 @@
 #include "mongo/base/shim.h"
 #include "mongo/db/collection_index_usage_tracker.h"
 #include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/query_result_cache.h"
 #include "mongo/db/query/query_settings.h"
 #include "mongo/db/update_index_data.h"
 #include "mongo/stdx/functional.h"
@@ -54,6 +55,8 @@ public:
 
         virtual QuerySettings* getQuerySettings() const = 0;
 
+        virtual QueryResultCache* getQueryResultCache() const = 0;
+
         virtual const UpdateIndexData& getIndexKeys(OperationContext* opCtx) const = 0;
 
         virtual CollectionIndexUsageMap getIndexUsageStats() const = 0;
@@ -68,6 +71,8 @@ public:
 
         virtual void notifyOfQuery(OperationContext* opCtx,
                                    const std::set<std::string>& indexesUsed) = 0;
+
+        virtual void notifyOfWrite(OperationContext* opCtx) = 0;
     };
 
 
@@ -103,6 +108,13 @@ public:
         return this->_impl().getQuerySettings();
     }
 
+    /**
+     * Get the QueryResultCache for this collection, or nullptr if results are not cached.
+     */
+    inline QueryResultCache* getQueryResultCache() const {
+        return this->_impl().getQueryResultCache();
+    }
+
     /* get set of index keys for this namespace.  handy to quickly check if a given
        field is indexed (Note it might be a secondary component of a compound index.)
     */
@@ -157,6 +169,14 @@ public:
         return this->_impl().notifyOfQuery(opCtx, indexesUsed);
     }
 
+    /**
+     * Signal to the cache that a document of the collection was written by the current unit of
+     * work. The cached query results are discarded once it commits.
+     */
+    inline void notifyOfWrite(OperationContext* const opCtx) {
+        return this->_impl().notifyOfWrite(opCtx);
+    }
+
     std::unique_ptr<Impl> _pimpl;
 
     // This structure exists to give us a customization point to decide how to force users of this
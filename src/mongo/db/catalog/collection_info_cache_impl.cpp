@@ -32,6 +32,8 @@
 
 #include "mongo/db/catalog/collection_info_cache_impl.h"
 
+#include <map>
+
 #include "mongo/base/init.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_catalog.h"
@@ -40,9 +42,14 @@
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_key_generator.h"
 #include "mongo/db/index_legacy.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/query/query_result_cache.h"
+#include "mongo/db/query/shared_plan_cache_registry.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/ttl_collection_cache.h"
 #include "mongo/stdx/memory.h"
@@ -61,8 +68,10 @@ CollectionInfoCacheImpl::CollectionInfoCacheImpl(Collection* collection, const N
     : _collection(collection),
       _ns(ns),
       _keysComputed(false),
-      _planCache(stdx::make_unique<PlanCache>(ns.ns())),
+      _planCache(std::make_shared<PlanCache>(ns.ns())),
       _querySettings(stdx::make_unique<QuerySettings>()),
+      _queryResultCache(internalQueryResultCacheEnabled ? std::make_shared<QueryResultCache>()
+                                                        : nullptr),
       _indexUsageTracker(getGlobalServiceContext()->getPreciseClockSource()) {}
 
 CollectionInfoCacheImpl::~CollectionInfoCacheImpl() {
@@ -105,6 +114,13 @@ void CollectionInfoCacheImpl::computeIndexKeys(OperationContext* opCtx) {
                     _indexedPaths.addPath(path);
                 }
             }
+            // The prefix fields of a compound $** index lead each of its keys.
+            const auto numPrefixFields =
+                WildcardKeyGenerator::numPrefixFields(descriptor->keyPattern());
+            BSONObjIterator keyPatternIt(descriptor->keyPattern());
+            for (size_t i = 0; i < numPrefixFields; ++i) {
+                _indexedPaths.addPath(FieldRef(keyPatternIt.next().fieldNameStringData()));
+            }
         } else if (descriptor->getAccessMethodName() == IndexNames::TEXT) {
             fts::FTSSpec ftsSpec(descriptor->infoObj());
 
@@ -191,8 +207,26 @@ QuerySettings* CollectionInfoCacheImpl::getQuerySettings() const {
     return _querySettings.get();
 }
 
+QueryResultCache* CollectionInfoCacheImpl::getQueryResultCache() const {
+    return _queryResultCache.get();
+}
+
+void CollectionInfoCacheImpl::notifyOfWrite(OperationContext* opCtx) {
+    if (!_queryResultCache) {
+        return;
+    }
+
+    // The collection may be dropped by the time the write commits, so the handler keeps its own
+    // reference to the cache.
+    opCtx->recoveryUnit()->onCommit(
+        [queryResultCache = _queryResultCache](boost::optional<Timestamp>) {
+            queryResultCache->notifyOfWrite();
+        });
+}
+
 void CollectionInfoCacheImpl::updatePlanCacheIndexEntries(OperationContext* opCtx) {
     std::vector<IndexEntry> indexEntries;
+    std::map<std::string, BSONObj> indexSpecs;
 
     // TODO We shouldn't need to include unfinished indexes, but we must here because the index
     // catalog may be in an inconsistent state.  SERVER-18346.
@@ -203,6 +237,28 @@ void CollectionInfoCacheImpl::updatePlanCacheIndexEntries(OperationContext* opCt
         const IndexDescriptor* desc = ii.next();
         const IndexCatalogEntry* ice = ii.catalogEntry(desc);
         indexEntries.emplace_back(indexEntryFromIndexCatalogEntry(opCtx, *ice));
+        indexSpecs.emplace(desc->indexName(),
+                           desc->infoObj().removeField(IndexDescriptor::kNamespaceFieldName));
+    }
+
+    if (internalQueryCacheShareAcrossCollections) {
+        // Collections whose indexes differ only in namespace share one plan cache, so the
+        // signature is every index spec, ordered by name, without its 'ns' field.
+        BSONObjBuilder signature;
+        if (auto collator = _collection->getDefaultCollator()) {
+            signature.append("collation", collator->getSpec().toBSON());
+        }
+        BSONArrayBuilder specs(signature.subarrayStart("indexes"));
+        for (auto&& spec : indexSpecs) {
+            specs.append(spec.second);
+        }
+        specs.doneFast();
+        BSONObj signatureObj = signature.obj();
+
+        _planCache = SharedPlanCacheRegistry::get(opCtx->getServiceContext())
+                         .getPlanCache(std::string(signatureObj.objdata(), signatureObj.objsize()),
+                                       indexEntries);
+        return;
     }
 
     _planCache->notifyOfIndexEntries(indexEntries);
@@ -242,7 +298,16 @@ void CollectionInfoCacheImpl::droppedIndex(OperationContext* opCtx, StringData i
 }
 
 void CollectionInfoCacheImpl::rebuildIndexData(OperationContext* opCtx) {
-    clearQueryCache();
+    // A shared plan cache is still valid for the other collections holding it. This collection
+    // moves to the cache for its new index signature instead.
+    if (!internalQueryCacheShareAcrossCollections) {
+        clearQueryCache();
+    }
+
+    // Cached results may rely on the indexes they were computed with, for example through a hint.
+    if (_queryResultCache) {
+        _queryResultCache->notifyOfWrite();
+    }
 
     _keysComputed = false;
     computeIndexKeys(opCtx);
@@ -33,6 +33,7 @@
 #include "mongo/base/shim.h"
 #include "mongo/db/collection_index_usage_tracker.h"
 #include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/query_result_cache.h"
 #include "mongo/db/query/query_settings.h"
 #include "mongo/db/update_index_data.h"
 
@@ -62,6 +63,11 @@ public:
      */
     QuerySettings* getQuerySettings() const;
 
+    /**
+     * Get the QueryResultCache for this collection, or nullptr if results are not cached.
+     */
+    QueryResultCache* getQueryResultCache() const;
+
     /* get set of index keys for this namespace.  handy to quickly check if a given
        field is indexed (Note it might be a secondary component of a compound index.)
     */
@@ -108,6 +114,12 @@ public:
      */
     void notifyOfQuery(OperationContext* opCtx, const std::set<std::string>& indexesUsed);
 
+    /**
+     * Signal to the cache that a document of the collection was written by the current unit of
+     * work. The cached query results are discarded once it commits.
+     */
+    void notifyOfWrite(OperationContext* opCtx);
+
 private:
     void computeIndexKeys(OperationContext* opCtx);
     void updatePlanCacheIndexEntries(OperationContext* opCtx);
@@ -125,13 +137,18 @@ private:
     bool _keysComputed;
     UpdateIndexData _indexedPaths;
 
-    // A cache for query plans.
-    std::unique_ptr<PlanCache> _planCache;
+    // A cache for query plans. Shared with collections having the same index signature when
+    // internalQueryCacheShareAcrossCollections is enabled.
+    std::shared_ptr<PlanCache> _planCache;
 
     // Query settings.
     // Includes index filters.
     std::unique_ptr<QuerySettings> _querySettings;
 
+    // Results of find commands, when internalQueryResultCacheEnabled is set. Shared with the
+    // commit handlers of writes, which may run after the collection is destroyed.
+    std::shared_ptr<QueryResultCache> _queryResultCache;
+
     // Tracks index usage statistics for this collection.
     CollectionIndexUsageTracker _indexUsageTracker;
 
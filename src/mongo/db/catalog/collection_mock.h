@@ -236,6 +236,13 @@ public:
         std::abort();
     }
 
+    bool getRecordChangeStreamImages() const {
+        std::abort();
+    }
+    void setRecordChangeStreamImages(OperationContext* opCtx, bool record) {
+        std::abort();
+    }
+
     bool isCapped() const {
         std::abort();
     }
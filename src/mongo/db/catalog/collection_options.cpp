@@ -176,6 +176,10 @@ Status CollectionOptions::parse(const BSONObj& options, ParseKind kind) {
             flagsSet = true;
         } else if (fieldName == "temp") {
             temp = e.trueValue();
+        } else if (fieldName == "recordChangeStreamImages") {
+            recordChangeStreamImages = e.trueValue();
+        } else if (fieldName == "clustered") {
+            clustered = e.trueValue();
         } else if (fieldName == "storageEngine") {
             Status status = checkStorageEngineOptions(e);
             if (!status.isOK()) {
@@ -243,6 +247,12 @@ Status CollectionOptions::parse(const BSONObj& options, ParseKind kind) {
             }
 
             pipeline = e.Obj().getOwned();
+        } else if (fieldName == "materialized") {
+            if (!e.isBoolean()) {
+                return Status(ErrorCodes::BadValue, "'materialized' has to be a boolean.");
+            }
+
+            materialized = e.boolean();
         } else if (fieldName == "idIndex" && kind == parseForCommand) {
             if (e.type() != mongo::Object) {
                 return Status(ErrorCodes::TypeMismatch, "'idIndex' has to be an object.");
@@ -266,6 +276,15 @@ Status CollectionOptions::parse(const BSONObj& options, ParseKind kind) {
         return Status(ErrorCodes::BadValue, "'pipeline' cannot be specified without 'viewOn'");
     }
 
+    if (viewOn.empty() && materialized) {
+        return Status(ErrorCodes::BadValue, "'materialized' cannot be specified without 'viewOn'");
+    }
+
+    if (clustered && (capped || !viewOn.empty())) {
+        return Status(ErrorCodes::BadValue,
+                      "'clustered' cannot be specified for a capped collection or a view");
+    }
+
     return Status::OK();
 }
 
@@ -302,6 +321,12 @@ void CollectionOptions::appendBSON(BSONObjBuilder* builder) const {
     if (temp)
         builder->appendBool("temp", true);
 
+    if (recordChangeStreamImages)
+        builder->appendBool("recordChangeStreamImages", true);
+
+    if (clustered)
+        builder->appendBool("clustered", true);
+
     if (!storageEngine.isEmpty()) {
         builder->append("storageEngine", storageEngine);
     }
@@ -334,6 +359,10 @@ void CollectionOptions::appendBSON(BSONObjBuilder* builder) const {
         builder->appendArray("pipeline", pipeline);
     }
 
+    if (materialized) {
+        builder->appendBool("materialized", true);
+    }
+
     if (!idIndex.isEmpty()) {
         builder->append("idIndex", idIndex);
     }
@@ -383,6 +412,14 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (recordChangeStreamImages != other.recordChangeStreamImages) {
+        return false;
+    }
+
+    if (clustered != other.clustered) {
+        return false;
+    }
+
     if (storageEngine.woCompare(other.storageEngine) != 0) {
         return false;
     }
@@ -423,6 +460,10 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (materialized != other.materialized) {
+        return false;
+    }
+
     return true;
 }
 }
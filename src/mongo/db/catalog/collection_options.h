@@ -126,6 +126,14 @@ struct CollectionOptions {
 
     bool temp = false;
 
+    // Whether updates to this collection record the pre- and post-images of the updated document
+    // for change streams.
+    bool recordChangeStreamImages = false;
+
+    // Whether the documents are stored under a RecordId derived from their _id, which must then be
+    // an integer. See clusteredid::keyForId().
+    bool clustered = false;
+
     // Storage engine collection options. Always owned or empty.
     BSONObj storageEngine;
 
@@ -149,5 +157,8 @@ struct CollectionOptions {
     std::string viewOn;
     // The aggregation pipeline that defines this view.
     BSONObj pipeline;
+    // Whether the results of this view are stored in a backing collection which the server keeps
+    // up to date as the documents of 'viewOn' change.
+    bool materialized = false;
 };
 }
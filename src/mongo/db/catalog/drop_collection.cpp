@@ -109,6 +109,24 @@ Status dropCollection(OperationContext* opCtx,
         }
         wunit.commit();
 
+        // The collections which hold the results of a materialized view belong to the view, so
+        // they are dropped along with it. Secondaries replicate these drops from the primary.
+        if (view && view->isMaterialized() && opCtx->writesAreReplicated()) {
+            for (auto&& backingNss :
+                 {view->materializedNss(), view->materializedContributionsNss()}) {
+                if (!db->getCollection(opCtx, backingNss)) {
+                    continue;
+                }
+                BackgroundOperation::assertNoBgOpInProgForNs(backingNss.ns());
+                WriteUnitOfWork backingWunit(opCtx);
+                Status status = db->dropCollection(opCtx, backingNss.ns());
+                if (!status.isOK()) {
+                    return status;
+                }
+                backingWunit.commit();
+            }
+        }
+
         return Status::OK();
     });
 }
@@ -48,6 +48,7 @@ class CollectionCatalogEntry;
 class CollectionInfoCache;
 class HeadManager;
 class IndexAccessMethod;
+class IndexBuildInterceptor;
 class IndexDescriptor;
 class MatchExpression;
 class OperationContext;
@@ -141,6 +142,18 @@ public:
     virtual boost::optional<Timestamp> getMinimumVisibleSnapshot() = 0;
 
     virtual void setMinimumVisibleSnapshot(const Timestamp name) = 0;
+
+    /**
+     * Returns the interceptor recording the writes made to the collection while this index is
+     * being built in bulk, or nullptr if writes are applied to the index directly.
+     */
+    virtual IndexBuildInterceptor* indexBuildInterceptor() = 0;
+
+    /**
+     * Takes ownership of 'interceptor', which records all subsequent writes in place of this
+     * index. Passing nullptr makes subsequent writes apply to the index directly again.
+     */
+    virtual void setIndexBuildInterceptor(std::unique_ptr<IndexBuildInterceptor> interceptor) = 0;
 };
 
 class IndexCatalogEntryContainer {
@@ -49,6 +49,7 @@ class CollectionCatalogEntry;
 class CollectionInfoCache;
 class HeadManager;
 class IndexAccessMethod;
+class IndexBuildInterceptor;
 class IndexDescriptor;
 class MatchExpression;
 class OperationContext;
@@ -168,6 +169,12 @@ public:
         _minVisibleSnapshot = name;
     }
 
+    IndexBuildInterceptor* indexBuildInterceptor() final {
+        return _indexBuildInterceptor.get();
+    }
+
+    void setIndexBuildInterceptor(std::unique_ptr<IndexBuildInterceptor> interceptor) final;
+
 private:
     class SetMultikeyChange;
     class SetHeadChange;
@@ -236,5 +243,9 @@ private:
 
     // The earliest snapshot that is allowed to read this index.
     boost::optional<Timestamp> _minVisibleSnapshot;
+
+    // Non-null while this index is being built in bulk. Writes to the collection are recorded
+    // here instead of in the index until the build applies them.
+    std::unique_ptr<IndexBuildInterceptor> _indexBuildInterceptor;
 };
 }  // namespace mongo
@@ -32,6 +32,7 @@
 
 #include "mongo/db/catalog/index_catalog_impl.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/base/init.h"
@@ -50,6 +51,7 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index_legacy.h"
 #include "mongo/db/index_names.h"
@@ -1221,6 +1223,30 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, index->descriptor(), &options);
 
+    // When every record is written at the same timestamp, as on a standalone, hand the whole batch
+    // to the index so that its keys can be inserted in index order.
+    if (bsonRecords.size() > 1 &&
+        std::all_of(bsonRecords.begin(), bsonRecords.end(), [&](const BsonRecord& bsonRecord) {
+            return bsonRecord.ts == bsonRecords.front().ts;
+        })) {
+        if (!bsonRecords.front().ts.isNull()) {
+            Status status = opCtx->recoveryUnit()->setTimestamp(bsonRecords.front().ts);
+            if (!status.isOK())
+                return status;
+        }
+
+        int64_t inserted;
+        Status status =
+            index->accessMethod()->insertBatch(opCtx, bsonRecords, options, &inserted);
+        if (!status.isOK())
+            return status;
+
+        if (keysInsertedOut) {
+            *keysInsertedOut += inserted;
+        }
+        return Status::OK();
+    }
+
     for (auto bsonRecord : bsonRecords) {
         int64_t inserted;
         invariant(bsonRecord.id != RecordId());
@@ -1247,6 +1273,14 @@ Status IndexCatalogImpl::_indexRecords(OperationContext* opCtx,
                                        IndexCatalogEntry* index,
                                        const std::vector<BsonRecord>& bsonRecords,
                                        int64_t* keysInsertedOut) {
+    if (auto interceptor = index->indexBuildInterceptor()) {
+        // The index build applies the filter when it indexes the documents.
+        for (auto&& bsonRecord : bsonRecords) {
+            interceptor->sideWrite(opCtx, bsonRecord.id, nullptr);
+        }
+        return Status::OK();
+    }
+
     const MatchExpression* filter = index->getFilterExpression();
     if (!filter)
         return _indexFilteredRecords(opCtx, index, bsonRecords, keysInsertedOut);
@@ -1266,6 +1300,11 @@ Status IndexCatalogImpl::_unindexRecord(OperationContext* opCtx,
                                         const RecordId& loc,
                                         bool logIfError,
                                         int64_t* keysDeletedOut) {
+    if (auto interceptor = index->indexBuildInterceptor()) {
+        interceptor->sideWrite(opCtx, loc, &obj);
+        return Status::OK();
+    }
+
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, index->descriptor(), &options);
     options.logIfError = logIfError;
@@ -38,6 +38,7 @@
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
 #include "mongo/db/field_ref.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_key_generator.h"
 #include "mongo/db/index_names.h"
@@ -79,7 +80,9 @@ static std::set<StringData> allowedFieldNames = {
     IndexDescriptor::kDefaultLanguageFieldName,
     IndexDescriptor::kDropDuplicatesFieldName,
     IndexDescriptor::kExpireAfterSecondsFieldName,
+    IndexDescriptor::kExpireCollectionFieldName,
     IndexDescriptor::kGeoHaystackBucketSize,
+    IndexDescriptor::kHashVersionFieldName,
     IndexDescriptor::kIndexNameFieldName,
     IndexDescriptor::kIndexVersionFieldName,
     IndexDescriptor::kKeyPatternFieldName,
@@ -176,10 +179,16 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                                         << "' index must be a non-zero number, not a string.");
         }
 
-        // Check if the wildcard index is compounded. If it is the key is invalid because
-        // compounded wildcard indexes are disallowed.
-        if (pluginName == IndexNames::WILDCARD && key.nFields() != 1) {
-            return Status(code, "wildcard indexes do not allow compounding");
+        // A wildcard index may be compounded only with regular fields which precede its single
+        // wildcard field.
+        if (pluginName == IndexNames::WILDCARD) {
+            const auto fieldName = keyElement.fieldNameStringData();
+            const bool isWildcardField = (fieldName == "$**" || fieldName.endsWith(".$**"));
+            if (isWildcardField == it.more()) {
+                return Status(code,
+                              "a compound wildcard index must have exactly one wildcard field, "
+                              "which must be the last field of its key pattern");
+            }
         }
 
         // Ensure that the fields on which we are building the index are valid: a field must not
@@ -398,6 +407,61 @@ StatusWith<BSONObj> validateIndexSpec(
             if (!statusWithMatcher.isOK()) {
                 return statusWithMatcher.getStatus();
             }
+        } else if (IndexDescriptor::kExpireCollectionFieldName == indexSpecElemFieldName) {
+            if (indexSpecElem.type() != BSONType::Bool) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << "The field '"
+                                      << IndexDescriptor::kExpireCollectionFieldName
+                                      << "' must be a boolean, but got "
+                                      << typeName(indexSpecElem.type())};
+            }
+
+            // The collection is only known to have expired as a whole from an index on every
+            // document
+            if (!indexSpec.hasField(IndexDescriptor::kExpireAfterSecondsFieldName) ||
+                indexSpec[IndexDescriptor::kSparseFieldName].trueValue() ||
+                indexSpec.hasField(IndexDescriptor::kPartialFilterExprFieldName)) {
+                return {ErrorCodes::CannotCreateIndex,
+                        str::stream() << "The field '"
+                                      << IndexDescriptor::kExpireCollectionFieldName
+                                      << "' is only allowed on a TTL index which is neither "
+                                         "sparse nor partial"};
+            }
+        } else if (IndexDescriptor::kHashVersionFieldName == indexSpecElemFieldName) {
+            const auto key = indexSpec.getObjectField(IndexDescriptor::kKeyPatternFieldName);
+            if (IndexNames::findPluginName(key) != IndexNames::HASHED) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "The field '" << IndexDescriptor::kHashVersionFieldName
+                                      << "' is only allowed in a '"
+                                      << IndexNames::HASHED
+                                      << "' index"};
+            }
+            if (!indexSpecElem.isNumber()) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << "The field '" << IndexDescriptor::kHashVersionFieldName
+                                      << "' must be a number, but got "
+                                      << typeName(indexSpecElem.type())};
+            }
+
+            auto hashVersion = representAs<int>(indexSpecElem.number());
+            if (!hashVersion || !BSONElementHasher::isSupportedHashVersion(*hashVersion)) {
+                return {ErrorCodes::CannotCreateIndex,
+                        str::stream() << "Unsupported "
+                                      << IndexDescriptor::kHashVersionFieldName
+                                      << ": "
+                                      << indexSpecElem.toString(false, false)};
+            }
+
+            // Older versions cannot generate the keys of an index which uses a newer hash
+            // function.
+            if (*hashVersion != BSONElementHasher::DEFAULT_HASH_VERSION &&
+                featureCompatibility.getVersion() <
+                    ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo42) {
+                return {ErrorCodes::CannotCreateIndex,
+                        str::stream() << IndexDescriptor::kHashVersionFieldName << " "
+                                      << *hashVersion
+                                      << " requires featureCompatibilityVersion 4.2"};
+            }
         } else if (IndexDescriptor::kPathProjectionFieldName == indexSpecElemFieldName) {
             const auto key = indexSpec.getObjectField(IndexDescriptor::kKeyPatternFieldName);
             if (IndexNames::findPluginName(key) != IndexNames::WILDCARD) {
@@ -413,7 +477,7 @@ StatusWith<BSONObj> validateIndexSpec(
                                       << "' must be a non-empty object, but got "
                                       << typeName(indexSpecElem.type())};
             }
-            if (!key.hasField("$**")) {
+            if (key.nFields() != 1 || !key.hasField("$**")) {
                 return {ErrorCodes::FailedToParse,
                         str::stream() << "The field '" << IndexDescriptor::kPathProjectionFieldName
                                       << "' is only allowed when '"
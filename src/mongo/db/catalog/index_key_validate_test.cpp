@@ -288,6 +288,26 @@ TEST(IndexKeyValidateTest, KeyElementNameWildcardFailsOnCompound) {
     ASSERT_EQ(status, ErrorCodes::CannotCreateIndex);
 }
 
+TEST(IndexKeyValidateTest, KeyElementNameWildcardSucceedsOnCompoundWithLeadingFields) {
+    TestCommandQueryKnobGuard guard;
+    ASSERT_OK(validateKeyPattern(BSON("a" << 1 << "$**" << 1), IndexVersion::kV2));
+    ASSERT_OK(validateKeyPattern(BSON("a" << 1 << "b.c" << 1 << "d.$**" << 1), IndexVersion::kV2));
+}
+
+TEST(IndexKeyValidateTest, KeyElementNameWildcardFailsOnCompoundWithTwoWildcardFields) {
+    TestCommandQueryKnobGuard guard;
+    auto status = validateKeyPattern(BSON("a.$**" << 1 << "$**" << 1), IndexVersion::kV2);
+    ASSERT_NOT_OK(status);
+    ASSERT_EQ(status, ErrorCodes::CannotCreateIndex);
+}
+
+TEST(IndexKeyValidateTest, KeyElementNameWildcardFailsOnCompoundWithDescendingField) {
+    TestCommandQueryKnobGuard guard;
+    auto status = validateKeyPattern(BSON("a" << -1 << "$**" << 1), IndexVersion::kV2);
+    ASSERT_NOT_OK(status);
+    ASSERT_EQ(status, ErrorCodes::CannotCreateIndex);
+}
+
 TEST(IndexKeyValidateTest, KeyElementNameWildcardFailsOnIncorrectValue) {
     TestCommandQueryKnobGuard guard;
     auto status = validateKeyPattern(BSON("$**" << false), IndexVersion::kV2);
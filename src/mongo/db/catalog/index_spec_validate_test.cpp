@@ -832,6 +832,123 @@ TEST(IndexSpecPartialFilterTest, AcceptsValidPartialFilterExpression) {
     ASSERT_OK(result.getStatus());
 }
 
+TEST(IndexSpecValidateTest, AcceptsExpireCollectionOnTTLIndex) {
+    auto result = validateIndexSpec(kDefaultOpCtx,
+                                    BSON("key" << BSON("createdAt" << 1) << "name"
+                                               << "indexName"
+                                               << "expireAfterSeconds"
+                                               << 3600
+                                               << "expireCollection"
+                                               << true),
+                                    kTestNamespace,
+                                    serverGlobalParams.featureCompatibility);
+    ASSERT_OK(result.getStatus());
+}
+
+TEST(IndexSpecValidateTest, ReturnsAnErrorIfExpireCollectionIsNotABoolean) {
+    auto result = validateIndexSpec(kDefaultOpCtx,
+                                    BSON("key" << BSON("createdAt" << 1) << "name"
+                                               << "indexName"
+                                               << "expireAfterSeconds"
+                                               << 3600
+                                               << "expireCollection"
+                                               << 1),
+                                    kTestNamespace,
+                                    serverGlobalParams.featureCompatibility);
+    ASSERT_EQ(result.getStatus().code(), ErrorCodes::TypeMismatch);
+}
+
+TEST(IndexSpecValidateTest, ReturnsAnErrorIfExpireCollectionIsNotOnAFullTTLIndex) {
+    for (auto&& options : {BSONObj(),
+                           BSON("expireAfterSeconds" << 3600 << "sparse" << true),
+                           BSON("expireAfterSeconds" << 3600 << "partialFilterExpression"
+                                                     << BSON("a" << 1))}) {
+        BSONObjBuilder spec;
+        spec.append("key", BSON("createdAt" << 1));
+        spec.append("name", "indexName");
+        spec.append("expireCollection", true);
+        spec.appendElements(options);
+        auto result = validateIndexSpec(
+            kDefaultOpCtx, spec.obj(), kTestNamespace, serverGlobalParams.featureCompatibility);
+        ASSERT_EQ(result.getStatus().code(), ErrorCodes::CannotCreateIndex) << options;
+    }
+}
+
+TEST(IndexSpecValidateTest, AcceptsSupportedHashVersionsOnHashedIndex) {
+    TestCommandFcvGuard guard;
+    for (int hashVersion : {0, 1}) {
+        auto result = validateIndexSpec(kDefaultOpCtx,
+                                        BSON("key" << BSON("a"
+                                                           << "hashed")
+                                                   << "name"
+                                                   << "indexName"
+                                                   << "hashVersion"
+                                                   << hashVersion),
+                                        kTestNamespace,
+                                        serverGlobalParams.featureCompatibility);
+        ASSERT_OK(result.getStatus()) << hashVersion;
+    }
+}
+
+TEST(IndexSpecValidateTest, ReturnsAnErrorIfHashVersionIsUnsupported) {
+    TestCommandFcvGuard guard;
+    for (auto&& hashVersion : {BSON("hashVersion" << 2),
+                               BSON("hashVersion" << -1),
+                               BSON("hashVersion" << 1.5),
+                               BSON("hashVersion" << (1LL << 40))}) {
+        BSONObjBuilder spec;
+        spec.append("key",
+                    BSON("a"
+                         << "hashed"));
+        spec.append("name", "indexName");
+        spec.appendElements(hashVersion);
+        auto result = validateIndexSpec(
+            kDefaultOpCtx, spec.obj(), kTestNamespace, serverGlobalParams.featureCompatibility);
+        ASSERT_EQ(result.getStatus().code(), ErrorCodes::CannotCreateIndex) << hashVersion;
+    }
+}
+
+TEST(IndexSpecValidateTest, ReturnsAnErrorIfHashVersionIsNotANumber) {
+    TestCommandFcvGuard guard;
+    auto result = validateIndexSpec(kDefaultOpCtx,
+                                    BSON("key" << BSON("a"
+                                                       << "hashed")
+                                               << "name"
+                                               << "indexName"
+                                               << "hashVersion"
+                                               << "1"),
+                                    kTestNamespace,
+                                    serverGlobalParams.featureCompatibility);
+    ASSERT_EQ(result.getStatus().code(), ErrorCodes::TypeMismatch);
+}
+
+TEST(IndexSpecValidateTest, ReturnsAnErrorIfHashVersionIsOnANonHashedIndex) {
+    TestCommandFcvGuard guard;
+    auto result = validateIndexSpec(kDefaultOpCtx,
+                                    BSON("key" << BSON("a" << 1) << "name"
+                                               << "indexName"
+                                               << "hashVersion"
+                                               << 1),
+                                    kTestNamespace,
+                                    serverGlobalParams.featureCompatibility);
+    ASSERT_EQ(result.getStatus().code(), ErrorCodes::BadValue);
+}
+
+TEST(IndexSpecValidateTest, ReturnsAnErrorIfNewHashVersionIsUsedBeforeUpgrade) {
+    TestCommandFcvGuard guard;
+    serverGlobalParams.featureCompatibility.setVersion(
+        ServerGlobalParams::FeatureCompatibility::Version::kUpgradingTo42);
+    auto spec = BSON("key" << BSON("a"
+                                   << "hashed")
+                           << "name"
+                           << "indexName"
+                           << "hashVersion"
+                           << 1);
+    auto result = validateIndexSpec(
+        kDefaultOpCtx, spec, kTestNamespace, serverGlobalParams.featureCompatibility);
+    ASSERT_EQ(result.getStatus().code(), ErrorCodes::CannotCreateIndex);
+}
+
 TEST(IndexSpecWildcard, SucceedsWithInclusion) {
     TestCommandFcvGuard guard;
     auto result = validateIndexSpec(kDefaultOpCtx,
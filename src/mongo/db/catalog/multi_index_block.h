@@ -142,6 +142,17 @@ public:
      */
     virtual Status doneInserting(std::set<RecordId>* const dupsOut = nullptr) = 0;
 
+    /**
+     * Applies to the indexes being built in bulk the writes which other operations made to the
+     * collection while the documents were being inserted, and which were recorded on the side
+     * instead of being applied to those indexes. insertAllDocumentsInCollection() applies the
+     * writes made until it finishes scanning the collection; a background build must call this
+     * again after reacquiring its exclusive lock, to apply the rest before commit().
+     *
+     * Must not be called inside of a WriteUnitOfWork.
+     */
+    virtual Status drainBackgroundWrites() = 0;
+
     /**
      * Marks the index ready for use. Should only be called as the last method after
      * doneInserting() or insertAllDocumentsInCollection() return success.
@@ -32,6 +32,10 @@
 
 #include "mongo/db/catalog/multi_index_block_impl.h"
 
+#include <algorithm>
+#include <boost/optional.hpp>
+#include <exception>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/base/init.h"
 #include "mongo/db/audit.h"
@@ -42,15 +46,20 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/index/multikey_paths.h"
+#include "mongo/db/index_names.h"
 #include "mongo/db/multi_key_path_tracker.h"
 #include "mongo/db/op_observer.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/functional.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
@@ -95,6 +104,45 @@ public:
 
 } exportedMaxIndexBuildMemoryUsageParameter;
 
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(internalIndexBuildKeyGenerationThreads, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 128) {
+            return Status(ErrorCodes::BadValue,
+                          "internalIndexBuildKeyGenerationThreads must be between 0 and 128");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(enableHybridIndexBuilds, bool, true);
+
+namespace {
+
+// Foreground builds of several indexes queue up documents until either limit is reached, then
+// generate keys for all of the queued documents one index per thread.
+const size_t kMaxPendingInsertDocs = 1024;
+const size_t kMaxPendingInsertBytes = 16 * 1024 * 1024;
+
+/**
+ * Returns the pool shared by all index builds for generating keys concurrently, starting it on
+ * first use. The pool is intentionally leaked so that it is never torn down underneath a build
+ * during shutdown.
+ */
+ThreadPool* getKeyGenerationPool() {
+    static ThreadPool* pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "IndexBuildKeyGenerators";
+        options.threadNamePrefix = "indexKeyGen-";
+        options.minThreads = 0;
+        options.maxThreads =
+            static_cast<size_t>(std::max(1, internalIndexBuildKeyGenerationThreads));
+        auto newPool = new ThreadPool(options);
+        newPool->startup();
+        return newPool;
+    }();
+    return pool;
+}
+
+}  // namespace
 
 /**
  * On rollback sets MultiIndexBlockImpl::_needToCleanup to true.
@@ -257,12 +305,6 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlockImpl::init(const std::vector<BSO
         if (!status.isOK())
             return status;
 
-        if (!_buildInBackground) {
-            // Bulk build process requires foreground building as it assumes nothing is changing
-            // under it.
-            index.bulk = index.real->initiateBulk(eachIndexBuildMaxMemoryUsageBytes);
-        }
-
         const IndexDescriptor* descriptor = index.block->getEntry()->descriptor();
 
         _collection->getIndexCatalog()->prepareInsertDeleteOptions(
@@ -272,6 +314,19 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlockImpl::init(const std::vector<BSO
             index.options.getKeysMode = IndexAccessMethod::GetKeysMode::kRelaxConstraints;
         }
 
+        // Bulk build process assumes nothing is changing under it. A background build may still
+        // use it by having the writes made to the collection in the meantime recorded on the side,
+        // and applying them once the bulk load is done. An index which enforces uniqueness must
+        // instead see every concurrent write, so that a write which violates it fails.
+        if (!_buildInBackground) {
+            index.bulk = index.real->initiateBulk(eachIndexBuildMaxMemoryUsageBytes);
+        } else if (enableHybridIndexBuilds.load() && index.options.dupsAllowed) {
+            index.bulk = index.real->initiateBulk(eachIndexBuildMaxMemoryUsageBytes);
+            index.block->getEntry()->setIndexBuildInterceptor(
+                stdx::make_unique<IndexBuildInterceptor>());
+            index.interceptor = index.block->getEntry()->indexBuildInterceptor();
+        }
+
         log() << "build index on: " << ns << " properties: " << descriptor->toString();
         if (index.bulk)
             log() << "\t building index using bulk method; build may temporarily use up to "
@@ -279,6 +334,9 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlockImpl::init(const std::vector<BSO
 
         index.filterExpression = index.block->getEntry()->getFilterExpression();
 
+        // Tokenizing and stemming make text index keys far more expensive to generate than others.
+        index.generateKeysInSlices = descriptor->getAccessMethodName() == IndexNames::TEXT;
+
         // TODO SERVER-14888 Suppress this in cases we don't want to audit.
         audit::logCreateIndex(_opCtx->getClient(), &info, descriptor->indexName(), ns);
 
@@ -357,6 +415,8 @@ Status MultiIndexBlockImpl::insertAllDocumentsInCollection() {
     auto exec =
         InternalPlanner::collectionScan(_opCtx, _collection->ns().ns(), _collection, yieldPolicy);
 
+    const bool insertConcurrently = _canInsertConcurrently();
+
     Snapshotted<BSONObj> objToIndex;
     RecordId loc;
     PlanExecutor::ExecState state;
@@ -390,7 +450,8 @@ Status MultiIndexBlockImpl::insertAllDocumentsInCollection() {
             failPointHangDuringBuild(&hangBeforeIndexBuildOf, "before", objToIndex.value());
 
             WriteUnitOfWork wunit(_opCtx);
-            Status ret = insert(objToIndex.value(), loc);
+            Status ret = insertConcurrently ? _queueForConcurrentInsert(objToIndex.value(), loc)
+                                            : insert(objToIndex.value(), loc);
             if (_buildInBackground)
                 exec->saveState();
             if (!ret.isOK()) {
@@ -453,12 +514,22 @@ Status MultiIndexBlockImpl::insertAllDocumentsInCollection() {
         }
     }
 
+    if (insertConcurrently) {
+        Status ret = _insertPendingConcurrently();
+        if (!ret.isOK())
+            return ret;
+    }
+
     progress->finished();
 
     Status ret = doneInserting();
     if (!ret.isOK())
         return ret;
 
+    ret = drainBackgroundWrites();
+    if (!ret.isOK())
+        return ret;
+
     log() << "build index done.  scanned " << n << " total records. " << t.seconds() << " secs";
 
     return Status::OK();
@@ -484,6 +555,142 @@ Status MultiIndexBlockImpl::insert(const BSONObj& doc, const RecordId& loc) {
     return Status::OK();
 }
 
+bool MultiIndexBlockImpl::_canInsertConcurrently() const {
+    if (internalIndexBuildKeyGenerationThreads <= 0)
+        return false;
+    if (_indexes.size() < 2 &&
+        std::none_of(_indexes.begin(), _indexes.end(), [](const IndexToBuild& index) {
+            return index.generateKeysInSlices;
+        }))
+        return false;
+    return std::all_of(_indexes.begin(), _indexes.end(), [](const IndexToBuild& index) {
+        return static_cast<bool>(index.bulk);
+    });
+}
+
+Status MultiIndexBlockImpl::_queueForConcurrentInsert(const BSONObj& doc, const RecordId& loc) {
+    _pendingInserts.emplace_back(doc.getOwned(), loc);
+    _pendingInsertBytes += doc.objsize();
+    if (_pendingInserts.size() < kMaxPendingInsertDocs &&
+        _pendingInsertBytes < kMaxPendingInsertBytes) {
+        return Status::OK();
+    }
+    return _insertPendingConcurrently();
+}
+
+Status MultiIndexBlockImpl::_insertPendingConcurrently() {
+    // A task which inserts into an index owns the index's BulkBuilder, so the builders need no
+    // synchronization. Key generation can throw, so exceptions are carried back to this thread
+    // along with statuses.
+    using DocumentKeys = IndexAccessMethod::BulkBuilder::DocumentKeys;
+    const size_t numIndexes = _indexes.size();
+    const size_t numDocs = _pendingInserts.size();
+    const size_t docsPerSlice =
+        numDocs / (static_cast<size_t>(internalIndexBuildKeyGenerationThreads) + 1) + 1;
+
+    std::vector<stdx::function<Status()>> tasks;
+    std::vector<std::vector<boost::optional<DocumentKeys>>> slicedKeys(numIndexes);
+    for (size_t i = 0; i < numIndexes; i++) {
+        IndexToBuild& index = _indexes[i];
+        if (!index.generateKeysInSlices) {
+            tasks.push_back([this, &index] {
+                for (auto&& pending : _pendingInserts) {
+                    if (index.filterExpression &&
+                        !index.filterExpression->matchesBSON(pending.first))
+                        continue;
+                    Status status =
+                        index.bulk->insert(_opCtx, pending.first, pending.second, index.options);
+                    if (!status.isOK())
+                        return status;
+                }
+                return Status::OK();
+            });
+            continue;
+        }
+
+        auto& keys = slicedKeys[i];
+        keys.resize(numDocs);
+        for (size_t begin = 0; begin < numDocs; begin += docsPerSlice) {
+            const size_t end = std::min(begin + docsPerSlice, numDocs);
+            tasks.push_back([this, &index, &keys, begin, end] {
+                for (size_t j = begin; j < end; j++) {
+                    const BSONObj& doc = _pendingInserts[j].first;
+                    if (index.filterExpression && !index.filterExpression->matchesBSON(doc))
+                        continue;
+                    keys[j].emplace();
+                    index.bulk->generateKeys(doc, index.options, keys[j].get_ptr());
+                }
+                return Status::OK();
+            });
+        }
+    }
+
+    const size_t numTasks = tasks.size();
+    std::vector<Status> statuses(numTasks, Status::OK());
+    std::vector<std::exception_ptr> exceptions(numTasks);
+    auto runTask = [&](size_t i) {
+        try {
+            statuses[i] = tasks[i]();
+        } catch (...) {
+            exceptions[i] = std::current_exception();
+        }
+    };
+
+    stdx::mutex mutex;
+    stdx::condition_variable allDone;
+    size_t tasksRemaining = 0;
+
+    // The first task is run on this thread while the workers run the rest.
+    for (size_t i = 1; i < numTasks; i++) {
+        {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            ++tasksRemaining;
+        }
+        Status scheduled = getKeyGenerationPool()->schedule([&, i] {
+            runTask(i);
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            if (--tasksRemaining == 0) {
+                allDone.notify_one();
+            }
+        });
+        if (!scheduled.isOK()) {
+            // The pool is shutting down; fall back to running this task here.
+            runTask(i);
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            --tasksRemaining;
+        }
+    }
+
+    if (numTasks > 0)
+        runTask(0);
+
+    {
+        stdx::unique_lock<stdx::mutex> lk(mutex);
+        allDone.wait(lk, [&] { return tasksRemaining == 0; });
+    }
+
+    ON_BLOCK_EXIT([this] {
+        _pendingInserts.clear();
+        _pendingInsertBytes = 0;
+    });
+
+    for (size_t i = 0; i < numTasks; i++) {
+        if (exceptions[i])
+            std::rethrow_exception(exceptions[i]);
+        if (!statuses[i].isOK())
+            return statuses[i];
+    }
+
+    // Keys generated in slices go into their sorters in document order.
+    for (size_t i = 0; i < numIndexes; i++) {
+        for (size_t j = 0; j < slicedKeys[i].size(); j++) {
+            if (slicedKeys[i][j])
+                _indexes[i].bulk->insertKeys(*slicedKeys[i][j], _pendingInserts[j].second);
+        }
+    }
+    return Status::OK();
+}
+
 Status MultiIndexBlockImpl::doneInserting(std::set<RecordId>* dupsOut) {
     invariant(!_opCtx->lockState()->inAWriteUnitOfWork());
     for (size_t i = 0; i < _indexes.size(); i++) {
@@ -504,6 +711,76 @@ Status MultiIndexBlockImpl::doneInserting(std::set<RecordId>* dupsOut) {
     return Status::OK();
 }
 
+Status MultiIndexBlockImpl::drainBackgroundWrites() {
+    invariant(!_opCtx->lockState()->inAWriteUnitOfWork());
+
+    // As with the collection scan, multikey updates are accumulated for commit() to write.
+    auto stopTracker =
+        MakeGuard([this] { MultikeyPathTracker::get(_opCtx).stopTrackingMultikeyPathInfo(); });
+    if (MultikeyPathTracker::get(_opCtx).isTrackingMultikeyPathInfo()) {
+        stopTracker.Dismiss();
+    }
+    MultikeyPathTracker::get(_opCtx).startTrackingMultikeyPathInfo();
+
+    for (auto&& index : _indexes) {
+        if (!index.interceptor)
+            continue;
+        Status status = _applySideWrites(index);
+        if (!status.isOK())
+            return status;
+    }
+    return Status::OK();
+}
+
+Status MultiIndexBlockImpl::_applySideWrites(IndexToBuild& index) {
+    const auto sideWrites = index.interceptor->takeSideWrites();
+    if (sideWrites.empty())
+        return Status::OK();
+
+    LOG(1) << "\t applying writes to " << sideWrites.size() << " records to index: "
+           << index.block->getEntry()->descriptor()->indexName();
+
+    // Forces the removal of each key to match its RecordId, as for any unfinished index.
+    InsertDeleteOptions removeOptions = index.options;
+    removeOptions.dupsAllowed = true;
+
+    for (auto&& sideWrite : sideWrites) {
+        const RecordId& loc = sideWrite.first;
+        Status status = writeConflictRetry(
+            _opCtx, "index build side writes", _collection->ns().ns(), [&]() -> Status {
+                WriteUnitOfWork wunit(_opCtx);
+                int64_t unused;
+                for (auto&& oldDoc : sideWrite.second) {
+                    Status status =
+                        index.real->remove(_opCtx, oldDoc, loc, removeOptions, &unused);
+                    if (!status.isOK())
+                        return status;
+                }
+
+                // The collection scan may have seen the current version already.
+                Snapshotted<BSONObj> doc;
+                if (_collection->findDoc(_opCtx, loc, &doc)) {
+                    Status status =
+                        index.real->remove(_opCtx, doc.value(), loc, removeOptions, &unused);
+                    if (!status.isOK())
+                        return status;
+                    if (!index.filterExpression ||
+                        index.filterExpression->matchesBSON(doc.value())) {
+                        status =
+                            index.real->insert(_opCtx, doc.value(), loc, index.options, &unused);
+                        if (!status.isOK())
+                            return status;
+                    }
+                }
+                wunit.commit();
+                return Status::OK();
+            });
+        if (!status.isOK())
+            return status;
+    }
+    return Status::OK();
+}
+
 void MultiIndexBlockImpl::abortWithoutCleanup() {
     _indexes.clear();
     _needToCleanup = false;
@@ -523,17 +800,27 @@ void MultiIndexBlockImpl::commit(stdx::function<void(const BSONObj& spec)> onCre
             onCreateFn(_indexes[i].block->getSpec());
         }
 
+        // Writes must now go to the index itself. The commit holds an exclusive lock, so there can
+        // be no writes left to apply. A retried commit finds the interceptor already removed.
+        if (_indexes[i].interceptor) {
+            invariant(_indexes[i].interceptor->numPendingRecords() == 0);
+            _indexes[i].block->getEntry()->setIndexBuildInterceptor(nullptr);
+            _indexes[i].interceptor = nullptr;
+        }
+
         _indexes[i].block->success();
 
         // The bulk builder will track multikey information itself. Non-bulk builders re-use the
         // code path that a typical insert/update uses. State is altered on the non-bulk build
-        // path to accumulate the multikey information on the `MultikeyPathTracker`.
+        // path to accumulate the multikey information on the `MultikeyPathTracker`. Applying the
+        // side writes of a background build also uses that path.
         if (_indexes[i].bulk) {
             const auto& bulkBuilder = _indexes[i].bulk;
             if (bulkBuilder->isMultikey()) {
                 _indexes[i].block->getEntry()->setMultikey(_opCtx, bulkBuilder->getMultikeyPaths());
             }
-        } else {
+        }
+        if (!_indexes[i].bulk || _buildInBackground) {
             auto multikeyPaths =
                 boost::optional<MultikeyPaths>(MultikeyPathTracker::get(_opCtx).getMultikeyPathInfo(
                     _collection->ns(), _indexes[i].block->getIndexName()));
@@ -33,6 +33,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
@@ -40,7 +41,9 @@
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/index_catalog_impl.h"
 #include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/record_id.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -49,6 +52,16 @@ class BSONObj;
 class Collection;
 class OperationContext;
 
+// Number of worker threads that foreground builds of several indexes at once, or of text indexes,
+// may use to generate keys concurrently. Zero, the default, generates all keys on the build's own
+// thread.
+extern int internalIndexBuildKeyGenerationThreads;
+
+// When true, the default, background builds of indexes which allow duplicate keys bulk load the
+// keys of a collection scan, and record the writes made concurrently to apply them afterwards.
+// When false, background builds insert every key directly into the index while they scan.
+extern AtomicBool enableHybridIndexBuilds;
+
 /**
  * Builds one or more indexes.
  *
@@ -155,6 +168,14 @@ public:
      */
     Status doneInserting(std::set<RecordId>* dupsOut = nullptr) override;
 
+    /**
+     * Applies the writes recorded for the indexes being built in bulk during a background build.
+     * The writes of each record are applied in their own WriteUnitOfWork.
+     *
+     * Must not be called inside of a WriteUnitOfWork.
+     */
+    Status drainBackgroundWrites() override;
+
     /**
      * Marks the index ready for use. Should only be called as the last method after
      * doneInserting() or insertAllDocumentsInCollection() return success.
@@ -197,11 +218,52 @@ private:
         const MatchExpression* filterExpression;  // might be NULL, owned elsewhere
         std::unique_ptr<IndexAccessMethod::BulkBuilder> bulk;
 
+        // Non-null when a background build bulk loads this index. Owned by the index's catalog
+        // entry.
+        IndexBuildInterceptor* interceptor = nullptr;
+
         InsertDeleteOptions options;
+
+        // True if the index's keys are expensive enough to generate that concurrent inserts should
+        // split the documents between several threads, rather than give the index one thread.
+        bool generateKeysInSlices = false;
     };
 
+    /**
+     * Returns true if insertAllDocumentsInCollection() may generate keys on other threads, which
+     * pays off when there are several indexes or an index whose keys are expensive to generate.
+     * This requires every index to be built by a BulkBuilder, since those touch no shared state
+     * until doneInserting().
+     */
+    bool _canInsertConcurrently() const;
+
+    /**
+     * Queues a copy of 'doc' for insertion into all the indexes, calling
+     * _insertPendingConcurrently() once enough documents have been queued.
+     */
+    Status _queueForConcurrentInsert(const BSONObj& doc, const RecordId& loc);
+
+    /**
+     * Inserts every queued document into the indexes using the key generation worker pool, and
+     * empties the queue. Most indexes get one task each. The keys of an index which generates keys
+     * in slices are generated by one task per slice of the documents, and then inserted on this
+     * thread.
+     */
+    Status _insertPendingConcurrently();
+
+    /**
+     * Applies the side writes recorded by 'index.interceptor' to the index: for every written
+     * record, removes the keys of each of its recorded versions and of its current version, then
+     * inserts the keys of the current version, if the record still exists.
+     */
+    Status _applySideWrites(IndexToBuild& index);
+
     std::vector<IndexToBuild> _indexes;
 
+    // Documents awaiting concurrent insertion, and the total size of their BSON.
+    std::vector<std::pair<BSONObj, RecordId>> _pendingInserts;
+    size_t _pendingInsertBytes = 0;
+
     std::unique_ptr<BackgroundOperation> _backgroundOperation;
 
     // Pointers not owned here and must outlive 'this'
@@ -32,6 +32,10 @@
 
 #include "mongo/db/catalog/private/record_store_validate_adaptor.h"
 
+#include <algorithm>
+#include <boost/optional.hpp>
+#include <exception>
+
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/index_consistency.h"
@@ -40,14 +44,121 @@
 #include "mongo/db/index/wildcard_access_method.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/record_store.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/rpc/object_check.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/functional.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
 
+// Number of threads validating the records and index entries that a validation reads, so that they
+// are checked while the next ones are read. With 0 they are checked as they are read.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(internalValidateWorkerThreads, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 128) {
+            return Status(ErrorCodes::BadValue,
+                          "internalValidateWorkerThreads must be between 0 and 128");
+        }
+        return Status::OK();
+    });
+
 namespace {
+
+// Records and index entries are handed to the workers in batches of about this size.
+const size_t kMaxBatchEntries = 1000;
+const size_t kMaxBatchBytes = 4 * 1024 * 1024;
+
+/**
+ * Returns the pool shared by all validations for checking records and index entries, starting it
+ * on first use. The pool is intentionally leaked so that it is never torn down underneath a
+ * validation during shutdown.
+ */
+ThreadPool* getValidateWorkerPool() {
+    static ThreadPool* pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "ValidateWorkers";
+        options.threadNamePrefix = "validate-";
+        options.minThreads = 0;
+        options.maxThreads = static_cast<size_t>(std::max(1, internalValidateWorkerThreads));
+        auto newPool = new ThreadPool(options);
+        newPool->startup();
+        return newPool;
+    }();
+    return pool;
+}
+
+/**
+ * The batches of one traversal being checked by the workers. At most twice as many batches as
+ * there are workers are in flight at a time, to bound the memory they hold. The first exception a
+ * batch throws is rethrown by wait().
+ */
+class ValidationBatches {
+    MONGO_DISALLOW_COPYING(ValidationBatches);
+
+public:
+    ValidationBatches() = default;
+
+    ~ValidationBatches() {
+        // The batches in flight refer to the traversal's state.
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        _batchDone.wait(lk, [&] { return _batchesInFlight == 0; });
+    }
+
+    void schedule(stdx::function<void()> checkBatch) {
+        {
+            stdx::unique_lock<stdx::mutex> lk(_mutex);
+            _batchDone.wait(lk, [&] {
+                return _batchesInFlight < 2 * static_cast<size_t>(internalValidateWorkerThreads);
+            });
+            ++_batchesInFlight;
+        }
+
+        auto runBatch = [this, checkBatch] {
+            std::exception_ptr exception;
+            try {
+                checkBatch();
+            } catch (...) {
+                exception = std::current_exception();
+            }
+
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            if (exception && !_exception) {
+                _exception = exception;
+            }
+            --_batchesInFlight;
+            _batchDone.notify_all();
+        };
+
+        Status scheduled = getValidateWorkerPool()->schedule(runBatch);
+        if (!scheduled.isOK()) {
+            // The pool is shutting down; fall back to checking the batch here.
+            runBatch();
+        }
+    }
+
+    /**
+     * Waits for all of the batches scheduled to be checked.
+     */
+    void wait() {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        _batchDone.wait(lk, [&] { return _batchesInFlight == 0; });
+        if (_exception) {
+            std::rethrow_exception(_exception);
+        }
+    }
+
+private:
+    stdx::mutex _mutex;  // protects the members below
+    stdx::condition_variable _batchDone;
+    size_t _batchesInFlight = 0;
+    std::exception_ptr _exception;
+};
+
 // TODO SERVER-36385: Completely remove the key size check in 4.4
 bool isLargeKeyDisallowed() {
     return serverGlobalParams.featureCompatibility.getVersion() ==
@@ -64,6 +175,37 @@ KeyString makeWildCardMultikeyMetadataKeyString(const BSONObj& indexKey) {
 Status RecordStoreValidateAdaptor::validate(const RecordId& recordId,
                                             const RecordData& record,
                                             size_t* dataSize) {
+    return _validateRecord(_getIndexesToCheck(), recordId, record, dataSize);
+}
+
+std::vector<RecordStoreValidateAdaptor::IndexToCheck>
+RecordStoreValidateAdaptor::_getIndexesToCheck() const {
+    std::vector<IndexToCheck> indexes;
+    if (!_indexCatalog->haveAnyIndexes()) {
+        return indexes;
+    }
+
+    IndexCatalog::IndexIterator i = _indexCatalog->getIndexIterator(_opCtx, false);
+    while (i.more()) {
+        const IndexDescriptor* descriptor = i.next();
+        IndexToCheck index;
+        index.descriptor = descriptor;
+        index.iam = _indexCatalog->getIndex(descriptor);
+        index.indexNs = descriptor->indexNamespace();
+        index.indexNumber = _indexConsistency->getIndexNumber(index.indexNs);
+        index.filterExpression = descriptor->isPartial()
+            ? _indexCatalog->getEntry(descriptor)->getFilterExpression()
+            : nullptr;
+        index.isMultikey = descriptor->isMultikey(_opCtx);
+        indexes.push_back(std::move(index));
+    }
+    return indexes;
+}
+
+Status RecordStoreValidateAdaptor::_validateRecord(const std::vector<IndexToCheck>& indexes,
+                                                   const RecordId& recordId,
+                                                   const RecordData& record,
+                                                   size_t* dataSize) {
     BSONObj recordBson = record.toBson();
 
     const Status status = validateBSON(
@@ -74,26 +216,18 @@ Status RecordStoreValidateAdaptor::validate(const RecordId& recordId,
         return status;
     }
 
-    if (!_indexCatalog->haveAnyIndexes()) {
-        return status;
-    }
-
-    IndexCatalog::IndexIterator i = _indexCatalog->getIndexIterator(_opCtx, false);
-
-    while (i.more()) {
-        const IndexDescriptor* descriptor = i.next();
-        const std::string indexNs = descriptor->indexNamespace();
-        int indexNumber = _indexConsistency->getIndexNumber(indexNs);
+    for (const auto& index : indexes) {
+        const IndexDescriptor* descriptor = index.descriptor;
+        const std::string& indexNs = index.indexNs;
+        int indexNumber = index.indexNumber;
         ValidateResults curRecordResults;
 
-        const IndexAccessMethod* iam = _indexCatalog->getIndex(descriptor);
+        const IndexAccessMethod* iam = index.iam;
 
-        if (descriptor->isPartial()) {
-            const IndexCatalogEntry* ice = _indexCatalog->getEntry(descriptor);
-            if (!ice->getFilterExpression()->matchesBSON(recordBson)) {
-                (*_indexNsResultsMap)[indexNs] = curRecordResults;
-                continue;
-            }
+        if (index.filterExpression && !index.filterExpression->matchesBSON(recordBson)) {
+            stdx::lock_guard<stdx::mutex> lk(_indexNsResultsMapMutex);
+            (*_indexNsResultsMap)[indexNs] = curRecordResults;
+            continue;
         }
 
         BSONObjSet documentKeySet = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
@@ -105,7 +239,7 @@ Status RecordStoreValidateAdaptor::validate(const RecordId& recordId,
                      &multikeyMetadataKeys,
                      &multikeyPaths);
 
-        if (!descriptor->isMultikey(_opCtx) &&
+        if (!index.isMultikey &&
             iam->shouldMarkIndexAsMultikey(documentKeySet, multikeyMetadataKeys, multikeyPaths)) {
             std::string msg = str::stream() << "Index " << descriptor->indexName()
                                             << " is not multi-key, but a multikey path "
@@ -135,11 +269,27 @@ Status RecordStoreValidateAdaptor::validate(const RecordId& recordId,
             KeyString ks(KeyString::kLatestVersion, key, ord, recordId);
             _indexConsistency->addDocKey(ks, indexNumber);
         }
+        stdx::lock_guard<stdx::mutex> lk(_indexNsResultsMapMutex);
         (*_indexNsResultsMap)[indexNs] = curRecordResults;
     }
     return status;
 }
 
+bool RecordStoreValidateAdaptor::_checkRecord(const std::vector<IndexToCheck>& indexes,
+                                              const RecordId& recordId,
+                                              const RecordData& record) {
+    size_t validatedSize;
+    Status status = _validateRecord(indexes, recordId, record, &validatedSize);
+
+    // While some storage engines may use padding, we still require that they return the
+    // unpadded record data.
+    if (!status.isOK() || validatedSize != static_cast<size_t>(record.size())) {
+        log() << "document at location: " << recordId << " is corrupted";
+        return false;
+    }
+    return true;
+}
+
 void RecordStoreValidateAdaptor::traverseIndex(const IndexAccessMethod* iam,
                                                const IndexDescriptor* descriptor,
                                                ValidateResults* results,
@@ -151,41 +301,99 @@ void RecordStoreValidateAdaptor::traverseIndex(const IndexAccessMethod* iam,
     const auto& key = descriptor->keyPattern();
     const Ordering ord = Ordering::make(key);
     KeyString::Version version = KeyString::kLatestVersion;
-    std::unique_ptr<KeyString> prevIndexKeyString = nullptr;
-    bool isFirstEntry = true;
+    const bool useWorkers = internalValidateWorkerThreads > 0;
+
+    const RecordId kWildcardMultikeyMetadataRecordId{
+        RecordId::ReservedId::kWildcardMultikeyMetadataId};
+    auto isMultikeyMetadataEntry = [&](const IndexKeyEntry& indexEntry) {
+        return descriptor->getIndexType() == IndexType::INDEX_WILDCARD &&
+            indexEntry.loc == kWildcardMultikeyMetadataRecordId;
+    };
+
+    // Set if any two consecutive index entries are out of order.
+    AtomicWord<bool> outOfOrder{false};
+
+    // Checks a run of consecutive index entries. If `startsWithPrevious` is set, the first entry
+    // is the last one of the previous run, and is only used to check the order of the next.
+    auto checkEntries = [&](const std::vector<IndexKeyEntry>& entries, bool startsWithPrevious) {
+        std::unique_ptr<KeyString> prevIndexKeyString = nullptr;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const IndexKeyEntry& indexEntry = entries[i];
+            if (isMultikeyMetadataEntry(indexEntry)) {
+                _indexConsistency->removeMultikeyMetadataPath(
+                    makeWildCardMultikeyMetadataKeyString(indexEntry.key), indexNumber);
+                continue;
+            }
 
-    std::unique_ptr<SortedDataInterface::Cursor> cursor = iam->newCursor(_opCtx, true);
-    // Seeking to BSONObj() is equivalent to seeking to the first entry of an index.
-    for (auto indexEntry = cursor->seek(BSONObj(), true); indexEntry; indexEntry = cursor->next()) {
+            // We want to use the latest version of KeyString here.
+            std::unique_ptr<KeyString> indexKeyString =
+                stdx::make_unique<KeyString>(version, indexEntry.key, ord, indexEntry.loc);
+            // Ensure that the index entries are in increasing or decreasing order.
+            if (prevIndexKeyString && *indexKeyString < *prevIndexKeyString) {
+                outOfOrder.store(true);
+            }
 
-        // We want to use the latest version of KeyString here.
-        std::unique_ptr<KeyString> indexKeyString =
-            stdx::make_unique<KeyString>(version, indexEntry->key, ord, indexEntry->loc);
-        // Ensure that the index entries are in increasing or decreasing order.
-        if (!isFirstEntry && *indexKeyString < *prevIndexKeyString) {
-            if (results->valid) {
-                results->errors.push_back(
-                    "one or more indexes are not in strictly ascending or descending "
-                    "order");
+            if (i > 0 || !startsWithPrevious) {
+                _indexConsistency->addIndexKey(*indexKeyString, indexNumber);
             }
-            results->valid = false;
+            prevIndexKeyString.swap(indexKeyString);
+        }
+    };
+
+    std::vector<IndexKeyEntry> batch;
+    bool batchStartsWithPrevious = false;
+    size_t batchBytes = 0;
+    ValidationBatches batches;
+
+    auto checkBatch = [&] {
+        // The next batch starts with the last entry whose order it has to follow.
+        auto last = std::find_if(batch.rbegin(), batch.rend(), [&](const IndexKeyEntry& entry) {
+            return !isMultikeyMetadataEntry(entry);
+        });
+        boost::optional<IndexKeyEntry> previous;
+        if (last != batch.rend()) {
+            previous.emplace(*last);
         }
 
-        const RecordId kWildcardMultikeyMetadataRecordId{
-            RecordId::ReservedId::kWildcardMultikeyMetadataId};
-        if (descriptor->getIndexType() == IndexType::INDEX_WILDCARD &&
-            indexEntry->loc == kWildcardMultikeyMetadataRecordId) {
-            _indexConsistency->removeMultikeyMetadataPath(
-                makeWildCardMultikeyMetadataKeyString(indexEntry->key), indexNumber);
-            numKeys++;
-            continue;
+        if (useWorkers) {
+            batches.schedule([
+                &checkEntries,
+                entries = std::make_shared<std::vector<IndexKeyEntry>>(std::move(batch)),
+                startsWithPrevious = batchStartsWithPrevious
+            ] { checkEntries(*entries, startsWithPrevious); });
+        } else {
+            checkEntries(batch, batchStartsWithPrevious);
         }
 
-        _indexConsistency->addIndexKey(*indexKeyString, indexNumber);
+        batch.clear();
+        batchStartsWithPrevious = static_cast<bool>(previous);
+        if (previous) {
+            batch.push_back(std::move(*previous));
+        }
+        batchBytes = 0;
+    };
 
+    std::unique_ptr<SortedDataInterface::Cursor> cursor = iam->newCursor(_opCtx, true);
+    // Seeking to BSONObj() is equivalent to seeking to the first entry of an index.
+    for (auto indexEntry = cursor->seek(BSONObj(), true); indexEntry; indexEntry = cursor->next()) {
         numKeys++;
-        isFirstEntry = false;
-        prevIndexKeyString.swap(indexKeyString);
+        batchBytes += indexEntry->key.objsize();
+        batch.emplace_back(indexEntry->key.getOwned(), indexEntry->loc);
+        if (batch.size() >= kMaxBatchEntries || batchBytes >= kMaxBatchBytes) {
+            checkBatch();
+        }
+    }
+
+    if (batch.size() > (batchStartsWithPrevious ? 1U : 0U)) {
+        checkBatch();
+    }
+    batches.wait();
+
+    if (outOfOrder.load()) {
+        results->errors.push_back(
+            "one or more indexes are not in strictly ascending or descending "
+            "order");
+        results->valid = false;
     }
 
     if (_indexConsistency->getMultikeyMetadataPathCount(indexNumber) > 0) {
@@ -201,16 +409,40 @@ void RecordStoreValidateAdaptor::traverseIndex(const IndexAccessMethod* iam,
 void RecordStoreValidateAdaptor::traverseRecordStore(RecordStore* recordStore,
                                                      ValidateCmdLevel level,
                                                      ValidateResults* results,
-                                                     BSONObjBuilder* output) {
+                                                     BSONObjBuilder* output,
+                                                     int64_t* numRecords) {
     long long nrecords = 0;
-    long long dataSizeTotal = 0;
-    long long nInvalid = 0;
+    AtomicWord<long long> nInvalid{0};
 
     results->valid = true;
     std::unique_ptr<SeekableRecordCursor> cursor = recordStore->getCursor(_opCtx, true);
     int interruptInterval = 4096;
     RecordId prevRecordId;
 
+    const auto indexes = _getIndexesToCheck();
+    const bool useWorkers = internalValidateWorkerThreads > 0;
+    auto checkRecords = [&](const std::vector<std::pair<RecordId, RecordData>>& records) {
+        for (const auto& record : records) {
+            if (!_checkRecord(indexes, record.first, record.second)) {
+                nInvalid.fetchAndAdd(1);
+            }
+        }
+    };
+
+    std::vector<std::pair<RecordId, RecordData>> batch;
+    size_t batchBytes = 0;
+    ValidationBatches batches;
+
+    auto checkBatch = [&] {
+        batches.schedule([
+            &checkRecords,
+            records = std::make_shared<std::vector<std::pair<RecordId, RecordData>>>(
+                std::move(batch))
+        ] { checkRecords(*records); });
+        batch.clear();
+        batchBytes = 0;
+    };
+
     while (auto record = cursor->next()) {
         ++nrecords;
 
@@ -219,36 +451,43 @@ void RecordStoreValidateAdaptor::traverseRecordStore(RecordStore* recordStore,
         }
 
         auto dataSize = record->data.size();
-        dataSizeTotal += dataSize;
-        size_t validatedSize;
-        Status status = validate(record->id, record->data, &validatedSize);
 
         // Checks to ensure isInRecordIdOrder() is being used properly.
         if (prevRecordId.isValid()) {
             invariant(prevRecordId < record->id);
         }
+        prevRecordId = record->id;
 
-        // While some storage engines may use padding, we still require that they return the
-        // unpadded record data.
-        if (!status.isOK() || validatedSize != static_cast<size_t>(dataSize)) {
-            if (results->valid) {
-                // Only log once.
-                results->errors.push_back("detected one or more invalid documents (see logs)");
+        if (!useWorkers) {
+            if (!_checkRecord(indexes, record->id, record->data)) {
+                nInvalid.fetchAndAdd(1);
             }
-            nInvalid++;
-            results->valid = false;
-            log() << "document at location: " << record->id << " is corrupted";
+            continue;
         }
 
-        prevRecordId = record->id;
+        // The record's data only lives as long as the cursor is positioned on it.
+        batch.emplace_back(record->id, record->data.getOwned());
+        batchBytes += dataSize;
+        if (batch.size() >= kMaxBatchEntries || batchBytes >= kMaxBatchBytes) {
+            checkBatch();
+        }
     }
 
-    if (results->valid) {
-        recordStore->updateStatsAfterRepair(_opCtx, nrecords, dataSizeTotal);
+    if (!batch.empty()) {
+        checkBatch();
+    }
+    batches.wait();
+
+    if (nInvalid.load() > 0) {
+        results->errors.push_back("detected one or more invalid documents (see logs)");
+        results->valid = false;
     }
 
-    output->append("nInvalidDocuments", nInvalid);
+    // The records are traversed while writes may run concurrently, so the traversal's totals are
+    // not used to correct the collection's fast count and size.
+    output->append("nInvalidDocuments", nInvalid.load());
     output->appendNumber("nrecords", nrecords);
+    *numRecords = nrecords;
 }
 
 void RecordStoreValidateAdaptor::validateIndexKeyCount(IndexDescriptor* idx,
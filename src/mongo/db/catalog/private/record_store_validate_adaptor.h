@@ -34,10 +34,12 @@
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/record_store.h"
+#include "mongo/stdx/mutex.h"
 
 namespace mongo {
 
 class IndexConsistency;
+class MatchExpression;
 
 namespace {
 
@@ -70,7 +72,8 @@ public:
 
     /**
      * Traverses the index getting index entriess to validate them and keep track of the index keys
-     * for index consistency.
+     * for index consistency. The index entries are validated by the worker threads, if any, while
+     * they are read.
      */
     void traverseIndex(const IndexAccessMethod* iam,
                        const IndexDescriptor* descriptor,
@@ -79,12 +82,15 @@ public:
 
     /**
      * Traverses the record store to retrieve every record and go through its document key
-     * set to keep track of the index consistency during a validation.
+     * set to keep track of the index consistency during a validation. The records are validated by
+     * the worker threads, if any, while they are read. Sets `numRecords` to the number of records
+     * traversed.
      */
     void traverseRecordStore(RecordStore* recordStore,
                              ValidateCmdLevel level,
                              ValidateResults* results,
-                             BSONObjBuilder* output);
+                             BSONObjBuilder* output,
+                             int64_t* numRecords);
 
     /**
      * Validate that the number of document keys matches the number of index keys.
@@ -92,10 +98,46 @@ public:
     void validateIndexKeyCount(IndexDescriptor* idx, int64_t numRecs, ValidateResults& results);
 
 private:
+    /**
+     * An index the records are validated against, resolved up front so that the records can be
+     * validated without the OperationContext.
+     */
+    struct IndexToCheck {
+        const IndexDescriptor* descriptor;
+        const IndexAccessMethod* iam;
+        std::string indexNs;
+        int indexNumber;
+        // Null unless the index is partial.
+        const MatchExpression* filterExpression;
+        bool isMultikey;
+    };
+
+    std::vector<IndexToCheck> _getIndexesToCheck() const;
+
+    /**
+     * Validates the record and adds its index keys, like validate(), using only the given indexes.
+     * May be called by several threads at once.
+     */
+    Status _validateRecord(const std::vector<IndexToCheck>& indexes,
+                           const RecordId& recordId,
+                           const RecordData& record,
+                           size_t* dataSize);
+
+    /**
+     * Validates a record read by traverseRecordStore(), logging it if it is corrupted. Returns
+     * whether the record is valid.
+     */
+    bool _checkRecord(const std::vector<IndexToCheck>& indexes,
+                      const RecordId& recordId,
+                      const RecordData& record);
+
     OperationContext* _opCtx;             // Not owned.
     IndexConsistency* _indexConsistency;  // Not owned.
     ValidateCmdLevel _level;
     IndexCatalog* _indexCatalog;             // Not owned.
     ValidateResultsMap* _indexNsResultsMap;  // Not owned.
+
+    // Protects `_indexNsResultsMap` while records are validated by several threads.
+    stdx::mutex _indexNsResultsMapMutex;
 };
 }  // namespace
@@ -277,6 +277,15 @@ public:
         }
         void operator*() && = delete;
 
+        /**
+         * Returns the lock held on this partition, so that callers can wait on a condition variable
+         * protected by it.
+         */
+        stdx::unique_lock<stdx::mutex>& lock() & {
+            return _partitionLock;
+        }
+        void lock() && = delete;
+
     private:
         friend class Partitioned;
 
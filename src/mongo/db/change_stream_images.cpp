@@ -0,0 +1,147 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/change_stream_images.h"
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/dbhelpers.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+
+namespace mongo {
+
+namespace {
+
+MONGO_EXPORT_SERVER_PARAMETER(changeStreamImagesExpireAfterSeconds, int, 60 * 60)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0) {
+            return Status(ErrorCodes::BadValue,
+                          "changeStreamImagesExpireAfterSeconds must be > 0");
+        }
+        return Status::OK();
+    });
+
+constexpr StringData kUUIDFieldName = "ui"_sd;
+constexpr StringData kWallClockTimeFieldName = "wall"_sd;
+constexpr StringData kPreImageFieldName = "preImage"_sd;
+constexpr StringData kPostImageFieldName = "postImage"_sd;
+
+// Leaves room for the fields other than the images themselves.
+constexpr int kMaxImagesSize = BSONObjMaxUserSize - 1024;
+
+}  // namespace
+
+Status createChangeStreamImagesCollection(OperationContext* opCtx) {
+    const auto& nss = NamespaceString::kChangeStreamImagesNamespace;
+    DBDirectClient client(opCtx);
+
+    BSONObj createResult;
+    client.runCommand(nss.db().toString(), BSON("create" << nss.coll()), createResult);
+    auto status = getStatusFromCommandResult(createResult);
+    if (!status.isOK() && status != ErrorCodes::NamespaceExists) {
+        return status;
+    }
+
+    // If the index already exists with a different expiry, it is left as it is; collMod may be
+    // used to change it.
+    BSONObj indexResult;
+    client.runCommand(
+        nss.db().toString(),
+        BSON("createIndexes" << nss.coll() << "indexes"
+                             << BSON_ARRAY(BSON("key" << BSON(kWallClockTimeFieldName << 1)
+                                                      << "name"
+                                                      << "wall_1"
+                                                      << "expireAfterSeconds"
+                                                      << changeStreamImagesExpireAfterSeconds
+                                                             .load()))),
+        indexResult);
+    status = getStatusFromCommandResult(indexResult);
+    if (!status.isOK() && status != ErrorCodes::IndexOptionsConflict) {
+        return status;
+    }
+    return Status::OK();
+}
+
+void recordChangeStreamImages(OperationContext* opCtx,
+                              CollectionUUID uuid,
+                              Timestamp ts,
+                              Date_t wallClockTime,
+                              const BSONObj& preImage,
+                              const BSONObj& postImage) {
+    if (preImage.objsize() + postImage.objsize() > kMaxImagesSize) {
+        return;
+    }
+
+    AutoGetCollection autoColl(opCtx, NamespaceString::kChangeStreamImagesNamespace, MODE_IX);
+    auto collection = autoColl.getCollection();
+    if (!collection) {
+        return;
+    }
+
+    BSONObjBuilder imagesBuilder;
+    imagesBuilder.append("_id", ts);
+    uuid.appendToBuilder(&imagesBuilder, kUUIDFieldName);
+    imagesBuilder.append(kWallClockTimeFieldName, wallClockTime);
+    imagesBuilder.append(kPreImageFieldName, preImage);
+    imagesBuilder.append(kPostImageFieldName, postImage);
+
+    OpDebug* const nullOpDebug = nullptr;
+    uassertStatusOK(collection->insertDocument(
+        opCtx, InsertStatement(imagesBuilder.obj()), nullOpDebug, false));
+}
+
+boost::optional<ChangeStreamImages> findChangeStreamImages(OperationContext* opCtx,
+                                                           CollectionUUID uuid,
+                                                           Timestamp ts) {
+    AutoGetCollectionForRead autoColl(opCtx, NamespaceString::kChangeStreamImagesNamespace);
+    auto collection = autoColl.getCollection();
+    if (!collection) {
+        return boost::none;
+    }
+
+    BSONObj images;
+    if (!Helpers::findOne(opCtx, collection, BSON("_id" << ts), images, true)) {
+        return boost::none;
+    }
+
+    // The images must have been recorded for the collection the caller is looking at.
+    auto imagesUUID = UUID::parse(images[kUUIDFieldName]);
+    if (!imagesUUID.isOK() || imagesUUID.getValue() != uuid) {
+        return boost::none;
+    }
+    return ChangeStreamImages{images[kPreImageFieldName].Obj().getOwned(),
+                              images[kPostImageFieldName].Obj().getOwned()};
+}
+
+}  // namespace mongo
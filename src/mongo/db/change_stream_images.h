@@ -0,0 +1,88 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/status.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/timestamp.h"
+#include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Collections created or modified with {recordChangeStreamImages: true} store the pre- and
+ * post-images of each update, outside of a multi-document transaction, in the
+ * config.change_stream_images collection, within the same WriteUnitOfWork as the update. Each
+ * image document has the form
+ *
+ *   {_id: <timestamp of the update>, ui: <collection UUID>, wall: <wall clock time of the update>,
+ *    preImage: <document>, postImage: <document>}.
+ *
+ * The images are written on the primary and replicated like any other write, and expire after
+ * changeStreamImagesExpireAfterSeconds through a TTL index on 'wall'.
+ */
+
+/**
+ * Creates the change stream images collection and its TTL index if they do not exist. Must be
+ * called without holding any locks.
+ */
+Status createChangeStreamImagesCollection(OperationContext* opCtx);
+
+/**
+ * Records the images of the update of a document in the collection 'uuid' which was logged at
+ * 'ts'. Does nothing if the images collection does not exist or if the images are too large to be
+ * stored together.
+ */
+void recordChangeStreamImages(OperationContext* opCtx,
+                              CollectionUUID uuid,
+                              Timestamp ts,
+                              Date_t wallClockTime,
+                              const BSONObj& preImage,
+                              const BSONObj& postImage);
+
+struct ChangeStreamImages {
+    BSONObj preImage;
+    BSONObj postImage;
+};
+
+/**
+ * Returns the images recorded for the update of a document in the collection 'uuid' which was
+ * logged at 'ts', if there are any.
+ */
+boost::optional<ChangeStreamImages> findChangeStreamImages(OperationContext* opCtx,
+                                                           CollectionUUID uuid,
+                                                           Timestamp ts);
+
+}  // namespace mongo
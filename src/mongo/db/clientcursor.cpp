@@ -46,6 +46,7 @@
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/cursor_server_params.h"
+#include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/repl/repl_client_info.h"
@@ -63,6 +64,7 @@ static Counter64 cursorStatsOpen;           // gauge
 static Counter64 cursorStatsOpenPinned;     // gauge
 static Counter64 cursorStatsOpenNoTimeout;  // gauge
 static Counter64 cursorStatsTimedOut;
+static Counter64 cursorStatsKilledForMemory;
 
 static ServerStatusMetricField<Counter64> dCursorStatsOpen("cursor.open.total", &cursorStatsOpen);
 static ServerStatusMetricField<Counter64> dCursorStatsOpenPinned("cursor.open.pinned",
@@ -71,6 +73,8 @@ static ServerStatusMetricField<Counter64> dCursorStatsOpenNoTimeout("cursor.open
                                                                     &cursorStatsOpenNoTimeout);
 static ServerStatusMetricField<Counter64> dCursorStatusTimedout("cursor.timedOut",
                                                                 &cursorStatsTimedOut);
+static ServerStatusMetricField<Counter64> dCursorStatsKilledForMemory(
+    "cursor.killedForMemory", &cursorStatsKilledForMemory);
 
 long long ClientCursor::totalOpen() {
     return cursorStatsOpen.get();
@@ -148,10 +152,17 @@ GenericCursor ClientCursor::toGenericCursor() const {
     gc.setPlanSummary(getPlanSummary());
     if (auto opCtx = _operationUsingCursor) {
         gc.setOperationUsingCursorId(opCtx->getOpID());
+    } else {
+        gc.setMemUsageBytes(static_cast<long long>(getMemUsage()));
     }
     return gc;
 }
 
+size_t ClientCursor::getMemUsage() const {
+    invariant(!_operationUsingCursor);
+    return _exec->getRootStage()->getMemUsage();
+}
+
 //
 // Pin methods
 //
@@ -275,7 +286,7 @@ namespace {
 //
 
 /**
- * Thread for timing out inactive cursors.
+ * Thread for timing out inactive cursors and enforcing the limit on the memory they hold.
  */
 class ClientCursorMonitor : public BackgroundJob {
 public:
@@ -292,6 +303,10 @@ public:
                 auto now = opCtx->getServiceContext()->getPreciseClockSource()->now();
                 cursorStatsTimedOut.increment(
                     CursorManager::timeoutCursorsGlobal(opCtx.get(), now));
+                if (auto limitBytes = getIdleCursorMemoryLimitBytes()) {
+                    cursorStatsKilledForMemory.increment(
+                        CursorManager::reclaimIdleCursorMemoryGlobal(opCtx.get(), limitBytes));
+                }
             }
             MONGO_IDLE_THREAD_BLOCK;
             sleepsecs(getClientCursorMonitorFrequencySecs());
@@ -205,6 +205,12 @@ public:
         return _lastUseDate;
     }
 
+    /**
+     * Returns an estimate of the bytes of buffered results held by this cursor's PlanExecutor. Must
+     * only be called while the cursor is not pinned.
+     */
+    size_t getMemUsage() const;
+
     Date_t getCreatedDate() const {
         return _createdDate;
     }
@@ -32,6 +32,7 @@
 
 #include "mongo/db/commands.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -104,6 +105,10 @@ bool checkAuthorizationImplPreParse(OperationContext* opCtx,
     return false;
 }
 
+// Replies are pre-sized from recent replies only up to this size. A command whose replies are
+// usually small should not reserve megabytes for every reply after one large one.
+constexpr std::size_t kMaxReplySizeHintBytes = 64 * 1024;
+
 // The command names that are allowed in a multi-document transaction.
 const StringMap<int> txnCmdWhitelist = {{"abortTransaction", 1},
                                         {"aggregate", 1},
@@ -151,7 +156,7 @@ BSONObj CommandHelpers::runCommandDirectly(OperationContext* opCtx, const OpMsgR
     std::unique_ptr<CommandInvocation> invocation;
     try {
         invocation = command->parse(opCtx, request);
-        invocation->run(opCtx, &replyBuilder);
+        invocation->runAsync(opCtx, &replyBuilder).get();
         auto body = replyBuilder.getBodyBuilder();
         CommandHelpers::extractOrAppendOk(body);
     } catch (const StaleConfigException&) {
@@ -550,6 +555,12 @@ private:
 
 Command::~Command() = default;
 
+std::size_t Command::replyBytesToReserve() const {
+    if (auto bytes = reserveBytesForReply())
+        return bytes;
+    return std::min(static_cast<std::size_t>(_replySizeTracker.getSize()), kMaxReplySizeHintBytes);
+}
+
 void Command::snipForLogging(mutablebson::Document* cmdObj) const {
     StringData sensitiveField = sensitiveFieldName();
     if (!sensitiveField.empty()) {
@@ -48,6 +48,7 @@
 #include "mongo/rpc/op_msg.h"
 #include "mongo/rpc/reply_builder_interface.h"
 #include "mongo/stdx/functional.h"
+#include "mongo/util/future.h"
 #include "mongo/util/string_map.h"
 
 namespace mongo {
@@ -286,6 +287,20 @@ public:
         return 0u;
     }
 
+    /**
+     * Returns how much space the rpc system should reserve for a reply to this command. Commands
+     * without their own reserveBytesForReply() hint get the size of their recent replies, so that
+     * building a reply does not repeatedly reallocate its buffer.
+     */
+    std::size_t replyBytesToReserve() const;
+
+    /**
+     * Records the size of a reply to this command, for use by replyBytesToReserve().
+     */
+    void recordReplySize(int bytes) const {
+        _replySizeTracker.got(bytes);
+    }
+
     /**
      * Return true for "user management commands", a distinction that affects
      * backward compatible output formatting.
@@ -427,6 +442,8 @@ private:
     // Counters for how many times this command has been executed and failed
     mutable Counter64 _commandsExecuted;
     mutable Counter64 _commandsFailed;
+    // Sizes of recent replies to this command
+    mutable BSONSizeTracker _replySizeTracker;
     // Pointers to hold the metrics tree references
     ServerStatusMetricField<Counter64> _commandsExecutedMetric;
     ServerStatusMetricField<Counter64> _commandsFailedMetric;
@@ -454,6 +471,19 @@ public:
      */
     virtual void run(OperationContext* opCtx, rpc::ReplyBuilderInterface* result) = 0;
 
+    /**
+     * Asynchronous form of run(), through which the command dispatch paths invoke commands. The
+     * returned Future is ready once 'result' has been filled in; errors may either be thrown from
+     * here, as from run(), or be carried by the Future. Commands which would otherwise block the
+     * calling thread, e.g. on a remote response, may override this to complete the Future from a
+     * continuation, in which case 'opCtx' and 'result' remain valid until it is ready. The default
+     * runs run() inline and returns a ready Future.
+     */
+    virtual Future<void> runAsync(OperationContext* opCtx, rpc::ReplyBuilderInterface* result) {
+        run(opCtx, result);
+        return Future<void>::makeReady();
+    }
+
     virtual void explain(OperationContext* opCtx,
                          ExplainOptions::Verbosity verbosity,
                          rpc::ReplyBuilderInterface* result) {
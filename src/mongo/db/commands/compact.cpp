@@ -39,20 +39,126 @@
 #include "mongo/db/background.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog_raii.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index_builder.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/util/log.h"
+#include "mongo/util/progress_meter.h"
 
 namespace mongo {
 
 using std::string;
 using std::stringstream;
 
+namespace {
+
+// Milliseconds an online compact waits, holding no locks, between the tables it compacts, to leave
+// room for the operations running against the collection.
+MONGO_EXPORT_SERVER_PARAMETER(onlineCompactPauseMillis, int, 100)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue, "onlineCompactPauseMillis must be non-negative");
+        }
+        return Status::OK();
+    });
+
+long long collectionStorageSize(OperationContext* opCtx, Collection* collection) {
+    return collection->getRecordStore()->storageSize(opCtx) +
+        static_cast<long long>(collection->getIndexSize(opCtx));
+}
+
+/**
+ * Compacts the record store and then each index of the collection 'nss', one table at a time and
+ * holding only intent locks, so that reads and writes to the collection carry on. The locks are
+ * released between tables: operations which need the collection exclusively, such as drops and
+ * index builds, wait for the compaction of at most one table. Only storage engines which compact
+ * in place support this. Returns the number of bytes of storage that were freed.
+ */
+long long compactOnline(OperationContext* opCtx, const NamespaceString& nss) {
+    boost::optional<UUID> uuid;
+    std::vector<std::string> indexNames;
+    long long sizeBefore = 0;
+    {
+        AutoGetCollection autoColl(opCtx, nss, MODE_IX);
+        Collection* collection = autoColl.getCollection();
+        uassert(ErrorCodes::NamespaceNotFound, "collection does not exist", collection);
+        uassert(ErrorCodes::CommandNotSupported,
+                str::stream() << "online compaction is not supported by record store "
+                              << collection->getRecordStore()->name(),
+                collection->getRecordStore()->compactSupported() &&
+                    collection->getRecordStore()->compactsInPlace());
+        uassert(ErrorCodes::CommandNotSupported,
+                "online compaction requires a collection with a UUID",
+                collection->uuid());
+        BackgroundOperation::assertNoBgOpInProgForNs(nss.ns());
+
+        uuid = collection->uuid();
+        IndexCatalog::IndexIterator ii =
+            collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+        while (ii.more()) {
+            indexNames.push_back(ii.next()->indexName());
+        }
+        sizeBefore = collectionStorageSize(opCtx, collection);
+    }
+
+    ProgressMeterHolder progress([&]() -> ProgressMeter& {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        return CurOp::get(opCtx)->setMessage_inlock(
+            "Online compact", "Online Compact Progress (tables)", indexNames.size() + 1);
+    }());
+
+    long long sizeAfter = 0;
+    for (size_t table = 0; table <= indexNames.size(); ++table) {
+        if (table > 0) {
+            opCtx->sleepFor(Milliseconds(onlineCompactPauseMillis.load()));
+        }
+        opCtx->checkForInterrupt();
+
+        AutoGetCollection autoColl(opCtx, {nss.db().toString(), *uuid}, MODE_IX);
+        Collection* collection = autoColl.getCollection();
+        uassert(ErrorCodes::NamespaceNotFound,
+                "collection was dropped during online compaction",
+                collection);
+        BackgroundOperation::assertNoBgOpInProgForNs(collection->ns().ns());
+
+        if (table == 0) {
+            LOG(1) << "online compact of " << collection->ns() << " compacting record store";
+            CompactOptions compactOptions;
+            CompactStats stats;
+            uassertStatusOK(
+                collection->getRecordStore()->compact(opCtx, nullptr, &compactOptions, &stats));
+        } else {
+            // An index which was dropped since the compaction started is skipped.
+            const std::string& indexName = indexNames[table - 1];
+            IndexCatalog* indexCatalog = collection->getIndexCatalog();
+            if (IndexDescriptor* descriptor = indexCatalog->findIndexByName(opCtx, indexName)) {
+                LOG(1) << "online compact of " << collection->ns() << " compacting index "
+                       << indexName;
+                uassertStatusOK(indexCatalog->getIndex(descriptor)->compact(opCtx));
+            }
+        }
+        progress.hit();
+
+        if (table == indexNames.size()) {
+            sizeAfter = collectionStorageSize(opCtx, collection);
+        }
+    }
+
+    return std::max(0LL, sizeBefore - sizeAfter);
+}
+
+}  // namespace
+
 class CompactCmd : public ErrmsgCommandDeprecated {
 public:
     virtual bool supportsWriteConcern(const BSONObj& cmd) const override {
@@ -79,8 +185,10 @@ public:
                "warning: this operation locks the database and is slow. you can cancel with "
                "killOp()\n"
                "{ compact : <collection_name>, [force:<bool>], [validate:<bool>],\n"
-               "  [paddingFactor:<num>], [paddingBytes:<num>] }\n"
+               "  [paddingFactor:<num>], [paddingBytes:<num>], [online:<bool>] }\n"
                "  force - allows to run on a replica set primary\n"
+               "  online - compact in place under intent locks, one table at a time, without "
+               "blocking reads and writes\n"
                "  validate - check records are noncorrupt before adding to newly compacting "
                "extents. slower but safer (defaults to true in this version)\n";
     }
@@ -92,9 +200,10 @@ public:
                            string& errmsg,
                            BSONObjBuilder& result) {
         NamespaceString nss = CommandHelpers::parseNsCollectionRequired(db, cmdObj);
+        const bool online = cmdObj["online"].trueValue();
 
         repl::ReplicationCoordinator* replCoord = repl::ReplicationCoordinator::get(opCtx);
-        if (replCoord->getMemberState().primary() && !cmdObj["force"].trueValue()) {
+        if (!online && replCoord->getMemberState().primary() && !cmdObj["force"].trueValue()) {
             errmsg =
                 "will not run compact on an active replica set primary as this is a slow blocking "
                 "operation. use force:true to force";
@@ -112,6 +221,13 @@ public:
             return false;
         }
 
+        if (online) {
+            log() << "online compact " << nss.ns() << " begin";
+            result.appendNumber("bytesFreed", compactOnline(opCtx, nss));
+            log() << "online compact " << nss.ns() << " end";
+            return true;
+        }
+
         CompactOptions compactOptions;
 
         if (cmdObj["preservePadding"].trueValue()) {
@@ -421,6 +421,9 @@ public:
 
             uassert(28551, "database dropped during index build", db);
             uassert(28552, "collection dropped during index build", db->getCollection(opCtx, ns));
+
+            // Apply the writes made since the collection scan ended.
+            uassertStatusOK(indexer.drainBackgroundWrites());
         }
 
         writeConflictRetry(opCtx, kCommandName, ns.ns(), [&] {
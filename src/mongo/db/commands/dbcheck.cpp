@@ -44,6 +44,9 @@
 #include "mongo/db/repl/dbcheck.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/optime.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/background.h"
 
 #include "mongo/util/log.h"
@@ -53,6 +56,7 @@ namespace mongo {
 namespace {
 constexpr uint64_t kBatchDocs = 5'000;
 constexpr uint64_t kBatchBytes = 20'000'000;
+constexpr int64_t kMaxConcurrentCollections = 64;
 
 
 /**
@@ -64,13 +68,71 @@ struct DbCheckCollectionInfo {
     BSONKey end;
     int64_t maxCount;
     int64_t maxSize;
+};
+
+/**
+ * A run of dbCheck consists of a series of collections, up to `maxConcurrentCollections` of which
+ * are checked at a time. All of them together are checked at no more than `maxRate` documents per
+ * second.
+ */
+struct DbCheckRun {
+    std::vector<DbCheckCollectionInfo> collections;
     int64_t maxRate;
+    int64_t maxConcurrentCollections;
 };
 
 /**
- * A run of dbCheck consists of a series of collections.
+ * Limits the rate at which the batches of a dbCheck run, possibly checking several collections at
+ * once, go through documents.
  */
-using DbCheckRun = std::vector<DbCheckCollectionInfo>;
+class DbCheckRateLimiter {
+    MONGO_DISALLOW_COPYING(DbCheckRateLimiter);
+
+public:
+    explicit DbCheckRateLimiter(int64_t maxRate) : _maxRate(maxRate) {}
+
+    /**
+     * Accounts for a batch of `nDocs` documents, sleeping until the documents seen fit the rate.
+     */
+    void consume(int64_t nDocs) {
+        using namespace std::literals::chrono_literals;
+
+        if (_maxRate <= 0) {
+            return;
+        }
+
+        TimePoint wakeUp;
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            if (Clock::now() - _intervalStart > 1s) {
+                _intervalStart = Clock::now();
+                _docsInCurrentInterval = 0;
+            }
+
+            _docsInCurrentInterval += nDocs;
+            if (_docsInCurrentInterval <= _maxRate) {
+                return;
+            }
+
+            // If an extremely low max rate has been set (substantially smaller than the batch
+            // size) we might want to sleep for multiple seconds between batches.
+            int64_t timesExceeded = _docsInCurrentInterval / _maxRate;
+            wakeUp = _intervalStart + timesExceeded * 1s;
+        }
+
+        stdx::this_thread::sleep_until(wakeUp);
+    }
+
+private:
+    using Clock = stdx::chrono::system_clock;
+    using TimePoint = stdx::chrono::time_point<Clock>;
+
+    const int64_t _maxRate;
+
+    stdx::mutex _mutex;  // protects the members below
+    TimePoint _intervalStart = Clock::now();
+    int64_t _docsInCurrentInterval = 0;
+};
 
 /**
  * Check if dbCheck can run on the given namespace.
@@ -115,10 +177,11 @@ std::unique_ptr<DbCheckRun> singleCollectionRun(OperationContext* opCtx,
     auto end = invocation.getMaxKey();
     auto maxCount = invocation.getMaxCount();
     auto maxSize = invocation.getMaxSize();
-    auto maxRate = invocation.getMaxCountPerSecond();
-    auto info = DbCheckCollectionInfo{nss, start, end, maxCount, maxSize, maxRate};
+    auto info = DbCheckCollectionInfo{nss, start, end, maxCount, maxSize};
     auto result = stdx::make_unique<DbCheckRun>();
-    result->push_back(info);
+    result->collections.push_back(info);
+    result->maxRate = invocation.getMaxCountPerSecond();
+    result->maxConcurrentCollections = 1;
     return result;
 }
 
@@ -135,13 +198,21 @@ std::unique_ptr<DbCheckRun> fullDatabaseRun(OperationContext* opCtx,
 
     uassert(ErrorCodes::NamespaceNotFound, "Database " + dbName + " not found", agd.getDb());
 
+    auto maxConcurrentCollections = invocation.getMaxConcurrentCollections();
+    uassert(ErrorCodes::InvalidOptions,
+            str::stream() << "maxConcurrentCollections must be between 1 and "
+                          << kMaxConcurrentCollections,
+            maxConcurrentCollections >= 1 &&
+                maxConcurrentCollections <= kMaxConcurrentCollections);
+
     int64_t max = std::numeric_limits<int64_t>::max();
-    auto rate = invocation.getMaxCountPerSecond();
 
     for (Collection* coll : *db) {
-        DbCheckCollectionInfo info{coll->ns(), BSONKey::min(), BSONKey::max(), max, max, rate};
-        result->push_back(info);
+        DbCheckCollectionInfo info{coll->ns(), BSONKey::min(), BSONKey::max(), max, max};
+        result->collections.push_back(info);
     }
+    result->maxRate = invocation.getMaxCountPerSecond();
+    result->maxConcurrentCollections = maxConcurrentCollections;
 
     return result;
 }
@@ -182,7 +253,12 @@ std::unique_ptr<DbCheckRun> getRun(OperationContext* opCtx,
 class DbCheckJob : public BackgroundJob {
 public:
     DbCheckJob(const StringData& dbName, std::unique_ptr<DbCheckRun> run)
-        : BackgroundJob(true), _done(false), _dbName(dbName.toString()), _run(std::move(run)) {}
+        : BackgroundJob(true),
+          _done(false),
+          _failed(false),
+          _dbName(dbName.toString()),
+          _run(std::move(run)),
+          _rateLimiter(_run->maxRate) {}
 
 protected:
     virtual std::string name() const override {
@@ -194,31 +270,72 @@ protected:
         Client::initThread(name());
         ON_BLOCK_EXIT([] { Client::destroy(); });
 
-        for (const auto& coll : *_run) {
+        if (_run->collections.empty()) {
+            return;
+        }
+
+        // The collections are handed out one at a time to this thread and its helpers, each of
+        // which checks its collection batch by batch.
+        const auto numThreads =
+            std::min<size_t>(_run->maxConcurrentCollections, _run->collections.size());
+        std::vector<stdx::thread> helpers;
+        // Joins the helpers started so far if starting another one throws.
+        ON_BLOCK_EXIT([&] {
+            for (auto&& helper : helpers) {
+                helper.join();
+            }
+        });
+        for (size_t i = 1; i < numThreads; ++i) {
+            helpers.emplace_back([this, i] {
+                Client::initThread(str::stream() << name() << "-" << i);
+                ON_BLOCK_EXIT([] { Client::destroy(); });
+                _doCollections();
+            });
+        }
+
+        _doCollections();
+        for (auto&& helper : helpers) {
+            helper.join();
+        }
+        helpers.clear();
+
+        if (_done.load()) {
+            log() << "dbCheck terminated due to stepdown";
+        }
+    }
+
+private:
+    /**
+     * Checks collections of the run until none is left, or the run is stopped by a stepdown or a
+     * failure.
+     */
+    void _doCollections() {
+        while (!_done.load() && !_failed.load()) {
+            auto i = _nextCollection.fetchAndAdd(1);
+            if (i >= _run->collections.size()) {
+                return;
+            }
+
+            const auto& coll = _run->collections[i];
             try {
                 _doCollection(coll);
             } catch (const DBException& e) {
                 auto logEntry = dbCheckErrorHealthLogEntry(
                     coll.nss, "dbCheck failed", OplogEntriesEnum::Batch, e.toStatus());
                 HealthLog::get(Client::getCurrent()->getServiceContext()).log(*logEntry);
-                return;
-            }
-
-            if (_done) {
-                log() << "dbCheck terminated due to stepdown";
+                _failed.store(true);
                 return;
             }
         }
     }
 
-private:
     void _doCollection(const DbCheckCollectionInfo& info) {
         // If we can't find the collection, abort the check.
         if (!_getCollectionMetadata(info)) {
             return;
         }
 
-        if (_done) {
+        if (_done.load()) {
             return;
         }
 
@@ -230,23 +347,12 @@ private:
         int64_t totalBytesSeen = 0;
         int64_t totalDocsSeen = 0;
 
-        // Limit the rate of the check.
-        using Clock = stdx::chrono::system_clock;
-        using TimePoint = stdx::chrono::time_point<Clock>;
-        TimePoint lastStart = Clock::now();
-        int64_t docsInCurrentInterval = 0;
-
+        // Each batch starts after the last key of the previous one, so the batches of a
+        // collection are run one after the other.
         do {
-            using namespace std::literals::chrono_literals;
-
-            if (Clock::now() - lastStart > 1s) {
-                lastStart = Clock::now();
-                docsInCurrentInterval = 0;
-            }
-
             auto result = _runBatch(info, start, kBatchDocs, kBatchBytes);
 
-            if (_done) {
+            if (_done.load() || _failed.load()) {
                 return;
             }
 
@@ -277,7 +383,6 @@ private:
             // Update our running totals.
             totalDocsSeen += stats.nDocs;
             totalBytesSeen += stats.nBytes;
-            docsInCurrentInterval += stats.nDocs;
 
             // Check if we've exceeded any limits.
             bool reachedLast = stats.lastKey >= info.end;
@@ -285,13 +390,8 @@ private:
             bool tooManyBytes = totalBytesSeen >= info.maxSize;
             reachedEnd = reachedLast || tooManyDocs || tooManyBytes;
 
-            if (docsInCurrentInterval > info.maxRate && info.maxRate > 0) {
-                // If an extremely low max rate has been set (substantially smaller than the batch
-                // size) we might want to sleep for multiple seconds between batches.
-                int64_t timesExceeded = docsInCurrentInterval / info.maxRate;
-
-                stdx::this_thread::sleep_for(timesExceeded * 1s - (Clock::now() - lastStart));
-            }
+            // Limit the rate of the check.
+            _rateLimiter.consume(stats.nDocs);
         } while (!reachedEnd);
     }
 
@@ -306,10 +406,15 @@ private:
         repl::OpTime time;
     };
 
-    // Set if the job cannot proceed.
-    bool _done;
+    // Set if the job cannot proceed because of a stepdown.
+    AtomicWord<bool> _done;
+    // Set if checking a collection failed, which stops the job.
+    AtomicWord<bool> _failed;
     std::string _dbName;
     std::unique_ptr<DbCheckRun> _run;
+    DbCheckRateLimiter _rateLimiter;
+    // The index in the run of the next collection to check.
+    AtomicWord<unsigned long long> _nextCollection{0};
 
     bool _getCollectionMetadata(const DbCheckCollectionInfo& info) {
         auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
@@ -320,7 +425,7 @@ private:
         AutoGetDbForDbCheck agd(opCtx, info.nss);
 
         if (_stepdownHasOccurred(opCtx, info.nss)) {
-            _done = true;
+            _done.store(true);
             return true;
         }
 
@@ -390,7 +495,7 @@ private:
         AutoGetCollectionForDbCheck agc(opCtx, info.nss, OplogEntriesEnum::Batch);
 
         if (_stepdownHasOccurred(opCtx, info.nss)) {
-            _done = true;
+            _done.store(true);
             return Status(ErrorCodes::PrimarySteppedDown, "dbCheck terminated due to stepdown");
         }
 
@@ -515,7 +620,10 @@ public:
                "              maxSize: <max size of docs>,\n"
                "              maxCountPerSecond: <max rate in docs/sec> } "
                "to check a collection.\n"
-               "Invoke with {dbCheck: 1} to check all collections in the database.";
+               "Invoke with { dbCheck: 1,\n"
+               "              maxCountPerSecond: <max rate in docs/sec>,\n"
+               "              maxConcurrentCollections: <collections checked at once> } "
+               "to check all collections in the database.";
     }
 
     virtual Status checkAuthForCommand(Client* client,
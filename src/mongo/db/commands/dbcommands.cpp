@@ -52,6 +52,7 @@
 #include "mongo/db/catalog/drop_database.h"
 #include "mongo/db/catalog/index_key_validate.h"
 #include "mongo/db/catalog_raii.h"
+#include "mongo/db/change_stream_images.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/profile_common.h"
@@ -296,6 +297,10 @@ public:
             result.append("note", deprecationWarning);
         }
 
+        if (cmdObj["recordChangeStreamImages"].trueValue()) {
+            uassertStatusOK(createChangeStreamImagesCollection(opCtx));
+        }
+
         // Validate _id index spec and fill in missing fields.
         if (auto idIndexElem = cmdObj["idIndex"]) {
             if (cmdObj["viewOn"]) {
@@ -590,6 +595,9 @@ public:
              const BSONObj& jsobj,
              BSONObjBuilder& result) {
         const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, jsobj));
+        if (jsobj["recordChangeStreamImages"].trueValue()) {
+            uassertStatusOK(createChangeStreamImagesCollection(opCtx));
+        }
         uassertStatusOK(collMod(opCtx, nss, jsobj, &result));
         return true;
     }
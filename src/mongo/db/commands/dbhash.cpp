@@ -33,6 +33,7 @@
 #include "mongo/platform/basic.h"
 
 #include <boost/optional.hpp>
+#include <iomanip>
 #include <map>
 #include <string>
 
@@ -45,17 +46,190 @@
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/transaction_participant.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/log.h"
 #include "mongo/util/md5.hpp"
 #include "mongo/util/net/socket_utils.h"
 #include "mongo/util/timer.h"
 
+#include <third_party/murmurhash3/MurmurHash3.h>
+
 namespace mongo {
 
+// Number of threads hashing the documents that dbHash reads, so that the hashing overlaps with the
+// reading and, for murmur3, with itself. With 0 the documents are hashed as they are read.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(internalDbHashWorkerThreads, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 128) {
+            return Status(ErrorCodes::BadValue,
+                          "internalDbHashWorkerThreads must be between 0 and 128");
+        }
+        return Status::OK();
+    });
+
 namespace {
 
+// The documents of a collection are handed to the hashing workers in chunks of about this size.
+const size_t kHashChunkBytes = 1024 * 1024;
+
+/**
+ * Returns the pool shared by all dbHash commands for hashing documents, starting it on first use.
+ * The pool is intentionally leaked so that it is never torn down underneath a dbHash during
+ * shutdown.
+ */
+ThreadPool* getHashWorkerPool() {
+    static ThreadPool* pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "DbHashWorkers";
+        options.threadNamePrefix = "dbHash-";
+        options.minThreads = 0;
+        options.maxThreads = static_cast<size_t>(std::max(1, internalDbHashWorkerThreads));
+        auto newPool = new ThreadPool(options);
+        newPool->startup();
+        return newPool;
+    }();
+    return pool;
+}
+
+enum class HashAlgorithm { kMD5, kMurmur3 };
+
+/**
+ * Computes the hash of one collection from its documents, which are passed to append() in the
+ * order in which they are read.
+ *
+ * The md5 of a collection depends on the order of its documents, so its chunks are hashed one at a
+ * time, each continuing from the previous one, while the next chunk is read. The murmur3 hash of a
+ * collection is the sum of the 128-bit hashes of its documents, which does not depend on their
+ * order, so the chunks, which are consecutive ranges of the collection, are hashed concurrently.
+ */
+class CollectionHasher {
+    MONGO_DISALLOW_COPYING(CollectionHasher);
+
+public:
+    explicit CollectionHasher(HashAlgorithm algorithm)
+        : _algorithm(algorithm), _useWorkers(internalDbHashWorkerThreads > 0) {
+        md5_init(&_md5State);
+    }
+
+    ~CollectionHasher() {
+        // Chunks still being hashed refer to this object.
+        _waitForChunksInFlight(0);
+    }
+
+    void append(const BSONObj& doc) {
+        if (!_useWorkers) {
+            _hashDocuments(doc.objdata(), doc.objsize());
+            return;
+        }
+
+        _chunk.insert(_chunk.end(), doc.objdata(), doc.objdata() + doc.objsize());
+        if (_chunk.size() >= kHashChunkBytes) {
+            _scheduleChunk();
+        }
+    }
+
+    /**
+     * Returns the hash of all of the documents appended.
+     */
+    std::string finish() {
+        _scheduleChunk();
+        _waitForChunksInFlight(0);
+
+        if (_algorithm == HashAlgorithm::kMurmur3) {
+            std::ostringstream ss;
+            ss << std::hex << std::setfill('0') << std::setw(16) << _murmur3Sum[0]
+               << std::setw(16) << _murmur3Sum[1];
+            return ss.str();
+        }
+
+        md5digest d;
+        md5_finish(&_md5State, d);
+        return digestToString(d);
+    }
+
+private:
+    /**
+     * Hashes a run of consecutive BSON documents.
+     */
+    void _hashDocuments(const char* data, size_t len) {
+        if (_algorithm == HashAlgorithm::kMD5) {
+            md5_append(&_md5State, reinterpret_cast<const md5_byte_t*>(data), len);
+            return;
+        }
+
+        uint64_t sum[2] = {0, 0};
+        for (const char* end = data + len; data < end;) {
+            const BSONObj doc(data);
+            uint64_t docHash[2];
+            MurmurHash3_x64_128(doc.objdata(), doc.objsize(), 0, docHash);
+            sum[0] += docHash[0];
+            sum[1] += docHash[1];
+            data += doc.objsize();
+        }
+
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _murmur3Sum[0] += sum[0];
+        _murmur3Sum[1] += sum[1];
+    }
+
+    void _scheduleChunk() {
+        if (_chunk.empty()) {
+            return;
+        }
+
+        // An md5 chunk may only be hashed once the previous one is. The number of murmur3 chunks
+        // in flight is bounded to bound the memory they hold.
+        _waitForChunksInFlight(_algorithm == HashAlgorithm::kMD5
+                                   ? 0
+                                   : 2 * static_cast<size_t>(internalDbHashWorkerThreads) - 1);
+
+        auto chunk = std::make_shared<std::vector<char>>(std::move(_chunk));
+        _chunk = std::vector<char>();
+        _chunk.reserve(kHashChunkBytes);
+
+        auto hashChunk = [this, chunk] {
+            _hashDocuments(chunk->data(), chunk->size());
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            --_chunksInFlight;
+            _chunkDone.notify_one();
+        };
+
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            ++_chunksInFlight;
+        }
+        Status scheduled = getHashWorkerPool()->schedule(hashChunk);
+        if (!scheduled.isOK()) {
+            // The pool is shutting down; fall back to hashing the chunk here.
+            hashChunk();
+        }
+    }
+
+    void _waitForChunksInFlight(size_t maxChunksInFlight) {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        _chunkDone.wait(lk, [&] { return _chunksInFlight <= maxChunksInFlight; });
+    }
+
+    const HashAlgorithm _algorithm;
+    const bool _useWorkers;
+
+    // Documents appended since the last chunk was scheduled.
+    std::vector<char> _chunk;
+
+    // Only ever used by one thread at a time: the md5 chunks are hashed one after the other, and
+    // finish() waits for the last one.
+    md5_state_t _md5State;
+
+    stdx::mutex _mutex;  // protects the members below
+    stdx::condition_variable _chunkDone;
+    size_t _chunksInFlight = 0;
+    uint64_t _murmur3Sum[2] = {0, 0};
+};
+
 class DBHashCmd : public ErrmsgCommandDeprecated {
 public:
     DBHashCmd() : ErrmsgCommandDeprecated("dbHash", "dbhash") {}
@@ -107,6 +281,19 @@ public:
             }
         }
 
+        auto algorithm = HashAlgorithm::kMD5;
+        if (auto algorithmElem = cmdObj["hashAlgorithm"]) {
+            if (algorithmElem.type() != String ||
+                (algorithmElem.valueStringData() != "md5" &&
+                 algorithmElem.valueStringData() != "murmur3")) {
+                errmsg = "hashAlgorithm has to be either \"md5\" or \"murmur3\"";
+                return false;
+            }
+            if (algorithmElem.valueStringData() == "murmur3") {
+                algorithm = HashAlgorithm::kMurmur3;
+            }
+        }
+
         const std::string ns = parseNs(dbname, cmdObj);
         uassert(ErrorCodes::InvalidNamespace,
                 str::stream() << "Invalid db name: " << ns,
@@ -133,6 +320,7 @@ public:
 
         md5_state_t globalState;
         md5_init(&globalState);
+        std::string allCollectionHashes;
 
         // A set of 'system' collections that are replicated, and therefore included in the db hash.
         const std::set<StringData> replicatedSystemCollections{"system.backup_users",
@@ -186,21 +374,33 @@ public:
             }
 
             // Compute the hash for this collection.
-            std::string hash = _hashCollection(opCtx, db, collNss.toString());
+            std::string hash = _hashCollection(opCtx, db, collNss.toString(), algorithm);
 
             bb.append(collNss.coll(), hash);
-            md5_append(&globalState, (const md5_byte_t*)hash.c_str(), hash.size());
+            if (algorithm == HashAlgorithm::kMD5) {
+                md5_append(&globalState, (const md5_byte_t*)hash.c_str(), hash.size());
+            } else {
+                allCollectionHashes += hash;
+            }
         }
         bb.done();
 
         result.append("capped", BSONArray(cappedCollections.done()));
         result.append("uuids", collectionsByUUID.done());
 
-        md5digest d;
-        md5_finish(&globalState, d);
-        std::string hash = digestToString(d);
-
-        result.append("md5", hash);
+        if (algorithm == HashAlgorithm::kMD5) {
+            md5digest d;
+            md5_finish(&globalState, d);
+            result.append("md5", digestToString(d));
+        } else {
+            uint64_t hash[2];
+            MurmurHash3_x64_128(
+                allCollectionHashes.data(), allCollectionHashes.size(), 0, hash);
+            std::ostringstream ss;
+            ss << std::hex << std::setfill('0') << std::setw(16) << hash[0] << std::setw(16)
+               << hash[1];
+            result.append("murmur3", ss.str());
+        }
         result.appendNumber("timeMillis", timer.millis());
 
         return 1;
@@ -209,7 +409,8 @@ public:
 private:
     std::string _hashCollection(OperationContext* opCtx,
                                 Database* db,
-                                const std::string& fullCollectionName) {
+                                const std::string& fullCollectionName,
+                                HashAlgorithm algorithm) {
 
         NamespaceString ns(fullCollectionName);
 
@@ -265,15 +466,14 @@ private:
             return "no _id _index";
         }
 
-        md5_state_t st;
-        md5_init(&st);
+        CollectionHasher hasher(algorithm);
 
         long long n = 0;
         PlanExecutor::ExecState state;
         BSONObj c;
         verify(NULL != exec.get());
         while (PlanExecutor::ADVANCED == (state = exec->getNext(&c, NULL))) {
-            md5_append(&st, (const md5_byte_t*)c.objdata(), c.objsize());
+            hasher.append(c);
             n++;
         }
         if (PlanExecutor::IS_EOF != state) {
@@ -282,11 +482,7 @@ private:
                       "Plan executor error while running dbHash command: " +
                           WorkingSetCommon::toStatusString(c));
         }
-        md5digest d;
-        md5_finish(&st, d);
-        std::string hash = digestToString(d);
-
-        return hash;
+        return hasher.finish();
     }
 
 } dbhashCmd;
@@ -422,7 +422,7 @@ public:
                 // Fill out OpDebug with the number of deleted docs.
                 opDebug->additiveMetrics.ndeleted = getDeleteStats(exec.get())->docsDeleted;
 
-                if (curOp->shouldDBProfile()) {
+                if (curOp->shouldCollectExecStats()) {
                     BSONObjBuilder execStatsBob;
                     Explain::getWinningPlanStats(exec.get(), &execStatsBob);
                     curOp->debug().execStats = execStatsBob.obj();
@@ -518,7 +518,7 @@ public:
                 UpdateStage::recordUpdateStatsInOpDebug(getUpdateStats(exec.get()), opDebug);
                 opDebug->setPlanSummaryMetrics(summaryStats);
 
-                if (curOp->shouldDBProfile()) {
+                if (curOp->shouldCollectExecStats()) {
                     BSONObjBuilder execStatsBob;
                     Explain::getWinningPlanStats(exec.get(), &execStatsBob);
                     curOp->debug().execStats = execStatsBob.obj();
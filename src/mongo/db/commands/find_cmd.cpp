@@ -30,11 +30,13 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/base/counter.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/run_aggregate.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
@@ -44,8 +46,13 @@
 #include "mongo/db/query/find.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/prepared_find.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/query/query_result_cache.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
@@ -58,6 +65,242 @@ namespace {
 
 const auto kTermField = "term"_sd;
 
+Counter64 queryResultCacheHits;
+Counter64 queryResultCacheMisses;
+Counter64 queryResultCacheInsertions;
+
+ServerStatusMetricField<Counter64> queryResultCacheHitsDisplay("query.resultCache.hits",
+                                                               &queryResultCacheHits);
+ServerStatusMetricField<Counter64> queryResultCacheMissesDisplay("query.resultCache.misses",
+                                                                 &queryResultCacheMisses);
+ServerStatusMetricField<Counter64> queryResultCacheInsertionsDisplay(
+    "query.resultCache.insertions", &queryResultCacheInsertions);
+
+/**
+ * Returns the cache which may hold the results of 'cq' on 'collection', and fills in 'key' with the
+ * key of its results. Returns nullptr if the results of the query must not be cached, because
+ * writes to the collection could change them without invalidating the cache: the collection is
+ * capped, the read does not see the latest local writes, or the query runs in a transaction or on
+ * behalf of a router whose routing information could change.
+ */
+QueryResultCache* getQueryResultCache(OperationContext* opCtx,
+                                      Collection* collection,
+                                      const CanonicalQuery& cq,
+                                      std::string* key) {
+    if (!collection || collection->isCapped()) {
+        return nullptr;
+    }
+    QueryResultCache* resultCache = collection->infoCache()->getQueryResultCache();
+    if (!resultCache || cq.getQueryRequest().isTailable()) {
+        return nullptr;
+    }
+
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    const auto level = readConcernArgs.getLevel();
+    if ((level != repl::ReadConcernLevel::kLocalReadConcern &&
+         level != repl::ReadConcernLevel::kAvailableReadConcern) ||
+        readConcernArgs.getArgsAfterClusterTime() || readConcernArgs.getArgsAtClusterTime() ||
+        readConcernArgs.getArgsOpTime()) {
+        return nullptr;
+    }
+
+    const auto txnParticipant = TransactionParticipant::get(opCtx);
+    if ((txnParticipant && txnParticipant->inMultiDocumentTransaction()) ||
+        opCtx->lockState()->inAWriteUnitOfWork() ||
+        OperationShardingState::get(opCtx).hasShardVersion()) {
+        return nullptr;
+    }
+
+    // Secondaries read from a snapshot which may trail the writes they have applied.
+    if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, collection->ns())) {
+        return nullptr;
+    }
+
+    *key = QueryResultCache::computeKey(
+        collection->infoCache()->getPlanCache()->computeKey(cq),
+        cq.getQueryRequest(),
+        level == repl::ReadConcernLevel::kLocalReadConcern ? "local"_sd : "available"_sd);
+    return resultCache;
+}
+
+/**
+ * Replies to the query with the results cached for it, which all fit in the first batch.
+ */
+void replyFromResultCache(OperationContext* opCtx,
+                          const NamespaceString& nss,
+                          const std::vector<BSONObj>& docs,
+                          rpc::ReplyBuilderInterface* result) {
+    {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        CurOp::get(opCtx)->setPlanSummary_inlock("RESULT_CACHE"_sd);
+    }
+    auto& opDebug = CurOp::get(opCtx)->debug();
+    opDebug.nreturned = docs.size();
+    opDebug.cursorid = -1;
+    opDebug.cursorExhausted = true;
+
+    CursorResponseBuilder::Options options;
+    options.isInitialResponse = true;
+    CursorResponseBuilder firstBatch(result, options);
+    for (auto&& doc : docs) {
+        firstBatch.append(doc);
+    }
+    firstBatch.done(0, nss.ns());
+}
+
+/**
+ * Runs the parsed query 'cq' on 'collection', which may be null if it does not exist, once its
+ * locks are held: plans it, generates the first batch and saves the state of the query for getMore
+ * in a ClientCursor, unless its results are cached. 'cmdObj' is the command which runs the query.
+ */
+void runFindOnCollection(OperationContext* opCtx,
+                         Collection* collection,
+                         const NamespaceString& nss,
+                         std::unique_ptr<CanonicalQuery> cq,
+                         const BSONObj& cmdObj,
+                         rpc::ReplyBuilderInterface* result) {
+    // Serve the query from the result cache if it ran before and the collection has not
+    // changed since, skipping planning and execution.
+    std::string resultCacheKey;
+    QueryResultCache* resultCache = getQueryResultCache(opCtx, collection, *cq, &resultCacheKey);
+    unsigned long long resultCacheVersion = 0;
+    if (resultCache) {
+        if (auto cachedDocs = resultCache->get(resultCacheKey)) {
+            queryResultCacheHits.increment();
+            replyFromResultCache(opCtx, nss, *cachedDocs, result);
+            return;
+        }
+        queryResultCacheMisses.increment();
+
+        // The results may only be cached if they are read from a snapshot opened after
+        // the version of the collection, so that any write they miss invalidates them.
+        resultCacheVersion = resultCache->getVersion();
+        opCtx->recoveryUnit()->abandonSnapshot();
+    }
+
+    // Get the execution plan for the query.
+    auto exec = uassertStatusOK(getExecutorFind(opCtx, collection, nss, std::move(cq)));
+
+    {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        CurOp::get(opCtx)->setPlanSummary_inlock(Explain::getPlanSummary(exec.get()));
+    }
+
+    if (!collection) {
+        // No collection. Just fill out curop indicating that there were zero results and
+        // there is no ClientCursor id, and then return.
+        const long long numResults = 0;
+        const CursorId cursorId = 0;
+        endQueryOp(opCtx, collection, *exec, numResults, cursorId);
+        auto bodyBuilder = result->getBodyBuilder();
+        appendCursorResponseObject(cursorId, nss.ns(), BSONArray(), &bodyBuilder);
+        return;
+    }
+
+    CurOpFailpointHelpers::waitWhileFailPointEnabled(
+        &waitInFindBeforeMakingBatch, opCtx, "waitInFindBeforeMakingBatch");
+
+    const QueryRequest& originalQR = exec->getCanonicalQuery()->getQueryRequest();
+
+    // Stream query results, adding them to a BSONArray as we go.
+    CursorResponseBuilder::Options options;
+    options.isInitialResponse = true;
+    CursorResponseBuilder firstBatch(result, options);
+    BSONObj obj;
+    PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
+    std::uint64_t numResults = 0;
+    std::vector<BSONObj> docsToCache;
+    long long bytesToCache = 0;
+    while (!FindCommon::enoughForFirstBatch(originalQR, numResults) &&
+           PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
+        // If we can't fit this result inside the current batch, then we stash it for later.
+        if (!FindCommon::haveSpaceForNext(obj, numResults, firstBatch.bytesUsed())) {
+            exec->enqueue(obj);
+            break;
+        }
+
+        // Add result to output buffer.
+        firstBatch.append(obj);
+        numResults++;
+
+        if (resultCache) {
+            bytesToCache += obj.objsize();
+            if (bytesToCache > internalQueryResultCacheMaxResultBytes.load()) {
+                resultCache = nullptr;
+                docsToCache.clear();
+            } else {
+                docsToCache.push_back(obj.getOwned());
+            }
+        }
+
+        // Size the reply for the whole batch up front rather than growing it by doubling.
+        if (numResults == 1) {
+            firstBatch.reserveBatchBytes(FindCommon::estimateRemainingBatchBytes(
+                obj, originalQR.getEffectiveBatchSize().value_or(QueryRequest::kDefaultBatchSize)));
+        }
+    }
+
+    // Throw an assertion if query execution fails for any reason.
+    if (PlanExecutor::FAILURE == state || PlanExecutor::DEAD == state) {
+        firstBatch.abandon();
+        error() << "Plan executor error during find command: " << PlanExecutor::statestr(state)
+                << ", stats: " << redact(Explain::getWinningPlanStats(exec.get()));
+
+        uassertStatusOK(WorkingSetCommon::getMemberObjectStatus(obj).withContext(
+            "Executor error during find command"));
+    }
+
+    // Before saving the cursor, ensure that whatever plan we established happened with the
+    // expected collection version
+    auto css = CollectionShardingState::get(opCtx, nss);
+    css->checkShardVersionOrThrow(opCtx);
+
+    // Set up the cursor for getMore.
+    CursorId cursorId = 0;
+    if (shouldSaveCursor(opCtx, collection, state, exec.get())) {
+        // Create a ClientCursor containing this plan executor and register it with the
+        // cursor manager.
+        ClientCursorPin pinnedCursor = collection->getCursorManager()->registerCursor(
+            opCtx,
+            {std::move(exec),
+             nss,
+             AuthorizationSession::get(opCtx->getClient())->getAuthenticatedUserNames(),
+             repl::ReadConcernArgs::get(opCtx).getLevel(),
+             cmdObj});
+        cursorId = pinnedCursor.getCursor()->cursorid();
+
+        invariant(!exec);
+        PlanExecutor* cursorExec = pinnedCursor.getCursor()->getExecutor();
+
+        // State will be restored on getMore.
+        cursorExec->saveState();
+        cursorExec->detachFromOperationContext();
+
+        // We assume that cursors created through a DBDirectClient are always used from
+        // their original OperationContext, so we do not need to move time to and from the
+        // cursor.
+        if (!opCtx->getClient()->isInDirectClient()) {
+            pinnedCursor.getCursor()->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
+        }
+        pinnedCursor.getCursor()->setNReturnedSoFar(numResults);
+        pinnedCursor.getCursor()->incNBatches();
+
+        // Fill out curop based on the results.
+        endQueryOp(opCtx, collection, *cursorExec, numResults, cursorId);
+    } else {
+        endQueryOp(opCtx, collection, *exec, numResults, cursorId);
+
+        // The first batch holds the complete results, which can be cached.
+        if (resultCache &&
+            resultCache->add(resultCacheKey, std::move(docsToCache), resultCacheVersion)) {
+            queryResultCacheInsertions.increment();
+        }
+    }
+
+    // Generate the response object to send to the client.
+    firstBatch.done(cursorId, nss.ns());
+}
+
 /**
  * A command for running .find() queries.
  */
@@ -198,12 +441,22 @@ public:
             // execution tree with an EOFStage.
             Collection* const collection = ctx->getCollection();
 
+            // Report whether running the query would return cached results.
+            std::string resultCacheKey;
+            boost::optional<bool> resultCacheHit;
+            if (auto resultCache = getQueryResultCache(opCtx, collection, *cq, &resultCacheKey)) {
+                resultCacheHit = static_cast<bool>(resultCache->get(resultCacheKey));
+            }
+
             // We have a parsed query. Time to get the execution plan for it.
             auto exec = uassertStatusOK(getExecutorFind(opCtx, collection, nss, std::move(cq)));
 
             auto bodyBuilder = result->getBodyBuilder();
             // Got the execution tree. Explain it.
             Explain::explainStages(exec.get(), collection, verbosity, &bodyBuilder);
+            if (resultCacheHit) {
+                bodyBuilder.append("resultCacheHit", *resultCacheHit);
+            }
         }
 
         /**
@@ -233,6 +486,16 @@ public:
                     "It is illegal to open a tailable cursor in a transaction",
                     !txnParticipant ||
                         !(txnParticipant->inMultiDocumentTransaction() && qr->isTailable()));
+            uassert(ErrorCodes::InvalidOptions,
+                    "It is illegal to use the readOnce option in a transaction",
+                    !txnParticipant ||
+                        !(txnParticipant->inMultiDocumentTransaction() && qr->isReadOnce()));
+
+            // Ask the storage engine to evict the data this query reads ahead of other data, so
+            // that a large scan does not push the working set out of the cache.
+            if (qr->isReadOnce()) {
+                opCtx->recoveryUnit()->setReadOnce(true);
+            }
 
             // Validate term before acquiring locks, if provided.
             if (auto term = qr->getReplicationTerm()) {
@@ -294,115 +557,225 @@ public:
                 return;
             }
 
-            Collection* const collection = ctx->getCollection();
+            runFindOnCollection(
+                opCtx, ctx->getCollection(), nss, std::move(cq), _request.body, result);
+        }
 
-            // Get the execution plan for the query.
-            auto exec = uassertStatusOK(getExecutorFind(opCtx, collection, nss, std::move(cq)));
+    private:
+        const OpMsgRequest& _request;
+        const StringData _dbName;
+    };
 
-            {
-                stdx::lock_guard<Client> lk(*opCtx->getClient());
-                CurOp::get(opCtx)->setPlanSummary_inlock(Explain::getPlanSummary(exec.get()));
-            }
+} findCmd;
 
-            if (!collection) {
-                // No collection. Just fill out curop indicating that there were zero results and
-                // there is no ClientCursor id, and then return.
-                const long long numResults = 0;
-                const CursorId cursorId = 0;
-                endQueryOp(opCtx, collection, *exec, numResults, cursorId);
-                auto bodyBuilder = result->getBodyBuilder();
-                appendCursorResponseObject(cursorId, nss.ns(), BSONArray(), &bodyBuilder);
-                return;
-            }
+/**
+ * A command which parses a find with placeholders in its filter once, for executePrepared to run
+ * with values for them. It takes the options of find, as in
+ * {prepareFind: <collection>, filter: {a: {$param: "a"}}, sort: {b: 1}}, and replies with the id of
+ * the prepared find and the names of its parameters.
+ */
+class PrepareFindCmd final : public BasicCommand {
+public:
+    PrepareFindCmd() : BasicCommand("prepareFind") {}
 
-            CurOpFailpointHelpers::waitWhileFailPointEnabled(
-                &waitInFindBeforeMakingBatch, opCtx, "waitInFindBeforeMakingBatch");
-
-            const QueryRequest& originalQR = exec->getCanonicalQuery()->getQueryRequest();
-
-            // Stream query results, adding them to a BSONArray as we go.
-            CursorResponseBuilder::Options options;
-            options.isInitialResponse = true;
-            CursorResponseBuilder firstBatch(result, options);
-            BSONObj obj;
-            PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
-            std::uint64_t numResults = 0;
-            while (!FindCommon::enoughForFirstBatch(originalQR, numResults) &&
-                   PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
-                // If we can't fit this result inside the current batch, then we stash it for later.
-                if (!FindCommon::haveSpaceForNext(obj, numResults, firstBatch.bytesUsed())) {
-                    exec->enqueue(obj);
-                    break;
-                }
+    AllowedOnSecondary secondaryAllowed(ServiceContext* context) const override {
+        return AllowedOnSecondary::kOptIn;
+    }
 
-                // Add result to output buffer.
-                firstBatch.append(obj);
-                numResults++;
-            }
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    std::string help() const override {
+        return "prepare a query with parameters for executePrepared";
+    }
+
+    std::string parseNs(const std::string& dbname, const BSONObj& cmdObj) const override {
+        return CommandHelpers::parseNsCollectionRequired(dbname, cmdObj).ns();
+    }
 
-            // Throw an assertion if query execution fails for any reason.
-            if (PlanExecutor::FAILURE == state || PlanExecutor::DEAD == state) {
-                firstBatch.abandon();
-                error() << "Plan executor error during find command: "
-                        << PlanExecutor::statestr(state)
-                        << ", stats: " << redact(Explain::getWinningPlanStats(exec.get()));
+    Status checkAuthForOperation(OperationContext* opCtx,
+                                 const std::string& dbname,
+                                 const BSONObj& cmdObj) const override {
+        return AuthorizationSession::get(opCtx->getClient())
+            ->checkAuthForFind(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj), false);
+    }
 
-                uassertStatusOK(WorkingSetCommon::getMemberObjectStatus(obj).withContext(
-                    "Executor error during find command"));
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const auto nss = CommandHelpers::parseNsCollectionRequired(dbname, cmdObj);
+
+        // The options are those of find.
+        BSONObjBuilder findBuilder;
+        findBuilder.append(QueryRequest::kFindCommandName, nss.coll());
+        for (auto&& elem : cmdObj) {
+            if (elem.fieldNameStringData() != getName()) {
+                findBuilder.append(elem);
             }
+        }
+        const bool isExplain = false;
+        auto qr = uassertStatusOK(
+            QueryRequest::makeFromFindCommand(nss, findBuilder.obj(), isExplain));
+        uassert(ErrorCodes::InvalidOptions,
+                "It is illegal to prepare a tailable find",
+                !qr->isTailable());
+
+        AutoGetCollectionForReadCommand ctx(
+            opCtx, nss, AutoGetCollection::ViewMode::kViewsPermitted);
+        uassert(ErrorCodes::CommandNotSupportedOnView,
+                "Namespace " + nss.ns() + " is a view, which prepared finds do not support",
+                !ctx.getView());
+
+        const ExtensionsCallbackReal extensionsCallback(opCtx, &nss);
+        std::shared_ptr<const PreparedFind> prepared =
+            uassertStatusOK(PreparedFind::prepare(opCtx,
+                                                  std::move(qr),
+                                                  extensionsCallback,
+                                                  MatchExpressionParser::kAllowAllSpecialFeatures));
+        const auto parameterNames = prepared->getParameterNames();
+
+        auto& catalog = PreparedFindCatalog::get(opCtx->getServiceContext());
+        result.append("statementId", catalog.add(std::move(prepared)));
+        result.append("parameters", parameterNames);
+        return true;
+    }
+} prepareFindCmd;
 
-            // Before saving the cursor, ensure that whatever plan we established happened with the
-            // expected collection version
-            auto css = CollectionShardingState::get(opCtx, nss);
-            css->checkShardVersionOrThrow(opCtx);
-
-            // Set up the cursor for getMore.
-            CursorId cursorId = 0;
-            if (shouldSaveCursor(opCtx, collection, state, exec.get())) {
-                // Create a ClientCursor containing this plan executor and register it with the
-                // cursor manager.
-                ClientCursorPin pinnedCursor = collection->getCursorManager()->registerCursor(
-                    opCtx,
-                    {std::move(exec),
-                     nss,
-                     AuthorizationSession::get(opCtx->getClient())->getAuthenticatedUserNames(),
-                     repl::ReadConcernArgs::get(opCtx).getLevel(),
-                     _request.body});
-                cursorId = pinnedCursor.getCursor()->cursorid();
-
-                invariant(!exec);
-                PlanExecutor* cursorExec = pinnedCursor.getCursor()->getExecutor();
-
-                // State will be restored on getMore.
-                cursorExec->saveState();
-                cursorExec->detachFromOperationContext();
-
-                // We assume that cursors created through a DBDirectClient are always used from
-                // their original OperationContext, so we do not need to move time to and from the
-                // cursor.
-                if (!opCtx->getClient()->isInDirectClient()) {
-                    pinnedCursor.getCursor()->setLeftoverMaxTimeMicros(
-                        opCtx->getRemainingMaxTimeMicros());
-                }
-                pinnedCursor.getCursor()->setNReturnedSoFar(numResults);
-                pinnedCursor.getCursor()->incNBatches();
+/**
+ * A command which runs a find prepared by prepareFind with values for its parameters, as in
+ * {executePrepared: <statementId>, parameters: {a: 5}}. It replies as find does, without parsing
+ * or normalizing the filter again.
+ */
+class ExecutePreparedCmd final : public Command {
+public:
+    ExecutePreparedCmd() : Command("executePrepared") {}
 
-                // Fill out curop based on the results.
-                endQueryOp(opCtx, collection, *cursorExec, numResults, cursorId);
-            } else {
-                endQueryOp(opCtx, collection, *exec, numResults, cursorId);
+    std::unique_ptr<CommandInvocation> parse(OperationContext* opCtx,
+                                             const OpMsgRequest& opMsgRequest) override {
+        return std::make_unique<Invocation>(this, opCtx, opMsgRequest);
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext* context) const override {
+        return AllowedOnSecondary::kOptIn;
+    }
+
+    bool maintenanceOk() const override {
+        return false;
+    }
+
+    bool adminOnly() const override {
+        return false;
+    }
+
+    std::string help() const override {
+        return "run a query prepared by prepareFind";
+    }
+
+    LogicalOp getLogicalOp() const override {
+        return LogicalOp::opQuery;
+    }
+
+    ReadWriteType getReadWriteType() const override {
+        return ReadWriteType::kRead;
+    }
+
+    std::size_t reserveBytesForReply() const override {
+        return FindCommon::kInitReplyBufferSize;
+    }
+
+    /**
+     * Like find, executePrepared increments the query counter rather than the command counter.
+     */
+    bool shouldAffectCommandCounter() const override {
+        return false;
+    }
+
+    class Invocation final : public CommandInvocation {
+    public:
+        Invocation(const ExecutePreparedCmd* definition,
+                   OperationContext* opCtx,
+                   const OpMsgRequest& request)
+            : CommandInvocation(definition), _request(request) {
+            const auto idElem = _request.body.firstElement();
+            uassert(ErrorCodes::TypeMismatch,
+                    str::stream() << "executePrepared must name a statement with its id, not "
+                                  << idElem,
+                    idElem.isNumber());
+
+            const auto paramsElem = _request.body["parameters"];
+            uassert(ErrorCodes::TypeMismatch,
+                    "parameters must be an object",
+                    paramsElem.eoo() || paramsElem.type() == BSONType::Object);
+            if (paramsElem) {
+                _params = paramsElem.Obj();
             }
 
-            // Generate the response object to send to the client.
-            firstBatch.done(cursorId, nss.ns());
+            _prepared = PreparedFindCatalog::get(opCtx->getServiceContext())
+                            .lookup(idElem.numberLong());
+            uassert(ErrorCodes::NoSuchKey,
+                    str::stream() << "no prepared find with the id " << idElem,
+                    _prepared);
+            uassert(ErrorCodes::InvalidNamespace,
+                    str::stream() << "the prepared find with the id " << idElem
+                                  << " is not on database "
+                                  << _request.getDatabase(),
+                    _prepared->nss().db() == _request.getDatabase());
         }
 
     private:
+        bool supportsWriteConcern() const override {
+            return false;
+        }
+
+        bool supportsReadConcern(repl::ReadConcernLevel level) const final {
+            return true;
+        }
+
+        NamespaceString ns() const override {
+            return _prepared->nss();
+        }
+
+        void doCheckAuthorization(OperationContext* opCtx) const final {
+            uassertStatusOK(AuthorizationSession::get(opCtx->getClient())
+                                ->checkAuthForFind(_prepared->nss(), false));
+        }
+
+        void run(OperationContext* opCtx, rpc::ReplyBuilderInterface* result) {
+            globalOpCounters.gotQuery();
+
+            auto cq = uassertStatusOK(_prepared->bind(opCtx, _params));
+            const auto txnParticipant = TransactionParticipant::get(opCtx);
+            uassert(ErrorCodes::InvalidOptions,
+                    "It is illegal to open a tailable cursor in a transaction",
+                    !txnParticipant || !(txnParticipant->inMultiDocumentTransaction() &&
+                                         cq->getQueryRequest().isTailable()));
+
+            AutoGetCollectionForReadCommand ctx(
+                opCtx, _prepared->nss(), AutoGetCollection::ViewMode::kViewsPermitted);
+            const auto& nss = ctx.getNss();
+            uassert(ErrorCodes::CommandNotSupportedOnView,
+                    "Namespace " + nss.ns() + " is a view, which prepared finds do not support",
+                    !ctx.getView());
+
+            uassertStatusOK(repl::ReplicationCoordinator::get(opCtx)->checkCanServeReadsFor(
+                opCtx, nss, ReadPreferenceSetting::get(opCtx).canRunOnSecondary()));
+
+            const int ntoreturn = -1;
+            const int ntoskip = -1;
+            beginQueryOp(opCtx, nss, _request.body, ntoreturn, ntoskip);
+
+            runFindOnCollection(
+                opCtx, ctx.getCollection(), nss, std::move(cq), _request.body, result);
+        }
+
         const OpMsgRequest& _request;
-        const StringData _dbName;
+        BSONObj _params;
+        std::shared_ptr<const PreparedFind> _prepared;
     };
 
-} findCmd;
+} executePreparedCmd;
 
 }  // namespace
 }  // namespace mongo
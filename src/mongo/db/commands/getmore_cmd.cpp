@@ -44,6 +44,7 @@
 #include "mongo/db/cursor_manager.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/find.h"
 #include "mongo/db/query/find_common.h"
@@ -209,6 +210,13 @@ public:
                     nextBatch->setLatestOplogTimestamp(exec->getLatestOplogTimestamp());
                     nextBatch->append(obj);
                     (*numResults)++;
+
+                    // Size the reply for the whole batch up front rather than growing it by
+                    // doubling.
+                    if (*numResults == 1) {
+                        nextBatch->reserveBatchBytes(FindCommon::estimateRemainingBatchBytes(
+                            obj, request.batchSize.value_or(0)));
+                    }
                 }
             } catch (const ExceptionFor<ErrorCodes::CloseChangeStream>&) {
                 // FAILURE state will make getMore command close the cursor even if it's tailable.
@@ -408,6 +416,14 @@ public:
             }
 
             PlanExecutor* exec = cursor->getExecutor();
+
+            // A find with 'readOnce' keeps giving the data it reads a low cache priority throughout
+            // the lifetime of its cursor.
+            if (exec->getCanonicalQuery() &&
+                exec->getCanonicalQuery()->getQueryRequest().isReadOnce()) {
+                opCtx->recoveryUnit()->setReadOnce(true);
+            }
+
             exec->reattachToOperationContext(opCtx);
             uassertStatusOK(exec->restoreState());
 
@@ -481,7 +497,7 @@ public:
             // whether
             // we need execStats and we do not want to generate for all operations due to cost.
             if (!CursorManager::isGloballyManagedCursor(_request.cursorid) &&
-                curOp->shouldDBProfile()) {
+                curOp->shouldCollectExecStats()) {
                 BSONObjBuilder execStatsBob;
                 Explain::getWinningPlanStats(exec, &execStatsBob);
                 curOp->debug().execStats = execStatsBob.obj();
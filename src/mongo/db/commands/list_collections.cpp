@@ -144,6 +144,9 @@ BSONObj buildViewBson(const ViewDefinition& view, bool nameOnly) {
     BSONObjBuilder optionsBuilder(b.subobjStart("options"));
     optionsBuilder.append("viewOn", view.viewOn().coll());
     optionsBuilder.append("pipeline", view.pipeline());
+    if (view.isMaterialized()) {
+        optionsBuilder.append("materialized", true);
+    }
     if (view.defaultCollator()) {
         optionsBuilder.append("collation", view.defaultCollator()->getSpec().toBSON());
     }
@@ -279,7 +282,7 @@ public:
         std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec;
         BSONArrayBuilder firstBatch;
         {
-            AutoGetDb autoDb(opCtx, dbname, MODE_IS);
+            AutoGetDbForRead autoDb(opCtx, dbname);
             Database* db = autoDb.getDb();
 
             auto ws = make_unique<WorkingSet>();
@@ -63,6 +63,7 @@
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/client/parallel.h"
@@ -72,7 +73,9 @@
 #include "mongo/s/shard_key_pattern.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/scripting/engine.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
@@ -93,6 +96,22 @@ namespace dps = ::mongo::dotted_path_support;
 namespace mr {
 namespace {
 
+// When true, mapReduce keeps the JavaScript scope of a finished operation on its thread, with the
+// functions it compiled, so that the next mapReduce on that thread for the same database and users
+// does not have to set up a new one.
+MONGO_EXPORT_SERVER_PARAMETER(mapReduceReuseScopes, bool, true);
+
+// Number of threads running the map function, over chunks of the documents read by mapReduce
+// commands that do not run in jsMode. With 0 every command maps the documents it reads itself.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(internalMapReduceMapWorkerThreads, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 128) {
+            return Status(ErrorCodes::BadValue,
+                          "internalMapReduceMapWorkerThreads must be between 0 and 128");
+        }
+        return Status::OK();
+    });
+
 /**
  * Runs a count against the namespace specified by 'ns'. If the caller holds the global write lock,
  * then this function does not acquire any additional locks.
@@ -120,25 +139,33 @@ unsigned long long collectionCount(OperationContext* opCtx,
 }
 
 /**
- * Emit that will be called by a js function.
+ * Validates the arguments of an emit() call and turns them into the {"0": key, "1": value} tuple
+ * to stage.
  */
-BSONObj fastEmit(const BSONObj& args, void* data) {
+BSONObj emitArgsToTuple(const BSONObj& args) {
     uassert(10077, "emit takes 2 args", args.nFields() == 2);
     uassert(13069,
             "an emit can't be more than half max bson size",
             args.objsize() < (BSONObjMaxUserSize / 2));
 
-    State* state = (State*)data;
-    if (args.firstElement().type() == Undefined) {
-        BSONObjBuilder b(args.objsize());
-        b.appendNull("");
-        BSONObjIterator i(args);
-        i.next();
-        b.append(i.next());
-        state->emit(b.obj());
-    } else {
-        state->emit(args);
+    if (args.firstElement().type() != Undefined) {
+        return args;
     }
+
+    BSONObjBuilder b(args.objsize());
+    b.appendNull("");
+    BSONObjIterator i(args);
+    i.next();
+    b.append(i.next());
+    return b.obj();
+}
+
+/**
+ * Emit that will be called by a js function.
+ */
+BSONObj fastEmit(const BSONObj& args, void* data) {
+    State* state = (State*)data;
+    state->emit(emitArgsToTuple(args));
     return BSONObj();
 }
 
@@ -174,7 +201,11 @@ JSFunction::JSFunction(const std::string& type, const BSONElement& e) {
 }
 
 void JSFunction::init(State* state) {
-    _scope = state->scope();
+    init(state->scope());
+}
+
+void JSFunction::init(Scope* scope) {
+    _scope = scope;
     verify(_scope);
     _scope->init(&_wantedScope);
 
@@ -190,6 +221,11 @@ void JSMapper::init(State* state) {
     _params = state->config().mapParams;
 }
 
+void JSMapper::init(Scope* scope, const BSONObj& params) {
+    _func.init(scope);
+    _params = params;
+}
+
 /**
  * Applies the map function to an object, which should internally call emit()
  */
@@ -222,6 +258,10 @@ void JSReducer::init(State* state) {
     _func.init(state);
 }
 
+void JSReducer::init(Scope* scope) {
+    _func.init(scope);
+}
+
 /**
  * Reduces a list of tuple objects (key, value) to a single tuple {"0": key, "1": value}
  */
@@ -895,11 +935,16 @@ void State::init() {
     // setup js
     const string userToken =
         AuthorizationSession::get(Client::getCurrent())->getAuthenticatedUserNamesToken();
-    _scope.reset(getGlobalScriptEngine()->newScopeForCurrentThread());
+    if (mapReduceReuseScopes.load()) {
+        _scope = getGlobalScriptEngine()->getPooledScopeForCurrentThread(
+            _opCtx, _config.dbname, "mapreduce" + userToken);
+    } else {
+        _scope.reset(getGlobalScriptEngine()->newScopeForCurrentThread());
+        _scope->registerOperation(_opCtx);
+        _scope->setLocalDB(_config.dbname);
+        _scope->loadStored(_opCtx, true);
+    }
     _scope->requireOwnedObjects();
-    _scope->registerOperation(_opCtx);
-    _scope->setLocalDB(_config.dbname);
-    _scope->loadStored(_opCtx, true);
 
     if (!_config.scopeSetup.isEmpty())
         _scope->init(&_config.scopeSetup);
@@ -1289,6 +1334,14 @@ void State::emit(const BSONObj& a) {
     _size += _add(_temp.get(), a);
 }
 
+void State::addEmitted(const BSONList& tuples, long long numEmits, long long numReduces) {
+    for (const auto& tuple : tuples) {
+        _size += _add(_temp.get(), tuple);
+    }
+    _numEmits += numEmits;
+    _config.reducer->numReduces += numReduces;
+}
+
 int State::_add(InMemory* im, const BSONObj& a) {
     BSONList& all = (*im)[a];
     all.push_back(a);
@@ -1343,6 +1396,281 @@ void State::reduceAndSpillInMemoryStateIfNeeded() {
     }
 }
 
+namespace {
+
+// A chunk of the documents read by mapReduce is handed to a map worker once it holds this many
+// documents or bytes.
+const size_t kMapChunkDocs = 1000;
+const size_t kMapChunkBytes = 1024 * 1024;
+
+/**
+ * Returns the pool shared by all mapReduce commands for running their map functions, starting it
+ * on first use. The pool is intentionally leaked so that it is never torn down underneath a
+ * mapReduce during shutdown.
+ */
+ThreadPool* getMapWorkerPool() {
+    static ThreadPool* pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "MapReduceMapWorkers";
+        options.threadNamePrefix = "mrMap-";
+        options.minThreads = 0;
+        options.maxThreads = static_cast<size_t>(std::max(1, internalMapReduceMapWorkerThreads));
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName);
+        };
+        auto newPool = new ThreadPool(options);
+        newPool->startup();
+        return newPool;
+    }();
+    return pool;
+}
+
+/**
+ * The tuples emitted while mapping one chunk of documents, grouped by key.
+ */
+struct MappedChunk {
+    InMemory tuples;
+    long long numEmits = 0;
+    long long numReduces = 0;
+};
+
+/**
+ * Emit called by a map function running on a map worker.
+ */
+BSONObj chunkEmit(const BSONObj& args, void* data) {
+    auto chunk = static_cast<MappedChunk*>(data);
+    BSONObj tuple = emitArgsToTuple(args);
+    chunk->tuples[tuple].push_back(tuple);
+    ++chunk->numEmits;
+    return BSONObj();
+}
+
+/**
+ * Runs the map function of a mapReduce over the documents that the command reads, on the threads
+ * of the map worker pool.
+ *
+ * The documents are handed to the workers in chunks, which are consecutive ranges of the
+ * command's cursor. A worker maps a chunk in a scope of its own and reduces the values that the
+ * chunk emitted for each key; the command's thread then merges the result into its State, where
+ * the usual in-memory reduce and spill take over. The documents are still read by the command's
+ * thread, since its locks and snapshot belong to the operation.
+ */
+class ParallelMapper {
+    MONGO_DISALLOW_COPYING(ParallelMapper);
+
+public:
+    ParallelMapper(OperationContext* opCtx, const BSONObj& cmd, const Config& config)
+        : _opCtx(opCtx),
+          _cmd(cmd),
+          _config(config),
+          _userToken(AuthorizationSession::get(opCtx->getClient())
+                         ->getAuthenticatedUserNamesToken()),
+          _maxChunksInFlight(2 * static_cast<size_t>(internalMapReduceMapWorkerThreads)) {}
+
+    ~ParallelMapper() {
+        // Chunks still being mapped refer to this object.
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        _interruptWorkers_inlock();
+        _chunkDone.wait(lk, [&] { return _chunksInFlight == 0; });
+    }
+
+    /**
+     * Adds a document to the chunk being filled.
+     */
+    void map(const BSONObj& doc) {
+        _chunkBytes += doc.objsize();
+        _chunk.push_back(doc);
+    }
+
+    /**
+     * Returns true once the chunk being filled should be handed to a worker.
+     */
+    bool chunkFull() const {
+        return _chunk.size() >= kMapChunkDocs || _chunkBytes >= kMapChunkBytes;
+    }
+
+    /**
+     * Hands the chunk being filled to a worker if it is full, and merges the chunks mapped so far
+     * into 'state'. Must be called without holding any locks, since it may wait for a worker.
+     */
+    void scheduleAndMerge(State* state) {
+        if (chunkFull()) {
+            _waitForChunksInFlight(_maxChunksInFlight - 1);
+            _scheduleChunk();
+        }
+        _mergeMapped(state);
+    }
+
+    /**
+     * Maps the remaining documents and merges all of the mapped chunks into 'state'. Must be
+     * called without holding any locks.
+     */
+    void finish(State* state) {
+        _waitForChunksInFlight(_maxChunksInFlight - 1);
+        _scheduleChunk();
+        _waitForChunksInFlight(0);
+        _mergeMapped(state);
+    }
+
+    /**
+     * Returns the time the workers spent mapping, summed over all of them.
+     */
+    long long mapMicros() {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        return _mapMicros;
+    }
+
+private:
+    void _scheduleChunk() {
+        if (_chunk.empty()) {
+            return;
+        }
+
+        auto docs = std::make_shared<std::vector<BSONObj>>(std::move(_chunk));
+        _chunk = std::vector<BSONObj>();
+        _chunkBytes = 0;
+
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            ++_chunksInFlight;
+        }
+        Status scheduled = getMapWorkerPool()->schedule([this, docs] { _mapChunk(*docs); });
+        if (!scheduled.isOK()) {
+            // The pool is shutting down. The chunk cannot be mapped on this thread instead, since
+            // it already hosts the scope of the command.
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            --_chunksInFlight;
+            uassertStatusOK(scheduled);
+        }
+    }
+
+    /**
+     * Runs on a worker.
+     */
+    void _mapChunk(const std::vector<BSONObj>& docs) {
+        auto chunk = stdx::make_unique<MappedChunk>();
+        Status status = Status::OK();
+        long long micros = 0;
+        try {
+            auto workerOpCtx = cc().makeOperationContext();
+            {
+                stdx::lock_guard<stdx::mutex> lk(_mutex);
+                uassert(ErrorCodes::Interrupted, "mapReduce was interrupted", !_interrupted);
+                _workerOpCtxs.insert(workerOpCtx.get());
+            }
+            ON_BLOCK_EXIT([&] {
+                stdx::lock_guard<stdx::mutex> lk(_mutex);
+                _workerOpCtxs.erase(workerOpCtx.get());
+            });
+
+            Timer t;
+            _mapDocuments(workerOpCtx.get(), docs, chunk.get());
+            micros = t.micros();
+        } catch (const DBException& ex) {
+            status = ex.toStatus();
+        }
+
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        if (!status.isOK()) {
+            if (_status.isOK()) {
+                _status = status;
+            }
+            _interruptWorkers_inlock();
+        } else {
+            _mapped.push_back(std::move(chunk));
+        }
+        _mapMicros += micros;
+        --_chunksInFlight;
+        _chunkDone.notify_all();
+    }
+
+    void _mapDocuments(OperationContext* opCtx,
+                       const std::vector<BSONObj>& docs,
+                       MappedChunk* chunk) {
+        auto scope = getGlobalScriptEngine()->getPooledScopeForCurrentThread(
+            opCtx, _config.dbname, "mapreduce" + _userToken);
+        scope->requireOwnedObjects();
+        if (!_config.scopeSetup.isEmpty())
+            scope->init(&_config.scopeSetup);
+
+        JSMapper mapper(_cmd["map"]);
+        mapper.init(scope.get(), _config.mapParams);
+        scope->injectNative("emit", chunkEmit, chunk);
+        for (const auto& doc : docs) {
+            mapper.map(doc);
+        }
+
+        // Reduce while still on the worker, so that the command's thread only merges one tuple
+        // per key of the chunk.
+        JSReducer reducer(_cmd["reduce"]);
+        reducer.init(scope.get());
+        for (auto& keyAndValues : chunk->tuples) {
+            BSONList& values = keyAndValues.second;
+            if (values.size() > 1) {
+                BSONObj reduced = reducer.reduce(values);
+                values.clear();
+                values.push_back(reduced);
+            }
+        }
+        chunk->numReduces = reducer.numReduces;
+    }
+
+    void _mergeMapped(State* state) {
+        std::vector<std::unique_ptr<MappedChunk>> mapped;
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            uassertStatusOK(_status);
+            mapped.swap(_mapped);
+        }
+
+        for (const auto& chunk : mapped) {
+            BSONList tuples;
+            for (const auto& keyAndValues : chunk->tuples) {
+                tuples.insert(tuples.end(), keyAndValues.second.begin(), keyAndValues.second.end());
+            }
+            state->addEmitted(tuples, chunk->numEmits, chunk->numReduces);
+        }
+    }
+
+    void _waitForChunksInFlight(size_t maxChunksInFlight) {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        _opCtx->waitForConditionOrInterrupt(
+            _chunkDone, lk, [&] { return _chunksInFlight <= maxChunksInFlight; });
+    }
+
+    /**
+     * Kills the operations of the workers mapping chunks, and keeps new chunks from being mapped.
+     */
+    void _interruptWorkers_inlock() {
+        _interrupted = true;
+        for (auto workerOpCtx : _workerOpCtxs) {
+            stdx::lock_guard<Client> clientLock(*workerOpCtx->getClient());
+            workerOpCtx->getServiceContext()->killOperation(workerOpCtx, ErrorCodes::Interrupted);
+        }
+    }
+
+    OperationContext* const _opCtx;
+    const BSONObj& _cmd;
+    const Config& _config;
+    const std::string _userToken;
+    const size_t _maxChunksInFlight;
+
+    // Documents read since the last chunk was scheduled.
+    std::vector<BSONObj> _chunk;
+    size_t _chunkBytes = 0;
+
+    stdx::mutex _mutex;  // protects the members below
+    stdx::condition_variable _chunkDone;
+    size_t _chunksInFlight = 0;
+    std::vector<std::unique_ptr<MappedChunk>> _mapped;
+    std::set<OperationContext*> _workerOpCtxs;
+    bool _interrupted = false;
+    Status _status = Status::OK();
+    long long _mapMicros = 0;
+};
+
+}  // namespace
+
 /**
  * This class represents a map/reduce command executed on a single server
  */
@@ -1454,6 +1782,12 @@ public:
             long long reduceTime = 0;
             long long numInputs = 0;
 
+            // In jsMode the emitted values have to stay in the command's scope.
+            boost::optional<ParallelMapper> parallelMapper;
+            if (internalMapReduceMapWorkerThreads > 0 && !state.jsMode()) {
+                parallelMapper.emplace(opCtx, cmd, config);
+            }
+
             {
                 // We've got a cursor preventing migrations off, now re-establish our useful cursor
 
@@ -1527,18 +1861,22 @@ public:
                     }
 
                     // do map
-                    if (config.verbose)
-                        mt.reset();
-                    config.mapper->map(o);
-                    if (config.verbose)
-                        mapTime += mt.micros();
+                    if (parallelMapper) {
+                        parallelMapper->map(o);
+                    } else {
+                        if (config.verbose)
+                            mt.reset();
+                        config.mapper->map(o);
+                        if (config.verbose)
+                            mapTime += mt.micros();
+                    }
 
                     // Check if the state accumulated so far needs to be written to a
                     // collection. This may yield the DB lock temporarily and then
                     // acquire it again.
                     //
                     numInputs++;
-                    if (numInputs % 100 == 0) {
+                    if (numInputs % 100 == 0 || (parallelMapper && parallelMapper->chunkFull())) {
                         Timer t;
 
                         // TODO: As an optimization, we might want to do the save/restore
@@ -1548,6 +1886,8 @@ public:
 
                         scopedAutoColl.reset();
 
+                        if (parallelMapper)
+                            parallelMapper->scheduleAndMerge(&state);
                         state.reduceAndSpillInMemoryStateIfNeeded();
                         scopedAutoColl.emplace(opCtx, config.nss, MODE_S);
 
@@ -1581,12 +1921,17 @@ public:
                 scopedAutoColl->getCollection()->infoCache()->notifyOfQuery(opCtx,
                                                                             stats.indexesUsed);
 
-                if (curOp->shouldDBProfile()) {
+                if (curOp->shouldCollectExecStats()) {
                     BSONObjBuilder execStatsBob;
                     Explain::getWinningPlanStats(exec.get(), &execStatsBob);
                     curOp->debug().execStats = execStatsBob.obj();
                 }
             }
+            if (parallelMapper) {
+                parallelMapper->finish(&state);
+                mapTime += parallelMapper->mapMicros();
+                parallelMapper.reset();
+            }
             pm.finished();
 
             opCtx->checkForInterrupt();
@@ -113,6 +113,11 @@ public:
 
     virtual void init(State* state);
 
+    /**
+     * Compiles the function in 'scope' instead of the scope of a State.
+     */
+    void init(Scope* scope);
+
     Scope* scope() const {
         return _scope;
     }
@@ -135,6 +140,11 @@ public:
     virtual void map(const BSONObj& o);
     virtual void init(State* state);
 
+    /**
+     * Prepares to map documents in 'scope', passing 'params' to the map function.
+     */
+    void init(Scope* scope, const BSONObj& params);
+
 private:
     JSFunction _func;
     BSONObj _params;
@@ -145,6 +155,11 @@ public:
     JSReducer(const BSONElement& code) : _func("_reduce", code) {}
     virtual void init(State* state);
 
+    /**
+     * Prepares to reduce values in 'scope'.
+     */
+    void init(Scope* scope);
+
     virtual BSONObj reduce(const BSONList& tuples);
     virtual BSONObj finalReduce(const BSONList& tuples, Finalizer* finalizer);
 
@@ -275,6 +290,12 @@ public:
      */
     void emit(const BSONObj& a);
 
+    /**
+     * Stages tuples that were emitted, and possibly reduced, outside of this State's scope,
+     * accounting for the 'numEmits' emits and 'numReduces' reduces that produced them.
+     */
+    void addEmitted(const BSONList& tuples, long long numEmits, long long numReduces);
+
     /**
     * Checks the size of the transient in-memory results accumulated so far and potentially
     * runs reduce in order to compact them. If the data is still too large, it will be
@@ -458,6 +458,22 @@ TEST_F(MapReduceCommandTest, MapIdToValue) {
                       unittest::assertGet(_storage.findSingleton(_opCtx.get(), outputNss)));
 }
 
+TEST_F(MapReduceCommandTest, ReusedScopeRunsFunctionsOfNextOperation) {
+    auto sourceDoc = BSON("_id" << 1);
+    ASSERT_OK(_storage.insertDocument(_opCtx.get(), inputNss, {sourceDoc, Timestamp(0)}, 1LL));
+
+    // The second command runs in the scope left behind by the first one on this thread, and must
+    // neither see the first map function nor the emitted values of the first command.
+    auto reduceCode = "function(k, v) { return Array.sum(v); }"_sd;
+    ASSERT_OK(_runCommand("function() { emit(this._id, this._id); }"_sd, reduceCode));
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 1 << "value" << 1),
+                      unittest::assertGet(_storage.findSingleton(_opCtx.get(), outputNss)));
+
+    ASSERT_OK(_runCommand("function() { emit(this._id, this._id + 10); }"_sd, reduceCode));
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 1 << "value" << 11),
+                      unittest::assertGet(_storage.findSingleton(_opCtx.get(), outputNss)));
+}
+
 TEST_F(MapReduceCommandTest, DropTemporaryCollectionsOnInsertError) {
     auto sourceDoc = BSON("_id" << 0);
     ASSERT_OK(_storage.insertDocument(_opCtx.get(), inputNss, {sourceDoc, Timestamp(0)}, 1LL));
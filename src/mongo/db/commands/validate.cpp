@@ -39,6 +39,7 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/storage_engine.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
@@ -76,7 +77,9 @@ public:
                "Slow.\n"
                "Add full:true option to do a more thorough check\n"
                "Add scandata:false to skip the scan of the collection data without skipping scans "
-               "of any indexes";
+               "of any indexes\n"
+               "Add background:true to validate at a snapshot of the collection while writes to "
+               "it go on";
     }
 
     virtual bool supportsWriteConcern(const BSONObj& cmd) const override {
@@ -89,7 +92,8 @@ public:
         actions.addAction(ActionType::validate);
         out->push_back(Privilege(parseResourcePattern(dbname, cmdObj), actions));
     }
-    //{ validate: "collectionnamewithoutthedbpart" [, scandata: <bool>] [, full: <bool> } */
+    //{ validate: "collectionnamewithoutthedbpart" [, scandata: <bool>] [, full: <bool>]
+    //  [, background: <bool>] } */
 
     bool run(OperationContext* opCtx,
              const string& dbname,
@@ -104,6 +108,7 @@ public:
 
         const bool full = cmdObj["full"].trueValue();
         const bool scanData = cmdObj["scandata"].trueValue();
+        const bool background = cmdObj["background"].trueValue();
 
         ValidateCmdLevel level = kValidateIndex;
 
@@ -118,12 +123,27 @@ public:
                       "Can only run full validate on a regular collection");
         }
 
+        if (background && full) {
+            uasserted(ErrorCodes::CommandFailed,
+                      "Running background validation with full:true is not supported");
+        }
+
+        if (background && !opCtx->getServiceContext()->getStorageEngine()->supportsDocLocking()) {
+            uasserted(ErrorCodes::CommandNotSupported,
+                      "Background validation requires a storage engine with document-level "
+                      "locking");
+        }
+
         if (!serverGlobalParams.quiet.load()) {
-            LOG(0) << "CMD: validate " << nss.ns();
+            LOG(0) << "CMD: validate " << nss.ns() << (background ? " in background" : "");
         }
 
+        // A background validation reads the collection at the snapshot of its recovery unit, which
+        // is open for all of its reads, so it lets writes go on. Dropping the collection or its
+        // indexes still waits for it.
         AutoGetDb ctx(opCtx, nss.db(), MODE_IX);
-        auto collLk = stdx::make_unique<Lock::CollectionLock>(opCtx->lockState(), nss.ns(), MODE_X);
+        auto collLk = stdx::make_unique<Lock::CollectionLock>(
+            opCtx->lockState(), nss.ns(), background ? MODE_IX : MODE_X);
         Collection* collection = ctx.getDb() ? ctx.getDb()->getCollection(opCtx, nss) : NULL;
         if (!collection) {
             if (ctx.getDb() && ctx.getDb()->getViewCatalog()->lookup(opCtx, nss.ns())) {
@@ -133,6 +153,11 @@ public:
             uasserted(ErrorCodes::NamespaceNotFound, "ns not found");
         }
 
+        if (background && !collection->getRecordStore()->isInRecordIdOrder()) {
+            uasserted(ErrorCodes::CommandNotSupported,
+                      "Background validation requires a record store in RecordId order");
+        }
+
         result.append("ns", nss.ns());
 
         // Only one validation per collection can be in progress, the rest wait in order.
@@ -159,9 +184,6 @@ public:
             _validationNotifier.notify_all();
         });
 
-        // TODO SERVER-30357: Add support for background validation.
-        const bool background = false;
-
         ValidateResults results;
         Status status =
             collection->validate(opCtx, level, background, std::move(collLk), &results, &result);
@@ -35,6 +35,7 @@
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/rpc/factory.h"
 #include "mongo/rpc/op_msg_rpc_impls.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -278,6 +279,73 @@ public:
     mutable std::int32_t iCapture = 0;
 };
 
+// Just like ExampleMinimalCommand, but completing its reply from another thread through runAsync.
+class ExampleAsyncCommand final : public TypedCommand<ExampleAsyncCommand> {
+public:
+    ExampleAsyncCommand() : TypedCommand<ExampleAsyncCommand>("exampleAsync") {}
+
+private:
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return Command::AllowedOnSecondary::kNever;
+    }
+
+    std::string help() const override {
+        return "Return an incremented request.i, computed asynchronously.";
+    }
+
+public:
+    using Request = commands_test_example::ExampleMinimal;
+
+    class Invocation final : public MinimalInvocationBase {
+    public:
+        using MinimalInvocationBase::MinimalInvocationBase;
+
+        ~Invocation() {
+            if (_worker.joinable()) {
+                _worker.join();
+            }
+        }
+
+        void run(OperationContext* opCtx, rpc::ReplyBuilderInterface* reply) override {
+            runAsync(opCtx, reply).get();
+        }
+
+        /**
+         * Reply with an incremented 'request.i' from a separate thread, failing when it is
+         * negative.
+         */
+        Future<void> runAsync(OperationContext* opCtx, rpc::ReplyBuilderInterface* reply) override {
+            auto pf = makePromiseFuture<void>();
+            _worker = stdx::thread([ this, reply, promise = std::move(pf.promise) ]() mutable {
+                promise.setWith([&] {
+                    uassert(ErrorCodes::BadValue, "i must not be negative", request().getI() >= 0);
+                    commands_test_example::ExampleIncrementReply r;
+                    r.setIPlusOne(request().getI() + 1);
+                    reply->fillFrom(r);
+                });
+            });
+            return std::move(pf.future);
+        }
+
+    private:
+        bool supportsWriteConcern() const override {
+            return true;
+        }
+
+        void explain(OperationContext* opCtx,
+                     ExplainOptions::Verbosity verbosity,
+                     rpc::ReplyBuilderInterface* result) override {}
+
+        void doCheckAuthorization(OperationContext*) const override {}
+
+        NamespaceString ns() const override {
+            return request().getNamespace();
+        }
+
+        stdx::thread _worker;
+    };
+};
+
 template <typename Fn>
 class MyCommand final : public TypedCommand<MyCommand<Fn>> {
 public:
@@ -328,6 +396,7 @@ auto throwFn = [] { uasserted(ErrorCodes::UnknownError, "some error"); };
 ExampleIncrementCommand exampleIncrementCommand;
 ExampleMinimalCommand exampleMinimalCommand;
 ExampleVoidCommand exampleVoidCommand;
+ExampleAsyncCommand exampleAsyncCommand;
 CmdT<decltype(throwFn)> throwStatusCommand("throwsStatus", throwFn);
 
 class TypedCommandTest : public ServiceContextTest {
@@ -349,7 +418,7 @@ protected:
             const BSONObj reply = [&] {
                 rpc::OpMsgReplyBuilder replyBuilder;
                 try {
-                    invocation->run(opCtx.get(), &replyBuilder);
+                    invocation->runAsync(opCtx.get(), &replyBuilder).get();
                     auto bob = replyBuilder.getBodyBuilder();
                     CommandHelpers::extractOrAppendOk(bob);
                 } catch (const DBException& e) {
@@ -385,6 +454,18 @@ TEST_F(TypedCommandTest, runVoid) {
     });
 }
 
+TEST_F(TypedCommandTest, runAsync) {
+    runIncr(exampleAsyncCommand, [](int i, const BSONObj& reply) {
+        if (i < 0) {
+            ASSERT_EQ(reply["ok"].Double(), 0.0);
+            ASSERT_EQ(reply["code"].Int(), ErrorCodes::BadValue);
+            return;
+        }
+        ASSERT_EQ(reply["ok"].Double(), 1.0);
+        ASSERT_EQ(reply["iPlusOne"].Int(), i + 1);
+    });
+}
+
 TEST_F(TypedCommandTest, runThrowStatus) {
     runIncr(throwStatusCommand, [](int i, const BSONObj& reply) {
         Status status = Status::OK();
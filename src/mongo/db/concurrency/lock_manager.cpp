@@ -34,6 +34,10 @@
 
 #include <third_party/murmurhash3/MurmurHash3.h>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include "mongo/base/data_type_endian.h"
 #include "mongo/base/data_view.h"
 #include "mongo/base/static_assert.h"
@@ -41,6 +45,7 @@
 #include "mongo/config.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/stringutils.h"
@@ -319,13 +324,27 @@ void LockHead::decConflictModeCount(LockMode mode) {
 // Have more buckets than CPUs to reduce contention on lock and caches
 const unsigned LockManager::_numLockBuckets(128);
 
+namespace {
+
 // Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+// The exact value doesn't appear very important, but should be power of two and no smaller than
+// the number of CPUs.
+unsigned computeNumPartitions() {
+    const unsigned kMinPartitions = 32;
+    const unsigned kMaxPartitions = 1024;
+
+    unsigned numPartitions = kMinPartitions;
+    while (numPartitions < stdx::thread::hardware_concurrency() && numPartitions < kMaxPartitions) {
+        numPartitions *= 2;
+    }
+    return numPartitions;
+}
 
-LockManager::LockManager() {
+}  // namespace
+
+LockManager::LockManager() : _numPartitions(computeNumPartitions()) {
     _lockBuckets = new LockBucket[_numLockBuckets];
-    _partitions = new Partition[_numPartitions];
+    _partitions = new CacheAligned<Partition>[_numPartitions];
 }
 
 LockManager::~LockManager() {
@@ -350,7 +369,7 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
 
     // For intent modes, try the PartitionedLockHead
     if (request->partitioned) {
-        Partition* partition = _getPartition(request);
+        Partition* partition = _assignPartition(request);
         stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
 
         // Fast path for intent locks
@@ -718,8 +737,19 @@ LockManager::LockBucket* LockManager::_getBucket(ResourceId resId) const {
     return &_lockBuckets[resId % _numLockBuckets];
 }
 
+LockManager::Partition* LockManager::_assignPartition(LockRequest* request) const {
+#if defined(__linux__)
+    const int cpu = sched_getcpu();
+    request->partitionIndex = cpu >= 0 ? static_cast<unsigned>(cpu) % _numPartitions
+                                       : request->locker->getId() % _numPartitions;
+#else
+    request->partitionIndex = request->locker->getId() % _numPartitions;
+#endif
+    return _getPartition(request);
+}
+
 LockManager::Partition* LockManager::_getPartition(LockRequest* request) const {
-    return &_partitions[request->locker->getId() % _numPartitions];
+    return &_partitions[request->partitionIndex];
 }
 
 void LockManager::dump() const {
@@ -1083,6 +1113,7 @@ void LockRequest::initNew(Locker* locker, LockGrantNotification* notify) {
     next = nullptr;
     status = STATUS_NEW;
     partitioned = false;
+    partitionIndex = 0;
     mode = MODE_NONE;
     convertMode = MODE_NONE;
 }
@@ -43,6 +43,7 @@
 #include "mongo/stdx/mutex.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -172,7 +173,13 @@ private:
 
 
     /**
-     * Retrieves the Partition that a particular LockRequest should use for intent locking.
+     * Picks the Partition that a new intent mode LockRequest should use, preferring the one
+     * belonging to the CPU the calling thread runs on, and records it in the request.
+     */
+    Partition* _assignPartition(LockRequest* request) const;
+
+    /**
+     * Retrieves the Partition that a particular LockRequest was assigned for intent locking.
      */
     Partition* _getPartition(LockRequest* request) const;
 
@@ -220,8 +227,10 @@ private:
     static const unsigned _numLockBuckets;
     LockBucket* _lockBuckets;
 
-    static const unsigned _numPartitions;
-    Partition* _partitions;
+    // At least one per CPU, so that threads on different CPUs do not share a partition mutex.
+    // Each partition is cache aligned so that neighbouring partition mutexes do not false share.
+    const unsigned _numPartitions;
+    CacheAligned<Partition>* _partitions;
 };
 
 
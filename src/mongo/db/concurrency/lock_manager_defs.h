@@ -374,6 +374,15 @@ struct LockRequest {
     // No synchronization
     bool partitioned;
 
+    // Index of the LockManager partition used for this request while it is partitioned. Chosen
+    // from the CPU running the Locker thread when the request is first made, and kept so that
+    // unlock uses the same partition even if the thread has since moved to another CPU.
+    //
+    // Written by LockManager on Locker thread
+    // Read by LockManager on Locker thread
+    // No synchronization
+    unsigned partitionIndex;
+
     // How many times has LockManager::lock been called for this request. Locks are released when
     // their recursive count drops to zero.
     //
@@ -36,7 +36,9 @@
 
 #include "mongo/db/concurrency/replication_lock_manager_manipulator.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/concurrent_latency_histogram.h"
 #include "mongo/platform/compiler.h"
 #include "mongo/stdx/new.h"
 #include "mongo/util/background.h"
@@ -45,6 +47,7 @@
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -118,6 +121,17 @@ const Milliseconds DeadlockTimeout = Milliseconds(500);
 // Dispenses unique LockerId identifiers
 AtomicUInt64 idCounter(0);
 
+// Longest a low priority Locker yields to queued operations on each ticket acquisition before
+// waiting for a ticket in the same queue as them.
+MONGO_EXPORT_SERVER_PARAMETER(lowPriorityTicketMaxDeferralMillis, int, 1000)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "lowPriorityTicketMaxDeferralMillis must be greater than or equal to 0");
+        }
+        return Status::OK();
+    });
+
 // Partitioned global lock statistics, so we don't hit the same bucket
 PartitionedInstanceWideLockStats globalStats;
 
@@ -238,6 +252,10 @@ void CondVarLockGrantNotification::notify(ResourceId resId, LockResult result) {
 
 namespace {
 TicketHolder* ticketHolders[LockModesCount] = {};
+
+// Time spent waiting for read and write tickets, in microseconds.
+ConcurrentLatencyHistogram readTicketWaits;
+ConcurrentLatencyHistogram writeTicketWaits;
 }  // namespace
 
 
@@ -252,6 +270,18 @@ void Locker::setGlobalThrottling(class TicketHolder* reading, class TicketHolder
     ticketHolders[MODE_IX] = writing;
 }
 
+/* static */
+void Locker::appendTicketWaitStats(BSONObjBuilder* builder) {
+    {
+        BSONObjBuilder readBuilder(builder->subobjStart("read"));
+        readTicketWaits.append(false, &readBuilder);
+    }
+    {
+        BSONObjBuilder writeBuilder(builder->subobjStart("write"));
+        writeTicketWaits.append(false, &writeBuilder);
+    }
+}
+
 LockerImpl::LockerImpl()
     : _id(idCounter.addAndFetch(1)), _wuowNestingLevel(0), _threadId(stdx::this_thread::get_id()) {}
 
@@ -339,11 +369,20 @@ LockResult LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Da
         auto restoreStateOnErrorGuard = MakeGuard([&] { _clientState.store(kInactive); });
 
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
-        if (deadline == Date_t::max()) {
+        Timer waitTimer;
+        if (hasLowTicketPriority()) {
+            if (!holder->waitForLowPriorityTicketUntil(
+                    interruptible,
+                    deadline,
+                    Milliseconds(lowPriorityTicketMaxDeferralMillis.load()))) {
+                return LOCK_TIMEOUT;
+            }
+        } else if (deadline == Date_t::max()) {
             holder->waitForTicket(interruptible);
         } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
             return LOCK_TIMEOUT;
         }
+        (reader ? readTicketWaits : writeTicketWaits).record(waitTimer.micros());
         restoreStateOnErrorGuard.Dismiss();
     }
     _clientState.store(reader ? kActiveReader : kActiveWriter);
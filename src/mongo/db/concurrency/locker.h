@@ -38,6 +38,8 @@
 
 namespace mongo {
 
+class BSONObjBuilder;
+
 /**
  * Interface for acquiring locks. One of those objects will have to be instantiated for each
  * request (transaction).
@@ -73,6 +75,12 @@ public:
      */
     static void setGlobalThrottling(class TicketHolder* reading, class TicketHolder* writing);
 
+    /**
+     * Appends the distribution of the time global lock attempts have waited for read and write
+     * tickets.
+     */
+    static void appendTicketWaitStats(BSONObjBuilder* builder);
+
     /**
      * State for reporting the number of active and queued reader and writer clients.
      */
@@ -451,6 +459,19 @@ public:
     bool shouldAcquireTicket() const {
         return _shouldAcquireTicket;
     }
+
+    /**
+     * If set to true, ticket acquisitions yield to operations already queued for a ticket, for up
+     * to lowPriorityTicketMaxDeferralMillis per acquisition. Used for batch workloads that should
+     * not starve interactive traffic.
+     */
+    void setLowTicketPriority(bool newValue) {
+        _lowTicketPriority = newValue;
+    }
+    bool hasLowTicketPriority() const {
+        return _lowTicketPriority;
+    }
+
     /**
      * This function is for unit testing only.
      */
@@ -478,6 +499,7 @@ protected:
 private:
     bool _shouldConflictWithSecondaryBatchApplication = true;
     bool _shouldAcquireTicket = true;
+    bool _lowTicketPriority = false;
 };
 
 /**
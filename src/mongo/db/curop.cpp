@@ -35,6 +35,11 @@
 #include "mongo/db/curop.h"
 
 #include <iomanip>
+#include <time.h>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/bson/mutable/document.h"
@@ -67,6 +72,35 @@ const std::vector<const char*> kDollarQueryModifiers = {
     "$hint", "$comment", "$max", "$min", "$returnKey", "$showDiskLoc", "$snapshot", "$maxTimeMS",
 };
 
+/**
+ * Returns the CPU time consumed so far by the calling thread, or boost::none on platforms which
+ * cannot measure it.
+ */
+boost::optional<long long> threadCpuNanos() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    struct timespec t;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t) == 0) {
+        return static_cast<long long>(t.tv_sec) * 1000 * 1000 * 1000 + t.tv_nsec;
+    }
+#endif
+    return boost::none;
+}
+
+/**
+ * Returns the number of block reads and writes the filesystem has performed on behalf of the
+ * calling thread, or boost::none on platforms which cannot count them per thread. Reads served
+ * from the page cache are not counted, so these are the operation's reads and writes to disk.
+ */
+boost::optional<CurOp::BlockIoCounts> threadBlockIoCounts() {
+#if defined(RUSAGE_THREAD)
+    struct rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+        return CurOp::BlockIoCounts{usage.ru_inblock, usage.ru_oublock};
+    }
+#endif
+    return boost::none;
+}
+
 }  // namespace
 
 BSONObj upconvertQueryEntry(const BSONObj& query,
@@ -364,6 +398,8 @@ void CurOp::setNS_inlock(StringData ns) {
 void CurOp::ensureStarted() {
     if (_start == 0) {
         _start = curTimeMicros64();
+        _startCpuNanos = threadCpuNanos();
+        _startBlockIoCounts = threadBlockIoCounts();
     }
 }
 
@@ -399,6 +435,20 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
     _end = curTimeMicros64();
     _debug.executionTimeMicros = durationCount<Microseconds>(elapsedTimeExcludingPauses());
 
+    // An operation runs on a single thread from start to finish, so the thread's resource usage
+    // measures the resource usage of the operation.
+    if (_startCpuNanos) {
+        if (auto endCpuNanos = threadCpuNanos()) {
+            _debug.cpuNanos = *endCpuNanos - *_startCpuNanos;
+        }
+    }
+    if (_startBlockIoCounts) {
+        if (auto endBlockIoCounts = threadBlockIoCounts()) {
+            _debug.storageBlockReads = endBlockIoCounts->reads - _startBlockIoCounts->reads;
+            _debug.storageBlockWrites = endBlockIoCounts->writes - _startBlockIoCounts->writes;
+        }
+    }
+
     const bool shouldSample =
         client->getPrng().nextCanonicalDouble() < serverGlobalParams.sampleRate;
 
@@ -626,6 +676,9 @@ string OpDebug::report(Client* client,
     OPDEBUG_TOSTRING_HELP_OPTIONAL("keysDeleted", additiveMetrics.keysDeleted);
     OPDEBUG_TOSTRING_HELP_OPTIONAL("prepareReadConflicts", additiveMetrics.prepareReadConflicts);
     OPDEBUG_TOSTRING_HELP_OPTIONAL("writeConflicts", additiveMetrics.writeConflicts);
+    OPDEBUG_TOSTRING_HELP_OPTIONAL("cpuNanos", cpuNanos);
+    OPDEBUG_TOSTRING_HELP_OPTIONAL("storageBlockReads", storageBlockReads);
+    OPDEBUG_TOSTRING_HELP_OPTIONAL("storageBlockWrites", storageBlockWrites);
 
     s << " numYields:" << curop.numYields();
     OPDEBUG_TOSTRING_HELP(nreturned);
@@ -711,6 +764,9 @@ void OpDebug::append(const CurOp& curop,
     OPDEBUG_APPEND_OPTIONAL("keysDeleted", additiveMetrics.keysDeleted);
     OPDEBUG_APPEND_OPTIONAL("prepareReadConflicts", additiveMetrics.prepareReadConflicts);
     OPDEBUG_APPEND_OPTIONAL("writeConflicts", additiveMetrics.writeConflicts);
+    OPDEBUG_APPEND_OPTIONAL("cpuNanos", cpuNanos);
+    OPDEBUG_APPEND_OPTIONAL("storageBlockReads", storageBlockReads);
+    OPDEBUG_APPEND_OPTIONAL("storageBlockWrites", storageBlockWrites);
 
     b.appendNumber("numYield", curop.numYields());
     OPDEBUG_APPEND_NUMBER(nreturned);
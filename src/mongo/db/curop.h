@@ -190,6 +190,12 @@ public:
 
     // response info
     long long executionTimeMicros{0};
+    // Resources used by the operation's thread, where the platform can measure them. Only set
+    // once the operation completes. The block counts are reads and writes that went to disk
+    // rather than being served from the page cache.
+    boost::optional<long long> cpuNanos;
+    boost::optional<long long> storageBlockReads;
+    boost::optional<long long> storageBlockWrites;
     long long nreturned{-1};
     int responseLength{-1};
 
@@ -225,6 +231,14 @@ class CurOp {
     MONGO_DISALLOW_COPYING(CurOp);
 
 public:
+    /**
+     * Block reads and writes performed by the filesystem on behalf of a thread.
+     */
+    struct BlockIoCounts {
+        long long reads;
+        long long writes;
+    };
+
     static CurOp* get(const OperationContext* opCtx);
     static CurOp* get(const OperationContext& opCtx);
 
@@ -346,6 +360,26 @@ public:
         return elapsedTimeExcludingPauses() >= Milliseconds{serverGlobalParams.slowMS};
     }
 
+    /**
+     * Returns true if the execution stats of this operation's plan should be gathered when it
+     * finishes running, which is the case if it is to be profiled or was chosen for the
+     * OpSampleBuffer.
+     */
+    bool shouldCollectExecStats() {
+        return _sampledForOpSampleBuffer || shouldDBProfile();
+    }
+
+    /**
+     * Whether this operation's profiler entry is recorded in the OpSampleBuffer when it completes.
+     * Decided once, before the operation starts running.
+     */
+    bool isSampledForOpSampleBuffer() const {
+        return _sampledForOpSampleBuffer;
+    }
+    void setSampledForOpSampleBuffer(bool sampled) {
+        _sampledForOpSampleBuffer = sampled;
+    }
+
     /**
      * Raises the profiling level for this operation to "dbProfileLevel" if it was previously
      * less than "dbProfileLevel".
@@ -583,6 +617,10 @@ private:
     // The time at which this CurOp instance was marked as started.
     long long _start{0};
 
+    // The resources used by the thread running this operation when it started.
+    boost::optional<long long> _startCpuNanos;
+    boost::optional<BlockIoCounts> _startBlockIoCounts;
+
     // The time at which this CurOp instance was marked as done.
     long long _end{0};
 
@@ -602,6 +640,7 @@ private:
 
     bool _isCommand{false};
     int _dbprofile{0};  // 0=off, 1=slow, 2=all
+    bool _sampledForOpSampleBuffer{false};
     std::string _ns;
     BSONObj _opDescription;
     BSONObj _originatingCommand;  // Used by getMore to display original command.
@@ -58,6 +58,16 @@ ServerStatusMetricField<Counter64> displayScanAndOrder("operation.scanAndOrder",
 ServerStatusMetricField<Counter64> displayWriteConflicts("operation.writeConflicts",
                                                          &writeConflictsCounter);
 
+Counter64 cpuNanosCounter;
+Counter64 storageBlockReadsCounter;
+Counter64 storageBlockWritesCounter;
+
+ServerStatusMetricField<Counter64> displayCpuNanos("operation.cpuNanos", &cpuNanosCounter);
+ServerStatusMetricField<Counter64> displayStorageBlockReads("operation.storageBlockReads",
+                                                            &storageBlockReadsCounter);
+ServerStatusMetricField<Counter64> displayStorageBlockWrites("operation.storageBlockWrites",
+                                                             &storageBlockWritesCounter);
+
 }  // namespace
 
 void recordCurOpMetrics(OperationContext* opCtx) {
@@ -79,6 +89,13 @@ void recordCurOpMetrics(OperationContext* opCtx) {
         scanAndOrderCounter.increment();
     if (debug.additiveMetrics.writeConflicts)
         writeConflictsCounter.increment(*debug.additiveMetrics.writeConflicts);
+
+    if (debug.cpuNanos)
+        cpuNanosCounter.increment(*debug.cpuNanos);
+    if (debug.storageBlockReads)
+        storageBlockReadsCounter.increment(*debug.storageBlockReads);
+    if (debug.storageBlockWrites)
+        storageBlockWritesCounter.increment(*debug.storageBlockWrites);
 }
 
 }  // namespace mongo
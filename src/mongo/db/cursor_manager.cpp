@@ -32,6 +32,8 @@
 
 #include "mongo/db/cursor_manager.h"
 
+#include <algorithm>
+
 #include "mongo/base/data_cursor.h"
 #include "mongo/base/init.h"
 #include "mongo/db/audit.h"
@@ -104,9 +106,18 @@ public:
 
     std::size_t timeoutCursors(OperationContext* opCtx, Date_t now);
 
+    std::size_t reclaimIdleCursorMemory(OperationContext* opCtx, std::size_t limitBytes);
+
     template <typename Visitor>
     void visitAllCursorManagers(OperationContext* opCtx, Visitor* visitor);
 
+    /**
+     * Like visitAllCursorManagers(), but for use by background tasks: lock acquisitions are not
+     * interruptible, and collections that have disappeared or turned into views are skipped.
+     */
+    template <typename Visitor>
+    void visitAllCursorManagersUninterruptibly(OperationContext* opCtx, Visitor* visitor);
+
     int64_t nextSeed();
 
 private:
@@ -249,13 +260,12 @@ bool GlobalCursorIdCache::killCursor(OperationContext* opCtx, CursorId id, bool
     return eraseStatus.isOK();
 }
 
-std::size_t GlobalCursorIdCache::timeoutCursors(OperationContext* opCtx, Date_t now) {
-    size_t totalTimedOut = 0;
-
-    // Time out the cursors from the global cursor manager.
-    totalTimedOut += globalCursorManager->timeoutCursors(opCtx, now);
+template <typename Visitor>
+void GlobalCursorIdCache::visitAllCursorManagersUninterruptibly(OperationContext* opCtx,
+                                                                Visitor* visitor) {
+    (*visitor)(*globalCursorManager);
 
-    // Compute the set of collection names that we have to time out cursors for.
+    // Compute the set of collection names whose cursor managers we have to visit.
     vector<NamespaceString> todo;
     {
         stdx::lock_guard<SimpleMutex> lk(_mutex);
@@ -264,8 +274,8 @@ std::size_t GlobalCursorIdCache::timeoutCursors(OperationContext* opCtx, Date_t
         }
     }
 
-    // For each collection, time out its cursors under the collection lock (to prevent the
-    // collection from going away during the erase).
+    // For each collection, visit its cursor manager under the collection lock (to prevent the
+    // collection from going away during the visit).
     for (const auto& nsTodo : todo) {
         // We need to be careful to not use an AutoGet* helper, since we only need the lock to
         // protect potential access to the Collection's CursorManager, and those helpers may
@@ -291,12 +301,50 @@ std::size_t GlobalCursorIdCache::timeoutCursors(OperationContext* opCtx, Date_t
             continue;
         }
 
-        totalTimedOut += collection->getCursorManager()->timeoutCursors(opCtx, now);
+        (*visitor)(*(collection->getCursorManager()));
     }
+}
 
+std::size_t GlobalCursorIdCache::timeoutCursors(OperationContext* opCtx, Date_t now) {
+    size_t totalTimedOut = 0;
+    auto visitor = [&](CursorManager& mgr) { totalTimedOut += mgr.timeoutCursors(opCtx, now); };
+    visitAllCursorManagersUninterruptibly(opCtx, &visitor);
     return totalTimedOut;
 }
 
+std::size_t GlobalCursorIdCache::reclaimIdleCursorMemory(OperationContext* opCtx,
+                                                         std::size_t limitBytes) {
+    std::vector<CursorManager::IdleCursorMemUsage> usage;
+    auto collector = [&](CursorManager& mgr) { mgr.appendIdleCursorMemUsage(&usage); };
+    visitAllCursorManagersUninterruptibly(opCtx, &collector);
+
+    std::size_t totalBytes = 0;
+    for (auto&& entry : usage) {
+        totalBytes += entry.bytes;
+    }
+    if (totalBytes <= limitBytes) {
+        return 0;
+    }
+
+    // Pick the least recently used cursors until the rest fit within the limit. The cursors are not
+    // pinned while they are chosen, so a cursor is only destroyed if it has not been used since.
+    std::sort(usage.begin(), usage.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.lastUseDate < rhs.lastUseDate;
+    });
+    stdx::unordered_map<CursorId, Date_t> toReclaim;
+    for (auto it = usage.begin(); it != usage.end() && totalBytes > limitBytes; ++it) {
+        toReclaim.emplace(it->cursorId, it->lastUseDate);
+        totalBytes -= it->bytes;
+    }
+
+    std::size_t totalReclaimed = 0;
+    auto reclaimer = [&](CursorManager& mgr) {
+        totalReclaimed += mgr.reclaimIdleCursors(opCtx, toReclaim);
+    };
+    visitAllCursorManagersUninterruptibly(opCtx, &reclaimer);
+    return totalReclaimed;
+}
+
 }  // namespace
 
 template <typename Visitor>
@@ -366,6 +414,11 @@ std::size_t CursorManager::timeoutCursorsGlobal(OperationContext* opCtx, Date_t
     return globalCursorIdCache->timeoutCursors(opCtx, now);
 }
 
+std::size_t CursorManager::reclaimIdleCursorMemoryGlobal(OperationContext* opCtx,
+                                                         std::size_t limitBytes) {
+    return globalCursorIdCache->reclaimIdleCursorMemory(opCtx, limitBytes);
+}
+
 int CursorManager::killCursorGlobalIfAuthorized(OperationContext* opCtx, int n, const char* _ids) {
     ConstDataCursor ids(_ids);
     int numDeleted = 0;
@@ -518,6 +571,49 @@ std::size_t CursorManager::timeoutCursors(OperationContext* opCtx, Date_t now) {
     return toDisposeWithoutMutex.size();
 }
 
+void CursorManager::appendIdleCursorMemUsage(std::vector<IdleCursorMemUsage>* usage) const {
+    auto allPartitions = _cursorMap->lockAllPartitions();
+    for (auto&& partition : allPartitions) {
+        for (auto&& entry : partition) {
+            auto cursor = entry.second;
+            if (cursor->isNoTimeout() || cursor->_operationUsingCursor) {
+                continue;
+            }
+            if (auto bytes = cursor->getMemUsage()) {
+                usage->push_back({cursor->cursorid(), cursor->_lastUseDate, bytes});
+            }
+        }
+    }
+}
+
+std::size_t CursorManager::reclaimIdleCursors(
+    OperationContext* opCtx, const stdx::unordered_map<CursorId, Date_t>& toReclaim) {
+    std::vector<std::unique_ptr<ClientCursor, ClientCursor::Deleter>> toDisposeWithoutMutex;
+
+    for (size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+        auto lockedPartition = _cursorMap->lockOnePartitionById(partitionId);
+        for (auto it = lockedPartition->begin(); it != lockedPartition->end();) {
+            auto* cursor = it->second;
+            auto reclaimIt = toReclaim.find(cursor->cursorid());
+            if (reclaimIt != toReclaim.end() && !cursor->_operationUsingCursor &&
+                cursor->_lastUseDate == reclaimIt->second) {
+                toDisposeWithoutMutex.emplace_back(cursor);
+                it = lockedPartition->erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Be careful not to dispose of cursors while holding the partition lock.
+    for (auto&& cursor : toDisposeWithoutMutex) {
+        log() << "Cursor id " << cursor->cursorid() << " killed to free memory, idle since "
+              << cursor->getLastUseDate();
+        cursor->dispose(opCtx);
+    }
+    return toDisposeWithoutMutex.size();
+}
+
 namespace {
 static AtomicUInt32 registeredPlanExecutorId;
 }  // namespace
@@ -134,6 +134,28 @@ public:
      */
     std::size_t timeoutCursors(OperationContext* opCtx, Date_t now);
 
+    /**
+     * The memory held by an idle cursor, as weighed by reclaimIdleCursorMemoryGlobal().
+     */
+    struct IdleCursorMemUsage {
+        CursorId cursorId;
+        Date_t lastUseDate;
+        std::size_t bytes;
+    };
+
+    /**
+     * Appends the memory usage of every idle cursor in this cursor manager that is allowed to time
+     * out and holds buffered results.
+     */
+    void appendIdleCursorMemUsage(std::vector<IdleCursorMemUsage>* usage) const;
+
+    /**
+     * Destroys the cursors in 'toReclaim' that are still idle and have not been used since the
+     * last use date they map to. Returns the number of cursors destroyed.
+     */
+    std::size_t reclaimIdleCursors(OperationContext* opCtx,
+                                   const stdx::unordered_map<CursorId, Date_t>& toReclaim);
+
     /**
      * Register an executor so that it can be notified of events that cause the PlanExecutor to be
      * killed. Must be called before an executor yields. Registration happens automatically for
@@ -240,6 +262,14 @@ public:
      */
     static std::size_t timeoutCursorsGlobal(OperationContext* opCtx, Date_t now);
 
+    /**
+     * Destroys the least recently used idle cursors across all cursor managers until the buffered
+     * results held by the remaining ones fit in 'limitBytes'. Returns the number of cursors that
+     * were destroyed.
+     */
+    static std::size_t reclaimIdleCursorMemoryGlobal(OperationContext* opCtx,
+                                                     std::size_t limitBytes);
+
     /**
      * Locate the correct cursor manager for a given cursorId and execute the provided callback.
      * Returns ErrorCodes::CursorNotFound if cursorId does not exist.
@@ -42,6 +42,16 @@ MONGO_EXPORT_SERVER_PARAMETER(cursorTimeoutMillis,
                               long long,
                               durationCount<Milliseconds>(kDefaultCursorTimeoutMinutes));
 
+// Total bytes of buffered results that idle cursors may hold before the least recently used of them
+// are reclaimed, or 0 for no limit.
+MONGO_EXPORT_SERVER_PARAMETER(idleCursorMemoryLimitBytes, long long, 0)
+    ->withValidator([](const long long& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue, "idleCursorMemoryLimitBytes must be non-negative");
+        }
+        return Status::OK();
+    });
+
 }  // namespace
 
 int getClientCursorMonitorFrequencySecs() {
@@ -52,6 +62,10 @@ long long getCursorTimeoutMillis() {
     return cursorTimeoutMillis.load();
 }
 
+long long getIdleCursorMemoryLimitBytes() {
+    return idleCursorMemoryLimitBytes.load();
+}
+
 Milliseconds getDefaultCursorTimeoutMillis() {
     return kDefaultCursorTimeoutMinutes;
 }
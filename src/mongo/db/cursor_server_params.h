@@ -38,6 +38,11 @@ int getClientCursorMonitorFrequencySecs();
 // parameter "cursorTimeoutMillis".
 long long getCursorTimeoutMillis();
 
+// Bytes of buffered results that idle cursors may hold in total before the least recently used of
+// them are killed to free memory, or 0 for no limit. Configurable with server parameter
+// "idleCursorMemoryLimitBytes".
+long long getIdleCursorMemoryLimitBytes();
+
 Milliseconds getDefaultCursorTimeoutMillis();
 
 }  // namespace mongo
@@ -129,6 +129,8 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/system_index.h"
 #include "mongo/db/ttl.h"
+#include "mongo/db/views/materialized_view_op_observer.h"
+#include "mongo/db/views/materialized_view_refresher.h"
 #include "mongo/db/wire_version.h"
 #include "mongo/executor/network_connection_hook.h"
 #include "mongo/executor/network_interface_factory.h"
@@ -282,6 +284,7 @@ ExitCode _initAndListen(int listenPort) {
     auto opObserverRegistry = stdx::make_unique<OpObserverRegistry>();
     opObserverRegistry->addObserver(stdx::make_unique<OpObserverShardingImpl>());
     opObserverRegistry->addObserver(stdx::make_unique<UUIDCatalogObserver>());
+    opObserverRegistry->addObserver(stdx::make_unique<MaterializedViewOpObserver>());
 
     if (serverGlobalParams.clusterRole == ClusterRole::ShardServer) {
         opObserverRegistry->addObserver(stdx::make_unique<ShardServerOpObserver>());
@@ -596,6 +599,7 @@ ExitCode _initAndListen(int listenPort) {
             log() << startupWarningsLog;
         } else {
             startTTLBackgroundJob();
+            startMaterializedViewRefresher();
         }
 
         if (replSettings.usingReplSets() || !internalValidateFeaturesAsMaster) {
@@ -48,10 +48,23 @@ const boost::optional<int> kDoNotChangeProfilingLevel = boost::none;
 
 }  // namespace
 
-// If true, do not take the PBWM lock in AutoGetCollectionForRead on secondaries during batch
-// application.
+// If true, do not take the PBWM lock in AutoGetCollectionForRead or AutoGetDbForRead on
+// secondaries during batch application.
 MONGO_EXPORT_SERVER_PARAMETER(allowSecondaryReadsDuringBatchApplication, bool, true);
 
+namespace {
+
+/**
+ * Returns true if reads need not take the ParallelBatchWriterMode lock: when the server parameter
+ * is set and our storage engine supports snapshot reads.
+ */
+bool canReadDuringBatchApplication(OperationContext* opCtx) {
+    return allowSecondaryReadsDuringBatchApplication.load() &&
+        opCtx->getServiceContext()->getStorageEngine()->supportsReadConcernSnapshot();
+}
+
+}  // namespace
+
 AutoStatsTracker::AutoStatsTracker(OperationContext* opCtx,
                                    const NamespaceString& nss,
                                    Top::LockType lockType,
@@ -83,14 +96,18 @@ AutoStatsTracker::~AutoStatsTracker() {
                 curOp->getReadWriteType());
 }
 
+AutoGetDbForRead::AutoGetDbForRead(OperationContext* opCtx, StringData dbName, Date_t deadline) {
+    if (canReadDuringBatchApplication(opCtx)) {
+        _shouldNotConflictWithSecondaryBatchApplicationBlock.emplace(opCtx->lockState());
+    }
+    _autoDb.emplace(opCtx, dbName, MODE_IS, deadline);
+}
+
 AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
                                                    const NamespaceStringOrUUID& nsOrUUID,
                                                    AutoGetCollection::ViewMode viewMode,
                                                    Date_t deadline) {
-    // Don't take the ParallelBatchWriterMode lock when the server parameter is set and our
-    // storage engine supports snapshot reads.
-    if (allowSecondaryReadsDuringBatchApplication.load() &&
-        opCtx->getServiceContext()->getStorageEngine()->supportsReadConcernSnapshot()) {
+    if (canReadDuringBatchApplication(opCtx)) {
         _shouldNotConflictWithSecondaryBatchApplicationBlock.emplace(opCtx->lockState());
     }
     const auto collectionLockMode = getLockModeForQuery(opCtx);
@@ -66,6 +66,32 @@ private:
     Top::LockType _lockType;
 };
 
+/**
+ * Same as calling AutoGetDb with MODE_IS, but like AutoGetCollectionForRead does not wait for
+ * oplog batch application on secondaries.
+ *
+ * Use this to read the catalog of a database, such as the names and options of its collections or
+ * its view definitions, but not the contents of its collections: these reads see the catalog as of
+ * the latest catalog change, which batch application only makes while holding exclusive locks.
+ */
+class AutoGetDbForRead {
+    MONGO_DISALLOW_COPYING(AutoGetDbForRead);
+
+public:
+    AutoGetDbForRead(OperationContext* opCtx, StringData dbName, Date_t deadline = Date_t::max());
+
+    Database* getDb() const {
+        return _autoDb->getDb();
+    }
+
+private:
+    // Stays in scope with the _autoDb so that locks are taken and released in the right order.
+    boost::optional<ShouldNotConflictWithSecondaryBatchApplicationBlock>
+        _shouldNotConflictWithSecondaryBatchApplicationBlock;
+
+    boost::optional<AutoGetDb> _autoDb;
+};
+
 /**
  * Same as calling AutoGetCollection with MODE_IS, but in addition ensures that the read will be
  * performed against an appropriately committed snapshot if the operation is using a readConcern of
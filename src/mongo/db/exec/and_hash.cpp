@@ -80,7 +80,7 @@ void AndHashStage::addChild(PlanStage* child) {
 }
 
 size_t AndHashStage::getMemUsage() const {
-    return _memUsage;
+    return _memUsage + PlanStage::getMemUsage();
 }
 
 bool AndHashStage::isEOF() {
@@ -312,12 +312,13 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
         // WSM with no record id.
         invariant(member->hasRecordId());
 
-        if (_dataMap.end() == _dataMap.find(member->recordId)) {
+        DataMap::const_iterator it = _dataMap.find(member->recordId);
+        if (_dataMap.end() == it) {
             // Ignore.  It's not in any previous child.
         } else {
             // We have a hit.  Copy data into the WSM we already have.
             _seenMap.insert(member->recordId);
-            WorkingSetID olderMemberID = _dataMap[member->recordId];
+            WorkingSetID olderMemberID = it->second;
             WorkingSetMember* olderMember = _ws->get(olderMemberID);
             size_t memUsageBefore = olderMember->getMemUsage();
 
@@ -335,7 +336,7 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
         // Keep elements of _dataMap that are in _seenMap.
         DataMap::iterator it = _dataMap.begin();
         while (it != _dataMap.end()) {
-            if (_seenMap.end() == _seenMap.find(it->first)) {
+            if (!_seenMap.contains(it->first)) {
                 DataMap::iterator toErase = it;
                 ++it;
 
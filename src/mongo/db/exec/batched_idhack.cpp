@@ -0,0 +1,270 @@
+/**
+ *    Copyright (C) 2013-2014 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/batched_idhack.h"
+
+#include <algorithm>
+
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/exec/working_set_computed_data.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/query/indexability.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/storage/clustered_id.h"
+#include "mongo/stdx/memory.h"
+
+namespace mongo {
+
+using std::unique_ptr;
+using stdx::make_unique;
+
+namespace {
+
+int compareKeys(const BSONObj& lhs, const BSONObj& rhs) {
+    return lhs.woCompare(rhs, BSONObj(), /*considerFieldNames*/ false);
+}
+
+}  // namespace
+
+// static
+const char* BatchedIDHackStage::kStageType = "BATCHED_IDHACK";
+
+BatchedIDHackStage::BatchedIDHackStage(OperationContext* opCtx,
+                                       const Collection* collection,
+                                       CanonicalQuery* query,
+                                       WorkingSet* ws,
+                                       const IndexDescriptor* descriptor)
+    : PlanStage(kStageType, opCtx), _collection(collection), _workingSet(ws) {
+    const IndexCatalog* catalog = _collection->getIndexCatalog();
+    _specificStats.indexName = descriptor->indexName();
+    _accessMethod = catalog->getIndex(descriptor);
+
+    for (auto&& value : query->getQueryObj()["_id"]["$in"].Obj()) {
+        BSONObjBuilder key;
+        key.appendAs(value, "");
+        _keys.push_back(key.obj());
+    }
+    std::sort(_keys.begin(), _keys.end(), [](const BSONObj& lhs, const BSONObj& rhs) {
+        return compareKeys(lhs, rhs) < 0;
+    });
+    _keys.erase(std::unique(_keys.begin(),
+                            _keys.end(),
+                            [](const BSONObj& lhs, const BSONObj& rhs) {
+                                return compareKeys(lhs, rhs) == 0;
+                            }),
+                _keys.end());
+
+    if (NULL != query->getProj()) {
+        _addKeyMetadata = query->getProj()->wantIndexKey();
+    } else {
+        _addKeyMetadata = false;
+    }
+}
+
+bool BatchedIDHackStage::isEOF() {
+    return _lookedUp && _nextRecordId == _recordIds.size();
+}
+
+void BatchedIDHackStage::lookUpRecordIds() {
+    const bool clustered = _collection->getRecordStore()->isClustered();
+    auto cursor = _accessMethod->newCursor(getOpCtx());
+    boost::optional<IndexKeyEntry> entry;
+    bool positioned = false;
+
+    for (const BSONObj& key : _keys) {
+        if (clustered) {
+            auto swRecordId = clusteredid::keyForId(key.firstElement());
+            if (swRecordId.isOK()) {
+                _recordIds.push_back(swRecordId.getValue());
+                continue;
+            }
+        }
+
+        // The cursor may already be on or past 'key'. Otherwise, when the values are dense the
+        // next entry is likely to be 'key', and stepping to it is cheaper than a seek.
+        int cmp = -1;
+        if (positioned) {
+            cmp = compareKeys(entry->key, key);
+            if (cmp < 0) {
+                entry = cursor->next();
+                if (!entry)
+                    break;
+                ++_specificStats.keysExamined;
+                cmp = compareKeys(entry->key, key);
+            }
+        }
+
+        if (cmp < 0) {
+            entry = cursor->seek(key, true);
+            if (!entry)
+                break;
+            ++_specificStats.keysExamined;
+            positioned = true;
+            cmp = compareKeys(entry->key, key);
+        }
+
+        if (cmp == 0)
+            _recordIds.push_back(entry->loc);
+    }
+
+    std::sort(_recordIds.begin(), _recordIds.end());
+}
+
+PlanStage::StageState BatchedIDHackStage::doWork(WorkingSetID* out) {
+    if (isEOF()) {
+        return PlanStage::IS_EOF;
+    }
+
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    try {
+        if (!_lookedUp) {
+            lookUpRecordIds();
+            _lookedUp = true;
+            return PlanStage::NEED_TIME;
+        }
+
+        id = _workingSet->allocate();
+        WorkingSetMember* member = _workingSet->get(id);
+        member->recordId = _recordIds[_nextRecordId];
+        _workingSet->transitionToRecordIdAndIdx(id);
+
+        if (!_recordCursor)
+            _recordCursor = _collection->getCursor(getOpCtx());
+
+        ++_specificStats.docsExamined;
+
+        // A document may have been deleted while yielding.
+        if (!WorkingSetCommon::fetch(getOpCtx(), _workingSet, id, _recordCursor)) {
+            _workingSet->free(id);
+            ++_nextRecordId;
+            return PlanStage::NEED_TIME;
+        }
+        ++_nextRecordId;
+
+        if (_addKeyMetadata) {
+            BSONObj ownedKeyObj = member->obj.value()["_id"].wrap().getOwned();
+            member->addComputed(new IndexKeyComputedData(
+                IndexKeyComputedData::rehydrateKey(BSON("_id" << 1), ownedKeyObj)));
+        }
+
+        *out = id;
+        return PlanStage::ADVANCED;
+    } catch (const WriteConflictException&) {
+        // Retry the lookup or the fetch of the current document.
+        _recordCursor.reset();
+        if (!_lookedUp) {
+            _recordIds.clear();
+            _specificStats.keysExamined = 0;
+        }
+        if (id != WorkingSet::INVALID_ID)
+            _workingSet->free(id);
+
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+}
+
+void BatchedIDHackStage::doSaveState() {
+    if (_recordCursor)
+        _recordCursor->saveUnpositioned();
+}
+
+void BatchedIDHackStage::doRestoreState() {
+    if (_recordCursor)
+        _recordCursor->restore();
+}
+
+void BatchedIDHackStage::doDetachFromOperationContext() {
+    if (_recordCursor)
+        _recordCursor->detachFromOperationContext();
+}
+
+void BatchedIDHackStage::doReattachToOperationContext() {
+    if (_recordCursor)
+        _recordCursor->reattachToOperationContext(getOpCtx());
+}
+
+// static
+bool BatchedIDHackStage::supportsQuery(Collection* collection, const CanonicalQuery& query) {
+    const auto& qr = query.getQueryRequest();
+    if (qr.showRecordId() || !qr.getHint().isEmpty() || qr.getSkip() || qr.getLimit() ||
+        qr.getNToReturn() || !qr.getSort().isEmpty() || !qr.getMin().isEmpty() ||
+        !qr.getMax().isEmpty() || qr.isTailable()) {
+        return false;
+    }
+
+    // The values are probed in the _id index as they are, so no collation may apply.
+    if (query.getCollator() || collection->getDefaultCollator()) {
+        return false;
+    }
+
+    const BSONObj& filter = qr.getFilter();
+    if (filter.nFields() != 1) {
+        return false;
+    }
+    BSONElement idElt = filter.firstElement();
+    if (idElt.fieldNameStringData() != "_id" || idElt.type() != Object) {
+        return false;
+    }
+    BSONObj idObj = idElt.Obj();
+    if (idObj.nFields() != 1 || idObj.firstElement().fieldNameStringData() != "$in" ||
+        idObj.firstElement().type() != Array) {
+        return false;
+    }
+
+    const int minKeys = internalQueryBatchedIdHackMinKeys.load();
+    BSONObj values = idObj.firstElement().Obj();
+    if (minKeys == 0 || values.nFields() < minKeys) {
+        return false;
+    }
+    for (auto&& value : values) {
+        if (!Indexability::isExactBoundsGenerating(value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+unique_ptr<PlanStageStats> BatchedIDHackStage::getStats() {
+    _commonStats.isEOF = isEOF();
+    unique_ptr<PlanStageStats> ret =
+        make_unique<PlanStageStats>(_commonStats, STAGE_BATCHED_IDHACK);
+    ret->specific = make_unique<IDHackStats>(_specificStats);
+    return ret;
+}
+
+const SpecificStats* BatchedIDHackStage::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
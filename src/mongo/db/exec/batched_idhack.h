@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2013-2014 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+
+class IndexAccessMethod;
+class RecordCursor;
+
+/**
+ * The fast path of IDHackStage for queries of the form {_id: {$in: [...]}}. All values are looked
+ * up up front: they are sorted so that a single cursor over the _id index advances through them
+ * in order, and the RecordIds found are sorted so that the documents are then read in RecordId
+ * order. Results are therefore returned in RecordId order.
+ *
+ * Like the IDHackStage it is only used when the query has no collation, as the values are probed
+ * in the _id index as they are.
+ */
+class BatchedIDHackStage final : public PlanStage {
+public:
+    BatchedIDHackStage(OperationContext* opCtx,
+                       const Collection* collection,
+                       CanonicalQuery* query,
+                       WorkingSet* ws,
+                       const IndexDescriptor* descriptor);
+
+    bool isEOF() final;
+    StageState doWork(WorkingSetID* out) final;
+
+    void doSaveState() final;
+    void doRestoreState() final;
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+    /**
+     * Returns true if 'query' is an $in over at least internalQueryBatchedIdHackMinKeys _id
+     * values which otherwise meets the criteria of IDHackStage::supportsQuery().
+     */
+    static bool supportsQuery(Collection* collection, const CanonicalQuery& query);
+
+    StageType stageType() const final {
+        return STAGE_BATCHED_IDHACK;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats();
+
+    const SpecificStats* getSpecificStats() const final;
+
+    static const char* kStageType;
+
+private:
+    /**
+     * Fills '_recordIds' with the sorted RecordIds of the documents whose _id is in '_keys'.
+     */
+    void lookUpRecordIds();
+
+    // Not owned here.
+    const Collection* _collection;
+
+    std::unique_ptr<SeekableRecordCursor> _recordCursor;
+
+    // The WorkingSet we annotate with results.  Not owned by us.
+    WorkingSet* _workingSet;
+
+    // Not owned here.
+    const IndexAccessMethod* _accessMethod;
+
+    // The values to match against the _id field, each as an index key with an empty field name,
+    // sorted and without duplicates.
+    std::vector<BSONObj> _keys;
+
+    // Filled in by the first call to doWork().
+    bool _lookedUp = false;
+    std::vector<RecordId> _recordIds;
+    size_t _nextRecordId = 0;
+
+    // Do we need to add index key metadata for returnKey?
+    bool _addKeyMetadata;
+
+    IDHackStats _specificStats;
+};
+
+}  // namespace mongo
@@ -38,8 +38,13 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/optime.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 
@@ -51,6 +56,41 @@ using std::unique_ptr;
 using std::vector;
 using stdx::make_unique;
 
+namespace {
+
+// Records are handed to the filter worker threads in chunks of at least this many, so that
+// scheduling overhead stays small relative to the matching work.
+const size_t kMinRecordsPerFilterTask = 64;
+
+/**
+ * Returns the pool shared by all collection scans for concurrent filter evaluation, starting it on
+ * first use. The pool is intentionally leaked so that it is never torn down underneath a scan
+ * during shutdown.
+ */
+ThreadPool* getFilterWorkerPool() {
+    static ThreadPool* pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "CollScanFilterWorkers";
+        options.threadNamePrefix = "collScanFilter-";
+        options.minThreads = 0;
+        options.maxThreads =
+            static_cast<size_t>(std::max(1, internalQueryCollScanFilterWorkerThreads));
+        auto newPool = new ThreadPool(options);
+        newPool->startup();
+        return newPool;
+    }();
+    return pool;
+}
+
+bool shouldUseConcurrentFilter(const CollectionScanParams& params, const MatchExpression* filter) {
+    return filter && params.allowConcurrentFilterEvaluation &&
+        internalQueryCollScanFilterWorkerThreads > 0 && !params.tailable &&
+        !params.maxTs && params.start.isNull() && !params.shouldTrackLatestOplogTimestamp &&
+        !params.stopApplyingFilterAfterFirstMatch;
+}
+
+}  // namespace
+
 // static
 const char* CollectionScan::kStageType = "COLLSCAN";
 
@@ -61,8 +101,10 @@ CollectionScan::CollectionScan(OperationContext* opCtx,
     : PlanStage(kStageType, opCtx),
       _workingSet(workingSet),
       _filter(filter),
+      _filterPrefetch(filter ? TopLevelFieldPrefetch::compile(filter) : nullptr),
       _params(params),
-      _isDead(false) {
+      _isDead(false),
+      _useConcurrentFilter(shouldUseConcurrentFilter(params, filter)) {
     // Explain reports the direction of the collection scan.
     _specificStats.direction = params.direction;
     _specificStats.maxTs = params.maxTs;
@@ -140,7 +182,11 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             return PlanStage::NEED_TIME;
         }
 
-        if (_lastSeenId.isNull() && !_params.start.isNull()) {
+        if (_useConcurrentFilter) {
+            if (_bufferedPos == _bufferedMatches.size() && !_cursorExhausted) {
+                fillAndMatchBuffer();
+            }
+        } else if (_lastSeenId.isNull() && !_params.start.isNull()) {
             record = _cursor->seekExact(_params.start);
         } else {
             record = _cursor->next();
@@ -153,7 +199,15 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::NEED_YIELD;
     }
 
+    if (_useConcurrentFilter) {
+        return returnNextBuffered(out);
+    }
+
     if (!record) {
+        if (_params.tailable && _params.shouldTrackLatestOplogTimestamp) {
+            advanceLatestOplogEntryTimestampAtEOF();
+        }
+
         // We just hit EOF. If we are tailable and have already returned data, leave us in a
         // state to pick up where we left off on the next call to work(). Otherwise EOF is
         // permanent.
@@ -193,16 +247,150 @@ Status CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
                                     << record.data.toBson().toString());
         return status;
     }
-    _latestOplogEntryTimestamp = std::max(_latestOplogEntryTimestamp, tsElem.timestamp());
+
+    // Oplog entries are read in timestamp order, so an entry at or before the latest timestamp
+    // means this scan already reported progress past it, which only a rollback or a failover can
+    // cause. The stream must be resumed rather than return events out of order.
+    if (!_latestOplogEntryTimestamp.isNull() && tsElem.timestamp() <= _latestOplogEntryTimestamp) {
+        return {ErrorCodes::RetryChangeStream,
+                str::stream() << "Found oplog entry at " << tsElem.timestamp().toString()
+                              << " after reporting progress through "
+                              << _latestOplogEntryTimestamp.toString()};
+    }
+    _latestOplogEntryTimestamp = tsElem.timestamp();
     return Status::OK();
 }
 
+void CollectionScan::advanceLatestOplogEntryTimestampAtEOF() {
+    auto visibleThrough = getOpCtx()->recoveryUnit()->getOplogVisibilityTimestamp();
+    if (!visibleThrough) {
+        return;
+    }
+    _latestOplogEntryTimestamp = std::max(_latestOplogEntryTimestamp, *visibleThrough);
+    if (auto idleTimestamp = repl::getIdleOplogTimestamp(getOpCtx(), *visibleThrough)) {
+        _latestOplogEntryTimestamp = std::max(_latestOplogEntryTimestamp, *idleTimestamp);
+    }
+}
+
+void CollectionScan::fillAndMatchBuffer() {
+    if (_bufferedMatches.size() == _bufferedRecords.size()) {
+        // The previous batch has been fully consumed, so start a new one.
+        _bufferedRecords.clear();
+        _bufferedMatches.clear();
+        _bufferedPos = 0;
+    }
+
+    if (_bufferedRecords.empty()) {
+        // If filling this batch is interrupted by a yield, the batch ends up spanning several
+        // snapshots. Tagging all of its records with the oldest one is conservative, as consumers
+        // re-validate documents whose snapshot is no longer current.
+        _bufferedSnapshotId = getOpCtx()->recoveryUnit()->getSnapshotId();
+    }
+
+    const size_t batchSize = static_cast<size_t>(internalQueryCollScanFilterBatchSize.load());
+    while (_bufferedRecords.size() < batchSize) {
+        auto record = _cursor->next();
+        if (!record) {
+            _cursorExhausted = true;
+            break;
+        }
+        // The record must outlive the cursor's position, since it is matched after the cursor
+        // has moved on.
+        record->data.makeOwned();
+        _bufferedRecords.push_back(std::move(*record));
+    }
+
+    const size_t numRecords = _bufferedRecords.size();
+    _bufferedMatches.assign(numRecords, 0);
+    if (numRecords == 0) {
+        return;
+    }
+
+    const size_t numWorkers =
+        static_cast<size_t>(std::max(1, internalQueryCollScanFilterWorkerThreads));
+    const size_t numTasks = std::min(
+        numWorkers + 1, (numRecords + kMinRecordsPerFilterTask - 1) / kMinRecordsPerFilterTask);
+    const size_t recordsPerTask = (numRecords + numTasks - 1) / numTasks;
+
+    auto matchRange = [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            _bufferedMatches[i] = TopLevelFieldPrefetch::matchesBSON(
+                _filter, _bufferedRecords[i].data.toBson(), _filterPrefetch.get());
+        }
+    };
+
+    stdx::mutex mutex;
+    stdx::condition_variable allDone;
+    size_t tasksRemaining = 0;
+
+    // The first chunk is matched on this thread while the workers handle the rest.
+    for (size_t task = 1; task < numTasks; ++task) {
+        const size_t begin = task * recordsPerTask;
+        const size_t end = std::min(numRecords, begin + recordsPerTask);
+        if (begin >= end) {
+            break;
+        }
+
+        {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            ++tasksRemaining;
+        }
+        Status scheduled = getFilterWorkerPool()->schedule([&, begin, end] {
+            matchRange(begin, end);
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            if (--tasksRemaining == 0) {
+                allDone.notify_one();
+            }
+        });
+        if (!scheduled.isOK()) {
+            // The pool is shutting down; fall back to matching the chunk here.
+            matchRange(begin, end);
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            --tasksRemaining;
+        }
+    }
+
+    matchRange(0, std::min(numRecords, recordsPerTask));
+
+    stdx::unique_lock<stdx::mutex> lk(mutex);
+    allDone.wait(lk, [&] { return tasksRemaining == 0; });
+}
+
+PlanStage::StageState CollectionScan::returnNextBuffered(WorkingSetID* out) {
+    while (_bufferedPos < _bufferedMatches.size()) {
+        const size_t pos = _bufferedPos++;
+        ++_specificStats.docsTested;
+        if (!_bufferedMatches[pos]) {
+            continue;
+        }
+
+        Record& record = _bufferedRecords[pos];
+        _lastSeenId = record.id;
+
+        WorkingSetID id = _workingSet->allocate();
+        WorkingSetMember* member = _workingSet->get(id);
+        member->recordId = record.id;
+        member->obj = {_bufferedSnapshotId, record.data.releaseToBson()};
+        _workingSet->transitionToRecordIdAndObj(id);
+
+        *out = id;
+        return PlanStage::ADVANCED;
+    }
+
+    if (_cursorExhausted) {
+        _commonStats.isEOF = true;
+        return PlanStage::IS_EOF;
+    }
+
+    return PlanStage::NEED_TIME;
+}
+
 PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
                                                       WorkingSetID memberID,
                                                       WorkingSetID* out) {
     ++_specificStats.docsTested;
 
-    if (Filter::passes(member, _filter)) {
+    if (Filter::passes(member, _filter, _filterPrefetch.get())) {
         if (_params.stopApplyingFilterAfterFirstMatch) {
             _filter = nullptr;
         }
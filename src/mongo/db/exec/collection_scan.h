@@ -29,15 +29,17 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/top_level_field_prefetch.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/storage/record_store.h"
 
 namespace mongo {
 
-struct Record;
 class SeekableRecordCursor;
 class WorkingSet;
 class OperationContext;
@@ -91,12 +93,38 @@ private:
      */
     Status setLatestOplogEntryTimestamp(const Record& record);
 
+    /**
+     * Called when a tailable oplog scan reaches the end of what it can see. Advances
+     * '_latestOplogEntryTimestamp' to the oplog visibility point of the storage snapshot, or past
+     * it to the current cluster time if the oplog is idle, since no later entry can be at or
+     * before either.
+     */
+    void advanceLatestOplogEntryTimestampAtEOF();
+
+    /**
+     * Reads up to internalQueryCollScanFilterBatchSize records into '_bufferedRecords' and then
+     * evaluates '_filter' against all of them on the filter worker threads. May throw
+     * WriteConflictException while reading, in which case the records read so far are kept and
+     * the next call resumes filling the batch.
+     */
+    void fillAndMatchBuffer();
+
+    /**
+     * Returns the next buffered record which passed the filter, or IS_EOF/NEED_TIME when the
+     * buffer is exhausted.
+     */
+    StageState returnNextBuffered(WorkingSetID* out);
+
     // WorkingSet is not owned by us.
     WorkingSet* _workingSet;
 
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // Locates the fields read by '_filter' in one scan of each record. Null when the filter reads
+    // fewer than two top-level fields.
+    const std::unique_ptr<TopLevelFieldPrefetch> _filterPrefetch;
+
     // If a document does not pass '_filter' but passes '_endCondition', stop scanning and return
     // IS_EOF.
     BSONObj _endConditionBSON;
@@ -110,6 +138,18 @@ private:
 
     RecordId _lastSeenId;  // Null if nothing has been returned from _cursor yet.
 
+    // Set if the filter is evaluated over batches of records on the filter worker threads rather
+    // than one record at a time on the operation's thread.
+    const bool _useConcurrentFilter;
+
+    // Records read ahead of the consumer when '_useConcurrentFilter' is set. Once a batch is
+    // complete, '_bufferedMatches[i]' is non-zero if '_bufferedRecords[i]' passed the filter.
+    std::vector<Record> _bufferedRecords;
+    std::vector<char> _bufferedMatches;
+    size_t _bufferedPos = 0;
+    SnapshotId _bufferedSnapshotId;
+    bool _cursorExhausted = false;
+
     // If _params.shouldTrackLatestOplogTimestamp is set and the collection is the oplog, the latest
     // timestamp seen in the collection.  Otherwise, this is a null timestamp.
     Timestamp _latestOplogEntryTimestamp;
@@ -68,6 +68,10 @@ struct CollectionScanParams {
 
     // Whether or not to wait for oplog visibility on oplog collection scans.
     bool shouldWaitForOplogVisibility = false;
+
+    // May the filter be evaluated on the collection scan filter worker threads? Only set this when
+    // the filter has no per-operation state, e.g. no $where, $expr or collation.
+    bool allowConcurrentFilterEvaluation = false;
 };
 
 }  // namespace mongo
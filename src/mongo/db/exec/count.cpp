@@ -31,8 +31,10 @@
 #include "mongo/db/exec/count.h"
 
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/exec/count_scan.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
 
 namespace mongo {
@@ -113,6 +115,12 @@ PlanStage::StageState CountStage::doWork(WorkingSetID* out) {
     // For cases where we can't ask the record store directly, we should always have a child stage
     // from which we can retrieve results.
     invariant(child());
+
+    const long long countScanBatchSize = internalQueryCountScanBatchSize.load();
+    if (countScanBatchSize > 1 && STAGE_COUNT_SCAN == child()->stageType()) {
+        return countScanBatch(countScanBatchSize);
+    }
+
     WorkingSetID id = WorkingSet::INVALID_ID;
     PlanStage::StageState state = child()->work(&id);
 
@@ -148,6 +156,28 @@ PlanStage::StageState CountStage::doWork(WorkingSetID* out) {
     return PlanStage::NEED_TIME;
 }
 
+PlanStage::StageState CountStage::countScanBatch(long long batchSize) {
+    // Never examine more keys than could still be skipped or counted, so that the limit is not
+    // overshot even if every key is for a distinct record.
+    long long maxKeys = batchSize;
+    if (_params.limit > 0) {
+        maxKeys = std::min(maxKeys, _leftToSkip + _params.limit - _specificStats.nCounted);
+    }
+
+    long long nFound = 0;
+    const StageState state = static_cast<CountScan*>(child().get())->countBatch(maxKeys, &nFound);
+
+    const long long nSkipped = std::min(nFound, _leftToSkip);
+    _leftToSkip -= nSkipped;
+    _specificStats.nSkipped += nSkipped;
+    _specificStats.nCounted += nFound - nSkipped;
+
+    if (PlanStage::IS_EOF == state) {
+        _commonStats.isEOF = true;
+    }
+    return state;
+}
+
 unique_ptr<PlanStageStats> CountStage::getStats() {
     _commonStats.isEOF = isEOF();
     unique_ptr<PlanStageStats> ret = make_unique<PlanStageStats>(_commonStats, STAGE_COUNT);
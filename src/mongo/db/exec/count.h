@@ -99,6 +99,12 @@ private:
      */
     void recordStoreCount();
 
+    /**
+     * Has a COUNT_SCAN child count a batch of up to 'batchSize' index keys in one call, applying
+     * the skip and limit to the result.
+     */
+    StageState countScanBatch(long long batchSize);
+
     // The collection over which we are counting.
     Collection* _collection;
 
@@ -95,6 +95,37 @@ CountScan::CountScan(OperationContext* opCtx, CountScanParams params, WorkingSet
 }
 
 PlanStage::StageState CountScan::doWork(WorkingSetID* out) {
+    bool counted = false;
+    const StageState state = advance(&counted);
+    if (PlanStage::NEED_YIELD == state) {
+        *out = WorkingSet::INVALID_ID;
+    }
+    if (PlanStage::NEED_TIME != state || !counted) {
+        return state;
+    }
+
+    WorkingSetID id = _workingSet->allocate();
+    _workingSet->transitionToRecordIdAndObj(id);
+    *out = id;
+    return PlanStage::ADVANCED;
+}
+
+PlanStage::StageState CountScan::countBatch(long long maxKeys, long long* nCounted) {
+    for (long long i = 0; i < maxKeys; ++i) {
+        bool counted = false;
+        const StageState state = advance(&counted);
+        if (PlanStage::NEED_TIME != state) {
+            return state;
+        }
+        if (counted) {
+            ++*nCounted;
+            ++_commonStats.advanced;
+        }
+    }
+    return PlanStage::NEED_TIME;
+}
+
+PlanStage::StageState CountScan::advance(bool* counted) {
     if (_commonStats.isEOF)
         return PlanStage::IS_EOF;
 
@@ -118,7 +149,6 @@ PlanStage::StageState CountScan::doWork(WorkingSetID* out) {
             // Release our cursor and try again next time.
             _cursor.reset();
         }
-        *out = WorkingSet::INVALID_ID;
         return PlanStage::NEED_YIELD;
     }
 
@@ -130,15 +160,9 @@ PlanStage::StageState CountScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    if (_shouldDedup && !_returned.insert(entry->loc).second) {
-        // *loc was already in _returned.
-        return PlanStage::NEED_TIME;
-    }
-
-    WorkingSetID id = _workingSet->allocate();
-    _workingSet->transitionToRecordIdAndObj(id);
-    *out = id;
-    return PlanStage::ADVANCED;
+    // If *loc was already in _returned, this key does not add to the count.
+    *counted = !_shouldDedup || _returned.insert(entry->loc).second;
+    return PlanStage::NEED_TIME;
 }
 
 bool CountScan::isEOF() {
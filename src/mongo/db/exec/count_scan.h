@@ -106,6 +106,17 @@ public:
     CountScan(OperationContext* opCtx, CountScanParams params, WorkingSet* workingSet);
 
     StageState doWork(WorkingSetID* out) final;
+
+    /**
+     * Examines up to 'maxKeys' index keys and adds the number of distinct records among them to
+     * '*nCounted', without producing a WorkingSetMember for each. Returns IS_EOF once the end of
+     * the range has been reached, NEED_YIELD if a write conflict interrupted the batch (keys
+     * examined before the conflict are still counted), and NEED_TIME otherwise.
+     *
+     * Used by CountStage in place of work() so that counting a range does not pay for a full trip
+     * through the stage tree per key.
+     */
+    StageState countBatch(long long maxKeys, long long* nCounted);
     bool isEOF() final;
     void doSaveState() final;
     void doRestoreState() final;
@@ -123,6 +134,12 @@ public:
     static const char* kStageType;
 
 private:
+    /**
+     * Moves the cursor to the next key in the range. Returns NEED_TIME if it landed on a key, in
+     * which case '*counted' is set to whether that key belongs to a record not seen before.
+     */
+    StageState advance(bool* counted);
+
     // The WorkingSet we annotate with results.  Not owned by us.
     WorkingSet* _workingSet;
 
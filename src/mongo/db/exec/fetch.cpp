@@ -30,11 +30,15 @@
 
 #include "mongo/db/exec/fetch.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/mongoutils/str.h"
@@ -57,7 +61,9 @@ FetchStage::FetchStage(OperationContext* opCtx,
       _collection(collection),
       _ws(ws),
       _filter(filter),
-      _idRetrying(WorkingSet::INVALID_ID) {
+      _filterPrefetch(filter ? TopLevelFieldPrefetch::compile(filter) : nullptr),
+      _idRetrying(WorkingSet::INVALID_ID),
+      _batchSize(internalQueryFetchBatchSize.load()) {
     _children.emplace_back(child);
 }
 
@@ -69,6 +75,11 @@ bool FetchStage::isEOF() {
         return false;
     }
 
+    if (_batchPosition < _batch.size()) {
+        // There are fetched members left to return, or members left to fetch.
+        return false;
+    }
+
     return child()->isEOF();
 }
 
@@ -77,6 +88,10 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_batchSize > 0) {
+        return doWorkBatched(out);
+    }
+
     // Either retry the last WSM we worked on or get a new one from our child.
     WorkingSetID id;
     StageState status;
@@ -131,6 +146,102 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::doWorkBatched(WorkingSetID* out) {
+    if (_batchFetched) {
+        // Return the members of the batch in the order of the child, which may be the sort order
+        // of the plan.
+        while (_batchPosition < _batch.size()) {
+            const WorkingSetID id = _batch[_batchPosition++];
+            if (WorkingSet::INVALID_ID != id) {
+                return returnIfMatches(_ws->get(id), id, out);
+            }
+        }
+
+        _batch.clear();
+        _batchPosition = 0;
+        _batchFetched = false;
+    }
+
+    if (_batch.size() < _batchSize && !child()->isEOF()) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        const StageState status = child()->work(&id);
+
+        if (PlanStage::ADVANCED == status) {
+            WorkingSetMember* member = _ws->get(id);
+            if (member->hasObj()) {
+                ++_specificStats.alreadyHasObj;
+            } else {
+                // We need a valid RecordId to fetch from and this is the only state that has one.
+                verify(WorkingSetMember::RID_AND_IDX == member->getState());
+                verify(member->hasRecordId());
+            }
+            _batch.push_back(id);
+        } else if (PlanStage::FAILURE == status || PlanStage::DEAD == status) {
+            // The stage which produces a failure is responsible for allocating a working set member
+            // with error details.
+            invariant(WorkingSet::INVALID_ID != id);
+            *out = id;
+            return status;
+        } else if (PlanStage::NEED_YIELD == status) {
+            *out = id;
+            return status;
+        } else if (PlanStage::NEED_TIME == status) {
+            return status;
+        }
+
+        if (_batch.size() < _batchSize && !child()->isEOF()) {
+            return PlanStage::NEED_TIME;
+        }
+    }
+
+    if (_batch.empty()) {
+        return PlanStage::IS_EOF;
+    }
+    return fetchBatch(out);
+}
+
+PlanStage::StageState FetchStage::fetchBatch(WorkingSetID* out) {
+    // Visit the members in RecordId order, so the record store is read front to back.
+    std::vector<size_t> order(_batch.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+        return _ws->get(_batch[lhs])->recordId < _ws->get(_batch[rhs])->recordId;
+    });
+
+    try {
+        if (!_cursor)
+            _cursor = _collection->getCursor(getOpCtx());
+
+        for (size_t i : order) {
+            const WorkingSetID id = _batch[i];
+            WorkingSetMember* member = _ws->get(id);
+            if (member->hasObj()) {
+                continue;
+            }
+
+            if (!WorkingSetCommon::fetch(getOpCtx(), _ws, id, _cursor)) {
+                _ws->free(id);
+                _batch[i] = WorkingSet::INVALID_ID;
+                continue;
+            }
+
+            // The document must outlive the next read of the cursor.
+            member->makeObjOwnedIfNeeded();
+        }
+    } catch (const WriteConflictException&) {
+        // The members fetched so far own their documents and are skipped when the batch is
+        // resumed after the yield. Forget the members which were freed.
+        _batch.erase(std::remove(_batch.begin(), _batch.end(), WorkingSet::INVALID_ID),
+                     _batch.end());
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    ++_specificStats.batchesFetched;
+    _batchFetched = true;
+    return NEED_TIME;
+}
+
 void FetchStage::doSaveState() {
     if (_cursor)
         _cursor->saveUnpositioned();
@@ -170,7 +281,7 @@ PlanStage::StageState FetchStage::returnIfMatches(WorkingSetMember* member,
     // predicate.
     ++_specificStats.docsExamined;
 
-    if (Filter::passes(member, _filter)) {
+    if (Filter::passes(member, _filter, _filterPrefetch.get())) {
         *out = memberID;
         return PlanStage::ADVANCED;
     } else {
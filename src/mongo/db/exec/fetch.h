@@ -29,10 +29,12 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/top_level_field_prefetch.h"
 #include "mongo/db/record_id.h"
 
 namespace mongo {
@@ -82,6 +84,19 @@ private:
      */
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
+    /**
+     * doWork() when '_batchSize' is positive: collects up to '_batchSize' members from the child,
+     * reads their documents in RecordId order, then returns them in the order of the child.
+     */
+    StageState doWorkBatched(WorkingSetID* out);
+
+    /**
+     * Reads the documents of the members in '_batch' which do not have one yet, in RecordId order.
+     * Members whose document is gone are freed and replaced by WorkingSet::INVALID_ID. Returns
+     * NEED_YIELD on a write conflict, in which case calling it again resumes the batch.
+     */
+    StageState fetchBatch(WorkingSetID* out);
+
     // Collection which is used by this stage. Used to resolve record ids retrieved by child
     // stages. The lifetime of the collection must supersede that of the stage.
     const Collection* _collection;
@@ -94,9 +109,23 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // Locates the fields read by '_filter' in one scan of each fetched document. Null when the
+    // filter reads fewer than two top-level fields.
+    const std::unique_ptr<TopLevelFieldPrefetch> _filterPrefetch;
+
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // The number of members fetched together, see 'internalQueryFetchBatchSize'. Zero when each
+    // member is fetched as soon as the child returns it.
+    const size_t _batchSize;
+
+    // The members of the current batch in the order the child returned them, whether they are
+    // waiting for their documents or waiting to be returned from '_batchPosition' on.
+    std::vector<WorkingSetID> _batch;
+    size_t _batchPosition = 0;
+    bool _batchFetched = false;
+
     // Stats
     FetchStats _specificStats;
 };
@@ -31,6 +31,7 @@
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/matchable.h"
+#include "mongo/db/matcher/top_level_field_prefetch.h"
 
 namespace mongo {
 
@@ -157,6 +158,24 @@ public:
         return filter->matches(&doc, NULL);
     }
 
+    /**
+     * Like passes() above, but if 'wsm' has an object and 'prefetch' is non-null, the fields read
+     * by 'filter' are located through 'prefetch', which must have been compiled from 'filter'.
+     */
+    static bool passes(WorkingSetMember* wsm,
+                       const MatchExpression* filter,
+                       const TopLevelFieldPrefetch* prefetch) {
+        if (NULL == filter) {
+            return true;
+        }
+        if (prefetch && wsm->hasObj()) {
+            PrefetchedBSONMatchableDocument doc(wsm->obj.value(), *prefetch);
+            return filter->matches(&doc, NULL);
+        }
+        WorkingSetMatchableDocument doc(wsm);
+        return filter->matches(&doc, NULL);
+    }
+
     static bool passes(const BSONObj& keyData,
                        const BSONObj& keyPattern,
                        const MatchExpression* filter) {
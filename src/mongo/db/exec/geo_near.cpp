@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/geo_near.h"
 
+#include <cmath>
 #include <memory>
 #include <vector>
 
@@ -797,6 +798,35 @@ GeoNear2DSphereStage::~GeoNear2DSphereStage() {}
 
 namespace {
 
+// The number of results each search annulus aims to return.
+const double kTargetResultsPerInterval = 450;
+
+/**
+ * Returns the width of the annulus to search after 'lastBounds', which was 'lastIncrement' wide
+ * and returned 'numResults' results. The width is chosen so that the next annulus returns about
+ * kTargetResultsPerInterval results if the documents past 'lastBounds' are as dense as those
+ * within it, which keeps a dense area from being searched by many annuli that are far too narrow
+ * or a sparse one by annuli that are far too wide. The width changes by at most a factor of four
+ * per interval, since the density may change sharply from one annulus to the next.
+ */
+double nextSphereBoundsIncrement(const R2Annulus& lastBounds,
+                                 double lastIncrement,
+                                 long long numResults) {
+    const double kMaxGrowth = 4;
+    const double inner = std::max(0.0, lastBounds.getInner());
+    const double outer = lastBounds.getOuter();
+    const double lastArea = outer * outer - inner * inner;
+    if (numResults == 0 || lastArea <= 0) {
+        return lastIncrement * 2;
+    }
+
+    // Flat annuli are a good enough approximation to size the next annulus by.
+    const double density = numResults / lastArea;
+    const double nextOuter = std::sqrt(outer * outer + kTargetResultsPerInterval / density);
+    return std::max(lastIncrement / kMaxGrowth,
+                    std::min(lastIncrement * kMaxGrowth, nextOuter - outer));
+}
+
 S2Region* buildS2Region(const R2Annulus& sphereBounds) {
     // Internal bounds come in SPHERE CRS units
     // i.e. center is lon/lat, inner/outer are in meters
@@ -1032,12 +1062,8 @@ StatusWith<NearStage::CoveredInterval*>  //
 
     if (!_specificStats.intervalStats.empty()) {
         const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
+        _boundsIncrement = nextSphereBoundsIncrement(
+            _currBounds, _boundsIncrement, lastIntervalStats.numResultsReturned);
     }
 
     invariant(_boundsIncrement > 0.0);
@@ -1084,7 +1110,8 @@ StatusWith<NearStage::CoveredInterval*>  //
     _scannedCells.Add(cover);
 
     OrderedIntervalList* coveredIntervals = &scanParams.bounds.fields[s2FieldPosition];
-    ExpressionMapping::S2CellIdsToIntervalsWithParents(cover, _indexParams, coveredIntervals);
+    ExpressionMapping::S2CellIdsToIntervalsWithParents(
+        cover, _indexParams, coveredIntervals, &_scannedParentCells);
 
     IndexScan* scan = new IndexScan(opCtx, scanParams, workingSet, nullptr);
 
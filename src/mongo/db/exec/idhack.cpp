@@ -38,6 +38,7 @@
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/exec/working_set_computed_data.h"
 #include "mongo/db/index/btree_access_method.h"
+#include "mongo/db/storage/clustered_id.h"
 #include "mongo/stdx/memory.h"
 
 namespace mongo {
@@ -99,16 +100,31 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
 
     WorkingSetID id = WorkingSet::INVALID_ID;
     try {
-        // Look up the key by going directly to the index.
-        RecordId recordId = _accessMethod->findSingle(getOpCtx(), _key);
+        // A clustered collection stores the document under a RecordId derived from its _id, so
+        // the index need not be consulted.
+        RecordId recordId;
+        bool clusteredLookup = false;
+        if (_collection->getRecordStore()->isClustered()) {
+            auto swRecordId = clusteredid::keyForId(_key.firstElement());
+            if (swRecordId.isOK()) {
+                recordId = swRecordId.getValue();
+                clusteredLookup = true;
+            }
+        }
 
-        // Key not found.
-        if (recordId.isNull()) {
-            _done = true;
-            return PlanStage::IS_EOF;
+        if (!clusteredLookup) {
+            // Look up the key by going directly to the index.
+            recordId = _accessMethod->findSingle(getOpCtx(), _key);
+
+            // Key not found.
+            if (recordId.isNull()) {
+                _done = true;
+                return PlanStage::IS_EOF;
+            }
+
+            ++_specificStats.keysExamined;
         }
 
-        ++_specificStats.keysExamined;
         ++_specificStats.docsExamined;
 
         // Create a new WSM for the result document.
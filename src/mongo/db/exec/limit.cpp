@@ -78,6 +78,26 @@ PlanStage::StageState LimitStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState LimitStage::doWorkBatch(size_t maxWorks,
+                                              WorkingSet* ws,
+                                              std::vector<WorkingSetID>* results,
+                                              WorkingSetID* out) {
+    if (0 == _numToReturn) {
+        ++_commonStats.works;
+        return PlanStage::IS_EOF;
+    }
+
+    // Never let the child produce results beyond our limit.
+    const CommonStats childStatsBefore = *child()->getCommonStats();
+    const size_t numBefore = results->size();
+    StageState status = child()->workBatch(
+        std::min(maxWorks, static_cast<size_t>(_numToReturn)), ws, results, out);
+
+    _numToReturn -= results->size() - numBefore;
+    recordBatchStats(childStatsBefore, 0);
+    return status;
+}
+
 unique_ptr<PlanStageStats> LimitStage::getStats() {
     _commonStats.isEOF = isEOF();
     unique_ptr<PlanStageStats> ret = make_unique<PlanStageStats>(_commonStats, STAGE_LIMIT);
@@ -45,6 +45,7 @@
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_ranker.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -205,10 +206,15 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
     size_t numWorks = getTrialPeriodWorks(getOpCtx(), _collection);
     size_t numResults = getTrialPeriodNumToReturn(*_query);
 
+    // Working each plan several times in a row keeps its cursors and working set members warm
+    // between works, at the cost of detecting the end of the trial period less promptly.
+    const size_t worksPerPlan =
+        std::min(numWorks, static_cast<size_t>(internalQueryPlanEvaluationWorksPerBatch.load()));
+
     // Work the plans, stopping when a plan hits EOF or returns some
     // fixed number of results.
-    for (size_t ix = 0; ix < numWorks; ++ix) {
-        bool moreToDo = workAllPlans(numResults, yieldPolicy);
+    for (size_t ix = 0; ix < numWorks; ix += worksPerPlan) {
+        bool moreToDo = workAllPlans(numResults, worksPerPlan, yieldPolicy);
         if (!moreToDo) {
             break;
         }
@@ -332,7 +338,9 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
     return Status::OK();
 }
 
-bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolicy) {
+bool MultiPlanStage::workAllPlans(size_t numResults,
+                                  size_t worksPerPlan,
+                                  PlanYieldPolicy* yieldPolicy) {
     bool doneWorking = false;
 
     for (size_t ix = 0; ix < _candidates.size(); ++ix) {
@@ -347,21 +355,29 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
         }
 
         WorkingSetID id = WorkingSet::INVALID_ID;
-        PlanStage::StageState state = candidate.root->work(&id);
-
-        if (PlanStage::ADVANCED == state) {
-            // Save result for later.
-            WorkingSetMember* member = candidate.ws->get(id);
-            // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we choose to
-            // return the results from the 'candidate' plan.
-            member->makeObjOwnedIfNeeded();
-            candidate.results.push(id);
-
-            // Once a plan returns enough results, stop working.
-            if (candidate.results.size() >= numResults) {
-                doneWorking = true;
+        PlanStage::StageState state = PlanStage::NEED_TIME;
+        for (size_t works = 0; works < worksPerPlan; ++works) {
+            id = WorkingSet::INVALID_ID;
+            state = candidate.root->work(&id);
+            if (PlanStage::ADVANCED == state) {
+                // Save result for later.
+                WorkingSetMember* member = candidate.ws->get(id);
+                // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we
+                // choose to return the results from the 'candidate' plan.
+                member->makeObjOwnedIfNeeded();
+                candidate.results.push(id);
+
+                // Once a plan returns enough results, stop working.
+                if (candidate.results.size() >= numResults) {
+                    doneWorking = true;
+                    break;
+                }
+            } else if (PlanStage::NEED_TIME != state) {
+                break;
             }
-        } else if (PlanStage::IS_EOF == state) {
+        }
+
+        if (PlanStage::IS_EOF == state) {
             // First plan to hit EOF wins automatically.  Stop evaluating other plans.
             // Assumes that the ranking will pick this plan.
             doneWorking = true;
@@ -378,7 +394,7 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
             if (!(tryYield(yieldPolicy)).isOK()) {
                 return false;
             }
-        } else if (PlanStage::NEED_TIME != state) {
+        } else if (PlanStage::ADVANCED != state && PlanStage::NEED_TIME != state) {
             // FAILURE or DEAD.  Do we want to just tank that plan and try the rest?  We
             // probably want to fail globally as this shouldn't happen anyway.
 
@@ -159,12 +159,12 @@ private:
     //
 
     /**
-     * Calls work on each child plan in a round-robin fashion. We stop when any plan hits EOF
-     * or returns 'numResults' results.
+     * Calls work on each child plan in a round-robin fashion, 'worksPerPlan' times per plan in
+     * a row. We stop when any plan hits EOF or returns 'numResults' results.
      *
      * Returns true if we need to keep working the plans and false otherwise.
      */
-    bool workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolicy);
+    bool workAllPlans(size_t numResults, size_t worksPerPlan, PlanYieldPolicy* yieldPolicy);
 
     /**
      * Checks whether we need to perform either a timing-based yield or a yield for a document
@@ -76,14 +76,11 @@ PlanStage::StageState OrStage::doWork(WorkingSetID* out) {
             ++_specificStats.dupsTested;
 
             // ...and we've seen the RecordId before
-            if (_seen.end() != _seen.find(member->recordId)) {
+            if (!_seen.insert(member->recordId)) {
                 // ...drop it.
                 ++_specificStats.dupsDropped;
                 _ws->free(id);
                 return PlanStage::NEED_TIME;
-            } else {
-                // Otherwise, note that we've seen it.
-                _seen.insert(member->recordId);
             }
         }
 
@@ -114,6 +114,14 @@ unique_ptr<PlanStageStats> PipelineProxyStage::getStats() {
     return ret;
 }
 
+size_t PipelineProxyStage::getMemUsage() const {
+    size_t memUsage = _pipeline->getMemUsage();
+    for (auto&& obj : _stash) {
+        memUsage += obj.objsize();
+    }
+    return memUsage;
+}
+
 boost::optional<BSONObj> PipelineProxyStage::getNextBson() {
     if (auto next = _pipeline->getNext()) {
         if (_includeMetaData) {
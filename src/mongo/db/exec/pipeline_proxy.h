@@ -68,6 +68,8 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    size_t getMemUsage() const final;
+
     /**
      * Pass through the last oplog timestamp from the proxied pipeline.
      */
@@ -56,6 +56,61 @@ PlanStage::StageState PlanStage::work(WorkingSetID* out) {
     return workResult;
 }
 
+PlanStage::StageState PlanStage::workBatch(size_t maxWorks,
+                                           WorkingSet* ws,
+                                           std::vector<WorkingSetID>* results,
+                                           WorkingSetID* out) {
+    invariant(_opCtx);
+    invariant(maxWorks > 0);
+    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+    return doWorkBatch(maxWorks, ws, results, out);
+}
+
+PlanStage::StageState PlanStage::doWorkBatch(size_t maxWorks,
+                                             WorkingSet* ws,
+                                             std::vector<WorkingSetID>* results,
+                                             WorkingSetID* out) {
+    StageState workResult = NEED_TIME;
+    for (size_t i = 0; i < maxWorks; ++i) {
+        // The previous result may point at storage data that this unit of work invalidates.
+        if (StageState::ADVANCED == workResult) {
+            ws->get(results->back())->makeObjOwnedIfNeeded();
+        }
+
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        ++_commonStats.works;
+        workResult = doWork(&id);
+
+        if (StageState::ADVANCED == workResult) {
+            ++_commonStats.advanced;
+            results->push_back(id);
+        } else if (StageState::NEED_TIME == workResult) {
+            ++_commonStats.needTime;
+        } else {
+            if (StageState::NEED_YIELD == workResult) {
+                ++_commonStats.needYield;
+            }
+            *out = id;
+            return workResult;
+        }
+    }
+
+    return workResult;
+}
+
+void PlanStage::recordBatchStats(const CommonStats& childStatsBefore,
+                                 size_t numDropped,
+                                 size_t numDiscarded) {
+    const CommonStats* childStats = child()->getCommonStats();
+    const size_t childAdvanced = childStats->advanced - childStatsBefore.advanced;
+    invariant(childAdvanced >= numDropped + numDiscarded);
+
+    _commonStats.works += childStats->works - childStatsBefore.works - numDiscarded;
+    _commonStats.advanced += childAdvanced - numDropped - numDiscarded;
+    _commonStats.needTime += childStats->needTime - childStatsBefore.needTime + numDropped;
+    _commonStats.needYield += childStats->needYield - childStatsBefore.needYield;
+}
+
 void PlanStage::saveState() {
     ++_commonStats.yields;
     for (auto&& child : _children) {
@@ -187,6 +187,23 @@ public:
      */
     StageState work(WorkingSetID* out);
 
+    /**
+     * Performs up to 'maxWorks' units of work in a single call, appending the WorkingSetID of each
+     * result to 'results' in the order the results were produced. This amortizes the per-call
+     * overhead of work() for callers which consume many results at a time. 'ws' is the working
+     * set the results are allocated in; every result but the last is owned, since the storage
+     * data it may point to does not survive the works that follow it.
+     *
+     * The batch ends on the first state other than ADVANCED or NEED_TIME, which is returned with
+     * *out populated exactly as work() would have populated it. Otherwise the state of the last
+     * unit of work is returned. Either way, any results appended to 'results' precede the returned
+     * state.
+     */
+    StageState workBatch(size_t maxWorks,
+                         WorkingSet* ws,
+                         std::vector<WorkingSetID>* results,
+                         WorkingSetID* out);
+
     /**
      * Returns true if no more work can be done on the query / out of results.
      */
@@ -325,12 +342,47 @@ public:
      */
     virtual const SpecificStats* getSpecificStats() const = 0;
 
+    /**
+     * Returns an estimate of the number of bytes of data buffered by this stage and its children,
+     * such as the results accumulated by a blocking sort. Stages which buffer data override this
+     * to add their own usage to that of their children.
+     */
+    virtual size_t getMemUsage() const {
+        size_t memUsage = 0;
+        for (auto&& child : _children) {
+            memUsage += child->getMemUsage();
+        }
+        return memUsage;
+    }
+
 protected:
     /**
      * Performs one unit of work.  See comment at work() above.
      */
     virtual StageState doWork(WorkingSetID* out) = 0;
 
+    /**
+     * Performs up to 'maxWorks' units of work. See comment at workBatch() above.
+     *
+     * The default implementation calls doWork() repeatedly. Stages which do one unit of work per
+     * unit of work of their only child may override this to pull whole batches from the child,
+     * using recordBatchStats() to keep their stats identical to those work() would produce.
+     */
+    virtual StageState doWorkBatch(size_t maxWorks,
+                                   WorkingSet* ws,
+                                   std::vector<WorkingSetID>* results,
+                                   WorkingSetID* out);
+
+    /**
+     * Credits this stage with one unit of work for every unit of work its child has performed
+     * since 'childStatsBefore' was captured. 'numDropped' of the child's ADVANCED results were
+     * consumed by this stage without being returned and count as NEED_TIME instead, and
+     * 'numDiscarded' of them were never looked at because the batch ended early.
+     */
+    void recordBatchStats(const CommonStats& childStatsBefore,
+                          size_t numDropped,
+                          size_t numDiscarded = 0);
+
     /**
      * Saves any stage-specific state required to resume where it was if the underlying data
      * changes.
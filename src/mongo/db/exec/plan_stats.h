@@ -341,6 +341,9 @@ struct FetchStats : public SpecificStats {
 
     // The total number of full documents touched by the fetch stage.
     size_t docsExamined = 0u;
+
+    // How many batches of RecordIds were read in RecordId order.
+    size_t batchesFetched = 0u;
 };
 
 struct GroupStats : public SpecificStats {
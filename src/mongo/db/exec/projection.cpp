@@ -216,6 +216,39 @@ PlanStage::StageState ProjectionStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState ProjectionStage::doWorkBatch(size_t maxWorks,
+                                                   WorkingSet* ws,
+                                                   std::vector<WorkingSetID>* results,
+                                                   WorkingSetID* out) {
+    const CommonStats childStatsBefore = *child()->getCommonStats();
+    const size_t numBefore = results->size();
+    StageState status = child()->workBatch(maxWorks, ws, results, out);
+
+    for (size_t i = numBefore; i < results->size(); ++i) {
+        // Punt to our specific projection impl.
+        Status projStatus = transform(_ws->get((*results)[i]));
+        if (!projStatus.isOK()) {
+            warning() << "Couldn't execute projection, status = " << redact(projStatus);
+
+            // Results from the failed one onwards are never returned. The failed transformation
+            // still counts as one unit of work, as it does in doWork().
+            const size_t numDiscarded = results->size() - i;
+            for (size_t j = i; j < results->size(); ++j) {
+                _ws->free((*results)[j]);
+            }
+            results->resize(i);
+            recordBatchStats(childStatsBefore, 0, numDiscarded);
+            ++_commonStats.works;
+
+            *out = WorkingSetCommon::allocateStatusMember(_ws, projStatus);
+            return PlanStage::FAILURE;
+        }
+    }
+
+    recordBatchStats(childStatsBefore, 0);
+    return status;
+}
+
 unique_ptr<PlanStageStats> ProjectionStage::getStats() {
     _commonStats.isEOF = isEOF();
     unique_ptr<PlanStageStats> ret = make_unique<PlanStageStats>(_commonStats, STAGE_PROJECTION);
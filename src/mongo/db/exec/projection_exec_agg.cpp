@@ -92,7 +92,8 @@ public:
     }
 
     BSONObj applyProjection(BSONObj inputDoc) const {
-        return applyTransformation(Document{inputDoc}).toBson();
+        // Computed fields are banned, so the projection can copy what it keeps straight from BSON.
+        return _projection->applyProjectionToBson(inputDoc);
     }
 
     bool applyProjectionToOneField(StringData field) const {
@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+
+#include <algorithm>
+
+namespace mongo {
+
+namespace {
+
+constexpr size_t kChunkSize = 1 << 16;
+constexpr size_t kBitsPerWord = 64;
+
+}  // namespace
+
+bool RecordIdBitmap::insert(const RecordId& id) {
+    if (!_chunks[_chunkKey(id)].insert(_lowBits(id))) {
+        return false;
+    }
+    ++_size;
+    return true;
+}
+
+bool RecordIdBitmap::contains(const RecordId& id) const {
+    auto it = _chunks.find(_chunkKey(id));
+    return it != _chunks.end() && it->second.contains(_lowBits(id));
+}
+
+void RecordIdBitmap::clear() {
+    _chunks.clear();
+    _size = 0;
+}
+
+size_t RecordIdBitmap::memUsage() const {
+    size_t usage = sizeof(*this);
+    for (auto&& chunk : _chunks) {
+        usage += sizeof(chunk) + chunk.second.memUsage();
+    }
+    return usage;
+}
+
+bool RecordIdBitmap::Chunk::insert(uint16_t low) {
+    if (!_bitmap.empty()) {
+        uint64_t& word = _bitmap[low / kBitsPerWord];
+        const uint64_t bit = uint64_t(1) << (low % kBitsPerWord);
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+        return true;
+    }
+
+    auto it = std::lower_bound(_array.begin(), _array.end(), low);
+    if (it != _array.end() && *it == low) {
+        return false;
+    }
+
+    if (_array.size() < kMaxArraySize) {
+        _array.insert(it, low);
+        return true;
+    }
+
+    // The chunk became dense, so switch to the bitmap.
+    _bitmap.assign(kChunkSize / kBitsPerWord, 0);
+    for (uint16_t value : _array) {
+        _bitmap[value / kBitsPerWord] |= uint64_t(1) << (value % kBitsPerWord);
+    }
+    _bitmap[low / kBitsPerWord] |= uint64_t(1) << (low % kBitsPerWord);
+    std::vector<uint16_t>().swap(_array);
+    return true;
+}
+
+bool RecordIdBitmap::Chunk::contains(uint16_t low) const {
+    if (!_bitmap.empty()) {
+        return _bitmap[low / kBitsPerWord] & (uint64_t(1) << (low % kBitsPerWord));
+    }
+    return std::binary_search(_array.begin(), _array.end(), low);
+}
+
+size_t RecordIdBitmap::Chunk::memUsage() const {
+    return _array.capacity() * sizeof(uint16_t) + _bitmap.capacity() * sizeof(uint64_t);
+}
+
+}  // namespace mongo
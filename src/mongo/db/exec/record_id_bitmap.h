@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+/**
+ * A set of RecordIds kept as a compressed bitmap, in the style of a Roaring bitmap.
+ *
+ * The RecordId space is split into chunks of 2^16 consecutive values. A chunk holding few
+ * RecordIds keeps the low 16 bits of each in a sorted array. Once that array would outgrow a
+ * bitmap of the whole chunk, the chunk switches to the bitmap. RecordIds close to each other, such
+ * as the ones storage engines hand out in insertion order, then cost between 1 and 16 bits each
+ * rather than a hash table node.
+ */
+class RecordIdBitmap {
+public:
+    /**
+     * Adds 'id' to the set. Returns true if it was not in the set yet.
+     */
+    bool insert(const RecordId& id);
+
+    bool contains(const RecordId& id) const;
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    void clear();
+
+    /**
+     * Returns the approximate number of bytes used by the set.
+     */
+    size_t memUsage() const;
+
+private:
+    /**
+     * The RecordIds of the set which share all but their low 16 bits.
+     */
+    class Chunk {
+    public:
+        bool insert(uint16_t low);
+
+        bool contains(uint16_t low) const;
+
+        size_t memUsage() const;
+
+    private:
+        // An array of this many values takes as much space as a bitmap of the whole chunk.
+        static constexpr size_t kMaxArraySize = 4096;
+
+        // Sorted low bits of the RecordIds in the chunk, while it is sparse.
+        std::vector<uint16_t> _array;
+
+        // One bit per value of the chunk, once it is dense. Empty until then.
+        std::vector<uint64_t> _bitmap;
+    };
+
+    static int64_t _chunkKey(const RecordId& id) {
+        return id.repr() >> 16;
+    }
+
+    static uint16_t _lowBits(const RecordId& id) {
+        return static_cast<uint16_t>(id.repr() & 0xFFFF);
+    }
+
+    stdx::unordered_map<int64_t, Chunk> _chunks;
+    size_t _size = 0;
+};
+
+}  // namespace mongo
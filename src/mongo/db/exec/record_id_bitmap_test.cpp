@@ -0,0 +1,98 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(RecordIdBitmapTest, InsertReportsDuplicates) {
+    RecordIdBitmap bitmap;
+    ASSERT_TRUE(bitmap.empty());
+    ASSERT_TRUE(bitmap.insert(RecordId(1)));
+    ASSERT_FALSE(bitmap.insert(RecordId(1)));
+    ASSERT_TRUE(bitmap.insert(RecordId(2)));
+    ASSERT_EQ(2U, bitmap.size());
+    ASSERT_FALSE(bitmap.empty());
+}
+
+TEST(RecordIdBitmapTest, ContainsOnlyInsertedRecordIds) {
+    RecordIdBitmap bitmap;
+    for (int64_t i = 1; i < 1000; i += 7) {
+        bitmap.insert(RecordId(i));
+    }
+    for (int64_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(i % 7 == 1, bitmap.contains(RecordId(i))) << i;
+    }
+}
+
+TEST(RecordIdBitmapTest, RecordIdsFarApartUseSeparateChunks) {
+    RecordIdBitmap bitmap;
+    const std::vector<int64_t> values = {
+        -(int64_t(1) << 40), -1, 0, 65535, 65536, int64_t(1) << 40, RecordId::max().repr()};
+    for (auto value : values) {
+        ASSERT_TRUE(bitmap.insert(RecordId(value))) << value;
+    }
+    ASSERT_EQ(values.size(), bitmap.size());
+    for (auto value : values) {
+        ASSERT_TRUE(bitmap.contains(RecordId(value))) << value;
+        ASSERT_FALSE(bitmap.contains(RecordId(value - 1))) << value;
+    }
+}
+
+TEST(RecordIdBitmapTest, DenseChunkKeepsItsRecordIds) {
+    RecordIdBitmap bitmap;
+    const int64_t kNumRecordIds = 20000;
+    for (int64_t i = 0; i < kNumRecordIds; ++i) {
+        ASSERT_TRUE(bitmap.insert(RecordId(2 * i + 1)));
+    }
+    ASSERT_EQ(static_cast<size_t>(kNumRecordIds), bitmap.size());
+    for (int64_t i = 0; i < 2 * kNumRecordIds + 2; ++i) {
+        ASSERT_EQ(i % 2 == 1, bitmap.contains(RecordId(i))) << i;
+    }
+    ASSERT_FALSE(bitmap.insert(RecordId(1)));
+
+    // A dense chunk costs one bit per value it covers.
+    ASSERT_LT(bitmap.memUsage(), 2 * kNumRecordIds * sizeof(uint16_t));
+}
+
+TEST(RecordIdBitmapTest, ClearEmptiesTheSet) {
+    RecordIdBitmap bitmap;
+    bitmap.insert(RecordId(5));
+    bitmap.clear();
+    ASSERT_TRUE(bitmap.empty());
+    ASSERT_FALSE(bitmap.contains(RecordId(5)));
+    ASSERT_TRUE(bitmap.insert(RecordId(5)));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -81,6 +81,34 @@ PlanStage::StageState SkipStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState SkipStage::doWorkBatch(size_t maxWorks,
+                                             WorkingSet* ws,
+                                             std::vector<WorkingSetID>* results,
+                                             WorkingSetID* out) {
+    const CommonStats childStatsBefore = *child()->getCommonStats();
+    const size_t numBefore = results->size();
+    StageState status = child()->workBatch(maxWorks, ws, results, out);
+
+    // Drop the results we are still skipping from the front of the child's batch.
+    const size_t numToDrop = std::min(static_cast<size_t>(_toSkip), results->size() - numBefore);
+    if (numToDrop > 0) {
+        auto dropBegin = results->begin() + numBefore;
+        auto dropEnd = dropBegin + numToDrop;
+        for (auto it = dropBegin; it != dropEnd; ++it) {
+            _ws->free(*it);
+        }
+        results->erase(dropBegin, dropEnd);
+        _toSkip -= numToDrop;
+
+        if (PlanStage::ADVANCED == status && results->size() == numBefore) {
+            status = PlanStage::NEED_TIME;
+        }
+    }
+
+    recordBatchStats(childStatsBefore, numToDrop);
+    return status;
+}
+
 unique_ptr<PlanStageStats> SkipStage::getStats() {
     _commonStats.isEOF = isEOF();
     _specificStats.skip = _toSkip;
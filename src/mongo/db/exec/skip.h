@@ -48,6 +48,10 @@ public:
 
     bool isEOF() final;
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(size_t maxWorks,
+                           WorkingSet* ws,
+                           std::vector<WorkingSetID>* results,
+                           WorkingSetID* out) final;
 
     StageType stageType() const final {
         return STAGE_SKIP;
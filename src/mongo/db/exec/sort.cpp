@@ -190,6 +190,10 @@ const SpecificStats* SortStage::getSpecificStats() const {
     return &_specificStats;
 }
 
+size_t SortStage::getMemUsage() const {
+    return _memUsage + PlanStage::getMemUsage();
+}
+
 /**
  * addToBuffer() and sortBuffer() work differently based on the
  * configured limit. addToBuffer() is also responsible for
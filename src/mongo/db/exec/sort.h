@@ -85,6 +85,8 @@ public:
 
     const SpecificStats* getSpecificStats() const final;
 
+    size_t getMemUsage() const final;
+
     static const char* kStageType;
 
 private:
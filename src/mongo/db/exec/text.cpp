@@ -123,6 +123,19 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* opCtx,
 
         textScorer->addChildren(std::move(indexScanList));
 
+        // If only the best scoring documents are wanted, the TEXT_OR stage can avoid fetching
+        // documents which cannot be among them. This requires that the TEXT_MATCH stage will not
+        // reject any of the documents it returns, which holds when every document containing a
+        // positive term matches.
+        const auto& query = _params.query;
+        const auto& terms = query.getTermsForBounds();
+        if (_params.topK && !filter && !query.getCaseSensitive() &&
+            !query.getDiacriticSensitive() && query.getNegatedTerms().empty() &&
+            query.getPositivePhr().empty() && query.getNegatedPhr().empty() &&
+            terms.size() <= 64) {
+            textScorer->setTopK(_params.topK, std::vector<std::string>(terms.begin(), terms.end()));
+        }
+
         textMatchStage = make_unique<TextMatchStage>(
             opCtx, std::move(textScorer), _params.query, _params.spec, ws);
     } else {
@@ -63,6 +63,9 @@ struct TextStageParams {
     // True if we need the text score in the output, because the projection includes the 'textScore'
     // metadata field.
     bool wantTextScore = true;
+
+    // If non-zero, the parent sorts by the text score and keeps only this many documents.
+    size_t topK = 0;
 };
 
 /**
@@ -28,6 +28,8 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <algorithm>
+#include <functional>
 #include <map>
 #include <vector>
 
@@ -78,6 +80,19 @@ void TextOrStage::addChildren(Children childrenToAdd) {
                      std::make_move_iterator(childrenToAdd.end()));
 }
 
+void TextOrStage::setTopK(size_t limit, std::vector<std::string> terms) {
+    invariant(limit > 0);
+    invariant(!_filter);
+    invariant(terms.size() == _children.size());
+    invariant(_children.size() <= 64);
+
+    _topK = limit;
+    _terms = std::move(terms);
+    _childMaxScores.assign(_children.size(), fts::MAX_WEIGHT);
+    _childEOF.assign(_children.size(), false);
+    _nextTopKCheck = limit;
+}
+
 bool TextOrStage::isEOF() {
     return _internalState == State::kDone;
 }
@@ -142,7 +157,7 @@ PlanStage::StageState TextOrStage::doWork(WorkingSetID* out) {
             stageState = readFromChildren(out);
             break;
         case State::kReturningResults:
-            stageState = returnResults(out);
+            stageState = _topK ? returnTopKResults(out) : returnResults(out);
             break;
         case State::kDone:
             // Should have been handled above.
@@ -174,6 +189,13 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
     invariant(_currentChild < _children.size());
 
+    // Reading resumes after a missed candidate even if all children are already exhausted.
+    if (_topK && _numChildrenEOF == _children.size()) {
+        invariant(collectTopKCandidates());
+        _internalState = State::kReturningResults;
+        return PlanStage::NEED_TIME;
+    }
+
     // Either retry the last WSM we worked on or get a new one from our current child.
     WorkingSetID id;
     StageState childState;
@@ -186,7 +208,21 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
 
     if (PlanStage::ADVANCED == childState) {
-        return addTerm(id, out);
+        return _topK ? addTermBound(id) : addTerm(id, out);
+    } else if (PlanStage::IS_EOF == childState && _topK) {
+        // Done with this child. No more keys can come from it.
+        _childEOF[_currentChild] = true;
+        _childMaxScores[_currentChild] = 0;
+        ++_numChildrenEOF;
+
+        if (_numChildrenEOF < _children.size()) {
+            advanceToNextChild();
+            return PlanStage::NEED_TIME;
+        }
+
+        invariant(collectTopKCandidates());
+        _internalState = State::kReturningResults;
+        return PlanStage::NEED_TIME;
     } else if (PlanStage::IS_EOF == childState) {
         // Done with this child.
         ++_currentChild;
@@ -245,6 +281,185 @@ PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
     return PlanStage::ADVANCED;
 }
 
+PlanStage::StageState TextOrStage::returnTopKResults(WorkingSetID* out) {
+    if (_nextCandidate == _candidates.size()) {
+        if (_candidatesPruned && _missedCandidate) {
+            // A document which was left out of the candidates may belong in the top-k after all,
+            // so read the remaining keys and return every document that has not been returned.
+            _internalState = State::kReadingTerms;
+            return PlanStage::NEED_TIME;
+        }
+        _internalState = State::kDone;
+        return PlanStage::IS_EOF;
+    }
+
+    const RecordId& recordId = _candidates[_nextCandidate];
+    boost::optional<Record> record;
+    try {
+        record = _recordCursor->seekExact(recordId);
+    } catch (const WriteConflictException&) {
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
+    ++_nextCandidate;
+    ++_specificStats.fetches;
+
+    // Mark the document as returned, so that reading resumed after a missed candidate skips it.
+    TextRecordData* textRecordData = &_scores[recordId];
+    double score = textRecordData->score;
+    textRecordData->score = -1;
+
+    if (!record) {
+        _missedCandidate = true;
+        return PlanStage::NEED_TIME;
+    }
+
+    WorkingSetID wsid = _ws->allocate();
+    WorkingSetMember* wsm = _ws->get(wsid);
+    wsm->recordId = recordId;
+    wsm->obj = {getOpCtx()->recoveryUnit()->getSnapshotId(), record->data.releaseToBson()};
+    _ws->transitionToRecordIdAndObj(wsid);
+    wsm->makeObjOwnedIfNeeded();
+
+    // A partial score is only complete if every child was exhausted before the candidates were
+    // collected.
+    if (_stoppedEarly) {
+        score = scoreDocument(wsm->obj.value());
+    }
+
+    wsm->addComputed(new TextScoreComputedData(score));
+    *out = wsid;
+    return PlanStage::ADVANCED;
+}
+
+PlanStage::StageState TextOrStage::addTermBound(WorkingSetID wsid) {
+    WorkingSetMember* wsm = _ws->get(wsid);
+    invariant(wsm->getState() == WorkingSetMember::RID_AND_IDX);
+    invariant(1 == wsm->keyData.size());
+    const double documentTermScore = getKeyTermScore(wsm->keyData.back().keyData);
+    TextRecordData* textRecordData = &_scores[wsm->recordId];
+    _ws->free(wsid);
+
+    // Keys arrive in descending score order, so no later key from this child scores higher.
+    _childMaxScores[_currentChild] = documentTermScore;
+
+    // A negative score marks a document which has already been returned.
+    if (textRecordData->score >= 0) {
+        textRecordData->score += documentTermScore;
+        textRecordData->childrenSeen |= uint64_t{1} << _currentChild;
+    }
+
+    advanceToNextChild();
+
+    // Testing whether reading can stop costs a pass over the documents seen so far, so test after
+    // reading geometrically growing numbers of keys.
+    if (++_keysRead >= _nextTopKCheck) {
+        _nextTopKCheck *= 2;
+        if (collectTopKCandidates()) {
+            _internalState = State::kReturningResults;
+        }
+    }
+    return PlanStage::NEED_TIME;
+}
+
+void TextOrStage::advanceToNextChild() {
+    for (size_t i = 1; i <= _children.size(); ++i) {
+        const size_t child = (_currentChild + i) % _children.size();
+        if (!_childEOF[child]) {
+            _currentChild = child;
+            return;
+        }
+    }
+}
+
+bool TextOrStage::collectTopKCandidates() {
+    const bool exhausted = _numChildrenEOF == _children.size();
+    if (!exhausted && _missedCandidate) {
+        return false;
+    }
+
+    // Find the lowest partial score that is still in the top-k. Partial scores only grow, so every
+    // top-k document scores at least this much.
+    double minScore = 0;
+    if (!_missedCandidate) {
+        std::vector<double> scores;
+        for (auto&& entry : _scores) {
+            if (entry.second.score >= 0) {
+                scores.push_back(entry.second.score);
+            }
+        }
+        if (scores.size() >= _topK) {
+            std::nth_element(scores.begin(),
+                             scores.begin() + (_topK - 1),
+                             scores.end(),
+                             std::greater<double>());
+            minScore = scores[_topK - 1];
+        } else if (!exhausted) {
+            return false;
+        }
+    }
+
+    // A document which has not been seen yet scores at most the sum of the children's bounds.
+    double unseenMaxScore = 0;
+    for (double childMaxScore : _childMaxScores) {
+        unseenMaxScore += childMaxScore;
+    }
+    if (unseenMaxScore > minScore) {
+        return false;
+    }
+
+    // Keep the documents whose partial scores, plus the bounds of the children they have not been
+    // read from, could still reach the top-k.
+    _candidates.clear();
+    _nextCandidate = 0;
+    _candidatesPruned = !_missedCandidate;
+    _stoppedEarly = !exhausted;
+    for (auto&& entry : _scores) {
+        const TextRecordData& textRecordData = entry.second;
+        if (textRecordData.score < 0) {
+            continue;
+        }
+
+        double maxScore = textRecordData.score;
+        for (size_t i = 0; i < _children.size(); ++i) {
+            if (!(textRecordData.childrenSeen & (uint64_t{1} << i))) {
+                maxScore += _childMaxScores[i];
+            }
+        }
+        if (maxScore >= minScore) {
+            _candidates.push_back(entry.first);
+        }
+    }
+    return true;
+}
+
+double TextOrStage::scoreDocument(const BSONObj& obj) const {
+    fts::TermFrequencyMap termScores;
+    _ftsSpec.scoreDocument(obj, &termScores);
+
+    double score = 0;
+    for (auto&& term : _terms) {
+        auto it = termScores.find(term);
+        if (it != termScores.end()) {
+            score += it->second;
+        }
+    }
+    return score;
+}
+
+double TextOrStage::getKeyTermScore(const BSONObj& key) const {
+    // Locate score within possibly compound key: {prefix,term,score,suffix}.
+    BSONObjIterator keyIt(key);
+    for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
+        keyIt.next();
+    }
+
+    keyIt.next();  // Skip past 'term'.
+
+    BSONElement scoreElement = keyIt.next();
+    return scoreElement.number();
+}
+
 PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out) {
     WorkingSetMember* wsm = _ws->get(wsid);
     invariant(wsm->getState() == WorkingSetMember::RID_AND_IDX);
@@ -299,16 +514,7 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         wsm = _ws->get(textRecordData->wsid);
     }
 
-    // Locate score within possibly compound key: {prefix,term,score,suffix}.
-    BSONObjIterator keyIt(newKeyData.keyData);
-    for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
-        keyIt.next();
-    }
-
-    keyIt.next();  // Skip past 'term'.
-
-    BSONElement scoreElement = keyIt.next();
-    double documentTermScore = scoreElement.number();
+    double documentTermScore = getKeyTermScore(newKeyData.keyData);
 
     // Aggregate relevance score, term keys.
     textRecordData->score += documentTermScore;
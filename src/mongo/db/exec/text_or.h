@@ -29,6 +29,8 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/plan_stage.h"
@@ -79,6 +81,23 @@ public:
 
     void addChildren(Children childrenToAdd);
 
+    /**
+     * Tells the stage that its parent only needs the 'limit' documents with the highest text
+     * scores. 'terms' are the query terms scanned by each child, in the order of the children.
+     *
+     * Each child scans one term's keys in descending score order, so the score of the last key
+     * read from a child bounds the score of every key it has not returned yet. With a limit, the
+     * stage reads its children in turn and stops reading once no document it has not seen can
+     * score higher than the 'limit'-th best partial score. It then returns only the documents
+     * that could still make the cut, computing their scores from the fetched documents. This saves
+     * fetching every document that matches a common term.
+     *
+     * The returned documents are a superset of the top 'limit', so the parent still has to sort
+     * and limit them. Must be called before the first call to work(), and only on a stage without
+     * a filter whose parent does not reject documents, after all children have been added.
+     */
+    void setTopK(size_t limit, std::vector<std::string> terms);
+
     bool isEOF() final;
 
     StageState doWork(WorkingSetID* out) final;
@@ -122,6 +141,40 @@ private:
      */
     StageState returnResults(WorkingSetID* out);
 
+    /**
+     * Helper called from readFromChildren in place of addTerm when a top-k limit is set. Adds the
+     * term score of the newfound key to the partial score of its document without fetching it.
+     */
+    StageState addTermBound(WorkingSetID wsid);
+
+    /**
+     * Moves _currentChild on to the next child which has not hit EOF, if there is one.
+     */
+    void advanceToNextChild();
+
+    /**
+     * Called when a top-k limit is set. If no document which has not been returned yet can still
+     * reach the top-k, other than those that are already known, fills '_candidates' with the
+     * documents that can and returns true. Always succeeds once all children are exhausted.
+     */
+    bool collectTopKCandidates();
+
+    /**
+     * Worker for kReturningResults when a top-k limit is set. Fetches the next candidate and
+     * returns it with its score.
+     */
+    StageState returnTopKResults(WorkingSetID* out);
+
+    /**
+     * Returns the term score stored in a text index key.
+     */
+    double getKeyTermScore(const BSONObj& key) const;
+
+    /**
+     * Returns the sum of the scores of the query terms in 'obj'.
+     */
+    double scoreDocument(const BSONObj& obj) const;
+
     // The index spec used to determine where to find the score.
     FTSSpec _ftsSpec;
 
@@ -143,12 +196,46 @@ private:
         TextRecordData() : wsid(WorkingSet::INVALID_ID), score(0.0) {}
         WorkingSetID wsid;
         double score;
+
+        // With a top-k limit, a bit for each child the document has been read from.
+        uint64_t childrenSeen = 0;
     };
 
     typedef stdx::unordered_map<RecordId, TextRecordData, RecordId::Hasher> ScoreMap;
     ScoreMap _scores;
     ScoreMap::const_iterator _scoreIterator;
 
+    // The top-k limit, or 0 if all matching documents are returned. See setTopK().
+    size_t _topK = 0;
+
+    // The query term scanned by each child.
+    std::vector<std::string> _terms;
+
+    // With a top-k limit, the score of the last key read from each child, or 0 once it is
+    // exhausted. No key the child has yet to return scores higher.
+    std::vector<double> _childMaxScores;
+    std::vector<bool> _childEOF;
+    size_t _numChildrenEOF = 0;
+
+    // Keys read so far, and how many to read before next testing whether reading can stop.
+    size_t _keysRead = 0;
+    size_t _nextTopKCheck = 0;
+
+    // True if reading stopped before all children were exhausted, in which case the partial
+    // scores in _scores may be missing terms and scores are computed from the documents instead.
+    bool _stoppedEarly = false;
+
+    // True once a candidate had been deleted by the time it was fetched. The top-k may then
+    // include a document that was not a candidate, so from then on the remaining keys are read
+    // and every remaining document is returned.
+    bool _missedCandidate = false;
+
+    // The documents to return with a top-k limit, and whether documents which could not make the
+    // top-k were left out of them.
+    std::vector<RecordId> _candidates;
+    bool _candidatesPruned = false;
+    size_t _nextCandidate = 0;
+
     TextOrStats _specificStats;
 
     // Members needed only for using the TextMatchableDocument.
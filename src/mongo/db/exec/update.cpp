@@ -43,6 +43,7 @@
 #include "mongo/db/op_observer.h"
 #include "mongo/db/ops/update_lifecycle.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/service_context.h"
@@ -346,9 +347,11 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         // it again.  For an example, see the comment above near declaration of
         // updatedRecordIds.
         //
-        // This must be done after the wunit commits so we are sure we won't be rolling back.
+        // This must be done after the wunit commits so we are sure we won't be rolling back. When
+        // batching, the batch's WriteUnitOfWork has yet to commit, so the RecordId is kept with the
+        // batch until it does.
         if (_updatedRecordIds && (newRecordId != recordId || driver->modsAffectIndices())) {
-            _updatedRecordIds->insert(newRecordId);
+            (_inBatch ? _batchRecordIds : *_updatedRecordIds).insert(newRecordId);
         }
     }
 
@@ -479,6 +482,7 @@ bool UpdateStage::doneUpdating() {
     // We're done updating if either the child has no more results to give us, or we've
     // already gotten a result back and we're not a multi-update.
     return _idRetrying == WorkingSet::INVALID_ID && _idReturning == WorkingSet::INVALID_ID &&
+        _idsToRetry.empty() &&
         (child()->isEOF() || (_specificStats.nMatched > 0 && !_params.request->isMulti()));
 }
 
@@ -549,9 +553,14 @@ PlanStage::StageState UpdateStage::doWork(WorkingSetID* out) {
     }
 
     // Either retry the last WSM we worked on or get a new one from our child.
+    if (_idRetrying == WorkingSet::INVALID_ID && !_idsToRetry.empty()) {
+        _idRetrying = _idsToRetry.front();
+        _idsToRetry.pop_front();
+    }
     WorkingSetID id;
     StageState status;
-    if (_idRetrying == WorkingSet::INVALID_ID) {
+    const bool retrying = _idRetrying != WorkingSet::INVALID_ID;
+    if (!retrying) {
         status = child()->work(&id);
     } else {
         status = ADVANCED;
@@ -559,6 +568,10 @@ PlanStage::StageState UpdateStage::doWork(WorkingSetID* out) {
         _idRetrying = WorkingSet::INVALID_ID;
     }
 
+    if (PlanStage::ADVANCED == status && !retrying && canBatchUpdates()) {
+        return doBatchedUpdates(id, out);
+    }
+
     if (PlanStage::ADVANCED == status) {
         // Need to get these things from the result returned by the child.
         RecordId recordId;
@@ -767,4 +780,133 @@ PlanStage::StageState UpdateStage::prepareToRetryWSM(WorkingSetID idToRetry, Wor
     return NEED_YIELD;
 }
 
+bool UpdateStage::canBatchUpdates() const {
+    const UpdateRequest* request = _params.request;
+    return internalUpdateMaxBatchSize.load() > 1 && request->isMulti() &&
+        !request->shouldReturnAnyDocs() && !request->isExplain() &&
+        !request->isFromOplogApplication() && !getOpCtx()->lockState()->inAWriteUnitOfWork() &&
+        repl::ReplicationCoordinator::get(getOpCtx())
+            ->isOplogDisabledFor(getOpCtx(), request->getNamespaceString());
+}
+
+PlanStage::StageState UpdateStage::doBatchedUpdates(WorkingSetID firstId, WorkingSetID* out) {
+    const size_t maxBatchSize = internalUpdateMaxBatchSize.load();
+    const UpdateStats statsBeforeBatch = _specificStats;
+    boost::optional<OpDebug::AdditiveMetrics> metricsBeforeBatch;
+    if (_params.opDebug) {
+        metricsBeforeBatch = _params.opDebug->additiveMetrics;
+    }
+
+    // The members whose documents this batch updated. They are freed once the batch commits.
+    std::vector<WorkingSetID> batchIds;
+    WorkingSetID id = firstId;
+    StageState childStatus = ADVANCED;
+    bool inChildWork = false;
+
+    _inBatch = true;
+    ON_BLOCK_EXIT([this] {
+        _inBatch = false;
+        _batchRecordIds.clear();
+    });
+    try {
+        WriteUnitOfWork wunit(getOpCtx());
+
+        // Each call to our child counts towards the size of the batch, so that a batch which
+        // matches few documents still returns control to the executor often enough to yield.
+        for (size_t childWorks = 1;; ++childWorks) {
+            if (ADVANCED == childStatus) {
+                batchIds.push_back(id);
+                if (!updateBatchMember(id)) {
+                    batchIds.pop_back();
+                    _ws->free(id);
+                }
+            }
+            if (childWorks >= maxBatchSize) {
+                break;
+            }
+            inChildWork = true;
+            childStatus = child()->work(&id);
+            inChildWork = false;
+            if (ADVANCED != childStatus && NEED_TIME != childStatus) {
+                break;
+            }
+        }
+
+        wunit.commit();
+    } catch (const DBException&) {
+        // Undo the accounting of the documents the aborted batch updated.
+        _specificStats = statsBeforeBatch;
+        if (metricsBeforeBatch) {
+            _params.opDebug->additiveMetrics = *metricsBeforeBatch;
+        }
+        // Our child's state is unknown after it throws, so the error is not retried.
+        if (inChildWork) {
+            for (auto&& batchId : batchIds) {
+                _ws->free(batchId);
+            }
+            throw;
+        }
+
+        // Retry each document of the batch on its own. A write conflict is then handled like any
+        // other, and a document which cannot be updated fails the update only once the documents
+        // before it have been.
+        _idsToRetry.insert(_idsToRetry.end(), batchIds.begin(), batchIds.end());
+        if (FAILURE == childStatus) {
+            *out = id;
+            return FAILURE;
+        }
+        *out = NEED_YIELD == childStatus ? id : WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    _updatedRecordIds->insert(_batchRecordIds.begin(), _batchRecordIds.end());
+    for (auto&& batchId : batchIds) {
+        _ws->free(batchId);
+    }
+
+    if (FAILURE == childStatus) {
+        *out = id;
+        if (WorkingSet::INVALID_ID == id) {
+            const std::string errmsg = "update stage failed to read in results from child";
+            *out = WorkingSetCommon::allocateStatusMember(
+                _ws, Status(ErrorCodes::InternalError, errmsg));
+        }
+        return FAILURE;
+    }
+    if (NEED_YIELD == childStatus) {
+        *out = id;
+        return NEED_YIELD;
+    }
+    return NEED_TIME;
+}
+
+bool UpdateStage::updateBatchMember(WorkingSetID id) {
+    WorkingSetMember* member = _ws->get(id);
+    invariant(member->hasRecordId());
+    invariant(member->hasObj());
+    RecordId recordId = member->recordId;
+
+    if (_updatedRecordIds->count(recordId) > 0 || _batchRecordIds.count(recordId) > 0) {
+        return false;
+    }
+    if (!write_stage_common::ensureStillMatches(
+            _collection, getOpCtx(), _ws, id, _params.canonicalQuery)) {
+        return false;
+    }
+
+    member->makeObjOwnedIfNeeded();
+    WorkingSetCommon::prepareForSnapshotChange(_ws);
+    try {
+        child()->saveState();
+    } catch (const WriteConflictException&) {
+        std::terminate();
+    }
+
+    transformAndUpdate(member->obj, recordId);
+    ++_specificStats.nMatched;
+
+    child()->restoreState();
+    return true;
+}
+
 }  // namespace mongo
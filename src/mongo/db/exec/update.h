@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <deque>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/plan_stage.h"
@@ -176,6 +177,27 @@ private:
      */
     StageState prepareToRetryWSM(WorkingSetID idToRetry, WorkingSetID* out);
 
+    /**
+     * Returns whether the documents of this update may be applied several at a time in one
+     * WriteUnitOfWork. This is only the case for a multi-update which is not written to the oplog,
+     * since each replicated update must be timestamped separately.
+     */
+    bool canBatchUpdates() const;
+
+    /**
+     * Updates the document of 'firstId', followed by up to internalUpdateMaxBatchSize - 1 more
+     * documents from the child, all in one WriteUnitOfWork. If the batch fails to commit, every
+     * document in it is queued to be retried on its own. Returns the state that work() should
+     * return, setting 'out' accordingly.
+     */
+    StageState doBatchedUpdates(WorkingSetID firstId, WorkingSetID* out);
+
+    /**
+     * Updates the document of the member 'id' within the batch's WriteUnitOfWork. Returns false
+     * without updating it if the document was already updated or no longer matches.
+     */
+    bool updateBatchMember(WorkingSetID id);
+
     UpdateStageParams _params;
 
     // Not owned by us.
@@ -211,6 +233,16 @@ private:
     typedef stdx::unordered_set<RecordId, RecordId::Hasher> RecordIdSet;
     const std::unique_ptr<RecordIdSet> _updatedRecordIds;
 
+    // True while a batch of updates is being applied in one WriteUnitOfWork. The RecordIds the
+    // batch updates are kept in '_batchRecordIds' and only added to '_updatedRecordIds' once the
+    // batch commits.
+    bool _inBatch = false;
+    RecordIdSet _batchRecordIds;
+
+    // Members of a batch which failed to commit, to be updated one at a time before asking our
+    // child for more results.
+    std::deque<WorkingSetID> _idsToRetry;
+
     // These get reused for each update.
     mutablebson::Document& _doc;
     mutablebson::DamageVector _damages;
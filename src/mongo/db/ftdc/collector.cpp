@@ -42,9 +42,10 @@
 
 namespace mongo {
 
-void FTDCCollectorCollection::add(std::unique_ptr<FTDCCollectorInterface> collector) {
+void FTDCCollectorCollection::add(std::unique_ptr<FTDCCollectorInterface> collector,
+                                  Milliseconds interval) {
     // TODO: ensure the collectors all have unique names.
-    _collectors.emplace_back(std::move(collector));
+    _collectors.push_back({std::move(collector), interval, Date_t(), BSONObj()});
 }
 
 std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
@@ -72,7 +73,17 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
     // Explicitly start future read transactions without a timestamp.
     opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kNoTimestamp);
 
-    for (auto& collector : _collectors) {
+    for (auto& entry : _collectors) {
+        auto& collector = entry.collector;
+
+        // Repeat the last result of a collector whose interval has not elapsed yet, including its
+        // original start and end dates.
+        if (!entry.lastSample.isEmpty() && start < entry.lastCollected + entry.interval) {
+            builder.append(collector->name(), entry.lastSample);
+            end = client->getServiceContext()->getPreciseClockSource()->now();
+            continue;
+        }
+
         BSONObjBuilder subObjBuilder(builder.subobjStart(collector->name()));
 
         // Add a Date_t before and after each BSON is collected so that we can track timing of the
@@ -91,6 +102,12 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
 
         end = client->getServiceContext()->getPreciseClockSource()->now();
         subObjBuilder.appendDate(kFTDCCollectEndField, end);
+
+        if (entry.interval > Milliseconds::zero()) {
+            subObjBuilder.doneFast();
+            entry.lastCollected = start;
+            entry.lastSample = builder.asTempObj()[collector->name()].Obj().getOwned();
+        }
     }
 
     builder.appendDate(kFTDCCollectEndField, end);
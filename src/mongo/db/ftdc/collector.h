@@ -33,12 +33,13 @@
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
-class BSONObj;
 class BSONObjBuilder;
-class Date_t;
 class Client;
 class OperationContext;
 
@@ -86,8 +87,13 @@ public:
     /**
      * Add a metric collector to the collection.
      * Must be called before collect. Cannot be called after collect is called.
+     *
+     * A collector with a non-zero interval is only run once that much time has passed since it
+     * last ran. Samples taken in between repeat its last result, which keeps the schema of the
+     * samples stable so the compressor stores the repeated values as zero deltas.
      */
-    void add(std::unique_ptr<FTDCCollectorInterface> collector);
+    void add(std::unique_ptr<FTDCCollectorInterface> collector,
+             Milliseconds interval = Milliseconds::zero());
 
     /**
      * Collect a sample from all collectors. Called after all adding is complete.
@@ -108,8 +114,19 @@ public:
     std::tuple<BSONObj, Date_t> collect(Client* client);
 
 private:
+    struct CollectorEntry {
+        std::unique_ptr<FTDCCollectorInterface> collector;
+
+        // Minimum time between runs of the collector, or zero to run it for every sample
+        Milliseconds interval;
+
+        // Time at which the collector last ran, and the sub-document it produced
+        Date_t lastCollected;
+        BSONObj lastSample;
+    };
+
     // collection of collectors
-    std::vector<std::unique_ptr<FTDCCollectorInterface>> _collectors;
+    std::vector<CollectorEntry> _collectors;
 };
 
 }  // namespace mongo
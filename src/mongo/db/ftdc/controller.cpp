@@ -109,12 +109,13 @@ Status FTDCController::setDirectory(const boost::filesystem::path& path) {
 }
 
 
-void FTDCController::addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector) {
+void FTDCController::addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector,
+                                          Milliseconds interval) {
     {
         stdx::lock_guard<stdx::mutex> lock(_mutex);
         invariant(_state == State::kNotStarted);
 
-        _periodicCollectors.add(std::move(collector));
+        _periodicCollectors.add(std::move(collector), interval);
     }
 }
 
@@ -107,8 +107,12 @@ public:
 
     /**
      * Add a metric collector to collect periodically. i.e., serverStatus
+     *
+     * A collector given a non-zero interval runs at most once per interval, rather than for every
+     * sample, which lets expensive collectors run less often than the collection period.
      */
-    void addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector);
+    void addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector,
+                              Milliseconds interval = Milliseconds::zero());
 
     /**
      * Add a collector to collect on server start, and file rotation. i.e. hostInfo
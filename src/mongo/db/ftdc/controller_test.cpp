@@ -47,6 +47,7 @@
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/clock_source_mock.h"
 
 namespace mongo {
 
@@ -279,4 +280,48 @@ TEST_F(FTDCControllerTest, TestStartAsDisabled) {
     ValidateDocumentList(alog, allDocs, FTDCValidationMode::kStrict);
 }
 
+class FTDCCounterCollector : public FTDCCollectorInterface {
+public:
+    explicit FTDCCounterCollector(std::string name) : _name(std::move(name)) {}
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) final {
+        builder.append("count", ++_count);
+    }
+
+    std::string name() const final {
+        return _name;
+    }
+
+private:
+    std::string _name;
+    int _count{0};
+};
+
+// Test that a collector with an interval only runs once the interval has passed, and that the
+// samples in between repeat its last result.
+TEST_F(FTDCControllerTest, TestCollectorInterval) {
+    auto clock = static_cast<ClockSourceMock*>(getServiceContext()->getPreciseClockSource());
+
+    FTDCCollectorCollection collectors;
+    collectors.add(stdx::make_unique<FTDCCounterCollector>("fast"));
+    collectors.add(stdx::make_unique<FTDCCounterCollector>("slow"), Milliseconds(1000));
+
+    std::vector<BSONObj> samples;
+    for (int i = 0; i < 25; ++i) {
+        samples.push_back(std::get<0>(collectors.collect(getClient())));
+        clock->advance(Milliseconds(100));
+    }
+
+    for (int i = 0; i < 25; ++i) {
+        ASSERT_EQUALS(i + 1, samples[i]["fast"]["count"].numberInt());
+        ASSERT_EQUALS(i / 10 + 1, samples[i]["slow"]["count"].numberInt());
+
+        // Repeated samples are identical, including their collection dates, so they compress to
+        // zero deltas.
+        if (i % 10 != 0) {
+            ASSERT_BSONOBJ_EQ(samples[i - 1]["slow"].Obj(), samples[i]["slow"].Obj());
+        }
+    }
+}
+
 }  // namespace mongo
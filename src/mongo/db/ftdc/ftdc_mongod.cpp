@@ -36,18 +36,36 @@
 #include "mongo/db/ftdc/controller.h"
 #include "mongo/db/ftdc/ftdc_server.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/storage_options.h"
 
 namespace mongo {
 
 namespace {
+
+// Minimum time between runs of the replication collectors, which take locks and are more
+// expensive than the counters in serverStatus. Zero runs them for every sample.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(diagnosticDataCollectionReplicationPeriodMillis, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "diagnosticDataCollectionReplicationPeriodMillis must be greater than "
+                          "or equal to 0");
+        }
+        return Status::OK();
+    });
+
 void registerMongoDCollectors(FTDCController* controller) {
     // These metrics are only collected if replication is enabled
     if (repl::ReplicationCoordinator::get(getGlobalServiceContext())->getReplicationMode() !=
         repl::ReplicationCoordinator::modeNone) {
+        const Milliseconds interval(diagnosticDataCollectionReplicationPeriodMillis);
+
         // CmdReplSetGetStatus
-        controller->addPeriodicCollector(stdx::make_unique<FTDCSimpleInternalCommandCollector>(
-            "replSetGetStatus", "replSetGetStatus", "", BSON("replSetGetStatus" << 1)));
+        controller->addPeriodicCollector(
+            stdx::make_unique<FTDCSimpleInternalCommandCollector>(
+                "replSetGetStatus", "replSetGetStatus", "", BSON("replSetGetStatus" << 1)),
+            interval);
 
         // CollectionStats
         controller->addPeriodicCollector(
@@ -55,7 +73,8 @@ void registerMongoDCollectors(FTDCController* controller) {
                                                                   "local.oplog.rs.stats",
                                                                   "local",
                                                                   BSON("collStats"
-                                                                       << "oplog.rs")));
+                                                                       << "oplog.rs")),
+            interval);
     }
 }
 
@@ -44,6 +44,17 @@ class FTSSpec;
 
 class FTSIndexFormat {
 public:
+    /**
+     * Generates one key per distinct term of 'document', of the form
+     * {prefix fields, term, weight, suffix fields}.
+     *
+     * The index holds no per-term posting lists. Each document owns its own keys, so a write only
+     * ever inserts or removes the keys of the document being written, and writers of different
+     * documents containing a common term do not conflict. The keys of a term are adjacent and
+     * ordered by weight, so a term scan is a range scan in which the term is repeated in every key.
+     * Storage engines are expected to compress that repetition away. WiredTiger does so with index
+     * prefix compression, which is on by default.
+     */
     static void getKeys(const FTSSpec& spec, const BSONObj& document, BSONObjSet* keys);
 
     /**
@@ -37,6 +37,7 @@
 #include "mongo/db/fts/fts_tokenizer.h"
 #include "mongo/db/fts/fts_util.h"
 #include "mongo/db/matcher/expression_parser.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/stringutils.h"
 
@@ -174,6 +175,25 @@ const FTSLanguage* FTSSpec::_getLanguageToUseV2(const BSONObj& userDoc,
     return swl.getValue();
 }
 
+namespace {
+
+/**
+ * Returns a tokenizer for 'language' owned by the calling thread. Creating a tokenizer sets up a
+ * stemmer, and tokenizers cache the tokens of words they have seen, so threads which score many
+ * documents reuse one tokenizer per language rather than creating one per string.
+ */
+FTSTokenizer* getThreadTokenizer(const FTSLanguage* language) {
+    static thread_local stdx::unordered_map<const FTSLanguage*, std::unique_ptr<FTSTokenizer>>
+        tokenizers;
+    auto& tokenizer = tokenizers[language];
+    if (!tokenizer) {
+        tokenizer = language->createTokenizer();
+    }
+    return tokenizer.get();
+}
+
+}  // namespace
+
 void FTSSpec::scoreDocument(const BSONObj& obj, TermFrequencyMap* term_freqs) const {
     if (_textIndexVersion == TEXT_INDEX_VERSION_1) {
         return _scoreDocumentV1(obj, term_freqs);
@@ -183,8 +203,7 @@ void FTSSpec::scoreDocument(const BSONObj& obj, TermFrequencyMap* term_freqs) co
 
     while (it.more()) {
         FTSIteratorValue val = it.next();
-        std::unique_ptr<FTSTokenizer> tokenizer(val._language->createTokenizer());
-        _scoreStringV2(tokenizer.get(), val._text, term_freqs, val._weight);
+        _scoreStringV2(getThreadTokenizer(val._language), val._text, term_freqs, val._weight);
     }
 }
 
@@ -89,6 +89,17 @@ bool UnicodeFTSTokenizer::moveNext() {
             continue;
         }
 
+        const bool useTokenCache =
+            !(_options & (kGenerateCaseSensitiveTokens | kGenerateDiacriticSensitiveTokens));
+        const StringData lowerCasedWord = _word;
+        if (useTokenCache) {
+            auto it = _tokenCache.find(lowerCasedWord);
+            if (it != _tokenCache.end()) {
+                _word = it->second;
+                return true;
+            }
+        }
+
         if (_options & kGenerateCaseSensitiveTokens) {
             _word = _document.substrToBuf(&_wordBuf, start, len);
         }
@@ -102,6 +113,15 @@ bool UnicodeFTSTokenizer::moveNext() {
                 &_finalBuf, _word, unicode::String::kCaseSensitive, _caseFoldMode);
         }
 
+        // Neither stemming nor stripping diacritics writes to _wordBuf, so 'lowerCasedWord' is
+        // still intact here.
+        if (useTokenCache) {
+            if (_tokenCache.size() >= kMaxCachedTokens) {
+                _tokenCache.clear();
+            }
+            _tokenCache[lowerCasedWord] = _word.toString();
+        }
+
         return true;
     }
 }
@@ -34,6 +34,7 @@
 #include "mongo/db/fts/stemmer.h"
 #include "mongo/db/fts/tokenizer.h"
 #include "mongo/db/fts/unicode/string.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 namespace fts {
@@ -86,6 +87,12 @@ private:
 
     StackBufBuilder _wordBuf;
     StackBufBuilder _finalBuf;
+
+    // Tokens of recently seen words, keyed by their lower cased form. Stemming dominates the cost
+    // of tokenizing, and natural language repeats words often. Only used when generating case and
+    // diacritic insensitive tokens, which depend on nothing but the lower cased word.
+    static const size_t kMaxCachedTokens = 4096;
+    StringMap<std::string> _tokenCache;
 };
 
 }  // namespace fts
@@ -30,8 +30,11 @@
 
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/geoparser.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/transitional_tools_do_not_use/vector_spooling.h"
+#include "third_party/s2/s2cellunion.h"
+#include "third_party/s2/s2regioncoverer.h"
 
 namespace mongo {
 
@@ -363,6 +366,51 @@ bool GeometryContainer::contains(const GeometryContainer& otherContainer) const
     return false;
 }
 
+/**
+ * Cell coverings of an S2Polygon which answer whether the polygon contains a point without
+ * examining its edges, unless the point is close to the polygon's boundary. A point in a cell of
+ * the interior covering is inside the polygon. A point outside of the covering is outside of the
+ * polygon, just as the index bounds generated from the same kind of covering assume.
+ */
+class GeometryContainer::S2PolygonCellIndex {
+public:
+    enum class Containment { kInside, kOutside, kUnknown };
+
+    explicit S2PolygonCellIndex(const S2Polygon& polygon) {
+        S2RegionCoverer coverer;
+        coverer.set_max_cells(kMaxCells);
+
+        std::vector<S2CellId> cells;
+        coverer.GetInteriorCovering(polygon, &cells);
+        _interior.InitSwap(&cells);
+        coverer.GetCovering(polygon, &cells);
+        _covering.InitSwap(&cells);
+    }
+
+    Containment contains(const S2Cell& otherCell) const {
+        if (_interior.Contains(otherCell.id())) {
+            return Containment::kInside;
+        }
+        if (!_covering.Intersects(otherCell.id())) {
+            return Containment::kOutside;
+        }
+        return Containment::kUnknown;
+    }
+
+    // Checks against fewer points than this are cheaper to answer from the polygon's edges.
+    static const int kMinChecksBeforeIndexing = 64;
+
+private:
+    static const int kMaxCells = 512;
+
+    S2CellUnion _interior;
+    S2CellUnion _covering;
+};
+
+GeometryContainer::GeometryContainer() = default;
+
+GeometryContainer::~GeometryContainer() = default;
+
 bool containsPoint(const S2Polygon& poly, const S2Cell& otherCell, const S2Point& otherPoint) {
     // This is much faster for actual containment checking.
     if (poly.Contains(otherPoint)) {
@@ -374,6 +422,20 @@ bool containsPoint(const S2Polygon& poly, const S2Cell& otherCell, const S2Point
 
 bool GeometryContainer::contains(const S2Cell& otherCell, const S2Point& otherPoint) const {
     if (NULL != _polygon && (NULL != _polygon->s2Polygon)) {
+        if (!_s2PolygonCellIndex &&
+            ++_numPointContainsChecks >= S2PolygonCellIndex::kMinChecksBeforeIndexing) {
+            _s2PolygonCellIndex = stdx::make_unique<S2PolygonCellIndex>(*_polygon->s2Polygon);
+        }
+        if (_s2PolygonCellIndex) {
+            switch (_s2PolygonCellIndex->contains(otherCell)) {
+                case S2PolygonCellIndex::Containment::kInside:
+                    return true;
+                case S2PolygonCellIndex::Containment::kOutside:
+                    return false;
+                case S2PolygonCellIndex::Containment::kUnknown:
+                    break;
+            }
+        }
         return containsPoint(*_polygon->s2Polygon, otherCell, otherPoint);
     }
 
@@ -43,7 +43,9 @@ public:
     /**
      * Creates an empty geometry container which may then be loaded from BSON or directly.
      */
-    GeometryContainer() = default;
+    GeometryContainer();
+
+    ~GeometryContainer();
 
     /**
      * Loads an empty GeometryContainer from query.
@@ -125,6 +127,7 @@ public:
 
 private:
     class R2BoxRegion;
+    class S2PolygonCellIndex;
 
     Status parseFromGeoJSON(const BSONObj& obj, bool skipValidation = false);
 
@@ -160,6 +163,11 @@ private:
     // TODO: _s2Region is currently generated immediately - don't necessarily need to do this
     std::unique_ptr<S2RegionUnion> _s2Region;
     std::unique_ptr<R2Region> _r2Region;
+
+    // Built once '_polygon' has been checked against enough points, to answer most of the later
+    // checks without examining the polygon's edges.
+    mutable std::unique_ptr<S2PolygonCellIndex> _s2PolygonCellIndex;
+    mutable int _numPointContainsChecks = 0;
 };
 
 }  // namespace mongo
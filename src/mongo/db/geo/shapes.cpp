@@ -239,6 +239,12 @@ bool Polygon::contains(const Point& p) const {
  * A ray casting intersection method is used.
  */
 int Polygon::contains(const Point& p, double fudge) const {
+    // A point outside of the polygon's bounds, grown by 'fudge', is outside of the polygon and
+    // its error box touches none of the polygon's edges.
+    if (!bounds().inside(p, fudge)) {
+        return -1;
+    }
+
     Box fudgeBox(Point(p.x - fudge, p.y - fudge), Point(p.x + fudge, p.y + fudge));
 
     int counter = 0;
@@ -34,8 +34,11 @@
 
 #include "mongo/db/hasher.h"
 
+#include <third_party/murmurhash3/MurmurHash3.h>
 
+#include "mongo/bson/util/builder.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/util/assert_util.h"
 #include "mongo/util/md5.hpp"
 #include "mongo/util/startup_test.h"
 
@@ -79,7 +82,35 @@ void Hasher::finish(HashDigest out) {
     md5_finish(&_md5State, out);
 }
 
-void recursiveHash(Hasher* h, const BSONElement& e, bool includeFieldName) {
+/**
+ * The hasher for hashVersion 1. MurmurHash3 digests its input in a single pass, so the bytes are
+ * collected as they are added. The elements of index and shard keys almost always fit in the stack
+ * buffer.
+ */
+class Murmur3Hasher {
+    MONGO_DISALLOW_COPYING(Murmur3Hasher);
+
+public:
+    explicit Murmur3Hasher(HashSeed seed) : _seed(seed) {}
+
+    void addData(const void* keyData, size_t numBytes) {
+        _buf.appendBuf(keyData, numBytes);
+    }
+
+    // Returns the low 64 bits of the 128-bit hash. Only call this once per Murmur3Hasher.
+    long long int finish() {
+        char digest[16];
+        MurmurHash3_x64_128(_buf.buf(), _buf.len(), static_cast<uint32_t>(_seed), digest);
+        return ConstDataView(digest).read<long long int>();
+    }
+
+private:
+    StackBufBuilder _buf;
+    HashSeed _seed;
+};
+
+template <typename HasherType>
+void recursiveHash(HasherType* h, const BSONElement& e, bool includeFieldName) {
     int canonicalType = endian::nativeToLittle(e.canonicalType());
     h->addData(&canonicalType, sizeof(canonicalType));
 
@@ -122,6 +153,10 @@ struct HasherUnitTest : public StartupTest {
         // Hard-coded check to ensure the hash function is consistent across platforms
         BSONObj o = BSON("check" << 42);
         verify(BSONElementHasher::hash64(o.firstElement(), 0) == -944302157085130861LL);
+        verify(BSONElementHasher::hash64(o.firstElement(),
+                                         0,
+                                         BSONElementHasher::MURMUR3_HASH_VERSION) ==
+               8715208212397937794LL);
     }
 } hasherUnitTest;
 
@@ -137,4 +172,15 @@ long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed) {
     return digestView.read<LittleEndian<long long int>>();
 }
 
+long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed, int hashVersion) {
+    if (hashVersion == DEFAULT_HASH_VERSION) {
+        return hash64(e, seed);
+    }
+
+    invariant(hashVersion == MURMUR3_HASH_VERSION);
+    Murmur3Hasher h(seed);
+    recursiveHash(&h, e, false);
+    return h.finish();
+}
+
 }  // namespace mongo
@@ -54,6 +54,18 @@ public:
      */
     static const int DEFAULT_HASH_SEED = 0;
 
+    /* The "hashVersion" of a hashed index names the hash function used to compute its keys.
+     * Version 0 is the MD5-based hash that hashed shard keys depend on and is the default.
+     * Version 1 is the much cheaper 64-bit MurmurHash3, and may only be chosen when creating
+     * an index.
+     */
+    static const int DEFAULT_HASH_VERSION = 0;
+    static const int MURMUR3_HASH_VERSION = 1;
+
+    static bool isSupportedHashVersion(int hashVersion) {
+        return hashVersion == DEFAULT_HASH_VERSION || hashVersion == MURMUR3_HASH_VERSION;
+    }
+
     /* This computes a 64-bit hash of the value part of BSONElement "e",
      * preceded by the seed "seed".  Squashes element (and any sub-elements)
      * of the same canonical type, so hash({a:{b:4}}) will be the same
@@ -68,6 +80,12 @@ public:
      */
     static long long int hash64(const BSONElement& e, HashSeed seed);
 
+    /* As above, but using the hash function of the given hashVersion, which must be supported.
+     * Both versions squash canonical types identically; they differ only in how the resulting
+     * bytes are digested.
+     */
+    static long long int hash64(const BSONElement& e, HashSeed seed, int hashVersion);
+
 private:
     BSONElementHasher();
 };
@@ -359,5 +359,46 @@ TEST(BSONElementHasher, HashCodeWScope) {
     ASSERT_EQUALS(hashIt(o), 501342939894575968LL);
 }
 
+TEST(BSONElementHasher, Murmur3HashVersionSquashesNumericTypes) {
+    const int v = BSONElementHasher::MURMUR3_HASH_VERSION;
+    const auto intHash = BSONElementHasher::hash64(BSON("a" << 3).firstElement(), 0, v);
+    ASSERT_EQUALS(intHash, BSONElementHasher::hash64(BSON("a" << 3LL).firstElement(), 0, v));
+    ASSERT_EQUALS(intHash, BSONElementHasher::hash64(BSON("a" << 3.1).firstElement(), 0, v));
+    ASSERT_NOT_EQUALS(intHash, BSONElementHasher::hash64(BSON("a" << 4).firstElement(), 0, v));
+
+    const auto objHash =
+        BSONElementHasher::hash64(BSON("a" << BSON("b" << 4)).firstElement(), 0, v);
+    ASSERT_EQUALS(objHash,
+                  BSONElementHasher::hash64(BSON("a" << BSON("b" << 4.1)).firstElement(), 0, v));
+    ASSERT_NOT_EQUALS(objHash,
+                      BSONElementHasher::hash64(BSON("a" << BSON("c" << 4)).firstElement(), 0, v));
+}
+
+TEST(BSONElementHasher, Murmur3HashVersionDependsOnSeed) {
+    const int v = BSONElementHasher::MURMUR3_HASH_VERSION;
+    BSONObj o = BSON("check" << 42);
+    ASSERT_NOT_EQUALS(BSONElementHasher::hash64(o.firstElement(), 0, v),
+                      BSONElementHasher::hash64(o.firstElement(), 1, v));
+}
+
+TEST(BSONElementHasher, HashVersionsDiffer) {
+    BSONObj o = BSON("check" << 42);
+    ASSERT_EQUALS(BSONElementHasher::hash64(o.firstElement(), 0),
+                  BSONElementHasher::hash64(
+                      o.firstElement(), 0, BSONElementHasher::DEFAULT_HASH_VERSION));
+    ASSERT_NOT_EQUALS(BSONElementHasher::hash64(o.firstElement(), 0),
+                      BSONElementHasher::hash64(
+                          o.firstElement(), 0, BSONElementHasher::MURMUR3_HASH_VERSION));
+}
+
+TEST(BSONElementHasher, Murmur3HashVersionHashesLargeValues) {
+    const int v = BSONElementHasher::MURMUR3_HASH_VERSION;
+    const std::string big(10 * 1024, 'x');
+    std::string bigger = big;
+    bigger.back() = 'y';
+    ASSERT_NOT_EQUALS(BSONElementHasher::hash64(BSON("a" << big).firstElement(), 0, v),
+                      BSONElementHasher::hash64(BSON("a" << bigger).firstElement(), 0, v));
+}
+
 }  // namespace
 }  // namespace mongo
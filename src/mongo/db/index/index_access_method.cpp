@@ -32,6 +32,7 @@
 
 #include "mongo/db/index/btree_access_method.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -46,6 +47,7 @@
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/timestamp_block.h"
@@ -220,6 +222,86 @@ Status AbstractIndexAccessMethod::insert(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status AbstractIndexAccessMethod::insertBatch(OperationContext* opCtx,
+                                              const std::vector<BsonRecord>& bsonRecords,
+                                              const InsertDeleteOptions& options,
+                                              int64_t* numInserted) {
+    invariant(numInserted);
+    *numInserted = 0;
+    bool checkIndexKeySize = shouldCheckIndexKeySize(opCtx);
+
+    struct KeyAndRecordId {
+        BSONObj key;
+        RecordId loc;
+    };
+    std::vector<KeyAndRecordId> dataKeys;
+    BSONObjSet multikeyMetadataKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    std::vector<MultikeyPaths> multikeyPathsToSet;
+
+    for (const auto& bsonRecord : bsonRecords) {
+        BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+        BSONObjSet recordMultikeyMetadataKeys =
+            SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+        MultikeyPaths multikeyPaths;
+        getKeys(*bsonRecord.docPtr,
+                options.getKeysMode,
+                &keys,
+                &recordMultikeyMetadataKeys,
+                &multikeyPaths);
+
+        if (shouldMarkIndexAsMultikey(keys, recordMultikeyMetadataKeys, multikeyPaths)) {
+            multikeyPathsToSet.push_back(std::move(multikeyPaths));
+        }
+        for (const auto& key : keys) {
+            dataKeys.push_back({key, bsonRecord.id});
+        }
+        *numInserted += keys.size() + recordMultikeyMetadataKeys.size();
+        multikeyMetadataKeys.insert(recordMultikeyMetadataKeys.begin(),
+                                    recordMultikeyMetadataKeys.end());
+    }
+
+    const auto ordering = Ordering::make(_descriptor->keyPattern());
+    std::sort(dataKeys.begin(),
+              dataKeys.end(),
+              [&](const KeyAndRecordId& lhs, const KeyAndRecordId& rhs) {
+                  const int cmp = lhs.key.woCompare(rhs.key, ordering, false);
+                  return cmp < 0 || (cmp == 0 && lhs.loc < rhs.loc);
+              });
+
+    auto insertOneKey = [&](const BSONObj& key, const RecordId& recordId) {
+        Status status = checkIndexKeySize ? checkKeySize(key) : Status::OK();
+        if (status.isOK()) {
+            StatusWith<SpecialFormatInserted> ret =
+                _newInterface->insert(opCtx, key, recordId, options.dupsAllowed);
+            status = ret.getStatus();
+            if (status.isOK() && ret.getValue() == SpecialFormatInserted::LongTypeBitsInserted)
+                _btreeState->setIndexKeyStringWithLongTypeBitsExistsOnDisk(opCtx);
+        }
+        return status;
+    };
+
+    for (const auto& dataKey : dataKeys) {
+        Status status = insertOneKey(dataKey.key, dataKey.loc);
+        if (isFatalError(opCtx, status, dataKey.key)) {
+            *numInserted = 0;
+            return status;
+        }
+    }
+    for (const auto& key : multikeyMetadataKeys) {
+        Status status = insertOneKey(key, kMultikeyMetadataKeyId);
+        if (isFatalError(opCtx, status, key)) {
+            *numInserted = 0;
+            return status;
+        }
+    }
+
+    for (const auto& multikeyPaths : multikeyPathsToSet) {
+        _btreeState->setMultikey(opCtx, multikeyPaths);
+    }
+
+    return Status::OK();
+}
+
 void AbstractIndexAccessMethod::removeOneKey(OperationContext* opCtx,
                                              const BSONObj& key,
                                              const RecordId& loc,
@@ -492,7 +574,9 @@ IndexAccessMethod::BulkBuilder::BulkBuilder(const IndexAccessMethod* index,
           SortOptions()
               .TempDir(storageGlobalParams.dbpath + "/_tmp")
               .ExtSortAllowed()
-              .MaxMemoryUsageBytes(maxMemoryUsageBytes),
+              .MaxMemoryUsageBytes(maxMemoryUsageBytes)
+              .MaxSortThreads(internalSorterMaxThreads.load())
+              .PrefixCompressKeys(),
           BtreeExternalSortComparison(descriptor->keyPattern(), descriptor->version()))),
       _real(index) {}
 
@@ -500,11 +584,25 @@ Status IndexAccessMethod::BulkBuilder::insert(OperationContext* opCtx,
                                               const BSONObj& obj,
                                               const RecordId& loc,
                                               const InsertDeleteOptions& options) {
-    BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
-    MultikeyPaths multikeyPaths;
+    DocumentKeys docKeys;
+    generateKeys(obj, options, &docKeys);
+    insertKeys(docKeys, loc);
+    return Status::OK();
+}
 
-    _real->getKeys(obj, options.getKeysMode, &keys, &_multikeyMetadataKeys, &multikeyPaths);
+void IndexAccessMethod::BulkBuilder::generateKeys(const BSONObj& obj,
+                                                  const InsertDeleteOptions& options,
+                                                  DocumentKeys* docKeys) const {
+    _real->getKeys(obj,
+                   options.getKeysMode,
+                   &docKeys->keys,
+                   &docKeys->multikeyMetadataKeys,
+                   &docKeys->multikeyPaths);
+}
 
+void IndexAccessMethod::BulkBuilder::insertKeys(const DocumentKeys& docKeys,
+                                                const RecordId& loc) {
+    const MultikeyPaths& multikeyPaths = docKeys.multikeyPaths;
     if (!multikeyPaths.empty()) {
         if (_indexMultikeyPaths.empty()) {
             _indexMultikeyPaths = multikeyPaths;
@@ -516,15 +614,16 @@ Status IndexAccessMethod::BulkBuilder::insert(OperationContext* opCtx,
         }
     }
 
-    for (const auto& key : keys) {
+    _multikeyMetadataKeys.insert(docKeys.multikeyMetadataKeys.begin(),
+                                 docKeys.multikeyMetadataKeys.end());
+
+    for (const auto& key : docKeys.keys) {
         _sorter->add(key, loc);
         ++_keysInserted;
     }
 
-    _isMultiKey =
-        _isMultiKey || _real->shouldMarkIndexAsMultikey(keys, _multikeyMetadataKeys, multikeyPaths);
-
-    return Status::OK();
+    _isMultiKey = _isMultiKey ||
+        _real->shouldMarkIndexAsMultikey(docKeys.keys, _multikeyMetadataKeys, multikeyPaths);
 }
 
 IndexAccessMethod::BulkBuilder::Sorter::Iterator* IndexAccessMethod::BulkBuilder::done() {
@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/index_build_interceptor.h"
+
+#include "mongo/db/operation_context.h"
+
+namespace mongo {
+
+/**
+ * Adds a side write to the interceptor once the unit of work which made it commits.
+ */
+class IndexBuildInterceptor::SideWriteChange : public RecoveryUnit::Change {
+public:
+    SideWriteChange(IndexBuildInterceptor* interceptor, RecordId loc, BSONObj oldDoc)
+        : _interceptor(interceptor), _loc(std::move(loc)), _oldDoc(std::move(oldDoc)) {}
+
+    void commit(boost::optional<Timestamp>) final {
+        stdx::lock_guard<stdx::mutex> lk(_interceptor->_mutex);
+        auto& versions = _interceptor->_sideWrites[_loc];
+        if (!_oldDoc.isEmpty()) {
+            versions.push_back(std::move(_oldDoc));
+        }
+    }
+
+    void rollback() final {}
+
+private:
+    IndexBuildInterceptor* const _interceptor;
+    const RecordId _loc;
+    BSONObj _oldDoc;
+};
+
+void IndexBuildInterceptor::sideWrite(OperationContext* opCtx,
+                                      const RecordId& loc,
+                                      const BSONObj* oldDoc) {
+    opCtx->recoveryUnit()->registerChange(
+        new SideWriteChange(this, loc, oldDoc ? oldDoc->getOwned() : BSONObj()));
+}
+
+IndexBuildInterceptor::SideWrites IndexBuildInterceptor::takeSideWrites() {
+    SideWrites sideWrites;
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    sideWrites.swap(_sideWrites);
+    return sideWrites;
+}
+
+size_t IndexBuildInterceptor::numPendingRecords() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _sideWrites.size();
+}
+
+}  // namespace mongo
@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Records the writes which concurrent operations make to a collection while one of its indexes is
+ * being bulk built from a collection scan, in place of writing them to the index itself. Once the
+ * bulk build is done, the index builder applies these side writes to the index.
+ *
+ * Rather than an ordered log of key insertions and deletions, each side write is kept as the
+ * RecordId of the written document and the version of the document from before the write, if
+ * any. Applying the side writes for a RecordId removes the keys of every recorded version and
+ * indexes the current version of the document. This needs no ordering between side writes, and
+ * is correct no matter which version of the document the collection scan saw, since every
+ * version the scan could have seen was either recorded here or is the current one.
+ *
+ * Side writes become visible to the index builder only once their unit of work commits.
+ */
+class IndexBuildInterceptor {
+    MONGO_DISALLOW_COPYING(IndexBuildInterceptor);
+
+public:
+    // The side writes to apply: for each written RecordId, the versions of the document before
+    // each of the writes, oldest first. The versions are empty when all writes were inserts.
+    using SideWrites = std::map<RecordId, std::vector<BSONObj>>;
+
+    IndexBuildInterceptor() = default;
+
+    /**
+     * Records a write to the document at 'loc' in the unit of work of 'opCtx'. 'oldDoc' is the
+     * version of the document before the write, or nullptr if the write inserted it.
+     */
+    void sideWrite(OperationContext* opCtx, const RecordId& loc, const BSONObj* oldDoc);
+
+    /**
+     * Removes and returns all committed side writes.
+     */
+    SideWrites takeSideWrites();
+
+    /**
+     * Returns the number of RecordIds with committed side writes which have not yet been taken.
+     */
+    size_t numPendingRecords() const;
+
+private:
+    class SideWriteChange;
+
+    mutable stdx::mutex _mutex;
+    SideWrites _sideWrites;
+};
+
+}  // namespace mongo
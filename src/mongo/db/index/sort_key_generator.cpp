@@ -30,7 +30,9 @@
 
 #include "mongo/db/index/sort_key_generator.h"
 
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/bson/bsonobj_comparator.h"
+#include "mongo/db/query/collation/collation_index_key.h"
 
 namespace mongo {
 
@@ -75,6 +77,16 @@ SortKeyGenerator::SortKeyGenerator(const BSONObj& sortSpec, const CollatorInterf
     for (auto&& patternElt : _sortSpecWithoutMeta) {
         fieldNames.push_back(patternElt.fieldName());
         fixed.push_back(BSONElement());
+        _topLevelFieldNames.push_back(patternElt.fieldNameStringData());
+    }
+
+    // A sort over dotted paths, including positional paths such as "a.0", always goes through the
+    // key generator.
+    for (auto&& fieldName : _topLevelFieldNames) {
+        if (fieldName.find('.') != std::string::npos) {
+            _topLevelFieldNames.clear();
+            break;
+        }
     }
 
     constexpr bool isSparse = false;
@@ -126,12 +138,43 @@ StatusWith<BSONObj> SortKeyGenerator::getSortKey(const BSONObj& obj,
     return mergedKeyBob.obj();
 }
 
+boost::optional<BSONObj> SortKeyGenerator::getIndexKeyFromTopLevelFields(
+    const BSONObj& obj) const {
+    boost::optional<BSONFieldIndex> fieldIndex;
+    if (_topLevelFieldNames.size() >= static_cast<size_t>(BSONFieldIndex::kMinLookups)) {
+        fieldIndex.emplace(obj);
+    }
+
+    BSONObjBuilder keyBob;
+    for (auto&& fieldName : _topLevelFieldNames) {
+        auto elt = fieldIndex ? fieldIndex->getField(fieldName) : obj.getField(fieldName);
+        if (elt.type() == BSONType::Array) {
+            // The key generator decides which element of the array to sort by.
+            return boost::none;
+        }
+        if (elt.eoo()) {
+            keyBob.appendNull("");
+        } else {
+            CollationIndexKey::collationAwareIndexKeyAppend(elt, _collator, &keyBob);
+        }
+    }
+    return keyBob.obj();
+}
+
 StatusWith<BSONObj> SortKeyGenerator::getIndexKey(const BSONObj& obj) const {
     // Not sorting by anything in the key, just bail out early.
     if (_sortSpecWithoutMeta.isEmpty()) {
         return BSONObj();
     }
 
+    // Sorting by top-level fields which are not arrays has a single key, which we can build
+    // without the key generator.
+    if (!_topLevelFieldNames.empty()) {
+        if (auto key = getIndexKeyFromTopLevelFields(obj)) {
+            return std::move(*key);
+        }
+    }
+
     // We will sort 'obj' in the same order an index over '_sortSpecWithoutMeta' would have. This is
     // tricky. Consider the sort pattern {a:1} and the document {a: [1, 10]}. We have potentially
     // two keys we could use to sort on. Here we extract these keys.
@@ -28,6 +28,9 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <vector>
+
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/index/btree_key_generator.h"
 #include "mongo/db/operation_context.h"
@@ -82,6 +85,12 @@ private:
 
     StatusWith<BSONObj> getIndexKey(const BSONObj& obj) const;
 
+    /**
+     * Builds the index key for 'obj' directly from its top-level fields, or returns boost::none if
+     * one of them is an array.
+     */
+    boost::optional<BSONObj> getIndexKeyFromTopLevelFields(const BSONObj& obj) const;
+
     const CollatorInterface* _collator = nullptr;
 
     // The sort pattern with any $meta sort components stripped out, since the underlying index key
@@ -95,6 +104,9 @@ private:
     // If we're not sorting with a $meta value we can short-cut some work.
     bool _sortHasMeta = false;
 
+    // The fields of '_sortSpecWithoutMeta', if none of them is a dotted path. Empty otherwise.
+    std::vector<StringData> _topLevelFieldNames;
+
     std::unique_ptr<BtreeKeyGenerator> _indexKeyGen;
 };
 
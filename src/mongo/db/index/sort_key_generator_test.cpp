@@ -86,6 +86,36 @@ TEST(SortKeyGeneratorTest, CompoundPatternLeadingFieldIsArray) {
     ASSERT_BSONOBJ_EQ(sortKey.getValue(), BSON("" << 1 << "" << 16));
 }
 
+TEST(SortKeyGeneratorTest, CompoundSortPatternOverManyTopLevelFields) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    auto sortKeyGen = stdx::make_unique<SortKeyGenerator>(
+        BSON("d" << 1 << "b" << -1 << "missing" << 1 << "a" << 1), &collator);
+    for (int i = 0; i < 2; i++) {
+        auto sortKey = sortKeyGen->getSortKey(
+            fromjson("{_id: 0, a: 'thing', b: {c: 'x'}, d: 16, e: [1, 2]}"), nullptr);
+        ASSERT_OK(sortKey.getStatus());
+        ASSERT_BSONOBJ_EQ(sortKey.getValue(),
+                          BSON("" << 16 << "" << BSON("c"
+                                                      << "x")
+                                  << ""
+                                  << BSONNULL
+                                  << ""
+                                  << "gniht"));
+    }
+
+    // A document of the same shape with an array in a sort field goes through the key generator.
+    auto sortKey = sortKeyGen->getSortKey(
+        fromjson("{_id: 0, a: 'thing', b: {c: 'x'}, d: [3, 1, 2], e: [1, 2]}"), nullptr);
+    ASSERT_OK(sortKey.getStatus());
+    ASSERT_BSONOBJ_EQ(sortKey.getValue(),
+                      BSON("" << 1 << "" << BSON("c"
+                                                 << "x")
+                              << ""
+                              << BSONNULL
+                              << ""
+                              << "gniht"));
+}
+
 TEST(SortKeyGeneratorTest, ExtractStringSortKeyWithCollatorUsesComparisonKey) {
     CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
     auto sortKeyGen = stdx::make_unique<SortKeyGenerator>(BSON("a" << 1), &collator);
@@ -55,10 +55,17 @@ void WildcardAccessMethod::doGetKeys(const BSONObj& obj,
 
 std::set<FieldRef> WildcardAccessMethod::getMultikeyPathSet(OperationContext* opCtx) const {
     auto cursor = newCursor(opCtx);
-    // All of the keys storing multikeyness metadata are prefixed by a value of 1. Establish an
-    // index cursor which will scan this range.
-    const BSONObj metadataKeyRangeBegin = BSON("" << 1 << "" << MINKEY);
-    const BSONObj metadataKeyRangeEnd = BSON("" << 1 << "" << MAXKEY);
+    // All of the keys storing multikeyness metadata are prefixed by a value of 1, which for a
+    // compound wildcard index follows a MinKey for each prefix field. Establish an index cursor
+    // which will scan this range.
+    const auto& keyPattern = _descriptor->keyPattern();
+    const size_t numPrefixFields = WildcardKeyGenerator::numPrefixFields(keyPattern);
+    const BSONObj metadataKeyPrefix =
+        WildcardKeyGenerator::makeMultikeyMetadataKeyPrefix(keyPattern);
+    const BSONObj metadataKeyRangeBegin =
+        BSONObjBuilder().appendElements(metadataKeyPrefix).appendMinKey("").obj();
+    const BSONObj metadataKeyRangeEnd =
+        BSONObjBuilder().appendElements(metadataKeyPrefix).appendMaxKey("").obj();
 
     constexpr bool inclusive = true;
     cursor->setEndPosition(metadataKeyRangeEnd, inclusive);
@@ -72,8 +79,12 @@ std::set<FieldRef> WildcardAccessMethod::getMultikeyPathSet(OperationContext* op
         invariant(entry->loc.repr() ==
                   static_cast<int64_t>(RecordId::ReservedId::kWildcardMultikeyMetadataId));
 
-        // Validate that the first piece of the key is the integer 1.
+        // Validate that the key begins with a MinKey for each prefix field and the integer 1.
         BSONObjIterator iter(entry->key);
+        for (size_t i = 0; i < numPrefixFields; ++i) {
+            invariant(iter.more());
+            invariant(iter.next().type() == BSONType::MinKey);
+        }
         invariant(iter.more());
         const auto firstElem = iter.next();
         invariant(firstElem.isNumber());
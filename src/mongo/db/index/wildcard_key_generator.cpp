@@ -30,6 +30,9 @@
 
 #include "mongo/db/index/wildcard_key_generator.h"
 
+#include <set>
+
+#include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 
@@ -61,18 +64,36 @@ void popPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* path
 
 constexpr StringData WildcardKeyGenerator::kSubtreeSuffix;
 
+BSONElement WildcardKeyGenerator::getWildcardField(const BSONObj& keyPattern) {
+    BSONElement wildcardField;
+    for (auto&& elem : keyPattern) {
+        wildcardField = elem;
+    }
+    invariant(wildcardField.fieldNameStringData() == "$**"_sd ||
+              wildcardField.fieldNameStringData().endsWith(kSubtreeSuffix));
+    return wildcardField;
+}
+
+BSONObj WildcardKeyGenerator::makeMultikeyMetadataKeyPrefix(const BSONObj& keyPattern) {
+    BSONObjBuilder bob;
+    for (size_t i = 0; i < numPrefixFields(keyPattern); ++i) {
+        bob.appendMinKey("");
+    }
+    bob.append("", 1);
+    return bob.obj();
+}
+
 std::unique_ptr<ProjectionExecAgg> WildcardKeyGenerator::createProjectionExec(
     BSONObj keyPattern, BSONObj pathProjection) {
-    // We should never have a key pattern that contains more than a single element.
-    invariant(keyPattern.nFields() == 1);
-
-    // The _keyPattern is either { "$**": ±1 } for all paths or { "path.$**": ±1 } for a single
+    // The wildcard field is either { "$**": ±1 } for all paths or { "path.$**": ±1 } for a single
     // subtree. If we are indexing a single subtree, then we will project just that path.
-    auto indexRoot = keyPattern.firstElement().fieldNameStringData();
+    auto indexRoot = getWildcardField(keyPattern).fieldNameStringData();
     auto suffixPos = indexRoot.find(kSubtreeSuffix);
 
-    // If we're indexing a single subtree, we can't also specify a path projection.
+    // If we're indexing a single subtree or have prefix fields, we can't also specify a path
+    // projection.
     invariant(suffixPos == std::string::npos || pathProjection.isEmpty());
+    invariant(numPrefixFields(keyPattern) == 0 || pathProjection.isEmpty());
 
     // If this is a subtree projection, the projection spec is { "path.to.subtree": 1 }. Otherwise,
     // we use the path projection from the original command object. If the path projection is empty
@@ -93,20 +114,59 @@ std::unique_ptr<ProjectionExecAgg> WildcardKeyGenerator::createProjectionExec(
 WildcardKeyGenerator::WildcardKeyGenerator(BSONObj keyPattern,
                                            BSONObj pathProjection,
                                            const CollatorInterface* collator)
-    : _collator(collator), _keyPattern(keyPattern) {
+    : _collator(collator),
+      _keyPattern(keyPattern),
+      _multikeyMetadataKeyPrefix(makeMultikeyMetadataKeyPrefix(keyPattern)) {
     _projExec = createProjectionExec(keyPattern, pathProjection);
+
+    const size_t numPrefix = numPrefixFields(keyPattern);
+    for (auto&& elem : keyPattern) {
+        if (_prefixFields.size() == numPrefix)
+            break;
+        _prefixFields.push_back(elem.fieldName());
+    }
 }
 
 void WildcardKeyGenerator::generateKeys(BSONObj inputDoc,
                                         BSONObjSet* keys,
                                         BSONObjSet* multikeyPaths) const {
     FieldRef rootPath;
-    _traverseWildcard(_projExec->applyProjection(inputDoc), false, &rootPath, keys, multikeyPaths);
+    _traverseWildcard(_projExec->applyProjection(inputDoc),
+                      false,
+                      &rootPath,
+                      _extractKeyPrefix(inputDoc),
+                      keys,
+                      multikeyPaths);
+}
+
+BSONObj WildcardKeyGenerator::_extractKeyPrefix(const BSONObj& inputDoc) const {
+    BSONObjBuilder bob;
+    for (const auto& field : _prefixFields) {
+        BSONElementSet elements;
+        std::set<size_t> arrayComponents;
+        dotted_path_support::extractAllElementsAlongPath(
+            inputDoc, field, elements, true, &arrayComponents);
+        uassert(51533,
+                str::stream() << "Cannot index the array along the path '" << field
+                              << "', which precedes the wildcard field of compound wildcard index "
+                              << _keyPattern,
+                arrayComponents.empty());
+
+        // As in regular indexes, a missing field is indexed as null.
+        invariant(elements.size() <= 1u);
+        if (elements.empty()) {
+            bob.appendNull("");
+        } else {
+            CollationIndexKey::collationAwareIndexKeyAppend(*elements.begin(), _collator, &bob);
+        }
+    }
+    return bob.obj();
 }
 
 void WildcardKeyGenerator::_traverseWildcard(BSONObj obj,
                                              bool objIsArray,
                                              FieldRef* path,
+                                             const BSONObj& keyPrefix,
                                              BSONObjSet* keys,
                                              BSONObjSet* multikeyPaths) const {
     for (const auto elem : obj) {
@@ -120,22 +180,26 @@ void WildcardKeyGenerator::_traverseWildcard(BSONObj obj,
         switch (elem.type()) {
             case BSONType::Array:
                 // If this is a nested array, we don't descend it but instead index it as a value.
-                if (_addKeyForNestedArray(elem, *path, objIsArray, keys))
+                if (_addKeyForNestedArray(elem, *path, objIsArray, keyPrefix, keys))
                     break;
 
                 // Add an entry for the multi-key path, and then fall through to BSONType::Object.
                 _addMultiKey(*path, multikeyPaths);
 
             case BSONType::Object:
-                if (_addKeyForEmptyLeaf(elem, *path, keys))
+                if (_addKeyForEmptyLeaf(elem, *path, keyPrefix, keys))
                     break;
 
-                _traverseWildcard(
-                    elem.Obj(), elem.type() == BSONType::Array, path, keys, multikeyPaths);
+                _traverseWildcard(elem.Obj(),
+                                  elem.type() == BSONType::Array,
+                                  path,
+                                  keyPrefix,
+                                  keys,
+                                  multikeyPaths);
                 break;
 
             default:
-                _addKey(elem, *path, keys);
+                _addKey(elem, *path, keyPrefix, keys);
         }
 
         // Remove the element's fieldname from the path, if it was pushed onto it earlier.
@@ -146,10 +210,11 @@ void WildcardKeyGenerator::_traverseWildcard(BSONObj obj,
 bool WildcardKeyGenerator::_addKeyForNestedArray(BSONElement elem,
                                                  const FieldRef& fullPath,
                                                  bool enclosingObjIsArray,
+                                                 const BSONObj& keyPrefix,
                                                  BSONObjSet* keys) const {
     // If this element is an array whose parent is also an array, index it as a value.
     if (enclosingObjIsArray && elem.type() == BSONType::Array) {
-        _addKey(elem, fullPath, keys);
+        _addKey(elem, fullPath, keyPrefix, keys);
         return true;
     }
     return false;
@@ -157,12 +222,13 @@ bool WildcardKeyGenerator::_addKeyForNestedArray(BSONElement elem,
 
 bool WildcardKeyGenerator::_addKeyForEmptyLeaf(BSONElement elem,
                                                const FieldRef& fullPath,
+                                               const BSONObj& keyPrefix,
                                                BSONObjSet* keys) const {
     invariant(elem.isABSONObj());
     if (elem.embeddedObject().isEmpty()) {
         // In keeping with the behaviour of regular indexes, an empty object is indexed as-is while
         // empty arrays are indexed as 'undefined'.
-        _addKey(elem.type() == BSONType::Array ? BSONElement{} : elem, fullPath, keys);
+        _addKey(elem.type() == BSONType::Array ? BSONElement{} : elem, fullPath, keyPrefix, keys);
         return true;
     }
     return false;
@@ -170,9 +236,12 @@ bool WildcardKeyGenerator::_addKeyForEmptyLeaf(BSONElement elem,
 
 void WildcardKeyGenerator::_addKey(BSONElement elem,
                                    const FieldRef& fullPath,
+                                   const BSONObj& keyPrefix,
                                    BSONObjSet* keys) const {
-    // Wildcard keys are of the form { "": "path.to.field", "": <collation-aware value> }.
+    // Wildcard keys are of the form { "": "path.to.field", "": <collation-aware value> }, after
+    // the values of any prefix fields.
     BSONObjBuilder bob;
+    bob.appendElements(keyPrefix);
     bob.append("", fullPath.dottedField());
     if (elem) {
         CollationIndexKey::collationAwareIndexKeyAppend(elem, _collator, &bob);
@@ -183,11 +252,14 @@ void WildcardKeyGenerator::_addKey(BSONElement elem,
 }
 
 void WildcardKeyGenerator::_addMultiKey(const FieldRef& fullPath, BSONObjSet* multikeyPaths) const {
-    // Multikey paths are denoted by a key of the form { "": 1, "": "path.to.array" }. The argument
-    // 'multikeyPaths' may be nullptr if the access method is being used in an operation which does
-    // not require multikey path generation.
+    // Multikey paths are denoted by a key of the form { "": 1, "": "path.to.array" }, after a
+    // MinKey for each prefix field. The argument 'multikeyPaths' may be nullptr if the access
+    // method is being used in an operation which does not require multikey path generation.
     if (multikeyPaths) {
-        multikeyPaths->insert(BSON("" << 1 << "" << fullPath.dottedField()));
+        BSONObjBuilder bob;
+        bob.appendElements(_multikeyMetadataKeyPrefix);
+        bob.append("", fullPath.dottedField());
+        multikeyPaths->insert(bob.obj());
     }
 }
 
@@ -28,6 +28,9 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "mongo/db/exec/projection_exec_agg.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/query/collation/collator_interface.h"
@@ -38,6 +41,11 @@ namespace mongo {
  * This class is responsible for generating an aggregation projection based on the keyPattern and
  * pathProjection specs, and for subsequently extracting the set of all path-value pairs for each
  * document.
+ *
+ * The wildcard field is always the last field of the keyPattern. Any fields before it are regular
+ * "prefix" fields of a compound wildcard index, such as 'tenantId' in
+ * {tenantId: 1, "attrs.$**": 1}, whose values lead every key generated for a document. Prefix
+ * fields may not hold arrays.
  */
 class WildcardKeyGenerator {
 public:
@@ -51,6 +59,24 @@ public:
     static std::unique_ptr<ProjectionExecAgg> createProjectionExec(BSONObj keyPattern,
                                                                    BSONObj pathProjection);
 
+    /**
+     * Returns the number of regular fields which precede the wildcard field in 'keyPattern'.
+     */
+    static size_t numPrefixFields(const BSONObj& keyPattern) {
+        return static_cast<size_t>(keyPattern.nFields()) - 1;
+    }
+
+    /**
+     * Returns the wildcard field of 'keyPattern', which is its last field.
+     */
+    static BSONElement getWildcardField(const BSONObj& keyPattern);
+
+    /**
+     * Returns the leading part of the keys which store multikey metadata, which is a MinKey for
+     * each prefix field of 'keyPattern' followed by the integer 1.
+     */
+    static BSONObj makeMultikeyMetadataKeyPrefix(const BSONObj& keyPattern);
+
     WildcardKeyGenerator(BSONObj keyPattern,
                          BSONObj pathProjection,
                          const CollatorInterface* collator);
@@ -62,30 +88,47 @@ public:
      * Also adds one entry to 'multikeyPaths' for each array encountered in the post-projection
      * document, in the following format:
      *      { '': 1, '': 'path.to.array' }
+     * For a compound wildcard index, the keys are preceded by the values of the prefix fields and
+     * the multikey entries by a MinKey for each prefix field. Throws if a prefix field is an array.
      */
     void generateKeys(BSONObj inputDoc, BSONObjSet* keys, BSONObjSet* multikeyPaths) const;
 
 private:
+    // Returns the values of the prefix fields in 'inputDoc' as { '': <value>, ... }.
+    BSONObj _extractKeyPrefix(const BSONObj& inputDoc) const;
+
     // Traverses every path of the post-projection document, adding keys to the set as it goes.
     void _traverseWildcard(BSONObj obj,
                            bool objIsArray,
                            FieldRef* path,
+                           const BSONObj& keyPrefix,
                            BSONObjSet* keys,
                            BSONObjSet* multikeyPaths) const;
 
     // Helper functions to format the entry appropriately before adding it to the key/path tracker.
     void _addMultiKey(const FieldRef& fullPath, BSONObjSet* multikeyPaths) const;
-    void _addKey(BSONElement elem, const FieldRef& fullPath, BSONObjSet* keys) const;
+    void _addKey(BSONElement elem,
+                 const FieldRef& fullPath,
+                 const BSONObj& keyPrefix,
+                 BSONObjSet* keys) const;
 
     // Helper to check whether the element is a nested array, and conditionally add it to 'keys'.
     bool _addKeyForNestedArray(BSONElement elem,
                                const FieldRef& fullPath,
                                bool enclosingObjIsArray,
+                               const BSONObj& keyPrefix,
                                BSONObjSet* keys) const;
-    bool _addKeyForEmptyLeaf(BSONElement elem, const FieldRef& fullPath, BSONObjSet* keys) const;
+    bool _addKeyForEmptyLeaf(BSONElement elem,
+                             const FieldRef& fullPath,
+                             const BSONObj& keyPrefix,
+                             BSONObjSet* keys) const;
 
     std::unique_ptr<ProjectionExecAgg> _projExec;
     const CollatorInterface* _collator;
     const BSONObj _keyPattern;
+
+    // The prefix fields of a compound wildcard index, and the leading part of its multikey keys.
+    std::vector<std::string> _prefixFields;
+    const BSONObj _multikeyMetadataKeyPrefix;
 };
 }  // namespace mongo
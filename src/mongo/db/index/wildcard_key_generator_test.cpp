@@ -967,5 +967,65 @@ TEST(WildcardKeyGeneratorDottedFieldsTest, DoNotIndexDottedFieldsWithSimilarSubp
     ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
 }
 
+// Compound wildcard index tests.
+
+TEST(WildcardKeyGeneratorCompoundTest, PrefixFieldValueLeadsEachKey) {
+    WildcardKeyGenerator keyGen{fromjson("{tenantId: 1, 'attrs.$**': 1}"), {}, nullptr};
+    auto inputDoc = fromjson("{tenantId: 5, attrs: {color: 'red', sizes: [1, 2]}, other: 1}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': 5, '': 'attrs.color', '': 'red'}"),
+                                    fromjson("{'': 5, '': 'attrs.sizes', '': 1}"),
+                                    fromjson("{'': 5, '': 'attrs.sizes', '': 2}")});
+
+    auto expectedMultikeyPaths =
+        makeKeySet({fromjson("{'': {$minKey: 1}, '': 1, '': 'attrs.sizes'}")});
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
+TEST(WildcardKeyGeneratorCompoundTest, MissingPrefixFieldsAreIndexedAsNull) {
+    WildcardKeyGenerator keyGen{fromjson("{a: 1, 'b.c': 1, 'd.$**': 1}"), {}, nullptr};
+    auto inputDoc = fromjson("{b: {c: 'x'}, d: {e: 1}}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': null, '': 'x', '': 'd.e', '': 1}")});
+
+    auto expectedMultikeyPaths = makeKeySet();
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
+TEST(WildcardKeyGeneratorCompoundTest, ArrayAlongPrefixFieldIsRejected) {
+    WildcardKeyGenerator keyGen{fromjson("{'a.b': 1, '$**': 1}"), {}, nullptr};
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    ASSERT_THROWS_CODE(keyGen.generateKeys(
+                           fromjson("{a: {b: [1, 2]}}"), &outputKeys, &multikeyMetadataKeys),
+                       AssertionException,
+                       51533);
+    ASSERT_THROWS_CODE(keyGen.generateKeys(
+                           fromjson("{a: [{b: 1}]}"), &outputKeys, &multikeyMetadataKeys),
+                       AssertionException,
+                       51533);
+}
+
+TEST(WildcardKeyGeneratorCompoundTest, MultikeyMetadataKeyPrefixHasMinKeyPerPrefixField) {
+    ASSERT_BSONOBJ_EQ(fromjson("{'': 1}"),
+                      WildcardKeyGenerator::makeMultikeyMetadataKeyPrefix(fromjson("{'$**': 1}")));
+    ASSERT_BSONOBJ_EQ(fromjson("{'': {$minKey: 1}, '': {$minKey: 1}, '': 1}"),
+                      WildcardKeyGenerator::makeMultikeyMetadataKeyPrefix(
+                          fromjson("{a: 1, b: 1, 'c.$**': 1}")));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -245,6 +245,12 @@ Status IndexBuilder::_build(OperationContext* opCtx,
 
     if (allowBackgroundBuilding) {
         dbLock->relockWithMode(MODE_X);
+
+        // Apply the writes made since the collection scan ended.
+        status = indexer.drainBackgroundWrites();
+        if (!status.isOK()) {
+            return _failIndexBuild(indexer, status, allowBackgroundBuilding);
+        }
     }
     writeConflictRetry(opCtx, "Commit index build", ns.ns(), [opCtx, &indexer, &ns] {
         WriteUnitOfWork wunit(opCtx);
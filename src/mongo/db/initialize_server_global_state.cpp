@@ -52,6 +52,8 @@
 #include "mongo/db/auth/security_key.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/logger/async_log_writer.h"
+#include "mongo/logger/async_rotatable_file_appender.h"
 #include "mongo/logger/console_appender.h"
 #include "mongo/logger/logger.h"
 #include "mongo/logger/message_event.h"
@@ -62,6 +64,7 @@
 #include "mongo/logger/rotatable_file_writer.h"
 #include "mongo/logger/syslog_appender.h"
 #include "mongo/platform/process_id.h"
+#include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/net/ssl_manager.h"
@@ -211,6 +214,10 @@ void forkServerOrDie() {
 }
 
 MONGO_EXPORT_SERVER_PARAMETER(maxLogSizeKB, int, logger::LogContext::kDefaultMaxLogSizeKB);
+
+// When positive, the log file is written from a background thread, and each thread may buffer up to
+// this many kilobytes of log lines before further lines are dropped.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(asyncLogBufferSizeKB, int, 0);
 MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
                           ("GlobalLogManager", "EndStartupOptionHandling", "ForkServer"),
                           ("default"))
@@ -298,12 +305,31 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
 
         LogManager* manager = logger::globalLogManager();
         manager->getGlobalDomain()->clearAppenders();
-        manager->getGlobalDomain()->attachAppender(
-            std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
-                std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
-        manager->getNamedDomain("javascriptOutput")
-            ->attachAppender(std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
-                std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
+        if (asyncLogBufferSizeKB > 0) {
+            using logger::AsyncLogWriter;
+            using logger::AsyncRotatableFileAppender;
+
+            // Never deleted, since threads may log until the process exits.
+            auto asyncWriter = new AsyncLogWriter(
+                writer.getValue(), static_cast<size_t>(asyncLogBufferSizeKB) * 1024);
+            asyncWriter->startup();
+            registerShutdownTask([asyncWriter] { asyncWriter->shutdown(); });
+
+            manager->getGlobalDomain()->attachAppender(
+                std::make_unique<AsyncRotatableFileAppender<MessageEventEphemeral>>(
+                    std::make_unique<MessageEventDetailsEncoder>(), asyncWriter));
+            manager->getNamedDomain("javascriptOutput")
+                ->attachAppender(
+                    std::make_unique<AsyncRotatableFileAppender<MessageEventEphemeral>>(
+                        std::make_unique<MessageEventDetailsEncoder>(), asyncWriter));
+        } else {
+            manager->getGlobalDomain()->attachAppender(
+                std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
+                    std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
+            manager->getNamedDomain("javascriptOutput")
+                ->attachAppender(std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
+                    std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
+        }
 
         if (serverGlobalParams.logAppend && exists) {
             log() << "***** SERVER RESTARTED *****";
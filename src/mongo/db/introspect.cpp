@@ -41,6 +41,7 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/op_sample_buffer.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/client_metadata_ismaster.h"
 #include "mongo/util/log.h"
@@ -79,14 +80,9 @@ void _appendUserInfo(const CurOp& c, BSONObjBuilder& builder, AuthorizationSessi
     builder.append("user", bestUser.getUser().empty() ? "" : bestUser.getFullName());
 }
 
-}  // namespace
-
-
-void profile(OperationContext* opCtx, NetworkOp op) {
+BSONObj makeProfileEntry(OperationContext* opCtx) {
     // Initialize with 1kb at start in order to avoid realloc later
-    BufBuilder profileBufBuilder(1024);
-
-    BSONObjBuilder b(profileBufBuilder);
+    BSONObjBuilder b(1024);
 
     {
         Locker::LockerInfo lockerInfo;
@@ -109,7 +105,14 @@ void profile(OperationContext* opCtx, NetworkOp op) {
     AuthorizationSession* authSession = AuthorizationSession::get(opCtx->getClient());
     _appendUserInfo(*CurOp::get(opCtx), b, authSession);
 
-    const BSONObj p = b.done();
+    return b.obj();
+}
+
+}  // namespace
+
+
+void profile(OperationContext* opCtx, NetworkOp op) {
+    const BSONObj p = makeProfileEntry(opCtx);
 
     const bool wasLocked = opCtx->lockState()->isLocked();
 
@@ -174,6 +177,11 @@ void profile(OperationContext* opCtx, NetworkOp op) {
 }
 
 
+void recordOpSample(OperationContext* opCtx) {
+    OpSampleBuffer::get(opCtx->getServiceContext())->add(makeProfileEntry(opCtx));
+}
+
+
 Status createProfileCollection(OperationContext* opCtx, Database* db) {
     invariant(opCtx->lockState()->isDbLockedForMode(db->name(), MODE_X));
 
@@ -41,6 +41,12 @@ class OperationContext;
  */
 void profile(OperationContext* opCtx, NetworkOp op);
 
+/**
+ * Invoked when the operation was chosen for the OpSampleBuffer. Records the operation's profiler
+ * entry in memory, without writing to system.profile.
+ */
+void recordOpSample(OperationContext* opCtx);
+
 /**
  * Pre-creates the profile collection for the specified database.
  */
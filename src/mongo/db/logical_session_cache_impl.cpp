@@ -42,6 +42,7 @@
 #include "mongo/util/log.h"
 #include "mongo/util/periodic_runner.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -54,6 +55,26 @@ MONGO_EXPORT_STARTUP_SERVER_PARAMETER(disableLogicalSessionCacheRefresh, bool, f
 
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(maxSessions, int, 1'000'000);
 
+MONGO_EXPORT_SERVER_PARAMETER(logicalSessionRefreshBatchSize, int, 1000)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1) {
+            return Status(ErrorCodes::BadValue,
+                          "logicalSessionRefreshBatchSize must be at least 1");
+        }
+        return Status::OK();
+    });
+
+// The percentage of the refresh interval over which a periodic refresh spreads its writes to the
+// sessions collection. Zero sends all the batches back to back.
+MONGO_EXPORT_SERVER_PARAMETER(logicalSessionRefreshSpreadPercent, int, 50)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 100) {
+            return Status(ErrorCodes::BadValue,
+                          "logicalSessionRefreshSpreadPercent must be between 0 and 100");
+        }
+        return Status::OK();
+    });
+
 constexpr Milliseconds LogicalSessionCacheImpl::kLogicalSessionDefaultRefresh;
 
 LogicalSessionCacheImpl::LogicalSessionCacheImpl(
@@ -151,7 +172,7 @@ Status LogicalSessionCacheImpl::vivify(OperationContext* opCtx, const LogicalSes
 
 Status LogicalSessionCacheImpl::refreshNow(Client* client) {
     try {
-        _refresh(client);
+        _refresh(client, false);
     } catch (...) {
         return exceptionToStatus();
     }
@@ -173,7 +194,7 @@ size_t LogicalSessionCacheImpl::size() {
 
 void LogicalSessionCacheImpl::_periodicRefresh(Client* client) {
     try {
-        _refresh(client);
+        _refresh(client, true);
     } catch (...) {
         log() << "Failed to refresh session cache: " << exceptionToStatus();
     }
@@ -248,7 +269,7 @@ Status LogicalSessionCacheImpl::_reap(Client* client) {
     return Status::OK();
 }
 
-void LogicalSessionCacheImpl::_refresh(Client* client) {
+void LogicalSessionCacheImpl::_refresh(Client* client, bool spreadOverInterval) {
     // Stats for serverStatus:
     {
         stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
@@ -258,6 +279,9 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
         _stats.setLastSessionsCollectionJobEntriesRefreshed(0);
         _stats.setLastSessionsCollectionJobEntriesEnded(0);
         _stats.setLastSessionsCollectionJobCursorsClosed(0);
+        _stats.setLastSessionsCollectionJobRefreshBatches(0);
+        _stats.setLastSessionsCollectionJobRefreshMillis(0);
+        _stats.setLastSessionsCollectionJobMaxRefreshBatchMillis(0);
 
         // Start the new run.
         _stats.setLastSessionsCollectionJobTimestamp(now());
@@ -340,7 +364,7 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
     }
 
     // Refresh the active sessions in the sessions collection.
-    uassertStatusOK(_sessionsColl->refreshSessions(opCtx, activeSessionRecords));
+    _refreshSessionRecords(opCtx, activeSessionRecords, spreadOverInterval);
     activeSessionsBackSwapper.Dismiss();
     {
         stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
@@ -399,6 +423,51 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
     }
 }
 
+void LogicalSessionCacheImpl::_refreshSessionRecords(OperationContext* opCtx,
+                                                     const LogicalSessionRecordSet& records,
+                                                     bool spreadOverInterval) {
+    const size_t batchSize = logicalSessionRefreshBatchSize.load();
+    const size_t numBatches = (records.size() + batchSize - 1) / batchSize;
+
+    // Each batch is given an equal share of the part of the interval the refresh is spread over,
+    // and waits out whatever of its share the write did not use before the next batch is sent.
+    const Milliseconds batchShare = (spreadOverInterval && numBatches > 1)
+        ? _refreshInterval * logicalSessionRefreshSpreadPercent.load() / 100 /
+            static_cast<long long>(numBatches)
+        : Milliseconds(0);
+
+    long long totalMillis = 0;
+    long long maxBatchMillis = 0;
+    size_t batchesSent = 0;
+
+    auto it = records.begin();
+    while (it != records.end()) {
+        LogicalSessionRecordSet batch;
+        while (it != records.end() && batch.size() < batchSize) {
+            batch.insert(*it++);
+        }
+
+        Timer batchTimer;
+        uassertStatusOK(_sessionsColl->refreshSessions(opCtx, batch));
+        const long long batchMillis = batchTimer.millis();
+
+        totalMillis += batchMillis;
+        maxBatchMillis = std::max(maxBatchMillis, batchMillis);
+        ++batchesSent;
+        {
+            stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
+            _stats.setLastSessionsCollectionJobRefreshBatches(batchesSent);
+            _stats.setLastSessionsCollectionJobRefreshMillis(totalMillis);
+            _stats.setLastSessionsCollectionJobMaxRefreshBatchMillis(maxBatchMillis);
+        }
+
+        const auto remainingShare = batchShare - Milliseconds(batchMillis);
+        if (it != records.end() && remainingShare > Milliseconds(0)) {
+            opCtx->sleepFor(remainingShare);
+        }
+    }
+}
+
 void LogicalSessionCacheImpl::endSessions(const LogicalSessionIdSet& sessions) {
     stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
     _endingSessions.insert(begin(sessions), end(sessions));
@@ -133,7 +133,17 @@ private:
      * session records contained within the cache.
      */
     void _periodicRefresh(Client* client);
-    void _refresh(Client* client);
+    void _refresh(Client* client, bool spreadOverInterval);
+
+    /**
+     * Upserts 'records' into the sessions collection in batches of at most
+     * logicalSessionRefreshBatchSize records. If 'spreadOverInterval' is true, the batches are
+     * paced so that they are spread over logicalSessionRefreshSpreadPercent of the refresh
+     * interval, rather than sent back to back.
+     */
+    void _refreshSessionRecords(OperationContext* opCtx,
+                                const LogicalSessionRecordSet& records,
+                                bool spreadOverInterval);
 
     void _periodicReap(Client* client);
     Status _reap(Client* client);
@@ -234,9 +234,13 @@ TEST_F(LogicalSessionCacheTest, ManySignedLsidsInCacheRefresh) {
         ASSERT_OK(cache()->startSession(opCtx(), record));
     }
 
-    // Check that all signedLsids refresh
-    sessions()->setRefreshHook([&count](const LogicalSessionRecordSet& sessions) {
-        ASSERT_EQ(sessions.size(), size_t(count));
+    // Check that all signedLsids refresh, in batches of at most the refresh batch size
+    size_t refreshed = 0;
+    size_t batches = 0;
+    sessions()->setRefreshHook([&](const LogicalSessionRecordSet& sessions) {
+        ASSERT_LTE(sessions.size(), 1000U);
+        refreshed += sessions.size();
+        ++batches;
         return Status::OK();
     });
 
@@ -244,6 +248,14 @@ TEST_F(LogicalSessionCacheTest, ManySignedLsidsInCacheRefresh) {
     clearOpCtx();
     service()->fastForward(kForceRefresh);
     ASSERT(cache()->refreshNow(getClient()).isOK());
+    ASSERT_EQ(size_t(count), refreshed);
+    ASSERT_EQ(10U, batches);
+
+    auto stats = cache()->getStats();
+    ASSERT_EQ(10, stats.getLastSessionsCollectionJobRefreshBatches());
+    ASSERT_EQ(count, stats.getLastSessionsCollectionJobEntriesRefreshed());
+    ASSERT_GTE(stats.getLastSessionsCollectionJobRefreshMillis(),
+               stats.getLastSessionsCollectionJobMaxRefreshBatchMillis());
 }
 
 //
@@ -106,7 +106,20 @@ SignedLogicalTime LogicalTimeValidator::_getProof(const KeysCollectionDocument&
     return newSignedTime;
 }
 
+boost::optional<SignedLogicalTime> LogicalTimeValidator::_getLastSignedTime(
+    const LogicalTime& newTime) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (newTime == _lastSeenValidTime.getTime() && _lastSeenValidTime.getProof()) {
+        return _lastSeenValidTime;
+    }
+    return boost::none;
+}
+
 SignedLogicalTime LogicalTimeValidator::trySignLogicalTime(const LogicalTime& newTime) {
+    if (auto lastSignedTime = _getLastSignedTime(newTime)) {
+        return *lastSignedTime;
+    }
+
     auto keyStatusWith = _getKeyManagerCopy()->getKeyForSigning(nullptr, newTime);
     auto keyStatus = keyStatusWith.getStatus();
 
@@ -121,6 +134,10 @@ SignedLogicalTime LogicalTimeValidator::trySignLogicalTime(const LogicalTime& ne
 
 SignedLogicalTime LogicalTimeValidator::signLogicalTime(OperationContext* opCtx,
                                                         const LogicalTime& newTime) {
+    if (auto lastSignedTime = _getLastSignedTime(newTime)) {
+        return *lastSignedTime;
+    }
+
     auto keyManager = _getKeyManagerCopy();
     auto keyStatusWith = keyManager->getKeyForSigning(nullptr, newTime);
     auto keyStatus = keyStatusWith.getStatus();
@@ -143,7 +160,8 @@ SignedLogicalTime LogicalTimeValidator::signLogicalTime(OperationContext* opCtx,
 Status LogicalTimeValidator::validate(OperationContext* opCtx, const SignedLogicalTime& newTime) {
     {
         stdx::lock_guard<stdx::mutex> lk(_mutex);
-        if (newTime.getTime() <= _lastSeenValidTime.getTime()) {
+        if (newTime.getTime() <= _lastSeenValidTime.getTime() ||
+            newTime.getTime() <= _lastValidatedTime) {
             return Status::OK();
         }
     }
@@ -159,11 +177,16 @@ Status LogicalTimeValidator::validate(OperationContext* opCtx, const SignedLogic
     // received cluster times should have proofs.
     invariant(newProof);
 
-    auto res = _timeProofService.checkProof(newTime.getTime(), newProof.get(), key);
+    auto res = _validationProofService.checkProof(newTime.getTime(), newProof.get(), key);
     if (res != Status::OK()) {
         return res;
     }
 
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (newTime.getTime() > _lastValidatedTime) {
+        _lastValidatedTime = newTime.getTime();
+    }
+
     return Status::OK();
 }
 
@@ -203,7 +226,9 @@ void LogicalTimeValidator::resetKeyManagerCache() {
     }
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     _lastSeenValidTime = SignedLogicalTime();
+    _lastValidatedTime = LogicalTime();
     _timeProofService.resetCache();
+    _validationProofService.resetCache();
 }
 
 void LogicalTimeValidator::stopKeyManager() {
@@ -215,7 +240,9 @@ void LogicalTimeValidator::stopKeyManager() {
 
         stdx::lock_guard<stdx::mutex> lk(_mutex);
         _lastSeenValidTime = SignedLogicalTime();
+        _lastValidatedTime = LogicalTime();
         _timeProofService.resetCache();
+        _validationProofService.resetCache();
     } else {
         log() << "Stopping key manager: no key manager exists.";
     }
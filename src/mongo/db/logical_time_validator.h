@@ -121,10 +121,25 @@ private:
 
     SignedLogicalTime _getProof(const KeysCollectionDocument& keyDoc, LogicalTime newTime);
 
-    stdx::mutex _mutex;            // protects _lastSeenValidTime
+    /**
+     * Returns the last signed time if it is newTime, so signing the same time again needs neither
+     * a key lookup nor an HMAC.
+     */
+    boost::optional<SignedLogicalTime> _getLastSignedTime(const LogicalTime& newTime);
+
+    stdx::mutex _mutex;            // protects _lastSeenValidTime and _lastValidatedTime
     stdx::mutex _mutexKeyManager;  // protects _keyManager
     SignedLogicalTime _lastSeenValidTime;
+
+    // The greatest time whose proof validate() has checked. No time up to it can advance the clock
+    // past a genuine cluster time, so validate() accepts those without checking them again.
+    LogicalTime _lastValidatedTime;
+
     TimeProofService _timeProofService;
+
+    // Used only to check proofs in validate(), so that the times gossiped by other nodes and the
+    // times this node signs do not evict one another from the one-entry proof caches.
+    TimeProofService _validationProofService;
     std::shared_ptr<KeysCollectionManager> _keyManager;
 };
 
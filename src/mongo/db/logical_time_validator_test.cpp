@@ -160,6 +160,47 @@ TEST_F(LogicalTimeValidatorTest, ValidateErrorsOnInvalidTimeWithImplicitRefresh)
     ASSERT_EQ(ErrorCodes::TimeProofMismatch, status);
 }
 
+TEST_F(LogicalTimeValidatorTest, ValidateSkipsTimesNotNewerThanTheLastValidatedTime) {
+    validator()->enableKeyGenerator(operationContext(), true);
+
+    LogicalTime t1(Timestamp(20, 0));
+    refreshKeyManager();
+    auto newTime = validator()->trySignLogicalTime(t1);
+
+    // Forget the signed time so that validating it checks its proof.
+    validator()->resetKeyManagerCache();
+    refreshKeyManager();
+    ASSERT_OK(validator()->validate(operationContext(), newTime));
+
+    // Times up to the validated one are accepted without checking their proofs again.
+    TimeProofService::TimeProof invalidProof = {{{1, 2, 3}}};
+    ASSERT_OK(validator()->validate(operationContext(),
+                                    SignedLogicalTime(t1, invalidProof, newTime.getKeyId())));
+    ASSERT_OK(validator()->validate(
+        operationContext(),
+        SignedLogicalTime(LogicalTime(Timestamp(10, 0)), invalidProof, newTime.getKeyId())));
+
+    // Newer times still are checked.
+    SignedLogicalTime invalidTime(LogicalTime(Timestamp(30, 0)), invalidProof, newTime.getKeyId());
+    ASSERT_EQ(ErrorCodes::TimeProofMismatch,
+              validator()->validate(operationContext(), invalidTime));
+}
+
+TEST_F(LogicalTimeValidatorTest, SigningTheSameTimeAgainReturnsTheSameProof) {
+    validator()->enableKeyGenerator(operationContext(), true);
+
+    LogicalTime t1(Timestamp(20, 0));
+    refreshKeyManager();
+    auto newTime = validator()->trySignLogicalTime(t1);
+    ASSERT_TRUE(newTime.getProof());
+
+    auto sameTime = validator()->signLogicalTime(operationContext(), t1);
+    ASSERT_EQ(t1, sameTime.getTime());
+    ASSERT_TRUE(newTime.getProof() == sameTime.getProof());
+    ASSERT_EQ(newTime.getKeyId(), sameTime.getKeyId());
+    ASSERT_OK(validator()->validate(operationContext(), sameTime));
+}
+
 TEST_F(LogicalTimeValidatorTest, ShouldGossipLogicalTimeIsFalseUntilKeysAreFound) {
     // shouldGossipLogicalTime initially returns false.
     ASSERT_EQ(false, validator()->shouldGossipLogicalTime());
@@ -112,6 +112,12 @@ ComparisonMatchExpression::ComparisonMatchExpression(MatchType type,
     }
 }
 
+void ComparisonMatchExpression::setData(const BSONElement& rhs) {
+    invariant(rhs);
+    uassert(ErrorCodes::BadValue, "cannot compare to undefined", rhs.type() != BSONType::Undefined);
+    _rhs = rhs;
+}
+
 bool ComparisonMatchExpression::matchesSingleElement(const BSONElement& e,
                                                      MatchDetails* details) const {
     if (e.canonicalType() != _rhs.canonicalType()) {
@@ -380,10 +386,91 @@ bool ExistsMatchExpression::equivalent(const MatchExpression* other) const {
 
 // ----
 
+namespace {
+
+/**
+ * Returns whether 'elem' is a number with an exact 64-bit integer value, setting 'value' to it.
+ */
+bool getExactIntegerValue(const BSONElement& elem, long long* value) {
+    switch (elem.type()) {
+        case NumberInt:
+            *value = elem._numberInt();
+            return true;
+        case NumberLong:
+            *value = elem._numberLong();
+            return true;
+        case NumberDouble: {
+            const double d = elem._numberDouble();
+            // The upper limit is 2^63, which is the first double too large for a long long.
+            if (d >= -9223372036854775808.0 && d < 9223372036854775808.0 && std::trunc(d) == d) {
+                *value = static_cast<long long>(d);
+                return true;
+            }
+            return false;
+        }
+        default:
+            return false;
+    }
+}
+
+/**
+ * Returns 'elements' sorted by 'eltCmp'.
+ */
+std::vector<BSONElement> sortElements(std::vector<BSONElement> elements,
+                                      const BSONElementComparator& eltCmp) {
+    if (!std::is_sorted(elements.begin(), elements.end(), eltCmp.makeLessThan())) {
+        // Sort the list of equalities to work around https://svn.boost.org/trac10/ticket/13140.
+        std::sort(elements.begin(), elements.end(), eltCmp.makeLessThan());
+    }
+    return elements;
+}
+
+}  // namespace
+
+constexpr size_t InMatchExpression::kMinEqualitiesToHash;
+
+InMatchExpression::Equalities::Equalities(std::vector<BSONElement> elements,
+                                          const CollatorInterface* collator)
+    : eltCmp(BSONElementComparator::FieldNamesMode::kIgnore, collator),
+      sortedElements(sortElements(std::move(elements), eltCmp)),
+      set(eltCmp.makeBSONEltFlatSet(sortedElements)) {
+    if (set.size() < kMinEqualitiesToHash) {
+        return;
+    }
+
+    hashesNumbers = std::none_of(set.begin(), set.end(), [](const BSONElement& elem) {
+        return elem.type() == NumberDecimal;
+    });
+    hashesStrings = !collator;
+    for (auto&& elem : set) {
+        long long value;
+        if (hashesNumbers && getExactIntegerValue(elem, &value)) {
+            integers.insert(value);
+        } else if (hashesStrings && (elem.type() == String || elem.type() == Symbol)) {
+            strings.insert(StringData(elem.valuestr(), elem.valuestrsize() - 1));
+        }
+    }
+}
+
+bool InMatchExpression::Equalities::findInHashSets(const BSONElement& elem, bool* found) const {
+    if (hashesNumbers && elem.isNumber()) {
+        long long value;
+        if (!getExactIntegerValue(elem, &value)) {
+            return false;
+        }
+        *found = integers.count(value) > 0;
+        return true;
+    }
+    if (hashesStrings && (elem.type() == String || elem.type() == Symbol)) {
+        *found = strings.count(StringData(elem.valuestr(), elem.valuestrsize() - 1)) > 0;
+        return true;
+    }
+    return false;
+}
+
 InMatchExpression::InMatchExpression(StringData path)
     : LeafMatchExpression(MATCH_IN, path),
-      _eltCmp(BSONElementComparator::FieldNamesMode::kIgnore, _collator),
-      _equalitySet(_eltCmp.makeBSONEltFlatSet(_originalEqualityVector)) {}
+      _equalities(std::make_shared<Equalities>(std::vector<BSONElement>(), _collator)) {}
 
 std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     auto next = stdx::make_unique<InMatchExpression>(path());
@@ -393,8 +480,7 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     }
     next->_hasNull = _hasNull;
     next->_hasEmptyArray = _hasEmptyArray;
-    next->_equalitySet = _equalitySet;
-    next->_originalEqualityVector = _originalEqualityVector;
+    next->_equalities = _equalities;
     for (auto&& regex : _regexes) {
         std::unique_ptr<RegexMatchExpression> clonedRegex(
             static_cast<RegexMatchExpression*>(regex->shallowClone().release()));
@@ -407,7 +493,12 @@ bool InMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetails*
     if (_hasNull && e.eoo()) {
         return true;
     }
-    if (_equalitySet.find(e) != _equalitySet.end()) {
+    bool found;
+    if (_equalities->findInHashSets(e, &found)) {
+        if (found) {
+            return true;
+        }
+    } else if (_equalities->set.find(e) != _equalities->set.end()) {
         return true;
     }
     for (auto&& regex : _regexes) {
@@ -422,7 +513,7 @@ void InMatchExpression::debugString(StringBuilder& debug, int level) const {
     _debugAddSpace(debug, level);
     debug << path() << " $in ";
     debug << "[ ";
-    for (auto&& equality : _equalitySet) {
+    for (auto&& equality : _equalities->set) {
         debug << equality.toString(false) << " ";
     }
     for (auto&& regex : _regexes) {
@@ -441,7 +532,7 @@ void InMatchExpression::debugString(StringBuilder& debug, int level) const {
 void InMatchExpression::serialize(BSONObjBuilder* out) const {
     BSONObjBuilder inBob(out->subobjStart(path()));
     BSONArrayBuilder arrBob(inBob.subarrayStart("$in"));
-    for (auto&& _equality : _equalitySet) {
+    for (auto&& _equality : _equalities->set) {
         arrBob.append(_equality);
     }
     for (auto&& _regex : _regexes) {
@@ -475,39 +566,32 @@ bool InMatchExpression::equivalent(const MatchExpression* other) const {
     if (!CollatorInterface::collatorsMatch(_collator, realOther->_collator)) {
         return false;
     }
-    // We use an element-wise comparison to check equivalence of '_equalitySet'.  Unfortunately, we
-    // can't use BSONElementSet::operator==(), as it does not use the comparator object the set is
-    // initialized with (and as such, it is not collation-aware).
-    if (_equalitySet.size() != realOther->_equalitySet.size()) {
+    // We use an element-wise comparison to check equivalence of the equality sets.  Unfortunately,
+    // we can't use BSONElementSet::operator==(), as it does not use the comparator object the set
+    // is initialized with (and as such, it is not collation-aware).
+    const auto& equalitySet = _equalities->set;
+    const auto& otherEqualitySet = realOther->_equalities->set;
+    if (equalitySet.size() != otherEqualitySet.size()) {
         return false;
     }
-    auto thisEqIt = _equalitySet.begin();
-    auto otherEqIt = realOther->_equalitySet.begin();
-    for (; thisEqIt != _equalitySet.end(); ++thisEqIt, ++otherEqIt) {
+    auto thisEqIt = equalitySet.begin();
+    auto otherEqIt = otherEqualitySet.begin();
+    for (; thisEqIt != equalitySet.end(); ++thisEqIt, ++otherEqIt) {
         const bool considerFieldName = false;
         if (thisEqIt->woCompare(*otherEqIt, considerFieldName, _collator)) {
             return false;
         }
     }
-    invariant(otherEqIt == realOther->_equalitySet.end());
+    invariant(otherEqIt == otherEqualitySet.end());
     return true;
 }
 
 void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
     _collator = collator;
-    _eltCmp = BSONElementComparator(BSONElementComparator::FieldNamesMode::kIgnore, _collator);
 
-    if (!std::is_sorted(_originalEqualityVector.begin(),
-                        _originalEqualityVector.end(),
-                        _eltCmp.makeLessThan())) {
-        // Re-sort the list of equalities according to our current comparator. This is necessary to
-        // work around https://svn.boost.org/trac10/ticket/13140.
-        std::sort(
-            _originalEqualityVector.begin(), _originalEqualityVector.end(), _eltCmp.makeLessThan());
-    }
-
-    // We need to re-compute '_equalitySet', since our set comparator has changed.
-    _equalitySet = _eltCmp.makeBSONEltFlatSet(_originalEqualityVector);
+    // We need to re-compute the equality set, since our set comparator has changed. The equalities
+    // are re-sorted according to the new comparator as they are rebuilt.
+    _equalities = std::make_shared<Equalities>(_equalities->sortedElements, _collator);
 }
 
 Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
@@ -526,21 +610,20 @@ Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
         }
     }
 
-    _originalEqualityVector = std::move(equalities);
-
-    if (!std::is_sorted(_originalEqualityVector.begin(),
-                        _originalEqualityVector.end(),
-                        _eltCmp.makeLessThan())) {
-        // Sort the list of equalities to work around https://svn.boost.org/trac10/ticket/13140.
-        std::sort(
-            _originalEqualityVector.begin(), _originalEqualityVector.end(), _eltCmp.makeLessThan());
-    }
-
-    _equalitySet = _eltCmp.makeBSONEltFlatSet(_originalEqualityVector);
+    _equalities = std::make_shared<Equalities>(std::move(equalities), _collator);
 
     return Status::OK();
 }
 
+InMatchExpression::PlannerData* InMatchExpression::getOrCreatePlannerData(
+    const stdx::function<std::unique_ptr<PlannerData>()>& makeData) const {
+    stdx::lock_guard<stdx::mutex> lock(_equalities->plannerDataMutex);
+    if (!_equalities->plannerData) {
+        _equalities->plannerData = makeData();
+    }
+    return _equalities->plannerData.get();
+}
+
 Status InMatchExpression::addRegex(std::unique_ptr<RegexMatchExpression> expr) {
     _regexes.push_back(std::move(expr));
     return Status::OK();
@@ -552,7 +635,7 @@ MatchExpression::ExpressionOptimizerFunc InMatchExpression::getOptimizer() const
         // _regexes list. We assume that optimize() on a RegexMatchExpression is a no-op.
 
         auto& regexList = static_cast<InMatchExpression&>(*expression)._regexes;
-        auto& equalitySet = static_cast<InMatchExpression&>(*expression)._equalitySet;
+        auto& equalitySet = static_cast<InMatchExpression&>(*expression).getEqualities();
         auto collator = static_cast<InMatchExpression&>(*expression).getCollator();
         if (regexList.size() == 1 && equalitySet.empty()) {
             // Simplify IN of exactly one regex to be a regex match.
@@ -28,14 +28,20 @@
 
 #pragma once
 
+#include <memory>
+
+#include "mongo/base/simple_string_data_comparator.h"
 #include "mongo/bson/bsonelement_comparator.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_path.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/stdx/functional.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/stdx/unordered_set.h"
 
 namespace pcrecpp {
 class RE;
@@ -166,6 +172,12 @@ public:
 
     virtual ~ComparisonMatchExpression() = default;
 
+    /**
+     * Replaces the value this expression compares against, as when binding a parameter of a
+     * prepared query. 'rhs' must outlive this expression and any clones made of it.
+     */
+    void setData(const BSONElement& rhs);
+
     bool matchesSingleElement(const BSONElement&, MatchDetails* details = nullptr) const final;
 };
 
@@ -397,6 +409,16 @@ private:
  */
 class InMatchExpression : public LeafMatchExpression {
 public:
+    /**
+     * State which the query planner derives from the equalities of an InMatchExpression, such as
+     * the index bounds they translate to. It is attached to the equalities, and so is shared by the
+     * clones of the expression and discarded whenever the equalities or the collator change.
+     */
+    class PlannerData {
+    public:
+        virtual ~PlannerData() = default;
+    };
+
     explicit InMatchExpression(StringData path);
 
     virtual std::unique_ptr<MatchExpression> shallowClone() const;
@@ -419,9 +441,16 @@ public:
     Status addRegex(std::unique_ptr<RegexMatchExpression> expr);
 
     const BSONEltFlatSet& getEqualities() const {
-        return _equalitySet;
+        return _equalities->set;
     }
 
+    /**
+     * Returns the PlannerData attached to the equalities, attaching the result of 'makeData' first
+     * if there is none. May be called concurrently on the clones of an expression.
+     */
+    PlannerData* getOrCreatePlannerData(
+        const stdx::function<std::unique_ptr<PlannerData>()>& makeData) const;
+
     const std::vector<std::unique_ptr<RegexMatchExpression>>& getRegexes() const {
         return _regexes;
     }
@@ -439,6 +468,55 @@ public:
     }
 
 private:
+    /**
+     * The equalities of an InMatchExpression under one collator, along with the structures used to
+     * look them up. Apart from the attached PlannerData, it is never modified once built, so that
+     * clones of the expression can share it rather than copy every equality.
+     */
+    struct Equalities {
+        Equalities(std::vector<BSONElement> elements, const CollatorInterface* collator);
+
+        /**
+         * Looks 'elem' up in the hash sets, returning true and setting 'found' if they can tell
+         * whether 'elem' is equal to one of the equalities. Returns false if 'set' must be
+         * searched instead.
+         */
+        bool findInHashSets(const BSONElement& elem, bool* found) const;
+
+        // Comparator used to compare elements. By default, simple binary comparison will be used.
+        BSONElementComparator eltCmp;
+
+        // Original container of equality elements, including duplicates. Needed for re-computing
+        // 'set' in case the collator changes after elements have been added.
+        //
+        // We keep the equalities in sorted order according to 'eltCmp'. This list of equalities
+        // will be used to construct a boost::flat_set, which maintains the set of elements in
+        // sorted order within a contiguous region of memory. Sorting and then constructing a
+        // flat_set is O(n log n), whereas the boost::flat_set constructor is O(n ^ 2) due to
+        // https://svn.boost.org/trac10/ticket/13140.
+        std::vector<BSONElement> sortedElements;
+
+        // Set of equality elements, ordered by 'eltCmp'.
+        BSONEltFlatSet set;
+
+        // For a large list, the numeric equalities with an exact 64-bit integer value, provided no
+        // equality is a decimal, and the string and symbol equalities, provided there is no
+        // collator. A number or string which these sets do not contain is in 'set' only if it is a
+        // number with no exact 64-bit integer value.
+        bool hashesNumbers = false;
+        stdx::unordered_set<long long> integers;
+        bool hashesStrings = false;
+        StringData::ComparatorInterface::StringDataUnorderedSet strings =
+            SimpleStringDataComparator::kInstance.makeStringDataUnorderedSet();
+
+        mutable stdx::mutex plannerDataMutex;
+        mutable std::unique_ptr<PlannerData> plannerData;
+    };
+
+    // The fewest equalities for which the hash sets in 'Equalities' are built. Smaller lists are
+    // only searched by binary search.
+    static constexpr size_t kMinEqualitiesToHash = 16;
+
     ExpressionOptimizerFunc getOptimizer() const final;
 
     // Whether or not '_equalities' has a jstNULL element in it.
@@ -447,25 +525,11 @@ private:
     // Whether or not '_equalities' has an empty array element in it.
     bool _hasEmptyArray = false;
 
-    // Collator used to construct '_eltCmp';
+    // Collator used to construct '_equalities'.
     const CollatorInterface* _collator = nullptr;
 
-    // Comparator used to compare elements. By default, simple binary comparison will be used.
-    BSONElementComparator _eltCmp;
-
-    // Original container of equality elements, including duplicates. Needed for re-computing
-    // '_equalitySet' in case '_collator' changes after elements have been added.
-    //
-    // We keep the equalities in sorted order according to the current BSON element comparator. This
-    // list of equalities will be used to construct a boost::flat_set, which maintains the set of
-    // elements in sorted order within a contiguous region of memory. Sorting and then constructing
-    // a flat_set is O(n log n), whereas the boost::flat_set constructor is O(n ^ 2) due to
-    // https://svn.boost.org/trac10/ticket/13140.
-    std::vector<BSONElement> _originalEqualityVector;
-
-    // Set of equality elements associated with this expression. '_eltCmp' is used as a comparator
-    // for this set.
-    BSONEltFlatSet _equalitySet;
+    // The equality elements associated with this expression, shared with its clones.
+    std::shared_ptr<const Equalities> _equalities;
 
     // Container of regex elements this object owns.
     std::vector<std::unique_ptr<RegexMatchExpression>> _regexes;
@@ -1350,6 +1350,97 @@ TEST(InMatchExpression, ChangingCollationAfterAddingEqualitiesPreservesEqualitie
     ASSERT(in.getEqualities().count(obj2.firstElement()));
 }
 
+TEST(InMatchExpression, LargeNumericInListMatchesAcrossNumericTypes) {
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 32; ++i) {
+        bab.append(i * 10);
+    }
+    bab.append(2.5);
+    BSONArray operand = bab.arr();
+    InMatchExpression in("");
+    std::vector<BSONElement> equalities;
+    operand.elems(equalities);
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+
+    ASSERT(in.matchesSingleElement(BSON("a" << 40)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 40LL)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 40.0)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << Decimal128(40))["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 2.5)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 41)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 40.5)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a"
+                                         << "40")["a"]));
+}
+
+TEST(InMatchExpression, LargeInListWithDecimalMatchesEquivalentNumbers) {
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 32; ++i) {
+        bab.append(i);
+    }
+    bab.append(Decimal128("100.25"));
+    BSONArray operand = bab.arr();
+    InMatchExpression in("");
+    std::vector<BSONElement> equalities;
+    operand.elems(equalities);
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+
+    ASSERT(in.matchesSingleElement(BSON("a" << 7.0)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 100.25)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 32)["a"]));
+}
+
+TEST(InMatchExpression, LargeStringInListRespectsCollation) {
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 32; ++i) {
+        bab.append("string" + std::to_string(i));
+    }
+    BSONArray operand = bab.arr();
+    BSONObj match = BSON("a"
+                         << "string7");
+    BSONObj reversed = BSON("a"
+                            << "7gnirts");
+
+    InMatchExpression in("");
+    std::vector<BSONElement> equalities;
+    operand.elems(equalities);
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+    ASSERT(in.matchesSingleElement(match["a"]));
+    ASSERT(!in.matchesSingleElement(reversed["a"]));
+
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    InMatchExpression collatedIn("");
+    collatedIn.setCollator(&collator);
+    equalities.clear();
+    operand.elems(equalities);
+    ASSERT_OK(collatedIn.setEqualities(std::move(equalities)));
+    ASSERT(collatedIn.matchesSingleElement(match["a"]));
+    ASSERT(!collatedIn.matchesSingleElement(reversed["a"]));
+    ASSERT(!collatedIn.matchesSingleElement(BSON("a"
+                                                 << "string77")["a"]));
+}
+
+TEST(InMatchExpression, ClonedLargeInListMatchesAfterOriginalIsDestroyed) {
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 32; ++i) {
+        bab.append(i);
+    }
+    BSONArray operand = bab.arr();
+    std::unique_ptr<MatchExpression> clone;
+    {
+        InMatchExpression in("");
+        std::vector<BSONElement> equalities;
+        operand.elems(equalities);
+        ASSERT_OK(in.setEqualities(std::move(equalities)));
+        clone = in.shallowClone();
+        ASSERT(in.equivalent(clone.get()));
+    }
+    auto clonedIn = static_cast<const InMatchExpression*>(clone.get());
+    ASSERT_EQ(clonedIn->getEqualities().size(), 32U);
+    ASSERT(clonedIn->matchesSingleElement(BSON("a" << 31)["a"]));
+    ASSERT(!clonedIn->matchesSingleElement(BSON("a" << 32)["a"]));
+}
+
 std::vector<uint32_t> bsonArrayToBitPositions(const BSONArray& ba) {
     std::vector<uint32_t> bitPositions;
 
@@ -72,6 +72,13 @@ public:
         return _path;
     }
 
+    /**
+     * Returns the ElementPath through which matches() reads its input document.
+     */
+    const ElementPath& elementPath() const {
+        return _elementPath;
+    }
+
     void setPath(StringData path) {
         _path = path;
         _elementPath.init(_path);
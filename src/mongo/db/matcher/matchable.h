@@ -30,6 +30,9 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/field_ref.h"
@@ -85,10 +88,11 @@ public:
     }
 
     virtual ElementIterator* allocateIterator(const ElementPath* path) const {
+        const BSONFieldIndex* fieldIndex = getFieldIndex();
         if (_iteratorUsed)
-            return new BSONElementIterator(path, _obj);
+            return new BSONElementIterator(path, _obj, fieldIndex);
         _iteratorUsed = true;
-        _iterator.reset(path, _obj);
+        _iterator.reset(path, _obj, fieldIndex);
         return &_iterator;
     }
 
@@ -101,9 +105,26 @@ public:
     }
 
 private:
+    /**
+     * Returns an index of '_obj' once enough paths have been looked up in it for the index to be
+     * cheaper than scanning '_obj' for each path, or nullptr before then.
+     */
+    const BSONFieldIndex* getFieldIndex() const {
+        if (_fieldIndex) {
+            return &*_fieldIndex;
+        }
+        if (++_numLookups < BSONFieldIndex::kMinLookups) {
+            return nullptr;
+        }
+        _fieldIndex.emplace(_obj);
+        return &*_fieldIndex;
+    }
+
     BSONObj _obj;
     mutable BSONElementIterator _iterator;
     mutable bool _iteratorUsed;
+    mutable int _numLookups = 0;
+    mutable boost::optional<BSONFieldIndex> _fieldIndex;
 };
 
 /**
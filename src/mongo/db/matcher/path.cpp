@@ -85,14 +85,16 @@ BSONElementIterator::BSONElementIterator() {
 BSONElementIterator::BSONElementIterator(const ElementPath* path,
                                          size_t suffixIndex,
                                          BSONElement elementToIterate)
-    : _path(path), _state(BEGIN) {
+    : _path(path), _traversalStartIndex(0), _state(BEGIN) {
     _setTraversalStart(suffixIndex, elementToIterate);
 }
 
-BSONElementIterator::BSONElementIterator(const ElementPath* path, const BSONObj& objectToIterate)
+BSONElementIterator::BSONElementIterator(const ElementPath* path,
+                                         const BSONObj& objectToIterate,
+                                         const BSONFieldIndex* fieldIndex)
     : _path(path), _state(BEGIN) {
-    _traversalStart =
-        getFieldDottedOrArray(objectToIterate, _path->fieldRef(), &_traversalStartIndex);
+    _traversalStart = getFieldDottedOrArray(
+        objectToIterate, _path->fieldRef(), &_traversalStartIndex, 0, fieldIndex);
 }
 
 BSONElementIterator::~BSONElementIterator() {}
@@ -111,11 +113,13 @@ void BSONElementIterator::reset(const ElementPath* path,
     _subCursorPath.reset();
 }
 
-void BSONElementIterator::reset(const ElementPath* path, const BSONObj& objectToIterate) {
+void BSONElementIterator::reset(const ElementPath* path,
+                                const BSONObj& objectToIterate,
+                                const BSONFieldIndex* fieldIndex) {
     _path = path;
     _traversalStartIndex = 0;
-    _traversalStart =
-        getFieldDottedOrArray(objectToIterate, _path->fieldRef(), &_traversalStartIndex);
+    _traversalStart = getFieldDottedOrArray(
+        objectToIterate, _path->fieldRef(), &_traversalStartIndex, 0, fieldIndex);
     _state = BEGIN;
     _next.reset();
 
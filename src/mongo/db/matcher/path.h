@@ -33,6 +33,7 @@
 
 #include "mongo/base/status.h"
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/field_ref.h"
 
@@ -195,14 +196,19 @@ public:
 
     /**
      * Constructs an iterator over 'objectToIterate', where the desired element(s) is/are at the end
-     * of 'path'.
+     * of 'path'. If 'fieldIndex' is non-null, it must index 'objectToIterate' and is used to find
+     * the first field of 'path'.
      */
-    BSONElementIterator(const ElementPath* path, const BSONObj& objectToIterate);
+    BSONElementIterator(const ElementPath* path,
+                        const BSONObj& objectToIterate,
+                        const BSONFieldIndex* fieldIndex = nullptr);
 
     virtual ~BSONElementIterator();
 
     void reset(const ElementPath* path, size_t suffixIndex, BSONElement elementToIterate);
-    void reset(const ElementPath* path, const BSONObj& objectToIterate);
+    void reset(const ElementPath* path,
+               const BSONObj& objectToIterate,
+               const BSONFieldIndex* fieldIndex = nullptr);
 
     bool more();
     Context next();
@@ -0,0 +1,455 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/schema/compiled_json_schema.h"
+
+#include <boost/optional.hpp>
+#include <set>
+#include <vector>
+
+#include "mongo/bson/bsontypes.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/matcher_type_set.h"
+#include "mongo/db/matcher/schema/expression_internal_schema_max_length.h"
+#include "mongo/db/matcher/schema/expression_internal_schema_min_length.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+namespace {
+
+// The path given to the leaf match expressions, which are only ever applied to single elements.
+constexpr StringData kPlaceholderPath = "i"_sd;
+
+// Properties of one level of a schema are tracked in a 64-bit mask while walking a document.
+const size_t kMaxCompiledProperties = 64;
+
+const std::set<StringData> kCompiledKeywords{
+    "additionalProperties"_sd,
+    "bsonType"_sd,
+    "description"_sd,
+    "exclusiveMaximum"_sd,
+    "exclusiveMinimum"_sd,
+    "maxLength"_sd,
+    "maxProperties"_sd,
+    "maximum"_sd,
+    "minLength"_sd,
+    "minProperties"_sd,
+    "minimum"_sd,
+    "pattern"_sd,
+    "properties"_sd,
+    "required"_sd,
+    "title"_sd,
+    "type"_sd,
+};
+
+const std::set<StringData> kObjectKeywords{
+    "additionalProperties"_sd, "maxProperties"_sd, "minProperties"_sd, "properties"_sd,
+    "required"_sd,
+};
+
+bool hasOnlyCompiledKeywords(const BSONObj& schema) {
+    for (auto&& keyword : schema) {
+        if (kCompiledKeywords.find(keyword.fieldNameStringData()) == kCompiledKeywords.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool hasObjectKeywords(const BSONObj& schema) {
+    for (auto&& keyword : schema) {
+        if (kObjectKeywords.find(keyword.fieldNameStringData()) != kObjectKeywords.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Property names are looked up as paths by the match expressions, so names which are not a single
+ * path component are left to them.
+ */
+bool isSimplePropertyName(StringData name) {
+    return !name.empty() && name.find('.') == std::string::npos;
+}
+
+/**
+ * Parses the 'type' or 'bsonType' keyword of 'schema', if any. Returns false if the type cannot be
+ * parsed.
+ */
+bool parseType(const BSONObj& schema, boost::optional<MatcherTypeSet>* type) {
+    BSONElement typeElem = schema["type"];
+    const StringMap<BSONType>* aliasMap = &MatcherTypeSet::kJsonSchemaTypeAliasMap;
+    if (!typeElem) {
+        typeElem = schema["bsonType"];
+        aliasMap = &kTypeAliasMap;
+    }
+    if (!typeElem) {
+        return true;
+    }
+
+    std::set<StringData> aliases;
+    if (typeElem.type() == BSONType::String) {
+        aliases.insert(typeElem.valueStringData());
+    } else if (typeElem.type() == BSONType::Array) {
+        for (auto&& alias : typeElem.embeddedObject()) {
+            if (alias.type() != BSONType::String) {
+                return false;
+            }
+            aliases.insert(alias.valueStringData());
+        }
+    } else {
+        return false;
+    }
+
+    auto typeSet = MatcherTypeSet::fromStringAliases(std::move(aliases), *aliasMap);
+    if (!typeSet.isOK()) {
+        return false;
+    }
+    *type = std::move(typeSet.getValue());
+    return true;
+}
+
+}  // namespace
+
+/**
+ * The constraints that the keywords of a nested schema place on the value of a property. As in the
+ * match expressions the schema translates to, the restrictions on numbers, strings and objects
+ * only apply to values of that type.
+ */
+class CompiledJSONSchema::ValueSchema {
+public:
+    ValueSchema() = default;
+    ~ValueSchema();
+
+    /**
+     * Compiles the nested schema 'schema'. Returns false if it cannot be compiled.
+     */
+    bool compile(const BSONObj& schema);
+
+    bool matches(const BSONElement& elem) const;
+
+private:
+    boost::optional<MatcherTypeSet> _type;
+    std::vector<std::unique_ptr<MatchExpression>> _numberRestrictions;
+    std::vector<std::unique_ptr<MatchExpression>> _stringRestrictions;
+    std::unique_ptr<ObjectSchema> _objectSchema;
+};
+
+/**
+ * The constraints that the object keywords of a schema place on the fields of an object.
+ */
+class CompiledJSONSchema::ObjectSchema {
+public:
+    /**
+     * Compiles the object keywords of 'schema'. Returns false if they cannot be compiled.
+     */
+    bool compile(const BSONObj& schema);
+
+    bool matches(const BSONObj& obj) const;
+
+private:
+    struct Property {
+        bool required = false;
+
+        // Null if the property is only named by the 'required' keyword, in which case it is still
+        // subject to 'additionalProperties'.
+        std::unique_ptr<ValueSchema> schema;
+    };
+
+    /**
+     * Returns the property named 'name', adding it if needed. Returns null if there are too many
+     * properties to compile.
+     */
+    Property* _getProperty(StringData name);
+
+    std::vector<Property> _properties;
+    StringMap<size_t> _propertyIndexes;
+    size_t _numRequired = 0;
+    bool _additionalPropertiesAllowed = true;
+    boost::optional<long long> _minProperties;
+    boost::optional<long long> _maxProperties;
+};
+
+CompiledJSONSchema::ValueSchema::~ValueSchema() = default;
+
+bool CompiledJSONSchema::ValueSchema::compile(const BSONObj& schema) {
+    if (!hasOnlyCompiledKeywords(schema) || !parseType(schema, &_type)) {
+        return false;
+    }
+
+    if (auto maximum = schema["maximum"]) {
+        if (schema["exclusiveMaximum"].trueValue()) {
+            _numberRestrictions.push_back(
+                stdx::make_unique<LTMatchExpression>(kPlaceholderPath, maximum));
+        } else {
+            _numberRestrictions.push_back(
+                stdx::make_unique<LTEMatchExpression>(kPlaceholderPath, maximum));
+        }
+    }
+    if (auto minimum = schema["minimum"]) {
+        if (schema["exclusiveMinimum"].trueValue()) {
+            _numberRestrictions.push_back(
+                stdx::make_unique<GTMatchExpression>(kPlaceholderPath, minimum));
+        } else {
+            _numberRestrictions.push_back(
+                stdx::make_unique<GTEMatchExpression>(kPlaceholderPath, minimum));
+        }
+    }
+
+    if (auto maxLength = schema["maxLength"]) {
+        auto length = MatchExpressionParser::parseIntegerElementToNonNegativeLong(maxLength);
+        if (!length.isOK()) {
+            return false;
+        }
+        _stringRestrictions.push_back(stdx::make_unique<InternalSchemaMaxLengthMatchExpression>(
+            kPlaceholderPath, length.getValue()));
+    }
+    if (auto minLength = schema["minLength"]) {
+        auto length = MatchExpressionParser::parseIntegerElementToNonNegativeLong(minLength);
+        if (!length.isOK()) {
+            return false;
+        }
+        _stringRestrictions.push_back(stdx::make_unique<InternalSchemaMinLengthMatchExpression>(
+            kPlaceholderPath, length.getValue()));
+    }
+    if (auto pattern = schema["pattern"]) {
+        if (pattern.type() != BSONType::String) {
+            return false;
+        }
+        // JSON Schema does not allow regex flags to be specified.
+        _stringRestrictions.push_back(stdx::make_unique<RegexMatchExpression>(
+            kPlaceholderPath, pattern.valueStringData(), ""));
+    }
+
+    if (hasObjectKeywords(schema)) {
+        _objectSchema = stdx::make_unique<ObjectSchema>();
+        if (!_objectSchema->compile(schema)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CompiledJSONSchema::ValueSchema::matches(const BSONElement& elem) const {
+    if (_type && !_type->hasType(elem.type())) {
+        return false;
+    }
+
+    if (elem.isNumber()) {
+        for (auto&& restriction : _numberRestrictions) {
+            if (!restriction->matchesSingleElement(elem)) {
+                return false;
+            }
+        }
+    } else if (elem.type() == BSONType::String) {
+        for (auto&& restriction : _stringRestrictions) {
+            if (!restriction->matchesSingleElement(elem)) {
+                return false;
+            }
+        }
+    } else if (elem.type() == BSONType::Object && _objectSchema) {
+        return _objectSchema->matches(elem.embeddedObject());
+    }
+    return true;
+}
+
+CompiledJSONSchema::ObjectSchema::Property* CompiledJSONSchema::ObjectSchema::_getProperty(
+    StringData name) {
+    auto it = _propertyIndexes.find(name);
+    if (it != _propertyIndexes.end()) {
+        return &_properties[it->second];
+    }
+
+    if (_properties.size() == kMaxCompiledProperties) {
+        return nullptr;
+    }
+    _propertyIndexes[name] = _properties.size();
+    _properties.emplace_back();
+    return &_properties.back();
+}
+
+bool CompiledJSONSchema::ObjectSchema::compile(const BSONObj& schema) {
+    if (auto properties = schema["properties"]) {
+        if (properties.type() != BSONType::Object) {
+            return false;
+        }
+        for (auto&& property : properties.embeddedObject()) {
+            if (property.type() != BSONType::Object ||
+                !isSimplePropertyName(property.fieldNameStringData())) {
+                return false;
+            }
+            auto compiled = _getProperty(property.fieldNameStringData());
+            if (!compiled) {
+                return false;
+            }
+            compiled->schema = stdx::make_unique<ValueSchema>();
+            if (!compiled->schema->compile(property.embeddedObject())) {
+                return false;
+            }
+        }
+    }
+
+    if (auto required = schema["required"]) {
+        if (required.type() != BSONType::Array) {
+            return false;
+        }
+        for (auto&& name : required.embeddedObject()) {
+            if (name.type() != BSONType::String || !isSimplePropertyName(name.valueStringData())) {
+                return false;
+            }
+            auto compiled = _getProperty(name.valueStringData());
+            if (!compiled || compiled->required) {
+                return false;
+            }
+            compiled->required = true;
+            ++_numRequired;
+        }
+    }
+
+    if (auto additionalProperties = schema["additionalProperties"]) {
+        if (additionalProperties.type() != BSONType::Bool) {
+            return false;
+        }
+        _additionalPropertiesAllowed = additionalProperties.boolean();
+    }
+
+    if (auto minProperties = schema["minProperties"]) {
+        auto parsed = MatchExpressionParser::parseIntegerElementToNonNegativeLong(minProperties);
+        if (!parsed.isOK()) {
+            return false;
+        }
+        _minProperties = parsed.getValue();
+    }
+    if (auto maxProperties = schema["maxProperties"]) {
+        auto parsed = MatchExpressionParser::parseIntegerElementToNonNegativeLong(maxProperties);
+        if (!parsed.isOK()) {
+            return false;
+        }
+        _maxProperties = parsed.getValue();
+    }
+    return true;
+}
+
+bool CompiledJSONSchema::ObjectSchema::matches(const BSONObj& obj) const {
+    // Match expressions look fields up by name, which finds the first of several fields with the
+    // same name, so only that one is checked against the schema of its property. Any field counts
+    // towards minProperties and maxProperties, and is checked against additionalProperties.
+    uint64_t seen = 0;
+    size_t numRequiredSeen = 0;
+    long long numFields = 0;
+    for (auto&& elem : obj) {
+        ++numFields;
+
+        auto it = _propertyIndexes.find(elem.fieldNameStringData());
+        const bool isAdditional = it == _propertyIndexes.end() || !_properties[it->second].schema;
+        if (isAdditional && !_additionalPropertiesAllowed) {
+            return false;
+        }
+        if (it == _propertyIndexes.end()) {
+            continue;
+        }
+
+        const uint64_t bit = uint64_t{1} << it->second;
+        if (seen & bit) {
+            continue;
+        }
+        seen |= bit;
+
+        const Property& property = _properties[it->second];
+        if (property.required) {
+            ++numRequiredSeen;
+        }
+        if (property.schema && !property.schema->matches(elem)) {
+            return false;
+        }
+    }
+
+    if (numRequiredSeen != _numRequired) {
+        return false;
+    }
+    if (_minProperties && numFields < *_minProperties) {
+        return false;
+    }
+    if (_maxProperties && numFields > *_maxProperties) {
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<CompiledJSONSchema> CompiledJSONSchema::compile(const BSONObj& validator) {
+    if (validator.nFields() != 1) {
+        return nullptr;
+    }
+    BSONObj ownedValidator = validator.getOwned();
+    BSONElement schemaElem = ownedValidator.firstElement();
+    if (schemaElem.fieldNameStringData() != "$jsonSchema" ||
+        schemaElem.type() != BSONType::Object) {
+        return nullptr;
+    }
+    BSONObj schema = schemaElem.embeddedObject();
+
+    try {
+        boost::optional<MatcherTypeSet> type;
+        if (!hasOnlyCompiledKeywords(schema) || !parseType(schema, &type)) {
+            return nullptr;
+        }
+
+        // Validated documents are objects, so a top-level schema which does not allow objects
+        // matches nothing, and the number and string restrictions of a top-level schema never
+        // apply.
+        std::unique_ptr<ObjectSchema> root;
+        if (!type || type->hasType(BSONType::Object)) {
+            root = stdx::make_unique<ObjectSchema>();
+            if (!root->compile(schema)) {
+                return nullptr;
+            }
+        }
+
+        return std::unique_ptr<CompiledJSONSchema>(
+            new CompiledJSONSchema(std::move(ownedValidator), std::move(root)));
+    } catch (const DBException&) {
+        return nullptr;
+    }
+}
+
+CompiledJSONSchema::CompiledJSONSchema(BSONObj validator, std::unique_ptr<ObjectSchema> root)
+    : _validator(std::move(validator)), _root(std::move(root)) {}
+
+CompiledJSONSchema::~CompiledJSONSchema() = default;
+
+bool CompiledJSONSchema::matches(const BSONObj& doc) const {
+    return _root && _root->matches(doc);
+}
+
+}  // namespace mongo
@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * A document validator of the form {$jsonSchema: <schema>}, compiled into a walk over the documents
+ * being validated. Each level of a document is checked in a single pass over its elements, instead
+ * of evaluating the match expression tree that the schema translates to one path at a time.
+ *
+ * Only schemas restricted to the following keywords are compiled: bsonType, type, properties,
+ * required, additionalProperties (as a boolean), minimum, maximum, exclusiveMinimum,
+ * exclusiveMaximum, minLength, maxLength, pattern, minProperties, maxProperties, title and
+ * description. Validators using anything else keep being evaluated as match expressions.
+ */
+class CompiledJSONSchema {
+    MONGO_DISALLOW_COPYING(CompiledJSONSchema);
+
+public:
+    /**
+     * Returns the compiled form of 'validator', or nullptr if 'validator' is not a $jsonSchema
+     * validator that can be compiled. 'validator' must already have been parsed successfully as a
+     * match expression.
+     */
+    static std::unique_ptr<CompiledJSONSchema> compile(const BSONObj& validator);
+
+    ~CompiledJSONSchema();
+
+    /**
+     * Returns true if 'doc' satisfies the schema, exactly when the match expression parsed from the
+     * same validator matches it.
+     */
+    bool matches(const BSONObj& doc) const;
+
+private:
+    class ObjectSchema;
+    class ValueSchema;
+
+    CompiledJSONSchema(BSONObj validator, std::unique_ptr<ObjectSchema> root);
+
+    // Owns the elements that the comparisons against the schema's bounds refer to.
+    const BSONObj _validator;
+
+    // Null when the schema matches no document at all.
+    const std::unique_ptr<ObjectSchema> _root;
+};
+
+}  // namespace mongo
@@ -0,0 +1,214 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/schema/compiled_json_schema.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/matcher/schema/json_schema_parser.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<CompiledJSONSchema> compile(const char* schema) {
+    return CompiledJSONSchema::compile(BSON("$jsonSchema" << fromjson(schema)));
+}
+
+/**
+ * Asserts that 'schema' compiles, and that the compiled schema agrees with the match expression
+ * the schema parses to on each of 'docs'.
+ */
+void assertMatchesLikeExpression(const char* schema, const std::vector<const char*>& docs) {
+    auto compiled = compile(schema);
+    ASSERT(compiled) << schema;
+
+    // The match expression refers into the schema, so it must outlive the expression.
+    BSONObj schemaObj = fromjson(schema);
+    auto expr = JSONSchemaParser::parse(schemaObj);
+    ASSERT_OK(expr.getStatus());
+
+    for (auto&& doc : docs) {
+        BSONObj obj = fromjson(doc);
+        ASSERT_EQ(expr.getValue()->matchesBSON(obj), compiled->matches(obj))
+            << "schema: " << schema << " doc: " << doc;
+    }
+}
+
+TEST(CompiledJSONSchemaTest, DoesNotCompileValidatorsWhichAreNotOnlyJSONSchema) {
+    ASSERT_FALSE(CompiledJSONSchema::compile(fromjson("{a: 1}")));
+    ASSERT_FALSE(CompiledJSONSchema::compile(fromjson("{$jsonSchema: {}, a: 1}")));
+    ASSERT_FALSE(CompiledJSONSchema::compile(fromjson("{$jsonSchema: 1}")));
+    ASSERT_FALSE(CompiledJSONSchema::compile(BSONObj()));
+}
+
+TEST(CompiledJSONSchemaTest, DoesNotCompileUnsupportedKeywords) {
+    ASSERT_FALSE(compile("{enum: [1]}"));
+    ASSERT_FALSE(compile("{properties: {a: {items: {type: 'string'}}}}"));
+    ASSERT_FALSE(compile("{patternProperties: {'^a': {type: 'string'}}}"));
+    ASSERT_FALSE(compile("{additionalProperties: {type: 'string'}}"));
+    ASSERT_FALSE(compile("{properties: {a: {dependencies: {b: ['c']}}}}"));
+    ASSERT_FALSE(compile("{properties: {a: {anyOf: [{type: 'string'}]}}}"));
+}
+
+TEST(CompiledJSONSchemaTest, DoesNotCompileDottedPropertyNames) {
+    ASSERT_FALSE(compile("{properties: {'a.b': {type: 'string'}}}"));
+    ASSERT_FALSE(compile("{required: ['a.b']}"));
+}
+
+TEST(CompiledJSONSchemaTest, DoesNotCompileTooManyProperties) {
+    BSONObjBuilder properties;
+    for (int i = 0; i < 65; ++i) {
+        properties.append(std::to_string(i), BSON("type"
+                                                  << "string"));
+    }
+    BSONObj schema = BSON("properties" << properties.obj());
+    ASSERT_FALSE(CompiledJSONSchema::compile(BSON("$jsonSchema" << schema)));
+}
+
+TEST(CompiledJSONSchemaTest, EmptySchemaMatchesEverything) {
+    assertMatchesLikeExpression("{}", {"{}", "{a: 1}", "{a: [1, 2]}"});
+}
+
+TEST(CompiledJSONSchemaTest, TopLevelTypeMatchesLikeExpression) {
+    const std::vector<const char*> docs{"{}", "{a: 1}"};
+    assertMatchesLikeExpression("{type: 'object'}", docs);
+    assertMatchesLikeExpression("{type: 'string'}", docs);
+    assertMatchesLikeExpression("{bsonType: ['int', 'string']}", docs);
+    assertMatchesLikeExpression("{type: 'string', minimum: 1, maxLength: 1}", docs);
+}
+
+TEST(CompiledJSONSchemaTest, TypeMatchesLikeExpression) {
+    const std::vector<const char*> docs{"{}",
+                                        "{a: 1}",
+                                        "{a: 1.5}",
+                                        "{a: 'str'}",
+                                        "{a: null}",
+                                        "{a: {b: 1}}",
+                                        "{a: ['str']}",
+                                        "{a: [1, 'str']}"};
+    assertMatchesLikeExpression("{properties: {a: {type: 'string'}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {type: ['number', 'null']}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {type: 'array'}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {bsonType: 'int'}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {bsonType: ['double', 'object']}}}", docs);
+}
+
+TEST(CompiledJSONSchemaTest, NumberRestrictionsMatchLikeExpression) {
+    const std::vector<const char*> docs{"{}",
+                                        "{a: 0}",
+                                        "{a: 5}",
+                                        "{a: 5.5}",
+                                        "{a: 10}",
+                                        "{a: NumberLong(11)}",
+                                        "{a: NumberDecimal('-1')}",
+                                        "{a: 'str'}",
+                                        "{a: [20]}",
+                                        "{a: NaN}"};
+    assertMatchesLikeExpression("{properties: {a: {minimum: 5}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {minimum: 5, exclusiveMinimum: true}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {maximum: 10}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {maximum: 10, exclusiveMaximum: true}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {type: 'number', minimum: 0, maximum: 10}}}",
+                                docs);
+    assertMatchesLikeExpression("{properties: {a: {bsonType: 'string', minimum: 20}}}", docs);
+}
+
+TEST(CompiledJSONSchemaTest, StringRestrictionsMatchLikeExpression) {
+    const std::vector<const char*> docs{"{}",
+                                        "{a: ''}",
+                                        "{a: 'ab'}",
+                                        "{a: 'abcdef'}",
+                                        "{a: 'xyz'}",
+                                        "{a: 3}",
+                                        "{a: ['a']}",
+                                        "{a: /ab/}"};
+    assertMatchesLikeExpression("{properties: {a: {minLength: 2}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {maxLength: 3}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {pattern: '^ab'}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {type: 'string', minLength: 1, pattern: 'b'}}}",
+                                docs);
+}
+
+TEST(CompiledJSONSchemaTest, RequiredMatchesLikeExpression) {
+    const std::vector<const char*> docs{
+        "{}", "{a: 1}", "{b: 1}", "{a: null, b: 'str'}", "{a: 1, a: 2}", "{a: 'str', b: [1]}"};
+    assertMatchesLikeExpression("{required: ['a']}", docs);
+    assertMatchesLikeExpression("{required: ['a', 'b']}", docs);
+    assertMatchesLikeExpression("{required: ['a'], properties: {a: {type: 'number'}}}", docs);
+    assertMatchesLikeExpression("{required: ['b'], properties: {a: {type: 'number'}}}", docs);
+}
+
+TEST(CompiledJSONSchemaTest, DuplicateFieldsMatchLikeExpression) {
+    const std::vector<const char*> docs{"{a: 1, a: 'str'}", "{a: 'str', a: 1}", "{b: 1, b: 2}"};
+    assertMatchesLikeExpression("{properties: {a: {type: 'number'}}}", docs);
+    assertMatchesLikeExpression("{maxProperties: 1}", docs);
+    assertMatchesLikeExpression("{properties: {a: {}}, additionalProperties: false}", docs);
+}
+
+TEST(CompiledJSONSchemaTest, AdditionalPropertiesMatchesLikeExpression) {
+    const std::vector<const char*> docs{"{}", "{a: 1}", "{a: 1, b: 1}", "{b: 1}", "{a: 'str'}"};
+    assertMatchesLikeExpression("{additionalProperties: false}", docs);
+    assertMatchesLikeExpression("{additionalProperties: true}", docs);
+    assertMatchesLikeExpression(
+        "{properties: {a: {type: 'number'}}, additionalProperties: false}", docs);
+    assertMatchesLikeExpression("{required: ['a'], additionalProperties: false}", docs);
+}
+
+TEST(CompiledJSONSchemaTest, NumPropertiesMatchLikeExpression) {
+    const std::vector<const char*> docs{"{}", "{a: 1}", "{a: 1, b: 1}", "{a: 1, b: 1, c: 1}"};
+    assertMatchesLikeExpression("{minProperties: 2}", docs);
+    assertMatchesLikeExpression("{maxProperties: 2}", docs);
+    assertMatchesLikeExpression("{minProperties: 1, maxProperties: 1}", docs);
+}
+
+TEST(CompiledJSONSchemaTest, NestedObjectSchemasMatchLikeExpression) {
+    const std::vector<const char*> docs{"{}",
+                                        "{a: 1}",
+                                        "{a: {}}",
+                                        "{a: {b: 1}}",
+                                        "{a: {b: 'str'}}",
+                                        "{a: {b: 1, c: 1}}",
+                                        "{a: [{b: 'str'}]}",
+                                        "{a: {b: {c: 1}}}",
+                                        "{a: {b: {c: 'str'}}}"};
+    assertMatchesLikeExpression("{properties: {a: {properties: {b: {type: 'number'}}}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {required: ['b']}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {type: 'object', required: ['b']}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {additionalProperties: false}}}", docs);
+    assertMatchesLikeExpression("{properties: {a: {minProperties: 1, maxProperties: 1}}}", docs);
+    assertMatchesLikeExpression(
+        "{properties: {a: {properties: {b: {properties: {c: {minimum: 0}}}}}}}", docs);
+    assertMatchesLikeExpression(
+        "{properties: {a: {properties: {b: {required: ['c'], additionalProperties: false}}}}}",
+        docs);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/top_level_field_prefetch.h"
+
+#include <algorithm>
+
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_path.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Appends to 'out' the PathMatchExpressions which match against the same document as 'expr'.
+ */
+void collectPathExpressions(const MatchExpression* expr,
+                            std::vector<const PathMatchExpression*>* out) {
+    switch (expr->matchType()) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOR:
+        case MatchExpression::NOT:
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                collectPathExpressions(expr->getChild(i), out);
+            }
+            return;
+        default:
+            break;
+    }
+
+    if (auto pathExpr = dynamic_cast<const PathMatchExpression*>(expr)) {
+        out->push_back(pathExpr);
+    }
+}
+
+}  // namespace
+
+constexpr size_t TopLevelFieldPrefetch::kMaxFields;
+constexpr size_t TopLevelFieldPrefetch::kNotPrefetched;
+
+std::unique_ptr<TopLevelFieldPrefetch> TopLevelFieldPrefetch::compile(const MatchExpression* root) {
+    std::vector<const PathMatchExpression*> pathExprs;
+    collectPathExpressions(root, &pathExprs);
+
+    std::unique_ptr<TopLevelFieldPrefetch> prefetch(new TopLevelFieldPrefetch());
+    auto& fieldNames = prefetch->_fieldNames;
+    for (auto&& pathExpr : pathExprs) {
+        const ElementPath& path = pathExpr->elementPath();
+        if (path.fieldRef().numParts() == 0) {
+            continue;
+        }
+
+        const StringData field = path.fieldRef().getPart(0);
+        auto it = std::find(fieldNames.begin(), fieldNames.end(), field);
+        if (it == fieldNames.end()) {
+            if (fieldNames.size() == kMaxFields) {
+                continue;
+            }
+            it = fieldNames.insert(fieldNames.end(), field.toString());
+        }
+        prefetch->_fieldIndexOfPath[&path] = it - fieldNames.begin();
+    }
+
+    if (fieldNames.size() < 2) {
+        return nullptr;
+    }
+    return prefetch;
+}
+
+bool TopLevelFieldPrefetch::matchesBSON(const MatchExpression* expr,
+                                        const BSONObj& obj,
+                                        const TopLevelFieldPrefetch* prefetch,
+                                        MatchDetails* details) {
+    if (!prefetch) {
+        return expr->matchesBSON(obj, details);
+    }
+    PrefetchedBSONMatchableDocument doc(obj, *prefetch);
+    return expr->matches(&doc, details);
+}
+
+void TopLevelFieldPrefetch::prefetch(const BSONObj& obj, BSONElement* fields) const {
+    const size_t numFields = _fieldNames.size();
+    size_t numFound = 0;
+
+    BSONObjIterator it(obj);
+    while (numFound < numFields && it.more()) {
+        const BSONElement elem = it.next();
+        const StringData name = elem.fieldNameStringData();
+        for (size_t i = 0; i < numFields; ++i) {
+            // Like BSONObj::getField(), keep the first of any duplicate fields.
+            if (name == _fieldNames[i]) {
+                if (fields[i].eoo()) {
+                    fields[i] = elem;
+                    ++numFound;
+                }
+                break;
+            }
+        }
+    }
+}
+
+ElementIterator* PrefetchedBSONMatchableDocument::allocateIterator(const ElementPath* path) const {
+    const size_t fieldIndex = _prefetch.fieldIndexOf(path);
+    if (fieldIndex == TopLevelFieldPrefetch::kNotPrefetched) {
+        if (_iteratorUsed) {
+            return new BSONElementIterator(path, _obj);
+        }
+        _iteratorUsed = true;
+        _iterator.reset(path, _obj);
+        return &_iterator;
+    }
+
+    // Iterating the rest of 'path' from its top-level element is equivalent to iterating all of
+    // 'path' over the object, down to the treatment of a missing or array top-level field.
+    const BSONElement& field = _fields[fieldIndex];
+    if (_iteratorUsed) {
+        return new BSONElementIterator(path, 1, field);
+    }
+    _iteratorUsed = true;
+    _iterator.reset(path, 1, field);
+    return &_iterator;
+}
+
+}  // namespace mongo
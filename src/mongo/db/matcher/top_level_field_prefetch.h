@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/matchable.h"
+#include "mongo/db/matcher/path.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+class MatchDetails;
+class MatchExpression;
+
+/**
+ * The top-level fields of the documents a MatchExpression reads, computed once so that a
+ * PrefetchedBSONMatchableDocument can locate all of them in a single scan of each input object.
+ * Otherwise, each path predicate searches the object from its first field on its own.
+ *
+ * Only the paths of PathMatchExpressions reached from the root through $and, $or, $nor and $not
+ * are considered, since the children of any other node are matched against something other than
+ * the input document.
+ */
+class TopLevelFieldPrefetch {
+public:
+    // The most distinct top-level fields prefetched. Paths through any further fields are searched
+    // for as usual.
+    static constexpr size_t kMaxFields = 16;
+
+    static constexpr size_t kNotPrefetched = kMaxFields;
+
+    /**
+     * Returns the prefetch for the paths of 'root', or nullptr if they read fewer than two distinct
+     * top-level fields, in which case one scan takes no less time than the usual search.
+     */
+    static std::unique_ptr<TopLevelFieldPrefetch> compile(const MatchExpression* root);
+
+    /**
+     * Returns whether 'obj' matches 'expr', locating the fields it reads through 'prefetch' when
+     * that is non-null. A non-null 'prefetch' must have been compiled from 'expr'.
+     */
+    static bool matchesBSON(const MatchExpression* expr,
+                            const BSONObj& obj,
+                            const TopLevelFieldPrefetch* prefetch,
+                            MatchDetails* details = nullptr);
+
+    size_t numFields() const {
+        return _fieldNames.size();
+    }
+
+    /**
+     * Returns the index of the prefetched top-level field of 'path', or kNotPrefetched if 'path'
+     * was not among those compiled.
+     */
+    size_t fieldIndexOf(const ElementPath* path) const {
+        auto it = _fieldIndexOfPath.find(path);
+        return it == _fieldIndexOfPath.end() ? kNotPrefetched : it->second;
+    }
+
+    /**
+     * Sets fields[i] to the first element of 'obj' named as the i-th prefetched field, or leaves it
+     * EOO if there is none. 'fields' must hold numFields() default-constructed elements.
+     */
+    void prefetch(const BSONObj& obj, BSONElement* fields) const;
+
+private:
+    TopLevelFieldPrefetch() = default;
+
+    std::vector<std::string> _fieldNames;
+    stdx::unordered_map<const ElementPath*, size_t> _fieldIndexOfPath;
+};
+
+/**
+ * A MatchableDocument over a BSONObj which starts the iterator for each path compiled into a
+ * TopLevelFieldPrefetch from that path's prefetched top-level element, and behaves like a
+ * BSONMatchableDocument for any other path.
+ */
+class PrefetchedBSONMatchableDocument : public MatchableDocument {
+public:
+    PrefetchedBSONMatchableDocument(const BSONObj& obj, const TopLevelFieldPrefetch& prefetch)
+        : _obj(obj), _prefetch(prefetch) {
+        _prefetch.prefetch(_obj, _fields.data());
+    }
+
+    BSONObj toBSON() const final {
+        return _obj;
+    }
+
+    ElementIterator* allocateIterator(const ElementPath* path) const final;
+
+    void releaseIterator(ElementIterator* iterator) const final {
+        if (iterator == &_iterator) {
+            _iteratorUsed = false;
+        } else {
+            delete iterator;
+        }
+    }
+
+private:
+    BSONObj _obj;
+    const TopLevelFieldPrefetch& _prefetch;
+    std::array<BSONElement, TopLevelFieldPrefetch::kMaxFields> _fields;
+
+    mutable BSONElementIterator _iterator;
+    mutable bool _iteratorUsed = false;
+};
+
+}  // namespace mongo
@@ -0,0 +1,147 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/top_level_field_prefetch.h"
+
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const BSONObj& filter) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto status = MatchExpressionParser::parse(filter, std::move(expCtx));
+    ASSERT_OK(status.getStatus());
+    return std::move(status.getValue());
+}
+
+/**
+ * Asserts that matching 'filter' against each of 'docs' through a prefetch gives the same result
+ * and elemMatchKey as matching it directly.
+ */
+void assertPrefetchMatchesLikeDirectMatch(const BSONObj& filter,
+                                          const std::vector<BSONObj>& docs) {
+    auto expr = parse(filter);
+    auto prefetch = TopLevelFieldPrefetch::compile(expr.get());
+    ASSERT(prefetch) << filter;
+
+    for (auto&& doc : docs) {
+        MatchDetails direct;
+        direct.requestElemMatchKey();
+        MatchDetails prefetched;
+        prefetched.requestElemMatchKey();
+
+        const bool expected = expr->matchesBSON(doc, &direct);
+        ASSERT_EQ(expected,
+                  TopLevelFieldPrefetch::matchesBSON(expr.get(), doc, prefetch.get(), &prefetched))
+            << filter << " against " << doc;
+        if (expected && direct.hasElemMatchKey()) {
+            ASSERT(prefetched.hasElemMatchKey());
+            ASSERT_EQ(direct.elemMatchKey(), prefetched.elemMatchKey());
+        }
+    }
+}
+
+TEST(TopLevelFieldPrefetchTest, ShouldNotCompileForFewerThanTwoTopLevelFields) {
+    ASSERT_FALSE(TopLevelFieldPrefetch::compile(parse(fromjson("{a: 1}")).get()));
+    ASSERT_FALSE(TopLevelFieldPrefetch::compile(parse(fromjson("{'a.b': 1, 'a.c': 2}")).get()));
+    ASSERT_FALSE(
+        TopLevelFieldPrefetch::compile(parse(fromjson("{a: {$elemMatch: {b: 1, c: 2}}}")).get()));
+}
+
+TEST(TopLevelFieldPrefetchTest, ShouldCompileOneFieldPerDistinctTopLevelField) {
+    auto prefetch = TopLevelFieldPrefetch::compile(
+        parse(fromjson("{a: 1, 'b.c': 2, $or: [{'b.d': 3}, {e: {$not: {$gt: 4}}}]}")).get());
+    ASSERT(prefetch);
+    ASSERT_EQ(prefetch->numFields(), 3U);
+}
+
+TEST(TopLevelFieldPrefetchTest, ShouldMatchLikeADirectMatchForScalarsAndMissingFields) {
+    assertPrefetchMatchesLikeDirectMatch(
+        fromjson("{a: 1, b: {$gt: 2}, c: null, d: {$exists: false}}"),
+        {fromjson("{a: 1, b: 3, d: 1}"),
+         fromjson("{a: 1, b: 3}"),
+         fromjson("{b: 3, a: 1, c: null}"),
+         fromjson("{a: 2, b: 3}"),
+         fromjson("{a: 1, b: 3, a: 2}"),
+         fromjson("{a: 2, b: 3, a: 1}"),
+         fromjson("{}")});
+}
+
+TEST(TopLevelFieldPrefetchTest, ShouldMatchLikeADirectMatchThroughArraysAndSubdocuments) {
+    assertPrefetchMatchesLikeDirectMatch(
+        fromjson("{'a.b': 1, 'c.0': 2, d: {$size: 2}, e: {$elemMatch: {$gt: 3}}, 'f.g.h': 5}"),
+        {fromjson("{a: {b: 1}, c: [2], d: [1, 2], e: [1, 4], f: {g: {h: 5}}}"),
+         fromjson("{a: [{b: 2}, {b: 1}], c: {'0': 2}, d: [[1, 2]], e: [4], f: {g: [{h: 5}]}}"),
+         fromjson("{a: [[{b: 1}]], c: [[2]], d: [1, 2], e: [4], f: [{g: {h: 5}}]}"),
+         fromjson("{a: 1, c: 2, d: 2, e: 4, f: 5}"),
+         fromjson("{a: {b: [0, 1]}, c: [1, 2], d: [1, 2], e: [4], f: {g: {h: [5]}}}")});
+}
+
+TEST(TopLevelFieldPrefetchTest, ShouldMatchLikeADirectMatchUnderLogicalOperators) {
+    assertPrefetchMatchesLikeDirectMatch(
+        fromjson("{$or: [{a: 1, b: 2}, {$nor: [{c: 3}, {'d.e': {$ne: 4}}]}], f: {$not: {$lt: 0}}}"),
+        {fromjson("{a: 1, b: 2}"),
+         fromjson("{a: [0, 1], b: [2], f: -1}"),
+         fromjson("{c: 1, d: {e: 4}}"),
+         fromjson("{c: 1, d: [{e: 3}, {e: 4}]}"),
+         fromjson("{c: 3, d: {e: 4}, f: 1}")});
+}
+
+TEST(TopLevelFieldPrefetchTest, ShouldSearchForFieldsBeyondTheMaximumAsUsual) {
+    const size_t numFields = TopLevelFieldPrefetch::kMaxFields + 4;
+    BSONObjBuilder filter;
+    std::vector<BSONObj> docs;
+    for (size_t i = 0; i < numFields; ++i) {
+        filter.append("f" + std::to_string(i), 1);
+    }
+    for (size_t missing = 0; missing <= numFields; ++missing) {
+        BSONObjBuilder doc;
+        for (size_t i = numFields; i-- > 0;) {
+            if (i != missing) {
+                doc.append("f" + std::to_string(i), 1);
+            }
+        }
+        docs.push_back(doc.obj());
+    }
+
+    auto prefetch = TopLevelFieldPrefetch::compile(parse(filter.asTempObj()).get());
+    ASSERT(prefetch);
+    ASSERT_EQ(prefetch->numFields(), TopLevelFieldPrefetch::kMaxFields);
+    assertPrefetchMatchesLikeDirectMatch(filter.obj(), docs);
+}
+
+}  // namespace
+}  // namespace mongo
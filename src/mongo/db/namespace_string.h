@@ -91,6 +91,10 @@ public:
     // Namespace of the the oplog collection.
     static const NamespaceString kRsOplogNamespace;
 
+    // Namespace for storing the pre- and post-images of updates for change streams, for the
+    // collections which record them.
+    static const NamespaceString kChangeStreamImagesNamespace;
+
     /**
      * Constructs an empty NamespaceString.
      */
@@ -57,6 +57,9 @@ struct OplogUpdateEntryArgs {
     NamespaceString nss;
     CollectionUUID uuid;
 
+    // True if the collection records the pre- and post-images of updates for change streams.
+    bool recordChangeStreamImages = false;
+
     OplogUpdateEntryArgs(CollectionUpdateArgs updateArgs, NamespaceString nss, CollectionUUID uuid)
         : updateArgs(std::move(updateArgs)), nss(std::move(nss)), uuid(std::move(uuid)) {}
 };
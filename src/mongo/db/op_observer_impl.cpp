@@ -37,6 +37,7 @@
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/namespace_uuid_cache.h"
+#include "mongo/db/change_stream_images.h"
 #include "mongo/db/commands/feature_compatibility_version.h"
 #include "mongo/db/commands/feature_compatibility_version_parser.h"
 #include "mongo/db/commands/txn_cmds_gen.h"
@@ -51,6 +52,7 @@
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/session_catalog.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/views/durable_view_catalog.h"
@@ -64,6 +66,19 @@ namespace {
 
 MONGO_FAIL_POINT_DEFINE(failCollectionUpdates);
 
+// The largest size, in bytes, of the operations written to a single applyOps oplog entry for an
+// unprepared transaction. Larger transactions are written as a chain of entries.
+MONGO_EXPORT_SERVER_PARAMETER(transactionOplogEntrySizeLimitBytes, int, BSONObjMaxUserSize)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > BSONObjMaxUserSize) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "transactionOplogEntrySizeLimitBytes must be between 1 "
+                                           "and "
+                                        << BSONObjMaxUserSize);
+        }
+        return Status::OK();
+    });
+
 const auto documentKeyDecoration = OperationContext::declareDecoration<BSONObj>();
 
 repl::OpTime logOperation(OperationContext* opCtx,
@@ -476,6 +491,18 @@ void OpObserverImpl::onUpdate(OperationContext* opCtx, const OplogUpdateEntryArg
                            opTime.writeOpTime,
                            opTime.wallClockTime,
                            boost::none);
+
+        // The images are recorded on the primary and replicated, since only the primary knows the
+        // timestamp of the update when it is made.
+        if (args.recordChangeStreamImages && !opTime.writeOpTime.isNull() &&
+            args.updateArgs.preImageDoc) {
+            recordChangeStreamImages(opCtx,
+                                     args.uuid,
+                                     opTime.writeOpTime.getTimestamp(),
+                                     opTime.wallClockTime,
+                                     *args.updateArgs.preImageDoc,
+                                     args.updateArgs.updatedDoc);
+        }
     }
 
     AuthorizationManager::get(opCtx->getServiceContext())
@@ -922,17 +949,34 @@ void OpObserverImpl::onEmptyCapped(OperationContext* opCtx,
 
 namespace {
 
+/**
+ * Splits the statements of an unprepared transaction into groups whose serialized size does not
+ * exceed 'transactionOplogEntrySizeLimitBytes', so that each group fits in one applyOps oplog
+ * entry. A statement larger than the limit is given a group of its own.
+ */
+std::vector<std::vector<BSONObj>> groupTransactionStatements(
+    const std::vector<repl::ReplOperation>& stmts, bool allowMultipleEntries) {
+    const auto sizeLimit = static_cast<size_t>(transactionOplogEntrySizeLimitBytes.load());
+
+    std::vector<std::vector<BSONObj>> groups(1);
+    size_t groupSize = 0;
+    for (auto& stmt : stmts) {
+        auto stmtObj = stmt.toBSON();
+        const size_t stmtSize = stmtObj.objsize();
+        if (allowMultipleEntries && !groups.back().empty() && groupSize + stmtSize > sizeLimit) {
+            groups.emplace_back();
+            groupSize = 0;
+        }
+        groupSize += stmtSize;
+        groups.back().push_back(std::move(stmtObj));
+    }
+    return groups;
+}
+
 OpTimeBundle logApplyOpsForTransaction(OperationContext* opCtx,
                                        Session* const session,
                                        std::vector<repl::ReplOperation> stmts,
                                        const OplogSlot& prepareOplogSlot) {
-    BSONObjBuilder applyOpsBuilder;
-    BSONArrayBuilder opsArray(applyOpsBuilder.subarrayStart("applyOps"_sd));
-    for (auto& stmt : stmts) {
-        opsArray.append(stmt.toBSON());
-    }
-    opsArray.done();
-
     const NamespaceString cmdNss{"admin", "$cmd"};
 
     OperationSessionInfo sessionInfo;
@@ -942,18 +986,50 @@ OpTimeBundle logApplyOpsForTransaction(OperationContext* opCtx,
 
     const auto txnParticipant = TransactionParticipant::get(opCtx);
     oplogLink.prevOpTime = txnParticipant->getLastWriteOpTime(*opCtx->getTxnNumber());
-    // Until we support multiple oplog entries per transaction, prevOpTime should always be null.
+    // All of the oplog entries of a transaction are written here, so the chain always starts out
+    // empty.
     invariant(oplogLink.prevOpTime.isNull());
 
+    // We are only given an oplog slot for prepared transactions.
+    const auto prepare = !prepareOplogSlot.opTime.isNull();
+
+    // Prepared transactions reserve a single oplog slot for their applyOps entry, and secondaries
+    // running an older binary cannot assemble a chain of entries, so only unprepared transactions
+    // in a fully upgraded replica set are split.
+    const auto allowMultipleEntries = !prepare &&
+        serverGlobalParams.featureCompatibility.getVersion() ==
+            ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo42;
+    const auto groups = groupTransactionStatements(stmts, allowMultipleEntries);
+
     try {
-        // We are only given an oplog slot for prepared transactions.
-        auto prepare = !prepareOplogSlot.opTime.isNull();
+        // Every entry but the last is marked as a partial transaction, and each one links to the
+        // entry before it. Secondaries apply nothing until they see the final, unmarked entry.
+        // All of the entries are written in the same WriteUnitOfWork, so they become visible
+        // together. Each entry carries its own statement id, as the transaction history walk
+        // requires the statement ids along a chain to be distinct.
+        for (size_t i = 0; i + 1 < groups.size(); ++i) {
+            BSONObjBuilder applyOpsBuilder;
+            applyOpsBuilder.append("applyOps"_sd, groups[i]);
+            applyOpsBuilder.append(repl::OplogEntry::kPartialTransactionFieldName, true);
+            const auto times = replLogApplyOps(opCtx,
+                                               cmdNss,
+                                               applyOpsBuilder.done(),
+                                               sessionInfo,
+                                               StmtId(i),
+                                               oplogLink,
+                                               false /* prepare */,
+                                               OplogSlot());
+            oplogLink.prevOpTime = times.writeOpTime;
+        }
+
+        BSONObjBuilder applyOpsBuilder;
+        applyOpsBuilder.append("applyOps"_sd, groups.back());
         if (prepare) {
             // TODO: SERVER-36814 Remove "prepare" field on applyOps.
             applyOpsBuilder.append("prepare", true);
         }
         auto applyOpCmd = applyOpsBuilder.done();
-        const StmtId stmtId(0);
+        const StmtId stmtId(groups.size() - 1);
 
         auto times = replLogApplyOps(
             opCtx, cmdNss, applyOpCmd, sessionInfo, stmtId, oplogLink, prepare, prepareOplogSlot);
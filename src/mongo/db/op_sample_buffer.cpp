@@ -0,0 +1,104 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/op_sample_buffer.h"
+
+#include <algorithm>
+
+#include "mongo/db/client.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getOpSampleBuffer = ServiceContext::declareDecoration<OpSampleBuffer>();
+
+// The fraction of operations whose profiler entry is recorded in the OpSampleBuffer. 0 turns
+// sampling off.
+MONGO_EXPORT_SERVER_PARAMETER(opSampleBufferSampleRate, double, 0.0)
+    ->withValidator([](const double& newVal) {
+        if (newVal < 0.0 || newVal > 1.0) {
+            return Status(ErrorCodes::BadValue,
+                          "opSampleBufferSampleRate must be between 0.0 and 1.0 inclusive");
+        }
+        return Status::OK();
+    });
+
+}  // namespace
+
+constexpr size_t OpSampleBuffer::kCapacity;
+
+OpSampleBuffer* OpSampleBuffer::get(ServiceContext* service) {
+    return &getOpSampleBuffer(service);
+}
+
+bool OpSampleBuffer::shouldSample(Client* client) {
+    const auto sampleRate = opSampleBufferSampleRate.load();
+    return sampleRate > 0.0 && client->getPrng().nextCanonicalDouble() < sampleRate;
+}
+
+void OpSampleBuffer::add(BSONObj sample) {
+    const auto sequence = _numAdded.fetchAndAdd(1) + 1;
+    auto& slot = _slots[(sequence - 1) % kCapacity];
+
+    scoped_spinlock lk(slot.mutex);
+    // A later sample may already have wrapped around to this slot; never overwrite it.
+    if (slot.sequence < sequence) {
+        slot.sequence = sequence;
+        slot.sample = std::move(sample);
+    }
+}
+
+std::vector<BSONObj> OpSampleBuffer::getSamples() const {
+    std::vector<std::pair<unsigned long long, BSONObj>> samples;
+    samples.reserve(kCapacity);
+    for (const auto& slot : _slots) {
+        scoped_spinlock lk(slot.mutex);
+        if (slot.sequence > 0) {
+            samples.emplace_back(slot.sequence, slot.sample);
+        }
+    }
+
+    // The buffer wraps around, so put the samples back in the order they were recorded.
+    std::sort(samples.begin(), samples.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    std::vector<BSONObj> result;
+    result.reserve(samples.size());
+    for (auto& sample : samples) {
+        result.push_back(std::move(sample.second));
+    }
+    return result;
+}
+
+}  // namespace mongo
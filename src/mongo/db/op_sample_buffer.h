@@ -0,0 +1,96 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/spin_lock.h"
+
+namespace mongo {
+
+class Client;
+class ServiceContext;
+
+/**
+ * A fixed-size, in-memory ring buffer of profiler entries for a sample of the operations run on
+ * this server. Unlike the profiler, recording a sample does no write to system.profile, so
+ * sampling can be left on in production. Samples are read back with the $opSamples aggregation
+ * stage.
+ *
+ * Each recording operation claims the next slot with a single atomic increment. The slot is then
+ * filled under its own spin lock, which is only contended when a reader copies that slot or the
+ * buffer wraps all the way around while it is being filled.
+ */
+class OpSampleBuffer {
+    OpSampleBuffer(const OpSampleBuffer&) = delete;
+    OpSampleBuffer& operator=(const OpSampleBuffer&) = delete;
+
+public:
+    static constexpr size_t kCapacity = 1024;
+
+    OpSampleBuffer() = default;
+
+    static OpSampleBuffer* get(ServiceContext* service);
+
+    /**
+     * Decides whether the next operation run by 'client' should be sampled, according to
+     * 'opSampleBufferSampleRate'. Must be called by the thread which owns 'client'.
+     */
+    static bool shouldSample(Client* client);
+
+    /**
+     * Records 'sample', replacing the oldest sample once the buffer is full.
+     */
+    void add(BSONObj sample);
+
+    /**
+     * Returns the samples currently held in the buffer, oldest first.
+     */
+    std::vector<BSONObj> getSamples() const;
+
+private:
+    struct Slot {
+        mutable SpinLock mutex;
+
+        // The position in the sequence of all samples that this slot currently holds, or 0 if the
+        // slot has never been written.
+        unsigned long long sequence{0};
+        BSONObj sample;
+    };
+
+    // The number of samples ever recorded. The next sample goes to slot '_numAdded % kCapacity'.
+    AtomicUInt64 _numAdded;
+
+    std::array<Slot, kCapacity> _slots;
+};
+
+}  // namespace mongo
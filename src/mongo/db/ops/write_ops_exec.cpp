@@ -521,8 +521,11 @@ WriteResult performInserts(OperationContext* opCtx,
                 }
             }
 
-            BSONObj toInsert = fixedDoc.getValue().isEmpty() ? doc : std::move(fixedDoc.getValue());
-            batch.emplace_back(stmtId, toInsert);
+            // Unless _id had to be added or moved, insert the document as a view into the request
+            // message rather than a copy of it.
+            batch.emplace_back(stmtId,
+                               fixedDoc.getValue().isEmpty() ? doc
+                                                             : std::move(fixedDoc.getValue()));
             bytesInBatch += batch.back().doc.objsize();
             if (!isLastDoc && batch.size() < maxBatchSize && bytesInBatch < insertVectorMaxBytes)
                 continue;  // Add more to batch before inserting.
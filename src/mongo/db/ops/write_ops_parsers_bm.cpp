@@ -0,0 +1,102 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/rpc/op_msg.h"
+
+namespace mongo {
+namespace {
+
+// Builds an insert of 'numDocuments' small documents with the arguments a driver typically sends
+// along, so that each parse walks both the command's own fields and the generic arguments.
+OpMsgRequest makeInsertRequest(int64_t numDocuments) {
+    BSONArrayBuilder documents;
+    for (int64_t i = 0; i < numDocuments; i++) {
+        documents.append(BSON("_id" << i << "x" << 1));
+    }
+    return OpMsgRequest::fromDBAndBody("test",
+                                       BSON("insert"
+                                            << "coll"
+                                            << "documents"
+                                            << documents.arr()
+                                            << "ordered"
+                                            << false
+                                            << "bypassDocumentValidation"
+                                            << false
+                                            << "writeConcern"
+                                            << BSON("w" << 1)
+                                            << "lsid"
+                                            << BSON("id" << 1)));
+}
+
+// Builds an update of 'numUpdates' single-document upserts, each parsed as an UpdateOpEntry.
+OpMsgRequest makeUpdateRequest(int64_t numUpdates) {
+    BSONArrayBuilder updates;
+    for (int64_t i = 0; i < numUpdates; i++) {
+        updates.append(BSON("q" << BSON("_id" << i) << "u" << BSON("$set" << BSON("x" << 1))
+                                << "upsert"
+                                << true
+                                << "multi"
+                                << false));
+    }
+    return OpMsgRequest::fromDBAndBody("test",
+                                       BSON("update"
+                                            << "coll"
+                                            << "updates"
+                                            << updates.arr()
+                                            << "ordered"
+                                            << true));
+}
+
+}  // namespace
+
+void BM_parseInsert(benchmark::State& state) {
+    const auto request = makeInsertRequest(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(InsertOp::parse(request));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_parseUpdate(benchmark::State& state) {
+    const auto request = makeUpdateRequest(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(UpdateOp::parse(request));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_parseInsert)->Arg(1)->Arg(100);
+BENCHMARK(BM_parseUpdate)->Arg(1)->Arg(100);
+
+}  // namespace mongo
@@ -271,6 +271,25 @@ TEST(CommandWriteOpsParsers, RealMultiInsert) {
     }
 }
 
+TEST(CommandWriteOpsParsers, InsertDocumentsAreViewsIntoTheMessage) {
+    const auto ns = NamespaceString("test", "foo");
+    const BSONObj obj0 = BSON("x" << 0);
+    const BSONObj obj1 = BSON("x" << 1);
+    auto cmd = BSON("insert" << ns.coll() << "documents" << BSON_ARRAY(obj0 << obj1));
+    for (bool seq : {false, true}) {
+        const auto message = toOpMsg(ns.db(), cmd, seq).serialize();
+        const auto op = InsertOp::parse(OpMsgRequest::parse(message));
+        ASSERT_EQ(op.getDocuments().size(), 2u);
+        const char* const begin = message.buf();
+        const char* const end = begin + message.size();
+        for (auto&& doc : op.getDocuments()) {
+            ASSERT(doc.objdata() >= begin && doc.objdata() + doc.objsize() <= end);
+        }
+        ASSERT_BSONOBJ_EQ(op.getDocuments()[0], obj0);
+        ASSERT_BSONOBJ_EQ(op.getDocuments()[1], obj1);
+    }
+}
+
 TEST(CommandWriteOpsParsers, MultiInsertWithStmtId) {
     const auto ns = NamespaceString("test", "foo");
     const BSONObj obj0 = BSON("x" << 0);
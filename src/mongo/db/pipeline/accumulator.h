@@ -76,6 +76,14 @@ public:
         processInternal(input, merging);
     }
 
+    /** Process each of 'inputs' in order, as if by calling process() on each one.
+     *  Accumulators which can add a run of values of one type faster than one at a time override
+     *  processBatchInternal().
+     */
+    void processBatch(const std::vector<Value>& inputs, bool merging) {
+        processBatchInternal(inputs, merging);
+    }
+
     /** Marks the end of the evaluate() phase and return accumulated result.
      *  toBeMerged should be true when the outputs will be merged by process().
      */
@@ -109,6 +117,13 @@ protected:
     /// Update subclass's internal state based on input
     virtual void processInternal(const Value& input, bool merging) = 0;
 
+    /// Update subclass's internal state based on each of 'inputs' in order
+    virtual void processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+        for (auto&& input : inputs) {
+            processInternal(input, merging);
+        }
+    }
+
     const boost::intrusive_ptr<ExpressionContext>& getExpressionContext() const {
         return _expCtx;
     }
@@ -194,6 +209,7 @@ public:
     explicit AccumulatorSum(const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
     void processInternal(const Value& input, bool merging) final;
+    void processBatchInternal(const std::vector<Value>& inputs, bool merging) final;
     Value getValue(bool toBeMerged) final;
     const char* getOpName() const final;
     void reset() final;
@@ -282,6 +298,7 @@ public:
     explicit AccumulatorAvg(const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
     void processInternal(const Value& input, bool merging) final;
+    void processBatchInternal(const std::vector<Value>& inputs, bool merging) final;
     Value getValue(bool toBeMerged) final;
     const char* getOpName() const final;
     void reset() final;
@@ -335,6 +352,112 @@ public:
         const boost::intrusive_ptr<ExpressionContext>& expCtx);
 };
 
+/**
+ * Estimates the number of distinct values with a HyperLogLog sketch. Small numbers of distinct
+ * values are counted exactly by their hashes, until the fixed size array of registers would take
+ * less memory than the hashes do.
+ */
+class AccumulatorApproxCountDistinct final : public Accumulator {
+public:
+    // Each hash updates one of 2^kPrecision registers, for a standard error of about 0.8%.
+    static constexpr int kPrecision = 14;
+    static constexpr size_t kNumRegisters = size_t(1) << kPrecision;
+
+    // The number of distinct hashes past which the registers take less memory.
+    static constexpr size_t kMaxExactHashes = kNumRegisters / 32;
+
+    explicit AccumulatorApproxCountDistinct(const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    static boost::intrusive_ptr<Accumulator> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    bool isAssociative() const final {
+        return true;
+    }
+
+    bool isCommutative() const final {
+        return true;
+    }
+
+private:
+    void addHash(uint64_t hash);
+    void switchToRegisters();
+
+    // The distinct hashes seen so far, until there are more than kMaxExactHashes of them.
+    stdx::unordered_set<uint64_t> _hashes;
+
+    // The HyperLogLog registers, which are empty while counting the hashes exactly.
+    std::vector<uint8_t> _registers;
+};
+
+/**
+ * Estimates percentiles of the numeric values with a t-digest, which summarizes them as a bounded
+ * number of weighted centroids that hold fewer values the closer they are to the extremes. Takes
+ * objects of the form {input: <value>, p: <percentile or array of percentiles>}, where the
+ * percentiles are between 0 and 1 and must be the same for every document of a group.
+ */
+class AccumulatorApproxPercentile final : public Accumulator {
+public:
+    // The digest holds at most about this many centroids. Larger values trade memory for accuracy.
+    static constexpr double kCompression = 100;
+
+    // Values are added to a buffer, which is merged into the centroids once it holds this many.
+    static constexpr size_t kMaxUnmerged = 500;
+
+    explicit AccumulatorApproxPercentile(const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    static boost::intrusive_ptr<Accumulator> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    bool isAssociative() const final {
+        return true;
+    }
+
+    bool isCommutative() const final {
+        return true;
+    }
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    void setPercentiles(const Value& percentiles);
+    void add(double mean, double weight);
+    void updateMemUsage();
+
+    /**
+     * Merges '_unmerged' into '_centroids', combining neighbouring centroids for as long as the
+     * t-digest scale function allows.
+     */
+    void compress();
+
+    /**
+     * Interpolates the value at percentile 'p' between the centroids. Must only be called once
+     * compressed.
+     */
+    double percentile(double p) const;
+
+    // The percentiles to return, which are missing until the first document was processed.
+    Value _percentiles;
+
+    std::vector<Centroid> _centroids;
+    std::vector<Centroid> _unmerged;
+    double _min;
+    double _max;
+};
+
 class AccumulatorMergeObjects : public Accumulator {
 public:
     AccumulatorMergeObjects(const boost::intrusive_ptr<ExpressionContext>& expCtx);
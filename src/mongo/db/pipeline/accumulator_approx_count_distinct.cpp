@@ -0,0 +1,178 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_ACCUMULATOR(approxCountDistinct, AccumulatorApproxCountDistinct::create);
+
+namespace {
+// The approximate memory taken by each hash in an unordered set, including the node and bucket.
+const int kExactHashBytes = 4 * sizeof(uint64_t);
+
+/**
+ * The finalizer of MurmurHash3, which spreads the entropy of a Value's hash over all of its bits,
+ * since the estimate relies on them being uniformly distributed.
+ */
+uint64_t mixHash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+}  // namespace
+
+const char* AccumulatorApproxCountDistinct::getOpName() const {
+    return "$approxCountDistinct";
+}
+
+void AccumulatorApproxCountDistinct::processInternal(const Value& input, bool merging) {
+    if (!merging) {
+        if (!input.missing()) {
+            addHash(mixHash(getExpressionContext()->getValueComparator().hash(input)));
+        }
+        return;
+    }
+
+    // This is what getValue(true) produced below.
+    verify(input.getType() == Object);
+    Value registers = input["registers"];
+    if (registers.missing()) {
+        for (auto&& hash : input["hashes"].getArray()) {
+            addHash(static_cast<uint64_t>(hash.getLong()));
+        }
+        return;
+    }
+
+    if (_registers.empty()) {
+        switchToRegisters();
+    }
+    const BSONBinData binData = registers.getBinData();
+    verify(binData.length == static_cast<int>(kNumRegisters));
+    const uint8_t* otherRegisters = static_cast<const uint8_t*>(binData.data);
+    for (size_t i = 0; i < kNumRegisters; i++) {
+        _registers[i] = std::max(_registers[i], otherRegisters[i]);
+    }
+}
+
+void AccumulatorApproxCountDistinct::addHash(uint64_t hash) {
+    if (_registers.empty()) {
+        if (_hashes.insert(hash).second) {
+            _memUsageBytes += kExactHashBytes;
+            if (_hashes.size() > kMaxExactHashes) {
+                switchToRegisters();
+            }
+        }
+        return;
+    }
+
+    // The leading bits of the hash pick the register, which keeps the highest position of the
+    // first 1-bit among the remaining ones.
+    const size_t index = hash >> (64 - kPrecision);
+    const int leadingZeros = std::min(countLeadingZeros64(hash << kPrecision), 64 - kPrecision);
+    _registers[index] = std::max(_registers[index], static_cast<uint8_t>(leadingZeros + 1));
+}
+
+void AccumulatorApproxCountDistinct::switchToRegisters() {
+    _registers.assign(kNumRegisters, 0);
+    auto hashes = std::move(_hashes);
+    _hashes = stdx::unordered_set<uint64_t>();
+    for (auto&& hash : hashes) {
+        addHash(hash);
+    }
+    _memUsageBytes = sizeof(*this) + kNumRegisters;
+}
+
+Value AccumulatorApproxCountDistinct::getValue(bool toBeMerged) {
+    if (toBeMerged) {
+        if (_registers.empty()) {
+            std::vector<Value> hashes;
+            hashes.reserve(_hashes.size());
+            for (auto&& hash : _hashes) {
+                hashes.push_back(Value(static_cast<long long>(hash)));
+            }
+            return Value(DOC("hashes" << Value(std::move(hashes))));
+        }
+        return Value(
+            DOC("registers" << BSONBinData(_registers.data(), kNumRegisters, BinDataGeneral)));
+    }
+
+    if (_registers.empty()) {
+        return Value(static_cast<long long>(_hashes.size()));
+    }
+
+    // This is the estimate of the original HyperLogLog paper, falling back to linear counting
+    // while some registers are still empty. The 64-bit hashes need no correction for large sets.
+    const double numRegisters = kNumRegisters;
+    double sum = 0;
+    size_t numEmptyRegisters = 0;
+    for (auto&& reg : _registers) {
+        sum += std::ldexp(1.0, -reg);
+        numEmptyRegisters += (reg == 0);
+    }
+    double estimate = (0.7213 / (1 + 1.079 / numRegisters)) * numRegisters * numRegisters / sum;
+    if (estimate <= 2.5 * numRegisters && numEmptyRegisters) {
+        estimate = numRegisters * std::log(numRegisters / numEmptyRegisters);
+    }
+    return Value(static_cast<long long>(std::llround(estimate)));
+}
+
+AccumulatorApproxCountDistinct::AccumulatorApproxCountDistinct(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx)
+    : Accumulator(expCtx) {
+    _memUsageBytes = sizeof(*this);
+}
+
+void AccumulatorApproxCountDistinct::reset() {
+    _hashes = stdx::unordered_set<uint64_t>();
+    _registers = std::vector<uint8_t>();
+    _memUsageBytes = sizeof(*this);
+}
+
+intrusive_ptr<Accumulator> AccumulatorApproxCountDistinct::create(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    return new AccumulatorApproxCountDistinct(expCtx);
+}
+
+}  // namespace mongo
@@ -0,0 +1,278 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_ACCUMULATOR(approxPercentile, AccumulatorApproxPercentile::create);
+
+namespace {
+/**
+ * The k1 scale function of the t-digest paper, which maps a quantile to a scale where each
+ * centroid may span at most 1. Its slope is steepest near the extremes, keeping their centroids
+ * small.
+ */
+double quantileToScale(double q) {
+    return AccumulatorApproxPercentile::kCompression / (2 * M_PI) * std::asin(2 * q - 1);
+}
+
+double scaleToQuantile(double k) {
+    if (k >= AccumulatorApproxPercentile::kCompression / 4) {
+        return 1;
+    }
+    return (std::sin(k * 2 * M_PI / AccumulatorApproxPercentile::kCompression) + 1) / 2;
+}
+
+bool isValidPercentile(const Value& p) {
+    return p.numeric() && p.coerceToDouble() >= 0 && p.coerceToDouble() <= 1;
+}
+}  // namespace
+
+const char* AccumulatorApproxPercentile::getOpName() const {
+    return "$approxPercentile";
+}
+
+void AccumulatorApproxPercentile::processInternal(const Value& input, bool merging) {
+    if (!merging) {
+        uassert(51534,
+                str::stream() << "$approxPercentile requires an object of the form {input: "
+                                 "<expression>, p: <percentile(s)>}, but found "
+                              << input.toString(),
+                input.getType() == Object);
+        setPercentiles(input["p"]);
+
+        // Non-numeric types, and NaN, which cannot be ordered, have no impact on percentiles.
+        Value value = input["input"];
+        if (!value.numeric() || std::isnan(value.coerceToDouble())) {
+            return;
+        }
+
+        const double val = value.coerceToDouble();
+        _min = std::min(_min, val);
+        _max = std::max(_max, val);
+        add(val, 1);
+        return;
+    }
+
+    // This is what getValue(true) produced below.
+    verify(input.getType() == Object);
+    if (!input["p"].missing()) {
+        setPercentiles(input["p"]);
+    }
+
+    const auto& means = input["means"].getArray();
+    const auto& weights = input["weights"].getArray();
+    verify(means.size() == weights.size());
+    if (means.empty()) {
+        return;  // This partition had no data to contribute.
+    }
+
+    _min = std::min(_min, input["min"].getDouble());
+    _max = std::max(_max, input["max"].getDouble());
+    for (size_t i = 0; i < means.size(); i++) {
+        add(means[i].getDouble(), weights[i].getDouble());
+    }
+}
+
+void AccumulatorApproxPercentile::setPercentiles(const Value& percentiles) {
+    if (!_percentiles.missing()) {
+        uassert(51535,
+                str::stream() << "$approxPercentile requires the same percentiles for every "
+                                 "document of a group, but found "
+                              << _percentiles.toString()
+                              << " and "
+                              << percentiles.toString(),
+                ValueComparator::kInstance.evaluate(_percentiles == percentiles));
+        return;
+    }
+
+    bool isValid = isValidPercentile(percentiles);
+    if (percentiles.isArray()) {
+        const auto& array = percentiles.getArray();
+        isValid = !array.empty() && std::all_of(array.begin(), array.end(), isValidPercentile);
+    }
+    uassert(51536,
+            str::stream() << "$approxPercentile requires 'p' to be a number between 0 and 1, or a "
+                             "non-empty array of them, but found "
+                          << percentiles.toString(),
+            isValid);
+    _percentiles = percentiles;
+}
+
+void AccumulatorApproxPercentile::add(double mean, double weight) {
+    _unmerged.push_back({mean, weight});
+    if (_unmerged.size() >= kMaxUnmerged) {
+        compress();
+    }
+    updateMemUsage();
+}
+
+void AccumulatorApproxPercentile::updateMemUsage() {
+    _memUsageBytes = sizeof(*this) + _percentiles.getApproximateSize() +
+        (_centroids.capacity() + _unmerged.capacity()) * sizeof(Centroid);
+}
+
+void AccumulatorApproxPercentile::compress() {
+    if (_unmerged.empty()) {
+        return;
+    }
+
+    _unmerged.insert(_unmerged.end(), _centroids.begin(), _centroids.end());
+    std::sort(_unmerged.begin(), _unmerged.end(), [](const Centroid& lhs, const Centroid& rhs) {
+        return lhs.mean < rhs.mean;
+    });
+
+    double totalWeight = 0;
+    for (auto&& centroid : _unmerged) {
+        totalWeight += centroid.weight;
+    }
+
+    // Add each centroid, in order, to the current one for as long as the weight of all the
+    // centroids up to the current one stays below the quantile at which the scale function has
+    // grown by 1 since the start of the current one.
+    _centroids.clear();
+    Centroid current = _unmerged.front();
+    double weightSoFar = 0;
+    double weightLimit = totalWeight * scaleToQuantile(quantileToScale(0) + 1);
+    for (size_t i = 1; i < _unmerged.size(); i++) {
+        const Centroid& next = _unmerged[i];
+        if (weightSoFar + current.weight + next.weight <= weightLimit) {
+            current.weight += next.weight;
+            current.mean += (next.mean - current.mean) * next.weight / current.weight;
+        } else {
+            weightSoFar += current.weight;
+            _centroids.push_back(current);
+            weightLimit =
+                totalWeight * scaleToQuantile(quantileToScale(weightSoFar / totalWeight) + 1);
+            current = next;
+        }
+    }
+    _centroids.push_back(current);
+    _unmerged.clear();
+}
+
+double AccumulatorApproxPercentile::percentile(double p) const {
+    invariant(!_centroids.empty() && _unmerged.empty());
+
+    double totalWeight = 0;
+    for (auto&& centroid : _centroids) {
+        totalWeight += centroid.weight;
+    }
+
+    // Each centroid is taken to be centered on its mean, with half of its weight on either side.
+    // Values between the centers of two centroids are interpolated linearly, as are those between
+    // the outermost centers and the minimum and maximum.
+    const double index = p * totalWeight;
+    const Centroid& first = _centroids.front();
+    if (index < first.weight / 2) {
+        return _min + (first.mean - _min) * index / (first.weight / 2);
+    }
+
+    double weightSoFar = first.weight / 2;
+    for (size_t i = 0; i + 1 < _centroids.size(); i++) {
+        const double weightBetween = (_centroids[i].weight + _centroids[i + 1].weight) / 2;
+        if (weightSoFar + weightBetween > index) {
+            return _centroids[i].mean + (_centroids[i + 1].mean - _centroids[i].mean) *
+                (index - weightSoFar) / weightBetween;
+        }
+        weightSoFar += weightBetween;
+    }
+
+    const Centroid& last = _centroids.back();
+    const double weightAfterLast = std::min(index - weightSoFar, last.weight / 2);
+    return last.mean + (_max - last.mean) * weightAfterLast / (last.weight / 2);
+}
+
+Value AccumulatorApproxPercentile::getValue(bool toBeMerged) {
+    compress();
+
+    if (toBeMerged) {
+        std::vector<Value> means;
+        std::vector<Value> weights;
+        means.reserve(_centroids.size());
+        weights.reserve(_centroids.size());
+        for (auto&& centroid : _centroids) {
+            means.push_back(Value(centroid.mean));
+            weights.push_back(Value(centroid.weight));
+        }
+        return Value(DOC("p" << _percentiles << "min" << _min << "max" << _max << "means"
+                             << Value(std::move(means))
+                             << "weights"
+                             << Value(std::move(weights))));
+    }
+
+    if (_centroids.empty()) {
+        return Value(BSONNULL);
+    }
+
+    if (_percentiles.isArray()) {
+        std::vector<Value> results;
+        for (auto&& p : _percentiles.getArray()) {
+            results.push_back(Value(percentile(p.coerceToDouble())));
+        }
+        return Value(std::move(results));
+    }
+    return Value(percentile(_percentiles.coerceToDouble()));
+}
+
+AccumulatorApproxPercentile::AccumulatorApproxPercentile(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx)
+    : Accumulator(expCtx) {
+    reset();
+}
+
+void AccumulatorApproxPercentile::reset() {
+    _percentiles = Value();
+    _centroids = std::vector<Centroid>();
+    _unmerged = std::vector<Centroid>();
+    _min = std::numeric_limits<double>::infinity();
+    _max = -std::numeric_limits<double>::infinity();
+    _memUsageBytes = sizeof(*this);
+}
+
+intrusive_ptr<Accumulator> AccumulatorApproxPercentile::create(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    return new AccumulatorApproxPercentile(expCtx);
+}
+
+}  // namespace mongo
@@ -52,6 +52,9 @@ namespace {
 const char subTotalName[] = "subTotal";
 const char subTotalErrorName[] = "subTotalError";  // Used for extra precision
 const char countName[] = "count";
+
+// Number of doubles gathered before they are added to the total in one go.
+const size_t kDoubleRunSize = 128;
 }  // namespace
 
 void AccumulatorAvg::processInternal(const Value& input, bool merging) {
@@ -92,6 +95,40 @@ void AccumulatorAvg::processInternal(const Value& input, bool merging) {
     _count++;
 }
 
+void AccumulatorAvg::processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+    if (merging) {
+        Accumulator::processBatchInternal(inputs, merging);
+        return;
+    }
+
+    // Ints and doubles are both added as doubles, so a run of them is gathered and added without
+    // looking at the type of each value again. The values reach '_nonDecimalTotal' in the same
+    // order as through processInternal(), so the result is the same.
+    double doubleRun[kDoubleRunSize];
+    size_t doubleRunSize = 0;
+
+    auto flushDoubleRun = [&] {
+        _nonDecimalTotal.addDoubles(doubleRun, doubleRunSize);
+        _count += doubleRunSize;
+        doubleRunSize = 0;
+    };
+
+    for (auto&& input : inputs) {
+        switch (input.getType()) {
+            case NumberInt:
+            case NumberDouble:
+                if (doubleRunSize == kDoubleRunSize)
+                    flushDoubleRun();
+                doubleRun[doubleRunSize++] = input.getDouble();
+                break;
+            default:
+                flushDoubleRun();
+                processInternal(input, false);
+        }
+    }
+    flushDoubleRun();
+}
+
 intrusive_ptr<Accumulator> AccumulatorAvg::create(
     const boost::intrusive_ptr<ExpressionContext>& expCtx) {
     return new AccumulatorAvg(expCtx);
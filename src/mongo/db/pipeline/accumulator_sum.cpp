@@ -52,6 +52,9 @@ const char* AccumulatorSum::getOpName() const {
 namespace {
 const char subTotalName[] = "subTotal";
 const char subTotalErrorName[] = "subTotalError";  // Used for extra precision.
+
+// Number of doubles gathered before they are added to the total in one go.
+const size_t kDoubleRunSize = 128;
 }  // namespace
 
 
@@ -84,6 +87,72 @@ void AccumulatorSum::processInternal(const Value& input, bool merging) {
     }
 }
 
+void AccumulatorSum::processBatchInternal(const std::vector<Value>& inputs, bool merging) {
+    if (merging) {
+        Accumulator::processBatchInternal(inputs, merging);
+        return;
+    }
+
+    // Runs of doubles and of ints are added without looking at the type of each value again. The
+    // values reach 'nonDecimalTotal' in the same order as through processInternal(). Ints sum
+    // exactly either way, so a run of them is added as one long with the same precision. Decimals
+    // go to a total of their own, so they are summed in a local copy of it without ending the other
+    // runs and without the conversion through coerceToDecimal().
+    double doubleRun[kDoubleRunSize];
+    size_t doubleRunSize = 0;
+    long long intRun = 0;
+    bool haveIntRun = false;
+    Decimal128 decimalSum = decimalTotal;
+    bool haveDecimals = false;
+
+    auto flushDoubleRun = [&] {
+        if (doubleRunSize) {
+            totalType = Value::getWidestNumeric(totalType, NumberDouble);
+            nonDecimalTotal.addDoubles(doubleRun, doubleRunSize);
+            doubleRunSize = 0;
+        }
+    };
+    auto flushIntRun = [&] {
+        if (haveIntRun) {
+            // A BSON array cannot hold enough ints for 'intRun' to overflow.
+            totalType = Value::getWidestNumeric(totalType, NumberInt);
+            nonDecimalTotal.addLong(intRun);
+            intRun = 0;
+            haveIntRun = false;
+        }
+    };
+
+    for (auto&& input : inputs) {
+        switch (input.getType()) {
+            case NumberDouble:
+                flushIntRun();
+                if (doubleRunSize == kDoubleRunSize)
+                    flushDoubleRun();
+                doubleRun[doubleRunSize++] = input.getDouble();
+                break;
+            case NumberInt:
+                flushDoubleRun();
+                intRun += input.getInt();
+                haveIntRun = true;
+                break;
+            case NumberDecimal:
+                decimalSum = decimalSum.add(input.getDecimal());
+                haveDecimals = true;
+                break;
+            default:
+                flushDoubleRun();
+                flushIntRun();
+                processInternal(input, false);
+        }
+    }
+    flushDoubleRun();
+    flushIntRun();
+    if (haveDecimals) {
+        totalType = NumberDecimal;
+        decimalTotal = decimalSum;
+    }
+}
+
 intrusive_ptr<Accumulator> AccumulatorSum::create(
     const boost::intrusive_ptr<ExpressionContext>& expCtx) {
     return new AccumulatorSum(expCtx);
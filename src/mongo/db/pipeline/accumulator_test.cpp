@@ -91,6 +91,15 @@ static void assertExpectedResults(
                 ASSERT_VALUE_EQ(op.second, result);
                 ASSERT_EQUALS(op.second.getType(), result.getType());
             }
+
+            // Asserts that result equals expected result when the input is processed as a batch.
+            {
+                boost::intrusive_ptr<Accumulator> accum(factory(expCtx));
+                accum->processBatch(op.first, false);
+                Value result = accum->getValue(false);
+                ASSERT_VALUE_EQ(op.second, result);
+                ASSERT_EQUALS(op.second.getType(), result.getType());
+            }
         } catch (...) {
             log() << "failed with arguments: " << Value(op.first);
             throw;
@@ -334,6 +343,61 @@ TEST(Accumulators, Sum) {
          {{Value(9), Value()}, Value(9)}});
 }
 
+/**
+ * Asserts that processing 'inputs' as a batch gives the same partial result as processing them one
+ * at a time.
+ */
+static void assertBatchMatchesScalar(std::string accumulatorName,
+                                     const std::vector<Value>& inputs) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    auto factory = AccumulationStatement::getFactory(accumulatorName);
+    boost::intrusive_ptr<Accumulator> scalar(factory(expCtx));
+    for (auto&& val : inputs) {
+        scalar->process(val, false);
+    }
+    boost::intrusive_ptr<Accumulator> batch(factory(expCtx));
+    batch->processBatch(inputs, false);
+    ASSERT_VALUE_EQ(scalar->getValue(true), batch->getValue(true));
+    ASSERT_VALUE_EQ(scalar->getValue(false), batch->getValue(false));
+}
+
+TEST(Accumulators, SumAndAvgOfBatchMatchScalar) {
+    // Long runs of doubles which lose precision without compensation, broken up by other types.
+    std::vector<Value> inputs;
+    for (int i = 0; i < 1000; ++i) {
+        inputs.push_back(Value(0.1 * i + 1e16));
+        if (i % 300 == 0) {
+            inputs.push_back(Value(-1e16));
+            inputs.push_back(Value(i));
+            inputs.push_back(Value(BSONNULL));
+        }
+    }
+    assertBatchMatchesScalar("$sum", inputs);
+    assertBatchMatchesScalar("$avg", inputs);
+
+    inputs.push_back(Value(3LL));
+    inputs.push_back(Value(Decimal128("0.5")));
+    inputs.push_back(Value(2.5));
+    assertBatchMatchesScalar("$sum", inputs);
+    assertBatchMatchesScalar("$avg", inputs);
+}
+
+TEST(Accumulators, SumOfDecimalBatchMatchesScalar) {
+    // Decimals interleaved with runs of doubles and ints, including sums which must be rounded.
+    std::vector<Value> inputs;
+    for (int i = 0; i < 500; ++i) {
+        inputs.push_back(Value(Decimal128("1.1")));
+        inputs.push_back(Value(Decimal128("-0.01")));
+        if (i % 7 == 0) {
+            inputs.push_back(Value(Decimal128("1234567890123456789012345678901234E-10")));
+            inputs.push_back(Value(0.1));
+            inputs.push_back(Value(i));
+        }
+    }
+    assertBatchMatchesScalar("$sum", inputs);
+    assertBatchMatchesScalar("$avg", inputs);
+}
+
 TEST(Accumulators, AddToSetRespectsCollation) {
     intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
     CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kAlwaysEqual);
@@ -344,6 +408,135 @@ TEST(Accumulators, AddToSetRespectsCollation) {
                             Value(std::vector<Value>{Value("a"_sd)})}});
 }
 
+TEST(Accumulators, ApproxCountDistinct) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    assertExpectedResults(
+        "$approxCountDistinct",
+        expCtx,
+        {// No documents evaluated.
+         {{}, Value(0LL)},
+         // Small numbers of distinct values are counted exactly.
+         {{Value(1), Value(2), Value(1)}, Value(2LL)},
+         // Numbers which compare equal are the same value.
+         {{Value(1), Value(1.0), Value(1LL)}, Value(1LL)},
+         // Null values are counted, but missing values are ignored.
+         {{Value(BSONNULL), Value(), Value("a"_sd)}, Value(2LL)}});
+}
+
+TEST(Accumulators, ApproxCountDistinctRespectsCollation) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kAlwaysEqual);
+    expCtx->setCollator(&collator);
+    assertExpectedResults("$approxCountDistinct",
+                          expCtx,
+                          {{{Value("a"_sd), Value("b"_sd), Value("c"_sd)}, Value(1LL)}});
+}
+
+TEST(Accumulators, ApproxCountDistinctEstimatesLargeCountsWhenMerged) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    auto factory = AccumulationStatement::getFactory("$approxCountDistinct");
+    const int kNumValues = 100000;
+    const int kNumShards = 4;
+
+    // Each shard sees a different half of the values, so that every value is seen twice.
+    boost::intrusive_ptr<Accumulator> merger(factory(expCtx));
+    for (int shard = 0; shard < kNumShards; shard++) {
+        boost::intrusive_ptr<Accumulator> accum(factory(expCtx));
+        for (int i = 0; i < kNumValues; i++) {
+            if (i % kNumShards == shard || (i + 1) % kNumShards == shard) {
+                accum->process(Value(i), false);
+            }
+        }
+        merger->process(accum->getValue(true), true);
+    }
+
+    const long long estimate = merger->getValue(false).getLong();
+    ASSERT_LT(std::abs(estimate - kNumValues), kNumValues * 3 / 100);
+
+    // The registers take a fixed amount of memory, however many values were counted.
+    ASSERT_LT(merger->memUsageForSorter(),
+              2 * static_cast<int>(AccumulatorApproxCountDistinct::kNumRegisters));
+}
+
+TEST(Accumulators, ApproxPercentile) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    auto input = [](Value value, Value p) { return Value(DOC("input" << value << "p" << p)); };
+    const Value median(0.5);
+    const Value percentiles(std::vector<Value>{Value(0), Value(0.5), Value(1)});
+    assertExpectedResults(
+        "$approxPercentile",
+        expCtx,
+        {// No numeric values evaluated.
+         {{input(Value("a"_sd), median), input(Value(), median)}, Value(BSONNULL)},
+         // A single value is every percentile.
+         {{input(Value(3), median)}, Value(3.0)},
+         // Small numbers of values are interpolated exactly.
+         {{input(Value(5), median),
+           input(Value(1), median),
+           input(Value(3LL), median),
+           input(Value(2.0), median),
+           input(Value(4), median)},
+          Value(3.0)},
+         {{input(Value(1), median), input(Value(2), median)}, Value(1.5)},
+         // Several percentiles may be returned at once.
+         {{input(Value(1), percentiles),
+           input(Value(3), percentiles),
+           input(Value(5), percentiles)},
+          Value(std::vector<Value>{Value(1.0), Value(3.0), Value(5.0)})},
+         // Non-numeric values and NaN are ignored.
+         {{input(Value(1), median),
+           input(Value(BSONNULL), median),
+           input(Value(numeric_limits<double>::quiet_NaN()), median),
+           input(Value(3), median)},
+          Value(2.0)}});
+}
+
+TEST(Accumulators, ApproxPercentileRejectsInvalidPercentiles) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    auto factory = AccumulationStatement::getFactory("$approxPercentile");
+
+    ASSERT_THROWS_CODE(factory(expCtx)->process(Value(1), false), AssertionException, 51534);
+    ASSERT_THROWS_CODE(
+        factory(expCtx)->process(Value(DOC("input" << 1 << "p" << 1.5)), false),
+        AssertionException,
+        51536);
+    ASSERT_THROWS_CODE(factory(expCtx)->process(
+                           Value(DOC("input" << 1 << "p" << std::vector<Value>{})), false),
+                       AssertionException,
+                       51536);
+
+    boost::intrusive_ptr<Accumulator> accum(factory(expCtx));
+    accum->process(Value(DOC("input" << 1 << "p" << 0.5)), false);
+    ASSERT_THROWS_CODE(accum->process(Value(DOC("input" << 2 << "p" << 0.9)), false),
+                       AssertionException,
+                       51535);
+}
+
+TEST(Accumulators, ApproxPercentileEstimatesLargeDistributionsWhenMerged) {
+    intrusive_ptr<ExpressionContext> expCtx(new ExpressionContextForTest());
+    auto factory = AccumulationStatement::getFactory("$approxPercentile");
+    const int kNumValues = 100000;
+    const int kNumShards = 10;
+    const Value percentiles(std::vector<Value>{Value(0.01), Value(0.5), Value(0.99)});
+
+    // The values 0 to 99999 are seen in a scrambled order, spread over the shards.
+    boost::intrusive_ptr<Accumulator> merger(factory(expCtx));
+    for (int shard = 0; shard < kNumShards; shard++) {
+        boost::intrusive_ptr<Accumulator> accum(factory(expCtx));
+        for (int i = shard; i < kNumValues; i += kNumShards) {
+            const long long value = (i * 7919LL) % kNumValues;
+            accum->process(Value(DOC("input" << value << "p" << percentiles)), false);
+        }
+        merger->process(accum->getValue(true), true);
+    }
+
+    const auto results = merger->getValue(false).getArray();
+    ASSERT_EQ(3U, results.size());
+    ASSERT_APPROX_EQUAL(1000, results[0].getDouble(), 100);
+    ASSERT_APPROX_EQUAL(50000, results[1].getDouble(), 500);
+    ASSERT_APPROX_EQUAL(99000, results[2].getDouble(), 100);
+}
+
 /* ------------------------- AccumulatorMergeObjects -------------------------- */
 
 namespace AccumulatorMergeObjects {
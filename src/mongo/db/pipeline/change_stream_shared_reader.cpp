@@ -0,0 +1,295 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/change_stream_shared_reader.h"
+
+#include <map>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/document_source_change_stream.h"
+#include "mongo/db/pipeline/document_source_change_stream_transform.h"
+#include "mongo/db/pipeline/mongo_process_interface.h"
+#include "mongo/db/query/collation/collation_spec.h"
+#include "mongo/db/query/find_common.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_options.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+
+class ChangeStreamSharedReader::Subscriber {
+public:
+    // Events with a cluster time at or before this one happened before the subscription.
+    Timestamp startAfter;
+
+    std::deque<Document> queue;
+
+    // Set once the queue has overflowed; the subscriber receives no further events.
+    bool lagged = false;
+};
+
+namespace {
+
+struct Registry {
+    stdx::mutex mutex;
+
+    // Must be acquired before the mutex of any reader.
+    std::map<std::string, std::weak_ptr<ChangeStreamSharedReader>> readers;
+};
+
+const auto getRegistry = ServiceContext::declareDecoration<Registry>();
+
+/**
+ * Change streams may share a reader only if they see the same events, which depends on the
+ * namespace they were opened on, the collation they compare with, and the feature compatibility
+ * version which determines the format of the events.
+ */
+std::string makeKey(const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    StringBuilder sb;
+    sb << expCtx->ns.ns() << '|';
+    if (expCtx->uuid) {
+        sb << expCtx->uuid->toString();
+    }
+    sb << '|'
+       << (expCtx->getCollator() ? expCtx->getCollator()->getSpec().toBSON()
+                                 : CollationSpec::kSimpleSpec)
+              .toString();
+    sb << '|' << static_cast<int>(serverGlobalParams.featureCompatibility.getVersion());
+    return sb.str();
+}
+
+}  // namespace
+
+std::shared_ptr<ChangeStreamSharedReader> ChangeStreamSharedReader::get(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, Timestamp startFrom) {
+    auto key = makeKey(expCtx);
+    auto& registry = getRegistry(expCtx->opCtx->getServiceContext());
+
+    // Declared before the lock is taken, so that a reader which is replaced here is destroyed
+    // after the lock is released.
+    std::shared_ptr<ChangeStreamSharedReader> existing;
+
+    stdx::lock_guard<stdx::mutex> lk(registry.mutex);
+    auto& entry = registry.readers[key];
+    existing = entry.lock();
+    if (existing && existing->_isUsable()) {
+        return existing;
+    }
+    auto reader = std::make_shared<ChangeStreamSharedReader>(expCtx, key, startFrom);
+    entry = reader;
+    return reader;
+}
+
+ChangeStreamSharedReader::ChangeStreamSharedReader(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, std::string key, Timestamp startFrom)
+    : _serviceContext(expCtx->opCtx->getServiceContext()),
+      _expCtx(expCtx->copyWith(expCtx->ns, expCtx->uuid)),
+      _key(std::move(key)) {
+    // The reader outlives the change stream which created it, so it may not share the process
+    // interface of that stream, which is bound to its OperationContext.
+    _expCtx->tailableMode = TailableModeEnum::kTailableAndAwaitData;
+    _expCtx->mongoProcessInterface = MongoProcessInterface::create(expCtx->opCtx);
+
+    const auto fcv = serverGlobalParams.featureCompatibility.getVersion();
+    Pipeline::SourceContainer stages;
+    stages.push_back(DocumentSourceOplogMatch::create(
+        DocumentSourceChangeStream::buildMatchFilter(_expCtx, startFrom, false), _expCtx));
+    stages.push_back(DocumentSourceChangeStreamTransform::create(_expCtx, fcv, BSONObj()));
+
+    _pipeline = uassertStatusOK(Pipeline::create(std::move(stages), _expCtx));
+    _pipeline->detachFromOperationContext();
+}
+
+ChangeStreamSharedReader::~ChangeStreamSharedReader() {
+    if (_pipeline) {
+        // Without a cursor there is nothing to dispose of, and no OperationContext to do it with.
+        invariant(!_cursorAttached);
+        _pipeline.get_deleter().dismissDisposal();
+    }
+
+    auto& registry = getRegistry(_serviceContext);
+    stdx::lock_guard<stdx::mutex> lk(registry.mutex);
+    auto it = registry.readers.find(_key);
+    if (it != registry.readers.end() && it->second.expired()) {
+        registry.readers.erase(it);
+    }
+}
+
+std::shared_ptr<ChangeStreamSharedReader::Subscriber> ChangeStreamSharedReader::subscribe(
+    OperationContext* opCtx) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_disposed || !_status.isOK()) {
+        return nullptr;
+    }
+
+    // Every event read from the oplog before this point was applied before this point, so
+    // capturing the last applied optime under the mutex ensures that the subscriber receives each
+    // event which happens after it subscribes exactly once.
+    auto subscriber = std::make_shared<Subscriber>();
+    subscriber->startAfter =
+        repl::ReplicationCoordinator::get(opCtx)->getMyLastAppliedOpTime().getTimestamp();
+    _subscribers.push_back(subscriber);
+    return subscriber;
+}
+
+void ChangeStreamSharedReader::unsubscribe(OperationContext* opCtx,
+                                           const std::shared_ptr<Subscriber>& subscriber) {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _subscribers.remove(subscriber);
+        if (!_subscribers.empty() || _disposed) {
+            return;
+        }
+        invariant(!_reading);
+        _disposed = true;
+    }
+    _deregister();
+
+    // No other subscriber can reach the pipeline once the reader has been disposed of.
+    if (_cursorAttached) {
+        _pipeline->reattachToOperationContext(opCtx);
+        _pipeline->dispose(opCtx);
+    }
+    _pipeline.get_deleter().dismissDisposal();
+    _pipeline.reset();
+}
+
+boost::optional<Document> ChangeStreamSharedReader::getNext(OperationContext* opCtx,
+                                                            Subscriber* subscriber) {
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    bool timedOut = false;
+    while (true) {
+        uassertStatusOK(_status);
+        uassert(ErrorCodes::ChangeStreamSubscriptionLost,
+                "change stream fell too far behind the other change streams sharing its oplog "
+                "reader and must be resumed",
+                !subscriber->lagged);
+
+        if (!subscriber->queue.empty()) {
+            auto event = std::move(subscriber->queue.front());
+            subscriber->queue.pop_front();
+            return event;
+        }
+
+        if (!_reading) {
+            _reading = true;
+            lk.unlock();
+
+            boost::optional<Document> event;
+            Status status = Status::OK();
+            try {
+                event = _readNext(opCtx);
+            } catch (const DBException& ex) {
+                status = ex.toStatus();
+            }
+
+            lk.lock();
+            _reading = false;
+            _readerDone.notify_all();
+
+            if (!status.isOK()) {
+                // If this operation was interrupted, the state of the shared cursor is unknown but
+                // the other subscribers did nothing wrong, so they are told to resume instead.
+                _status = opCtx->checkForInterruptNoAssert().isOK()
+                    ? status
+                    : Status(ErrorCodes::ChangeStreamSubscriptionLost,
+                             str::stream() << "the change stream reading the oplog on behalf of "
+                                              "this change stream failed: "
+                                           << status.reason());
+                lk.unlock();
+                _deregister();
+                uassertStatusOK(status);
+            }
+
+            if (!event) {
+                return boost::none;
+            }
+            _dispatch_inlock(*event);
+            continue;
+        }
+
+        // Another subscriber is reading the oplog. Wait for it to dispatch an event, for as long
+        // as this subscriber would have waited for inserts into the oplog itself.
+        auto& waitState = awaitDataState(opCtx);
+        if (timedOut || !waitState.shouldWaitForInserts) {
+            return boost::none;
+        }
+        timedOut = opCtx->waitForConditionOrInterruptUntil(
+                       _readerDone, lk, waitState.waitForInsertsDeadline) ==
+            stdx::cv_status::timeout;
+    }
+}
+
+boost::optional<Document> ChangeStreamSharedReader::_readNext(OperationContext* opCtx) {
+    _pipeline->reattachToOperationContext(opCtx);
+    ON_BLOCK_EXIT([this] { _pipeline->detachFromOperationContext(); });
+
+    if (!_cursorAttached) {
+        _expCtx->mongoProcessInterface->attachOplogCursorSourceToPipeline(_expCtx,
+                                                                          _pipeline.get());
+        _cursorAttached = true;
+    }
+    return _pipeline->getNext();
+}
+
+void ChangeStreamSharedReader::_dispatch_inlock(const Document& event) {
+    const auto clusterTime = event[DocumentSourceChangeStream::kClusterTimeField].getTimestamp();
+    const size_t maxQueuedEvents = internalChangeStreamSharedReaderMaxQueuedEvents.load();
+    for (auto&& subscriber : _subscribers) {
+        if (subscriber->lagged || clusterTime <= subscriber->startAfter) {
+            continue;
+        }
+        if (subscriber->queue.size() >= maxQueuedEvents) {
+            subscriber->lagged = true;
+            subscriber->queue.clear();
+            continue;
+        }
+        subscriber->queue.push_back(event);
+    }
+}
+
+bool ChangeStreamSharedReader::_isUsable() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return !_disposed && _status.isOK();
+}
+
+void ChangeStreamSharedReader::_deregister() {
+    auto& registry = getRegistry(_serviceContext);
+    stdx::lock_guard<stdx::mutex> lk(registry.mutex);
+    auto it = registry.readers.find(_key);
+    if (it != registry.readers.end() && it->second.lock().get() == this) {
+        registry.readers.erase(it);
+    }
+}
+
+}  // namespace mongo
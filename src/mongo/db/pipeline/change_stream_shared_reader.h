@@ -0,0 +1,145 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <list>
+#include <memory>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
+#include "mongo/bson/timestamp.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+/**
+ * Reads the oplog on behalf of all the change streams opened on the same namespace with the same
+ * collation and no resume point, applying the oplog filter and the change stream transformation
+ * to each entry once and dispatching the resulting events to a bounded queue for each
+ * subscribing stream.
+ *
+ * There is no dedicated thread: whichever subscriber finds its queue empty reads the next event
+ * from the oplog using its own OperationContext while the others wait for it to dispatch, so the
+ * oplog is only read as fast as the fastest subscriber consumes it. A subscriber whose queue fills
+ * up is dropped, and the next call to getNext() on its behalf fails with
+ * ChangeStreamSubscriptionLost; the client then resumes the stream, which reads the oplog on its
+ * own.
+ */
+class ChangeStreamSharedReader {
+    MONGO_DISALLOW_COPYING(ChangeStreamSharedReader);
+
+public:
+    class Subscriber;
+
+    /**
+     * Returns the reader shared by the change streams opened with 'expCtx', creating one which
+     * starts reading the oplog after 'startFrom' if there is none.
+     */
+    static std::shared_ptr<ChangeStreamSharedReader> get(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx, Timestamp startFrom);
+
+    ChangeStreamSharedReader(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                             std::string key,
+                             Timestamp startFrom);
+
+    ~ChangeStreamSharedReader();
+
+    /**
+     * Subscribes to the events which happen after the last applied optime. Returns nullptr if
+     * this reader has been disposed of since it was obtained from get(), in which case the caller
+     * should obtain a new one.
+     */
+    std::shared_ptr<Subscriber> subscribe(OperationContext* opCtx);
+
+    /**
+     * Unsubscribes 'subscriber', disposing of the reader if it was the last subscriber.
+     */
+    void unsubscribe(OperationContext* opCtx, const std::shared_ptr<Subscriber>& subscriber);
+
+    /**
+     * Returns the next event for 'subscriber', reading it from the oplog if no other subscriber
+     * is doing so, or boost::none if there is none yet. Waits for other subscribers to dispatch
+     * events until the await data deadline of 'opCtx'.
+     */
+    boost::optional<Document> getNext(OperationContext* opCtx, Subscriber* subscriber);
+
+private:
+    /**
+     * Reads the next event from the oplog using 'opCtx'. Must be called by the subscriber which
+     * set '_reading'.
+     */
+    boost::optional<Document> _readNext(OperationContext* opCtx);
+
+    /**
+     * Appends 'event' to the queue of each subscriber which is interested in it, dropping the
+     * subscribers whose queue is full.
+     */
+    void _dispatch_inlock(const Document& event);
+
+    /**
+     * Returns whether new change streams may still subscribe to this reader.
+     */
+    bool _isUsable();
+
+    /**
+     * Stops handing out this reader to new change streams.
+     */
+    void _deregister();
+
+    ServiceContext* const _serviceContext;
+    const boost::intrusive_ptr<ExpressionContext> _expCtx;
+    const std::string _key;
+
+    // Only accessed by the subscriber which set '_reading', or once there are no subscribers.
+    std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
+    bool _cursorAttached = false;
+
+    stdx::mutex _mutex;
+
+    // Signalled whenever the subscriber reading the oplog has dispatched an event or stopped.
+    stdx::condition_variable _readerDone;
+
+    std::list<std::shared_ptr<Subscriber>> _subscribers;
+
+    // Set while a subscriber is reading from '_pipeline'.
+    bool _reading = false;
+
+    // Set once the last subscriber has left and '_pipeline' has been disposed of.
+    bool _disposed = false;
+
+    // The error, if any, which made reading the oplog fail for all subscribers.
+    Status _status = Status::OK();
+};
+
+}  // namespace mongo
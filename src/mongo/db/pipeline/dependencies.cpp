@@ -28,6 +28,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/field_path.h"
@@ -222,6 +224,10 @@ std::vector<DepsTracker::MetadataType> DepsTracker::getAllRequiredMetadataTypes(
 }
 
 namespace {
+// The largest number of needed top-level fields for which ParsedDeps matches input field names by
+// scanning a list rather than by looking them up in a Document.
+const int kMaxLinearLookupFields = 8;
+
 // Mutually recursive with arrayHelper
 Document documentHelper(const BSONObj& bson, const Document& neededFields, int nFieldsNeeded = -1);
 
@@ -245,6 +251,28 @@ Value arrayHelper(const BSONObj& bson, const Document& neededFields) {
     return Value(std::move(values));
 }
 
+// Adds the needed parts of 'bsonElement' to 'md', given the entry for its field in a ParsedDeps
+// look-up table.
+void addNeededField(MutableDocument* md,
+                    StringData fieldName,
+                    const BSONElement& bsonElement,
+                    const Value& isNeeded) {
+    if (isNeeded.getType() == Bool) {
+        md->addField(fieldName, Value(bsonElement));
+    } else {
+        dassert(isNeeded.getType() == Object);
+
+        if (bsonElement.type() == BSONType::Object) {
+            md->addField(
+                fieldName,
+                Value(documentHelper(bsonElement.embeddedObject(), isNeeded.getDocument())));
+        } else if (bsonElement.type() == BSONType::Array) {
+            md->addField(fieldName,
+                         arrayHelper(bsonElement.embeddedObject(), isNeeded.getDocument()));
+        }
+    }
+}
+
 // Handles object-typed values including the top-level for ParsedDeps::extractFields
 Document documentHelper(const BSONObj& bson, const Document& neededFields, int nFieldsNeeded) {
     // We cache the number of top level fields, so don't need to re-compute it every time. For
@@ -264,27 +292,47 @@ Document documentHelper(const BSONObj& bson, const Document& neededFields, int n
             continue;
 
         --nFieldsNeeded;  // Found a needed field.
-        if (isNeeded.getType() == Bool) {
-            md.addField(fieldName, Value(bsonElement));
-        } else {
-            dassert(isNeeded.getType() == Object);
-
-            if (bsonElement.type() == BSONType::Object) {
-                md.addField(
-                    fieldName,
-                    Value(documentHelper(bsonElement.embeddedObject(), isNeeded.getDocument())));
-            } else if (bsonElement.type() == BSONType::Array) {
-                md.addField(fieldName,
-                            arrayHelper(bsonElement.embeddedObject(), isNeeded.getDocument()));
-            }
-        }
+        addNeededField(&md, fieldName, bsonElement, isNeeded);
     }
 
     return md.freeze();
 }
 }  // namespace
 
+ParsedDeps::ParsedDeps(Document&& fields) : _fields(std::move(fields)), _nFields(_fields.size()) {
+    if (_nFields <= kMaxLinearLookupFields) {
+        _topLevelFields.reserve(_nFields);
+        for (auto it = _fields.fieldIterator(); it.more();) {
+            auto field = it.next();
+            _topLevelFields.emplace_back(field.first.toString(), field.second);
+        }
+    }
+}
+
 Document ParsedDeps::extractFields(const BSONObj& input) const {
-    return documentHelper(input, _fields, _nFields);
+    if (_topLevelFields.empty()) {
+        return documentHelper(input, _fields, _nFields);
+    }
+
+    int nFieldsNeeded = _nFields;
+    MutableDocument md(nFieldsNeeded);
+
+    BSONObjIterator it(input);
+    while (it.more() && nFieldsNeeded > 0) {
+        auto bsonElement = it.next();
+        StringData fieldName = bsonElement.fieldNameStringData();
+        auto neededField = std::find_if(
+            _topLevelFields.begin(), _topLevelFields.end(), [&](const auto& topLevelField) {
+                return fieldName == topLevelField.first;
+            });
+
+        if (neededField == _topLevelFields.end())
+            continue;
+
+        --nFieldsNeeded;  // Found a needed field.
+        addNeededField(&md, fieldName, bsonElement, neededField->second);
+    }
+
+    return md.freeze();
 }
 }
@@ -31,6 +31,8 @@
 #include <boost/optional.hpp>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/variables.h"
@@ -199,9 +201,14 @@ public:
 
 private:
     friend struct DepsTracker;  // so it can call constructor
-    explicit ParsedDeps(Document&& fields) : _fields(std::move(fields)), _nFields(_fields.size()) {}
+    explicit ParsedDeps(Document&& fields);
 
     Document _fields;
     int _nFields;  // Cache the number of top-level fields needed.
+
+    // When only a few top-level fields are needed, which is typical for pipelines that $group on a
+    // handful of fields of wide documents, they are also kept in this list. Comparing each input
+    // field name against it is cheaper than a hashed lookup into '_fields'. Empty otherwise.
+    std::vector<std::pair<std::string, Value>> _topLevelFields;
 };
 }
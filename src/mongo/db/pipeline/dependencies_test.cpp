@@ -36,7 +36,9 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
 namespace {
@@ -159,5 +161,39 @@ TEST(DependenciesToProjectionTest,
     ASSERT_BSONOBJ_EQ(deps.toProjection(), BSON(Document::metaFieldTextScore << metaTextScore));
 }
 
+TEST(DependenciesExtractFieldsTest, ShouldExtractFewTopLevelFieldsFromWideDocument) {
+    DepsTracker deps;
+    deps.fields = {"a", "c.d", "z"};
+    auto parsedDeps = deps.toParsedDeps();
+    ASSERT(parsedDeps);
+
+    BSONObjBuilder bob;
+    for (int i = 0; i < 100; ++i) {
+        bob.append(str::stream() << "unneeded" << i, i);
+    }
+    bob.append("z", 3);
+    bob.append("c", BSON("d" << 2 << "e" << 4));
+    bob.append("a", 1);
+
+    ASSERT_DOCUMENT_EQ(parsedDeps->extractFields(bob.obj()),
+                       Document(BSON("z" << 3 << "c" << BSON("d" << 2) << "a" << 1)));
+}
+
+TEST(DependenciesExtractFieldsTest, ShouldExtractManyTopLevelFields) {
+    DepsTracker deps;
+    BSONObjBuilder input;
+    BSONObjBuilder expected;
+    for (int i = 0; i < 20; ++i) {
+        deps.fields.insert(str::stream() << "f" << i);
+        input.append(str::stream() << "f" << i, i);
+        input.append(str::stream() << "unneeded" << i, i);
+        expected.append(str::stream() << "f" << i, i);
+    }
+    auto parsedDeps = deps.toParsedDeps();
+    ASSERT(parsedDeps);
+
+    ASSERT_DOCUMENT_EQ(parsedDeps->extractFields(input.obj()), Document(expected.obj()));
+}
+
 }  // namespace
 }  // namespace mongo
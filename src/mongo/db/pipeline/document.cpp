@@ -30,6 +30,7 @@
 
 #include "mongo/db/pipeline/document.h"
 
+#include <array>
 #include <boost/functional/hash.hpp>
 
 #include "mongo/bson/bson_depth.h"
@@ -43,8 +44,96 @@ using boost::intrusive_ptr;
 using std::string;
 using std::vector;
 
+namespace {
+
+/**
+ * A per-thread cache of freed DocumentStorage objects and of freed buffers of the power-of-two
+ * sizes which DocumentStorage::alloc() uses for small documents. Pipelines which create and discard
+ * a document per input, like $unwind and $project, keep reusing the same few blocks instead of
+ * going to the allocator twice or more for every document.
+ */
+class DocumentStorageCache {
+public:
+    ~DocumentStorageCache() {
+        for (size_t sizeClass = 0; sizeClass < kSizes.size(); ++sizeClass) {
+            for (size_t i = 0; i < _numFree[sizeClass]; ++i) {
+                ::operator delete(_free[sizeClass][i]);
+            }
+            _numFree[sizeClass] = 0;
+        }
+        _destroyed = true;
+    }
+
+    static void* allocate(size_t size) {
+        const int sizeClass = sizeClassOf(size);
+        if (sizeClass >= 0 && !_destroyed) {
+            auto& cache = get();
+            if (cache._numFree[sizeClass] > 0) {
+                return cache._free[sizeClass][--cache._numFree[sizeClass]];
+            }
+        }
+        return ::operator new(size);
+    }
+
+    static void release(void* block, size_t size) {
+        if (!block) {
+            return;
+        }
+        const int sizeClass = sizeClassOf(size);
+        if (sizeClass >= 0 && !_destroyed) {
+            auto& cache = get();
+            if (cache._numFree[sizeClass] < kMaxFreePerSize) {
+                cache._free[sizeClass][cache._numFree[sizeClass]++] = block;
+                return;
+            }
+        }
+        ::operator delete(block);
+    }
+
+private:
+    // At most this many blocks of each size are kept, which bounds the cache at about 16KB per
+    // thread.
+    static constexpr size_t kMaxFreePerSize = 8;
+    static constexpr std::array<size_t, 5> kSizes{{sizeof(DocumentStorage), 128, 256, 512, 1024}};
+
+    static int sizeClassOf(size_t size) {
+        for (size_t sizeClass = 0; sizeClass < kSizes.size(); ++sizeClass) {
+            if (kSizes[sizeClass] == size) {
+                return sizeClass;
+            }
+        }
+        return -1;
+    }
+
+    static DocumentStorageCache& get() {
+        thread_local DocumentStorageCache cache;
+        return cache;
+    }
+
+    // Set once this thread's cache is destroyed at thread exit, after which documents which are
+    // still freed, such as those held by other thread-local objects, bypass the cache.
+    static thread_local bool _destroyed;
+
+    std::array<std::array<void*, kMaxFreePerSize>, kSizes.size()> _free;
+    std::array<size_t, kSizes.size()> _numFree{};
+};
+
+constexpr size_t DocumentStorageCache::kMaxFreePerSize;
+constexpr std::array<size_t, 5> DocumentStorageCache::kSizes;
+thread_local bool DocumentStorageCache::_destroyed = false;
+
+}  // namespace
+
 const DocumentStorage DocumentStorage::kEmptyDoc;
 
+void* DocumentStorage::operator new(size_t size) {
+    return DocumentStorageCache::allocate(size);
+}
+
+void DocumentStorage::operator delete(void* ptr, size_t size) {
+    DocumentStorageCache::release(ptr, size);
+}
+
 const std::vector<StringData> Document::allMetadataFieldNames = {Document::metaFieldTextScore,
                                                                  Document::metaFieldRandVal,
                                                                  Document::metaFieldSortKey,
@@ -75,12 +164,69 @@ Position DocumentStorage::findField(StringData requested) const {
         }
     }
 
+    // The field may be among those which have yet to be loaded
+    if (!isFullyLoaded()) {
+        return loadFields(&requested);
+    }
+
     // if we got here, there's no such field
     return Position();
 }
 
+Value DocumentStorage::lazyValueFromBson(const BSONElement& elem, const BSONObj& owner) {
+    switch (elem.type()) {
+        case Object: {
+            BSONObj obj = elem.embeddedObject();
+            if (obj.isEmpty()) {
+                return Value(elem);
+            }
+            return Value(Document::fromOwnedBsonLazily(std::move(obj).shareOwnershipWith(owner)));
+        }
+        case Array: {
+            std::vector<Value> values;
+            for (auto&& sub : elem.embeddedObject()) {
+                values.push_back(lazyValueFromBson(sub, owner));
+            }
+            return Value(std::move(values));
+        }
+        default:
+            return Value(elem);
+    }
+}
+
+void DocumentStorage::initFromBsonLazily(BSONObj bson) {
+    invariant(!_buffer && !_bsonIt);
+    invariant(bson.isOwned());
+    _bson = std::move(bson);
+    _bsonIt = _bson.firstElement().rawdata();
+}
+
+Position DocumentStorage::loadFields(const StringData* stopAt) const {
+    auto self = const_cast<DocumentStorage*>(this);
+    while (!isFullyLoaded()) {
+        const BSONElement elem(_bsonIt);
+        self->_bsonIt += elem.size();
+
+        const StringData fieldName = elem.fieldNameStringData();
+        const Position pos(_usedBytes);
+        Value value = lazyValueFromBson(elem, _bson);
+        self->appendFieldToBuffer(fieldName) = std::move(value);
+        if (stopAt && fieldName == *stopAt) {
+            return pos;
+        }
+    }
+    return Position();
+}
+
 Value& DocumentStorage::appendField(StringData name) {
-    Position pos = getNextPosition();
+    // A new field goes after all of the fields of the BSON the storage was created from.
+    loadAllFields();
+    _modified = true;
+    return appendFieldToBuffer(name);
+}
+
+Value& DocumentStorage::appendFieldToBuffer(StringData name) {
+    Position pos(_usedBytes);
     const int nameSize = name.size();
 
     // these are the same for everyone
@@ -106,7 +252,7 @@ Value& DocumentStorage::appendField(StringData name) {
 #undef append
 
     // Make sure next field starts where we expect it
-    fassert(16486, getField(pos).next()->ptr() == _buffer + _usedBytes);
+    fassert(16486, fieldAt(pos).next()->ptr() == _buffer + _usedBytes);
 
     _numFields++;
 
@@ -117,12 +263,12 @@ Value& DocumentStorage::appendField(StringData name) {
         rehash();
     }
 
-    return getField(pos).val;
+    return fieldAt(pos).val;
 }
 
 // Call after adding field to _fields and increasing _numFields
 void DocumentStorage::addFieldToHashTable(Position pos) {
-    ValueElement& elem = getField(pos);
+    ValueElement& elem = fieldAt(pos);
     elem.nextCollision = Position();
 
     const unsigned bucket = bucketForKey(elem.nameSD());
@@ -130,7 +276,7 @@ void DocumentStorage::addFieldToHashTable(Position pos) {
     Position* posPtr = &_hashTab[bucket];
     while (posPtr->found()) {
         // collision: walk links and add new to end
-        posPtr = &getField(*posPtr).nextCollision;
+        posPtr = &fieldAt(*posPtr).nextCollision;
     }
     *posPtr = Position(pos.index);
 }
@@ -139,6 +285,7 @@ void DocumentStorage::alloc(unsigned newSize) {
     const bool firstAlloc = !_buffer;
     const bool doingRehash = needRehash();
     const size_t oldCapacity = _bufferEnd - _buffer;
+    const size_t oldAllocatedBytes = allocatedBytes();
 
     // make new bucket count big enough
     while (needRehash() || hashTabBuckets() < HASH_TAB_INIT_SIZE)
@@ -151,13 +298,13 @@ void DocumentStorage::alloc(unsigned newSize) {
 
     uassert(16490, "Tried to make oversized document", capacity <= size_t(BufferMaxSize));
 
-    std::unique_ptr<char[]> oldBuf(_buffer);
-    _buffer = new char[capacity];
+    char* const oldBuf = _buffer;
+    _buffer = allocBuffer(capacity);
     _bufferEnd = _buffer + capacity - hashTabBytes();
 
     if (!firstAlloc) {
         // This just copies the elements
-        memcpy(_buffer, oldBuf.get(), _usedBytes);
+        memcpy(_buffer, oldBuf, _usedBytes);
 
         if (_numFields >= HASH_TAB_MIN) {
             // if we were hashing, deal with the hash table
@@ -165,10 +312,19 @@ void DocumentStorage::alloc(unsigned newSize) {
                 rehash();
             } else {
                 // no rehash needed so just slide table down to new position
-                memcpy(_hashTab, oldBuf.get() + oldCapacity, hashTabBytes());
+                memcpy(_hashTab, oldBuf + oldCapacity, hashTabBytes());
             }
         }
     }
+    freeBuffer(oldBuf, oldAllocatedBytes);
+}
+
+char* DocumentStorage::allocBuffer(size_t bytes) {
+    return static_cast<char*>(DocumentStorageCache::allocate(bytes));
+}
+
+void DocumentStorage::freeBuffer(char* buffer, size_t bytes) {
+    DocumentStorageCache::release(buffer, bytes);
 }
 
 void DocumentStorage::reserveFields(size_t expectedFields) {
@@ -184,7 +340,7 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
 
     uassert(16491, "Tried to make oversized document", newSize <= size_t(BufferMaxSize));
 
-    _buffer = new char[newSize + hashTabBytes()];
+    _buffer = allocBuffer(newSize + hashTabBytes());
     _bufferEnd = _buffer + newSize;
 }
 
@@ -194,7 +350,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
     // Make a copy of the buffer.
     // It is very important that the positions of each field are the same after cloning.
     const size_t bufferBytes = allocatedBytes();
-    out->_buffer = new char[bufferBytes];
+    out->_buffer = bufferBytes > 0 ? allocBuffer(bufferBytes) : nullptr;
     out->_bufferEnd = out->_buffer + (_bufferEnd - _buffer);
     if (bufferBytes > 0) {
         memcpy(out->_buffer, _buffer, bufferBytes);
@@ -210,6 +366,9 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
     out->_sortKey = _sortKey.getOwned();
     out->_geoNearDistance = _geoNearDistance;
     out->_geoNearPoint = _geoNearPoint.getOwned();
+    out->_bson = _bson;
+    out->_bsonIt = _bsonIt;
+    out->_modified = _modified;
 
     // Tell values that they have been memcpyed (updates ref counts)
     for (DocumentStorageIterator it = out->iteratorAll(); !it.atEnd(); it.advance()) {
@@ -220,11 +379,10 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
 }
 
 DocumentStorage::~DocumentStorage() {
-    std::unique_ptr<char[]> deleteBufferAtScopeEnd(_buffer);
-
     for (DocumentStorageIterator it = iteratorAll(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
     }
+    freeBuffer(_buffer, allocatedBytes());
 }
 
 Document::Document(const BSONObj& bson) {
@@ -263,12 +421,20 @@ void Document::toBson(BSONObjBuilder* builder, size_t recursionLevel) const {
                           << " levels of nesting",
             recursionLevel <= BSONDepth::getMaxAllowableDepth());
 
+    if (const BSONObj* bson = storage().unmodifiedBson()) {
+        builder->appendElements(*bson);
+        return;
+    }
+
     for (DocumentStorageIterator it = storage().iterator(); !it.atEnd(); it.advance()) {
         it->val.addToBsonObj(builder, it->nameSD(), recursionLevel);
     }
 }
 
 BSONObj Document::toBson() const {
+    if (const BSONObj* bson = storage().unmodifiedBson()) {
+        return *bson;
+    }
     BSONObjBuilder bb;
     toBson(&bb);
     return bb.obj();
@@ -296,7 +462,20 @@ BSONObj Document::toBsonWithMetaData() const {
     return bb.obj();
 }
 
+Document Document::fromOwnedBsonLazily(BSONObj bson) {
+    boost::intrusive_ptr<DocumentStorage> storage(new DocumentStorage());
+    storage->initFromBsonLazily(std::move(bson));
+    return Document(storage.get());
+}
+
 Document Document::fromBsonWithMetaData(const BSONObj& bson) {
+    const bool mayHaveMetaData = std::any_of(bson.begin(), bson.end(), [](const BSONElement& elem) {
+        return elem.fieldNameStringData()[0] == '$';
+    });
+    if (!mayHaveMetaData && !bson.isEmpty()) {
+        return fromOwnedBsonLazily(bson.getOwned());
+    }
+
     MutableDocument md;
 
     BSONObjIterator it(bson);
@@ -401,6 +580,31 @@ const Value Document::getNestedField(const FieldPath& path, vector<Position>* po
     return getNestedFieldHelper(*this, path, positions, 0);
 }
 
+void Document::loadLazyFields() const {
+    for (DocumentStorageIterator it = storage().iterator(); !it.atEnd(); it.advance()) {
+        it->val.loadLazyFields();
+    }
+}
+
+namespace {
+void loadAllNestedFields(const Value& value) {
+    if (value.getType() == BSONType::Object) {
+        value.getDocument().loadAllFields();
+    } else if (value.getType() == BSONType::Array) {
+        for (auto&& element : value.getArray()) {
+            loadAllNestedFields(element);
+        }
+    }
+}
+}  // namespace
+
+void Document::loadAllFields() const {
+    // Iterating the fields loads them.
+    for (auto it = fieldIterator(); it.more();) {
+        loadAllNestedFields(it.next().second);
+    }
+}
+
 size_t Document::getApproximateSize() const {
     if (!_storage)
         return 0;  // we've allocated no memory
@@ -408,7 +612,15 @@ size_t Document::getApproximateSize() const {
     size_t size = sizeof(DocumentStorage);
     size += storage().allocatedBytes();
 
-    for (DocumentStorageIterator it = storage().iterator(); !it.atEnd(); it.advance()) {
+    // A document created from BSON also holds the BSON, of which only the fields looked up so far
+    // have been loaded. The BSON of a nested object is part of the buffer of its outermost object.
+    if (const BSONObj* bson = storage().sourceBson()) {
+        if (bson->objdata() == bson->sharedBuffer().get()) {
+            size += bson->objsize();
+        }
+    }
+
+    for (DocumentStorageIterator it = storage().iteratorAll(); !it.atEnd(); it.advance()) {
         size += it->val.getApproximateSize();
         size -= sizeof(Value);  // already accounted for above
     }
@@ -139,6 +139,13 @@ public:
     const Value getNestedField(const FieldPath& path,
                                std::vector<Position>* positions = nullptr) const;
 
+    /**
+     * Loads every field of this document and of its nested documents which has yet to be converted
+     * from BSON. Reads never modify the document afterwards, so it may then be read from several
+     * threads at once.
+     */
+    void loadLazyFields() const;
+
     /// Number of fields in this document. O(n)
     size_t size() const {
         return storage().size();
@@ -146,7 +153,7 @@ public:
 
     /// True if this document has no fields.
     bool empty() const {
-        return !_storage || storage().iterator().atEnd();
+        return !_storage || storage().empty();
     }
 
     /// Create a new FieldIterator that can be used to examine the Document's fields in order.
@@ -216,6 +223,10 @@ public:
      * Like Document(BSONObj) but treats top-level fields with special names as metadata.
      * Special field names are available as static constants on this class with names starting
      * with metaField.
+     *
+     * Unless 'bson' has a top-level field starting with '$', the returned document keeps a copy of
+     * 'bson' and only converts each field, and each nested object, once it is looked up. Such a
+     * document is not safe to read from several threads at once.
      */
     static Document fromBsonWithMetaData(const BSONObj& bson);
 
@@ -293,12 +304,21 @@ public:
         return *this;
     }
 
+    /**
+     * Loads the fields of this document, and of the documents nested in it, which are still held
+     * in the BSON it was created from. Looking up fields otherwise loads them on first access,
+     * which modifies the storage, so a document must be fully loaded before several threads may
+     * read it at once.
+     */
+    void loadAllFields() const;
+
     /// only for testing
     const void* getPtr() const {
         return _storage.get();
     }
 
 private:
+    friend class DocumentStorage;
     friend class FieldIterator;
     friend class ValueStorage;
     friend class MutableDocument;
@@ -306,6 +326,10 @@ private:
 
     explicit Document(const DocumentStorage* ptr) : _storage(ptr){};
 
+    /// Returns a document which loads its fields from 'bson', which must be owned, as they are
+    /// looked up.
+    static Document fromOwnedBsonLazily(BSONObj bson);
+
     const DocumentStorage& storage() const {
         return (_storage ? *_storage : DocumentStorage::emptyDoc());
     }
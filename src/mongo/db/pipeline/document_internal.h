@@ -190,10 +190,17 @@ public:
           _metaFields(),
           _textScore(0),
           _randVal(0),
-          _geoNearDistance(0) {}
+          _geoNearDistance(0),
+          _bsonIt(nullptr),
+          _modified(false) {}
 
     ~DocumentStorage();
 
+    // DocumentStorage objects and their buffers are allocated through a per-thread cache of freed
+    // blocks, since pipelines create and destroy them at a high rate.
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
+
     enum MetaType : char {
         TEXT_SCORE,
         RAND_VAL,
@@ -217,14 +224,37 @@ public:
         return count;
     }
 
+    bool empty() const {
+        // A field which has yet to be loaded from BSON cannot be missing.
+        return isFullyLoaded() && iterator().atEnd();
+    }
+
     /// Returns the position of the next field to be inserted
     Position getNextPosition() const {
+        loadAllFields();
         return Position(_usedBytes);
     }
 
     /// Returns the position of the named field (may be missing) or Position()
     Position findField(StringData name) const;
 
+    /**
+     * Makes this empty storage hold the fields of 'bson', which must be owned, loading each field
+     * into the buffer only once it is looked up or the fields are iterated.
+     */
+    void initFromBsonLazily(BSONObj bson);
+
+    /// Returns the BSON this storage was created from, if any.
+    const BSONObj* sourceBson() const {
+        return _bsonIt ? &_bson : nullptr;
+    }
+
+    /// Returns the BSON this storage was created from if none of its fields have been modified
+    /// through a MutableDocument since, in which case it is the BSON form of the document.
+    const BSONObj* unmodifiedBson() const {
+        return _bsonIt && !_modified ? &_bson : nullptr;
+    }
+
     // Document uses these
     const ValueElement& getField(Position pos) const {
         verify(pos.found());
@@ -237,10 +267,12 @@ public:
         return getField(pos).val;
     }
 
-    // MutableDocument uses these
+    // MutableDocument uses these. Since a MutableValue refers to a field in the buffer, any fields
+    // which have yet to be loaded are loaded first, so that later lookups do not move the buffer.
     ValueElement& getField(Position pos) {
-        verify(pos.found());
-        return *(_firstElement->plusBytes(pos.index));
+        loadAllFields();
+        _modified = true;
+        return fieldAt(pos);
     }
     Value& getField(StringData name) {
         Position pos = findField(name);
@@ -259,10 +291,11 @@ public:
 
     /// This skips missing values
     DocumentStorageIterator iterator() const {
+        loadAllFields();
         return DocumentStorageIterator(_firstElement, end(), false);
     }
 
-    /// This includes missing values
+    /// This includes missing values, but only covers the fields loaded into the buffer so far
     DocumentStorageIterator iteratorAll() const {
         return DocumentStorageIterator(_firstElement, end(), true);
     }
@@ -360,6 +393,42 @@ private:
     /// Allocates space in _buffer. Copies existing data if there is any.
     void alloc(unsigned newSize);
 
+    ValueElement& fieldAt(Position pos) {
+        verify(pos.found());
+        return *(_firstElement->plusBytes(pos.index));
+    }
+
+    /// Adds a new field with missing Value after the fields loaded so far
+    Value& appendFieldToBuffer(StringData name);
+
+    bool isFullyLoaded() const {
+        return !_bsonIt || *_bsonIt == EOO;
+    }
+
+    /**
+     * Loads the fields of _bson which have yet to be loaded, stopping after the first one named
+     * '*stopAt' if it is given, and returns the position of that field or Position(). Loading
+     * changes what the buffer holds but not the fields of the document, so it is allowed on const
+     * storage.
+     */
+    Position loadFields(const StringData* stopAt) const;
+
+    void loadAllFields() const {
+        if (!isFullyLoaded()) {
+            loadFields(nullptr);
+        }
+    }
+
+    /**
+     * Converts 'elem', which is part of the owned BSONObj 'owner', to a Value whose nested objects
+     * share ownership of 'owner' and load their own fields lazily.
+     */
+    static Value lazyValueFromBson(const BSONElement& elem, const BSONObj& owner);
+
+    /// Allocates and frees the memory of _buffer. 'bytes' must be allocatedBytes() when freeing.
+    static char* allocBuffer(size_t bytes);
+    static void freeBuffer(char* buffer, size_t bytes);
+
     /// Call after adding field to _buffer and increasing _numFields
     void addFieldToHashTable(Position pos);
 
@@ -435,6 +504,13 @@ private:
     BSONObj _sortKey;
     double _geoNearDistance;
     Value _geoNearPoint;
+
+    // For storage created by initFromBsonLazily(), the BSON of the document and the first of its
+    // elements which has yet to be loaded into the buffer. '_modified' is set once a field may
+    // have been modified, after which '_bson' is no longer the BSON form of the document.
+    BSONObj _bson;
+    const char* _bsonIt;
+    bool _modified;
     // When adding a field, make sure to update clone() method
 
     // Defined in document.cpp
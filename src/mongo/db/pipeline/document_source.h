@@ -290,6 +290,15 @@ public:
         return false;
     };
 
+    /**
+     * Returns an estimate of the number of bytes of intermediate results, such as buffered
+     * documents or the groups of a $group, that this stage holds in memory. Must not be called
+     * while the pipeline is executing.
+     */
+    virtual size_t getMemUsage() const {
+        return 0;
+    }
+
     /**
      * Create a DocumentSource pipeline stage from 'stageObj'.
      */
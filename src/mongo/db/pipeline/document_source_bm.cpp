@@ -0,0 +1,296 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <vector>
+
+#ifdef MONGO_HAVE_GPERFTOOLS_MALLOC_HOOK
+#include <gperftools/malloc_hook.h>
+#endif
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/json.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/pipeline/stub_mongo_process_interface.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Benchmarks for the throughput of individual aggregation stages. Each iteration runs a pipeline
+ * over a DocumentSourceMock holding 'state.range(0)' documents, and the benchmarks report the
+ * documents processed per second.
+ *
+ * When built with tcmalloc, the benchmarks also report the bytes allocated per input document
+ * while the pipeline runs, counted through a MallocHook.
+ */
+
+#ifdef MONGO_HAVE_GPERFTOOLS_MALLOC_HOOK
+// The benchmarks are single threaded, so only the allocations of this thread are of interest.
+thread_local long long allocatedBytes = 0;
+
+void countAllocation(const void*, size_t size) {
+    allocatedBytes += size;
+}
+
+long long bytesAllocatedSoFar() {
+    static const bool hookAdded = MallocHook::AddNewHook(&countAllocation);
+    invariant(hookAdded);
+    return allocatedBytes;
+}
+#endif
+
+const NamespaceString kForeignNss("test", "customers");
+const int kNumCustomers = 100;
+
+/**
+ * Serves $lookup sub-pipelines from an in-memory copy of the foreign collection, which plays the
+ * part of a local, unsharded collection.
+ */
+class LocalCollectionProcessInterface final : public StubMongoProcessInterface {
+public:
+    explicit LocalCollectionProcessInterface(std::deque<DocumentSource::GetNextResult> documents)
+        : _documents(std::move(documents)) {}
+
+    bool isSharded(OperationContext* opCtx, const NamespaceString& ns) final {
+        return false;
+    }
+
+    StatusWith<std::unique_ptr<Pipeline, PipelineDeleter>> makePipeline(
+        const std::vector<BSONObj>& rawPipeline,
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const MakePipelineOptions opts) final {
+        auto pipeline = Pipeline::parse(rawPipeline, expCtx);
+        if (!pipeline.isOK()) {
+            return pipeline.getStatus();
+        }
+        if (opts.optimize) {
+            pipeline.getValue()->optimizePipeline();
+        }
+        if (opts.attachCursorSource) {
+            uassertStatusOK(attachCursorSourceToPipeline(expCtx, pipeline.getValue().get()));
+        }
+        return pipeline;
+    }
+
+    Status attachCursorSourceToPipeline(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                        Pipeline* pipeline) final {
+        pipeline->addInitialSource(DocumentSourceMock::create(_documents));
+        return Status::OK();
+    }
+
+private:
+    std::deque<DocumentSource::GetNextResult> _documents;
+};
+
+/**
+ * Returns an order with a few scalar fields, four line items and a reference to one of
+ * 'kNumCustomers' customers.
+ */
+Document makeOrder(int id) {
+    BSONObjBuilder bob;
+    bob.append("_id", id);
+    bob.append("customerId", id % kNumCustomers);
+    bob.append("status", id % 3 == 0 ? "shipped" : "pending");
+    bob.append("total", 19.99 + id % 1000);
+    {
+        BSONArrayBuilder items(bob.subarrayStart("items"));
+        for (int i = 0; i < 4; ++i) {
+            BSONObjBuilder item(items.subobjStart());
+            item.append("sku", "SKU-" + std::to_string((id + i) % 5000));
+            item.append("qty", 1 + i);
+            item.append("price", 4.99 + i);
+        }
+    }
+    bob.append("tags", BSON_ARRAY("gift"
+                                  << "express"));
+    return Document(bob.obj());
+}
+
+std::deque<DocumentSource::GetNextResult> makeCustomers() {
+    std::deque<DocumentSource::GetNextResult> customers;
+    for (int i = 0; i < kNumCustomers; ++i) {
+        customers.emplace_back(Document{{"_id", i},
+                                        {"name", "Customer " + std::to_string(i)},
+                                        {"city", i % 2 == 0 ? "New York" : "Dublin"}});
+    }
+    return customers;
+}
+
+/**
+ * Runs the pipeline 'stages', given as a JSON array, over 'state.range(0)' orders.
+ */
+void runPipeline(benchmark::State& state, const char* stages) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    expCtx->mongoProcessInterface =
+        std::make_shared<LocalCollectionProcessInterface>(makeCustomers());
+    expCtx->setResolvedNamespace(kForeignNss, {kForeignNss, std::vector<BSONObj>{}});
+
+    std::vector<BSONObj> rawPipeline;
+    for (auto&& stage : fromjson(std::string("{stages: ") + stages + "}")["stages"].Obj()) {
+        rawPipeline.push_back(stage.Obj().getOwned());
+    }
+
+    const int numDocuments = state.range(0);
+    std::deque<DocumentSource::GetNextResult> input;
+    for (int i = 0; i < numDocuments; ++i) {
+        input.emplace_back(makeOrder(i));
+    }
+
+#ifdef MONGO_HAVE_GPERFTOOLS_MALLOC_HOOK
+    long long bytesAllocated = 0;
+#endif
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
+    for (auto _ : state) {
+        // Blocking stages such as $group and $sort cannot be rewound, so each iteration runs a
+        // new pipeline. Building it is not part of the measurement.
+        state.PauseTiming();
+        pipeline.reset();
+        pipeline = uassertStatusOK(Pipeline::parse(rawPipeline, expCtx));
+        pipeline->addInitialSource(DocumentSourceMock::create(input));
+        state.ResumeTiming();
+
+#ifdef MONGO_HAVE_GPERFTOOLS_MALLOC_HOOK
+        const auto allocatedBefore = bytesAllocatedSoFar();
+#endif
+        while (auto doc = pipeline->getNext()) {
+            benchmark::DoNotOptimize(doc);
+        }
+#ifdef MONGO_HAVE_GPERFTOOLS_MALLOC_HOOK
+        bytesAllocated += bytesAllocatedSoFar() - allocatedBefore;
+#endif
+    }
+
+    state.SetItemsProcessed(state.iterations() * numDocuments);
+#ifdef MONGO_HAVE_GPERFTOOLS_MALLOC_HOOK
+    if (state.iterations() > 0) {
+        state.counters["bytesAllocatedPerDoc"] =
+            static_cast<double>(bytesAllocated) / (state.iterations() * numDocuments);
+    }
+#endif
+}
+
+void BM_GroupCount(benchmark::State& state) {
+    runPipeline(state, "[{$group: {_id: '$customerId', count: {$sum: 1}}}]");
+}
+
+void BM_GroupSumAvg(benchmark::State& state) {
+    runPipeline(state,
+                "[{$group: {_id: '$customerId', revenue: {$sum: '$total'}, "
+                "avgOrder: {$avg: '$total'}}}]");
+}
+
+void BM_GroupMinMax(benchmark::State& state) {
+    runPipeline(state,
+                "[{$group: {_id: '$customerId', first: {$min: '$_id'}, last: {$max: '$_id'}}}]");
+}
+
+void BM_GroupPush(benchmark::State& state) {
+    runPipeline(state, "[{$group: {_id: '$customerId', orders: {$push: '$_id'}}}]");
+}
+
+void BM_GroupAddToSet(benchmark::State& state) {
+    runPipeline(state, "[{$group: {_id: '$status', customers: {$addToSet: '$customerId'}}}]");
+}
+
+void BM_GroupCompoundKey(benchmark::State& state) {
+    runPipeline(state,
+                "[{$group: {_id: {customer: '$customerId', status: '$status'}, "
+                "count: {$sum: 1}}}]");
+}
+
+void BM_Unwind(benchmark::State& state) {
+    runPipeline(state, "[{$unwind: '$items'}]");
+}
+
+void BM_UnwindGroup(benchmark::State& state) {
+    runPipeline(state,
+                "[{$unwind: '$items'}, "
+                "{$group: {_id: '$items.sku', sold: {$sum: '$items.qty'}}}]");
+}
+
+void BM_ProjectInclusion(benchmark::State& state) {
+    runPipeline(state, "[{$project: {_id: 0, customerId: 1, total: 1}}]");
+}
+
+void BM_ProjectExclusion(benchmark::State& state) {
+    runPipeline(state, "[{$project: {items: 0, tags: 0}}]");
+}
+
+void BM_ProjectComputed(benchmark::State& state) {
+    runPipeline(state,
+                "[{$project: {total: 1, tax: {$multiply: ['$total', 0.2]}, "
+                "numItems: {$size: '$items'}}}]");
+}
+
+void BM_Sort(benchmark::State& state) {
+    runPipeline(state, "[{$sort: {total: -1, _id: 1}}]");
+}
+
+void BM_SortLimit(benchmark::State& state) {
+    runPipeline(state, "[{$sort: {total: -1}}, {$limit: 10}]");
+}
+
+void BM_LookupLocalCollection(benchmark::State& state) {
+    runPipeline(state,
+                "[{$lookup: {from: 'customers', localField: 'customerId', foreignField: '_id', "
+                "as: 'customer'}}]");
+}
+
+void BM_Facet(benchmark::State& state) {
+    runPipeline(state,
+                "[{$facet: {byStatus: [{$group: {_id: '$status', count: {$sum: 1}}}], "
+                "top: [{$sort: {total: -1}}, {$limit: 5}], "
+                "skus: [{$unwind: '$items'}, {$group: {_id: '$items.sku'}}]}}]");
+}
+
+BENCHMARK(BM_GroupCount)->Arg(10000);
+BENCHMARK(BM_GroupSumAvg)->Arg(10000);
+BENCHMARK(BM_GroupMinMax)->Arg(10000);
+BENCHMARK(BM_GroupPush)->Arg(10000);
+BENCHMARK(BM_GroupAddToSet)->Arg(10000);
+BENCHMARK(BM_GroupCompoundKey)->Arg(10000);
+BENCHMARK(BM_Unwind)->Arg(10000);
+BENCHMARK(BM_UnwindGroup)->Arg(10000);
+BENCHMARK(BM_ProjectInclusion)->Arg(10000);
+BENCHMARK(BM_ProjectExclusion)->Arg(10000);
+BENCHMARK(BM_ProjectComputed)->Arg(10000);
+BENCHMARK(BM_Sort)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_SortLimit)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_LookupLocalCollection)->Arg(1000);
+BENCHMARK(BM_Facet)->Arg(10000);
+
+}  // namespace
+}  // namespace mongo
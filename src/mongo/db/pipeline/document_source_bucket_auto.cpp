@@ -52,13 +52,18 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::getNext() {
     pExpCtx->checkForInterrupt();
 
     if (!_populated) {
-        const auto populationResult = populateSorter();
+        const auto populationResult =
+            _approximate ? populateProvisionalBuckets() : populateSorter();
         if (populationResult.isPaused()) {
             return populationResult;
         }
         invariant(populationResult.isEOF());
 
-        populateBuckets();
+        if (_approximate) {
+            populateBucketsFromProvisionalBuckets();
+        } else {
+            populateBuckets();
+        }
 
         _populated = true;
         _bucketsIterator = _buckets.begin();
@@ -113,6 +118,68 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::populateSorter() {
     return next;
 }
 
+DocumentSource::GetNextResult DocumentSourceBucketAuto::populateProvisionalBuckets() {
+    const size_t numAccumulators = _accumulatedFields.size();
+    const size_t maxProvisionalBuckets = 2 * size_t(kProvisionalBucketsPerBucket) * _nBuckets;
+
+    auto next = pSource->getNext();
+    for (; next.isAdvanced(); next = pSource->getNext()) {
+        auto nextDoc = next.releaseDocument();
+        Bucket& bucket = getProvisionalBucket(extractKey(nextDoc));
+        for (size_t k = 0; k < numAccumulators; k++) {
+            bucket._accums[k]->process(_accumulatedFields[k].expression->evaluate(nextDoc), false);
+        }
+        ++bucket._count;
+        _nDocuments++;
+
+        if (_provisionalBuckets.size() >= maxProvisionalBuckets) {
+            compactProvisionalBuckets();
+        }
+    }
+    return next;
+}
+
+DocumentSourceBucketAuto::Bucket& DocumentSourceBucketAuto::getProvisionalBucket(
+    const Value& key) {
+    auto it = _provisionalBuckets.upper_bound(key);
+    if (it != _provisionalBuckets.begin()) {
+        Bucket& previous = std::prev(it)->second;
+        if (pExpCtx->getValueComparator().evaluate(key <= previous._max)) {
+            return previous;
+        }
+    }
+    return _provisionalBuckets.emplace_hint(it, key, Bucket(pExpCtx, key, key, _accumulatedFields))
+        ->second;
+}
+
+void DocumentSourceBucketAuto::compactProvisionalBuckets() {
+    // No two neighbouring buckets may remain whose documents add up to at most 'maxBucketSize',
+    // so that fewer than 'kProvisionalBucketsPerBucket * _nBuckets' are left.
+    const long long targetNumBuckets =
+        static_cast<long long>(kProvisionalBucketsPerBucket) * _nBuckets;
+    const long long maxBucketSize = std::max(2 * _nDocuments / targetNumBuckets, 1LL);
+
+    auto current = _provisionalBuckets.begin();
+    for (auto next = std::next(current); next != _provisionalBuckets.end();) {
+        if (current->second._count + next->second._count <= maxBucketSize) {
+            mergeBucket(next->second, current->second);
+            next = _provisionalBuckets.erase(next);
+        } else {
+            current = next++;
+        }
+    }
+}
+
+void DocumentSourceBucketAuto::mergeBucket(const Bucket& other, Bucket& bucket) {
+    bucket._max = other._max;
+    bucket._count += other._count;
+
+    const size_t numAccumulators = _accumulatedFields.size();
+    for (size_t k = 0; k < numAccumulators; k++) {
+        bucket._accums[k]->process(other._accums[k]->getValue(true), true);
+    }
+}
+
 Value DocumentSourceBucketAuto::extractKey(const Document& doc) {
     if (!_groupByExpression) {
         return Value(BSONNULL);
@@ -254,6 +321,47 @@ void DocumentSourceBucketAuto::populateBuckets() {
         addBucket(currentBucket);
     }
 
+    roundOuterBoundaries();
+}
+
+void DocumentSourceBucketAuto::populateBucketsFromProvisionalBuckets() {
+    // Calculate the approximate bucket size, as populateBuckets() does.
+    const long long approxBucketSize =
+        std::max(static_cast<long long>(std::round(double(_nDocuments) / double(_nBuckets))), 1LL);
+
+    auto next = _provisionalBuckets.begin();
+    for (int i = 0; i < _nBuckets && next != _provisionalBuckets.end(); i++) {
+        const bool isLastBucket = (i == _nBuckets - 1);
+        Bucket currentBucket = std::move(next++->second);
+
+        // Since a provisional bucket holds all of the documents with the same value, this fills
+        // the bucket up to a boundary between values, like populateBuckets() does. The last
+        // bucket takes any that remain.
+        while (next != _provisionalBuckets.end() &&
+               (isLastBucket || currentBucket._count < approxBucketSize)) {
+            mergeBucket(next++->second, currentBucket);
+        }
+
+        if (_granularityRounder && next != _provisionalBuckets.end()) {
+            Value boundaryValue = _granularityRounder->roundUp(currentBucket._max);
+            // If any buckets now start below the rounded boundary, absorb them too.
+            while (next != _provisionalBuckets.end() &&
+                   pExpCtx->getValueComparator().evaluate(boundaryValue > next->first)) {
+                mergeBucket(next++->second, currentBucket);
+            }
+            if (next != _provisionalBuckets.end()) {
+                currentBucket._max = boundaryValue;
+            }
+        }
+
+        addBucket(currentBucket);
+    }
+    _provisionalBuckets.clear();
+
+    roundOuterBoundaries();
+}
+
+void DocumentSourceBucketAuto::roundOuterBoundaries() {
     if (!_buckets.empty() && _granularityRounder) {
         // If we we have a granularity, we round the first bucket's minimum down and the last
         // bucket's maximum up. This way all of the bucket boundaries are rounded to numbers in the
@@ -328,6 +436,7 @@ Document DocumentSourceBucketAuto::makeDocument(const Bucket& bucket) {
 
 void DocumentSourceBucketAuto::doDispose() {
     _sortedInput.reset();
+    _provisionalBuckets.clear();
     _bucketsIterator = _buckets.end();
 }
 
@@ -342,6 +451,10 @@ Value DocumentSourceBucketAuto::serialize(
         insides["granularity"] = Value(_granularityRounder->getName());
     }
 
+    if (_approximate) {
+        insides["approximate"] = Value(true);
+    }
+
     MutableDocument outputSpec(_accumulatedFields.size());
     for (auto&& accumulatedField : _accumulatedFields) {
         intrusive_ptr<Accumulator> accum = accumulatedField.makeAccumulator(pExpCtx);
@@ -360,7 +473,8 @@ intrusive_ptr<DocumentSourceBucketAuto> DocumentSourceBucketAuto::create(
     int numBuckets,
     std::vector<AccumulationStatement> accumulationStatements,
     const boost::intrusive_ptr<GranularityRounder>& granularityRounder,
-    uint64_t maxMemoryUsageBytes) {
+    uint64_t maxMemoryUsageBytes,
+    bool approximate) {
     uassert(40243,
             str::stream() << "The $bucketAuto 'buckets' field must be greater than 0, but found: "
                           << numBuckets,
@@ -371,12 +485,24 @@ intrusive_ptr<DocumentSourceBucketAuto> DocumentSourceBucketAuto::create(
                                             ExpressionConstant::create(pExpCtx, Value(1)),
                                             AccumulationStatement::getFactory("$sum"));
     }
+    if (approximate) {
+        // Provisional buckets accumulate their documents in no particular order.
+        for (auto&& accumulationStatement : accumulationStatements) {
+            auto accum = accumulationStatement.makeAccumulator(pExpCtx);
+            uassert(51537,
+                    str::stream() << "An approximate $bucketAuto does not support the "
+                                  << accum->getOpName()
+                                  << " accumulator, which depends on the order of its input",
+                    accum->isCommutative());
+        }
+    }
     return new DocumentSourceBucketAuto(pExpCtx,
                                         groupByExpression,
                                         numBuckets,
                                         accumulationStatements,
                                         granularityRounder,
-                                        maxMemoryUsageBytes);
+                                        maxMemoryUsageBytes,
+                                        approximate);
 }
 
 DocumentSourceBucketAuto::DocumentSourceBucketAuto(
@@ -385,10 +511,13 @@ DocumentSourceBucketAuto::DocumentSourceBucketAuto(
     int numBuckets,
     std::vector<AccumulationStatement> accumulationStatements,
     const boost::intrusive_ptr<GranularityRounder>& granularityRounder,
-    uint64_t maxMemoryUsageBytes)
+    uint64_t maxMemoryUsageBytes,
+    bool approximate)
     : DocumentSource(pExpCtx),
+      _provisionalBuckets(pExpCtx->getValueComparator().makeOrderedValueMap<Bucket>()),
       _nBuckets(numBuckets),
       _maxMemoryUsageBytes(maxMemoryUsageBytes),
+      _approximate(approximate),
       _groupByExpression(groupByExpression),
       _granularityRounder(granularityRounder) {
 
@@ -432,6 +561,7 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
     boost::intrusive_ptr<Expression> groupByExpression;
     boost::optional<int> numBuckets;
     boost::intrusive_ptr<GranularityRounder> granularityRounder;
+    bool approximate = false;
 
     for (auto&& argument : elem.Obj()) {
         const auto argName = argument.fieldNameStringData();
@@ -472,6 +602,13 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
                         << typeName(argument.type()),
                     argument.type() == BSONType::String);
             granularityRounder = GranularityRounder::getGranularityRounder(pExpCtx, argument.str());
+        } else if ("approximate" == argName) {
+            uassert(51538,
+                    str::stream()
+                        << "The $bucketAuto 'approximate' field must be a boolean, but found type: "
+                        << typeName(argument.type()),
+                    argument.type() == BSONType::Bool);
+            approximate = argument.boolean();
         } else {
             uasserted(40245, str::stream() << "Unrecognized option to $bucketAuto: " << argName);
         }
@@ -481,8 +618,13 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
             "$bucketAuto requires 'groupBy' and 'buckets' to be specified",
             groupByExpression && numBuckets);
 
-    return DocumentSourceBucketAuto::create(
-        pExpCtx, groupByExpression, numBuckets.get(), accumulationStatements, granularityRounder);
+    return DocumentSourceBucketAuto::create(pExpCtx,
+                                            groupByExpression,
+                                            numBuckets.get(),
+                                            accumulationStatements,
+                                            granularityRounder,
+                                            kDefaultMaxMemoryUsageBytes,
+                                            approximate);
 }
 }  // namespace mongo
 
@@ -52,7 +52,7 @@ public:
         return {StreamType::kBlocking,
                 PositionRequirement::kNone,
                 HostTypeRequirement::kNone,
-                DiskUseRequirement::kWritesTmpData,
+                _approximate ? DiskUseRequirement::kNoDiskUse : DiskUseRequirement::kWritesTmpData,
                 FacetRequirement::kAllowed,
                 TransactionRequirement::kAllowed};
     }
@@ -69,11 +69,17 @@ public:
 
     static const uint64_t kDefaultMaxMemoryUsageBytes = 100 * 1024 * 1024;
 
+    // When approximating, the number of provisional buckets kept for each requested bucket.
+    static const int kProvisionalBucketsPerBucket = 32;
+
     /**
      * Convenience method to create a $bucketAuto stage.
      *
      * If 'accumulationStatements' is the empty vector, it will be filled in with the statement
      * 'count: {$sum: 1}'.
+     *
+     * If 'approximate' is true, the boundaries are approximated in one pass over the input instead
+     * of sorting it, which requires every accumulator to be commutative.
      */
     static boost::intrusive_ptr<DocumentSourceBucketAuto> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
@@ -81,7 +87,8 @@ public:
         int numBuckets,
         std::vector<AccumulationStatement> accumulationStatements = {},
         const boost::intrusive_ptr<GranularityRounder>& granularityRounder = nullptr,
-        uint64_t maxMemoryUsageBytes = kDefaultMaxMemoryUsageBytes);
+        uint64_t maxMemoryUsageBytes = kDefaultMaxMemoryUsageBytes,
+        bool approximate = false);
 
     /**
      * Parses a $bucketAuto stage from the user-supplied BSON.
@@ -98,7 +105,8 @@ private:
                              int numBuckets,
                              std::vector<AccumulationStatement> accumulationStatements,
                              const boost::intrusive_ptr<GranularityRounder>& granularityRounder,
-                             uint64_t maxMemoryUsageBytes);
+                             uint64_t maxMemoryUsageBytes,
+                             bool approximate);
 
     // struct for holding information about a bucket.
     struct Bucket {
@@ -109,6 +117,7 @@ private:
         Value _min;
         Value _max;
         std::vector<boost::intrusive_ptr<Accumulator>> _accums;
+        long long _count = 0;
     };
 
     /**
@@ -119,6 +128,41 @@ private:
      */
     GetNextResult populateSorter();
 
+    /**
+     * Consumes all of the documents from the source in the pipeline, accumulating each of them into
+     * the provisional bucket holding its 'groupBy' value. Like populateSorter(), returns the last
+     * GetNextResult encountered, which may be either kEOF or kPauseExecution.
+     */
+    GetNextResult populateProvisionalBuckets();
+
+    /**
+     * Returns the provisional bucket whose range holds 'key', creating one for 'key' alone if there
+     * is none.
+     */
+    Bucket& getProvisionalBucket(const Value& key);
+
+    /**
+     * Merges neighbouring provisional buckets, such that at most about half as many remain, which
+     * hold roughly the same number of documents.
+     */
+    void compactProvisionalBuckets();
+
+    /**
+     * Calculates the bucket boundaries from the provisional buckets, merging consecutive ones into
+     * each bucket the same way populateBuckets() does with consecutive documents.
+     */
+    void populateBucketsFromProvisionalBuckets();
+
+    /**
+     * Merges the accumulators and range of 'other', which must follow 'bucket', into 'bucket'.
+     */
+    void mergeBucket(const Bucket& other, Bucket& bucket);
+
+    /**
+     * With a granularity, rounds the first bucket's minimum down and the last bucket's maximum up.
+     */
+    void roundOuterBoundaries();
+
     /**
      * Computes the 'groupBy' expression value for 'doc'.
      */
@@ -148,10 +192,15 @@ private:
     std::unique_ptr<Sorter<Value, Document>> _sorter;
     std::unique_ptr<Sorter<Value, Document>::Iterator> _sortedInput;
 
+    // When approximating, the provisional buckets keyed by their minimum. Each of them holds every
+    // document whose 'groupBy' value lies between its minimum and maximum.
+    ValueMap<Bucket> _provisionalBuckets;
+
     std::vector<AccumulationStatement> _accumulatedFields;
 
     int _nBuckets;
     uint64_t _maxMemoryUsageBytes;
+    bool _approximate;
     bool _populated = false;
     std::vector<Bucket> _buckets;
     std::vector<Bucket>::iterator _bucketsIterator;
@@ -802,5 +802,94 @@ TEST_F(BucketAutoTests, ShouldFailOnNegativeNumbersWhenGranularitySpecified) {
         AssertionException,
         40260);
 }
+
+TEST_F(BucketAutoTests, ApproximateBucketsMatchExactBucketsWhenFewDistinctValues) {
+    // Values 0 to 19, where each value 'i' appears 'i % 4 + 1' times.
+    deque<Document> inputs;
+    for (int i = 19; i >= 0; i--) {
+        for (int j = 0; j <= i % 4; j++) {
+            inputs.push_back(Document{{"x", i}});
+        }
+    }
+
+    for (auto&& spec : {"{groupBy : '$x', buckets : 4, output : {count : {$sum : 1}, total : "
+                        "{$sum : '$x'}, top : {$max : '$x'}}}",
+                        "{groupBy : '$x', buckets : 3, granularity : 'R5'}",
+                        "{groupBy : '$x', buckets : 100}"}) {
+        auto exactSpec = fromjson(spec);
+        BSONObjBuilder approximateSpec;
+        approximateSpec.appendElements(exactSpec);
+        approximateSpec.append("approximate", true);
+        auto expected = getResults(BSON("$bucketAuto" << exactSpec), inputs);
+        auto results = getResults(BSON("$bucketAuto" << approximateSpec.obj()), inputs);
+
+        ASSERT_EQUALS(results.size(), expected.size());
+        for (size_t i = 0; i < results.size(); i++) {
+            ASSERT_DOCUMENT_EQ(results[i], expected[i]);
+        }
+    }
+}
+
+TEST_F(BucketAutoTests, ApproximateBucketsHoldRoughlyEqualNumbersOfDocuments) {
+    const int kNumDocuments = 10000;
+    const long long kNumBuckets = 5;
+    auto bucketAutoSpec =
+        fromjson("{$bucketAuto : {groupBy : '$x', buckets : 5, approximate : true}}");
+
+    // Values in a scrambled order, and in increasing order.
+    deque<Document> scrambled;
+    deque<Document> increasing;
+    for (int i = 0; i < kNumDocuments; i++) {
+        scrambled.push_back(Document{{"x", (i * 7919) % kNumDocuments}});
+        increasing.push_back(Document{{"x", i}});
+    }
+
+    for (auto&& inputs : {scrambled, increasing}) {
+        auto results = getResults(bucketAutoSpec, inputs);
+        ASSERT_EQUALS(results.size(), 5UL);
+        ASSERT_VALUE_EQ(results.front()["_id"]["min"], Value(0));
+        ASSERT_VALUE_EQ(results.back()["_id"]["max"], Value(kNumDocuments - 1));
+
+        // Every bucket but the last is filled up to at least its share of the documents, and
+        // overshoots by less than the provisional bucket which completed it.
+        const long long share = kNumDocuments / kNumBuckets;
+        for (size_t i = 0; i < results.size(); i++) {
+            const long long count = results[i]["count"].coerceToLong();
+            if (i + 1 < results.size()) {
+                ASSERT_GTE(count, share);
+            }
+            ASSERT_LTE(std::abs(count - share), share / 4);
+            if (i > 0) {
+                ASSERT_VALUE_EQ(results[i]["_id"]["min"], results[i - 1]["_id"]["max"]);
+                ASSERT_EQ(results[i]["_id"]["min"].coerceToLong(),
+                          results[i - 1]["_id"]["min"].coerceToLong() +
+                              results[i - 1]["count"].coerceToLong());
+            }
+        }
+    }
+}
+
+TEST_F(BucketAutoTests, ShouldSerializeAndReParseApproximateOption) {
+    BSONObj spec = fromjson("{$bucketAuto : {groupBy : '$x', buckets : 2, approximate : true}}");
+    BSONObj expected = fromjson(
+        "{groupBy : '$x', buckets : 2, approximate : true, output : {count : {$sum : {$const : "
+        "1}}}}");
+    testSerialize(spec, expected);
+
+    auto bucketAuto = createBucketAuto(spec);
+    ASSERT(bucketAuto->constraints(Pipeline::SplitState::kUnsplit).diskRequirement ==
+           StageConstraints::DiskUseRequirement::kNoDiskUse);
+}
+
+TEST_F(BucketAutoTests, ShouldFailWithInvalidApproximateOption) {
+    auto spec = fromjson("{$bucketAuto : {groupBy : '$x', buckets : 2, approximate : 1}}");
+    ASSERT_THROWS_CODE(createBucketAuto(spec), AssertionException, 51538);
+
+    // Accumulators which depend on the order of their input are not supported.
+    spec = fromjson(
+        "{$bucketAuto : {groupBy : '$x', buckets : 2, approximate : true, output : {all : {$push : "
+        "'$x'}}}}");
+    ASSERT_THROWS_CODE(createBucketAuto(spec), AssertionException, 51537);
+}
 }  // namespace
 }  // namespace mongo
@@ -37,11 +37,13 @@
 #include "mongo/db/pipeline/change_stream_constants.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/document_source_change_stream_close_cursor.h"
+#include "mongo/db/pipeline/document_source_change_stream_subscriber.h"
 #include "mongo/db/pipeline/document_source_change_stream_transform.h"
 #include "mongo/db/pipeline/document_source_check_invalidate.h"
 #include "mongo/db/pipeline/document_source_check_resume_token.h"
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
+#include "mongo/db/pipeline/document_source_lookup_change_pre_image.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
@@ -72,6 +74,7 @@ REGISTER_MULTI_STAGE_ALIAS(changeStream,
 
 constexpr StringData DocumentSourceChangeStream::kDocumentKeyField;
 constexpr StringData DocumentSourceChangeStream::kFullDocumentField;
+constexpr StringData DocumentSourceChangeStream::kFullDocumentBeforeChangeField;
 constexpr StringData DocumentSourceChangeStream::kIdField;
 constexpr StringData DocumentSourceChangeStream::kNamespaceField;
 constexpr StringData DocumentSourceChangeStream::kUuidField;
@@ -377,6 +380,17 @@ list<intrusive_ptr<DocumentSource>> buildPipeline(const intrusive_ptr<Expression
         startFrom = replCoord->getMyLastAppliedOpTime().getTimestamp();
     }
 
+    // A change stream with no resume point which is being run directly against a replica set
+    // member may share a single oplog reader with the other such change streams on the same
+    // namespace, rather than reading and transforming the oplog itself.
+    if (internalChangeStreamUseSharedReader.load() && !resumeStage && !expCtx->inMongos &&
+        !expCtx->fromMongos && !expCtx->needsMerge && !expCtx->explain) {
+        stages.push_back(DocumentSourceChangeStreamSubscriber::create(
+            expCtx, *startFrom, elem.embeddedObject()));
+        stages.push_back(DocumentSourceCheckInvalidate::create(expCtx, ignoreFirstInvalidate));
+        return stages;
+    }
+
     if (startFrom) {
         const bool startFromInclusive = (resumeStage != nullptr);
         stages.push_back(DocumentSourceOplogMatch::create(
@@ -427,6 +441,21 @@ list<intrusive_ptr<DocumentSource>> DocumentSourceChangeStream::createFromBson(
 
     const bool shouldLookupPostImage = (fullDocOption == "updateLookup"_sd);
 
+    auto fullDocBeforeChangeOption = spec.getFullDocumentBeforeChange();
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "unrecognized value for the 'fullDocumentBeforeChange' option to the "
+                             "$changeStream stage. Expected \"off\" or \"whenAvailable\", got \""
+                          << fullDocBeforeChangeOption
+                          << "\"",
+            fullDocBeforeChangeOption == "whenAvailable"_sd ||
+                fullDocBeforeChangeOption == "off"_sd);
+
+    const bool shouldLookupPreImage = (fullDocBeforeChangeOption == "whenAvailable"_sd);
+    uassert(ErrorCodes::InvalidOptions,
+            "the 'fullDocumentBeforeChange' option to the $changeStream stage is not supported on "
+            "sharded clusters",
+            !shouldLookupPreImage || !expCtx->inMongos);
+
     auto stages = buildPipeline(expCtx, spec, elem);
     if (!expCtx->needsMerge) {
         // There should only be one close cursor stage. If we're on the shards and producing input
@@ -438,6 +467,10 @@ list<intrusive_ptr<DocumentSource>> DocumentSourceChangeStream::createFromBson(
         if (shouldLookupPostImage) {
             stages.push_back(DocumentSourceLookupChangePostImage::create(expCtx));
         }
+
+        if (shouldLookupPreImage) {
+            stages.push_back(DocumentSourceLookupChangePreImage::create(expCtx));
+        }
     }
     return stages;
 }
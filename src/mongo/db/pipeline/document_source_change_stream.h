@@ -106,6 +106,10 @@ public:
     // full document is only present for certain types of operations, such as an insert.
     static constexpr StringData kFullDocumentField = "fullDocument"_sd;
 
+    // The name of the field where the version of the document before an update will be found,
+    // when the stream asks for it and the collection records it.
+    static constexpr StringData kFullDocumentBeforeChangeField = "fullDocumentBeforeChange"_sd;
+
     // The name of the field where the change identifier will be located after the transformation.
     static constexpr StringData kIdField = "_id"_sd;
 
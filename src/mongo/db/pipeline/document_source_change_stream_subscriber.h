@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/bson/timestamp.h"
+#include "mongo/db/pipeline/change_stream_shared_reader.h"
+#include "mongo/db/pipeline/document_source.h"
+
+namespace mongo {
+
+/**
+ * This stage is used internally by change streams which share an oplog reader with the other
+ * change streams on the same namespace, in place of the stages which read and transform the oplog.
+ * It returns the events which the shared reader dispatches to this change stream. It is not
+ * intended to be created by the user.
+ */
+class DocumentSourceChangeStreamSubscriber final : public DocumentSource {
+public:
+    GetNextResult getNext() final;
+
+    const char* getSourceName() const final {
+        // This is used in error reporting.
+        return "$changeStream";
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        StageConstraints constraints(StreamType::kStreaming,
+                                     PositionRequirement::kFirst,
+                                     HostTypeRequirement::kAnyShard,
+                                     DiskUseRequirement::kNoDiskUse,
+                                     FacetRequirement::kNotAllowed,
+                                     TransactionRequirement::kNotAllowed,
+                                     ChangeStreamRequirement::kChangeStreamStage);
+        constraints.requiresInputDocSource = false;
+        constraints.isIndependentOfAnyCollection = pExpCtx->ns.isCollectionlessAggregateNS();
+        return constraints;
+    }
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    static boost::intrusive_ptr<DocumentSourceChangeStreamSubscriber> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        Timestamp startFrom,
+        BSONObj changeStreamSpec) {
+        return new DocumentSourceChangeStreamSubscriber(expCtx, startFrom, changeStreamSpec);
+    }
+
+protected:
+    void doDispose() final;
+
+private:
+    /**
+     * Use the create static method to create a DocumentSourceChangeStreamSubscriber.
+     */
+    DocumentSourceChangeStreamSubscriber(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                         Timestamp startFrom,
+                                         BSONObj changeStreamSpec)
+        : DocumentSource(expCtx),
+          _startFrom(startFrom),
+          _changeStreamSpec(changeStreamSpec.getOwned()) {}
+
+    // The point after which a new shared reader starts reading the oplog, if this change stream
+    // does not find one to subscribe to.
+    const Timestamp _startFrom;
+    const BSONObj _changeStreamSpec;
+
+    // Subscribed to on the first call to getNext(), normally made by the aggregate command which
+    // opened the change stream. The change stream only sees the events which happen after that.
+    std::shared_ptr<ChangeStreamSharedReader> _reader;
+    std::shared_ptr<ChangeStreamSharedReader::Subscriber> _subscriber;
+};
+
+}  // namespace mongo
@@ -58,10 +58,23 @@ DocumentSource::GetNextResult DocumentSourceCursor::getNext() {
     pExpCtx->checkForInterrupt();
 
     if (_currentBatch.empty()) {
-        loadBatch();
+        if (_readAheadThread.joinable()) {
+            joinReadAhead();
+            if (auto error = _readAheadError) {
+                _readAheadError = nullptr;
+                std::rethrow_exception(error);
+            }
+            _currentBatch.swap(_readAheadBatch);
+        } else {
+            loadBatch(&_currentBatch);
+        }
 
         if (_currentBatch.empty())
             return GetNextResult::makeEOF();
+
+        if (_readAhead && _exec && !_exec->isDisposed()) {
+            startReadAhead();
+        }
     }
 
     Document out = std::move(_currentBatch.front());
@@ -70,10 +83,36 @@ DocumentSource::GetNextResult DocumentSourceCursor::getNext() {
 }
 
 Document DocumentSourceCursor::transformBSONObjToDocument(const BSONObj& obj) const {
+    if (_aggProjection) {
+        // The projected BSON is only converted to a Document as the pipeline reads its fields, and
+        // is returned as it is if no later stage changes it.
+        return Document::fromBsonWithMetaData(_aggProjection->applyProjection(obj));
+    }
     return _dependencies ? _dependencies->extractFields(obj) : Document::fromBsonWithMetaData(obj);
 }
 
-void DocumentSourceCursor::loadBatch() {
+void DocumentSourceCursor::startReadAhead() {
+    invariant(_readAheadBatch.empty());
+    pExpCtx->opCtxLent = true;
+    _readAheadThread = stdx::thread([this] {
+        auto lockState = pExpCtx->opCtx->lockState();
+        lockState->updateThreadIdToCurrentThread();
+        try {
+            loadBatch(&_readAheadBatch);
+        } catch (...) {
+            _readAheadError = std::current_exception();
+        }
+        lockState->unsetThreadId();
+    });
+}
+
+void DocumentSourceCursor::joinReadAhead() {
+    _readAheadThread.join();
+    pExpCtx->opCtx->lockState()->updateThreadIdToCurrentThread();
+    pExpCtx->opCtxLent = false;
+}
+
+void DocumentSourceCursor::loadBatch(std::deque<Document>* batch) {
     if (!_exec || _exec->isDisposed()) {
         // No more documents.
         return;
@@ -99,9 +138,9 @@ void DocumentSourceCursor::loadBatch() {
 
             while ((state = _exec->getNext(&resultObj, nullptr)) == PlanExecutor::ADVANCED) {
                 if (_shouldProduceEmptyDocs) {
-                    _currentBatch.push_back(Document());
+                    batch->push_back(Document());
                 } else {
-                    _currentBatch.push_back(transformBSONObjToDocument(resultObj));
+                    batch->push_back(transformBSONObjToDocument(resultObj));
                 }
 
                 if (_limit) {
@@ -111,7 +150,7 @@ void DocumentSourceCursor::loadBatch() {
                     verify(_docsAddedToBatches < _limit->getLimit());
                 }
 
-                memUsageBytes += _currentBatch.back().getApproximateSize();
+                memUsageBytes += batch->back().getApproximateSize();
 
                 // As long as we're waiting for inserts, we shouldn't do any batching at this level
                 // we need the whole pipeline to see each document to see if we should stop waiting.
@@ -211,6 +250,9 @@ Value DocumentSourceCursor::serialize(boost::optional<ExplainOptions::Verbosity>
     if (!_projection.isEmpty())
         out["fields"] = Value(_projection);
 
+    if (_aggProjection)
+        out["projection"] = Value(_aggProjection->getProjectionSpec());
+
     BSONObjBuilder explainStatsBuilder;
 
     {
@@ -241,7 +283,20 @@ Value DocumentSourceCursor::serialize(boost::optional<ExplainOptions::Verbosity>
     return Value(DOC(getSourceName() << out.freezeToValue()));
 }
 
+size_t DocumentSourceCursor::getMemUsage() const {
+    size_t memUsage = _exec ? _exec->getRootStage()->getMemUsage() : 0;
+    for (auto&& batch : {&_currentBatch, &_readAheadBatch}) {
+        for (auto&& doc : *batch) {
+            memUsage += doc.getApproximateSize();
+        }
+    }
+    return memUsage;
+}
+
 void DocumentSourceCursor::detachFromOperationContext() {
+    if (_readAheadThread.joinable()) {
+        joinReadAhead();
+    }
     if (_exec && !_exec->isDetached()) {
         _exec->detachFromOperationContext();
     }
@@ -254,6 +309,12 @@ void DocumentSourceCursor::reattachToOperationContext(OperationContext* opCtx) {
 }
 
 void DocumentSourceCursor::doDispose() {
+    if (_readAheadThread.joinable()) {
+        // Any error hit while reading ahead no longer matters.
+        joinReadAhead();
+        _readAheadError = nullptr;
+    }
+    _readAheadBatch.clear();
     _currentBatch.clear();
     if (!_exec || _exec->isDisposed()) {
         // We've already properly disposed of our PlanExecutor.
@@ -300,6 +361,7 @@ void DocumentSourceCursor::cleanupExecutor(const AutoGetCollectionForRead& readL
 }
 
 DocumentSourceCursor::~DocumentSourceCursor() {
+    invariant(!_readAheadThread.joinable());  // Joined by dispose() before destruction.
     if (pExpCtx->explain) {
         invariant(_exec->isDisposed());  // _exec should have at least been disposed.
     } else {
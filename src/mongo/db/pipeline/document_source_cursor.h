@@ -29,14 +29,17 @@
 #pragma once
 
 #include <deque>
+#include <exception>
 
 #include "mongo/db/db_raii.h"
+#include "mongo/db/exec/projection_exec_agg.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/query/explain_options.h"
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/stdx/thread.h"
 
 namespace mongo {
 
@@ -72,6 +75,8 @@ public:
 
     void reattachToOperationContext(OperationContext* opCtx) final;
 
+    size_t getMemUsage() const final;
+
     /**
      * Create a document source based on a passed-in PlanExecutor. 'exec' must be a yielding
      * PlanExecutor, and must be registered with the associated collection's CursorManager.
@@ -122,6 +127,14 @@ public:
         _dependencies = deps;
     }
 
+    /**
+     * Applies 'projection', taken from a $project stage which followed this cursor, to each BSON
+     * document returned by the query system before it is converted to a Document.
+     */
+    void setAggregationProjection(std::unique_ptr<ProjectionExecAgg> projection) {
+        _aggProjection = std::move(projection);
+    }
+
     /**
      * Returns the limit associated with this cursor, or -1 if there is no limit.
      */
@@ -152,6 +165,16 @@ public:
         return _planSummaryStats;
     }
 
+    /**
+     * Loads each batch after the first on a separate thread while the previous one is consumed,
+     * overlapping the storage reads with the work of the later stages. The OperationContext is
+     * handed to that thread for as long as a batch loads, so this may only be enabled when nothing
+     * else uses the OperationContext until this stage reaches EOF or is disposed.
+     */
+    void enableReadAhead() {
+        _readAhead = true;
+    }
+
 protected:
     DocumentSourceCursor(Collection* collection,
                          std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec,
@@ -192,22 +215,42 @@ private:
     void cleanupExecutor(const AutoGetCollectionForRead& readLock);
 
     /**
-     * Reads a batch of data from '_exec'. Subclasses can specify custom behavior to be performed on
-     * each document by overloading transformBSONObjToDocument().
+     * Reads a batch of data from '_exec' into 'batch'. Subclasses can specify custom behavior to be
+     * performed on each document by overloading transformBSONObjToDocument().
+     */
+    void loadBatch(std::deque<Document>* batch);
+
+    /**
+     * Lends the OperationContext to '_readAheadThread', which loads the next batch into
+     * '_readAheadBatch'.
      */
-    void loadBatch();
+    void startReadAhead();
+
+    /**
+     * Waits for '_readAheadThread' to finish and takes back the OperationContext. Any error hit
+     * while reading ahead is left in '_readAheadError'.
+     */
+    void joinReadAhead();
 
     void recordPlanSummaryStats();
 
     // Batches results returned from the underlying PlanExecutor.
     std::deque<Document> _currentBatch;
 
+    // If '_readAhead' is set, the batch after '_currentBatch' is loaded into '_readAheadBatch' on
+    // '_readAheadThread', which owns the OperationContext until it is joined.
+    bool _readAhead = false;
+    stdx::thread _readAheadThread;
+    std::deque<Document> _readAheadBatch;
+    std::exception_ptr _readAheadError;
+
     // BSONObj members must outlive _projection and cursor.
     BSONObj _query;
     BSONObj _sort;
     BSONObj _projection;
     bool _shouldProduceEmptyDocs = false;
     boost::optional<ParsedDeps> _dependencies;
+    std::unique_ptr<ProjectionExecAgg> _aggProjection;
     boost::intrusive_ptr<DocumentSourceLimit> _limit;
     long long _docsAddedToBatches;  // for _limit enforcement
 
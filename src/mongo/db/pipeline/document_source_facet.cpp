@@ -30,13 +30,17 @@
 
 #include "mongo/db/pipeline/document_source_facet.h"
 
+#include <algorithm>
+#include <exception>
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/bsontypes.h"
+#include "mongo/db/operation_context.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/document_source_tee_consumer.h"
 #include "mongo/db/pipeline/expression_context.h"
@@ -44,9 +48,12 @@
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/tee_buffer.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -176,16 +183,21 @@ DocumentSource::GetNextResult DocumentSourceFacet::getNext() {
     }
 
     vector<vector<Value>> results(_facets.size());
-    bool allPipelinesEOF = false;
-    while (!allPipelinesEOF) {
-        allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
-        for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
-            const auto& pipeline = _facets[facetId].pipeline;
-            auto next = pipeline->getSources().back()->getNext();
-            for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
-                results[facetId].emplace_back(next.releaseDocument());
+    const size_t numThreads = computeNumThreads();
+    if (numThreads > 1) {
+        runFacetsInParallel(numThreads, &results);
+    } else {
+        bool allPipelinesEOF = false;
+        while (!allPipelinesEOF) {
+            allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
+            for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+                const auto& pipeline = _facets[facetId].pipeline;
+                auto next = pipeline->getSources().back()->getNext();
+                for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+                    results[facetId].emplace_back(next.releaseDocument());
+                }
+                allPipelinesEOF = allPipelinesEOF && next.isEOF();
             }
-            allPipelinesEOF = allPipelinesEOF && next.isEOF();
         }
     }
 
@@ -198,6 +210,121 @@ DocumentSource::GetNextResult DocumentSourceFacet::getNext() {
     return resultDoc.freeze();
 }
 
+size_t DocumentSourceFacet::computeNumThreads() const {
+    const size_t maxThreads = internalQueryFacetMaxThreads.load();
+    if (maxThreads <= 1 || _facets.size() <= 1) {
+        return 1;
+    }
+
+    // Comparisons under a collation go through ICU, which we do not share between threads.
+    if (pExpCtx->getCollator()) {
+        return 1;
+    }
+
+    // These stages only evaluate expressions over their input. Any other stage, $lookup for
+    // instance, may need the OperationContext, which only this thread may use.
+    static const std::set<StringData> kThreadSafeStages = {"$addFields"_sd,
+                                                           "$bucketAuto"_sd,
+                                                           "$group"_sd,
+                                                           "$limit"_sd,
+                                                           "$match"_sd,
+                                                           "$project"_sd,
+                                                           "$replaceRoot"_sd,
+                                                           "$skip"_sd,
+                                                           "$sort"_sd,
+                                                           "$unwind"_sd};
+    std::vector<Value> specs;
+    for (auto&& facet : _facets) {
+        for (auto&& source : facet.pipeline->getSources()) {
+            if (dynamic_cast<DocumentSourceTeeConsumer*>(source.get())) {
+                continue;
+            }
+            if (!kThreadSafeStages.count(source->getSourceName())) {
+                return 1;
+            }
+            source->serializeToArray(specs);
+        }
+    }
+
+    // Expressions which bind variables store them in the shared ExpressionContext as they
+    // evaluate, so they cannot be evaluated on several threads at once.
+    static const std::set<StringData> kVariableBindingExpressions = {
+        "$filter"_sd, "$let"_sd, "$map"_sd, "$reduce"_sd};
+    while (!specs.empty()) {
+        Value spec = std::move(specs.back());
+        specs.pop_back();
+        if (spec.getType() == BSONType::Object) {
+            for (auto it = spec.getDocument().fieldIterator(); it.more();) {
+                auto field = it.next();
+                if (kVariableBindingExpressions.count(field.first)) {
+                    return 1;
+                }
+                specs.push_back(field.second);
+            }
+        } else if (spec.getType() == BSONType::Array) {
+            for (auto&& element : spec.getArray()) {
+                specs.push_back(element);
+            }
+        }
+    }
+
+    return std::min(maxThreads, _facets.size());
+}
+
+void DocumentSourceFacet::runFacetsInParallel(size_t numThreads,
+                                              std::vector<std::vector<Value>>* results) {
+    // Runs the facets assigned to thread 'threadId' until each has consumed the current batch,
+    // and records which of them are done.
+    std::vector<char> pipelineEOF(_facets.size(), false);
+    auto runFacets = [this, numThreads, results, &pipelineEOF](size_t threadId) {
+        for (size_t facetId = threadId; facetId < _facets.size(); facetId += numThreads) {
+            if (pipelineEOF[facetId]) {
+                continue;
+            }
+            const auto& pipeline = _facets[facetId].pipeline;
+            auto next = pipeline->getSources().back()->getNext();
+            for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+                (*results)[facetId].emplace_back(next.releaseDocument());
+            }
+            pipelineEOF[facetId] = next.isEOF();
+        }
+    };
+
+    // The batches are loaded on this thread, which owns the OperationContext, and handed to the
+    // other threads one at a time, so that the TeeBuffer bounds how much input is held at once.
+    _teeBuffer->setConcurrentConsumers(true);
+    ON_BLOCK_EXIT([this] { _teeBuffer->setConcurrentConsumers(false); });
+    while (!std::all_of(pipelineEOF.begin(), pipelineEOF.end(), [](char eof) { return eof; })) {
+        pExpCtx->opCtx->checkForInterrupt();
+        _teeBuffer->loadNextBatchForConcurrentConsumers();
+
+        std::vector<std::exception_ptr> errors(numThreads);
+        std::vector<stdx::thread> threads;
+        for (size_t threadId = 1; threadId < numThreads; ++threadId) {
+            threads.emplace_back([&runFacets, &errors, threadId] {
+                try {
+                    runFacets(threadId);
+                } catch (...) {
+                    errors[threadId] = std::current_exception();
+                }
+            });
+        }
+        try {
+            runFacets(0);
+        } catch (...) {
+            errors[0] = std::current_exception();
+        }
+        for (auto&& thread : threads) {
+            thread.join();
+        }
+        for (auto&& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+}
+
 Value DocumentSourceFacet::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument serialized;
     for (auto&& facet : _facets) {
@@ -151,6 +151,20 @@ private:
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
 
+    /**
+     * Returns how many threads getNext() may run the sub-pipelines on: 1 unless the server
+     * parameter allows more and every stage of every sub-pipeline only computes on its input,
+     * without using the OperationContext or binding variables in the shared ExpressionContext.
+     */
+    size_t computeNumThreads() const;
+
+    /**
+     * Runs the sub-pipelines to completion on 'numThreads' threads, each of which drives its share
+     * of the facets through every batch the TeeBuffer loads on this thread, and adds the results of
+     * facet i to '(*results)[i]'.
+     */
+    void runFacetsInParallel(size_t numThreads, std::vector<std::vector<Value>>* results);
+
     boost::intrusive_ptr<TeeBuffer> _teeBuffer;
     std::vector<FacetPipeline> _facets;
 
@@ -43,6 +43,7 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_skip.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 
@@ -385,6 +386,98 @@ TEST_F(DocumentSourceFacetTest,
     ASSERT(facetStage->getNext().isEOF());
 }
 
+/**
+ * Lets a $facet running while it is in scope use 'maxThreads' threads, and makes its TeeBuffer hold
+ * one document at a time so that the sub-pipelines run over many batches.
+ */
+class ParallelFacets {
+public:
+    explicit ParallelFacets(int maxThreads)
+        : _oldMaxThreads(internalQueryFacetMaxThreads.load()),
+          _oldBufferSizeBytes(internalQueryFacetBufferSizeBytes.load()) {
+        internalQueryFacetMaxThreads.store(maxThreads);
+        internalQueryFacetBufferSizeBytes.store(1);
+    }
+
+    ~ParallelFacets() {
+        internalQueryFacetMaxThreads.store(_oldMaxThreads);
+        internalQueryFacetBufferSizeBytes.store(_oldBufferSizeBytes);
+    }
+
+private:
+    const int _oldMaxThreads;
+    const int _oldBufferSizeBytes;
+};
+
+TEST_F(DocumentSourceFacetTest, ShouldProduceTheSameResultsWhenRunningFacetsInParallel) {
+    auto ctx = getExpCtx();
+    const auto spec = fromjson(
+        "{$facet: {"
+        "  top: [{$sort: {a: -1}}, {$limit: 3}],"
+        "  total: [{$group: {_id: null, sum: {$sum: '$a'}, max: {$max: '$b.c'}}}],"
+        "  first: [{$limit: 2}, {$project: {_id: 0, b: 1}}],"
+        "  matched: [{$match: {a: {$gte: 25}}}, {$unwind: '$d'}, {$skip: 1}]"
+        "}}");
+
+    auto runFacet = [&](int maxThreads) {
+        ParallelFacets parallelFacets(maxThreads);
+        deque<DocumentSource::GetNextResult> inputs;
+        for (int i = 0; i < 50; ++i) {
+            // Documents read from a cursor load their fields lazily, so every facet thread reads
+            // the same lazily-created documents.
+            inputs.emplace_back(Document::fromBsonWithMetaData(
+                BSON("_id" << i << "a" << i << "b" << BSON("c" << i % 7) << "d"
+                           << BSON_ARRAY(i << i + 1))));
+        }
+        auto mock = DocumentSourceMock::create(inputs);
+        auto facetStage = DocumentSourceFacet::createFromBson(spec.firstElement(), ctx);
+        facetStage->setSource(mock.get());
+
+        auto output = facetStage->getNext();
+        ASSERT(output.isAdvanced());
+        ASSERT(facetStage->getNext().isEOF());
+        facetStage->dispose();
+        ASSERT_TRUE(mock->isDisposed);
+        return output.releaseDocument();
+    };
+
+    const auto expected = runFacet(1);
+    ASSERT_EQ(expected["top"].getArrayLength(), 3UL);
+    ASSERT_VALUE_EQ(expected["total"][0]["sum"], Value(1225));
+    ASSERT_DOCUMENT_EQ(runFacet(2), expected);
+    ASSERT_DOCUMENT_EQ(runFacet(4), expected);
+}
+
+TEST_F(DocumentSourceFacetTest, ShouldDisposeSourceOnceEveryParallelFacetIsDone) {
+    ParallelFacets parallelFacets(2);
+    auto ctx = getExpCtx();
+
+    deque<DocumentSource::GetNextResult> inputs = {
+        Document{{"_id", 0}}, Document{{"_id", 1}}, Document{{"_id", 2}}, Document{{"_id", 3}}};
+    auto mock = DocumentSourceMock::create(inputs);
+
+    auto firstPipe =
+        uassertStatusOK(Pipeline::createFacetPipeline({DocumentSourceLimit::create(ctx, 1)}, ctx));
+    auto secondPipe =
+        uassertStatusOK(Pipeline::createFacetPipeline({DocumentSourceLimit::create(ctx, 2)}, ctx));
+
+    std::vector<DocumentSourceFacet::FacetPipeline> facets;
+    facets.emplace_back("first", std::move(firstPipe));
+    facets.emplace_back("second", std::move(secondPipe));
+    auto facetStage = DocumentSourceFacet::create(std::move(facets), ctx);
+
+    facetStage->setSource(mock.get());
+
+    auto output = facetStage->getNext();
+    ASSERT(output.isAdvanced());
+    ASSERT_DOCUMENT_EQ(output.getDocument(),
+                       Document(fromjson("{first: [{_id: 0}], second: [{_id: 0}, {_id: 1}]}")));
+
+    // Both limits were reached before the input was, so the source is released right away.
+    ASSERT_TRUE(mock->isDisposed);
+    ASSERT(facetStage->getNext().isEOF());
+}
+
 TEST_F(DocumentSourceFacetTest, ShouldBeAbleToEvaluateMultipleStagesWithinOneSubPipeline) {
     auto ctx = getExpCtx();
 
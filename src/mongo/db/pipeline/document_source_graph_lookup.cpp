@@ -39,6 +39,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/stdx/memory.h"
 
@@ -104,19 +105,16 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNext() {
     performSearch();
 
     std::vector<Value> results;
-    while (!_visited.empty()) {
+    while (hasMoreVisited()) {
         // Remove elements one at a time to avoid consuming more memory.
-        auto it = _visited.begin();
-        results.push_back(Value(it->second));
-        _visited.erase(it);
+        results.push_back(Value(popVisited()));
     }
 
     MutableDocument output(*_input);
     output.setNestedField(_as, Value(std::move(results)));
 
     _visitedUsageBytes = 0;
-
-    invariant(_visited.empty());
+    _visitedDocumentsUsageBytes = 0;
 
     return output.freeze();
 }
@@ -127,7 +125,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
     // If the unwind is not preserving empty arrays, we might have to process multiple inputs before
     // we get one that will produce an output.
     while (true) {
-        if (_visited.empty()) {
+        if (!hasMoreVisited()) {
             // No results are left for the current input, so we should move on to the next one and
             // perform a new search.
 
@@ -139,11 +137,12 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
             _input = input.releaseDocument();
             performSearch();
             _visitedUsageBytes = 0;
+            _visitedDocumentsUsageBytes = 0;
             _outputIndex = 0;
         }
         MutableDocument unwound(*_input);
 
-        if (_visited.empty()) {
+        if (!hasMoreVisited()) {
             if ((*_unwind)->preserveNullAndEmptyArrays()) {
                 // Since "preserveNullAndEmptyArrays" was specified, output a document even though
                 // we had no result.
@@ -157,13 +156,11 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
                 continue;
             }
         } else {
-            auto it = _visited.begin();
-            unwound.setNestedField(_as, Value(it->second));
+            unwound.setNestedField(_as, Value(popVisited()));
             if (indexPath) {
                 unwound.setNestedField(*indexPath, Value(_outputIndex));
                 ++_outputIndex;
             }
-            _visited.erase(it);
         }
 
         return unwound.freeze();
@@ -174,6 +171,29 @@ void DocumentSourceGraphLookUp::doDispose() {
     _cache.clear();
     _frontier.clear();
     _visited.clear();
+    _visitedDocuments.clear();
+    _visitedWriter.reset();
+    _spilledVisited.reset();
+}
+
+bool DocumentSourceGraphLookUp::hasMoreVisited() const {
+    return !_visitedDocuments.empty() || (_spilledVisited && _spilledVisited->more());
+}
+
+Document DocumentSourceGraphLookUp::popVisited() {
+    if (!_visitedDocuments.empty()) {
+        Document next = std::move(_visitedDocuments.front());
+        _visitedDocuments.pop_front();
+        return next;
+    }
+
+    invariant(_spilledVisited);
+    Document next = _spilledVisited->next().second;
+    if (!_spilledVisited->more()) {
+        // Release the file as soon as it has been read back.
+        _spilledVisited.reset();
+    }
+    return next;
 }
 
 void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
@@ -184,7 +204,7 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
         // Check whether each key in the frontier exists in the cache or needs to be queried.
         auto cached = pExpCtx->getDocumentComparator().makeUnorderedDocumentSet();
-        auto matchStage = makeMatchStageFromFrontier(&cached);
+        std::vector<Value> uncached = takeUncachedFrontier(&cached);
 
         ValueUnorderedSet queried = pExpCtx->getValueComparator().makeUnorderedValueSet();
         _frontier.swap(queried);
@@ -199,12 +219,17 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
             checkMemoryUsage();
         }
 
-        if (matchStage) {
-            // Query for all keys that were in the frontier and not in the cache, populating
-            // '_frontier' for the next iteration of search.
+        // Query for all keys that were in the frontier and not in the cache, populating
+        // '_frontier' for the next iteration of search. The keys are queried for in batches of
+        // consecutive values, so that each query scans a narrow range of the 'connectToField'
+        // index in order and stays well within the maximum size of a BSON object.
+        const size_t batchSize = internalDocumentSourceGraphLookupFrontierBatchSize.load();
+        for (auto batchBegin = uncached.cbegin(); batchBegin != uncached.cend();) {
+            const auto batchEnd =
+                batchBegin + std::min<size_t>(batchSize, uncached.cend() - batchBegin);
 
             // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-            _fromPipeline.back() = *matchStage;
+            _fromPipeline.back() = makeMatchStage(batchBegin, batchEnd);
             auto pipeline = uassertStatusOK(
                 pExpCtx->mongoProcessInterface->makePipeline(_fromPipeline, _fromExpCtx));
             while (auto next = pipeline->getNext()) {
@@ -220,6 +245,7 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
                 addToCache(std::move(*next), queried);
             }
             checkMemoryUsage();
+            batchBegin = batchEnd;
         }
 
         ++depth;
@@ -228,12 +254,20 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
     _frontier.clear();
     _frontierUsageBytes = 0;
+
+    // The '_id' values are only needed to de-duplicate the documents of this search.
+    _visited.clear();
+
+    if (_visitedWriter) {
+        _spilledVisited.reset(_visitedWriter->done());
+        _visitedWriter.reset();
+    }
 }
 
 bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long long depth) {
     auto id = result.getField("_id");
 
-    if (_visited.find(id) != _visited.end()) {
+    if (!_visited.insert(id).second) {
         // We've already seen this object, don't repeat any work.
         return false;
     }
@@ -255,11 +289,13 @@ bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long lo
             _frontierUsageBytes += nextFrontierValue.getApproximateSize();
         });
 
-    // Add the object to our '_visited' list and update the size of '_visited' appropriately.
-    _visitedUsageBytes += id.getApproximateSize();
-    _visitedUsageBytes += result.getApproximateSize();
+    // Add the object to our list of visited documents and update the size of '_visited'
+    // appropriately.
+    const size_t documentSize = result.getApproximateSize();
+    _visitedUsageBytes += id.getApproximateSize() + documentSize;
+    _visitedDocumentsUsageBytes += documentSize;
 
-    _visited[id] = std::move(result);
+    _visitedDocuments.push_back(std::move(result));
 
     // We inserted into _visited, so return true.
     return true;
@@ -280,8 +316,7 @@ void DocumentSourceGraphLookUp::addToCache(const Document& result,
         });
 }
 
-boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
-    DocumentUnorderedSet* cached) {
+std::vector<Value> DocumentSourceGraphLookUp::takeUncachedFrontier(DocumentUnorderedSet* cached) {
     // Add any cached values to 'cached' and remove them from '_frontier'.
     for (auto it = _frontier.begin(); it != _frontier.end();) {
         if (auto entry = _cache[*it]) {
@@ -298,6 +333,13 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
         }
     }
 
+    std::vector<Value> uncached(_frontier.begin(), _frontier.end());
+    std::sort(uncached.begin(), uncached.end(), pExpCtx->getValueComparator().getLessThan());
+    return uncached;
+}
+
+BSONObj DocumentSourceGraphLookUp::makeMatchStage(std::vector<Value>::const_iterator begin,
+                                                  std::vector<Value>::const_iterator end) const {
     // Create a query of the form {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]}.
     //
     // We wrap the query in a $match so that it can be parsed into a DocumentSourceMatch when
@@ -317,8 +359,8 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
                     BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
                     {
                         BSONArrayBuilder in(subObj.subarrayStart("$in"));
-                        for (auto&& value : _frontier) {
-                            in << value;
+                        for (auto it = begin; it != end; ++it) {
+                            in << *it;
                         }
                     }
                 }
@@ -326,7 +368,7 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
         }
     }
 
-    return _frontier.empty() ? boost::none : boost::optional<BSONObj>(match.obj());
+    return match.obj();
 }
 
 void DocumentSourceGraphLookUp::performSearch() {
@@ -388,13 +430,41 @@ BSONObjSet DocumentSourceGraphLookUp::getOutputSorts() {
 }
 
 void DocumentSourceGraphLookUp::checkMemoryUsage() {
-    // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
+    if ((_visitedUsageBytes + _frontierUsageBytes) >= _maxMemoryUsageBytes &&
+        pExpCtx->allowDiskUse && !pExpCtx->inMongos) {
+        spillVisited();
+    }
+
     uassert(40099,
             "$graphLookup reached maximum memory consumption",
             (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
     _cache.evictDownTo(_maxMemoryUsageBytes - _frontierUsageBytes - _visitedUsageBytes);
 }
 
+void DocumentSourceGraphLookUp::spillVisited() {
+    if (_visitedDocuments.empty()) {
+        return;
+    }
+
+    if (!_visitedWriter) {
+        _visitedWriter = stdx::make_unique<SortedFileWriter<Value, Document>>(
+            SortOptions().TempDir(pExpCtx->tempDir));
+        _numSpilled = 0;
+    }
+    _usedDisk = true;
+
+    // The documents are returned in no particular order, so they are keyed by when they were
+    // spilled, which keeps the file sorted.
+    while (!_visitedDocuments.empty()) {
+        _visitedWriter->addAlreadySorted(Value(_numSpilled++), _visitedDocuments.front());
+        _visitedDocuments.pop_front();
+    }
+
+    invariant(_visitedDocumentsUsageBytes <= _visitedUsageBytes);
+    _visitedUsageBytes -= _visitedDocumentsUsageBytes;
+    _visitedDocumentsUsageBytes = 0;
+}
+
 void DocumentSourceGraphLookUp::serializeToArray(
     std::vector<Value>& array, boost::optional<ExplainOptions::Verbosity> explain) const {
     // Serialize default options.
@@ -464,8 +534,9 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
       _additionalFilter(additionalFilter),
       _depthField(depthField),
       _maxDepth(maxDepth),
+      _maxMemoryUsageBytes(internalDocumentSourceGraphLookupMaxMemoryBytes.load()),
       _frontier(pExpCtx->getValueComparator().makeUnorderedValueSet()),
-      _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
+      _visited(ValueComparator::kInstance.makeUnorderedValueSet()),
       _cache(pExpCtx->getValueComparator()),
       _unwind(unwindSrc) {
     const auto& resolvedNamespace = pExpCtx->getResolvedNamespace(_from);
@@ -602,3 +673,6 @@ intrusive_ptr<DocumentSource> DocumentSourceGraphLookUp::createFromBson(
     return std::move(newSource);
 }
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
@@ -28,11 +28,14 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
 
@@ -57,7 +60,7 @@ public:
         StageConstraints constraints(StreamType::kStreaming,
                                      PositionRequirement::kNone,
                                      HostTypeRequirement::kPrimaryShard,
-                                     DiskUseRequirement::kNoDiskUse,
+                                     DiskUseRequirement::kWritesTmpData,
                                      FacetRequirement::kAllowed,
                                      TransactionRequirement::kAllowed);
 
@@ -74,6 +77,10 @@ public:
         collections->push_back(_from);
     }
 
+    bool usedDisk() final {
+        return _usedDisk;
+    }
+
     void detachFromOperationContext() final;
 
     void reattachToOperationContext(OperationContext* opCtx) final;
@@ -121,15 +128,20 @@ private:
     }
 
     /**
-     * Prepares the query to execute on the 'from' collection wrapped in a $match by using the
-     * contents of '_frontier'.
+     * Removes from '_frontier' every value found in '_cache', filling 'cached' with the documents
+     * retrieved from the cache.
      *
-     * Fills 'cached' with any values that were retrieved from the cache.
-     *
-     * Returns boost::none if no query is necessary, i.e., all values were retrieved from the cache.
-     * Otherwise, returns a query object.
+     * Returns the values which are not cached and still need to be queried for, sorted so that
+     * each batch of them covers a contiguous range of the 'connectToField' index.
      */
-    boost::optional<BSONObj> makeMatchStageFromFrontier(DocumentUnorderedSet* cached);
+    std::vector<Value> takeUncachedFrontier(DocumentUnorderedSet* cached);
+
+    /**
+     * Prepares the query to execute on the 'from' collection wrapped in a $match, looking for the
+     * values in the range ['begin', 'end').
+     */
+    BSONObj makeMatchStage(std::vector<Value>::const_iterator begin,
+                           std::vector<Value>::const_iterator end) const;
 
     /**
      * If we have internalized a $unwind, getNext() dispatches to this function.
@@ -156,11 +168,29 @@ private:
     void addToCache(const Document& result, const ValueUnorderedSet& queried);
 
     /**
-     * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, and then
-     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'.
+     * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, spilling
+     * the visited documents to disk first if allowed to, and then evict from '_cache' until this
+     * source is using less than '_maxMemoryUsageBytes'.
      */
     void checkMemoryUsage();
 
+    /**
+     * Writes the documents in '_visitedDocuments' to '_visitedWriter', leaving only their _ids in
+     * memory.
+     */
+    void spillVisited();
+
+    /**
+     * Returns whether any document found by the last search has yet to be returned.
+     */
+    bool hasMoreVisited() const;
+
+    /**
+     * Removes and returns the next document found by the last search, reading back the spilled
+     * ones once those in memory run out.
+     */
+    Document popVisited();
+
     /**
      * Process 'result', adding it to '_visited' with the given 'depth', and updating '_frontier'
      * with the object's 'connectTo' values.
@@ -186,19 +216,30 @@ private:
     // The aggregation pipeline to perform against the '_from' namespace.
     std::vector<BSONObj> _fromPipeline;
 
-    size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
+    size_t _maxMemoryUsageBytes;
 
-    // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'.
+    // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'. '_visitedUsageBytes'
+    // includes '_visitedDocumentsUsageBytes', which is released by spilling.
     size_t _visitedUsageBytes = 0;
+    size_t _visitedDocumentsUsageBytes = 0;
     size_t _frontierUsageBytes = 0;
 
     // Only used during the breadth-first search, tracks the set of values on the current frontier.
     ValueUnorderedSet _frontier;
 
-    // Tracks nodes that have been discovered for a given input. Keys are the '_id' value of the
-    // document from the foreign collection, value is the document itself.  The keys are compared
-    // using the simple collation.
-    ValueUnorderedMap<Document> _visited;
+    // Tracks the '_id' values of the nodes that have been discovered for a given input, to
+    // de-duplicate them during the search. The values are compared using the simple collation.
+    ValueUnorderedSet _visited;
+
+    // The documents discovered for a given input which are still in memory, in discovery order.
+    std::deque<Document> _visitedDocuments;
+
+    // When allowed to use disk, the discovered documents which did not fit in memory are written
+    // to '_visitedWriter' as the search goes, and read back from '_spilledVisited' once it is done.
+    std::unique_ptr<SortedFileWriter<Value, Document>> _visitedWriter;
+    std::unique_ptr<Sorter<Value, Document>::Iterator> _spilledVisited;
+    long long _numSpilled = 0;
+    bool _usedDisk = false;
 
     // Caches query results to avoid repeating any work. This structure is maintained across calls
     // to getNext().
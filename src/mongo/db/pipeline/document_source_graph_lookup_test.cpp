@@ -37,6 +37,8 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/db/pipeline/stub_mongo_process_interface.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/mongoutils/str.h"
@@ -65,6 +67,7 @@ public:
         const std::vector<BSONObj>& rawPipeline,
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         const MakePipelineOptions opts) final {
+        ++_numPipelinesMade;
         auto pipeline = Pipeline::parse(rawPipeline, expCtx);
         if (!pipeline.isOK()) {
             return pipeline.getStatus();
@@ -87,8 +90,49 @@ public:
         return Status::OK();
     }
 
+    int numPipelinesMade() const {
+        return _numPipelinesMade;
+    }
+
 private:
     std::deque<DocumentSource::GetNextResult> _results;
+    int _numPipelinesMade = 0;
+};
+
+/**
+ * Makes a $graphLookup query for at most 'batchSize' values at a time while it is in scope.
+ */
+class FrontierBatchSize {
+public:
+    explicit FrontierBatchSize(int batchSize)
+        : _oldBatchSize(internalDocumentSourceGraphLookupFrontierBatchSize.load()) {
+        internalDocumentSourceGraphLookupFrontierBatchSize.store(batchSize);
+    }
+
+    ~FrontierBatchSize() {
+        internalDocumentSourceGraphLookupFrontierBatchSize.store(_oldBatchSize);
+    }
+
+private:
+    const int _oldBatchSize;
+};
+
+/**
+ * Limits a $graphLookup created while it is in scope to 'maxMemoryBytes' of memory.
+ */
+class GraphLookUpMaxMemory {
+public:
+    explicit GraphLookUpMaxMemory(long long maxMemoryBytes)
+        : _oldMaxMemoryBytes(internalDocumentSourceGraphLookupMaxMemoryBytes.load()) {
+        internalDocumentSourceGraphLookupMaxMemoryBytes.store(maxMemoryBytes);
+    }
+
+    ~GraphLookUpMaxMemory() {
+        internalDocumentSourceGraphLookupMaxMemoryBytes.store(_oldMaxMemoryBytes);
+    }
+
+private:
+    const long long _oldMaxMemoryBytes;
 };
 
 TEST_F(DocumentSourceGraphLookUpTest,
@@ -615,5 +659,113 @@ TEST_F(DocumentSourceGraphLookUpTest, ShouldNotExpandArraysWithinArraysAtEndOfCo
     ASSERT(graphLookupStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceGraphLookUpTest, ShouldQueryForFrontierInBatches) {
+    FrontierBatchSize batchSize(1);
+    auto expCtx = getExpCtx();
+
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}, {"startVal", 0}}};
+    auto inputMock = DocumentSourceMock::create(std::move(inputs));
+
+    // The same graph as above, where the frontier after the first query is [1, 2, 3].
+    Document startDoc{{"_id", 0}, {"to", std::vector<Value>{Value(1), Value(2), Value(3)}}};
+    Document middle1{{"_id", 1}, {"to", 4}};
+    Document middle2{{"_id", 2}, {"to", 4}};
+    Document middle3{{"_id", 3}, {"to", 4}};
+    Document sinkDoc{{"_id", 4}};
+
+    std::deque<DocumentSource::GetNextResult> fromContents{Document(startDoc),
+                                                           Document(middle1),
+                                                           Document(middle2),
+                                                           Document(middle3),
+                                                           Document(sinkDoc)};
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespace_forTest(fromNs, {fromNs, std::vector<BSONObj>{}});
+    auto mongoProcessInterface = std::make_shared<MockMongoInterface>(std::move(fromContents));
+    expCtx->mongoProcessInterface = mongoProcessInterface;
+    auto graphLookupStage =
+        DocumentSourceGraphLookUp::create(expCtx,
+                                          fromNs,
+                                          "results",
+                                          "to",
+                                          "_id",
+                                          ExpressionFieldPath::create(expCtx, "startVal"),
+                                          boost::none,
+                                          boost::none,
+                                          boost::none,
+                                          boost::none);
+    graphLookupStage->setSource(inputMock.get());
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+
+    auto resultsArray = next.getDocument().getField("results").getArray();
+    ASSERT_EQ(5U, resultsArray.size());
+    ASSERT(arrayContains(expCtx, resultsArray, Value(startDoc)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(middle1)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(middle2)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(middle3)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(sinkDoc)));
+    ASSERT(graphLookupStage->getNext().isEOF());
+
+    // One query for each of 0, 1, 2, 3 and 4.
+    ASSERT_EQ(5, mongoProcessInterface->numPipelinesMade());
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldSpillVisitedDocumentsWhenAllowedToUseDisk) {
+    GraphLookUpMaxMemory maxMemory(2000);
+    auto expCtx = getExpCtx();
+    unittest::TempDir tempDir("DocumentSourceGraphLookUpTest");
+    expCtx->tempDir = tempDir.path();
+
+    // Make a chain 0 -> 1 -> ... -> 9 of documents which do not fit in memory together, although
+    // their _ids do.
+    const std::string padding(500, 'x');
+    std::deque<DocumentSource::GetNextResult> fromContents;
+    std::vector<Document> chain;
+    for (int i = 0; i < 10; ++i) {
+        chain.push_back(Document{{"_id", i}, {"to", i + 1}, {"padding", padding}});
+        fromContents.push_back(Document(chain.back()));
+    }
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespace_forTest(fromNs, {fromNs, std::vector<BSONObj>{}});
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(fromContents);
+
+    auto makeGraphLookup = [&] {
+        return DocumentSourceGraphLookUp::create(expCtx,
+                                                 fromNs,
+                                                 "results",
+                                                 "to",
+                                                 "_id",
+                                                 ExpressionFieldPath::create(expCtx, "startVal"),
+                                                 boost::none,
+                                                 boost::none,
+                                                 boost::none,
+                                                 boost::none);
+    };
+
+    // Without disk use, the search runs out of memory.
+    auto inputMock = DocumentSourceMock::create(Document{{"_id", 0}, {"startVal", 0}});
+    auto graphLookupStage = makeGraphLookup();
+    graphLookupStage->setSource(inputMock.get());
+    ASSERT_THROWS_CODE(graphLookupStage->getNext(), AssertionException, 40099);
+
+    expCtx->allowDiskUse = true;
+    inputMock = DocumentSourceMock::create(Document{{"_id", 0}, {"startVal", 0}});
+    graphLookupStage = makeGraphLookup();
+    graphLookupStage->setSource(inputMock.get());
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    auto resultsArray = next.getDocument().getField("results").getArray();
+    ASSERT_EQ(chain.size(), resultsArray.size());
+    for (auto&& doc : chain) {
+        ASSERT(arrayContains(expCtx, resultsArray, Value(doc)));
+    }
+    ASSERT(graphLookupStage->getNext().isEOF());
+    ASSERT_TRUE(graphLookupStage->usedDisk());
+}
+
 }  // namespace
 }  // namespace mongo
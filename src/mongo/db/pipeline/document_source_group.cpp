@@ -28,6 +28,10 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <exception>
+#include <set>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
@@ -38,7 +42,11 @@
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/stdx/functional.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -121,14 +129,20 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNext() {
         invariant(initializationResult.isEOF());
     }
 
+    if (_streaming) {
+        // A streaming $group resets its accumulators itself, since a group may still be in progress
+        // when the previous call returned to pause execution.
+        return getNextStreaming();
+    }
+
     for (auto&& accum : _currentAccumulators) {
         accum->reset();  // Prep accumulators for a new group.
     }
 
     if (_spilled) {
         return getNextSpilled();
-    } else if (_streaming) {
-        return getNextStreaming();
+    } else if (_partitioned) {
+        return getNextPartitioned();
     } else {
         return getNextStandard();
     }
@@ -140,22 +154,10 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
         return GetNextResult::makeEOF();
 
     _currentId = _firstPartOfNextGroup.first;
-    const size_t numAccumulators = _accumulatedFields.size();
     while (pExpCtx->getValueComparator().evaluate(_currentId == _firstPartOfNextGroup.first)) {
         // Inside of this loop, _firstPartOfNextGroup is the current data being processed.
         // At loop exit, it is the first value to be processed in the next group.
-        switch (numAccumulators) {  // mirrors switch in spill()
-            case 1:                 // Single accumulators serialize as a single Value.
-                _currentAccumulators[0]->process(_firstPartOfNextGroup.second, true);
-            case 0:  // No accumulators so no Values.
-                break;
-            default: {  // Multiple accumulators serialize as an array of Values.
-                const vector<Value>& accumulatorStates = _firstPartOfNextGroup.second.getArray();
-                for (size_t i = 0; i < numAccumulators; i++) {
-                    _currentAccumulators[i]->process(accumulatorStates[i], true);
-                }
-            }
-        }
+        mergeSpilledState(_firstPartOfNextGroup.second, &_currentAccumulators);
 
         if (!_sorterIterator->more()) {
             dispose();
@@ -181,42 +183,66 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     return std::move(out);
 }
 
-DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
-    // Streaming optimization is active.
-    if (!_firstDocOfNextGroup) {
-        auto nextInput = pSource->getNext();
-        if (!nextInput.isAdvanced()) {
-            return nextInput;
+DocumentSource::GetNextResult DocumentSourceGroup::getNextPartitioned() {
+    // Not streaming, and spilled to hash partitions.
+    while (groupsIterator == _groups->end()) {
+        if (_pendingPartitions.empty()) {
+            dispose();
+            return GetNextResult::makeEOF();
         }
-        _firstDocOfNextGroup = nextInput.releaseDocument();
+        regroupNextPartition();
     }
 
-    Value id;
-    do {
-        // Add to the current accumulator(s).
-        for (size_t i = 0; i < _currentAccumulators.size(); i++) {
-            _currentAccumulators[i]->process(
-                _accumulatedFields[i].expression->evaluate(*_firstDocOfNextGroup), _doingMerge);
+    Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge);
+    ++groupsIterator;
+    return std::move(out);
+}
+
+DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
+    // Streaming optimization is active. '_firstDocOfNextGroup', when set, is an input document that
+    // has not been added to any group yet, and '_groupInProgress' says whether '_currentId' and
+    // '_currentAccumulators' hold a group that has not been output yet.
+    while (true) {
+        if (_firstDocOfNextGroup) {
+            Value id = computeId(*_firstDocOfNextGroup);
+            boost::optional<Document> out;
+            if (_groupInProgress &&
+                !pExpCtx->getValueComparator().evaluate(_currentId == id)) {
+                out = makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
+                _groupInProgress = false;
+            }
+
+            if (!_groupInProgress) {
+                for (auto&& accum : _currentAccumulators) {
+                    accum->reset();  // Prep accumulators for a new group.
+                }
+                _currentId = std::move(id);
+                _groupInProgress = true;
+            }
+
+            // Add to the current accumulator(s).
+            for (size_t i = 0; i < _currentAccumulators.size(); i++) {
+                _currentAccumulators[i]->process(
+                    _accumulatedFields[i].expression->evaluate(*_firstDocOfNextGroup), _doingMerge);
+            }
+            _firstDocOfNextGroup = boost::none;
+
+            if (out) {
+                return std::move(*out);
+            }
         }
 
-        // Retrieve the next document.
         auto nextInput = pSource->getNext();
+        if (nextInput.isEOF() && _groupInProgress) {
+            // The input is exhausted, so the group in progress is complete.
+            _groupInProgress = false;
+            return makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
+        }
         if (!nextInput.isAdvanced()) {
             return nextInput;
         }
-
         _firstDocOfNextGroup = nextInput.releaseDocument();
-
-
-        // Compute the id. If it does not match _currentId, we will exit the loop, leaving
-        // _firstDocOfNextGroup set for the next time getNext() is called.
-        id = computeId(*_firstDocOfNextGroup);
-    } while (pExpCtx->getValueComparator().evaluate(_currentId == id));
-
-    Document out = makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
-    _currentId = std::move(id);
-
-    return std::move(out);
+    }
 }
 
 void DocumentSourceGroup::doDispose() {
@@ -228,6 +254,16 @@ void DocumentSourceGroup::doDispose() {
     groupsIterator = _groups->end();
 
     _firstDocOfNextGroup = boost::none;
+    _groupInProgress = false;
+
+    _parallelBatch.clear();
+    _partialGroups.clear();
+    _memoryUsageBytes = 0;
+    _partialMemoryUsageBytes.clear();
+
+    _partitionWriters.clear();
+    _partitionSizes.clear();
+    _pendingPartitions.clear();
 }
 
 intrusive_ptr<DocumentSource> DocumentSourceGroup::optimize() {
@@ -341,8 +377,10 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
       _inputSort(BSONObj()),
       _streaming(false),
       _initialized(false),
+      _inputSortedByIndex(false),
       _groups(pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()),
       _spilled(false),
+      _numSpillPartitions(internalDocumentSourceGroupSpillPartitions.load()),
       _allowDiskUse(pExpCtx->allowDiskUse && !pExpCtx->inMongos) {}
 
 void DocumentSourceGroup::addAccumulator(AccumulationStatement accumulationStatement) {
@@ -462,24 +500,37 @@ private:
     ValueComparator _valueComparator;
 };
 
-bool containsOnlyFieldPathsAndConstants(ExpressionObject* expressionObj) {
-    for (auto&& it : expressionObj->getChildExpressions()) {
-        const intrusive_ptr<Expression>& childExp = it.second;
-        if (dynamic_cast<ExpressionFieldPath*>(childExp.get())) {
-            continue;
-        } else if (dynamic_cast<ExpressionConstant*>(childExp.get())) {
-            continue;
-        } else if (auto expObj = dynamic_cast<ExpressionObject*>(childExp.get())) {
-            if (!containsOnlyFieldPathsAndConstants(expObj)) {
-                // A nested expression was not a FieldPath or a constant.
-                return false;
+/**
+ * Calls 'task(i)' for each i in [0, numThreads), running task 0 on this thread and the rest on
+ * their own threads. The first exception thrown by any task is rethrown once all have joined.
+ */
+void runOnThreads(size_t numThreads, const stdx::function<void(size_t)>& task) {
+    std::vector<std::exception_ptr> errors(numThreads);
+    std::vector<stdx::thread> threads;
+    for (size_t i = 1; i < numThreads; ++i) {
+        threads.emplace_back([&task, &errors, i] {
+            try {
+                task(i);
+            } catch (...) {
+                errors[i] = std::current_exception();
             }
-        } else {
-            // expressionObj was something other than a FieldPath, a constant, or a nested object.
-            return false;
+        });
+    }
+    if (numThreads > 0) {
+        try {
+            task(0);
+        } catch (...) {
+            errors[0] = std::current_exception();
+        }
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    for (auto&& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
         }
     }
-    return true;
 }
 
 void getFieldPathMap(ExpressionObject* expressionObj,
@@ -540,78 +591,42 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
             _currentAccumulators.push_back(accumulatedField.makeAccumulator(pExpCtx));
         }
 
-        // We only need to load the first document.
-        auto firstInput = pSource->getNext();
-        if (!firstInput.isAdvanced()) {
-            // Leave '_firstDocOfNextGroup' uninitialized and return.
-            return firstInput;
-        }
-        _firstDocOfNextGroup = firstInput.releaseDocument();
-
-        // Compute the _id value.
-        _currentId = computeId(*_firstDocOfNextGroup);
+        // The input is consumed one group at a time by getNextStreaming().
         _initialized = true;
         return DocumentSource::GetNextResult::makeEOF();
     }
 
 
-    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
-    GetNextResult input = pSource->getNext();
+    if (!_numGroupingThreads) {
+        _numGroupingThreads = computeNumGroupingThreads();
+    }
+
+    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'. When grouping in
+    // parallel, it only picks up where groupInParallel() left off, if that ran out of memory.
+    GetNextResult input = _numGroupingThreads > 1 ? groupInParallel() : pSource->getNext();
     for (; input.isAdvanced(); input = pSource->getNext()) {
         if (_memoryUsageBytes > _maxMemoryUsageBytes) {
             uassert(16945,
                     "Exceeded memory limit for $group, but didn't allow external sort."
                     " Pass allowDiskUse:true to opt in.",
                     _allowDiskUse);
-            _sortedFiles.push_back(spill());
+            spillGroups();
             _memoryUsageBytes = 0;
         }
 
         // We release the result document here so that it does not outlive the end of this loop
         // iteration. Not releasing could lead to an array copy when this group follows an unwind.
         auto rootDocument = input.releaseDocument();
-        Value id = computeId(rootDocument);
-
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<Accumulator>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
-
-        if (inserted) {
-            _memoryUsageBytes += id.getApproximateSize();
-
-            // Add the accumulators
-            group.reserve(numAccumulators);
-            for (auto&& accumulatedField : _accumulatedFields) {
-                group.push_back(accumulatedField.makeAccumulator(pExpCtx));
-            }
-        } else {
-            for (auto&& groupObj : group) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryUsageBytes -= groupObj->memUsageForSorter();
-            }
-        }
-
-        /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
-
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(_accumulatedFields[i].expression->evaluate(rootDocument),
-                              _doingMerge);
-
-            _memoryUsageBytes += group[i]->memUsageForSorter();
-        }
+        const bool inserted = accumulate(rootDocument, &*_groups, &_memoryUsageBytes);
 
         if (kDebugBuild && !storageGlobalParams.readOnly) {
             // In debug mode, spill every time we have a duplicate id to stress merge logic.
-            if (!inserted &&                 // is a dup
-                !pExpCtx->inMongos &&        // can't spill to disk in mongos
-                !_allowDiskUse &&            // don't change behavior when testing external sort
-                _sortedFiles.size() < 20) {  // don't open too many FDs
+            if (!inserted &&            // is a dup
+                !pExpCtx->inMongos &&   // can't spill to disk in mongos
+                !_allowDiskUse &&       // don't change behavior when testing external sort
+                _numSpills < 20) {      // don't open too many FDs
 
-                _sortedFiles.push_back(spill());
+                spillGroups();
             }
         }
     }
@@ -625,7 +640,12 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
         }
         case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
             // Do any final steps necessary to prepare to output results.
-            if (!_sortedFiles.empty()) {
+            if (!_partitionWriters.empty()) {
+                _partitioned = true;
+                spillToPartitions(_partitionLevel);
+                finishPartitions();
+                groupsIterator = _groups->end();
+            } else if (!_sortedFiles.empty()) {
                 _spilled = true;
                 if (!_groups->empty()) {
                     _sortedFiles.push_back(spill());
@@ -659,6 +679,192 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     MONGO_UNREACHABLE;
 }
 
+bool DocumentSourceGroup::accumulate(const Document& root,
+                                     GroupsMap* groups,
+                                     size_t* memoryUsageBytes) {
+    const size_t numAccumulators = _accumulatedFields.size();
+    Value id = computeId(root);
+
+    // Look for the _id value in the map. If it's not there, add a new entry with a blank
+    // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
+    // looking it up in 'groups' multiple times.
+    const size_t oldSize = groups->size();
+    vector<intrusive_ptr<Accumulator>>& group = (*groups)[id];
+    const bool inserted = groups->size() != oldSize;
+
+    if (inserted) {
+        *memoryUsageBytes += id.getApproximateSize();
+
+        // Add the accumulators
+        group.reserve(numAccumulators);
+        for (auto&& accumulatedField : _accumulatedFields) {
+            group.push_back(accumulatedField.makeAccumulator(pExpCtx));
+        }
+    } else {
+        for (auto&& groupObj : group) {
+            // subtract old mem usage. New usage added back after processing.
+            *memoryUsageBytes -= groupObj->memUsageForSorter();
+        }
+    }
+
+    /* tickle all the accumulators for the group we found */
+    dassert(numAccumulators == group.size());
+
+    for (size_t i = 0; i < numAccumulators; i++) {
+        group[i]->process(_accumulatedFields[i].expression->evaluate(root), _doingMerge);
+
+        *memoryUsageBytes += group[i]->memUsageForSorter();
+    }
+
+    return inserted;
+}
+
+size_t DocumentSourceGroup::computeNumGroupingThreads() const {
+    const size_t maxThreads = internalDocumentSourceGroupMaxThreads.load();
+    if (maxThreads <= 1) {
+        return 1;
+    }
+
+    // Comparisons under a collation go through ICU, which we do not share between threads.
+    if (pExpCtx->getCollator()) {
+        return 1;
+    }
+
+    // Each thread sees an arbitrary subset of every group, so only accumulators whose result does
+    // not depend on the order of their input can be split up and merged.
+    static const std::set<StringData> kOrderInsensitiveAccumulators = {"$addToSet"_sd,
+                                                                       "$avg"_sd,
+                                                                       "$max"_sd,
+                                                                       "$min"_sd,
+                                                                       "$stdDevPop"_sd,
+                                                                       "$stdDevSamp"_sd,
+                                                                       "$sum"_sd};
+    std::vector<Value> expressions;
+    for (auto&& accumulatedField : _accumulatedFields) {
+        if (!kOrderInsensitiveAccumulators.count(
+                accumulatedField.makeAccumulator(pExpCtx)->getOpName())) {
+            return 1;
+        }
+        expressions.push_back(accumulatedField.expression->serialize(false));
+    }
+    for (auto&& idExpression : _idExpressions) {
+        expressions.push_back(idExpression->serialize(false));
+    }
+
+    // Expressions which bind variables store them in the shared ExpressionContext as they
+    // evaluate, so they cannot be evaluated on several threads at once.
+    static const std::set<StringData> kVariableBindingExpressions = {
+        "$filter"_sd, "$let"_sd, "$map"_sd, "$reduce"_sd};
+    while (!expressions.empty()) {
+        Value expression = std::move(expressions.back());
+        expressions.pop_back();
+        if (expression.getType() == BSONType::Object) {
+            for (auto it = expression.getDocument().fieldIterator(); it.more();) {
+                auto field = it.next();
+                if (kVariableBindingExpressions.count(field.first)) {
+                    return 1;
+                }
+                expressions.push_back(field.second);
+            }
+        } else if (expression.getType() == BSONType::Array) {
+            for (auto&& element : expression.getArray()) {
+                expressions.push_back(element);
+            }
+        }
+    }
+
+    return maxThreads;
+}
+
+DocumentSource::GetNextResult DocumentSourceGroup::groupInParallel() {
+    // Each thread groups this many documents per batch, which keeps the cost of starting the
+    // threads small next to the work they do.
+    const size_t kDocumentsPerThread = 4 * 1024;
+    const size_t batchSize = _numGroupingThreads * kDocumentsPerThread;
+
+    while (_partialGroups.size() < _numGroupingThreads) {
+        _partialGroups.push_back(
+            pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>());
+        _partialMemoryUsageBytes.push_back(0);
+    }
+
+    while (true) {
+        auto input = pSource->getNext();
+        for (; input.isAdvanced() && _parallelBatch.size() + 1 < batchSize;
+             input = pSource->getNext()) {
+            _parallelBatch.push_back(input.releaseDocument());
+        }
+        if (input.isPaused()) {
+            return input;
+        }
+        if (input.isAdvanced()) {
+            _parallelBatch.push_back(input.releaseDocument());
+        }
+
+        // Thread 'i' groups the 'i'th slice of the batch into its own partial groups.
+        const size_t numThreads = std::min(
+            _numGroupingThreads,
+            (_parallelBatch.size() + kDocumentsPerThread - 1) / kDocumentsPerThread);
+        ON_BLOCK_EXIT([this] { _parallelBatch.clear(); });
+        if (numThreads > 1) {
+            // Documents created from BSON load their fields on first access, and the threads must
+            // only read the batch.
+            for (auto&& doc : _parallelBatch) {
+                doc.loadLazyFields();
+            }
+        }
+        runOnThreads(numThreads, [this, numThreads](size_t i) {
+            const size_t begin = _parallelBatch.size() * i / numThreads;
+            const size_t end = _parallelBatch.size() * (i + 1) / numThreads;
+            for (size_t doc = begin; doc < end; ++doc) {
+                accumulate(_parallelBatch[doc], &_partialGroups[i], &_partialMemoryUsageBytes[i]);
+            }
+        });
+
+        if (input.isEOF()) {
+            mergePartialGroups();
+            return input;
+        }
+
+        size_t memoryUsageBytes = 0;
+        for (auto&& partialMemoryUsageBytes : _partialMemoryUsageBytes) {
+            memoryUsageBytes += partialMemoryUsageBytes;
+        }
+        if (memoryUsageBytes > _maxMemoryUsageBytes) {
+            // Let the caller spill, or fail, as it would have without the extra threads.
+            mergePartialGroups();
+            _numGroupingThreads = 1;
+            return pSource->getNext();
+        }
+    }
+}
+
+void DocumentSourceGroup::mergePartialGroups() {
+    for (auto&& partialGroups : _partialGroups) {
+        for (auto&& partialGroup : partialGroups) {
+            const size_t oldSize = _groups->size();
+            Accumulators& group = (*_groups)[partialGroup.first];
+            if (_groups->size() != oldSize) {
+                group = std::move(partialGroup.second);
+                continue;
+            }
+            for (size_t i = 0; i < group.size(); ++i) {
+                group[i]->process(partialGroup.second[i]->getValue(true), true);
+            }
+        }
+    }
+    _partialGroups.clear();
+    _partialMemoryUsageBytes.clear();
+
+    _memoryUsageBytes = 0;
+    for (auto&& group : *_groups) {
+        _memoryUsageBytes += group.first.getApproximateSize();
+        for (auto&& accumulator : group.second) {
+            _memoryUsageBytes += accumulator->memUsageForSorter();
+        }
+    }
+}
+
 bool DocumentSourceGroup::usedDisk() {
     return _usedDisk;
 }
@@ -674,40 +880,167 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(pExpCtx->getValueComparator()));
 
     SortedFileWriter<Value, Value> writer(SortOptions().TempDir(pExpCtx->tempDir));
-    switch (_accumulatedFields.size()) {  // same as ptrs[i]->second.size() for all i.
-        case 0:                           // no values, essentially a distinct
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first, Value());
+    for (size_t i = 0; i < ptrs.size(); i++) {
+        writer.addAlreadySorted(ptrs[i]->first, getSpillableState(ptrs[i]->second));
+    }
+
+    _groups->clear();
+
+    return shared_ptr<Sorter<Value, Value>::Iterator>(writer.done());
+}
+
+void DocumentSourceGroup::spillGroups() {
+    ++_numSpills;
+    if (_numSpillPartitions) {
+        spillToPartitions(0);
+    } else {
+        _sortedFiles.push_back(spill());
+    }
+}
+
+void DocumentSourceGroup::spillToPartitions(size_t level) {
+    _usedDisk = true;
+    if (_partitionWriters.empty()) {
+        _partitionLevel = level;
+        for (size_t i = 0; i < _numSpillPartitions; i++) {
+            _partitionWriters.push_back(stdx::make_unique<SortedFileWriter<Value, Value>>(
+                SortOptions().TempDir(pExpCtx->tempDir)));
+            _partitionSizes.push_back(0);
+        }
+    }
+    invariant(_partitionLevel == level);
+
+    for (auto&& group : *_groups) {
+        // Each level seeds the hash differently, so that the groups of one partition spread out
+        // over all partitions of the next level.
+        size_t hash = level;
+        group.first.hash_combine(hash, pExpCtx->getCollator());
+        const size_t partition = hash % _numSpillPartitions;
+
+        _partitionWriters[partition]->addAlreadySorted(group.first,
+                                                       getSpillableState(group.second));
+        ++_partitionSizes[partition];
+    }
+
+    _groups->clear();
+}
+
+void DocumentSourceGroup::finishPartitions() {
+    for (size_t i = 0; i < _partitionWriters.size(); i++) {
+        // A file that was never written to cannot be read back, but has nothing to regroup anyway.
+        if (_partitionSizes[i]) {
+            _pendingPartitions.emplace_back(
+                std::unique_ptr<Sorter<Value, Value>::Iterator>(_partitionWriters[i]->done()),
+                _partitionLevel);
+        }
+    }
+    _partitionWriters.clear();
+    _partitionSizes.clear();
+}
+
+void DocumentSourceGroup::regroupNextPartition() {
+    // Past this depth, whatever still does not fit is most likely a handful of groups that are each
+    // too large on their own, so the partition is regrouped in memory regardless.
+    const size_t kMaxPartitionLevel = 4;
+
+    auto partition = std::move(_pendingPartitions.back().first);
+    const size_t level = _pendingPartitions.back().second;
+    _pendingPartitions.pop_back();
+
+    _groups->clear();
+    _memoryUsageBytes = 0;
+    while (partition->more()) {
+        if (_memoryUsageBytes > _maxMemoryUsageBytes && level < kMaxPartitionLevel) {
+            spillToPartitions(level + 1);
+            _memoryUsageBytes = 0;
+        }
+
+        auto spilledGroup = partition->next();
+        const size_t oldSize = _groups->size();
+        Accumulators& group = (*_groups)[spilledGroup.first];
+        if (_groups->size() != oldSize) {
+            _memoryUsageBytes += spilledGroup.first.getApproximateSize();
+            for (auto&& accumulatedField : _accumulatedFields) {
+                group.push_back(accumulatedField.makeAccumulator(pExpCtx));
             }
-            break;
+        } else {
+            for (auto&& accumulator : group) {
+                _memoryUsageBytes -= accumulator->memUsageForSorter();
+            }
+        }
+
+        mergeSpilledState(spilledGroup.second, &group);
+        for (auto&& accumulator : group) {
+            _memoryUsageBytes += accumulator->memUsageForSorter();
+        }
+    }
+
+    if (!_partitionWriters.empty()) {
+        spillToPartitions(level + 1);
+        finishPartitions();
+    }
+    groupsIterator = _groups->begin();
+}
+
+Value DocumentSourceGroup::getSpillableState(const Accumulators& group) const {
+    switch (group.size()) {
+        case 0:  // no values, essentially a distinct
+            return Value();
 
         case 1:  // just one value, use optimized serialization as single Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first,
-                                        ptrs[i]->second[0]->getValue(/*toBeMerged=*/true));
-            }
-            break;
+            return group[0]->getValue(/*toBeMerged=*/true);
 
-        default:  // multiple values, serialize as array-typed Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                vector<Value> accums;
-                for (size_t j = 0; j < ptrs[i]->second.size(); j++) {
-                    accums.push_back(ptrs[i]->second[j]->getValue(/*toBeMerged=*/true));
-                }
-                writer.addAlreadySorted(ptrs[i]->first, Value(std::move(accums)));
+        default: {  // multiple values, serialize as array-typed Value
+            vector<Value> accums;
+            for (auto&& accumulator : group) {
+                accums.push_back(accumulator->getValue(/*toBeMerged=*/true));
             }
+            return Value(std::move(accums));
+        }
+    }
+}
+
+void DocumentSourceGroup::mergeSpilledState(const Value& state, Accumulators* group) const {
+    switch (group->size()) {  // mirrors switch in getSpillableState()
+        case 0:               // No accumulators so no Values.
+            break;
+        case 1:  // Single accumulators serialize as a single Value.
+            (*group)[0]->process(state, true);
             break;
+        default: {  // Multiple accumulators serialize as an array of Values.
+            const vector<Value>& accumulatorStates = state.getArray();
+            for (size_t i = 0; i < group->size(); i++) {
+                (*group)[i]->process(accumulatorStates[i], true);
+            }
+        }
     }
+}
 
-    _groups->clear();
+boost::optional<BSONObj> DocumentSourceGroup::getStreamingInputSort() const {
+    if (!internalDocumentSourceGroupEnableStreaming.load() || _idExpressions.size() != 1) {
+        return boost::none;
+    }
 
-    return shared_ptr<Sorter<Value, Value>::Iterator>(writer.done());
+    // Only a single field path _id can stream. In a compound _id, a missing field and a null field
+    // produce different groups, but an index sorts the two together, so their documents would be
+    // interleaved in the input stream (SERVER-23318).
+    auto fieldPath = dynamic_cast<ExpressionFieldPath*>(_idExpressions[0].get());
+    if (!fieldPath) {
+        return boost::none;
+    }
+
+    DepsTracker deps(DepsTracker::MetadataAvailable::kNoMetadata);
+    fieldPath->addDependencies(&deps);
+    if (deps.needWholeDocument || deps.fields.size() != 1) {
+        // Grouping on $$ROOT or on a variable.
+        return boost::none;
+    }
+
+    return BSON(*deps.fields.begin() << 1);
 }
 
 boost::optional<BSONObj> DocumentSourceGroup::findRelevantInputSort() const {
-    if (true) {
-        // Until streaming $group correctly handles nullish values, the streaming behavior is
-        // disabled. See SERVER-23318.
+    if (!internalDocumentSourceGroupEnableStreaming.load()) {
         return boost::none;
     }
 
@@ -717,51 +1050,31 @@ boost::optional<BSONObj> DocumentSourceGroup::findRelevantInputSort() const {
         return boost::none;
     }
 
-    BSONObjSet sorts = pSource->getOutputSorts();
-
-    // 'sorts' is a BSONObjSet. We need to check if our group pattern is compatible with one of the
-    // input sort patterns.
-
-    // We will only attempt to take advantage of a sorted input stream if the _id given to the
-    // $group contained only FieldPaths or constants. Determine if this is the case, and extract
-    // those FieldPaths if it is.
-    DepsTracker deps(DepsTracker::MetadataAvailable::kNoMetadata);  // We don't support streaming
-                                                                    // based off a text score.
+    DepsTracker deps(DepsTracker::MetadataAvailable::kNoMetadata);
     for (auto&& exp : _idExpressions) {
-        if (dynamic_cast<ExpressionConstant*>(exp.get())) {
-            continue;
-        }
-        ExpressionObject* obj;
-        if ((obj = dynamic_cast<ExpressionObject*>(exp.get()))) {
-            // We can only perform an optimization if there are no operators in the _id expression.
-            if (!containsOnlyFieldPathsAndConstants(obj)) {
-                return boost::none;
-            }
-        } else if (!dynamic_cast<ExpressionFieldPath*>(exp.get())) {
-            return boost::none;
-        }
         exp->addDependencies(&deps);
     }
+    if (!deps.needWholeDocument && deps.fields.empty()) {
+        // Our _id field is constant, so we should stream, but the input sort we choose is
+        // irrelevant since we will output only one document.
+        return BSONObj();
+    }
 
-    if (deps.needWholeDocument) {
-        // We don't swap to streaming if we need the entire document, which is likely because of
-        // $$ROOT.
+    if (!_inputSortedByIndex) {
+        // Only a sort provided by an index scan is safe to stream from. A blocking sort orders an
+        // array by its smallest element, so documents with equal arrays need not be adjacent,
+        // whereas the query system never reports an index sort on a multikey field.
         return boost::none;
     }
 
-    if (deps.fields.empty()) {
-        // Our _id field is constant, so we should stream, but the input sort we choose is
-        // irrelevant since we will output only one document.
-        return BSONObj();
+    auto streamingSort = getStreamingInputSort();
+    if (!streamingSort) {
+        return boost::none;
     }
 
-    for (auto&& obj : sorts) {
-        // Note that a sort order of, e.g., {a: 1, b: 1, c: 1} allows us to do a non-blocking group
-        // for every permutation of group by (a, b, c), since we are guaranteed that documents with
-        // the same value of (a, b, c) will be consecutive in the input stream, no matter what our
-        // _id is.
-        auto fieldNames = obj.getFieldNames<std::set<std::string>>();
-        if (fieldNames == deps.fields) {
+    const StringData groupField = streamingSort->firstElementFieldName();
+    for (auto&& obj : pSource->getOutputSorts()) {
+        if (obj.nFields() == 1 && groupField == obj.firstElementFieldName()) {
             return obj;
         }
     }
@@ -791,9 +1104,7 @@ BSONObjSet DocumentSourceGroup::getOutputSorts() {
             if (auto obj = dynamic_cast<ExpressionFieldPath*>(_idExpressions[0].get())) {
                 FieldPath _idSort = obj->getFieldPath();
 
-                sortOrder.append(
-                    "_id",
-                    _inputSort.getIntField(_idSort.getFieldName(_idSort.getPathLength() - 1)));
+                sortOrder.append("_id", _inputSort.getIntField(_idSort.tail().fullPath()));
             }
         }
     } else if (_streaming) {
@@ -811,9 +1122,7 @@ BSONObjSet DocumentSourceGroup::getOutputSorts() {
                 // _id is an object containing a nested document, such as: {_id: {x: {y: "$b"}}}.
                 getFieldPathMap(obj, "_id." + _idFieldNames[i], &fieldMap);
             } else if (auto fieldPath = dynamic_cast<ExpressionFieldPath*>(exp.get())) {
-                FieldPath _idSort = fieldPath->getFieldPath();
-                fieldMap[_idSort.getFieldName(_idSort.getPathLength() - 1)] =
-                    "_id." + _idFieldNames[i];
+                fieldMap[fieldPath->getFieldPath().tail().fullPath()] = "_id." + _idFieldNames[i];
             }
         }
 
@@ -160,6 +160,10 @@ public:
      */
     bool usedDisk() final;
 
+    size_t getMemUsage() const final {
+        return _memoryUsageBytes;
+    }
+
     // Virtuals for NeedsMergerDocumentSource.
     boost::intrusive_ptr<DocumentSource> getShardSource() final;
     MergingLogic mergingLogic() final;
@@ -178,6 +182,21 @@ public:
     std::unique_ptr<GroupFromFirstDocumentTransformation> rewriteGroupAsTransformOnFirstDocument()
         const;
 
+    /**
+     * Returns the sort pattern, such as {a: 1}, which an index would have to provide on this
+     * stage's input for it to output each group as soon as its last document arrives rather than
+     * hashing the whole input. Returns boost::none if this $group cannot stream on a sorted input.
+     */
+    boost::optional<BSONObj> getStreamingInputSort() const;
+
+    /**
+     * Informs this stage that the sort orders reported by its source are provided by an index scan
+     * rather than by a blocking sort, which is what makes streaming over them safe.
+     */
+    void setInputSortedByIndex() {
+        _inputSortedByIndex = true;
+    }
+
 protected:
     void doDispose() final;
 
@@ -194,6 +213,12 @@ private:
     GetNextResult getNextSpilled();
     GetNextResult getNextStandard();
 
+    /**
+     * Like getNextStandard(), but once '_groups' is exhausted, regroups the next spilled hash
+     * partition into it, until no partitions remain.
+     */
+    GetNextResult getNextPartitioned();
+
     /**
      * Attempt to identify an input sort order that allows us to turn into a streaming $group. If we
      * find one, return it. Otherwise, return boost::none.
@@ -202,8 +227,8 @@ private:
 
     /**
      * Before returning anything, this source must prepare itself. In a streaming $group,
-     * initialize() requests the first document from the previous source, and uses it to prepare the
-     * accumulators. In an unsorted $group, initialize() exhausts the previous source before
+     * initialize() only prepares the accumulators, and the input is consumed as groups are
+     * requested. In an unsorted $group, initialize() exhausts the previous source before
      * returning. The '_initialized' boolean indicates that initialize() has finished.
      *
      * This method may not be able to finish initialization in a single call if 'pSource' returns a
@@ -212,6 +237,35 @@ private:
      */
     GetNextResult initialize();
 
+    /**
+     * Adds 'root' to its group in 'groups', creating the group if it is new, and adds to
+     * '*memoryUsageBytes' however much the groups grew. Returns true if a new group was created.
+     * This never modifies the stage itself, so several threads may call it at once as long as each
+     * passes its own 'groups'.
+     */
+    bool accumulate(const Document& root, GroupsMap* groups, size_t* memoryUsageBytes);
+
+    /**
+     * Returns how many threads initialize() may group on: 1 unless the server parameter allows
+     * more and every expression and accumulator of this stage can be evaluated concurrently and
+     * yields the same result whatever order its input arrives in.
+     */
+    size_t computeNumGroupingThreads() const;
+
+    /**
+     * Consumes 'pSource' in batches, grouping each batch on '_numGroupingThreads' threads into
+     * per-thread partial groups. These are merged into '_groups' once the input is exhausted, and
+     * the EOF is returned, or once they outgrow the memory limit, in which case grouping continues
+     * on the calling thread alone and the next input is returned. Pauses are propagated.
+     */
+    GetNextResult groupInParallel();
+
+    /**
+     * Merges '_partialGroups' into '_groups' through the accumulators' mergeable partial state, as
+     * a merging $group would, and recomputes '_memoryUsageBytes'.
+     */
+    void mergePartialGroups();
+
     /**
      * Spill groups map to disk and returns an iterator to the file. Note: Since a sorted $group
      * does not exhaust the previous stage before returning, and thus does not maintain as large a
@@ -219,6 +273,41 @@ private:
      */
     std::shared_ptr<Sorter<Value, Value>::Iterator> spill();
 
+    /**
+     * Spills '_groups' while consuming the input: as a sorted run with spill(), or into the hash
+     * partitions when '_numSpillPartitions' allows.
+     */
+    void spillGroups();
+
+    /**
+     * Appends each group in '_groups' to the partition file its _id hashes to at 'level', opening
+     * the partition files for that level if needed, and then clears '_groups'.
+     */
+    void spillToPartitions(size_t level);
+
+    /**
+     * Closes the open partition files, queueing the non-empty ones to be regrouped.
+     */
+    void finishPartitions();
+
+    /**
+     * Replaces '_groups' with the groups of the next queued partition. If those do not fit in
+     * memory, they are partitioned again with a different hash and the first of the resulting
+     * partitions is regrouped instead.
+     */
+    void regroupNextPartition();
+
+    /**
+     * Returns the mergeable state of 'group' in the form spill() writes it: nothing for no
+     * accumulators, a single Value for one, or an array of Values for several.
+     */
+    Value getSpillableState(const Accumulators& group) const;
+
+    /**
+     * Merges 'state', in the form returned by getSpillableState(), into 'group'.
+     */
+    void mergeSpilledState(const Value& state, Accumulators* group) const;
+
     Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
 
     /**
@@ -249,6 +338,11 @@ private:
     BSONObj _inputSort;
     bool _streaming;
     bool _initialized;
+    bool _inputSortedByIndex;
+
+    // Set while a streaming $group has accumulated into '_currentAccumulators' a group it has not
+    // yet output.
+    bool _groupInProgress = false;
 
     Value _currentId;
     Accumulators _currentAccumulators;
@@ -261,6 +355,26 @@ private:
     std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> _sortedFiles;
     bool _spilled;
 
+    // How many times the input has been spilled.
+    size_t _numSpills = 0;
+
+    // The number of hash partitions to spill to, or zero to spill sorted runs instead.
+    const size_t _numSpillPartitions;
+
+    // Set once the input has been consumed into hash partitions.
+    bool _partitioned = false;
+
+    // The partition files being written, for partitioning at '_partitionLevel', and how many
+    // groups each holds. These are only open while consuming the input or regrouping a partition.
+    std::vector<std::unique_ptr<SortedFileWriter<Value, Value>>> _partitionWriters;
+    std::vector<size_t> _partitionSizes;
+    size_t _partitionLevel = 0;
+
+    // Spilled partitions still to be regrouped, along with the level they were partitioned at. The
+    // back is regrouped next.
+    std::vector<std::pair<std::unique_ptr<Sorter<Value, Value>::Iterator>, size_t>>
+        _pendingPartitions;
+
     // Only used when '_spilled' is false.
     GroupsMap::iterator groupsIterator;
 
@@ -269,6 +383,16 @@ private:
     const bool _allowDiskUse;
 
     std::pair<Value, Value> _firstPartOfNextGroup;
+
+    // Zero until initialize() decides how many threads to group on.
+    size_t _numGroupingThreads = 0;
+
+    // Only used while grouping in parallel: input documents not yet grouped, and each thread's
+    // partial groups along with their approximate size.
+    std::vector<Document> _parallelBatch;
+    std::vector<GroupsMap> _partialGroups;
+    std::vector<size_t> _partialMemoryUsageBytes;
+
     // Only used when '_sorted' is true.
     boost::optional<Document> _firstDocOfNextGroup;
 };
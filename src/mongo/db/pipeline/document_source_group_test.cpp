@@ -47,6 +47,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
@@ -68,6 +69,246 @@ static const char* const ns = "unittests.document_source_group_tests";
 // This provides access to getExpCtx(), but we'll use a different name for this test suite.
 using DocumentSourceGroupTest = AggregationContextFixture;
 
+/**
+ * Turns on the streaming $group for as long as it is in scope.
+ */
+class StreamingGroupEnabled {
+public:
+    StreamingGroupEnabled() : _wasEnabled(internalDocumentSourceGroupEnableStreaming.load()) {
+        internalDocumentSourceGroupEnableStreaming.store(true);
+    }
+
+    ~StreamingGroupEnabled() {
+        internalDocumentSourceGroupEnableStreaming.store(_wasEnabled);
+    }
+
+private:
+    const bool _wasEnabled;
+};
+
+/**
+ * Lets a hashing $group use up to 'maxThreads' threads for as long as it is in scope.
+ */
+class GroupingThreads {
+public:
+    explicit GroupingThreads(int maxThreads)
+        : _oldMaxThreads(internalDocumentSourceGroupMaxThreads.load()) {
+        internalDocumentSourceGroupMaxThreads.store(maxThreads);
+    }
+
+    ~GroupingThreads() {
+        internalDocumentSourceGroupMaxThreads.store(_oldMaxThreads);
+    }
+
+private:
+    const int _oldMaxThreads;
+};
+
+/**
+ * Makes a $group created while it is in scope spill to 'numPartitions' hash partitions.
+ */
+class SpillPartitions {
+public:
+    explicit SpillPartitions(int numPartitions)
+        : _oldNumPartitions(internalDocumentSourceGroupSpillPartitions.load()) {
+        internalDocumentSourceGroupSpillPartitions.store(numPartitions);
+    }
+
+    ~SpillPartitions() {
+        internalDocumentSourceGroupSpillPartitions.store(_oldNumPartitions);
+    }
+
+private:
+    const int _oldNumPartitions;
+};
+
+TEST_F(DocumentSourceGroupTest, ShouldRegroupEachSpilledHashPartition) {
+    SpillPartitions spillPartitions(4);
+    auto expCtx = getExpCtx();
+
+    // Allow the $group stage to spill to disk.
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 1000;
+
+    VariablesParseState vps = expCtx->variablesParseState;
+    AccumulationStatement sumStatement{"sum",
+                                       ExpressionFieldPath::parse(expCtx, "$b", vps),
+                                       AccumulationStatement::getFactory("$sum")};
+    auto group = DocumentSourceGroup::create(expCtx,
+                                             ExpressionFieldPath::parse(expCtx, "$a", vps),
+                                             {sumStatement},
+                                             maxMemoryUsageBytes);
+
+    // Every group is seen twice, far enough apart that its two halves are spilled separately, and
+    // there are so many groups that each partition has to be partitioned again to fit.
+    const int kNumGroups = 1000;
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < kNumGroups; ++i) {
+            inputs.push_back(Document{{"a", i}, {"b", round + 1}});
+        }
+    }
+    auto mock = DocumentSourceMock::create(inputs);
+    group->setSource(mock.get());
+
+    stdx::unordered_set<int> idSet;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        ASSERT_EQ(doc["sum"].coerceToInt(), 3);
+        ASSERT_TRUE(idSet.insert(doc["_id"].coerceToInt()).second);
+    }
+    ASSERT_TRUE(group->getNext().isEOF());
+    ASSERT_TRUE(group->usedDisk());
+    ASSERT_EQ(idSet.size(), static_cast<size_t>(kNumGroups));
+
+    // Hash partitions do not come back in _id order.
+    ASSERT_EQ(group->getOutputSorts().size(), 0U);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldMergePartialGroupsBuiltInParallel) {
+    GroupingThreads groupingThreads(4);
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+    VariablesParseState vps = expCtx->variablesParseState;
+    AccumulationStatement sumStatement{"sum",
+                                       ExpressionFieldPath::parse(expCtx, "$b", vps),
+                                       AccumulationStatement::getFactory("$sum")};
+    AccumulationStatement maxStatement{"max",
+                                       ExpressionFieldPath::parse(expCtx, "$b", vps),
+                                       AccumulationStatement::getFactory("$max")};
+    auto group = DocumentSourceGroup::create(
+        expCtx, ExpressionFieldPath::parse(expCtx, "$a", vps), {sumStatement, maxStatement});
+
+    // Enough documents for several batches on every thread, with a pause in the middle of one.
+    const int kNumDocs = 50 * 1000;
+    const int kNumGroups = 7;
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < kNumDocs; ++i) {
+        if (i == kNumDocs / 3) {
+            inputs.push_back(DocumentSource::GetNextResult::makePauseExecution());
+        }
+        inputs.push_back(Document{{"a", i % kNumGroups}, {"b", i}});
+    }
+    auto mock = DocumentSourceMock::create(inputs);
+    group->setSource(mock.get());
+
+    ASSERT_TRUE(group->getNext().isPaused());
+
+    stdx::unordered_set<int> idSet;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        const int id = doc["_id"].coerceToInt();
+        idSet.insert(id);
+
+        long long expectedSum = 0;
+        int expectedMax = 0;
+        for (int b = id; b < kNumDocs; b += kNumGroups) {
+            expectedSum += b;
+            expectedMax = b;
+        }
+        ASSERT_EQ(doc["sum"].coerceToLong(), expectedSum);
+        ASSERT_EQ(doc["max"].coerceToInt(), expectedMax);
+    }
+    ASSERT_EQ(idSet.size(), static_cast<size_t>(kNumGroups));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldEnforceMemoryLimitWhenGroupingInParallel) {
+    GroupingThreads groupingThreads(4);
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+    const size_t maxMemoryUsageBytes = 1000;
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto group = DocumentSourceGroup::create(
+        expCtx, ExpressionFieldPath::parse(expCtx, "$a", vps), {}, maxMemoryUsageBytes);
+
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 50 * 1000; ++i) {
+        inputs.push_back(Document{{"a", i}});
+    }
+    auto mock = DocumentSourceMock::create(inputs);
+    group->setSource(mock.get());
+
+    ASSERT_THROWS_CODE(group->getNext(), AssertionException, 16945);
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingInputSortIsTheGroupedFieldPath) {
+    StreamingGroupEnabled streamingEnabled;
+    auto expCtx = getExpCtx();
+    VariablesParseState vps = expCtx->variablesParseState;
+
+    auto group =
+        DocumentSourceGroup::create(expCtx, ExpressionFieldPath::parse(expCtx, "$a.b", vps), {});
+    auto streamingSort = group->getStreamingInputSort();
+    ASSERT_TRUE(streamingSort);
+    ASSERT_BSONOBJ_EQ(*streamingSort, BSON("a.b" << 1));
+
+    // A compound _id cannot stream, since missing and null fields sort together in an index.
+    auto compoundGroup = DocumentSourceGroup::create(
+        expCtx,
+        Expression::parseObject(expCtx, fromjson("{x: '$a', y: '$b'}"), vps),
+        {});
+    ASSERT_FALSE(compoundGroup->getStreamingInputSort());
+
+    // Nor can any $group while the knob is off.
+    internalDocumentSourceGroupEnableStreaming.store(false);
+    ASSERT_FALSE(group->getStreamingInputSort());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldNotStreamUnlessInputIsSortedByAnIndex) {
+    StreamingGroupEnabled streamingEnabled;
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+    VariablesParseState vps = expCtx->variablesParseState;
+
+    auto group =
+        DocumentSourceGroup::create(expCtx, ExpressionFieldPath::parse(expCtx, "$a", vps), {});
+    auto mock = DocumentSourceMock::create({Document{{"a", 1}}, Document{{"a", 2}}});
+    mock->sorts = {BSON("a" << 1)};
+    group->setSource(mock.get());
+
+    ASSERT_TRUE(group->getNext().isAdvanced());
+    ASSERT_FALSE(group->isStreaming());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldBeAbleToPauseWhileStreaming) {
+    StreamingGroupEnabled streamingEnabled;
+    auto expCtx = getExpCtx();
+    VariablesParseState vps = expCtx->variablesParseState;
+    AccumulationStatement countStatement{"count",
+                                         ExpressionConstant::create(expCtx, Value(1)),
+                                         AccumulationStatement::getFactory("$sum")};
+    auto group = DocumentSourceGroup::create(
+        expCtx, ExpressionFieldPath::parse(expCtx, "$a", vps), {countStatement});
+    auto mock = DocumentSourceMock::create({Document{},
+                                            DocumentSource::GetNextResult::makePauseExecution(),
+                                            Document{{"a", BSONNULL}},
+                                            Document{{"a", 1}},
+                                            DocumentSource::GetNextResult::makePauseExecution(),
+                                            Document{{"a", 1}}});
+    mock->sorts = {BSON("a" << 1)};
+    group->setSource(mock.get());
+    group->setInputSortedByIndex();
+
+    // The pause arrives in the middle of the first group, which must pick up where it left off.
+    ASSERT_TRUE(group->getNext().isPaused());
+    ASSERT_TRUE(group->isStreaming());
+
+    // Missing and null values are grouped together under a null _id.
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", BSONNULL}, {"count", 2}}));
+
+    ASSERT_TRUE(group->getNext().isPaused());
+
+    // The last group is output once the input is exhausted.
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 1}, {"count", 2}}));
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldBeAbleToPauseLoading) {
     auto expCtx = getExpCtx();
     expCtx->inMongos = true;  // Disallow external sort.
@@ -812,12 +1053,14 @@ public:
 class StreamingOptimization : public Base {
 public:
     void _doTest() final {
+        StreamingGroupEnabled streamingEnabled;
         auto source = DocumentSourceMock::create({"{a: 0}", "{a: 0}", "{a: 1}", "{a: 1}"});
         source->sorts = {BSON("a" << 1)};
 
         createGroup(BSON("_id"
                          << "$a"));
         group()->setSource(source.get());
+        group()->setInputSortedByIndex();
 
         auto res = group()->getNext();
         ASSERT_TRUE(res.isAdvanced());
@@ -992,11 +1235,13 @@ public:
 class StreamingWithRootSubfield : public Base {
 public:
     void _doTest() final {
+        StreamingGroupEnabled streamingEnabled;
         auto source = DocumentSourceMock::create({"{a: 1}", "{a: 2}", "{a: 3}"});
         source->sorts = {BSON("a" << 1)};
 
         createGroup(fromjson("{_id: '$$ROOT.a'}"));
         group()->setSource(source.get());
+        group()->setInputSortedByIndex();
 
         group()->getNext();
         ASSERT_TRUE(group()->isStreaming());
@@ -1012,11 +1257,13 @@ public:
 class StreamingWithConstant : public Base {
 public:
     void _doTest() final {
+        StreamingGroupEnabled streamingEnabled;
         auto source = DocumentSourceMock::create({"{a: 1}", "{a: 2}", "{a: 3}"});
         source->sorts = {BSON("$a" << 1)};
 
         createGroup(fromjson("{_id: 1}"));
         group()->setSource(source.get());
+        group()->setInputSortedByIndex();
 
         group()->getNext();
         ASSERT_TRUE(group()->isStreaming());
@@ -1029,11 +1276,13 @@ public:
 class StreamingWithEmptyId : public Base {
 public:
     void _doTest() final {
+        StreamingGroupEnabled streamingEnabled;
         auto source = DocumentSourceMock::create({"{a: 1}", "{a: 2}", "{a: 3}"});
         source->sorts = {BSON("$a" << 1)};
 
         createGroup(fromjson("{_id: {}}"));
         group()->setSource(source.get());
+        group()->setInputSortedByIndex();
 
         group()->getNext();
         ASSERT_TRUE(group()->isStreaming());
@@ -1046,6 +1295,7 @@ public:
 class NoOptimizationIfMissingDoubleSort : public Base {
 public:
     void _doTest() final {
+        StreamingGroupEnabled streamingEnabled;
         auto source = DocumentSourceMock::create({"{a: 1}", "{a: 2}", "{a: 3}"});
         source->sorts = {BSON("a" << 1)};
 
@@ -1061,6 +1311,7 @@ public:
                     inShard,
                     inMongos);
         group()->setSource(source.get());
+        group()->setInputSortedByIndex();
 
         group()->getNext();
         ASSERT_FALSE(group()->isStreaming());
@@ -1073,6 +1324,7 @@ public:
 class NoOptimizationWithRawRoot : public Base {
 public:
     void _doTest() final {
+        StreamingGroupEnabled streamingEnabled;
         auto source = DocumentSourceMock::create({"{a: 1}", "{a: 2}", "{a: 3}"});
         source->sorts = {BSON("a" << 1)};
 
@@ -1088,6 +1340,7 @@ public:
                     inShard,
                     inMongos);
         group()->setSource(source.get());
+        group()->setInputSortedByIndex();
 
         group()->getNext();
         ASSERT_FALSE(group()->isStreaming());
@@ -1100,6 +1353,7 @@ public:
 class NoOptimizationIfUsingExpressions : public Base {
 public:
     void _doTest() final {
+        StreamingGroupEnabled streamingEnabled;
         auto source = DocumentSourceMock::create({"{a: 1, b: 1}", "{a: 2, b: 2}", "{a: 3, b: 1}"});
         source->sorts = {BSON("a" << 1 << "b" << 1)};
 
@@ -1110,6 +1364,7 @@ public:
 
         createGroup(fromjson("{_id: {$sum: ['$a', '$b']}}"), inShard, inMongos);
         group()->setSource(source.get());
+        group()->setInputSortedByIndex();
 
         group()->getNext();
         ASSERT_FALSE(group()->isStreaming());
@@ -1195,17 +1450,18 @@ public:
         add<Dependencies>();
         add<StringConstantIdAndAccumulatorExpressions>();
         add<ArrayConstantAccumulatorExpression>();
-#if 0
-        // Disabled tests until SERVER-23318 is implemented.
         add<StreamingOptimization>();
-        add<StreamingWithMultipleIdFields>();
         add<NoOptimizationIfMissingDoubleSort>();
         add<NoOptimizationWithRawRoot>();
         add<NoOptimizationIfUsingExpressions>();
-        add<StreamingWithMultipleLevels>();
         add<StreamingWithConstant>();
         add<StreamingWithEmptyId>();
         add<StreamingWithRootSubfield>();
+#if 0
+        // Disabled tests until a compound _id can stream without interleaving missing and null
+        // values (SERVER-23318).
+        add<StreamingWithMultipleIdFields>();
+        add<StreamingWithMultipleLevels>();
         add<StreamingWithConstantAndFieldPath>();
         add<StreamingWithFieldRepeated>();
 #endif
@@ -30,6 +30,8 @@
 
 #include "mongo/db/pipeline/document_source_lookup.h"
 
+#include <algorithm>
+
 #include "mongo/base/init.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
@@ -40,6 +42,7 @@
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/stringutils.h"
 
 namespace mongo {
 
@@ -246,7 +249,36 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
     // '_unwindSrc' would be non-null, and we would not have made it here.
     invariant(!_matchSrc);
 
+    std::vector<Value> results;
+    int objsize = 0;
+    auto addResult = [&](Document result) {
+        objsize += result.getApproximateSize();
+        uassert(4568,
+                str::stream() << "Total size of documents in " << _fromNs.coll()
+                              << " matching pipeline "
+                              << getUserPipelineDefinition()
+                              << " exceeds maximum document size",
+                objsize <= BSONObjMaxInternalSize);
+        results.emplace_back(std::move(result));
+    };
+
     if (!wasConstructedWithPipelineSyntax()) {
+        if (auto hashJoinMatches = findHashJoinMatches(inputDoc)) {
+            for (auto&& match : *hashJoinMatches) {
+                addResult(match);
+            }
+
+            MutableDocument output(std::move(inputDoc));
+            output.setNestedField(_as, Value(std::move(results)));
+            return output.freeze();
+        }
+
+        if (!mayHaveForeignMatches(inputDoc)) {
+            MutableDocument output(std::move(inputDoc));
+            output.setNestedField(_as, Value(std::vector<Value>()));
+            return output.freeze();
+        }
+
         auto matchStage =
             makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
         // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
@@ -255,17 +287,8 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
 
     auto pipeline = buildPipeline(inputDoc);
 
-    std::vector<Value> results;
-    int objsize = 0;
     while (auto result = pipeline->getNext()) {
-        objsize += result->getApproximateSize();
-        uassert(4568,
-                str::stream() << "Total size of documents in " << _fromNs.coll()
-                              << " matching pipeline "
-                              << getUserPipelineDefinition()
-                              << " exceeds maximum document size",
-                objsize <= BSONObjMaxInternalSize);
-        results.emplace_back(std::move(*result));
+        addResult(std::move(*result));
     }
     for (auto&& source : pipeline->getSources()) {
         if (source->usedDisk())
@@ -323,6 +346,178 @@ std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
     return pipeline;
 }
 
+const std::vector<Document>* DocumentSourceLookUp::findHashJoinMatches(
+    const Document& inputDoc) {
+    if (!_hashJoinTableInitialized) {
+        _hashJoinTableInitialized = true;
+        buildHashJoinTable();
+    }
+
+    if (!_hashJoinTable) {
+        return nullptr;
+    }
+
+    // Only a single local value equal to foreign values can be answered from the table. Missing,
+    // null and regex values, local arrays and multiple values along the path go through the
+    // foreign query instead, whose matching rules for them the table doesn't replicate.
+    boost::optional<Value> localValue;
+    bool canProbe = true;
+    document_path_support::visitAllValuesAtPath(
+        inputDoc, *_localField, [&](const Value& nextValue) {
+            canProbe = canProbe && !localValue;
+            localValue = nextValue;
+        });
+    if (!canProbe || !localValue) {
+        return nullptr;
+    }
+    switch (localValue->getType()) {
+        case BSONType::jstNULL:
+        case BSONType::Undefined:
+        case BSONType::Array:
+        case BSONType::RegEx:
+            return nullptr;
+        default:
+            break;
+    }
+
+    static const std::vector<Document> kNoMatches;
+    auto it = _hashJoinTable->find(*localValue);
+    return it == _hashJoinTable->end() ? &kNoMatches : &it->second;
+}
+
+void DocumentSourceLookUp::buildHashJoinTable() {
+    invariant(!wasConstructedWithPipelineSyntax());
+    const long long maxBytes = internalDocumentSourceLookupHashJoinMaxBytes.load();
+    if (maxBytes <= 0 || foreignFieldHasNumericComponent()) {
+        return;
+    }
+
+    // Read the whole foreign namespace through any view definition, which is everything in
+    // '_resolvedPipeline' but its trailing $match placeholder. A $match absorbed from after an
+    // absorbed $unwind doesn't depend on the local document, so it can be applied here.
+    std::vector<BSONObj> foreignPipeline(_resolvedPipeline.begin(), _resolvedPipeline.end() - 1);
+    if (_additionalFilter) {
+        foreignPipeline.push_back(BSON("$match" << *_additionalFilter));
+    }
+    auto pipeline =
+        uassertStatusOK(pExpCtx->mongoProcessInterface->makePipeline(foreignPipeline, _fromExpCtx));
+
+    const auto& comparator = pExpCtx->getValueComparator();
+    _hashJoinTable.emplace(comparator.makeUnorderedValueMap<std::vector<Document>>());
+    long long bytesUsed = 0;
+    std::vector<Value> keys;
+    while (auto foreignDoc = pipeline->getNext()) {
+        pExpCtx->checkForInterrupt();
+
+        // A document joins once for each distinct value of its foreign field, and is stored under
+        // each of them.
+        keys.clear();
+        document_path_support::visitAllValuesAtPath(
+            *foreignDoc, *_foreignField, [&](const Value& nextValue) {
+                auto equalsNext = [&](const Value& key) {
+                    return comparator.evaluate(key == nextValue);
+                };
+                if (std::none_of(keys.begin(), keys.end(), equalsNext)) {
+                    keys.push_back(nextValue);
+                }
+            });
+
+        for (auto&& key : keys) {
+            bytesUsed += key.getApproximateSize() + foreignDoc->getApproximateSize();
+            (*_hashJoinTable)[key].push_back(*foreignDoc);
+        }
+
+        if (bytesUsed > maxBytes) {
+            // Too big to hold in memory. Fall back to querying per local document.
+            _hashJoinTable = boost::none;
+            break;
+        }
+    }
+    _usedDisk = _usedDisk || pipeline->usedDisk();
+}
+
+bool DocumentSourceLookUp::foreignFieldHasNumericComponent() const {
+    // A numeric path component may be either a field name or an array position when the foreign
+    // query is matched, which values collected by visitAllValuesAtPath() do not account for.
+    for (size_t i = 0; i < _foreignField->getPathLength(); ++i) {
+        if (parseUnsignedBase10Integer(_foreignField->getFieldName(i))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool DocumentSourceLookUp::mayHaveForeignMatches(const Document& inputDoc) {
+    if (!_foreignValueFilterInitialized) {
+        _foreignValueFilterInitialized = true;
+        buildForeignValueFilter();
+    }
+
+    if (!_foreignValueFilter) {
+        return true;
+    }
+
+    // Missing and null local values match foreign documents which lack the field, and arrays and
+    // regular expressions have matching rules of their own, so be conservative with all of them.
+    bool sawValue = false;
+    bool mayMatch = false;
+    document_path_support::visitAllValuesAtPath(
+        inputDoc, *_localField, [&](const Value& nextValue) {
+            sawValue = true;
+            if (mayMatch) {
+                return;
+            }
+            switch (nextValue.getType()) {
+                case BSONType::jstNULL:
+                case BSONType::Undefined:
+                case BSONType::Array:
+                case BSONType::RegEx:
+                    mayMatch = true;
+                    break;
+                default:
+                    mayMatch = _foreignValueFilter->mayContain(nextValue);
+            }
+        });
+    return !sawValue || mayMatch;
+}
+
+void DocumentSourceLookUp::buildForeignValueFilter() {
+    invariant(!wasConstructedWithPipelineSyntax());
+    if (!internalDocumentSourceLookupUseForeignValueFilter.load()) {
+        return;
+    }
+
+    if (foreignFieldHasNumericComponent()) {
+        return;
+    }
+
+    // Read the foreign field from every document in the foreign namespace, through any view
+    // definition, which is everything in '_resolvedPipeline' but its trailing $match placeholder.
+    std::vector<BSONObj> valuesPipeline(_resolvedPipeline.begin(), _resolvedPipeline.end() - 1);
+    BSONObjBuilder projection;
+    if (_foreignField->getFieldName(0) != "_id") {
+        projection.append("_id", 0);
+    }
+    projection.append(_foreignField->fullPath(), 1);
+    valuesPipeline.push_back(BSON("$project" << projection.obj()));
+
+    auto pipeline =
+        uassertStatusOK(pExpCtx->mongoProcessInterface->makePipeline(valuesPipeline, _fromExpCtx));
+
+    _foreignValueFilter = stdx::make_unique<LookUpForeignValueFilter>(
+        pExpCtx->getValueComparator(),
+        internalDocumentSourceLookupForeignValueSetMaxBytes.load(),
+        internalDocumentSourceLookupForeignValueBloomFilterBytes.load());
+    while (auto foreignDoc = pipeline->getNext()) {
+        pExpCtx->checkForInterrupt();
+        document_path_support::visitAllValuesAtPath(
+            *foreignDoc, *_foreignField, [&](const Value& nextValue) {
+                _foreignValueFilter->insert(nextValue);
+            });
+    }
+    _usedDisk = _usedDisk || pipeline->usedDisk();
+}
+
 DocumentSource::GetModPathsReturn DocumentSourceLookUp::getModifiedPaths() const {
     std::set<std::string> modifiedPaths{_as.fullPath()};
     if (_unwindSrc) {
@@ -560,7 +755,7 @@ DocumentSource::GetNextResult DocumentSourceLookUp::unwindResult() {
     // Loop until we get a document that has at least one match.
     // Note we may return early from this loop if our source stage is exhausted or if the unwind
     // source was asked to return empty arrays and we get a document without a match.
-    while (!_pipeline || !_nextValue) {
+    while (!_nextValue) {
         auto nextInput = pSource->getNext();
         if (!nextInput.isAdvanced()) {
             return nextInput;
@@ -568,28 +763,45 @@ DocumentSource::GetNextResult DocumentSourceLookUp::unwindResult() {
 
         _input = nextInput.releaseDocument();
 
-        if (!wasConstructedWithPipelineSyntax()) {
-            BSONObj filter = _additionalFilter.value_or(BSONObj());
-            auto matchStage =
-                makeMatchStageFromInput(*_input, *_localField, _foreignField->fullPath(), filter);
-            // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
-            _resolvedPipeline.back() = matchStage;
-        }
+        _hashJoinMatches = wasConstructedWithPipelineSyntax() ? nullptr
+                                                              : findHashJoinMatches(*_input);
+        if (_hashJoinMatches) {
+            _hashJoinMatchPos = 0;
+        } else if (!wasConstructedWithPipelineSyntax() && !mayHaveForeignMatches(*_input)) {
+            if (_unwindSrc->preserveNullAndEmptyArrays()) {
+                MutableDocument output(std::move(*_input));
+                output.setNestedField(_as, Value());
+                if (indexPath) {
+                    output.setNestedField(*indexPath, Value(BSONNULL));
+                }
+                return output.freeze();
+            }
+            continue;
+        } else {
+            if (!wasConstructedWithPipelineSyntax()) {
+                BSONObj filter = _additionalFilter.value_or(BSONObj());
+                auto matchStage = makeMatchStageFromInput(
+                    *_input, *_localField, _foreignField->fullPath(), filter);
+                // We've already allocated space for the trailing $match stage in
+                // '_resolvedPipeline'.
+                _resolvedPipeline.back() = matchStage;
+            }
 
-        if (_pipeline) {
-            _usedDisk = _usedDisk || _pipeline->usedDisk();
-            _pipeline->dispose(pExpCtx->opCtx);
-        }
+            if (_pipeline) {
+                _usedDisk = _usedDisk || _pipeline->usedDisk();
+                _pipeline->dispose(pExpCtx->opCtx);
+            }
 
-        _pipeline = buildPipeline(*_input);
+            _pipeline = buildPipeline(*_input);
 
-        // The $lookup stage takes responsibility for disposing of its Pipeline, since it will
-        // potentially be used by multiple OperationContexts, and the $lookup stage is part of an
-        // outer Pipeline that will propagate dispose() calls before being destroyed.
-        _pipeline.get_deleter().dismissDisposal();
+            // The $lookup stage takes responsibility for disposing of its Pipeline, since it will
+            // potentially be used by multiple OperationContexts, and the $lookup stage is part of
+            // an outer Pipeline that will propagate dispose() calls before being destroyed.
+            _pipeline.get_deleter().dismissDisposal();
+        }
 
         _cursorIndex = 0;
-        _nextValue = _pipeline->getNext();
+        _nextValue = getNextUnwindValue();
 
         if (_unwindSrc->preserveNullAndEmptyArrays() && !_nextValue) {
             // There were no results for this cursor, but the $unwind was asked to preserve empty
@@ -607,7 +819,7 @@ DocumentSource::GetNextResult DocumentSourceLookUp::unwindResult() {
 
     invariant(bool(_input) && bool(_nextValue));
     auto currentValue = *_nextValue;
-    _nextValue = _pipeline->getNext();
+    _nextValue = getNextUnwindValue();
 
     // Move input document into output if this is the last or only result, otherwise perform a copy.
     MutableDocument output(_nextValue ? *_input : std::move(*_input));
@@ -621,6 +833,16 @@ DocumentSource::GetNextResult DocumentSourceLookUp::unwindResult() {
     return output.freeze();
 }
 
+boost::optional<Document> DocumentSourceLookUp::getNextUnwindValue() {
+    if (!_hashJoinMatches) {
+        return _pipeline->getNext();
+    }
+    if (_hashJoinMatchPos == _hashJoinMatches->size()) {
+        return boost::none;
+    }
+    return (*_hashJoinMatches)[_hashJoinMatchPos++];
+}
+
 void DocumentSourceLookUp::copyVariablesToExpCtx(const Variables& vars,
                                                  const VariablesParseState& vps,
                                                  ExpressionContext* expCtx) {
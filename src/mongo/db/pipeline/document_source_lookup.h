@@ -36,6 +36,7 @@
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
+#include "mongo/db/pipeline/lookup_foreign_value_filter.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
 #include "mongo/db/pipeline/value_comparator.h"
 
@@ -262,6 +263,43 @@ private:
      */
     std::unique_ptr<Pipeline, PipelineDeleter> buildPipeline(const Document& inputDoc);
 
+    /**
+     * For localField/foreignField syntax, returns the foreign documents matching 'inputDoc' from
+     * '_hashJoinTable', or null if they must be found by querying the foreign collection. On the
+     * first call, tries to build the table if internalDocumentSourceLookupHashJoinMaxBytes allows.
+     */
+    const std::vector<Document>* findHashJoinMatches(const Document& inputDoc);
+
+    /**
+     * Populates '_hashJoinTable' from a scan of the foreign collection, leaving it unset if the
+     * foreign documents don't fit within internalDocumentSourceLookupHashJoinMaxBytes.
+     */
+    void buildHashJoinTable();
+
+    /**
+     * Returns true if some component of '_foreignField' could be read as an array index.
+     */
+    bool foreignFieldHasNumericComponent() const;
+
+    /**
+     * Returns the next foreign document to unwind for '_input', from either '_hashJoinMatches' or
+     * '_pipeline'.
+     */
+    boost::optional<Document> getNextUnwindValue();
+
+    /**
+     * For localField/foreignField syntax, returns false if 'inputDoc' is known to have no matches
+     * in the foreign collection, so that the foreign query can be skipped. On the first call, reads
+     * every foreignField value from the foreign collection into '_foreignValueFilter' if
+     * internalDocumentSourceLookupUseForeignValueFilter is enabled.
+     */
+    bool mayHaveForeignMatches(const Document& inputDoc);
+
+    /**
+     * Populates '_foreignValueFilter' from a scan of the foreign collection.
+     */
+    void buildForeignValueFilter();
+
     /**
      * The pipeline supplied via the $lookup 'pipeline' argument. This may differ from pipeline that
      * is executed in that it will not include optimizations or resolved views.
@@ -317,6 +355,16 @@ private:
 
     std::vector<LetVariable> _letVariables;
 
+    // For localField/foreignField syntax, the set of foreignField values across the foreign
+    // collection. Null unless the filter is enabled and applicable to this $lookup.
+    std::unique_ptr<LookUpForeignValueFilter> _foreignValueFilter;
+    bool _foreignValueFilterInitialized = false;
+
+    // For localField/foreignField syntax, the foreign documents keyed by their foreignField values,
+    // when they fit in memory. Populated on the first call to getNext().
+    boost::optional<ValueUnorderedMap<std::vector<Document>>> _hashJoinTable;
+    bool _hashJoinTableInitialized = false;
+
     boost::intrusive_ptr<DocumentSourceMatch> _matchSrc;
     boost::intrusive_ptr<DocumentSourceUnwind> _unwindSrc;
 
@@ -324,6 +372,8 @@ private:
     // not null.
     long long _cursorIndex = 0;
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
+    const std::vector<Document>* _hashJoinMatches = nullptr;  // used instead of '_pipeline' if set
+    size_t _hashJoinMatchPos = 0;
     boost::optional<Document> _input;
     boost::optional<Document> _nextValue;
 };
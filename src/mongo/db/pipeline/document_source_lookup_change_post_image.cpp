@@ -115,6 +115,16 @@ Value DocumentSourceLookupChangePostImage::lookupPostImage(const Document& updat
                                         << resumeToken.getData().clusterTime))
         : boost::none;
     invariant(resumeToken.getData().uuid);
+
+    // If the collection records the images of its updates, return the document as of this update
+    // rather than its current version.
+    if (!pExpCtx->inMongos) {
+        if (auto images = pExpCtx->mongoProcessInterface->lookupChangeStreamImages(
+                pExpCtx, *resumeToken.getData().uuid, resumeToken.getData().clusterTime)) {
+            return Value(images->postImage);
+        }
+    }
+
     auto lookedUpDoc = pExpCtx->mongoProcessInterface->lookupSingleDocument(
         pExpCtx, nss, *resumeToken.getData().uuid, documentKey, readConcern);
 
@@ -35,6 +35,7 @@ namespace mongo {
 
 /**
  * Part of the change stream API machinery used to look up the post-image of a document. Uses the
+ * post-image recorded for the update if the collection records them, and otherwise the
  * "documentKey" field of the input to look up the new version of the document.
  */
 class DocumentSourceLookupChangePostImage final : public DocumentSource {
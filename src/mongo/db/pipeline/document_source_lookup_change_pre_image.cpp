@@ -0,0 +1,68 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_lookup_change_pre_image.h"
+
+#include "mongo/db/pipeline/resume_token.h"
+
+namespace mongo {
+
+constexpr StringData DocumentSourceLookupChangePreImage::kStageName;
+constexpr StringData DocumentSourceLookupChangePreImage::kFullDocumentBeforeChangeFieldName;
+
+DocumentSource::GetNextResult DocumentSourceLookupChangePreImage::getNext() {
+    pExpCtx->checkForInterrupt();
+
+    auto input = pSource->getNext();
+    if (!input.isAdvanced()) {
+        return input;
+    }
+    auto opTypeVal = input.getDocument()[DocumentSourceChangeStream::kOperationTypeField];
+    if (opTypeVal.getType() != BSONType::String ||
+        opTypeVal.getString() != DocumentSourceChangeStream::kUpdateOpType) {
+        return input;
+    }
+
+    MutableDocument output(input.releaseDocument());
+    output[kFullDocumentBeforeChangeFieldName] = lookupPreImage(output.peek());
+    return output.freeze();
+}
+
+Value DocumentSourceLookupChangePreImage::lookupPreImage(const Document& updateOp) const {
+    auto resumeToken =
+        ResumeToken::parse(updateOp[DocumentSourceChangeStream::kIdField].getDocument());
+    invariant(resumeToken.getData().uuid);
+
+    auto images = pExpCtx->mongoProcessInterface->lookupChangeStreamImages(
+        pExpCtx, *resumeToken.getData().uuid, resumeToken.getData().clusterTime);
+    return (images ? Value(images->preImage) : Value(BSONNULL));
+}
+
+}  // namespace mongo
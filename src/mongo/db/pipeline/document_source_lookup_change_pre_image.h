@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_change_stream.h"
+
+namespace mongo {
+
+/**
+ * Part of the change stream API machinery used to look up the pre-image of a document. Uses the
+ * resume token of an update event to find the version of the document before the update, which is
+ * only available if the collection records the images of its updates.
+ */
+class DocumentSourceLookupChangePreImage final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalLookupChangePreImage"_sd;
+    static constexpr StringData kFullDocumentBeforeChangeFieldName =
+        DocumentSourceChangeStream::kFullDocumentBeforeChangeField;
+
+    /**
+     * Creates a DocumentSourceLookupChangePreImage stage.
+     */
+    static boost::intrusive_ptr<DocumentSourceLookupChangePreImage> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+        return new DocumentSourceLookupChangePreImage(expCtx);
+    }
+
+    /**
+     * Only modifies a single path: "fullDocumentBeforeChange".
+     */
+    GetModPathsReturn getModifiedPaths() const final {
+        return {GetModPathsReturn::Type::kFiniteSet,
+                {kFullDocumentBeforeChangeFieldName.toString()},
+                {}};
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        invariant(pipeState != Pipeline::SplitState::kSplitForShards);
+        StageConstraints constraints(StreamType::kStreaming,
+                                     PositionRequirement::kNone,
+                                     // The images are only recorded on mongod, and this stage is
+                                     // never parsed on mongos.
+                                     HostTypeRequirement::kLocalOnly,
+                                     DiskUseRequirement::kNoDiskUse,
+                                     FacetRequirement::kNotAllowed,
+                                     TransactionRequirement::kNotAllowed,
+                                     ChangeStreamRequirement::kChangeStreamStage);
+
+        constraints.canSwapWithMatch = true;
+        return constraints;
+    }
+
+    DepsTracker::State getDependencies(DepsTracker* deps) const {
+        deps->fields.insert(DocumentSourceChangeStream::kOperationTypeField.toString());
+        deps->fields.insert(DocumentSourceChangeStream::kIdField.toString());
+        // This stage does not restrict the output fields to a finite set, and has no impact on
+        // whether metadata is available or needed.
+        return DepsTracker::State::SEE_NEXT;
+    }
+
+    /**
+     * Performs the lookup to retrieve the version of the document before the update.
+     */
+    GetNextResult getNext() final;
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final {
+        if (explain) {
+            return Value{Document{{kStageName, Document()}}};
+        }
+        return Value();  // Do not serialize this stage unless we're explaining.
+    }
+
+    const char* getSourceName() const final {
+        return kStageName.rawData();
+    }
+
+private:
+    DocumentSourceLookupChangePreImage(const boost::intrusive_ptr<ExpressionContext>& expCtx)
+        : DocumentSource(expCtx) {}
+
+    /**
+     * Uses the resume token of 'updateOp' to look up the recorded pre-image of the update. Returns
+     * Value(BSONNULL) if the collection does not record images or the image has expired.
+     */
+    Value lookupPreImage(const Document& updateOp) const;
+};
+
+}  // namespace mongo
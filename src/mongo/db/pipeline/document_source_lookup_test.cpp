@@ -47,6 +47,7 @@
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_options.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -546,6 +547,7 @@ public:
         const std::vector<BSONObj>& rawPipeline,
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         const MakePipelineOptions opts) final {
+        ++numPipelinesMade;
         auto pipeline = Pipeline::parse(rawPipeline, expCtx);
         if (!pipeline.isOK()) {
             return pipeline.getStatus();
@@ -576,6 +578,8 @@ public:
         return Status::OK();
     }
 
+    int numPipelinesMade = 0;
+
 private:
     deque<DocumentSource::GetNextResult> _mockResults;
     bool _removeLeadingQueryStages = false;
@@ -685,6 +689,131 @@ TEST_F(DocumentSourceLookUpTest, ShouldPropagatePausesWhileUnwinding) {
     lookup->dispose();
 }
 
+TEST_F(DocumentSourceLookUpTest, ForeignValueFilterSkipsQueriesForValuesWithNoMatch) {
+    const bool oldUseFilter = internalDocumentSourceLookupUseForeignValueFilter.load();
+    ON_BLOCK_EXIT([&] { internalDocumentSourceLookupUseForeignValueFilter.store(oldUseFilter); });
+    internalDocumentSourceLookupUseForeignValueFilter.store(true);
+
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespace_forTest(fromNs, {fromNs, std::vector<BSONObj>{}});
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "foreignId"_sd},
+                                         {"foreignField", "fid"_sd},
+                                         {"as", "foreignDocs"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource = DocumentSourceMock::create({Document{{"foreignId", 0}},
+                                                       Document{{"foreignId", 5}},
+                                                       Document{{"foreignId", 1.0}},
+                                                       Document{{"other", 1}}});
+    lookup->setSource(mockLocalSource.get());
+
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document{{"_id", 10}, {"fid", 0}}, Document{{"_id", 11}, {"fid", vector<Value>{Value(1)}}}};
+    auto mongoInterface = std::make_shared<MockMongoInterface>(std::move(mockForeignContents));
+    expCtx->mongoProcessInterface = mongoInterface;
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"foreignId", 0},
+                                 {"foreignDocs",
+                                  vector<Value>{Value(Document{{"_id", 10}, {"fid", 0}})}}}));
+
+    // No foreign document has the value 5, so it gets an empty result without a query.
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"foreignId", 5}, {"foreignDocs", vector<Value>{}}}));
+
+    // Matches the array element 1, with a numeric value of a different type.
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    const Document matchingForeignDoc{{"_id", 11}, {"fid", vector<Value>{Value(1)}}};
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        (Document{{"foreignId", 1.0}, {"foreignDocs", vector<Value>{Value(matchingForeignDoc)}}}));
+
+    // A missing local field is still looked up, since it matches foreign documents without 'fid'.
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_TRUE(lookup->getNext().isEOF());
+
+    // One pipeline to read the foreign values, then one for each document but the second.
+    ASSERT_EQ(mongoInterface->numPipelinesMade, 4);
+    lookup->dispose();
+}
+
+TEST_F(DocumentSourceLookUpTest, HashJoinAnswersScalarLocalValuesFromOneForeignScan) {
+    const long long oldMaxBytes = internalDocumentSourceLookupHashJoinMaxBytes.load();
+    ON_BLOCK_EXIT([&] { internalDocumentSourceLookupHashJoinMaxBytes.store(oldMaxBytes); });
+    internalDocumentSourceLookupHashJoinMaxBytes.store(1024 * 1024);
+
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespace_forTest(fromNs, {fromNs, std::vector<BSONObj>{}});
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "foreignId"_sd},
+                                         {"foreignField", "fid"_sd},
+                                         {"as", "foreignDocs"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource =
+        DocumentSourceMock::create({Document{{"foreignId", 0}},
+                                    Document{{"foreignId", 5}},
+                                    Document{{"foreignId", 1.0}},
+                                    Document{{"foreignId", vector<Value>{Value(0), Value(5)}}}});
+    lookup->setSource(mockLocalSource.get());
+
+    const Document foreignDoc0{{"_id", 10}, {"fid", 0}};
+    const Document foreignDoc1{{"_id", 11}, {"fid", vector<Value>{Value(1), Value(1)}}};
+    const Document foreignDoc2{{"_id", 12}, {"fid", 1}};
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document(foreignDoc0), Document(foreignDoc1), Document(foreignDoc2)};
+    auto mongoInterface = std::make_shared<MockMongoInterface>(std::move(mockForeignContents));
+    expCtx->mongoProcessInterface = mongoInterface;
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        (Document{{"foreignId", 0}, {"foreignDocs", vector<Value>{Value(foreignDoc0)}}}));
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"foreignId", 5}, {"foreignDocs", vector<Value>{}}}));
+
+    // A foreign document whose array repeats the value is only joined once.
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        (Document{{"foreignId", 1.0},
+                  {"foreignDocs", vector<Value>{Value(foreignDoc1), Value(foreignDoc2)}}}));
+
+    // A local array is looked up with a query instead.
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"foreignId", vector<Value>{Value(0), Value(5)}},
+                                 {"foreignDocs", vector<Value>{Value(foreignDoc0)}}}));
+    ASSERT_TRUE(lookup->getNext().isEOF());
+
+    // One pipeline to build the table, and one for the local array.
+    ASSERT_EQ(mongoInterface->numPipelinesMade, 2);
+    lookup->dispose();
+}
+
 TEST_F(DocumentSourceLookUpTest, LookupReportsAsFieldIsModified) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "foreign");
@@ -84,6 +84,11 @@ DocumentSource::GetNextResult DocumentSourceMatch::getNext() {
     // The user facing error should have been generated earlier.
     massert(17309, "Should never call getNext on a $match stage with $text clause", !_isTextQuery);
 
+    if (!_fieldPrefetchCompiled) {
+        _fieldPrefetch = TopLevelFieldPrefetch::compile(_expression.get());
+        _fieldPrefetchCompiled = true;
+    }
+
     auto nextInput = pSource->getNext();
     for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
         // MatchExpression only takes BSON documents, so we have to make one. As an optimization,
@@ -93,7 +98,7 @@ DocumentSource::GetNextResult DocumentSourceMatch::getNext() {
             : document_path_support::documentToBsonWithPaths(nextInput.getDocument(),
                                                              _dependencies.fields);
 
-        if (_expression->matchesBSON(toMatch)) {
+        if (TopLevelFieldPrefetch::matchesBSON(_expression.get(), toMatch, _fieldPrefetch.get())) {
             return nextInput;
         }
 
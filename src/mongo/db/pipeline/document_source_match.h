@@ -33,6 +33,7 @@
 
 #include "mongo/client/connpool.h"
 #include "mongo/db/matcher/matcher.h"
+#include "mongo/db/matcher/top_level_field_prefetch.h"
 #include "mongo/db/pipeline/document_source.h"
 
 namespace mongo {
@@ -172,6 +173,12 @@ private:
 
     // Cache the dependencies so that we know what fields we need to serialize to BSON for matching.
     DepsTracker _dependencies;
+
+    // Locates the fields read by '_expression' in one scan of each document. Compiled on the first
+    // call to getNext(), by which point optimization can no longer replace '_expression', and null
+    // if the expression reads fewer than two top-level fields.
+    std::unique_ptr<TopLevelFieldPrefetch> _fieldPrefetch;
+    bool _fieldPrefetchCompiled = false;
 };
 
 }  // namespace mongo
@@ -0,0 +1,77 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_op_samples.h"
+
+namespace mongo {
+
+constexpr StringData DocumentSourceOpSamples::kStageName;
+
+REGISTER_DOCUMENT_SOURCE(opSamples,
+                         DocumentSourceOpSamples::LiteParsed::parse,
+                         DocumentSourceOpSamples::createFromBson);
+
+boost::intrusive_ptr<DocumentSource> DocumentSourceOpSamples::createFromBson(
+    BSONElement spec, const boost::intrusive_ptr<ExpressionContext>& pExpCtx) {
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << kStageName << " parameters object must be empty. Found: "
+                          << spec.toString(),
+            spec.type() == BSONType::Object && spec.embeddedObject().isEmpty());
+
+    const NamespaceString& nss = pExpCtx->ns;
+    uassert(ErrorCodes::InvalidNamespace,
+            str::stream() << kStageName
+                          << " must be run against the 'admin' database with {aggregate: 1}",
+            nss.db() == NamespaceString::kAdminDb && nss.isCollectionlessAggregateNS());
+
+    uassert(ErrorCodes::IllegalOperation,
+            str::stream() << kStageName << " cannot be executed against a MongoS.",
+            !pExpCtx->inMongos && !pExpCtx->fromMongos && !pExpCtx->needsMerge);
+
+    return new DocumentSourceOpSamples(pExpCtx);
+}
+
+DocumentSource::GetNextResult DocumentSourceOpSamples::getNext() {
+    pExpCtx->checkForInterrupt();
+
+    if (!_haveRetrievedSamples) {
+        _samples = pExpCtx->mongoProcessInterface->getOpSamples(pExpCtx->opCtx);
+        _samplesIter = _samples.begin();
+        _haveRetrievedSamples = true;
+    }
+
+    if (_samplesIter == _samples.end()) {
+        return GetNextResult::makeEOF();
+    }
+
+    return Document{*_samplesIter++};
+}
+
+}  // namespace mongo
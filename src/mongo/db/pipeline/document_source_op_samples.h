@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/pipeline/document_source.h"
+
+namespace mongo {
+
+/**
+ * Produces the profiler entries held in the OpSampleBuffer of this mongod, oldest first. Must be
+ * run against the 'admin' database with {aggregate: 1}.
+ */
+class DocumentSourceOpSamples final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$opSamples"_sd;
+
+    class LiteParsed final : public LiteParsedDocumentSource {
+    public:
+        static std::unique_ptr<LiteParsed> parse(const AggregationRequest& request,
+                                                 const BSONElement& spec) {
+            return stdx::make_unique<LiteParsed>();
+        }
+
+        stdx::unordered_set<NamespaceString> getInvolvedNamespaces() const final {
+            return stdx::unordered_set<NamespaceString>();
+        }
+
+        PrivilegeVector requiredPrivileges(bool isMongos) const final {
+            return {Privilege(ResourcePattern::forClusterResource(), ActionType::inprog)};
+        }
+
+        bool isInitialSource() const final {
+            return true;
+        }
+
+        bool allowedToForwardFromMongos() const final {
+            // $opSamples must be run locally on a mongod.
+            return false;
+        }
+
+        bool allowedToPassthroughFromMongos() const final {
+            // $opSamples must be run locally on a mongod.
+            return false;
+        }
+
+        void assertSupportsReadConcern(const repl::ReadConcernArgs& readConcern) const {
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream() << "Aggregation stage " << kStageName
+                                  << " requires read concern local but found "
+                                  << readConcern.toString(),
+                    readConcern.getLevel() == repl::ReadConcernLevel::kLocalReadConcern);
+        }
+    };
+
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement spec, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
+
+    GetNextResult getNext() final;
+
+    const char* getSourceName() const final {
+        return kStageName.rawData();
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        StageConstraints constraints(StreamType::kStreaming,
+                                     PositionRequirement::kFirst,
+                                     HostTypeRequirement::kAnyShard,
+                                     DiskUseRequirement::kNoDiskUse,
+                                     FacetRequirement::kNotAllowed,
+                                     TransactionRequirement::kNotAllowed);
+
+        constraints.isIndependentOfAnyCollection = true;
+        constraints.requiresInputDocSource = false;
+        return constraints;
+    }
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final {
+        return Value(Document{{kStageName, Document{}}});
+    }
+
+private:
+    DocumentSourceOpSamples(const boost::intrusive_ptr<ExpressionContext>& pExpCtx)
+        : DocumentSource(pExpCtx) {}
+
+    // The samples are copied out of the buffer on the first call to getNext(), so that the
+    // stage returns a consistent set even as new samples are recorded.
+    std::vector<BSONObj> _samples;
+    bool _haveRetrievedSamples = false;
+    std::vector<BSONObj>::iterator _samplesIter;
+};
+
+}  // namespace mongo
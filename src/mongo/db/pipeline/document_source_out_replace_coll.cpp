@@ -74,27 +74,29 @@ void DocumentSourceOutReplaceColl::initializeWriteNs() {
                 conn->runCommand(outputNs.db().toString(), cmd.done(), info));
     }
 
-    if (_originalIndexes.empty()) {
-        return;
-    }
-
-    // Copy the indexes of the output collection to the temp collection.
-    std::vector<BSONObj> tempNsIndexes;
+    // Prepare copies of the indexes of the output collection for the temp collection. They are
+    // only built once all of the documents have been inserted, so that each index is bulk built
+    // from its sorted keys instead of being updated on every insert.
     for (const auto& indexSpec : _originalIndexes) {
         // Replace the spec's 'ns' field value, which is the original collection, with the temp
         // collection.
-        tempNsIndexes.push_back(indexSpec.addField(BSON("ns" << _tempNs.ns()).firstElement()));
-    }
-    try {
-        conn->createIndexes(_tempNs.ns(), tempNsIndexes);
-    } catch (DBException& ex) {
-        ex.addContext("Copying indexes for $out failed");
-        throw;
+        _tempNsIndexes.push_back(indexSpec.addField(BSON("ns" << _tempNs.ns()).firstElement()));
     }
 };
 
 void DocumentSourceOutReplaceColl::finalize() {
     const auto& outputNs = getOutputNs();
+
+    if (!_tempNsIndexes.empty()) {
+        try {
+            pExpCtx->mongoProcessInterface->directClient()->createIndexes(_tempNs.ns(),
+                                                                          _tempNsIndexes);
+        } catch (DBException& ex) {
+            ex.addContext("Copying indexes for $out failed");
+            throw;
+        }
+    }
+
     auto renameCommandObj =
         BSON("renameCollection" << _tempNs.ns() << "to" << outputNs.ns() << "dropTarget" << true);
 
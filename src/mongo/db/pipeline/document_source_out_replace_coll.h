@@ -52,14 +52,14 @@ public:
     }
 
     /**
-     * Sets up a temp collection which contains the same indexes and options as the output
-     * collection. All writes will be directed to the temp collection.
+     * Sets up a temp collection which contains the same options as the output collection. All
+     * writes will be directed to the temp collection.
      */
     void initializeWriteNs() final;
 
     /**
-     * Renames the temp collection to the output collection with the 'dropTarget' option set to
-     * true.
+     * Builds the indexes of the output collection on the temp collection, then renames the temp
+     * collection to the output collection with the 'dropTarget' option set to true.
      */
     void finalize() final;
 
@@ -75,6 +75,9 @@ private:
 
     // The temporary namespace for the $out writes.
     NamespaceString _tempNs;
+
+    // The index specs of the output collection, rewritten for the temp collection.
+    std::vector<BSONObj> _tempNsIndexes;
 };
 
 }  // namespace mongo
@@ -77,13 +77,14 @@ double smallestFromSampleOfUniform(PseudoRandom* prng, size_t N) {
 DocumentSource::GetNextResult DocumentSourceSampleFromRandomCursor::getNext() {
     pExpCtx->checkForInterrupt();
 
-    if (_seenDocs.size() >= static_cast<size_t>(_size))
+    if (_nReturned >= _size)
         return GetNextResult::makeEOF();
 
-    auto nextResult = getNextNonDuplicateDocument();
+    auto nextResult = _idField.empty() ? pSource->getNext() : getNextNonDuplicateDocument();
     if (!nextResult.isAdvanced()) {
         return nextResult;
     }
+    ++_nReturned;
 
     // Assign it a random value to enable merging by random value, attempting to avoid bias in that
     // process.
@@ -149,7 +150,9 @@ Value DocumentSourceSampleFromRandomCursor::serialize(
 }
 
 DepsTracker::State DocumentSourceSampleFromRandomCursor::getDependencies(DepsTracker* deps) const {
-    deps->fields.insert(_idField);
+    if (!_idField.empty()) {
+        deps->fields.insert(_idField);
+    }
     return DepsTracker::State::SEE_NEXT;
 }
 
@@ -35,7 +35,8 @@ namespace mongo {
 
 /**
  * This class is not a registered stage, it is only used as an optimized replacement for $sample
- * when the storage engine allows us to use a random cursor.
+ * when the storage engine allows us to use a random cursor, or when the input is already a sample
+ * of the collection drawn without replacement.
  */
 class DocumentSourceSampleFromRandomCursor final : public DocumentSource {
 public:
@@ -53,6 +54,10 @@ public:
                 TransactionRequirement::kAllowed};
     }
 
+    /**
+     * An empty 'idField' indicates that the input never returns the same document twice, so
+     * documents are passed through without being de-duplicated.
+     */
     static boost::intrusive_ptr<DocumentSourceSampleFromRandomCursor> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         long long size,
@@ -74,13 +79,17 @@ private:
 
     long long _size;
 
-    // The field to use as the id of a document. Usually '_id', but 'ts' for the oplog.
+    // The field to use as the id of a document. Usually '_id', but 'ts' for the oplog. Empty if the
+    // input cannot produce duplicates.
     std::string _idField;
 
     // Keeps track of the documents that have been returned, since a random cursor is allowed to
     // return duplicates.
     ValueUnorderedSet _seenDocs;
 
+    // The number of documents returned so far.
+    long long _nReturned = 0;
+
     // The approximate number of documents in the collection (includes orphans).
     const long long _nDocsInColl;
 
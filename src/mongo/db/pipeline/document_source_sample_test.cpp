@@ -352,6 +352,29 @@ TEST_F(SampleFromRandomCursorBasics, MissingIdField) {
     ASSERT_THROWS_CODE(sample()->getNext(), AssertionException, 28793);
 }
 
+/**
+ * Without an id field, the $sampleFromRandomCursor stage trusts its input not to contain duplicate
+ * documents, so it neither drops repeated _ids nor requires an _id at all.
+ */
+TEST_F(SampleFromRandomCursorBasics, NoDeduplicationWithoutIdField) {
+    _sample = DocumentSourceSampleFromRandomCursor::create(getExpCtx(), 3, "", 100);
+    sample()->setSource(_mock.get());
+    source()->queue.push_back(DOC("_id" << 1));
+    source()->queue.push_back(DOC("_id" << 1));
+    source()->queue.push_back(DOC("non_id" << 2));
+    source()->queue.push_back(DOC("_id" << 3));
+
+    for (int i = 0; i < 3; ++i) {
+        auto next = sample()->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_TRUE(next.getDocument().hasRandMetaField());
+    }
+
+    // The sample is complete, so the last document should be left in the source.
+    assertEOF();
+    ASSERT_TRUE(source()->getNext().isAdvanced());
+}
+
 /**
  * The $sampleFromRandomCursor stage should set the random meta value in a way that mimics the
  * non-optimized case.
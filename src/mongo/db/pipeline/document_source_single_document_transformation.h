@@ -78,6 +78,10 @@ public:
         return _parsedTransform->isSubsetOfProjection(proj);
     }
 
+    bool isSimpleProjection() const {
+        return _parsedTransform->isSimpleProjection();
+    }
+
 protected:
     void doDispose() final;
 
@@ -40,6 +40,7 @@
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/s/query/document_source_merge_cursors.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -50,6 +51,12 @@ using std::unique_ptr;
 using std::vector;
 
 namespace {
+// Number of entries in the cache of string comparison keys. Must be a power of two.
+const size_t kCollationKeyCacheSize = 256;
+
+// Longer strings are unlikely to repeat, so their comparison keys are not cached.
+const size_t kMaxCachedCollationKeyStringSize = 64;
+
 Value missingToNull(Value maybeMissing) {
     return maybeMissing.missing() ? Value(BSONNULL) : maybeMissing;
 }
@@ -142,6 +149,7 @@ void DocumentSourceSort::serializeToArray(
 
 void DocumentSourceSort::doDispose() {
     _output.reset();
+    _memoryUsageBytes = 0;
 }
 
 long long DocumentSourceSort::getLimit() const {
@@ -307,6 +315,8 @@ SortOptions DocumentSourceSort::makeSortOptions() const {
         opts.limit = _limitSrc->getLimit();
 
     opts.maxMemoryUsageBytes = _maxMemoryUsageBytes;
+    // Sort keys are compared bytewise, so it is safe to compare them from several threads.
+    opts.maxSortThreads = internalSorterMaxThreads.load();
     if (pExpCtx->allowDiskUse && !pExpCtx->inMongos) {
         opts.extSortAllowed = true;
         opts.tempDir = pExpCtx->tempDir;
@@ -338,6 +348,7 @@ void DocumentSourceSort::loadDocument(Document&& doc) {
     // already computed the sort key we'd have split the pipeline there, would be merging presorted
     // documents, and wouldn't use this method.
     std::tie(sortKey, docForSorter) = extractSortKey(std::move(doc));
+    _memoryUsageBytes += sortKey.getApproximateSize() + docForSorter.getApproximateSize();
     _sorter->add(sortKey, docForSorter);
 }
 
@@ -355,6 +366,10 @@ bool DocumentSourceSort::usedDisk() {
     return _usedDisk;
 }
 
+size_t DocumentSourceSort::getMemUsage() const {
+    return std::min<size_t>(_memoryUsageBytes, _maxMemoryUsageBytes);
+}
+
 Value DocumentSourceSort::getCollationComparisonKey(const Value& val) const {
     const auto collator = pExpCtx->getCollator();
 
@@ -368,10 +383,24 @@ Value DocumentSourceSort::getCollationComparisonKey(const Value& val) const {
         return val;
     }
 
-    // If 'val' is a string, directly use the collator to obtain a comparison key.
+    // If 'val' is a string, directly use the collator to obtain a comparison key. Keys for short
+    // strings are remembered, since the same values tend to be sorted over and over.
     if (val.getType() == BSONType::String) {
-        auto compKey = collator->getComparisonKey(val.getString());
-        return Value(compKey.getKeyData());
+        const auto str = val.getStringData();
+        if (str.size() > kMaxCachedCollationKeyStringSize) {
+            return Value(collator->getComparisonKey(str).getKeyData());
+        }
+
+        if (_collationKeyCache.empty()) {
+            _collationKeyCache.resize(kCollationKeyCacheSize);
+        }
+        auto& entry =
+            _collationKeyCache[StringMapTraits::hash(str) & (kCollationKeyCacheSize - 1)];
+        if (entry.key.missing() || entry.string != str) {
+            entry.string = str.toString();
+            entry.key = Value(collator->getComparisonKey(str).getKeyData());
+        }
+        return entry.key;
     }
 
     // Otherwise, for non-string collatable types, take the slow path and round-trip the value
@@ -459,6 +488,9 @@ std::pair<Value, Document> DocumentSourceSort::extractSortKey(Document&& doc) co
         serializedSortKey = extractKeyWithArray(doc);
         inMemorySortKey = deserializeSortKey(_sortPattern.size(), *serializedSortKey);
     }
+    // The sorter may compare keys on several threads, so a key taken from a document which is still
+    // being loaded from BSON must not load it further while it is compared.
+    inMemorySortKey.loadLazyFields();
 
     MutableDocument toBeSorted(std::move(doc));
     if (pExpCtx->needsMerge) {
@@ -130,6 +130,12 @@ public:
      */
     bool usedDisk() final;
 
+    /**
+     * Returns the size of the documents loaded into the sorter, which holds at most
+     * 'maxMemoryUsageBytes' of them in memory before spilling.
+     */
+    size_t getMemUsage() const final;
+
     /**
      * Instructs the sort stage to use the given set of cursors as inputs, to merge documents that
      * have already been sorted.
@@ -262,6 +268,15 @@ private:
     std::unique_ptr<MySorter> _sorter;
     std::unique_ptr<MySorter::Iterator> _output;
     bool _usedDisk = false;
+    size_t _memoryUsageBytes = 0;
+
+    // Comparison keys of recently sorted short strings, indexed by a hash of the string. Sort keys
+    // often repeat, and computing one under a non-simple collation is expensive.
+    struct CachedCollationKey {
+        std::string string;
+        Value key;
+    };
+    mutable std::vector<CachedCollationKey> _collationKeyCache;
 };
 
 }  // namespace mongo
@@ -44,6 +44,7 @@
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 
@@ -354,6 +355,24 @@ TEST_F(DocumentSourceSortExecutionTest, ExtractArrayValues) {
                  "[{_id:1,a:[{b:1},{b:0}]},{_id:0,a:[{b:1},{b:2}]}]");
 }
 
+/** Repeated strings are sorted by their comparison keys under the collation. */
+TEST_F(DocumentSourceSortExecutionTest, RepeatedStringsRespectCollation) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    getExpCtx()->setCollator(&collator);
+    const std::string longString(100, 'z');
+    checkResults({Document{{"_id", 0}, {"a", "ab"_sd}},
+                  Document{{"_id", 1}, {"a", "ba"_sd}},
+                  Document{{"_id", 2}, {"a", longString}},
+                  Document{{"_id", 3}, {"a", "ab"_sd}},
+                  Document{{"_id", 4}, {"a", "ca"_sd}},
+                  Document{{"_id", 5}, {"a", "ba"_sd}},
+                  Document{{"_id", 6}, {"a", longString}}},
+                 BSON("a" << 1 << "_id" << 1),
+                 "[{_id:1,a:'ba'},{_id:5,a:'ba'},{_id:4,a:'ca'},{_id:0,a:'ab'},{_id:3,a:'ab'},"
+                 "{_id:2,a:'" +
+                     longString + "'},{_id:6,a:'" + longString + "'}]");
+}
+
 TEST_F(DocumentSourceSortExecutionTest, ShouldPauseWhenAskedTo) {
     auto sort = DocumentSourceSort::create(getExpCtx(), BSON("a" << 1));
     auto mock = DocumentSourceMock::create({DocumentSource::GetNextResult::makePauseExecution(),
@@ -471,5 +490,22 @@ TEST_F(DocumentSourceSortExecutionTest, ShouldCorrectlyTrackMemoryUsageBetweenPa
     ASSERT_THROWS_CODE(sort->getNext(), AssertionException, 16819);
 }
 
+TEST_F(DocumentSourceSortExecutionTest, ShouldReportMemoryUsageOfLoadedDocuments) {
+    auto sort = DocumentSourceSort::create(getExpCtx(), BSON("_id" << -1));
+    ASSERT_EQ(sort->getMemUsage(), 0U);
+
+    string largeStr(1000, 'x');
+    auto mock = DocumentSourceMock::create({Document{{"_id", 0}, {"largeStr", largeStr}},
+                                            Document{{"_id", 1}, {"largeStr", largeStr}}});
+    sort->setSource(mock.get());
+
+    // The documents stay buffered while the sorted results are returned.
+    ASSERT_TRUE(sort->getNext().isAdvanced());
+    ASSERT_GT(sort->getMemUsage(), 2 * largeStr.size());
+
+    sort->dispose();
+    ASSERT_EQ(sort->getMemUsage(), 0U);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -30,7 +30,10 @@
 
 #include "mongo/db/pipeline/document_source_unwind.h"
 
+#include <algorithm>
+
 #include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
@@ -59,7 +62,35 @@ public:
      */
     DocumentSource::GetNextResult getNext();
 
+    /**
+     * Skips the array elements for which 'match' does not pass, before a document is materialized
+     * for them. 'match' must only depend on the unwound path.
+     */
+    void setMatch(boost::intrusive_ptr<DocumentSourceMatch> match) {
+        _match = std::move(match);
+    }
+
+    /**
+     * Copies only the top-level fields in 'neededFields' from each input document, or the whole
+     * document if 'neededFields' is boost::none.
+     */
+    void setNeededFields(boost::optional<StringMap<bool>> neededFields) {
+        _neededFields = std::move(neededFields);
+    }
+
 private:
+    /**
+     * Returns a copy of 'document' holding only the fields in '_neededFields', in their original
+     * order, along with its metadata.
+     */
+    Document narrowDocument(const Document& document) const;
+
+    /**
+     * Returns whether '_match' passes for a document holding nothing but 'element' at the unwound
+     * path.
+     */
+    bool elementMatches(const Value& element) const;
+
     // Tracks whether or not we can possibly return any more documents. Note we may return
     // boost::none even if this is true.
     bool _haveNext = false;
@@ -75,6 +106,14 @@ private:
     // existing value, setting to null when the value was a non-array or empty array.
     const boost::optional<FieldPath> _indexPath;
 
+    // If set, a $match which only depends on the unwound path. Output documents which it rejects
+    // are skipped.
+    boost::intrusive_ptr<DocumentSourceMatch> _match;
+
+    // If set, the only top-level fields of the input documents which the rest of the pipeline
+    // depends on. The values are unused.
+    boost::optional<StringMap<bool>> _neededFields;
+
     Value _inputArray;
 
     MutableDocument _output;
@@ -94,14 +133,34 @@ DocumentSourceUnwind::Unwinder::Unwinder(const FieldPath& unwindPath,
       _indexPath(indexPath) {}
 
 void DocumentSourceUnwind::Unwinder::resetDocument(const Document& document) {
-    // Reset document specific attributes.
-    _output.reset(document);
+    // Reset document specific attributes. Dropping the unneeded fields up front means that each
+    // unwound document only clones the parts of the input which are read downstream.
+    Document input = _neededFields ? narrowDocument(document) : document;
+    _output.reset(input);
     _unwindPathFieldIndexes.clear();
     _index = 0;
-    _inputArray = document.getNestedField(_unwindPath, &_unwindPathFieldIndexes);
+    _inputArray = input.getNestedField(_unwindPath, &_unwindPathFieldIndexes);
     _haveNext = true;
 }
 
+Document DocumentSourceUnwind::Unwinder::narrowDocument(const Document& document) const {
+    MutableDocument narrowed(_neededFields->size());
+    for (FieldIterator fields(document); fields.more();) {
+        auto field = fields.next();
+        if (_neededFields->count(field.first)) {
+            narrowed.addField(field.first, field.second);
+        }
+    }
+    narrowed.copyMetaDataFrom(document);
+    return narrowed.freeze();
+}
+
+bool DocumentSourceUnwind::Unwinder::elementMatches(const Value& element) const {
+    MutableDocument toMatch;
+    toMatch.setNestedField(_unwindPath, element);
+    return _match->getMatchExpression()->matchesBSON(toMatch.freeze().toBson());
+}
+
 DocumentSource::GetNextResult DocumentSourceUnwind::Unwinder::getNext() {
     // WARNING: Any functional changes to this method must also be implemented in the unwinding
     // implementation of the $lookup stage.
@@ -125,6 +184,15 @@ DocumentSource::GetNextResult DocumentSourceUnwind::Unwinder::getNext() {
             }
             _output.removeNestedField(_unwindPathFieldIndexes);
         } else {
+            // Skip the elements which the absorbed $match rejects, without cloning the document
+            // for any of them.
+            while (_match && !elementMatches(_inputArray[_index])) {
+                if (++_index == length) {
+                    _haveNext = false;
+                    return GetNextResult::makeEOF();
+                }
+            }
+
             // Set field to be the next element in the array. If needed, this will automatically
             // clone all the documents along the field path so that the end values are not shared
             // across documents that have come out of this pipeline operator. This is a partial deep
@@ -152,6 +220,13 @@ DocumentSource::GetNextResult DocumentSourceUnwind::Unwinder::getNext() {
             indexForOutput ? Value(*indexForOutput) : Value(BSONNULL);
     }
 
+    // A document which was passed through rather than unwound must be matched as a whole, since
+    // the unwound path may traverse an array which $unwind does not descend into.
+    if (_match && !indexForOutput &&
+        !_match->getMatchExpression()->matchesBSON(_output.peek().toBson())) {
+        return GetNextResult::makeEOF();
+    }
+
     return _haveNext ? _output.peek() : _output.freeze();
 }
 
@@ -206,6 +281,95 @@ DocumentSource::GetNextResult DocumentSourceUnwind::getNext() {
     return nextOut;
 }
 
+intrusive_ptr<DocumentSource> DocumentSourceUnwind::optimize() {
+    if (_absorbedMatch && !_absorbedMatch->optimize()) {
+        // The absorbed $match turned out to be empty.
+        _absorbedMatch.reset();
+        _unwinder->setMatch(nullptr);
+    }
+    return this;
+}
+
+bool DocumentSourceUnwind::canAbsorbMatch(const DocumentSourceMatch& match) const {
+    if (match.isTextQuery()) {
+        return false;
+    }
+
+    // The index path is written into each output document, so a $match which could observe it
+    // cannot be evaluated against the array element alone.
+    const auto unwindPath = _unwindPath.fullPath();
+    if (_indexPath) {
+        const auto indexPath = _indexPath->fullPath();
+        if (indexPath == unwindPath || expression::isPathPrefixOf(indexPath, unwindPath) ||
+            expression::isPathPrefixOf(unwindPath, indexPath)) {
+            return false;
+        }
+    }
+
+    DepsTracker deps(DepsTracker::kAllMetadataAvailable);
+    if (match.getDependencies(&deps) == DepsTracker::State::NOT_SUPPORTED ||
+        deps.needWholeDocument || !deps.getAllRequiredMetadataTypes().empty()) {
+        return false;
+    }
+    return std::all_of(deps.fields.begin(), deps.fields.end(), [&](const std::string& field) {
+        return field == unwindPath || expression::isPathPrefixOf(unwindPath, field);
+    });
+}
+
+boost::optional<StringMap<bool>> DocumentSourceUnwind::computeNeededFields(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) const {
+    // When this stage is at the front of the pipeline, its input has already been limited to the
+    // pipeline's dependencies by the query layer.
+    if (itr == container->begin()) {
+        return boost::none;
+    }
+
+    DepsTracker deps(DepsTracker::kAllMetadataAvailable);
+    for (auto stage = std::next(itr); stage != container->end(); ++stage) {
+        auto state = (*stage)->getDependencies(&deps);
+        if (state == DepsTracker::State::NOT_SUPPORTED || deps.needWholeDocument) {
+            return boost::none;
+        }
+        if (state & DepsTracker::State::EXHAUSTIVE_FIELDS) {
+            StringMap<bool> neededFields;
+            neededFields[_unwindPath.getFieldName(0)] = true;
+            for (auto&& field : deps.fields) {
+                neededFields[FieldPath::extractFirstFieldFromDottedPath(field)] = true;
+            }
+            return neededFields;
+        }
+    }
+
+    // The end of the pipeline needs the whole document.
+    return boost::none;
+}
+
+Pipeline::SourceContainer::iterator DocumentSourceUnwind::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    // The portions of a following $match which do not depend on our modified paths have already
+    // been swapped ahead of us. If the rest only reads the unwound path, it can be evaluated
+    // against each array element before the element is copied into a document.
+    auto nextMatch = dynamic_cast<DocumentSourceMatch*>((*std::next(itr)).get());
+    if (nextMatch && canAbsorbMatch(*nextMatch)) {
+        if (!_absorbedMatch) {
+            _absorbedMatch = nextMatch;
+        } else {
+            _absorbedMatch->joinMatchWith(nextMatch);
+        }
+        _unwinder->setMatch(_absorbedMatch);
+
+        // There may be further optimization between this $unwind and the new neighbor, so we
+        // return an iterator pointing to ourself.
+        container->erase(std::next(itr));
+        return itr;
+    }
+
+    _unwinder->setNeededFields(computeNeededFields(itr, container));
+    return std::next(itr);
+}
+
 BSONObjSet DocumentSourceUnwind::getOutputSorts() {
     BSONObjSet out = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     std::string unwoundPath = getUnwindPath();
@@ -247,8 +411,22 @@ Value DocumentSourceUnwind::serialize(boost::optional<ExplainOptions::Verbosity>
                                 << (_indexPath ? Value((*_indexPath).fullPath()) : Value()))));
 }
 
+void DocumentSourceUnwind::serializeToArray(
+    std::vector<Value>& array, boost::optional<ExplainOptions::Verbosity> explain) const {
+    array.push_back(serialize(explain));
+
+    // The absorbed $match is serialized as a separate stage, so that the pipeline can be parsed
+    // again wherever it is sent.
+    if (_absorbedMatch) {
+        _absorbedMatch->serializeToArray(array, explain);
+    }
+}
+
 DepsTracker::State DocumentSourceUnwind::getDependencies(DepsTracker* deps) const {
     deps->fields.insert(_unwindPath.fullPath());
+    if (_absorbedMatch) {
+        _absorbedMatch->getDependencies(deps);
+    }
     return DepsTracker::State::SEE_NEXT;
 }
 
@@ -29,7 +29,9 @@
 #pragma once
 
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/field_path.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -40,6 +42,14 @@ public:
     const char* getSourceName() const final;
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
     BSONObjSet getOutputSorts() final;
+    boost::intrusive_ptr<DocumentSource> optimize() final;
+
+    /**
+     * Serializes this stage, followed by any $match it has absorbed.
+     */
+    void serializeToArray(
+        std::vector<Value>& array,
+        boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
 
     /**
      * Returns the unwound path, and the 'includeArrayIndex' path, if specified.
@@ -84,12 +94,43 @@ public:
         return _indexPath;
     }
 
+    /**
+     * Returns the $match which this stage applies to its output, or null if it has not absorbed
+     * one.
+     */
+    const boost::intrusive_ptr<DocumentSourceMatch>& absorbedMatch() const {
+        return _absorbedMatch;
+    }
+
+protected:
+    /**
+     * Attempts to absorb a subsequent $match which only depends on the unwound path, so that the
+     * array elements it rejects are skipped before a document is materialized for them. Otherwise
+     * limits the documents produced by this stage to the top-level fields which the rest of the
+     * pipeline depends on.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
 private:
     DocumentSourceUnwind(const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
                          const FieldPath& fieldPath,
                          bool includeNullIfEmptyOrMissing,
                          const boost::optional<FieldPath>& includeArrayIndex);
 
+    /**
+     * Returns true if 'match' reads nothing but the unwound path, and can therefore be evaluated
+     * against each array element on its own.
+     */
+    bool canAbsorbMatch(const DocumentSourceMatch& match) const;
+
+    /**
+     * Returns the top-level fields which the stages following 'itr' depend on, or boost::none if
+     * they may need the whole document.
+     */
+    boost::optional<StringMap<bool>> computeNeededFields(
+        Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) const;
+
     // Configuration state.
     const FieldPath _unwindPath;
     // Documents that have a nullish value, or an empty array for the field '_unwindPath', will pass
@@ -98,6 +139,8 @@ private:
     // If set, the $unwind stage will include the array index in the specified path, overwriting any
     // existing value, setting to null when the value was a non-array or empty array.
     const boost::optional<FieldPath> _indexPath;
+    // If set, a $match which only depends on the unwound path, applied to each output document.
+    boost::intrusive_ptr<DocumentSourceMatch> _absorbedMatch;
 
     // Iteration state.
     class Unwinder;
@@ -43,6 +43,7 @@
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/value_comparator.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/db/service_context.h"
@@ -744,6 +745,88 @@ TEST_F(UnwindStageTest, UnwindIncludesIndexPathWhenIncludingIndex) {
     ASSERT_EQUALS(1U, modifiedPaths.paths.count("arrIndex"));
 }
 
+TEST_F(UnwindStageTest, AbsorbsMatchOnUnwoundPath) {
+    auto pipeline = uassertStatusOK(Pipeline::parse(
+        {fromjson("{$unwind: '$a'}"), fromjson("{$match: {'a.b': {$gt: 1}}}")}, getExpCtx()));
+    pipeline->optimizePipeline();
+
+    ASSERT_EQUALS(1U, pipeline->getSources().size());
+    auto unwind = dynamic_cast<DocumentSourceUnwind*>(pipeline->getSources().front().get());
+    ASSERT(unwind);
+    ASSERT(unwind->absorbedMatch());
+
+    // The absorbed $match is still serialized as a stage of its own.
+    ASSERT_EQUALS(2U, pipeline->serialize().size());
+
+    auto source = DocumentSourceMock::create({"{_id: 0, a: [{b: 1}, {b: 2}, {b: 0}, {b: 3}]}",
+                                              "{_id: 1, a: [{b: 0}]}",
+                                              "{_id: 2, a: {b: 2}}",
+                                              "{_id: 3, a: {b: 0}}"});
+    unwind->setSource(source.get());
+
+    ASSERT_DOCUMENT_EQ(unwind->getNext().releaseDocument(),
+                       Document(fromjson("{_id: 0, a: {b: 2}}")));
+    ASSERT_DOCUMENT_EQ(unwind->getNext().releaseDocument(),
+                       Document(fromjson("{_id: 0, a: {b: 3}}")));
+    ASSERT_DOCUMENT_EQ(unwind->getNext().releaseDocument(),
+                       Document(fromjson("{_id: 2, a: {b: 2}}")));
+    ASSERT_TRUE(unwind->getNext().isEOF());
+}
+
+TEST_F(UnwindStageTest, DoesNotAbsorbMatchOnOtherPaths) {
+    auto pipeline = uassertStatusOK(Pipeline::parse(
+        {fromjson("{$unwind: '$a'}"), fromjson("{$match: {$or: [{a: 1}, {b: 1}]}}")},
+        getExpCtx()));
+    pipeline->optimizePipeline();
+
+    ASSERT_EQUALS(2U, pipeline->getSources().size());
+    auto unwind = dynamic_cast<DocumentSourceUnwind*>(pipeline->getSources().front().get());
+    ASSERT(unwind);
+    ASSERT_FALSE(unwind->absorbedMatch());
+}
+
+TEST_F(UnwindStageTest, DoesNotAbsorbMatchWhenIndexPathIsWithinUnwoundPath) {
+    auto pipeline = uassertStatusOK(
+        Pipeline::parse({fromjson("{$unwind: {path: '$a', includeArrayIndex: 'a.i'}}"),
+                         fromjson("{$match: {'a.i': 0}}")},
+                        getExpCtx()));
+    pipeline->optimizePipeline();
+
+    ASSERT_EQUALS(2U, pipeline->getSources().size());
+}
+
+TEST_F(UnwindStageTest, OnlyProducesFieldsNeededByLaterStages) {
+    auto pipeline = uassertStatusOK(
+        Pipeline::parse({fromjson("{$addFields: {z: 1}}"),
+                         fromjson("{$unwind: '$a'}"),
+                         fromjson("{$group: {_id: '$a.k', total: {$sum: '$b'}}}")},
+                        getExpCtx()));
+    pipeline->optimizePipeline();
+    pipeline->addInitialSource(
+        DocumentSourceMock::create("{_id: 0, b: 5, c: 6, a: [{k: 1, l: 2}, {k: 3}]}"));
+
+    ASSERT_EQUALS(4U, pipeline->getSources().size());
+    auto unwind = std::next(pipeline->getSources().begin(), 2)->get();
+    ASSERT(dynamic_cast<DocumentSourceUnwind*>(unwind));
+
+    // The unneeded top-level fields are dropped, and the needed ones keep their original order.
+    ASSERT_DOCUMENT_EQ(unwind->getNext().releaseDocument(),
+                       Document(fromjson("{b: 5, a: {k: 1, l: 2}}")));
+    ASSERT_DOCUMENT_EQ(unwind->getNext().releaseDocument(),
+                       Document(fromjson("{b: 5, a: {k: 3}}")));
+    ASSERT_TRUE(unwind->getNext().isEOF());
+}
+
+TEST_F(UnwindStageTest, ProducesWholeDocumentsWhenEndOfPipelineFollows) {
+    auto pipeline = uassertStatusOK(Pipeline::parse(
+        {fromjson("{$addFields: {z: 1}}"), fromjson("{$unwind: '$a'}")}, getExpCtx()));
+    pipeline->optimizePipeline();
+    pipeline->addInitialSource(DocumentSourceMock::create("{_id: 0, b: 5, a: [1]}"));
+
+    ASSERT_DOCUMENT_EQ(*pipeline->getNext(), Document(fromjson("{_id: 0, b: 5, a: 1, z: 1}")));
+    ASSERT_FALSE(static_cast<bool>(pipeline->getNext()));
+}
+
 //
 // Error cases.
 //
@@ -111,6 +111,81 @@ TEST(DocumentConstruction, FromEmptyDocumentClone) {
     ASSERT_DOCUMENT_EQ(document, documentClone);
 }
 
+TEST(DocumentConstruction, RebuildingDocumentsReusesFreedStorageCorrectly) {
+    // Documents of growing sizes free buffers of every cached size, which the next round of
+    // documents then reuses.
+    for (int round = 0; round < 3; ++round) {
+        std::vector<Document> documents;
+        for (int numFields = 0; numFields < 64; ++numFields) {
+            // Reserving too few fields makes the document grow through its power-of-two sizes.
+            MutableDocument md(numFields % 2 == 0 ? numFields : 1);
+            for (int i = 0; i < numFields; ++i) {
+                md.addField("field" + std::to_string(i), Value(round * 100 + i));
+            }
+            documents.push_back(md.freeze());
+            documents.push_back(documents.back().clone());
+        }
+        for (int numFields = 0; numFields < 64; ++numFields) {
+            for (int copy = 0; copy < 2; ++copy) {
+                const Document& document = documents[numFields * 2 + copy];
+                ASSERT_EQUALS(static_cast<size_t>(numFields), document.size());
+                for (int i = 0; i < numFields; ++i) {
+                    ASSERT_VALUE_EQ(Value(round * 100 + i),
+                                    document["field" + std::to_string(i)]);
+                }
+            }
+        }
+    }
+}
+
+TEST(DocumentConstruction, FromBsonWithMetaDataLoadsFieldsOnFirstAccess) {
+    BSONObj obj = BSON("a" << 1 << "b" << BSON("c" << 2) << "d" << BSON_ARRAY(BSON("e" << 3))
+                           << "f"
+                           << "x");
+    Document document = Document::fromBsonWithMetaData(obj);
+    ASSERT_FALSE(document.empty());
+    ASSERT_VALUE_EQ(Value("x"_sd), document["f"]);
+    ASSERT_VALUE_EQ(Value(2), document.getNestedField(FieldPath("b.c")));
+    ASSERT_VALUE_EQ(Value(1), document["a"]);
+    ASSERT(document["z"].missing());
+    ASSERT_EQUALS(4U, document.size());
+    ASSERT_EQUALS("d", getNthField(document, 2).first.toString());
+    ASSERT_VALUE_EQ(Value(3), document["d"][0]["e"]);
+
+    // An unmodified document serializes to the BSON it was created from.
+    ASSERT_BSONOBJ_EQ(obj, document.toBson());
+    ASSERT_EQUALS(static_cast<const void*>(obj.objdata()),
+                  static_cast<const void*>(document.toBson().objdata()));
+}
+
+TEST(DocumentConstruction, ModifyingDocumentFromBsonWithMetaData) {
+    BSONObj obj = BSON("a" << 1 << "b" << BSON("c" << 2) << "d" << 3);
+    Document document = Document::fromBsonWithMetaData(obj);
+    ASSERT_VALUE_EQ(Value(1), document["a"]);
+
+    MutableDocument md(document);
+    md.setField("a", Value(5));
+    md.setNestedField(FieldPath("b.c"), Value(6));
+    md.addField("e", Value(true));
+    ASSERT_BSONOBJ_EQ(BSON("a" << 5 << "b" << BSON("c" << 6) << "d" << 3 << "e" << true),
+                      md.freeze().toBson());
+
+    // The original document is unchanged.
+    ASSERT_BSONOBJ_EQ(obj, document.toBson());
+}
+
+TEST(DocumentConstruction, LoadingLazyFieldsOfDocumentFromBsonWithMetaData) {
+    BSONObj obj = BSON("a" << BSON_ARRAY(BSON("b" << 1) << BSON("b" << 2)) << "c"
+                           << BSON("d" << BSON("e" << 3)));
+    Document document = Document::fromBsonWithMetaData(obj);
+    Document copy = document;
+    copy.loadLazyFields();
+    ASSERT_VALUE_EQ(Value(2), document["a"][1]["b"]);
+    ASSERT_VALUE_EQ(Value(3), copy.getNestedField(FieldPath("c.d.e")));
+    ASSERT_BSONOBJ_EQ(obj, document.toBson());
+    ASSERT_DOCUMENT_EQ(Document(obj), copy);
+}
+
 /**
  * Appends to 'builder' an object nested 'depth' levels deep.
  */
@@ -263,7 +263,13 @@ const char* ExpressionAbs::getOpName() const {
 
 /* ------------------------- ExpressionAdd ----------------------------- */
 
-Value ExpressionAdd::evaluate(const Document& root) const {
+namespace {
+/**
+ * Sums the 'n' values produced by 'getOperand', returning null as soon as one of them is nullish.
+ * Operands after a nullish one are never produced.
+ */
+template <typename OperandFunc>
+Value sumOperands(size_t n, OperandFunc&& getOperand) {
     // We'll try to return the narrowest possible result value while avoiding overflow, loss
     // of precision due to intermediate rounding or implicit use of decimal types. To do that,
     // compute a compensated sum for non-decimal values and a separate decimal sum for decimal
@@ -273,9 +279,8 @@ Value ExpressionAdd::evaluate(const Document& root) const {
     BSONType totalType = NumberInt;
     bool haveDate = false;
 
-    const size_t n = vpOperand.size();
     for (size_t i = 0; i < n; ++i) {
-        Value val = vpOperand[i]->evaluate(root);
+        Value val = getOperand(i);
 
         switch (val.getType()) {
             case NumberDecimal:
@@ -337,6 +342,15 @@ Value ExpressionAdd::evaluate(const Document& root) const {
             massert(16417, "$add resulted in a non-numeric type", false);
     }
 }
+}  // namespace
+
+Value ExpressionAdd::evaluate(const Document& root) const {
+    return sumOperands(vpOperand.size(), [&](size_t i) { return vpOperand[i]->evaluate(root); });
+}
+
+Value ExpressionAdd::apply(const Value& lhs, const Value& rhs) {
+    return sumOperands(2, [&](size_t i) { return i == 0 ? lhs : rhs; });
+}
 
 REGISTER_EXPRESSION(add, ExpressionAdd::parse);
 const char* ExpressionAdd::getOpName() const {
@@ -810,9 +824,10 @@ static const CmpLookup cmpLookup[7] = {
 }
 
 Value ExpressionCompare::evaluate(const Document& root) const {
-    Value pLeft(vpOperand[0]->evaluate(root));
-    Value pRight(vpOperand[1]->evaluate(root));
+    return apply(vpOperand[0]->evaluate(root), vpOperand[1]->evaluate(root));
+}
 
+Value ExpressionCompare::apply(const Value& pLeft, const Value& pRight) const {
     int cmp = getExpressionContext()->getValueComparator().compare(pLeft, pRight);
 
     // Make cmp one of 1, 0, or -1.
@@ -1008,6 +1023,42 @@ boost::optional<TimeZone> makeTimeZone(const TimeZoneDatabase* tzdb,
     return tzdb->getTimeZone(timeZoneId.getString());
 }
 
+/**
+ * Returns the timezone that 'timeZone' evaluates to if it is absent or a constant, or boost::none
+ * if it depends on the input document, is nullish or is invalid. In the latter cases evaluate()
+ * resolves it for each document, and reports an invalid timezone then.
+ */
+boost::optional<TimeZone> resolveConstantTimeZone(const TimeZoneDatabase* tzdb,
+                                                  const Expression* timeZone) {
+    if (!tzdb || (timeZone && !dynamic_cast<const ExpressionConstant*>(timeZone))) {
+        return boost::none;
+    }
+
+    try {
+        return makeTimeZone(tzdb, Document{}, timeZone);
+    } catch (const DBException&) {
+        return boost::none;
+    }
+}
+
+/**
+ * Returns whether 'format' is a constant string which 'validate' accepts, in which case evaluate()
+ * need not check it for each document.
+ */
+bool isValidConstantFormat(const Expression* format, void (*validate)(StringData)) {
+    const auto constant = dynamic_cast<const ExpressionConstant*>(format);
+    if (!constant || constant->getValue().getType() != BSONType::String) {
+        return false;
+    }
+
+    try {
+        validate(constant->getValue().getStringData());
+        return true;
+    } catch (const DBException&) {
+        return false;
+    }
+}
+
 }  // namespace
 
 
@@ -1391,6 +1442,10 @@ intrusive_ptr<Expression> ExpressionDateFromString::optimize() {
         // Everything is a constant, so we can turn into a constant.
         return ExpressionConstant::create(getExpressionContext(), evaluate(Document{}));
     }
+
+    _parsedTimeZone =
+        resolveConstantTimeZone(getExpressionContext()->timeZoneDatabase, _timeZone.get());
+    _formatValidated = isValidConstantFormat(_format.get(), &TimeZone::validateFromStringFormat);
     return this;
 }
 
@@ -1412,7 +1467,7 @@ Value ExpressionDateFromString::evaluate(const Document& root) const {
     // behavior takes precedence.
     if (_format) {
         formatValue = _format->evaluate(root);
-        if (!formatValue.nullish()) {
+        if (!_formatValidated && !formatValue.nullish()) {
             uassert(40684,
                     str::stream() << "$dateFromString requires that 'format' be a string, found: "
                                   << typeName(formatValue.getType())
@@ -1426,7 +1481,12 @@ Value ExpressionDateFromString::evaluate(const Document& root) const {
 
     // Evaluate the timezone parameter before checking for nullish input, as this will throw an
     // exception for an invalid timezone string.
-    auto timeZone = makeTimeZone(getExpressionContext()->timeZoneDatabase, root, _timeZone.get());
+    boost::optional<TimeZone> evaluatedTimeZone;
+    if (!_parsedTimeZone) {
+        evaluatedTimeZone =
+            makeTimeZone(getExpressionContext()->timeZoneDatabase, root, _timeZone.get());
+    }
+    const auto& timeZone = _parsedTimeZone ? _parsedTimeZone : evaluatedTimeZone;
 
     // Behavior for nullish input takes precedence over other nullish elements.
     if (dateString.nullish()) {
@@ -1704,6 +1764,9 @@ intrusive_ptr<Expression> ExpressionDateToString::optimize() {
         return ExpressionConstant::create(getExpressionContext(), evaluate(Document{}));
     }
 
+    _parsedTimeZone =
+        resolveConstantTimeZone(getExpressionContext()->timeZoneDatabase, _timeZone.get());
+    _formatValidated = isValidConstantFormat(_format.get(), &TimeZone::validateToStringFormat);
     return this;
 }
 
@@ -1724,7 +1787,7 @@ Value ExpressionDateToString::evaluate(const Document& root) const {
     // behavior takes precedence.
     if (_format) {
         formatValue = _format->evaluate(root);
-        if (!formatValue.nullish()) {
+        if (!_formatValidated && !formatValue.nullish()) {
             uassert(18533,
                     str::stream() << "$dateToString requires that 'format' be a string, found: "
                                   << typeName(formatValue.getType())
@@ -1738,7 +1801,12 @@ Value ExpressionDateToString::evaluate(const Document& root) const {
 
     // Evaluate the timezone parameter before checking for nullish input, as this will throw an
     // exception for an invalid timezone string.
-    auto timeZone = makeTimeZone(getExpressionContext()->timeZoneDatabase, root, _timeZone.get());
+    boost::optional<TimeZone> evaluatedTimeZone;
+    if (!_parsedTimeZone) {
+        evaluatedTimeZone =
+            makeTimeZone(getExpressionContext()->timeZoneDatabase, root, _timeZone.get());
+    }
+    const auto& timeZone = _parsedTimeZone ? _parsedTimeZone : evaluatedTimeZone;
 
     if (date.nullish()) {
         return _onNull ? _onNull->evaluate(root) : Value(BSONNULL);
@@ -1777,9 +1845,10 @@ void ExpressionDateToString::_doAddDependencies(DepsTracker* deps) const {
 /* ----------------------- ExpressionDivide ---------------------------- */
 
 Value ExpressionDivide::evaluate(const Document& root) const {
-    Value lhs = vpOperand[0]->evaluate(root);
-    Value rhs = vpOperand[1]->evaluate(root);
+    return apply(vpOperand[0]->evaluate(root), vpOperand[1]->evaluate(root));
+}
 
+Value ExpressionDivide::apply(const Value& lhs, const Value& rhs) {
     auto assertNonZero = [](bool nonZero) { uassert(16608, "can't $divide by zero", nonZero); };
 
     if (lhs.numeric() && rhs.numeric()) {
@@ -2557,7 +2626,13 @@ const char* ExpressionMod::getOpName() const {
 
 /* ------------------------- ExpressionMultiply ----------------------------- */
 
-Value ExpressionMultiply::evaluate(const Document& root) const {
+namespace {
+/**
+ * Multiplies the 'n' values produced by 'getOperand', returning null as soon as one of them is
+ * nullish. Operands after a nullish one are never produced.
+ */
+template <typename OperandFunc>
+Value multiplyOperands(size_t n, OperandFunc&& getOperand) {
     /*
       We'll try to return the narrowest possible result value.  To do that
       without creating intermediate Values, do the arithmetic for double
@@ -2570,9 +2645,8 @@ Value ExpressionMultiply::evaluate(const Document& root) const {
 
     BSONType productType = NumberInt;
 
-    const size_t n = vpOperand.size();
     for (size_t i = 0; i < n; ++i) {
-        Value val = vpOperand[i]->evaluate(root);
+        Value val = getOperand(i);
 
         if (val.numeric()) {
             BSONType oldProductType = productType;
@@ -2612,6 +2686,16 @@ Value ExpressionMultiply::evaluate(const Document& root) const {
     else
         massert(16418, "$multiply resulted in a non-numeric type", false);
 }
+}  // namespace
+
+Value ExpressionMultiply::evaluate(const Document& root) const {
+    return multiplyOperands(vpOperand.size(),
+                            [&](size_t i) { return vpOperand[i]->evaluate(root); });
+}
+
+Value ExpressionMultiply::apply(const Value& lhs, const Value& rhs) {
+    return multiplyOperands(2, [&](size_t i) { return i == 0 ? lhs : rhs; });
+}
 
 REGISTER_EXPRESSION(multiply, ExpressionMultiply::parse);
 const char* ExpressionMultiply::getOpName() const {
@@ -4274,9 +4358,10 @@ const char* ExpressionStrLenCP::getOpName() const {
 /* ----------------------- ExpressionSubtract ---------------------------- */
 
 Value ExpressionSubtract::evaluate(const Document& root) const {
-    Value lhs = vpOperand[0]->evaluate(root);
-    Value rhs = vpOperand[1]->evaluate(root);
+    return apply(vpOperand[0]->evaluate(root), vpOperand[1]->evaluate(root));
+}
 
+Value ExpressionSubtract::apply(const Value& lhs, const Value& rhs) {
     BSONType diffType = Value::getWidestNumeric(rhs.getType(), lhs.getType());
 
     if (diffType == NumberDecimal) {
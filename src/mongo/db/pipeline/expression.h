@@ -248,6 +248,9 @@ protected:
     virtual void _doAddDependencies(DepsTracker* deps) const = 0;
 
 private:
+    // A compiled expression shares the ExpressionContext of the tree it was compiled from.
+    friend class ExpressionCompiled;
+
     boost::optional<Variables::Id> _boundaryVariableId;
     boost::intrusive_ptr<ExpressionContext> _expCtx;
 };
@@ -391,9 +394,7 @@ public:
         if (n == 1) {
             Value singleVal = this->vpOperand[0]->evaluate(root);
             if (singleVal.getType() == Array) {
-                for (const Value& val : singleVal.getArray()) {
-                    accum.process(val, false);
-                }
+                accum.processBatch(singleVal.getArray(), false);
             } else {
                 accum.process(singleVal, false);
             }
@@ -672,6 +673,11 @@ public:
     Value evaluate(const Document& root) const final;
     const char* getOpName() const final;
 
+    /**
+     * Returns the result of adding 'rhs' to 'lhs', exactly as a two-operand $add would.
+     */
+    static Value apply(const Value& lhs, const Value& rhs);
+
     bool isAssociative() const final {
         return true;
     }
@@ -813,6 +819,12 @@ public:
     Value evaluate(const Document& root) const final;
     const char* getOpName() const final;
 
+    /**
+     * Compares 'lhs' with 'rhs' using this expression's operator and the collation of its
+     * ExpressionContext, as evaluate() would for those operands.
+     */
+    Value apply(const Value& lhs, const Value& rhs) const;
+
     CmpOp getOp() const {
         return cmpOp;
     }
@@ -905,6 +917,13 @@ private:
     boost::intrusive_ptr<Expression> _format;
     boost::intrusive_ptr<Expression> _onNull;
     boost::intrusive_ptr<Expression> _onError;
+
+    // Set by optimize() when the timezone is a constant which names a valid timezone, so it is not
+    // looked up for every document.
+    boost::optional<TimeZone> _parsedTimeZone;
+
+    // Set by optimize() when the format is a constant which is a valid format string.
+    bool _formatValidated = false;
 };
 
 class ExpressionDateFromParts final : public Expression {
@@ -1021,6 +1040,13 @@ private:
     boost::intrusive_ptr<Expression> _date;
     boost::intrusive_ptr<Expression> _timeZone;
     boost::intrusive_ptr<Expression> _onNull;
+
+    // Set by optimize() when the timezone is a constant which names a valid timezone, so it is not
+    // looked up for every document.
+    boost::optional<TimeZone> _parsedTimeZone;
+
+    // Set by optimize() when the format is a constant which is a valid format string.
+    bool _formatValidated = false;
 };
 
 class ExpressionDayOfMonth final : public DateExpressionAcceptingTimeZone<ExpressionDayOfMonth> {
@@ -1063,6 +1089,11 @@ public:
 
     Value evaluate(const Document& root) const final;
     const char* getOpName() const final;
+
+    /**
+     * Returns the result of dividing 'lhs' by 'rhs', as evaluate() would for those operands.
+     */
+    static Value apply(const Value& lhs, const Value& rhs);
 };
 
 
@@ -1440,6 +1471,11 @@ public:
     Value evaluate(const Document& root) const final;
     const char* getOpName() const final;
 
+    /**
+     * Returns the product of 'lhs' and 'rhs', exactly as a two-operand $multiply would.
+     */
+    static Value apply(const Value& lhs, const Value& rhs);
+
     bool isAssociative() const final {
         return true;
     }
@@ -1790,6 +1826,11 @@ public:
 
     Value evaluate(const Document& root) const final;
     const char* getOpName() const final;
+
+    /**
+     * Returns the result of subtracting 'rhs' from 'lhs', as evaluate() would for those operands.
+     */
+    static Value apply(const Value& lhs, const Value& rhs);
 };
 
 
@@ -0,0 +1,326 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/expression_compiled.h"
+
+#include <array>
+#include <boost/optional.hpp>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+
+// The functions below handle operands of a single common int or double type directly, and
+// otherwise defer to the operator's own implementation.
+
+Value add(const Value& lhs, const Value& rhs) {
+    if (lhs.getType() == NumberInt && rhs.getType() == NumberInt) {
+        return Value::createIntOrLong(static_cast<long long>(lhs.getInt()) + rhs.getInt());
+    }
+    if (lhs.getType() == NumberDouble && rhs.getType() == NumberDouble) {
+        // The compensated sum used by $add starts from positive zero, so -0 + -0 is 0 there too.
+        return Value(0.0 + lhs.getDouble() + rhs.getDouble());
+    }
+    return ExpressionAdd::apply(lhs, rhs);
+}
+
+Value subtract(const Value& lhs, const Value& rhs) {
+    if (lhs.getType() == NumberInt && rhs.getType() == NumberInt) {
+        return Value::createIntOrLong(static_cast<long long>(lhs.getInt()) - rhs.getInt());
+    }
+    if (lhs.getType() == NumberDouble && rhs.getType() == NumberDouble) {
+        return Value(lhs.getDouble() - rhs.getDouble());
+    }
+    return ExpressionSubtract::apply(lhs, rhs);
+}
+
+Value multiply(const Value& lhs, const Value& rhs) {
+    if (lhs.getType() == NumberInt && rhs.getType() == NumberInt) {
+        return Value::createIntOrLong(static_cast<long long>(lhs.getInt()) * rhs.getInt());
+    }
+    if (lhs.getType() == NumberDouble && rhs.getType() == NumberDouble) {
+        return Value(lhs.getDouble() * rhs.getDouble());
+    }
+    return ExpressionMultiply::apply(lhs, rhs);
+}
+
+Value compare(const ExpressionCompare& node, const Value& lhs, const Value& rhs) {
+    // Doubles are left to the ValueComparator, which orders NaN below every other number.
+    if (lhs.getType() == NumberInt && rhs.getType() == NumberInt) {
+        const int left = lhs.getInt();
+        const int right = rhs.getInt();
+        switch (node.getOp()) {
+            case ExpressionCompare::EQ:
+                return Value(left == right);
+            case ExpressionCompare::NE:
+                return Value(left != right);
+            case ExpressionCompare::GT:
+                return Value(left > right);
+            case ExpressionCompare::GTE:
+                return Value(left >= right);
+            case ExpressionCompare::LT:
+                return Value(left < right);
+            case ExpressionCompare::LTE:
+                return Value(left <= right);
+            case ExpressionCompare::CMP:
+                return Value(left < right ? -1 : (left > right ? 1 : 0));
+        }
+        MONGO_UNREACHABLE;
+    }
+    return node.apply(lhs, rhs);
+}
+
+}  // namespace
+
+/**
+ * Emits the program for an expression tree into an ExpressionCompiled. Each subexpression is
+ * compiled into a destination register, with the operands of a binary operator going to that
+ * register and the one after it.
+ */
+class ExpressionCompiled::Compiler {
+public:
+    using Op = Instruction::Op;
+
+    explicit Compiler(ExpressionCompiled* compiled) : _compiled(compiled) {}
+
+    /**
+     * Emits instructions which leave the value of 'expression' in register 'dst'. Returns false if
+     * the expression needs more registers than are available.
+     */
+    bool compile(const Expression* expression, size_t dst) {
+        if (dst >= kMaxRegisters) {
+            return false;
+        }
+
+        if (auto constant = dynamic_cast<const ExpressionConstant*>(expression)) {
+            _compiled->_constants.push_back(constant->getValue());
+            emit(Op::kLoadConstant, dst, _compiled->_constants.size() - 1);
+            return true;
+        }
+
+        if (auto fieldPath = dynamic_cast<const ExpressionFieldPath*>(expression)) {
+            // Only a top-level field of the root document can be read without the variables, and
+            // without the array traversal of a dotted path.
+            if (fieldPath->isRootFieldPath() && fieldPath->getFieldPath().getPathLength() == 2) {
+                _compiled->_fieldNames.push_back(
+                    fieldPath->getFieldPath().getFieldName(1).toString());
+                emit(Op::kLoadField, dst, _compiled->_fieldNames.size() - 1);
+                return true;
+            }
+            return evaluateThroughTree(expression, dst);
+        }
+
+        // $add and $multiply stop at a nullish operand without evaluating the ones after it. Only
+        // their two-operand forms are compiled, so that longer sums keep the compensated summation
+        // of the original.
+        if (auto add = dynamic_cast<const ExpressionAdd*>(expression)) {
+            if (add->getOperandList().size() == 2) {
+                return compileBinary(Op::kAdd, add->getOperandList(), dst, true);
+            }
+            return evaluateThroughTree(expression, dst);
+        }
+
+        if (auto multiply = dynamic_cast<const ExpressionMultiply*>(expression)) {
+            if (multiply->getOperandList().size() == 2) {
+                return compileBinary(Op::kMultiply, multiply->getOperandList(), dst, true);
+            }
+            return evaluateThroughTree(expression, dst);
+        }
+
+        if (auto subtract = dynamic_cast<const ExpressionSubtract*>(expression)) {
+            return compileBinary(Op::kSubtract, subtract->getOperandList(), dst, false);
+        }
+
+        if (auto divide = dynamic_cast<const ExpressionDivide*>(expression)) {
+            return compileBinary(Op::kDivide, divide->getOperandList(), dst, false);
+        }
+
+        if (auto compare = dynamic_cast<const ExpressionCompare*>(expression)) {
+            return compileBinary(
+                Op::kCompare, compare->getOperandList(), dst, false, addNode(compare));
+        }
+
+        if (auto cond = dynamic_cast<const ExpressionCond*>(expression)) {
+            const auto& operands = cond->getOperandList();
+            if (!compile(operands[0].get(), dst)) {
+                return false;
+            }
+            const size_t jumpToElse = emit(Op::kJumpIfFalse, dst);
+            if (!compile(operands[1].get(), dst)) {
+                return false;
+            }
+            const size_t jumpToEnd = emit(Op::kJump, dst);
+            patchJump(jumpToElse);
+            if (!compile(operands[2].get(), dst)) {
+                return false;
+            }
+            patchJump(jumpToEnd);
+            ++_numOperators;
+            return true;
+        }
+
+        return evaluateThroughTree(expression, dst);
+    }
+
+    /**
+     * Returns true if the program does anything beyond loading values or evaluating the tree,
+     * which is the only case where it is worth running instead of the tree.
+     */
+    bool hasOperators() const {
+        return _numOperators > 0;
+    }
+
+private:
+    size_t emit(Op op, size_t dst, size_t arg = 0) {
+        _compiled->_program.push_back(
+            {op, static_cast<uint8_t>(dst), static_cast<uint32_t>(arg)});
+        return _compiled->_program.size() - 1;
+    }
+
+    /**
+     * Points the jump at index 'jump' to the next instruction to be emitted.
+     */
+    void patchJump(size_t jump) {
+        _compiled->_program[jump].arg = static_cast<uint32_t>(_compiled->_program.size());
+    }
+
+    size_t addNode(const Expression* node) {
+        _compiled->_nodes.push_back(node);
+        return _compiled->_nodes.size() - 1;
+    }
+
+    bool evaluateThroughTree(const Expression* expression, size_t dst) {
+        emit(Op::kEvaluate, dst, addNode(expression));
+        return true;
+    }
+
+    bool compileBinary(Op op,
+                       const ExpressionVector& operands,
+                       size_t dst,
+                       bool nullIfLeftNullish,
+                       size_t arg = 0) {
+        if (!compile(operands[0].get(), dst)) {
+            return false;
+        }
+        boost::optional<size_t> jumpIfNullish;
+        if (nullIfLeftNullish) {
+            jumpIfNullish = emit(Op::kJumpIfNullish, dst);
+        }
+        if (!compile(operands[1].get(), dst + 1)) {
+            return false;
+        }
+        emit(op, dst, arg);
+        if (jumpIfNullish) {
+            patchJump(*jumpIfNullish);
+        }
+        ++_numOperators;
+        return true;
+    }
+
+    ExpressionCompiled* _compiled;
+    size_t _numOperators = 0;
+};
+
+ExpressionCompiled::ExpressionCompiled(const boost::intrusive_ptr<Expression>& source)
+    : Expression(source->_expCtx), _source(source) {}
+
+boost::intrusive_ptr<Expression> ExpressionCompiled::compile(
+    const boost::intrusive_ptr<Expression>& expression) {
+    if (dynamic_cast<ExpressionCompiled*>(expression.get())) {
+        return expression;
+    }
+
+    boost::intrusive_ptr<ExpressionCompiled> compiled(new ExpressionCompiled(expression));
+    Compiler compiler(compiled.get());
+    if (!compiler.compile(expression.get(), 0) || !compiler.hasOperators()) {
+        return expression;
+    }
+    return compiled;
+}
+
+Value ExpressionCompiled::evaluate(const Document& root) const {
+    using Op = Instruction::Op;
+    std::array<Value, kMaxRegisters> registers;
+
+    const size_t programSize = _program.size();
+    size_t pc = 0;
+    while (pc < programSize) {
+        const Instruction& instruction = _program[pc++];
+        Value& dst = registers[instruction.dst];
+        switch (instruction.op) {
+            case Op::kLoadConstant:
+                dst = _constants[instruction.arg];
+                break;
+            case Op::kLoadField:
+                dst = root[_fieldNames[instruction.arg]];
+                break;
+            case Op::kEvaluate:
+                dst = _nodes[instruction.arg]->evaluate(root);
+                break;
+            case Op::kAdd:
+                dst = add(dst, registers[instruction.dst + 1]);
+                break;
+            case Op::kSubtract:
+                dst = subtract(dst, registers[instruction.dst + 1]);
+                break;
+            case Op::kMultiply:
+                dst = multiply(dst, registers[instruction.dst + 1]);
+                break;
+            case Op::kDivide:
+                dst = ExpressionDivide::apply(dst, registers[instruction.dst + 1]);
+                break;
+            case Op::kCompare:
+                dst = compare(static_cast<const ExpressionCompare&>(*_nodes[instruction.arg]),
+                              dst,
+                              registers[instruction.dst + 1]);
+                break;
+            case Op::kJump:
+                pc = instruction.arg;
+                break;
+            case Op::kJumpIfFalse:
+                if (!dst.coerceToBool()) {
+                    pc = instruction.arg;
+                }
+                break;
+            case Op::kJumpIfNullish:
+                if (dst.nullish()) {
+                    dst = Value(BSONNULL);
+                    pc = instruction.arg;
+                }
+                break;
+        }
+    }
+
+    return std::move(registers[0]);
+}
+
+}  // namespace mongo
@@ -0,0 +1,137 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mongo/db/pipeline/expression.h"
+
+namespace mongo {
+
+/**
+ * An Expression which evaluates an already-optimized expression tree by running a flat program
+ * over a small array of registers, rather than by recursing through the tree's virtual evaluate()
+ * calls. Top-level field paths, constants, $add, $subtract, $multiply, $divide, the comparison
+ * operators and $cond are compiled into instructions, with dedicated paths for int and double
+ * operands; any other subexpression is evaluated through the original tree.
+ *
+ * The original tree is retained, and serialization and dependency analysis defer to it, so this
+ * expression is indistinguishable from the tree it was compiled from other than in how it is
+ * evaluated.
+ */
+class ExpressionCompiled final : public Expression {
+public:
+    /**
+     * The number of registers available to a compiled program. Expressions which need more are
+     * left uncompiled.
+     */
+    static constexpr size_t kMaxRegisters = 16;
+
+    /**
+     * Returns an ExpressionCompiled equivalent to 'expression', or 'expression' itself if it
+     * contains nothing worth compiling or cannot be compiled. 'expression' should already have been
+     * optimized.
+     */
+    static boost::intrusive_ptr<Expression> compile(
+        const boost::intrusive_ptr<Expression>& expression);
+
+    boost::intrusive_ptr<Expression> optimize() final {
+        return this;
+    }
+
+    Value serialize(bool explain) const final {
+        return _source->serialize(explain);
+    }
+
+    Value evaluate(const Document& root) const final;
+
+    ComputedPaths getComputedPaths(const std::string& exprFieldPath,
+                                   Variables::Id renamingVar) const final {
+        return _source->getComputedPaths(exprFieldPath, renamingVar);
+    }
+
+    /**
+     * Returns the expression tree this program was compiled from.
+     */
+    const boost::intrusive_ptr<Expression>& getSource() const {
+        return _source;
+    }
+
+    /**
+     * Returns the number of instructions in the compiled program.
+     */
+    size_t getProgramSize() const {
+        return _program.size();
+    }
+
+protected:
+    void _doAddDependencies(DepsTracker* deps) const final {
+        _source->addDependencies(deps);
+    }
+
+private:
+    class Compiler;
+
+    struct Instruction {
+        enum class Op : uint8_t {
+            kLoadConstant,  // registers[dst] = _constants[arg]
+            kLoadField,     // registers[dst] = root[_fieldNames[arg]]
+            kEvaluate,      // registers[dst] = _nodes[arg]->evaluate(root)
+            kAdd,           // registers[dst] = registers[dst] + registers[dst + 1]
+            kSubtract,      // registers[dst] = registers[dst] - registers[dst + 1]
+            kMultiply,      // registers[dst] = registers[dst] * registers[dst + 1]
+            kDivide,        // registers[dst] = registers[dst] / registers[dst + 1]
+            kCompare,       // registers[dst] = _nodes[arg] applied to registers[dst, dst + 1]
+            kJump,          // continue at instruction 'arg'
+            kJumpIfFalse,   // continue at instruction 'arg' if registers[dst] is false
+            kJumpIfNullish  // registers[dst] = null and continue at 'arg' if it is nullish
+        };
+
+        Op op;
+        uint8_t dst;
+        uint32_t arg;
+    };
+
+    ExpressionCompiled(const boost::intrusive_ptr<Expression>& source);
+
+    boost::intrusive_ptr<Expression> _source;
+
+    std::vector<Instruction> _program;
+    std::vector<Value> _constants;
+    std::vector<std::string> _fieldNames;
+
+    // Subexpressions evaluated through the tree, and comparisons whose operator and collation the
+    // program defers to. These are owned by '_source'.
+    std::vector<const Expression*> _nodes;
+};
+
+}  // namespace mongo
@@ -0,0 +1,193 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/expression_compiled.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/pipeline/dependencies.h"
+#include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using boost::intrusive_ptr;
+
+/**
+ * Parses and optimizes the expression in the 'expr' field of 'spec'.
+ */
+intrusive_ptr<Expression> parseOptimized(const intrusive_ptr<ExpressionContext>& expCtx,
+                                         const BSONObj& spec) {
+    return Expression::parseOperand(expCtx, spec["expr"], expCtx->variablesParseState)
+        ->optimize();
+}
+
+/**
+ * Asserts that 'compiled' and 'tree' evaluate 'doc' to values of the same type which compare
+ * equal, or both fail with the same error code.
+ */
+void assertSameResult(const intrusive_ptr<Expression>& compiled,
+                      const intrusive_ptr<Expression>& tree,
+                      const Document& doc) {
+    Value expected;
+    try {
+        expected = tree->evaluate(doc);
+    } catch (const AssertionException& ex) {
+        ASSERT_THROWS_CODE(compiled->evaluate(doc), AssertionException, ex.code());
+        return;
+    }
+    Value result = compiled->evaluate(doc);
+    ASSERT_VALUE_EQ(expected, result);
+    ASSERT_EQ(expected.getType(), result.getType());
+}
+
+TEST(ExpressionCompiledTest, ShouldLeaveFieldPathsAndConstantsUncompiled) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    for (auto&& spec : {fromjson("{expr: '$a'}"),
+                        fromjson("{expr: '$a.b'}"),
+                        fromjson("{expr: {$add: [1, 2]}}"),
+                        fromjson("{expr: {$concat: ['$a', '$b']}}")}) {
+        auto expression = parseOptimized(expCtx, spec);
+        ASSERT_EQ(ExpressionCompiled::compile(expression), expression);
+    }
+}
+
+TEST(ExpressionCompiledTest, ShouldNotCompileACompiledExpressionAgain) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto compiled =
+        ExpressionCompiled::compile(parseOptimized(expCtx, fromjson("{expr: {$add: ['$a', 1]}}")));
+    ASSERT(dynamic_cast<ExpressionCompiled*>(compiled.get()));
+    ASSERT_EQ(ExpressionCompiled::compile(compiled), compiled);
+    ASSERT_EQ(compiled->optimize(), compiled);
+}
+
+TEST(ExpressionCompiledTest, ShouldMatchTheTreeForArithmeticOverEveryNumericType) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    const std::vector<Value> values = {Value(3),
+                                       Value(-7),
+                                       Value(std::numeric_limits<int>::max()),
+                                       Value(5LL),
+                                       Value(std::numeric_limits<long long>::max()),
+                                       Value(2.5),
+                                       Value(-0.0),
+                                       Value(std::numeric_limits<double>::quiet_NaN()),
+                                       Value(Decimal128("1.1")),
+                                       Value(Date_t::fromMillisSinceEpoch(1000)),
+                                       Value(0),
+                                       Value(BSONNULL),
+                                       Value(),
+                                       Value("str"_sd)};
+
+    for (auto&& op : {"$add", "$subtract", "$multiply", "$divide", "$eq", "$lt", "$gte", "$cmp"}) {
+        auto tree = parseOptimized(expCtx, BSON("expr" << BSON(op << BSON_ARRAY("$a"
+                                                                                << "$b"))));
+        auto compiled = ExpressionCompiled::compile(tree);
+        ASSERT(dynamic_cast<ExpressionCompiled*>(compiled.get()));
+
+        for (auto&& a : values) {
+            for (auto&& b : values) {
+                assertSameResult(compiled, tree, Document{{"a", a}, {"b", b}});
+            }
+        }
+    }
+}
+
+TEST(ExpressionCompiledTest, ShouldEvaluateNestedExpressionsAndFallBackToTheTree) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto tree = parseOptimized(
+        expCtx,
+        fromjson("{expr: {$cond: [{$gt: [{$multiply: ['$price', '$qty']}, 100]},"
+                 "  {$subtract: [{$multiply: ['$price', '$qty']}, {$abs: '$discount'}]},"
+                 "  {$add: ['$sub.total', 1, 2]}]}}"));
+    auto compiled = ExpressionCompiled::compile(tree);
+    ASSERT(dynamic_cast<ExpressionCompiled*>(compiled.get()));
+
+    ASSERT_VALUE_EQ(Value(190),
+                    compiled->evaluate(Document{{"price", 20}, {"qty", 10}, {"discount", -10}}));
+    ASSERT_VALUE_EQ(Value(8.5),
+                    compiled->evaluate(Document{
+                        {"price", 1}, {"qty", 10}, {"sub", Document{{"total", 5.5}}}}));
+    for (auto&& doc : {Document{{"price", 2.5}, {"qty", 100LL}, {"discount", 3}},
+                       Document{{"price", 1}},
+                       Document{{"sub", Document{{"total", "x"_sd}}}}}) {
+        assertSameResult(compiled, tree, doc);
+    }
+}
+
+TEST(ExpressionCompiledTest, ShouldOnlyEvaluateTheBranchOfCondThatIsTaken) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto compiled = ExpressionCompiled::compile(parseOptimized(
+        expCtx, fromjson("{expr: {$cond: [{$ne: ['$a', 0]}, {$divide: [1, '$a']}, 0]}}")));
+    ASSERT_VALUE_EQ(Value(0.5), compiled->evaluate(Document{{"a", 2}}));
+    ASSERT_VALUE_EQ(Value(0), compiled->evaluate(Document{{"a", 0}}));
+}
+
+TEST(ExpressionCompiledTest, ShouldNotEvaluateTheSecondOperandOfAddAfterANullishFirst) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    for (auto&& op : {"$add", "$multiply"}) {
+        const BSONObj divideByZero = BSON("$divide" << BSON_ARRAY(1 << "$zero"));
+        auto compiled = ExpressionCompiled::compile(parseOptimized(
+            expCtx, BSON("expr" << BSON(op << BSON_ARRAY("$a" << divideByZero)))));
+        ASSERT(dynamic_cast<ExpressionCompiled*>(compiled.get()));
+        ASSERT_VALUE_EQ(Value(BSONNULL), compiled->evaluate(Document{{"zero", 0}}));
+        ASSERT_THROWS_CODE(
+            compiled->evaluate(Document{{"a", 1}, {"zero", 0}}), AssertionException, 16608);
+    }
+}
+
+TEST(ExpressionCompiledTest, ShouldSerializeAndReportDependenciesOfTheSource) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto tree = parseOptimized(expCtx, fromjson("{expr: {$lt: [{$add: ['$a', '$b.c']}, '$d']}}"));
+    auto compiled = ExpressionCompiled::compile(tree);
+    ASSERT(dynamic_cast<ExpressionCompiled*>(compiled.get()));
+    ASSERT_VALUE_EQ(tree->serialize(false), compiled->serialize(false));
+
+    DepsTracker deps;
+    compiled->addDependencies(&deps);
+    ASSERT_EQ(deps.fields.size(), 3UL);
+    ASSERT_EQ(deps.fields.count("a"), 1UL);
+    ASSERT_EQ(deps.fields.count("b.c"), 1UL);
+    ASSERT_EQ(deps.fields.count("d"), 1UL);
+}
+
+TEST(ExpressionCompiledTest, ShouldNotCompileAnExpressionNeedingTooManyRegisters) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    BSONObj expr = BSON("$subtract" << BSON_ARRAY("$a"
+                                                  << "$b"));
+    for (size_t i = 0; i < ExpressionCompiled::kMaxRegisters; ++i) {
+        expr = BSON("$subtract" << BSON_ARRAY("$a" << expr));
+    }
+    auto tree = parseOptimized(expCtx, BSON("expr" << expr));
+    ASSERT_EQ(ExpressionCompiled::compile(tree), tree);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -29,6 +29,8 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/pipeline/expression_context.h"
+
+#include "mongo/db/client.h"
 #include "mongo/db/pipeline/stub_mongo_process_interface.h"
 #include "mongo/db/query/collation/collation_spec.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
@@ -82,6 +84,13 @@ ExpressionContext::ExpressionContext(NamespaceString nss,
       variablesParseState(variables.useIdGenerator()) {}
 
 void ExpressionContext::checkForInterrupt() {
+    // Threads without a Client, like those a $facet runs its sub-pipelines on, may not use the
+    // OperationContext. The thread which started them checks for interrupts in their place. Nor may
+    // this thread while the OperationContext is lent to another one.
+    if (!haveClient() || opCtxLent) {
+        return;
+    }
+
     // This check could be expensive, at least in relative terms, so don't check every time.
     if (--_interruptCounter == 0) {
         invariant(opCtx);
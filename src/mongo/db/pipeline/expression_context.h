@@ -237,6 +237,10 @@ public:
     // Tracks the depth of nested aggregation sub-pipelines. Used to enforce depth limits.
     size_t subPipelineDepth = 0;
 
+    // Set while another thread uses 'opCtx' on this operation's behalf, such as when a $cursor
+    // stage reads ahead. That thread checks for interrupts in the meantime.
+    bool opCtxLent = false;
+
     // If set, this will disallow use of features introduced in versions above the provided version.
     boost::optional<ServerGlobalParams::FeatureCompatibility::Version>
         maxFeatureCompatibilityVersion;
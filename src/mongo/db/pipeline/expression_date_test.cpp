@@ -808,6 +808,39 @@ TEST_F(ExpressionDateToStringTest, FailsForInvalidFormatRegardlessOfInputDate) {
                        18533);
 }
 
+TEST_F(ExpressionDateToStringTest, UsesConstantTimezoneAndFormatAfterOptimization) {
+    auto expCtx = getExpCtx();
+
+    auto spec =
+        fromjson("{$dateToString: {date: '$date', format: '%H:%M', timezone: 'America/New_York'}}");
+    auto dateExp = Expression::parseExpression(expCtx, spec, expCtx->variablesParseState);
+    dateExp = dateExp->optimize();
+    ASSERT_VALUE_EQ(Value("19:00"_sd), dateExp->evaluate(Document{{"date", Date_t{}}}));
+    ASSERT_VALUE_EQ(Value("20:00"_sd),
+                    dateExp->evaluate(Document{{"date", Date_t::fromMillisSinceEpoch(3600000)}}));
+
+    spec = fromjson("{$dateToString: {date: '$date', format: '%H:%M', timezone: '+02:30'}}");
+    dateExp = Expression::parseExpression(expCtx, spec, expCtx->variablesParseState);
+    dateExp = dateExp->optimize();
+    ASSERT_VALUE_EQ(Value("02:30"_sd), dateExp->evaluate(Document{{"date", Date_t{}}}));
+}
+
+TEST_F(ExpressionDateToStringTest, FailsForInvalidConstantTimezoneOrFormatWhenEvaluated) {
+    auto expCtx = getExpCtx();
+
+    auto spec = fromjson("{$dateToString: {date: '$date', timezone: 'invalid'}}");
+    auto dateExp = Expression::parseExpression(expCtx, spec, expCtx->variablesParseState);
+    dateExp = dateExp->optimize();
+    ASSERT_THROWS_CODE(
+        dateExp->evaluate(Document{{"date", Date_t{}}}), AssertionException, 40485);
+
+    spec = fromjson("{$dateToString: {date: '$date', format: '%n'}}");
+    dateExp = Expression::parseExpression(expCtx, spec, expCtx->variablesParseState);
+    dateExp = dateExp->optimize();
+    ASSERT_THROWS_CODE(
+        dateExp->evaluate(Document{{"date", Date_t{}}}), AssertionException, 18536);
+}
+
 }  // namespace ExpressionDateToStringTest
 
 namespace ExpressionDateFromStringTest {
@@ -1394,5 +1427,24 @@ TEST_F(ExpressionDateFromStringTest, OnErrorEvaluatedLazily) {
     ASSERT_THROWS_CODE(dateExp->evaluate(Document{{"date", 5}}), AssertionException, 16608);
 }
 
+TEST_F(ExpressionDateFromStringTest, UsesConstantTimezoneAndFormatAfterOptimization) {
+    auto expCtx = getExpCtx();
+
+    auto spec = fromjson(
+        "{$dateFromString: {dateString: '$date', format: '%d/%m/%Y', timezone: '+01:00'}}");
+    auto dateExp = Expression::parseExpression(expCtx, spec, expCtx->variablesParseState);
+    dateExp = dateExp->optimize();
+    ASSERT_EQ("2017-01-31T23:00:00.000Z",
+              dateExp->evaluate(Document{{"date", "01/02/2017"_sd}}).toString());
+    ASSERT_EQ("2018-02-28T23:00:00.000Z",
+              dateExp->evaluate(Document{{"date", "01/03/2018"_sd}}).toString());
+
+    spec = fromjson("{$dateFromString: {dateString: '$date', timezone: 'invalid'}}");
+    dateExp = Expression::parseExpression(expCtx, spec, expCtx->variablesParseState);
+    dateExp = dateExp->optimize();
+    ASSERT_THROWS_CODE(
+        dateExp->evaluate(Document{{"date", "2017-01-01"_sd}}), AssertionException, 40485);
+}
+
 }  // namespace ExpressionDateFromStringTest
 }  // namespace mongo
@@ -0,0 +1,143 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/stdx/unordered_set.h"
+
+namespace mongo {
+
+/**
+ * A set of the values held by a $lookup's foreignField across the foreign collection, used to skip
+ * querying for local values which cannot match any foreign document.
+ *
+ * Values are kept exactly until their approximate size exceeds 'maxSetBytes'. From then on only a
+ * Bloom filter of 'bloomFilterBytes' is kept, so mayContain() can report false positives but never
+ * false negatives. Equality is decided by the given ValueComparator, which must be the one used by
+ * the $lookup's foreign query so that the two agree on collation.
+ */
+class LookUpForeignValueFilter {
+    MONGO_DISALLOW_COPYING(LookUpForeignValueFilter);
+
+public:
+    LookUpForeignValueFilter(const ValueComparator& comparator,
+                             size_t maxSetBytes,
+                             size_t bloomFilterBytes)
+        : _comparator(comparator),
+          _values(_comparator.makeUnorderedValueSet()),
+          _maxSetBytes(maxSetBytes),
+          _bloomFilterBits(std::max(bloomFilterBytes, size_t(1)) * 8) {}
+
+    void insert(const Value& value) {
+        if (isBloomFilter()) {
+            insertHash(_comparator.hash(value));
+            return;
+        }
+
+        if (!_values.insert(value).second) {
+            return;
+        }
+        _setBytes += value.getApproximateSize();
+        if (_setBytes > _maxSetBytes) {
+            convertToBloomFilter();
+        }
+    }
+
+    /**
+     * Returns false only if no value equal to 'value' has been inserted.
+     */
+    bool mayContain(const Value& value) const {
+        if (!isBloomFilter()) {
+            return _values.count(value) > 0;
+        }
+
+        const uint64_t hash = _comparator.hash(value);
+        const uint64_t step = secondHash(hash);
+        for (size_t i = 0; i < kNumProbes; ++i) {
+            const uint64_t bit = (hash + i * step) % _bloomFilterBits;
+            if (!(_bloomFilter[bit / 64] & (uint64_t(1) << (bit % 64)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isBloomFilter() const {
+        return !_bloomFilter.empty();
+    }
+
+private:
+    // Four probes keep the false positive rate near 1% at ten bits per distinct value.
+    static const size_t kNumProbes = 4;
+
+    // Derives the stride for double hashing from the primary hash. It is forced odd so that it is
+    // never zero.
+    static uint64_t secondHash(uint64_t hash) {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        return hash | 1;
+    }
+
+    void insertHash(uint64_t hash) {
+        const uint64_t step = secondHash(hash);
+        for (size_t i = 0; i < kNumProbes; ++i) {
+            const uint64_t bit = (hash + i * step) % _bloomFilterBits;
+            _bloomFilter[bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+    }
+
+    void convertToBloomFilter() {
+        _bloomFilter.assign((_bloomFilterBits + 63) / 64, 0);
+        for (auto&& value : _values) {
+            insertHash(_comparator.hash(value));
+        }
+        _values.clear();
+        _values.rehash(0);
+        _setBytes = 0;
+    }
+
+    const ValueComparator _comparator;
+    stdx::unordered_set<Value, ValueComparator::Hasher, ValueComparator::EqualTo> _values;
+    size_t _setBytes = 0;
+    const size_t _maxSetBytes;
+
+    const uint64_t _bloomFilterBits;
+    std::vector<uint64_t> _bloomFilter;  // empty until the exact set outgrows '_maxSetBytes'
+};
+
+}  // namespace mongo
@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/lookup_foreign_value_filter.h"
+#include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const ValueComparator defaultComparator{nullptr};
+
+TEST(LookUpForeignValueFilterTest, ExactSetReportsOnlyInsertedValues) {
+    LookUpForeignValueFilter filter(defaultComparator, 1024 * 1024, 1024);
+    filter.insert(Value(1));
+    filter.insert(Value("foo"_sd));
+    filter.insert(Value(Document{{"a", 1}}));
+
+    ASSERT_FALSE(filter.isBloomFilter());
+    ASSERT_TRUE(filter.mayContain(Value(1)));
+    ASSERT_TRUE(filter.mayContain(Value("foo"_sd)));
+    ASSERT_TRUE(filter.mayContain(Value(Document{{"a", 1}})));
+    ASSERT_FALSE(filter.mayContain(Value(2)));
+    ASSERT_FALSE(filter.mayContain(Value("bar"_sd)));
+    ASSERT_FALSE(filter.mayContain(Value(Document{{"a", 2}})));
+}
+
+TEST(LookUpForeignValueFilterTest, NumericValuesOfDifferentTypesAreEqual) {
+    LookUpForeignValueFilter filter(defaultComparator, 1024 * 1024, 1024);
+    filter.insert(Value(1));
+
+    ASSERT_TRUE(filter.mayContain(Value(1LL)));
+    ASSERT_TRUE(filter.mayContain(Value(1.0)));
+    ASSERT_TRUE(filter.mayContain(Value(Decimal128(1))));
+}
+
+TEST(LookUpForeignValueFilterTest, RespectsCollation) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    ValueComparator comparator(&collator);
+    LookUpForeignValueFilter filter(comparator, 1024 * 1024, 1024);
+    filter.insert(Value("FOO"_sd));
+
+    ASSERT_TRUE(filter.mayContain(Value("foo"_sd)));
+    ASSERT_FALSE(filter.mayContain(Value("bar"_sd)));
+}
+
+TEST(LookUpForeignValueFilterTest, BloomFilterHasNoFalseNegatives) {
+    // A tiny exact set limit forces the switch to a Bloom filter almost immediately.
+    LookUpForeignValueFilter filter(defaultComparator, 64, 64 * 1024);
+    for (int i = 0; i < 10000; i += 2) {
+        filter.insert(Value(i));
+    }
+    ASSERT_TRUE(filter.isBloomFilter());
+
+    int falsePositives = 0;
+    for (int i = 0; i < 10000; i += 2) {
+        ASSERT_TRUE(filter.mayContain(Value(i)));
+        if (filter.mayContain(Value(i + 1))) {
+            ++falsePositives;
+        }
+    }
+
+    // 512K bits for 5000 values should give well under 1% false positives.
+    ASSERT_LT(falsePositives, 50);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -190,6 +190,14 @@ public:
     virtual Status attachCursorSourceToPipeline(
         const boost::intrusive_ptr<ExpressionContext>& expCtx, Pipeline* pipeline) = 0;
 
+    /**
+     * Attaches a tailable cursor over the oplog to the start of 'pipeline', whose first stage must
+     * be a $_internalOplogMatch. Used for change stream pipelines which are not themselves the
+     * aggregation being run, and so were not given a cursor source by the aggregate command.
+     */
+    virtual void attachOplogCursorSourceToPipeline(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx, Pipeline* pipeline) = 0;
+
     /**
      * Returns a vector of owned BSONObjs, each of which contains details of an in-progress
      * operation or, optionally, an idle connection. If userMode is kIncludeAllUsers, report
@@ -231,6 +239,19 @@ public:
         const Document& documentKey,
         boost::optional<BSONObj> readConcern) = 0;
 
+    struct ChangeStreamImages {
+        Document preImage;
+        Document postImage;
+    };
+
+    /**
+     * Returns the pre- and post-images recorded for the update of a document in the collection
+     * 'uuid' which was logged at 'ts', or boost::none if the collection does not record them or
+     * they have expired.
+     */
+    virtual boost::optional<ChangeStreamImages> lookupChangeStreamImages(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx, UUID uuid, Timestamp ts) = 0;
+
     /**
      * Returns a vector of all idle (non-pinned) local cursors.
      */
@@ -254,6 +275,17 @@ public:
                                                                 const NamespaceString&,
                                                                 const MatchExpression*) const = 0;
 
+    /**
+     * Returns the profiler entries currently held in this server's OpSampleBuffer, oldest first.
+     */
+    virtual std::vector<BSONObj> getOpSamples(OperationContext* opCtx) const = 0;
+
+    /**
+     * Returns the statistics of the query shapes tracked by this server's QueryShapeStats, most
+     * expensive first.
+     */
+    virtual std::vector<BSONObj> getQueryShapeStats(OperationContext* opCtx) const = 0;
+
     /**
      * Returns true if there is an index on 'nss' with properties that will guarantee that a
      * document with non-array values for each of 'uniqueKeyPaths' will have at most one matching
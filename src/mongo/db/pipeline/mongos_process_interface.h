@@ -52,6 +52,11 @@ public:
         const Document& documentKey,
         boost::optional<BSONObj> readConcern) final;
 
+    boost::optional<ChangeStreamImages> lookupChangeStreamImages(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx, UUID uuid, Timestamp ts) final {
+        MONGO_UNREACHABLE;
+    }
+
     std::vector<GenericCursor> getIdleCursors(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                               CurrentOpUserMode userMode) const final;
 
@@ -118,6 +123,11 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    void attachOplogCursorSourceToPipeline(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                           Pipeline* pipeline) final {
+        MONGO_UNREACHABLE;
+    }
+
     std::string getShardName(OperationContext* opCtx) const final {
         MONGO_UNREACHABLE;
     }
@@ -155,6 +165,20 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    /**
+     * Mongos does not sample operations, and $opSamples fails to parse on mongos.
+     */
+    std::vector<BSONObj> getOpSamples(OperationContext* opCtx) const final {
+        MONGO_UNREACHABLE;
+    }
+
+    /**
+     * Mongos does not plan queries, and $queryShapeStats fails to parse on mongos.
+     */
+    std::vector<BSONObj> getQueryShapeStats(OperationContext* opCtx) const final {
+        MONGO_UNREACHABLE;
+    }
+
     bool uniqueKeyIsSupportedByIndex(const boost::intrusive_ptr<ExpressionContext>&,
                                      const NamespaceString&,
                                      const std::set<FieldPath>& uniqueKeyPaths) const final;
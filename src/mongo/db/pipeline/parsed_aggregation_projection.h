@@ -202,6 +202,14 @@ public:
         return applyProjection(input);
     }
 
+    /**
+     * Apply the projection to a BSON document, producing BSON. Projections without computed fields
+     * override this to copy the parts of 'input' they keep without converting it to a Document.
+     */
+    virtual BSONObj applyProjectionToBson(const BSONObj& input) const {
+        return applyProjection(Document(input)).toBson();
+    }
+
 protected:
     ParsedAggregationProjection(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                 ProjectionDefaultIdPolicy defaultIdPolicy,
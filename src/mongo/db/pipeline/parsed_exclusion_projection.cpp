@@ -127,6 +127,49 @@ Value ExclusionNode::applyProjectionToValue(Value val) const {
     }
 }
 
+void ExclusionNode::applyProjectionToBson(const BSONObj& input, BSONObjBuilder* output) const {
+    for (auto&& elem : input) {
+        auto fieldName = elem.fieldName();
+        if (_excludedFields.find(fieldName) != _excludedFields.end()) {
+            continue;
+        }
+
+        auto child = _children.empty() ? nullptr : getChild(fieldName);
+        if (child && elem.type() == BSONType::Object) {
+            BSONObjBuilder subObj(output->subobjStart(fieldName));
+            child->applyProjectionToBson(elem.embeddedObject(), &subObj);
+            subObj.doneFast();
+        } else if (child && elem.type() == BSONType::Array) {
+            BSONArrayBuilder subArr(output->subarrayStart(fieldName));
+            child->applyProjectionToArrayBson(elem.embeddedObject(), &subArr);
+            subArr.doneFast();
+        } else {
+            output->append(elem);
+        }
+    }
+}
+
+void ExclusionNode::applyProjectionToArrayBson(const BSONObj& input,
+                                               BSONArrayBuilder* output) const {
+    // As in applyProjectionToValue(), numeric paths aren't treated specially, and the exclusion
+    // applies to each document in the array.
+    for (auto&& elem : input) {
+        if (elem.type() == BSONType::Object) {
+            BSONObjBuilder subObj(output->subobjStart());
+            applyProjectionToBson(elem.embeddedObject(), &subObj);
+            subObj.doneFast();
+        } else if (elem.type() == BSONType::Array &&
+                   _arrayRecursionPolicy ==
+                       ProjectionArrayRecursionPolicy::kRecurseNestedArrays) {
+            BSONArrayBuilder subArr(output->subarrayStart());
+            applyProjectionToArrayBson(elem.embeddedObject(), &subArr);
+            subArr.doneFast();
+        } else {
+            output->append(elem);
+        }
+    }
+}
+
 void ExclusionNode::addModifiedPaths(std::set<std::string>* modifiedPaths) const {
     for (auto&& excludedField : _excludedFields) {
         modifiedPaths->insert(FieldPath::getFullyQualifiedPath(_pathToNode, excludedField));
@@ -150,6 +193,12 @@ Document ParsedExclusionProjection::applyProjection(const Document& inputDoc) co
     return _root->applyProjection(inputDoc);
 }
 
+BSONObj ParsedExclusionProjection::applyProjectionToBson(const BSONObj& input) const {
+    BSONObjBuilder output;
+    _root->applyProjectionToBson(input, &output);
+    return output.obj();
+}
+
 void ParsedExclusionProjection::parse(const BSONObj& spec, ExclusionNode* node, size_t depth) {
     bool idSpecified = false;
 
@@ -69,6 +69,11 @@ public:
      */
     Document applyProjection(const Document& input) const;
 
+    /**
+     * Appends the BSON document 'input' to 'output' without the fields this tree excludes.
+     */
+    void applyProjectionToBson(const BSONObj& input, BSONObjBuilder* output) const;
+
     /**
      * Creates the child if it doesn't already exist. 'field' is not allowed to be dotted.
      */
@@ -84,6 +89,9 @@ private:
     // Helper for applyProjection above.
     Value applyProjectionToValue(Value val) const;
 
+    // Helper for applyProjectionToBson above, which projects each element of an array.
+    void applyProjectionToArrayBson(const BSONObj& input, BSONArrayBuilder* output) const;
+
     // Fields excluded at this level.
     stdx::unordered_set<std::string> _excludedFields;
 
@@ -127,6 +135,12 @@ public:
      */
     Document applyProjection(const Document& inputDoc) const final;
 
+    BSONObj applyProjectionToBson(const BSONObj& input) const final;
+
+    bool isSimpleProjection() const final {
+        return true;
+    }
+
     DepsTracker::State addDependencies(DepsTracker* deps) const final {
         return DepsTracker::State::SEE_NEXT;
     }
@@ -523,6 +523,28 @@ TEST(ExclusionProjectionExecutionTest, ShouldNotRetainNestedArraysIfNoRecursionN
     ASSERT_DOCUMENT_EQ(result, expectedResult);
 }
 
+TEST(ExclusionProjectionExecutionTest, ShouldApplyToBsonLikeDocument) {
+    const boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    for (auto policy : {ProjectionArrayRecursionPolicy::kRecurseNestedArrays,
+                        ProjectionArrayRecursionPolicy::kDoNotRecurseNestedArrays}) {
+        ParsedExclusionProjection exclusion(expCtx, ProjectionDefaultIdPolicy::kIncludeId, policy);
+        exclusion.parse(fromjson("{'a.b': 0, c: 0, d: {e: 0}}"));
+        ASSERT_TRUE(exclusion.isSimpleProjection());
+
+        auto input = fromjson(
+            "{_id: 1, a: [1, {b: 2, c: 3}, [{b: 4, c: 5}], {d: 6}], c: 7, d: 8, f: {b: 9, e: "
+            "10}}");
+        ASSERT_BSONOBJ_EQ(exclusion.applyProjection(Document(input)).toBson(),
+                          exclusion.applyProjectionToBson(input));
+    }
+
+    auto exclusion = makeExclusionProjectionWithDefaultPolicies();
+    exclusion.parse(fromjson("{'a.b': 0, c: 0}"));
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1, a: [1, {c: 3}, [{c: 5}]], d: {e: 4}}"),
+                      exclusion.applyProjectionToBson(fromjson(
+                          "{_id: 1, a: [1, {b: 2, c: 3}, [{b: 4, c: 5}]], c: 6, d: {e: 4}}")));
+}
+
 }  // namespace
 }  // namespace parsed_aggregation_projection
 }  // namespace mongo
@@ -32,6 +32,9 @@
 
 #include <algorithm>
 
+#include "mongo/db/pipeline/expression_compiled.h"
+#include "mongo/db/query/query_knobs.h"
+
 namespace mongo {
 
 namespace parsed_aggregation_projection {
@@ -47,8 +50,11 @@ InclusionNode::InclusionNode(ProjectionArrayRecursionPolicy recursionPolicy, std
     : _arrayRecursionPolicy(recursionPolicy), _pathToNode(std::move(pathToNode)) {}
 
 void InclusionNode::optimize() {
+    const bool compileExpressions = internalQueryCompileAggExpressions.load();
     for (auto&& expressionIt : _expressions) {
-        _expressions[expressionIt.first] = expressionIt.second->optimize();
+        auto optimized = expressionIt.second->optimize();
+        _expressions[expressionIt.first] =
+            compileExpressions ? ExpressionCompiled::compile(optimized) : optimized;
     }
     for (auto&& childPair : _children) {
         childPair.second->optimize();
@@ -146,6 +152,49 @@ Value InclusionNode::applyInclusionsToValue(Value inputValue) const {
     }
 }
 
+void InclusionNode::applyInclusionsToBson(const BSONObj& input, BSONObjBuilder* output) const {
+    for (auto&& elem : input) {
+        auto fieldName = elem.fieldName();
+        if (_inclusions.find(fieldName) != _inclusions.end()) {
+            output->append(elem);
+            continue;
+        }
+
+        auto childIt = _children.find(fieldName);
+        if (childIt == _children.end()) {
+            continue;
+        }
+        // As in applyInclusionsToValue(), a value which is neither a document nor an array is left
+        // out when only its children are included.
+        if (elem.type() == BSONType::Object) {
+            BSONObjBuilder subObj(output->subobjStart(fieldName));
+            childIt->second->applyInclusionsToBson(elem.embeddedObject(), &subObj);
+            subObj.doneFast();
+        } else if (elem.type() == BSONType::Array) {
+            BSONArrayBuilder subArr(output->subarrayStart(fieldName));
+            childIt->second->applyInclusionsToArrayBson(elem.embeddedObject(), &subArr);
+            subArr.doneFast();
+        }
+    }
+}
+
+void InclusionNode::applyInclusionsToArrayBson(const BSONObj& input,
+                                               BSONArrayBuilder* output) const {
+    for (auto&& elem : input) {
+        if (elem.type() == BSONType::Object) {
+            BSONObjBuilder subObj(output->subobjStart());
+            applyInclusionsToBson(elem.embeddedObject(), &subObj);
+            subObj.doneFast();
+        } else if (elem.type() == BSONType::Array &&
+                   _arrayRecursionPolicy ==
+                       ProjectionArrayRecursionPolicy::kRecurseNestedArrays) {
+            BSONArrayBuilder subArr(output->subarrayStart());
+            applyInclusionsToArrayBson(elem.embeddedObject(), &subArr);
+            subArr.doneFast();
+        }
+    }
+}
+
 void InclusionNode::addComputedFields(MutableDocument* outputDoc, const Document& root) const {
     for (auto&& field : _orderToProcessAdditionsAndChildren) {
         auto childIt = _children.find(field);
@@ -359,6 +408,13 @@ Document ParsedInclusionProjection::applyProjection(const Document& inputDoc) co
     return output.freeze();
 }
 
+BSONObj ParsedInclusionProjection::applyProjectionToBson(const BSONObj& input) const {
+    invariant(isSimpleProjection());
+    BSONObjBuilder output;
+    _root->applyInclusionsToBson(input, &output);
+    return output.obj();
+}
+
 bool ParsedInclusionProjection::parseObjectAsExpression(
     StringData pathToObject,
     const BSONObj& objSpec,
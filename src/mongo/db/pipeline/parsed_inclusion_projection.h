@@ -88,6 +88,12 @@ public:
      */
     void applyInclusions(const Document& inputDoc, MutableDocument* outputDoc) const;
 
+    /**
+     * Like applyInclusions(), but appends the included parts of the BSON document 'input' to
+     * 'output'. This node must not contain any computed fields.
+     */
+    void applyInclusionsToBson(const BSONObj& input, BSONObjBuilder* output) const;
+
     /**
      * Add computed fields to 'outputDoc'.
      */
@@ -138,12 +144,20 @@ public:
     void addComputedPaths(std::set<std::string>* computedPaths,
                           StringMap<std::string>* renamedPaths) const;
 
+    /**
+     * Returns true if this node or any child of this node contains a computed field.
+     */
+    bool subtreeContainsComputedFields() const;
+
 private:
     // Helpers for the Document versions above. These will apply the transformation recursively to
     // each element of any arrays, and ensure non-documents are handled appropriately.
     Value applyInclusionsToValue(Value inputVal) const;
     Value addComputedFields(Value inputVal, const Document& root) const;
 
+    // Helper for applyInclusionsToBson() above, which projects each element of an array.
+    void applyInclusionsToArrayBson(const BSONObj& input, BSONArrayBuilder* output) const;
+
     /**
      * Returns nullptr if no such child exists.
      */
@@ -154,11 +168,6 @@ private:
      */
     InclusionNode* addChild(std::string field);
 
-    /**
-     * Returns true if this node or any child of this node contains a computed field.
-     */
-    bool subtreeContainsComputedFields() const;
-
     ProjectionArrayRecursionPolicy _arrayRecursionPolicy;
 
     std::string _pathToNode;
@@ -253,6 +262,16 @@ public:
      */
     Document applyProjection(const Document& inputDoc) const final;
 
+    /**
+     * Apply this inclusion projection directly to the BSON document 'input'. Only valid if the
+     * projection has no computed fields.
+     */
+    BSONObj applyProjectionToBson(const BSONObj& input) const final;
+
+    bool isSimpleProjection() const final {
+        return !_root->subtreeContainsComputedFields();
+    }
+
     /*
      * Checks whether the inclusion projection represented by the InclusionNode
      * tree is a subset of the object passed in. Projections that have any
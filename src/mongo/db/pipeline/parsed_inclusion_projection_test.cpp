@@ -965,6 +965,33 @@ TEST(InclusionProjectionSubsetTest, ShouldDetectNonSubsetForProjectionWithMissin
     ASSERT_FALSE(inclusion.isSubsetOfProjection(proj));
 }
 
+TEST(InclusionProjectionExecutionTest, ShouldApplyToBsonLikeDocument) {
+    const boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    for (auto policy : {ProjectionArrayRecursionPolicy::kRecurseNestedArrays,
+                        ProjectionArrayRecursionPolicy::kDoNotRecurseNestedArrays}) {
+        ParsedInclusionProjection inclusion(expCtx, ProjectionDefaultIdPolicy::kIncludeId, policy);
+        inclusion.parse(fromjson("{'a.b': 1, c: 1, d: {e: 1}}"));
+        ASSERT_TRUE(inclusion.isSimpleProjection());
+
+        auto input = fromjson(
+            "{a: [1, {b: 2, c: 3}, [{b: 4, c: 5}], {d: 6}], c: 7, d: 8, _id: 1, f: {b: 9}}");
+        ASSERT_BSONOBJ_EQ(inclusion.applyProjection(Document(input)).toBson(),
+                          inclusion.applyProjectionToBson(input));
+    }
+
+    auto inclusion = makeInclusionProjectionWithDefaultPolicies();
+    inclusion.parse(fromjson("{'a.b': 1, c: 1}"));
+    ASSERT_BSONOBJ_EQ(fromjson("{a: [{b: 2}, [{b: 4}], {}], _id: 1, c: {d: 1}}"),
+                      inclusion.applyProjectionToBson(fromjson(
+                          "{a: [1, {b: 2, c: 3}, [{b: 4, c: 5}], {d: 6}], _id: 1, c: {d: 1}}")));
+}
+
+TEST(InclusionProjectionExecutionTest, ShouldNotBeSimpleProjectionWithComputedFields) {
+    auto inclusion = makeInclusionProjectionWithDefaultPolicies();
+    inclusion.parse(BSON("a" << true << "b.c" << BSON("$literal" << 1)));
+    ASSERT_FALSE(inclusion.isSimpleProjection());
+}
+
 }  // namespace
 }  // namespace parsed_aggregation_projection
 }  // namespace mongo
@@ -420,6 +420,14 @@ std::vector<NamespaceString> Pipeline::getInvolvedCollections() const {
     return collections;
 }
 
+size_t Pipeline::getMemUsage() const {
+    size_t memUsage = 0;
+    for (auto&& source : _sources) {
+        memUsage += source->getMemUsage();
+    }
+    return memUsage;
+}
+
 vector<Value> Pipeline::serialize() const {
     vector<Value> serializedSources;
     for (auto&& source : _sources) {
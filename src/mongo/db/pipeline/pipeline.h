@@ -236,6 +236,12 @@ public:
      */
     std::vector<NamespaceString> getInvolvedCollections() const;
 
+    /**
+     * Returns an estimate of the memory held by the stages of this pipeline. See
+     * DocumentSource::getMemUsage().
+     */
+    size_t getMemUsage() const;
+
     /**
      * Serializes the pipeline into a form that can be parsed into an equivalent pipeline.
      */
@@ -32,6 +32,8 @@
 
 #include "mongo/db/pipeline/pipeline_d.h"
 
+#include <set>
+
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database.h"
@@ -42,6 +44,7 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/fetch.h"
 #include "mongo/db/exec/multi_iterator.h"
+#include "mongo/db/exec/projection_exec_agg.h"
 #include "mongo/db/exec/shard_filter.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/index/index_access_method.h"
@@ -64,6 +67,7 @@
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
@@ -94,27 +98,128 @@ using write_ops::Insert;
 namespace {
 
 /**
- * Returns a PlanExecutor which uses a random cursor to sample documents if successful. Returns {}
- * if the storage engine doesn't support random cursors, or if 'sampleSize' is a large enough
- * percentage of the collection.
+ * A cursor which returns a sample of 'sampleSize' records, taken without replacement, from a
+ * forward scan of a collection of roughly 'numRecords' records. The scan is divided into
+ * 'sampleSize' strata of consecutive records of (nearly) equal length, and one record is chosen
+ * uniformly at random from each, so every record is equally likely to be sampled and the sample
+ * covers the whole RecordId range. Records which are not chosen are skipped without being handed
+ * to the executor.
+ */
+class StratifiedSampleCursor final : public RecordCursor {
+public:
+    StratifiedSampleCursor(std::unique_ptr<RecordCursor> cursor,
+                           long long sampleSize,
+                           long long numRecords,
+                           int64_t seed)
+        : _cursor(std::move(cursor)),
+          _sampleSize(sampleSize),
+          _numRecords(numRecords),
+          _prng(seed) {
+        invariant(_sampleSize <= _numRecords);
+    }
+
+    boost::optional<Record> next() final {
+        if (_nSampled == _sampleSize) {
+            return boost::none;
+        }
+
+        if (_target < _position) {
+            const long long begin = stratumBegin(_nSampled);
+            const long long length = stratumBegin(_nSampled + 1) - begin;
+            _target = std::max(begin + _prng.nextInt64(std::max(length, 1LL)), _position);
+        }
+
+        // Skip over the records in front of the chosen one. The record count is only an estimate,
+        // so the scan may end before the last strata are reached.
+        while (auto record = _cursor->next()) {
+            if (_position++ == _target) {
+                ++_nSampled;
+                return record;
+            }
+        }
+        _nSampled = _sampleSize;
+        return boost::none;
+    }
+
+    void save() final {
+        _cursor->save();
+    }
+
+    bool restore() final {
+        return _cursor->restore();
+    }
+
+    void detachFromOperationContext() final {
+        _cursor->detachFromOperationContext();
+    }
+
+    void reattachToOperationContext(OperationContext* opCtx) final {
+        _cursor->reattachToOperationContext(opCtx);
+    }
+
+private:
+    /**
+     * Returns the position in the scan of the first record in stratum 'stratum'.
+     */
+    long long stratumBegin(long long stratum) const {
+        return static_cast<long long>(static_cast<double>(stratum) * _numRecords / _sampleSize);
+    }
+
+    const std::unique_ptr<RecordCursor> _cursor;
+    const long long _sampleSize;
+    const long long _numRecords;
+    PseudoRandom _prng;
+
+    long long _nSampled = 0;
+
+    // The position in the scan of the next record '_cursor' will return, and of the record chosen
+    // from the current stratum.
+    long long _position = 0;
+    long long _target = -1;
+};
+
+/**
+ * Returns a PlanExecutor which samples documents without sorting the collection if successful. A
+ * random cursor is used if 'sampleSize' is a small enough percentage of the collection, and a
+ * stratified scan is used beyond that if 'allowStratifiedScan' is true and the sample is below
+ * internalQueryStratifiedSampleMaxRatio of the collection; '*usedRandomCursor' reports which.
+ * Returns {} if 'sampleSize' is too large a percentage of the collection for either, or if a random
+ * cursor would have been chosen but the storage engine doesn't support random cursors.
  */
 StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> createRandomCursorExecutor(
-    Collection* collection, OperationContext* opCtx, long long sampleSize, long long numRecords) {
+    Collection* collection,
+    OperationContext* opCtx,
+    long long sampleSize,
+    long long numRecords,
+    bool allowStratifiedScan,
+    bool* usedRandomCursor) {
     double kMaxSampleRatioForRandCursor = 0.05;
-    if (sampleSize > numRecords * kMaxSampleRatioForRandCursor || numRecords <= 100) {
+    if (numRecords <= 100) {
         return {nullptr};
     }
 
-    // Attempt to get a random cursor from the RecordStore.
-    auto rsRandCursor = collection->getRecordStore()->getRandomCursor(opCtx);
-    if (!rsRandCursor) {
-        // The storage engine has no random cursor support.
+    std::unique_ptr<RecordCursor> rsSampleCursor;
+    if (sampleSize <= numRecords * kMaxSampleRatioForRandCursor) {
+        // Attempt to get a random cursor from the RecordStore.
+        rsSampleCursor = collection->getRecordStore()->getRandomCursor(opCtx);
+        if (!rsSampleCursor) {
+            // The storage engine has no random cursor support.
+            return {nullptr};
+        }
+        *usedRandomCursor = true;
+    } else if (allowStratifiedScan &&
+               sampleSize <= numRecords * internalQueryStratifiedSampleMaxRatio.load()) {
+        const int64_t seed = opCtx->getClient()->getPrng().nextInt64();
+        rsSampleCursor = stdx::make_unique<StratifiedSampleCursor>(
+            collection->getRecordStore()->getCursor(opCtx), sampleSize, numRecords, seed);
+        *usedRandomCursor = false;
+    } else {
         return {nullptr};
     }
 
     auto ws = stdx::make_unique<WorkingSet>();
     auto stage = stdx::make_unique<MultiIteratorStage>(opCtx, ws.get(), collection);
-    stage->addIterator(std::move(rsRandCursor));
+    stage->addIterator(std::move(rsSampleCursor));
 
     {
         AutoGetCollectionForRead autoColl(opCtx, collection->ns());
@@ -150,13 +255,15 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
     boost::optional<std::string> groupIdForDistinctScan,
     const AggregationRequest* aggRequest,
     const size_t plannerOpts,
-    const MatchExpressionParser::AllowedFeatureSet& matcherFeatures) {
+    const MatchExpressionParser::AllowedFeatureSet& matcherFeatures,
+    boost::optional<long long> limit = boost::none) {
     auto qr = stdx::make_unique<QueryRequest>(nss);
     qr->setTailableMode(pExpCtx->tailableMode);
     qr->setOplogReplay(oplogReplay);
     qr->setFilter(queryObj);
     qr->setProj(projectionObj);
     qr->setSort(sortObj);
+    qr->setLimit(limit);
     if (aggRequest) {
         qr->setExplain(static_cast<bool>(aggRequest->getExplain()));
         qr->setHint(aggRequest->getHint());
@@ -262,6 +369,40 @@ StringData extractGeoNearFieldFromIndexes(OperationContext* opCtx, Collection* c
     }
     MONGO_UNREACHABLE;
 }
+
+/**
+ * Returns true if 'cursor' may read ahead into 'pipeline'. While a batch loads on another thread,
+ * the pipeline must consume the previous one without using the OperationContext, and without
+ * returning to the caller, who could use it. This holds when the cursor's output only passes
+ * through stages which evaluate expressions before reaching one which consumes all of its input
+ * before producing anything.
+ */
+bool canReadAhead(const Pipeline* pipeline, DocumentSourceCursor* cursor) {
+    const auto& expCtx = pipeline->getContext();
+    if (!internalDocumentSourceCursorReadAhead.load() || expCtx->explain ||
+        expCtx->tailableMode != TailableModeEnum::kNormal || expCtx->inMultiDocumentTransaction ||
+        expCtx->subPipelineDepth > 0) {
+        return false;
+    }
+
+    // A $group over sorted input streams its groups out as soon as each one is complete.
+    if (!cursor->getOutputSorts().empty()) {
+        return false;
+    }
+
+    static const std::set<StringData> kStreamingStages = {
+        "$addFields"_sd, "$match"_sd, "$project"_sd, "$replaceRoot"_sd, "$skip"_sd, "$unwind"_sd};
+    static const std::set<StringData> kBlockingStages = {"$bucketAuto"_sd, "$group"_sd, "$sort"_sd};
+    for (auto&& source : pipeline->getSources()) {
+        if (kBlockingStages.count(source->getSourceName())) {
+            return true;
+        }
+        if (!kStreamingStages.count(source->getSourceName())) {
+            return false;
+        }
+    }
+    return false;
+}
 }  // namespace
 
 void PipelineD::prepareCursorSource(Collection* collection,
@@ -286,12 +427,23 @@ void PipelineD::prepareCursorSource(Collection* collection,
         if (collection && sampleStage) {
             const long long sampleSize = sampleStage->getSampleSize();
             const long long numRecords = collection->getRecordStore()->numRecords(expCtx->opCtx);
-            auto exec = uassertStatusOK(
-                createRandomCursorExecutor(collection, expCtx->opCtx, sampleSize, numRecords));
+            // A stratified sample is returned in collection order, so truncating the merged output
+            // of several shards would favor the documents at the start of each shard.
+            bool usedRandomCursor = false;
+            auto exec = uassertStatusOK(createRandomCursorExecutor(collection,
+                                                                   expCtx->opCtx,
+                                                                   sampleSize,
+                                                                   numRecords,
+                                                                   !expCtx->needsMerge,
+                                                                   &usedRandomCursor));
             if (exec) {
-                // Replace $sample stage with $sampleFromRandomCursor stage.
+                // Replace $sample stage with $sampleFromRandomCursor stage. Only a random cursor
+                // can return the same document twice and needs its results de-duplicated.
                 sources.pop_front();
-                std::string idString = collection->ns().isOplog() ? "ts" : "_id";
+                std::string idString;
+                if (usedRandomCursor) {
+                    idString = collection->ns().isOplog() ? "ts" : "_id";
+                }
                 sources.emplace_front(DocumentSourceSampleFromRandomCursor::create(
                     expCtx, sampleSize, idString, numRecords));
 
@@ -399,8 +551,12 @@ void PipelineD::prepareGenericCursorSource(Collection* collection,
     }
 
     std::unique_ptr<GroupFromFirstDocumentTransformation> rewrittenGroupStage;
+    BSONObj groupSortObj;
     if (groupStage) {
         rewrittenGroupStage = groupStage->rewriteGroupAsTransformOnFirstDocument();
+        if (!sortStage) {
+            groupSortObj = groupStage->getStreamingInputSort().value_or(BSONObj());
+        }
     }
 
     // Create the PlanExecutor.
@@ -412,6 +568,7 @@ void PipelineD::prepareGenericCursorSource(Collection* collection,
                                                 oplogReplay,
                                                 sortStage,
                                                 std::move(rewrittenGroupStage),
+                                                groupSortObj,
                                                 deps,
                                                 queryObj,
                                                 aggRequest,
@@ -419,6 +576,11 @@ void PipelineD::prepareGenericCursorSource(Collection* collection,
                                                 &sortObj,
                                                 &projForQuery));
 
+    if (groupStage && !sources.empty() && sources.front() == groupStage) {
+        // Every executor is planned with NO_BLOCKING_SORT, so any sort order it reports comes from
+        // an index scan, and a $group that directly consumes it may stream over that order.
+        groupStage->setInputSortedByIndex();
+    }
 
     if (!projForQuery.isEmpty() && !sources.empty()) {
         // Check for redundant $project in query with the same specification as the inclusion
@@ -430,12 +592,25 @@ void PipelineD::prepareGenericCursorSource(Collection* collection,
         }
     }
 
-    addCursorSource(pipeline,
-                    DocumentSourceCursor::create(collection, std::move(exec), expCtx),
-                    deps,
-                    queryObj,
-                    sortObj,
-                    projForQuery);
+    auto cursor = DocumentSourceCursor::create(collection, std::move(exec), expCtx);
+    if (!sources.empty() && !deps.getNeedsAnyMetadata() && !expCtx->needsMerge) {
+        // A leading $project which only includes or excludes fields is applied by the cursor to
+        // the BSON from the query system, so that the documents it keeps need not be converted to
+        // Documents and back. Metadata is held in the BSON as '$'-prefixed fields, which such a
+        // projection would drop, so it is only done when no metadata is needed.
+        auto proj =
+            dynamic_cast<DocumentSourceSingleDocumentTransformation*>(sources.front().get());
+        if (proj && proj->isSimpleProjection()) {
+            auto spec = proj->serialize().getDocument()[proj->getSourceName()].getDocument();
+            cursor->setAggregationProjection(ProjectionExecAgg::create(
+                spec.toBson(),
+                ProjectionExecAgg::DefaultIdPolicy::kIncludeId,
+                ProjectionExecAgg::ArrayRecursionPolicy::kRecurseNestedArrays));
+            sources.pop_front();
+        }
+    }
+
+    addCursorSource(pipeline, std::move(cursor), deps, queryObj, sortObj, projForQuery);
 }
 
 void PipelineD::prepareGeoNearCursorSource(Collection* collection,
@@ -474,6 +649,7 @@ void PipelineD::prepareGeoNearCursorSource(Collection* collection,
                                                 false,   /* oplogReplay */
                                                 nullptr, /* sortStage */
                                                 nullptr, /* rewrittenGroupStage */
+                                                BSONObj(), /* groupSortObj */
                                                 deps,
                                                 std::move(fullQuery),
                                                 aggRequest,
@@ -507,6 +683,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
     bool oplogReplay,
     const boost::intrusive_ptr<DocumentSourceSort>& sortStage,
     std::unique_ptr<GroupFromFirstDocumentTransformation> rewrittenGroupStage,
+    const BSONObj& groupSortObj,
     const DepsTracker& deps,
     const BSONObj& queryObj,
     const AggregationRequest* aggRequest,
@@ -605,7 +782,16 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
     }
 
     if (sortStage) {
+        // A $limit coalesced into the $sort is handed to the query system as well, so that a
+        // sorted index scan stops after that many documents and multi-planning can end its trial
+        // period as soon as a plan produces them.
+        boost::optional<long long> limit;
+        if (sortStage->getLimitSrc()) {
+            limit = sortStage->getLimitSrc()->getLimit();
+        }
+
         // See if the query system can provide a non-blocking sort.
+        size_t sortPlannerOpts = plannerOpts;
         auto swExecutorSort =
             attemptToGetExecutor(opCtx,
                                  collection,
@@ -617,8 +803,31 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                  *sortObj,
                                  boost::none, /* groupIdForDistinctScan */
                                  aggRequest,
-                                 plannerOpts,
-                                 matcherFeatures);
+                                 sortPlannerOpts,
+                                 matcherFeatures,
+                                 limit);
+
+        if (!swExecutorSort.isOK() && swExecutorSort != ErrorCodes::QueryPlanKilled && limit &&
+            *limit <= internalDocumentSourceSortMaxPushdownLimit.load()) {
+            // No index provides the sort, but the limit is small enough for the query system's
+            // top-k SORT stage. It only keeps the best 'limit' documents, so the rest are never
+            // converted into Documents for the pipeline.
+            sortPlannerOpts &= ~QueryPlannerParams::NO_BLOCKING_SORT;
+            swExecutorSort =
+                attemptToGetExecutor(opCtx,
+                                     collection,
+                                     nss,
+                                     expCtx,
+                                     oplogReplay,
+                                     queryObj,
+                                     expCtx->needsMerge ? metaSortProjection : emptyProjection,
+                                     *sortObj,
+                                     boost::none, /* groupIdForDistinctScan */
+                                     aggRequest,
+                                     sortPlannerOpts,
+                                     matcherFeatures,
+                                     limit);
+        }
 
         if (swExecutorSort.isOK()) {
             // Success! Now see if the query system can also cover the projection.
@@ -633,8 +842,9 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                      *sortObj,
                                      boost::none, /* groupIdForDistinctScan */
                                      aggRequest,
-                                     plannerOpts,
-                                     matcherFeatures);
+                                     sortPlannerOpts,
+                                     matcherFeatures,
+                                     limit);
 
             std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec;
             if (swExecutorSortAndProj.isOK()) {
@@ -668,6 +878,32 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         }
         // The query system can't provide a non-blocking sort.
         *sortObj = BSONObj();
+    } else if (!groupSortObj.isEmpty() && !projectionObj->isEmpty()) {
+        // See if a covering index can deliver the input to the leading $group ordered by its _id,
+        // which lets the $group stream rather than hash. An index scan that has to fetch may well
+        // be slower than the collection scan it would replace, so only a covered plan is taken.
+        // Unlike the $sort case above, nothing is removed from the pipeline, so we fall through to
+        // the unsorted executors if this fails.
+        auto swExecutorGroupSort = attemptToGetExecutor(opCtx,
+                                                        collection,
+                                                        nss,
+                                                        expCtx,
+                                                        oplogReplay,
+                                                        queryObj,
+                                                        *projectionObj,
+                                                        groupSortObj,
+                                                        boost::none, /* groupIdForDistinctScan */
+                                                        aggRequest,
+                                                        plannerOpts,
+                                                        matcherFeatures);
+        if (swExecutorGroupSort.isOK()) {
+            return std::move(swExecutorGroupSort.getValue());
+        } else if (swExecutorGroupSort == ErrorCodes::QueryPlanKilled) {
+            return {ErrorCodes::OperationFailed,
+                    str::stream() << "Failed to determine whether query system can provide a "
+                                     "non-blocking sort for $group: "
+                                  << swExecutorGroupSort.getStatus().toString()};
+        }
     }
 
     // Either there was no $sort stage, or the query system could not provide a non-blocking
@@ -748,6 +984,9 @@ void PipelineD::addCursorSource(Pipeline* pipeline,
 
         cursor->setProjection(deps.toProjection(), deps.toParsedDeps());
     }
+    if (canReadAhead(pipeline, cursor.get())) {
+        cursor->enableReadAhead();
+    }
     pipeline->addInitialSource(std::move(cursor));
 }
 
@@ -117,6 +117,10 @@ private:
      * Set 'rewrittenGroupStage' when the pipeline uses $match+$sort+$group stages that are
      * compatible with a DISTINCT_SCAN plan that visits the first document in each group
      * (SERVER-9507).
+     *
+     * Set 'groupSortObj' when there is no $sort stage and the leading $group could stream if its
+     * input arrived in that order; it is then requested from the query system as a non-blocking
+     * sort, without being reported back through 'sortObj'.
      */
     static StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> prepareExecutor(
         OperationContext* opCtx,
@@ -127,6 +131,7 @@ private:
         bool oplogReplay,
         const boost::intrusive_ptr<DocumentSourceSort>& sortStage,
         std::unique_ptr<GroupFromFirstDocumentTransformation> rewrittenGroupStage,
+        const BSONObj& groupSortObj,
         const DepsTracker& deps,
         const BSONObj& queryObj,
         const AggregationRequest* aggRequest,
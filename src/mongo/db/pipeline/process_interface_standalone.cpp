@@ -37,15 +37,19 @@
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog/uuid_catalog.h"
+#include "mongo/db/change_stream_images.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/op_sample_buffer.h"
+#include "mongo/db/pipeline/document_source_change_stream.h"
 #include "mongo/db/pipeline/document_source_cursor.h"
 #include "mongo/db/pipeline/pipeline_d.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/session_catalog.h"
 #include "mongo/db/stats/fill_locker_info.h"
+#include "mongo/db/stats/query_shape_stats.h"
 #include "mongo/db/stats/storage_stats.h"
 #include "mongo/db/storage/backup_cursor_hooks.h"
 #include "mongo/db/transaction_participant.h"
@@ -329,6 +333,20 @@ Status MongoInterfaceStandalone::attachCursorSourceToPipeline(
     return Status::OK();
 }
 
+void MongoInterfaceStandalone::attachOplogCursorSourceToPipeline(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, Pipeline* pipeline) {
+    invariant(!pipeline->getSources().empty() &&
+              dynamic_cast<DocumentSourceOplogMatch*>(pipeline->getSources().front().get()));
+
+    AutoGetCollectionForRead autoColl(expCtx->opCtx, NamespaceString::kRsOplogNamespace);
+
+    // Change streams read the oplog with the simple collation, whatever the collation of the
+    // stream itself.
+    auto collatorStash = expCtx->temporarilyChangeCollator(nullptr);
+    PipelineD::prepareCursorSource(
+        autoColl.getCollection(), NamespaceString::kRsOplogNamespace, nullptr, pipeline);
+}
+
 std::string MongoInterfaceStandalone::getShardName(OperationContext* opCtx) const {
     if (ShardingState::get(opCtx)->enabled()) {
         return ShardingState::get(opCtx)->shardId().toString();
@@ -382,6 +400,16 @@ boost::optional<Document> MongoInterfaceStandalone::lookupSingleDocument(
     return lookedUpDocument;
 }
 
+boost::optional<MongoProcessInterface::ChangeStreamImages>
+MongoInterfaceStandalone::lookupChangeStreamImages(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, UUID uuid, Timestamp ts) {
+    auto images = findChangeStreamImages(expCtx->opCtx, uuid, ts);
+    if (!images) {
+        return boost::none;
+    }
+    return ChangeStreamImages{Document(images->preImage), Document(images->postImage)};
+}
+
 BackupCursorState MongoInterfaceStandalone::openBackupCursor(OperationContext* opCtx) {
     auto backupCursorHooks = BackupCursorHooks::get(opCtx->getServiceContext());
     if (backupCursorHooks->enabled()) {
@@ -425,6 +453,14 @@ std::vector<BSONObj> MongoInterfaceStandalone::getMatchingPlanCacheEntryStats(
     return planCache->getMatchingStats(serializer, predicate);
 }
 
+std::vector<BSONObj> MongoInterfaceStandalone::getOpSamples(OperationContext* opCtx) const {
+    return OpSampleBuffer::get(opCtx->getServiceContext())->getSamples();
+}
+
+std::vector<BSONObj> MongoInterfaceStandalone::getQueryShapeStats(OperationContext* opCtx) const {
+    return QueryShapeStats::get(opCtx->getServiceContext()).getStats();
+}
+
 bool MongoInterfaceStandalone::uniqueKeyIsSupportedByIndex(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     const NamespaceString& nss,
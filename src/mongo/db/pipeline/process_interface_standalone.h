@@ -87,6 +87,8 @@ public:
         const MakePipelineOptions opts = MakePipelineOptions{}) final;
     Status attachCursorSourceToPipeline(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                         Pipeline* pipeline) final;
+    void attachOplogCursorSourceToPipeline(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                           Pipeline* pipeline) final;
     std::string getShardName(OperationContext* opCtx) const final;
     std::pair<std::vector<FieldPath>, bool> collectDocumentKeyFields(
         OperationContext* opCtx, NamespaceStringOrUUID nssOrUUID) const override;
@@ -96,6 +98,8 @@ public:
         UUID collectionUUID,
         const Document& documentKey,
         boost::optional<BSONObj> readConcern) final;
+    boost::optional<ChangeStreamImages> lookupChangeStreamImages(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx, UUID uuid, Timestamp ts) final;
     std::vector<GenericCursor> getIdleCursors(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                               CurrentOpUserMode userMode) const final;
     BackupCursorState openBackupCursor(OperationContext* opCtx) final;
@@ -105,6 +109,9 @@ public:
                                                         const NamespaceString&,
                                                         const MatchExpression*) const final;
 
+    std::vector<BSONObj> getOpSamples(OperationContext* opCtx) const final;
+    std::vector<BSONObj> getQueryShapeStats(OperationContext* opCtx) const final;
+
     bool uniqueKeyIsSupportedByIndex(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                      const NamespaceString& nss,
                                      const std::set<FieldPath>& uniqueKeyPaths) const final;
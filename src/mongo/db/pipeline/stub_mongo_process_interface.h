@@ -122,6 +122,11 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    void attachOplogCursorSourceToPipeline(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                           Pipeline* pipeline) override {
+        MONGO_UNREACHABLE;
+    }
+
     std::vector<BSONObj> getCurrentOps(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                        CurrentOpConnectionsMode connMode,
                                        CurrentOpSessionsMode sessionMode,
@@ -149,6 +154,11 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    boost::optional<ChangeStreamImages> lookupChangeStreamImages(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx, UUID uuid, Timestamp ts) override {
+        return boost::none;
+    }
+
     std::vector<GenericCursor> getIdleCursors(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                               CurrentOpUserMode userMode) const {
         MONGO_UNREACHABLE;
@@ -168,6 +178,14 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    std::vector<BSONObj> getOpSamples(OperationContext* opCtx) const override {
+        MONGO_UNREACHABLE;
+    }
+
+    std::vector<BSONObj> getQueryShapeStats(OperationContext* opCtx) const override {
+        MONGO_UNREACHABLE;
+    }
+
     bool uniqueKeyIsSupportedByIndex(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                      const NamespaceString& nss,
                                      const std::set<FieldPath>& uniqueKeyPaths) const override {
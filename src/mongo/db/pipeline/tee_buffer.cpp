@@ -49,6 +49,19 @@ boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferS
 }
 
 DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
+    if (_concurrentConsumers) {
+        if (_sourceExhausted) {
+            return DocumentSource::GetNextResult::makeEOF();
+        }
+        if (_consumers[consumerId].nLeftToReturn == 0) {
+            // The rest of the input is loaded once every consumer has seen this batch.
+            return DocumentSource::GetNextResult::makePauseExecution();
+        }
+        const size_t bufferIndex = _buffer.size() - _consumers[consumerId].nLeftToReturn;
+        --_consumers[consumerId].nLeftToReturn;
+        return _buffer[bufferIndex];
+    }
+
     size_t nConsumersStillProcessingThisBatch =
         std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
             return info.nLeftToReturn > 0;
@@ -75,6 +88,29 @@ DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
     return _buffer[bufferIndex];
 }
 
+void TeeBuffer::setConcurrentConsumers(bool concurrentConsumers) {
+    _concurrentConsumers = concurrentConsumers;
+    if (!_concurrentConsumers) {
+        // Release the source if the last consumers were disposed while running concurrently.
+        disposeSourceIfUnused();
+    }
+}
+
+bool TeeBuffer::loadNextBatchForConcurrentConsumers() {
+    invariant(_concurrentConsumers);
+    if (disposeSourceIfUnused()) {
+        _sourceExhausted = true;
+        return false;
+    }
+
+    loadNextBatch();
+    _sourceExhausted = _buffer.empty();
+    for (auto&& input : _buffer) {
+        input.getDocument().loadAllFields();
+    }
+    return true;
+}
+
 void TeeBuffer::loadNextBatch() {
     _buffer.clear();
     size_t bytesInBuffer = 0;
@@ -103,4 +139,17 @@ void TeeBuffer::loadNextBatch() {
     }
 }
 
+bool TeeBuffer::disposeSourceIfUnused() {
+    if (std::any_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
+            return info.stillInUse;
+        })) {
+        return false;
+    }
+    _buffer.clear();
+    if (_source) {
+        _source->dispose();
+    }
+    return true;
+}
+
 }  // namespace mongo
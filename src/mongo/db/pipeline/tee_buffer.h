@@ -65,13 +65,10 @@ public:
     void dispose(size_t consumerId) {
         _consumers[consumerId].stillInUse = false;
         _consumers[consumerId].nLeftToReturn = 0;
-        if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
-                return info.stillInUse;
-            })) {
-            _buffer.clear();
-            if (_source) {
-                _source->dispose();
-            }
+        if (!_concurrentConsumers) {
+            // Otherwise the consumers may be running on other threads, so the source is released
+            // by the thread which loads their batches instead.
+            disposeSourceIfUnused();
         }
     }
 
@@ -82,6 +79,22 @@ public:
      */
     DocumentSource::GetNextResult getNext(size_t consumerId);
 
+    /**
+     * While 'concurrentConsumers' is set, batches are loaded by
+     * loadNextBatchForConcurrentConsumers() rather than by the consumers themselves, and each
+     * consumer's getNext() and dispose() only touch that consumer's own state, so the consumers may
+     * run on separate threads between loads.
+     */
+    void setConcurrentConsumers(bool concurrentConsumers);
+
+    /**
+     * Loads the next batch for the consumers that are still in use and returns true, or returns
+     * false if there are none left, in which case the source is disposed. Every document of the
+     * batch is fully loaded so that the consumers can read it concurrently. Once the source is
+     * exhausted, getNext() returns EOF. Must not be called while any consumer is running.
+     */
+    bool loadNextBatchForConcurrentConsumers();
+
 private:
     TeeBuffer(size_t nConsumers, size_t bufferSizeBytes);
 
@@ -92,6 +105,12 @@ private:
      */
     void loadNextBatch();
 
+    /**
+     * Clears '_buffer' and disposes '_source' if every consumer has been disposed, and returns
+     * whether it did.
+     */
+    bool disposeSourceIfUnused();
+
     DocumentSource* _source = nullptr;
 
     const size_t _bufferSizeBytes;
@@ -102,5 +121,11 @@ private:
         int nLeftToReturn = 0;
     };
     std::vector<ConsumerInfo> _consumers;
+
+    // Set by setConcurrentConsumers().
+    bool _concurrentConsumers = false;
+
+    // Whether the last batch loaded by loadNextBatchForConcurrentConsumers() came back empty.
+    bool _sourceExhausted = false;
 };
 }  // namespace mongo
@@ -80,5 +80,13 @@ public:
     virtual bool isSubsetOfProjection(const BSONObj& proj) const {
         return false;
     }
+
+    /**
+     * Returns true if this transformer is an inclusion or exclusion projection without any computed
+     * fields, which the query system can apply to BSON documents using ProjectionExecAgg.
+     */
+    virtual bool isSimpleProjection() const {
+        return false;
+    }
 };
 }  // namespace mongo
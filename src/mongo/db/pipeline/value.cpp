@@ -1046,6 +1046,16 @@ bool Value::integral64Bit() const {
     }
 }
 
+void Value::loadLazyFields() const {
+    if (getType() == Object) {
+        getDocument().loadLazyFields();
+    } else if (getType() == Array) {
+        for (auto&& elem : getArray()) {
+            elem.loadLazyFields();
+        }
+    }
+}
+
 size_t Value::getApproximateSize() const {
     switch (getType()) {
         case Code:
@@ -318,6 +318,10 @@ public:
     /// Get the approximate memory size of the value, in bytes. Includes sizeof(Value)
     size_t getApproximateSize() const;
 
+    /// Loads any documents nested in this value which have yet to be converted from BSON. See
+    /// Document::loadLazyFields().
+    void loadLazyFields() const;
+
     /**
      * Calculate a hash value.
      *
@@ -212,19 +212,55 @@ StatusWith<std::unique_ptr<CanonicalQuery>> CanonicalQuery::canonicalize(
     return std::move(cq);
 }
 
+// static
+StatusWith<std::unique_ptr<CanonicalQuery>> CanonicalQuery::canonicalizeParsed(
+    OperationContext* opCtx,
+    std::unique_ptr<QueryRequest> qr,
+    std::unique_ptr<MatchExpression> root,
+    BSONObj backingObj,
+    std::unique_ptr<CollatorInterface> collator,
+    bool canHaveNoopMatchNodes) {
+    auto qrStatus = qr->validate();
+    if (!qrStatus.isOK()) {
+        return qrStatus;
+    }
+
+    root->setCollator(collator.get());
+
+    std::unique_ptr<CanonicalQuery> cq(new CanonicalQuery());
+    cq->_backingObj = std::move(backingObj);
+    const bool rootIsCanonical = true;
+    Status initStatus = cq->init(opCtx,
+                                 std::move(qr),
+                                 canHaveNoopMatchNodes,
+                                 std::move(root),
+                                 std::move(collator),
+                                 rootIsCanonical);
+
+    if (!initStatus.isOK()) {
+        return initStatus;
+    }
+    return std::move(cq);
+}
+
 Status CanonicalQuery::init(OperationContext* opCtx,
                             std::unique_ptr<QueryRequest> qr,
                             bool canHaveNoopMatchNodes,
                             std::unique_ptr<MatchExpression> root,
-                            std::unique_ptr<CollatorInterface> collator) {
+                            std::unique_ptr<CollatorInterface> collator,
+                            bool rootIsCanonical) {
     _qr = std::move(qr);
     _collator = std::move(collator);
 
     _canHaveNoopMatchNodes = canHaveNoopMatchNodes;
 
     // Normalize, sort and validate tree.
-    _root = MatchExpression::optimize(std::move(root));
-    sortTree(_root.get());
+    if (rootIsCanonical) {
+        _root = std::move(root);
+    } else {
+        _root = MatchExpression::optimize(std::move(root));
+        sortTree(_root.get());
+    }
     Status validStatus = isValid(_root.get(), *_qr);
     if (!validStatus.isOK()) {
         return validStatus;
@@ -91,6 +91,22 @@ public:
                                                                     const CanonicalQuery& baseQuery,
                                                                     MatchExpression* root);
 
+    /**
+     * Used for binding the parameters of prepared queries, whose filters are parsed only once.
+     *
+     * 'root' must be the match expression tree of the filter of 'qr', normalized and sorted as
+     * canonicalize() leaves it. It is validated but not normalized again. It may refer to the BSON
+     * of 'backingObj' as well as to that of 'qr', and the query keeps both alive. 'collator' must be
+     * the collator of 'qr', and is set on 'root'.
+     */
+    static StatusWith<std::unique_ptr<CanonicalQuery>> canonicalizeParsed(
+        OperationContext* opCtx,
+        std::unique_ptr<QueryRequest> qr,
+        std::unique_ptr<MatchExpression> root,
+        BSONObj backingObj,
+        std::unique_ptr<CollatorInterface> collator,
+        bool canHaveNoopMatchNodes);
+
     /**
      * Returns true if "query" describes an exact-match query on _id.
      */
@@ -170,18 +186,39 @@ public:
         return _canHaveNoopMatchNodes;
     }
 
+    /**
+     * The selectivity bucket of this query's parameters, if the plan cache buckets its entries
+     * for this shape. It selects among several plan cache entries for the same query shape, but
+     * is not part of the shape itself. Set during executor preparation.
+     */
+    boost::optional<int> getSelectivityBucket() const {
+        return _selectivityBucket;
+    }
+
+    void setSelectivityBucket(boost::optional<int> bucket) {
+        _selectivityBucket = bucket;
+    }
+
 private:
     // You must go through canonicalize to create a CanonicalQuery.
     CanonicalQuery() {}
 
+    /**
+     * Normalizes and sorts 'root' unless 'rootIsCanonical' is true, in which case it must already
+     * be.
+     */
     Status init(OperationContext* opCtx,
                 std::unique_ptr<QueryRequest> qr,
                 bool canHaveNoopMatchNodes,
                 std::unique_ptr<MatchExpression> root,
-                std::unique_ptr<CollatorInterface> collator);
+                std::unique_ptr<CollatorInterface> collator,
+                bool rootIsCanonical = false);
 
     std::unique_ptr<QueryRequest> _qr;
 
+    // BSON other than the filter of '_qr' which '_root' may point into.
+    BSONObj _backingObj;
+
     // _root points into _qr->getFilter()
     std::unique_ptr<MatchExpression> _root;
 
@@ -190,6 +227,8 @@ private:
     std::unique_ptr<CollatorInterface> _collator;
 
     bool _canHaveNoopMatchNodes = false;
+
+    boost::optional<int> _selectivityBucket;
 };
 
 }  // namespace mongo
@@ -31,13 +31,17 @@
 #include "mongo/db/query/collation/collator_interface_icu.h"
 
 #include <unicode/coll.h>
-#include <unicode/sortkey.h>
 
 #include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
 
+namespace {
+// Size of the buffer on the stack into which sort keys are first generated.
+const int32_t kStackSortKeySize = 256;
+}  // namespace
+
 CollatorInterfaceICU::CollatorInterfaceICU(CollationSpec spec,
                                            std::unique_ptr<icu::Collator> collator)
     : CollatorInterface(std::move(spec)), _collator(std::move(collator)) {}
@@ -75,20 +79,24 @@ CollatorInterface::ComparisonKey CollatorInterfaceICU::getComparisonKey(
     StringData stringData) const {
     // A StringPiece is ICU's StringData. They are logically the same abstraction.
     const icu::StringPiece stringPiece(stringData.rawData(), stringData.size());
-
-    UErrorCode status = U_ZERO_ERROR;
-    icu::CollationKey icuKey;
-    _collator->getCollationKey(icu::UnicodeString::fromUTF8(stringPiece), icuKey, status);
+    const auto unicodeString = icu::UnicodeString::fromUTF8(stringPiece);
+
+    // Most sort keys fit on the stack, which saves allocating an icu::CollationKey for each one.
+    // If the key is too long, ICU reports the length it needs and we try again.
+    uint8_t stackBuffer[kStackSortKeySize];
+    std::unique_ptr<uint8_t[]> heapBuffer;
+    uint8_t* keyBuffer = stackBuffer;
+    int32_t keyLength = _collator->getSortKey(unicodeString, keyBuffer, kStackSortKeySize);
+    if (keyLength > kStackSortKeySize) {
+        heapBuffer.reset(new uint8_t[keyLength]);
+        keyBuffer = heapBuffer.get();
+        keyLength = _collator->getSortKey(unicodeString, keyBuffer, keyLength);
+    }
 
     // Any sequence of bytes, even invalid UTF-8, has defined comparison behavior in ICU (invalid
-    // subsequences are weighted as the replacement character, U+FFFD). A non-ok error code is only
+    // subsequences are weighted as the replacement character, U+FFFD). A zero length is only
     // expected when a memory allocation fails inside ICU, which we consider fatal to the process.
-    fassert(34439, U_SUCCESS(status));
-
-    int32_t keyLength;
-    const uint8_t* keyBuffer = icuKey.getByteArray(keyLength);
-    invariant(keyLength > 0);
-    invariant(keyBuffer);
+    fassert(34439, keyLength > 0);
 
     // The last byte of the sort key should always be null. When we construct the comparison key, we
     // omit the trailing null byte.
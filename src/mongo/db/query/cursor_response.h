@@ -87,6 +87,16 @@ public:
         _numDocs++;
     }
 
+    /**
+     * Makes room for 'bytes' more bytes of batch in the reply buffer, so that building a large
+     * batch does not repeatedly reallocate and copy the documents already appended.
+     */
+    void reserveBatchBytes(int bytes) {
+        invariant(_active);
+        auto& bb = _options.useDocumentSequences ? _docSeqBuilder->bb() : _batch->bb();
+        bb.ensureCapacity(bytes);
+    }
+
     void setLatestOplogTimestamp(Timestamp ts) {
         _latestOplogTimestamp = ts;
     }
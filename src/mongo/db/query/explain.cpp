@@ -146,7 +146,7 @@ size_t getKeysExamined(StageType type, const SpecificStats* specific) {
     if (STAGE_IXSCAN == type) {
         const IndexScanStats* spec = static_cast<const IndexScanStats*>(specific);
         return spec->keysExamined;
-    } else if (STAGE_IDHACK == type) {
+    } else if (STAGE_IDHACK == type || STAGE_BATCHED_IDHACK == type) {
         const IDHackStats* spec = static_cast<const IDHackStats*>(specific);
         return spec->keysExamined;
     } else if (STAGE_COUNT_SCAN == type) {
@@ -176,7 +176,7 @@ size_t getDocsExamined(StageType type, const SpecificStats* specific) {
     } else if (STAGE_FETCH == type) {
         const FetchStats* spec = static_cast<const FetchStats*>(specific);
         return spec->docsExamined;
-    } else if (STAGE_IDHACK == type) {
+    } else if (STAGE_IDHACK == type || STAGE_BATCHED_IDHACK == type) {
         const IDHackStats* spec = static_cast<const IDHackStats*>(specific);
         return spec->docsExamined;
     } else if (STAGE_TEXT_OR == type) {
@@ -440,6 +440,9 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->docsExamined);
             bob->appendNumber("alreadyHasObj", spec->alreadyHasObj);
+            if (spec->batchesFetched > 0) {
+                bob->appendNumber("batchesFetched", spec->batchesFetched);
+            }
         }
     } else if (STAGE_GEO_NEAR_2D == stats.stageType || STAGE_GEO_NEAR_2DSPHERE == stats.stageType) {
         NearStats* spec = static_cast<NearStats*>(stats.specific.get());
@@ -467,7 +470,7 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("nGroups", spec->nGroups);
         }
-    } else if (STAGE_IDHACK == stats.stageType) {
+    } else if (STAGE_IDHACK == stats.stageType || STAGE_BATCHED_IDHACK == stats.stageType) {
         IDHackStats* spec = static_cast<IDHackStats*>(stats.specific.get());
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("keysExamined", spec->keysExamined);
@@ -955,10 +958,10 @@ void Explain::getSummaryStats(const PlanExecutor& exec, PlanSummaryStats* statsO
             const CountScanStats* countScanStats =
                 static_cast<const CountScanStats*>(countScan->getSpecificStats());
             statsOut->indexesUsed.insert(countScanStats->indexName);
-        } else if (STAGE_IDHACK == stages[i]->stageType()) {
-            const IDHackStage* idHackStage = static_cast<const IDHackStage*>(stages[i]);
+        } else if (STAGE_IDHACK == stages[i]->stageType() ||
+                   STAGE_BATCHED_IDHACK == stages[i]->stageType()) {
             const IDHackStats* idHackStats =
-                static_cast<const IDHackStats*>(idHackStage->getSpecificStats());
+                static_cast<const IDHackStats*>(stages[i]->getSpecificStats());
             statsOut->indexesUsed.insert(idHackStats->indexName);
         } else if (STAGE_DISTINCT_SCAN == stages[i]->stageType()) {
             const DistinctScan* distinctScan = static_cast<const DistinctScan*>(stages[i]);
@@ -45,9 +45,10 @@ namespace mongo {
 
 using std::set;
 
-BSONObj ExpressionMapping::hash(const BSONElement& value) {
+BSONObj ExpressionMapping::hash(const BSONElement& value, int hashVersion) {
     BSONObjBuilder bob;
-    bob.append("", BSONElementHasher::hash64(value, BSONElementHasher::DEFAULT_HASH_SEED));
+    bob.append("",
+               BSONElementHasher::hash64(value, BSONElementHasher::DEFAULT_HASH_SEED, hashVersion));
     return bob.obj();
 }
 
@@ -184,8 +185,17 @@ void ExpressionMapping::S2CellIdsToIntervals(const std::vector<S2CellId>& interv
 void ExpressionMapping::S2CellIdsToIntervalsWithParents(const std::vector<S2CellId>& intervalSet,
                                                         const S2IndexingParams& indexParams,
                                                         OrderedIntervalList* oilOut) {
-    // There may be duplicates when going up parent cells if two cells share a parent
-    std::unordered_set<S2CellId> exactSet;  // NOLINT
+    std::unordered_set<S2CellId> scannedParents;  // NOLINT
+    S2CellIdsToIntervalsWithParents(intervalSet, indexParams, oilOut, &scannedParents);
+}
+
+void ExpressionMapping::S2CellIdsToIntervalsWithParents(
+    const std::vector<S2CellId>& intervalSet,
+    const S2IndexingParams& indexParams,
+    OrderedIntervalList* oilOut,
+    std::unordered_set<S2CellId>* scannedParents) {  // NOLINT
+    // Parent cells shared by several cells are only added once, as 'scannedParents' dedups them
+    std::vector<S2CellId> exactSet;
     for (const S2CellId& interval : intervalSet) {
         S2CellId coveredCell = interval;
         // Look at the cells that cover us.  We want to look at every cell that contains the
@@ -209,7 +219,12 @@ void ExpressionMapping::S2CellIdsToIntervalsWithParents(const std::vector<S2Cell
             // coarsestIndexedLevel - this can result in S2 failures when level < 0.
 
             coveredCell = coveredCell.parent();
-            exactSet.insert(coveredCell);
+
+            // Every parent of a cell which has already been scanned has been scanned as well.
+            if (!scannedParents->insert(coveredCell).second) {
+                break;
+            }
+            exactSet.push_back(coveredCell);
         }
     }
 
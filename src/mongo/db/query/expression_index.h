@@ -28,9 +28,11 @@
 
 #pragma once
 
+#include <unordered_set>
 #include <vector>
 
 #include "mongo/db/geo/hash.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/geo/shapes.h"
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/jsobj.h"
@@ -48,7 +50,11 @@ namespace mongo {
  */
 class ExpressionMapping {
 public:
-    static BSONObj hash(const BSONElement& value);
+    /**
+     * Returns the key of a hashed index with the given 'hashVersion' for 'value'.
+     */
+    static BSONObj hash(const BSONElement& value,
+                        int hashVersion = BSONElementHasher::DEFAULT_HASH_VERSION);
 
     static std::vector<GeoHash> get2dCovering(const R2Region& region,
                                               const BSONObj& indexInfoObj,
@@ -74,6 +80,15 @@ public:
                                                 const S2IndexingParams& indexParams,
                                                 OrderedIntervalList* out);
 
+    // As above, but skips the parent cells in 'scannedParents' and adds the parent cells it
+    // generates to it. A caller which scans several coverings in turn with the same bounds
+    // otherwise re-reads the same coarse cells for each covering.
+    static void S2CellIdsToIntervalsWithParents(
+        const std::vector<S2CellId>& interval,
+        const S2IndexingParams& indexParams,
+        OrderedIntervalList* out,
+        std::unordered_set<S2CellId>* scannedParents);  // NOLINT
+
     static void cover2dsphere(const S2Region& region,
                               const S2IndexingParams& indexParams,
                               OrderedIntervalList* oilOut);
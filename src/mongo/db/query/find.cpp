@@ -151,7 +151,7 @@ void endQueryOp(OperationContext* opCtx,
         collection->infoCache()->notifyOfQuery(opCtx, summaryStats.indexesUsed);
     }
 
-    if (curOp->shouldDBProfile()) {
+    if (curOp->shouldCollectExecStats()) {
         BSONObjBuilder statsBob;
         Explain::getWinningPlanStats(&exec, &statsBob);
         curOp->debug().execStats = statsBob.obj();
@@ -462,7 +462,7 @@ Message getMore(OperationContext* opCtx,
         // the original request and subsequent getMore. It would be useful to have this information
         // for an aggregation, but the source PlanExecutor could be destroyed before we know whether
         // we need execStats and we do not want to generate for all operations due to cost.
-        if (!CursorManager::isGloballyManagedCursor(cursorid) && curOp.shouldDBProfile()) {
+        if (!CursorManager::isGloballyManagedCursor(cursorid) && curOp.shouldCollectExecStats()) {
             BSONObjBuilder execStatsBob;
             Explain::getWinningPlanStats(exec, &execStatsBob);
             curOp.debug().execStats = execStatsBob.obj();
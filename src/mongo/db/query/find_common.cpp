@@ -30,6 +30,8 @@
 
 #include "mongo/db/query/find_common.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/query/query_request.h"
@@ -68,6 +70,17 @@ bool FindCommon::haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int
     return (bytesBuffered + nextDoc.objsize()) <= kMaxBytesToReturnToClientAtOnce;
 }
 
+int FindCommon::estimateRemainingBatchBytes(const BSONObj& firstDoc, long long batchSize) {
+    if (batchSize <= 1) {
+        return 0;
+    }
+
+    // Array batches also spend a type byte and a decimal index per document; allow for that.
+    const long long perDocBytes = firstDoc.objsize() + 8;
+    const long long maxDocs = kMaxBytesToReturnToClientAtOnce / perDocBytes;
+    return static_cast<int>(std::min(batchSize - 1, maxDocs) * perDocBytes);
+}
+
 BSONObj FindCommon::transformSortSpec(const BSONObj& sortSpec) {
     BSONObjBuilder comparatorBob;
 
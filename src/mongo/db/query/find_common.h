@@ -110,6 +110,13 @@ public:
      */
     static bool haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int bytesBuffered);
 
+    /**
+     * Returns the number of bytes worth reserving for the rest of a batch of 'batchSize' documents,
+     * extrapolated from the size of its first document and capped at the reply size limit. Returns
+     * zero when 'batchSize' is zero, since such a batch may end anywhere below the limit.
+     */
+    static int estimateRemainingBatchBytes(const BSONObj& firstDoc, long long batchSize);
+
     /**
      * Transforms the raw sort spec into one suitable for use as the ordering specification in
      * BSONObj::woCompare().
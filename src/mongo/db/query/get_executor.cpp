@@ -33,12 +33,14 @@
 #include "mongo/db/query/get_executor.h"
 
 #include <boost/optional.hpp>
+#include <cmath>
 #include <limits>
 #include <memory>
 
 #include "mongo/base/error_codes.h"
 #include "mongo/base/parse_number.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/exec/batched_idhack.h"
 #include "mongo/db/exec/cached_plan.h"
 #include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/count.h"
@@ -51,10 +53,12 @@
 #include "mongo/db/exec/sort_key_generator.h"
 #include "mongo/db/exec/subplan.h"
 #include "mongo/db/exec/update.h"
+#include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_access_method.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/ops/update_lifecycle.h"
 #include "mongo/db/query/canonical_query.h"
@@ -64,6 +68,7 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/plan_pruner.h"
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
 #include "mongo/db/query/planner_wildcard_helpers.h"
@@ -263,6 +268,89 @@ struct PrepareExecutionResult {
     unique_ptr<PlanStage> root;
 };
 
+/**
+ * Returns the selectivity bucket of 'cq', the base-10 order of magnitude of the number of index
+ * keys matching its first top-level equality predicate on the leading field of an eligible btree
+ * index, or boost::none if the query has no such predicate. The probe stops counting once the
+ * count reaches the top bucket, so it touches at most 10^(buckets - 1) keys.
+ */
+boost::optional<int> computeSelectivityBucket(OperationContext* opCtx,
+                                              Collection* collection,
+                                              const CanonicalQuery& cq,
+                                              const QueryPlannerParams& plannerParams,
+                                              int numBuckets) {
+    if (numBuckets < 2 || cq.getCollator()) {
+        return boost::none;
+    }
+
+    std::vector<const EqualityMatchExpression*> equalities;
+    auto addIfEquality = [&equalities](const MatchExpression* expr) {
+        if (expr->matchType() == MatchExpression::EQ) {
+            equalities.push_back(static_cast<const EqualityMatchExpression*>(expr));
+        }
+    };
+    addIfEquality(cq.root());
+    if (cq.root()->matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < cq.root()->numChildren(); ++i) {
+            addIfEquality(cq.root()->getChild(i));
+        }
+    }
+
+    for (auto&& eq : equalities) {
+        const BSONElement value = eq->getData();
+        if (value.type() == BSONType::Array || value.type() == BSONType::Object ||
+            value.type() == BSONType::RegEx) {
+            continue;
+        }
+
+        for (auto&& entry : plannerParams.indices) {
+            if (entry.type != INDEX_BTREE || entry.collator || entry.filterExpr || entry.sparse ||
+                entry.keyPattern.firstElementFieldName() != eq->path()) {
+                continue;
+            }
+
+            const IndexDescriptor* desc = collection->getIndexCatalog()->findIndexByName(
+                opCtx, entry.identifier.catalogName);
+            if (!desc) {
+                continue;
+            }
+            const IndexAccessMethod* iam = collection->getIndexCatalog()->getIndex(desc);
+
+            // Bracket every key whose leading component equals 'value'.
+            BSONObjBuilder startKey;
+            BSONObjBuilder endKey;
+            bool leading = true;
+            for (auto&& keyElem : entry.keyPattern) {
+                if (leading) {
+                    startKey.appendAs(value, "");
+                    endKey.appendAs(value, "");
+                    leading = false;
+                } else if (keyElem.number() >= 0) {
+                    startKey.appendMinKey("");
+                    endKey.appendMaxKey("");
+                } else {
+                    startKey.appendMaxKey("");
+                    endKey.appendMinKey("");
+                }
+            }
+
+            const long long limit = std::pow(10, numBuckets - 1);
+            auto cursor = iam->newCursor(opCtx);
+            cursor->setEndPosition(endKey.obj(), true);
+            const auto parts = SortedDataInterface::Cursor::kJustExistance;
+            long long count = 0;
+            for (auto kv = cursor->seek(startKey.obj(), true, parts); kv && count < limit;
+                 kv = cursor->next(parts)) {
+                ++count;
+            }
+
+            return count == 0 ? 0 : std::min(static_cast<int>(std::log10(count)), numBuckets - 1);
+        }
+    }
+
+    return boost::none;
+}
+
 /**
  * Build an execution tree for the query described in 'canonicalQuery'.
  *
@@ -307,11 +395,21 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
 
     const IndexDescriptor* descriptor = collection->getIndexCatalog()->findIdIndex(opCtx);
 
-    // If we have an _id index we can use an idhack plan.
-    if (descriptor && IDHackStage::supportsQuery(collection, *canonicalQuery)) {
+    // If we have an _id index we can use an idhack plan, or for a large $in over _id values its
+    // batched variant.
+    const bool useIdHack = descriptor && IDHackStage::supportsQuery(collection, *canonicalQuery);
+    const bool useBatchedIdHack = descriptor && !useIdHack &&
+        BatchedIDHackStage::supportsQuery(collection, *canonicalQuery);
+    if (useIdHack || useBatchedIdHack) {
         LOG(2) << "Using idhack: " << redact(canonicalQuery->toStringShort());
 
-        root = make_unique<IDHackStage>(opCtx, collection, canonicalQuery.get(), ws, descriptor);
+        if (useIdHack) {
+            root =
+                make_unique<IDHackStage>(opCtx, collection, canonicalQuery.get(), ws, descriptor);
+        } else {
+            root = make_unique<BatchedIDHackStage>(
+                opCtx, collection, canonicalQuery.get(), ws, descriptor);
+        }
 
         // Might have to filter out orphaned docs.
         if (plannerParams.options & QueryPlannerParams::INCLUDE_SHARD_FILTER) {
@@ -368,14 +466,24 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
 
     // Check that the query should be cached.
     if (collection->infoCache()->getPlanCache()->shouldCacheQuery(*canonicalQuery)) {
-        auto planCacheKey = collection->infoCache()->getPlanCache()->computeKey(*canonicalQuery);
+        auto planCache = collection->infoCache()->getPlanCache();
+        auto planCacheKey = planCache->computeKey(*canonicalQuery);
 
         // Fill in opDebug information.
         CurOp::get(opCtx)->debug().queryHash = PlanCache::computeQueryHash(planCacheKey);
 
+        // Queries of the same shape whose parameters differ in selectivity by orders of magnitude
+        // may want different plans, so optionally cache a plan per selectivity bucket.
+        canonicalQuery->setSelectivityBucket(
+            computeSelectivityBucket(opCtx,
+                                     collection,
+                                     *canonicalQuery,
+                                     plannerParams,
+                                     internalQueryCacheSelectivityBuckets.load()));
+
         // Try to look up a cached solution for the query.
         if (auto cs =
-                collection->infoCache()->getPlanCache()->getCacheEntryIfActive(planCacheKey)) {
+                planCache->getCacheEntryIfActive(planCache->computeEntryKey(*canonicalQuery))) {
             // We have a CachedSolution.  Have the planner turn it into a QuerySolution.
             auto statusWithQs = QueryPlanner::planFromCache(*canonicalQuery, plannerParams, *cs);
 
@@ -451,6 +559,13 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
         }
     }
 
+    // Estimate the cost of each candidate so that only the cheapest are raced.
+    PlanPruner::prune(opCtx,
+                      collection,
+                      internalQueryPlannerMaxCandidatesForTrial.load(),
+                      internalQueryPlannerCostEstimateProbeLimit.load(),
+                      &solutions);
+
     if (1 == solutions.size()) {
         // Only one possible plan.  Run it.  Build the stages from the solution.
         PlanStage* rawRoot;
@@ -1339,8 +1454,10 @@ bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
 
     if (indexScanNode->index.type == IndexType::INDEX_WILDCARD) {
         // If the query is on a field other than the distinct key, we may have generated a $** plan
-        // which does not actually contain the distinct key field.
-        if (field != std::next(indexScanNode->index.keyPattern.begin())->fieldName()) {
+        // which does not actually contain the distinct key field. The leading fields of a compound
+        // $** index may span many values, so we do not turn its scan into a DISTINCT_SCAN.
+        if (indexScanNode->index.keyPattern.nFields() != 2 ||
+            field != std::next(indexScanNode->index.keyPattern.begin())->fieldName()) {
             return false;
         }
         // If the query includes object bounds, we cannot turn this IXSCAN into a DISTINCT_SCAN.
@@ -48,6 +48,8 @@
 #include "mongo/db/query/planner_ixselect.h"
 #include "mongo/db/query/planner_wildcard_helpers.h"
 #include "mongo/db/query/query_knobs.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "third_party/s2/s2cell.h"
@@ -119,6 +121,11 @@ const Interval kHashedUndefinedInterval = IndexBoundsBuilder::makePointInterval(
 const Interval kHashedNullInterval =
     IndexBoundsBuilder::makePointInterval(ExpressionMapping::hash(kNullElementObj.firstElement()));
 
+// Returns the hash function version of 'index', which only matters if it is a hashed index.
+int hashVersionOf(const IndexEntry& index) {
+    return index.infoObj["hashVersion"].numberInt();
+}
+
 void makeNullEqualityBounds(const IndexEntry& index,
                             bool isHashed,
                             OrderedIntervalList* oil,
@@ -128,14 +135,81 @@ void makeNullEqualityBounds(const IndexEntry& index,
     *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
 
     // There are two values that could possibly be equal to null in an index: undefined and null.
-    oil->intervals.push_back(isHashed
-                                 ? kHashedUndefinedInterval
-                                 : IndexBoundsBuilder::makePointInterval(kUndefinedElementObj));
-    oil->intervals.push_back(isHashed ? kHashedNullInterval
-                                      : IndexBoundsBuilder::makePointInterval(kNullElementObj));
+    const int hashVersion = hashVersionOf(index);
+    if (!isHashed) {
+        oil->intervals.push_back(IndexBoundsBuilder::makePointInterval(kUndefinedElementObj));
+        oil->intervals.push_back(IndexBoundsBuilder::makePointInterval(kNullElementObj));
+    } else if (hashVersion == BSONElementHasher::DEFAULT_HASH_VERSION) {
+        oil->intervals.push_back(kHashedUndefinedInterval);
+        oil->intervals.push_back(kHashedNullInterval);
+    } else {
+        oil->intervals.push_back(IndexBoundsBuilder::makePointInterval(
+            ExpressionMapping::hash(kUndefinedElementObj.firstElement(), hashVersion)));
+        oil->intervals.push_back(IndexBoundsBuilder::makePointInterval(
+            ExpressionMapping::hash(kNullElementObj.firstElement(), hashVersion)));
+    }
     // Just to be sure, make sure the bounds are in the right order if the hash values are opposite.
     IndexBoundsBuilder::unionize(oil);
 }
+
+/**
+ * The unionized intervals which the equalities of an InMatchExpression translate to, kept for each
+ * index collation and hashing they have been translated for. Attached to the equalities, so that
+ * every clone of the expression made while planning a query reuses them.
+ */
+class InEqualityBounds final : public InMatchExpression::PlannerData {
+public:
+    struct Bounds {
+        std::unique_ptr<CollatorInterface> collator;
+        bool isHashed;
+        int hashVersion;
+        std::vector<Interval> intervals;
+        IndexBoundsBuilder::BoundsTightness tightness;
+    };
+
+    /**
+     * Returns the bounds of the equalities of 'ime' for 'index', translating them on first use.
+     */
+    std::shared_ptr<const Bounds> get(const InMatchExpression* ime,
+                                      const IndexEntry& index,
+                                      bool isHashed) {
+        const int hashVersion = isHashed ? hashVersionOf(index) : 0;
+        {
+            stdx::lock_guard<stdx::mutex> lock(_mutex);
+            for (auto&& bounds : _bounds) {
+                if (bounds->isHashed == isHashed && bounds->hashVersion == hashVersion &&
+                    CollatorInterface::collatorsMatch(bounds->collator.get(), index.collator)) {
+                    return bounds;
+                }
+            }
+        }
+
+        auto bounds = std::make_shared<Bounds>();
+        bounds->collator = index.collator ? index.collator->clone() : nullptr;
+        bounds->isHashed = isHashed;
+        bounds->hashVersion = hashVersion;
+        bounds->tightness = IndexBoundsBuilder::EXACT;
+
+        OrderedIntervalList oil;
+        IndexBoundsBuilder::BoundsTightness tightness;
+        for (auto&& equality : ime->getEqualities()) {
+            IndexBoundsBuilder::translateEquality(equality, index, isHashed, &oil, &tightness);
+            if (tightness != IndexBoundsBuilder::EXACT) {
+                bounds->tightness = tightness;
+            }
+        }
+        IndexBoundsBuilder::unionize(&oil);
+        bounds->intervals = std::move(oil.intervals);
+
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        _bounds.push_back(bounds);
+        return bounds;
+    }
+
+private:
+    stdx::mutex _mutex;
+    std::vector<std::shared_ptr<const Bounds>> _bounds;
+};
 }  // namespace
 
 string IndexBoundsBuilder::simpleRegex(const char* regex,
@@ -343,8 +417,10 @@ void IndexBoundsBuilder::translate(const MatchExpression* expr,
 
     // Under certain circumstances, queries on a $** index require that the bounds' tightness be
     // adjusted regardless of the predicate. Having filled out the initial bounds, we apply any
-    // necessary changes to the tightness here.
-    if (index.type == IndexType::INDEX_WILDCARD) {
+    // necessary changes to the tightness here. The prefix fields of a compound $** index, which
+    // follow the query path during planning, are bounded as in any other index.
+    if (index.type == IndexType::INDEX_WILDCARD &&
+        elt.fieldNameStringData() == index.keyPattern.firstElement().fieldNameStringData()) {
         *tightnessOut = wcp::translateWildcardIndexBoundsAndTightness(index, *tightnessOut, oilOut);
     }
 }
@@ -665,17 +741,16 @@ void IndexBoundsBuilder::_translatePredicate(const MatchExpression* expr,
     } else if (MatchExpression::MATCH_IN == expr->matchType()) {
         const InMatchExpression* ime = static_cast<const InMatchExpression*>(expr);
 
-        *tightnessOut = IndexBoundsBuilder::EXACT;
-
-        // Create our various intervals.
+        // Create our various intervals. Those of the equalities, which may number in the
+        // thousands, are translated once per index collation and shared by the clones of 'ime'.
+        auto* equalityBounds = static_cast<InEqualityBounds*>(ime->getOrCreatePlannerData(
+            [] { return stdx::make_unique<InEqualityBounds>(); }));
+        auto bounds = equalityBounds->get(ime, index, isHashed);
+        oilOut->intervals = bounds->intervals;
+        *tightnessOut = bounds->tightness;
+        const size_t numEqualityIntervals = oilOut->intervals.size();
 
         IndexBoundsBuilder::BoundsTightness tightness;
-        for (auto&& equality : ime->getEqualities()) {
-            translateEquality(equality, index, isHashed, oilOut, &tightness);
-            if (tightness != IndexBoundsBuilder::EXACT) {
-                *tightnessOut = tightness;
-            }
-        }
 
         for (auto&& regex : ime->getRegexes()) {
             translateRegex(regex.get(), index, oilOut, &tightness);
@@ -699,6 +774,12 @@ void IndexBoundsBuilder::_translatePredicate(const MatchExpression* expr,
             *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
         }
 
+        // The equality intervals are already in order, so only the few added after them need
+        // sorting before the two runs are merged.
+        auto& intervals = oilOut->intervals;
+        const auto firstAdded = intervals.begin() + numEqualityIntervals;
+        std::sort(firstAdded, intervals.end(), IntervalComparison);
+        std::inplace_merge(intervals.begin(), firstAdded, intervals.end(), IntervalComparison);
         unionize(oilOut);
     } else if (MatchExpression::GEO == expr->matchType()) {
         const GeoMatchExpression* gme = static_cast<const GeoMatchExpression*>(expr);
@@ -807,8 +888,10 @@ void IndexBoundsBuilder::unionize(OrderedIntervalList* oilOut) {
         return;
     }
 
-    // Step 1: sort.
-    std::sort(iv.begin(), iv.end(), IntervalComparison);
+    // Step 1: sort, unless the intervals are already in order.
+    if (!std::is_sorted(iv.begin(), iv.end(), IntervalComparison)) {
+        std::sort(iv.begin(), iv.end(), IntervalComparison);
+    }
 
     // Step 2: Walk through and merge.
     size_t i = 0;
@@ -948,7 +1031,7 @@ void IndexBoundsBuilder::translateEquality(const BSONElement& data,
     if (BSONType::Array != data.type()) {
         BSONObj dataObj = objFromElement(data, index.collator);
         if (isHashed) {
-            dataObj = ExpressionMapping::hash(dataObj.firstElement());
+            dataObj = ExpressionMapping::hash(dataObj.firstElement(), hashVersionOf(index));
         }
 
         verify(dataObj.isOwned());
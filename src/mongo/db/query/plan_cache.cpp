@@ -65,6 +65,7 @@ const char kEncodeDiscriminatorsBegin = '<';
 const char kEncodeDiscriminatorsEnd = '>';
 const char kEncodeProjectionSection = '|';
 const char kEncodeRegexFlagsSeparator = '/';
+const char kEncodeSelectivitySection = '^';
 const char kEncodeSortSection = '~';
 
 /**
@@ -83,6 +84,7 @@ void encodeUserString(StringData s, StringBuilder* keyBuilder) {
             case kEncodeDiscriminatorsEnd:
             case kEncodeProjectionSection:
             case kEncodeRegexFlagsSeparator:
+            case kEncodeSelectivitySection:
             case kEncodeSortSection:
             case '\\':
                 *keyBuilder << '\\';
@@ -612,6 +614,10 @@ std::string SolutionCacheData::toString() const {
                                  << "tree=" << this->tree->toString() << ")";
         case COLLSCAN_SOLN:
             return "(collection scan)";
+        case SKIP_IXSCAN_SOLN:
+            verify(this->tree.get());
+            return str::stream() << "(index skip scan solution: "
+                                 << "tree=" << this->tree->toString() << ")";
         case USE_INDEX_TAGS_SOLN:
             verify(this->tree.get());
             return str::stream() << "(index-tagged expression tree: "
@@ -878,7 +884,8 @@ Status PlanCache::set(const CanonicalQuery& query,
                       "candidate ordering entries in decision must match solutions");
     }
 
-    const auto key = computeKey(query);
+    // The query hash identifies the shape, so it is the same for every selectivity bucket.
+    const auto key = computeEntryKey(query);
     const size_t newWorks = why->stats[0]->common.works;
     stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
     bool isNewEntryActive = false;
@@ -886,7 +893,7 @@ Status PlanCache::set(const CanonicalQuery& query,
     if (internalQueryCacheDisableInactiveEntries.load()) {
         // All entries are always active.
         isNewEntryActive = true;
-        queryHash = PlanCache::computeQueryHash(key);
+        queryHash = PlanCache::computeQueryHash(computeKey(query));
     } else {
         PlanCacheEntry* oldEntry = nullptr;
         Status cacheStatus = _cache.get(key, &oldEntry);
@@ -894,7 +901,7 @@ Status PlanCache::set(const CanonicalQuery& query,
         if (oldEntry) {
             queryHash = oldEntry->queryHash;
         } else {
-            queryHash = PlanCache::computeQueryHash(key);
+            queryHash = PlanCache::computeQueryHash(computeKey(query));
         }
 
         auto newState = getNewEntryState(
@@ -948,7 +955,7 @@ void PlanCache::deactivate(const CanonicalQuery& query) {
         return;
     }
 
-    PlanCacheKey key = computeKey(query);
+    PlanCacheKey key = computeEntryKey(query);
     stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
     PlanCacheEntry* entry = nullptr;
     Status cacheStatus = _cache.get(key, &entry);
@@ -961,7 +968,7 @@ void PlanCache::deactivate(const CanonicalQuery& query) {
 }
 
 PlanCache::GetResult PlanCache::get(const CanonicalQuery& query) const {
-    PlanCacheKey key = computeKey(query);
+    PlanCacheKey key = computeEntryKey(query);
     return get(key);
 }
 
@@ -981,7 +988,7 @@ PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
 }
 
 Status PlanCache::feedback(const CanonicalQuery& cq, double score) {
-    PlanCacheKey ck = computeKey(cq);
+    PlanCacheKey ck = computeEntryKey(cq);
 
     stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
     PlanCacheEntry* entry;
@@ -1000,8 +1007,18 @@ Status PlanCache::feedback(const CanonicalQuery& cq, double score) {
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
+    const PlanCacheKey shapeKey = computeKey(canonicalQuery);
+
     stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    Status status = _cache.remove(shapeKey);
+
+    // Removing a shape also removes the entries cached for each of its selectivity buckets.
+    for (int bucket = 0; bucket < kMaxPlanCacheSelectivityBuckets; ++bucket) {
+        if (_cache.remove(appendSelectivityBucket(shapeKey, bucket)).isOK()) {
+            status = Status::OK();
+        }
+    }
+    return status;
 }
 
 void PlanCache::clear() {
@@ -1017,12 +1034,26 @@ PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
     return keyBuilder.str();
 }
 
+PlanCacheKey PlanCache::computeEntryKey(const CanonicalQuery& cq) const {
+    PlanCacheKey key = computeKey(cq);
+    if (auto bucket = cq.getSelectivityBucket()) {
+        return appendSelectivityBucket(key, *bucket);
+    }
+    return key;
+}
+
+PlanCacheKey PlanCache::appendSelectivityBucket(const PlanCacheKey& shapeKey, int bucket) {
+    StringBuilder keyBuilder;
+    keyBuilder << shapeKey << kEncodeSelectivitySection << bucket;
+    return keyBuilder.str();
+}
+
 uint32_t PlanCache::computeQueryHash(const PlanCacheKey& key) {
     return SimpleStringDataComparator::kInstance.hash(key);
 }
 
 StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQuery& query) const {
-    PlanCacheKey key = computeKey(query);
+    PlanCacheKey key = computeEntryKey(query);
 
     stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
     PlanCacheEntry* entry;
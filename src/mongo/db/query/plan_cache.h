@@ -158,6 +158,10 @@ struct SolutionCacheData {
         // The cached plan is a collection scan.
         COLLSCAN_SOLN,
 
+        // The cached plan skip scans the index in 'tree' for a query with no predicate on the
+        // index's leading field.
+        SKIP_IXSCAN_SOLN,
+
         // Build the solution by using 'tree'
         // to tag the match expression.
         USE_INDEX_TAGS_SOLN
@@ -403,8 +407,9 @@ public:
     Status feedback(const CanonicalQuery& cq, double score);
 
     /**
-     * Remove the entry corresponding to 'ck' from the cache.  Returns Status::OK() if the plan
-     * was present and removed and an error status otherwise.
+     * Remove the entry corresponding to 'ck' from the cache, along with the entries cached for
+     * each selectivity bucket of its shape.  Returns Status::OK() if any plan was present and
+     * removed and an error status otherwise.
      */
     Status remove(const CanonicalQuery& canonicalQuery);
 
@@ -424,6 +429,20 @@ public:
      */
     PlanCacheKey computeKey(const CanonicalQuery&) const;
 
+    /**
+     * Get the key of the cache entry used for the given canonical query. This is the shape key
+     * from computeKey(), extended with the query's selectivity bucket when it has one, so that a
+     * single shape may cache a different plan for each order of magnitude of selectivity.
+     *
+     * Callers must hold the collection lock when calling this method.
+     */
+    PlanCacheKey computeEntryKey(const CanonicalQuery&) const;
+
+    /**
+     * Returns the entry key for 'shapeKey' restricted to the given selectivity bucket.
+     */
+    static PlanCacheKey appendSelectivityBucket(const PlanCacheKey& shapeKey, int bucket);
+
     /**
      * Returns a hash of the plan cache key. This hash may not be stable between different versions
      * of the server.
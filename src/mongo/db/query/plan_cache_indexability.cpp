@@ -175,6 +175,20 @@ void PlanCacheIndexabilityState::updateDiscriminators(const std::vector<IndexEnt
     for (const IndexEntry& idx : indexEntries) {
         if (idx.type == IndexType::INDEX_WILDCARD) {
             processWildcardIndex(idx);
+
+            // The prefix fields of a compound $** index are indexed as in a sparse index.
+            BSONObjBuilder prefixFields;
+            for (auto&& elem : idx.keyPattern) {
+                if (static_cast<size_t>(prefixFields.numFields()) ==
+                    WildcardKeyGenerator::numPrefixFields(idx.keyPattern))
+                    break;
+                prefixFields.append(elem);
+            }
+            if (prefixFields.numFields() > 0) {
+                const auto prefixKeyPattern = prefixFields.obj();
+                processSparseIndex(idx.identifier.catalogName, prefixKeyPattern);
+                processIndexCollation(idx.identifier.catalogName, prefixKeyPattern, idx.collator);
+            }
             continue;
         }
 
@@ -770,6 +770,42 @@ TEST(PlanCacheTest, DeactivateCacheEntry) {
     ASSERT_EQ(entry->works, 20U);
 }
 
+TEST(PlanCacheTest, SelectivityBucketsHaveSeparateEntries) {
+    PlanCache planCache;
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+    QueryTestServiceContext serviceContext;
+
+    cq->setSelectivityBucket(1);
+    ASSERT_OK(planCache.set(*cq, solns, createDecision(1U, 10), Date_t{}));
+    ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kPresentInactive);
+
+    // The entry for one bucket is not visible to the same shape in another bucket, nor to the
+    // unbucketed shape.
+    cq->setSelectivityBucket(3);
+    ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_OK(planCache.set(*cq, solns, createDecision(1U, 1000), Date_t{}));
+    cq->setSelectivityBucket(boost::none);
+    ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_EQ(planCache.size(), 2U);
+
+    // Entries for all buckets of a shape share the shape's query hash.
+    cq->setSelectivityBucket(1);
+    auto lowEntry = assertGet(planCache.getEntry(*cq));
+    cq->setSelectivityBucket(3);
+    auto highEntry = assertGet(planCache.getEntry(*cq));
+    ASSERT_EQ(lowEntry->works, 10U);
+    ASSERT_EQ(highEntry->works, 1000U);
+    ASSERT_EQ(lowEntry->queryHash, highEntry->queryHash);
+    ASSERT_EQ(lowEntry->queryHash, PlanCache::computeQueryHash(planCache.computeKey(*cq)));
+
+    // Removing the shape removes every bucket's entry.
+    cq->setSelectivityBucket(boost::none);
+    ASSERT_OK(planCache.remove(*cq));
+    ASSERT_EQ(planCache.size(), 0U);
+}
+
 TEST(PlanCacheTest, GetMatchingStatsMatchesAndSerializesCorrectly) {
     PlanCache planCache;
 
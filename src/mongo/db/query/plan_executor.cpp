@@ -50,6 +50,7 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/mock_yield_policies.h"
 #include "mongo/db/query/plan_yield_policy.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/stdx/memory.h"
@@ -347,6 +348,11 @@ void PlanExecutor::saveState() {
     // boundaries.
     WorkingSetCommon::prepareForSnapshotChange(_workingSet.get());
 
+    // Results buffered from a batch of work outlive the storage engine's current position.
+    for (size_t i = _nextBatchedResult; i < _batchedResults.size(); ++i) {
+        _workingSet->get(_batchedResults[i])->makeObjOwnedIfNeeded();
+    }
+
     if (!isMarkedAsKilled()) {
         _root->saveState();
     }
@@ -531,7 +537,10 @@ PlanExecutor::ExecState PlanExecutor::getNextImpl(Snapshotted<BSONObj>* objOut,
         //   2) some stage requested a yield, or
         //   3) we need to yield and retry due to a WriteConflictException.
         // In all cases, the actual yielding happens here.
-        if (_yieldPolicy->shouldYieldOrInterrupt()) {
+        //
+        // Results already produced by a batch of work are returned without yielding, since the
+        // batch is bounded by internalQueryExecWorkBatchSize.
+        if (!hasBatchedWork() && _yieldPolicy->shouldYieldOrInterrupt()) {
             auto yieldStatus = _yieldPolicy->yieldOrInterrupt();
             if (!yieldStatus.isOK()) {
                 if (objOut) {
@@ -543,7 +552,7 @@ PlanExecutor::ExecState PlanExecutor::getNextImpl(Snapshotted<BSONObj>* objOut,
         }
 
         WorkingSetID id = WorkingSet::INVALID_ID;
-        PlanStage::StageState code = _root->work(&id);
+        PlanStage::StageState code = workRoot(&id);
 
         if (code != PlanStage::NEED_YIELD)
             writeConflictsInARow = 0;
@@ -631,9 +640,55 @@ PlanExecutor::ExecState PlanExecutor::getNextImpl(Snapshotted<BSONObj>* objOut,
     }
 }
 
+PlanStage::StageState PlanExecutor::workRoot(WorkingSetID* out) {
+    if (_nextBatchedResult < _batchedResults.size()) {
+        *out = _batchedResults[_nextBatchedResult++];
+        return PlanStage::ADVANCED;
+    }
+
+    if (_batchEndState) {
+        const PlanStage::StageState state = *_batchEndState;
+        *out = _batchEndId;
+        _batchEndState = boost::none;
+        _batchEndId = WorkingSet::INVALID_ID;
+        return state;
+    }
+
+    if (!canBatchWork()) {
+        return _root->work(out);
+    }
+
+    _batchedResults.clear();
+    _nextBatchedResult = 0;
+    const PlanStage::StageState state = _root->workBatch(
+        static_cast<size_t>(internalQueryExecWorkBatchSize.load()),
+        _workingSet.get(),
+        &_batchedResults,
+        &_batchEndId);
+    if (PlanStage::ADVANCED != state && PlanStage::NEED_TIME != state) {
+        _batchEndState = state;
+    }
+
+    if (_batchedResults.empty()) {
+        return _batchEndState ? workRoot(out) : PlanStage::NEED_TIME;
+    }
+
+    *out = _batchedResults[_nextBatchedResult++];
+    return PlanStage::ADVANCED;
+}
+
+bool PlanExecutor::canBatchWork() {
+    if (!_canBatchWork) {
+        _canBatchWork = !_nss.isOplog() && !getStageByType(_root.get(), STAGE_PIPELINE_PROXY) &&
+            !getStageByType(_root.get(), STAGE_UPDATE) &&
+            !getStageByType(_root.get(), STAGE_DELETE);
+    }
+    return *_canBatchWork && internalQueryExecWorkBatchSize.load() > 1;
+}
+
 bool PlanExecutor::isEOF() {
     invariant(_currentState == kUsable);
-    return isMarkedAsKilled() || (_stash.empty() && _root->isEOF());
+    return isMarkedAsKilled() || (_stash.empty() && !hasBatchedWork() && _root->isEOF());
 }
 
 void PlanExecutor::markAsKilled(Status killStatus) {
@@ -33,6 +33,8 @@
 
 #include "mongo/base/status.h"
 #include "mongo/db/catalog/util/partitioned.h"
+#include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/working_set.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/db/storage/snapshot.h"
 #include "mongo/stdx/unordered_set.h"
@@ -45,11 +47,9 @@ struct CappedInsertNotifierData;
 class Collection;
 class CursorManager;
 class PlanExecutor;
-class PlanStage;
 class PlanYieldPolicy;
 class RecordId;
 struct PlanStageStats;
-class WorkingSet;
 
 /**
  * If a getMore command specified a lastKnownCommittedOpTime (as secondaries do), we want to stop
@@ -546,6 +546,28 @@ private:
      */
     Status pickBestPlan(const Collection* collection);
 
+    /**
+     * Returns the next result of the root stage, or the state which ended the root's most recent
+     * batch of work, before asking the root stage for more work. When batching is enabled and
+     * safe for this plan, the root stage is worked with PlanStage::workBatch().
+     */
+    PlanStage::StageState workRoot(WorkingSetID* out);
+
+    /**
+     * Returns true if results or a final state from the root stage's last batch of work have yet
+     * to be consumed by getNext().
+     */
+    bool hasBatchedWork() const {
+        return _nextBatchedResult < _batchedResults.size() || _batchEndState;
+    }
+
+    /**
+     * Returns true if the root stage may perform several units of work before its results are
+     * consumed. This is not the case for plans whose side effects or metadata must track each
+     * result as it is returned, such as writes, pipelines and oplog scans.
+     */
+    bool canBatchWork();
+
     // The OperationContext that we're executing within. This can be updated if necessary by using
     // detachFromOperationContext() and reattachToOperationContext().
     OperationContext* _opCtx;
@@ -572,6 +594,16 @@ private:
     // stages.
     std::queue<BSONObj> _stash;
 
+    // Results produced by the root stage in a batch of work which getNext() has not returned yet,
+    // followed by the state which ended that batch, if it wasn't ADVANCED or NEED_TIME.
+    std::vector<WorkingSetID> _batchedResults;
+    size_t _nextBatchedResult = 0;
+    boost::optional<PlanStage::StageState> _batchEndState;
+    WorkingSetID _batchEndId = WorkingSet::INVALID_ID;
+
+    // Whether the root stage may be worked in batches. Unset until the first call to workRoot().
+    boost::optional<bool> _canBatchWork;
+
     enum { kUsable, kSaved, kDetached, kDisposed } _currentState = kUsable;
 
     // Set if this PlanExecutor is registered with the CursorManager.
@@ -0,0 +1,180 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_pruner.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/exec/index_scan.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Counts the keys within the bounds of 'ixn', stopping at 'probeLimit'. Returns boost::none if
+ * the scan could not run to completion without yielding.
+ */
+boost::optional<long long> countIndexKeys(OperationContext* opCtx,
+                                          const Collection* collection,
+                                          const IndexScanNode* ixn,
+                                          long long probeLimit) {
+    auto descriptor =
+        collection->getIndexCatalog()->findIndexByName(opCtx, ixn->index.identifier.catalogName);
+    if (!descriptor) {
+        return boost::none;
+    }
+
+    // Use the node's internal name, keyPattern and multikey details, as the stage builder does.
+    IndexScanParams params{*descriptor,
+                           ixn->index.identifier.catalogName,
+                           ixn->index.keyPattern,
+                           ixn->index.multikeyPaths,
+                           ixn->index.multikey};
+    params.bounds = ixn->bounds;
+    params.direction = ixn->direction;
+
+    WorkingSet ws;
+    IndexScan scan(opCtx, std::move(params), &ws, nullptr);
+    long long count = 0;
+    while (count < probeLimit) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        PlanStage::StageState state = scan.work(&id);
+        if (PlanStage::ADVANCED == state) {
+            ws.free(id);
+            ++count;
+        } else if (PlanStage::IS_EOF == state) {
+            break;
+        } else if (PlanStage::NEED_TIME != state) {
+            return boost::none;
+        }
+    }
+    return count;
+}
+
+}  // namespace
+
+// static
+boost::optional<long long> PlanPruner::estimateCost(OperationContext* opCtx,
+                                                    const Collection* collection,
+                                                    const QuerySolution& soln,
+                                                    long long probeLimit) {
+    long long cost = 0;
+    std::vector<const QuerySolutionNode*> toVisit{soln.root.get()};
+    while (!toVisit.empty()) {
+        const QuerySolutionNode* node = toVisit.back();
+        toVisit.pop_back();
+
+        if (!node->children.empty()) {
+            for (auto&& child : node->children) {
+                toVisit.push_back(child);
+            }
+            continue;
+        }
+
+        switch (node->getType()) {
+            case STAGE_IXSCAN: {
+                auto keys = countIndexKeys(
+                    opCtx, collection, static_cast<const IndexScanNode*>(node), probeLimit);
+                if (!keys) {
+                    return boost::none;
+                }
+                cost += *keys;
+                break;
+            }
+            case STAGE_COLLSCAN:
+                cost += collection->numRecords(opCtx);
+                break;
+            default:
+                return boost::none;
+        }
+    }
+    return cost;
+}
+
+// static
+void PlanPruner::prune(OperationContext* opCtx,
+                       const Collection* collection,
+                       size_t maxCandidates,
+                       long long probeLimit,
+                       std::vector<std::unique_ptr<QuerySolution>>* solutions) {
+    if (maxCandidates == 0 || solutions->size() <= maxCandidates) {
+        return;
+    }
+
+    std::vector<long long> costs;
+    costs.reserve(solutions->size());
+    for (auto&& soln : *solutions) {
+        auto cost = estimateCost(opCtx, collection, *soln, probeLimit);
+        if (!cost) {
+            return;
+        }
+        costs.push_back(*cost);
+    }
+
+    std::vector<size_t> order(solutions->size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&costs](size_t lhs, size_t rhs) {
+        return costs[lhs] < costs[rhs];
+    });
+
+    std::vector<bool> keep(solutions->size(), false);
+    for (size_t i = 0; i < maxCandidates; ++i) {
+        keep[order[i]] = true;
+    }
+
+    // A non-blocking plan may stop early under a limit, so keep the cheapest one regardless.
+    auto nonBlocking = std::find_if(order.begin(), order.end(), [&solutions](size_t ix) {
+        return !(*solutions)[ix]->hasBlockingStage;
+    });
+    if (nonBlocking != order.end()) {
+        keep[*nonBlocking] = true;
+    }
+
+    std::vector<std::unique_ptr<QuerySolution>> survivors;
+    for (size_t ix = 0; ix < solutions->size(); ++ix) {
+        if (keep[ix]) {
+            survivors.push_back(std::move((*solutions)[ix]));
+        } else {
+            LOG(2) << "Pruning candidate plan with estimated cost " << costs[ix] << ": "
+                   << redact((*solutions)[ix]->toString());
+        }
+    }
+    *solutions = std::move(survivors);
+}
+
+}  // namespace mongo
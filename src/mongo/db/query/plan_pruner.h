@@ -0,0 +1,75 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo {
+
+class Collection;
+class OperationContext;
+
+/**
+ * Narrows the candidate solutions for a query down before they are raced by MultiPlanStage.
+ *
+ * Each candidate is assigned a cost equal to the number of index keys and documents its leaf
+ * scans would examine, which is measured by scanning the index bounds of each IXSCAN up to a
+ * fixed limit and taking the collection's record count for a COLLSCAN. Only the cheapest
+ * candidates go on to trial execution.
+ */
+class PlanPruner {
+public:
+    /**
+     * Returns the estimated cost of 'soln', examining at most 'probeLimit' keys per index scan, or
+     * boost::none if the solution has a leaf whose cost cannot be estimated, such as a text or
+     * geoNear stage.
+     */
+    static boost::optional<long long> estimateCost(OperationContext* opCtx,
+                                                   const Collection* collection,
+                                                   const QuerySolution& soln,
+                                                   long long probeLimit);
+
+    /**
+     * Removes all but the 'maxCandidates' cheapest solutions from 'solutions', preserving the
+     * planner's order among the survivors. Since the cost ignores limits and sorts, the cheapest
+     * solution without a blocking stage is always kept. Does nothing if any solution's cost
+     * cannot be estimated.
+     */
+    static void prune(OperationContext* opCtx,
+                      const Collection* collection,
+                      size_t maxCandidates,
+                      long long probeLimit,
+                      std::vector<std::unique_ptr<QuerySolution>>* solutions);
+};
+
+}  // namespace mongo
@@ -112,6 +112,18 @@ bool scansAreEquivalent(const QuerySolutionNode* lhs, const QuerySolutionNode* r
     return *leftIxscan == *rightIxscan;
 }
 
+/**
+ * Returns true if the field at position 'pos' of the key pattern of 'index' has no multikey path
+ * components. Every key of a document then holds the field's one value, so an INEXACT_COVERED
+ * predicate on it can be evaluated against the index keys even if 'index' is multikey.
+ */
+bool isCoveredFilterSafe(const IndexEntry& index, size_t pos) {
+    if (!index.multikey) {
+        return true;
+    }
+    return pos < index.multikeyPaths.size() && index.multikeyPaths[pos].empty();
+}
+
 /**
  * If all nodes can provide the requested sort, returns a vector expressing which nodes must have
  * their index scans reversed to provide the sort. Otherwise, returns an empty vector.
@@ -1216,7 +1228,7 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::_buildIndexedDataAccess(
             if (tightness == IndexBoundsBuilder::EXACT) {
                 return soln;
             } else if (tightness == IndexBoundsBuilder::INEXACT_COVERED &&
-                       !indices[tag->index].multikey) {
+                       isCoveredFilterSafe(indices[tag->index], tag->pos)) {
                 verify(NULL == soln->filter.get());
                 soln->filter = std::move(ownedRoot);
                 return soln;
@@ -1291,6 +1303,82 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::scanWholeIndex(
     return solnRoot;
 }
 
+std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::skipScanIndex(
+    const IndexEntry& index, const CanonicalQuery& query, const QueryPlannerParams& params) {
+    if (index.type != INDEX_BTREE || index.keyPattern.nFields() < 2 || index.sparse ||
+        index.filterExpr ||
+        !CollatorInterface::collatorsMatch(index.collator, query.getCollator())) {
+        return nullptr;
+    }
+
+    std::vector<const MatchExpression*> predicates;
+    if (MatchExpression::AND == query.root()->matchType()) {
+        for (size_t i = 0; i < query.root()->numChildren(); ++i) {
+            predicates.push_back(query.root()->getChild(i));
+        }
+    } else {
+        predicates.push_back(query.root());
+    }
+
+    auto isBoundsPredicate = [](const MatchExpression* expr) {
+        switch (expr->matchType()) {
+            case MatchExpression::EQ:
+            case MatchExpression::LT:
+            case MatchExpression::LTE:
+            case MatchExpression::GT:
+            case MatchExpression::GTE:
+            case MatchExpression::MATCH_IN:
+                return true;
+            default:
+                return false;
+        }
+    };
+
+    unique_ptr<IndexScanNode> isn = make_unique<IndexScanNode>(index);
+    isn->addKeyMetadata = query.getQueryRequest().returnKey();
+    isn->queryCollator = query.getCollator();
+
+    bool isLeadingField = true;
+    bool hasTrailingBounds = false;
+    for (auto&& keyElt : index.keyPattern) {
+        const StringData path = keyElt.fieldNameStringData();
+        auto predicate =
+            std::find_if(predicates.begin(), predicates.end(), [&](const MatchExpression* expr) {
+                return expr->path() == path && isBoundsPredicate(expr);
+            });
+
+        OrderedIntervalList oil(path.toString());
+        if (isLeadingField) {
+            // The normal planner already considers this index for predicates on its leading field.
+            if (std::any_of(predicates.begin(),
+                            predicates.end(),
+                            [&](const MatchExpression* expr) { return expr->path() == path; })) {
+                return nullptr;
+            }
+            IndexBoundsBuilder::allValuesForField(keyElt, &oil);
+            isLeadingField = false;
+        } else if (predicate != predicates.end()) {
+            IndexBoundsBuilder::BoundsTightness tightness;
+            IndexBoundsBuilder::translate(*predicate, keyElt, index, &oil, &tightness);
+            hasTrailingBounds = true;
+        } else {
+            IndexBoundsBuilder::allValuesForField(keyElt, &oil);
+        }
+        isn->bounds.fields.push_back(std::move(oil));
+    }
+
+    if (!hasTrailingBounds) {
+        return nullptr;
+    }
+    IndexBoundsBuilder::alignBounds(&isn->bounds, index.keyPattern);
+
+    // The bounds may be looser than the predicates they came from, so filter on the whole query.
+    unique_ptr<FetchNode> fetch = make_unique<FetchNode>();
+    fetch->filter = query.root()->shallowClone();
+    fetch->children.push_back(isn.release());
+    return std::move(fetch);
+}
+
 void QueryPlannerAccess::addFilterToSolutionNode(QuerySolutionNode* node,
                                                  MatchExpression* match,
                                                  MatchExpression::MatchType type) {
@@ -1364,18 +1452,18 @@ void QueryPlannerAccess::handleFilterAnd(ScanBuildingState* scanState) {
         root->getChildVector()->erase(root->getChildVector()->begin() + scanState->curChild);
         delete child;
     } else if (scanState->tightness == IndexBoundsBuilder::INEXACT_COVERED &&
-               (INDEX_TEXT == index.type || !index.multikey)) {
+               (INDEX_TEXT == index.type || isCoveredFilterSafe(index, scanState->ixtag->pos))) {
         // The bounds are not exact, but the information needed to
         // evaluate the predicate is in the index key. Remove the
         // MatchExpression from its parent and attach it to the filter
         // of the index scan we're building.
         //
-        // We can only use this optimization if the index is NOT multikey.
+        // We can only use this optimization if the field is not multikey.
         // Suppose that we had the multikey index {x: 1} and a document
         // {x: ["a", "b"]}. Now if we query for {x: /b/} the filter might
         // ever only be applied to the index key "a". We'd incorrectly
         // conclude that the document does not match the query :( so we
-        // gotta stick to non-multikey indices.
+        // gotta stick to fields without multikey components.
         root->getChildVector()->erase(root->getChildVector()->begin() + scanState->curChild);
 
         addFilterToSolutionNode(scanState->currentScan.get(), child, root->matchType());
@@ -109,6 +109,18 @@ public:
                                                              const QueryPlannerParams& params,
                                                              int direction = 1);
 
+    /**
+     * Return a plan that skip scans the provided compound btree index for a query with no
+     * predicate on the index's leading field, or nullptr if the index cannot serve the query
+     * this way. The bounds leave the leading field unconstrained and bound each later field by
+     * the first top-level comparison on it, so the index scan seeks past every run of keys that
+     * share a leading value but fall outside the bounds on a later field. The whole query is
+     * applied as a filter after fetching.
+     */
+    static std::unique_ptr<QuerySolutionNode> skipScanIndex(const IndexEntry& index,
+                                                            const CanonicalQuery& query,
+                                                            const QueryPlannerParams& params);
+
     /**
      * Return a plan that scans the provided index from [startKey to endKey).
      */
@@ -609,6 +609,13 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         sort->limit = 0;
     }
 
+    // A text node which the limited sort reads directly only has to produce the best scoring
+    // documents when the sort is on the text score alone.
+    if (sort->limit && STAGE_TEXT == keyGenNode->children[0]->getType() &&
+        sortObj.nFields() == 1 && QueryRequest::isTextScoreMeta(sortObj.firstElement())) {
+        static_cast<TextNode*>(keyGenNode->children[0])->topK = sort->limit;
+    }
+
     *blockingSortOut = true;
 
     return solnRoot;
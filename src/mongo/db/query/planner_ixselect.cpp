@@ -449,7 +449,10 @@ bool QueryPlannerIXSelect::_compatible(const BSONElement& keyPatternElt,
             }
         }
 
-        if (index.type == IndexType::INDEX_WILDCARD && !nodeIsSupportedByWildcardIndex(node)) {
+        // Only the query path of an expanded $** index, which is its first keyPattern field, is
+        // subject to the restrictions of $** indexes. Any prefix fields follow it.
+        if (index.type == IndexType::INDEX_WILDCARD && keyPatternIdx == 0 &&
+            !nodeIsSupportedByWildcardIndex(node)) {
             return false;
         }
 
@@ -32,6 +32,7 @@
 
 #include "mongo/db/query/planner_wildcard_helpers.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/bson/util/builder.h"
@@ -294,9 +295,17 @@ void expandWildcardIndexEntry(const IndexEntry& wildcardIndex,
                               std::vector<IndexEntry>* out) {
     invariant(out);
     invariant(wildcardIndex.type == INDEX_WILDCARD);
-    // Should only have one field of the form {"path.$**" : 1}.
-    invariant(wildcardIndex.keyPattern.nFields() == 1);
-    invariant(wildcardIndex.keyPattern.firstElement().fieldNameStringData().endsWith("$**"));
+    // Should have a single wildcard field of the form {"path.$**" : 1}, preceded by any prefix
+    // fields of a compound wildcard index.
+    const auto wildcardField = WildcardKeyGenerator::getWildcardField(wildcardIndex.keyPattern);
+    const auto numPrefixFields = WildcardKeyGenerator::numPrefixFields(wildcardIndex.keyPattern);
+    BSONObjBuilder prefixFieldsBuilder;
+    for (auto&& elem : wildcardIndex.keyPattern) {
+        if (static_cast<size_t>(prefixFieldsBuilder.numFields()) == numPrefixFields)
+            break;
+        prefixFieldsBuilder.append(elem);
+    }
+    const BSONObj prefixFields = prefixFieldsBuilder.obj();
 
     // $** indexes do not keep the multikey metadata inside the index catalog entry, as the amount
     // of metadata is not bounded. We do not expect IndexEntry objects for $** indexes to have a
@@ -312,6 +321,12 @@ void expandWildcardIndexEntry(const IndexEntry& wildcardIndex,
 
     out->reserve(out->size() + projectedFields.size());
     for (auto&& fieldName : projectedFields) {
+        // A query on one of the prefix fields is planned as a predicate on that field of the
+        // expanded IndexEntry for a wildcard path, not as a wildcard path in its own right.
+        if (prefixFields.hasField(fieldName)) {
+            continue;
+        }
+
         // Convert string 'fieldName' into a FieldRef, to better facilitate the subsequent checks.
         auto queryPath = FieldRef{fieldName};
         // $** indices hold multikey metadata directly in the index keys, rather than in the index
@@ -337,7 +352,13 @@ void expandWildcardIndexEntry(const IndexEntry& wildcardIndex,
         invariant(multikeyPaths.size() == 1u);
         const bool isMultikey = !multikeyPaths[0].empty();
 
-        IndexEntry entry(BSON(fieldName << wildcardIndex.keyPattern.firstElement()),
+        // The prefix fields of a compound wildcard index are never multikey.
+        multikeyPaths.resize(1u + numPrefixFields);
+        BSONObjBuilder keyPatternBuilder;
+        keyPatternBuilder.appendAs(wildcardField, fieldName);
+        keyPatternBuilder.appendElements(prefixFields);
+
+        IndexEntry entry(keyPatternBuilder.obj(),
                          IndexType::INDEX_WILDCARD,
                          isMultikey,
                          std::move(multikeyPaths),
@@ -360,12 +381,11 @@ BoundsTightness translateWildcardIndexBoundsAndTightness(const IndexEntry& index
                                                          BoundsTightness tightnessIn,
                                                          OrderedIntervalList* oil) {
     // This method should only ever be called for a $** IndexEntry. We expect to be called during
-    // planning, *before* finishWildcardIndexScanNode has been invoked. The IndexEntry should thus
-    // only have a single keyPattern field and multikeyPath entry, but this is sufficient to
-    // determine whether it will be necessary to adjust the tightness.
+    // planning, *before* finishWildcardIndexScanNode has been invoked. The query path should thus
+    // be the first keyPattern field and multikeyPath entry, which is sufficient to determine
+    // whether it will be necessary to adjust the tightness.
     invariant(index.type == IndexType::INDEX_WILDCARD);
-    invariant(index.keyPattern.nFields() == 1);
-    invariant(index.multikeyPaths.size() == 1);
+    invariant(index.multikeyPaths.size() == static_cast<size_t>(index.keyPattern.nFields()));
     invariant(oil);
 
     // If our bounds include any objects -- anything in the range ({}, []) -- then we will need to
@@ -392,23 +412,36 @@ BoundsTightness translateWildcardIndexBoundsAndTightness(const IndexEntry& index
 void finalizeWildcardIndexScanConfiguration(IndexEntry* index, IndexBounds* bounds) {
     // We should only ever reach this point when processing a $** index. Sanity check the arguments.
     invariant(index && index->type == IndexType::INDEX_WILDCARD);
-    invariant(index->keyPattern.nFields() == 1);
-    invariant(index->multikeyPaths.size() == 1);
-    invariant(bounds && bounds->fields.size() == 1);
+    const size_t numPrefixFields = index->keyPattern.nFields() - 1;
+    invariant(index->multikeyPaths.size() == numPrefixFields + 1);
+    invariant(bounds && bounds->fields.size() == numPrefixFields + 1);
     invariant(bounds->fields.front().name == index->keyPattern.firstElementFieldName());
 
-    // For $** indexes, the IndexEntry key pattern is {'path.to.field': ±1} but the actual keys in
-    // the index are of the form {'$_path': ±1, 'path.to.field': ±1}, where the value of the first
-    // field in each key is 'path.to.field'. We push a new entry into the bounds vector for the
-    // leading '$_path' bound here. We also push corresponding fields into the IndexScanNode's
-    // keyPattern and its multikeyPaths vector.
-    index->multikeyPaths.insert(index->multikeyPaths.begin(), std::set<std::size_t>{});
-    bounds->fields.insert(bounds->fields.begin(), {"$_path"});
-    index->keyPattern =
-        BSON("$_path" << index->keyPattern.firstElement() << index->keyPattern.firstElement());
+    // For $** indexes, the IndexEntry key pattern is {'path.to.field': ±1, <prefix fields>} but
+    // the actual keys in the index are of the form
+    // {<prefix fields>, '$_path': ±1, 'path.to.field': ±1}, where the value of the '$_path' field
+    // in each key is 'path.to.field'. We move the query path to the end of the bounds vector and
+    // push a new entry for the '$_path' bound just before it here. We also make the corresponding
+    // changes to the IndexScanNode's keyPattern and its multikeyPaths vector.
+    std::rotate(bounds->fields.begin(), bounds->fields.begin() + 1, bounds->fields.end());
+    std::rotate(index->multikeyPaths.begin(),
+                index->multikeyPaths.begin() + 1,
+                index->multikeyPaths.end());
+    index->multikeyPaths.insert(index->multikeyPaths.end() - 1, std::set<std::size_t>{});
+    bounds->fields.insert(bounds->fields.end() - 1, {"$_path"});
+
+    BSONObjBuilder keyPatternBuilder;
+    BSONObjIterator keyPatternIt(index->keyPattern);
+    const auto queryPathElem = keyPatternIt.next();
+    while (keyPatternIt.more()) {
+        keyPatternBuilder.append(keyPatternIt.next());
+    }
+    keyPatternBuilder.appendAs(queryPathElem, "$_path");
+    keyPatternBuilder.append(queryPathElem);
+    index->keyPattern = keyPatternBuilder.obj();
 
     // Create a FieldRef to perform any necessary manipulations on the query path string.
-    FieldRef queryPath{std::next(index->keyPattern.begin())->fieldNameStringData()};
+    FieldRef queryPath{bounds->fields.back().name};
     auto& multikeyPaths = index->multikeyPaths.back();
 
     // If the bounds overlap the object type bracket, then we must retrieve all documents which
@@ -441,7 +474,7 @@ void finalizeWildcardIndexScanConfiguration(IndexEntry* index, IndexBounds* boun
     // Add a $_path point-interval for each path that needs to be traversed in the index. If subpath
     // bounds are required, then we must add a further range interval on ["path.","path/").
     static const char subPathStart = '.', subPathEnd = static_cast<char>('.' + 1);
-    auto& pathIntervals = bounds->fields.front().intervals;
+    auto& pathIntervals = bounds->fields[numPrefixFields].intervals;
     for (const auto& fieldPath : paths) {
         auto path = fieldPath.dottedField().toString();
         pathIntervals.push_back(IndexBoundsBuilder::makePointInterval(path));
@@ -461,12 +494,11 @@ bool isWildcardObjectSubpathScan(const IndexScanNode* node) {
     }
 
     // We expect consistent arguments, representing a $** index which has already been finalized.
-    invariant(node->index.keyPattern.nFields() == 2);
-    invariant(node->index.multikeyPaths.size() == 2);
-    invariant(node->bounds.fields.size() == 2);
-    invariant(node->bounds.fields.front().name == node->index.keyPattern.firstElementFieldName());
-    invariant(node->bounds.fields.back().name ==
-              std::next(node->index.keyPattern.begin())->fieldName());
+    const size_t numFields = node->index.keyPattern.nFields();
+    invariant(numFields >= 2);
+    invariant(node->index.multikeyPaths.size() == numFields);
+    invariant(node->bounds.fields.size() == numFields);
+    invariant(node->bounds.fields[numFields - 2].name == "$_path");
 
     // Check the bounds on the query field for any intersections with the object type bracket.
     return boundsOverlapObjectTypeBracket(node->bounds.fields.back());
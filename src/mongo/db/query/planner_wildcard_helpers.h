@@ -49,7 +49,10 @@ static constexpr size_t kWildcardMaxArrayIndexTraversalDepth = 8u;
 
 /**
  * Given a single wildcard index, and a set of fields which are being queried, create a 'mock'
- * IndexEntry for each of the query fields and add them into the provided vector.
+ * IndexEntry for each of the query fields and add them into the provided vector. For a compound
+ * wildcard index, the query field leads the mock IndexEntry's keyPattern and is followed by the
+ * index's prefix fields, so that the planner only uses the index when there is a predicate on a
+ * wildcard path.
  */
 void expandWildcardIndexEntry(const IndexEntry& wildcardIndex,
                               const stdx::unordered_set<std::string>& fields,
@@ -67,10 +70,12 @@ BoundsTightness translateWildcardIndexBoundsAndTightness(const IndexEntry& index
                                                          OrderedIntervalList* oil);
 
 /**
- * During planning, the expanded $** IndexEntry's keyPattern and bounds are in the single-field
- * format {'path': 1}. Once planning is complete, it is necessary to call this method in order to
- * prepare the IndexEntry and bounds for execution. This function performs the following actions:
- * - Converts the keyPattern to the {$_path: 1, "path": 1} format expected by the $** index.
+ * During planning, the expanded $** IndexEntry's keyPattern and bounds are in the format
+ * {'path': 1, <prefix fields>}. Once planning is complete, it is necessary to call this method in
+ * order to prepare the IndexEntry and bounds for execution. This function performs the following
+ * actions:
+ * - Converts the keyPattern to the {<prefix fields>, $_path: 1, "path": 1} format expected by the
+ *   $** index, moving the bounds and 'multikeyPaths' entries of the query path to the end.
  * - Adds a new entry '$_path' to the bounds vector, and computes the necessary intervals on it.
  * - Adds a new, empty entry to 'multikeyPaths' for '$_path'.
  */
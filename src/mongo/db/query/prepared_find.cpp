@@ -0,0 +1,394 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/prepared_find.h"
+
+#include <set>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/service_context.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+constexpr StringData PreparedFind::kParamField;
+
+namespace {
+
+const auto getPreparedFindCatalog = ServiceContext::declareDecoration<PreparedFindCatalog>();
+
+bool isPlaceholder(const BSONElement& elem) {
+    return elem.type() == BSONType::Object && elem.Obj().nFields() == 1 &&
+        elem.Obj().firstElement().fieldNameStringData() == PreparedFind::kParamField;
+}
+
+bool isComparisonOperator(StringData name) {
+    return name == "$eq"_sd || name == "$lt"_sd || name == "$lte"_sd || name == "$gt"_sd ||
+        name == "$gte"_sd;
+}
+
+bool isLogicalOperator(StringData name) {
+    return name == "$and"_sd || name == "$or"_sd || name == "$nor"_sd;
+}
+
+/**
+ * Copies filters, replacing their placeholders with the values of the parameters they stand for.
+ * Without values, the placeholders are copied themselves, as the operands of $eq where they stand
+ * for a value compared for equality, so that the copy can be parsed. Records where each
+ * placeholder is in the copy.
+ */
+class FilterBinder {
+public:
+    struct BoundPlaceholder {
+        std::string name;
+
+        // The field names which lead from the copied filter to the value of the placeholder.
+        std::vector<std::string> location;
+    };
+
+    explicit FilterBinder(const BSONObj* params) : _params(params) {}
+
+    Status bindFilter(const BSONObj& filter, BSONObjBuilder* out) {
+        for (auto&& elem : filter) {
+            const auto name = elem.fieldNameStringData();
+            _location.push_back(name.toString());
+            Status status = Status::OK();
+            if (isLogicalOperator(name) && elem.type() == BSONType::Array) {
+                BSONArrayBuilder clauses(out->subarrayStart(name));
+                size_t i = 0;
+                for (auto&& clause : elem.Obj()) {
+                    _location.push_back(std::to_string(i++));
+                    if (clause.type() == BSONType::Object) {
+                        BSONObjBuilder clauseBuilder(clauses.subobjStart());
+                        status = bindFilter(clause.Obj(), &clauseBuilder);
+                    } else {
+                        clauses.append(clause);
+                    }
+                    _location.pop_back();
+                    if (!status.isOK()) {
+                        return status;
+                    }
+                }
+            } else if (name.startsWith("$")) {
+                out->append(elem);
+            } else if (isPlaceholder(elem)) {
+                status = bindPlaceholder(name, elem, true, out);
+            } else if (elem.type() == BSONType::Object && !elem.Obj().isEmpty() &&
+                       elem.Obj().firstElement().fieldNameStringData().startsWith("$")) {
+                BSONObjBuilder operators(out->subobjStart(name));
+                status = bindOperators(elem.Obj(), &operators);
+            } else {
+                out->append(elem);
+            }
+            _location.pop_back();
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+        return Status::OK();
+    }
+
+    const std::vector<BoundPlaceholder>& getPlaceholders() const {
+        return _placeholders;
+    }
+
+private:
+    Status bindOperators(const BSONObj& operators, BSONObjBuilder* out) {
+        for (auto&& op : operators) {
+            const auto name = op.fieldNameStringData();
+            _location.push_back(name.toString());
+            Status status = Status::OK();
+            if (isPlaceholder(op)) {
+                if (!isComparisonOperator(name)) {
+                    return Status(ErrorCodes::BadValue,
+                                  str::stream() << "a placeholder may only stand for the operand "
+                                                   "of $eq, $lt, $lte, $gt or $gte, not of "
+                                                << name);
+                }
+                status = bindPlaceholder(name, op, false, out);
+            } else if (name == "$not"_sd && op.type() == BSONType::Object) {
+                BSONObjBuilder negated(out->subobjStart(name));
+                status = bindOperators(op.Obj(), &negated);
+            } else if (name == "$elemMatch"_sd && op.type() == BSONType::Object) {
+                // Like the parser, treat the operand as operators on the array elements if it
+                // starts with one, and as a filter on them otherwise.
+                BSONObjBuilder elemMatch(out->subobjStart(name));
+                const auto first = op.Obj().firstElement().fieldNameStringData();
+                if (first.startsWith("$") && !isLogicalOperator(first) && first != "$where"_sd &&
+                    first != "$expr"_sd) {
+                    status = bindOperators(op.Obj(), &elemMatch);
+                } else {
+                    status = bindFilter(op.Obj(), &elemMatch);
+                }
+            } else {
+                out->append(op);
+            }
+            _location.pop_back();
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+        return Status::OK();
+    }
+
+    /**
+     * Copies 'placeholder', the value of 'fieldName' in the filter being copied, or binds it.
+     * 'isFieldValue' is true if it is the value of a field rather than the operand of an operator.
+     */
+    Status bindPlaceholder(StringData fieldName,
+                           const BSONElement& placeholder,
+                           bool isFieldValue,
+                           BSONObjBuilder* out) {
+        auto nameElem = placeholder.Obj().firstElement();
+        if (nameElem.type() != BSONType::String) {
+            return Status(ErrorCodes::TypeMismatch,
+                          str::stream() << PreparedFind::kParamField
+                                        << " must name a parameter with a string");
+        }
+
+        BoundPlaceholder bound{nameElem.str(), _location};
+        if (!_params) {
+            if (isFieldValue) {
+                out->append(fieldName, BSON("$eq" << placeholder.Obj()));
+                bound.location.push_back("$eq");
+            } else {
+                out->append(placeholder);
+            }
+            _placeholders.push_back(std::move(bound));
+            return Status::OK();
+        }
+
+        auto value = (*_params)[bound.name];
+        if (value.eoo()) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "no value for parameter '" << bound.name << "'");
+        }
+
+        // Write values compared for equality in the form the parser would read back as the same
+        // comparison, keeping for example {_id: <value>} recognizable as a lookup by _id.
+        if (isFieldValue &&
+            (value.type() == BSONType::Object || value.type() == BSONType::Array ||
+             value.type() == BSONType::RegEx)) {
+            BSONObjBuilder eq(out->subobjStart(fieldName));
+            eq.appendAs(value, "$eq");
+            bound.location.push_back("$eq");
+        } else {
+            out->appendAs(value, fieldName);
+        }
+        _placeholders.push_back(std::move(bound));
+        return Status::OK();
+    }
+
+    const BSONObj* _params;
+    std::vector<std::string> _location;
+    std::vector<BoundPlaceholder> _placeholders;
+};
+
+BSONElement elementAt(const BSONObj& obj, const std::vector<std::string>& location) {
+    BSONElement elem;
+    BSONObj current = obj;
+    for (auto&& fieldName : location) {
+        elem = current[fieldName];
+        if (elem.isABSONObj()) {
+            current = elem.Obj();
+        }
+    }
+    return elem;
+}
+
+/**
+ * Fills in 'path' with the child indexes which lead from 'node' to the comparison against 'rhs',
+ * an element of the BSON 'node' was parsed from. Returns false if there is no such comparison.
+ */
+bool findComparison(MatchExpression* node, const BSONElement& rhs, std::vector<size_t>* path) {
+    if (ComparisonMatchExpression::isComparisonMatchExpression(node) &&
+        static_cast<ComparisonMatchExpression*>(node)->getData().rawdata() == rhs.rawdata()) {
+        return true;
+    }
+    for (size_t i = 0; i < node->numChildren(); ++i) {
+        path->push_back(i);
+        if (findComparison(node->getChild(i), rhs, path)) {
+            return true;
+        }
+        path->pop_back();
+    }
+    return false;
+}
+
+}  // namespace
+
+StatusWith<std::unique_ptr<PreparedFind>> PreparedFind::prepare(
+    OperationContext* opCtx,
+    std::unique_ptr<QueryRequest> qr,
+    const ExtensionsCallback& extensionsCallback,
+    MatchExpressionParser::AllowedFeatureSet allowedFeatures) {
+    const BSONObj filter = qr->getFilter();
+    FilterBinder binder(nullptr);
+    BSONObjBuilder filterBuilder;
+    Status status = binder.bindFilter(filter, &filterBuilder);
+    if (!status.isOK()) {
+        return status;
+    }
+    qr->setFilter(filterBuilder.obj());
+
+    // The parsed forms of these refer to 'opCtx', so they could not be bound by later operations.
+    allowedFeatures &= ~(MatchExpressionParser::AllowedFeatures::kText |
+                         MatchExpressionParser::AllowedFeatures::kJavascript |
+                         MatchExpressionParser::AllowedFeatures::kExpr);
+
+    auto statusWithCQ = CanonicalQuery::canonicalize(
+        opCtx, std::move(qr), nullptr, extensionsCallback, allowedFeatures);
+    if (!statusWithCQ.isOK()) {
+        return statusWithCQ.getStatus();
+    }
+    auto query = std::move(statusWithCQ.getValue());
+
+    // Each placeholder is parsed into a comparison against it, which is where its values are
+    // bound.
+    const BSONObj parsedFilter = query->getQueryObj();
+    std::vector<Placeholder> placeholders;
+    for (auto&& bound : binder.getPlaceholders()) {
+        std::vector<size_t> nodePath;
+        if (!findComparison(query->root(), elementAt(parsedFilter, bound.location), &nodePath)) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "cannot prepare a query in which parameter '"
+                                        << bound.name
+                                        << "' is not the operand of a comparison");
+        }
+        placeholders.push_back({bound.name, std::move(nodePath)});
+    }
+
+    return std::unique_ptr<PreparedFind>(
+        new PreparedFind(filter.getOwned(), std::move(query), std::move(placeholders)));
+}
+
+StatusWith<std::unique_ptr<CanonicalQuery>> PreparedFind::bind(OperationContext* opCtx,
+                                                               const BSONObj& params) const {
+    for (auto&& param : params) {
+        const auto name = param.fieldNameStringData();
+        if (std::none_of(_placeholders.begin(), _placeholders.end(), [&](const auto& placeholder) {
+                return placeholder.name == name;
+            })) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "the query has no parameter '" << name << "'");
+        }
+    }
+
+    FilterBinder binder(&params);
+    BSONObjBuilder filterBuilder;
+    Status status = binder.bindFilter(_filter, &filterBuilder);
+    if (!status.isOK()) {
+        return status;
+    }
+    auto qr = stdx::make_unique<QueryRequest>(_query->getQueryRequest());
+    qr->setFilter(filterBuilder.obj());
+    const BSONObj boundFilter = qr->getFilter();
+
+    // The placeholders are found in the same order in which they were when the query was
+    // prepared.
+    const auto& bound = binder.getPlaceholders();
+    invariant(bound.size() == _placeholders.size());
+
+    auto root = _query->root()->shallowClone();
+    for (size_t i = 0; i < _placeholders.size(); ++i) {
+        MatchExpression* node = root.get();
+        for (auto childIndex : _placeholders[i].nodePath) {
+            node = node->getChild(childIndex);
+        }
+        auto comparison = static_cast<ComparisonMatchExpression*>(node);
+
+        auto value = elementAt(boundFilter, bound[i].location);
+        if (value.type() == BSONType::RegEx && comparison->matchType() != MatchExpression::EQ) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "Can't have RegEx as arg to predicate over field '"
+                                        << comparison->path()
+                                        << "'.");
+        }
+        try {
+            comparison->setData(value);
+        } catch (const DBException& ex) {
+            return ex.toStatus();
+        }
+    }
+
+    std::unique_ptr<CollatorInterface> collator;
+    if (_query->getCollator()) {
+        collator = _query->getCollator()->clone();
+    }
+
+    // The comparisons which were not bound refer to the filter the query was prepared with.
+    return CanonicalQuery::canonicalizeParsed(opCtx,
+                                              std::move(qr),
+                                              std::move(root),
+                                              _query->getQueryObj(),
+                                              std::move(collator),
+                                              _query->canHaveNoopMatchNodes());
+}
+
+std::vector<std::string> PreparedFind::getParameterNames() const {
+    std::vector<std::string> names;
+    std::set<std::string> seen;
+    for (auto&& placeholder : _placeholders) {
+        if (seen.insert(placeholder.name).second) {
+            names.push_back(placeholder.name);
+        }
+    }
+    return names;
+}
+
+PreparedFindCatalog& PreparedFindCatalog::get(ServiceContext* serviceContext) {
+    return getPreparedFindCatalog(serviceContext);
+}
+
+long long PreparedFindCatalog::add(std::shared_ptr<const PreparedFind> prepared) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    const long long id = _nextId++;
+    _prepared.emplace(id, std::move(prepared));
+    while (_prepared.size() > static_cast<size_t>(internalQueryPreparedFindCatalogSize.load())) {
+        _prepared.erase(_prepared.begin());
+    }
+    return id;
+}
+
+std::shared_ptr<const PreparedFind> PreparedFindCatalog::lookup(long long id) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _prepared.find(id);
+    return it == _prepared.end() ? nullptr : it->second;
+}
+
+size_t PreparedFindCatalog::size() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _prepared.size();
+}
+
+}  // namespace mongo
@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status_with.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * A find whose filter has placeholders of the form {$param: "<name>"} in place of some of the
+ * values it compares against. Its filter is parsed, normalized and validated once when it is
+ * prepared, and running it with values for its parameters only binds them to the parsed tree.
+ *
+ * A placeholder may be the operand of $eq, $lt, $lte, $gt or $gte, or the value of a field to
+ * which it is compared for equality, as in {a: {$param: "a"}}. The filter may not use $text, $where
+ * or $expr, whose parsed forms are bound to the operation which parsed them.
+ */
+class PreparedFind {
+    MONGO_DISALLOW_COPYING(PreparedFind);
+
+public:
+    static constexpr StringData kParamField = "$param"_sd;
+
+    /**
+     * Parses the filter of 'qr', with its placeholders, into a prepared query.
+     */
+    static StatusWith<std::unique_ptr<PreparedFind>> prepare(
+        OperationContext* opCtx,
+        std::unique_ptr<QueryRequest> qr,
+        const ExtensionsCallback& extensionsCallback,
+        MatchExpressionParser::AllowedFeatureSet allowedFeatures);
+
+    /**
+     * Returns the query with the values in 'params', an object with a field for each parameter,
+     * bound to its placeholders.
+     */
+    StatusWith<std::unique_ptr<CanonicalQuery>> bind(OperationContext* opCtx,
+                                                     const BSONObj& params) const;
+
+    const NamespaceString& nss() const {
+        return _query->nss();
+    }
+
+    /**
+     * Returns the name of each parameter, once each, in the order they first appear in the filter.
+     */
+    std::vector<std::string> getParameterNames() const;
+
+private:
+    struct Placeholder {
+        std::string name;
+
+        // The child indexes which lead from the root of the match expression tree to the
+        // comparison against the placeholder.
+        std::vector<size_t> nodePath;
+    };
+
+    PreparedFind(BSONObj filter,
+                 std::unique_ptr<CanonicalQuery> query,
+                 std::vector<Placeholder> placeholders)
+        : _filter(std::move(filter)),
+          _query(std::move(query)),
+          _placeholders(std::move(placeholders)) {}
+
+    // The filter as it was prepared.
+    BSONObj _filter;
+
+    // The query parsed with the placeholders themselves as the values compared against.
+    std::unique_ptr<CanonicalQuery> _query;
+    std::vector<Placeholder> _placeholders;
+};
+
+/**
+ * Holds the prepared queries of a server, identified by the ids it hands out for them. Once there
+ * are more than internalQueryPreparedFindCatalogSize, the oldest are dropped.
+ *
+ * This class is thread safe.
+ */
+class PreparedFindCatalog {
+public:
+    static PreparedFindCatalog& get(ServiceContext* serviceContext);
+
+    /**
+     * Adds 'prepared' and returns its id.
+     */
+    long long add(std::shared_ptr<const PreparedFind> prepared);
+
+    /**
+     * Returns the prepared query with the id 'id', or nullptr if there is none.
+     */
+    std::shared_ptr<const PreparedFind> lookup(long long id) const;
+
+    size_t size() const;
+
+private:
+    mutable stdx::mutex _mutex;
+    long long _nextId = 1;
+
+    // Ordered by id, and hence by age.
+    std::map<long long, std::shared_ptr<const PreparedFind>> _prepared;
+};
+
+}  // namespace mongo
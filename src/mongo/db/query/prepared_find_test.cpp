@@ -0,0 +1,195 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/prepared_find.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/query/query_request.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+
+StatusWith<std::unique_ptr<PreparedFind>> prepare(OperationContext* opCtx, const char* cmd) {
+    auto qr = uassertStatusOK(QueryRequest::makeFromFindCommand(kNss, fromjson(cmd), false));
+    return PreparedFind::prepare(opCtx,
+                                 std::move(qr),
+                                 ExtensionsCallbackNoop(),
+                                 MatchExpressionParser::kAllowAllSpecialFeatures);
+}
+
+std::unique_ptr<CanonicalQuery> canonicalize(OperationContext* opCtx, const char* cmd) {
+    auto qr = uassertStatusOK(QueryRequest::makeFromFindCommand(kNss, fromjson(cmd), false));
+    return uassertStatusOK(CanonicalQuery::canonicalize(opCtx, std::move(qr)));
+}
+
+/**
+ * Asserts that binding 'params' to the query prepared from 'preparedCmd' gives the query
+ * 'boundCmd' parses into.
+ */
+void assertBindsTo(const char* preparedCmd, const char* params, const char* boundCmd) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+
+    auto prepared = uassertStatusOK(prepare(opCtx.get(), preparedCmd));
+    auto bound = uassertStatusOK(prepared->bind(opCtx.get(), fromjson(params)));
+    auto expected = canonicalize(opCtx.get(), boundCmd);
+
+    ASSERT_TRUE(bound->root()->equivalent(expected->root()))
+        << bound->toString() << " is not " << expected->toString();
+    ASSERT_BSONOBJ_EQ(bound->getQueryObj(), expected->getQueryObj());
+    ASSERT_BSONOBJ_EQ(bound->getQueryRequest().getSort(), expected->getQueryRequest().getSort());
+}
+
+TEST(PreparedFindTest, BindsValuesComparedForEquality) {
+    assertBindsTo(
+        "{find: 'coll', filter: {a: {$param: 'a'}}}", "{a: 5}", "{find: 'coll', filter: {a: 5}}");
+    assertBindsTo("{find: 'coll', filter: {a: {$eq: {$param: 'a'}}}}",
+                  "{a: 'x'}",
+                  "{find: 'coll', filter: {a: {$eq: 'x'}}}");
+}
+
+TEST(PreparedFindTest, BindsObjectValuesAsEqualityRatherThanOperators) {
+    assertBindsTo("{find: 'coll', filter: {a: {$param: 'a'}}}",
+                  "{a: {$gt: 1}}",
+                  "{find: 'coll', filter: {a: {$eq: {$gt: 1}}}}");
+}
+
+TEST(PreparedFindTest, BindsValuesOfRangeComparisons) {
+    assertBindsTo("{find: 'coll', filter: {a: {$gte: {$param: 'low'}, $lt: {$param: 'high'}}}}",
+                  "{low: 1, high: 10}",
+                  "{find: 'coll', filter: {a: {$gte: 1, $lt: 10}}}");
+}
+
+TEST(PreparedFindTest, BindsValuesUnderLogicalOperators) {
+    assertBindsTo(
+        "{find: 'coll', filter: {$or: [{a: {$param: 'a'}}, {b: {$not: {$lt: {$param: 'b'}}}}]}, "
+        "sort: {c: 1}}",
+        "{a: 1, b: 2}",
+        "{find: 'coll', filter: {$or: [{a: 1}, {b: {$not: {$lt: 2}}}]}, sort: {c: 1}}");
+}
+
+TEST(PreparedFindTest, BindsValuesUnderElemMatch) {
+    assertBindsTo("{find: 'coll', filter: {a: {$elemMatch: {b: {$param: 'b'}, c: 1}}}}",
+                  "{b: 3}",
+                  "{find: 'coll', filter: {a: {$elemMatch: {b: 3, c: 1}}}}");
+    assertBindsTo("{find: 'coll', filter: {a: {$elemMatch: {$gt: {$param: 'low'}}}}}",
+                  "{low: 3}",
+                  "{find: 'coll', filter: {a: {$elemMatch: {$gt: 3}}}}");
+}
+
+TEST(PreparedFindTest, BindsAParameterUsedMoreThanOnce) {
+    assertBindsTo("{find: 'coll', filter: {a: {$param: 'x'}, b: {$gt: {$param: 'x'}}}}",
+                  "{x: 4}",
+                  "{find: 'coll', filter: {a: 4, b: {$gt: 4}}}");
+}
+
+TEST(PreparedFindTest, BindsEachTimeIndependently) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    auto prepared =
+        uassertStatusOK(prepare(opCtx.get(), "{find: 'coll', filter: {a: {$param: 'a'}}}"));
+
+    auto first = uassertStatusOK(prepared->bind(opCtx.get(), fromjson("{a: 1}")));
+    auto second = uassertStatusOK(prepared->bind(opCtx.get(), fromjson("{a: 2}")));
+    ASSERT_BSONOBJ_EQ(first->getQueryObj(), fromjson("{a: 1}"));
+    ASSERT_BSONOBJ_EQ(second->getQueryObj(), fromjson("{a: 2}"));
+    ASSERT_FALSE(first->root()->equivalent(second->root()));
+}
+
+TEST(PreparedFindTest, ReportsParameterNamesOnce) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    auto prepared = uassertStatusOK(
+        prepare(opCtx.get(),
+                "{find: 'coll', filter: {b: {$param: 'y'}, a: {$param: 'x'}, c: {$param: 'y'}}}"));
+    ASSERT(prepared->getParameterNames() == (std::vector<std::string>{"y", "x"}));
+}
+
+TEST(PreparedFindTest, RejectsFiltersWhichCannotBePrepared) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    ASSERT_EQ(prepare(opCtx.get(), "{find: 'coll', filter: {a: {$in: {$param: 'a'}}}}").getStatus(),
+              ErrorCodes::BadValue);
+    ASSERT_EQ(prepare(opCtx.get(), "{find: 'coll', filter: {a: {$ne: {$param: 'a'}}}}").getStatus(),
+              ErrorCodes::BadValue);
+    ASSERT_EQ(prepare(opCtx.get(), "{find: 'coll', filter: {a: {$param: 1}}}").getStatus(),
+              ErrorCodes::TypeMismatch);
+    ASSERT_NOT_OK(
+        prepare(opCtx.get(), "{find: 'coll', filter: {$expr: {$eq: ['$a', 1]}}}").getStatus());
+}
+
+TEST(PreparedFindTest, RejectsMissingAndUnknownParameters) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    auto prepared =
+        uassertStatusOK(prepare(opCtx.get(), "{find: 'coll', filter: {a: {$param: 'a'}}}"));
+    ASSERT_EQ(prepared->bind(opCtx.get(), BSONObj()).getStatus(), ErrorCodes::BadValue);
+    ASSERT_EQ(prepared->bind(opCtx.get(), fromjson("{a: 1, b: 2}")).getStatus(),
+              ErrorCodes::BadValue);
+}
+
+TEST(PreparedFindTest, RejectsValuesTheComparisonCannotHave) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    auto prepared =
+        uassertStatusOK(prepare(opCtx.get(), "{find: 'coll', filter: {a: {$lt: {$param: 'a'}}}}"));
+    ASSERT_EQ(prepared->bind(opCtx.get(), fromjson("{a: /x/}")).getStatus(),
+              ErrorCodes::BadValue);
+    ASSERT_EQ(prepared->bind(opCtx.get(), BSON("a" << BSONUndefined)).getStatus(),
+              ErrorCodes::BadValue);
+}
+
+TEST(PreparedFindCatalogTest, DropsTheOldestPreparedFinds) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    auto& catalog = PreparedFindCatalog::get(serviceContext.getServiceContext());
+
+    const auto sizeBefore = internalQueryPreparedFindCatalogSize.load();
+    internalQueryPreparedFindCatalogSize.store(2);
+    std::vector<long long> ids;
+    for (int i = 0; i < 3; ++i) {
+        ids.push_back(catalog.add(
+            uassertStatusOK(prepare(opCtx.get(), "{find: 'coll', filter: {a: {$param: 'a'}}}"))));
+    }
+    internalQueryPreparedFindCatalogSize.store(sizeBefore);
+
+    ASSERT_EQ(catalog.size(), 2U);
+    ASSERT_FALSE(catalog.lookup(ids[0]));
+    ASSERT_TRUE(catalog.lookup(ids[1]));
+    ASSERT_TRUE(catalog.lookup(ids[2]));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,262 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/projection_exec.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/index/sort_key_generator.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/index_entry.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Benchmarks for the per-document work done while executing queries and aggregations: matching,
+ * projecting, generating sort keys, building index bounds, evaluating aggregation expressions,
+ * and converting to and from Document.
+ *
+ * The documents resemble an order in an e-commerce collection: a few scalar fields, a nested
+ * customer sub-document, and an array of line items whose length is the benchmark argument.
+ */
+BSONObj makeOrder(int id, int numItems) {
+    BSONObjBuilder bob;
+    bob.append("_id", id);
+    bob.append("status", id % 3 == 0 ? "shipped" : "pending");
+    bob.append("total", 19.99 * numItems + id % 100);
+    bob.appendDate("createdAt", Date_t::fromMillisSinceEpoch(1530000000000LL + id * 1000LL));
+    {
+        BSONObjBuilder customer(bob.subobjStart("customer"));
+        customer.append("name", "Customer " + std::to_string(id % 1000));
+        customer.append("email", "customer" + std::to_string(id % 1000) + "@example.com");
+        {
+            BSONObjBuilder address(customer.subobjStart("address"));
+            address.append("city", id % 2 == 0 ? "New York" : "Dublin");
+            address.append("zip", std::to_string(10000 + id % 90000));
+        }
+    }
+    {
+        BSONArrayBuilder items(bob.subarrayStart("items"));
+        for (int i = 0; i < numItems; ++i) {
+            BSONObjBuilder item(items.subobjStart());
+            item.append("sku", "SKU-" + std::to_string((id + i) % 5000));
+            item.append("qty", 1 + i % 4);
+            item.append("price", 4.99 + i);
+        }
+    }
+    bob.append("tags", BSON_ARRAY("gift"
+                                  << "express"
+                                  << "loyalty"));
+    return bob.obj();
+}
+
+std::unique_ptr<MatchExpression> parseMatch(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                            const BSONObj& filter) {
+    return uassertStatusOK(MatchExpressionParser::parse(filter, expCtx));
+}
+
+void runMatch(benchmark::State& state, const BSONObj& filter) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto expr = parseMatch(expCtx, filter);
+    auto doc = makeOrder(42, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(expr->matchesBSON(doc));
+    }
+}
+
+void BM_MatchEquality(benchmark::State& state) {
+    runMatch(state, fromjson("{status: 'shipped'}"));
+}
+
+void BM_MatchConjunction(benchmark::State& state) {
+    runMatch(state,
+             fromjson("{status: {$in: ['shipped', 'pending']}, total: {$gte: 10, $lt: 1000}, "
+                      "'customer.address.city': 'New York'}"));
+}
+
+void BM_MatchArrayOfSubdocuments(benchmark::State& state) {
+    runMatch(state, fromjson("{items: {$elemMatch: {qty: {$gte: 4}, price: {$gt: 1000}}}}"));
+}
+
+BENCHMARK(BM_MatchEquality)->Arg(10);
+BENCHMARK(BM_MatchConjunction)->Arg(10);
+BENCHMARK(BM_MatchArrayOfSubdocuments)->Range(1, 1000);
+
+void runProjection(benchmark::State& state, const BSONObj& spec) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    ProjectionExec exec(expCtx->opCtx, spec, nullptr, nullptr);
+    auto doc = makeOrder(42, state.range(0));
+    for (auto _ : state) {
+        WorkingSetMember member;
+        member.obj = Snapshotted<BSONObj>(SnapshotId(), doc);
+        member.transitionToOwnedObj();
+        uassertStatusOK(exec.transform(&member));
+        benchmark::DoNotOptimize(member.obj.value());
+    }
+}
+
+void BM_ProjectionInclusion(benchmark::State& state) {
+    runProjection(state, fromjson("{status: 1, total: 1, 'customer.name': 1}"));
+}
+
+void BM_ProjectionExclusion(benchmark::State& state) {
+    runProjection(state, fromjson("{items: 0, tags: 0}"));
+}
+
+void BM_ProjectionSlice(benchmark::State& state) {
+    runProjection(state, fromjson("{status: 1, items: {$slice: 3}}"));
+}
+
+BENCHMARK(BM_ProjectionInclusion)->Range(1, 1000);
+BENCHMARK(BM_ProjectionExclusion)->Range(1, 1000);
+BENCHMARK(BM_ProjectionSlice)->Range(1, 1000);
+
+void runSortKey(benchmark::State& state, const BSONObj& sortSpec) {
+    SortKeyGenerator generator(sortSpec, nullptr);
+    auto doc = makeOrder(42, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(uassertStatusOK(generator.getSortKey(doc, nullptr)));
+    }
+}
+
+void BM_SortKeyCompound(benchmark::State& state) {
+    runSortKey(state, BSON("status" << 1 << "createdAt" << -1));
+}
+
+void BM_SortKeyArray(benchmark::State& state) {
+    runSortKey(state, BSON("items.price" << -1));
+}
+
+BENCHMARK(BM_SortKeyCompound)->Arg(10);
+BENCHMARK(BM_SortKeyArray)->Range(1, 1000);
+
+void runIndexBounds(benchmark::State& state, const BSONObj& keyPattern, const BSONObj& filter) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto expr = parseMatch(expCtx, filter);
+    IndexEntry index(keyPattern);
+    BSONElement elt = keyPattern.firstElement();
+    for (auto _ : state) {
+        OrderedIntervalList oil;
+        IndexBoundsBuilder::BoundsTightness tightness;
+        IndexBoundsBuilder::translate(expr.get(), elt, index, &oil, &tightness);
+        benchmark::DoNotOptimize(oil);
+    }
+}
+
+void BM_IndexBoundsRange(benchmark::State& state) {
+    runIndexBounds(state, BSON("total" << 1), fromjson("{total: {$gt: 10}}"));
+}
+
+void BM_IndexBoundsIn(benchmark::State& state) {
+    BSONObjBuilder filter;
+    {
+        BSONObjBuilder idBuilder(filter.subobjStart("_id"));
+        BSONArrayBuilder in(idBuilder.subarrayStart("$in"));
+        for (int i = 0; i < state.range(0); ++i) {
+            in.append(i * 7);
+        }
+    }
+    runIndexBounds(state, BSON("_id" << 1), filter.obj());
+}
+
+BENCHMARK(BM_IndexBoundsRange);
+BENCHMARK(BM_IndexBoundsIn)->Range(1, 1000);
+
+void runExpression(benchmark::State& state, const BSONObj& spec) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto expression = Expression::parseObject(expCtx, spec, expCtx->variablesParseState);
+    Document doc(makeOrder(42, state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(expression->evaluate(doc));
+    }
+}
+
+void BM_ExpressionArithmetic(benchmark::State& state) {
+    runExpression(state, fromjson("{withTax: {$multiply: ['$total', 1.08]}}"));
+}
+
+void BM_ExpressionConditional(benchmark::State& state) {
+    runExpression(state,
+                  fromjson("{priority: {$cond: [{$eq: ['$status', 'shipped']}, 'low', 'high']}, "
+                           "city: {$toUpper: '$customer.address.city'}}"));
+}
+
+void BM_ExpressionArrayAggregation(benchmark::State& state) {
+    runExpression(state,
+                  fromjson("{itemTotal: {$sum: {$map: {input: '$items', as: 'i', "
+                           "in: {$multiply: ['$$i.qty', '$$i.price']}}}}}"));
+}
+
+BENCHMARK(BM_ExpressionArithmetic)->Arg(10);
+BENCHMARK(BM_ExpressionConditional)->Arg(10);
+BENCHMARK(BM_ExpressionArrayAggregation)->Range(1, 1000);
+
+void BM_DocumentFromBson(benchmark::State& state) {
+    auto bson = makeOrder(42, state.range(0));
+    for (auto _ : state) {
+        Document doc(bson);
+        // Fields are only decoded when they are accessed.
+        benchmark::DoNotOptimize(doc["items"]);
+    }
+}
+
+void BM_DocumentToBson(benchmark::State& state) {
+    Document doc(makeOrder(42, state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(doc.toBson());
+    }
+}
+
+void BM_MutableDocumentBuild(benchmark::State& state) {
+    Document source(makeOrder(42, state.range(0)));
+    for (auto _ : state) {
+        MutableDocument doc(source);
+        doc.setField("status", Value("delivered"_sd));
+        doc.addField("itemCount", Value(static_cast<int>(state.range(0))));
+        doc.setNestedField(FieldPath("customer.address.zip"), Value("10001"_sd));
+        benchmark::DoNotOptimize(doc.freeze());
+    }
+}
+
+BENCHMARK(BM_DocumentFromBson)->Range(1, 1000);
+BENCHMARK(BM_DocumentToBson)->Range(1, 1000);
+BENCHMARK(BM_MutableDocumentBuild)->Range(1, 1000);
+
+}  // namespace
+}  // namespace mongo
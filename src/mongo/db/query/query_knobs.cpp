@@ -38,6 +38,15 @@ MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlanEvaluationCollFraction, double, 0
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlanEvaluationMaxResults, int, 101);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlanEvaluationWorksPerBatch, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryPlanEvaluationWorksPerBatch must be > 0");
+        }
+        return Status::OK();
+    });
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheSize, int, 5000);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheFeedbacksStored, int, 20);
@@ -57,8 +66,65 @@ MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheDisableInactiveEntries, bool, fa
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheListPlansNewOutput, bool, false);
 
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(internalQueryCacheShareAcrossCollections, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheSelectivityBuckets, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > kMaxPlanCacheSelectivityBuckets) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "internalQueryCacheSelectivityBuckets must be between 0 "
+                                           "and "
+                                        << kMaxPlanCacheSelectivityBuckets);
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(internalQueryResultCacheEnabled, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryResultCacheSize, int, 100)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryResultCacheSize must be strictly positive");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryResultCacheMaxResultBytes, int, 256 * 1024);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPreparedFindCatalogSize, int, 1000)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryPreparedFindCatalogSize must be strictly positive");
+        }
+        return Status::OK();
+    });
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerMaxIndexedSolutions, int, 64);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerEnableIndexSkipScan, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerMaxCandidatesForTrial, int, 0)
+    ->withValidator([](const int& newVal) {
+        // At least two candidates must remain, so that the winner is still picked by the
+        // multi-planner and cached.
+        if (newVal < 0 || newVal == 1) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryPlannerMaxCandidatesForTrial must be 0 or at least 2");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerCostEstimateProbeLimit, int, 1000)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryPlannerCostEstimateProbeLimit must be positive");
+        }
+        return Status::OK();
+    });
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryEnumerationMaxOrSolutions, int, 10);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryEnumerationMaxIntersectPerAnd, int, 3);
@@ -79,8 +145,69 @@ MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecMaxBlockingSortBytes, int, 32 * 1
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecYieldIterations, int, 128);
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecYieldPeriodMS, int, 10);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecWorkBatchSize, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0) {
+            return Status(ErrorCodes::BadValue, "internalQueryExecWorkBatchSize must be > 0");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryCountScanBatchSize, int, 1000)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0) {
+            return Status(ErrorCodes::BadValue, "internalQueryCountScanBatchSize must be > 0");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(internalQueryCollScanFilterWorkerThreads, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 128) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryCollScanFilterWorkerThreads must be between 0 and 128");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryCollScanFilterBatchSize, int, 1024)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryCollScanFilterBatchSize must be > 0");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryFetchBatchSize, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 100000) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryFetchBatchSize must be between 0 and 100000");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryBatchedIdHackMinKeys, int, 100)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryBatchedIdHackMinKeys must be greater than or equal to 0");
+        }
+        return Status::OK();
+    });
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryFacetBufferSizeBytes, int, 100 * 1024 * 1024);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryFacetMaxThreads, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 64) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryFacetMaxThreads must be between 1 and 64");
+        }
+        return Status::OK();
+    });
+
 MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceSortMaxBlockingSortBytes,
                               long long,
                               100 * 1024 * 1024)
@@ -92,6 +219,24 @@ MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceSortMaxBlockingSortBytes,
         return Status::OK();
     });
 
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceSortMaxPushdownLimit, long long, 0)
+    ->withValidator([](const long long& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalDocumentSourceSortMaxPushdownLimit must be >= 0");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalSorterMaxThreads, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 64) {
+            return Status(ErrorCodes::BadValue,
+                          "internalSorterMaxThreads must be between 1 and 64");
+        }
+        return Status::OK();
+    });
+
 MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceGroupMaxMemoryBytes,
                               long long,
                               100 * 1024 * 1024)
@@ -103,17 +248,143 @@ MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceGroupMaxMemoryBytes,
         return Status::OK();
     });
 
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceGroupEnableStreaming, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceGroupMaxThreads, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 64) {
+            return Status(ErrorCodes::BadValue,
+                          "internalDocumentSourceGroupMaxThreads must be between 1 and 64");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceGroupSpillPartitions, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal != 0 && (newVal < 2 || newVal > 256)) {
+            return Status(ErrorCodes::BadValue,
+                          "internalDocumentSourceGroupSpillPartitions must be 0 or between 2 and "
+                          "256");
+        }
+        return Status::OK();
+    });
+
 MONGO_EXPORT_SERVER_PARAMETER(internalInsertMaxBatchSize,
                               int,
                               internalQueryExecYieldIterations.load() / 2);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalUpdateMaxBatchSize, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1) {
+            return Status(ErrorCodes::BadValue, "internalUpdateMaxBatchSize must be at least 1");
+        }
+        return Status::OK();
+    });
+
 MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceCursorBatchSizeBytes, int, 4 * 1024 * 1024);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceCursorReadAhead, bool, false);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupCacheSizeBytes, int, 100 * 1024 * 1024);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupUseForeignValueFilter, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupForeignValueSetMaxBytes,
+                              int,
+                              16 * 1024 * 1024)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalDocumentSourceLookupForeignValueSetMaxBytes must be >= 0");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupForeignValueBloomFilterBytes,
+                              int,
+                              16 * 1024 * 1024)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalDocumentSourceLookupForeignValueBloomFilterBytes must be > 0");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupHashJoinMaxBytes, long long, 0)
+    ->withValidator([](const long long& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalDocumentSourceLookupHashJoinMaxBytes must be >= 0");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceGraphLookupMaxMemoryBytes,
+                              long long,
+                              100 * 1024 * 1024)
+    ->withValidator([](const long long& newVal) {
+        if (newVal <= 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalDocumentSourceGraphLookupMaxMemoryBytes must be > 0");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceGraphLookupFrontierBatchSize, int, 10000)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalDocumentSourceGraphLookupFrontierBatchSize must be > 0");
+        }
+        return Status::OK();
+    });
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerGenerateCoveredWholeIndexScans, bool, false);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryIgnoreUnknownJSONSchemaKeywords, bool, false);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryProhibitBlockingMergeOnMongoS, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryCompileAggExpressions, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryStreamSortedMerge, bool, true);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryAdaptiveGetMoreMaxBatchSize, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryAdaptiveGetMoreMaxBatchSize must be >= 0");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryAdaptiveGetMoreInitialBatchSize, int, 101)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryAdaptiveGetMoreInitialBatchSize must be > 0");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryStratifiedSampleMaxRatio, double, 0.0)
+    ->withValidator([](const double& newVal) {
+        if (newVal < 0.0 || newVal > 1.0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryStratifiedSampleMaxRatio must be between 0 and 1");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(internalChangeStreamUseSharedReader, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalChangeStreamSharedReaderMaxQueuedEvents, int, 1000)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalChangeStreamSharedReaderMaxQueuedEvents must be > 0");
+        }
+        return Status::OK();
+    });
 }  // namespace mongo
@@ -48,6 +48,9 @@ extern AtomicDouble internalQueryPlanEvaluationCollFraction;
 // Stop working plans once a plan returns this many results.
 extern AtomicInt32 internalQueryPlanEvaluationMaxResults;
 
+// How many times in a row each candidate plan is worked before moving on to the next one.
+extern AtomicInt32 internalQueryPlanEvaluationWorksPerBatch;
+
 // Do we give a big ranking bonus to intersection plans?
 extern AtomicBool internalQueryForceIntersectionPlans;
 
@@ -82,6 +85,34 @@ extern AtomicBool internalQueryCacheDisableInactiveEntries;
 // Whether or not planCacheListPlans uses the new output format.
 extern AtomicBool internalQueryCacheListPlansNewOutput;
 
+// Whether collections with identical index specifications and default collation share a single
+// plan cache instead of each owning one. Query shapes cached by one collection are then visible
+// to planCacheListQueryShapes on the others. May only be set at startup.
+extern bool internalQueryCacheShareAcrossCollections;
+
+// How many plan cache entries a query shape may have, one per order of magnitude of the number of
+// index keys matching its leading equality predicate. 0 or 1 caches a single entry per shape.
+const int kMaxPlanCacheSelectivityBuckets = 6;
+extern AtomicInt32 internalQueryCacheSelectivityBuckets;
+
+//
+// query result cache
+//
+
+// Whether find commands cache their results per collection, so that repeating an identical query
+// on a collection which has not been written to since returns the cached results without planning
+// or executing it. May only be set at startup.
+extern bool internalQueryResultCacheEnabled;
+
+// How many results each collection caches.
+extern AtomicInt32 internalQueryResultCacheSize;
+
+// Results larger than this many bytes are not cached.
+extern AtomicInt32 internalQueryResultCacheMaxResultBytes;
+
+// How many prepared finds a server holds before it drops the oldest.
+extern AtomicInt32 internalQueryPreparedFindCatalogSize;
+
 //
 // Planning and enumeration.
 //
@@ -89,6 +120,17 @@ extern AtomicBool internalQueryCacheListPlansNewOutput;
 // How many indexed solutions will QueryPlanner::plan output?
 extern AtomicInt32 internalQueryPlannerMaxIndexedSolutions;
 
+// Whether the planner considers skip scanning compound indexes whose leading field is not
+// constrained by the query.
+extern AtomicBool internalQueryPlannerEnableIndexSkipScan;
+
+// How many of the cheapest candidate solutions, by estimated keys and documents examined, are
+// raced by the multi-planner. 0 races every candidate.
+extern AtomicInt32 internalQueryPlannerMaxCandidatesForTrial;
+
+// How many keys each index scan examines at most when estimating the cost of a candidate.
+extern AtomicInt32 internalQueryPlannerCostEstimateProbeLimit;
+
 // How many solutions will the enumerator consider at each OR?
 extern AtomicInt32 internalQueryEnumerationMaxOrSolutions;
 
@@ -120,21 +162,133 @@ extern AtomicInt32 internalQueryExecYieldIterations;
 // Yield if it's been at least this many milliseconds since we last yielded.
 extern AtomicInt32 internalQueryExecYieldPeriodMS;
 
+// Maximum number of units of work the PlanExecutor asks its root stage to perform per call. The
+// resulting batch of results is drained by subsequent calls to getNext(). A value of 1 disables
+// batching.
+extern AtomicInt32 internalQueryExecWorkBatchSize;
+
+// Maximum number of index keys a COUNT_SCAN examines each time its parent COUNT stage is worked.
+// A value of 1 makes the COUNT_SCAN produce one result per key instead.
+extern AtomicInt32 internalQueryCountScanBatchSize;
+
+// Number of worker threads used to evaluate collection scan filters concurrently. A value of zero
+// disables concurrent filter evaluation and collection scans match each document as they read it.
+// May only be set at startup.
+extern int internalQueryCollScanFilterWorkerThreads;
+
+// How many records a collection scan reads ahead before farming out their filter evaluation to the
+// worker threads.
+extern AtomicInt32 internalQueryCollScanFilterBatchSize;
+
+// How many RecordIds a FETCH stage collects from its child before reading their documents in
+// RecordId order, turning the random reads of an index scan into a forward pass over the record
+// store. Zero disables batching and each document is read as soon as its RecordId arrives.
+extern AtomicInt32 internalQueryFetchBatchSize;
+
+// The smallest number of values in a query of the form {_id: {$in: [...]}} for which the query is
+// answered by a BATCHED_IDHACK stage rather than planned. Zero disables the stage.
+extern AtomicInt32 internalQueryBatchedIdHackMinKeys;
+
 // Limit the size that we write without yielding to 16MB / 64 (max expected number of indexes)
 const int64_t insertVectorMaxBytes = 256 * 1024;
 
 // The number of bytes to buffer at once during a $facet stage.
 extern AtomicInt32 internalQueryFacetBufferSizeBytes;
 
+// The maximum number of threads, including the calling thread, a $facet stage may use to run its
+// sub-pipelines over each buffered batch of input. A value of 1 runs them on the calling thread.
+extern AtomicInt32 internalQueryFacetMaxThreads;
+
 extern AtomicInt64 internalDocumentSourceSortMaxBlockingSortBytes;
 
+// An aggregation whose $sort is followed by a $limit of at most this many documents, and which no
+// index can sort, hands both to the query system as a top-k SORT stage instead of sorting in the
+// pipeline. Zero keeps such sorts in the pipeline.
+extern AtomicInt64 internalDocumentSourceSortMaxPushdownLimit;
+
+// The maximum number of threads the external sorter may use to sort each in-memory run, for both
+// $sort and index builds. A value of 1 sorts on the calling thread only.
+extern AtomicInt32 internalSorterMaxThreads;
+
 extern AtomicInt64 internalDocumentSourceGroupMaxMemoryBytes;
 
+// When enabled, a $group whose _id is a single field path streams its groups out one at a time if
+// an index delivers its input ordered by that field, rather than building a hash table.
+extern AtomicBool internalDocumentSourceGroupEnableStreaming;
+
+// The maximum number of threads, including the calling thread, a hashing $group may use to build
+// partial groups over slices of its input before merging them. A value of 1 groups on the calling
+// thread only.
+extern AtomicInt32 internalDocumentSourceGroupMaxThreads;
+
+// When a $group allowed to use disk runs out of memory, it spills its groups into this many files
+// by hash of their _id and later regroups one file at a time, instead of writing sorted runs and
+// merging them. Zero keeps the sorted runs.
+extern AtomicInt32 internalDocumentSourceGroupSpillPartitions;
+
 extern AtomicInt32 internalInsertMaxBatchSize;
 
+// A multi-update of a collection which is not written to the oplog applies up to this many
+// documents in each WriteUnitOfWork, rather than committing each document separately. One disables
+// the batching.
+extern AtomicInt32 internalUpdateMaxBatchSize;
+
 extern AtomicInt32 internalDocumentSourceCursorBatchSizeBytes;
 
+// When enabled, a $cursor which feeds a blocking stage like $group or $sort loads its next batch on
+// a separate thread while the pipeline consumes the current one.
+extern AtomicBool internalDocumentSourceCursorReadAhead;
+
 extern AtomicInt32 internalDocumentSourceLookupCacheSizeBytes;
 
+// When enabled, a localField/foreignField $lookup first reads every foreignField value from the
+// foreign collection, and skips the foreign query for local documents whose values appear nowhere.
+extern AtomicBool internalDocumentSourceLookupUseForeignValueFilter;
+
+// The approximate size of foreignField values kept exactly, beyond which the filter above switches
+// to a Bloom filter of internalDocumentSourceLookupForeignValueBloomFilterBytes.
+extern AtomicInt32 internalDocumentSourceLookupForeignValueSetMaxBytes;
+extern AtomicInt32 internalDocumentSourceLookupForeignValueBloomFilterBytes;
+
+// A localField/foreignField $lookup joins against an in-memory hash table of the foreign collection
+// when its documents fit in this many bytes. Zero disables the hash join.
+extern AtomicInt64 internalDocumentSourceLookupHashJoinMaxBytes;
+
+// The memory $graphLookup may use for the documents visited and the frontier of each search. When
+// allowed to use disk, it spills the visited documents rather than failing once over this limit.
+extern AtomicInt64 internalDocumentSourceGraphLookupMaxMemoryBytes;
+
+// $graphLookup queries for at most this many values of the frontier at a time.
+extern AtomicInt32 internalDocumentSourceGraphLookupFrontierBatchSize;
+
 extern AtomicBool internalQueryProhibitBlockingMergeOnMongoS;
+
+// When enabled, the computed fields of $project and $addFields are compiled into a flat register
+// program after optimization instead of being evaluated by walking the expression tree.
+extern AtomicBool internalQueryCompileAggExpressions;
+
+// When enabled, a sorted merge on mongos returns a buffered result as soon as it sorts no later
+// than the last result received from every remote whose next batch is still outstanding, rather
+// than waiting for each remote to have a result buffered.
+extern AtomicBool internalQueryStreamSortedMerge;
+
+// When positive and the client did not specify a batchSize, the getMores which mongos sends to each
+// remote during a merge start at internalQueryAdaptiveGetMoreInitialBatchSize documents and double
+// with every getMore sent to that remote, up to this many documents. Zero leaves the batchSize of
+// these getMores unset.
+extern AtomicInt32 internalQueryAdaptiveGetMoreMaxBatchSize;
+extern AtomicInt32 internalQueryAdaptiveGetMoreInitialBatchSize;
+
+// A leading $sample whose size is too large a fraction of the collection for a random cursor, but
+// no more than this fraction of it, draws one document from each of 'size' equally sized strata of
+// a forward collection scan instead of sorting the whole collection by random values. The sampled
+// documents are returned in collection order. Zero disables stratified sampling.
+extern AtomicDouble internalQueryStratifiedSampleMaxRatio;
+
+// When enabled, change streams on a replica set member which do not specify a resume point share a
+// single oplog reader with the other change streams on the same namespace. Each stream buffers at
+// most internalChangeStreamSharedReaderMaxQueuedEvents events which it has not yet returned, and
+// fails with a resumable error if it falls further behind than that.
+extern AtomicBool internalChangeStreamUseSharedReader;
+extern AtomicInt32 internalChangeStreamSharedReaderMaxQueuedEvents;
 }  // namespace mongo
@@ -51,6 +51,7 @@
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/util/log.h"
@@ -288,6 +289,17 @@ std::unique_ptr<QuerySolution> buildWholeIXSoln(const IndexEntry& index,
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
 }
 
+std::unique_ptr<QuerySolution> buildSkipScanSoln(const IndexEntry& index,
+                                                 const CanonicalQuery& query,
+                                                 const QueryPlannerParams& params) {
+    std::unique_ptr<QuerySolutionNode> solnRoot(
+        QueryPlannerAccess::skipScanIndex(index, query, params));
+    if (!solnRoot) {
+        return nullptr;
+    }
+    return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
+}
+
 bool providesSort(const CanonicalQuery& query, const BSONObj& kp) {
     return query.getQueryRequest().getSort().isPrefixOf(kp, SimpleBSONElementComparator::kInstance);
 }
@@ -457,6 +469,13 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
         } else {
             return {std::move(soln)};
         }
+    } else if (SolutionCacheData::SKIP_IXSCAN_SOLN == winnerCacheData.solnType) {
+        auto soln = buildSkipScanSoln(*winnerCacheData.tree->entry, query, params);
+        if (!soln) {
+            return Status(ErrorCodes::BadValue, "plan cache error: index skip scan soln");
+        } else {
+            return {std::move(soln)};
+        }
     } else if (SolutionCacheData::COLLSCAN_SOLN == winnerCacheData.solnType) {
         // The cached solution is a collection scan. We don't cache collscans
         // with tailable==true, hence the false below.
@@ -960,6 +979,31 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         }
     }
 
+    // A compound index whose leading field the query does not constrain can still be skip scanned
+    // on its later fields. This pays off when the leading field has few distinct values; plan
+    // ranking decides against a collection scan, which is always a candidate alongside.
+    size_t numSkipScanSolns = 0;
+    if (internalQueryPlannerEnableIndexSkipScan.load() && hintedIndex.isEmpty() && !isTailable &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::GEO_NEAR) &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::TEXT)) {
+        for (auto&& index : fullIndexList) {
+            auto soln = buildSkipScanSoln(index, query, params);
+            if (soln) {
+                LOG(5) << "Planner: outputting soln that skip scans index:" << endl
+                       << redact(soln->toString());
+                PlanCacheIndexTree* indexTree = new PlanCacheIndexTree();
+                indexTree->setIndexEntry(index);
+                SolutionCacheData* scd = new SolutionCacheData();
+                scd->tree.reset(indexTree);
+                scd->solnType = SolutionCacheData::SKIP_IXSCAN_SOLN;
+
+                soln->cacheData.reset(scd);
+                out.push_back(std::move(soln));
+                ++numSkipScanSolns;
+            }
+        }
+    }
+
     // If a projection exists, there may be an index that allows for a covered plan, even if none
     // were considered earlier.
     const auto projection = query.getProj();
@@ -1004,7 +1048,7 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
     bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN);
 
     // No indexed plans?  We must provide a collscan if possible or else we can't run the query.
-    bool collscanNeeded = (0 == out.size() && canTableScan);
+    bool collscanNeeded = (numSkipScanSolns == out.size() && canTableScan);
 
     if (possibleToCollscan && (collscanRequested || collscanNeeded)) {
         auto collscan = buildCollscanSoln(query, isTailable, params);
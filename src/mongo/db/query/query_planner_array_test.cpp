@@ -1188,6 +1188,43 @@ TEST_F(QueryPlannerTest, CanIntersectBoundsWhenFirstFieldIsMultikeyButHasElemMat
         "bounds: {a: [[0, 10, true, false]], b: [['MinKey', 'MaxKey', true, true]]}}}}}");
 }
 
+TEST_F(QueryPlannerTest, CanFilterIndexKeysOnFieldWhichIsNotMultikey) {
+    MultikeyPaths multikeyPaths{{0U}, std::set<size_t>{}};
+    addIndex(BSON("tags" << 1 << "owner" << 1), multikeyPaths);
+    runQuerySortProj(
+        fromjson("{tags: 'x', owner: /bob/}"), BSONObj(), fromjson("{_id: 0, owner: 1}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{proj: {spec: {_id: 0, owner: 1}, node: {cscan: {dir: 1}}}}");
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, owner: 1}, node: {ixscan: {pattern: {tags: 1, owner: 1}, "
+        "filter: {owner: /bob/}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CannotFilterIndexKeysOnFieldWhichIsMultikey) {
+    MultikeyPaths multikeyPaths{{0U}, std::set<size_t>{}};
+    addIndex(BSON("tags" << 1 << "owner" << 1), multikeyPaths);
+    runQuery(fromjson("{tags: /x/, owner: 'bob'}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: {tags: /x/}, node: {ixscan: {pattern: {tags: 1, owner: 1}, "
+        "filter: null}}}}");
+}
+
+TEST_F(QueryPlannerTest, CanFilterIndexKeysOnNonMultikeyFieldOfSingleFieldQuery) {
+    MultikeyPaths multikeyPaths{std::set<size_t>{}, {0U}};
+    addIndex(BSON("owner" << 1 << "tags" << 1), multikeyPaths);
+    runQuery(fromjson("{owner: /bob/}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {owner: /bob/}}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {owner: 1, tags: 1}, "
+        "filter: {owner: /bob/}}}}}");
+}
+
 TEST_F(QueryPlannerTest, CanComplementBoundsOnFirstFieldWhenItIsMultikeyAndHasNotEqualExpr) {
     params.options = QueryPlannerParams::NO_TABLE_SCAN;
 
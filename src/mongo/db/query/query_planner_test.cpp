@@ -37,6 +37,7 @@
 #include "mongo/db/matcher/expression_always_boolean.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner_test_fixture.h"
 
 namespace {
@@ -3238,6 +3239,54 @@ TEST_F(QueryPlannerTest, CompoundIndexBoundsMiddleFieldMissing) {
         " c: [[-Infinity,3,true,false]]}}}}}");
 }
 
+TEST_F(QueryPlannerTest, CompoundIndexWithoutLeadingPredicateIsNotSkipScannedByDefault) {
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, CompoundIndexWithoutLeadingPredicateIsSkipScanned) {
+    internalQueryPlannerEnableIndexSkipScan.store(true);
+    ON_BLOCK_EXIT([] { internalQueryPlannerEnableIndexSkipScan.store(false); });
+
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << -1));
+    runQuery(fromjson("{b: 5, c: {$lt: 3}}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: {b: 5, c: {$lt: 3}}, node: {ixscan: {pattern: {a: 1, b: 1, c: -1}, "
+        "bounds: {a: [['MinKey','MaxKey',true,true]], b: [[5,5,true,true]], "
+        "c: [[3,-Infinity,false,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CompoundIndexWithLeadingPredicateIsNotSkipScanned) {
+    internalQueryPlannerEnableIndexSkipScan.store(true);
+    ON_BLOCK_EXIT([] { internalQueryPlannerEnableIndexSkipScan.store(false); });
+
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{a: {$gt: 8}, b: 6}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {node: {ixscan: {pattern: {a: 1, b: 1}, bounds: "
+        "{a: [[8,Infinity,false,true]], b:[[6,6,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SparseCompoundIndexIsNotSkipScanned) {
+    internalQueryPlannerEnableIndexSkipScan.store(true);
+    ON_BLOCK_EXIT([] { internalQueryPlannerEnableIndexSkipScan.store(false); });
+
+    addIndex(BSON("a" << 1 << "b" << 1), false, true);
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
 TEST_F(QueryPlannerTest, CompoundIndexBoundsRangeAndEquality) {
     addIndex(BSON("a" << 1 << "b" << 1));
     runQuery(fromjson("{a: {$gt: 8}, b: 6}"));
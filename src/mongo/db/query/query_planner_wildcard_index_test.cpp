@@ -1817,4 +1817,39 @@ TEST_F(QueryPlannerWildcardTest, ContainedOrPushdownWorksWithWildcardIndex) {
         "{$_path: [['a','a',true,true]], a:[[1,1,true,true]]}}}}}");
 }
 
+//
+// Compound wildcard index tests.
+//
+
+TEST_F(QueryPlannerWildcardTest, CompoundWildcardIndexHasBoundsOnPrefixField) {
+    addWildcardIndex(BSON("tenantId" << 1 << "attrs.$**" << 1));
+    runQuery(fromjson("{tenantId: 5, 'attrs.color': 'red'}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {"
+        "pattern: {tenantId: 1, $_path: 1, 'attrs.color': 1}, bounds: {tenantId: [[5,5,true,true]],"
+        "'$_path': [['attrs.color','attrs.color',true,true]],"
+        "'attrs.color': [['red','red',true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerWildcardTest, CompoundWildcardIndexScansAllPrefixValuesWithoutPrefixPredicate) {
+    addWildcardIndex(BSON("tenantId" << 1 << "$**" << 1));
+    runQuery(fromjson("{a: {$gt: 3}}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {tenantId: 1, $_path: 1, a: 1},"
+        "bounds: {tenantId: [['MinKey','MaxKey',true,true]], '$_path': [['a','a',true,true]],"
+        "a: [[3,Infinity,false,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerWildcardTest, CompoundWildcardIndexNotUsedWithoutWildcardPathPredicate) {
+    addWildcardIndex(BSON("tenantId" << 1 << "$**" << 1));
+    runQuery(fromjson("{tenantId: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
 }  // namespace mongo
@@ -97,6 +97,7 @@ const char kOplogReplayField[] = "oplogReplay";
 const char kNoCursorTimeoutField[] = "noCursorTimeout";
 const char kAwaitDataField[] = "awaitData";
 const char kPartialResultsField[] = "allowPartialResults";
+const char kReadOnceField[] = "readOnce";
 const char kTermField[] = "term";
 const char kOptionsField[] = "options";
 
@@ -333,6 +334,13 @@ StatusWith<unique_ptr<QueryRequest>> QueryRequest::parseFromFindCommand(unique_p
             }
 
             qr->_allowPartialResults = el.boolean();
+        } else if (fieldName == kReadOnceField) {
+            Status status = checkFieldType(el, Bool);
+            if (!status.isOK()) {
+                return status;
+            }
+
+            qr->_readOnce = el.boolean();
         } else if (fieldName == kOptionsField) {
             // 3.0.x versions of the shell may generate an explain of a find command with an
             // 'options' field. We accept this only if the 'options' field is empty so that
@@ -521,6 +529,10 @@ void QueryRequest::asFindCommandInternal(BSONObjBuilder* cmdBuilder) const {
         cmdBuilder->append(kPartialResultsField, true);
     }
 
+    if (_readOnce) {
+        cmdBuilder->append(kReadOnceField, true);
+    }
+
     if (_replicationTerm) {
         cmdBuilder->append(kTermField, *_replicationTerm);
     }
@@ -992,6 +1004,10 @@ StatusWith<BSONObj> QueryRequest::asAggregationCommand() const {
                 str::stream() << "Option " << kPartialResultsField
                               << " not supported in aggregation."};
     }
+    if (_readOnce) {
+        return {ErrorCodes::InvalidPipelineOperator,
+                str::stream() << "Option " << kReadOnceField << " not supported in aggregation."};
+    }
     if (_ntoreturn) {
         return {ErrorCodes::BadValue,
                 str::stream() << "Cannot convert to an aggregation if ntoreturn is set."};
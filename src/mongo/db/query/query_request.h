@@ -368,6 +368,14 @@ public:
         _allowPartialResults = allowPartialResults;
     }
 
+    bool isReadOnce() const {
+        return _readOnce;
+    }
+
+    void setReadOnce(bool readOnce) {
+        _readOnce = readOnce;
+    }
+
     boost::optional<long long> getReplicationTerm() const {
         return _replicationTerm;
     }
@@ -501,6 +509,10 @@ private:
     bool _exhaust = false;
     bool _allowPartialResults = false;
 
+    // If true, the data this query brings into the storage engine's cache is evicted ahead of other
+    // data, so that large scans do not push the working set out of the cache.
+    bool _readOnce = false;
+
     boost::optional<long long> _replicationTerm;
 };
 
@@ -400,7 +400,8 @@ TEST(QueryRequestTest, ParseFromCommandAllFlagsTrue) {
         "oplogReplay: true,"
         "noCursorTimeout: true,"
         "awaitData: true,"
-        "allowPartialResults: true}");
+        "allowPartialResults: true,"
+        "readOnce: true}");
     const NamespaceString nss("test.testns");
     bool isExplain = false;
     unique_ptr<QueryRequest> qr(
@@ -413,6 +414,7 @@ TEST(QueryRequestTest, ParseFromCommandAllFlagsTrue) {
     ASSERT(qr->isNoCursorTimeout());
     ASSERT(qr->isTailableAndAwaitData());
     ASSERT(qr->isAllowPartialResults());
+    ASSERT(qr->isReadOnce());
 }
 
 TEST(QueryRequestTest, ParseFromCommandCommentWithValidMinMax) {
@@ -742,6 +744,17 @@ TEST(QueryRequestTest, ParseFromCommandPartialWrongType) {
     ASSERT_NOT_OK(result.getStatus());
 }
 
+TEST(QueryRequestTest, ParseFromCommandReadOnceWrongType) {
+    BSONObj cmdObj = fromjson(
+        "{find: 'testns',"
+        "filter:  {a: 1},"
+        "readOnce: 1}");
+    const NamespaceString nss("test.testns");
+    bool isExplain = false;
+    auto result = QueryRequest::makeFromFindCommand(nss, cmdObj, isExplain);
+    ASSERT_NOT_OK(result.getStatus());
+}
+
 TEST(QueryRequestTest, ParseFromCommandReadConcernWrongType) {
     BSONObj cmdObj = fromjson(
         "{find: 'testns',"
@@ -1024,6 +1037,7 @@ TEST(QueryRequestTest, DefaultQueryParametersCorrect) {
     ASSERT_EQUALS(false, qr->isTailableAndAwaitData());
     ASSERT_EQUALS(false, qr->isExhaust());
     ASSERT_EQUALS(false, qr->isAllowPartialResults());
+    ASSERT_EQUALS(false, qr->isReadOnce());
 }
 
 //
@@ -1208,6 +1222,12 @@ TEST(QueryRequestTest, ConvertToAggregationWithAllowPartialResultsFails) {
     ASSERT_NOT_OK(qr.asAggregationCommand());
 }
 
+TEST(QueryRequestTest, ConvertToAggregationWithReadOnceFails) {
+    QueryRequest qr(testns);
+    qr.setReadOnce(true);
+    ASSERT_NOT_OK(qr.asAggregationCommand());
+}
+
 TEST(QueryRequestTest, ConvertToAggregationWithNToReturnFails) {
     QueryRequest qr(testns);
     qr.setNToReturn(7);
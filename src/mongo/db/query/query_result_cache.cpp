@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_result_cache.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/query/query_request.h"
+
+namespace mongo {
+
+QueryResultCache::QueryResultCache() : _cache(internalQueryResultCacheSize.load()) {}
+
+std::string QueryResultCache::computeKey(const PlanCacheKey& shapeKey,
+                                         const QueryRequest& qr,
+                                         StringData readConcernLevel) {
+    BSONObjBuilder findBuilder;
+    qr.asFindCommand(&findBuilder);
+
+    // The collection is implied by the cache, and the remaining fields only affect how the
+    // command runs.
+    BSONObjBuilder optionsBuilder;
+    for (auto&& elem : findBuilder.done()) {
+        auto fieldName = elem.fieldNameStringData();
+        if (fieldName != "find"_sd && fieldName != "comment"_sd && fieldName != "maxTimeMS"_sd &&
+            fieldName != "readConcern"_sd && fieldName != "term"_sd &&
+            fieldName != "noCursorTimeout"_sd) {
+            optionsBuilder.append(elem);
+        }
+    }
+    const BSONObj options = optionsBuilder.obj();
+
+    std::string key;
+    key.reserve(shapeKey.size() + readConcernLevel.size() + options.objsize() + 2);
+    key.append(shapeKey);
+    key.push_back('|');
+    key.append(readConcernLevel.rawData(), readConcernLevel.size());
+    key.push_back('|');
+    key.append(options.objdata(), options.objsize());
+    return key;
+}
+
+unsigned long long QueryResultCache::getVersion() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _version;
+}
+
+QueryResultCache::Result QueryResultCache::get(const std::string& key) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    Entry* entry;
+    if (!_cache.get(key, &entry).isOK()) {
+        return nullptr;
+    }
+    return entry->docs;
+}
+
+bool QueryResultCache::add(const std::string& key,
+                           std::vector<BSONObj> docs,
+                           unsigned long long version) {
+    long long bytes = 0;
+    for (auto&& doc : docs) {
+        bytes += doc.objsize();
+    }
+    if (bytes > internalQueryResultCacheMaxResultBytes.load()) {
+        return false;
+    }
+
+    for (auto&& doc : docs) {
+        doc = doc.getOwned();
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (version != _version) {
+        return false;
+    }
+    _cache.add(key, new Entry{std::make_shared<const std::vector<BSONObj>>(std::move(docs))});
+    return true;
+}
+
+void QueryResultCache::notifyOfWrite() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    ++_version;
+    _cache.clear();
+}
+
+size_t QueryResultCache::size() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _cache.size();
+}
+
+}  // namespace mongo
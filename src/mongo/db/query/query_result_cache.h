@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/query/lru_key_value.h"
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+class QueryRequest;
+
+/**
+ * Caches the complete results of find commands run against a single collection, so that repeating
+ * an identical query while the collection does not change can skip planning and execution. Only
+ * results which fit in the first batch are cached.
+ *
+ * Every committed write to the collection advances its version and discards all entries. A query
+ * reads the version with getVersion() before it opens its storage snapshot, and add() only keeps a
+ * result if the version has not moved since, which guarantees that no entry predates a write.
+ *
+ * This class is thread safe.
+ */
+class QueryResultCache {
+    MONGO_DISALLOW_COPYING(QueryResultCache);
+
+public:
+    using Result = std::shared_ptr<const std::vector<BSONObj>>;
+
+    QueryResultCache();
+
+    /**
+     * Returns the key under which the results of 'qr', whose query shape has the plan cache key
+     * 'shapeKey', are cached for reads at 'readConcernLevel'. Options which cannot change the
+     * results of the query, such as 'comment' and 'maxTimeMS', are not part of the key.
+     */
+    static std::string computeKey(const PlanCacheKey& shapeKey,
+                                  const QueryRequest& qr,
+                                  StringData readConcernLevel);
+
+    /**
+     * Returns the number of writes to the collection committed so far.
+     */
+    unsigned long long getVersion() const;
+
+    /**
+     * Returns the cached results for 'key', or nullptr if there are none.
+     */
+    Result get(const std::string& key) const;
+
+    /**
+     * Caches 'docs' as the results for 'key', unless the version of the collection has changed
+     * since the query which produced them read it as 'version'. Results larger than
+     * internalQueryResultCacheMaxResultBytes are not cached. Returns whether 'docs' were cached.
+     */
+    bool add(const std::string& key, std::vector<BSONObj> docs, unsigned long long version);
+
+    /**
+     * Advances the version of the collection and discards every entry. Must be called after each
+     * write to the collection commits.
+     */
+    void notifyOfWrite();
+
+    /**
+     * Returns the number of cached results.
+     */
+    size_t size() const;
+
+private:
+    struct Entry {
+        Result docs;
+    };
+
+    mutable stdx::mutex _mutex;
+    unsigned long long _version = 0;
+    LRUKeyValue<std::string, Entry> _cache;
+};
+
+}  // namespace mongo
@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for mongo/db/query/query_result_cache.h
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_result_cache.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/query/query_request.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+
+std::unique_ptr<QueryRequest> makeQueryRequest(const char* cmd) {
+    return uassertStatusOK(QueryRequest::makeFromFindCommand(kNss, fromjson(cmd), false));
+}
+
+std::string computeKey(const char* cmd, StringData readConcernLevel = "local") {
+    return QueryResultCache::computeKey("shape", *makeQueryRequest(cmd), readConcernLevel);
+}
+
+TEST(QueryResultCacheTest, ReturnsCachedResults) {
+    QueryResultCache cache;
+    ASSERT_FALSE(cache.get("a"));
+
+    ASSERT_TRUE(cache.add("a", {BSON("_id" << 1), BSON("_id" << 2)}, cache.getVersion()));
+    ASSERT_EQ(cache.size(), 1U);
+
+    auto result = cache.get("a");
+    ASSERT_TRUE(result);
+    ASSERT_EQ(result->size(), 2U);
+    ASSERT_BSONOBJ_EQ(result->at(1), BSON("_id" << 2));
+    ASSERT_FALSE(cache.get("b"));
+}
+
+TEST(QueryResultCacheTest, WritesDiscardEveryResult) {
+    QueryResultCache cache;
+    ASSERT_TRUE(cache.add("a", {BSON("_id" << 1)}, cache.getVersion()));
+    ASSERT_TRUE(cache.add("b", {}, cache.getVersion()));
+
+    cache.notifyOfWrite();
+    ASSERT_EQ(cache.size(), 0U);
+    ASSERT_FALSE(cache.get("a"));
+    ASSERT_FALSE(cache.get("b"));
+}
+
+TEST(QueryResultCacheTest, DoesNotCacheResultsOfQueriesWhichRacedWithAWrite) {
+    QueryResultCache cache;
+    auto version = cache.getVersion();
+    cache.notifyOfWrite();
+
+    ASSERT_FALSE(cache.add("a", {BSON("_id" << 1)}, version));
+    ASSERT_FALSE(cache.get("a"));
+
+    ASSERT_TRUE(cache.add("a", {BSON("_id" << 1)}, cache.getVersion()));
+    ASSERT_TRUE(cache.get("a"));
+}
+
+TEST(QueryResultCacheTest, KeyDependsOnEveryOptionWhichCanChangeTheResults) {
+    const auto key = computeKey("{find: 'coll', filter: {a: 1}}");
+    ASSERT_EQ(key, computeKey("{find: 'coll', filter: {a: 1}}"));
+    ASSERT_NE(key, computeKey("{find: 'coll', filter: {a: 2}}"));
+    ASSERT_NE(key, computeKey("{find: 'coll', filter: {a: 1}, sort: {b: 1}}"));
+    ASSERT_NE(key, computeKey("{find: 'coll', filter: {a: 1}, projection: {b: 1}}"));
+    ASSERT_NE(key, computeKey("{find: 'coll', filter: {a: 1}, skip: 1}"));
+    ASSERT_NE(key, computeKey("{find: 'coll', filter: {a: 1}, limit: 1}"));
+    ASSERT_NE(key, computeKey("{find: 'coll', filter: {a: 1}, collation: {locale: 'fr'}}"));
+    ASSERT_NE(key, computeKey("{find: 'coll', filter: {a: 1}}", "available"));
+}
+
+TEST(QueryResultCacheTest, KeyIgnoresOptionsWhichOnlyAffectHowTheQueryRuns) {
+    const auto key = computeKey("{find: 'coll', filter: {a: 1}}");
+    ASSERT_EQ(key, computeKey("{find: 'coll', filter: {a: 1}, comment: 'dashboard'}"));
+    ASSERT_EQ(key, computeKey("{find: 'coll', filter: {a: 1}, maxTimeMS: 1000}"));
+    ASSERT_EQ(key,
+              computeKey("{find: 'coll', filter: {a: 1}, readConcern: {level: 'local'}}"));
+}
+
+}  // namespace
+}  // namespace mongo
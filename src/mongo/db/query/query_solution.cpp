@@ -202,6 +202,10 @@ void TextNode::appendToString(mongoutils::str::stream* ss, int indent) const {
     *ss << "diacriticSensitive= " << ftsQuery->getDiacriticSensitive() << '\n';
     addIndent(ss, indent + 1);
     *ss << "indexPrefix = " << indexPrefix.toString() << '\n';
+    if (topK) {
+        addIndent(ss, indent + 1);
+        *ss << "topK = " << topK << '\n';
+    }
     if (NULL != filter) {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->toString();
@@ -216,6 +220,7 @@ QuerySolutionNode* TextNode::clone() const {
     copy->_sort = this->_sort;
     copy->ftsQuery = this->ftsQuery->clone();
     copy->indexPrefix = this->indexPrefix;
+    copy->topK = this->topK;
 
     return copy;
 }
@@ -568,10 +573,9 @@ bool IndexScanNode::hasField(const string& field) const {
 
     size_t keyPatternFieldIndex = 0;
     for (auto&& elt : index.keyPattern) {
-        // For $** indexes, the keyPattern is prefixed by a virtual field, '$_path'. We therefore
-        // skip the first keyPattern field when deciding whether we can provide the requested field.
-        if (index.type == IndexType::INDEX_WILDCARD && !keyPatternFieldIndex) {
-            invariant(elt.fieldNameStringData() == "$_path"_sd);
+        // For $** indexes, the query path is preceded by a virtual field, '$_path'. We therefore
+        // skip that keyPattern field when deciding whether we can provide the requested field.
+        if (index.type == IndexType::INDEX_WILDCARD && elt.fieldNameStringData() == "$_path"_sd) {
             ++keyPatternFieldIndex;
             continue;
         }
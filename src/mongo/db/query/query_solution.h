@@ -277,6 +277,10 @@ struct TextNode : public QuerySolutionNode {
     // text node while creating the text leaf node and convert them into a BSONObj index prefix
     // when we finish the text leaf node.
     BSONObj indexPrefix;
+
+    // If non-zero, the text node is directly below a sort on the text score alone which keeps only
+    // this many documents.
+    size_t topK = 0u;
 };
 
 struct CollectionScanNode : public QuerySolutionNode {
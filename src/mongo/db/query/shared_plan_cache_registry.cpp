@@ -0,0 +1,87 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/shared_plan_cache_registry.h"
+
+#include <algorithm>
+
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+
+namespace {
+const auto getSharedPlanCacheRegistry =
+    ServiceContext::declareDecoration<SharedPlanCacheRegistry>();
+
+const size_t kMinPruneThreshold = 64;
+}  // namespace
+
+SharedPlanCacheRegistry& SharedPlanCacheRegistry::get(ServiceContext* serviceContext) {
+    return getSharedPlanCacheRegistry(serviceContext);
+}
+
+std::shared_ptr<PlanCache> SharedPlanCacheRegistry::getPlanCache(
+    const std::string& signature, const std::vector<IndexEntry>& indexEntries) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto& weakCache = _caches[signature];
+    if (auto cache = weakCache.lock()) {
+        return cache;
+    }
+
+    auto cache = std::make_shared<PlanCache>("shared plan cache");
+    cache->notifyOfIndexEntries(indexEntries);
+    weakCache = cache;
+
+    if (_caches.size() >= _pruneThreshold) {
+        _pruneExpired(lk);
+    }
+    return cache;
+}
+
+size_t SharedPlanCacheRegistry::size() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return std::count_if(_caches.begin(), _caches.end(), [](const auto& entry) {
+        return !entry.second.expired();
+    });
+}
+
+void SharedPlanCacheRegistry::_pruneExpired(WithLock) {
+    for (auto it = _caches.begin(); it != _caches.end();) {
+        if (it->second.expired()) {
+            it = _caches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    _pruneThreshold = std::max(kMinPruneThreshold, 2 * _caches.size());
+}
+
+}  // namespace mongo
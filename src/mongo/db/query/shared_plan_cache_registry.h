@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/query/index_entry.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
+
+namespace mongo {
+
+class PlanCache;
+class ServiceContext;
+
+/**
+ * Hands out the plan caches shared by collections with the same index signature, a string
+ * describing every index specification and the default collation of a collection. Collections
+ * holding the same signature can reuse each other's cached plans, since plans are cached in terms
+ * of index names and recomputed against each collection's own index entries when used.
+ *
+ * A shared cache lives as long as some collection holds it. This class is thread safe.
+ */
+class SharedPlanCacheRegistry {
+public:
+    static SharedPlanCacheRegistry& get(ServiceContext* serviceContext);
+
+    /**
+     * Returns the plan cache for 'signature', creating it if no collection currently holds one.
+     * A new cache is notified of 'indexEntries' before any other caller can see it; an existing
+     * cache already describes an identical index set and is returned as is.
+     */
+    std::shared_ptr<PlanCache> getPlanCache(const std::string& signature,
+                                            const std::vector<IndexEntry>& indexEntries);
+
+    /**
+     * Returns the number of shared plan caches currently held by some collection.
+     */
+    size_t size() const;
+
+private:
+    void _pruneExpired(WithLock);
+
+    mutable stdx::mutex _mutex;
+    stdx::unordered_map<std::string, std::weak_ptr<PlanCache>> _caches;
+
+    // Expired entries are pruned whenever the map grows to twice its size after the last prune.
+    size_t _pruneThreshold = 64;
+};
+
+}  // namespace mongo
@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/shared_plan_cache_registry.h"
+
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::vector<IndexEntry> makeIndexEntries() {
+    return {IndexEntry(BSON("a" << 1),
+                       false,                          // multikey
+                       false,                          // sparse
+                       false,                          // unique
+                       IndexEntry::Identifier{"a_1"},  // name
+                       nullptr,                        // filterExpr
+                       BSONObj())};
+}
+
+TEST(SharedPlanCacheRegistryTest, SameSignatureSharesPlanCache) {
+    SharedPlanCacheRegistry registry;
+    auto first = registry.getPlanCache("sig", makeIndexEntries());
+    auto second = registry.getPlanCache("sig", makeIndexEntries());
+    ASSERT_EQ(first.get(), second.get());
+    ASSERT_EQ(registry.size(), 1U);
+}
+
+TEST(SharedPlanCacheRegistryTest, DifferentSignaturesHaveSeparatePlanCaches) {
+    SharedPlanCacheRegistry registry;
+    auto first = registry.getPlanCache("sig1", makeIndexEntries());
+    auto second = registry.getPlanCache("sig2", makeIndexEntries());
+    ASSERT_NE(first.get(), second.get());
+    ASSERT_EQ(registry.size(), 2U);
+}
+
+TEST(SharedPlanCacheRegistryTest, PlanCacheIsReleasedWithLastHolder) {
+    SharedPlanCacheRegistry registry;
+    auto cache = registry.getPlanCache("sig", makeIndexEntries());
+    std::weak_ptr<PlanCache> weakCache = cache;
+    cache.reset();
+    ASSERT_TRUE(weakCache.expired());
+    ASSERT_EQ(registry.size(), 0U);
+
+    // A later request for the signature creates a fresh cache.
+    cache = registry.getPlanCache("sig", makeIndexEntries());
+    ASSERT(cache);
+    ASSERT_EQ(registry.size(), 1U);
+}
+
+TEST(SharedPlanCacheRegistryTest, ExpiredEntriesArePruned) {
+    SharedPlanCacheRegistry registry;
+    for (int i = 0; i < 1000; ++i) {
+        registry.getPlanCache(std::to_string(i), makeIndexEntries());
+    }
+    auto cache = registry.getPlanCache("held", makeIndexEntries());
+    ASSERT_EQ(registry.size(), 1U);
+    ASSERT_EQ(registry.getPlanCache("held", makeIndexEntries()).get(), cache.get());
+}
+
+}  // namespace
+}  // namespace mongo
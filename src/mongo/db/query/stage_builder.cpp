@@ -56,6 +56,7 @@
 #include "mongo/db/exec/text.h"
 #include "mongo/db/index/fts_access_method.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
@@ -81,6 +82,9 @@ PlanStage* buildStages(OperationContext* opCtx,
             params.direction = (csn->direction == 1) ? CollectionScanParams::FORWARD
                                                      : CollectionScanParams::BACKWARD;
             params.shouldWaitForOplogVisibility = csn->shouldWaitForOplogVisibility;
+            params.allowConcurrentFilterEvaluation = csn->filter && !cq.getCollator() &&
+                !QueryPlannerCommon::hasNode(csn->filter.get(), MatchExpression::WHERE) &&
+                !QueryPlannerCommon::hasNode(csn->filter.get(), MatchExpression::EXPRESSION);
             return new CollectionScan(opCtx, params, ws, csn->filter.get());
         }
         case STAGE_IXSCAN: {
@@ -289,6 +293,7 @@ PlanStage* buildStages(OperationContext* opCtx,
             // fail in this case (this improvement is being tracked by SERVER-21510).
             params.query = static_cast<FTSQueryImpl&>(*node->ftsQuery);
             params.wantTextScore = (cq.getProj() && cq.getProj()->wantTextScore());
+            params.topK = node->topK;
             return new TextStage(opCtx, params, ws, node->filter.get());
         }
         case STAGE_SHARDING_FILTER: {
@@ -363,6 +368,7 @@ PlanStage* buildStages(OperationContext* opCtx,
             }
             return new EnsureSortedStage(opCtx, esn->pattern, ws, childStage);
         }
+        case STAGE_BATCHED_IDHACK:
         case STAGE_CACHED_PLAN:
         case STAGE_COUNT:
         case STAGE_DELETE:
@@ -36,6 +36,7 @@ namespace mongo {
 enum StageType {
     STAGE_AND_HASH,
     STAGE_AND_SORTED,
+    STAGE_BATCHED_IDHACK,
     STAGE_CACHED_PLAN,
     STAGE_COLLSCAN,
 
@@ -39,12 +39,15 @@
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/repl/sync_tail.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
 namespace repl {
 
+MONGO_EXPORT_SERVER_PARAMETER(replWriterGroupUpdatesAndDeletes, bool, false);
+
 namespace {
 
 // Must not create too large an object.
@@ -53,6 +56,14 @@ const auto kInsertGroupMaxBatchSize = insertVectorMaxBytes;
 // Limit number of ops in a single group.
 constexpr auto kInsertGroupMaxBatchCount = 64;
 
+// Limits for a group of updates and deletes, which all stay in one storage transaction.
+const auto kWriteGroupMaxBatchSize = insertVectorMaxBytes;
+constexpr auto kWriteGroupMaxBatchCount = 64;
+
+bool isGroupableWrite(const OplogEntry& entry) {
+    return entry.getOpType() == OpTypeEnum::kUpdate || entry.getOpType() == OpTypeEnum::kDelete;
+}
+
 }  // namespace
 
 // static
@@ -215,5 +226,68 @@ StatusWith<InsertGroup::ConstIterator> InsertGroup::groupAndApplyInserts(ConstIt
     MONGO_UNREACHABLE;
 }
 
+using WriteGroup = ApplierHelpers::WriteGroup;
+
+WriteGroup::WriteGroup(ApplierHelpers::OperationPtrs* ops,
+                       OperationContext* opCtx,
+                       WriteGroup::Mode mode)
+    : _doNotGroupBeforePoint(ops->cbegin()), _end(ops->cend()), _opCtx(opCtx), _mode(mode) {}
+
+StatusWith<WriteGroup::ConstIterator> WriteGroup::groupAndApplyWrites(ConstIterator it) {
+    const auto& entry = **it;
+
+    if (!replWriterGroupUpdatesAndDeletes.load()) {
+        return Status(ErrorCodes::IllegalOperation, "Grouping updates and deletes is disabled.");
+    }
+    if (!isGroupableWrite(entry)) {
+        return Status(ErrorCodes::TypeMismatch, "Can only group update and delete operations.");
+    }
+    if (it <= _doNotGroupBeforePoint) {
+        return Status(ErrorCodes::InvalidPath,
+                      "Cannot group a write operation that we previously attempted to group.");
+    }
+
+    auto batchSize = entry.raw.objsize();
+    auto batchCount = OperationPtrs::size_type(1);
+    const auto& batchNamespace = entry.getNss();
+
+    // Find the first op that can't join the group, as in InsertGroup::groupAndApplyInserts().
+    auto endOfGroupableOpsIterator =
+        std::find_if(it + 1, _end, [&](const OplogEntry* nextEntry) -> bool {
+            batchSize += nextEntry->raw.objsize();
+            batchCount += 1;
+            return !isGroupableWrite(*nextEntry) || nextEntry->getNss() != batchNamespace ||
+                batchSize > kWriteGroupMaxBatchSize || batchCount > kWriteGroupMaxBatchCount;
+        });
+
+    if (std::distance(it, endOfGroupableOpsIterator) == 1) {
+        return Status(ErrorCodes::NoSuchKey,
+                      "Not able to create a group with more than a single write operation");
+    }
+
+    std::vector<BSONObj> toApply;
+    for (auto groupingIt = it; groupingIt != endOfGroupableOpsIterator; ++groupingIt) {
+        toApply.push_back((*groupingIt)->raw);
+    }
+
+    try {
+        uassertStatusOK(SyncTail::syncApplyGroupedWrites(_opCtx, toApply, _mode));
+        return endOfGroupableOpsIterator - 1;
+    } catch (...) {
+        // Applying the ops one at a time reports any error properly, or handles it, such as by
+        // fetching a missing document during initial sync.
+        auto status = exceptionToStatus().withContext(
+            str::stream() << "Error applying " << toApply.size()
+                          << " grouped writes. Trying first write as a lone write: "
+                          << redact(entry.raw));
+        LOG(1) << status;
+
+        _doNotGroupBeforePoint = endOfGroupableOpsIterator - 1;
+        return status;
+    }
+
+    MONGO_UNREACHABLE;
+}
+
 }  // namespace repl
 }  // namespace mongo
@@ -33,10 +33,14 @@
 #include "mongo/base/status_with.h"
 #include "mongo/db/repl/multiapplier.h"
 #include "mongo/db/repl/sync_tail.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 namespace repl {
 
+// Applies runs of updates and deletes on a namespace in one WriteUnitOfWork. See WriteGroup.
+extern AtomicBool replWriterGroupUpdatesAndDeletes;
+
 /**
  * Collection of helper functions and classes for oplog application.
  */
@@ -51,6 +55,7 @@ public:
     static void stableSortByNamespace(OperationPtrs* oplogEntryPointers);
 
     class InsertGroup;
+    class WriteGroup;
 };
 
 /**
@@ -88,5 +93,38 @@ private:
     Mode _mode;
 };
 
+/**
+ * Groups consecutive update and delete operations on the same namespace and applies them in a
+ * single WriteUnitOfWork. Only groups when replWriterGroupUpdatesAndDeletes is enabled.
+ * Advances the MultiApplier::OperationPtrs iterator if the group is applied successfully.
+ */
+class ApplierHelpers::WriteGroup {
+    MONGO_DISALLOW_COPYING(WriteGroup);
+
+public:
+    using ConstIterator = OperationPtrs::const_iterator;
+    using Mode = OplogApplication::Mode;
+
+    WriteGroup(OperationPtrs* ops, OperationContext* opCtx, Mode mode);
+
+    /**
+     * Attempts to group update and delete operations starting at 'oplogEntriesIterator'.
+     * If the group is applied successfully, returns the iterator to the last operation included
+     * in the group.
+     */
+    StatusWith<ConstIterator> groupAndApplyWrites(ConstIterator oplogEntriesIterator);
+
+private:
+    // Marks the final op of a failed group, like InsertGroup::_doNotGroupBeforePoint.
+    ConstIterator _doNotGroupBeforePoint;
+
+    // Used for constructing search bounds when grouping writes.
+    ConstIterator _end;
+
+    // Passed to SyncTail::syncApplyGroupedWrites when applying grouped writes.
+    OperationContext* _opCtx;
+    Mode _mode;
+};
+
 }  // namespace repl
 }  // namespace mongo
@@ -50,6 +50,14 @@ public:
      * Throws UserException on error.
      */
     static MultiApplier::Operations extractOperations(const OplogEntry& applyOpsOplogEntry);
+
+    /**
+     * Like above, but the top-level fields of each extracted operation, such as its timestamp,
+     * are taken from 'topLevelOplogEntry'. Used to apply the leading entries of a transaction
+     * that was split across several oplog entries at the opTime of its final entry.
+     */
+    static MultiApplier::Operations extractOperations(const OplogEntry& applyOpsOplogEntry,
+                                                      const OplogEntry& topLevelOplogEntry);
 };
 
 /**
@@ -46,6 +46,7 @@
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/fail_point_service.h"
@@ -73,8 +74,20 @@ MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncListIndexesAttempts, int, 3);
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionFindAttempts, int, 3);
 // Whether to use the "exhaust cursor" feature when retrieving collection data.
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(collectionClonerUsesExhaust, bool, true);
+
+// Collections with fewer documents than this many batches per cursor are cloned over one cursor.
+const int kMinBatchesPerParallelCloneCursor = 4;
 }  // namespace
 
+MONGO_EXPORT_SERVER_PARAMETER(initialSyncCollectionClonerMaxCursors, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 16) {
+            return Status(ErrorCodes::BadValue,
+                          "initialSyncCollectionClonerMaxCursors must be between 1 and 16");
+        }
+        return Status::OK();
+    });
+
 // Failpoint which causes initial sync to hang before establishing its cursor to clone the
 // 'namespace' collection.
 MONGO_FAIL_POINT_DEFINE(initialSyncHangBeforeCollectionClone);
@@ -264,6 +277,11 @@ void CollectionCloner::_cancelRemainingWork_inlock() {
     if (_queryState == QueryState::kRunning) {
         _queryState = QueryState::kCanceling;
         _clientConnection->shutdownAndDisallowReconnect();
+        for (auto&& conn : _rangeConnections) {
+            if (conn) {
+                conn->shutdownAndDisallowReconnect();
+            }
+        }
     } else {
         _queryState = QueryState::kFinished;
     }
@@ -490,6 +508,7 @@ void CollectionCloner::_beginCollectionCallback(const executor::TaskExecutor::Ca
                     stdx::lock_guard<stdx::mutex> lock(_mutex);
                     _queryState = QueryState::kFinished;
                     _clientConnection.reset();
+                    _rangeConnections.clear();
                 }
                 _condition.notify_all();
             });
@@ -550,13 +569,148 @@ void CollectionCloner::_runQuery(const executor::TaskExecutor::CallbackArgs& cal
     auto onCompletionGuard =
         std::make_shared<OnCompletionGuard>(cancelRemainingWorkInLock, finishCallbackFn);
 
+    // Range i covers [splitKeys[i - 1], splitKeys[i]) of the _id index; the first and last ranges
+    // are unbounded below and above, so together they cover every document regardless of type.
+    const auto splitKeys = _getIdRangeSplitKeys();
+    auto makeRangeQuery = [&splitKeys](size_t i) {
+        Query query;
+        if (splitKeys.empty()) {
+            return query;
+        }
+        query.hint(BSON("_id" << 1));
+        if (i > 0) {
+            query.minKey(splitKeys[i - 1]);
+        }
+        if (i < splitKeys.size()) {
+            query.maxKey(splitKeys[i]);
+        }
+        return query;
+    };
+
+    std::vector<stdx::thread> rangeThreads;
+    if (!splitKeys.empty()) {
+        {
+            stdx::lock_guard<stdx::mutex> lock(_mutex);
+            _rangeConnections.resize(splitKeys.size());
+        }
+        log() << "Cloning collection " << _sourceNss.ns() << " over " << splitKeys.size() + 1
+              << " cursors";
+        for (size_t i = 1; i <= splitKeys.size(); ++i) {
+            rangeThreads.emplace_back([this, i, onCompletionGuard, query = makeRangeQuery(i)] {
+                _runRangeQuery(i - 1, query, onCompletionGuard);
+            });
+        }
+    }
+
+    const bool queryOK =
+        _queryCollection(_clientConnection.get(), makeRangeQuery(0), onCompletionGuard);
+    for (auto&& thread : rangeThreads) {
+        thread.join();
+    }
+    if (!queryOK) {
+        return;
+    }
+    waitForDbWorker();
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    // A range query that may have seen the collection dropped leaves the result to the drop check.
+    if (!_verifyCollectionDroppedScheduler) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, Status::OK());
+    }
+}
+
+std::vector<BSONObj> CollectionCloner::_getIdRangeSplitKeys() {
+    const int maxCursors = initialSyncCollectionClonerMaxCursors.load();
+    if (maxCursors <= 1 || _idIndexSpec.isEmpty() || !_options.collation.isEmpty()) {
+        return {};
+    }
+
+    long long documentsToCopy;
+    {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        documentsToCopy = static_cast<long long>(_stats.documentToCopy);
+    }
+    if (documentsToCopy <
+        static_cast<long long>(maxCursors) * _collectionClonerBatchSize *
+            kMinBatchesPerParallelCloneCursor) {
+        return {};
+    }
+
+    // splitVector places a split point every half 'maxChunkSizeBytes', so twice the data size per
+    // cursor yields about one range per cursor.
+    std::vector<BSONObj> splitKeys;
+    try {
+        BSONObj collStats;
+        if (!_clientConnection->runCommand(
+                _sourceNss.db().toString(), BSON("collStats" << _sourceNss.coll()), collStats)) {
+            LOG(1) << "Cloning " << _sourceNss.ns() << " over one cursor; collStats failed: "
+                   << getStatusFromCommandResult(collStats);
+            return {};
+        }
+        const long long dataSize = collStats["size"].safeNumberLong();
+        if (dataSize <= 0) {
+            return {};
+        }
+
+        BSONObj splitResult;
+        if (!_clientConnection->runCommand(_sourceNss.db().toString(),
+                                           BSON("splitVector" << _sourceNss.ns() << "keyPattern"
+                                                              << BSON("_id" << 1)
+                                                              << "maxChunkSizeBytes"
+                                                              << 2 * dataSize / maxCursors
+                                                              << "maxSplitPoints"
+                                                              << maxCursors - 1),
+                                           splitResult)) {
+            LOG(1) << "Cloning " << _sourceNss.ns() << " over one cursor; splitVector failed: "
+                   << getStatusFromCommandResult(splitResult);
+            return {};
+        }
+        for (auto&& key : splitResult["splitKeys"].Array()) {
+            splitKeys.push_back(key.Obj().getOwned());
+        }
+    } catch (const DBException& e) {
+        LOG(1) << "Cloning " << _sourceNss.ns()
+               << " over one cursor; unable to find split points: " << e.toStatus();
+        return {};
+    }
+    return splitKeys;
+}
+
+void CollectionCloner::_runRangeQuery(size_t connectionIndex,
+                                      Query query,
+                                      std::shared_ptr<OnCompletionGuard> onCompletionGuard) {
+    auto conn = _createClientFn();
+    Status status = conn->connect(_source, StringData());
+    if (status.isOK() && !replAuthenticate(conn.get())) {
+        status = {ErrorCodes::AuthenticationFailed,
+                  str::stream() << "Failed to authenticate to " << _source};
+    }
+
+    DBClientConnection* rangeConnection = conn.get();
+    {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        if (!status.isOK()) {
+            onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, status);
+            return;
+        }
+        if (_queryState == QueryState::kCanceling) {
+            return;
+        }
+        // Once registered, _cancelRemainingWork_inlock() shuts this connection down.
+        _rangeConnections[connectionIndex] = std::move(conn);
+    }
+    _queryCollection(rangeConnection, query, onCompletionGuard);
+}
+
+bool CollectionCloner::_queryCollection(DBClientConnection* conn,
+                                        const Query& query,
+                                        std::shared_ptr<OnCompletionGuard> onCompletionGuard) {
     try {
-        _clientConnection->query(
+        conn->query(
             [this, onCompletionGuard](DBClientCursorBatchIterator& iter) {
                 _handleNextBatch(onCompletionGuard, iter);
             },
             NamespaceStringOrUUID(_sourceNss.db().toString(), *_options.uuid),
-            Query(),
+            query,
             nullptr /* fieldsToReturn */,
             QueryOption_NoCursorTimeout | QueryOption_SlaveOk |
                 (collectionClonerUsesExhaust ? QueryOption_Exhaust : 0),
@@ -571,24 +725,22 @@ void CollectionCloner::_runQuery(const executor::TaskExecutor::CallbackArgs& cal
             // cloning.  If so, we'll execute the drop during oplog application, so it's OK to
             // just stop cloning.
             _verifyCollectionWasDropped(lock, queryStatus, onCompletionGuard);
-            return;
+            return false;
         } else if (queryStatus.code() != ErrorCodes::NamespaceNotFound) {
             // NamespaceNotFound means the collection was dropped before we started cloning, so
             // we're OK to ignore the error.  Any other error we must report.
             onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, queryStatus);
-            return;
+            return false;
         }
     }
-    waitForDbWorker();
-    stdx::lock_guard<stdx::mutex> lock(_mutex);
-    onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, Status::OK());
+    return true;
 }
 
 void CollectionCloner::_handleNextBatch(std::shared_ptr<OnCompletionGuard> onCompletionGuard,
                                         DBClientCursorBatchIterator& iter) {
-    _stats.receivedBatches++;
     {
         stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _stats.receivedBatches++;
         uassert(ErrorCodes::CallbackCanceled,
                 "Collection cloning cancelled.",
                 _queryState != QueryState::kCanceling);
@@ -47,6 +47,7 @@
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/task_runner.h"
 #include "mongo/executor/task_executor.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/functional.h"
 #include "mongo/stdx/mutex.h"
@@ -59,6 +60,11 @@ namespace repl {
 
 class StorageInterface;
 
+// Maximum number of cursors used to clone one collection. When greater than one, the _id range of
+// a large collection is split with splitVector on the sync source and each range is queried over
+// its own connection. One clones every collection over a single cursor.
+extern AtomicInt32 initialSyncCollectionClonerMaxCursors;
+
 class CollectionCloner : public BaseCloner {
     MONGO_DISALLOW_COPYING(CollectionCloner);
 
@@ -217,6 +223,29 @@ private:
      */
     void _runQuery(const executor::TaskExecutor::CallbackArgs& callbackData);
 
+    /**
+     * Returns the _id values at which to split the collection into ranges that are each queried
+     * over their own cursor. Returns an empty vector, meaning the whole collection is queried
+     * over '_clientConnection', when parallel cloning is disabled or does not apply.
+     */
+    std::vector<BSONObj> _getIdRangeSplitKeys();
+
+    /**
+     * Runs on a thread started by _runQuery to query one _id range over a separate connection.
+     */
+    void _runRangeQuery(size_t connectionIndex,
+                        Query query,
+                        std::shared_ptr<OnCompletionGuard> onCompletionGuard);
+
+    /**
+     * Queries the collection over 'conn', passing each batch to _handleNextBatch. Returns false
+     * if the query failed, in which case the result has already been set on
+     * 'onCompletionGuard'.
+     */
+    bool _queryCollection(DBClientConnection* conn,
+                          const Query& query,
+                          std::shared_ptr<OnCompletionGuard> onCompletionGuard);
+
     /**
      * Put all results from a query batch into a buffer to be inserted, and schedule
      * it to be inserted.
@@ -297,6 +326,10 @@ private:
     // (M) Client connection used for query.
     std::unique_ptr<DBClientConnection> _clientConnection;
 
+    // (M) Client connections used by the additional range queries of a parallel clone. An entry
+    // is null until its thread has connected and authenticated.
+    std::vector<std::unique_ptr<DBClientConnection>> _rangeConnections;
+
     // State transitions:
     // PreStart --> Running --> ShuttingDown --> Complete
     // It is possible to skip intermediate states. For example,
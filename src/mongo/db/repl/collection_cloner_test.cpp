@@ -42,6 +42,7 @@
 #include "mongo/unittest/task_executor_proxy.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 
 namespace {
 
@@ -1055,6 +1056,35 @@ TEST_F(CollectionClonerTest, InsertDocumentsMultipleBatches) {
     ASSERT_FALSE(collectionCloner->isActive());
 }
 
+TEST_F(CollectionClonerTest, ParallelCloneFallsBackToOneCursorWhenSplitPointsAreUnavailable) {
+    // The mock sync source has no collStats or splitVector reply, so no split points are found.
+    const int oldMaxCursors = initialSyncCollectionClonerMaxCursors.load();
+    initialSyncCollectionClonerMaxCursors.store(2);
+    ON_BLOCK_EXIT([oldMaxCursors] { initialSyncCollectionClonerMaxCursors.store(oldMaxCursors); });
+
+    const int numDocs = 8;
+    for (int i = 0; i < numDocs; ++i) {
+        _server->insert(nss.ns(), BSON("_id" << i));
+    }
+
+    collectionCloner->setBatchSize_forTest(1);
+    ASSERT_OK(collectionCloner->startup());
+    ASSERT_TRUE(collectionCloner->isActive());
+
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(getNet());
+        processNetworkResponse(createCountResponse(numDocs));
+        processNetworkResponse(createListIndexesResponse(0, BSON_ARRAY(idIndexSpec)));
+    }
+    collectionCloner->join();
+    ASSERT_EQUALS(numDocs, collectionStats.insertCount);
+    ASSERT_TRUE(collectionStats.commitCalled);
+    ASSERT_EQUALS(static_cast<size_t>(numDocs), collectionCloner->getStats().documentsCopied);
+
+    ASSERT_OK(getStatus());
+    ASSERT_FALSE(collectionCloner->isActive());
+}
+
 TEST_F(CollectionClonerTest, CollectionClonerTransitionsToCompleteIfShutdownBeforeStartup) {
     collectionCloner->shutdown();
     ASSERT_EQUALS(ErrorCodes::ShutdownInProgress, collectionCloner->startup());
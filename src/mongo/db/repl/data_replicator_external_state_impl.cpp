@@ -37,6 +37,7 @@
 #include "mongo/db/repl/oplog_buffer_blocking_queue.h"
 #include "mongo/db/repl/oplog_buffer_collection.h"
 #include "mongo/db/repl/oplog_buffer_proxy.h"
+#include "mongo/db/repl/oplog_buffer_spilling.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_coordinator_external_state.h"
 #include "mongo/db/repl/replication_process.h"
@@ -50,19 +51,33 @@ namespace {
 
 const char kCollectionOplogBufferName[] = "collection";
 const char kBlockingQueueOplogBufferName[] = "inMemoryBlockingQueue";
+const char kSpillingOplogBufferName[] = "inMemoryWithCollectionSpill";
 
 // Set this to specify whether to use a collection to buffer the oplog on the destination server
-// during initial sync to prevent rolling over the oplog.
+// during initial sync to prevent rolling over the oplog. The default keeps operations in memory
+// and only writes them to the collection once the memory limit below is reached.
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(initialSyncOplogBuffer,
                                       std::string,
-                                      kCollectionOplogBufferName);
+                                      kSpillingOplogBufferName);
 
 // Set this to specify size of read ahead buffer in the OplogBufferCollection.
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(initialSyncOplogBufferPeekCacheSize, int, 10000);
 
+// Set this to specify how many megabytes of operations the inMemoryWithCollectionSpill oplog
+// buffer holds in memory before spilling to the collection.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(initialSyncOplogBufferMaxMemoryMB, int, 256)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "initialSyncOplogBufferMaxMemoryMB must be greater than or equal to 0");
+        }
+        return Status::OK();
+    });
+
 MONGO_INITIALIZER(initialSyncOplogBuffer)(InitializerContext*) {
     if ((initialSyncOplogBuffer != kCollectionOplogBufferName) &&
-        (initialSyncOplogBuffer != kBlockingQueueOplogBufferName)) {
+        (initialSyncOplogBuffer != kBlockingQueueOplogBufferName) &&
+        (initialSyncOplogBuffer != kSpillingOplogBufferName)) {
         return Status(ErrorCodes::BadValue,
                       "unsupported initial sync oplog buffer option: " + initialSyncOplogBuffer);
     }
@@ -132,15 +147,20 @@ bool DataReplicatorExternalStateImpl::shouldStopFetching(
 
 std::unique_ptr<OplogBuffer> DataReplicatorExternalStateImpl::makeInitialSyncOplogBuffer(
     OperationContext* opCtx) const {
-    if (initialSyncOplogBuffer == kCollectionOplogBufferName) {
-        invariant(initialSyncOplogBufferPeekCacheSize >= 0);
-        OplogBufferCollection::Options options;
-        options.peekCacheSize = std::size_t(initialSyncOplogBufferPeekCacheSize);
-        return stdx::make_unique<OplogBufferProxy>(
-            stdx::make_unique<OplogBufferCollection>(StorageInterface::get(opCtx), options));
-    } else {
+    if (initialSyncOplogBuffer == kBlockingQueueOplogBufferName) {
         return stdx::make_unique<OplogBufferBlockingQueue>();
     }
+
+    invariant(initialSyncOplogBufferPeekCacheSize >= 0);
+    OplogBufferCollection::Options options;
+    options.peekCacheSize = std::size_t(initialSyncOplogBufferPeekCacheSize);
+    auto collectionBuffer = stdx::make_unique<OplogBufferProxy>(
+        stdx::make_unique<OplogBufferCollection>(StorageInterface::get(opCtx), options));
+    if (initialSyncOplogBuffer == kCollectionOplogBufferName) {
+        return std::move(collectionBuffer);
+    }
+    return stdx::make_unique<OplogBufferSpilling>(
+        std::size_t(initialSyncOplogBufferMaxMemoryMB) * 1024 * 1024, std::move(collectionBuffer));
 }
 
 std::unique_ptr<OplogApplier> DataReplicatorExternalStateImpl::makeOplogApplier(
@@ -111,6 +111,10 @@ namespace {
 
 MONGO_FAIL_POINT_DEFINE(sleepBetweenInsertOpTimeGenerationAndLogOp);
 
+// When true, a primary whose oplog is idle lets tailing oplog scans, such as those of change
+// streams, report the current cluster time as their progress instead of the last entry they read.
+MONGO_EXPORT_SERVER_PARAMETER(reportIdleOplogClusterTime, bool, true);
+
 /**
  * This structure contains per-service-context state related to the oplog.
  */
@@ -132,6 +136,9 @@ struct LocalOplogInfo {
 
     // Used to generate "h" fields in pv0. Synchronized by newOpMutex.
     PseudoRandom hashGenerator{std::unique_ptr<SecureRandom>(SecureRandom::create())->nextInt64()};
+
+    // The last optime timestamp handed out for a new oplog entry. Synchronized by newOpMutex.
+    Timestamp lastReservedTimestamp;
 };
 
 const auto localOplogInfo = ServiceContext::declareDecoration<LocalOplogInfo>();
@@ -161,6 +168,7 @@ void _getNextOpTimes(OperationContext* opCtx,
     stdx::lock_guard<stdx::mutex> lk(oplogInfo.newOpMutex);
 
     auto ts = LogicalClock::get(opCtx)->reserveTicks(count).asTimestamp();
+    oplogInfo.lastReservedTimestamp = Timestamp(ts.asULL() + count - 1);
     const bool orderedCommit = false;
 
     if (persist) {
@@ -714,6 +722,32 @@ MONGO_REGISTER_SHIM(GetNextOpTimeClass::getNextOpTime)(OperationContext* opCtx)-
     return os;
 }
 
+MONGO_REGISTER_SHIM(GetIdleOplogTimestampClass::getIdleOplogTimestamp)
+(OperationContext* opCtx, Timestamp visibleThrough)->boost::optional<Timestamp> {
+    if (!reportIdleOplogClusterTime.load()) {
+        return boost::none;
+    }
+
+    // Only a primary chooses the timestamps of its future oplog entries. Entries it applied while
+    // it was a secondary must be visible too.
+    auto replCoord = ReplicationCoordinator::get(opCtx);
+    if (replCoord->getReplicationMode() != ReplicationCoordinator::modeReplSet ||
+        !replCoord->getMemberState().primary() ||
+        replCoord->getMyLastAppliedOpTime().getTimestamp() > visibleThrough) {
+        return boost::none;
+    }
+
+    // Optimes are reserved and registered with the storage engine under newOpMutex, and every
+    // optime reserved after it is released is later than the current cluster time. So once every
+    // optime reserved so far is visible, no future entry can be at or before the cluster time.
+    auto& oplogInfo = localOplogInfo(opCtx->getServiceContext());
+    stdx::lock_guard<stdx::mutex> lk(oplogInfo.newOpMutex);
+    if (oplogInfo.lastReservedTimestamp > visibleThrough) {
+        return boost::none;
+    }
+    return LogicalClock::get(opCtx)->getClusterTime().asTimestamp();
+}
+
 OplogSlot getNextOpTimeNoPersistForTesting(OperationContext* opCtx) {
     auto oplog = localOplogInfo(opCtx->getServiceContext()).oplog;
     invariant(oplog);
@@ -1076,7 +1110,8 @@ Status applyOperation_inlock(OperationContext* opCtx,
                              const BSONObj& op,
                              bool alwaysUpsert,
                              OplogApplication::Mode mode,
-                             IncrementOpsAppliedStatsFn incrementOpsAppliedStats) {
+                             IncrementOpsAppliedStatsFn incrementOpsAppliedStats,
+                             bool isGroupedWrite) {
     LOG(3) << "applying op: " << redact(op)
            << ", oplog application mode: " << OplogApplication::modeToString(mode);
 
@@ -1196,7 +1231,11 @@ Status applyOperation_inlock(OperationContext* opCtx,
     //    the individual operations will not contain a `ts` field. The caller is responsible for
     //    setting the timestamp before committing. Assigning a competing timestamp in this
     //    codepath would break that atomicity. Sharding is a consumer of this use-case.
-    const bool assignOperationTimestamp = [opCtx, haveWrappingWriteUnitOfWork, mode] {
+    //
+    //   Grouped secondary writes: Consecutive updates and deletes are applied under one parent
+    //     `WriteUnitOfWork` to save transaction overhead, but each keeps the timestamp in its own
+    //     operation document, as if applied alone.
+    const bool assignOperationTimestamp = [&] {
         const auto replMode = ReplicationCoordinator::get(opCtx)->getReplicationMode();
         if (opCtx->writesAreReplicated()) {
             // We do not assign timestamps on replicated writes since they will get their oplog
@@ -1205,7 +1244,7 @@ Status applyOperation_inlock(OperationContext* opCtx,
         } else {
             switch (replMode) {
                 case ReplicationCoordinator::modeReplSet: {
-                    if (haveWrappingWriteUnitOfWork) {
+                    if (haveWrappingWriteUnitOfWork && !isGroupedWrite) {
                         // We do not assign timestamps to non-replicated writes that have a wrapping
                         // WUOW. These must be operations inside of atomic 'applyOps' commands being
                         // applied on a secondary. They will get the timestamp of the outer
@@ -60,13 +60,14 @@ struct OplogSlot {
 struct InsertStatement {
 public:
     InsertStatement() = default;
-    explicit InsertStatement(BSONObj toInsert) : doc(toInsert) {}
+    explicit InsertStatement(BSONObj toInsert) : doc(std::move(toInsert)) {}
 
-    InsertStatement(StmtId statementId, BSONObj toInsert) : stmtId(statementId), doc(toInsert) {}
+    InsertStatement(StmtId statementId, BSONObj toInsert)
+        : stmtId(statementId), doc(std::move(toInsert)) {}
     InsertStatement(StmtId statementId, BSONObj toInsert, OplogSlot os)
-        : stmtId(statementId), oplogSlot(os), doc(toInsert) {}
+        : stmtId(statementId), oplogSlot(os), doc(std::move(toInsert)) {}
     InsertStatement(BSONObj toInsert, Timestamp ts, long long term)
-        : oplogSlot(repl::OpTime(ts, term), 0), doc(toInsert) {}
+        : oplogSlot(repl::OpTime(ts, term), 0), doc(std::move(toInsert)) {}
 
     StmtId stmtId = kUninitializedStmtId;
     OplogSlot oplogSlot;
@@ -212,6 +213,8 @@ inline std::ostream& operator<<(std::ostream& s, OplogApplication::Mode mode) {
  * @param alwaysUpsert convert some updates to upserts for idempotency reasons
  * @param mode specifies what oplog application mode we are in
  * @param incrementOpsAppliedStats is called whenever an op is applied.
+ * @param isGroupedWrite the caller applies this op along with others in one WriteUnitOfWork,
+ *     but each op is still timestamped with its own 'ts', unlike ops in an atomic applyOps.
  * Returns failure status if the op was an update that could not be applied.
  */
 Status applyOperation_inlock(OperationContext* opCtx,
@@ -219,7 +222,8 @@ Status applyOperation_inlock(OperationContext* opCtx,
                              const BSONObj& op,
                              bool alwaysUpsert,
                              OplogApplication::Mode mode,
-                             IncrementOpsAppliedStatsFn incrementOpsAppliedStats = {});
+                             IncrementOpsAppliedStatsFn incrementOpsAppliedStats = {},
+                             bool isGroupedWrite = false);
 
 /**
  * Take a command op and apply it locally
@@ -275,6 +279,27 @@ inline OplogSlot getNextOpTime(OperationContext* opCtx) {
     return GetNextOpTimeClass::getNextOpTime(opCtx);
 }
 
+// Shims currently do not support free functions so we wrap getIdleOplogTimestamp in a class as a
+// workaround.
+struct GetIdleOplogTimestampClass {
+    /**
+     * Returns a cluster time such that no oplog entry this node writes from now on can be at or
+     * before it, if every oplog entry this node has reserved an optime for is at or before
+     * 'visibleThrough'. Returns boost::none if this node is not a primary or a write it has
+     * started is not yet visible at 'visibleThrough'.
+     *
+     * Oplog scans that have read everything up to 'visibleThrough' use this to report progress
+     * past an idle oplog without waiting for a periodic no-op write.
+     */
+    static MONGO_DECLARE_SHIM((OperationContext * opCtx, Timestamp visibleThrough)
+                                  ->boost::optional<Timestamp>) getIdleOplogTimestamp;
+};
+
+inline boost::optional<Timestamp> getIdleOplogTimestamp(OperationContext* opCtx,
+                                                        Timestamp visibleThrough) {
+    return GetIdleOplogTimestampClass::getIdleOplogTimestamp(opCtx, visibleThrough);
+}
+
 /**
  * Allocates an OpTime, but does not update the storage engine with the timestamp. This is used to
  * test prepare support for transactions. It is necessary to do this because a transaction in
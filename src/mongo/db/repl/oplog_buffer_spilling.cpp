@@ -0,0 +1,230 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kReplication
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_buffer_spilling.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+#include "mongo/util/assert_util.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+namespace repl {
+
+namespace {
+
+std::size_t getDocumentSize(const BSONObj& o) {
+    return static_cast<std::size_t>(o.objsize());
+}
+
+}  // namespace
+
+OplogBufferSpilling::OplogBufferSpilling(std::size_t maxMemorySize,
+                                         std::unique_ptr<OplogBuffer> spillBuffer)
+    : _maxMemorySize(maxMemorySize), _spillBuffer(std::move(spillBuffer)) {
+    invariant(_spillBuffer);
+}
+
+void OplogBufferSpilling::startup(OperationContext* opCtx) {
+    _spillBuffer->startup(opCtx);
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _spilledCount = _spillBuffer->getCount();
+    _spilledSize = _spillBuffer->getSize();
+    _lastPushed = _spillBuffer->lastObjectPushed(opCtx);
+}
+
+void OplogBufferSpilling::shutdown(OperationContext* opCtx) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _spillBuffer->shutdown(opCtx);
+    _memory.clear();
+    _memorySize = 0;
+    _spilledCount = 0;
+    _spilledSize = 0;
+    _lastPushed = boost::none;
+}
+
+void OplogBufferSpilling::pushEvenIfFull(OperationContext* opCtx, const Value& value) {
+    Batch valueBatch = {value};
+    pushAllNonBlocking(opCtx, valueBatch.begin(), valueBatch.end());
+}
+
+void OplogBufferSpilling::push(OperationContext* opCtx, const Value& value) {
+    pushEvenIfFull(opCtx, value);
+}
+
+void OplogBufferSpilling::pushAllNonBlocking(OperationContext* opCtx,
+                                             Batch::const_iterator begin,
+                                             Batch::const_iterator end) {
+    if (begin == end) {
+        return;
+    }
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    // Operations stay in memory until one does not fit. That one and everything after it, until
+    // the spilled operations drain, goes to the spill buffer so that pops stay in push order.
+    auto toSpill = begin;
+    for (; toSpill != end && _spilledCount == 0; ++toSpill) {
+        const auto size = getDocumentSize(*toSpill);
+        if (_memorySize + size > _maxMemorySize) {
+            break;
+        }
+        _memory.push_back(*toSpill);
+        _memorySize += size;
+    }
+
+    if (toSpill != end) {
+        if (_spilledCount == 0) {
+            ++_timesSpilled;
+            LOG(1) << "Oplog buffer holds " << _memorySize << " bytes in memory; spilling "
+                   << "further operations until they have been applied";
+        }
+
+        // A collection backed spill buffer only positions sentinels correctly when they are
+        // pushed one at a time.
+        if (std::any_of(toSpill, end, [](const Value& value) { return value.isEmpty(); })) {
+            for (auto i = toSpill; i != end; ++i) {
+                _spillBuffer->pushEvenIfFull(opCtx, *i);
+            }
+        } else {
+            _spillBuffer->pushAllNonBlocking(opCtx, toSpill, end);
+        }
+        _spilledCount += std::distance(toSpill, end);
+        _spilledSize += std::accumulate(
+            toSpill, end, std::size_t(0), [](std::size_t total, const Value& value) {
+                return total + getDocumentSize(value);
+            });
+    }
+
+    _lastPushed = *std::prev(end);
+    _cvNoLongerEmpty.notify_all();
+}
+
+void OplogBufferSpilling::waitForSpace(OperationContext* opCtx, std::size_t size) {}
+
+bool OplogBufferSpilling::isEmpty() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _memory.empty() && _spilledCount == 0;
+}
+
+std::size_t OplogBufferSpilling::getMaxSize() const {
+    return 0;
+}
+
+std::size_t OplogBufferSpilling::getSize() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _memorySize + _spilledSize;
+}
+
+std::size_t OplogBufferSpilling::getCount() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _memory.size() + _spilledCount;
+}
+
+void OplogBufferSpilling::clear(OperationContext* opCtx) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _spillBuffer->clear(opCtx);
+    _memory.clear();
+    _memorySize = 0;
+    _spilledCount = 0;
+    _spilledSize = 0;
+    _lastPushed = boost::none;
+}
+
+bool OplogBufferSpilling::tryPop(OperationContext* opCtx, Value* value) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (!_memory.empty()) {
+        *value = std::move(_memory.front());
+        _memory.pop_front();
+        _memorySize -= getDocumentSize(*value);
+        return true;
+    }
+    if (_spilledCount == 0) {
+        return false;
+    }
+
+    const bool popped = _spillBuffer->tryPop(opCtx, value);
+    invariant(popped);
+    --_spilledCount;
+    _spilledSize -= getDocumentSize(*value);
+    if (_spilledCount == 0) {
+        LOG(1) << "Oplog buffer applied all spilled operations; buffering in memory again";
+    }
+    return true;
+}
+
+bool OplogBufferSpilling::waitForData(Seconds waitDuration) {
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    return _cvNoLongerEmpty.wait_for(lk, waitDuration.toSystemDuration(), [&] {
+        return !_memory.empty() || _spilledCount != 0;
+    });
+}
+
+bool OplogBufferSpilling::peek(OperationContext* opCtx, Value* value) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (!_memory.empty()) {
+        *value = _memory.front();
+        return true;
+    }
+    if (_spilledCount == 0) {
+        return false;
+    }
+    return _spillBuffer->peek(opCtx, value);
+}
+
+boost::optional<OplogBuffer::Value> OplogBufferSpilling::lastObjectPushed(
+    OperationContext* opCtx) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_memory.empty() && _spilledCount == 0) {
+        return boost::none;
+    }
+    return _lastPushed;
+}
+
+std::size_t OplogBufferSpilling::getMemoryCount_forTest() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _memory.size();
+}
+
+std::size_t OplogBufferSpilling::getSpilledCount_forTest() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _spilledCount;
+}
+
+std::size_t OplogBufferSpilling::getTimesSpilled_forTest() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _timesSpilled;
+}
+
+}  // namespace repl
+}  // namespace mongo
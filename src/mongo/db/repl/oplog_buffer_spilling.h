@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <deque>
+#include <memory>
+
+#include "mongo/db/repl/oplog_buffer.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * Oplog buffer that keeps operations in memory up to a size limit and only spills the operations
+ * that do not fit into another (typically collection backed) oplog buffer.
+ *
+ * Operations are popped in the order they were pushed. Once an operation has been spilled, all
+ * operations pushed after it are spilled too, until the spilled operations have been popped and
+ * the buffer goes back to holding new operations in memory.
+ */
+class OplogBufferSpilling final : public OplogBuffer {
+public:
+    OplogBufferSpilling(std::size_t maxMemorySize, std::unique_ptr<OplogBuffer> spillBuffer);
+
+    void startup(OperationContext* opCtx) override;
+    void shutdown(OperationContext* opCtx) override;
+    void pushEvenIfFull(OperationContext* opCtx, const Value& value) override;
+    void push(OperationContext* opCtx, const Value& value) override;
+    void pushAllNonBlocking(OperationContext* opCtx,
+                            Batch::const_iterator begin,
+                            Batch::const_iterator end) override;
+    void waitForSpace(OperationContext* opCtx, std::size_t size) override;
+    bool isEmpty() const override;
+    std::size_t getMaxSize() const override;
+    std::size_t getSize() const override;
+    std::size_t getCount() const override;
+    void clear(OperationContext* opCtx) override;
+    bool tryPop(OperationContext* opCtx, Value* value) override;
+    bool waitForData(Seconds waitDuration) override;
+    bool peek(OperationContext* opCtx, Value* value) override;
+    boost::optional<Value> lastObjectPushed(OperationContext* opCtx) const override;
+
+    // ---- Testing API ----
+    std::size_t getMemoryCount_forTest() const;
+    std::size_t getSpilledCount_forTest() const;
+    std::size_t getTimesSpilled_forTest() const;
+
+private:
+    // Maximum total size of the operations held in memory.
+    const std::size_t _maxMemorySize;
+
+    // Holds the operations that did not fit in memory, and every operation pushed after them
+    // until they have all been popped.
+    const std::unique_ptr<OplogBuffer> _spillBuffer;
+
+    // Allows functions to wait until the buffer has data. Used with _mutex below.
+    stdx::condition_variable _cvNoLongerEmpty;
+
+    // Protects member data below and synchronizes it with '_spillBuffer'.
+    mutable stdx::mutex _mutex;
+
+    // Operations held in memory. These are always older than the spilled operations.
+    std::deque<Value> _memory;
+    std::size_t _memorySize = 0;
+
+    // Number and size of the operations in '_spillBuffer'.
+    std::size_t _spilledCount = 0;
+    std::size_t _spilledSize = 0;
+
+    // Number of times the buffer started spilling.
+    std::size_t _timesSpilled = 0;
+
+    boost::optional<Value> _lastPushed;
+};
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,183 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/oplog_buffer_spilling.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+using namespace mongo::repl;
+
+BSONObj makeOplogEntry(int t) {
+    return BSON("ts" << Timestamp(t, t) << "h" << t << "ns"
+                     << "a.a"
+                     << "v"
+                     << 2
+                     << "op"
+                     << "i"
+                     << "o"
+                     << BSON("_id" << t << "a" << t));
+}
+
+// Room for 'n' entries from makeOplogEntry() in memory.
+std::size_t memoryFor(std::size_t n) {
+    return n * makeOplogEntry(1).objsize();
+}
+
+class OplogBufferSpillingTest : public unittest::Test {
+protected:
+    void setUpBuffer(std::size_t maxMemorySize) {
+        auto spillBuffer = stdx::make_unique<OplogBufferBlockingQueue>();
+        spillBufferPtr = spillBuffer.get();
+        buffer = stdx::make_unique<OplogBufferSpilling>(maxMemorySize, std::move(spillBuffer));
+        buffer->startup(nullptr);
+    }
+
+    void assertPops(int first, int last) {
+        for (int t = first; t <= last; ++t) {
+            BSONObj value;
+            ASSERT_TRUE(buffer->tryPop(nullptr, &value));
+            ASSERT_BSONOBJ_EQ(makeOplogEntry(t), value);
+        }
+    }
+
+    OplogBufferBlockingQueue* spillBufferPtr = nullptr;
+    std::unique_ptr<OplogBufferSpilling> buffer;
+};
+
+TEST_F(OplogBufferSpillingTest, KeepsOperationsInMemoryWithinLimit) {
+    setUpBuffer(memoryFor(3));
+    OplogBuffer::Batch batch = {makeOplogEntry(1), makeOplogEntry(2), makeOplogEntry(3)};
+    buffer->pushAllNonBlocking(nullptr, batch.begin(), batch.end());
+
+    ASSERT_EQUALS(3U, buffer->getCount());
+    ASSERT_EQUALS(memoryFor(3), buffer->getSize());
+    ASSERT_EQUALS(3U, buffer->getMemoryCount_forTest());
+    ASSERT_EQUALS(0U, buffer->getTimesSpilled_forTest());
+    ASSERT_TRUE(spillBufferPtr->isEmpty());
+    ASSERT_BSONOBJ_EQ(makeOplogEntry(3), *buffer->lastObjectPushed(nullptr));
+
+    BSONObj value;
+    ASSERT_TRUE(buffer->peek(nullptr, &value));
+    ASSERT_BSONOBJ_EQ(makeOplogEntry(1), value);
+    assertPops(1, 3);
+    ASSERT_TRUE(buffer->isEmpty());
+    ASSERT_FALSE(buffer->tryPop(nullptr, &value));
+    ASSERT_FALSE(buffer->lastObjectPushed(nullptr));
+}
+
+TEST_F(OplogBufferSpillingTest, SpillsOverflowAndPopsInPushOrder) {
+    setUpBuffer(memoryFor(2));
+    for (int t = 1; t <= 5; ++t) {
+        buffer->push(nullptr, makeOplogEntry(t));
+    }
+    ASSERT_EQUALS(5U, buffer->getCount());
+    ASSERT_EQUALS(memoryFor(5), buffer->getSize());
+    ASSERT_EQUALS(2U, buffer->getMemoryCount_forTest());
+    ASSERT_EQUALS(3U, buffer->getSpilledCount_forTest());
+    ASSERT_EQUALS(3U, spillBufferPtr->getCount());
+    ASSERT_EQUALS(1U, buffer->getTimesSpilled_forTest());
+
+    // Popping the in-memory operations frees space, but new operations follow the spilled ones.
+    assertPops(1, 2);
+    buffer->push(nullptr, makeOplogEntry(6));
+    ASSERT_EQUALS(0U, buffer->getMemoryCount_forTest());
+    ASSERT_EQUALS(4U, buffer->getSpilledCount_forTest());
+
+    BSONObj value;
+    ASSERT_TRUE(buffer->peek(nullptr, &value));
+    ASSERT_BSONOBJ_EQ(makeOplogEntry(3), value);
+    assertPops(3, 6);
+    ASSERT_TRUE(buffer->isEmpty());
+    ASSERT_EQUALS(0U, buffer->getSize());
+}
+
+TEST_F(OplogBufferSpillingTest, ReturnsToMemoryOnceSpilledOperationsDrain) {
+    setUpBuffer(memoryFor(1));
+    OplogBuffer::Batch batch = {makeOplogEntry(1), makeOplogEntry(2), makeOplogEntry(3)};
+    buffer->pushAllNonBlocking(nullptr, batch.begin(), batch.end());
+    ASSERT_EQUALS(2U, buffer->getSpilledCount_forTest());
+    assertPops(1, 3);
+
+    buffer->push(nullptr, makeOplogEntry(4));
+    ASSERT_EQUALS(1U, buffer->getMemoryCount_forTest());
+    ASSERT_EQUALS(0U, buffer->getSpilledCount_forTest());
+    buffer->push(nullptr, makeOplogEntry(5));
+    ASSERT_EQUALS(1U, buffer->getSpilledCount_forTest());
+    ASSERT_EQUALS(2U, buffer->getTimesSpilled_forTest());
+    assertPops(4, 5);
+}
+
+TEST_F(OplogBufferSpillingTest, SpillsSentinelsInOrder) {
+    setUpBuffer(memoryFor(1));
+    buffer->push(nullptr, makeOplogEntry(1));
+    buffer->push(nullptr, BSONObj());
+    buffer->push(nullptr, makeOplogEntry(2));
+    ASSERT_EQUALS(2U, buffer->getSpilledCount_forTest());
+
+    BSONObj value;
+    assertPops(1, 1);
+    ASSERT_TRUE(buffer->tryPop(nullptr, &value));
+    ASSERT_TRUE(value.isEmpty());
+    assertPops(2, 2);
+}
+
+TEST_F(OplogBufferSpillingTest, ClearEmptiesMemoryAndSpillBuffer) {
+    setUpBuffer(memoryFor(1));
+    buffer->push(nullptr, makeOplogEntry(1));
+    buffer->push(nullptr, makeOplogEntry(2));
+    buffer->clear(nullptr);
+
+    ASSERT_TRUE(buffer->isEmpty());
+    ASSERT_EQUALS(0U, buffer->getSize());
+    ASSERT_TRUE(spillBufferPtr->isEmpty());
+    ASSERT_FALSE(buffer->lastObjectPushed(nullptr));
+
+    // After clearing, the buffer starts over in memory.
+    buffer->push(nullptr, makeOplogEntry(3));
+    ASSERT_EQUALS(1U, buffer->getMemoryCount_forTest());
+    assertPops(3, 3);
+}
+
+TEST_F(OplogBufferSpillingTest, WaitForDataReturnsWhenOperationIsPushed) {
+    setUpBuffer(0);
+    ASSERT_FALSE(buffer->waitForData(Seconds(0)));
+    buffer->push(nullptr, makeOplogEntry(1));
+    ASSERT_EQUALS(1U, buffer->getSpilledCount_forTest());
+    ASSERT_TRUE(buffer->waitForData(Seconds(0)));
+    assertPops(1, 1);
+    buffer->shutdown(nullptr);
+}
+
+}  // namespace
@@ -144,6 +144,7 @@ BSONObj makeOplogEntryDoc(OpTime opTime,
 }  // namespace
 
 const int OplogEntry::kOplogVersion = 2;
+const StringData OplogEntry::kPartialTransactionFieldName = "partialTxn"_sd;
 
 // Static
 ReplOperation OplogEntry::makeInsertOperation(const NamespaceString& nss,
@@ -265,6 +266,11 @@ bool OplogEntry::shouldPrepare() const {
     return getPrepare() && *getPrepare();
 }
 
+bool OplogEntry::isPartialTransaction() const {
+    return getCommandType() == CommandType::kApplyOps &&
+        getObject()[kPartialTransactionFieldName].trueValue();
+}
+
 BSONElement OplogEntry::getIdElement() const {
     invariant(isCrudOpType());
     if (getOpType() == OpTypeEnum::kUpdate) {
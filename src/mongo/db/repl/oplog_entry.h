@@ -63,6 +63,10 @@ public:
     // Current oplog version, should be the value of the v field in all oplog entries.
     static const int kOplogVersion;
 
+    // Field of the 'o' object which marks an applyOps entry as one of the leading entries of a
+    // transaction that was split across several oplog entries.
+    static const StringData kPartialTransactionFieldName;
+
     // Helpers to generate ReplOperation.
     static ReplOperation makeInsertOperation(const NamespaceString& nss,
                                              boost::optional<UUID> uuid,
@@ -121,6 +125,13 @@ public:
      */
     bool shouldPrepare() const;
 
+    /**
+     * Returns if this is an 'applyOps' entry holding only part of a transaction's operations. The
+     * operations must not be applied until the final entry of the transaction is seen; that entry
+     * reaches this one through its 'prevOpTime' chain.
+     */
+    bool isPartialTransaction() const;
+
     /**
      * Returns the _id of the document being modified. Must be called on CRUD ops.
      */
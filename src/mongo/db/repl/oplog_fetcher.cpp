@@ -33,9 +33,11 @@
 #include "mongo/db/repl/oplog_fetcher.h"
 
 #include "mongo/base/counter.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/rpc/metadata/oplog_query_metadata.h"
 #include "mongo/util/assert_util.h"
@@ -50,6 +52,15 @@ Seconds OplogFetcher::kDefaultProtocolZeroAwaitDataTimeout(2);
 
 MONGO_FAIL_POINT_DEFINE(stopReplProducer);
 
+MONGO_EXPORT_SERVER_PARAMETER(oplogFetcherMaxPendingBatches, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 100) {
+            return Status(ErrorCodes::BadValue,
+                          "oplogFetcherMaxPendingBatches must be between 0 and 100");
+        }
+        return Status::OK();
+    });
+
 namespace {
 
 // The number and time spent reading batches off the network
@@ -62,6 +73,10 @@ ServerStatusMetricField<Counter64> displayOpsRead("repl.network.ops", &opsReadSt
 // The bytes read via the oplog reader
 Counter64 networkByteStats;
 ServerStatusMetricField<Counter64> displayBytesRead("repl.network.bytes", &networkByteStats);
+// The batches fetched by the oplog reader that are waiting to be enqueued
+Counter64 pendingBatchesStats;
+ServerStatusMetricField<Counter64> displayPendingBatches("repl.network.pendingBatches",
+                                                         &pendingBatchesStats);
 
 const Milliseconds maximumAwaitDataTimeoutMS(30 * 1000);
 
@@ -344,7 +359,13 @@ OplogFetcher::OplogFetcher(executor::TaskExecutor* executor,
                            source,
                            nss,
                            maxFetcherRestarts,
-                           onShutdownCallbackFn,
+                           [this, onShutdownCallbackFn](const Status& shutdownStatus) {
+                               // Batches fetched before the shutdown are enqueued first, and an
+                               // error enqueuing them takes precedence.
+                               auto enqueueStatus = _drainPendingBatches();
+                               onShutdownCallbackFn(enqueueStatus.isOK() ? shutdownStatus
+                                                                         : enqueueStatus);
+                           },
                            "oplog fetcher"),
       _metadataObject(makeMetadataObject()),
       _requiredRBID(requiredRBID),
@@ -352,15 +373,97 @@ OplogFetcher::OplogFetcher(executor::TaskExecutor* executor,
       _dataReplicatorExternalState(dataReplicatorExternalState),
       _enqueueDocumentsFn(enqueueDocumentsFn),
       _awaitDataTimeout(calculateAwaitDataTimeout(config)),
-      _batchSize(batchSize) {
+      _batchSize(batchSize),
+      _maxPendingBatches(oplogFetcherMaxPendingBatches.load()) {
 
     invariant(config.isInitialized());
     invariant(enqueueDocumentsFn);
+    invariant(onShutdownCallbackFn);
 }
 
 OplogFetcher::~OplogFetcher() {
     shutdown();
     join();
+
+    // The shutdown callback drains '_enqueueThread', but it is never called if startup failed.
+    _drainPendingBatches().ignore();
+}
+
+Status OplogFetcher::_enqueueDocuments(const Fetcher::QueryResponse& queryResponse,
+                                       Fetcher::Documents::const_iterator firstDocToApply,
+                                       const DocumentsInfo& info) {
+    if (_maxPendingBatches <= 0) {
+        return _enqueueDocumentsFn(firstDocToApply, queryResponse.documents.cend(), info);
+    }
+
+    stdx::unique_lock<stdx::mutex> lk(_pendingBatchesMutex);
+    _pendingBatchesCondition.wait(lk, [&] {
+        return !_enqueueStatus.isOK() ||
+            _pendingBatches.size() < static_cast<std::size_t>(_maxPendingBatches);
+    });
+    if (!_enqueueStatus.isOK()) {
+        return _enqueueStatus;
+    }
+
+    _pendingBatches.push_back(
+        {queryResponse.otherFields.metadata,
+         queryResponse.documents,
+         static_cast<std::size_t>(firstDocToApply - queryResponse.documents.cbegin()),
+         info});
+    pendingBatchesStats.increment();
+    if (!_enqueueThread) {
+        _enqueueThread = stdx::make_unique<stdx::thread>([this] { _runEnqueueThread(); });
+    }
+    _pendingBatchesCondition.notify_all();
+    return Status::OK();
+}
+
+void OplogFetcher::_runEnqueueThread() {
+    Client::initThread("OplogFetcherEnqueue");
+
+    stdx::unique_lock<stdx::mutex> lk(_pendingBatchesMutex);
+    while (true) {
+        _pendingBatchesCondition.wait(
+            lk, [this] { return _stopEnqueuing || !_pendingBatches.empty(); });
+        if (_pendingBatches.empty()) {
+            return;
+        }
+
+        // Only this thread removes batches, so the front batch stays put while unlocked.
+        const auto& batch = _pendingBatches.front();
+        lk.unlock();
+        auto status = _enqueueDocumentsFn(
+            batch.documents.cbegin() + batch.firstDocToApply, batch.documents.cend(), batch.info);
+        lk.lock();
+
+        _pendingBatches.pop_front();
+        pendingBatchesStats.decrement();
+        if (!status.isOK()) {
+            // Later batches can't be applied without this one.
+            _enqueueStatus = status;
+            pendingBatchesStats.decrement(_pendingBatches.size());
+            _pendingBatches.clear();
+        }
+        _pendingBatchesCondition.notify_all();
+    }
+}
+
+Status OplogFetcher::_drainPendingBatches() {
+    std::unique_ptr<stdx::thread> enqueueThread;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_pendingBatchesMutex);
+        _stopEnqueuing = true;
+        _pendingBatchesCondition.notify_all();
+        std::swap(enqueueThread, _enqueueThread);
+    }
+
+    // The thread exits once '_pendingBatches' is empty.
+    if (enqueueThread) {
+        enqueueThread->join();
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_pendingBatchesMutex);
+    return _enqueueStatus;
 }
 
 BSONObj OplogFetcher::_makeFindCommandObject(const NamespaceString& nss,
@@ -499,7 +602,7 @@ StatusWith<BSONObj> OplogFetcher::_onSuccessfulBatch(const Fetcher::QueryRespons
     getmoreReplStats.recordMillis(durationCount<Milliseconds>(queryResponse.elapsedMillis));
 
     // TODO: back pressure handling will be added in SERVER-23499.
-    auto status = _enqueueDocumentsFn(firstDocToApply, documents.cend(), info);
+    auto status = _enqueueDocuments(queryResponse, firstDocToApply, info);
     if (!status.isOK()) {
         return status;
     }
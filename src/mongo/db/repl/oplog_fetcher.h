@@ -29,6 +29,8 @@
 #pragma once
 
 #include <cstddef>
+#include <deque>
+#include <memory>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/status_with.h"
@@ -38,7 +40,11 @@
 #include "mongo/db/repl/abstract_oplog_fetcher.h"
 #include "mongo/db/repl/data_replicator_external_state.h"
 #include "mongo/db/repl/repl_set_config.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/functional.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point_service.h"
 
 namespace mongo {
@@ -46,6 +52,10 @@ namespace repl {
 
 MONGO_FAIL_POINT_DECLARE(stopReplProducer);
 
+// Number of fetched batches that may wait to be enqueued while the next getMore is outstanding.
+// Zero enqueues each batch before issuing the next getMore.
+extern AtomicInt32 oplogFetcherMaxPendingBatches;
+
 /**
  * The oplog fetcher, once started, reads operations from a remote oplog using a tailable cursor.
  *
@@ -62,7 +72,11 @@ MONGO_FAIL_POINT_DECLARE(stopReplProducer);
  * Pushes operations from each batch of operations onto a buffer using the "enqueueDocumentsFn"
  * function.
  *
- * Issues a getMore command after successfully processing each batch of operations.
+ * Issues a getMore command after successfully processing each batch of operations. If
+ * oplogFetcherMaxPendingBatches is positive, a validated batch is instead handed to a background
+ * thread to be enqueued, and the getMore is issued without waiting for "enqueueDocumentsFn". Up to
+ * that many batches may be waiting at once; all of them are enqueued before "onShutdownCallbackFn"
+ * is called.
  *
  * When there is an error or when it is not possible to issue another getMore request, calls
  * "onShutdownCallbackFn" to signal the end of processing.
@@ -158,6 +172,37 @@ private:
      */
     StatusWith<BSONObj> _onSuccessfulBatch(const Fetcher::QueryResponse& queryResponse) override;
 
+    /**
+     * A validated batch waiting to be passed to '_enqueueDocumentsFn' by '_enqueueThread'.
+     * 'response' owns the buffer that 'documents' point into.
+     */
+    struct PendingBatch {
+        BSONObj response;
+        Fetcher::Documents documents;
+        std::size_t firstDocToApply;
+        DocumentsInfo info;
+    };
+
+    /**
+     * Passes the documents of a validated batch from 'firstDocToApply' on to '_enqueueDocumentsFn',
+     * either directly or by way of '_pendingBatches'. Returns the first error from enqueuing an
+     * earlier pending batch, if any.
+     */
+    Status _enqueueDocuments(const Fetcher::QueryResponse& queryResponse,
+                             Fetcher::Documents::const_iterator firstDocToApply,
+                             const DocumentsInfo& info);
+
+    /**
+     * Body of '_enqueueThread'. Enqueues pending batches in order until told to stop.
+     */
+    void _runEnqueueThread();
+
+    /**
+     * Waits for every pending batch to be enqueued and stops '_enqueueThread'. Returns the first
+     * error from enqueuing a pending batch.
+     */
+    Status _drainPendingBatches();
+
     // The metadata object sent with the Fetcher queries.
     const BSONObj _metadataObject;
 
@@ -174,6 +219,27 @@ private:
     const EnqueueDocumentsFn _enqueueDocumentsFn;
     const Milliseconds _awaitDataTimeout;
     const int _batchSize;
+
+    // Read from oplogFetcherMaxPendingBatches at construction.
+    const int _maxPendingBatches;
+
+    // Protects the members below.
+    stdx::mutex _pendingBatchesMutex;
+
+    // Signaled when a batch is added to or removed from '_pendingBatches', and on '_stopEnqueuing'.
+    stdx::condition_variable _pendingBatchesCondition;
+
+    // Batches that have been fetched and validated but not yet enqueued. The front batch stays
+    // here while '_enqueueThread' enqueues it.
+    std::deque<PendingBatch> _pendingBatches;
+
+    // First error returned by '_enqueueDocumentsFn' for a pending batch.
+    Status _enqueueStatus = Status::OK();
+
+    bool _stopEnqueuing = false;
+
+    // Started when the first batch is made pending.
+    std::unique_ptr<stdx::thread> _enqueueThread;
 };
 
 }  // namespace repl
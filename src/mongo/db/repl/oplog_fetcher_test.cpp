@@ -36,7 +36,9 @@
 #include "mongo/rpc/metadata.h"
 #include "mongo/rpc/metadata/oplog_query_metadata.h"
 #include "mongo/rpc/metadata/repl_set_metadata.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/unittest/ensure_fcv.h"
 #include "mongo/unittest/task_executor_proxy.h"
 #include "mongo/unittest/unittest.h"
@@ -770,6 +772,69 @@ TEST_F(
                       request.cmdObj["lastKnownCommittedOpTime"].Obj())));
 }
 
+TEST_F(OplogFetcherTest, PendingBatchesLetGetMoreBeIssuedBeforeEnqueuingFinishes) {
+    const int oldMaxPendingBatches = oplogFetcherMaxPendingBatches.load();
+    ON_BLOCK_EXIT([&] { oplogFetcherMaxPendingBatches.store(oldMaxPendingBatches); });
+    oplogFetcherMaxPendingBatches.store(2);
+
+    // Enqueuing blocks until 'enqueueAllowed' is set.
+    stdx::mutex mutex;
+    stdx::condition_variable condition;
+    bool enqueueAllowed = false;
+    Fetcher::Documents enqueuedDocuments;
+    auto blockingEnqueueDocumentsFn = [&](Fetcher::Documents::const_iterator begin,
+                                          Fetcher::Documents::const_iterator end,
+                                          const OplogFetcher::DocumentsInfo&) {
+        stdx::unique_lock<stdx::mutex> lk(mutex);
+        condition.wait(lk, [&] { return enqueueAllowed; });
+        enqueuedDocuments.insert(enqueuedDocuments.end(), begin, end);
+        return Status::OK();
+    };
+
+    ShutdownState shutdownState;
+    OplogFetcher oplogFetcher(&getExecutor(),
+                              lastFetched,
+                              source,
+                              nss,
+                              _createConfig(),
+                              0,
+                              rbid,
+                              true,
+                              dataReplicatorExternalState.get(),
+                              blockingEnqueueDocumentsFn,
+                              stdx::ref(shutdownState),
+                              defaultBatchSize);
+    ASSERT_OK(oplogFetcher.startup());
+
+    auto firstEntry = makeNoopOplogEntry(lastFetched);
+    auto secondEntry = makeNoopOplogEntry({{Seconds(456), 0}, lastFetched.opTime.getTerm()}, 200);
+    auto metadataObj = makeOplogQueryMetadataObject(remoteNewerOpTime, rbid, 2, 2);
+    processNetworkResponse(
+        {concatenate(makeCursorResponse(22LL, {firstEntry, secondEntry}), metadataObj),
+         Milliseconds(0)},
+        true);
+
+    // The getMore was scheduled while the first batch is still waiting to be enqueued.
+    {
+        stdx::lock_guard<stdx::mutex> lk(mutex);
+        ASSERT(enqueuedDocuments.empty());
+        enqueueAllowed = true;
+        condition.notify_all();
+    }
+
+    auto thirdEntry = makeNoopOplogEntry({{Seconds(789), 0}, lastFetched.opTime.getTerm()}, 300);
+    auto request = processNetworkResponse(makeCursorResponse(0, {thirdEntry}, false));
+    ASSERT_EQUALS(std::string("getMore"), request.cmdObj.firstElementFieldName());
+
+    oplogFetcher.join();
+    ASSERT_OK(shutdownState.getStatus());
+
+    // Both batches were enqueued, in order, before the shutdown callback ran.
+    ASSERT_EQUALS(2U, enqueuedDocuments.size());
+    ASSERT_BSONOBJ_EQ(secondEntry, enqueuedDocuments[0]);
+    ASSERT_BSONOBJ_EQ(thirdEntry, enqueuedDocuments[1]);
+}
+
 TEST_F(OplogFetcherTest, ValidateDocumentsReturnsNoSuchKeyIfTimestampIsNotFoundInAnyDocument) {
     auto firstEntry = makeNoopOplogEntry(Seconds(123), 100);
     auto secondEntry = BSON("o" << BSON("msg"
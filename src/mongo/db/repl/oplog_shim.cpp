@@ -31,5 +31,6 @@
 namespace mongo {
 namespace repl {
 MONGO_DEFINE_SHIM(GetNextOpTimeClass::getNextOpTime);
+MONGO_DEFINE_SHIM(GetIdleOplogTimestampClass::getIdleOplogTimestamp);
 }  // namespace repl
 }  // namespace mongo
@@ -0,0 +1,83 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/phi_accrual_failure_detector.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mongo {
+namespace repl {
+
+PhiAccrualFailureDetector::PhiAccrualFailureDetector(Options options)
+    : _options(std::move(options)) {}
+
+void PhiAccrualFailureDetector::recordHeartbeat(Date_t now) {
+    if (_lastHeartbeatDate != Date_t()) {
+        const auto interval = durationCount<Milliseconds>(now - _lastHeartbeatDate);
+        _intervals.push_back(interval);
+        _intervalSum += interval;
+        _intervalSquaredSum += static_cast<double>(interval) * interval;
+
+        if (_intervals.size() > _options.maxSamples) {
+            const auto oldest = _intervals.front();
+            _intervals.pop_front();
+            _intervalSum -= oldest;
+            _intervalSquaredSum -= static_cast<double>(oldest) * oldest;
+        }
+    }
+    _lastHeartbeatDate = now;
+}
+
+double PhiAccrualFailureDetector::phi(Date_t now) const {
+    if (_intervals.empty()) {
+        return 0;
+    }
+
+    const double n = _intervals.size();
+    const double mean = _intervalSum / n;
+    const double variance = std::max(_intervalSquaredSum / n - mean * mean, 0.0);
+    const double stdDeviation =
+        std::max(std::sqrt(variance), double(durationCount<Milliseconds>(_options.minStdDeviation)));
+
+    // Approximates the tail of the normal distribution of the intervals with a logistic function
+    // rather than computing the error function. Once the elapsed time is far enough past the mean
+    // that 'e' underflows, the suspicion is infinite.
+    const double elapsed = durationCount<Milliseconds>(now - _lastHeartbeatDate);
+    const double y = (elapsed - mean) / stdDeviation;
+    const double e = std::exp(-y * (1.5976 + 0.070566 * y * y));
+    if (elapsed > mean) {
+        return -std::log10(e / (1.0 + e));
+    }
+    return -std::log10(1.0 - 1.0 / (1.0 + e));
+}
+
+}  // namespace repl
+}  // namespace mongo
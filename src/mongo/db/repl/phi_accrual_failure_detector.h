@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+
+#include "mongo/util/duration.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * Estimates how likely it is that a remote node has failed from the arrival times of the replies it
+ * has sent us, following "The phi Accrual Failure Detector" (Hayashibara et al.). Rather than
+ * declaring the node down after a fixed timeout, phi() grows continuously with the time since the
+ * last reply, scaled by the mean and deviation of the intervals seen so far, so a threshold on it
+ * adapts to the jitter of the network the replies actually travel over. A phi of 1 means the
+ * chance of the next reply still arriving is 10%, a phi of 2 means 1%, and so on.
+ *
+ * This class is not thread safe.
+ */
+class PhiAccrualFailureDetector {
+public:
+    struct Options {
+        // The number of most recent intervals between replies the distribution is estimated from.
+        std::size_t maxSamples = 100;
+
+        // Lower bound on the standard deviation of the intervals, so that a perfectly regular
+        // stream of replies does not make the detector suspect the node when one is a little late.
+        Milliseconds minStdDeviation{50};
+    };
+
+    PhiAccrualFailureDetector() = default;
+    explicit PhiAccrualFailureDetector(Options options);
+
+    /**
+     * Records that a reply from the node arrived at 'now'.
+     */
+    void recordHeartbeat(Date_t now);
+
+    /**
+     * Returns the suspicion level that the node has failed, given that no reply has arrived since
+     * the last one recorded. Returns 0 until at least one interval between replies is known.
+     */
+    double phi(Date_t now) const;
+
+    /**
+     * Returns the number of intervals between replies the distribution is currently estimated
+     * from.
+     */
+    std::size_t numSamples() const {
+        return _intervals.size();
+    }
+
+    Date_t getLastHeartbeatDate() const {
+        return _lastHeartbeatDate;
+    }
+
+private:
+    Options _options;
+
+    // The most recent intervals between replies, in milliseconds, and their running totals.
+    std::deque<long long> _intervals;
+    double _intervalSum = 0;
+    double _intervalSquaredSum = 0;
+
+    // Date_t() until the first reply is recorded.
+    Date_t _lastHeartbeatDate;
+};
+
+}  // namespace repl
+}  // namespace mongo
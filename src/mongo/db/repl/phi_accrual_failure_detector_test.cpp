@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/phi_accrual_failure_detector.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+const Date_t kStart = Date_t::fromMillisSinceEpoch(1000000);
+
+PhiAccrualFailureDetector makeDetector(std::size_t maxSamples = 100) {
+    PhiAccrualFailureDetector::Options options;
+    options.maxSamples = maxSamples;
+    options.minStdDeviation = Milliseconds(20);
+    return PhiAccrualFailureDetector(options);
+}
+
+// Records 'count' replies 'interval' apart, the first one at 'start'. Returns the date of the last.
+Date_t recordRegularHeartbeats(PhiAccrualFailureDetector* detector,
+                               Date_t start,
+                               Milliseconds interval,
+                               int count) {
+    Date_t now = start;
+    for (int i = 0; i < count; ++i) {
+        now = start + interval * i;
+        detector->recordHeartbeat(now);
+    }
+    return now;
+}
+
+TEST(PhiAccrualFailureDetector, NoSuspicionWithoutIntervals) {
+    auto detector = makeDetector();
+    ASSERT_EQ(0.0, detector.phi(kStart));
+
+    detector.recordHeartbeat(kStart);
+    ASSERT_EQ(0U, detector.numSamples());
+    ASSERT_EQ(kStart, detector.getLastHeartbeatDate());
+    ASSERT_EQ(0.0, detector.phi(kStart + Seconds(60)));
+}
+
+TEST(PhiAccrualFailureDetector, SuspicionGrowsWithTimeSinceLastReply) {
+    auto detector = makeDetector();
+    const auto last = recordRegularHeartbeats(&detector, kStart, Milliseconds(100), 20);
+    ASSERT_EQ(19U, detector.numSamples());
+
+    // A reply that is due is not suspicious, while one that is several deviations late is.
+    ASSERT_LT(detector.phi(last + Milliseconds(50)), 1.0);
+    ASSERT_LT(detector.phi(last + Milliseconds(100)), 1.0);
+    ASSERT_GT(detector.phi(last + Milliseconds(250)), 8.0);
+
+    double previous = 0;
+    for (int elapsed = 0; elapsed <= 300; elapsed += 10) {
+        const double phi = detector.phi(last + Milliseconds(elapsed));
+        ASSERT_GTE(phi, previous);
+        previous = phi;
+    }
+}
+
+TEST(PhiAccrualFailureDetector, JitteryRepliesRaiseTheBarForSuspicion) {
+    auto regular = makeDetector();
+    const auto regularLast = recordRegularHeartbeats(&regular, kStart, Milliseconds(100), 20);
+
+    auto jittery = makeDetector();
+    Date_t jitteryLast = kStart;
+    for (int i = 0; i < 20; ++i) {
+        jitteryLast += Milliseconds(i % 2 ? 20 : 180);
+        jittery.recordHeartbeat(jitteryLast);
+    }
+
+    // Both streams average one reply every 100ms, but the same delay is far less suspicious when
+    // replies have routinely been late before.
+    ASSERT_GT(regular.phi(regularLast + Milliseconds(250)),
+              jittery.phi(jitteryLast + Milliseconds(250)));
+}
+
+TEST(PhiAccrualFailureDetector, OnlyRecentIntervalsAreKept) {
+    auto detector = makeDetector(10);
+    auto last = recordRegularHeartbeats(&detector, kStart, Seconds(1), 20);
+    ASSERT_EQ(10U, detector.numSamples());
+
+    // Once the window only holds the faster replies, the old ones no longer mask a delay.
+    last = recordRegularHeartbeats(&detector, last + Milliseconds(100), Milliseconds(100), 11);
+    ASSERT_EQ(10U, detector.numSamples());
+    ASSERT_GT(detector.phi(last + Milliseconds(400)), 8.0);
+}
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -37,6 +37,7 @@
 #include "mongo/db/repl/member_state.h"
 #include "mongo/db/repl/repl_settings.h"
 #include "mongo/db/repl/sync_source_selector.h"
+#include "mongo/util/future.h"
 #include "mongo/util/net/hostandport.h"
 #include "mongo/util/time_support.h"
 
@@ -184,6 +185,18 @@ public:
                                                const OpTime& opTime,
                                                const WriteConcernOptions& writeConcern) = 0;
 
+    /**
+     * Asynchronous version of awaitReplication(), for callers that must not hold a thread while
+     * waiting. The returned future becomes ready once 'opTime' has been replicated to a set of
+     * nodes that satisfies 'writeConcern', or with the same errors as awaitReplication() when the
+     * writeConcern.wTimeout is reached, the node steps down or replication shuts down. Since no
+     * OperationContext is involved, interruption and maxTimeMS must be enforced by whoever waits
+     * on the future. The future may be completed on a replication executor thread, so
+     * continuations attached to it must not block.
+     */
+    virtual Future<void> awaitReplicationAsync(const OpTime& opTime,
+                                               const WriteConcernOptions& writeConcern) = 0;
+
     /**
      * Causes this node to relinquish being primary for at least 'stepdownTime'.  If 'force' is
      * false, before doing so it will wait for 'waitTime' for one other electable node to be caught
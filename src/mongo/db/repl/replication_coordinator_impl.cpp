@@ -226,6 +226,32 @@ void ReplicationCoordinatorImpl::CallbackWaiter::notify_inlock() {
     finishCallback();
 }
 
+ReplicationCoordinatorImpl::PromiseWaiter::PromiseWaiter(ReplicationCoordinatorImpl* _repl,
+                                                         uint64_t _id,
+                                                         OpTime _opTime,
+                                                         WriteConcernOptions _writeConcern,
+                                                         Promise<void> _promise)
+    : Waiter(std::move(_opTime), &ownedWriteConcern),
+      repl(_repl),
+      id(_id),
+      ownedWriteConcern(std::move(_writeConcern)),
+      promise(std::move(_promise)) {}
+
+void ReplicationCoordinatorImpl::PromiseWaiter::notify_inlock() {
+    // Waiters on _replicationWaiterList are only signaled when they are done waiting, on shutdown
+    // and when this node stops being primary.
+    Status status = Status::OK();
+    if (repl->_doneWaitingForReplication_inlock(opTime, ownedWriteConcern)) {
+        status = repl->_checkIfWriteConcernCanBeSatisfied_inlock(ownedWriteConcern);
+    } else if (repl->_inShutdown) {
+        status = {ErrorCodes::ShutdownInProgress, "Replication is being shut down"};
+    } else {
+        status = {ErrorCodes::PrimarySteppedDown,
+                  "Primary stepped down while waiting for replication"};
+    }
+    repl->_completePromiseWaiter_inlock(this, std::move(status));
+}
+
 
 class ReplicationCoordinatorImpl::WaiterGuard {
 public:
@@ -1562,29 +1588,7 @@ Status ReplicationCoordinatorImpl::_awaitReplication_inlock(
         return Status::OK();
     }
 
-    auto checkForStepDown = [&]() -> Status {
-        if (replMode == modeReplSet && !_memberState.primary()) {
-            return {ErrorCodes::PrimarySteppedDown,
-                    "Primary stepped down while waiting for replication"};
-        }
-
-        if (opTime.getTerm() != _topCoord->getTerm()) {
-            return {
-                ErrorCodes::PrimarySteppedDown,
-                str::stream() << "Term changed from " << opTime.getTerm() << " to "
-                              << _topCoord->getTerm()
-                              << " while waiting for replication, indicating that this node must "
-                                 "have stepped down."};
-        }
-
-        if (_topCoord->isSteppingDown()) {
-            return {ErrorCodes::PrimarySteppedDown,
-                    "Received stepdown request while waiting for replication"};
-        }
-        return Status::OK();
-    };
-
-    Status stepdownStatus = checkForStepDown();
+    Status stepdownStatus = _checkForStepDownWhileAwaitingReplication_inlock(opTime);
     if (!stepdownStatus.isOK()) {
         return stepdownStatus;
     }
@@ -1642,7 +1646,7 @@ Status ReplicationCoordinatorImpl::_awaitReplication_inlock(
             return {ErrorCodes::WriteConcernFailed, "waiting for replication timed out"};
         }
 
-        stepdownStatus = checkForStepDown();
+        stepdownStatus = _checkForStepDownWhileAwaitingReplication_inlock(opTime);
         if (!stepdownStatus.isOK()) {
             return stepdownStatus;
         }
@@ -1657,6 +1661,123 @@ Status ReplicationCoordinatorImpl::_awaitReplication_inlock(
     return Status::OK();
 }
 
+Status ReplicationCoordinatorImpl::_checkForStepDownWhileAwaitingReplication_inlock(
+    const OpTime& opTime) const {
+    if (getReplicationMode() == modeReplSet && !_memberState.primary()) {
+        return {ErrorCodes::PrimarySteppedDown,
+                "Primary stepped down while waiting for replication"};
+    }
+
+    if (opTime.getTerm() != _topCoord->getTerm()) {
+        return {ErrorCodes::PrimarySteppedDown,
+                str::stream() << "Term changed from " << opTime.getTerm() << " to "
+                              << _topCoord->getTerm()
+                              << " while waiting for replication, indicating that this node must "
+                                 "have stepped down."};
+    }
+
+    if (_topCoord->isSteppingDown()) {
+        return {ErrorCodes::PrimarySteppedDown,
+                "Received stepdown request while waiting for replication"};
+    }
+    return Status::OK();
+}
+
+Future<void> ReplicationCoordinatorImpl::awaitReplicationAsync(
+    const OpTime& opTime, const WriteConcernOptions& writeConcern) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+
+    if (getReplicationMode() == modeNone || opTime.isNull()) {
+        return Future<void>::makeReady();
+    }
+
+    if (_inShutdown) {
+        return Status(ErrorCodes::ShutdownInProgress, "Replication is being shut down");
+    }
+
+    Status stepdownStatus = _checkForStepDownWhileAwaitingReplication_inlock(opTime);
+    if (!stepdownStatus.isOK()) {
+        return stepdownStatus;
+    }
+
+    if (writeConcern.wMode.empty()) {
+        if (writeConcern.wNumNodes < 1) {
+            return Future<void>::makeReady();
+        } else if (writeConcern.wNumNodes == 1 && _getMyLastAppliedOpTime_inlock() >= opTime) {
+            return Future<void>::makeReady();
+        }
+    }
+
+    if (_doneWaitingForReplication_inlock(opTime, writeConcern)) {
+        return Future<void>::makeReady(_checkIfWriteConcernCanBeSatisfied_inlock(writeConcern));
+    }
+
+    const auto wTimeoutDate = [&]() -> const Date_t {
+        if (writeConcern.wDeadline != Date_t::max()) {
+            return writeConcern.wDeadline;
+        }
+        if (writeConcern.wTimeout == WriteConcernOptions::kNoTimeout) {
+            return Date_t::max();
+        }
+        return _replExecutor->now() + Milliseconds{writeConcern.wTimeout};
+    }();
+
+    auto pf = makePromiseFuture<void>();
+    const auto id = _nextPromiseWaiterId++;
+    auto waiter =
+        stdx::make_unique<PromiseWaiter>(this, id, opTime, writeConcern, std::move(pf.promise));
+
+    if (wTimeoutDate != Date_t::max()) {
+        waiter->timeoutHandle =
+            _scheduleWorkAt(wTimeoutDate, [this, id](const CallbackArgs&) {
+                stdx::lock_guard<stdx::mutex> lk(_mutex);
+                auto it = _promiseWaiters.find(id);
+                if (it == _promiseWaiters.end()) {
+                    return;
+                }
+                auto timedOut = it->second.get();
+                timedOut->timeoutHandle = CallbackHandle();
+                _replicationWaiterList.remove_inlock(timedOut);
+                _completePromiseWaiter_inlock(
+                    timedOut,
+                    {ErrorCodes::WriteConcernFailed, "waiting for replication timed out"});
+            });
+        if (!waiter->timeoutHandle.isValid()) {
+            return Status(ErrorCodes::ShutdownInProgress, "Replication is being shut down");
+        }
+    }
+
+    _replicationWaiterList.add_inlock(waiter.get());
+    _promiseWaiters.emplace(id, std::move(waiter));
+    return std::move(pf.future);
+}
+
+void ReplicationCoordinatorImpl::_completePromiseWaiter_inlock(PromiseWaiter* waiter,
+                                                               Status status) {
+    if (waiter->timeoutHandle.isValid()) {
+        _replExecutor->cancel(waiter->timeoutHandle);
+    }
+
+    auto promise = std::make_shared<Promise<void>>(std::move(waiter->promise));
+    auto complete = [promise, status] {
+        if (status.isOK()) {
+            promise->emplaceValue();
+        } else {
+            promise->setError(status);
+        }
+    };
+    // This destroys 'waiter'.
+    const auto id = waiter->id;
+    _promiseWaiters.erase(id);
+
+    // The callback also runs when it is canceled by the executor shutting down, which still
+    // completes the promise.
+    auto cbh = _replExecutor->scheduleWork([complete](const CallbackArgs&) { complete(); });
+    if (!cbh.isOK()) {
+        complete();
+    }
+}
+
 void ReplicationCoordinatorImpl::waitForStepDownAttempt_forTest() {
     auto isSteppingDown = [&]() {
         stdx::unique_lock<stdx::mutex> lk(_mutex);
@@ -38,6 +38,7 @@
 #include "mongo/db/repl/initial_syncer.h"
 #include "mongo/db/repl/member_state.h"
 #include "mongo/db/repl/optime.h"
+#include "mongo/db/repl/phi_accrual_failure_detector.h"
 #include "mongo/db/repl/repl_set_config.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_coordinator_external_state.h"
@@ -49,6 +50,7 @@
 #include "mongo/platform/random.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/net/hostandport.h"
@@ -118,6 +120,9 @@ public:
     virtual ReplicationCoordinator::StatusAndDuration awaitReplication(
         OperationContext* opCtx, const OpTime& opTime, const WriteConcernOptions& writeConcern);
 
+    Future<void> awaitReplicationAsync(const OpTime& opTime,
+                                       const WriteConcernOptions& writeConcern) override;
+
     void stepDown(OperationContext* opCtx,
                   bool force,
                   const Milliseconds& waitTime,
@@ -488,6 +493,31 @@ private:
         FinishFunc finishCallback = nullptr;
     };
 
+    // When PromiseWaiter gets notified, its promise is completed with the outcome of the wait.
+    //
+    // This is used by awaitReplicationAsync(), where no thread stays behind to own the
+    // writeConcern, so the waiter keeps its own copy. PromiseWaiters are owned by
+    // _promiseWaiters until they are completed.
+    struct PromiseWaiter : public Waiter {
+        PromiseWaiter(ReplicationCoordinatorImpl* _repl,
+                      uint64_t _id,
+                      OpTime _opTime,
+                      WriteConcernOptions _writeConcern,
+                      Promise<void> _promise);
+        void notify_inlock() override;
+        bool runs_once() const override {
+            return true;
+        }
+
+        ReplicationCoordinatorImpl* const repl;
+        const uint64_t id;
+        const WriteConcernOptions ownedWriteConcern;
+        Promise<void> promise;
+
+        // Handle to the callback that fails the wait once the writeConcern.wTimeout is reached.
+        executor::TaskExecutor::CallbackHandle timeoutHandle;
+    };
+
     class WaiterGuard;
 
     class WaiterList {
@@ -623,6 +653,18 @@ private:
 
     Status _checkIfWriteConcernCanBeSatisfied_inlock(const WriteConcernOptions& writeConcern) const;
 
+    /**
+     * Returns PrimarySteppedDown if this node has stepped down, or is about to, since it wrote
+     * 'opTime' as primary.
+     */
+    Status _checkForStepDownWhileAwaitingReplication_inlock(const OpTime& opTime) const;
+
+    /**
+     * Removes 'waiter' from _promiseWaiters and completes its promise with 'status' on the
+     * replication executor, so that continuations never run while holding _mutex.
+     */
+    void _completePromiseWaiter_inlock(PromiseWaiter* waiter, Status status);
+
     bool _canAcceptWritesFor_inlock(const NamespaceString& ns);
 
     int _getMyId_inlock() const;
@@ -1020,6 +1062,33 @@ private:
      */
     void _startElectSelfIfEligibleV1(TopologyCoordinator::StartElectionReason reason);
 
+    /**
+     * Starts sending failure detection pings to 'primary', unless they are disabled or are already
+     * being sent to it. They run alongside heartbeats, at a much shorter interval, so that an
+     * election can be called as soon as the primary stops answering rather than only once the
+     * election timeout has passed.
+     */
+    void _startFailureDetection_inlock(const HostAndPort& primary);
+
+    /**
+     * Stops sending failure detection pings and forgets the replies received so far.
+     */
+    void _stopFailureDetection_inlock();
+
+    /**
+     * Runs every 'failureDetectionPingIntervalMillis' while failure detection is active. Calls an
+     * election if the primary's replies are so late that it is suspected to have failed, and
+     * otherwise sends it another ping unless one is still outstanding.
+     */
+    void _doFailureDetectionPing(const executor::TaskExecutor::CallbackArgs& cbData,
+                                 Date_t scheduledDate);
+
+    /**
+     * Records the arrival of a reply to a failure detection ping.
+     */
+    void _handleFailureDetectionPingResponse(
+        const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData);
+
     /**
      * Schedules work to be run no sooner than 'when' and returns handle to callback.
      * If work cannot be scheduled due to shutdown, returns empty handle.
@@ -1139,6 +1208,13 @@ private:
     // Does *not* own the WaiterInfos.
     WaiterList _opTimeWaiterList;  // (M)
 
+    // Waiters created by awaitReplicationAsync() which have not been completed yet, by id. The
+    // waiters are also on _replicationWaiterList.
+    stdx::unordered_map<uint64_t, std::unique_ptr<PromiseWaiter>> _promiseWaiters;  // (M)
+
+    // Id to give to the next PromiseWaiter.
+    uint64_t _nextPromiseWaiterId = 0;  // (M)
+
     // Set to true when we are in the process of shutting down replication.
     bool _inShutdown;  // (M)
 
@@ -1241,6 +1317,13 @@ private:
     // Used for testing only.
     Date_t _handleElectionTimeoutWhen;  // (M)
 
+    // The primary that failure detection pings are being sent to, and the arrival times of its
+    // replies. '_failureDetectionTarget' is empty while failure detection is inactive.
+    HostAndPort _failureDetectionTarget;                          // (M)
+    PhiAccrualFailureDetector _failureDetector;                   // (M)
+    bool _failureDetectionPingInFlight = false;                   // (M)
+    executor::TaskExecutor::CallbackHandle _failureDetectionCbh;  // (M)
+
     // Callback Handle used to cancel a scheduled PriorityTakeover callback.
     executor::TaskExecutor::CallbackHandle _priorityTakeoverCbh;  // (M)
 
@@ -37,6 +37,7 @@
 #include <algorithm>
 
 #include "mongo/base/status.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/logical_clock.h"
 #include "mongo/db/logical_time_validator.h"
 #include "mongo/db/operation_context.h"
@@ -49,7 +50,9 @@
 #include "mongo/db/repl/replication_state_transition_lock_guard.h"
 #include "mongo/db/repl/topology_coordinator.h"
 #include "mongo/db/repl/vote_requester.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/timer_stats.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/rpc/metadata/repl_set_metadata.h"
 #include "mongo/stdx/functional.h"
@@ -68,6 +71,36 @@ namespace {
 MONGO_FAIL_POINT_DEFINE(blockHeartbeatStepdown);
 MONGO_FAIL_POINT_DEFINE(blockHeartbeatReconfigFinish);
 
+// Milliseconds between the failure detection pings a secondary sends the primary, or 0 to detect
+// a failed primary through heartbeats and the election timeout alone.
+MONGO_EXPORT_SERVER_PARAMETER(failureDetectionPingIntervalMillis, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "failureDetectionPingIntervalMillis must be non-negative");
+        }
+        return Status::OK();
+    });
+
+// The suspicion level, as computed by PhiAccrualFailureDetector, at which a secondary stops waiting
+// for the election timeout and calls an election.
+MONGO_EXPORT_SERVER_PARAMETER(failureDetectionPhiThreshold, double, 8.0)
+    ->withValidator([](const double& newVal) {
+        if (!(newVal > 0)) {
+            return Status(ErrorCodes::BadValue, "failureDetectionPhiThreshold must be positive");
+        }
+        return Status::OK();
+    });
+
+// The number of intervals between ping replies that must be known before the primary is suspected,
+// so that a handful of early replies cannot make the distribution look tighter than it is.
+constexpr std::size_t kFailureDetectionMinSamples = 10;
+
+// The time elections called by failure detection took to notice the primary had stopped replying.
+TimerStats failureDetectionLatencyStats;
+ServerStatusMetricField<TimerStats> displayFailureDetectionLatency(
+    "repl.failureDetection.detectionLatency", &failureDetectionLatencyStats);
+
 }  // namespace
 
 using executor::RemoteCommandRequest;
@@ -200,6 +233,7 @@ void ReplicationCoordinatorImpl::_handleHeartbeatResponse(
             hbResponse.getTerm() == _topCoord->getTerm()) {
             LOG_FOR_ELECTION(4) << "Postponing election timeout due to heartbeat from primary";
             _cancelAndRescheduleElectionTimeout_inlock();
+            _startFailureDetection_inlock(target);
         }
     } else {
         LOG_FOR_HEARTBEATS(0) << "Error in heartbeat (requestId: " << cbData.request.id << ") to "
@@ -791,6 +825,125 @@ void ReplicationCoordinatorImpl::_cancelAndRescheduleElectionTimeout_inlock() {
         });
 }
 
+void ReplicationCoordinatorImpl::_startFailureDetection_inlock(const HostAndPort& primary) {
+    const Milliseconds interval(failureDetectionPingIntervalMillis.load());
+    if (interval <= Milliseconds(0) ||
+        (primary == _failureDetectionTarget && _failureDetectionCbh.isValid())) {
+        return;
+    }
+    _stopFailureDetection_inlock();
+
+    // Replies rarely arrive more regularly than this, and a primary should not be suspected
+    // merely because one reply was a little later than an otherwise perfect stream of them.
+    PhiAccrualFailureDetector::Options options;
+    options.minStdDeviation = interval / 2;
+    _failureDetector = PhiAccrualFailureDetector(options);
+    _failureDetectionTarget = primary;
+
+    LOG_FOR_HEARTBEATS(1) << "Starting failure detection pings to " << primary << " every "
+                          << interval;
+    const auto now = _replExecutor->now();
+    _failureDetectionCbh =
+        _scheduleWorkAt(now, [=](const executor::TaskExecutor::CallbackArgs& cbData) {
+            _doFailureDetectionPing(cbData, now);
+        });
+}
+
+void ReplicationCoordinatorImpl::_stopFailureDetection_inlock() {
+    if (_failureDetectionCbh.isValid()) {
+        _replExecutor->cancel(_failureDetectionCbh);
+        _failureDetectionCbh = CallbackHandle();
+    }
+    _failureDetectionTarget = HostAndPort();
+}
+
+void ReplicationCoordinatorImpl::_doFailureDetectionPing(
+    const executor::TaskExecutor::CallbackArgs& cbData, Date_t scheduledDate) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    // Failure detection may have been stopped, and even restarted, after this callback began but
+    // before it could cancel it.
+    if (cbData.myHandle != _failureDetectionCbh) {
+        return;
+    }
+    _failureDetectionCbh = CallbackHandle();
+
+    // Keep pinging while the primary is merely unknown, which is what heartbeats to a crashed
+    // primary quickly lead to, but not once another node has taken over.
+    const Milliseconds interval(failureDetectionPingIntervalMillis.load());
+    const int primaryIndex = _topCoord->getCurrentPrimaryIndex();
+    if (_inShutdown || interval <= Milliseconds(0) || !_memberState.secondary() ||
+        (primaryIndex >= 0 &&
+         _rsConfig.getMemberAt(primaryIndex).getHostAndPort() != _failureDetectionTarget)) {
+        _stopFailureDetection_inlock();
+        return;
+    }
+
+    // If this callback ran late, this node was stalled itself, and the replies it has not seen in
+    // the meantime say nothing about the primary.
+    const Date_t now = _replExecutor->now();
+    const bool stalled = now - scheduledDate > interval;
+    if (!stalled && _failureDetector.numSamples() >= kFailureDetectionMinSamples) {
+        const double phi = _failureDetector.phi(now);
+        if (phi >= failureDetectionPhiThreshold.load()) {
+            const auto silence = now - _failureDetector.getLastHeartbeatDate();
+            failureDetectionLatencyStats.recordMillis(durationCount<Milliseconds>(silence));
+            LOG_FOR_ELECTION(0) << "Primary " << _failureDetectionTarget
+                                << " is suspected to have failed, since it has not replied to "
+                                << "failure detection pings for " << silence << " (phi " << phi
+                                << "); calling an election";
+            _stopFailureDetection_inlock();
+
+            // Other secondaries are likely to suspect the primary at about the same time, so
+            // spread their elections out the way the election timeout does.
+            const Milliseconds offset{
+                _nextRandomInt64_inlock(durationCount<Milliseconds>(interval))};
+            _scheduleWorkAt(now + offset, [=](const executor::TaskExecutor::CallbackArgs&) {
+                _startElectSelfIfEligibleV1(
+                    TopologyCoordinator::StartElectionReason::kElectionTimeout);
+            });
+            return;
+        }
+    }
+
+    // Only one ping is outstanding at a time, so a primary that has stopped replying does not
+    // accumulate a ping for every interval until they time out.
+    if (!_failureDetectionPingInFlight) {
+        const RemoteCommandRequest request(_failureDetectionTarget,
+                                           "admin",
+                                           BSON("ping" << 1),
+                                           nullptr,
+                                           _rsConfig.getElectionTimeoutPeriod());
+        auto cbh = _replExecutor->scheduleRemoteCommand(
+            request, [=](const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData) {
+                _handleFailureDetectionPingResponse(cbData);
+            });
+        if (!cbh.isOK()) {
+            _stopFailureDetection_inlock();
+            return;
+        }
+        _failureDetectionPingInFlight = true;
+    }
+
+    const Date_t next = now + interval;
+    _failureDetectionCbh =
+        _scheduleWorkAt(next, [=](const executor::TaskExecutor::CallbackArgs& cbData) {
+            _doFailureDetectionPing(cbData, next);
+        });
+}
+
+void ReplicationCoordinatorImpl::_handleFailureDetectionPingResponse(
+    const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _failureDetectionPingInFlight = false;
+
+    // Any reply at all shows the primary is still running.
+    if (!cbData.response.status.isOK() || cbData.request.target != _failureDetectionTarget) {
+        return;
+    }
+    _failureDetector.recordHeartbeat(_replExecutor->now());
+}
+
 void ReplicationCoordinatorImpl::_startElectSelfIfEligibleV1(
     TopologyCoordinator::StartElectionReason reason) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
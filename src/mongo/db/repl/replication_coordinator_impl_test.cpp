@@ -1259,6 +1259,156 @@ TEST_F(ReplCoordTest, NodeReturnsNotMasterWhenSteppingDownBeforeSatisfyingAWrite
     awaiter.reset();
 }
 
+TEST_F(ReplCoordTest, AwaitReplicationAsyncIsReadyImmediatelyOnAStandaloneNode) {
+    init("");
+
+    WriteConcernOptions writeConcern;
+    writeConcern.wTimeout = WriteConcernOptions::kNoTimeout;
+    writeConcern.wNumNodes = 2;
+
+    auto future = getReplCoord()->awaitReplicationAsync(OpTimeWithTermOne(100, 1), writeConcern);
+    ASSERT_TRUE(future.isReady());
+    ASSERT_OK(future.getNoThrow());
+}
+
+TEST_F(ReplCoordTest, AwaitReplicationAsyncIsReadyOnceASufficientNumberOfNodesHaveTheWrite) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version"
+                            << 2
+                            << "members"
+                            << BSON_ARRAY(BSON("_id" << 0 << "host"
+                                                     << "node1:12345")
+                                          << BSON("_id" << 1 << "host"
+                                                        << "node2:12345")
+                                          << BSON("_id" << 2 << "host"
+                                                        << "node3:12345"))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    getReplCoord()->setMyLastAppliedOpTime(OpTimeWithTermOne(100, 1));
+    getReplCoord()->setMyLastDurableOpTime(OpTimeWithTermOne(100, 1));
+    simulateSuccessfulV1Election();
+
+    OpTimeWithTermOne time1(100, 1);
+    OpTimeWithTermOne time2(100, 2);
+
+    WriteConcernOptions writeConcern;
+    writeConcern.wTimeout = WriteConcernOptions::kNoTimeout;
+    writeConcern.wNumNodes = 2;
+
+    getReplCoord()->setMyLastAppliedOpTime(time2);
+    getReplCoord()->setMyLastDurableOpTime(time2);
+    auto future = getReplCoord()->awaitReplicationAsync(time2, writeConcern);
+    ASSERT_FALSE(future.isReady());
+
+    // Progress that does not satisfy the write concern leaves the future pending.
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time1));
+    ASSERT_FALSE(future.isReady());
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time2));
+    ASSERT_OK(future.getNoThrow());
+
+    // A write concern which is already satisfied does not wait at all.
+    auto satisfied = getReplCoord()->awaitReplicationAsync(time2, writeConcern);
+    ASSERT_TRUE(satisfied.isReady());
+    ASSERT_OK(satisfied.getNoThrow());
+}
+
+TEST_F(ReplCoordTest, AwaitReplicationAsyncReturnsWriteConcernFailedWhenTheWriteConcernTimesOut) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version"
+                            << 2
+                            << "members"
+                            << BSON_ARRAY(BSON("_id" << 0 << "host"
+                                                     << "node1:12345")
+                                          << BSON("_id" << 1 << "host"
+                                                        << "node2:12345")
+                                          << BSON("_id" << 2 << "host"
+                                                        << "node3:12345"))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    getReplCoord()->setMyLastAppliedOpTime(OpTimeWithTermOne(100, 1));
+    getReplCoord()->setMyLastDurableOpTime(OpTimeWithTermOne(100, 1));
+    simulateSuccessfulV1Election();
+
+    WriteConcernOptions writeConcern;
+    writeConcern.wDeadline = getNet()->now() + Milliseconds(50);
+    writeConcern.wNumNodes = 2;
+
+    auto future = getReplCoord()->awaitReplicationAsync(OpTimeWithTermOne(100, 2), writeConcern);
+    {
+        NetworkInterfaceMock::InNetworkGuard inNet(getNet());
+        getNet()->runUntil(writeConcern.wDeadline);
+        ASSERT_EQUALS(writeConcern.wDeadline, getNet()->now());
+    }
+    ASSERT_EQUALS(ErrorCodes::WriteConcernFailed, future.getNoThrow());
+}
+
+TEST_F(ReplCoordTest, AwaitReplicationAsyncReturnsPrimarySteppedDownWhenTheNodeStepsDown) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version"
+                            << 2
+                            << "members"
+                            << BSON_ARRAY(BSON("_id" << 0 << "host"
+                                                     << "node1:12345")
+                                          << BSON("_id" << 1 << "host"
+                                                        << "node2:12345")
+                                          << BSON("_id" << 2 << "host"
+                                                        << "node3:12345"))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    getReplCoord()->setMyLastAppliedOpTime(OpTimeWithTermOne(100, 1));
+    getReplCoord()->setMyLastDurableOpTime(OpTimeWithTermOne(100, 1));
+    simulateSuccessfulV1Election();
+
+    const auto opCtx = makeOperationContext();
+
+    WriteConcernOptions writeConcern;
+    writeConcern.wTimeout = WriteConcernOptions::kNoTimeout;
+    writeConcern.wNumNodes = 2;
+
+    auto future = getReplCoord()->awaitReplicationAsync(OpTimeWithTermOne(100, 2), writeConcern);
+    getReplCoord()->stepDown(opCtx.get(), true, Milliseconds(0), Milliseconds(1000));
+    ASSERT_EQUALS(ErrorCodes::PrimarySteppedDown, future.getNoThrow());
+
+    // A node which is no longer primary does not start waiting.
+    auto afterStepDown =
+        getReplCoord()->awaitReplicationAsync(OpTimeWithTermOne(100, 2), writeConcern);
+    ASSERT_EQUALS(ErrorCodes::PrimarySteppedDown, afterStepDown.getNoThrow());
+}
+
+TEST_F(ReplCoordTest, AwaitReplicationAsyncReturnsShutdownInProgressWhenTheNodeShutsDown) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version"
+                            << 2
+                            << "members"
+                            << BSON_ARRAY(BSON("_id" << 0 << "host"
+                                                     << "node1:12345")
+                                          << BSON("_id" << 1 << "host"
+                                                        << "node2:12345")
+                                          << BSON("_id" << 2 << "host"
+                                                        << "node3:12345"))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    getReplCoord()->setMyLastAppliedOpTime(OpTimeWithTermOne(100, 1));
+    getReplCoord()->setMyLastDurableOpTime(OpTimeWithTermOne(100, 1));
+    simulateSuccessfulV1Election();
+
+    WriteConcernOptions writeConcern;
+    writeConcern.wTimeout = WriteConcernOptions::kNoTimeout;
+    writeConcern.wNumNodes = 2;
+
+    auto future = getReplCoord()->awaitReplicationAsync(OpTimeWithTermOne(100, 2), writeConcern);
+    {
+        auto opCtx = makeOperationContext();
+        shutdown(opCtx.get());
+    }
+    ASSERT_EQUALS(ErrorCodes::ShutdownInProgress, future.getNoThrow());
+}
+
 TEST_F(ReplCoordTest,
        NodeReturnsInterruptedWhenAnOpWaitingForWriteConcernToBeSatisfiedIsInterrupted) {
     // Tests that a thread blocked in awaitReplication can be killed by a killOp operation
@@ -113,6 +113,11 @@ ReplicationCoordinator::StatusAndDuration ReplicationCoordinatorMock::awaitRepli
     return _awaitReplicationReturnValueFunction(opTime);
 }
 
+Future<void> ReplicationCoordinatorMock::awaitReplicationAsync(
+    const OpTime& opTime, const WriteConcernOptions& writeConcern) {
+    return Future<void>::makeReady(_awaitReplicationReturnValueFunction(opTime).status);
+}
+
 void ReplicationCoordinatorMock::setAwaitReplicationReturnValueFunction(
     AwaitReplicationReturnValueFunction returnValueFunction) {
     _awaitReplicationReturnValueFunction = std::move(returnValueFunction);
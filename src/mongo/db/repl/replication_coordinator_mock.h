@@ -85,6 +85,9 @@ public:
     virtual ReplicationCoordinator::StatusAndDuration awaitReplication(
         OperationContext* opCtx, const OpTime& opTime, const WriteConcernOptions& writeConcern);
 
+    Future<void> awaitReplicationAsync(const OpTime& opTime,
+                                       const WriteConcernOptions& writeConcern) override;
+
     void stepDown(OperationContext* opCtx,
                   bool force,
                   const Milliseconds& waitTime,
@@ -34,6 +34,7 @@
 
 #include "mongo/client/connpool.h"
 #include "mongo/client/dbclient_connection.h"
+#include "mongo/db/auth/sasl_command_constants.h"
 #include "mongo/db/auth/sasl_mechanism_registry.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands/server_status.h"
@@ -209,6 +210,9 @@ public:
     AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
         return AllowedOnSecondary::kAlways;
     }
+    StringData sensitiveFieldName() const final {
+        return saslCommandSpeculativeAuthenticateFieldName;
+    }
     std::string help() const override {
         return "Check if this server is primary for a replica set\n"
                "{ isMaster : 1 }";
@@ -376,6 +380,7 @@ public:
 
         auto& saslMechanismRegistry = SASLServerMechanismRegistry::get(opCtx->getServiceContext());
         saslMechanismRegistry.advertiseMechanismNamesForUser(opCtx, cmdObj, &result);
+        speculativeSaslStart(opCtx, cmdObj, &result);
 
         return true;
     }
@@ -33,6 +33,8 @@
 
 #include "mongo/db/repl/replication_recovery.h"
 
+#include <algorithm>
+
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
@@ -54,11 +56,18 @@ namespace {
 const auto kRecoveryBatchLogLevel = logger::LogSeverity::Debug(2);
 const auto kRecoveryOperationLogLevel = logger::LogSeverity::Debug(3);
 
+// How often the progress of replaying the oplog is logged.
+const Seconds kRecoveryProgressLogInterval{10};
+
 /**
  * Tracks and logs operations applied during recovery.
  */
 class RecoveryOplogApplierStats : public OplogApplier::Observer {
 public:
+    RecoveryOplogApplierStats(const Timestamp& oplogApplicationStartPoint,
+                              const Timestamp& topOfOplog)
+        : _oplogApplicationStartPoint(oplogApplicationStartPoint), _topOfOplog(topOfOplog) {}
+
     void onBatchBegin(const OplogApplier::Operations& batch) final {
         _numBatches++;
         LOG_FOR_RECOVERY(kRecoveryBatchLogLevel)
@@ -80,18 +89,53 @@ public:
         }
     }
 
-    void onBatchEnd(const StatusWith<OpTime>&, const OplogApplier::Operations&) final {}
+    void onBatchEnd(const StatusWith<OpTime>& lastOpTimeApplied,
+                    const OplogApplier::Operations&) final {
+        if (!lastOpTimeApplied.isOK() || _progressTimer.elapsed() < kRecoveryProgressLogInterval) {
+            return;
+        }
+        _progressTimer.reset();
+
+        // The oplog is assumed to have been written at a steady rate, so the share of the time
+        // between the start point and the top of the oplog that has been replayed estimates the
+        // progress of recovery.
+        const auto appliedThrough = lastOpTimeApplied.getValue().getTimestamp();
+        const double secsApplied = appliedThrough.getSecs() - _oplogApplicationStartPoint.getSecs();
+        const double secsTotal = _topOfOplog.getSecs() - _oplogApplicationStartPoint.getSecs();
+
+        StringBuilder progress;
+        progress << "Replication recovery applied " << _numOpsApplied << " operations in "
+                 << _numBatches << " batches through " << appliedThrough.toString()
+                 << " of " << _topOfOplog.toString() << " in " << _totalTimer.seconds()
+                 << " seconds";
+        if (secsApplied > 0 && secsTotal > 0) {
+            const double fraction = std::min(secsApplied / secsTotal, 1.0);
+            const auto secsRemaining =
+                static_cast<long long>(_totalTimer.seconds() * (1 - fraction) / fraction);
+            progress << " (" << static_cast<int>(fraction * 100) << "%, about " << secsRemaining
+                     << " seconds remaining)";
+        }
+        log() << progress.str();
+    }
+
     void onMissingDocumentsFetchedAndInserted(const std::vector<FetchInfo>&) final {}
 
     void complete(const OpTime& applyThroughOpTime) const {
-        LOG_FOR_RECOVERY(kRecoveryBatchLogLevel)
-            << "Applied " << _numOpsApplied << " operations in " << _numBatches
-            << " batches. Last operation applied with optime: " << applyThroughOpTime;
+        log() << "Replication recovery applied " << _numOpsApplied << " operations in "
+              << _numBatches << " batches in " << _totalTimer.millis()
+              << "ms. Last operation applied with optime: " << applyThroughOpTime;
     }
 
 private:
+    const Timestamp _oplogApplicationStartPoint;
+    const Timestamp _topOfOplog;
+
     std::size_t _numBatches = 0;
     std::size_t _numOpsApplied = 0;
+
+    // Measures the time spent replaying the oplog and the time since progress was last logged.
+    Timer _totalTimer;
+    Timer _progressTimer;
 };
 
 /**
@@ -364,7 +408,9 @@ void ReplicationRecoveryImpl::_applyToEndOfOplog(OperationContext* opCtx,
     OplogBufferLocalOplog oplogBuffer(oplogApplicationStartPoint);
     oplogBuffer.startup(opCtx);
 
-    RecoveryOplogApplierStats stats;
+    // The operations are replayed in parallel by the writer pool, in batches of the same size as
+    // on a secondary.
+    RecoveryOplogApplierStats stats(oplogApplicationStartPoint, topOfOplog);
 
     auto writerPool = OplogApplier::makeWriterPool();
     OplogApplier::Options options;
@@ -28,15 +28,18 @@
 
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/status_with.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/util/net/hostandport.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
 
-class NamespaceString;
 class OperationContext;
 
 namespace repl {
@@ -88,6 +91,27 @@ public:
                                                               UUID uuid,
                                                               const BSONObj& filter) const = 0;
 
+    /**
+     * Fetches the documents whose _id is one of 'ids' from the sync source using the UUID. Ids that
+     * match no document are absent from the result, which is in no particular order. Returns the
+     * namespace matching the UUID on the sync source as well.
+     *
+     * The default implementation issues one findOneByUUID() per id; sources that can evaluate an
+     * $in query remotely should override it to save the round trips.
+     */
+    virtual std::pair<std::vector<BSONObj>, NamespaceString> findByUUID(
+        const std::string& db, UUID uuid, const std::vector<BSONElement>& ids) const {
+        std::pair<std::vector<BSONObj>, NamespaceString> result;
+        for (auto&& id : ids) {
+            auto docAndNss = findOneByUUID(db, uuid, id.wrap());
+            if (!docAndNss.first.isEmpty()) {
+                result.first.push_back(std::move(docAndNss.first));
+            }
+            result.second = std::move(docAndNss.second);
+        }
+        return result;
+    }
+
     /**
      * Clones a single collection from the sync source.
      */
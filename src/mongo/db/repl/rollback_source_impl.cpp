@@ -34,6 +34,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/repl/oplogreader.h"
+#include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/mongoutils/str.h"
 
@@ -79,6 +80,57 @@ std::pair<BSONObj, NamespaceString> RollbackSourceImpl::findOneByUUID(const std:
     return _getConnection()->findOneByUUID(db, uuid, filter);
 }
 
+std::pair<std::vector<BSONObj>, NamespaceString> RollbackSourceImpl::findByUUID(
+    const std::string& db, UUID uuid, const std::vector<BSONElement>& ids) const {
+    BSONObjBuilder cmdBuilder;
+    uuid.appendToBuilder(&cmdBuilder, "find");
+    {
+        BSONObjBuilder filterBuilder(cmdBuilder.subobjStart("filter"));
+        BSONObjBuilder idBuilder(filterBuilder.subobjStart("_id"));
+        BSONArrayBuilder inBuilder(idBuilder.subarrayStart("$in"));
+        for (auto&& id : ids) {
+            inBuilder.append(id);
+        }
+    }
+    // Asks for every match in the first batch; the server still cuts a batch off at the maximum
+    // reply size, in which case the rest is drained with getMore.
+    cmdBuilder.append("batchSize", static_cast<long long>(ids.size()));
+    BSONObj cmd = cmdBuilder.obj();
+
+    auto conn = _getConnection();
+    std::vector<BSONObj> docs;
+    BSONObj res;
+    if (!conn->runCommand(db, cmd, res, QueryOption_SlaveOk)) {
+        uassertStatusOKWithContext(getStatusFromCommandResult(res),
+                                   str::stream() << "find command using UUID failed. Command: "
+                                                 << cmd);
+    }
+
+    BSONObj cursorObj = res.getObjectField("cursor");
+    NamespaceString resNss(cursorObj["ns"].valueStringData());
+    long long cursorId = cursorObj["id"].safeNumberLong();
+    StringData batchField = "firstBatch"_sd;
+    while (true) {
+        for (auto&& doc : cursorObj.getObjectField(batchField)) {
+            docs.push_back(doc.Obj().getOwned());
+        }
+        if (cursorId == 0) {
+            break;
+        }
+
+        BSONObj getMoreCmd = BSON("getMore" << cursorId << "collection" << resNss.coll());
+        if (!conn->runCommand(db, getMoreCmd, res, QueryOption_SlaveOk)) {
+            uassertStatusOKWithContext(getStatusFromCommandResult(res),
+                                       str::stream() << "getMore command failed. Command: "
+                                                     << getMoreCmd);
+        }
+        cursorObj = res.getObjectField("cursor");
+        cursorId = cursorObj["id"].safeNumberLong();
+        batchField = "nextBatch"_sd;
+    }
+    return {std::move(docs), std::move(resNss)};
+}
+
 void RollbackSourceImpl::copyCollectionFromRemote(OperationContext* opCtx,
                                                   const NamespaceString& nss) const {
     std::string errmsg;
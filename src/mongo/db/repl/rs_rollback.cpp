@@ -69,6 +69,7 @@
 #include "mongo/db/repl/rollback_source.h"
 #include "mongo/db/repl/rslog.h"
 #include "mongo/db/s/shard_identity_rollback_notifier.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/session_catalog_mongod.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/util/exit.h"
@@ -580,6 +581,16 @@ Status rollback_internal::updateFixUpInfoFromLocalOplogEntry(FixUpInfo& fixUpInf
 
 namespace {
 
+// The number of documents refetched from the sync source with one query, and re-applied locally
+// in one WriteUnitOfWork, by the rollback via refetch algorithm.
+MONGO_EXPORT_SERVER_PARAMETER(rollbackRefetchBatchSize, int, 100)
+    ->withValidator([](const int& potentialNewValue) {
+        if (potentialNewValue < 1) {
+            return Status(ErrorCodes::BadValue, "rollbackRefetchBatchSize must be at least 1");
+        }
+        return Status::OK();
+    });
+
 /**
  * This must be called before making any changes to our local data and after fetching any
  * information from the upstream node. If any information is fetched from the upstream node after we
@@ -982,22 +993,55 @@ void rollback_internal::syncFixUp(OperationContext* opCtx,
 
     log() << "Starting refetching documents";
 
-    for (auto&& doc : fixUpInfo.docsToRefetch) {
-        invariant(!doc._id.eoo());  // This is checked when we insert to the set.
-
-        UUID uuid = doc.uuid;
+    const size_t refetchBatchSize = static_cast<size_t>(rollbackRefetchBatchSize.load());
+    const StringData::ComparatorInterface* stringComparator = nullptr;
+    BSONElementComparator idComparator(BSONElementComparator::FieldNamesMode::kIgnore,
+                                       stringComparator);
+
+    // Documents to refetch are ordered by UUID, so each batch is a run of ids in one collection
+    // that is fetched with a single $in query.
+    for (auto batchBegin = fixUpInfo.docsToRefetch.begin();
+         batchBegin != fixUpInfo.docsToRefetch.end();) {
+        UUID uuid = batchBegin->uuid;
         NamespaceString nss = catalog.lookupNSSByUUID(uuid);
 
+        auto batchEnd = batchBegin;
+        std::vector<BSONElement> ids;
+        for (; batchEnd != fixUpInfo.docsToRefetch.end() && batchEnd->uuid == uuid &&
+             ids.size() < refetchBatchSize;
+             ++batchEnd) {
+            invariant(!batchEnd->_id.eoo());  // This is checked when we insert to the set.
+
+            // $in cannot match these types by equality, so they are fetched on their own.
+            const auto idType = batchEnd->_id.type();
+            if (idType == BSONType::RegEx || idType == BSONType::Undefined) {
+                if (ids.empty()) {
+                    ids.push_back(batchEnd->_id);
+                    ++batchEnd;
+                }
+                break;
+            }
+            ids.push_back(batchEnd->_id);
+        }
+
         try {
-            LOG(2) << "Refetching document, collection: " << nss << ", UUID: " << uuid << ", "
-                   << redact(doc._id);
-            // TODO : Slow. Lots of round trips.
-            numFetched++;
+            LOG(2) << "Refetching " << ids.size() << " documents, collection: " << nss
+                   << ", UUID: " << uuid << ", first _id: " << redact(batchBegin->_id);
+            numFetched += ids.size();
 
-            BSONObj good;
+            std::vector<BSONObj> docs;
             NamespaceString resNss;
-            std::tie(good, resNss) =
-                rollbackSource.findOneByUUID(nss.db().toString(), uuid, doc._id.wrap());
+            if (ids.size() == 1) {
+                BSONObj good;
+                std::tie(good, resNss) =
+                    rollbackSource.findOneByUUID(nss.db().toString(), uuid, ids.front().wrap());
+                if (!good.isEmpty()) {
+                    docs.push_back(std::move(good));
+                }
+            } else {
+                std::tie(docs, resNss) =
+                    rollbackSource.findByUUID(nss.db().toString(), uuid, ids);
+            }
 
             // To prevent inconsistencies in the transactions collection, rollback fails if the UUID
             // of the collection is different on the sync source than on the node rolling back,
@@ -1014,7 +1058,11 @@ void rollback_internal::syncFixUp(OperationContext* opCtx,
                        "resync is required.");
             }
 
-            totalSize += good.objsize();
+            auto docsById = idComparator.makeBSONEltIndexedMap<BSONObj>();
+            for (auto&& good : docs) {
+                totalSize += good.objsize();
+                docsById.emplace(good["_id"], good);
+            }
 
             // Checks that the total amount of data that needs to be refetched is at most
             // 300 MB. We do not roll back more than 300 MB of documents in order to
@@ -1023,9 +1071,32 @@ void rollback_internal::syncFixUp(OperationContext* opCtx,
                 throw RSFatalException("replSet too much data to roll back.");
             }
 
-            // Note good might be empty, indicating we should delete it.
-            goodVersions[uuid].insert(std::pair<DocID, BSONObj>(doc, good));
+            std::vector<const DocID*> unmatched;
+            for (auto docIt = batchBegin; docIt != batchEnd; ++docIt) {
+                auto found = docsById.find(docIt->_id);
+                if (found == docsById.end()) {
+                    unmatched.push_back(&*docIt);
+                    continue;
+                }
+                goodVersions[uuid].insert(std::pair<DocID, BSONObj>(*docIt, found->second));
+                docsById.erase(found);
+            }
+
+            for (auto doc : unmatched) {
+                // Returned documents left over had an _id equal to one of ours only under the
+                // collection's collation, so these ids are resolved one at a time exactly as a
+                // single refetch would.
+                BSONObj good;
+                if (!docsById.empty()) {
+                    good =
+                        rollbackSource.findOneByUUID(nss.db().toString(), uuid, doc->_id.wrap())
+                            .first;
+                    totalSize += good.objsize();
+                }
 
+                // Note good might be empty, indicating we should delete it.
+                goodVersions[uuid].insert(std::pair<DocID, BSONObj>(*doc, good));
+            }
         } catch (const DBException& ex) {
             // If the collection turned into a view, we might get an error trying to
             // refetch documents, but these errors should be ignored, as we'll be creating
@@ -1034,14 +1105,17 @@ void rollback_internal::syncFixUp(OperationContext* opCtx,
             // oplog replay. So it is safe to ignore NamespaceNotFound errors while trying to
             // refetch documents.
             if (ex.code() == ErrorCodes::CommandNotSupportedOnView ||
-                ex.code() == ErrorCodes::NamespaceNotFound)
+                ex.code() == ErrorCodes::NamespaceNotFound) {
+                batchBegin = batchEnd;
                 continue;
+            }
 
-            log() << "Rollback couldn't re-fetch from uuid: " << uuid << " _id: " << redact(doc._id)
-                  << ' ' << numFetched << '/' << fixUpInfo.docsToRefetch.size() << ": "
-                  << redact(ex);
+            log() << "Rollback couldn't re-fetch from uuid: " << uuid << " " << ids.size()
+                  << " documents starting at _id: " << redact(batchBegin->_id) << ' '
+                  << numFetched << '/' << fixUpInfo.docsToRefetch.size() << ": " << redact(ex);
             throw;
         }
+        batchBegin = batchEnd;
     }
 
     log() << "Finished refetching documents. Total size of documents refetched: "
@@ -1261,6 +1335,24 @@ void rollback_internal::syncFixUp(OperationContext* opCtx,
             removeSaver = std::make_unique<Helpers::RemoveSaver>("rollback", "", nss.ns());
         }
 
+        // Consecutive documents of a collection are re-applied under one database lock and
+        // client context and, unless the collection is capped, in one WriteUnitOfWork. These are
+        // declared in acquisition order so that they are released in reverse.
+        boost::optional<Lock::DBLock> docDbLock;
+        boost::optional<OldClientContext> ctx;
+        boost::optional<WriteUnitOfWork> wunit;
+        StringData batchNs;
+        size_t docsInBatch = 0;
+        auto commitBatch = [&] {
+            if (wunit) {
+                wunit->commit();
+                wunit = boost::none;
+            }
+            ctx = boost::none;
+            docDbLock = boost::none;
+            docsInBatch = 0;
+        };
+
         const auto& goodVersionsByDocID = nsAndGoodVersionsByDocID.second;
         for (const auto& idAndDoc : goodVersionsByDocID) {
             time_t now = time(0);
@@ -1274,10 +1366,20 @@ void rollback_internal::syncFixUp(OperationContext* opCtx,
             BSONObj pattern = doc._id.wrap();  // { _id : ... }
             try {
 
-                // TODO: Lots of overhead in context. This can be faster.
-                const NamespaceString docNss(doc.ns);
-                Lock::DBLock docDbLock(opCtx, docNss.db(), MODE_X);
-                OldClientContext ctx(opCtx, doc.ns.toString());
+                if (ctx && (docsInBatch >= refetchBatchSize || doc.ns != batchNs)) {
+                    commitBatch();
+                }
+                if (!ctx) {
+                    const NamespaceString docNss(doc.ns);
+                    docDbLock.emplace(opCtx, docNss.db(), MODE_X);
+                    ctx.emplace(opCtx, doc.ns.toString());
+                    batchNs = doc.ns;
+                    Collection* batchCollection = catalog.lookupCollectionByUUID(uuid);
+                    if (batchCollection && !batchCollection->isCapped()) {
+                        wunit.emplace(opCtx);
+                    }
+                }
+                docsInBatch++;
                 Collection* collection = catalog.lookupCollectionByUUID(uuid);
 
                 // Adds the doc to our rollback file if the collection was not dropped while
@@ -1392,7 +1494,7 @@ void rollback_internal::syncFixUp(OperationContext* opCtx,
                     UpdateLifecycleImpl updateLifecycle(nss);
                     request.setLifecycle(&updateLifecycle);
 
-                    update(opCtx, ctx.db(), request);
+                    update(opCtx, ctx->db(), request);
                 }
             } catch (const DBException& e) {
                 log() << "Exception in rollback ns:" << nss.ns() << ' ' << pattern.toString() << ' '
@@ -1400,6 +1502,7 @@ void rollback_internal::syncFixUp(OperationContext* opCtx,
                 throw;
             }
         }
+        commitBatch();
     }
 
     log() << "Rollback deleted " << deletes << " documents and updated " << updates
@@ -1761,6 +1761,76 @@ TEST_F(RSRollbackTest, RollbackApplyOpsCommand) {
         << result;
 }
 
+TEST_F(RSRollbackTest, RollbackRefetchesDocumentsOfOneCollectionWithOneQuery) {
+    createOplog(_opCtx.get());
+    CollectionOptions options;
+    options.uuid = UUID::gen();
+    auto coll = _createCollection(_opCtx.get(), "test.t", options);
+    auto commonOperation = makeOpAndRecordId(1, 1);
+    auto makeDeleteOperation = [&](int id) {
+        return std::make_pair(BSON("ts" << Timestamp(Seconds(id + 1), 0) << "h" << 1LL << "op"
+                                        << "d"
+                                        << "ui"
+                                        << coll->uuid().get()
+                                        << "ns"
+                                        << "test.t"
+                                        << "o"
+                                        << BSON("_id" << id)),
+                              RecordId(id + 1));
+    };
+
+    class RollbackSourceLocal : public RollbackSourceMock {
+    public:
+        RollbackSourceLocal(std::unique_ptr<OplogInterface> oplog)
+            : RollbackSourceMock(std::move(oplog)) {}
+
+        std::pair<BSONObj, NamespaceString> findOneByUUID(const std::string& db,
+                                                          UUID uuid,
+                                                          const BSONObj& filter) const override {
+            FAIL("Unexpected findOneByUUID request") << filter;
+            return {};
+        }
+
+        std::pair<std::vector<BSONObj>, NamespaceString> findByUUID(
+            const std::string& db, UUID uuid, const std::vector<BSONElement>& ids) const override {
+            ++numQueries;
+            for (auto&& id : ids) {
+                searchedIds.insert(id.numberInt());
+            }
+            // The document with _id 3 no longer exists on the sync source.
+            return {{BSON("_id" << 2 << "v" << 2), BSON("_id" << 1 << "v" << 1)},
+                    NamespaceString("test.t")};
+        }
+
+        mutable int numQueries = 0;
+        mutable std::multiset<int> searchedIds;
+    } rollbackSource(std::unique_ptr<OplogInterface>(new OplogInterfaceMock({commonOperation})));
+
+    ASSERT_OK(syncRollback(_opCtx.get(),
+                           OplogInterfaceMock({makeDeleteOperation(3),
+                                               makeDeleteOperation(2),
+                                               makeDeleteOperation(1),
+                                               commonOperation}),
+                           rollbackSource,
+                           {},
+                           _coordinator,
+                           _replicationProcess.get()));
+    ASSERT_EQUALS(1, rollbackSource.numQueries);
+    ASSERT_EQUALS(3U, rollbackSource.searchedIds.size());
+    ASSERT_EQUALS(1U, rollbackSource.searchedIds.count(1));
+    ASSERT_EQUALS(1U, rollbackSource.searchedIds.count(2));
+    ASSERT_EQUALS(1U, rollbackSource.searchedIds.count(3));
+
+    AutoGetCollectionForReadCommand acr(_opCtx.get(), NamespaceString("test.t"));
+    BSONObj result;
+    ASSERT(Helpers::findOne(_opCtx.get(), acr.getCollection(), BSON("_id" << 1), result));
+    ASSERT_EQUALS(1, result["v"].numberInt()) << result;
+    ASSERT(Helpers::findOne(_opCtx.get(), acr.getCollection(), BSON("_id" << 2), result));
+    ASSERT_EQUALS(2, result["v"].numberInt()) << result;
+    ASSERT_FALSE(Helpers::findOne(_opCtx.get(), acr.getCollection(), BSON("_id" << 3), result))
+        << result;
+}
+
 TEST_F(RSRollbackTest, RollbackCreateCollectionCommand) {
     createOplog(_opCtx.get());
     CollectionOptions options;
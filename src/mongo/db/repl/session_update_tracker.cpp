@@ -122,6 +122,12 @@ void SessionUpdateTracker::_updateSessionInfo(const OplogEntry& entry) {
         return;
     }
 
+    // The transaction table is only updated once the final entry of a transaction which was split
+    // across several oplog entries is seen.
+    if (entry.isPartialTransaction()) {
+        return;
+    }
+
     auto lsid = sessionInfo.getSessionId();
     fassert(50842, lsid.is_initialized());
 
@@ -1012,6 +1012,45 @@ BSONObj _assertGetFront(const StatusWith<std::vector<BSONObj>>& statusWithDocs)
     return docs.front();
 }
 
+TEST_F(StorageInterfaceImplTest, InsertDocumentsBatchMaintainsSecondaryAndMultikeyIndexes) {
+    auto opCtx = getOperationContext();
+    StorageInterfaceImpl storage;
+    auto nss = makeNamespace(_agent);
+    ASSERT_OK(storage.createCollection(opCtx, nss, generateOptionsWithUuid()));
+
+    auto indexName = "x_-1"_sd;
+    auto indexSpec = BSON("name" << indexName << "ns" << nss.ns() << "key" << BSON("x" << -1)
+                                 << "v"
+                                 << static_cast<int>(kIndexVersion));
+    ASSERT_EQUALS(createIndexForColl(opCtx, nss, indexSpec), 2);
+
+    // All documents share a null timestamp, so their index keys are inserted as one sorted batch.
+    // The multikey document is returned once, for its largest key.
+    const auto multikeyDoc = BSON("_id" << 2 << "x" << BSON_ARRAY(1 << 4));
+    ASSERT_OK(storage.insertDocuments(opCtx,
+                                      nss,
+                                      transformInserts({BSON("_id" << 0 << "x" << 2),
+                                                        BSON("_id" << 1 << "x" << 5),
+                                                        multikeyDoc,
+                                                        BSON("_id" << 3 << "x" << 3)})));
+
+    _assertDocumentsEqual(storage.findDocuments(opCtx,
+                                                nss,
+                                                indexName,
+                                                StorageInterface::ScanDirection::kForward,
+                                                {},
+                                                BoundInclusion::kIncludeStartKeyOnly,
+                                                10U),
+                          {BSON("_id" << 1 << "x" << 5),
+                           multikeyDoc,
+                           BSON("_id" << 3 << "x" << 3),
+                           BSON("_id" << 0 << "x" << 2)});
+
+    AutoGetCollectionForReadCommand autoColl(opCtx, nss);
+    auto indexCatalog = autoColl.getCollection()->getIndexCatalog();
+    ASSERT(indexCatalog->isMultikey(opCtx, indexCatalog->findIndexByName(opCtx, indexName)));
+}
+
 TEST_F(StorageInterfaceImplTest,
        FindDocumentsReturnsDocumentWithLowestKeyValueIfScanDirectionIsForward) {
     auto opCtx = getOperationContext();
@@ -33,7 +33,10 @@
 #include "mongo/db/repl/sync_tail.h"
 
 #include "third_party/murmurhash3/MurmurHash3.h"
+#include <algorithm>
 #include <boost/functional/hash.hpp>
+#include <iterator>
+#include <map>
 #include <memory>
 
 #include "mongo/base/counter.h"
@@ -68,22 +71,29 @@
 #include "mongo/db/repl/repl_set_config.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/session_update_tracker.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/session.h"
 #include "mongo/db/session_txn_record_gen.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/db/storage/recovery_unit.h"
+#include "mongo/db/transaction_history_iterator.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/net/socket_exception.h"
+#include "mongo/util/timer.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
+
+MONGO_EXPORT_SERVER_PARAMETER(replWriterBalancedAssignment, bool, false);
+
 namespace {
 
 MONGO_FAIL_POINT_DEFINE(pauseBatchApplicationBeforeCompletion);
@@ -325,6 +335,50 @@ Status SyncTail::syncApply(OperationContext* opCtx,
     MONGO_UNREACHABLE;
 }
 
+Status SyncTail::syncApplyGroupedWrites(OperationContext* opCtx,
+                                        const std::vector<BSONObj>& ops,
+                                        OplogApplication::Mode oplogApplicationMode) {
+    invariant(!ops.empty());
+    CurOp individualOp(opCtx);
+
+    const NamespaceString nss(ops.front().getStringField("ns"));
+    const bool shouldAlwaysUpsert = (oplogApplicationMode != OplogApplication::Mode::kInitialSync);
+
+    return writeConflictRetry(opCtx, "syncApply_groupedWrites", nss.ns(), [&] {
+        AutoGetCollection autoColl(opCtx, getNsOrUUID(nss, ops.front()), MODE_IX);
+        auto db = autoColl.getDb();
+        uassert(ErrorCodes::NamespaceNotFound,
+                str::stream() << "missing database (" << nss.db() << ")",
+                db);
+        OldClientContext ctx(opCtx, autoColl.getNss().ns(), db);
+        UnreplicatedWritesBlock uwb(opCtx);
+        DisableDocumentValidation validationDisabler(opCtx);
+
+        // Only count the ops once the group commits, since a failed group is applied again one op
+        // at a time.
+        size_t numApplied = 0;
+        WriteUnitOfWork wuow(opCtx);
+        for (auto&& op : ops) {
+            Status status = applyOperation_inlock(opCtx,
+                                                  ctx.db(),
+                                                  op,
+                                                  shouldAlwaysUpsert,
+                                                  oplogApplicationMode,
+                                                  [&numApplied] { ++numApplied; },
+                                                  true);
+            if (!status.isOK()) {
+                if (status.code() == ErrorCodes::WriteConflict) {
+                    throw WriteConflictException();
+                }
+                return status;
+            }
+        }
+        wuow.commit();
+        opsAppliedStats.increment(numApplied);
+        return Status::OK();
+    });
+}
+
 SyncTail::SyncTail(OplogApplier::Observer* observer,
                    ReplicationConsistencyMarkers* consistencyMarkers,
                    StorageInterface* storageInterface,
@@ -351,6 +405,11 @@ const OplogApplier::Options& SyncTail::getOptions() const {
     return _options;
 }
 
+SyncTail::BatchPhaseTimings SyncTail::getBatchPhaseTimings() const {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    return _batchPhaseTimings;
+}
+
 namespace {
 
 // Doles out all the work to the writer pool threads.
@@ -484,10 +543,94 @@ private:
     StringMap<CollectionProperties> _cache;
 };
 
+/**
+ * Picks the writer thread for each op in a batch from the hash of what the op conflicts with: its
+ * namespace, and its _id where documents can be written concurrently. Ops with equal hashes must
+ * be applied in order, so they always share a writer.
+ *
+ * By default the writer is the hash modulo the number of writers. With
+ * replWriterBalancedAssignment, each hash seen for the first time in the batch instead goes to the
+ * writer with the fewest ops so far, so that unrelated ops whose hashes happen to share a residue
+ * don't queue up behind each other while other writers are idle.
+ */
+class WriterAssignment {
+public:
+    explicit WriterAssignment(uint32_t numWriters)
+        : _numWriters(numWriters),
+          _balanced(replWriterBalancedAssignment.load()),
+          _opCounts(_balanced ? numWriters : 0, 0) {}
+
+    uint32_t getWriter(uint32_t hash) {
+        if (!_balanced) {
+            return hash % _numWriters;
+        }
+
+        auto it = _writersByHash.find(hash);
+        if (it == _writersByHash.end()) {
+            auto leastLoaded = std::min_element(_opCounts.begin(), _opCounts.end());
+            it = _writersByHash.emplace(hash, leastLoaded - _opCounts.begin()).first;
+        }
+        ++_opCounts[it->second];
+        return it->second;
+    }
+
+private:
+    const uint32_t _numWriters;
+    const bool _balanced;
+
+    // Number of ops given to each writer in this batch. Only used when balancing.
+    std::vector<size_t> _opCounts;
+    stdx::unordered_map<uint32_t, uint32_t> _writersByHash;
+};
+
+/**
+ * Returns the operations of the transaction whose final applyOps entry is 'op', oldest first. The
+ * leading entries of a transaction that was split across several oplog entries are looked up in
+ * 'partialTxnOps' when they are part of the current batch, and are otherwise read back from the
+ * oplog, which earlier batches have already been written to. Every operation is applied at the
+ * opTime of the final entry, so that the transaction becomes visible all at once.
+ */
+MultiApplier::Operations extractTransactionOperations(
+    OperationContext* opCtx,
+    const OplogEntry& op,
+    const std::map<OpTime, const OplogEntry*>& partialTxnOps) {
+    const auto prevOpTime = op.getPrevWriteOpTimeInTransaction();
+    if (!op.getTxnNumber() || !prevOpTime || prevOpTime->isNull()) {
+        return ApplyOps::extractOperations(op);
+    }
+
+    // Walk the chain back to its first entry.
+    std::vector<OplogEntry> chain;
+    auto nextOpTime = *prevOpTime;
+    while (!nextOpTime.isNull()) {
+        auto it = partialTxnOps.find(nextOpTime);
+        auto entry = it != partialTxnOps.end()
+            ? *it->second
+            : TransactionHistoryIterator(nextOpTime).next(opCtx);
+        uassert(ErrorCodes::IncompleteTransactionHistory,
+                str::stream() << "oplog entry " << nextOpTime.toBSON()
+                              << " of a transaction is not a partial applyOps entry",
+                entry.isPartialTransaction());
+        nextOpTime = entry.getPrevWriteOpTimeInTransaction().value_or(OpTime());
+        chain.push_back(std::move(entry));
+    }
+
+    MultiApplier::Operations operations;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        auto partialOps = ApplyOps::extractOperations(*it, op);
+        std::move(partialOps.begin(), partialOps.end(), std::back_inserter(operations));
+    }
+    auto finalOps = ApplyOps::extractOperations(op);
+    std::move(finalOps.begin(), finalOps.end(), std::back_inserter(operations));
+    return operations;
+}
+
 /**
  * ops - This only modifies the isForCappedCollection field on each op. It does not alter the ops
  *      vector in any other way.
  * writerVectors - Set of operations for each worker thread to apply.
+ * writerAssignment - Chooses the writer for each op. Shared by all ops in the batch, including
+ *      derived ones, so that conflicting ops end up on the same writer.
  * derivedOps - If provided, this function inserts a decomposition of applyOps operations
  *      and instructions for updating the transactions table.
  * sessionUpdateTracker - if provided, keeps track of session info from ops.
@@ -495,16 +638,20 @@ private:
 void fillWriterVectors(OperationContext* opCtx,
                        MultiApplier::Operations* ops,
                        std::vector<MultiApplier::OperationPtrs>* writerVectors,
+                       WriterAssignment* writerAssignment,
                        std::vector<MultiApplier::Operations>* derivedOps,
                        SessionUpdateTracker* sessionUpdateTracker) {
     const auto serviceContext = opCtx->getServiceContext();
     const auto storageEngine = serviceContext->getStorageEngine();
 
     const bool supportsDocLocking = storageEngine->supportsDocLocking();
-    const uint32_t numWriters = writerVectors->size();
 
     CachedCollectionProperties collPropertiesCache;
 
+    // Leading entries of transactions split across several oplog entries, which are applied along
+    // with the final entry of their transaction.
+    std::map<OpTime, const OplogEntry*> partialTxnOps;
+
     for (auto&& op : *ops) {
         StringMapTraits::HashedKey hashedNs(op.getNss().ns());
         uint32_t hash = hashedNs.hash();
@@ -514,7 +661,12 @@ void fillWriterVectors(OperationContext* opCtx,
         if (sessionUpdateTracker) {
             if (auto newOplogWrites = sessionUpdateTracker->updateOrFlush(op)) {
                 derivedOps->emplace_back(std::move(*newOplogWrites));
-                fillWriterVectors(opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+                fillWriterVectors(opCtx,
+                                  &derivedOps->back(),
+                                  writerVectors,
+                                  writerAssignment,
+                                  derivedOps,
+                                  nullptr);
             }
         }
 
@@ -544,11 +696,21 @@ void fillWriterVectors(OperationContext* opCtx,
         // Extract applyOps operations and fill writers with extracted operations using this
         // function.
         if (op.getCommandType() == OplogEntry::CommandType::kApplyOps && !op.shouldPrepare()) {
+            if (op.isPartialTransaction()) {
+                partialTxnOps.emplace(op.getOpTime(), &op);
+                continue;
+            }
+
             try {
-                derivedOps->emplace_back(ApplyOps::extractOperations(op));
+                derivedOps->emplace_back(extractTransactionOperations(opCtx, op, partialTxnOps));
 
                 // Nested entries cannot have different session updates.
-                fillWriterVectors(opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+                fillWriterVectors(opCtx,
+                                  &derivedOps->back(),
+                                  writerVectors,
+                                  writerAssignment,
+                                  derivedOps,
+                                  nullptr);
             } catch (...) {
                 fassertFailedWithStatusNoTrace(
                     50711,
@@ -559,7 +721,7 @@ void fillWriterVectors(OperationContext* opCtx,
             continue;
         }
 
-        auto& writer = (*writerVectors)[hash % numWriters];
+        auto& writer = (*writerVectors)[writerAssignment->getWriter(hash)];
         if (writer.empty()) {
             writer.reserve(8);  // Skip a few growth rounds
         }
@@ -572,12 +734,15 @@ void fillWriterVectors(OperationContext* opCtx,
                        std::vector<MultiApplier::OperationPtrs>* writerVectors,
                        std::vector<MultiApplier::Operations>* derivedOps) {
     SessionUpdateTracker sessionUpdateTracker;
-    fillWriterVectors(opCtx, ops, writerVectors, derivedOps, &sessionUpdateTracker);
+    WriterAssignment writerAssignment(writerVectors->size());
+    fillWriterVectors(
+        opCtx, ops, writerVectors, &writerAssignment, derivedOps, &sessionUpdateTracker);
 
     auto newOplogWrites = sessionUpdateTracker.flushAll();
     if (!newOplogWrites.empty()) {
         derivedOps->emplace_back(std::move(newOplogWrites));
-        fillWriterVectors(opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+        fillWriterVectors(
+            opCtx, &derivedOps->back(), writerVectors, &writerAssignment, derivedOps, nullptr);
     }
 }
 
@@ -1156,6 +1321,7 @@ Status multiSyncApply(OperationContext* opCtx,
                : OplogApplication::Mode::kSecondary);
 
     ApplierHelpers::InsertGroup insertGroup(ops, opCtx, oplogApplicationMode);
+    ApplierHelpers::WriteGroup writeGroup(ops, opCtx, oplogApplicationMode);
 
     {  // Ensure that the MultikeyPathTracker stops tracking paths.
         ON_BLOCK_EXIT([opCtx] { MultikeyPathTracker::get(opCtx).stopTrackingMultikeyPathInfo(); });
@@ -1172,6 +1338,13 @@ Status multiSyncApply(OperationContext* opCtx,
                 continue;
             }
 
+            // Likewise for a run of updates and deletes.
+            groupResult = writeGroup.groupAndApplyWrites(it);
+            if (groupResult.isOK()) {
+                it = groupResult.getValue();
+                continue;
+            }
+
             // If we didn't create a group, try to apply the op individually.
             try {
                 // The write on transaction table may be applied concurrently, so refreshing state
@@ -1249,6 +1422,7 @@ StatusWith<OpTime> SyncTail::multiApply(OperationContext* opCtx, MultiApplier::O
     }
 
     std::vector<WorkerMultikeyPathInfo> multikeyVector(_writerPool->getStats().numThreads);
+    BatchPhaseTimings phaseTimings;
     {
         // Each node records cumulative batch application stats for itself using this timer.
         TimerHolder timer(&applyBatchStats);
@@ -1284,6 +1458,7 @@ StatusWith<OpTime> SyncTail::multiApply(OperationContext* opCtx, MultiApplier::O
         });
 
         // Write batch of ops into oplog.
+        Timer writeOplogTimer;
         if (!_options.skipWritesToOplog) {
             _consistencyMarkers->setOplogTruncateAfterPoint(opCtx, ops.front().getTimestamp());
             scheduleWritesToOplog(opCtx, _storageInterface, _writerPool, ops);
@@ -1299,10 +1474,13 @@ StatusWith<OpTime> SyncTail::multiApply(OperationContext* opCtx, MultiApplier::O
         std::vector<MultiApplier::Operations> derivedOps;
 
         std::vector<MultiApplier::OperationPtrs> writerVectors(_writerPool->getStats().numThreads);
+        Timer fillWriterVectorsTimer;
         fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
+        phaseTimings.fillWriterVectors = Microseconds(fillWriterVectorsTimer.micros());
 
         // Wait for writes to finish before applying ops.
         _writerPool->waitForIdle();
+        phaseTimings.writeOplog = Microseconds(writeOplogTimer.micros());
 
         // Reset consistency markers in case the node fails while applying ops.
         if (!_options.skipWritesToOplog) {
@@ -1312,8 +1490,10 @@ StatusWith<OpTime> SyncTail::multiApply(OperationContext* opCtx, MultiApplier::O
 
         {
             std::vector<Status> statusVector(_writerPool->getStats().numThreads, Status::OK());
+            Timer applyOpsTimer;
             applyOps(writerVectors, _writerPool, _applyFunc, this, &statusVector, &multikeyVector);
             _writerPool->waitForIdle();
+            phaseTimings.applyOps = Microseconds(applyOpsTimer.micros());
 
             // If any of the statuses is not ok, return error.
             for (auto it = statusVector.cbegin(); it != statusVector.cend(); ++it) {
@@ -1366,6 +1546,14 @@ StatusWith<OpTime> SyncTail::multiApply(OperationContext* opCtx, MultiApplier::O
         }
     }
 
+    {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        ++_batchPhaseTimings.batches;
+        _batchPhaseTimings.writeOplog += phaseTimings.writeOplog;
+        _batchPhaseTimings.fillWriterVectors += phaseTimings.fillWriterVectors;
+        _batchPhaseTimings.applyOps += phaseTimings.applyOps;
+    }
+
     // We have now written all database writes and updated the oplog to match.
     return ops.back().getOpTime();
 }
@@ -40,9 +40,11 @@
 #include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/repl/replication_consistency_markers.h"
 #include "mongo/db/repl/storage_interface.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/functional.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
@@ -54,6 +56,10 @@ namespace repl {
 class ReplicationCoordinator;
 class OpTime;
 
+// Assigns the ops of a batch to writer threads by load instead of by hash alone. See
+// WriterAssignment in sync_tail.cpp.
+extern AtomicBool replWriterBalancedAssignment;
+
 /**
  * Used for oplog application on a replica set secondary.
  * Primarily used to apply batches of operations fetched from a sync source during steady state
@@ -79,6 +85,14 @@ public:
                             const BSONObj& o,
                             OplogApplication::Mode oplogApplicationMode);
 
+    /**
+     * Applies consecutive update and delete operations on the same namespace in a single
+     * WriteUnitOfWork, each with its own timestamp. If any of them fails, none are applied.
+     */
+    static Status syncApplyGroupedWrites(OperationContext* opCtx,
+                                         const std::vector<BSONObj>& ops,
+                                         OplogApplication::Mode oplogApplicationMode);
+
     /**
      *
      * Constructs a SyncTail.
@@ -106,6 +120,23 @@ public:
      */
     const OplogApplier::Options& getOptions() const;
 
+    /**
+     * Cumulative wall clock time spent by multiApply() in each phase of batch application.
+     * The oplog write runs on the writer pool while fillWriterVectors() partitions the batch, so
+     * 'writeOplog' and 'fillWriterVectors' overlap.
+     */
+    struct BatchPhaseTimings {
+        long long batches = 0;
+        Microseconds writeOplog{0};
+        Microseconds fillWriterVectors{0};
+        Microseconds applyOps{0};
+    };
+
+    /**
+     * Returns the time spent in each phase of the batches applied by this SyncTail so far.
+     */
+    BatchPhaseTimings getBatchPhaseTimings() const;
+
     /**
      * Runs oplog application in a loop until shutdown() is called.
      * Retrieves operations from the OplogBuffer in batches that will be applied in parallel using
@@ -267,6 +298,9 @@ private:
 
     // Set to true if shutdown() has been called.
     bool _inShutdown = false;
+
+    // Updated by multiApply() after each batch. Guarded by _mutex.
+    BatchPhaseTimings _batchPhaseTimings;
 };
 
 // This free function is used by the thread pool workers to write ops to the db.
@@ -0,0 +1,491 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/catalog/uuid_catalog.h"
+#include "mongo/db/client.h"
+#include "mongo/db/logical_clock.h"
+#include "mongo/db/op_observer_registry.h"
+#include "mongo/db/repl/drop_pending_collection_reaper.h"
+#include "mongo/db/repl/oplog.h"
+#include "mongo/db/repl/oplog_entry.h"
+#include "mongo/db/repl/replication_consistency_markers_mock.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/repl/storage_interface_impl.h"
+#include "mongo/db/repl/sync_tail.h"
+#include "mongo/db/server_options.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_engine_init.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/platform/random.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/mock_periodic_runner_impl.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+// Matches the default value of replBatchLimitOperations.
+const int kBatchSize = 5000;
+
+// Size of the unindexed string field in each synthetic document.
+const int kPayloadSize = 100;
+
+/**
+ * A storage engine can only be started once per service context, so every benchmark in this file
+ * shares one, along with the replication machinery multiApply() needs. WiredTiger is used when it
+ * is part of the build. The environment lives until the process exits.
+ */
+class SyncTailBenchmarkEnvironment {
+public:
+    static SyncTailBenchmarkEnvironment& get() {
+        static auto environment = new SyncTailBenchmarkEnvironment();
+        return *environment;
+    }
+
+    StorageInterface* getStorageInterface() {
+        return &_storageInterface;
+    }
+
+    ReplicationConsistencyMarkers* getConsistencyMarkers() {
+        return &_consistencyMarkers;
+    }
+
+    ThreadPool* getWriterPool() {
+        return _writerPool.get();
+    }
+
+    /**
+     * Returns a new optime, later than every optime returned so far.
+     */
+    OpTime nextOpTime() {
+        return OpTime(Timestamp(Seconds(1), ++_lastIncrement), 1LL);
+    }
+
+private:
+    SyncTailBenchmarkEnvironment() : _dbpath("sync_tail_bm") {
+        Client::initThreadIfNotAlready("SyncTailBenchmark");
+        auto service = getGlobalServiceContext();
+
+        storageGlobalParams.engine =
+            isRegisteredStorageEngine(service, "wiredTiger") ? "wiredTiger" : "ephemeralForTest";
+        storageGlobalParams.engineSetByUser = true;
+        storageGlobalParams.dbpath = _dbpath.path();
+
+        auto opObserverRegistry = stdx::make_unique<OpObserverRegistry>();
+        opObserverRegistry->addObserver(stdx::make_unique<UUIDCatalogObserver>());
+        service->setOpObserver(std::move(opObserverRegistry));
+        LogicalClock::set(service, stdx::make_unique<LogicalClock>(service));
+        service->setPeriodicRunner(stdx::make_unique<MockPeriodicRunnerImpl>());
+        initializeStorageEngine(service, StorageEngineInitFlags::kNone);
+
+        ReplicationCoordinator::set(service,
+                                    stdx::make_unique<ReplicationCoordinatorMock>(service));
+        DropPendingCollectionReaper::set(
+            service, stdx::make_unique<DropPendingCollectionReaper>(&_storageInterface));
+        serverGlobalParams.featureCompatibility.setVersion(
+            ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo42);
+
+        auto opCtx = cc().makeOperationContext();
+        uassertStatusOK(ReplicationCoordinator::get(opCtx.get())
+                            ->setFollowerMode(MemberState::RS_SECONDARY));
+        setOplogCollectionName(service);
+        createOplog(opCtx.get());
+
+        _writerPool = OplogApplier::makeWriterPool();
+    }
+
+    unittest::TempDir _dbpath;
+    StorageInterfaceImpl _storageInterface;
+    ReplicationConsistencyMarkersMock _consistencyMarkers;
+    std::unique_ptr<ThreadPool> _writerPool;
+    unsigned _lastIncrement = 0;
+};
+
+OplogEntry makeOplogEntry(OpTypeEnum opType,
+                          const NamespaceString& nss,
+                          const BSONObj& object,
+                          boost::optional<BSONObj> object2 = boost::none) {
+    return OplogEntry(SyncTailBenchmarkEnvironment::get().nextOpTime(),  // optime
+                      1LL,                                               // hash
+                      opType,                                            // opType
+                      nss,                                               // namespace
+                      boost::none,                                       // uuid
+                      boost::none,                                       // fromMigrate
+                      OplogEntry::kOplogVersion,                         // version
+                      object,                                            // o
+                      object2,                                           // o2
+                      {},                                                // sessionInfo
+                      boost::none,                                       // upsert
+                      Date_t::now(),                                     // wall clock time
+                      boost::none,                                       // statement id
+                      boost::none,   // optime of previous write within same transaction
+                      boost::none,   // pre-image optime
+                      boost::none);  // post-image optime
+}
+
+/**
+ * The update modifiers exercised by the update benchmarks.
+ */
+enum class UpdateKind { kSet, kInc, kUnset, kReplacement, kNumKinds };
+
+/**
+ * Generates oplog entries against 'numCollections' collections, each with 'numIndexes' secondary
+ * indexes, in a database of its own. Documents are spread round-robin across the collections and
+ * the _ids of the live documents always form the range [_firstLiveId, _nextId), so that updates
+ * and deletes always find the document they target.
+ */
+class SyntheticOplog {
+public:
+    SyntheticOplog(int numCollections, int numIndexes)
+        : _dbName(str::stream() << "sync_tail_bm_" << _nextDbId++),
+          _numCollections(numCollections),
+          _numIndexes(numIndexes) {}
+
+    /**
+     * Returns the create and createIndexes commands for the collections. Commands are applied as
+     * batches of their own.
+     */
+    std::vector<OplogEntry> makeCollections() const {
+        std::vector<OplogEntry> ops;
+        for (int i = 0; i < _numCollections; ++i) {
+            const auto nss = _nss(i);
+            ops.push_back(makeOplogEntry(
+                OpTypeEnum::kCommand, nss.getCommandNS(), BSON("create" << nss.coll())));
+            for (int j = 0; j < _numIndexes; ++j) {
+                const auto field = _indexedField(j);
+                ops.push_back(makeOplogEntry(OpTypeEnum::kCommand,
+                                             nss.getCommandNS(),
+                                             BSON("createIndexes" << nss.coll() << "v" << 2 << "key"
+                                                                  << BSON(field << 1)
+                                                                  << "name"
+                                                                  << (field + "_1"))));
+            }
+        }
+        return ops;
+    }
+
+    OplogEntry makeInsert() {
+        const auto id = _nextId++;
+        return makeOplogEntry(OpTypeEnum::kInsert, _nssForId(id), _makeDocument(id));
+    }
+
+    OplogEntry makeUpdate(UpdateKind kind) {
+        invariant(_firstLiveId < _nextId);
+        const auto id = _firstLiveId + _random.nextInt64(_nextId - _firstLiveId);
+        const auto field = _indexedField(_random.nextInt32(std::max(_numIndexes, 1)));
+
+        BSONObj update;
+        switch (kind) {
+            case UpdateKind::kSet:
+                update = BSON("$set" << BSON(field << _random.nextInt32()));
+                break;
+            case UpdateKind::kInc:
+                update = BSON("$inc" << BSON("counter" << 1));
+                break;
+            case UpdateKind::kUnset:
+                update = BSON("$unset" << BSON(field << true));
+                break;
+            case UpdateKind::kReplacement:
+                update = _makeDocument(id);
+                break;
+            case UpdateKind::kNumKinds:
+                MONGO_UNREACHABLE;
+        }
+        return makeOplogEntry(OpTypeEnum::kUpdate, _nssForId(id), update, BSON("_id" << id));
+    }
+
+    OplogEntry makeDelete() {
+        invariant(_firstLiveId < _nextId);
+        const auto id = _firstLiveId++;
+        return makeOplogEntry(OpTypeEnum::kDelete, _nssForId(id), BSON("_id" << id));
+    }
+
+    /**
+     * Returns an applyOps command wrapping 'numInserts' inserts, as written by a primary for a
+     * transaction.
+     */
+    OplogEntry makeApplyOps(int numInserts) {
+        BSONArrayBuilder operations;
+        for (int i = 0; i < numInserts; ++i) {
+            const auto id = _nextId++;
+            operations.append(BSON("op"
+                                   << "i"
+                                   << "ns"
+                                   << _nssForId(id).ns()
+                                   << "o"
+                                   << _makeDocument(id)));
+        }
+        return makeOplogEntry(OpTypeEnum::kCommand,
+                              NamespaceString(_dbName, "$cmd"),
+                              BSON("applyOps" << operations.arr()));
+    }
+
+    PseudoRandom& random() {
+        return _random;
+    }
+
+private:
+    NamespaceString _nss(int collection) const {
+        return NamespaceString(_dbName, str::stream() << "c" << collection);
+    }
+
+    NamespaceString _nssForId(long long id) const {
+        return _nss(id % _numCollections);
+    }
+
+    static std::string _indexedField(int index) {
+        return str::stream() << "f" << index;
+    }
+
+    BSONObj _makeDocument(long long id) {
+        BSONObjBuilder doc;
+        doc.append("_id", id);
+        for (int i = 0; i < std::max(_numIndexes, 1); ++i) {
+            doc.append(_indexedField(i), _random.nextInt32());
+        }
+        doc.append("counter", 0);
+        doc.append("payload", std::string(kPayloadSize, 'x'));
+        return doc.obj();
+    }
+
+    static int _nextDbId;
+
+    const std::string _dbName;
+    const int _numCollections;
+    const int _numIndexes;
+    PseudoRandom _random{1};
+    long long _firstLiveId = 0;
+    long long _nextId = 0;
+};
+
+int SyntheticOplog::_nextDbId = 0;
+
+/**
+ * Applies batches of synthetic oplog entries with SyncTail::multiApply(), the way a secondary
+ * applies the batches it fetches, and reports the time spent in each phase of application.
+ */
+class SyncTailBenchmark {
+public:
+    SyncTailBenchmark(int numCollections, int numIndexes)
+        : _environment(SyncTailBenchmarkEnvironment::get()),
+          _opCtx(cc().makeOperationContext()),
+          _syncTail(nullptr,
+                    _environment.getConsistencyMarkers(),
+                    _environment.getStorageInterface(),
+                    multiSyncApply,
+                    _environment.getWriterPool()),
+          _oplog(numCollections, numIndexes) {
+        for (auto&& op : _oplog.makeCollections()) {
+            apply({op});
+        }
+        _unmeasured = _syncTail.getBatchPhaseTimings();
+    }
+
+    /**
+     * Returns a batch of 'batchSize' oplog entries produced by 'makeOp'.
+     */
+    template <typename MakeOp>
+    MultiApplier::Operations makeBatch(MakeOp makeOp, int batchSize = kBatchSize) {
+        MultiApplier::Operations batch;
+        batch.reserve(batchSize);
+        for (int i = 0; i < batchSize; ++i) {
+            batch.push_back(makeOp(_oplog));
+        }
+        return batch;
+    }
+
+    void apply(MultiApplier::Operations batch) {
+        uassertStatusOK(_syncTail.multiApply(_opCtx.get(), std::move(batch)).getStatus());
+    }
+
+    /**
+     * Applies 'numDocuments' inserts, so that updates and deletes have documents to target. These
+     * batches are not included in the report.
+     */
+    void preload(int numDocuments) {
+        const auto before = _syncTail.getBatchPhaseTimings();
+        while (numDocuments > 0) {
+            const int batchSize = std::min(numDocuments, kBatchSize);
+            apply(makeBatch([](SyntheticOplog& oplog) { return oplog.makeInsert(); }, batchSize));
+            numDocuments -= batchSize;
+        }
+        const auto after = _syncTail.getBatchPhaseTimings();
+        _unmeasured.batches += after.batches - before.batches;
+        _unmeasured.writeOplog += after.writeOplog - before.writeOplog;
+        _unmeasured.fillWriterVectors += after.fillWriterVectors - before.fillWriterVectors;
+        _unmeasured.applyOps += after.applyOps - before.applyOps;
+    }
+
+    /**
+     * Reports the oplog entries applied per second and the average time per batch spent writing
+     * the oplog, partitioning the batch across the writer threads and applying the operations.
+     */
+    void report(benchmark::State& state, int opsPerBatch = kBatchSize) {
+        const auto timings = _syncTail.getBatchPhaseTimings();
+        const auto batches = timings.batches - _unmeasured.batches;
+        state.SetItemsProcessed(state.iterations() * opsPerBatch);
+        if (batches == 0) {
+            return;
+        }
+
+        auto perBatch = [&](Microseconds total, Microseconds unmeasured) {
+            return static_cast<double>(durationCount<Microseconds>(total - unmeasured)) / batches;
+        };
+        state.counters["writeOplogMicros"] = perBatch(timings.writeOplog, _unmeasured.writeOplog);
+        state.counters["fillWriterVectorsMicros"] =
+            perBatch(timings.fillWriterVectors, _unmeasured.fillWriterVectors);
+        state.counters["applyOpsMicros"] = perBatch(timings.applyOps, _unmeasured.applyOps);
+    }
+
+private:
+    SyncTailBenchmarkEnvironment& _environment;
+    ServiceContext::UniqueOperationContext _opCtx;
+    SyncTail _syncTail;
+    SyntheticOplog _oplog;
+
+    // Phase timings of the setup batches, which are excluded from the report.
+    SyncTail::BatchPhaseTimings _unmeasured;
+};
+
+// All benchmarks take the number of collections and the number of secondary indexes per collection
+// as their first two arguments.
+
+void BM_ApplyInserts(benchmark::State& state) {
+    SyncTailBenchmark bm(state.range(0), state.range(1));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto batch = bm.makeBatch([](SyntheticOplog& oplog) { return oplog.makeInsert(); });
+        state.ResumeTiming();
+        bm.apply(std::move(batch));
+    }
+    bm.report(state);
+}
+
+// The third argument selects the UpdateKind.
+void BM_ApplyUpdates(benchmark::State& state) {
+    SyncTailBenchmark bm(state.range(0), state.range(1));
+    const auto kind = static_cast<UpdateKind>(state.range(2));
+    bm.preload(4 * kBatchSize);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto batch = bm.makeBatch([=](SyntheticOplog& oplog) { return oplog.makeUpdate(kind); });
+        state.ResumeTiming();
+        bm.apply(std::move(batch));
+    }
+    bm.report(state);
+}
+
+void BM_ApplyDeletes(benchmark::State& state) {
+    SyncTailBenchmark bm(state.range(0), state.range(1));
+    for (auto _ : state) {
+        state.PauseTiming();
+        bm.preload(kBatchSize);
+        auto batch = bm.makeBatch([](SyntheticOplog& oplog) { return oplog.makeDelete(); });
+        state.ResumeTiming();
+        bm.apply(std::move(batch));
+    }
+    bm.report(state);
+}
+
+// The third argument is the number of inserts in each applyOps entry.
+void BM_ApplyApplyOps(benchmark::State& state) {
+    SyncTailBenchmark bm(state.range(0), state.range(1));
+    const int opsPerEntry = state.range(2);
+    const int batchSize = kBatchSize / opsPerEntry;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto batch = bm.makeBatch(
+            [=](SyntheticOplog& oplog) { return oplog.makeApplyOps(opsPerEntry); }, batchSize);
+        state.ResumeTiming();
+        bm.apply(std::move(batch));
+    }
+    bm.report(state, batchSize * opsPerEntry);
+}
+
+// Half inserts and a third updates, using every modifier, with the rest split between deletes
+// and small applyOps entries.
+void BM_ApplyMixed(benchmark::State& state) {
+    SyncTailBenchmark bm(state.range(0), state.range(1));
+    bm.preload(4 * kBatchSize);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto batch = bm.makeBatch([](SyntheticOplog& oplog) {
+            const auto choice = oplog.random().nextInt32(12);
+            if (choice < 6) {
+                return oplog.makeInsert();
+            }
+            if (choice < 10) {
+                return oplog.makeUpdate(static_cast<UpdateKind>(choice - 6));
+            }
+            if (choice < 11) {
+                return oplog.makeDelete();
+            }
+            return oplog.makeApplyOps(4);
+        });
+        state.ResumeTiming();
+        bm.apply(std::move(batch));
+    }
+    bm.report(state);
+}
+
+void collectionsAndIndexes(benchmark::internal::Benchmark* b) {
+    for (int collections : {1, 16}) {
+        for (int indexes : {0, 4}) {
+            b->Args({collections, indexes});
+        }
+    }
+}
+
+void updateArgs(benchmark::internal::Benchmark* b) {
+    for (int kind = 0; kind < static_cast<int>(UpdateKind::kNumKinds); ++kind) {
+        b->Args({1, 0, kind});
+        b->Args({16, 4, kind});
+    }
+}
+
+BENCHMARK(BM_ApplyInserts)->Apply(collectionsAndIndexes)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ApplyUpdates)->Apply(updateArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ApplyDeletes)->Apply(collectionsAndIndexes)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ApplyApplyOps)
+    ->Args({1, 0, 10})
+    ->Args({16, 4, 10})
+    ->Args({16, 4, 100})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ApplyMixed)->Apply(collectionsAndIndexes)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
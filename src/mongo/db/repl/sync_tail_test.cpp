@@ -49,6 +49,7 @@
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/repl/applier_helpers.h"
 #include "mongo/db/repl/bgsync.h"
 #include "mongo/db/repl/drop_pending_collection_reaper.h"
 #include "mongo/db/repl/idempotency_test_fixture.h"
@@ -453,6 +454,26 @@ TEST_F(SyncTailTest,
                                                      createOplogCollectionOptions()));
 }
 
+TEST_F(SyncTailTest, MultiApplyRecordsBatchPhaseTimings) {
+    NamespaceString nss("test.t");
+    auto writerPool = OplogApplier::makeWriterPool(2);
+    auto op = makeInsertDocumentOplogEntry({Timestamp(Seconds(1), 0), 1LL}, nss, BSON("_id" << 1));
+
+    SyncTail syncTail(nullptr,
+                      getConsistencyMarkers(),
+                      getStorageInterface(),
+                      noopApplyOperationFn,
+                      writerPool.get());
+    ASSERT_EQUALS(0, syncTail.getBatchPhaseTimings().batches);
+
+    ASSERT_OK(syncTail.multiApply(_opCtx.get(), {op}).getStatus());
+    auto timings = syncTail.getBatchPhaseTimings();
+    ASSERT_EQUALS(1, timings.batches);
+
+    // The oplog write is in flight for the whole of fillWriterVectors().
+    ASSERT_GTE(timings.writeOplog, timings.fillWriterVectors);
+}
+
 TEST_F(SyncTailTest, MultiApplyAssignsOperationsToWriterThreadsBasedOnNamespaceHash) {
     // This test relies on implementation details of how multiApply uses hashing to distribute ops
     // to threads. It is possible for this test to fail, even if the implementation of multiApply is
@@ -523,6 +544,63 @@ TEST_F(SyncTailTest, MultiApplyAssignsOperationsToWriterThreadsBasedOnNamespaceH
     ASSERT_EQUALS(op2, lastEntry);
 }
 
+TEST_F(SyncTailTest, MultiApplyBalancedAssignmentSpreadsNamespacesAcrossWriterThreads) {
+    const bool oldBalancedAssignment = replWriterBalancedAssignment.load();
+    ON_BLOCK_EXIT([&] { replWriterBalancedAssignment.store(oldBalancedAssignment); });
+    replWriterBalancedAssignment.store(true);
+
+    auto writerPool = OplogApplier::makeWriterPool(2);
+
+    stdx::mutex mutex;
+    std::vector<MultiApplier::Operations> operationsApplied;
+    auto applyOperationFn =
+        [&mutex, &operationsApplied](OperationContext* opCtx,
+                                     MultiApplier::OperationPtrs* operationsForWriterThreadToApply,
+                                     SyncTail* st,
+                                     WorkerMultikeyPathInfo*) -> Status {
+        stdx::lock_guard<stdx::mutex> lock(mutex);
+        operationsApplied.emplace_back();
+        for (auto&& opPtr : *operationsForWriterThreadToApply) {
+            operationsApplied.back().push_back(*opPtr);
+        }
+        return Status::OK();
+    };
+
+    // Four namespaces go to alternating writers regardless of their hashes. The last op shares a
+    // namespace with the first, so it must follow it on the same writer.
+    MultiApplier::Operations ops;
+    for (int i = 0; i < 4; ++i) {
+        ops.push_back(makeInsertDocumentOplogEntry({Timestamp(Seconds(i + 1), 0), 1LL},
+                                                   NamespaceString("test.t" + std::to_string(i)),
+                                                   BSON("x" << i)));
+    }
+    ops.push_back(makeInsertDocumentOplogEntry(
+        {Timestamp(Seconds(5), 0), 1LL}, NamespaceString("test.t0"), BSON("x" << 4)));
+
+    SyncTail syncTail(nullptr,
+                      getConsistencyMarkers(),
+                      getStorageInterface(),
+                      applyOperationFn,
+                      writerPool.get());
+    auto lastOpTime = unittest::assertGet(syncTail.multiApply(_opCtx.get(), ops));
+    ASSERT_EQUALS(ops.back().getOpTime(), lastOpTime);
+
+    stdx::lock_guard<stdx::mutex> lock(mutex);
+    ASSERT_EQUALS(2U, operationsApplied.size());
+    auto firstWriterOps = operationsApplied[0];
+    auto secondWriterOps = operationsApplied[1];
+    if (firstWriterOps.size() < secondWriterOps.size()) {
+        std::swap(firstWriterOps, secondWriterOps);
+    }
+    ASSERT_EQUALS(3U, firstWriterOps.size());
+    ASSERT_EQUALS(ops[0], firstWriterOps[0]);
+    ASSERT_EQUALS(ops[2], firstWriterOps[1]);
+    ASSERT_EQUALS(ops[4], firstWriterOps[2]);
+    ASSERT_EQUALS(2U, secondWriterOps.size());
+    ASSERT_EQUALS(ops[1], secondWriterOps[0]);
+    ASSERT_EQUALS(ops[3], secondWriterOps[1]);
+}
+
 TEST_F(SyncTailTest, MultiSyncApplyUsesSyncApplyToApplyOperation) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
     auto op = makeCreateCollectionOplogEntry({Timestamp(Seconds(1), 0), 1LL}, nss);
@@ -1098,6 +1176,62 @@ TEST_F(SyncTailTest, MultiSyncApplyFetchesMissingDocumentIfDocumentIsAvailableFr
     ASSERT_EQUALS(ErrorCodes::CollectionIsEmpty, iter->next().getStatus());
 }
 
+TEST_F(SyncTailTest, MultiSyncApplyGroupsUpdateAndDeleteOperationsByNamespace) {
+    const bool oldGroupWrites = replWriterGroupUpdatesAndDeletes.load();
+    ON_BLOCK_EXIT([&] { replWriterGroupUpdatesAndDeletes.store(oldGroupWrites); });
+    replWriterGroupUpdatesAndDeletes.store(true);
+
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    int seconds = 1;
+    auto nextOpTime = [&seconds]() -> OpTime { return {Timestamp(Seconds(seconds++), 0), 1LL}; };
+    ASSERT_OK(runOpsSteadyState(
+        {makeCreateCollectionOplogEntry(nextOpTime(), nss),
+         makeInsertDocumentOplogEntry(nextOpTime(), nss, BSON("_id" << 1 << "x" << 1)),
+         makeInsertDocumentOplogEntry(nextOpTime(), nss, BSON("_id" << 2 << "x" << 2)),
+         makeInsertDocumentOplogEntry(nextOpTime(), nss, BSON("_id" << 3 << "x" << 3))}));
+
+    // The updates and deletes are applied as one group, in order.
+    ASSERT_OK(runOpsSteadyState(
+        {makeUpdateDocumentOplogEntry(
+             nextOpTime(), nss, BSON("_id" << 1), BSON("_id" << 1 << "x" << 10)),
+         makeDeleteDocumentOplogEntry(nextOpTime(), nss, BSON("_id" << 2)),
+         makeUpdateDocumentOplogEntry(
+             nextOpTime(), nss, BSON("_id" << 3), BSON("_id" << 3 << "x" << 30)),
+         makeUpdateDocumentOplogEntry(
+             nextOpTime(), nss, BSON("_id" << 3), BSON("_id" << 3 << "x" << 31))}));
+
+    OplogInterfaceLocal collectionReader(_opCtx.get(), nss.ns());
+    auto iter = collectionReader.makeIterator();
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 3 << "x" << 31), unittest::assertGet(iter->next()).first);
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 1 << "x" << 10), unittest::assertGet(iter->next()).first);
+    ASSERT_EQUALS(ErrorCodes::CollectionIsEmpty, iter->next().getStatus());
+}
+
+TEST_F(SyncTailTest, MultiSyncApplyFallsBackOnApplyingWritesIndividuallyWhenGroupedWritesFail) {
+    const bool oldGroupWrites = replWriterGroupUpdatesAndDeletes.load();
+    ON_BLOCK_EXIT([&] { replWriterGroupUpdatesAndDeletes.store(oldGroupWrites); });
+    replWriterGroupUpdatesAndDeletes.store(true);
+
+    // During initial sync, the update of a missing document fails the group. Applied alone, it
+    // fetches the document from the sync source instead.
+    SyncTailWithLocalDocumentFetcher syncTail(BSON("_id" << 0 << "x" << 1));
+    NamespaceString nss("test.t");
+    createCollection(_opCtx.get(), nss, {});
+    auto op1 = makeUpdateDocumentOplogEntry(
+        {Timestamp(Seconds(1), 0), 1LL}, nss, BSON("_id" << 0), BSON("_id" << 0 << "x" << 1));
+    auto op2 = makeUpdateDocumentOplogEntry(
+        {Timestamp(Seconds(2), 0), 1LL}, nss, BSON("_id" << 0), BSON("_id" << 0 << "x" << 2));
+    MultiApplier::OperationPtrs ops = {&op1, &op2};
+    WorkerMultikeyPathInfo pathInfo;
+    ASSERT_OK(multiSyncApply(_opCtx.get(), &ops, &syncTail, &pathInfo));
+    ASSERT_EQUALS(syncTail.numFetched, 1U);
+
+    OplogInterfaceLocal collectionReader(_opCtx.get(), nss.ns());
+    auto iter = collectionReader.makeIterator();
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 0 << "x" << 2), unittest::assertGet(iter->next()).first);
+    ASSERT_EQUALS(ErrorCodes::CollectionIsEmpty, iter->next().getStatus());
+}
+
 namespace {
 
 class ReplicationCoordinatorSignalDrainCompleteThrows : public ReplicationCoordinatorMock {
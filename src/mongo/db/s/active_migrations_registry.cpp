@@ -34,6 +34,7 @@
 #include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/migration_session_id.h"
 #include "mongo/db/s/migration_source_manager.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 
 namespace mongo {
@@ -43,10 +44,19 @@ const auto getRegistry = ServiceContext::declareDecoration<ActiveMigrationsRegis
 
 }  // namespace
 
+MONGO_EXPORT_SERVER_PARAMETER(maxConcurrentChunkMigrationsPerShard, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1) {
+            return Status(ErrorCodes::BadValue,
+                          "maxConcurrentChunkMigrationsPerShard must be >= 1");
+        }
+        return Status::OK();
+    });
+
 ActiveMigrationsRegistry::ActiveMigrationsRegistry() = default;
 
 ActiveMigrationsRegistry::~ActiveMigrationsRegistry() {
-    invariant(!_activeMoveChunkState);
+    invariant(_activeMoveChunkStates.empty());
 }
 
 ActiveMigrationsRegistry& ActiveMigrationsRegistry::get(ServiceContext* service) {
@@ -64,17 +74,23 @@ StatusWith<ScopedDonateChunk> ActiveMigrationsRegistry::registerDonateChunk(
         return _activeReceiveChunkState->constructErrorStatus();
     }
 
-    if (_activeMoveChunkState) {
-        if (_activeMoveChunkState->args == args) {
-            return {ScopedDonateChunk(nullptr, false, _activeMoveChunkState->notification)};
+    const auto it = _activeMoveChunkStates.find(args.getNss());
+    if (it != _activeMoveChunkStates.end()) {
+        if (it->second.args == args) {
+            return {ScopedDonateChunk(nullptr, args.getNss(), false, it->second.notification)};
         }
 
-        return _activeMoveChunkState->constructErrorStatus();
+        return it->second.constructErrorStatus();
+    }
+
+    if (_activeMoveChunkStates.size() >=
+        static_cast<size_t>(maxConcurrentChunkMigrationsPerShard.load())) {
+        return _activeMoveChunkStates.begin()->second.constructErrorStatus();
     }
 
-    _activeMoveChunkState.emplace(args);
+    const auto newIt = _activeMoveChunkStates.emplace(args.getNss(), args).first;
 
-    return {ScopedDonateChunk(this, true, _activeMoveChunkState->notification)};
+    return {ScopedDonateChunk(this, args.getNss(), true, newIt->second.notification)};
 }
 
 StatusWith<ScopedReceiveChunk> ActiveMigrationsRegistry::registerReceiveChunk(
@@ -84,8 +100,8 @@ StatusWith<ScopedReceiveChunk> ActiveMigrationsRegistry::registerReceiveChunk(
         return _activeReceiveChunkState->constructErrorStatus();
     }
 
-    if (_activeMoveChunkState) {
-        return _activeMoveChunkState->constructErrorStatus();
+    if (!_activeMoveChunkStates.empty()) {
+        return _activeMoveChunkStates.begin()->second.constructErrorStatus();
     }
 
     _activeReceiveChunkState.emplace(nss, chunkRange, fromShardId);
@@ -93,13 +109,20 @@ StatusWith<ScopedReceiveChunk> ActiveMigrationsRegistry::registerReceiveChunk(
     return {ScopedReceiveChunk(this)};
 }
 
-boost::optional<NamespaceString> ActiveMigrationsRegistry::getActiveDonateChunkNss() {
+std::vector<NamespaceString> ActiveMigrationsRegistry::getActiveDonateChunkNamespaces() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
-    if (_activeMoveChunkState) {
-        return _activeMoveChunkState->args.getNss();
+
+    std::vector<NamespaceString> namespaces;
+    for (const auto& entry : _activeMoveChunkStates) {
+        namespaces.push_back(entry.first);
     }
 
-    return boost::none;
+    return namespaces;
+}
+
+bool ActiveMigrationsRegistry::isDonatingChunk(const NamespaceString& nss) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _activeMoveChunkStates.count(nss);
 }
 
 BSONObj ActiveMigrationsRegistry::getActiveMigrationStatusReport(OperationContext* opCtx) {
@@ -107,8 +130,8 @@ BSONObj ActiveMigrationsRegistry::getActiveMigrationStatusReport(OperationContex
     {
         stdx::lock_guard<stdx::mutex> lk(_mutex);
 
-        if (_activeMoveChunkState) {
-            nss = _activeMoveChunkState->args.getNss();
+        if (!_activeMoveChunkStates.empty()) {
+            nss = _activeMoveChunkStates.begin()->first;
         }
     }
 
@@ -129,10 +152,9 @@ BSONObj ActiveMigrationsRegistry::getActiveMigrationStatusReport(OperationContex
     return BSONObj();
 }
 
-void ActiveMigrationsRegistry::_clearDonateChunk() {
+void ActiveMigrationsRegistry::_clearDonateChunk(const NamespaceString& nss) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
-    invariant(_activeMoveChunkState);
-    _activeMoveChunkState.reset();
+    invariant(_activeMoveChunkStates.erase(nss));
 }
 
 void ActiveMigrationsRegistry::_clearReceiveChunk() {
@@ -164,9 +186,11 @@ Status ActiveMigrationsRegistry::ActiveReceiveChunkState::constructErrorStatus()
 }
 
 ScopedDonateChunk::ScopedDonateChunk(ActiveMigrationsRegistry* registry,
+                                     NamespaceString nss,
                                      bool shouldExecute,
                                      std::shared_ptr<Notification<Status>> completionNotification)
     : _registry(registry),
+      _nss(std::move(nss)),
       _shouldExecute(shouldExecute),
       _completionNotification(std::move(completionNotification)) {}
 
@@ -174,7 +198,7 @@ ScopedDonateChunk::~ScopedDonateChunk() {
     if (_registry && _shouldExecute) {
         // If this is a newly started migration the caller must always signal on completion
         invariant(*_completionNotification);
-        _registry->_clearDonateChunk();
+        _registry->_clearDonateChunk(_nss);
     }
 }
 
@@ -186,6 +210,7 @@ ScopedDonateChunk& ScopedDonateChunk::operator=(ScopedDonateChunk&& other) {
     if (&other != this) {
         _registry = other._registry;
         other._registry = nullptr;
+        _nss = std::move(other._nss);
         _shouldExecute = other._shouldExecute;
         _completionNotification = std::move(other._completionNotification);
     }
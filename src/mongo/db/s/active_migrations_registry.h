@@ -29,9 +29,12 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <map>
+#include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/s/migration_session_id.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/s/request_types/move_chunk_request.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/mutex.h"
@@ -45,9 +48,13 @@ class ScopedReceiveChunk;
 template <typename T>
 class StatusWith;
 
+// Maximum number of chunks of different collections, which a shard may donate at the same time
+extern AtomicInt32 maxConcurrentChunkMigrationsPerShard;
+
 /**
  * Thread-safe object that keeps track of the active migrations running on a node and limits them
- * to only one per shard. There is only one instance of this object per shard.
+ * to maxConcurrentChunkMigrationsPerShard donations of different collections or one receive per
+ * shard. There is only one instance of this object per shard.
  */
 class ActiveMigrationsRegistry {
     MONGO_DISALLOW_COPYING(ActiveMigrationsRegistry);
@@ -60,9 +67,10 @@ public:
     static ActiveMigrationsRegistry& get(OperationContext* opCtx);
 
     /**
-     * If there are no migrations running on this shard, registers an active migration with the
-     * specified arguments. Returns a ScopedDonateChunk, which must be signaled by the
-     * caller before it goes out of scope.
+     * If this shard is not receiving a chunk, is not donating a chunk of the same collection and
+     * is donating fewer than maxConcurrentChunkMigrationsPerShard chunks, registers an active
+     * migration with the specified arguments. Returns a ScopedDonateChunk, which must be signaled
+     * by the caller before it goes out of scope.
      *
      * If there is an active migration already running on this shard and it has the exact same
      * arguments, returns a ScopedDonateChunk. The ScopedDonateChunk can be used to join the
@@ -84,14 +92,20 @@ public:
                                                         const ShardId& fromShardId);
 
     /**
-     * If a migration has been previously registered through a call to registerDonateChunk, returns
-     * that namespace. Otherwise returns boost::none.
+     * Returns the namespaces of the migrations, which have been previously registered through calls
+     * to registerDonateChunk, in namespace order.
      */
-    boost::optional<NamespaceString> getActiveDonateChunkNss();
+    std::vector<NamespaceString> getActiveDonateChunkNamespaces();
 
     /**
-     * Returns a report on the active migration if there currently is one. Otherwise, returns an
-     * empty BSONObj.
+     * Returns true if a migration of a chunk of the specified namespace has been previously
+     * registered through a call to registerDonateChunk.
+     */
+    bool isDonatingChunk(const NamespaceString& nss);
+
+    /**
+     * Returns a report on the first active migration in namespace order if there currently is
+     * one. Otherwise, returns an empty BSONObj.
      *
      * Takes an IS lock on the namespace of the active migration, if one is active.
      */
@@ -140,9 +154,9 @@ private:
 
     /**
      * Unregisters a previously registered namespace with an ongoing migration. Must only be called
-     * if a previous call to registerDonateChunk has succeeded.
+     * if a previous call to registerDonateChunk for that namespace has succeeded.
      */
-    void _clearDonateChunk();
+    void _clearDonateChunk(const NamespaceString& nss);
 
     /**
      * Unregisters a previously registered incoming migration. Must only be called if a previous
@@ -153,8 +167,8 @@ private:
     // Protects the state below
     stdx::mutex _mutex;
 
-    // If there is an active moveChunk operation, this field contains the original request
-    boost::optional<ActiveMoveChunkState> _activeMoveChunkState;
+    // Map of namespace to the original request of each active moveChunk operation
+    std::map<NamespaceString, ActiveMoveChunkState> _activeMoveChunkStates;
 
     // If there is an active chunk receive operation, this field contains the original session id
     boost::optional<ActiveReceiveChunkState> _activeReceiveChunkState;
@@ -170,6 +184,7 @@ class ScopedDonateChunk {
 
 public:
     ScopedDonateChunk(ActiveMigrationsRegistry* registry,
+                      NamespaceString nss,
                       bool shouldExecute,
                       std::shared_ptr<Notification<Status>> completionNotification);
     ~ScopedDonateChunk();
@@ -203,6 +218,9 @@ private:
     // Registry from which to unregister the migration. Not owned.
     ActiveMigrationsRegistry* _registry;
 
+    // Namespace of the migrated chunk
+    NamespaceString _nss;
+
     /**
      * Whether the holder is the first in line for a newly started migration (in which case the
      * destructor must unregister) or the caller is joining on an already-running migration
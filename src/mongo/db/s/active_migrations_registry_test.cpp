@@ -35,6 +35,7 @@
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/s/request_types/move_chunk_request.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -80,14 +81,18 @@ TEST_F(MoveChunkRegistration, ScopedDonateChunkMoveConstructorAndAssignment) {
 }
 
 TEST_F(MoveChunkRegistration, GetActiveMigrationNamespace) {
-    ASSERT(!_registry.getActiveDonateChunkNss());
+    ASSERT(_registry.getActiveDonateChunkNamespaces().empty());
 
     const NamespaceString nss("TestDB", "TestColl");
 
     auto originalScopedDonateChunk =
         assertGet(_registry.registerDonateChunk(createMoveChunkRequest(nss)));
 
-    ASSERT_EQ(nss.ns(), _registry.getActiveDonateChunkNss()->ns());
+    const auto namespaces = _registry.getActiveDonateChunkNamespaces();
+    ASSERT_EQ(1U, namespaces.size());
+    ASSERT_EQ(nss.ns(), namespaces[0].ns());
+    ASSERT(_registry.isDonatingChunk(nss));
+    ASSERT(!_registry.isDonatingChunk(NamespaceString("TestDB", "OtherColl")));
 
     // Need to signal the registered migration so the destructor doesn't invariant
     originalScopedDonateChunk.signalComplete(Status::OK());
@@ -105,6 +110,54 @@ TEST_F(MoveChunkRegistration, SecondMigrationReturnsConflictingOperationInProgre
     originalScopedDonateChunk.signalComplete(Status::OK());
 }
 
+TEST_F(MoveChunkRegistration, ConcurrentMigrationsOfDifferentCollections) {
+    const int originalMaxConcurrentMigrations = maxConcurrentChunkMigrationsPerShard.load();
+    maxConcurrentChunkMigrationsPerShard.store(2);
+    ON_BLOCK_EXIT(
+        [&] { maxConcurrentChunkMigrationsPerShard.store(originalMaxConcurrentMigrations); });
+
+    const NamespaceString nss1("TestDB", "TestColl1");
+    const NamespaceString nss2("TestDB", "TestColl2");
+
+    auto firstScopedDonateChunk =
+        assertGet(_registry.registerDonateChunk(createMoveChunkRequest(nss1)));
+    ASSERT(firstScopedDonateChunk.mustExecute());
+
+    // A different chunk of the same collection cannot be migrated concurrently
+    auto sameCollectionStatus = _registry.registerDonateChunk(createMoveChunkRequest(nss1));
+    ASSERT_EQ(ErrorCodes::ConflictingOperationInProgress, sameCollectionStatus.getStatus());
+
+    {
+        auto secondScopedDonateChunk =
+            assertGet(_registry.registerDonateChunk(createMoveChunkRequest(nss2)));
+        ASSERT(secondScopedDonateChunk.mustExecute());
+        ASSERT_EQ(2U, _registry.getActiveDonateChunkNamespaces().size());
+
+        // The limit has been reached
+        auto thirdScopedDonateChunkStatus = _registry.registerDonateChunk(
+            createMoveChunkRequest(NamespaceString("TestDB", "TestColl3")));
+        ASSERT_EQ(ErrorCodes::ConflictingOperationInProgress,
+                  thirdScopedDonateChunkStatus.getStatus());
+
+        // Receiving is not allowed while donating
+        ASSERT_EQ(ErrorCodes::ConflictingOperationInProgress,
+                  _registry
+                      .registerReceiveChunk(NamespaceString("TestDB", "TestColl3"),
+                                            ChunkRange(BSON("Key" << -100), BSON("Key" << 100)),
+                                            ShardId("shard0001"))
+                      .getStatus());
+
+        secondScopedDonateChunk.signalComplete(Status::OK());
+    }
+
+    // Completing a migration only unregisters its own collection
+    const auto namespaces = _registry.getActiveDonateChunkNamespaces();
+    ASSERT_EQ(1U, namespaces.size());
+    ASSERT_EQ(nss1.ns(), namespaces[0].ns());
+
+    firstScopedDonateChunk.signalComplete(Status::OK());
+}
+
 TEST_F(MoveChunkRegistration, SecondMigrationWithSameArgumentsJoinsFirst) {
     auto originalScopedDonateChunk = assertGet(_registry.registerDonateChunk(
         createMoveChunkRequest(NamespaceString("TestDB", "TestColl"))));
@@ -32,6 +32,9 @@
 
 #include "mongo/db/s/balancer/balancer_policy.h"
 
+#include <algorithm>
+
+#include "mongo/db/server_parameters.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/catalog/type_tags.h"
 #include "mongo/util/log.h"
@@ -51,8 +54,76 @@ namespace {
 // optimal average across all shards for a zone for a rebalancing migration to be initiated.
 const size_t kDefaultImbalanceThreshold = 1;
 
+Status validateNonNegativeLoadKnob(const char* name, double newVal) {
+    if (newVal < 0) {
+        return {ErrorCodes::BadValue, str::stream() << name << " must be >= 0"};
+    }
+    return Status::OK();
+}
+
+/**
+ * Returns the cost of serving the specified rates of operations and bytes according to the
+ * configured cost model.
+ */
+double loadCost(double opsPerSec, double bytesPerSec) {
+    return balancerLoadOpsWeight.load() * opsPerSec +
+        balancerLoadBytesWeight.load() * bytesPerSec / (1024 * 1024);
+}
+
+double shardLoadCost(const ClusterStatistics::ShardStatistics& stat) {
+    return loadCost(stat.opsPerSec, stat.bytesPerSec);
+}
+
+/**
+ * Returns the cost of the load served by the specified chunk, which is zero if the shard owning it
+ * didn't report it among its most written chunks.
+ */
+double chunkLoadCost(const ClusterStatistics::ShardStatistics& stat,
+                     const NamespaceString& nss,
+                     const ChunkType& chunk) {
+    const auto it = stat.chunkLoads.find(nss.ns());
+    if (it == stat.chunkLoads.end())
+        return 0;
+
+    for (const auto& chunkLoad : it->second) {
+        if (SimpleBSONObjComparator::kInstance.evaluate(chunkLoad.min == chunk.getMin())) {
+            return loadCost(chunkLoad.opsPerSec, chunkLoad.bytesPerSec);
+        }
+    }
+
+    return 0;
+}
+
+const ClusterStatistics::ShardStatistics& getShardStats(const ShardStatisticsVector& shardStats,
+                                                        const ShardId& shardId) {
+    const auto it = std::find_if(shardStats.begin(), shardStats.end(), [&](const auto& stat) {
+        return stat.shardId == shardId;
+    });
+    invariant(it != shardStats.end());
+    return *it;
+}
+
 }  // namespace
 
+MONGO_EXPORT_SERVER_PARAMETER(balancerLoadOpsWeight, double, 1.0)
+    ->withValidator([](const double& newVal) {
+        return validateNonNegativeLoadKnob("balancerLoadOpsWeight", newVal);
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(balancerLoadBytesWeight, double, 1.0)
+    ->withValidator([](const double& newVal) {
+        return validateNonNegativeLoadKnob("balancerLoadBytesWeight", newVal);
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(balancerLoadImbalanceThreshold, double, 0)
+    ->withValidator([](const double& newVal) {
+        if (newVal != 0 && newVal < 1) {
+            return Status(ErrorCodes::BadValue,
+                          "balancerLoadImbalanceThreshold must be either 0 or >= 1");
+        }
+        return Status::OK();
+    });
+
 DistributionStatus::DistributionStatus(NamespaceString nss, ShardToChunksMap shardToChunksMap)
     : _nss(std::move(nss)),
       _shardChunks(std::move(shardToChunksMap)),
@@ -425,6 +496,14 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
                                   &migrations,
                                   usedShards))
             ;
+
+        while (_singleZoneLoadBalance(shardStats,
+                                      distribution,
+                                      tag,
+                                      idealNumberOfChunksPerShardForTag,
+                                      &migrations,
+                                      usedShards))
+            ;
     }
 
     return migrations;
@@ -489,9 +568,15 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
         return false;
 
     const vector<ChunkType>& chunks = distribution.getChunks(from);
+    const auto& fromStat = getShardStats(shardStats, from);
 
     unsigned numJumboChunks = 0;
 
+    // Move the least loaded chunk, so that balancing the chunk counts disturbs the load as little
+    // as possible. Without load statistics this is the first chunk.
+    const ChunkType* coldestChunk = nullptr;
+    double coldestChunkCost = 0;
+
     for (const auto& chunk : chunks) {
         if (distribution.getTagForChunk(chunk) != tag)
             continue;
@@ -501,8 +586,16 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
             continue;
         }
 
-        migrations->emplace_back(to, chunk);
-        invariant(usedShards->insert(chunk.getShard()).second);
+        const double chunkCost = chunkLoadCost(fromStat, distribution.nss(), chunk);
+        if (!coldestChunk || chunkCost < coldestChunkCost) {
+            coldestChunk = &chunk;
+            coldestChunkCost = chunkCost;
+        }
+    }
+
+    if (coldestChunk) {
+        migrations->emplace_back(to, *coldestChunk);
+        invariant(usedShards->insert(coldestChunk->getShard()).second);
         invariant(usedShards->insert(to).second);
         return true;
     }
@@ -516,6 +609,91 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
     return false;
 }
 
+bool BalancerPolicy::_singleZoneLoadBalance(const ShardStatisticsVector& shardStats,
+                                            const DistributionStatus& distribution,
+                                            const string& tag,
+                                            size_t idealNumberOfChunksPerShardForTag,
+                                            vector<MigrateInfo>* migrations,
+                                            set<ShardId>* usedShards) {
+    const double threshold = balancerLoadImbalanceThreshold.load();
+    if (threshold <= 0)
+        return false;
+
+    const ClusterStatistics::ShardStatistics* from = nullptr;
+    const ClusterStatistics::ShardStatistics* to = nullptr;
+
+    for (const auto& stat : shardStats) {
+        if (usedShards->count(stat.shardId))
+            continue;
+
+        if (!tag.empty() && !stat.shardTags.count(tag))
+            continue;
+
+        const double cost = shardLoadCost(stat);
+
+        if (!from || cost > shardLoadCost(*from)) {
+            from = &stat;
+        }
+
+        if (!isShardSuitableReceiver(stat, tag).isOK())
+            continue;
+
+        if (distribution.numberOfChunksInShardWithTag(stat.shardId, tag) >
+            idealNumberOfChunksPerShardForTag)
+            continue;
+
+        if (!to || cost < shardLoadCost(*to)) {
+            to = &stat;
+        }
+    }
+
+    if (!from || !to || from == to)
+        return false;
+
+    const double fromCost = shardLoadCost(*from);
+    const double toCost = shardLoadCost(*to);
+
+    LOG(1) << "collection : " << distribution.nss().ns();
+    LOG(1) << "zone       : " << tag;
+    LOG(1) << "donor      : " << from->shardId << " load cost " << fromCost;
+    LOG(1) << "receiver   : " << to->shardId << " load cost " << toCost;
+    LOG(1) << "threshold  : " << threshold;
+
+    // Check whether it is necessary to balance the load within this zone
+    if (fromCost <= toCost * threshold)
+        return false;
+
+    // Moving a chunk, which costs more than half of the difference would make the receiver more
+    // loaded than the donor and the next round would move it back
+    const double maxChunkCost = (fromCost - toCost) / 2;
+
+    const ChunkType* hottestChunk = nullptr;
+    double hottestChunkCost = 0;
+
+    for (const auto& chunk : distribution.getChunks(from->shardId)) {
+        if (chunk.getJumbo())
+            continue;
+
+        if (distribution.getTagForChunk(chunk) != tag)
+            continue;
+
+        const double chunkCost = chunkLoadCost(*from, distribution.nss(), chunk);
+        if (chunkCost <= hottestChunkCost || chunkCost > maxChunkCost)
+            continue;
+
+        hottestChunk = &chunk;
+        hottestChunkCost = chunkCost;
+    }
+
+    if (!hottestChunk)
+        return false;
+
+    migrations->emplace_back(to->shardId, *hottestChunk);
+    invariant(usedShards->insert(from->shardId).second);
+    invariant(usedShards->insert(to->shardId).second);
+    return true;
+}
+
 ZoneRange::ZoneRange(const BSONObj& a_min, const BSONObj& a_max, const std::string& _zone)
     : min(a_min.getOwned()), max(a_max.getOwned()), zone(_zone) {}
 
@@ -36,11 +36,22 @@
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/s/balancer/cluster_statistics.h"
+#include "mongo/platform/atomic_proxy.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/shard_id.h"
 
 namespace mongo {
 
+// Weights of the cost model used to compare the load of shards and chunks. The cost of a shard or a
+// chunk is balancerLoadOpsWeight * operations/sec + balancerLoadBytesWeight * MB/sec.
+extern AtomicDouble balancerLoadOpsWeight;
+extern AtomicDouble balancerLoadBytesWeight;
+
+// How many times higher the cost of the most loaded shard of a zone must be than that of the least
+// loaded one for the balancer to migrate a chunk between them because of load. Zero disables load
+// balancing, in which case the balancer doesn't collect load statistics from the shards.
+extern AtomicDouble balancerLoadImbalanceThreshold;
+
 struct ZoneRange {
     ZoneRange(const BSONObj& a_min, const BSONObj& a_max, const std::string& _zone);
 
@@ -179,7 +190,9 @@ public:
      *
      * The balancing logic calculates the optimum number of chunks per shard for each zone and if
      * any of the shards have chunks, which are sufficiently higher than this number, suggests
-     * moving chunks to shards, which are under this number.
+     * moving chunks to shards, which are under this number. The least written chunks are moved
+     * first. If load balancing is enabled, the shards which were not used for these migrations
+     * are then balanced by moving written chunks from the most loaded to the least loaded shards.
      *
      * The usedShards parameter is in/out and it contains the set of shards, which have already been
      * used for migrations. Used so we don't return multiple conflicting migrations for the same
@@ -234,6 +247,24 @@ private:
                                    size_t idealNumberOfChunksPerShardForTag,
                                    std::vector<MigrateInfo>* migrations,
                                    std::set<ShardId>* usedShards);
+
+    /**
+     * Selects one chunk for the specified zone (if appropriate) to be moved from the most loaded
+     * to the least loaded shard in the zone, if the cost of the former exceeds that of the latter
+     * by more than balancerLoadImbalanceThreshold times. Only shards, which do not have more than
+     * 'idealNumberOfChunksPerShardForTag' chunks are considered as receivers, so that balancing
+     * the load doesn't undo the balancing of the chunk counts. The selected chunk is the most
+     * loaded one, which doesn't make the receiver more loaded than the donor.
+     *
+     * Returns true if a migration was suggested, false otherwise. This method is intented to be
+     * called multiple times until all posible migrations for a zone have been selected.
+     */
+    static bool _singleZoneLoadBalance(const ShardStatisticsVector& shardStats,
+                                       const DistributionStatus& distribution,
+                                       const std::string& tag,
+                                       size_t idealNumberOfChunksPerShardForTag,
+                                       std::vector<MigrateInfo>* migrations,
+                                       std::set<ShardId>* usedShards);
 };
 
 }  // namespace mongo
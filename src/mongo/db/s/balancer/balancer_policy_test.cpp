@@ -36,6 +36,7 @@
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -110,6 +111,22 @@ std::pair<ShardStatisticsVector, ShardToChunksMap> generateCluster(
     return std::make_pair(std::move(shardStats), std::move(chunkMap));
 }
 
+/**
+ * Sets the load of the specified shard and of its chunks, which are specified as pairs of chunk and
+ * operations per second.
+ */
+void setShardLoad(ShardStatistics* stat,
+                  double opsPerSec,
+                  const vector<std::pair<ChunkType, double>>& chunkOpsPerSec) {
+    stat->opsPerSec = opsPerSec;
+    for (const auto& entry : chunkOpsPerSec) {
+        ClusterStatistics::ChunkLoad chunkLoad;
+        chunkLoad.min = entry.first.getMin();
+        chunkLoad.opsPerSec = entry.second;
+        stat->chunkLoads[kNamespace.ns()].push_back(std::move(chunkLoad));
+    }
+}
+
 std::vector<MigrateInfo> balanceChunks(const ShardStatisticsVector& shardStats,
                                        const DistributionStatus& distribution,
                                        bool shouldAggressivelyBalance) {
@@ -608,6 +625,99 @@ TEST(BalancerPolicy, BalancerHandlesNoShardsWithTag) {
     ASSERT(balanceChunks(cluster.first, distribution, false).empty());
 }
 
+TEST(BalancerPolicy, BalancerMovesLeastLoadedChunkWhenBalancingChunkCounts) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 4, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId1, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0}});
+
+    setShardLoad(&cluster.first[0],
+                 100,
+                 {{cluster.second[kShardId0][0], 50},
+                  {cluster.second[kShardId0][1], 30},
+                  {cluster.second[kShardId0][3], 20}});
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][2].getMin(), migrations[0].minKey);
+}
+
+TEST(BalancerPolicy, BalancerDoesNotBalanceLoadByDefault) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+
+    setShardLoad(&cluster.first[0], 100, {{cluster.second[kShardId0][1], 30}});
+    setShardLoad(&cluster.first[1], 10, {});
+
+    ASSERT(balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false)
+               .empty());
+}
+
+TEST(BalancerPolicy, BalancerMovesLoadedChunkToLeastLoadedShard) {
+    const double originalThreshold = balancerLoadImbalanceThreshold.load();
+    balancerLoadImbalanceThreshold.store(1.5);
+    ON_BLOCK_EXIT([&] { balancerLoadImbalanceThreshold.store(originalThreshold); });
+
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId2, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+
+    // The first chunk is too hot to move, because the receiver would become more loaded than the
+    // donor
+    setShardLoad(&cluster.first[0],
+                 100,
+                 {{cluster.second[kShardId0][0], 80}, {cluster.second[kShardId0][1], 30}});
+    setShardLoad(&cluster.first[1], 40, {});
+    setShardLoad(&cluster.first[2], 10, {});
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId2, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][1].getMin(), migrations[0].minKey);
+}
+
+TEST(BalancerPolicy, BalancerDoesNotBalanceLoadBelowThreshold) {
+    const double originalThreshold = balancerLoadImbalanceThreshold.load();
+    balancerLoadImbalanceThreshold.store(1.5);
+    ON_BLOCK_EXIT([&] { balancerLoadImbalanceThreshold.store(originalThreshold); });
+
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+
+    setShardLoad(&cluster.first[0], 100, {{cluster.second[kShardId0][1], 10}});
+    setShardLoad(&cluster.first[1], 80, {});
+
+    ASSERT(balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false)
+               .empty());
+}
+
+TEST(BalancerPolicy, BalancerDoesNotBalanceLoadOntoShardWithTooManyChunks) {
+    const double originalThreshold = balancerLoadImbalanceThreshold.load();
+    balancerLoadImbalanceThreshold.store(1.5);
+    ON_BLOCK_EXIT([&] { balancerLoadImbalanceThreshold.store(originalThreshold); });
+
+    // The least loaded shard has more than the ideal number of chunks, so the load can only be
+    // moved to the second most loaded shard, which is within the threshold
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 3, false, emptyTagSet, emptyShardVersion), 3},
+         {ShardStatistics(kShardId1, kNoMaxSize, 3, false, emptyTagSet, emptyShardVersion), 3},
+         {ShardStatistics(kShardId2, kNoMaxSize, 4, false, emptyTagSet, emptyShardVersion), 4}});
+
+    setShardLoad(&cluster.first[0], 100, {{cluster.second[kShardId0][1], 10}});
+    setShardLoad(&cluster.first[1], 90, {});
+    setShardLoad(&cluster.first[2], 10, {});
+
+    ASSERT(balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false)
+               .empty());
+}
+
 TEST(DistributionStatus, AddTagRangeOverlap) {
     DistributionStatus d(kNamespace, ShardToChunksMap{});
 
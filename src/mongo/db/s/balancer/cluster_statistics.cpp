@@ -72,6 +72,11 @@ BSONObj ClusterStatistics::ShardStatistics::toBSON() const {
     }
 
     builder.append("version", mongoVersion);
+    if (opsPerSec || bytesPerSec) {
+        builder.append("opsPerSec", opsPerSec);
+        builder.append("bytesPerSec", bytesPerSec);
+    }
+
     return builder.obj();
 }
 
@@ -28,17 +28,18 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
 #include "mongo/s/client/shard.h"
 
 namespace mongo {
 
-class BSONObj;
 class OperationContext;
 template <typename T>
 class StatusWith;
@@ -52,6 +53,20 @@ class ClusterStatistics {
     MONGO_DISALLOW_COPYING(ClusterStatistics);
 
 public:
+    /**
+     * Structure, which describes the write load served by a single chunk.
+     */
+    struct ChunkLoad {
+        // The min key of the chunk
+        BSONObj min;
+
+        // The rate of writes to the chunk
+        double opsPerSec{0};
+
+        // The rate of bytes written to the chunk
+        double bytesPerSec{0};
+    };
+
     /**
      * Structure, which describes the statistics of a single shard host.
      */
@@ -92,6 +107,14 @@ public:
 
         // Version of mongod, which runs on this shard's primary
         std::string mongoVersion;
+
+        // The rate of operations and network bytes served by this shard's primary. Only collected
+        // when load balancing is enabled and zero otherwise.
+        double opsPerSec{0};
+        double bytesPerSec{0};
+
+        // The load of the most written chunks on this shard, keyed by collection namespace
+        std::map<std::string, std::vector<ChunkLoad>> chunkLoads;
     };
 
     virtual ~ClusterStatistics();
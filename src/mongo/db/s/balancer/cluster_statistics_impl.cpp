@@ -37,6 +37,7 @@
 #include "mongo/base/status_with.h"
 #include "mongo/bson/util/bson_extract.h"
 #include "mongo/client/read_preference.h"
+#include "mongo/db/s/balancer/balancer_policy.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
@@ -49,6 +50,9 @@ namespace {
 
 const char kVersionField[] = "version";
 
+// Number of the most written chunks of each collection, which the shards report
+const int kMaxChunkLoadsPerCollection = 10;
+
 /**
  * Executes the serverStatus command against the specified shard and obtains the version of the
  * running MongoD service.
@@ -89,6 +93,126 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
     return version;
 }
 
+/**
+ * Executes the _shardsvrGetChunkLoadStatistics command against the specified shard and fills in
+ * the load it has served since the previous call. The first call only starts the measurement on
+ * the shard, so it leaves the load at zero.
+ */
+Status retrieveShardLoad(OperationContext* opCtx, ClusterStatistics::ShardStatistics* stat) {
+    auto shardRegistry = Grid::get(opCtx)->shardRegistry();
+    auto shardStatus = shardRegistry->getShard(opCtx, stat->shardId);
+    if (!shardStatus.isOK()) {
+        return shardStatus.getStatus();
+    }
+    auto shard = shardStatus.getValue();
+
+    auto commandResponse = shard->runCommandWithFixedRetryAttempts(
+        opCtx,
+        ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+        "admin",
+        BSON("_shardsvrGetChunkLoadStatistics" << 1 << "maxChunksPerCollection"
+                                               << kMaxChunkLoadsPerCollection),
+        Shard::RetryPolicy::kIdempotent);
+    if (!commandResponse.isOK()) {
+        return commandResponse.getStatus();
+    }
+    if (!commandResponse.getValue().commandStatus.isOK()) {
+        return commandResponse.getValue().commandStatus;
+    }
+
+    const BSONObj response = std::move(commandResponse.getValue().response);
+
+    long long windowMillis;
+    Status status = bsonExtractIntegerField(response, "windowMillis", &windowMillis);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    if (windowMillis <= 0) {
+        return Status::OK();
+    }
+
+    const double windowSecs = windowMillis / 1000.0;
+
+    long long ops;
+    status = bsonExtractIntegerField(response, "ops", &ops);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    long long bytes;
+    status = bsonExtractIntegerField(response, "bytes", &bytes);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    BSONElement collections;
+    status = bsonExtractTypedField(response, "collections", Array, &collections);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    std::map<std::string, std::vector<ClusterStatistics::ChunkLoad>> chunkLoads;
+
+    for (const auto& collElem : collections.Obj()) {
+        if (collElem.type() != Object) {
+            return {ErrorCodes::TypeMismatch, "Invalid collection entry in the chunk load"};
+        }
+        const BSONObj coll = collElem.Obj();
+
+        std::string ns;
+        status = bsonExtractStringField(coll, "ns", &ns);
+        if (!status.isOK()) {
+            return status;
+        }
+
+        BSONElement chunks;
+        status = bsonExtractTypedField(coll, "chunks", Array, &chunks);
+        if (!status.isOK()) {
+            return status;
+        }
+
+        auto& nsChunkLoads = chunkLoads[ns];
+
+        for (const auto& chunkElem : chunks.Obj()) {
+            if (chunkElem.type() != Object) {
+                return {ErrorCodes::TypeMismatch, "Invalid chunk entry in the chunk load"};
+            }
+            const BSONObj chunk = chunkElem.Obj();
+
+            BSONElement min;
+            status = bsonExtractTypedField(chunk, "min", Object, &min);
+            if (!status.isOK()) {
+                return status;
+            }
+
+            long long chunkOps;
+            status = bsonExtractIntegerField(chunk, "ops", &chunkOps);
+            if (!status.isOK()) {
+                return status;
+            }
+
+            long long chunkBytes;
+            status = bsonExtractIntegerField(chunk, "bytes", &chunkBytes);
+            if (!status.isOK()) {
+                return status;
+            }
+
+            ClusterStatistics::ChunkLoad chunkLoad;
+            chunkLoad.min = min.Obj().getOwned();
+            chunkLoad.opsPerSec = chunkOps / windowSecs;
+            chunkLoad.bytesPerSec = chunkBytes / windowSecs;
+            nsChunkLoads.push_back(std::move(chunkLoad));
+        }
+    }
+
+    stat->opsPerSec = ops / windowSecs;
+    stat->bytesPerSec = bytes / windowSecs;
+    stat->chunkLoads = std::move(chunkLoads);
+
+    return Status::OK();
+}
+
 }  // namespace
 
 using ShardStatistics = ClusterStatistics::ShardStatistics;
@@ -156,6 +280,16 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
                            shard.getDraining(),
                            std::move(shardTags),
                            std::move(mongoDVersion));
+
+        if (balancerLoadImbalanceThreshold.load() > 0) {
+            // The load is not required for balancing by chunk counts, so if it cannot be
+            // retrieved just leave it at zero
+            auto loadStatus = retrieveShardLoad(opCtx, &stats.back());
+            if (!loadStatus.isOK()) {
+                log() << "Unable to obtain the load of shard " << shard.getName()
+                      << causedBy(loadStatus);
+            }
+        }
     }
 
     return stats;
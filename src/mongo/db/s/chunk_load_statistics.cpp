@@ -0,0 +1,196 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/chunk_load_statistics.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/stats/counters.h"
+#include "mongo/s/chunk_manager.h"
+
+namespace mongo {
+namespace {
+
+const auto getChunkLoadStatistics = ServiceContext::declareDecoration<ChunkLoadStatistics>();
+
+/**
+ * Returns the total number of operations this process has served. The counters are reset when any
+ * of them wraps, in which case the returned value goes backwards.
+ */
+long long totalOps() {
+    return static_cast<long long>(globalOpCounters.getInsert()->load()) +
+        globalOpCounters.getQuery()->load() + globalOpCounters.getUpdate()->load() +
+        globalOpCounters.getDelete()->load() + globalOpCounters.getGetMore()->load() +
+        globalOpCounters.getCommand()->load();
+}
+
+/**
+ * Returns the total number of bytes this process has received and sent.
+ */
+long long totalBytes() {
+    BSONObjBuilder builder;
+    networkCounter.append(builder);
+    const BSONObj network = builder.obj();
+    return network["bytesIn"].safeNumberLong() + network["bytesOut"].safeNumberLong();
+}
+
+/**
+ * Returns the growth of a counter since 'start', treating a counter, which went backwards as having
+ * been reset to zero.
+ */
+long long counterDelta(long long start, long long current) {
+    return current >= start ? current - start : current;
+}
+
+}  // namespace
+
+ChunkLoadStatistics::ChunkLoadStatistics() = default;
+
+ChunkLoadStatistics& ChunkLoadStatistics::get(ServiceContext* serviceContext) {
+    return getChunkLoadStatistics(serviceContext);
+}
+
+ChunkLoadStatistics& ChunkLoadStatistics::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void ChunkLoadStatistics::recordWrite(OperationContext* opCtx,
+                                      const NamespaceString& nss,
+                                      const BSONObj& doc) {
+    if (!_enabled.load())
+        return;
+
+    const auto metadata = CollectionShardingState::get(opCtx, nss)->getMetadata(opCtx);
+    if (!metadata->isSharded())
+        return;
+
+    const auto cm = metadata->getChunkManager();
+    const BSONObj shardKey = cm->getShardKeyPattern().extractShardKeyFromDoc(doc);
+    if (shardKey.isEmpty())
+        return;
+
+    const auto chunk = cm->findIntersectingChunkWithSimpleCollation(shardKey);
+    recordChunkWrite(nss, chunk.getMin(), doc.objsize());
+}
+
+void ChunkLoadStatistics::recordChunkWrite(const NamespaceString& nss,
+                                           const BSONObj& chunkMin,
+                                           long long bytes) {
+    stdx::lock_guard<stdx::mutex> lg(_mutex);
+
+    auto it = _chunkLoads.find(nss.ns());
+    if (it == _chunkLoads.end()) {
+        it = _chunkLoads
+                 .emplace(nss.ns(),
+                          SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<ChunkLoad>())
+                 .first;
+    }
+
+    auto chunkIt = it->second.find(chunkMin);
+    if (chunkIt == it->second.end()) {
+        chunkIt = it->second.emplace(chunkMin.getOwned(), ChunkLoad()).first;
+    }
+
+    chunkIt->second.ops++;
+    chunkIt->second.bytes += bytes;
+}
+
+void ChunkLoadStatistics::reportAndReset(BSONObjBuilder* builder,
+                                         Date_t now,
+                                         size_t maxChunksPerCollection) {
+    const long long ops = totalOps();
+    const long long bytes = totalBytes();
+
+    std::map<std::string, ChunkLoadMap> chunkLoads;
+    Date_t windowStart;
+    long long windowStartOps;
+    long long windowStartBytes;
+
+    {
+        stdx::lock_guard<stdx::mutex> lg(_mutex);
+
+        if (!_enabled.load()) {
+            _windowStart = now;
+            _windowStartOps = ops;
+            _windowStartBytes = bytes;
+            _enabled.store(true);
+        }
+
+        chunkLoads.swap(_chunkLoads);
+        windowStart = _windowStart;
+        windowStartOps = _windowStartOps;
+        windowStartBytes = _windowStartBytes;
+
+        _windowStart = now;
+        _windowStartOps = ops;
+        _windowStartBytes = bytes;
+    }
+
+    builder->append("windowMillis", durationCount<Milliseconds>(now - windowStart));
+    builder->append("ops", counterDelta(windowStartOps, ops));
+    builder->append("bytes", counterDelta(windowStartBytes, bytes));
+
+    BSONArrayBuilder collectionsBuilder(builder->subarrayStart("collections"));
+    for (const auto& collEntry : chunkLoads) {
+        std::vector<ChunkLoadMap::const_iterator> chunks;
+        for (auto it = collEntry.second.begin(); it != collEntry.second.end(); ++it) {
+            chunks.push_back(it);
+        }
+
+        const size_t numChunks = std::min(chunks.size(), maxChunksPerCollection);
+        std::partial_sort(
+            chunks.begin(),
+            chunks.begin() + numChunks,
+            chunks.end(),
+            [](ChunkLoadMap::const_iterator lhs, ChunkLoadMap::const_iterator rhs) {
+                return lhs->second.bytes > rhs->second.bytes ||
+                    (lhs->second.bytes == rhs->second.bytes && lhs->second.ops > rhs->second.ops);
+            });
+
+        BSONObjBuilder collBuilder(collectionsBuilder.subobjStart());
+        collBuilder.append("ns", collEntry.first);
+
+        BSONArrayBuilder chunksBuilder(collBuilder.subarrayStart("chunks"));
+        for (size_t i = 0; i < numChunks; i++) {
+            BSONObjBuilder chunkBuilder(chunksBuilder.subobjStart());
+            chunkBuilder.append("min", chunks[i]->first);
+            chunkBuilder.append("ops", chunks[i]->second.ops);
+            chunkBuilder.append("bytes", chunks[i]->second.bytes);
+        }
+    }
+}
+
+}  // namespace mongo
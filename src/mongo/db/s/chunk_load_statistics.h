@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class NamespaceString;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Tracks the load which this shard serves, both in aggregate and per chunk, so that the balancer
+ * can take it into account when choosing migrations. The aggregate load comes from the global
+ * operation and network counters, while the per chunk load only covers writes, because those are
+ * the operations which can be attributed to a chunk cheaply from the op observer.
+ *
+ * Recording is only turned on by the first report, so that shards in clusters which do not use
+ * load balancing don't pay for it.
+ */
+class ChunkLoadStatistics {
+    MONGO_DISALLOW_COPYING(ChunkLoadStatistics);
+
+public:
+    ChunkLoadStatistics();
+
+    /**
+     * Obtains the per-process instance of the chunk load statistics.
+     */
+    static ChunkLoadStatistics& get(ServiceContext* serviceContext);
+    static ChunkLoadStatistics& get(OperationContext* opCtx);
+
+    /**
+     * Attributes a write of the given document (or document key, for deletes) to the chunk of
+     * 'nss' which owns it. Does nothing if the collection is not sharded or if recording has not
+     * been turned on yet.
+     */
+    void recordWrite(OperationContext* opCtx, const NamespaceString& nss, const BSONObj& doc);
+
+    /**
+     * Attributes a write of 'bytes' to the chunk of 'nss' which starts at 'chunkMin'.
+     */
+    void recordChunkWrite(const NamespaceString& nss, const BSONObj& chunkMin, long long bytes);
+
+    /**
+     * Appends the load observed since the previous report and starts a new window. The output is
+     * in the form:
+     *
+     *  {windowMillis: <>, ops: <>, bytes: <>,
+     *   collections: [{ns: <>, chunks: [{min: <>, ops: <>, bytes: <>}, ...]}, ...]}
+     *
+     * where at most 'maxChunksPerCollection' of the most written chunks are listed for each
+     * collection. The first report turns on recording and has an empty window.
+     */
+    void reportAndReset(BSONObjBuilder* builder, Date_t now, size_t maxChunksPerCollection);
+
+private:
+    struct ChunkLoad {
+        long long ops{0};
+        long long bytes{0};
+    };
+
+    using ChunkLoadMap = BSONObjIndexedMap<ChunkLoad>;
+
+    // Whether writes are being recorded, which is the case after the first report
+    AtomicBool _enabled{false};
+
+    // Protects the state below
+    stdx::mutex _mutex;
+
+    // Per collection map of chunk min key to the writes recorded for that chunk in this window
+    std::map<std::string, ChunkLoadMap> _chunkLoads;
+
+    // When the current window started and the values of the global counters at that time
+    Date_t _windowStart;
+    long long _windowStartOps{0};
+    long long _windowStartBytes{0};
+};
+
+}  // namespace mongo
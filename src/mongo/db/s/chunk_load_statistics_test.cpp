@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/s/chunk_load_statistics.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("TestDB", "TestColl");
+const NamespaceString kOtherNss("TestDB", "OtherColl");
+
+BSONObj report(ChunkLoadStatistics* stats, Date_t now, size_t maxChunksPerCollection) {
+    BSONObjBuilder builder;
+    stats->reportAndReset(&builder, now, maxChunksPerCollection);
+    return builder.obj();
+}
+
+TEST(ChunkLoadStatistics, FirstReportHasAnEmptyWindow) {
+    ChunkLoadStatistics stats;
+    const Date_t now = Date_t::now();
+
+    const auto result = report(&stats, now, 10);
+    ASSERT_EQ(0, result["windowMillis"].numberLong());
+    ASSERT_EQ(0, result["ops"].numberLong());
+    ASSERT_EQ(0, result["bytes"].numberLong());
+    ASSERT_EQ(0U, result["collections"].Obj().nFields());
+}
+
+TEST(ChunkLoadStatistics, ReportsMostWrittenChunksSinceThePreviousReport) {
+    ChunkLoadStatistics stats;
+    const Date_t now = Date_t::now();
+    report(&stats, now, 10);
+
+    stats.recordChunkWrite(kNss, BSON("x" << 0), 10);
+    stats.recordChunkWrite(kNss, BSON("x" << 10), 100);
+    stats.recordChunkWrite(kNss, BSON("x" << 10), 100);
+    stats.recordChunkWrite(kNss, BSON("x" << 20), 50);
+    stats.recordChunkWrite(kOtherNss, BSON("y" << 0), 1);
+
+    const auto result = report(&stats, now + Seconds(10), 2);
+    ASSERT_EQ(10000, result["windowMillis"].numberLong());
+
+    const auto collections = result["collections"].Array();
+    ASSERT_EQ(2U, collections.size());
+
+    // Collections are reported in namespace order
+    ASSERT_EQ(kOtherNss.ns(), collections[0]["ns"].String());
+    ASSERT_EQ(1U, collections[0]["chunks"].Array().size());
+
+    ASSERT_EQ(kNss.ns(), collections[1]["ns"].String());
+    const auto chunks = collections[1]["chunks"].Array();
+    ASSERT_EQ(2U, chunks.size());
+    ASSERT_BSONOBJ_EQ(BSON("x" << 10), chunks[0]["min"].Obj());
+    ASSERT_EQ(2, chunks[0]["ops"].numberLong());
+    ASSERT_EQ(200, chunks[0]["bytes"].numberLong());
+    ASSERT_BSONOBJ_EQ(BSON("x" << 20), chunks[1]["min"].Obj());
+    ASSERT_EQ(1, chunks[1]["ops"].numberLong());
+    ASSERT_EQ(50, chunks[1]["bytes"].numberLong());
+
+    // The next report starts a new window
+    const auto nextResult = report(&stats, now + Seconds(15), 2);
+    ASSERT_EQ(5000, nextResult["windowMillis"].numberLong());
+    ASSERT_EQ(0U, nextResult["collections"].Array().size());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -42,6 +42,7 @@
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/split_chunk.h"
 #include "mongo/db/s/split_vector.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/catalog/type_chunk.h"
@@ -54,6 +55,11 @@
 #include "mongo/util/log.h"
 
 namespace mongo {
+
+// Whether the autosplitter estimates split points from sampled documents rather than scanning the
+// shard key index.
+MONGO_EXPORT_SERVER_PARAMETER(autoSplitSampleSplitPoints, bool, true);
+
 namespace {
 
 /**
@@ -314,16 +320,30 @@ void ChunkSplitter::_runAutosplit(std::shared_ptr<ChunkSplitStateDriver> chunkSp
                << " maxChunkSizeBytes: " << maxChunkSizeBytes;
 
         chunkSplitStateDriver->prepareSplit();
-        auto splitPoints = uassertStatusOK(splitVector(opCtx.get(),
-                                                       nss,
-                                                       shardKeyPattern.toBSON(),
-                                                       chunk.getMin(),
-                                                       chunk.getMax(),
-                                                       false,
-                                                       boost::none,
-                                                       boost::none,
-                                                       boost::none,
-                                                       maxChunkSizeBytes));
+
+        // Estimate the split points from a sample of the collection, falling back to scanning the
+        // chunk's range of the shard key index when that is not possible.
+        boost::optional<std::vector<BSONObj>> sampledSplitPoints;
+        if (autoSplitSampleSplitPoints.load()) {
+            sampledSplitPoints = sampleSplitVector(opCtx.get(),
+                                                   nss,
+                                                   shardKeyPattern.toBSON(),
+                                                   chunk.getMin(),
+                                                   chunk.getMax(),
+                                                   maxChunkSizeBytes);
+        }
+        auto splitPoints = sampledSplitPoints
+            ? std::move(*sampledSplitPoints)
+            : uassertStatusOK(splitVector(opCtx.get(),
+                                          nss,
+                                          shardKeyPattern.toBSON(),
+                                          chunk.getMin(),
+                                          chunk.getMax(),
+                                          false,
+                                          boost::none,
+                                          boost::none,
+                                          boost::none,
+                                          maxChunkSizeBytes));
 
         if (splitPoints.size() <= 1) {
             LOG(1)
@@ -55,6 +55,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/executor/task_executor.h"
+#include "mongo/s/shard_key_pattern.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
@@ -69,6 +70,15 @@ MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterBatchDelayMS, int, 20)
         return Status::OK();
     });
 
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterWriteUnitOfWorkSize, int, 16)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1) {
+            return Status(ErrorCodes::BadValue,
+                          "rangeDeleterWriteUnitOfWorkSize must be at least 1");
+        }
+        return Status::OK();
+    });
+
 namespace {
 
 using Deletion = CollectionRangeDeleter::Deletion;
@@ -111,6 +121,7 @@ boost::optional<Date_t> CollectionRangeDeleter::cleanUpNextRange(
 
     auto range = boost::optional<ChunkRange>(boost::none);
     auto notification = DeleteNotification();
+    BSONObj resumeKey;
 
     {
         UninterruptibleLockGuard noInterrupt(opCtx->lockState());
@@ -183,6 +194,7 @@ boost::optional<Date_t> CollectionRangeDeleter::cleanUpNextRange(
             invariant(!orphans.empty());
             const auto& frontRange = orphans.front().range;
             range.emplace(frontRange.getMin().getOwned(), frontRange.getMax().getOwned());
+            resumeKey = orphans.front().resumeKey;
             notification = orphans.front().notification;
         }
 
@@ -218,13 +230,31 @@ boost::optional<Date_t> CollectionRangeDeleter::cleanUpNextRange(
             }
         }
 
+        // Resume the scan from the last document deleted by the previous batch. The resumed range
+        // includes that key, so documents sharing it which were not yet deleted are not skipped.
+        const ChunkRange remaining = resumeKey.isEmpty()
+            ? *range
+            : ChunkRange(resumeKey, range->getMax());
+
+        BSONObj lastDeletedKey;
         try {
-            wrote = self->_doDeletion(
-                opCtx, collection, metadata->getKeyPattern(), *range, maxToDelete);
+            wrote = self->_doDeletion(opCtx,
+                                      collection,
+                                      metadata->getKeyPattern(),
+                                      remaining,
+                                      maxToDelete,
+                                      &lastDeletedKey);
         } catch (const DBException& e) {
             wrote = e.toStatus();
             warning() << e.what();
         }
+
+        if (!lastDeletedKey.isEmpty()) {
+            stdx::lock_guard<stdx::mutex> scopedLock(css->_metadataManager->_managerLock);
+            if (!self->_orphans.empty() && self->_orphans.front().notification == notification) {
+                self->_orphans.front().resumeKey = lastDeletedKey;
+            }
+        }
     }  // drop autoColl
 
     if (!wrote.isOK() || wrote.getValue() == 0) {
@@ -304,7 +334,8 @@ StatusWith<int> CollectionRangeDeleter::_doDeletion(OperationContext* opCtx,
                                                     Collection* collection,
                                                     BSONObj const& keyPattern,
                                                     ChunkRange const& range,
-                                                    int maxToDelete) {
+                                                    int maxToDelete,
+                                                    BSONObj* lastDeletedKey) {
     invariant(collection != nullptr);
     invariant(!isEmpty());
 
@@ -354,32 +385,68 @@ StatusWith<int> CollectionRangeDeleter::_doDeletion(OperationContext* opCtx,
     auto exec = InternalPlanner::indexScan(
         opCtx, collection, descriptor, min, max, halfOpen, manual, forward, fetch);
 
+    const int docsPerWriteUnitOfWork = std::max(rangeDeleterWriteUnitOfWorkSize.load(), 1);
+
     int numDeleted = 0;
-    do {
-        RecordId rloc;
-        BSONObj obj;
-        PlanExecutor::ExecState state = exec->getNext(&obj, &rloc);
-        if (state == PlanExecutor::IS_EOF) {
-            break;
+    bool done = false;
+    while (!done && numDeleted < maxToDelete) {
+        // Collect the next batch in shard key index order, then remove it in a single write unit
+        // of work, so the per-document commit cost is amortized over the whole batch.
+        std::vector<RecordId> batch;
+        std::vector<BSONObj> batchDocs;
+        BSONObj lastKey;
+
+        const int batchLimit = std::min(docsPerWriteUnitOfWork, maxToDelete - numDeleted);
+        while (int(batch.size()) < batchLimit) {
+            RecordId rloc;
+            BSONObj obj;
+            PlanExecutor::ExecState state = exec->getNext(&obj, &rloc);
+            if (state == PlanExecutor::IS_EOF) {
+                done = true;
+                break;
+            }
+            if (state == PlanExecutor::FAILURE || state == PlanExecutor::DEAD) {
+                warning() << PlanExecutor::statestr(state)
+                          << " - cursor error while trying to delete " << redact(min) << " to "
+                          << redact(max) << " in " << nss << ": "
+                          << redact(WorkingSetCommon::toStatusString(obj))
+                          << ", stats: " << Explain::getWinningPlanStats(exec.get());
+                done = true;
+                break;
+            }
+            invariant(PlanExecutor::ADVANCED == state);
+
+            batch.push_back(rloc);
+            lastKey = obj;
+            if (saver) {
+                batchDocs.push_back(obj.getOwned());
+            }
         }
-        if (state == PlanExecutor::FAILURE || state == PlanExecutor::DEAD) {
-            warning() << PlanExecutor::statestr(state) << " - cursor error while trying to delete "
-                      << redact(min) << " to " << redact(max) << " in " << nss << ": "
-                      << redact(WorkingSetCommon::toStatusString(obj))
-                      << ", stats: " << Explain::getWinningPlanStats(exec.get());
+
+        if (batch.empty()) {
             break;
         }
-        invariant(PlanExecutor::ADVANCED == state);
+
+        const auto lastDeleted = ShardKeyPattern(keyPattern).extractShardKeyFromDoc(lastKey);
 
         exec->saveState();
         writeConflictRetry(opCtx, "delete range", nss.ns(), [&] {
             WriteUnitOfWork wuow(opCtx);
-            if (saver) {
-                uassertStatusOK(saver->goingToDelete(obj));
+            for (size_t i = 0; i < batch.size(); ++i) {
+                if (saver) {
+                    uassertStatusOK(saver->goingToDelete(batchDocs[i]));
+                }
+                collection->deleteDocument(opCtx, kUninitializedStmtId, batch[i], nullptr, true);
             }
-            collection->deleteDocument(opCtx, kUninitializedStmtId, rloc, nullptr, true);
             wuow.commit();
         });
+
+        numDeleted += batch.size();
+        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(batch.size());
+        if (lastDeletedKey && !lastDeleted.isEmpty()) {
+            *lastDeletedKey = lastDeleted.getOwned();
+        }
+
         auto restoreStateStatus = exec->restoreState();
         if (!restoreStateStatus.isOK()) {
             warning() << "error restoring cursor state while trying to delete " << redact(min)
@@ -388,9 +455,7 @@ StatusWith<int> CollectionRangeDeleter::_doDeletion(OperationContext* opCtx,
                       << redact(restoreStateStatus);
             break;
         }
-        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(1);
-
-    } while (++numDeleted < maxToDelete);
+    }
 
     return numDeleted;
 }
@@ -46,6 +46,9 @@ class OperationContext;
 // next batch of deletions.
 extern AtomicInt32 rangeDeleterBatchDelayMS;
 
+// Maximum number of documents removed by the range deleter in a single write unit of work.
+extern AtomicInt32 rangeDeleterWriteUnitOfWorkSize;
+
 class CollectionRangeDeleter {
     MONGO_DISALLOW_COPYING(CollectionRangeDeleter);
 
@@ -110,6 +113,11 @@ public:
         ChunkRange range;
         Date_t whenToDelete;  // A value of Date_t{} means immediately.
         DeleteNotification notification{};
+
+        // Shard key of the last document deleted from the range, from which the next batch
+        // resumes the index scan instead of going again over the keys, which were already
+        // removed. Empty until the first batch has been deleted.
+        BSONObj resumeKey;
     };
 
     CollectionRangeDeleter();
@@ -175,17 +183,19 @@ public:
 
 private:
     /**
-     * Performs the deletion of up to maxToDelete entries within the range in progress. Must be
-     * called under the collection lock.
+     * Performs the deletion of up to maxToDelete entries within the range in progress, in shard key
+     * index order and in write units of work of up to rangeDeleterWriteUnitOfWorkSize documents.
+     * Must be called under the collection lock.
      *
      * Returns the number of documents deleted, 0 if done with the range, or bad status if deleting
-     * the range failed.
+     * the range failed. Sets 'lastDeletedKey' to the shard key of the last deleted document.
      */
     StatusWith<int> _doDeletion(OperationContext* opCtx,
                                 Collection* collection,
                                 const BSONObj& keyPattern,
                                 ChunkRange const& range,
-                                int maxToDelete);
+                                int maxToDelete,
+                                BSONObj* lastDeletedKey);
 
     /**
      * Removes the latest-scheduled range from the ranges to be cleaned up, and notifies any
@@ -45,6 +45,7 @@
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/shard_server_test_fixture.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -231,6 +232,41 @@ TEST_F(CollectionRangeDeleterTest, MultipleCleanupNextRangeCalls) {
     ASSERT_EQUALS(0ULL, dbclient.count(kAdminSysVer.ns(), BSON(kShardKey << "startRangeDeletion")));
 }
 
+// Tests that deletions of a range batched over several write units of work and several calls
+// resume where the previous call stopped and do not remove documents outside of the range.
+TEST_F(CollectionRangeDeleterTest, BatchedDeletionsResumeWithinRange) {
+    const auto savedWriteUnitOfWorkSize = rangeDeleterWriteUnitOfWorkSize.load();
+    ON_BLOCK_EXIT([&] { rangeDeleterWriteUnitOfWorkSize.store(savedWriteUnitOfWorkSize); });
+    rangeDeleterWriteUnitOfWorkSize.store(2);
+
+    CollectionRangeDeleter rangeDeleter;
+    DBDirectClient dbclient(operationContext());
+    for (int i = 0; i <= 10; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+
+    std::list<Deletion> ranges;
+    auto deletion = Deletion{ChunkRange(BSON(kShardKey << 1), BSON(kShardKey << 8)), Date_t{}};
+    ranges.emplace_back(std::move(deletion));
+    auto when = rangeDeleter.add(std::move(ranges));
+    ASSERT(when && *when == Date_t{});
+
+    ASSERT_TRUE(next(rangeDeleter, 3));
+    ASSERT_EQUALS(8ULL, dbclient.count(kNss.toString(), BSONObj()));
+    ASSERT_EQUALS(0ULL, dbclient.count(kNss.toString(), BSON(kShardKey << GTE << 1 << LT << 4)));
+
+    ASSERT_TRUE(next(rangeDeleter, 3));
+    ASSERT_EQUALS(5ULL, dbclient.count(kNss.toString(), BSONObj()));
+
+    ASSERT_TRUE(next(rangeDeleter, 3));
+    ASSERT_TRUE(next(rangeDeleter, 3));
+    ASSERT_FALSE(next(rangeDeleter, 3));
+
+    ASSERT_EQUALS(4ULL, dbclient.count(kNss.toString(), BSONObj()));
+    ASSERT_EQUALS(1ULL, dbclient.count(kNss.toString(), BSON(kShardKey << 0)));
+    ASSERT_EQUALS(3ULL, dbclient.count(kNss.toString(), BSON(kShardKey << GTE << 8)));
+}
+
 // Tests the case that there are two ranges to clean, each containing multiple documents.
 TEST_F(CollectionRangeDeleterTest, MultipleDocumentsInMultipleRangesToClean) {
     CollectionRangeDeleter rangeDeleter;
@@ -0,0 +1,600 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kSharding
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/auth/action_type.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/s/config/initial_split_policy.h"
+#include "mongo/db/s/config/sharding_catalog_manager.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/s/catalog/dist_lock_manager.h"
+#include "mongo/s/catalog/type_chunk.h"
+#include "mongo/s/catalog/type_collection.h"
+#include "mongo/s/catalog_cache.h"
+#include "mongo/s/client/shard_registry.h"
+#include "mongo/s/cluster_commands_helpers.h"
+#include "mongo/s/grid.h"
+#include "mongo/s/request_types/reshard_collection_gen.h"
+#include "mongo/s/request_types/shard_collection_gen.h"
+#include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+// Number of documents sampled from each shard to choose the initial chunks of the new shard key
+const int kSampleSizePerShard = 1000;
+
+// The critical section is only entered once a catch-up round applies at most this many writes on
+// every recipient, or after the maximum number of rounds
+const long long kMaxOplogEntriesToApplyInCriticalSection = 1000;
+const int kMaxCatchUpRounds = 10;
+
+/**
+ * Runs 'cmdObj' with majority write concern on each of the shards in 'shardIds' in parallel and
+ * returns their responses, throwing if any of them fails.
+ */
+std::map<ShardId, BSONObj> runOnShards(OperationContext* opCtx,
+                                       const NamespaceString& nss,
+                                       const std::map<ShardId, BSONObj>& cmdObjs,
+                                       Shard::RetryPolicy retryPolicy) {
+    std::vector<AsyncRequestsSender::Request> requests;
+    for (const auto& shardAndCmdObj : cmdObjs) {
+        requests.emplace_back(shardAndCmdObj.first,
+                              CommandHelpers::appendMajorityWriteConcern(shardAndCmdObj.second));
+    }
+
+    std::map<ShardId, BSONObj> results;
+    for (auto& response : gatherResponses(opCtx,
+                                          NamespaceString::kAdminDb,
+                                          ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+                                          retryPolicy,
+                                          requests)) {
+        const std::string context = str::stream() << "Resharding " << nss.ns()
+                                                  << " failed on shard " << response.shardId;
+        auto shardResponse =
+            uassertStatusOKWithContext(std::move(response.swResponse), context);
+        uassertStatusOK(getStatusFromCommandResult(shardResponse.data).withContext(context));
+        uassertStatusOK(
+            getWriteConcernStatusFromCommandResult(shardResponse.data).withContext(context));
+        results.emplace(response.shardId, shardResponse.data.getOwned());
+    }
+
+    return results;
+}
+
+std::map<ShardId, BSONObj> runOnShards(OperationContext* opCtx,
+                                       const NamespaceString& nss,
+                                       const std::set<ShardId>& shardIds,
+                                       const BSONObj& cmdObj,
+                                       Shard::RetryPolicy retryPolicy) {
+    std::map<ShardId, BSONObj> cmdObjs;
+    for (const auto& shardId : shardIds) {
+        cmdObjs.emplace(shardId, cmdObj);
+    }
+    return runOnShards(opCtx, nss, cmdObjs, retryPolicy);
+}
+
+BSONObj runOnShard(OperationContext* opCtx,
+                   const ShardId& shardId,
+                   const std::string& dbName,
+                   const BSONObj& cmdObj) {
+    const auto shard = uassertStatusOK(Grid::get(opCtx)->shardRegistry()->getShard(opCtx, shardId));
+    auto response = uassertStatusOK(
+        shard->runCommandWithFixedRetryAttempts(opCtx,
+                                                ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+                                                dbName,
+                                                cmdObj,
+                                                Shard::RetryPolicy::kIdempotent));
+    uassertStatusOK(response.commandStatus);
+    uassertStatusOK(response.writeConcernStatus);
+    return response.response;
+}
+
+BSONObj firstBatch(const BSONObj& cursorResponse) {
+    return cursorResponse["cursor"]["firstBatch"].Obj();
+}
+
+/**
+ * Internal sharding command run on config servers to change the shard key of a collection while
+ * it keeps serving reads and writes. The documents are copied into a temporary collection sharded
+ * by the new key, which is caught up with the writes made in the meantime by tailing the oplog of
+ * the shards, and which replaces the collection once the writes are blocked for a last catch-up.
+ */
+class ConfigSvrReshardCollectionCommand : public BasicCommand {
+public:
+    ConfigSvrReshardCollectionCommand() : BasicCommand("_configsvrReshardCollection") {}
+
+    std::string help() const override {
+        return "Internal command, which is exported by the sharding config server. Do not call "
+               "directly. Changes the shard key of a collection.";
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kNever;
+    }
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return true;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override {
+        if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
+                ResourcePattern::forClusterResource(), ActionType::internal)) {
+            return Status(ErrorCodes::Unauthorized, "Unauthorized");
+        }
+        return Status::OK();
+    }
+
+    std::string parseNs(const std::string& dbname, const BSONObj& cmdObj) const override {
+        return CommandHelpers::parseNsFullyQualified(cmdObj);
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        uassert(ErrorCodes::IllegalOperation,
+                "_configsvrReshardCollection can only be run on config servers",
+                serverGlobalParams.clusterRole == ClusterRole::ConfigServer);
+
+        // Set the operation context read concern level to local for reads into the config database.
+        repl::ReadConcernArgs::get(opCtx) =
+            repl::ReadConcernArgs(repl::ReadConcernLevel::kLocalReadConcern);
+
+        uassert(ErrorCodes::InvalidOptions,
+                str::stream() << "reshardCollection must be called with majority writeConcern, got "
+                              << cmdObj,
+                opCtx->getWriteConcern().wMode == WriteConcernOptions::kMajority);
+
+        const auto request = ConfigsvrReshardCollection::parse(
+            IDLParserErrorContext("_configsvrReshardCollection"), cmdObj);
+        const auto& nss = request.get_configsvrReshardCollection();
+        const NamespaceString tempNss(nss.db(), "tmp.reshard." + nss.coll());
+
+        auto const catalogClient = Grid::get(opCtx)->catalogClient();
+        auto const catalogCache = Grid::get(opCtx)->catalogCache();
+
+        // The collection lock also keeps the balancer from migrating its chunks
+        auto dbDistLock = uassertStatusOK(catalogClient->getDistLockManager()->lock(
+            opCtx, nss.db(), "reshardCollection", DistLockManager::kDefaultLockTimeout));
+        auto collDistLock = uassertStatusOK(catalogClient->getDistLockManager()->lock(
+            opCtx, nss.ns(), "reshardCollection", DistLockManager::kDefaultLockTimeout));
+        auto tempCollDistLock = uassertStatusOK(catalogClient->getDistLockManager()->lock(
+            opCtx, tempNss.ns(), "reshardCollection", DistLockManager::kDefaultLockTimeout));
+
+        ON_BLOCK_EXIT([opCtx, nss, tempNss] {
+            Grid::get(opCtx)->catalogCache()->invalidateShardedCollection(nss);
+            Grid::get(opCtx)->catalogCache()->invalidateShardedCollection(tempNss);
+        });
+
+        const auto readConcernLevel = repl::ReadConcernArgs::get(opCtx).getLevel();
+
+        const auto coll = [&] {
+            auto swColl = catalogClient->getCollection(opCtx, nss, readConcernLevel);
+            uassert(ErrorCodes::NamespaceNotSharded,
+                    str::stream() << "Collection " << nss.ns() << " is not sharded",
+                    swColl != ErrorCodes::NamespaceNotFound);
+            auto coll = uassertStatusOK(std::move(swColl)).value;
+            uassert(ErrorCodes::NamespaceNotSharded,
+                    str::stream() << "Collection " << nss.ns() << " is not sharded",
+                    !coll.getDropped());
+            return coll;
+        }();
+
+        uassert(ErrorCodes::InvalidOptions,
+                str::stream() << "Collection " << nss.ns() << " is already sharded by "
+                              << request.getKey(),
+                SimpleBSONObjComparator::kInstance.evaluate(coll.getKeyPattern().toBSON() !=
+                                                            request.getKey()));
+        uassert(ErrorCodes::IllegalOperation,
+                str::stream() << "Collection " << nss.ns()
+                              << " has zones, which cannot be kept across resharding",
+                uassertStatusOK(catalogClient->getTagsForCollection(opCtx, nss)).empty());
+        uassert(ErrorCodes::NamespaceExists,
+                str::stream() << "Collection " << tempNss.ns() << " already exists",
+                catalogClient->getCollection(opCtx, tempNss, readConcernLevel) ==
+                    ErrorCodes::NamespaceNotFound);
+
+        const ShardKeyPattern newShardKeyPattern(request.getKey());
+
+        const auto routingInfo =
+            uassertStatusOK(catalogCache->getCollectionRoutingInfoWithRefresh(opCtx, nss));
+        uassert(ErrorCodes::NamespaceNotSharded,
+                str::stream() << "Collection " << nss.ns() << " is not sharded",
+                routingInfo.cm());
+
+        std::set<ShardId> donors;
+        routingInfo.cm()->getAllShardIds(&donors);
+        const auto primaryShardId = routingInfo.db().primaryId();
+
+        catalogClient->logChange(opCtx,
+                                 "reshardCollection.start",
+                                 nss.ns(),
+                                 BSON("key" << request.getKey() << "oldKey"
+                                            << coll.getKeyPattern().toBSON()),
+                                 ShardingCatalogClient::kMajorityWriteConcern);
+
+        std::set<ShardId> participants(donors);
+        participants.insert(primaryShardId);
+
+        // Until the new routing table is committed, a failure leaves the collection as it was
+        auto abortGuard = MakeGuard([&] { _abort(opCtx, nss, tempNss, participants); });
+
+        const auto uuid = _createTempCollection(
+            opCtx, nss, tempNss, coll, newShardKeyPattern, primaryShardId, donors, request);
+
+        std::set<ShardId> recipients;
+        uassertStatusOK(catalogCache->getCollectionRoutingInfoWithRefresh(opCtx, tempNss))
+            .cm()
+            ->getAllShardIds(&recipients);
+        participants.insert(recipients.begin(), recipients.end());
+
+        // Copy the documents and catch up with the writes until few enough are left that the
+        // writes can be blocked while the rest are applied
+        ShardsvrReshardingClone cloneRequest;
+        cloneRequest.set_shardsvrReshardingClone(tempNss);
+        cloneRequest.setSourceNs(nss);
+        cloneRequest.setCloneDocuments(true);
+
+        auto cloneResults = runOnShards(
+            opCtx, nss, recipients, cloneRequest.toBSON(), Shard::RetryPolicy::kNoRetry);
+        cloneRequest.setCloneDocuments(false);
+
+        long long numDocumentsCloned = 0;
+        for (const auto& shardAndResult : cloneResults) {
+            numDocumentsCloned +=
+                _parseCloneResponse(shardAndResult.second).getNumDocumentsCloned();
+        }
+
+        for (int round = 0; round < kMaxCatchUpRounds; ++round) {
+            long long maxApplied = 0;
+            for (const auto& shardAndResult : cloneResults) {
+                maxApplied = std::max(
+                    maxApplied,
+                    _parseCloneResponse(shardAndResult.second).getNumOplogEntriesApplied());
+            }
+            if (maxApplied <= kMaxOplogEntriesToApplyInCriticalSection) {
+                break;
+            }
+
+            cloneResults = runOnShards(opCtx,
+                                       nss,
+                                       _makeCatchUpRequests(cloneRequest, cloneResults),
+                                       Shard::RetryPolicy::kNoRetry);
+        }
+
+        // Block the writes and apply the last ones
+        ShardsvrReshardingCriticalSection critSecRequest;
+        critSecRequest.set_shardsvrReshardingCriticalSection(nss);
+        critSecRequest.setTempNs(tempNss);
+        critSecRequest.setAction(ReshardingCriticalSectionActionEnum::kEnter);
+
+        const auto fetchUpTo = [&] {
+            BSONObjBuilder builder;
+            for (const auto& shardAndResult : runOnShards(opCtx,
+                                                          nss,
+                                                          participants,
+                                                          critSecRequest.toBSON(),
+                                                          Shard::RetryPolicy::kIdempotent)) {
+                builder.append(shardAndResult.first.toString(),
+                               shardAndResult.second["fetchUpTo"].timestamp());
+            }
+            return builder.obj();
+        }();
+
+        cloneRequest.setFetchUpTo(fetchUpTo);
+        runOnShards(opCtx,
+                    nss,
+                    _makeCatchUpRequests(cloneRequest, cloneResults),
+                    Shard::RetryPolicy::kNoRetry);
+
+        // Block the reads as well, since the routing table is about to change
+        critSecRequest.setAction(ReshardingCriticalSectionActionEnum::kEnterCommitPhase);
+        runOnShards(
+            opCtx, nss, participants, critSecRequest.toBSON(), Shard::RetryPolicy::kIdempotent);
+
+        _commitRoutingTable(opCtx, nss, tempNss, coll);
+        abortGuard.Dismiss();
+
+        // The new routing table is committed, so the shards must not give up before switching to
+        // it, or the writes would remain blocked
+        critSecRequest.setAction(ReshardingCriticalSectionActionEnum::kCommit);
+        critSecRequest.setCollectionUUID(uuid);
+        while (true) {
+            try {
+                runOnShards(opCtx,
+                            nss,
+                            participants,
+                            critSecRequest.toBSON(),
+                            Shard::RetryPolicy::kIdempotent);
+                break;
+            } catch (const DBException& ex) {
+                opCtx->checkForInterrupt();
+                warning() << "Failed to switch the shards to the new shard key of " << nss
+                          << ", retrying" << causedBy(redact(ex));
+                opCtx->sleepFor(Milliseconds(500));
+            }
+        }
+
+        catalogClient->logChange(opCtx,
+                                 "reshardCollection.end",
+                                 nss.ns(),
+                                 BSON("key" << request.getKey() << "numDocumentsCloned"
+                                            << numDocumentsCloned),
+                                 ShardingCatalogClient::kMajorityWriteConcern);
+
+        result << "collectionUUID" << uuid;
+        result.append("numDocumentsCloned", numDocumentsCloned);
+        return true;
+    }
+
+private:
+    static ShardsvrReshardingCloneResponse _parseCloneResponse(const BSONObj& response) {
+        return ShardsvrReshardingCloneResponse::parse(
+            IDLParserErrorContext("ShardsvrReshardingCloneResponse"), response);
+    }
+
+    static std::map<ShardId, BSONObj> _makeCatchUpRequests(
+        ShardsvrReshardingClone& cloneRequest, const std::map<ShardId, BSONObj>& cloneResults) {
+        std::map<ShardId, BSONObj> requests;
+        for (const auto& shardAndResult : cloneResults) {
+            cloneRequest.setResumeFrom(_parseCloneResponse(shardAndResult.second).getResumeFrom());
+            requests.emplace(shardAndResult.first, cloneRequest.toBSON());
+        }
+        return requests;
+    }
+
+    /**
+     * Creates the temporary collection with the options and indexes of the collection, and shards
+     * it by the new key into chunks computed from a sample of the documents of every donor.
+     */
+    static UUID _createTempCollection(OperationContext* opCtx,
+                                      const NamespaceString& nss,
+                                      const NamespaceString& tempNss,
+                                      const CollectionType& coll,
+                                      const ShardKeyPattern& newShardKeyPattern,
+                                      const ShardId& primaryShardId,
+                                      const std::set<ShardId>& donors,
+                                      const ConfigsvrReshardCollection& request) {
+        const auto& donor = *donors.begin();
+        const auto dbName = nss.db().toString();
+
+        const auto collInfos = firstBatch(runOnShard(
+            opCtx,
+            donor,
+            dbName,
+            BSON("listCollections" << 1 << "filter" << BSON("name" << nss.coll()))));
+        uassert(ErrorCodes::NamespaceNotFound,
+                str::stream() << "Collection " << nss.ns() << " does not exist on shard " << donor,
+                !collInfos.isEmpty());
+
+        BSONObjBuilder createCmd;
+        createCmd.append("create", tempNss.coll());
+        createCmd.appendElements(collInfos.firstElement().Obj()["options"].Obj());
+        runOnShard(opCtx,
+                   primaryShardId,
+                   dbName,
+                   CommandHelpers::appendMajorityWriteConcern(createCmd.obj()));
+
+        BSONArrayBuilder indexes;
+        for (const auto& index :
+             firstBatch(runOnShard(opCtx, donor, dbName, BSON("listIndexes" << nss.coll())))) {
+            if (index.Obj()["name"].str() != "_id_") {
+                indexes.append(index.Obj().removeField("ns"));
+            }
+        }
+        if (indexes.arrSize() > 0) {
+            runOnShard(opCtx,
+                       primaryShardId,
+                       dbName,
+                       CommandHelpers::appendMajorityWriteConcern(
+                           BSON("createIndexes" << tempNss.coll() << "indexes" << indexes.arr())));
+        }
+
+        ShardsvrShardCollection shardCollectionRequest;
+        shardCollectionRequest.set_shardsvrShardCollection(tempNss);
+        shardCollectionRequest.setKey(request.getKey());
+        shardCollectionRequest.setNumInitialChunks(request.getNumInitialChunks());
+        shardCollectionRequest.setCollation(coll.getDefaultCollation());
+        shardCollectionRequest.setGetUUIDfromPrimaryShard(true);
+
+        // Hashed shard keys are always split evenly
+        if (!newShardKeyPattern.isHashedPattern()) {
+            BSONObjBuilder projection;
+            projection.append("_id", 0);
+            for (const auto& field : request.getKey()) {
+                projection.append(field.fieldName(), 1);
+            }
+            const auto sampleCmd = BSON(
+                "aggregate" << nss.coll() << "pipeline"
+                            << BSON_ARRAY(BSON("$sample" << BSON("size" << kSampleSizePerShard))
+                                          << BSON("$project" << projection.obj()))
+                            << "cursor"
+                            << BSON("batchSize" << kSampleSizePerShard));
+
+            std::vector<BSONObj> sample;
+            for (const auto& sampleResult :
+                 runOnShards(opCtx, nss, donors, sampleCmd, Shard::RetryPolicy::kIdempotent)) {
+                for (const auto& doc : firstBatch(sampleResult.second)) {
+                    sample.push_back(doc.Obj().getOwned());
+                }
+            }
+            shardCollectionRequest.setPresplitSample(std::move(sample));
+        }
+
+        // The primary shard will read the config.tags collection so we need to lock the zone
+        // mutex.
+        Lock::ExclusiveLock lk = ShardingCatalogManager::get(opCtx)->lockZoneMutex(opCtx);
+
+        const auto response = ShardsvrShardCollectionResponse::parse(
+            IDLParserErrorContext("ShardsvrShardCollectionResponse"),
+            runOnShard(opCtx,
+                       primaryShardId,
+                       NamespaceString::kAdminDb.toString(),
+                       CommandHelpers::appendMajorityWriteConcern(
+                           shardCollectionRequest.toBSON())));
+        invariant(response.getCollectionUUID());
+        return *response.getCollectionUUID();
+    }
+
+    /**
+     * Atomically replaces the routing table of the collection by the one of the temporary
+     * collection, provided that the collection was not dropped or recreated in the meantime.
+     */
+    static void _commitRoutingTable(OperationContext* opCtx,
+                                    const NamespaceString& nss,
+                                    const NamespaceString& tempNss,
+                                    const CollectionType& coll) {
+        auto const catalogClient = Grid::get(opCtx)->catalogClient();
+        const auto readConcernLevel = repl::ReadConcernArgs::get(opCtx).getLevel();
+
+        auto newColl =
+            uassertStatusOK(catalogClient->getCollection(opCtx, tempNss, readConcernLevel)).value;
+        newColl.setNs(nss);
+        newColl.setUpdatedAt(Grid::get(opCtx)->getNetwork()->now());
+
+        const auto sourceChunks = uassertStatusOK(
+            catalogClient->getChunks(opCtx,
+                                     BSON(ChunkType::ns(nss.ns())),
+                                     BSONObj(),
+                                     boost::none,
+                                     nullptr,
+                                     readConcernLevel));
+        const auto tempChunks = uassertStatusOK(
+            catalogClient->getChunks(opCtx,
+                                     BSON(ChunkType::ns(tempNss.ns())),
+                                     BSON(ChunkType::lastmod() << -1),
+                                     boost::none,
+                                     nullptr,
+                                     readConcernLevel));
+        invariant(!tempChunks.empty());
+
+        BSONArrayBuilder updates;
+        updates.append(BSON("op"
+                            << "u"
+                            << "b"
+                            << false
+                            << "ns"
+                            << CollectionType::ConfigNS.ns()
+                            << "o"
+                            << newColl.toBSON()
+                            << "o2"
+                            << BSON(CollectionType::fullNs(nss.ns()))));
+        updates.append(BSON("op"
+                            << "d"
+                            << "ns"
+                            << CollectionType::ConfigNS.ns()
+                            << "o"
+                            << BSON(CollectionType::fullNs(tempNss.ns()))));
+        for (const auto& chunk : sourceChunks) {
+            updates.append(BSON("op"
+                                << "d"
+                                << "ns"
+                                << ChunkType::ConfigNS.ns()
+                                << "o"
+                                << BSON(ChunkType::name(chunk.getName()))));
+        }
+        for (const auto& chunk : tempChunks) {
+            updates.append(BSON("op"
+                                << "d"
+                                << "ns"
+                                << ChunkType::ConfigNS.ns()
+                                << "o"
+                                << BSON(ChunkType::name(chunk.getName()))));
+
+            auto newChunk = chunk;
+            newChunk.setNS(nss);
+            updates.append(BSON("op"
+                                << "i"
+                                << "ns"
+                                << ChunkType::ConfigNS.ns()
+                                << "o"
+                                << newChunk.toConfigBSON()));
+        }
+
+        BSONArrayBuilder preCond;
+        preCond.append(BSON("ns" << CollectionType::ConfigNS.ns() << "q"
+                                 << BSON(CollectionType::fullNs(nss.ns()))
+                                 << "res"
+                                 << BSON(CollectionType::epoch(coll.getEpoch()))));
+
+        uassertStatusOKWithContext(
+            catalogClient->applyChunkOpsDeprecated(opCtx,
+                                                   updates.arr(),
+                                                   preCond.arr(),
+                                                   nss,
+                                                   tempChunks.front().getVersion(),
+                                                   ShardingCatalogClient::kMajorityWriteConcern,
+                                                   repl::ReadConcernLevel::kLocalReadConcern),
+            str::stream() << "Failed to commit the new shard key of " << nss.ns());
+    }
+
+    /**
+     * Best effort to release the shards and drop the temporary collection after a failure.
+     */
+    static void _abort(OperationContext* opCtx,
+                       const NamespaceString& nss,
+                       const NamespaceString& tempNss,
+                       const std::set<ShardId>& participants) {
+        try {
+            ShardsvrReshardingCriticalSection critSecRequest;
+            critSecRequest.set_shardsvrReshardingCriticalSection(nss);
+            critSecRequest.setTempNs(tempNss);
+            critSecRequest.setAction(ReshardingCriticalSectionActionEnum::kAbort);
+            runOnShards(opCtx,
+                        nss,
+                        participants,
+                        critSecRequest.toBSON(),
+                        Shard::RetryPolicy::kIdempotent);
+
+            uassertStatusOK(ShardingCatalogManager::get(opCtx)->dropCollection(opCtx, tempNss));
+        } catch (const DBException& ex) {
+            warning() << "Failed to clean up after resharding " << nss << " failed"
+                      << causedBy(redact(ex));
+        }
+    }
+
+} configsvrReshardCollectionCmd;
+
+}  // namespace
+}  // namespace mongo
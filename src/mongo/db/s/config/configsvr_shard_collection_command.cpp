@@ -179,6 +179,16 @@ void validateAndDeduceFullRequestOptions(OperationContext* opCtx,
             numChunks >= 0 && numChunks <= maxNumInitialChunksForShards &&
                 numChunks <= maxNumInitialChunksTotal);
 
+    // Hashed shard keys are already pre-split evenly, and mapReduce provides its own split points.
+    if (request->getPresplitSample()) {
+        uassert(ErrorCodes::InvalidOptions,
+                "presplitSample is not supported with a hashed shard key",
+                !shardKeyPattern.isHashedPattern());
+        uassert(ErrorCodes::InvalidOptions,
+                "presplitSample cannot be combined with initialSplitPoints",
+                !request->getInitialSplitPoints());
+    }
+
     // Retrieve the collection metadata in order to verify that it is legal to shard this
     // collection.
     BSONObj res;
@@ -352,7 +362,7 @@ void validateShardKeyAgainstExistingIndexes(OperationContext* opCtx,
         // Check 2.i. and 2.ii.
         if (!idx["sparse"].trueValue() && idx["filter"].eoo() && idx["collation"].eoo() &&
             proposedKey.isPrefixOf(currentKey, SimpleBSONElementComparator::kInstance)) {
-            // We can't currently use hashed indexes with a non-default hash seed
+            // We can't currently use hashed indexes with a non-default hash seed or hash version
             // Check v.
             // Note that this means that, for sharding, we only support one hashed index
             // per field per collection.
@@ -364,6 +374,15 @@ void validateShardKeyAgainstExistingIndexes(OperationContext* opCtx,
                                   << idx["seed"].numberInt(),
                     !shardKeyPattern.isHashedPattern() || idx["seed"].eoo() ||
                         idx["seed"].numberInt() == BSONElementHasher::DEFAULT_HASH_SEED);
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream() << "can't shard collection " << nss.ns()
+                                  << " with hashed shard key "
+                                  << proposedKey
+                                  << " because the hashed index uses hashVersion "
+                                  << idx["hashVersion"].numberInt()
+                                  << ", which hashed shard keys do not support",
+                    !shardKeyPattern.isHashedPattern() ||
+                        idx["hashVersion"].numberInt() == BSONElementHasher::DEFAULT_HASH_VERSION);
             hasUsefulIndexForKey = true;
         }
     }
@@ -763,6 +782,7 @@ public:
         shardsvrShardCollectionRequest.setUnique(request.getUnique());
         shardsvrShardCollectionRequest.setNumInitialChunks(request.getNumInitialChunks());
         shardsvrShardCollectionRequest.setInitialSplitPoints(request.getInitialSplitPoints());
+        shardsvrShardCollectionRequest.setPresplitSample(request.getPresplitSample());
         shardsvrShardCollectionRequest.setCollation(request.getCollation());
         shardsvrShardCollectionRequest.setGetUUIDfromPrimaryShard(
             request.getGetUUIDfromPrimaryShard());
@@ -817,6 +837,15 @@ public:
             std::vector<BSONObj> finalSplitPoints;    // all of the desired split points
             if (request.getInitialSplitPoints()) {
                 initialSplitPoints = std::move(*request.getInitialSplitPoints());
+            } else if (request.getPresplitSample()) {
+                uassert(ErrorCodes::InvalidOptions,
+                        "presplitSample is only supported when the collection is empty",
+                        isEmpty);
+                initialSplitPoints = InitialSplitPolicy::calculateSplitPointsFromSample(
+                    shardKeyPattern,
+                    *request.getPresplitSample(),
+                    numShards,
+                    request.getNumInitialChunks());
             } else {
                 InitialSplitPolicy::calculateHashedSplitPointsForEmptyCollection(
                     shardKeyPattern,
@@ -833,12 +862,12 @@ public:
                 Client::getCurrent(), nss.ns(), proposedKey, request.getUnique());
 
             // The initial chunks are distributed evenly across shards only if the initial split
-            // points
-            // were specified in the request, i.e., by mapReduce. Otherwise, all the initial chunks
-            // are
-            // placed on the primary shard, and may be distributed across shards through migrations
-            // (below) if using a hashed shard key.
-            const bool distributeInitialChunks = bool(request.getInitialSplitPoints());
+            // points were specified in the request, i.e., by mapReduce, or computed from a
+            // presplitSample. Otherwise, all the initial chunks are placed on the primary shard,
+            // and may be distributed across shards through migrations (below) if using a hashed
+            // shard key.
+            const bool distributeInitialChunks =
+                bool(request.getInitialSplitPoints()) || bool(request.getPresplitSample());
 
             // Step 6. Actually shard the collection.
             catalogManager->shardCollection(opCtx,
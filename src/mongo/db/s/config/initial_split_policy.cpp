@@ -169,6 +169,49 @@ void InitialSplitPolicy::calculateHashedSplitPointsForEmptyCollection(
     }
 }
 
+std::vector<BSONObj> InitialSplitPolicy::calculateSplitPointsFromSample(
+    const ShardKeyPattern& shardKeyPattern,
+    const std::vector<BSONObj>& sample,
+    int numShards,
+    int numInitialChunks) {
+    if (numInitialChunks <= 0) {
+        numInitialChunks = 2 * numShards;
+    }
+
+    std::vector<BSONObj> sampleKeys;
+    sampleKeys.reserve(sample.size());
+    for (const auto& doc : sample) {
+        auto shardKey = shardKeyPattern.extractShardKeyFromDoc(doc);
+        uassert(ErrorCodes::ShardKeyNotFound,
+                str::stream() << "presplitSample document " << redact(doc)
+                              << " does not contain shard key for pattern "
+                              << shardKeyPattern.toString(),
+                !shardKey.isEmpty());
+        sampleKeys.push_back(shardKey.getOwned());
+    }
+
+    std::sort(sampleKeys.begin(),
+              sampleKeys.end(),
+              SimpleBSONObjComparator::kInstance.makeLessThan());
+
+    std::vector<BSONObj> splitPoints;
+    if (sampleKeys.empty()) {
+        return splitPoints;
+    }
+
+    // Splitting at the smallest sampled key would only produce an empty chunk below it.
+    const BSONObj* lastSplitPoint = &sampleKeys.front();
+    for (int i = 1; i < numInitialChunks; i++) {
+        const auto& candidate = sampleKeys[(i * sampleKeys.size()) / numInitialChunks];
+        if (SimpleBSONObjComparator::kInstance.evaluate(*lastSplitPoint < candidate)) {
+            splitPoints.push_back(candidate);
+            lastSplitPoint = &candidate;
+        }
+    }
+
+    return splitPoints;
+}
+
 InitialSplitPolicy::ShardCollectionConfig InitialSplitPolicy::generateShardCollectionInitialChunks(
     const NamespaceString& nss,
     const ShardKeyPattern& shardKeyPattern,
@@ -60,6 +60,22 @@ public:
         std::vector<BSONObj>* initialSplitPoints,
         std::vector<BSONObj>* finalSplitPoints);
 
+    /**
+     * For new, empty collections which are about to be bulk loaded, computes split points for
+     * 'numInitialChunks' chunks of roughly equal size from a sample of the documents to be loaded,
+     * so that the chunks can be distributed across the shards before any data arrives. The split
+     * points are the shard key values found at evenly spaced positions of the sorted sample, with
+     * duplicates removed, so fewer chunks may be produced when the sample has few distinct keys.
+     * If 'numInitialChunks' is not positive, two chunks per shard are produced.
+     *
+     * Throws ShardKeyNotFound if a sampled document does not contain the full shard key.
+     */
+    static std::vector<BSONObj> calculateSplitPointsFromSample(
+        const ShardKeyPattern& shardKeyPattern,
+        const std::vector<BSONObj>& sample,
+        int numShards,
+        int numInitialChunks);
+
     struct ShardCollectionConfig {
         std::vector<ChunkType> chunks;
 
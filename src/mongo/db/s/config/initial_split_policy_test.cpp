@@ -143,6 +143,53 @@ TEST(CalculateHashedSplitPointsTest, NotHashedWithInitialSplitsFails) {
                        ErrorCodes::InvalidOptions);
 }
 
+/**
+ * Returns a sample of documents {_id: i, x: i % numDistinctKeys} for i in [0, sampleSize).
+ */
+std::vector<BSONObj> makeSample(int sampleSize, int numDistinctKeys) {
+    std::vector<BSONObj> sample;
+    for (int i = 0; i < sampleSize; i++) {
+        sample.push_back(BSON("_id" << i << "x" << i % numDistinctKeys));
+    }
+    return sample;
+}
+
+TEST(CalculateSplitPointsFromSampleTest, SplitPointsAreEvenlySpacedInSample) {
+    const std::vector<BSONObj> expectedSplitPoints = {
+        BSON("x" << 25), BSON("x" << 50), BSON("x" << 75)};
+    assertBSONObjVectorsAreEqual(expectedSplitPoints,
+                                 InitialSplitPolicy::calculateSplitPointsFromSample(
+                                     makeShardKeyPattern(false), makeSample(100, 100), 2, 4));
+}
+
+TEST(CalculateSplitPointsFromSampleTest, NumInitialChunksZeroCreatesTwoChunksPerShard) {
+    const std::vector<BSONObj> expectedSplitPoints = {
+        BSON("x" << 25), BSON("x" << 50), BSON("x" << 75)};
+    assertBSONObjVectorsAreEqual(expectedSplitPoints,
+                                 InitialSplitPolicy::calculateSplitPointsFromSample(
+                                     makeShardKeyPattern(false), makeSample(100, 100), 2, 0));
+}
+
+TEST(CalculateSplitPointsFromSampleTest, DuplicateKeysProduceFewerSplitPoints) {
+    const std::vector<BSONObj> expectedSplitPoints = {BSON("x" << 1)};
+    assertBSONObjVectorsAreEqual(expectedSplitPoints,
+                                 InitialSplitPolicy::calculateSplitPointsFromSample(
+                                     makeShardKeyPattern(false), makeSample(100, 2), 2, 4));
+}
+
+TEST(CalculateSplitPointsFromSampleTest, EmptySampleProducesNoSplitPoints) {
+    ASSERT(InitialSplitPolicy::calculateSplitPointsFromSample(
+               makeShardKeyPattern(false), std::vector<BSONObj>(), 2, 4)
+               .empty());
+}
+
+TEST(CalculateSplitPointsFromSampleTest, SampleDocumentWithoutShardKeyFails) {
+    ASSERT_THROWS_CODE(InitialSplitPolicy::calculateSplitPointsFromSample(
+                           makeShardKeyPattern(false), {BSON("_id" << 0 << "y" << 1)}, 2, 4),
+                       AssertionException,
+                       ErrorCodes::ShardKeyNotFound);
+}
+
 class GenerateInitialSplitChunksTest : public unittest::Test {
 public:
     /**
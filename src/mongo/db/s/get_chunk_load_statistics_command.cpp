@@ -0,0 +1,114 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kSharding
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/auth/action_set.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/auth/resource_pattern.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/s/chunk_load_statistics.h"
+#include "mongo/db/s/sharding_state.h"
+
+namespace mongo {
+namespace {
+
+// Number of chunks per collection to report if the caller does not specify it
+const long long kDefaultMaxChunksPerCollection = 10;
+
+/**
+ * Internal sharding command run by the balancer on the shard primaries to obtain the load each of
+ * them served since the previous invocation. The format is:
+ *
+ *   {
+ *     _shardsvrGetChunkLoadStatistics: 1,
+ *     maxChunksPerCollection: <number of the most written chunks to report for each collection>
+ *   }
+ */
+class GetChunkLoadStatisticsCommand : public BasicCommand {
+public:
+    GetChunkLoadStatisticsCommand() : BasicCommand("_shardsvrGetChunkLoadStatistics") {}
+
+    std::string help() const override {
+        return "Internal command, which is exported by the sharding servers. Do not call "
+               "directly. Reports the load served by this shard since it was last called.";
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kNever;
+    }
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override {
+        if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
+                ResourcePattern::forClusterResource(), ActionType::internal)) {
+            return Status(ErrorCodes::Unauthorized, "Unauthorized");
+        }
+
+        return Status::OK();
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        uassertStatusOK(ShardingState::get(opCtx)->canAcceptShardedCommands());
+
+        long long maxChunksPerCollection = kDefaultMaxChunksPerCollection;
+        if (auto maxChunksElem = cmdObj["maxChunksPerCollection"]) {
+            uassert(ErrorCodes::TypeMismatch,
+                    "maxChunksPerCollection must be a number",
+                    maxChunksElem.isNumber());
+            maxChunksPerCollection = maxChunksElem.safeNumberLong();
+            uassert(ErrorCodes::BadValue,
+                    "maxChunksPerCollection must not be negative",
+                    maxChunksPerCollection >= 0);
+        }
+
+        ChunkLoadStatistics::get(opCtx).reportAndReset(
+            &result,
+            opCtx->getServiceContext()->getFastClockSource()->now(),
+            static_cast<size_t>(maxChunksPerCollection));
+        return true;
+    }
+
+} getChunkLoadStatisticsCmd;
+
+}  // namespace
+}  // namespace mongo
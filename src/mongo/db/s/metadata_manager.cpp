@@ -38,6 +38,7 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/range_arithmetic.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/s/grid.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
@@ -108,6 +109,17 @@
 //  new entries are pushed onto the back, popped off the front.
 
 namespace mongo {
+
+// Maximum number of documents the range deleter removes before yielding the collection lock and
+// pausing for rangeDeleterBatchDelayMS. Zero means internalQueryExecYieldIterations.
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterBatchSize, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue, "rangeDeleterBatchSize must not be negative");
+        }
+        return Status::OK();
+    });
+
 namespace {
 
 using TaskExecutor = executor::TaskExecutor;
@@ -147,7 +159,9 @@ void scheduleCleanup(executor::TaskExecutor* executor,
             auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
             auto opCtx = uniqueOpCtx.get();
 
-            const int maxToDelete = std::max(int(internalQueryExecYieldIterations.load()), 1);
+            const int batchSize = rangeDeleterBatchSize.load();
+            const int maxToDelete =
+                std::max(batchSize ? batchSize : int(internalQueryExecYieldIterations.load()), 1);
 
             MONGO_FAIL_POINT_PAUSE_WHILE_SET(suspendRangeDeletion);
 
@@ -41,6 +41,7 @@
 #include "mongo/db/s/active_migrations_registry.h"
 #include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/migration_chunk_cloner_source_legacy.h"
+#include "mongo/db/s/migration_clone_throttle.h"
 #include "mongo/db/s/migration_source_manager.h"
 #include "mongo/db/write_concern.h"
 
@@ -52,41 +53,45 @@ namespace {
 
 /**
  * Shortcut class to perform the appropriate checks and acquire the cloner associated with the
- * currently active migration. Uses the currently registered migration for this shard and ensures
- * the session ids match.
+ * currently active migration. Uses the migrations currently registered for this shard and picks the
+ * one whose session id matches.
  */
 class AutoGetActiveCloner {
     MONGO_DISALLOW_COPYING(AutoGetActiveCloner);
 
 public:
     AutoGetActiveCloner(OperationContext* opCtx, const MigrationSessionId& migrationSessionId) {
-        const auto nss = ActiveMigrationsRegistry::get(opCtx).getActiveDonateChunkNss();
-        uassert(ErrorCodes::NotYetInitialized, "No active migrations were found", nss);
-
-        // Once the collection is locked, the migration status cannot change
-        _autoColl.emplace(opCtx, *nss, MODE_IS);
-
-        uassert(ErrorCodes::NamespaceNotFound,
-                str::stream() << "Collection " << nss->ns() << " does not exist",
-                _autoColl->getCollection());
-
-        if (auto msm = MigrationSourceManager::get(CollectionShardingRuntime::get(opCtx, *nss))) {
-            // It is now safe to access the cloner
-            _chunkCloner = dynamic_cast<MigrationChunkClonerSourceLegacy*>(msm->getCloner());
-            invariant(_chunkCloner);
+        const auto namespaces =
+            ActiveMigrationsRegistry::get(opCtx).getActiveDonateChunkNamespaces();
+        uassert(
+            ErrorCodes::NotYetInitialized, "No active migrations were found", !namespaces.empty());
+
+        for (const auto& nss : namespaces) {
+            // Once the collection is locked, the migration status cannot change
+            _autoColl.emplace(opCtx, nss, MODE_IS);
+
+            if (_autoColl->getCollection()) {
+                if (auto msm =
+                        MigrationSourceManager::get(CollectionShardingRuntime::get(opCtx, nss))) {
+                    // It is now safe to access the cloner
+                    auto chunkCloner =
+                        dynamic_cast<MigrationChunkClonerSourceLegacy*>(msm->getCloner());
+                    invariant(chunkCloner);
+
+                    if (migrationSessionId.matches(chunkCloner->getSessionId())) {
+                        _chunkCloner = chunkCloner;
+                        return;
+                    }
+                }
+            }
 
-        } else {
-            uasserted(ErrorCodes::IllegalOperation,
-                      str::stream() << "No active migrations were found for collection "
-                                    << nss->ns());
+            _autoColl.reset();
         }
 
-        // Ensure the session ids are correct
-        uassert(ErrorCodes::IllegalOperation,
-                str::stream() << "Requested migration session id " << migrationSessionId.toString()
-                              << " does not match active session id "
-                              << _chunkCloner->getSessionId().toString(),
-                migrationSessionId.matches(_chunkCloner->getSessionId()));
+        uasserted(ErrorCodes::IllegalOperation,
+                  str::stream() << "Requested migration session id "
+                                << migrationSessionId.toString()
+                                << " does not match any active migration");
     }
 
     Database* getDb() const {
@@ -109,7 +114,7 @@ private:
     boost::optional<AutoGetCollection> _autoColl;
 
     // Contains the active cloner for the namespace
-    MigrationChunkClonerSourceLegacy* _chunkCloner;
+    MigrationChunkClonerSourceLegacy* _chunkCloner{nullptr};
 };
 
 class InitialCloneCommand : public BasicCommand {
@@ -167,6 +172,17 @@ public:
         }
 
         invariant(arrBuilder);
+
+        // Wait for the throttle outside of the collection lock, so that the cloned documents are
+        // returned to the recipient at the rate configured for all migrations together
+        const auto throttleWait = MigrationCloneThrottle::get(opCtx).reserve(
+            arrBuilder->len(),
+            opCtx->getServiceContext()->getFastClockSource()->now(),
+            migrationCloneMaxBytesPerSec.load());
+        if (throttleWait > Milliseconds(0)) {
+            opCtx->sleepFor(throttleWait);
+        }
+
         result.appendArray("objects", arrBuilder->arr());
 
         return true;
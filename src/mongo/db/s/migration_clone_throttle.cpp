@@ -0,0 +1,81 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/migration_clone_throttle.h"
+
+#include <algorithm>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getMigrationCloneThrottle = ServiceContext::declareDecoration<MigrationCloneThrottle>();
+
+}  // namespace
+
+MONGO_EXPORT_SERVER_PARAMETER(migrationCloneMaxBytesPerSec, long long, 0)
+    ->withValidator([](const long long& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue, "migrationCloneMaxBytesPerSec must be >= 0");
+        }
+        return Status::OK();
+    });
+
+MigrationCloneThrottle::MigrationCloneThrottle() = default;
+
+MigrationCloneThrottle& MigrationCloneThrottle::get(ServiceContext* serviceContext) {
+    return getMigrationCloneThrottle(serviceContext);
+}
+
+MigrationCloneThrottle& MigrationCloneThrottle::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+Milliseconds MigrationCloneThrottle::reserve(long long bytes,
+                                             Date_t now,
+                                             long long maxBytesPerSec) {
+    if (maxBytesPerSec <= 0) {
+        return Milliseconds(0);
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    // Bytes which were not used while no migration was cloning are not saved up, so that the
+    // throttle never allows a burst above the configured rate
+    const Date_t start = std::max(now, _nextAvailable);
+    _nextAvailable = start + Milliseconds(bytes * 1000 / maxBytesPerSec);
+
+    return start - now;
+}
+
+}  // namespace mongo
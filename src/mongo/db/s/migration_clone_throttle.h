@@ -0,0 +1,74 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+// Maximum rate in bytes per second at which all the chunk migrations donated by this shard together
+// may clone documents. Zero means unlimited.
+extern AtomicInt64 migrationCloneMaxBytesPerSec;
+
+/**
+ * Throttles the initial cloning of the chunks donated by this shard, so that running several
+ * migrations concurrently does not take more of the shard's I/O than configured. The throttle is
+ * shared by all the outbound migrations and there is only one instance of it per shard.
+ */
+class MigrationCloneThrottle {
+    MONGO_DISALLOW_COPYING(MigrationCloneThrottle);
+
+public:
+    MigrationCloneThrottle();
+
+    static MigrationCloneThrottle& get(ServiceContext* serviceContext);
+    static MigrationCloneThrottle& get(OperationContext* opCtx);
+
+    /**
+     * Accounts for a clone batch of 'bytes', which was read at 'now', and returns how long the
+     * caller must wait before returning it to the recipient in order to stay within
+     * 'maxBytesPerSec' across all migrations. Returns zero if 'maxBytesPerSec' is not positive.
+     */
+    Milliseconds reserve(long long bytes, Date_t now, long long maxBytesPerSec);
+
+private:
+    // Protects the state below
+    stdx::mutex _mutex;
+
+    // The time at which the throttle will have paid for all the bytes reserved so far
+    Date_t _nextAvailable;
+};
+
+}  // namespace mongo
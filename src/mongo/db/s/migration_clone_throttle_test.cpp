@@ -0,0 +1,68 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/migration_clone_throttle.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(MigrationCloneThrottle, UnlimitedRateNeverWaits) {
+    MigrationCloneThrottle throttle;
+    const Date_t now = Date_t::now();
+
+    ASSERT_EQ(Milliseconds(0), throttle.reserve(1024 * 1024, now, 0));
+    ASSERT_EQ(Milliseconds(0), throttle.reserve(1024 * 1024, now, 0));
+}
+
+TEST(MigrationCloneThrottle, BatchesWaitForThePreviousOnes) {
+    MigrationCloneThrottle throttle;
+    const Date_t now = Date_t::now();
+
+    // The first batch is free, but delays the next ones by the time it takes to pay for it
+    ASSERT_EQ(Milliseconds(0), throttle.reserve(1000, now, 1000));
+    ASSERT_EQ(Milliseconds(1000), throttle.reserve(500, now, 1000));
+    ASSERT_EQ(Milliseconds(1500), throttle.reserve(1000, now, 1000));
+
+    // Time which passed counts towards the wait
+    ASSERT_EQ(Milliseconds(500), throttle.reserve(1000, now + Seconds(2), 1000));
+}
+
+TEST(MigrationCloneThrottle, IdleTimeIsNotSavedUp) {
+    MigrationCloneThrottle throttle;
+    const Date_t now = Date_t::now();
+
+    ASSERT_EQ(Milliseconds(0), throttle.reserve(1000, now, 1000));
+    ASSERT_EQ(Milliseconds(0), throttle.reserve(1000, now + Seconds(10), 1000));
+    ASSERT_EQ(Milliseconds(1000), throttle.reserve(1000, now + Seconds(10), 1000));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -53,6 +53,7 @@
 #include "mongo/db/s/move_timing_helper.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/start_chunk_clone_request.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/client/shard_registry.h"
@@ -67,6 +68,16 @@
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
+
+// Number of clone batches, which the recipient fetches from the donor ahead of inserting them
+MONGO_EXPORT_SERVER_PARAMETER(migrateCloneBatchQueueDepth, int, 2)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1) {
+            return Status(ErrorCodes::BadValue, "migrateCloneBatchQueueDepth must be >= 1");
+        }
+        return Status::OK();
+    });
+
 namespace {
 
 const auto getMigrationDestinationManager =
@@ -378,7 +389,7 @@ void MigrationDestinationManager::cloneDocumentsFromDonor(
     stdx::function<void(OperationContext*, BSONObj)> insertBatchFn,
     stdx::function<BSONObj(OperationContext*)> fetchBatchFn) {
 
-    ProducerConsumerQueue<BSONObj> batches(1);
+    ProducerConsumerQueue<BSONObj> batches(migrateCloneBatchQueueDepth.load());
     stdx::thread inserterThread{[&] {
         Client::initThreadIfNotAlready("chunkInserter");
         auto inserterOpCtx = Client::getCurrent()->makeOperationContext();
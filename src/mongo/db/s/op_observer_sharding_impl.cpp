@@ -30,6 +30,7 @@
 
 #include "mongo/db/s/op_observer_sharding_impl.h"
 
+#include "mongo/db/s/chunk_load_statistics.h"
 #include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/migration_source_manager.h"
 
@@ -66,6 +67,8 @@ void OpObserverShardingImpl::shardObserveInsertOp(OperationContext* opCtx,
         if (msm) {
             msm->getCloner()->onInsertOp(opCtx, insertedDoc, opTime);
         }
+
+        ChunkLoadStatistics::get(opCtx).recordWrite(opCtx, nss, insertedDoc);
     }
 }
 
@@ -80,6 +83,8 @@ void OpObserverShardingImpl::shardObserveUpdateOp(OperationContext* opCtx,
     if (msm) {
         msm->getCloner()->onUpdateOp(opCtx, updatedDoc, opTime, prePostImageOpTime);
     }
+
+    ChunkLoadStatistics::get(opCtx).recordWrite(opCtx, nss, updatedDoc);
 }
 
 void OpObserverShardingImpl::shardObserveDeleteOp(OperationContext* opCtx,
@@ -94,6 +99,8 @@ void OpObserverShardingImpl::shardObserveDeleteOp(OperationContext* opCtx,
     if (msm && isMigrating) {
         msm->getCloner()->onDeleteOp(opCtx, documentKey, opTime, preImageOpTime);
     }
+
+    ChunkLoadStatistics::get(opCtx).recordWrite(opCtx, nss, documentKey);
 }
 
 }  // namespace mongo
@@ -0,0 +1,458 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kSharding
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/resharding_recipient.h"
+
+#include <set>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/catalog/document_validation.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbhelpers.h"
+#include "mongo/db/ops/delete.h"
+#include "mongo/db/ops/write_ops_exec.h"
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/db/query/getmore_request.h"
+#include "mongo/db/repl/optime.h"
+#include "mongo/db/s/migration_destination_manager.h"
+#include "mongo/db/s/sharding_state.h"
+#include "mongo/s/catalog_cache.h"
+#include "mongo/s/client/shard_registry.h"
+#include "mongo/s/grid.h"
+#include "mongo/stdx/functional.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kRsOplogNamespace("local.oplog.rs");
+
+// How long to wait for the oplog of a donor to reach the timestamp it must be applied up to
+const Milliseconds kFetchUpToRetryInterval(10);
+
+/**
+ * Runs a cursor command on the primary of 'shard'. The getMore commands must be run on the same
+ * host as the command which established the cursor, so they are not retried.
+ */
+std::pair<BSONObj, CursorResponse> runCursorCommand(OperationContext* opCtx,
+                                                    const std::shared_ptr<Shard>& shard,
+                                                    const NamespaceString& nss,
+                                                    const BSONObj& cmdObj,
+                                                    Shard::RetryPolicy retryPolicy) {
+    auto swResponse = shard->runCommand(opCtx,
+                                        ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+                                        nss.db().toString(),
+                                        cmdObj,
+                                        retryPolicy);
+    uassertStatusOKWithContext(Shard::CommandResponse::getEffectiveStatus(swResponse),
+                               str::stream() << "Failed to read " << nss.ns() << " from "
+                                             << shard->getId());
+
+    // The entries of the batch point into the response, which must outlive them
+    auto response = std::move(swResponse.getValue().response);
+    auto cursorResponse = uassertStatusOK(CursorResponse::parseFromBSON(response));
+    return {std::move(response), std::move(cursorResponse)};
+}
+
+/**
+ * Passes each batch of the results of the cursor established by 'cmdObj' on 'shard' to 'callback'.
+ */
+void forEachBatch(OperationContext* opCtx,
+                  const std::shared_ptr<Shard>& shard,
+                  const NamespaceString& nss,
+                  const BSONObj& cmdObj,
+                  const stdx::function<void(const std::vector<BSONObj>&)>& callback) {
+    auto response = runCursorCommand(opCtx, shard, nss, cmdObj, Shard::RetryPolicy::kIdempotent);
+
+    while (true) {
+        callback(response.second.getBatch());
+
+        const auto cursorId = response.second.getCursorId();
+        if (cursorId == 0) {
+            return;
+        }
+
+        const GetMoreRequest getMore(
+            nss, cursorId, boost::none, boost::none, boost::none, boost::none);
+        response =
+            runCursorCommand(opCtx, shard, nss, getMore.toBSON(), Shard::RetryPolicy::kNoRetry);
+    }
+}
+
+/**
+ * Reads with local read concern, after the latest writes up to 'clusterTime' became visible and
+ * the prepared transactions writing the documents read were committed or aborted.
+ */
+BSONObj makeReadConcernAfterClusterTime(Timestamp clusterTime) {
+    return BSON("level"
+                << "local"
+                << "afterClusterTime"
+                << clusterTime);
+}
+
+/**
+ * Returns the timestamp of the latest write majority committed on 'donor'. All the writes before
+ * it are committed, so reading the documents of the donor after it and applying its oplog from it
+ * sees every write.
+ */
+Timestamp getMajorityCommittedTimestamp(OperationContext* opCtx,
+                                        const std::shared_ptr<Shard>& donor) {
+    auto response = uassertStatusOK(
+        donor->runCommand(opCtx,
+                          ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+                          "admin",
+                          BSON("isMaster" << 1),
+                          Shard::RetryPolicy::kIdempotent));
+    uassertStatusOK(response.commandStatus);
+
+    const auto majorityOpTime = response.response["lastWrite"]["majorityOpTime"];
+    uassert(ErrorCodes::InternalError,
+            str::stream() << "Shard " << donor->getId()
+                          << " did not report its majority committed optime",
+            majorityOpTime.isABSONObj());
+    return repl::OpTime::parse(majorityOpTime.Obj()).getTimestamp();
+}
+
+/**
+ * Selects the oplog entries after 'resumeFrom' which write to 'nss', directly or within an
+ * applyOps.
+ */
+BSONObj makeOplogFilter(const NamespaceString& nss, Timestamp resumeFrom) {
+    return BSON("ts" << BSON("$gt" << resumeFrom) << "$or"
+                     << BSON_ARRAY(BSON("ns" << nss.ns()) << BSON("o.applyOps.ns" << nss.ns())));
+}
+
+}  // namespace
+
+ReshardingRecipient::ReshardingRecipient(OperationContext* opCtx,
+                                         NamespaceString sourceNss,
+                                         NamespaceString tempNss)
+    : _sourceNss(std::move(sourceNss)),
+      _tempNss(std::move(tempNss)),
+      _shardId(ShardingState::get(opCtx)->shardId()) {
+    const auto catalogCache = Grid::get(opCtx)->catalogCache();
+
+    _sourceChunkManager =
+        uassertStatusOK(catalogCache->getCollectionRoutingInfoWithRefresh(opCtx, _sourceNss)).cm();
+    uassert(ErrorCodes::NamespaceNotSharded,
+            str::stream() << "Collection " << _sourceNss.ns() << " is not sharded",
+            _sourceChunkManager);
+
+    _tempChunkManager =
+        uassertStatusOK(catalogCache->getCollectionRoutingInfoWithRefresh(opCtx, _tempNss)).cm();
+    uassert(ErrorCodes::NamespaceNotSharded,
+            str::stream() << "Collection " << _tempNss.ns() << " is not sharded",
+            _tempChunkManager);
+
+    std::set<ShardId> donors;
+    _sourceChunkManager->getAllShardIds(&donors);
+    for (const auto& donor : donors) {
+        _resumeFrom.emplace(donor, Timestamp());
+    }
+}
+
+ReshardingRecipient::~ReshardingRecipient() = default;
+
+void ReshardingRecipient::cloneFromDonors(OperationContext* opCtx) {
+    const auto shardRegistry = Grid::get(opCtx)->shardRegistry();
+
+    for (auto& donorAndResumeFrom : _resumeFrom) {
+        const auto donor =
+            uassertStatusOK(shardRegistry->getShard(opCtx, donorAndResumeFrom.first));
+        const auto startTimestamp = getMajorityCommittedTimestamp(opCtx, donor);
+
+        // Only the documents the donor owns are returned, since the shard version is attached
+        BSONObjBuilder findCmdBuilder;
+        findCmdBuilder.append("find", _sourceNss.coll());
+        findCmdBuilder.append("readConcern", makeReadConcernAfterClusterTime(startTimestamp));
+        _sourceChunkManager->getVersion(donor->getId()).appendToCommand(&findCmdBuilder);
+        const auto findCmd = findCmdBuilder.obj();
+
+        boost::optional<CursorId> cursorId;
+        auto fetchBatchFn = [&](OperationContext* opCtx) {
+            BSONArrayBuilder objects;
+            while (objects.arrSize() == 0 && (!cursorId || *cursorId != 0)) {
+                auto response = cursorId
+                    ? runCursorCommand(opCtx,
+                                       donor,
+                                       _sourceNss,
+                                       GetMoreRequest(_sourceNss,
+                                                      *cursorId,
+                                                      boost::none,
+                                                      boost::none,
+                                                      boost::none,
+                                                      boost::none)
+                                           .toBSON(),
+                                       Shard::RetryPolicy::kNoRetry)
+                    : runCursorCommand(
+                          opCtx, donor, _sourceNss, findCmd, Shard::RetryPolicy::kIdempotent);
+
+                cursorId = response.second.getCursorId();
+                for (const auto& doc : response.second.getBatch()) {
+                    objects.append(doc);
+                }
+            }
+
+            return BSON("objects" << objects.arr());
+        };
+
+        auto insertBatchFn = [&](OperationContext* opCtx, BSONObj arr) {
+            DisableDocumentValidation validationDisabler(opCtx);
+
+            write_ops::Insert insertOp(_tempNss);
+            insertOp.getWriteCommandBase().setOrdered(true);
+            insertOp.setDocuments([&] {
+                std::vector<BSONObj> toInsert;
+                for (const auto& doc : arr) {
+                    if (_ownsDocument(doc.Obj())) {
+                        toInsert.push_back(doc.Obj());
+                    }
+                }
+                return toInsert;
+            }());
+
+            if (insertOp.getDocuments().empty()) {
+                return;
+            }
+
+            const WriteResult reply = performInserts(opCtx, insertOp, true);
+            for (size_t i = 0; i < reply.results.size(); ++i) {
+                uassertStatusOKWithContext(reply.results[i],
+                                           str::stream() << "Insert of "
+                                                         << redact(insertOp.getDocuments()[i])
+                                                         << " failed.");
+            }
+
+            _numDocumentsCloned += insertOp.getDocuments().size();
+        };
+
+        MigrationDestinationManager::cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
+
+        donorAndResumeFrom.second = startTimestamp;
+
+        LOG(0) << "Cloned " << _sourceNss << " from " << donor->getId() << " into " << _tempNss
+               << ", it will be caught up from " << startTimestamp.toString();
+    }
+}
+
+long long ReshardingRecipient::applyDonorOplogs(OperationContext* opCtx, const BSONObj& fetchUpTo) {
+    const auto shardRegistry = Grid::get(opCtx)->shardRegistry();
+
+    long long numApplied = 0;
+    for (auto& donorAndResumeFrom : _resumeFrom) {
+        const auto donor =
+            uassertStatusOK(shardRegistry->getShard(opCtx, donorAndResumeFrom.first));
+        auto& resumeFrom = donorAndResumeFrom.second;
+
+        const auto fetchUpToElem = fetchUpTo[donor->getId().toString()];
+
+        while (true) {
+            forEachBatch(opCtx,
+                         donor,
+                         kRsOplogNamespace,
+                         BSON("find" << kRsOplogNamespace.coll() << "filter"
+                                     << makeOplogFilter(_sourceNss, resumeFrom)
+                                     << "oplogReplay"
+                                     << true),
+                         [&](const std::vector<BSONObj>& batch) {
+                             if (batch.empty()) {
+                                 return;
+                             }
+
+                             numApplied += _applyOplogEntries(opCtx, donor, batch);
+                             resumeFrom = batch.back()["ts"].timestamp();
+                         });
+
+            // The write made by the donor upon entering the critical section is to the source
+            // collection, so it is returned once all the writes before it become visible
+            if (fetchUpToElem.eoo() || resumeFrom >= fetchUpToElem.timestamp()) {
+                break;
+            }
+
+            opCtx->sleepFor(kFetchUpToRetryInterval);
+        }
+    }
+
+    return numApplied;
+}
+
+BSONObj ReshardingRecipient::getResumeFrom() const {
+    BSONObjBuilder builder;
+    for (const auto& donorAndResumeFrom : _resumeFrom) {
+        builder.append(donorAndResumeFrom.first.toString(), donorAndResumeFrom.second);
+    }
+    return builder.obj();
+}
+
+void ReshardingRecipient::setResumeFrom(const BSONObj& resumeFrom) {
+    for (auto& donorAndResumeFrom : _resumeFrom) {
+        const auto elem = resumeFrom[donorAndResumeFrom.first.toString()];
+        uassert(ErrorCodes::BadValue,
+                str::stream() << "Missing the timestamp reached in the oplog of shard "
+                              << donorAndResumeFrom.first,
+                elem.type() == bsonTimestamp);
+        donorAndResumeFrom.second = elem.timestamp();
+    }
+}
+
+std::vector<BSONObj> ReshardingRecipient::getDocumentIdsWrittenByOplogEntry(
+    const NamespaceString& nss, const BSONObj& oplogEntry) {
+    std::vector<BSONObj> ids;
+    if (oplogEntry["fromMigrate"].trueValue()) {
+        return ids;
+    }
+
+    const auto op = oplogEntry["op"].str();
+    if (op == "c") {
+        const auto applyOps = oplogEntry["o"]["applyOps"];
+        if (applyOps.type() == Array) {
+            for (const auto& innerEntry : applyOps.Obj()) {
+                if (innerEntry.type() != Object) {
+                    continue;
+                }
+                auto innerIds = getDocumentIdsWrittenByOplogEntry(nss, innerEntry.Obj());
+                ids.insert(ids.end(), innerIds.begin(), innerIds.end());
+            }
+        }
+        return ids;
+    }
+
+    if (oplogEntry["ns"].str() != nss.ns()) {
+        return ids;
+    }
+
+    // The updates identify the document in 'o2', the inserts and deletes in 'o'
+    BSONElement id;
+    if (op == "i" || op == "d") {
+        id = oplogEntry["o"]["_id"];
+    } else if (op == "u") {
+        id = oplogEntry["o2"]["_id"];
+    }
+
+    if (!id.eoo()) {
+        ids.push_back(id.wrap());
+    }
+
+    return ids;
+}
+
+bool ReshardingRecipient::_ownsDocument(const BSONObj& doc) const {
+    const auto& shardKeyPattern = _tempChunkManager->getShardKeyPattern();
+    const auto shardKey = shardKeyPattern.extractShardKeyFromDoc(doc);
+    uassert(ErrorCodes::ShardKeyNotFound,
+            str::stream() << "Document " << redact(doc) << " does not contain the new shard key "
+                          << shardKeyPattern.toString(),
+            !shardKey.isEmpty());
+
+    return _tempChunkManager->findIntersectingChunkWithSimpleCollation(shardKey).getShardId() ==
+        _shardId;
+}
+
+long long ReshardingRecipient::_applyOplogEntries(OperationContext* opCtx,
+                                                  const std::shared_ptr<Shard>& donor,
+                                                  const std::vector<BSONObj>& oplogEntries) {
+    auto idsToApply = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    for (const auto& entry : oplogEntries) {
+        for (auto& id : getDocumentIdsWrittenByOplogEntry(_sourceNss, entry)) {
+            idsToApply.insert(std::move(id));
+        }
+    }
+
+    if (idsToApply.empty()) {
+        return 0;
+    }
+
+    const auto numIds = static_cast<long long>(idsToApply.size());
+
+    BSONArrayBuilder idValues;
+    for (const auto& id : idsToApply) {
+        idValues.append(id.firstElement());
+    }
+
+    // Rather than replaying the writes, which may move documents between the chunks of the new
+    // shard key, the current version of each document is copied, or removed if it is gone.
+    BSONObjBuilder findCmdBuilder;
+    findCmdBuilder.append("find", _sourceNss.coll());
+    findCmdBuilder.append("filter", BSON("_id" << BSON("$in" << idValues.arr())));
+    findCmdBuilder.append("readConcern",
+                          makeReadConcernAfterClusterTime(oplogEntries.back()["ts"].timestamp()));
+    _sourceChunkManager->getVersion(donor->getId()).appendToCommand(&findCmdBuilder);
+    const auto findCmd = findCmdBuilder.obj();
+
+    DisableDocumentValidation validationDisabler(opCtx);
+
+    forEachBatch(opCtx, donor, _sourceNss, findCmd, [&](const std::vector<BSONObj>& batch) {
+        for (const auto& doc : batch) {
+            const auto id = doc["_id"].wrap();
+            idsToApply.erase(id);
+
+            AutoGetCollection autoColl(opCtx, _tempNss, MODE_IX);
+            uassert(ErrorCodes::NamespaceNotFound,
+                    str::stream() << "Collection " << _tempNss.ns()
+                                  << " was dropped in the middle of the resharding",
+                    autoColl.getCollection());
+
+            if (_ownsDocument(doc)) {
+                Helpers::upsert(opCtx, _tempNss.ns(), doc, true /* fromMigrate */);
+            } else {
+                deleteObjects(opCtx,
+                              autoColl.getCollection(),
+                              _tempNss,
+                              id,
+                              true /* justOne */,
+                              false /* god */,
+                              true /* fromMigrate */);
+            }
+        }
+    });
+
+    for (const auto& id : idsToApply) {
+        AutoGetCollection autoColl(opCtx, _tempNss, MODE_IX);
+        uassert(ErrorCodes::NamespaceNotFound,
+                str::stream() << "Collection " << _tempNss.ns()
+                              << " was dropped in the middle of the resharding",
+                autoColl.getCollection());
+
+        deleteObjects(opCtx,
+                      autoColl.getCollection(),
+                      _tempNss,
+                      id,
+                      true /* justOne */,
+                      false /* god */,
+                      true /* fromMigrate */);
+    }
+
+    return numIds;
+}
+
+}  // namespace mongo
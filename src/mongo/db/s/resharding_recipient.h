@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/timestamp.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/s/shard_id.h"
+
+namespace mongo {
+
+class ChunkManager;
+class OperationContext;
+class Shard;
+
+/**
+ * Copies a collection which is being resharded into the temporary collection sharded by the new
+ * shard key, on a shard which owns chunks of the temporary collection. The documents of every donor
+ * shard, which owns chunks of the collection under its current shard key, are read in turn and the
+ * ones falling in the chunks of the temporary collection owned by this shard are inserted. The
+ * writes made to the collection since are then applied by following the oplogs of the donors.
+ *
+ * No state is kept between commands: the timestamp reached in the oplog of each donor is returned
+ * to the resharding coordinator, which passes it back with the next command.
+ */
+class ReshardingRecipient {
+    MONGO_DISALLOW_COPYING(ReshardingRecipient);
+
+public:
+    ReshardingRecipient(OperationContext* opCtx,
+                        NamespaceString sourceNss,
+                        NamespaceString tempNss);
+    ~ReshardingRecipient();
+
+    /**
+     * Copies the documents owned by this shard under the new shard key from every donor shard.
+     * The oplog of each donor is applied afterwards from the timestamp of the latest write
+     * majority committed on it before its copy started.
+     */
+    void cloneFromDonors(OperationContext* opCtx);
+
+    /**
+     * Applies the writes to the collection found in the oplog of every donor shard after the
+     * timestamp reached for it. For the donors in 'fetchUpTo', waits until their oplog has been
+     * applied up to the given timestamp. Returns the number of writes applied.
+     */
+    long long applyDonorOplogs(OperationContext* opCtx, const BSONObj& fetchUpTo);
+
+    /**
+     * Get/set the timestamp reached in the oplog of each donor shard, by shard name.
+     */
+    BSONObj getResumeFrom() const;
+    void setResumeFrom(const BSONObj& resumeFrom);
+
+    long long getNumDocumentsCloned() const {
+        return _numDocumentsCloned;
+    }
+
+    /**
+     * Returns the _id, in the form {_id: <value>}, of each document of 'nss' written by the
+     * given oplog entry, including the writes within an applyOps. The writes made by chunk
+     * migrations are skipped, since they move orphans rather than change the documents.
+     */
+    static std::vector<BSONObj> getDocumentIdsWrittenByOplogEntry(const NamespaceString& nss,
+                                                                  const BSONObj& oplogEntry);
+
+private:
+    /**
+     * Returns whether the document falls in a chunk of the temporary collection owned by this
+     * shard.
+     */
+    bool _ownsDocument(const BSONObj& doc) const;
+
+    /**
+     * Applies the writes of the given oplog entries of 'donor' by reading the current version of
+     * each written document from the donor, as of the timestamp of the last entry or later.
+     */
+    long long _applyOplogEntries(OperationContext* opCtx,
+                                 const std::shared_ptr<Shard>& donor,
+                                 const std::vector<BSONObj>& oplogEntries);
+
+    const NamespaceString _sourceNss;
+    const NamespaceString _tempNss;
+
+    const ShardId _shardId;
+
+    std::shared_ptr<ChunkManager> _sourceChunkManager;
+    std::shared_ptr<ChunkManager> _tempChunkManager;
+
+    // The timestamp reached in the oplog of each donor shard
+    std::map<ShardId, Timestamp> _resumeFrom;
+
+    long long _numDocumentsCloned{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,145 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/resharding_recipient.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("foo.bar");
+
+void assertIdsEqual(const std::vector<BSONObj>& expected, const std::vector<BSONObj>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(expected[i], actual[i]);
+    }
+}
+
+TEST(ReshardingRecipientTest, CrudOplogEntriesWriteTheirDocument) {
+    assertIdsEqual({BSON("_id" << 1)},
+                   ReshardingRecipient::getDocumentIdsWrittenByOplogEntry(
+                       kNss,
+                       BSON("op"
+                            << "i"
+                            << "ns"
+                            << kNss.ns()
+                            << "o"
+                            << BSON("_id" << 1 << "x" << 1))));
+
+    assertIdsEqual({BSON("_id" << 2)},
+                   ReshardingRecipient::getDocumentIdsWrittenByOplogEntry(
+                       kNss,
+                       BSON("op"
+                            << "u"
+                            << "ns"
+                            << kNss.ns()
+                            << "o"
+                            << BSON("$set" << BSON("x" << 2))
+                            << "o2"
+                            << BSON("_id" << 2))));
+
+    assertIdsEqual({BSON("_id" << 3)},
+                   ReshardingRecipient::getDocumentIdsWrittenByOplogEntry(
+                       kNss,
+                       BSON("op"
+                            << "d"
+                            << "ns"
+                            << kNss.ns()
+                            << "o"
+                            << BSON("_id" << 3))));
+}
+
+TEST(ReshardingRecipientTest, ApplyOpsWritesTheDocumentsOfItsOperationsOnTheNamespace) {
+    assertIdsEqual({BSON("_id" << 1), BSON("_id" << 3)},
+                   ReshardingRecipient::getDocumentIdsWrittenByOplogEntry(
+                       kNss,
+                       BSON("op"
+                            << "c"
+                            << "ns"
+                            << "admin.$cmd"
+                            << "o"
+                            << BSON("applyOps" << BSON_ARRAY(BSON("op"
+                                                                  << "i"
+                                                                  << "ns"
+                                                                  << kNss.ns()
+                                                                  << "o"
+                                                                  << BSON("_id" << 1))
+                                                             << BSON("op"
+                                                                     << "i"
+                                                                     << "ns"
+                                                                     << "foo.other"
+                                                                     << "o"
+                                                                     << BSON("_id" << 2))
+                                                             << BSON("op"
+                                                                     << "d"
+                                                                     << "ns"
+                                                                     << kNss.ns()
+                                                                     << "o"
+                                                                     << BSON("_id" << 3)))))));
+}
+
+TEST(ReshardingRecipientTest, MigrationsNoopsAndOtherNamespacesWriteNoDocuments) {
+    ASSERT(ReshardingRecipient::getDocumentIdsWrittenByOplogEntry(
+               kNss,
+               BSON("op"
+                    << "d"
+                    << "ns"
+                    << kNss.ns()
+                    << "fromMigrate"
+                    << true
+                    << "o"
+                    << BSON("_id" << 1)))
+               .empty());
+
+    ASSERT(ReshardingRecipient::getDocumentIdsWrittenByOplogEntry(
+               kNss,
+               BSON("op"
+                    << "n"
+                    << "ns"
+                    << kNss.ns()
+                    << "o"
+                    << BSON("msg"
+                            << "resharding critical section")))
+               .empty());
+
+    ASSERT(ReshardingRecipient::getDocumentIdsWrittenByOplogEntry(
+               kNss,
+               BSON("op"
+                    << "i"
+                    << "ns"
+                    << "foo.other"
+                    << "o"
+                    << BSON("_id" << 1)))
+               .empty());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -63,6 +63,7 @@
 #include "mongo/s/client/sharding_connection_hook.h"
 #include "mongo/s/config_server_catalog_cache_loader.h"
 #include "mongo/s/grid.h"
+#include "mongo/s/routing_table_change_watcher.h"
 #include "mongo/s/sharding_initialization.h"
 #include "mongo/util/log.h"
 
@@ -131,6 +132,7 @@ void initializeShardingEnvironmentOnShardServer(OperationContext* opCtx,
     ChunkSplitter::get(opCtx).onShardingInitialization(isStandaloneOrPrimary);
     PeriodicBalancerConfigRefresher::get(opCtx).onShardingInitialization(opCtx->getServiceContext(),
                                                                          isStandaloneOrPrimary);
+    RoutingTableChangeWatcher::get(opCtx).startThread();
 
     LOG(0) << "Finished initializing sharding components for "
            << (isStandaloneOrPrimary ? "primary" : "secondary") << " node.";
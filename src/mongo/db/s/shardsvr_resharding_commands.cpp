@@ -0,0 +1,327 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kSharding
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/auth/action_type.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/drop_collection.h"
+#include "mongo/db/catalog/rename_collection.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/op_observer.h"
+#include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/s/collection_sharding_runtime.h"
+#include "mongo/db/s/resharding_recipient.h"
+#include "mongo/db/s/shard_filtering_metadata_refresh.h"
+#include "mongo/db/s/shard_metadata_util.h"
+#include "mongo/db/s/sharding_state.h"
+#include "mongo/s/catalog/type_shard_collection.h"
+#include "mongo/s/request_types/reshard_collection_gen.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+namespace {
+
+Status checkIsInternal(Client* client) {
+    if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
+            ResourcePattern::forClusterResource(), ActionType::internal)) {
+        return Status(ErrorCodes::Unauthorized, "Unauthorized");
+    }
+    return Status::OK();
+}
+
+class ShardsvrReshardingCloneCommand : public BasicCommand {
+public:
+    ShardsvrReshardingCloneCommand() : BasicCommand("_shardsvrReshardingClone") {}
+
+    std::string help() const override {
+        return "Internal command, which is exported by the shards. Do not call directly. Copies "
+               "the documents of a collection being resharded which fall in the chunks owned by "
+               "this shard under the new shard key, and applies the writes to it made since.";
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kNever;
+    }
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return true;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override {
+        return checkIsInternal(client);
+    }
+
+    std::string parseNs(const std::string& dbname, const BSONObj& cmdObj) const override {
+        return CommandHelpers::parseNsFullyQualified(cmdObj);
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        uassertStatusOK(ShardingState::get(opCtx)->canAcceptShardedCommands());
+
+        const auto request = ShardsvrReshardingClone::parse(
+            IDLParserErrorContext("_shardsvrReshardingClone"), cmdObj);
+
+        ReshardingRecipient recipient(
+            opCtx, request.getSourceNs(), request.get_shardsvrReshardingClone());
+
+        if (request.getCloneDocuments()) {
+            recipient.cloneFromDonors(opCtx);
+        } else {
+            uassert(ErrorCodes::InvalidOptions,
+                    "resumeFrom is required unless cloning the documents",
+                    request.getResumeFrom());
+            recipient.setResumeFrom(*request.getResumeFrom());
+        }
+
+        const auto numOplogEntriesApplied = recipient.applyDonorOplogs(
+            opCtx, request.getFetchUpTo().value_or(BSONObj()));
+
+        // The documents are inserted from another thread, so the write concern must wait for the
+        // latest write on this shard
+        repl::ReplClientInfo::forClient(opCtx->getClient()).setLastOpToSystemLastOpTime(opCtx);
+
+        ShardsvrReshardingCloneResponse response;
+        response.setResumeFrom(recipient.getResumeFrom());
+        response.setNumDocumentsCloned(recipient.getNumDocumentsCloned());
+        response.setNumOplogEntriesApplied(numOplogEntriesApplied);
+        response.serialize(&result);
+        return true;
+    }
+
+} shardsvrReshardingCloneCmd;
+
+class ShardsvrReshardingCriticalSectionCommand : public BasicCommand {
+public:
+    ShardsvrReshardingCriticalSectionCommand()
+        : BasicCommand("_shardsvrReshardingCriticalSection") {}
+
+    std::string help() const override {
+        return "Internal command, which is exported by the shards. Do not call directly. Enters, "
+               "commits or aborts the critical section which cuts a collection over to its new "
+               "shard key.";
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kNever;
+    }
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return true;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override {
+        return checkIsInternal(client);
+    }
+
+    std::string parseNs(const std::string& dbname, const BSONObj& cmdObj) const override {
+        return CommandHelpers::parseNsFullyQualified(cmdObj);
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        uassertStatusOK(ShardingState::get(opCtx)->canAcceptShardedCommands());
+
+        const auto request = ShardsvrReshardingCriticalSection::parse(
+            IDLParserErrorContext("_shardsvrReshardingCriticalSection"), cmdObj);
+        const auto& nss = request.get_shardsvrReshardingCriticalSection();
+
+        switch (request.getAction()) {
+            case ReshardingCriticalSectionActionEnum::kEnter:
+                _enter(opCtx, nss, &result);
+                break;
+            case ReshardingCriticalSectionActionEnum::kEnterCommitPhase:
+                _enterCommitPhase(opCtx, nss);
+                break;
+            case ReshardingCriticalSectionActionEnum::kCommit:
+                uassert(ErrorCodes::InvalidOptions,
+                        "collectionUUID is required to commit",
+                        request.getCollectionUUID());
+                _commit(opCtx, nss, request.getTempNs(), *request.getCollectionUUID());
+                break;
+            case ReshardingCriticalSectionActionEnum::kAbort:
+                _exit(opCtx, nss);
+                break;
+        }
+
+        return true;
+    }
+
+private:
+    /**
+     * Blocks the writes to the collection and returns in 'fetchUpTo' the timestamp of an oplog
+     * entry for the collection which follows all the writes made to it.
+     */
+    static void _enter(OperationContext* opCtx,
+                       const NamespaceString& nss,
+                       BSONObjBuilder* result) {
+        boost::optional<UUID> uuid;
+        {
+            AutoGetCollection autoColl(opCtx, nss, MODE_IX, MODE_X);
+            auto* const css = CollectionShardingState::get(opCtx, nss);
+
+            // The coordinator may retry after the critical section was entered
+            if (!css->getCriticalSectionSignal(ShardingMigrationCriticalSection::kWrite)) {
+                css->enterCriticalSectionCatchUpPhase(opCtx);
+            }
+
+            if (autoColl.getCollection()) {
+                uuid = autoColl.getCollection()->uuid();
+            }
+        }
+
+        // Signal to the secondaries that the critical section was entered, as migrations do, so
+        // that their refreshes block behind it
+        uassertStatusOK(shardmetadatautil::updateShardCollectionsEntry(
+            opCtx,
+            BSON(ShardCollectionType::ns() << nss.ns()),
+            BSONObj(),
+            BSON(ShardCollectionType::enterCriticalSectionCounter() << 1),
+            false /* upsert */));
+
+        {
+            AutoGetCollection autoOplog(opCtx, NamespaceString::kRsOplogNamespace, MODE_IX);
+            writeConflictRetry(
+                opCtx, "reshardingCriticalSection", NamespaceString::kRsOplogNamespace.ns(), [&] {
+                    WriteUnitOfWork uow(opCtx);
+                    opCtx->getServiceContext()->getOpObserver()->onInternalOpMessage(
+                        opCtx,
+                        nss,
+                        uuid,
+                        BSON("msg" << (str::stream() << "Resharding " << nss.ns()
+                                                     << " entered its critical section")),
+                        boost::none);
+                    uow.commit();
+                });
+        }
+
+        const auto& lastOp = repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
+        result->append("fetchUpTo", lastOp.getTimestamp());
+    }
+
+    /**
+     * Blocks the reads of the collection before the routing table of the new shard key is
+     * committed. Fails if the critical section was lost since entered, e.g. by a failover, since
+     * the writes made since then may not have been applied by the recipients.
+     */
+    static void _enterCommitPhase(OperationContext* opCtx, const NamespaceString& nss) {
+        AutoGetCollection autoColl(opCtx, nss, MODE_IX, MODE_X);
+        auto* const css = CollectionShardingState::get(opCtx, nss);
+        uassert(ErrorCodes::ConflictingOperationInProgress,
+                str::stream() << "The critical section of resharding " << nss.ns()
+                              << " is no longer held",
+                css->getCriticalSectionSignal(ShardingMigrationCriticalSection::kWrite));
+        css->enterCriticalSectionCommitPhase(opCtx);
+    }
+
+    /**
+     * Once the routing table of the new shard key has been committed, replaces the collection by
+     * the part of the temporary collection owned by this shard, loads the new routing table and
+     * leaves the critical section. Safe to retry.
+     */
+    static void _commit(OperationContext* opCtx,
+                        const NamespaceString& nss,
+                        const NamespaceString& tempNss,
+                        const UUID& uuid) {
+        // Both collections are sharded as far as this shard knows, which renames do not allow,
+        // until their routing tables are loaded again below
+        {
+            AutoGetCollection autoTemp(opCtx, tempNss, MODE_IX, MODE_X);
+            CollectionShardingRuntime::get(opCtx, tempNss)->clearFilteringMetadata();
+        }
+
+        bool alreadyReplaced;
+        {
+            AutoGetCollection autoColl(opCtx, nss, MODE_IX, MODE_X);
+            CollectionShardingRuntime::get(opCtx, nss)->clearFilteringMetadata();
+            alreadyReplaced = autoColl.getCollection() && autoColl.getCollection()->uuid() == uuid;
+        }
+
+        if (!alreadyReplaced) {
+            const bool ownsChunks = [&] {
+                AutoGetCollection autoTemp(opCtx, tempNss, MODE_IS);
+                return bool(autoTemp.getCollection());
+            }();
+
+            if (ownsChunks) {
+                RenameCollectionOptions options;
+                options.dropTarget = true;
+                uassertStatusOK(renameCollection(opCtx, tempNss, nss, options));
+            } else {
+                BSONObjBuilder unusedResult;
+                const auto status = dropCollection(
+                    opCtx,
+                    nss,
+                    unusedResult,
+                    {},
+                    DropCollectionSystemCollectionMode::kDisallowSystemCollectionDrops);
+                if (status != ErrorCodes::NamespaceNotFound) {
+                    uassertStatusOK(status);
+                }
+            }
+        }
+
+        forceShardFilteringMetadataRefresh(opCtx, tempNss, true);
+        forceShardFilteringMetadataRefresh(opCtx, nss, true);
+
+        _exit(opCtx, nss);
+
+        log() << "Resharding of " << nss << " committed on this shard";
+    }
+
+    static void _exit(OperationContext* opCtx, const NamespaceString& nss) {
+        UninterruptibleLockGuard noInterrupt(opCtx->lockState());
+        AutoGetCollection autoColl(opCtx, nss, MODE_IX, MODE_X);
+        CollectionShardingState::get(opCtx, nss)->exitCriticalSection(opCtx);
+    }
+
+} shardsvrReshardingCriticalSectionCmd;
+
+}  // namespace
+}  // namespace mongo
@@ -192,7 +192,7 @@ void createCollectionOrValidateExisting(OperationContext* opCtx,
         // Check 2.i. and 2.ii.
         if (!idx["sparse"].trueValue() && idx["filter"].eoo() && idx["collation"].eoo() &&
             proposedKey.isPrefixOf(currentKey, SimpleBSONElementComparator::kInstance)) {
-            // We can't currently use hashed indexes with a non-default hash seed
+            // We can't currently use hashed indexes with a non-default hash seed or hash version
             // Check v.
             // Note that this means that, for sharding, we only support one hashed index
             // per field per collection.
@@ -204,6 +204,15 @@ void createCollectionOrValidateExisting(OperationContext* opCtx,
                                   << idx["seed"].numberInt(),
                     !shardKeyPattern.isHashedPattern() || idx["seed"].eoo() ||
                         idx["seed"].numberInt() == BSONElementHasher::DEFAULT_HASH_SEED);
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream() << "can't shard collection " << nss.ns()
+                                  << " with hashed shard key "
+                                  << proposedKey
+                                  << " because the hashed index uses hashVersion "
+                                  << idx["hashVersion"].numberInt()
+                                  << ", which hashed shard keys do not support",
+                    !shardKeyPattern.isHashedPattern() ||
+                        idx["hashVersion"].numberInt() == BSONElementHasher::DEFAULT_HASH_VERSION);
             hasUsefulIndexForKey = true;
         }
     }
@@ -403,6 +412,7 @@ void shardCollection(OperationContext* opCtx,
                      const std::vector<BSONObj>& splitPoints,
                      const std::vector<TagsType>& tags,
                      const bool fromMapReduce,
+                     const bool presplitFromSample,
                      const ShardId& dbPrimaryShardId,
                      const int numContiguousChunksPerShard) {
     const auto catalogClient = Grid::get(opCtx)->catalogClient();
@@ -410,7 +420,7 @@ void shardCollection(OperationContext* opCtx,
 
     const auto primaryShard = uassertStatusOK(shardRegistry->getShard(opCtx, dbPrimaryShardId));
     const bool distributeChunks =
-        fromMapReduce || fieldsAndOrder.isHashedPattern() || !tags.empty();
+        fromMapReduce || presplitFromSample || fieldsAndOrder.isHashedPattern() || !tags.empty();
 
     // Fail if there are partially written chunks from a previous failed shardCollection.
     checkForExistingChunks(opCtx, nss);
@@ -670,6 +680,20 @@ public:
             uassert(ErrorCodes::InvalidOptions,
                     str::stream() << "found existing zones but the collection is not empty",
                     isEmpty);
+            uassert(ErrorCodes::InvalidOptions,
+                    "presplitSample is not supported when the collection has zones",
+                    !request.getPresplitSample());
+        } else if (request.getPresplitSample()) {
+            // Distributing the chunks of a collection which already has data would orphan it, so
+            // only an empty collection about to be bulk loaded may be pre-split from a sample.
+            uassert(ErrorCodes::InvalidOptions,
+                    "presplitSample is only supported when the collection is empty",
+                    isEmpty);
+            finalSplitPoints =
+                InitialSplitPolicy::calculateSplitPointsFromSample(shardKeyPattern,
+                                                                   *request.getPresplitSample(),
+                                                                   numShards,
+                                                                   request.getNumInitialChunks());
         } else {
             InitialSplitPolicy::calculateHashedSplitPointsForEmptyCollection(
                 shardKeyPattern,
@@ -692,9 +716,11 @@ public:
         audit::logShardCollection(Client::getCurrent(), nss.ns(), proposedKey, request.getUnique());
 
         // The initial chunks are distributed evenly across shards if the initial split points were
-        // specified in the request by mapReduce or if we are using a hashed shard key. Otherwise,
-        // all the initial chunks are placed on the primary shard.
+        // specified in the request by mapReduce or computed from a presplitSample, or if we are
+        // using a hashed shard key. Otherwise, all the initial chunks are placed on the primary
+        // shard.
         const bool fromMapReduce = bool(request.getInitialSplitPoints());
+        const bool presplitFromSample = bool(request.getPresplitSample());
         const int numContiguousChunksPerShard = initialSplitPoints.empty()
             ? 1
             : (finalSplitPoints.size() + 1) / (initialSplitPoints.size() + 1);
@@ -709,6 +735,7 @@ public:
                         finalSplitPoints,
                         tags,
                         fromMapReduce,
+                        presplitFromSample,
                         ShardingState::get(opCtx)->shardId(),
                         numContiguousChunksPerShard);
 
@@ -43,13 +43,24 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/s/shard_key_pattern.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
+
+// Number of documents in the chunk that sampleSplitVector aims to sample, and the most documents
+// of the collection it draws to find them.
+MONGO_EXPORT_SERVER_PARAMETER(splitVectorSampleSize, int, 1000);
+MONGO_EXPORT_SERVER_PARAMETER(splitVectorMaxSampledDocs, int, 20000);
+
 namespace {
 
 const int kMaxObjectPerChunk{250000};
 
+// Fewer samples in the chunk than this are not enough to estimate its split points.
+const int kMinSamplesInChunk{100};
+
 BSONObj prettyKey(const BSONObj& keyPattern, const BSONObj& key) {
     return key.replaceFieldNames(keyPattern).clientReadable();
 }
@@ -275,4 +286,100 @@ StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
     return splitKeys;
 }
 
+boost::optional<std::vector<BSONObj>> sampleSplitVector(OperationContext* opCtx,
+                                                        const NamespaceString& nss,
+                                                        const BSONObj& keyPattern,
+                                                        const BSONObj& min,
+                                                        const BSONObj& max,
+                                                        long long maxChunkSizeBytes) {
+    AutoGetCollection autoColl(opCtx, nss, MODE_IS);
+
+    Collection* const collection = autoColl.getCollection();
+    if (!collection || maxChunkSizeBytes <= 0) {
+        return boost::none;
+    }
+
+    // The split points have to be usable with the shard key index, so leave it to splitVector to
+    // report when there is none.
+    if (!collection->getIndexCatalog()->findShardKeyPrefixedIndex(opCtx, keyPattern, false)) {
+        return boost::none;
+    }
+
+    const long long recCount = collection->numRecords(opCtx);
+    const long long dataSize = collection->dataSize(opCtx);
+
+    // If there's not enough data for more than one chunk, no point continuing.
+    if (dataSize < maxChunkSizeBytes || recCount == 0) {
+        return std::vector<BSONObj>();
+    }
+
+    // Sampling only pays off when a full chunk holds more documents than may be sampled.
+    const long long avgRecSize = dataSize / recCount;
+    const int maxSampledDocs = splitVectorMaxSampledDocs.load();
+    if (maxChunkSizeBytes / avgRecSize <= maxSampledDocs) {
+        return boost::none;
+    }
+
+    auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    if (!cursor) {
+        return boost::none;
+    }
+
+    // Split at half the max chunk size, as splitVector does.
+    const long long keyCount =
+        std::min<long long>(maxChunkSizeBytes / (2 * avgRecSize), kMaxObjectPerChunk);
+
+    Timer timer;
+    const ShardKeyPattern shardKeyPattern(keyPattern);
+    const int sampleSize = std::max(splitVectorSampleSize.load(), kMinSamplesInChunk);
+    int numSampledDocs = 0;
+    std::vector<BSONObj> sampleKeys;
+    while (static_cast<int>(sampleKeys.size()) < sampleSize && numSampledDocs < maxSampledDocs) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        numSampledDocs++;
+
+        BSONObj key = shardKeyPattern.extractShardKeyFromDoc(record->data.toBson());
+        if (key.isEmpty() || key.woCompare(min) < 0 || key.woCompare(max) >= 0) {
+            continue;
+        }
+        sampleKeys.push_back(key.getOwned());
+    }
+
+    if (static_cast<int>(sampleKeys.size()) < kMinSamplesInChunk) {
+        LOG(1) << "only " << sampleKeys.size() << " of " << numSampledDocs
+               << " sampled documents fall into chunk " << nss.toString() << " " << redact(min)
+               << " -->> " << redact(max) << ", falling back to scanning for split points";
+        return boost::none;
+    }
+
+    // Each document sampled stands for recCount / numSampledDocs documents of the collection, so
+    // a split point falls every keyCount * numSampledDocs / recCount samples in the chunk. Samples
+    // equal to the chunk's min or to the previous split point are skipped, since all the instances
+    // of a given key value live in the same chunk.
+    std::sort(
+        sampleKeys.begin(), sampleKeys.end(), SimpleBSONObjComparator::kInstance.makeLessThan());
+    const double samplesPerSplitPoint =
+        std::max(1.0, static_cast<double>(keyCount) * numSampledDocs / recCount);
+
+    std::vector<BSONObj> splitKeys;
+    for (double next = samplesPerSplitPoint; next < sampleKeys.size();
+         next += samplesPerSplitPoint) {
+        const BSONObj& key = sampleKeys[static_cast<size_t>(next)];
+        if (key.woCompare(min) == 0 ||
+            (!splitKeys.empty() && key.woCompare(splitKeys.back()) == 0)) {
+            continue;
+        }
+        splitKeys.push_back(key);
+    }
+
+    LOG(1) << "estimated " << splitKeys.size() << " split points for chunk " << nss.toString()
+           << " " << redact(min) << " -->> " << redact(max) << " from " << sampleKeys.size()
+           << " of " << numSampledDocs << " sampled documents in " << timer.millis() << "ms";
+
+    return splitKeys;
+}
+
 }  // namespace mongo
@@ -66,4 +66,22 @@ StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
                                              boost::optional<long long> maxChunkSize,
                                              boost::optional<long long> maxChunkSizeBytes);
 
+/**
+ * Estimates the split points of a chunk for chunks of at most maxChunkSizeBytes, like splitVector
+ * does without force, from documents drawn at random from the collection instead of a scan of the
+ * shard key index. The sampled shard key values in the chunk, scaled by the fraction of the samples
+ * that fall into it, stand in for the index entries.
+ *
+ * Returns boost::none if the split points cannot be estimated, because the collection or its shard
+ * key index does not exist, the storage engine has no random cursors, or too few of the samples
+ * fall into the chunk, or should not be, because a full chunk holds fewer documents than would be
+ * sampled. splitVector should then be used instead.
+ */
+boost::optional<std::vector<BSONObj>> sampleSplitVector(OperationContext* opCtx,
+                                                        const NamespaceString& nss,
+                                                        const BSONObj& keyPattern,
+                                                        const BSONObj& min,
+                                                        const BSONObj& max,
+                                                        long long maxChunkSizeBytes);
+
 }  // namespace mongo
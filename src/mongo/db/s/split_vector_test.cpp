@@ -300,5 +300,40 @@ TEST_F(SplitVectorTest, NoMaxChunkSize) {
     ASSERT_EQUALS(status.code(), ErrorCodes::InvalidOptions);
 }
 
+TEST_F(SplitVectorTest, SampleSplitVectorNoSplitWhenCollectionIsSmall) {
+    auto splitKeys = sampleSplitVector(operationContext(),
+                                       kNss,
+                                       BSON(kPattern << 1),
+                                       BSON(kPattern << 0),
+                                       BSON(kPattern << 100),
+                                       getDocSizeBytes() * 200LL);
+    ASSERT(splitKeys);
+    ASSERT_EQ(0UL, splitKeys->size());
+}
+
+TEST_F(SplitVectorTest, SampleSplitVectorFallsBackWithFewDocumentsPerChunk) {
+    ASSERT_FALSE(sampleSplitVector(operationContext(),
+                                   kNss,
+                                   BSON(kPattern << 1),
+                                   BSON(kPattern << 0),
+                                   BSON(kPattern << 100),
+                                   getDocSizeBytes() * 10LL));
+}
+
+TEST_F(SplitVectorTest, SampleSplitVectorFallsBackWithoutCollectionOrIndex) {
+    ASSERT_FALSE(sampleSplitVector(operationContext(),
+                                   NamespaceString("dummy", "collection"),
+                                   BSON(kPattern << 1),
+                                   BSON(kPattern << 0),
+                                   BSON(kPattern << 100),
+                                   getDocSizeBytes() * 10LL));
+    ASSERT_FALSE(sampleSplitVector(operationContext(),
+                                   kNss,
+                                   BSON("foo" << 1),
+                                   BSON(kPattern << 0),
+                                   BSON(kPattern << 100),
+                                   getDocSizeBytes() * 10LL));
+}
+
 }  // namespace
 }  // namespace mongo
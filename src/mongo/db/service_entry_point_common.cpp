@@ -56,6 +56,7 @@
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/logical_session_id_helpers.h"
 #include "mongo/db/logical_time_validator.h"
+#include "mongo/db/op_sample_buffer.h"
 #include "mongo/db/operation_context_session_mongod.h"
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/ops/write_ops_exec.h"
@@ -68,9 +69,11 @@
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/sharded_connection_info.h"
 #include "mongo/db/s/sharding_state.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_entry_point_common.h"
 #include "mongo/db/snapshot_window_util.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/query_shape_stats.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/transaction_validation.h"
@@ -78,6 +81,7 @@
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/rpc/message.h"
 #include "mongo/rpc/metadata.h"
+#include "mongo/rpc/metadata/client_metadata_ismaster.h"
 #include "mongo/rpc/metadata/logical_time_metadata.h"
 #include "mongo/rpc/metadata/oplog_query_metadata.h"
 #include "mongo/rpc/metadata/repl_set_metadata.h"
@@ -85,6 +89,7 @@
 #include "mongo/rpc/op_msg.h"
 #include "mongo/rpc/reply_builder_interface.h"
 #include "mongo/util/fail_point_service.h"
+#include "mongo/util/heap_profiler_attribution.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
 
@@ -98,6 +103,28 @@ MONGO_FAIL_POINT_DEFINE(skipCheckingForNotMasterInCommandDispatch);
 namespace {
 using logger::LogComponent;
 
+// Application names whose commands acquire storage tickets at low priority, so that batch clients
+// yield to interactive ones. See Locker::setLowTicketPriority().
+std::vector<std::string> lowPriorityTicketAppNames;
+ExportedServerParameter<std::vector<std::string>, ServerParameterType::kStartupOnly>
+    lowPriorityTicketAppNamesParam(ServerParameterSet::getGlobal(),
+                                   "lowPriorityTicketAppNames",
+                                   &lowPriorityTicketAppNames);
+
+bool hasLowTicketPriorityAppName(OperationContext* opCtx) {
+    if (lowPriorityTicketAppNames.empty()) {
+        return false;
+    }
+    const auto& clientMetadata =
+        ClientMetadataIsMasterState::get(opCtx->getClient()).getClientMetadata();
+    if (!clientMetadata) {
+        return false;
+    }
+    const auto appName = clientMetadata.get().getApplicationName();
+    return std::find(lowPriorityTicketAppNames.begin(), lowPriorityTicketAppNames.end(), appName) !=
+        lowPriorityTicketAppNames.end();
+}
+
 // The command names for which to check out a session. These are commands that support retryable
 // writes, readConcern snapshot, or multi-statement transactions. We additionally check out the
 // session for commands that can take a lock and then run another whitelisted command in
@@ -398,7 +425,7 @@ void invokeInTransaction(OperationContext* opCtx,
     });
 
     try {
-        invocation->run(opCtx, replyBuilder);
+        invocation->runAsync(opCtx, replyBuilder).get();
     } catch (const ExceptionFor<ErrorCodes::CommandOnShardedViewNotSupportedOnMongod>&) {
         // Exceptions are used to resolve views in a sharded cluster, so they should be handled
         // specially to avoid unnecessary aborts.
@@ -443,7 +470,7 @@ bool runCommandImpl(OperationContext* opCtx,
                     BSONObjBuilder* extraFieldsBuilder,
                     const boost::optional<OperationSessionInfoFromClient>& sessionOptions) {
     const Command* command = invocation->definition();
-    auto bytesToReserve = command->reserveBytesForReply();
+    auto bytesToReserve = command->replyBytesToReserve();
 // SERVER-22100: In Windows DEBUG builds, the CRT heap debugging overhead, in conjunction with the
 // additional memory pressure introduced by reply buffer pre-allocation, causes the concurrency
 // suite to run extremely slowly. As a workaround we do not pre-allocate in Windows DEBUG builds.
@@ -459,7 +486,7 @@ bool runCommandImpl(OperationContext* opCtx,
         if (txnParticipant) {
             invokeInTransaction(opCtx, invocation, txnParticipant, sessionOptions, replyBuilder);
         } else {
-            invocation->run(opCtx, replyBuilder);
+            invocation->runAsync(opCtx, replyBuilder).get();
         }
     } else {
         auto wcResult = uassertStatusOK(extractWriteConcern(opCtx, request.body));
@@ -491,7 +518,7 @@ bool runCommandImpl(OperationContext* opCtx,
                 invokeInTransaction(
                     opCtx, invocation, txnParticipant, sessionOptions, replyBuilder);
             } else {
-                invocation->run(opCtx, replyBuilder);
+                invocation->runAsync(opCtx, replyBuilder).get();
             }
         } catch (const DBException&) {
             waitForWriteConcern(*extraFieldsBuilder);
@@ -579,6 +606,10 @@ void execCommandDatabase(OperationContext* opCtx,
     boost::optional<OperationSessionInfoFromClient> sessionOptions = boost::none;
 
     try {
+        // Charge the memory the command allocates to it, if the heap profiler is enabled.
+        HeapProfilerAttribution heapProfilerAttribution(command->getName(),
+                                                        invocation->ns().ns());
+
         {
             stdx::lock_guard<Client> lk(*opCtx->getClient());
             CurOp::get(opCtx)->setCommand_inlock(command);
@@ -599,6 +630,10 @@ void execCommandDatabase(OperationContext* opCtx,
 
         evaluateFailCommandFailPoint(opCtx, command->getName());
 
+        if (hasLowTicketPriorityAppName(opCtx)) {
+            opCtx->lockState()->setLowTicketPriority(true);
+        }
+
         const auto dbname = request.getDatabase().toString();
         uassert(
             ErrorCodes::InvalidNamespace,
@@ -917,6 +952,7 @@ DbResponse receivedCommands(OperationContext* opCtx,
                             const Message& message,
                             const ServiceEntryPointCommon::Hooks& behaviors) {
     auto replyBuilder = rpc::makeReplyBuilder(rpc::protocolForMessage(message));
+    const Command* command = nullptr;
     [&] {
         OpMsgRequest request;
         try {  // Parse.
@@ -969,6 +1005,7 @@ DbResponse receivedCommands(OperationContext* opCtx,
                 CurOp::get(opCtx)->setLogicalOp_inlock(c->getLogicalOp());
             }
 
+            command = c;
             execCommandDatabase(opCtx, c, request, replyBuilder.get(), behaviors);
         } catch (const DBException& ex) {
             BSONObjBuilder metadataBob;
@@ -997,6 +1034,9 @@ DbResponse receivedCommands(OperationContext* opCtx,
 
     auto response = replyBuilder->done();
     CurOp::get(opCtx)->debug().responseLength = response.header().dataLen();
+    if (command) {
+        command->recordReplySize(response.header().dataLen());
+    }
 
     // TODO exhaust
     return DbResponse{std::move(response)};
@@ -1245,6 +1285,10 @@ DbResponse ServiceEntryPointCommon::handleRequest(OperationContext* opCtx,
         currentOp.setLogicalOp_inlock(networkOpToLogicalOp(op));
     }
 
+    if (!c.isInDirectClient()) {
+        currentOp.setSampledForOpSampleBuffer(OpSampleBuffer::shouldSample(&c));
+    }
+
     OpDebug& debug = currentOp.debug();
 
     boost::optional<long long> slowMsOverride;
@@ -1311,6 +1355,18 @@ DbResponse ServiceEntryPointCommon::handleRequest(OperationContext* opCtx,
             durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses()),
             currentOp.getReadWriteType());
 
+    // Queries which went through the query planner carry the hash of their plan cache key.
+    if (debug.queryHash) {
+        QueryShapeStats::Execution execution;
+        execution.latencyMicros = std::max(debug.executionTimeMicros, 0LL);
+        execution.docsExamined = debug.additiveMetrics.docsExamined.value_or(0);
+        execution.keysExamined = debug.additiveMetrics.keysExamined.value_or(0);
+        execution.nreturned = std::max(debug.nreturned, 0LL);
+        execution.cpuNanos = debug.cpuNanos;
+        QueryShapeStats::get(opCtx->getServiceContext())
+            .record(currentOp.getNS(), *debug.queryHash, execution);
+    }
+
     if (currentOp.shouldDBProfile(shouldSample)) {
         // Performance profiling is on
         if (opCtx->lockState()->isReadLocked()) {
@@ -1329,6 +1385,10 @@ DbResponse ServiceEntryPointCommon::handleRequest(OperationContext* opCtx,
         }
     }
 
+    if (currentOp.isSampledForOpSampleBuffer()) {
+        recordOpSample(opCtx);
+    }
+
     recordCurOpMetrics(opCtx);
     return dbresponse;
 }
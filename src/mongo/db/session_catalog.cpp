@@ -51,16 +51,19 @@ const auto operationSessionDecoration =
 
 }  // namespace
 
+constexpr std::size_t SessionCatalog::kNumPartitions;
+
 SessionCatalog::~SessionCatalog() {
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
-    for (const auto& entry : _sessions) {
-        auto& sri = entry.second;
-        invariant(!sri->checkedOut);
+    auto allPartitions = _sessions.lockAllPartitions();
+    for (const auto& partition : allPartitions) {
+        for (const auto& entry : partition) {
+            auto& sri = entry.second;
+            invariant(!sri->checkedOut);
+        }
     }
 }
 
 void SessionCatalog::reset_forTest() {
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
     _sessions.clear();
 }
 
@@ -78,14 +81,17 @@ ScopedCheckedOutSession SessionCatalog::checkOutSession(OperationContext* opCtx)
     invariant(opCtx->getLogicalSessionId());
 
     const auto lsid = *opCtx->getLogicalSessionId();
+    const auto partitionId = _partitionOf(lsid);
+    auto& partitionState = _partitionStates[partitionId];
 
-    stdx::unique_lock<stdx::mutex> ul(_mutex);
+    auto partition = _sessions.lockOnePartitionById(partitionId);
+    auto& ul = partition.lock();
 
-    while (!_isSessionCheckoutAllowed()) {
-        opCtx->waitForConditionOrInterrupt(_checkingOutSessionsAllowedCond, ul);
+    while (!_isSessionCheckoutAllowed(ul, partitionId)) {
+        opCtx->waitForConditionOrInterrupt(partitionState.checkingOutSessionsAllowedCond, ul);
     }
 
-    auto sri = _getOrCreateSessionRuntimeInfo(ul, opCtx, lsid);
+    auto sri = _getOrCreateSessionRuntimeInfo(partition, opCtx, lsid);
 
     // Wait until the session is no longer checked out
     opCtx->waitForConditionOrInterrupt(
@@ -93,7 +99,7 @@ ScopedCheckedOutSession SessionCatalog::checkOutSession(OperationContext* opCtx)
 
     invariant(!sri->checkedOut);
     sri->checkedOut = true;
-    ++_numCheckedOutSessions;
+    ++partitionState.numCheckedOutSessions;
 
     return ScopedCheckedOutSession(opCtx, ScopedSession(std::move(sri)));
 }
@@ -105,8 +111,8 @@ ScopedSession SessionCatalog::getOrCreateSession(OperationContext* opCtx,
     invariant(!opCtx->getTxnNumber());
 
     auto ss = [&] {
-        stdx::unique_lock<stdx::mutex> ul(_mutex);
-        return ScopedSession(_getOrCreateSessionRuntimeInfo(ul, opCtx, lsid));
+        auto partition = _sessions.lockOnePartition(lsid);
+        return ScopedSession(_getOrCreateSessionRuntimeInfo(partition, opCtx, lsid));
     }();
 
     return ss;
@@ -124,7 +130,9 @@ void SessionCatalog::invalidateSessions(OperationContext* opCtx,
                 !opCtx->getLogicalSessionId());
     }
 
-    const auto invalidateSessionFn = [&](WithLock, SessionRuntimeInfoMap::iterator it) {
+    const auto invalidateSessionFn = [&](WithLock,
+                                         SessionRuntimeInfoMap& sessions,
+                                         SessionRuntimeInfoMap::iterator it) {
         auto& sri = it->second;
         auto const txnParticipant =
             TransactionParticipant::getFromNonCheckedOutSession(&sri->txnState);
@@ -133,24 +141,26 @@ void SessionCatalog::invalidateSessions(OperationContext* opCtx,
         // We cannot remove checked-out sessions from the cache, because operations expect to find
         // them there to check back in
         if (!sri->checkedOut) {
-            _sessions.erase(it);
+            sessions.erase(it);
         }
     };
 
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
-
     if (singleSessionDoc) {
         const auto lsid = LogicalSessionId::parse(IDLParserErrorContext("lsid"),
                                                   singleSessionDoc->getField("_id").Obj());
 
-        auto it = _sessions.find(lsid);
-        if (it != _sessions.end()) {
-            invalidateSessionFn(lg, it);
+        auto partition = _sessions.lockOnePartition(lsid);
+        auto it = partition->find(lsid);
+        if (it != partition->end()) {
+            invalidateSessionFn(partition.lock(), *partition, it);
         }
     } else {
-        auto it = _sessions.begin();
-        while (it != _sessions.end()) {
-            invalidateSessionFn(lg, it++);
+        for (std::size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+            auto partition = _sessions.lockOnePartitionById(partitionId);
+            auto it = partition->begin();
+            while (it != partition->end()) {
+                invalidateSessionFn(partition.lock(), *partition, it++);
+            }
         }
     }
 }
@@ -158,44 +168,51 @@ void SessionCatalog::invalidateSessions(OperationContext* opCtx,
 void SessionCatalog::scanSessions(OperationContext* opCtx,
                                   const SessionKiller::Matcher& matcher,
                                   const ScanSessionsCallbackFn& workerFn) {
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
-
-    LOG(2) << "Beginning scanSessions. Scanning " << _sessions.size() << " sessions.";
-
-    for (auto& sessionEntry : _sessions) {
-        if (matcher.match(sessionEntry.first)) {
-            workerFn(opCtx, &sessionEntry.second->txnState);
+    LOG(2) << "Beginning scanSessions. Scanning " << kNumPartitions << " partitions.";
+
+    // Only one partition is locked at a time, so that checking sessions in and out of the other
+    // partitions can proceed while a partition is being scanned.
+    for (std::size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+        auto partition = _sessions.lockOnePartitionById(partitionId);
+        for (auto& sessionEntry : *partition) {
+            if (matcher.match(sessionEntry.first)) {
+                workerFn(opCtx, &sessionEntry.second->txnState);
+            }
         }
     }
 }
 
 std::shared_ptr<SessionCatalog::SessionRuntimeInfo> SessionCatalog::_getOrCreateSessionRuntimeInfo(
-    WithLock, OperationContext* opCtx, const LogicalSessionId& lsid) {
+    PartitionedSessionRuntimeInfoMap::OnePartition& partition,
+    OperationContext* opCtx,
+    const LogicalSessionId& lsid) {
     invariant(!opCtx->lockState()->inAWriteUnitOfWork());
-    invariant(_isSessionCheckoutAllowed());
+    invariant(_isSessionCheckoutAllowed(partition.lock(), _partitionOf(lsid)));
 
-    auto it = _sessions.find(lsid);
-    if (it == _sessions.end()) {
-        it = _sessions.emplace(lsid, std::make_shared<SessionRuntimeInfo>(lsid)).first;
+    auto it = partition->find(lsid);
+    if (it == partition->end()) {
+        it = partition->emplace(lsid, std::make_shared<SessionRuntimeInfo>(lsid)).first;
     }
 
     return it->second;
 }
 
 void SessionCatalog::_releaseSession(const LogicalSessionId& lsid) {
-    stdx::lock_guard<stdx::mutex> lg(_mutex);
+    const auto partitionId = _partitionOf(lsid);
+    auto& partitionState = _partitionStates[partitionId];
+    auto partition = _sessions.lockOnePartitionById(partitionId);
 
-    auto it = _sessions.find(lsid);
-    invariant(it != _sessions.end());
+    auto it = partition->find(lsid);
+    invariant(it != partition->end());
 
     auto& sri = it->second;
     invariant(sri->checkedOut);
 
     sri->checkedOut = false;
     sri->availableCondVar.notify_one();
-    --_numCheckedOutSessions;
-    if (_numCheckedOutSessions == 0) {
-        _allSessionsCheckedInCond.notify_all();
+    --partitionState.numCheckedOutSessions;
+    if (partitionState.numCheckedOutSessions == 0) {
+        partitionState.allSessionsCheckedInCond.notify_all();
     }
 }
 
@@ -204,30 +221,42 @@ SessionCatalog::PreventCheckingOutSessionsBlock::PreventCheckingOutSessionsBlock
     : _sessionCatalog(sessionCatalog) {
     invariant(sessionCatalog);
 
-    stdx::lock_guard<stdx::mutex> lg(sessionCatalog->_mutex);
-    ++sessionCatalog->_preventSessionCheckoutRequests;
+    for (std::size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+        auto partition = sessionCatalog->_sessions.lockOnePartitionById(partitionId);
+        ++sessionCatalog->_partitionStates[partitionId].preventSessionCheckoutRequests;
+    }
 }
 
 SessionCatalog::PreventCheckingOutSessionsBlock::~PreventCheckingOutSessionsBlock() {
-    stdx::lock_guard<stdx::mutex> lg(_sessionCatalog->_mutex);
-
-    invariant(_sessionCatalog->_preventSessionCheckoutRequests > 0);
-    --_sessionCatalog->_preventSessionCheckoutRequests;
-    if (_sessionCatalog->_preventSessionCheckoutRequests == 0) {
-        _sessionCatalog->_checkingOutSessionsAllowedCond.notify_all();
+    for (std::size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+        auto partition = _sessionCatalog->_sessions.lockOnePartitionById(partitionId);
+        auto& partitionState = _sessionCatalog->_partitionStates[partitionId];
+
+        invariant(partitionState.preventSessionCheckoutRequests > 0);
+        --partitionState.preventSessionCheckoutRequests;
+        if (partitionState.preventSessionCheckoutRequests == 0) {
+            partitionState.checkingOutSessionsAllowedCond.notify_all();
+        }
     }
 }
 
 void SessionCatalog::PreventCheckingOutSessionsBlock::waitForAllSessionsToBeCheckedIn(
     OperationContext* opCtx) {
-    stdx::unique_lock<stdx::mutex> ul(_sessionCatalog->_mutex);
-
-    invariant(!_sessionCatalog->_isSessionCheckoutAllowed());
-    while (_sessionCatalog->_numCheckedOutSessions > 0) {
-        opCtx->waitForConditionOrInterrupt(_sessionCatalog->_allSessionsCheckedInCond, ul);
+    // Checking out is prevented in every partition before this is called, so once a partition has
+    // no sessions checked out it stays that way and the partitions can be waited on one at a time.
+    for (std::size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+        auto partition = _sessionCatalog->_sessions.lockOnePartitionById(partitionId);
+        auto& ul = partition.lock();
+        auto& partitionState = _sessionCatalog->_partitionStates[partitionId];
+
+        invariant(!_sessionCatalog->_isSessionCheckoutAllowed(ul, partitionId));
+        while (partitionState.numCheckedOutSessions > 0) {
+            opCtx->waitForConditionOrInterrupt(partitionState.allSessionsCheckedInCond, ul);
+        }
     }
 }
 
+
 OperationContextSession::OperationContextSession(OperationContext* opCtx, bool checkOutSession)
     : _opCtx(opCtx) {
     if (!opCtx->getLogicalSessionId()) {
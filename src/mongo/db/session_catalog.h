@@ -30,7 +30,10 @@
 
 #include <boost/optional.hpp>
 
+#include <array>
+
 #include "mongo/base/disallow_copying.h"
+#include "mongo/db/catalog/util/partitioned.h"
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/session.h"
 #include "mongo/db/session_killer.h"
@@ -38,6 +41,7 @@
 #include "mongo/stdx/mutex.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -111,7 +115,7 @@ public:
 
     /**
      * Iterates through the SessionCatalog and applies 'workerFn' to each Session. This locks the
-     * SessionCatalog.
+     * partitions of the SessionCatalog one at a time.
      * TODO SERVER-33850: Take Matcher out of the SessionKiller namespace.
      */
     using ScanSessionsCallbackFn = stdx::function<void(OperationContext*, Session*)>;
@@ -128,8 +132,8 @@ private:
         // check it out.
         bool checkedOut{false};
 
-        // Signaled when the state becomes available. Uses the transaction table's mutex to protect
-        // the state transitions.
+        // Signaled when the state becomes available. Uses the mutex of the catalog partition which
+        // owns the session to protect the state transitions.
         stdx::condition_variable availableCondVar;
 
         // Must only be accessed when the state is kInUse and only by the operation context, which
@@ -141,41 +145,67 @@ private:
                                                       std::shared_ptr<SessionRuntimeInfo>,
                                                       LogicalSessionIdHash>;
 
+    static constexpr std::size_t kNumPartitions = 16;
+
+    struct LogicalSessionIdPartitioner {
+        std::size_t operator()(const LogicalSessionId& lsid, std::size_t nPartitions) const {
+            return LogicalSessionIdHash()(lsid) % nPartitions;
+        }
+    };
+
+    using PartitionedSessionRuntimeInfoMap =
+        Partitioned<SessionRuntimeInfoMap, kNumPartitions, LogicalSessionIdPartitioner>;
+
     /**
-     * May release and re-acquire it zero or more times before returning. The returned
-     * 'SessionRuntimeInfo' is guaranteed to be linked on the catalog's _txnTable as long as the
-     * lock is held.
+     * The check-out state of the sessions in one partition of the catalog. Protected by the mutex
+     * of that partition.
+     */
+    struct PartitionState {
+        // Count of the number of Sessions in this partition that are currently checked out.
+        uint32_t numCheckedOutSessions{0};
+
+        // When >0 all Session checkout or creation requests in this partition will block.
+        uint32_t preventSessionCheckoutRequests{0};
+
+        // Condition that is signaled when the number of checked out sessions goes to 0.
+        stdx::condition_variable allSessionsCheckedInCond;
+
+        // Condition that is signaled when checking out Sessions becomes legal again after having
+        // previously been forbidden.
+        stdx::condition_variable checkingOutSessionsAllowedCond;
+    };
+
+    static PartitionedSessionRuntimeInfoMap::PartitionId _partitionOf(
+        const LogicalSessionId& lsid) {
+        return LogicalSessionIdPartitioner()(lsid, kNumPartitions);
+    }
+
+    /**
+     * Must be called with 'partition' locked being the partition which owns 'lsid'. The returned
+     * 'SessionRuntimeInfo' is guaranteed to be linked on the catalog as long as the lock on the
+     * partition is held.
      */
     std::shared_ptr<SessionRuntimeInfo> _getOrCreateSessionRuntimeInfo(
-        WithLock, OperationContext* opCtx, const LogicalSessionId& lsid);
+        PartitionedSessionRuntimeInfoMap::OnePartition& partition,
+        OperationContext* opCtx,
+        const LogicalSessionId& lsid);
 
     /**
      * Makes a session, previously checked out through 'checkoutSession', available again.
      */
     void _releaseSession(const LogicalSessionId& lsid);
 
-    bool _isSessionCheckoutAllowed() const {
-        return _preventSessionCheckoutRequests == 0;
+    bool _isSessionCheckoutAllowed(
+        WithLock, PartitionedSessionRuntimeInfoMap::PartitionId partitionId) const {
+        return _partitionStates[partitionId].preventSessionCheckoutRequests == 0;
     };
 
-    // Protects members below.
-    stdx::mutex _mutex;
-
-    // Owns the Session objects for all current Sessions.
-    SessionRuntimeInfoMap _sessions;
-
-    // Count of the number of Sessions that are currently checked out.
-    uint32_t _numCheckedOutSessions{0};
-
-    // When >0 all Session checkout or creation requests will block.
-    uint32_t _preventSessionCheckoutRequests{0};
-
-    // Condition that is signaled when the number of checked out sessions goes to 0.
-    stdx::condition_variable _allSessionsCheckedInCond;
+    // Owns the Session objects for all current Sessions, partitioned by session id so that
+    // operations on different sessions do not contend on a single mutex.
+    PartitionedSessionRuntimeInfoMap _sessions;
 
-    // Condition that is signaled when checking out Sessions becomes legal again after having
-    // previously been forbidden.
-    stdx::condition_variable _checkingOutSessionsAllowedCond;
+    // The check-out state of each partition of '_sessions'.
+    std::array<CacheAligned<PartitionState>, kNumPartitions> _partitionStates;
 };
 
 /**
@@ -303,5 +303,41 @@ TEST_F(SessionCatalogTest, MultiplePreventCheckingOutSessionsBlocks) {
     ASSERT_EQ(lsid1, ocs->get(opCtx())->getSessionId());
 }
 
+TEST_F(SessionCatalogTest, ManySessionsAcrossPartitions) {
+    // Enough sessions that every partition of the catalog very likely owns some of them.
+    const int kNumSessions = 100;
+
+    std::vector<ServiceContext::UniqueClient> clients;
+    std::vector<ServiceContext::UniqueOperationContext> opCtxs;
+    std::vector<ScopedCheckedOutSession> checkedOutSessions;
+    for (int i = 0; i < kNumSessions; ++i) {
+        clients.push_back(getServiceContext()->makeClient(str::stream() << "client" << i));
+        opCtxs.push_back(clients.back()->makeOperationContext());
+        opCtxs.back()->setLogicalSessionId(makeLogicalSessionIdForTest());
+        checkedOutSessions.push_back(catalog()->checkOutSession(opCtxs.back().get()));
+    }
+
+    // All the sessions are checked out at once, and a scan visits each of them.
+    std::vector<LogicalSessionId> lsids;
+    SessionKiller::Matcher matcherAllSessions(
+        KillAllSessionsByPatternSet{makeKillAllSessionsByPattern(opCtx())});
+    catalog()->scanSessions(opCtx(), matcherAllSessions, [&](OperationContext*, Session* session) {
+        lsids.push_back(session->getSessionId());
+    });
+    ASSERT_EQ(static_cast<size_t>(kNumSessions), lsids.size());
+
+    // Waiting for all sessions to be checked in waits for the sessions in every partition.
+    SessionCatalog::PreventCheckingOutSessionsBlock preventCheckoutBlock(catalog());
+    auto waitClient = getServiceContext()->makeClient("waitForAllSessions");
+    auto waitOpCtx = waitClient->makeOperationContext();
+    waitOpCtx->setDeadlineAfterNowBy(Milliseconds(10), ErrorCodes::MaxTimeMSExpired);
+    ASSERT_THROWS_CODE(preventCheckoutBlock.waitForAllSessionsToBeCheckedIn(waitOpCtx.get()),
+                       AssertionException,
+                       ErrorCodes::MaxTimeMSExpired);
+
+    checkedOutSessions.clear();
+    preventCheckoutBlock.waitForAllSessionsToBeCheckedIn(opCtx());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -47,7 +47,9 @@
 
 #include "mongo/db/sorter/sorter.h"
 
+#include <algorithm>
 #include <boost/filesystem/operations.hpp>
+#include <exception>
 #include <snappy.h>
 #include <vector>
 
@@ -59,6 +61,8 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/functional.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/bufreader.h"
 #include "mongo/util/destructor_guard.h"
@@ -102,6 +106,35 @@ void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs)
 #endif
 }
 
+/**
+ * SortedFileWriter compresses and writes out its buffer once it grows past this many bytes. Small
+ * enough that a block and its compressed form both stay in cache while being (de)compressed.
+ */
+const int kSortedFileBlockSize = 64 * 1024;
+
+/**
+ * Prefix-compressed keys store two lengths before each key suffix. Keys are usually small, so
+ * they are written as little-endian base-128 varints rather than fixed-width integers.
+ */
+inline void writeKeyLength(BufBuilder& buf, uint32_t value) {
+    while (value >= 0x80) {
+        buf.appendUChar(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    buf.appendUChar(static_cast<unsigned char>(value));
+}
+
+inline uint32_t readKeyLength(BufReader& reader) {
+    uint32_t value = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+        const uint8_t byte = reader.read<uint8_t>();
+        value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return value;
+    }
+    msgasserted(50968, "corrupt key length in sorted file");
+}
+
 /** Ensures a named file is deleted when this object goes out of scope */
 class FileDeleter {
 public:
@@ -114,6 +147,80 @@ private:
     const std::string _fileName;
 };
 
+/**
+ * Stable-sorts [begin, end) using up to 'numThreads' threads, including the calling thread.
+ *
+ * The range is cut into equal runs which are sorted concurrently, then adjacent runs are merged
+ * pairwise, also concurrently, until a single run remains. 'less' must be safe to call from
+ * several threads at once. Falls back to a plain std::stable_sort when the range is too small to
+ * be worth splitting.
+ */
+template <typename Iter, typename Less>
+void parallelStableSort(Iter begin, Iter end, const Less& less, size_t numThreads) {
+    // Below this many elements per run, thread startup costs more than it saves.
+    const size_t kMinElementsPerThread = 16 * 1024;
+
+    const size_t numElements = end - begin;
+    numThreads = std::min(numThreads, numElements / kMinElementsPerThread);
+    if (numThreads <= 1) {
+        std::stable_sort(begin, end, less);
+        return;
+    }
+
+    // Runs [bounds[i], bounds[i + 1]) for i in [0, numThreads).
+    std::vector<Iter> bounds;
+    for (size_t i = 0; i < numThreads; i++) {
+        bounds.push_back(begin + (numElements * i) / numThreads);
+    }
+    bounds.push_back(end);
+
+    // Calls 'task(i)' for each i in [0, numTasks), running task 0 on this thread and the rest on
+    // their own threads. The first exception thrown by any task is rethrown once all have joined.
+    auto runConcurrently = [](size_t numTasks, const stdx::function<void(size_t)>& task) {
+        std::vector<std::exception_ptr> errors(numTasks);
+        std::vector<stdx::thread> threads;
+        for (size_t i = 1; i < numTasks; i++) {
+            threads.emplace_back([&task, &errors, i] {
+                try {
+                    task(i);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+        try {
+            task(0);
+        } catch (...) {
+            errors[0] = std::current_exception();
+        }
+        for (auto&& thread : threads) {
+            thread.join();
+        }
+        for (auto&& error : errors) {
+            if (error)
+                std::rethrow_exception(error);
+        }
+    };
+
+    runConcurrently(numThreads,
+                    [&](size_t i) { std::stable_sort(bounds[i], bounds[i + 1], less); });
+
+    // Merging neighbours in order, earlier run first, keeps the overall sort stable.
+    while (bounds.size() > 2) {
+        const size_t numRuns = bounds.size() - 1;
+        runConcurrently(numRuns / 2, [&](size_t i) {
+            std::inplace_merge(bounds[2 * i], bounds[2 * i + 1], bounds[2 * i + 2], less);
+        });
+
+        std::vector<Iter> merged;
+        for (size_t i = 0; i < numRuns; i += 2) {
+            merged.push_back(bounds[i]);
+        }
+        merged.push_back(end);
+        bounds.swap(merged);
+    }
+}
+
 /** Returns results from sorted in-memory storage */
 template <typename Key, typename Value>
 class InMemIterator : public SortIteratorInterface<Key, Value> {
@@ -154,8 +261,10 @@ public:
 
     FileIterator(const std::string& fileName,
                  const Settings& settings,
-                 std::shared_ptr<FileDeleter> fileDeleter)
+                 std::shared_ptr<FileDeleter> fileDeleter,
+                 bool prefixCompressedKeys)
         : _settings(settings),
+          _prefixCompressedKeys(prefixCompressedKeys),
           _done(false),
           _fileName(fileName),
           _fileDeleter(fileDeleter),
@@ -181,12 +290,32 @@ public:
         fillIfNeeded();
 
         // Note: key must be read before value so can't pass directly to Data constructor
-        auto first = Key::deserializeForSorter(*_reader, _settings.first);
+        auto first = _prefixCompressedKeys ? nextPrefixCompressedKey()
+                                           : Key::deserializeForSorter(*_reader, _settings.first);
         auto second = Value::deserializeForSorter(*_reader, _settings.second);
         return Data(std::move(first), std::move(second));
     }
 
 private:
+    /**
+     * Rebuilds the next key from the prefix it shares with the previous key in this block. The
+     * shared bytes are already in _keyBuffer, so only the suffix is copied. Like keys pointing
+     * into the block buffers, the returned key is only valid until the following call.
+     */
+    Key nextPrefixCompressedKey() {
+        const uint32_t prefixSize = readKeyLength(*_reader);
+        const uint32_t suffixSize = readKeyLength(*_reader);
+        massert(50969, "corrupt key prefix in sorted file", prefixSize <= _keySize);
+        massert(50970, "corrupt key suffix in sorted file", suffixSize <= _reader->remaining());
+
+        _keySize = prefixSize + suffixSize;
+        growBuffer(&_keyBuffer, _keySize);
+        memcpy(_keyBuffer.data() + prefixSize, _reader->skip(suffixSize), suffixSize);
+
+        BufReader keyReader(_keyBuffer.data(), _keySize);
+        return Key::deserializeForSorter(keyReader, _settings.first);
+    }
+
     void fillIfNeeded() {
         verify(!_done);
 
@@ -200,51 +329,61 @@ private:
         if (_done)
             return;
 
+        // Each block starts a new run of prefix-compressed keys.
+        _keySize = 0;
+
         // negative size means compressed
         const bool compressed = rawSize < 0;
         int32_t blockSize = std::abs(rawSize);
 
-        _buffer.reset(new char[blockSize]);
-        read(_buffer.get(), blockSize);
+        // The block buffers are reused from one block to the next. Data returned by next() is
+        // only valid until the following call, so nothing can still point into them here.
+        growBuffer(&_fileBuffer, blockSize);
+        read(_fileBuffer.data(), blockSize);
         massert(16816, "file too short?", !_done);
 
         auto encryptionHooks = EncryptionHooks::get(getGlobalServiceContext());
         if (encryptionHooks->enabled()) {
-            std::unique_ptr<char[]> out(new char[blockSize]);
+            std::vector<char> out(blockSize);
             size_t outLen;
             Status status =
-                encryptionHooks->unprotectTmpData(reinterpret_cast<uint8_t*>(_buffer.get()),
+                encryptionHooks->unprotectTmpData(reinterpret_cast<uint8_t*>(_fileBuffer.data()),
                                                   blockSize,
-                                                  reinterpret_cast<uint8_t*>(out.get()),
+                                                  reinterpret_cast<uint8_t*>(out.data()),
                                                   blockSize,
                                                   &outLen);
             massert(28841,
                     str::stream() << "Failed to unprotect data: " << status.toString(),
                     status.isOK());
             blockSize = outLen;
-            _buffer.swap(out);
+            _fileBuffer.swap(out);
         }
 
         if (!compressed) {
-            _reader.reset(new BufReader(_buffer.get(), blockSize));
+            _reader.reset(new BufReader(_fileBuffer.data(), blockSize));
             return;
         }
 
-        dassert(snappy::IsValidCompressedBuffer(_buffer.get(), blockSize));
+        dassert(snappy::IsValidCompressedBuffer(_fileBuffer.data(), blockSize));
 
         size_t uncompressedSize;
         massert(17061,
                 "couldn't get uncompressed length",
-                snappy::GetUncompressedLength(_buffer.get(), blockSize, &uncompressedSize));
+                snappy::GetUncompressedLength(_fileBuffer.data(), blockSize, &uncompressedSize));
 
-        std::unique_ptr<char[]> decompressionBuffer(new char[uncompressedSize]);
+        growBuffer(&_decompressionBuffer, uncompressedSize);
         massert(17062,
                 "decompression failed",
-                snappy::RawUncompress(_buffer.get(), blockSize, decompressionBuffer.get()));
+                snappy::RawUncompress(_fileBuffer.data(), blockSize, _decompressionBuffer.data()));
 
-        // hold on to decompressed data and throw out compressed data at block exit
-        _buffer.swap(decompressionBuffer);
-        _reader.reset(new BufReader(_buffer.get(), uncompressedSize));
+        _reader.reset(new BufReader(_decompressionBuffer.data(), uncompressedSize));
+    }
+
+    // Makes sure 'buffer' holds at least 'size' bytes. Buffers never shrink, so that blocks of
+    // varying size don't cause repeated reallocation.
+    static void growBuffer(std::vector<char>* buffer, size_t size) {
+        if (buffer->size() < size)
+            buffer->resize(size);
     }
 
     // sets _done to true on EOF - asserts on any other error
@@ -264,8 +403,12 @@ private:
     }
 
     const Settings _settings;
+    const bool _prefixCompressedKeys;
     bool _done;
-    std::unique_ptr<char[]> _buffer;
+    std::vector<char> _fileBuffer;           // the block as read from the file
+    std::vector<char> _decompressionBuffer;  // the block after decompression, if needed
+    std::vector<char> _keyBuffer;            // the current key, if keys are prefix compressed
+    uint32_t _keySize = 0;
     std::unique_ptr<BufReader> _reader;
     std::string _fileName;
     std::shared_ptr<FileDeleter> _fileDeleter;  // Must outlive _file
@@ -455,7 +598,7 @@ private:
 
     void sort() {
         STLComparator less(_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
+        parallelStableSort(_data.begin(), _data.end(), less, _opts.maxSortThreads);
 
         // Does 2x more compares than stable_sort
         // TODO test on windows
@@ -808,7 +951,7 @@ inline unsigned nextFileNumber() {
 
 template <typename Key, typename Value>
 SortedFileWriter<Key, Value>::SortedFileWriter(const SortOptions& opts, const Settings& settings)
-    : _settings(settings) {
+    : _settings(settings), _prefixCompressKeys(opts.prefixCompressKeys) {
     namespace str = mongoutils::str;
 
     // This should be checked by consumers, but if we get here don't allow writes.
@@ -841,10 +984,29 @@ SortedFileWriter<Key, Value>::SortedFileWriter(const SortOptions& opts, const Se
 
 template <typename Key, typename Value>
 void SortedFileWriter<Key, Value>::addAlreadySorted(const Key& key, const Value& val) {
-    key.serializeForSorter(_buffer);
+    if (_prefixCompressKeys) {
+        // Sorted keys tend to share long leading fields, such as the first fields of a compound
+        // index key, so only store what differs from the previous key in this block.
+        _keyBuffer.reset();
+        key.serializeForSorter(_keyBuffer);
+
+        const char* keyData = _keyBuffer.buf();
+        const size_t keySize = _keyBuffer.len();
+        const size_t maxPrefix = std::min(keySize, _prevKey.size());
+        size_t prefixSize = 0;
+        while (prefixSize < maxPrefix && keyData[prefixSize] == _prevKey[prefixSize])
+            ++prefixSize;
+
+        sorter::writeKeyLength(_buffer, prefixSize);
+        sorter::writeKeyLength(_buffer, keySize - prefixSize);
+        _buffer.appendBuf(keyData + prefixSize, keySize - prefixSize);
+        _prevKey.assign(keyData, keyData + keySize);
+    } else {
+        key.serializeForSorter(_buffer);
+    }
     val.serializeForSorter(_buffer);
 
-    if (_buffer.len() > 64 * 1024)
+    if (_buffer.len() > sorter::kSortedFileBlockSize)
         spill();
 }
 
@@ -858,14 +1020,18 @@ void SortedFileWriter<Key, Value>::spill() {
     if (size == 0)
         return;
 
-    std::string compressed;
-    snappy::Compress(outBuffer, size, &compressed);
-    verify(compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
+    // Compress into a buffer kept across blocks rather than a fresh string for every block.
+    const size_t maxCompressedSize = snappy::MaxCompressedLength(size);
+    if (_compressionBuffer.size() < maxCompressedSize)
+        _compressionBuffer.resize(maxCompressedSize);
+    size_t compressedSize;
+    snappy::RawCompress(outBuffer, size, _compressionBuffer.data(), &compressedSize);
+    verify(compressedSize <= size_t(std::numeric_limits<int32_t>::max()));
 
-    const bool shouldCompress = compressed.size() < size_t(_buffer.len() / 10 * 9);
+    const bool shouldCompress = compressedSize < size_t(_buffer.len() / 10 * 9);
     if (shouldCompress) {
-        size = compressed.size();
-        outBuffer = const_cast<char*>(compressed.data());
+        size = compressedSize;
+        outBuffer = _compressionBuffer.data();
     }
 
     std::unique_ptr<char[]> out;
@@ -899,13 +1065,15 @@ void SortedFileWriter<Key, Value>::spill() {
     }
 
     _buffer.reset();
+    _prevKey.clear();
 }
 
 template <typename Key, typename Value>
 SortIteratorInterface<Key, Value>* SortedFileWriter<Key, Value>::done() {
     spill();
     _file.close();
-    return new sorter::FileIterator<Key, Value>(_fileName, _settings, _fileDeleter);
+    return new sorter::FileIterator<Key, Value>(
+        _fileName, _settings, _fileDeleter, _prefixCompressKeys);
 }
 
 //
@@ -98,8 +98,17 @@ struct SortOptions {
     bool extSortAllowed;         /// If false, uassert if more mem needed than allowed.
     std::string tempDir;         /// Directory to directly place files in.
                                  /// Must be explicitly set if extSortAllowed is true.
-
-    SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
+    size_t maxSortThreads;       /// Threads used to sort each in-memory run. The comparator
+                                 /// must be thread-safe if this is greater than 1.
+    bool prefixCompressKeys;     /// If true, spilled keys are stored as the number of bytes
+                                 /// shared with the previous key plus the remaining suffix.
+
+    SortOptions()
+        : limit(0),
+          maxMemoryUsageBytes(64 * 1024 * 1024),
+          extSortAllowed(false),
+          maxSortThreads(1),
+          prefixCompressKeys(false) {}
 
     /// Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -122,6 +131,16 @@ struct SortOptions {
         tempDir = newTempDir;
         return *this;
     }
+
+    SortOptions& MaxSortThreads(size_t newMaxSortThreads) {
+        maxSortThreads = newMaxSortThreads;
+        return *this;
+    }
+
+    SortOptions& PrefixCompressKeys(bool newPrefixCompressKeys = true) {
+        prefixCompressKeys = newPrefixCompressKeys;
+        return *this;
+    }
 };
 
 /// This is the output from the sorting framework
@@ -204,10 +223,16 @@ private:
     void spill();
 
     const Settings _settings;
+    const bool _prefixCompressKeys;
     std::string _fileName;
     std::shared_ptr<sorter::FileDeleter> _fileDeleter;  // Must outlive _file
     std::ofstream _file;
     BufBuilder _buffer;
+    std::vector<char> _compressionBuffer;  // reused by each call to spill()
+
+    // Only used with prefixCompressKeys: the serialized form of the current and previous key.
+    BufBuilder _keyBuffer;
+    std::vector<char> _prevKey;
 };
 }
 
@@ -263,6 +263,32 @@ public:
             ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter.done()),
                                         make_shared<IntIterator>(0, 10 * 1000 * 1000));
         }
+        {  // blocks that compress well interleaved with blocks that don't
+            SortedFileWriter<IntWrapper, IntWrapper> sorter(opts);
+            PseudoRandom random(int64_t(time(0)));
+            std::vector<IWPair> expected;
+            for (int i = 0; i < 1000 * 1000; i++) {
+                const bool compressible = (i / (16 * 1024)) % 2 == 0;
+                expected.push_back(IWPair(i, compressible ? 0 : random.nextInt32()));
+                sorter.addAlreadySorted(expected.back().first, expected.back().second);
+            }
+
+            std::shared_ptr<IWIterator> expectedIter =
+                std::make_shared<sorter::InMemIterator<IntWrapper, IntWrapper>>(expected);
+            ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter.done()), expectedIter);
+        }
+        {  // prefix compressed keys, including runs of identical keys and many blocks
+            SortedFileWriter<IntWrapper, IntWrapper> sorter(SortOptions(opts).PrefixCompressKeys());
+            std::vector<IWPair> expected;
+            for (int i = 0; i < 1000 * 1000; i++) {
+                expected.push_back(IWPair(i / 3, -i));
+                sorter.addAlreadySorted(expected.back().first, expected.back().second);
+            }
+
+            std::shared_ptr<IWIterator> expectedIter =
+                std::make_shared<sorter::InMemIterator<IntWrapper, IntWrapper>>(expected);
+            ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter.done()), expectedIter);
+        }
 
         ASSERT(boost::filesystem::is_empty(tempDir.path()));
     }
@@ -325,6 +351,33 @@ public:
     }
 };
 
+class ParallelStableSortTests {
+public:
+    void run() {
+        // Few distinct keys so that stability is observable through the values.
+        const int kNumItems = 200 * 1000;
+        PseudoRandom random(int64_t(time(0)));
+        std::vector<IWPair> input;
+        for (int i = 0; i < kNumItems; i++)
+            input.push_back(IWPair(random.nextInt32(100), i));
+
+        auto less = [](const IWPair& lhs, const IWPair& rhs) { return lhs.first < rhs.first; };
+        std::vector<IWPair> expected = input;
+        std::stable_sort(expected.begin(), expected.end(), less);
+
+        // Odd thread counts leave an unpaired run at some merge levels.
+        for (size_t numThreads = 1; numThreads <= 7; numThreads++) {
+            std::deque<IWPair> data(input.begin(), input.end());
+            parallelStableSort(data.begin(), data.end(), less, numThreads);
+            ASSERT_EQ(data.size(), expected.size());
+            for (size_t i = 0; i < data.size(); i++) {
+                ASSERT_EQ(int(data[i].first), int(expected[i].first));
+                ASSERT_EQ(int(data[i].second), int(expected[i].second));
+            }
+        }
+    }
+};
+
 namespace SorterTests {
 class Basic : public ScopedGlobalServiceContextForTest {
 public:
@@ -511,6 +564,26 @@ public:
 };
 
 
+template <bool Random = true>
+class LotsOfDataMultipleSortThreads : public LotsOfDataLittleMemory<Random> {
+    SortOptions adjustSortOptions(SortOptions opts) {
+        // Keep everything in memory so that the whole input is sorted by one parallel sort.
+        return opts.MaxSortThreads(4);
+    }
+    void addData(unowned_ptr<IWSorter> sorter) {
+        for (int i = 0; i < LotsOfDataLittleMemory<Random>::NUM_ITEMS; i++)
+            sorter->add(this->_array[i], -this->_array[i]);
+        ASSERT_EQ(sorter->numFiles(), 0);
+    }
+};
+
+template <bool Random = true>
+class LotsOfDataPrefixCompressedKeys : public LotsOfDataLittleMemory<Random> {
+    SortOptions adjustSortOptions(SortOptions opts) {
+        return LotsOfDataLittleMemory<Random>::adjustSortOptions(opts).PrefixCompressKeys();
+    }
+};
+
 template <long long Limit, bool Random = true>
 class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     typedef LotsOfDataLittleMemory<Random> Parent;
@@ -544,11 +617,16 @@ public:
         add<InMemIterTests>();
         add<SortedFileWriterAndFileIteratorTests>();
         add<MergeIteratorTests>();
+        add<ParallelStableSortTests>();
         add<SorterTests::Basic>();
         add<SorterTests::Limit>();
         add<SorterTests::Dupes>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/false>>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::LotsOfDataMultipleSortThreads</*random=*/false>>();
+        add<SorterTests::LotsOfDataMultipleSortThreads</*random=*/true>>();
+        add<SorterTests::LotsOfDataPrefixCompressedKeys</*random=*/false>>();
+        add<SorterTests::LotsOfDataPrefixCompressedKeys</*random=*/true>>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/true>>();      // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/false>>();   // fits in mem
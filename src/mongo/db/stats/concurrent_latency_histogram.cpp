@@ -0,0 +1,159 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/concurrent_latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Returns the shard used by the calling thread. Shards are handed out to threads in turn, which
+ * spreads the threads of a busy server evenly across them.
+ */
+size_t getShardForThread() {
+    static AtomicUInt32 nextShard;
+    thread_local const size_t shard =
+        nextShard.fetchAndAdd(1) % ConcurrentLatencyHistogram::kNumShards;
+    return shard;
+}
+
+}  // namespace
+
+constexpr int ConcurrentLatencyHistogram::kSubBucketBits;
+constexpr int ConcurrentLatencyHistogram::kSubBucketCount;
+constexpr int ConcurrentLatencyHistogram::kMaxLog2;
+constexpr int ConcurrentLatencyHistogram::kNumBuckets;
+constexpr size_t ConcurrentLatencyHistogram::kNumShards;
+
+ConcurrentLatencyHistogram::ConcurrentLatencyHistogram() : _shards(kNumShards) {}
+
+int ConcurrentLatencyHistogram::getBucket(uint64_t value) {
+    if (value < static_cast<uint64_t>(kSubBucketCount)) {
+        return static_cast<int>(value);
+    }
+
+    int log2 = 63 - countLeadingZeros64(value);
+    if (log2 > kMaxLog2) {
+        return kNumBuckets - 1;
+    }
+
+    // The bits below the leading one select the sub-bucket within this power of two.
+    int shift = log2 - kSubBucketBits;
+    int subBucket = static_cast<int>(value >> shift) & (kSubBucketCount - 1);
+    return kSubBucketCount + shift * kSubBucketCount + subBucket;
+}
+
+uint64_t ConcurrentLatencyHistogram::getBucketLowerBound(int bucket) {
+    if (bucket < kSubBucketCount) {
+        return bucket;
+    }
+
+    int shift = (bucket - kSubBucketCount) / kSubBucketCount;
+    int subBucket = (bucket - kSubBucketCount) % kSubBucketCount;
+    return static_cast<uint64_t>(kSubBucketCount + subBucket) << shift;
+}
+
+uint64_t ConcurrentLatencyHistogram::getBucketUpperBound(int bucket) {
+    if (bucket < kSubBucketCount) {
+        return bucket;
+    }
+
+    int shift = (bucket - kSubBucketCount) / kSubBucketCount;
+    return getBucketLowerBound(bucket) + (1ULL << shift) - 1;
+}
+
+void ConcurrentLatencyHistogram::record(uint64_t value) {
+    auto& shard = _shards[getShardForThread()];
+    shard.buckets[getBucket(value)].fetchAndAdd(1);
+    shard.sum.fetchAndAdd(value);
+}
+
+ConcurrentLatencyHistogram::Snapshot ConcurrentLatencyHistogram::snapshot() const {
+    Snapshot snapshot;
+    for (const auto& shard : _shards) {
+        for (int i = 0; i < kNumBuckets; ++i) {
+            auto count = shard.buckets[i].load();
+            snapshot._buckets[i] += count;
+            snapshot._count += count;
+        }
+        snapshot._sum += shard.sum.load();
+    }
+    return snapshot;
+}
+
+uint64_t ConcurrentLatencyHistogram::Snapshot::percentile(double fraction) const {
+    if (_count == 0) {
+        return 0;
+    }
+
+    auto rank = std::max<uint64_t>(1, std::ceil(fraction * _count));
+    uint64_t seen = 0;
+    for (int i = 0; i < kNumBuckets; ++i) {
+        seen += _buckets[i];
+        if (seen >= rank) {
+            return getBucketUpperBound(i);
+        }
+    }
+    return getBucketUpperBound(kNumBuckets - 1);
+}
+
+void ConcurrentLatencyHistogram::Snapshot::append(bool includeHistogram,
+                                                  BSONObjBuilder* builder) const {
+    if (includeHistogram) {
+        BSONArrayBuilder arrayBuilder(builder->subarrayStart("histogram"));
+        for (int i = 0; i < kNumBuckets; ++i) {
+            if (_buckets[i] == 0)
+                continue;
+            BSONObjBuilder entryBuilder(arrayBuilder.subobjStart());
+            entryBuilder.append("micros", static_cast<long long>(getBucketLowerBound(i)));
+            entryBuilder.append("count", static_cast<long long>(_buckets[i]));
+            entryBuilder.doneFast();
+        }
+        arrayBuilder.doneFast();
+    }
+    builder->append("latency", static_cast<long long>(_sum));
+    builder->append("ops", static_cast<long long>(_count));
+
+    BSONObjBuilder percentilesBuilder(builder->subobjStart("percentiles"));
+    percentilesBuilder.append("p50", static_cast<long long>(percentile(0.5)));
+    percentilesBuilder.append("p95", static_cast<long long>(percentile(0.95)));
+    percentilesBuilder.append("p99", static_cast<long long>(percentile(0.99)));
+    percentilesBuilder.append("p999", static_cast<long long>(percentile(0.999)));
+    percentilesBuilder.doneFast();
+}
+
+}  // namespace mongo
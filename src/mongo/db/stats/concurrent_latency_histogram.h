@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <boost/align/aligned_allocator.hpp>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/with_alignment.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * A latency histogram which any number of threads may record into concurrently without taking a
+ * lock, and which may be read while they do so.
+ *
+ * The buckets follow the layout of an HDR histogram. Values below kSubBucketCount each have their
+ * own bucket, and every power of two above that is split into kSubBucketCount equally sized
+ * buckets, so a value is reported with a relative error of at most 1/kSubBucketCount. Values of
+ * 2^(kMaxLog2 + 1) or more are counted in the last bucket.
+ *
+ * Each thread records into one of kNumShards cache-aligned copies of the counters, so that
+ * threads running on different CPUs do not contend on the same cache lines. Readers add the
+ * shards together, and may miss values recorded while they were reading.
+ */
+class ConcurrentLatencyHistogram {
+    MONGO_DISALLOW_COPYING(ConcurrentLatencyHistogram);
+
+public:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr int kSubBucketCount = 1 << kSubBucketBits;
+    static constexpr int kMaxLog2 = 40;
+    static constexpr int kNumBuckets =
+        kSubBucketCount + (kMaxLog2 - kSubBucketBits + 1) * kSubBucketCount;
+    static constexpr size_t kNumShards = 16;
+
+    /**
+     * The sum of all shards of a histogram at some point in time.
+     */
+    class Snapshot {
+    public:
+        uint64_t count() const {
+            return _count;
+        }
+
+        uint64_t sum() const {
+            return _sum;
+        }
+
+        /**
+         * Returns the smallest bucket upper bound which at least 'fraction' of the recorded
+         * values are less than or equal to, or 0 if nothing has been recorded.
+         */
+        uint64_t percentile(double fraction) const;
+
+        /**
+         * Appends the total latency, the number of values recorded and the p50, p95, p99 and
+         * p99.9 latencies, and optionally the non-empty buckets of the histogram, in the same
+         * format as OperationLatencyHistogram.
+         */
+        void append(bool includeHistogram, BSONObjBuilder* builder) const;
+
+    private:
+        friend class ConcurrentLatencyHistogram;
+
+        std::array<uint64_t, kNumBuckets> _buckets{};
+        uint64_t _count = 0;
+        uint64_t _sum = 0;
+    };
+
+    ConcurrentLatencyHistogram();
+
+    /**
+     * Records a single value, typically a latency in microseconds.
+     */
+    void record(uint64_t value);
+
+    Snapshot snapshot() const;
+
+    /**
+     * Shorthand for snapshot().append(includeHistogram, builder).
+     */
+    void append(bool includeHistogram, BSONObjBuilder* builder) const {
+        snapshot().append(includeHistogram, builder);
+    }
+
+    static int getBucket(uint64_t value);
+
+    /**
+     * Returns the smallest and largest values which are counted in 'bucket'.
+     */
+    static uint64_t getBucketLowerBound(int bucket);
+    static uint64_t getBucketUpperBound(int bucket);
+
+private:
+    struct Shard {
+        std::array<AtomicUInt64, kNumBuckets> buckets;
+        AtomicUInt64 sum;
+    };
+
+    using CacheAlignedShard = CacheAligned<Shard>;
+
+    std::vector<CacheAlignedShard, boost::alignment::aligned_allocator<CacheAlignedShard>> _shards;
+};
+
+}  // namespace mongo
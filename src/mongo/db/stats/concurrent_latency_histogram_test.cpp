@@ -0,0 +1,159 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/concurrent_latency_histogram.h"
+
+#include <limits>
+#include <vector>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Histogram = ConcurrentLatencyHistogram;
+
+TEST(ConcurrentLatencyHistogram, SmallValuesHaveTheirOwnBuckets) {
+    for (uint64_t value = 0; value < static_cast<uint64_t>(Histogram::kSubBucketCount); ++value) {
+        auto bucket = Histogram::getBucket(value);
+        ASSERT_EQUALS(value, Histogram::getBucketLowerBound(bucket));
+        ASSERT_EQUALS(value, Histogram::getBucketUpperBound(bucket));
+    }
+}
+
+TEST(ConcurrentLatencyHistogram, BucketsAreContiguous) {
+    for (int bucket = 0; bucket < Histogram::kNumBuckets - 1; ++bucket) {
+        auto lower = Histogram::getBucketLowerBound(bucket);
+        auto upper = Histogram::getBucketUpperBound(bucket);
+        ASSERT_LESS_THAN_OR_EQUALS(lower, upper);
+        ASSERT_EQUALS(upper + 1, Histogram::getBucketLowerBound(bucket + 1));
+        ASSERT_EQUALS(bucket, Histogram::getBucket(lower));
+        ASSERT_EQUALS(bucket, Histogram::getBucket(upper));
+    }
+}
+
+TEST(ConcurrentLatencyHistogram, RelativeErrorIsBounded) {
+    for (uint64_t value = 1; value < (1ULL << Histogram::kMaxLog2); value = value * 3 + 1) {
+        auto bucket = Histogram::getBucket(value);
+        auto width =
+            Histogram::getBucketUpperBound(bucket) - Histogram::getBucketLowerBound(bucket);
+        ASSERT_LESS_THAN_OR_EQUALS(width * Histogram::kSubBucketCount, value);
+    }
+}
+
+TEST(ConcurrentLatencyHistogram, LargeValuesGoInTheLastBucket) {
+    ASSERT_EQUALS(Histogram::kNumBuckets - 1, Histogram::getBucket(1ULL << 50));
+    ASSERT_EQUALS(Histogram::kNumBuckets - 1,
+                  Histogram::getBucket(std::numeric_limits<uint64_t>::max()));
+}
+
+TEST(ConcurrentLatencyHistogram, Percentiles) {
+    Histogram histogram;
+    ASSERT_EQUALS(0U, histogram.snapshot().percentile(0.5));
+
+    for (uint64_t value = 1; value <= 1000; ++value) {
+        histogram.record(value);
+    }
+
+    auto snapshot = histogram.snapshot();
+    ASSERT_EQUALS(1000U, snapshot.count());
+    ASSERT_EQUALS(500500U, snapshot.sum());
+
+    // Each percentile is the upper bound of the bucket holding the exact value.
+    ASSERT_EQUALS(Histogram::getBucketUpperBound(Histogram::getBucket(500)),
+                  snapshot.percentile(0.5));
+    ASSERT_EQUALS(Histogram::getBucketUpperBound(Histogram::getBucket(950)),
+                  snapshot.percentile(0.95));
+    ASSERT_EQUALS(Histogram::getBucketUpperBound(Histogram::getBucket(990)),
+                  snapshot.percentile(0.99));
+    ASSERT_EQUALS(Histogram::getBucketUpperBound(Histogram::getBucket(1000)),
+                  snapshot.percentile(0.999));
+    ASSERT_EQUALS(Histogram::getBucketUpperBound(Histogram::getBucket(1)),
+                  snapshot.percentile(0));
+}
+
+TEST(ConcurrentLatencyHistogram, Append) {
+    Histogram histogram;
+    histogram.record(3);
+    histogram.record(3);
+    histogram.record(100);
+
+    BSONObjBuilder builder;
+    histogram.append(true, &builder);
+    auto obj = builder.obj();
+
+    ASSERT_EQUALS(106, obj["latency"].Long());
+    ASSERT_EQUALS(3, obj["ops"].Long());
+    ASSERT_EQUALS(3, obj["percentiles"]["p50"].Long());
+    ASSERT_EQUALS(static_cast<long long>(Histogram::getBucketUpperBound(Histogram::getBucket(100))),
+                  obj["percentiles"]["p999"].Long());
+
+    auto buckets = obj["histogram"].Array();
+    ASSERT_EQUALS(2U, buckets.size());
+    ASSERT_BSONOBJ_EQ(BSON("micros" << 3LL << "count" << 2LL), buckets[0].Obj());
+    ASSERT_EQUALS(Histogram::getBucketLowerBound(Histogram::getBucket(100)),
+                  static_cast<uint64_t>(buckets[1]["micros"].Long()));
+
+    BSONObjBuilder withoutHistogram;
+    histogram.append(false, &withoutHistogram);
+    ASSERT_FALSE(withoutHistogram.obj().hasField("histogram"));
+}
+
+TEST(ConcurrentLatencyHistogram, ConcurrentRecording) {
+    const int kThreads = 8;
+    const int kValuesPerThread = 10000;
+
+    Histogram histogram;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&histogram] {
+            for (int j = 0; j < kValuesPerThread; ++j) {
+                histogram.record(j % 100);
+            }
+        });
+    }
+
+    // Reading while the writers are running sees a prefix of the values recorded so far.
+    auto during = histogram.snapshot();
+    ASSERT_LESS_THAN_OR_EQUALS(during.count(), static_cast<uint64_t>(kThreads * kValuesPerThread));
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto after = histogram.snapshot();
+    ASSERT_EQUALS(static_cast<uint64_t>(kThreads * kValuesPerThread), after.count());
+    ASSERT_EQUALS(static_cast<uint64_t>(kThreads * (kValuesPerThread / 100) * 4950), after.sum());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -93,6 +93,12 @@ public:
             activeClientsBuilder.done();
         }
 
+        {
+            BSONObjBuilder ticketWaitsBuilder(ret.subobjStart("ticketWaits"));
+            Locker::appendTicketWaitStats(&ticketWaitsBuilder);
+            ticketWaitsBuilder.done();
+        }
+
         ret.done();
 
         return ret.obj();
@@ -0,0 +1,156 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getQueryShapeStats = ServiceContext::declareDecoration<QueryShapeStats>();
+
+// The largest number of query shapes tracked. 0 turns the statistics off.
+MONGO_EXPORT_SERVER_PARAMETER(queryShapeStatsMaxEntries, int, 500)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "queryShapeStatsMaxEntries must be greater than or equal to 0");
+        }
+        return Status::OK();
+    });
+
+}  // namespace
+
+QueryShapeStats& QueryShapeStats::get(ServiceContext* service) {
+    return getQueryShapeStats(service);
+}
+
+void QueryShapeStats::record(StringData ns, uint32_t queryHash, const Execution& execution) {
+    const size_t maxEntries = queryShapeStatsMaxEntries.load();
+    if (maxEntries == 0) {
+        return;
+    }
+
+    // The bucket of the first lower bound which exceeds the latency, less one.
+    const auto& bounds = OperationLatencyHistogram::kLowerBounds;
+    const auto bucket =
+        std::upper_bound(bounds.begin(), bounds.end(), execution.latencyMicros) - bounds.begin() -
+        1;
+
+    ShapeKey key{ns.toString(), queryHash};
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _shapes.find(key);
+    if (it == _shapes.end()) {
+        // Make room by dropping the cheapest shapes. More than one may go if the limit was lowered.
+        while (_shapes.size() >= maxEntries) {
+            auto cheapest = std::min_element(
+                _shapes.begin(), _shapes.end(), [](const auto& lhs, const auto& rhs) {
+                    return lhs.second.totalMicros < rhs.second.totalMicros;
+                });
+            _shapes.erase(cheapest);
+        }
+        it = _shapes.emplace(std::move(key), ShapeData{}).first;
+    }
+
+    auto& data = it->second;
+    data.count++;
+    data.totalMicros += execution.latencyMicros;
+    data.maxMicros = std::max(data.maxMicros, execution.latencyMicros);
+    data.docsExamined += execution.docsExamined;
+    data.keysExamined += execution.keysExamined;
+    data.nreturned += execution.nreturned;
+    data.cpuNanos += execution.cpuNanos.value_or(0);
+    data.histogram[bucket]++;
+}
+
+std::vector<BSONObj> QueryShapeStats::getStats() const {
+    std::vector<std::pair<uint64_t, BSONObj>> shapes;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        shapes.reserve(_shapes.size());
+        for (const auto& shape : _shapes) {
+            shapes.emplace_back(shape.second.totalMicros, _toBSON(shape.first, shape.second));
+        }
+    }
+
+    std::sort(shapes.begin(), shapes.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first > rhs.first;
+    });
+
+    std::vector<BSONObj> stats;
+    stats.reserve(shapes.size());
+    for (auto& shape : shapes) {
+        stats.push_back(std::move(shape.second));
+    }
+    return stats;
+}
+
+void QueryShapeStats::reset() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _shapes.clear();
+}
+
+BSONObj QueryShapeStats::_toBSON(const ShapeKey& key, const ShapeData& data) {
+    BSONObjBuilder builder;
+    builder.append("ns", key.first);
+    builder.append("queryHash", unsignedIntToFixedLengthHex(key.second));
+    builder.append("count", data.count);
+    builder.append("totalMicros", static_cast<long long>(data.totalMicros));
+    builder.append("maxMicros", static_cast<long long>(data.maxMicros));
+    builder.append("docsExamined", data.docsExamined);
+    builder.append("keysExamined", data.keysExamined);
+    builder.append("nreturned", data.nreturned);
+    builder.append("cpuNanos", data.cpuNanos);
+
+    // Only the non-empty buckets are reported, in the same format as $collStats latencyStats.
+    BSONArrayBuilder histogram(builder.subarrayStart("histogram"));
+    for (int i = 0; i < OperationLatencyHistogram::kMaxBuckets; i++) {
+        if (data.histogram[i] == 0) {
+            continue;
+        }
+        BSONObjBuilder entry(histogram.subobjStart());
+        entry.append("micros", static_cast<long long>(OperationLatencyHistogram::kLowerBounds[i]));
+        entry.append("count", static_cast<long long>(data.histogram[i]));
+        entry.doneFast();
+    }
+    histogram.doneFast();
+
+    return builder.obj();
+}
+
+}  // namespace mongo
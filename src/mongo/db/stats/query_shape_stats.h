@@ -0,0 +1,104 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/stats/operation_latency_histogram.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * Tracks latency and resource usage per query shape, where a shape is a namespace together with
+ * the hash of its PlanCache key. The table is bounded by 'queryShapeStatsMaxEntries'; once it is
+ * full, a new shape displaces the shape with the least total execution time, so the table keeps
+ * the most expensive shapes. The statistics are read with the $queryShapeStats aggregation stage.
+ */
+class QueryShapeStats {
+public:
+    static QueryShapeStats& get(ServiceContext* service);
+
+    QueryShapeStats() = default;
+
+    /**
+     * The resources used by one execution of a query.
+     */
+    struct Execution {
+        uint64_t latencyMicros = 0;
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+
+        // Not available on platforms without per-thread CPU clocks.
+        boost::optional<long long> cpuNanos;
+    };
+
+    void record(StringData ns, uint32_t queryHash, const Execution& execution);
+
+    /**
+     * Returns one document per tracked shape, most expensive first.
+     */
+    std::vector<BSONObj> getStats() const;
+
+    /**
+     * Clears all statistics. Used by tests.
+     */
+    void reset();
+
+private:
+    struct ShapeData {
+        long long count = 0;
+        uint64_t totalMicros = 0;
+        uint64_t maxMicros = 0;
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+        long long cpuNanos = 0;
+        std::array<uint64_t, OperationLatencyHistogram::kMaxBuckets> histogram{};
+    };
+
+    using ShapeKey = std::pair<std::string, uint32_t>;
+
+    static BSONObj _toBSON(const ShapeKey& key, const ShapeData& data);
+
+    mutable stdx::mutex _mutex;
+    std::map<ShapeKey, ShapeData> _shapes;
+};
+
+}  // namespace mongo
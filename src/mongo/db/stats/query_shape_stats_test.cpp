@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include "mongo/db/server_parameters.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+QueryShapeStats::Execution makeExecution(uint64_t latencyMicros) {
+    QueryShapeStats::Execution execution;
+    execution.latencyMicros = latencyMicros;
+    execution.docsExamined = 10;
+    execution.keysExamined = 5;
+    execution.nreturned = 2;
+    execution.cpuNanos = 1000;
+    return execution;
+}
+
+TEST(QueryShapeStatsTest, AccumulatesExecutionsOfTheSameShape) {
+    QueryShapeStats stats;
+    stats.record("test.coll", 0x1234, makeExecution(3));
+    stats.record("test.coll", 0x1234, makeExecution(100));
+
+    auto shapes = stats.getStats();
+    ASSERT_EQ(shapes.size(), 1U);
+    ASSERT_BSONOBJ_EQ(shapes[0],
+                      BSON("ns"
+                           << "test.coll"
+                           << "queryHash"
+                           << "00001234"
+                           << "count"
+                           << 2LL
+                           << "totalMicros"
+                           << 103LL
+                           << "maxMicros"
+                           << 100LL
+                           << "docsExamined"
+                           << 20LL
+                           << "keysExamined"
+                           << 10LL
+                           << "nreturned"
+                           << 4LL
+                           << "cpuNanos"
+                           << 2000LL
+                           << "histogram"
+                           << BSON_ARRAY(BSON("micros" << 2LL << "count" << 1LL)
+                                         << BSON("micros" << 64LL << "count" << 1LL))));
+}
+
+TEST(QueryShapeStatsTest, ShapesAreKeyedByNamespaceAndHash) {
+    QueryShapeStats stats;
+    stats.record("test.coll", 1, makeExecution(10));
+    stats.record("test.other", 1, makeExecution(30));
+    stats.record("test.coll", 2, makeExecution(20));
+
+    // The most expensive shapes come first.
+    auto shapes = stats.getStats();
+    ASSERT_EQ(shapes.size(), 3U);
+    ASSERT_EQ(shapes[0]["ns"].String(), "test.other");
+    ASSERT_EQ(shapes[1]["queryHash"].String(), "00000002");
+    ASSERT_EQ(shapes[2]["queryHash"].String(), "00000001");
+}
+
+TEST(QueryShapeStatsTest, EvictsTheCheapestShapeWhenFull) {
+    auto param = ServerParameterSet::getGlobal()->getMap().find("queryShapeStatsMaxEntries");
+    ASSERT(param != ServerParameterSet::getGlobal()->getMap().end());
+    ASSERT_OK(param->second->setFromString("2"));
+    ON_BLOCK_EXIT([&] { ASSERT_OK(param->second->setFromString("500")); });
+
+    QueryShapeStats stats;
+    stats.record("test.coll", 1, makeExecution(50));
+    stats.record("test.coll", 2, makeExecution(10));
+    stats.record("test.coll", 3, makeExecution(20));
+
+    auto shapes = stats.getStats();
+    ASSERT_EQ(shapes.size(), 2U);
+    ASSERT_EQ(shapes[0]["queryHash"].String(), "00000001");
+    ASSERT_EQ(shapes[1]["queryHash"].String(), "00000003");
+
+    // Turning the statistics off stops recording, but keeps what was recorded.
+    ASSERT_OK(param->second->setFromString("0"));
+    stats.record("test.coll", 4, makeExecution(1000));
+    ASSERT_EQ(stats.getStats().size(), 2U);
+}
+
+}  // namespace
+}  // namespace mongo
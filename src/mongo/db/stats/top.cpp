@@ -211,18 +211,43 @@ void Top::appendLatencyStats(StringData ns, bool includeHistograms, BSONObjBuild
 void Top::incrementGlobalLatencyStats(OperationContext* opCtx,
                                       uint64_t latency,
                                       Command::ReadWriteType readWriteType) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _incrementHistogram(opCtx, latency, &_globalHistogramStats, readWriteType);
+    // Only update histogram if operation came from a user.
+    Client* client = opCtx->getClient();
+    if (client->isFromUserConnection() && !client->isInDirectClient()) {
+        _getGlobalHistogram(readWriteType)->record(latency);
+    }
 }
 
 void Top::appendGlobalLatencyStats(bool includeHistograms, BSONObjBuilder* builder) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.append(includeHistograms, builder);
+    const std::pair<const char*, const ConcurrentLatencyHistogram*> histograms[] = {
+        {"reads", &_globalReads},
+        {"writes", &_globalWrites},
+        {"commands", &_globalCommands},
+        {"transactions", &_globalTransactions}};
+
+    for (const auto& histogram : histograms) {
+        BSONObjBuilder histogramBuilder(builder->subobjStart(histogram.first));
+        histogram.second->append(includeHistograms, &histogramBuilder);
+        histogramBuilder.doneFast();
+    }
 }
 
 void Top::incrementGlobalTransactionLatencyStats(uint64_t latency) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
+    _globalTransactions.record(latency);
+}
+
+ConcurrentLatencyHistogram* Top::_getGlobalHistogram(Command::ReadWriteType readWriteType) {
+    switch (readWriteType) {
+        case Command::ReadWriteType::kRead:
+            return &_globalReads;
+        case Command::ReadWriteType::kWrite:
+            return &_globalWrites;
+        case Command::ReadWriteType::kCommand:
+            return &_globalCommands;
+        case Command::ReadWriteType::kTransaction:
+            return &_globalTransactions;
+    }
+    MONGO_UNREACHABLE;
 }
 
 void Top::_incrementHistogram(OperationContext* opCtx,
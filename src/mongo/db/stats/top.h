@@ -33,6 +33,7 @@
 
 #include "mongo/db/commands.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/stats/concurrent_latency_histogram.h"
 #include "mongo/db/stats/operation_latency_histogram.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/string_map.h"
@@ -124,7 +125,7 @@ public:
     void incrementGlobalTransactionLatencyStats(uint64_t latency);
 
     /**
-     * Appends the global latency statistics.
+     * Appends the global latency statistics. Does not block operations recording latencies.
      */
     void appendGlobalLatencyStats(bool includeHistograms, BSONObjBuilder* builder);
 
@@ -145,8 +146,17 @@ private:
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
+    ConcurrentLatencyHistogram* _getGlobalHistogram(Command::ReadWriteType readWriteType);
+
     mutable SimpleMutex _lock;
-    OperationLatencyHistogram _globalHistogramStats;
+
+    // Every user operation records into one of the global histograms, so they are not protected
+    // by _lock.
+    ConcurrentLatencyHistogram _globalReads;
+    ConcurrentLatencyHistogram _globalWrites;
+    ConcurrentLatencyHistogram _globalCommands;
+    ConcurrentLatencyHistogram _globalTransactions;
+
     UsageMap _usage;
     std::set<std::string> _collDropNs;
 };
@@ -70,17 +70,13 @@ std::unique_ptr<::mongo::RecordStore> KVEngine::getRecordStore(OperationContext*
     return std::make_unique<RecordStore>(ns, ident);
 }
 
-void KVEngine::setMaster_inlock(std::unique_ptr<StringStore> newMaster) {
-    _master.reset(newMaster.release());
-}
-
 std::shared_ptr<StringStore> KVEngine::getMaster() const {
-    stdx::lock_guard<stdx::mutex> lk(_masterLock);
-    return _master;
+    return std::atomic_load(&_master);
 }
 
-std::shared_ptr<StringStore> KVEngine::getMaster_inlock() const {
-    return _master;
+bool KVEngine::trySetMaster(std::shared_ptr<StringStore>* expected,
+                            const std::shared_ptr<StringStore>& newMaster) {
+    return std::atomic_compare_exchange_strong(&_master, expected, newMaster);
 }
 
 
@@ -44,9 +44,9 @@ class JournalListener;
  * The biggie storage engine is intended for unit and performance testing.
  */
 class KVEngine : public ::mongo::KVEngine {
+    // Only accessed through the std::atomic_* functions for shared_ptr.
     std::shared_ptr<StringStore> _master = std::make_shared<StringStore>();
     std::map<std::string, bool> _idents;  // TODO : replace with a query to _master.
-    mutable stdx::mutex _masterLock;
 
 public:
     KVEngine() : ::mongo::KVEngine() {}
@@ -135,20 +135,16 @@ public:
 
     // Biggie Specific
 
-    /**
-     * Used to replace the master branch of the store with an updated copy.
-     * Appropriate lock must be taken externally.
-     */
-    void setMaster_inlock(std::unique_ptr<StringStore> newMaster);
-
     std::shared_ptr<StringStore> getMaster() const;
-    std::shared_ptr<StringStore> getMaster_inlock() const;
+
     /**
-     * Get the lock around the master branch.
+     * Replaces the master branch of the store with 'newMaster' if the master is still '*expected',
+     * i.e. no other writer has committed since '*expected' was read. Otherwise returns false and
+     * sets '*expected' to the current master, which 'newMaster' must be merged with before trying
+     * again.
      */
-    stdx::mutex& getMasterLock() {
-        return _masterLock;
-    }
+    bool trySetMaster(std::shared_ptr<StringStore>* expected,
+                      const std::shared_ptr<StringStore>& newMaster);
 
 private:
     std::shared_ptr<void> _catalogInfo;
@@ -47,20 +47,24 @@ void RecoveryUnit::beginUnitOfWork(OperationContext* opCtx) {}
 
 void RecoveryUnit::commitUnitOfWork() {
     if (_dirty && _workingCopy) {
+        std::shared_ptr<StringStore> master = _KVEngine->getMaster();
         while (true) {
-            std::shared_ptr<StringStore> master = _KVEngine->getMaster();
-            try {
-                _workingCopy->merge3(*_mergeBase, *master);
-            } catch (const merge_conflict_exception&) {
-                throw WriteConflictException();
+            if (master != _mergeBase) {
+                try {
+                    _workingCopy->merge3(*_mergeBase, *master);
+                } catch (const merge_conflict_exception&) {
+                    throw WriteConflictException();
+                }
+                // The working copy now includes everything in 'master', so if another writer
+                // commits first, only the changes since 'master' need merging in.
+                _mergeBase = master;
             }
-            stdx::lock_guard<stdx::mutex> lkOnMaster(_KVEngine->getMasterLock());
-            if (_KVEngine->getMaster_inlock() == master) {
-                _KVEngine->setMaster_inlock(std::move(_workingCopy));
-                _mergeBase.reset();
+            if (_KVEngine->trySetMaster(&master, _workingCopy)) {
                 break;
             }
         }
+        _workingCopy.reset();
+        _mergeBase.reset();
         _dirty = false;
     }
     try {
@@ -114,7 +118,7 @@ bool RecoveryUnit::forkIfNeeded() {
         return false;
     }
     _mergeBase = _KVEngine->getMaster();
-    _workingCopy = std::make_unique<StringStore>(*_mergeBase);
+    _workingCopy = std::make_shared<StringStore>(*_mergeBase);
     return true;
 }
 
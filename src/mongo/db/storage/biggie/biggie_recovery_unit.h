@@ -47,7 +47,7 @@ class RecoveryUnit : public ::mongo::RecoveryUnit {
     KVEngine* _KVEngine;
     bool _dirty = false;  // Whether or not we have written to this _workingCopy.
     std::shared_ptr<StringStore> _mergeBase;
-    std::unique_ptr<StringStore> _workingCopy;
+    std::shared_ptr<StringStore> _workingCopy;
 
 public:
     RecoveryUnit(KVEngine* parentKVEngine, stdx::function<void()> cb = nullptr);
@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/biggie/biggie_recovery_unit.h"
+
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/storage/biggie/biggie_kv_engine.h"
+#include "mongo/db/storage/biggie/store.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace biggie {
+namespace {
+
+void insert(RecoveryUnit* ru, std::string key, std::string value) {
+    ru->forkIfNeeded();
+    ru->getWorkingCopy()->insert(StringStore::value_type(std::move(key), std::move(value)));
+    ru->makeDirty();
+}
+
+TEST(BiggieRecoveryUnitTest, WritersOfDisjointKeysBothCommit) {
+    KVEngine engine;
+    RecoveryUnit first(&engine);
+    RecoveryUnit second(&engine);
+
+    insert(&first, "a", "1");
+    insert(&second, "b", "2");
+    first.commitUnitOfWork();
+    second.commitUnitOfWork();
+
+    auto master = engine.getMaster();
+    ASSERT_EQ(2U, master->size());
+    ASSERT_EQ("1", master->find("a")->second);
+    ASSERT_EQ("2", master->find("b")->second);
+}
+
+TEST(BiggieRecoveryUnitTest, WriterMergesEveryCommitSinceItForked) {
+    KVEngine engine;
+    RecoveryUnit writer(&engine);
+    insert(&writer, "a", "1");
+
+    for (auto key : {"b", "c", "d"}) {
+        RecoveryUnit other(&engine);
+        insert(&other, key, key);
+        other.commitUnitOfWork();
+    }
+    writer.commitUnitOfWork();
+
+    auto master = engine.getMaster();
+    ASSERT_EQ(4U, master->size());
+    ASSERT_EQ("1", master->find("a")->second);
+    ASSERT_EQ("d", master->find("d")->second);
+}
+
+TEST(BiggieRecoveryUnitTest, WritersOfTheSameKeyConflict) {
+    KVEngine engine;
+    RecoveryUnit first(&engine);
+    RecoveryUnit second(&engine);
+
+    insert(&first, "a", "1");
+    insert(&second, "a", "2");
+    first.commitUnitOfWork();
+    ASSERT_THROWS(second.commitUnitOfWork(), WriteConflictException);
+    second.abortUnitOfWork();
+
+    auto master = engine.getMaster();
+    ASSERT_EQ(1U, master->size());
+    ASSERT_EQ("1", master->find("a")->second);
+}
+
+}  // namespace
+}  // namespace biggie
+}  // namespace mongo
@@ -0,0 +1,92 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/clustered_id.h"
+
+#include <cmath>
+
+#include "mongo/bson/bson_validate.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/util/debug_util.h"
+
+namespace mongo {
+namespace clusteredid {
+
+namespace {
+
+// Added to the _id values so that negative values map to positive RecordIds.
+const long long kOffset = 1LL << 62;
+
+}  // namespace
+
+StatusWith<RecordId> keyForId(const BSONElement& id) {
+    long long value;
+    switch (id.type()) {
+        case NumberInt:
+            value = id._numberInt();
+            break;
+        case NumberLong:
+            value = id._numberLong();
+            break;
+        case NumberDouble: {
+            const double number = id._numberDouble();
+            if (std::trunc(number) != number || number <= -kOffset || number >= kOffset) {
+                return {ErrorCodes::BadValue,
+                        "_id of a document in a clustered collection must be an integer"};
+            }
+            value = static_cast<long long>(number);
+            break;
+        }
+        default:
+            return {ErrorCodes::BadValue,
+                    "_id of a document in a clustered collection must be an integer"};
+    }
+
+    if (value <= -kOffset || value >= kOffset - 1) {
+        return {ErrorCodes::BadValue,
+                "_id of a document in a clustered collection must be between -2^62 and 2^62 - 1"};
+    }
+    return RecordId(value + kOffset);
+}
+
+StatusWith<RecordId> extractKey(const char* data, int len) {
+    DEV invariant(validateBSON(data, len, BSONVersion::kLatest).isOK());
+
+    const BSONObj obj(data);
+    const BSONElement id = obj["_id"];
+    if (id.eoo()) {
+        return {ErrorCodes::BadValue, "a document in a clustered collection must have an _id"};
+    }
+    return keyForId(id);
+}
+
+}  // namespace clusteredid
+}  // namespace mongo
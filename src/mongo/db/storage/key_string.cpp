@@ -248,6 +248,23 @@ T readType(BufReader* reader, bool inverted) {
     return t;
 }
 
+/**
+ * Reads the big-endian integer part of a kNumeric*ByteInt value with a single bounds check
+ * rather than one per byte.
+ */
+uint64_t readIntegerPart(BufReader* reader, uint8_t ctype, bool inverted) {
+    const size_t numBytes = CType::numBytesForInt(ctype);
+    const uint8_t* bytes = static_cast<const uint8_t*>(reader->skip(numBytes));
+    uint64_t value = 0;
+    for (size_t i = 0; i < numBytes; i++) {
+        value = (value << 8) | bytes[i];
+    }
+
+    if (inverted)
+        value ^= numBytes == sizeof(uint64_t) ? ~0ULL : (1ULL << (numBytes * 8)) - 1;
+    return value;
+}
+
 StringData readCString(BufReader* reader) {
     const char* start = static_cast<const char*>(reader->pos());
     const char* end = static_cast<const char*>(memchr(start, 0x0, reader->remaining()));
@@ -1560,15 +1577,7 @@ void toBsonValue(uint8_t ctype,
         case CType::kNumericPositive7ByteInt:
         case CType::kNumericPositive8ByteInt: {
             const uint8_t originalType = typeBits->readNumeric();
-
-            uint64_t encodedIntegerPart = 0;
-            {
-                size_t intBytesRemaining = CType::numBytesForInt(ctype);
-                while (intBytesRemaining--) {
-                    encodedIntegerPart =
-                        (encodedIntegerPart << 8) | readType<uint8_t>(reader, inverted);
-                }
-            }
+            const uint64_t encodedIntegerPart = readIntegerPart(reader, ctype, inverted);
 
             const bool haveFractionalPart = (encodedIntegerPart & 1);
             int64_t integerPart = encodedIntegerPart >> 1;
@@ -1672,6 +1681,87 @@ void toBsonValue(uint8_t ctype,
     }
 }
 
+/**
+ * Fast path for keys whose TypeBits are all zeros, meaning every string is a String and every
+ * integral number is a NumberInt. Decodes the types most index keys are made of straight into
+ * 'builder' and returns true. Returns false without consuming anything for any other value, so
+ * that the caller can fall back to toBsonValue().
+ */
+bool appendValueWithAllZerosTypeBits(uint8_t ctype,
+                                     BufReader* reader,
+                                     bool inverted,
+                                     BSONObjBuilder* builder) {
+    bool isNegative = false;
+
+    switch (ctype) {
+        case CType::kDate:
+            builder->appendDate("",
+                                Date_t::fromMillisSinceEpoch(
+                                    endian::bigToNative(readType<uint64_t>(reader, inverted)) ^
+                                    (1LL << 63)));
+            return true;
+
+        case CType::kOID:
+            if (inverted) {
+                char buf[OID::kOIDSize];
+                memcpy_flipBits(buf, reader->skip(OID::kOIDSize), OID::kOIDSize);
+                builder->append("", OID::from(buf));
+            } else {
+                builder->append("", OID::from(reader->skip(OID::kOIDSize)));
+            }
+            return true;
+
+        case CType::kStringLike: {
+            if (inverted)
+                return false;
+            std::string scratch;
+            builder->append("", readCStringWithNuls(reader, &scratch));
+            return true;
+        }
+
+        case CType::kNumericZero:
+            builder->append("", 0);
+            return true;
+
+        case CType::kNumericNegative8ByteInt:
+        case CType::kNumericNegative7ByteInt:
+        case CType::kNumericNegative6ByteInt:
+        case CType::kNumericNegative5ByteInt:
+        case CType::kNumericNegative4ByteInt:
+        case CType::kNumericNegative3ByteInt:
+        case CType::kNumericNegative2ByteInt:
+        case CType::kNumericNegative1ByteInt:
+            inverted = !inverted;
+            isNegative = true;
+        // fallthrough (format is the same as positive, but inverted)
+
+        case CType::kNumericPositive1ByteInt:
+        case CType::kNumericPositive2ByteInt:
+        case CType::kNumericPositive3ByteInt:
+        case CType::kNumericPositive4ByteInt:
+        case CType::kNumericPositive5ByteInt:
+        case CType::kNumericPositive6ByteInt:
+        case CType::kNumericPositive7ByteInt:
+        case CType::kNumericPositive8ByteInt: {
+            // The low bit of the last integer byte flags a fractional part, which only the
+            // generic path decodes. Check it before consuming anything.
+            const size_t numBytes = CType::numBytesForInt(ctype);
+            if (reader->remaining() < numBytes)
+                return false;
+            const uint8_t lastByte = static_cast<const uint8_t*>(reader->pos())[numBytes - 1];
+            if ((inverted ? ~lastByte : lastByte) & 1)
+                return false;
+
+            int64_t integerPart = readIntegerPart(reader, ctype, inverted) >> 1;
+            builder->append("", int(isNegative ? -integerPart : integerPart));
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
 void filterKeyFromKeyString(uint8_t ctype,
                             BufReader* reader,
                             bool inverted,
@@ -2056,6 +2146,10 @@ BSONObj KeyString::toBsonSafe(const char* buffer,
 
         if (ctype == kEnd)
             break;
+        if (typeBits.isAllZeros() &&
+            appendValueWithAllZerosTypeBits(ctype, &reader, invert, &builder)) {
+            continue;
+        }
         toBsonValue(ctype, &reader, &typeBitsReader, invert, typeBits.version, &(builder << ""));
     }
     return builder.obj();
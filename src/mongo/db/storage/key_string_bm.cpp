@@ -36,6 +36,7 @@
 
 #include "mongo/db/storage/key_string.h"
 #include "mongo/platform/decimal128.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/bufreader.h"
 #include "mongo/util/log.h"
 
@@ -61,10 +62,13 @@ struct BsonsAndKeyStrings {
 
 enum BsonValueType {
     INT,
+    LONG,
     DOUBLE,
     STRING,
     ARRAY,
     DECIMAL,
+    OBJECTID,
+    COMPOUND,
 };
 
 BSONObj generateBson(BsonValueType bsonValueType) {
@@ -75,6 +79,8 @@ BSONObj generateBson(BsonValueType bsonValueType) {
     switch (bsonValueType) {
         case INT:
             return BSON("" << static_cast<int>(expReal(gen)));
+        case LONG:
+            return BSON("" << static_cast<long long>(expReal(gen)));
         case DOUBLE:
             return BSON("" << expReal(gen));
         case STRING:
@@ -92,6 +98,15 @@ BSONObj generateBson(BsonValueType bsonValueType) {
                                          Decimal128::kRoundTo34Digits,
                                          Decimal128::kRoundTiesToAway)
                                   .quantize(Decimal128("0.01", Decimal128::kRoundTiesToAway)));
+        case OBJECTID:
+            return BSON("" << OID::gen());
+        case COMPOUND:
+            // Shaped like a {tenantId, userId, ts} index key, where every key in a run shares a
+            // long leading field.
+            return BSON("" << std::string(kStrLenMultiplier / 2, 't') << ""
+                           << static_cast<int>(expReal(gen))
+                           << ""
+                           << Date_t::fromMillisSinceEpoch(static_cast<long long>(expReal(gen))));
     }
     MONGO_UNREACHABLE;
 }
@@ -152,8 +167,27 @@ void BM_KeyStringToBSON(benchmark::State& state,
     state.SetItemsProcessed(state.iterations() * kSampleSize);
 }
 
+void BM_KeyStringCompare(benchmark::State& state,
+                         const KeyString::Version version,
+                         BsonValueType bsonType) {
+    std::vector<std::unique_ptr<KeyString>> keyStrings;
+    for (int i = 0; i < kSampleSize; i++) {
+        keyStrings.push_back(
+            stdx::make_unique<KeyString>(version, generateBson(bsonType), ALL_ASCENDING));
+    }
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        for (size_t i = 1; i < kSampleSize; i++) {
+            benchmark::DoNotOptimize(keyStrings[i - 1]->compare(*keyStrings[i]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (kSampleSize - 1));
+}
+
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Int, KeyString::Version::V0, INT);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Int, KeyString::Version::V1, INT);
+BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Long, KeyString::Version::V1, LONG);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Double, KeyString::Version::V0, DOUBLE);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Double, KeyString::Version::V1, DOUBLE);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Decimal, KeyString::Version::V1, DECIMAL);
@@ -161,9 +195,13 @@ BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_String, KeyString::Version::V0, STRING)
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_String, KeyString::Version::V1, STRING);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Array, KeyString::Version::V0, ARRAY);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Array, KeyString::Version::V1, ARRAY);
+BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_ObjectId, KeyString::Version::V1, OBJECTID);
+BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Compound, KeyString::Version::V0, COMPOUND);
+BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Compound, KeyString::Version::V1, COMPOUND);
 
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Int, KeyString::Version::V0, INT);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Int, KeyString::Version::V1, INT);
+BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Long, KeyString::Version::V1, LONG);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Double, KeyString::Version::V0, DOUBLE);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Double, KeyString::Version::V1, DOUBLE);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Decimal, KeyString::Version::V1, DECIMAL);
@@ -171,5 +209,11 @@ BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_String, KeyString::Version::V0, STRING)
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_String, KeyString::Version::V1, STRING);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Array, KeyString::Version::V0, ARRAY);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Array, KeyString::Version::V1, ARRAY);
+BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_ObjectId, KeyString::Version::V1, OBJECTID);
+BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Compound, KeyString::Version::V0, COMPOUND);
+BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Compound, KeyString::Version::V1, COMPOUND);
+
+BENCHMARK_CAPTURE(BM_KeyStringCompare, V1_String, KeyString::Version::V1, STRING);
+BENCHMARK_CAPTURE(BM_KeyStringCompare, V1_Compound, KeyString::Version::V1, COMPOUND);
 }  // namespace
 }  // namespace mongo
@@ -366,6 +366,28 @@ TEST_F(KeyStringTest, Compound1) {
     ROUNDTRIP(version, BSON("" << BSON("" << 5) << "" << 1));
 }
 
+TEST_F(KeyStringTest, CompoundWithAllZerosTypeBits) {
+    const auto oid = OID("abcdefabcdefabcdefabcdef");
+    const std::string tenant = "tenant";
+    const BSONObj keys[] = {
+        BSON("" << tenant << "" << 0 << "" << oid),
+        BSON("" << tenant << "" << 1 << "" << Date_t::fromMillisSinceEpoch(-1)),
+        BSON("" << tenant << "" << -1 << "" << Date_t::fromMillisSinceEpoch(1500000000000LL)),
+        BSON("" << std::numeric_limits<int>::max() << "" << std::numeric_limits<int>::min()),
+        BSON("" << StringData("with\0nul", 8) << "" << 255 << "" << -256 << "" << 65536),
+        BSON("" << oid << "" << std::string() << "" << 1234567),
+    };
+
+    for (auto&& key : keys) {
+        ASSERT(KeyString(version, key, ALL_ASCENDING).getTypeBits().isAllZeros());
+        ROUNDTRIP(version, key);
+    }
+
+    // Keys with any non-default type bits keep using the generic decoder.
+    ROUNDTRIP(version, BSON("" << tenant << "" << 5LL << "" << 1.5));
+    ROUNDTRIP(version, BSON("" << 3 << "" << BSONSymbol("sym") << "" << 4.0));
+}
+
 TEST_F(KeyStringTest, Undef1) {
     ROUNDTRIP(version, BSON("" << BSONUndefined));
 }
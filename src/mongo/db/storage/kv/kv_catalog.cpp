@@ -37,6 +37,7 @@
 #include "mongo/bson/util/bson_extract.h"
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/kv/kv_catalog_feature_tracker.h"
@@ -129,6 +130,34 @@ std::string escapeDbName(StringData dbname) {
     return escaped;
 }
 
+// Grouped idents end in a name that starts with this, see KVCatalog::_groupedIdent().
+const char kGroupedIdentName[] = "group-";
+
+/**
+ * Returns true if a prefixed collection with these options may share its table with the other
+ * grouped collections of its database. Capped collections truncate their own table and custom
+ * storage engine options would not apply to a shared table, so these get a table of their own.
+ */
+bool isGroupableCollection(KVPrefix prefix, const CollectionOptions& options) {
+    return prefix.isPrefixed() && !options.capped && options.storageEngine.isEmpty();
+}
+
+/**
+ * Returns true if a prefixed index may share its table with the other grouped indexes of its
+ * collection's database that have the same index version. The data format of unique indexes other
+ * than the _id index depends on the featureCompatibilityVersion they were created with, so they
+ * are never grouped.
+ */
+bool isGroupableIndex(const BSONCollectionCatalogEntry::MetaData& md,
+                      const BSONCollectionCatalogEntry::IndexMetaData& imd) {
+    if (!imd.prefix.isPrefixed() || imd.spec.hasField("storageEngine") ||
+        md.options.indexOptionDefaults.hasField("storageEngine")) {
+        return false;
+    }
+    return !imd.spec["unique"].trueValue() ||
+        IndexDescriptor::isIdIndexPattern(imd.spec["key"].Obj());
+}
+
 }  // namespace
 
 using std::unique_ptr;
@@ -350,6 +379,22 @@ std::string KVCatalog::_newUniqueIdent(StringData ns, const char* kind) {
     return buf.str();
 }
 
+std::string KVCatalog::_groupedIdent(StringData ns, const char* kind, StringData group) const {
+    const std::string dbName = escapeDbName(nsToDatabaseSubstring(ns));
+    StringBuilder buf;
+    if (_directoryPerDb) {
+        buf << dbName << '/';
+    }
+    buf << kind;
+    buf << (_directoryForIndexes ? '/' : '-');
+    buf << kGroupedIdentName;
+    if (!group.empty()) {
+        buf << group << '-';
+    }
+    buf << dbName;
+    return buf.str();
+}
+
 void KVCatalog::init(OperationContext* opCtx) {
     // No locking needed since called single threaded.
     auto cursor = _rs->getCursor(opCtx);
@@ -397,7 +442,9 @@ Status KVCatalog::newCollection(OperationContext* opCtx,
                                 KVPrefix prefix) {
     invariant(opCtx->lockState()->isDbLockedForMode(nsToDatabaseSubstring(ns), MODE_X));
 
-    const string ident = _newUniqueIdent(ns, "collection");
+    const string ident = isGroupableCollection(prefix, options)
+        ? _groupedIdent(ns, "collection", "")
+        : _newUniqueIdent(ns, "collection");
 
     stdx::lock_guard<stdx::mutex> lk(_identsLock);
     Entry& old = _idents[ns.toString()];
@@ -505,7 +552,13 @@ void KVCatalog::putMetaData(OperationContext* opCtx,
                 continue;
             }
             // missing, create new
-            newIdentMap.append(name, _newUniqueIdent(ns, "index"));
+            const BSONCollectionCatalogEntry::IndexMetaData& imd = md.indexes[i];
+            if (isGroupableIndex(md, imd)) {
+                const std::string group = str::stream() << 'v' << imd.spec["v"].numberInt();
+                newIdentMap.append(name, _groupedIdent(ns, "index", group));
+            } else {
+                newIdentMap.append(name, _newUniqueIdent(ns, "index"));
+            }
         }
         b.append("idxIdent", newIdentMap.obj());
 
@@ -629,6 +682,15 @@ bool KVCatalog::isCollectionIdent(StringData ident) const {
         ident.find("collection/") != std::string::npos;
 }
 
+bool KVCatalog::isGroupedIdent(StringData ident) const {
+    // Only the last path component names the table; it starts with the kind of "thing" unless
+    // 'directoryForIndexes' put the kind in a directory of its own.
+    const size_t lastSlash = ident.rfind('/');
+    const StringData name = lastSlash == std::string::npos ? ident : ident.substr(lastSlash + 1);
+    return name.startsWith(kGroupedIdentName) || name.startsWith("collection-group-") ||
+        name.startsWith("index-group-");
+}
+
 StatusWith<std::string> KVCatalog::newOrphanedIdent(OperationContext* opCtx, std::string ident) {
     // The collection will be named local.orphan.xxxxx.
     std::string identNs = ident;
@@ -94,6 +94,13 @@ public:
 
     bool isCollectionIdent(StringData ident) const;
 
+    /**
+     * Returns true if 'ident' names a table shared by several collections or indexes of a database,
+     * whose entries are told apart by the KVPrefix of each collection or index. Such a table must
+     * not be dropped along with one of them.
+     */
+    bool isGroupedIdent(StringData ident) const;
+
     FeatureTracker* getFeatureTracker() const {
         invariant(_featureTracker);
         return _featureTracker.get();
@@ -124,6 +131,12 @@ private:
      */
     std::string _newUniqueIdent(StringData ns, const char* kind);
 
+    /**
+     * Returns the identifier of the table shared by the grouped "things" of 'ns''s database that
+     * are of the same 'kind' and 'group'. Used when 'storageGlobalParams.groupCollections' is true.
+     */
+    std::string _groupedIdent(StringData ns, const char* kind, StringData group) const;
+
     // Helpers only used by constructor and init(). Don't call from elsewhere.
     static std::string _newRand();
     bool _hasEntryCollidingWithRand() const;
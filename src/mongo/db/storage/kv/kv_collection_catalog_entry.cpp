@@ -178,11 +178,24 @@ Status KVCollectionCatalogEntry::removeIndex(OperationContext* opCtx, StringData
 
     const string ident = _catalog->getIndexIdent(opCtx, ns().ns(), indexName);
 
+    // The entries of an index sharing its table with other indexes are removed in this unit of
+    // work, whereas a table of its own is dropped once the removal commits.
+    const bool grouped = _catalog->isGroupedIdent(ident);
+    if (grouped) {
+        const KVPrefix prefix = md.indexes[md.findIndexOffset(indexName)].prefix;
+        Status status = _engine->dropIdentPrefix(opCtx, ident, prefix);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
     md.eraseIndex(indexName);
     _catalog->putMetaData(opCtx, ns().toString(), md);
 
     // Lazily remove to isolate underlying engine from rollback.
-    opCtx->recoveryUnit()->registerChange(new RemoveIndexChange(opCtx, this, ident));
+    if (!grouped) {
+        opCtx->recoveryUnit()->registerChange(new RemoveIndexChange(opCtx, this, ident));
+    }
     return Status::OK();
 }
 
@@ -217,7 +230,8 @@ Status KVCollectionCatalogEntry::prepareForIndexBuild(OperationContext* opCtx,
     string ident = _catalog->getIndexIdent(opCtx, ns().ns(), spec->indexName());
 
     const Status status = _engine->createGroupedSortedDataInterface(opCtx, ident, spec, prefix);
-    if (status.isOK()) {
+    // Rolling back the creation of an index in a shared table only removes its entries.
+    if (status.isOK() && !_catalog->isGroupedIdent(ident)) {
         opCtx->recoveryUnit()->registerChange(new AddIndexChange(opCtx, this, ident));
     }
 
@@ -279,6 +293,12 @@ void KVCollectionCatalogEntry::setIsTemp(OperationContext* opCtx, bool isTemp) {
     _catalog->putMetaData(opCtx, ns().toString(), md);
 }
 
+void KVCollectionCatalogEntry::setRecordChangeStreamImages(OperationContext* opCtx, bool record) {
+    MetaData md = _getMetaData(opCtx);
+    md.options.recordChangeStreamImages = record;
+    _catalog->putMetaData(opCtx, ns().toString(), md);
+}
+
 void KVCollectionCatalogEntry::updateCappedSize(OperationContext* opCtx, long long size) {
     MetaData md = _getMetaData(opCtx);
     md.options.cappedSize = size;
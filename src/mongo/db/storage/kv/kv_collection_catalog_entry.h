@@ -89,6 +89,8 @@ public:
 
     void setIsTemp(OperationContext* opCtx, bool isTemp);
 
+    void setRecordChangeStreamImages(OperationContext* opCtx, bool record) final;
+
     void updateCappedSize(OperationContext*, long long int) final;
 
     bool isEqualToMetadataUUID(OperationContext* opCtx, OptionalCollectionUUID uuid) final;
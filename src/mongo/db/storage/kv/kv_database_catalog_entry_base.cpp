@@ -230,7 +230,11 @@ Status KVDatabaseCatalogEntryBase::createCollection(OperationContext* opCtx,
         }
     }
 
-    opCtx->recoveryUnit()->registerChange(new AddCollectionChange(opCtx, this, ns, ident, true));
+    // A table shared with other collections is left in place; rolling back removes the entries of
+    // this collection from it.
+    const bool dropOnRollback = !_engine->getCatalog()->isGroupedIdent(ident);
+    opCtx->recoveryUnit()->registerChange(
+        new AddCollectionChange(opCtx, this, ns, ident, dropOnRollback));
 
     auto rs = _engine->getEngine()->getGroupedRecordStore(opCtx, ns, ident, options, prefix);
     invariant(rs);
@@ -359,6 +363,17 @@ Status KVDatabaseCatalogEntryBase::dropCollection(OperationContext* opCtx, Strin
 
     const std::string ident = _engine->getCatalog()->getCollectionIdent(ns);
 
+    // The entries of a collection sharing its table with other collections are removed in this
+    // unit of work, whereas a table of its own is dropped once the drop commits.
+    const bool grouped = _engine->getCatalog()->isGroupedIdent(ident);
+    if (grouped) {
+        const KVPrefix prefix = _engine->getCatalog()->getMetaData(opCtx, ns).prefix;
+        Status status = _engine->getEngine()->dropIdentPrefix(opCtx, ident, prefix);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
     Status status = _engine->getCatalog()->dropCollection(opCtx, ns);
     if (!status.isOK()) {
         return status;
@@ -367,7 +382,7 @@ Status KVDatabaseCatalogEntryBase::dropCollection(OperationContext* opCtx, Strin
     // This will lazily delete the KVCollectionCatalogEntry and notify the storageEngine to
     // drop the collection only on WUOW::commit().
     opCtx->recoveryUnit()->registerChange(
-        new RemoveCollectionChange(opCtx, this, ns, ident, it->second, true));
+        new RemoveCollectionChange(opCtx, this, ns, ident, it->second, !grouped));
 
     _collections.erase(ns.toString());
 
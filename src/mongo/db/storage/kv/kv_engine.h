@@ -172,6 +172,15 @@ public:
 
     virtual Status dropIdent(OperationContext* opCtx, StringData ident) = 0;
 
+    /**
+     * Removes the entries prefixed by 'prefix' from the table 'ident' shares with other grouped
+     * collections or indexes, as part of the caller's unit of work. The table itself is kept.
+     */
+    virtual Status dropIdentPrefix(OperationContext* opCtx, StringData ident, KVPrefix prefix) {
+        return Status(ErrorCodes::CommandNotSupported,
+                      "This storage engine does not support grouped collections");
+    }
+
     /**
      * Attempts to locate and recover a file that is "orphaned" from the storage engine's metadata,
      * but may still exist on disk if this is a durable storage engine. Returns DataModifiedByRepair
@@ -0,0 +1,321 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/kv/kv_engine_bm_harness.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/operation_context_noop.h"
+#include "mongo/db/stats/concurrent_latency_histogram.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/random.h"
+#include "mongo/stdx/chrono.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+stdx::function<std::unique_ptr<KVBenchmarkHelper>()> benchmarkFactory =
+    []() -> std::unique_ptr<KVBenchmarkHelper> { MONGO_UNREACHABLE; };
+
+// Number of records loaded into the record store and its index before each benchmark runs.
+const int kPreloadedRecords = 10000;
+
+// Number of index entries, and the records they point to, read by each range scan.
+const int kRangeScanLength = 100;
+
+const std::string kNs = "bm.records";
+const std::string kRecordStoreIdent = "bm-records";
+const std::string kIndexIdent = "bm-index";
+
+class BenchmarkOperationContext : public OperationContextNoop {
+public:
+    explicit BenchmarkOperationContext(KVEngine* engine)
+        : OperationContextNoop(engine->newRecoveryUnit()) {}
+};
+
+BSONObj makeKey(long long key) {
+    return BSON("" << key);
+}
+
+/**
+ * Shared by all threads of a benchmark run: a fresh engine, a record store preloaded with
+ * kPreloadedRecords records of the value size given by the benchmark argument, an index with one
+ * entry per record, and a histogram of the latencies of the operations the threads run.
+ *
+ * Record i is indexed under key i. Threads only update and delete the records i for which
+ * i % threads == thread_index, so those workloads measure the engine rather than write conflicts
+ * between the threads.
+ */
+class KVEngineBenchmark : public benchmark::Fixture {
+public:
+    void setUpWorkload(const benchmark::State& state) {
+        _helper = KVBenchmarkHelper::create();
+        _engine = _helper->getEngine();
+        _value = std::string(state.range(0), 'v');
+        _updatedValue = std::string(state.range(0), 'u');
+        _latencies = stdx::make_unique<ConcurrentLatencyHistogram>();
+
+        BenchmarkOperationContext opCtx(_engine);
+        uassertStatusOK(_engine->createRecordStore(&opCtx, kNs, kRecordStoreIdent, {}));
+        _rs = _engine->getRecordStore(&opCtx, kNs, kRecordStoreIdent, {});
+
+        _indexDescriptor = stdx::make_unique<IndexDescriptor>(
+            nullptr, "", BSON("v" << 2 << "key" << BSON("a" << 1) << "name" << "a_1"));
+        uassertStatusOK(
+            _engine->createSortedDataInterface(&opCtx, kIndexIdent, _indexDescriptor.get()));
+        _index.reset(
+            _engine->getSortedDataInterface(&opCtx, kIndexIdent, _indexDescriptor.get()));
+
+        _ids.resize(kPreloadedRecords);
+        for (int i = 0; i < kPreloadedRecords; ++i) {
+            _ids[i] = insert(i, _value);
+        }
+        _nextKey.store(kPreloadedRecords);
+    }
+
+    void tearDownWorkload() {
+        _index.reset();
+        _indexDescriptor.reset();
+        _rs.reset();
+        _ids.clear();
+        _engine = nullptr;
+        _helper.reset();
+    }
+
+    /**
+     * Runs 'op' for each iteration of the benchmark on every thread, then reports throughput and
+     * latency percentiles. 'op' is passed a random number generator owned by the thread.
+     */
+    template <typename Op>
+    void run(benchmark::State& state, Op op) {
+        if (state.thread_index == 0) {
+            setUpWorkload(state);
+        }
+
+        PseudoRandom random(state.thread_index + 1);
+        for (auto keepRunning : state) {
+            auto start = stdx::chrono::steady_clock::now();
+            op(random);
+            auto elapsed = stdx::chrono::steady_clock::now() - start;
+            _latencies->record(
+                stdx::chrono::duration_cast<stdx::chrono::nanoseconds>(elapsed).count());
+        }
+        state.SetItemsProcessed(state.iterations());
+
+        if (state.thread_index == 0) {
+            auto latencies = _latencies->snapshot();
+            state.counters["p50_ns"] = latencies.percentile(0.5);
+            state.counters["p95_ns"] = latencies.percentile(0.95);
+            state.counters["p99_ns"] = latencies.percentile(0.99);
+            state.counters["p999_ns"] = latencies.percentile(0.999);
+            tearDownWorkload();
+        }
+    }
+
+    RecordId insert(long long key, const std::string& value) {
+        RecordId id;
+        runTransaction([&](OperationContext* opCtx) {
+            id = uassertStatusOK(
+                _rs->insertRecord(opCtx, value.c_str(), value.size(), Timestamp()));
+            uassertStatusOK(_index->insert(opCtx, makeKey(key), id, true));
+        });
+        return id;
+    }
+
+    void insertNew() {
+        insert(_nextKey.fetchAndAdd(1), _value);
+    }
+
+    void pointRead(long long key) {
+        BenchmarkOperationContext opCtx(_engine);
+        auto entry = _index->newCursor(&opCtx)->seekExact(makeKey(key));
+        invariant(entry);
+        RecordData data;
+        invariant(_rs->findRecord(&opCtx, entry->loc, &data));
+        benchmark::DoNotOptimize(data.data());
+    }
+
+    void rangeScan(long long startKey) {
+        BenchmarkOperationContext opCtx(_engine);
+        auto cursor = _index->newCursor(&opCtx);
+        auto entry = cursor->seek(makeKey(startKey), true);
+        for (int i = 0; entry && i < kRangeScanLength; ++i, entry = cursor->next()) {
+            RecordData data;
+            invariant(_rs->findRecord(&opCtx, entry->loc, &data));
+            benchmark::DoNotOptimize(data.data());
+        }
+    }
+
+    void update(int i) {
+        runTransaction([&](OperationContext* opCtx) {
+            uassertStatusOK(
+                _rs->updateRecord(opCtx, _ids[i], _updatedValue.c_str(), _updatedValue.size()));
+        });
+    }
+
+    void remove(int i) {
+        runTransaction([&](OperationContext* opCtx) {
+            _index->unindex(opCtx, makeKey(i), _ids[i], true);
+            _rs->deleteRecord(opCtx, _ids[i]);
+        });
+    }
+
+    /**
+     * Returns a random record owned by the calling thread.
+     */
+    static int ownedRecord(const benchmark::State& state, PseudoRandom& random) {
+        int owned = (kPreloadedRecords - state.thread_index + state.threads - 1) / state.threads;
+        return state.thread_index + state.threads * random.nextInt32(owned);
+    }
+
+private:
+    /**
+     * Runs 'op' in its own storage transaction, retrying it if it hits a write conflict.
+     */
+    template <typename F>
+    void runTransaction(F&& op) {
+        while (true) {
+            try {
+                BenchmarkOperationContext opCtx(_engine);
+                WriteUnitOfWork wuow(&opCtx);
+                op(&opCtx);
+                wuow.commit();
+                return;
+            } catch (const WriteConflictException&) {
+            }
+        }
+    }
+
+    std::unique_ptr<KVBenchmarkHelper> _helper;
+    KVEngine* _engine = nullptr;
+
+    std::string _value;
+    std::string _updatedValue;
+
+    std::unique_ptr<RecordStore> _rs;
+    std::unique_ptr<IndexDescriptor> _indexDescriptor;
+    std::unique_ptr<SortedDataInterface> _index;
+
+    // The ids of the preloaded records, indexed by their keys.
+    std::vector<RecordId> _ids;
+
+    // The key of the next record inserted by the benchmark.
+    AtomicInt64 _nextKey;
+
+    std::unique_ptr<ConcurrentLatencyHistogram> _latencies;
+};
+
+BENCHMARK_DEFINE_F(KVEngineBenchmark, Insert)(benchmark::State& state) {
+    run(state, [this](PseudoRandom&) { insertNew(); });
+}
+
+BENCHMARK_DEFINE_F(KVEngineBenchmark, PointRead)(benchmark::State& state) {
+    run(state, [this](PseudoRandom& random) { pointRead(random.nextInt32(kPreloadedRecords)); });
+}
+
+BENCHMARK_DEFINE_F(KVEngineBenchmark, RangeScan)(benchmark::State& state) {
+    run(state, [this](PseudoRandom& random) {
+        rangeScan(random.nextInt32(kPreloadedRecords - kRangeScanLength));
+    });
+}
+
+BENCHMARK_DEFINE_F(KVEngineBenchmark, Update)(benchmark::State& state) {
+    run(state, [this, &state](PseudoRandom& random) { update(ownedRecord(state, random)); });
+}
+
+BENCHMARK_DEFINE_F(KVEngineBenchmark, Delete)(benchmark::State& state) {
+    // Each thread deletes the records it owns in turn, and puts them back without timing it
+    // once it has deleted them all.
+    int next = state.thread_index;
+    run(state, [this, &state, &next](PseudoRandom&) {
+        if (next >= kPreloadedRecords) {
+            state.PauseTiming();
+            for (int i = state.thread_index; i < kPreloadedRecords; i += state.threads) {
+                _ids[i] = insert(i, _value);
+            }
+            next = state.thread_index;
+            state.ResumeTiming();
+        }
+        remove(next);
+        next += state.threads;
+    });
+}
+
+BENCHMARK_DEFINE_F(KVEngineBenchmark, Mixed)(benchmark::State& state) {
+    // A read-mostly mix: 80% point reads, 10% updates, 5% range scans and 5% inserts.
+    run(state, [this, &state](PseudoRandom& random) {
+        auto choice = random.nextInt32(100);
+        if (choice < 80) {
+            pointRead(random.nextInt32(kPreloadedRecords));
+        } else if (choice < 90) {
+            update(ownedRecord(state, random));
+        } else if (choice < 95) {
+            rangeScan(random.nextInt32(kPreloadedRecords - kRangeScanLength));
+        } else {
+            insertNew();
+        }
+    });
+}
+
+/**
+ * Every workload runs with 100 byte, 1KB and 16KB values, on 1 to 16 threads.
+ */
+void workloadArgs(benchmark::internal::Benchmark* b) {
+    b->Arg(100)->Arg(1024)->Arg(16 * 1024)->ThreadRange(1, 16)->UseRealTime();
+}
+
+BENCHMARK_REGISTER_F(KVEngineBenchmark, Insert)->Apply(workloadArgs);
+BENCHMARK_REGISTER_F(KVEngineBenchmark, PointRead)->Apply(workloadArgs);
+BENCHMARK_REGISTER_F(KVEngineBenchmark, RangeScan)->Apply(workloadArgs);
+BENCHMARK_REGISTER_F(KVEngineBenchmark, Update)->Apply(workloadArgs);
+BENCHMARK_REGISTER_F(KVEngineBenchmark, Delete)->Apply(workloadArgs);
+BENCHMARK_REGISTER_F(KVEngineBenchmark, Mixed)->Apply(workloadArgs);
+
+}  // namespace
+
+std::unique_ptr<KVBenchmarkHelper> KVBenchmarkHelper::create() {
+    return benchmarkFactory();
+}
+
+void KVBenchmarkHelper::registerFactory(
+    stdx::function<std::unique_ptr<KVBenchmarkHelper>()> factory) {
+    benchmarkFactory = std::move(factory);
+}
+
+}  // namespace mongo
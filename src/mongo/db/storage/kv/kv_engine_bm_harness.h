@@ -0,0 +1,57 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/stdx/functional.h"
+
+namespace mongo {
+
+/**
+ * Creates a harness for benchmarking all KVEngine implementations on equal terms.
+ *
+ * The benchmarks in kv_engine_bm_harness.cpp run insert, point read, range scan, update, delete
+ * and mixed workloads through the RecordStore and SortedDataInterface of whichever engine the
+ * registered factory creates. Each KVEngine implementation provides a Benchmark target which
+ * links against this library and registers a factory from a MONGO_INITIALIZER.
+ */
+class KVBenchmarkHelper {
+public:
+    virtual ~KVBenchmarkHelper() {}
+
+    // returns same thing for entire life
+    virtual KVEngine* getEngine() = 0;
+
+    static std::unique_ptr<KVBenchmarkHelper> create();
+    static void registerFactory(stdx::function<std::unique_ptr<KVBenchmarkHelper>()> factory);
+};
+
+}  // namespace mongo
@@ -158,7 +158,8 @@ void KVStorageEngine::loadCatalog(OperationContext* opCtx) {
         // 'local.orphan.xxxxx' for it. However, in a nonrepair context, the orphaned idents
         // will be dropped in reconcileCatalogAndIdents().
         for (const auto& ident : identsKnownToStorageEngine) {
-            if (_catalog->isCollectionIdent(ident)) {
+            // A shared table is not a collection of its own, even if no collection uses it.
+            if (_catalog->isCollectionIdent(ident) && !_catalog->isGroupedIdent(ident)) {
                 bool isOrphan = !std::any_of(collectionsKnownToCatalog.begin(),
                                              collectionsKnownToCatalog.end(),
                                              [this, &ident](const auto& coll) {
@@ -354,8 +355,10 @@ KVStorageEngine::reconcileCatalogAndIdents(OperationContext* opCtx) {
         }
 
         // In repair context, any orphaned collection idents from the engine should already be
-        // recovered in the catalog in loadCatalog().
-        invariant(!(_catalog->isCollectionIdent(it) && _options.forRepair));
+        // recovered in the catalog in loadCatalog(). Tables shared by grouped collections are
+        // dropped once no collection or index uses them.
+        invariant(!(_catalog->isCollectionIdent(it) && !_catalog->isGroupedIdent(it) &&
+                    _options.forRepair));
 
         const auto& toRemove = it;
         log() << "Dropping unknown ident: " << toRemove;
@@ -430,8 +433,16 @@ KVStorageEngine::reconcileCatalogAndIdents(OperationContext* opCtx) {
             if (!indexMetaData.ready && !indexMetaData.isBackgroundSecondaryBuild) {
                 log() << "Dropping unfinished index. Collection: " << coll
                       << " Index: " << indexName;
-                // Ensure the `ident` is dropped while we have the `indexIdent` value.
-                fassert(50713, _engine->dropIdent(opCtx, indexIdent));
+                // Ensure the `ident` is dropped while we have the `indexIdent` value. Only the
+                // entries of an index sharing its table with other indexes are removed.
+                if (_catalog->isGroupedIdent(indexIdent)) {
+                    WriteUnitOfWork wuow(opCtx);
+                    fassert(51532,
+                            _engine->dropIdentPrefix(opCtx, indexIdent, indexMetaData.prefix));
+                    wuow.commit();
+                } else {
+                    fassert(50713, _engine->dropIdent(opCtx, indexIdent));
+                }
                 indexesToDrop.push_back(indexName);
                 continue;
             }
@@ -33,6 +33,7 @@
 #include "mongo/base/init.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/kv/kv_storage_engine.h"
+#include "mongo/db/storage/mobile/mobile_global_options.h"
 #include "mongo/db/storage/mobile/mobile_kv_engine.h"
 #include "mongo/db/storage/storage_engine_init.h"
 #include "mongo/db/storage/storage_options.h"
@@ -52,7 +53,12 @@ public:
         options.directoryPerDB = params.directoryperdb;
         options.forRepair = params.repair;
 
-        MobileKVEngine* kvEngine = new MobileKVEngine(params.dbpath);
+        MobileSessionPool::Options sessionPoolOptions;
+        sessionPoolOptions.maxPoolSize = mobileGlobalOptions.maxSessionPoolSize;
+        sessionPoolOptions.cacheSizeKB = mobileGlobalOptions.sessionCacheSizeKB;
+        sessionPoolOptions.releaseMemoryOnRelease = mobileGlobalOptions.releaseSessionMemory;
+
+        MobileKVEngine* kvEngine = new MobileKVEngine(params.dbpath, sessionPoolOptions);
         return new KVStorageEngine(kvEngine, options);
     }
 
@@ -54,7 +54,8 @@ namespace mongo {
 class MobileSession;
 class SqliteStatement;
 
-MobileKVEngine::MobileKVEngine(const std::string& path) {
+MobileKVEngine::MobileKVEngine(const std::string& path,
+                               const MobileSessionPool::Options& sessionPoolOptions) {
     _initDBPath(path);
 
     // Initialize the database to be in WAL mode.
@@ -134,7 +135,7 @@ MobileKVEngine::MobileKVEngine(const std::string& path) {
                                   << ". Val: " << fullfsync_val;
     }
 
-    _sessionPool.reset(new MobileSessionPool(_path));
+    _sessionPool.reset(new MobileSessionPool(_path, sessionPoolOptions));
 }
 
 void MobileKVEngine::_initDBPath(const std::string& path) {
@@ -42,7 +42,9 @@ class JournalListener;
 
 class MobileKVEngine : public KVEngine {
 public:
-    MobileKVEngine(const std::string& path);
+    MobileKVEngine(const std::string& path,
+                   const MobileSessionPool::Options& sessionPoolOptions =
+                       MobileSessionPool::Options());
 
     RecoveryUnit* newRecoveryUnit() override;
 
@@ -35,8 +35,38 @@
 
 namespace mongo {
 
-MobileSession::MobileSession(sqlite3* session, MobileSessionPool* sessionPool)
-    : _session(session), _sessionPool(sessionPool) {}
+MobileStatementCache::MobileStatementCache() : _statements(kMaxCachedStatements) {}
+
+MobileStatementCache::~MobileStatementCache() {
+    for (auto&& entry : _statements) {
+        sqlite3_finalize(entry.second);
+    }
+}
+
+sqlite3_stmt* MobileStatementCache::take(const std::string& sqlQuery) {
+    auto it = _statements.find(sqlQuery);
+    if (it == _statements.end()) {
+        return nullptr;
+    }
+    sqlite3_stmt* stmt = it->second;
+    _statements.erase(it);
+    return stmt;
+}
+
+void MobileStatementCache::release(const std::string& sqlQuery, sqlite3_stmt* stmt) {
+    if (_statements.hasKey(sqlQuery)) {
+        sqlite3_finalize(stmt);
+        return;
+    }
+    if (auto evicted = _statements.add(sqlQuery, stmt)) {
+        sqlite3_finalize(*evicted);
+    }
+}
+
+MobileSession::MobileSession(sqlite3* session,
+                             MobileSessionPool* sessionPool,
+                             MobileStatementCache* statementCache)
+    : _session(session), _sessionPool(sessionPool), _statementCache(statementCache) {}
 
 MobileSession::~MobileSession() {
     // Releases this session back to the session pool.
@@ -46,4 +76,8 @@ MobileSession::~MobileSession() {
 sqlite3* MobileSession::getSession() const {
     return _session;
 }
+
+MobileStatementCache* MobileSession::getStatementCache() const {
+    return _statementCache;
+}
 }  // namespace mongo
@@ -33,10 +33,45 @@
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/storage/mobile/mobile_session_pool.h"
+#include "mongo/util/lru_cache.h"
 
 namespace mongo {
 class MobileSessionPool;
 
+/**
+ * This class keeps prepared statements open on a single SQLite connection, so that queries which
+ * run repeatedly are compiled once per connection rather than once per call. A statement is taken
+ * out of the cache while it is in use, so two users of a connection never share a statement.
+ */
+class MobileStatementCache final {
+    MONGO_DISALLOW_COPYING(MobileStatementCache);
+
+public:
+    static constexpr std::size_t kMaxCachedStatements = 64;
+
+    MobileStatementCache();
+
+    /**
+     * Finalizes all cached statements. This must happen before the connection is closed.
+     */
+    ~MobileStatementCache();
+
+    /**
+     * Removes and returns a prepared statement for the given query, or nullptr if there is none.
+     */
+    sqlite3_stmt* take(const std::string& sqlQuery);
+
+    /**
+     * Returns a reset statement to the cache. If the cache already holds a statement for the query,
+     * or the least recently used statement has to make room for this one, the statement that is
+     * dropped from the cache is finalized.
+     */
+    void release(const std::string& sqlQuery, sqlite3_stmt* stmt);
+
+private:
+    LRUCache<std::string, sqlite3_stmt*> _statements;
+};
+
 /**
  * This class manages a SQLite database connection object.
  */
@@ -44,7 +79,9 @@ class MobileSession final {
     MONGO_DISALLOW_COPYING(MobileSession);
 
 public:
-    MobileSession(sqlite3* session, MobileSessionPool* sessionPool);
+    MobileSession(sqlite3* session,
+                  MobileSessionPool* sessionPool,
+                  MobileStatementCache* statementCache = nullptr);
 
     ~MobileSession();
 
@@ -53,8 +90,15 @@ public:
      */
     sqlite3* getSession() const;
 
+    /**
+     * Returns the prepared statement cache of the underlying connection, or nullptr if statements
+     * on this session are not cached.
+     */
+    MobileStatementCache* getStatementCache() const;
+
 private:
     sqlite3* _session;
     MobileSessionPool* _sessionPool;
+    MobileStatementCache* _statementCache;
 };
 }  // namespace mongo
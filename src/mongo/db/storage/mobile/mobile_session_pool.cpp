@@ -94,8 +94,11 @@ bool MobileDelayedOpQueue::isEmpty() {
     return (_isEmpty.load());
 }
 
-MobileSessionPool::MobileSessionPool(const std::string& path, std::uint64_t maxPoolSize)
-    : _path(path), _maxPoolSize(maxPoolSize) {}
+MobileSessionPool::MobileSessionPool(const std::string& path)
+    : MobileSessionPool(path, Options()) {}
+
+MobileSessionPool::MobileSessionPool(const std::string& path, const Options& options)
+    : _path(path), _options(options) {}
 
 MobileSessionPool::~MobileSessionPool() {
     shutDown();
@@ -110,17 +113,26 @@ std::unique_ptr<MobileSession> MobileSessionPool::getSession(OperationContext* o
 
     // Checks if there is an open session available.
     if (!_sessions.empty()) {
-        sqlite3* session = _popSession_inlock();
-        return stdx::make_unique<MobileSession>(session, this);
+        return _makeSession_inlock(_popSession_inlock());
     }
 
     // Checks if a new session can be opened.
-    if (_curPoolSize < _maxPoolSize) {
+    if (_curPoolSize < _options.maxPoolSize) {
         sqlite3* session;
         int status = sqlite3_open(_path.c_str(), &session);
         checkStatus(status, SQLITE_OK, "sqlite3_open");
+        if (_options.cacheSizeKB > 0) {
+            // A negative cache_size is a limit in KiB rather than in pages.
+            std::string cacheSizeQuery =
+                "PRAGMA cache_size = -" + std::to_string(_options.cacheSizeKB) + ";";
+            char* errMsg = NULL;
+            status = sqlite3_exec(session, cacheSizeQuery.c_str(), NULL, NULL, &errMsg);
+            checkStatus(status, SQLITE_OK, "sqlite3_exec", errMsg);
+            sqlite3_free(errMsg);
+        }
         _curPoolSize++;
-        return stdx::make_unique<MobileSession>(session, this);
+        _statementCaches[session] = stdx::make_unique<MobileStatementCache>();
+        return _makeSession_inlock(session);
     }
 
     // There are no open sessions available and the maxPoolSize has been reached.
@@ -128,8 +140,7 @@ std::unique_ptr<MobileSession> MobileSessionPool::getSession(OperationContext* o
     opCtx->waitForConditionOrInterrupt(
         _releasedSessionNotifier, lk, [&] { return !_sessions.empty(); });
 
-    sqlite3* session = _popSession_inlock();
-    return stdx::make_unique<MobileSession>(session, this);
+    return _makeSession_inlock(_popSession_inlock());
 }
 
 void MobileSessionPool::releaseSession(MobileSession* session) {
@@ -137,6 +148,10 @@ void MobileSessionPool::releaseSession(MobileSession* session) {
     if (!failedDropsQueue.isEmpty())
         failedDropsQueue.execAndDequeueOp(session);
 
+    if (_options.releaseMemoryOnRelease) {
+        sqlite3_db_release_memory(session->getSession());
+    }
+
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     _sessions.push_back(session->getSession());
     _releasedSessionNotifier.notify_one();
@@ -172,6 +187,8 @@ void MobileSessionPool::shutDown() {
         sqlite3_close(session);
     }
 
+    // Cached statements must be finalized before their connections can be closed.
+    _statementCaches.clear();
     for (auto&& session : _sessions) {
         sqlite3_close(session);
     }
@@ -184,4 +201,10 @@ sqlite3* MobileSessionPool::_popSession_inlock() {
     return session;
 }
 
+std::unique_ptr<MobileSession> MobileSessionPool::_makeSession_inlock(sqlite3* session) {
+    auto it = _statementCaches.find(session);
+    invariant(it != _statementCaches.end());
+    return stdx::make_unique<MobileSession>(session, this, it->second.get());
+}
+
 }  // namespace mongo
@@ -37,9 +37,11 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/mobile/mobile_session.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 class MobileSession;
+class MobileStatementCache;
 
 /**
  * This class manages a queue of operations delayed for some reason
@@ -67,7 +69,19 @@ class MobileSessionPool final {
     MONGO_DISALLOW_COPYING(MobileSessionPool);
 
 public:
-    MobileSessionPool(const std::string& path, std::uint64_t maxPoolSize = 80);
+    struct Options {
+        // The most connections the pool keeps open at once.
+        std::uint64_t maxPoolSize = 80;
+
+        // Page cache of each connection in KB, or 0 to keep SQLite's default.
+        std::int32_t cacheSizeKB = 0;
+
+        // Whether a connection frees its page cache whenever it is released back into the pool.
+        bool releaseMemoryOnRelease = false;
+    };
+
+    explicit MobileSessionPool(const std::string& path);
+    MobileSessionPool(const std::string& path, const Options& options);
 
     ~MobileSessionPool();
 
@@ -96,20 +110,30 @@ private:
      */
     sqlite3* _popSession_inlock();
 
+    /**
+     * Wraps a connection in a session which uses the connection's prepared statement cache.
+     */
+    std::unique_ptr<MobileSession> _makeSession_inlock(sqlite3* session);
+
     // This is used to lock the _sessions vector.
     stdx::mutex _mutex;
     stdx::condition_variable _releasedSessionNotifier;
 
     std::string _path;
 
+    const Options _options;
+
     /**
      * PoolSize is the number of open sessions associated with the session pool.
      */
-    std::uint64_t _maxPoolSize = 80;
     std::uint64_t _curPoolSize = 0;
     bool _shuttingDown = false;
 
     using SessionPool = std::vector<sqlite3*>;
     SessionPool _sessions;
+
+    // Prepared statements of each open connection, keyed by the connection. A connection is used by
+    // one session at a time, so its cache needs no locking of its own.
+    stdx::unordered_map<sqlite3*, std::unique_ptr<MobileStatementCache>> _statementCaches;
 };
 }  // namespace mongo
@@ -51,6 +51,12 @@ SqliteStatement::SqliteStatement(const MobileSession& session, const std::string
     _id = _nextID.addAndFetch(1);
     _sqlQuery = sqlQuery;
 
+    _statementCache = session.getStatementCache();
+    if (_statementCache && (_stmt = _statementCache->take(_sqlQuery))) {
+        SQLITE_STMT_TRACE() << "Reusing cached statement: " << _sqlQuery;
+        return;
+    }
+
     prepare(session);
 }
 
@@ -63,6 +69,7 @@ void SqliteStatement::finalize() {
     int status = sqlite3_finalize(_stmt);
     fassert(37053, status == _exceptionStatus);
     _stmt = NULL;
+    _statementCache = nullptr;
 }
 
 void SqliteStatement::prepare(const MobileSession& session) {
@@ -83,6 +90,14 @@ void SqliteStatement::prepare(const MobileSession& session) {
 }
 
 SqliteStatement::~SqliteStatement() {
+    // A reset statement holds no locks, so keeping it cached does not block other connections.
+    if (_stmt && _statementCache && _exceptionStatus == SQLITE_OK &&
+        sqlite3_reset(_stmt) == SQLITE_OK && sqlite3_clear_bindings(_stmt) == SQLITE_OK) {
+        SQLITE_STMT_TRACE() << "Caching: " << _sqlQuery;
+        _statementCache->release(_sqlQuery, _stmt);
+        _stmt = NULL;
+        return;
+    }
     finalize();
 }
 
@@ -43,12 +43,14 @@ namespace mongo {
 class SqliteStatement final {
 public:
     /**
-     * Creates and prepares a SQLite statement.
+     * Creates and prepares a SQLite statement. If the session's connection has a prepared
+     * statement for the query cached, that statement is reused instead.
      */
     SqliteStatement(const MobileSession& session, const std::string& sqlQuery);
 
     /**
-     * Finalizes the prepared statement.
+     * Returns the statement to its connection's cache if it came from a session with one and
+     * completed without an error, and finalizes it otherwise.
      */
     ~SqliteStatement();
 
@@ -117,7 +119,8 @@ public:
     static void execQuery(MobileSession* session, const std::string& query);
 
     /**
-     * Finalizes a prepared statement.
+     * Finalizes a prepared statement. A statement that is prepared again afterwards is not
+     * returned to a cache on destruction.
      */
     void finalize();
 
@@ -130,9 +133,12 @@ public:
 
 private:
     static AtomicInt64 _nextID;
-    sqlite3_stmt* _stmt;
+    sqlite3_stmt* _stmt = nullptr;
     std::string _sqlQuery;
 
+    // The cache of the connection the statement was prepared on, if any.
+    MobileStatementCache* _statementCache = nullptr;
+
     // If the most recent call to sqlite3_step on this statement returned an error, the error is
     // returned again when the statement is finalized. This is used to verify that the last error
     // code returned matches the finalize error code, if there is any.
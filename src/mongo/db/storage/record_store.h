@@ -264,10 +264,27 @@ public:
 
     virtual bool isCapped() const = 0;
 
+    /**
+     * Returns true if the records are stored under a RecordId derived from their _id, see
+     * clusteredid::keyForId(). Looking a document up by _id then needs no index.
+     */
+    virtual bool isClustered() const {
+        return false;
+    }
+
     virtual void setCappedCallback(CappedCallback*) {
         MONGO_UNREACHABLE;
     }
 
+    /**
+     * Returns true if inserts into this capped record store may run concurrently. Forward cursors
+     * then see records in RecordId order with no holes: a record is hidden while a record with a
+     * lower RecordId has yet to commit, as in the oplog.
+     */
+    virtual bool supportsConcurrentCappedInserts() const {
+        return false;
+    }
+
     /**
      * @param extraInfo - optional more debug info
      * @param level - optional, level of debug info to put in (higher is more)
@@ -172,6 +172,15 @@ public:
         return boost::none;
     }
 
+    /**
+     * Returns a timestamp such that every oplog entry at or before it is visible to forward oplog
+     * cursors in the open storage transaction, or boost::none if no transaction is open or the
+     * storage engine cannot tell.
+     */
+    virtual boost::optional<Timestamp> getOplogVisibilityTimestamp() const {
+        return boost::none;
+    }
+
     /**
      * Gets the local SnapshotId.
      *
@@ -142,6 +142,12 @@ StatusWith<std::string> WiredTigerIndex::parseIndexOptions(const BSONObj& option
                 return status;
             }
             ss << elem.valueStringData() << ',';
+        } else if (elem.fieldNameStringData() == "cacheResident") {
+            // Pins the whole index in the cache, so that scans of colder data never evict it.
+            if (elem.type() != BSONType::Bool) {
+                return {ErrorCodes::TypeMismatch, "'cacheResident' must be a boolean"};
+            }
+            ss << "cache_resident=" << (elem.boolean() ? "true" : "false") << ',';
         } else {
             // Return error on first unrecognized field.
             return StatusWith<std::string>(ErrorCodes::InvalidOptions,
@@ -531,7 +537,9 @@ Status WiredTigerIndex::compact(OperationContext* opCtx) {
         WT_SESSION* s = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
         opCtx->recoveryUnit()->abandonSnapshot();
         int ret = s->compact(s, uri().c_str(), "timeout=0");
-        invariantWTOK(ret);
+        if (ret != 0) {
+            return wtRCToStatus(ret, "unable to compact table");
+        }
     }
     return Status::OK();
 }
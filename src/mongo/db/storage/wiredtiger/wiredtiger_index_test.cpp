@@ -93,5 +93,14 @@ TEST(WiredTigerIndexTest, GenerateCreateStringValidConfigStringOption) {
     ASSERT_EQ(WiredTigerIndex::parseIndexOptions(spec), std::string("prefix_compression=true,"));
 }
 
+TEST(WiredTigerIndexTest, GenerateCreateStringCacheResident) {
+    ASSERT_EQ(WiredTigerIndex::parseIndexOptions(fromjson("{cacheResident: true}")),
+              std::string("cache_resident=true,"));
+    ASSERT_EQ(WiredTigerIndex::parseIndexOptions(fromjson("{cacheResident: false}")),
+              std::string("cache_resident=false,"));
+    ASSERT_EQ(WiredTigerIndex::parseIndexOptions(fromjson("{cacheResident: 1}")),
+              ErrorCodes::TypeMismatch);
+}
+
 }  // namespace
 }  // namespace mongo
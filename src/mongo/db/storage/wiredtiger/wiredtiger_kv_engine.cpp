@@ -41,6 +41,7 @@
 #define NVALGRIND
 #endif
 
+#include <cstring>
 #include <memory>
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
@@ -77,6 +78,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_extensions.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
@@ -425,11 +427,208 @@ TicketHolder openReadTransaction(128);
 TicketServerParameter openReadTransactionParam(&openReadTransaction,
                                                "wiredTigerConcurrentReadTransactions");
 
+// When enabled at startup, a background thread resizes the read and write ticket pools above from
+// WiredTiger cache statistics, within [wiredTigerAdaptiveConcurrentTransactionsMin,
+// wiredTigerAdaptiveConcurrentTransactionsMax].
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(wiredTigerAdaptiveConcurrentTransactions, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerAdaptiveConcurrentTransactionsMin, int, 16)
+    ->withValidator([](const int& newVal) {
+        // TicketHolder cannot be resized below 5.
+        if (newVal < 5) {
+            return Status(ErrorCodes::BadValue,
+                          "wiredTigerAdaptiveConcurrentTransactionsMin has to be >= 5");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerAdaptiveConcurrentTransactionsMax, int, 512)
+    ->withValidator([](const int& newVal) {
+        // TicketHolder cannot be resized below 5.
+        if (newVal < 5) {
+            return Status(ErrorCodes::BadValue,
+                          "wiredTigerAdaptiveConcurrentTransactionsMax has to be >= 5");
+        }
+        return Status::OK();
+    });
+
+// The last cache sample and the resizes made by the WiredTigerTicketController, reported in
+// serverStatus under concurrentTransactions.adaptive.
+struct AdaptiveTicketStats {
+    void append(BSONObjBuilder* builder) const {
+        stdx::lock_guard<stdx::mutex> lock(mutex);
+        builder->append("cacheDirtyRatio", lastDirtyRatio);
+        builder->append("cacheUsedRatio", lastUsedRatio);
+        builder->append("applicationEvictions", lastApplicationEvictions);
+        builder->append("writeIncreases", writeIncreases);
+        builder->append("writeDecreases", writeDecreases);
+        builder->append("readIncreases", readIncreases);
+        builder->append("readDecreases", readDecreases);
+    }
+
+    mutable stdx::mutex mutex;
+    double lastDirtyRatio = 0;
+    double lastUsedRatio = 0;
+    long long lastApplicationEvictions = -1;
+    long long writeIncreases = 0;
+    long long writeDecreases = 0;
+    long long readIncreases = 0;
+    long long readDecreases = 0;
+} adaptiveTicketStats;
+
 stdx::function<bool(StringData)> initRsOplogBackgroundThreadCallback = [](StringData) -> bool {
     fassertFailed(40358);
 };
+
+stdx::function<bool(StringData)> requestCappedReclaimCallback = [](StringData) { return false; };
 }  // namespace
 
+/**
+ * Periodically samples WiredTiger cache statistics and resizes the global read and write ticket
+ * pools. Tickets are cut multiplicatively while the cache is under eviction pressure, so fewer
+ * operations compete with eviction, and grown additively while the cache is healthy and nearly
+ * every ticket is in use.
+ */
+class WiredTigerKVEngine::WiredTigerTicketController : public BackgroundJob {
+public:
+    explicit WiredTigerTicketController(WiredTigerSessionCache* sessionCache)
+        : BackgroundJob(false /* deleteSelf */), _sessionCache(sessionCache) {}
+
+    virtual string name() const {
+        return "WTTicketController";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+        ON_BLOCK_EXIT([] { Client::destroy(); });
+
+        LOG(1) << "starting " << name() << " thread";
+
+        while (!_shuttingDown.load()) {
+            {
+                stdx::unique_lock<stdx::mutex> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                _condvar.wait_for(lock, kAdjustInterval.toSystemDuration(), [this] {
+                    return _shuttingDown.load();
+                });
+            }
+            if (_shuttingDown.load()) {
+                break;
+            }
+
+            try {
+                _adjust();
+            } catch (const DBException& e) {
+                LOG(1) << name() << " unable to read cache statistics: " << e.toStatus();
+            }
+        }
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        {
+            stdx::lock_guard<stdx::mutex> lock(_mutex);
+            _shuttingDown.store(true);
+        }
+        _condvar.notify_one();
+        wait();
+    }
+
+private:
+    // WiredTiger's default eviction_dirty_trigger and eviction_trigger, past which application
+    // threads are drafted into eviction.
+    static constexpr double kDirtyTrigger = 0.20;
+    static constexpr double kUsedTrigger = 0.95;
+
+    static constexpr int kTicketIncrement = 8;
+    static const Milliseconds kAdjustInterval;
+
+    enum class Adjustment { kNone, kIncrease, kDecrease };
+
+    /**
+     * Resizes 'holder' towards a target within [min, max]. A pool is only grown when at most an
+     * eighth of its tickets are available, meaning operations are likely queueing for them.
+     */
+    static Adjustment _resize(TicketHolder* holder, bool underPressure, int min, int max) {
+        const int current = holder->outof();
+        int target = current;
+        if (underPressure) {
+            target = current * 3 / 4;
+        } else if (holder->available() <= current / 8) {
+            target = current + kTicketIncrement;
+        }
+        target = std::max(min, std::min(max, target));
+        if (target == current || !holder->resize(target).isOK()) {
+            return Adjustment::kNone;
+        }
+        return target > current ? Adjustment::kIncrease : Adjustment::kDecrease;
+    }
+
+    void _adjust() {
+        UniqueWiredTigerSession session = _sessionCache->getSession();
+        WT_SESSION* s = session->getSession();
+        auto getStat = [s](int key) {
+            return uassertStatusOK(
+                WiredTigerUtil::getStatisticsValueAs<int64_t>(s, "statistics:", "", key));
+        };
+
+        const int64_t maxBytes = getStat(WT_STAT_CONN_CACHE_BYTES_MAX);
+        if (maxBytes <= 0) {
+            return;
+        }
+        const double dirtyRatio =
+            static_cast<double>(getStat(WT_STAT_CONN_CACHE_BYTES_DIRTY)) / maxBytes;
+        const double usedRatio =
+            static_cast<double>(getStat(WT_STAT_CONN_CACHE_BYTES_INUSE)) / maxBytes;
+        const int64_t applicationEvictions = getStat(WT_STAT_CONN_CACHE_EVICTION_APP);
+
+        auto& stats = adaptiveTicketStats;
+        bool applicationEvicting;
+        {
+            stdx::lock_guard<stdx::mutex> lock(stats.mutex);
+            applicationEvicting = stats.lastApplicationEvictions >= 0 &&
+                applicationEvictions > stats.lastApplicationEvictions;
+            stats.lastDirtyRatio = dirtyRatio;
+            stats.lastUsedRatio = usedRatio;
+            stats.lastApplicationEvictions = applicationEvictions;
+        }
+
+        const int min = wiredTigerAdaptiveConcurrentTransactionsMin.load();
+        const int max = std::max(min, wiredTigerAdaptiveConcurrentTransactionsMax.load());
+
+        // Shrinking a pool waits for tickets to be returned, so no lock is held while resizing.
+        // Writers dirty the cache, so they back off as soon as it is over the dirty trigger.
+        // Readers only back off once the cache is full and their own threads are evicting.
+        auto writeAdjustment = _resize(&openWriteTransaction,
+                                       dirtyRatio >= kDirtyTrigger || applicationEvicting,
+                                       min,
+                                       max);
+        auto readAdjustment = _resize(
+            &openReadTransaction, usedRatio >= kUsedTrigger && applicationEvicting, min, max);
+
+        stdx::lock_guard<stdx::mutex> lock(stats.mutex);
+        stats.writeIncreases += writeAdjustment == Adjustment::kIncrease;
+        stats.writeDecreases += writeAdjustment == Adjustment::kDecrease;
+        stats.readIncreases += readAdjustment == Adjustment::kIncrease;
+        stats.readDecreases += readAdjustment == Adjustment::kDecrease;
+
+        if (writeAdjustment != Adjustment::kNone || readAdjustment != Adjustment::kNone) {
+            LOG(2) << name() << " resized tickets to write: " << openWriteTransaction.outof()
+                   << " read: " << openReadTransaction.outof() << " (cache dirty " << dirtyRatio
+                   << ", used " << usedRatio << ", application evicting " << applicationEvicting
+                   << ")";
+        }
+    }
+
+    WiredTigerSessionCache* _sessionCache;
+
+    stdx::mutex _mutex;  // Protects the condition variable.
+    stdx::condition_variable _condvar;
+    AtomicBool _shuttingDown{false};
+};
+
+const Milliseconds WiredTigerKVEngine::WiredTigerTicketController::kAdjustInterval{1000};
+
 WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
                                        const std::string& path,
                                        ClockSource* cs,
@@ -574,6 +773,11 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sizeStorer = std::make_unique<WiredTigerSizeStorer>(_conn, _sizeStorerUri, _readOnly);
 
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
+
+    if (wiredTigerAdaptiveConcurrentTransactions && !_readOnly) {
+        _ticketController = stdx::make_unique<WiredTigerTicketController>(_sessionCache.get());
+        _ticketController->go();
+    }
 }
 
 
@@ -601,6 +805,11 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("totalTickets", openReadTransaction.outof());
         bbb.done();
     }
+    if (wiredTigerAdaptiveConcurrentTransactions) {
+        BSONObjBuilder bbb(bb.subobjStart("adaptive"));
+        adaptiveTicketStats.append(&bbb);
+        bbb.done();
+    }
     bb.done();
 }
 
@@ -671,6 +880,11 @@ void WiredTigerKVEngine::cleanShutdown() {
     }
 
     // these must be the last things we do before _conn->close();
+    if (_ticketController) {
+        log() << "Shutting down ticket controller thread";
+        _ticketController->shutdown();
+        log() << "Finished shutting down ticket controller thread";
+    }
     if (_journalFlusher) {
         log() << "Shutting down journal flusher thread";
         _journalFlusher->shutdown();
@@ -1045,6 +1259,7 @@ std::unique_ptr<RecordStore> WiredTigerKVEngine::getGroupedRecordStore(
     params.cappedCallback = nullptr;
     params.sizeStorer = _sizeStorer.get();
     params.isReadOnly = _readOnly;
+    params.isClustered = options.clustered;
 
     params.cappedMaxSize = -1;
     if (options.capped) {
@@ -1170,6 +1385,60 @@ Status WiredTigerKVEngine::dropIdent(OperationContext* opCtx, StringData ident)
     return Status::OK();
 }
 
+Status WiredTigerKVEngine::dropIdentPrefix(OperationContext* opCtx,
+                                           StringData ident,
+                                           KVPrefix prefix) {
+    invariant(prefix.isPrefixed());
+    invariant(opCtx->lockState()->inAWriteUnitOfWork());
+
+    // Both record stores ("qq") and indexes ("qu") pack the prefix first, so the raw keys of all
+    // entries with 'prefix' start with the packed prefix and are adjacent in the table.
+    WT_SESSION* session = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
+    size_t packedSize;
+    invariantWTOK(wiredtiger_struct_size(session, &packedSize, "q", prefix.repr()));
+    std::unique_ptr<char[]> packed(new char[packedSize]);
+    invariantWTOK(
+        wiredtiger_struct_pack(session, packed.get(), packedSize, "q", prefix.repr()));
+
+    WT_CURSOR* cursor;
+    const std::string uri = _uri(ident);
+    invariantWTOK(session->open_cursor(session, uri.c_str(), nullptr, "raw", &cursor));
+    ON_BLOCK_EXIT([cursor] { cursor->close(cursor); });
+
+    WT_ITEM searchKey = {packed.get(), packedSize};
+    cursor->set_key(cursor, &searchKey);
+    int exact;
+    int ret =
+        wiredTigerPrepareConflictRetry(opCtx, [&] { return cursor->search_near(cursor, &exact); });
+    if (ret == 0 && exact < 0) {
+        ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return cursor->next(cursor); });
+    }
+
+    int64_t numRemoved = 0;
+    while (ret == 0) {
+        WT_ITEM key;
+        invariantWTOK(cursor->get_key(cursor, &key));
+        if (key.size < packedSize || memcmp(key.data, packed.get(), packedSize) != 0) {
+            break;
+        }
+
+        ret = WT_OP_CHECK(cursor->remove(cursor));
+        if (ret != 0) {
+            return wtRCToStatus(ret);
+        }
+        ++numRemoved;
+
+        ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return cursor->next(cursor); });
+    }
+    if (ret != 0 && ret != WT_NOTFOUND) {
+        return wtRCToStatus(ret);
+    }
+
+    LOG(1) << "WT removal of " << prefix << " from " << uri << " removed " << numRemoved
+           << " entries";
+    return Status::OK();
+}
+
 std::list<WiredTigerCachedCursor> WiredTigerKVEngine::filterCursorsWithQueuedDrops(
     std::list<WiredTigerCachedCursor>* cache) {
     std::list<WiredTigerCachedCursor> toDrop;
@@ -1357,6 +1626,14 @@ bool WiredTigerKVEngine::initRsOplogBackgroundThread(StringData ns) {
     return initRsOplogBackgroundThreadCallback(ns);
 }
 
+void WiredTigerKVEngine::setRequestCappedReclaimCallback(stdx::function<bool(StringData)> cb) {
+    requestCappedReclaimCallback = std::move(cb);
+}
+
+bool WiredTigerKVEngine::requestCappedReclaim(StringData ns) {
+    return requestCappedReclaimCallback(ns);
+}
+
 namespace {
 
 MONGO_FAIL_POINT_DEFINE(WTPreserveSnapshotHistoryIndefinitely);
@@ -1592,6 +1869,9 @@ StatusWith<Timestamp> WiredTigerKVEngine::recoverToStableTimestamp(OperationCont
         }
         _checkpointThread->shutdown();
     }
+    if (_ticketController) {
+        _ticketController->shutdown();
+    }
 
     const Timestamp stableTimestamp(_stableTimestamp.load());
     const Timestamp initialDataTimestamp(_initialDataTimestamp.load());
@@ -1612,6 +1892,10 @@ StatusWith<Timestamp> WiredTigerKVEngine::recoverToStableTimestamp(OperationCont
         _checkpointThread = std::make_unique<WiredTigerCheckpointThread>(this, _sessionCache.get());
         _checkpointThread->go();
     }
+    if (_ticketController) {
+        _ticketController = std::make_unique<WiredTigerTicketController>(_sessionCache.get());
+        _ticketController->go();
+    }
 
     _sizeStorer = std::make_unique<WiredTigerSizeStorer>(_conn, _sizeStorerUri, _readOnly);
 
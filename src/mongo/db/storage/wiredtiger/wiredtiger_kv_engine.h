@@ -146,6 +146,10 @@ public:
 
     virtual Status dropIdent(OperationContext* opCtx, StringData ident) override;
 
+    virtual Status dropIdentPrefix(OperationContext* opCtx,
+                                   StringData ident,
+                                   KVPrefix prefix) override;
+
     virtual void alterIdentMetadata(OperationContext* opCtx,
                                     StringData ident,
                                     const IndexDescriptor* desc) override;
@@ -296,6 +300,19 @@ public:
      */
     static bool initRsOplogBackgroundThread(StringData ns);
 
+    /**
+     * Sets the implementation for `requestCappedReclaim`. Intended to be called from a
+     * MONGO_INITIALIZER and therefore in a single threaded context.
+     */
+    static void setRequestCappedReclaimCallback(stdx::function<bool(StringData)> cb);
+
+    /**
+     * Asks a background job to remove excess documents from the capped collection 'ns', which
+     * supports concurrent inserts. Returns false if there is no such job, in which case the
+     * inserts into the collection must remove excess documents themselves.
+     */
+    static bool requestCappedReclaim(StringData ns);
+
     static void appendGlobalStats(BSONObjBuilder& b);
 
     /**
@@ -344,6 +361,7 @@ public:
 private:
     class WiredTigerJournalFlusher;
     class WiredTigerCheckpointThread;
+    class WiredTigerTicketController;
 
     /**
      * Opens a connection on the WiredTiger database 'path' with the configuration 'wtOpenConfig'.
@@ -428,6 +446,7 @@ private:
 
     std::unique_ptr<WiredTigerJournalFlusher> _journalFlusher;  // Depends on _sizeStorer
     std::unique_ptr<WiredTigerCheckpointThread> _checkpointThread;
+    std::unique_ptr<WiredTigerTicketController> _ticketController;
 
     std::string _rsOptions;
     std::string _indexOptions;
@@ -0,0 +1,83 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/base/init.h"
+#include "mongo/db/repl/repl_settings.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/kv/kv_engine_bm_harness.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/clock_source_mock.h"
+
+namespace mongo {
+namespace {
+
+// Large enough to hold the benchmark data set, so that the benchmarks measure the engine rather
+// than eviction.
+const size_t kCacheSizeMB = 1024;
+
+class WiredTigerKVBenchmarkHelper : public KVBenchmarkHelper {
+public:
+    WiredTigerKVBenchmarkHelper() : _dbpath("wt-kv-bm") {
+        repl::ReplicationCoordinator::set(
+            getGlobalServiceContext(),
+            std::unique_ptr<repl::ReplicationCoordinator>(new repl::ReplicationCoordinatorMock(
+                getGlobalServiceContext(), repl::ReplSettings())));
+        _engine = stdx::make_unique<WiredTigerKVEngine>(kWiredTigerEngineName,
+                                                        _dbpath.path(),
+                                                        _cs.get(),
+                                                        "",
+                                                        kCacheSizeMB,
+                                                        true,
+                                                        false,
+                                                        false,
+                                                        false);
+    }
+
+    KVEngine* getEngine() override {
+        return _engine.get();
+    }
+
+private:
+    const std::unique_ptr<ClockSource> _cs = stdx::make_unique<ClockSourceMock>();
+    unittest::TempDir _dbpath;
+    std::unique_ptr<WiredTigerKVEngine> _engine;
+};
+
+MONGO_INITIALIZER(RegisterKVBenchmarkFactory)(InitializerContext*) {
+    KVBenchmarkHelper::registerFactory(
+        [] { return std::unique_ptr<KVBenchmarkHelper>(new WiredTigerKVBenchmarkHelper()); });
+    return Status::OK();
+}
+
+}  // namespace
+}  // namespace mongo
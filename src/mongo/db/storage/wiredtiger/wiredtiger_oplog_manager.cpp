@@ -31,8 +31,12 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -40,12 +44,29 @@
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
 // This is the minimum valid timestamp; it can be used for reads that need to see all untimestamped
 // data but no timestamped data.  We cannot use 0 here because 0 means see all timestamped data.
 const uint64_t kMinimumTimestamp = 1;
+
+// Weight given to the latest flush when updating the moving averages behind the group commit
+// window.
+const double kGroupCommitSmoothing = 0.2;
+
+// The longest a journal flush publishing oplog visibility waits for more operations to join it.
+// The flush only waits when operations have been waiting for visibility faster than flushes
+// complete, and never longer than a flush takes on average. Zero disables group commit.
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerOplogGroupCommitMaxWindowMicros, int, 1000)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 100'000) {
+            return Status(ErrorCodes::BadValue,
+                          "wiredTigerOplogGroupCommitMaxWindowMicros must be between 0 and 100000");
+        }
+        return Status::OK();
+    });
 }  // namespace
 
 MONGO_FAIL_POINT_DEFINE(WTPausePrimaryOplogDurabilityLoop);
@@ -130,6 +151,8 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     _opsWaitingForVisibility++;
     invariant(_opsWaitingForVisibility > 0);
     auto exitGuard = MakeGuard([&] { _opsWaitingForVisibility--; });
+    _visibilityWaiterArrivals++;
+    _opsWaitingForJournalCV.notify_one();
 
     opCtx->waitForConditionOrInterrupt(_opsBecameVisibleCV, lk, [&] {
         auto newLatestVisibleTimestamp = getOplogReadTimestamp();
@@ -212,14 +235,30 @@ void WiredTigerOplogManager::_oplogJournalThreadLoop(WiredTigerSessionCache* ses
             lk.lock();
         }
 
+        // When operations start waiting for visibility faster than a flush completes, hold the
+        // flush for a short window so that the operations arriving meanwhile share it instead of
+        // each waiting for a flush of their own.
+        if (!_shuttingDown && _opsWaitingForVisibility && _groupCommitWindow > Microseconds(0)) {
+            const auto expectedArrivals = std::llround(
+                _avgArrivalsPerMicro * durationCount<Microseconds>(_groupCommitWindow));
+            const auto target =
+                _opsWaitingForVisibility + std::max<std::int64_t>(1, expectedArrivals);
+            _opsWaitingForJournalCV.wait_for(lk, _groupCommitWindow.toSystemDuration(), [&] {
+                return _shuttingDown || _opsWaitingForVisibility >= target;
+            });
+        }
+
         if (_shuttingDown) {
             log() << "oplog journal thread loop shutting down";
             return;
         }
         invariant(_opsWaitingForJournal);
         _opsWaitingForJournal = false;
+        const auto waiters = _opsWaitingForVisibility;
         lk.unlock();
 
+        const auto flushStartMicros = curTimeMicros64();
+        Timer flushTimer;
         const uint64_t newTimestamp = fetchAllCommittedValue(sessionCache->conn());
 
         // The newTimestamp may actually go backward during secondary batch application,
@@ -233,6 +272,7 @@ void WiredTigerOplogManager::_oplogJournalThreadLoop(WiredTigerSessionCache* ses
         // In order to avoid oplog holes after an unclean shutdown, we must ensure this proposed
         // oplog read timestamp's documents are durable before publishing that timestamp.
         sessionCache->waitUntilDurable(/*forceCheckpoint=*/false, false);
+        const auto flushDuration = Microseconds(flushTimer.micros());
 
         lk.lock();
         // Publish the new timestamp value.  Avoid going backward.
@@ -240,6 +280,17 @@ void WiredTigerOplogManager::_oplogJournalThreadLoop(WiredTigerSessionCache* ses
         if (newTimestamp > oldTimestamp) {
             _setOplogReadTimestamp(lk, newTimestamp);
         }
+
+        size_t bucket = 0;
+        for (auto n = waiters; n > 0 && bucket < kNumWaiterBuckets - 1; n >>= 1) {
+            bucket++;
+        }
+        _flushesByWaiters[bucket]++;
+        _numFlushes++;
+        _numWaitersReleased += waiters;
+        _totalFlushMicros += durationCount<Microseconds>(flushDuration);
+        _maxFlushMicros = std::max(_maxFlushMicros, durationCount<Microseconds>(flushDuration));
+        _updateGroupCommitWindow(lk, flushStartMicros, flushDuration);
         lk.unlock();
 
         if (updateOldestTimestamp) {
@@ -267,6 +318,53 @@ void WiredTigerOplogManager::_setOplogReadTimestamp(WithLock, uint64_t newTimest
     LOG(2) << "setting new oplogReadTimestamp: " << newTimestamp;
 }
 
+void WiredTigerOplogManager::_updateGroupCommitWindow(WithLock,
+                                                      unsigned long long flushStartMicros,
+                                                      Microseconds flushDuration) {
+    const auto arrivals = _visibilityWaiterArrivals - _arrivalsAtLastFlush;
+    _arrivalsAtLastFlush = _visibilityWaiterArrivals;
+    if (_lastFlushStartMicros != 0 && flushStartMicros > _lastFlushStartMicros) {
+        const double arrivalsPerMicro =
+            static_cast<double>(arrivals) / (flushStartMicros - _lastFlushStartMicros);
+        _avgArrivalsPerMicro = kGroupCommitSmoothing * arrivalsPerMicro +
+            (1 - kGroupCommitSmoothing) * _avgArrivalsPerMicro;
+    }
+    _lastFlushStartMicros = flushStartMicros;
+    _avgFlushMicros = kGroupCommitSmoothing * durationCount<Microseconds>(flushDuration) +
+        (1 - kGroupCommitSmoothing) * _avgFlushMicros;
+
+    // Holding a flush only pays off when, on average, another operation starts waiting for
+    // visibility within the time a flush takes. Otherwise flush as soon as anyone waits.
+    const auto maxWindowMicros = wiredTigerOplogGroupCommitMaxWindowMicros.load();
+    if (maxWindowMicros == 0 || _avgArrivalsPerMicro * _avgFlushMicros < 1.0) {
+        _groupCommitWindow = Microseconds(0);
+        return;
+    }
+    _groupCommitWindow =
+        Microseconds(std::min<long long>(maxWindowMicros, std::llround(_avgFlushMicros)));
+}
+
+void WiredTigerOplogManager::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<stdx::mutex> lk(_oplogVisibilityStateMutex);
+    builder->append("flushes", _numFlushes);
+    builder->append("waitersReleased", _numWaitersReleased);
+    builder->append("totalFlushMicros", _totalFlushMicros);
+    builder->append("maxFlushMicros", _maxFlushMicros);
+    builder->append("groupCommitWindowMicros", durationCount<Microseconds>(_groupCommitWindow));
+
+    BSONObjBuilder waitersPerFlush(builder->subobjStart("waitersPerFlush"));
+    for (size_t i = 0; i < kNumWaiterBuckets; i++) {
+        const long long low = i == 0 ? 0 : 1LL << (i - 1);
+        std::string label = std::to_string(low);
+        if (i == kNumWaiterBuckets - 1) {
+            label += "+";
+        } else if (low > 1) {
+            label += "-" + std::to_string(2 * low - 1);
+        }
+        waitersPerFlush.append(label, _flushesByWaiters[i]);
+    }
+}
+
 uint64_t WiredTigerOplogManager::fetchAllCommittedValue(WT_CONNECTION* conn) {
     // Fetch the latest all_committed value from the storage engine.  This value will be a
     // timestamp that has no holes (uncommitted transactions with lower timestamps) behind it.
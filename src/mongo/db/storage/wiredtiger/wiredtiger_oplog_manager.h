@@ -29,15 +29,19 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerRecordStore;
 class WiredTigerSessionCache;
 
@@ -84,7 +88,21 @@ public:
     // all committed timestamp are committed.
     uint64_t fetchAllCommittedValue(WT_CONNECTION* conn);
 
+    // Appends statistics about the journal flushes made to publish new oplog read timestamps: how
+    // many operations each flush released, how long the flushes took and the current group commit
+    // window.
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
+    // Flushes are bucketed by the number of waiters they released: 0, 1, 2-3, 4-7, ..., 128+.
+    static constexpr size_t kNumWaiterBuckets = 9;
+
+    // Computes how long the next flush should wait for more operations to join it, from the rate
+    // at which operations have been waiting for visibility and the time journal flushes take.
+    void _updateGroupCommitWindow(WithLock,
+                                  unsigned long long flushStartMicros,
+                                  Microseconds flushDuration);
+
     void _oplogJournalThreadLoop(WiredTigerSessionCache* sessionCache,
                                  WiredTigerRecordStore* oplogRecordStore,
                                  const bool updateOldestTimestamp) noexcept;
@@ -110,6 +128,23 @@ private:
     // journal flushing should not be delayed.
     std::int64_t _opsWaitingForVisibility = 0;  // Guarded by oplogVisibilityStateMutex.
 
+    // Group commit state, guarded by oplogVisibilityStateMutex. Arrivals count every call that
+    // waited for visibility; the rates are exponentially weighted moving averages updated once
+    // per flush.
+    std::int64_t _visibilityWaiterArrivals = 0;
+    std::int64_t _arrivalsAtLastFlush = 0;
+    unsigned long long _lastFlushStartMicros = 0;
+    double _avgArrivalsPerMicro = 0;
+    double _avgFlushMicros = 0;
+    Microseconds _groupCommitWindow{0};
+
+    // Flush statistics reported by appendStats(), guarded by oplogVisibilityStateMutex.
+    long long _numFlushes = 0;
+    long long _numWaitersReleased = 0;
+    long long _totalFlushMicros = 0;
+    long long _maxFlushMicros = 0;
+    std::array<long long, kNumWaiterBuckets> _flushesByWaiters{};
+
     AtomicUInt64 _oplogReadTimestamp;
 };
 }  // namespace mongo
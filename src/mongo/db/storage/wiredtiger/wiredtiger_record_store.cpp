@@ -47,8 +47,11 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/repl_settings.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/server_recovery.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/clustered_id.h"
+#include "mongo/db/storage/index_entry_comparison.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
@@ -75,6 +78,17 @@ using std::string;
 
 namespace {
 
+// When true, record stores with a size storer do not look for their largest RecordId when they are
+// opened, but when they are first used. This keeps startup from opening a cursor on every table,
+// which dominates the startup time of a node with a very large number of collections.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(wiredTigerLazyRecordStoreInit, bool, false);
+
+// When true, inserts into capped collections other than the oplog, which have no maximum number of
+// documents, run concurrently rather than one at a time. Removing the oldest documents is left to
+// a background job. Since the inserts then may not commit in the order they are replicated, the
+// members of a replica set may remove different documents from the collection.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(wiredTigerConcurrentCappedInserts, bool, false);
+
 static const int kMinimumRecordStoreVersion = 1;
 static const int kCurrentRecordStoreVersion = 1;  // New record stores use this by default.
 static const int kMaximumRecordStoreVersion = 1;
@@ -87,6 +101,46 @@ void checkOplogFormatVersion(OperationContext* opCtx, const std::string& uri) {
 
     fassertNoTrace(39998, appMetadata.getValue().getIntField("oplogKeyExtractionVersion") == 1);
 }
+
+// Updates of records at least this long are written as a WiredTiger modify of the changed bytes
+// when the bytes that differ between the old and new values are at most a tenth of the new value.
+const int64_t kMinLengthForModify = 1024;
+const int64_t kMaxModifyFraction = 10;
+
+/**
+ * Describes the replacement of 'oldValue' with 'newValue' as a single WT_MODIFY covering the bytes
+ * between their common prefix and common suffix. Returns false if more than a tenth of 'newValue'
+ * differs, in which case writing the whole value is cheaper than a modify.
+ */
+bool computeModify(const WT_ITEM& oldValue,
+                   const char* newData,
+                   int64_t newLength,
+                   WT_MODIFY* out) {
+    const char* oldData = static_cast<const char*>(oldValue.data);
+    const int64_t oldLength = oldValue.size;
+    const int64_t maxCommon = std::min(oldLength, newLength);
+
+    int64_t prefix = 0;
+    while (prefix < maxCommon && oldData[prefix] == newData[prefix]) {
+        ++prefix;
+    }
+    int64_t suffix = 0;
+    while (suffix < maxCommon - prefix &&
+           oldData[oldLength - suffix - 1] == newData[newLength - suffix - 1]) {
+        ++suffix;
+    }
+
+    const int64_t oldChanged = oldLength - prefix - suffix;
+    const int64_t newChanged = newLength - prefix - suffix;
+    if (std::max(oldChanged, newChanged) > newLength / kMaxModifyFraction) {
+        return false;
+    }
+    out->data.data = newData + prefix;
+    out->data.size = newChanged;
+    out->offset = prefix;
+    out->size = oldChanged;
+    return true;
+}
 }  // namespace
 
 MONGO_FAIL_POINT_DEFINE(WTWriteConflictException);
@@ -475,6 +529,11 @@ StatusWith<std::string> WiredTigerRecordStore::parseOptionsField(const BSONObj o
                 return status;
             }
             ss << elem.valueStringData() << ',';
+        } else if (elem.fieldNameStringData() == "cacheResident") {
+            if (elem.type() != BSONType::Bool) {
+                return {ErrorCodes::TypeMismatch, "'cacheResident' must be a boolean"};
+            }
+            ss << "cache_resident=" << (elem.boolean() ? "true" : "false") << ',';
         } else {
             // Return error on first unrecognized field.
             return StatusWith<std::string>(ErrorCodes::InvalidOptions,
@@ -635,11 +694,16 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
                                              Params params)
     : RecordStore(params.ns),
       _uri(params.uri),
+      _sizeStorerUri(params.uri),
       _tableId(WiredTigerSession::genTableId()),
+      _clusteredInsertTableId(WiredTigerSession::genTableId()),
       _engineName(params.engineName),
       _isCapped(params.isCapped),
       _isEphemeral(params.isEphemeral),
+      _isClustered(params.isClustered),
       _isOplog(NamespaceString::oplog(params.ns)),
+      _concurrentCappedInserts(params.isCapped && !_isOplog && params.cappedMaxDocs == -1 &&
+                               wiredTigerConcurrentCappedInserts),
       _cappedMaxSize(params.cappedMaxSize),
       _cappedMaxSizeSlack(std::min(params.cappedMaxSize / 10, int64_t(16 * 1024 * 1024))),
       _cappedMaxDocs(params.cappedMaxDocs),
@@ -698,10 +762,31 @@ WiredTigerRecordStore::~WiredTigerRecordStore() {
 }
 
 void WiredTigerRecordStore::postConstructorInit(OperationContext* opCtx) {
+    _sizeInfo = _sizeStorer ? _sizeStorer->load(_sizeStorerUri)
+                            : std::make_shared<WiredTigerSizeStorer::SizeInfo>();
+
+    // The size storer already knows the size of the collection, so only inserts need the largest
+    // RecordId. The oplog and capped collections are always loaded eagerly.
+    if (!(wiredTigerLazyRecordStoreInit && _sizeStorer && !_isCapped && !_isOplog)) {
+        _loadLargestRecordId(opCtx);
+    }
+
+    if (_sizeStorer)
+        _sizeStorer->store(_sizeStorerUri, _sizeInfo);
+
+    if (WiredTigerKVEngine::initRsOplogBackgroundThread(ns())) {
+        _oplogStones = std::make_shared<OplogStones>(opCtx, this);
+    }
+
+    if (_isOplog) {
+        invariant(_kvEngine);
+        _kvEngine->startOplogManager(opCtx, _uri, this);
+    }
+}
+
+void WiredTigerRecordStore::_loadLargestRecordId(OperationContext* opCtx) const {
     // Find the largest RecordId currently in use and estimate the number of records.
     std::unique_ptr<SeekableRecordCursor> cursor = getCursor(opCtx, /*forward=*/false);
-    _sizeInfo =
-        _sizeStorer ? _sizeStorer->load(_uri) : std::make_shared<WiredTigerSizeStorer::SizeInfo>();
 
     if (auto record = cursor->next()) {
         int64_t max = record->id.repr();
@@ -735,7 +820,7 @@ void WiredTigerRecordStore::postConstructorInit(OperationContext* opCtx) {
                                "record store as needing size adjustment during recovery. ns: "
                             << ns() << ", ident: " << _uri;
         sizeRecoveryState(getGlobalServiceContext())
-            .markCollectionAsAlwaysNeedsSizeAdjustment(_uri);
+            .markCollectionAsAlwaysNeedsSizeAdjustment(_sizeStorerUri);
         _sizeInfo->dataSize.store(0);
         _sizeInfo->numRecords.store(0);
 
@@ -743,17 +828,36 @@ void WiredTigerRecordStore::postConstructorInit(OperationContext* opCtx) {
         _nextIdNum.store(1);
     }
 
-    if (_sizeStorer)
-        _sizeStorer->store(_uri, _sizeInfo);
+    _largestRecordIdLoaded.store(true);
+}
 
-    if (WiredTigerKVEngine::initRsOplogBackgroundThread(ns())) {
-        _oplogStones = std::make_shared<OplogStones>(opCtx, this);
+void WiredTigerRecordStore::_ensureLargestRecordIdLoaded(OperationContext* opCtx) const {
+    if (_largestRecordIdLoaded.load()) {
+        return;
     }
 
-    if (_isOplog) {
-        invariant(_kvEngine);
-        _kvEngine->startOplogManager(opCtx, _uri, this);
+    stdx::lock_guard<stdx::mutex> lk(_largestRecordIdMutex);
+    if (_largestRecordIdLoaded.load()) {
+        return;
     }
+
+    // Until the largest RecordId is loaded nothing has been written to this record store, so it
+    // still holds what it held at startup. Look for it in a side transaction, which sees all of
+    // that without the read timestamp or the uncommitted writes of the caller's transaction.
+    WiredTigerRecoveryUnit* realRecoveryUnit =
+        checked_cast<WiredTigerRecoveryUnit*>(opCtx->releaseRecoveryUnit().release());
+    invariant(realRecoveryUnit);
+    WiredTigerSessionCache* sc = realRecoveryUnit->getSessionCache();
+    WriteUnitOfWork::RecoveryUnitState const realRUstate =
+        opCtx->setRecoveryUnit(std::make_unique<WiredTigerRecoveryUnit>(sc),
+                               WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
+    ON_BLOCK_EXIT([&] {
+        opCtx->releaseRecoveryUnit();
+        opCtx->setRecoveryUnit(std::unique_ptr<RecoveryUnit>(realRecoveryUnit), realRUstate);
+    });
+
+    LOG(2) << "Loading the largest RecordId of " << ns() << " on first use";
+    _loadLargestRecordId(opCtx);
 }
 
 const char* WiredTigerRecordStore::name() const {
@@ -766,10 +870,12 @@ bool WiredTigerRecordStore::inShutdown() const {
 }
 
 long long WiredTigerRecordStore::dataSize(OperationContext* opCtx) const {
+    _ensureLargestRecordIdLoaded(opCtx);
     return _sizeInfo->dataSize.load();
 }
 
 long long WiredTigerRecordStore::numRecords(OperationContext* opCtx) const {
+    _ensureLargestRecordIdLoaded(opCtx);
     return _sizeInfo->numRecords.load();
 }
 
@@ -910,7 +1016,8 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded(OperationContext* opCtx,
     // replication recovery. If we don't mark the collection for size adjustment then we will not
     // perform the capped deletions as expected. In that case, the collection is guaranteed to be
     // empty at the stable timestamp and thus guaranteed to be marked for size adjustment.
-    if (!sizeRecoveryState(getGlobalServiceContext()).collectionNeedsSizeAdjustment(_uri)) {
+    if (!sizeRecoveryState(getGlobalServiceContext())
+             .collectionNeedsSizeAdjustment(_sizeStorerUri)) {
         return 0;
     }
 
@@ -955,6 +1062,23 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded(OperationContext* opCtx,
     return _cappedDeleteAsNeeded_inlock(opCtx, justInserted);
 }
 
+void WiredTigerRecordStore::reclaimCapped(OperationContext* opCtx) {
+    invariant(_concurrentCappedInserts);
+    if (!sizeRecoveryState(getGlobalServiceContext())
+             .collectionNeedsSizeAdjustment(_sizeStorerUri)) {
+        return;
+    }
+
+    while (cappedAndNeedDelete()) {
+        opCtx->checkForInterrupt();
+        stdx::unique_lock<stdx::timed_mutex> lock(_cappedDeleterMutex);
+        if (_cappedDeleteAsNeeded_inlock(opCtx, _lowestUncommittedCappedRecordId()) == 0) {
+            // Every remaining record is newer than an uncommitted insert, or deleting conflicted.
+            return;
+        }
+    }
+}
+
 Timestamp WiredTigerRecordStore::getPinnedOplog() const {
     return _kvEngine->getPinnedOplog();
 }
@@ -1038,8 +1162,9 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded_inlock(OperationContext* op
             positioned = false;
 
             newestIdToDelete = getKey(truncateEnd);
-            // don't go past the record we just inserted
-            if (newestIdToDelete >= justInserted)  // TODO: use oldest uncommitted instead
+            // Don't go past the record we just inserted or, with concurrent inserts, the oldest
+            // uncommitted one.
+            if (newestIdToDelete >= justInserted)
                 break;
 
             WT_ITEM old_value;
@@ -1171,11 +1296,18 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx) {
     reclaimOplog(opCtx, _kvEngine->getPinnedOplog());
 }
 
-void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayTruncateUpTo) {
+void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx,
+                                         Timestamp mayTruncateUpTo,
+                                         std::size_t maxStones) {
     Timer timer;
+    std::size_t numStonesTruncated = 0;
     while (auto stone = _oplogStones->peekOldestStoneIfNeeded()) {
         invariant(stone->lastRecord.isValid());
 
+        if (numStonesTruncated >= maxStones) {
+            break;
+        }
+
         if (static_cast<std::uint64_t>(stone->lastRecord.repr()) >= mayTruncateUpTo.asULL()) {
             // Do not truncate oplogs needed for replication recovery.
             return;
@@ -1215,6 +1347,7 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
 
             // Stash the truncate point for next time to cleanly skip over tombstones, etc.
             _oplogStones->firstRecord = stone->lastRecord;
+            ++numStonesTruncated;
         } catch (const WriteConflictException&) {
             LOG(1) << "Caught WriteConflictException while truncating oplog entries, retrying";
         }
@@ -1248,7 +1381,11 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
     if (_isCapped && totalLength > _cappedMaxSize)
         return Status(ErrorCodes::BadValue, "object to insert exceeds cappedMaxSize");
 
-    WiredTigerCursor curwrap(_uri, _tableId, true, opCtx);
+    // A clustered record store must not overwrite a record whose _id is inserted again.
+    WiredTigerCursor curwrap(_uri,
+                             _isClustered ? _clusteredInsertTableId : _tableId,
+                             !_isClustered,
+                             opCtx);
     curwrap.assertInActiveTxn();
     WT_CURSOR* c = curwrap.get();
     invariant(c);
@@ -1263,13 +1400,24 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             if (!status.isOK())
                 return status.getStatus();
             record.id = status.getValue();
-        } else if (_isCapped) {
-            record.id = _nextId();
+        } else if (_isClustered) {
+            StatusWith<RecordId> status =
+                clusteredid::extractKey(record.data.data(), record.data.size());
+            if (!status.isOK())
+                return status.getStatus();
+            record.id = status.getValue();
+        } else if (_concurrentCappedInserts) {
+            // Reserved below, all at once.
+            continue;
         } else {
-            record.id = _nextId();
+            record.id = _nextId(opCtx);
         }
-        dassert(record.id > highestId);
-        highestId = record.id;
+        dassert(_isClustered || record.id > highestId);
+        highestId = std::max(highestId, record.id);
+    }
+    if (_concurrentCappedInserts) {
+        _reserveCappedRecordIds(opCtx, records, nRecords);
+        highestId = records[nRecords - 1].id;
     }
 
     for (size_t i = 0; i < nRecords; i++) {
@@ -1295,6 +1443,11 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
         WiredTigerItem value(record.data.data(), record.data.size());
         c->set_value(c, value.Get());
         int ret = WT_OP_CHECK(c->insert(c));
+        if (ret == WT_DUPLICATE_KEY) {
+            invariant(_isClustered);
+            const BSONObj id = record.data.toBson()["_id"].wrap("");
+            return buildDupKeyErrorStatus(id, ns(), "_id_", BSON("_id" << 1));
+        }
         if (ret)
             return wtRCToStatus(ret, "WiredTigerRecordStore::insertRecord");
     }
@@ -1305,6 +1458,12 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
     if (_oplogStones) {
         _oplogStones->updateCurrentStoneAfterInsertOnCommit(
             opCtx, totalLength, highestId, nRecords);
+    } else if (_concurrentCappedInserts && cappedAndNeedDelete() &&
+               WiredTigerKVEngine::requestCappedReclaim(ns())) {
+        // Only help the background job when it has fallen far behind.
+        if (_sizeInfo->dataSize.load() - _cappedMaxSize >= 2 * _cappedMaxSizeSlack) {
+            _cappedDeleteAsNeeded(opCtx, _lowestUncommittedCappedRecordId());
+        }
     } else {
         _cappedDeleteAsNeeded(opCtx, highestId);
     }
@@ -1409,9 +1568,18 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
         return {ErrorCodes::IllegalOperation, "Cannot change the size of a document in the oplog"};
     }
 
-    WiredTigerItem value(data, len);
-    c->set_value(c, value.Get());
-    ret = WT_OP_CHECK(c->insert(c));
+    // A large record which only changes in a small region, such as when a field grows and the
+    // update cannot be applied in place, is written as a modify so that WiredTiger only caches and
+    // logs the changed bytes.
+    WT_MODIFY entry;
+    if (len >= kMinLengthForModify && old_length >= kMinLengthForModify &&
+        computeModify(old_value, data, len, &entry)) {
+        ret = WT_OP_CHECK(c->modify(c, &entry, 1));
+    } else {
+        WiredTigerItem value(data, len);
+        c->set_value(c, value.Get());
+        ret = WT_OP_CHECK(c->insert(c));
+    }
     invariantWTOK(ret);
 
     _increaseDataSize(opCtx, len - old_length);
@@ -1433,16 +1601,29 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
     const char* damageSource,
     const mutablebson::DamageVector& damages) {
 
-    const int nentries = damages.size();
-    mutablebson::DamageVector::const_iterator where = damages.begin();
-    const mutablebson::DamageVector::const_iterator end = damages.cend();
-    std::vector<WT_MODIFY> entries(nentries);
-    for (u_int i = 0; where != end; ++i, ++where) {
-        entries[i].data.data = damageSource + where->sourceOffset;
-        entries[i].data.size = where->size;
-        entries[i].offset = where->targetOffset;
-        entries[i].size = where->size;
+    // Damages which are contiguous in both the source and the target, as mutablebson produces for
+    // neighbouring fields, are coalesced so that WiredTiger applies fewer modifications.
+    std::vector<WT_MODIFY> entries;
+    entries.reserve(damages.size());
+    for (auto&& damage : damages) {
+        const char* source = damageSource + damage.sourceOffset;
+        if (!entries.empty()) {
+            WT_MODIFY& last = entries.back();
+            if (static_cast<const char*>(last.data.data) + last.data.size == source &&
+                last.offset + last.size == damage.targetOffset) {
+                last.data.size += damage.size;
+                last.size += damage.size;
+                continue;
+            }
+        }
+        WT_MODIFY entry;
+        entry.data.data = source;
+        entry.data.size = damage.size;
+        entry.offset = damage.targetOffset;
+        entry.size = damage.size;
+        entries.push_back(entry);
     }
+    const int nentries = entries.size();
 
     WiredTigerCursor curwrap(_uri, _tableId, true, opCtx);
     curwrap.assertInActiveTxn();
@@ -1500,8 +1681,12 @@ Status WiredTigerRecordStore::compact(OperationContext* opCtx,
     if (!cache->isEphemeral()) {
         WT_SESSION* s = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
         opCtx->recoveryUnit()->abandonSnapshot();
+        // Compaction can run alongside other operations on the table, so it may fail for reasons
+        // like a conflicting checkpoint. Report the failure rather than asserting.
         int ret = s->compact(s, getURI().c_str(), "timeout=0");
-        invariantWTOK(ret);
+        if (ret != 0) {
+            return wtRCToStatus(ret, "unable to compact table");
+        }
     }
     return Status::OK();
 }
@@ -1669,24 +1854,84 @@ boost::optional<RecordId> WiredTigerRecordStore::oplogStartHack(
 void WiredTigerRecordStore::updateStatsAfterRepair(OperationContext* opCtx,
                                                    long long numRecords,
                                                    long long dataSize) {
+    _ensureLargestRecordIdLoaded(opCtx);
+
     // We're correcting the size as of now, future writes should be tracked.
-    sizeRecoveryState(getGlobalServiceContext()).markCollectionAsAlwaysNeedsSizeAdjustment(_uri);
+    sizeRecoveryState(getGlobalServiceContext())
+        .markCollectionAsAlwaysNeedsSizeAdjustment(_sizeStorerUri);
 
     _sizeInfo->numRecords.store(numRecords);
     _sizeInfo->dataSize.store(dataSize);
 
     // If we have a WiredTigerSizeStorer, but our size info is not currently cached, add it.
     if (_sizeStorer)
-        _sizeStorer->store(_uri, _sizeInfo);
+        _sizeStorer->store(_sizeStorerUri, _sizeInfo);
 }
 
-RecordId WiredTigerRecordStore::_nextId() {
+RecordId WiredTigerRecordStore::_nextId(OperationContext* opCtx) {
     invariant(!_isOplog);
+    _ensureLargestRecordIdLoaded(opCtx);
     RecordId out = RecordId(_nextIdNum.fetchAndAdd(1));
     invariant(out.isNormal());
     return out;
 }
 
+/**
+ * Makes the RecordIds reserved by a concurrent capped insert visible, or forgets them, once its
+ * unit of work is done.
+ */
+class WiredTigerRecordStore::UncommittedCappedInsertsChange : public RecoveryUnit::Change {
+public:
+    UncommittedCappedInsertsChange(WiredTigerRecordStore* rs, std::vector<RecordId> ids)
+        : _rs(rs), _ids(std::move(ids)) {}
+
+    void commit(boost::optional<Timestamp>) final {
+        _release();
+    }
+
+    void rollback() final {
+        _release();
+    }
+
+private:
+    void _release() {
+        stdx::lock_guard<stdx::mutex> lk(_rs->_uncommittedCappedRecordIdsMutex);
+        for (auto&& id : _ids) {
+            _rs->_uncommittedCappedRecordIds.erase(id);
+        }
+    }
+
+    WiredTigerRecordStore* const _rs;
+    const std::vector<RecordId> _ids;
+};
+
+void WiredTigerRecordStore::_reserveCappedRecordIds(OperationContext* opCtx,
+                                                    Record* records,
+                                                    size_t nRecords) {
+    invariant(_concurrentCappedInserts);
+    std::vector<RecordId> ids;
+    ids.reserve(nRecords);
+    {
+        stdx::lock_guard<stdx::mutex> lk(_uncommittedCappedRecordIdsMutex);
+        for (size_t i = 0; i < nRecords; i++) {
+            records[i].id = _nextId(opCtx);
+            _uncommittedCappedRecordIds.insert(records[i].id);
+            ids.push_back(records[i].id);
+        }
+    }
+    opCtx->recoveryUnit()->registerChange(new UncommittedCappedInsertsChange(this, std::move(ids)));
+}
+
+RecordId WiredTigerRecordStore::_lowestUncommittedCappedRecordId() const {
+    stdx::lock_guard<stdx::mutex> lk(_uncommittedCappedRecordIdsMutex);
+    return _uncommittedCappedRecordIds.empty() ? RecordId::max()
+                                               : *_uncommittedCappedRecordIds.begin();
+}
+
+bool WiredTigerRecordStore::_isCappedHidden(const RecordId& id) const {
+    return _concurrentCappedInserts && id >= _lowestUncommittedCappedRecordId();
+}
+
 WiredTigerRecoveryUnit* WiredTigerRecordStore::_getRecoveryUnit(OperationContext* opCtx) {
     return checked_cast<WiredTigerRecoveryUnit*>(opCtx->recoveryUnit());
 }
@@ -1706,7 +1951,9 @@ private:
 };
 
 void WiredTigerRecordStore::_changeNumRecords(OperationContext* opCtx, int64_t diff) {
-    if (!sizeRecoveryState(getGlobalServiceContext()).collectionNeedsSizeAdjustment(_uri)) {
+    _ensureLargestRecordIdLoaded(opCtx);
+    if (!sizeRecoveryState(getGlobalServiceContext())
+             .collectionNeedsSizeAdjustment(_sizeStorerUri)) {
         return;
     }
 
@@ -1729,7 +1976,11 @@ private:
 };
 
 void WiredTigerRecordStore::_increaseDataSize(OperationContext* opCtx, int64_t amount) {
-    if (!sizeRecoveryState(getGlobalServiceContext()).collectionNeedsSizeAdjustment(_uri)) {
+    // Rolling back a change passes no 'opCtx', but then the largest RecordId was loaded already.
+    if (opCtx)
+        _ensureLargestRecordIdLoaded(opCtx);
+    if (!sizeRecoveryState(getGlobalServiceContext())
+             .collectionNeedsSizeAdjustment(_sizeStorerUri)) {
         return;
     }
 
@@ -1740,7 +1991,7 @@ void WiredTigerRecordStore::_increaseDataSize(OperationContext* opCtx, int64_t a
         _sizeInfo->dataSize.store(std::max(amount, int64_t(0)));
 
     if (_sizeStorer)
-        _sizeStorer->store(_uri, _sizeInfo);
+        _sizeStorer->store(_sizeStorerUri, _sizeInfo);
 }
 
 void WiredTigerRecordStore::cappedTruncateAfter(OperationContext* opCtx,
@@ -1896,6 +2147,12 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
         id = getKey(c);
     }
 
+    if (_forward && _rs._isCappedHidden(id)) {
+        // An earlier insert has yet to commit. Tailable cursors resume from here once it does.
+        _eof = true;
+        return {};
+    }
+
     if (_forward && _lastReturnedId >= id) {
         log() << "WTCursor::next -- c->next_key ( " << id
               << ") was not greater than _lastReturnedId (" << _lastReturnedId
@@ -2087,7 +2344,10 @@ PrefixedWiredTigerRecordStore::PrefixedWiredTigerRecordStore(WiredTigerKVEngine*
                                                              OperationContext* opCtx,
                                                              Params params,
                                                              KVPrefix prefix)
-    : WiredTigerRecordStore(kvEngine, opCtx, params), _prefix(prefix) {}
+    : WiredTigerRecordStore(kvEngine, opCtx, params), _prefix(prefix) {
+    // Record stores of grouped collections share a table, so their sizes are kept apart.
+    _sizeStorerUri = str::stream() << _uri << "?prefix=" << _prefix.repr();
+}
 
 std::unique_ptr<SeekableRecordCursor> PrefixedWiredTigerRecordStore::getCursor(
     OperationContext* opCtx, bool forward) const {
@@ -2112,6 +2372,37 @@ std::unique_ptr<RecordCursor> PrefixedWiredTigerRecordStore::getRandomCursorWith
     return {};
 }
 
+Status PrefixedWiredTigerRecordStore::truncate(OperationContext* opCtx) {
+    // The table may be shared with other record stores, so only the range between the first and
+    // the last record with this prefix is truncated.
+    auto forward = getCursor(opCtx, true);
+    auto first = forward->next();
+    // Empty collections don't have anything to truncate.
+    if (!first) {
+        return Status::OK();
+    }
+    auto reverse = getCursor(opCtx, false);
+    auto last = reverse->next();
+    invariant(last);
+
+    WiredTigerCursor startWrap(_uri, _tableId, true, opCtx);
+    WT_CURSOR* start = startWrap.get();
+    setKey(start, first->id);
+    invariantWTOK(wiredTigerPrepareConflictRetry(opCtx, [&] { return start->search(start); }));
+
+    WiredTigerCursor stopWrap(_uri, _tableId, true, opCtx);
+    WT_CURSOR* stop = stopWrap.get();
+    setKey(stop, last->id);
+    invariantWTOK(wiredTigerPrepareConflictRetry(opCtx, [&] { return stop->search(stop); }));
+
+    WT_SESSION* session = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
+    invariantWTOK(WT_OP_CHECK(session->truncate(session, NULL, start, stop, NULL)));
+    _changeNumRecords(opCtx, -numRecords(opCtx));
+    _increaseDataSize(opCtx, -dataSize(opCtx));
+
+    return Status::OK();
+}
+
 RecordId PrefixedWiredTigerRecordStore::getKey(WT_CURSOR* cursor) const {
     std::int64_t prefix;
     std::int64_t recordId;
@@ -31,6 +31,7 @@
 
 #pragma once
 
+#include <limits>
 #include <memory>
 #include <set>
 #include <string>
@@ -113,6 +114,7 @@ public:
         CappedCallback* cappedCallback;
         WiredTigerSizeStorer* sizeStorer;
         bool isReadOnly;
+        bool isClustered = false;
     };
 
     WiredTigerRecordStore(WiredTigerKVEngine* kvEngine, OperationContext* opCtx, Params params);
@@ -130,6 +132,14 @@ public:
 
     virtual bool isCapped() const;
 
+    bool supportsConcurrentCappedInserts() const override {
+        return _concurrentCappedInserts;
+    }
+
+    bool isClustered() const override {
+        return _isClustered;
+    }
+
     virtual int64_t storageSize(OperationContext* opCtx,
                                 BSONObjBuilder* extraInfo = NULL,
                                 int infoLevel = 0) const;
@@ -261,13 +271,23 @@ public:
     /**
      * The `recoveryTimestamp` is when replication recovery would need to replay from for
      * recoverable rollback, or restart for durable engines. `reclaimOplog` will not
-     * truncate oplog entries in front of this time.
+     * truncate oplog entries in front of this time. At most `maxStones` oplog stones are
+     * truncated, so that a caller can pace the truncation of a large backlog of stones.
      */
-    void reclaimOplog(OperationContext* opCtx, Timestamp recoveryTimestamp);
+    void reclaimOplog(OperationContext* opCtx,
+                      Timestamp recoveryTimestamp,
+                      std::size_t maxStones = std::numeric_limits<std::size_t>::max());
 
     // Returns false if the oplog was dropped while waiting for a deletion request.
     bool yieldAndAwaitOplogDeletionRequest(OperationContext* opCtx);
 
+    /**
+     * Deletes the oldest records of a capped collection which supports concurrent inserts until
+     * it fits within its maximum size again, stopping short of the oldest record whose insert has
+     * yet to commit. Called by the background reclaimer rather than by the inserts themselves.
+     */
+    void reclaimCapped(OperationContext* opCtx);
+
     bool haveCappedWaiters();
 
     void notifyCappedWaitersIfNeeded();
@@ -289,6 +309,7 @@ private:
 
     class NumRecordsChange;
     class DataSizeChange;
+    class UncommittedCappedInsertsChange;
 
     static WiredTigerRecoveryUnit* _getRecoveryUnit(OperationContext* opCtx);
 
@@ -297,7 +318,37 @@ private:
                           const Timestamp* timestamps,
                           size_t nRecords);
 
-    RecordId _nextId();
+    RecordId _nextId(OperationContext* opCtx);
+
+    /**
+     * Reserves the RecordIds of 'nRecords' records inserted into a capped collection which supports
+     * concurrent inserts. They are hidden from forward cursors, along with every later RecordId,
+     * until the unit of work of 'opCtx' commits or rolls back.
+     */
+    void _reserveCappedRecordIds(OperationContext* opCtx, Record* records, size_t nRecords);
+
+    /**
+     * Returns the lowest RecordId whose concurrent capped insert has yet to commit, or
+     * RecordId::max() if there is none.
+     */
+    RecordId _lowestUncommittedCappedRecordId() const;
+
+    /**
+     * Returns true if forward cursors must not see 'id' yet, see
+     * supportsConcurrentCappedInserts().
+     */
+    bool _isCappedHidden(const RecordId& id) const;
+
+    /**
+     * Finds the largest RecordId in use, and the size of the collection if there is no size
+     * storer to remember it.
+     */
+    void _loadLargestRecordId(OperationContext* opCtx) const;
+
+    /**
+     * Calls _loadLargestRecordId() in a side transaction if postConstructorInit() deferred it.
+     */
+    void _ensureLargestRecordIdLoaded(OperationContext* opCtx) const;
     void _setId(RecordId id);
     bool cappedAndNeedDelete() const;
     RecordData _getData(const WiredTigerCursor& cursor) const;
@@ -342,7 +393,12 @@ private:
     int64_t _cappedDeleteAsNeeded_inlock(OperationContext* opCtx, const RecordId& justInserted);
 
     const std::string _uri;
+    // Identifies this record store in the size storer and to the size recovery state. Only the
+    // prefixed record store constructor changes it from '_uri'.
+    std::string _sizeStorerUri;
     const uint64_t _tableId;  // not persisted
+    // Identifies the cached cursors which refuse to overwrite records, see _insertRecords().
+    const uint64_t _clusteredInsertTableId;  // not persisted
 
     // Canonical engine name to use for retrieving options
     const std::string _engineName;
@@ -350,8 +406,13 @@ private:
     const bool _isCapped;
     // True if the storage engine is an in-memory storage engine
     const bool _isEphemeral;
+    // True if records are stored under a RecordId derived from their _id.
+    const bool _isClustered;
     // True if the namespace of this record store starts with "local.oplog.", and false otherwise.
     const bool _isOplog;
+    // True if this is a capped collection, other than the oplog, whose inserts may run
+    // concurrently: see supportsConcurrentCappedInserts().
+    const bool _concurrentCappedInserts;
     int64_t _cappedMaxSize;
     const int64_t _cappedMaxSizeSlack;  // when to start applying backpressure
     const int64_t _cappedMaxDocs;
@@ -366,7 +427,18 @@ private:
     int _cappedDeleteCheckCount;
     mutable stdx::timed_mutex _cappedDeleterMutex;
 
-    AtomicInt64 _nextIdNum;
+    mutable AtomicInt64 _nextIdNum;
+
+    // The RecordIds reserved by concurrent capped inserts which have yet to commit. RecordIds are
+    // reserved while holding the mutex, so that a cursor never sees a RecordId before every lower
+    // one that is still uncommitted has been added.
+    mutable stdx::mutex _uncommittedCappedRecordIdsMutex;
+    std::set<RecordId> _uncommittedCappedRecordIds;
+
+    // False until _loadLargestRecordId() has run, which postConstructorInit() may defer until the
+    // record store is first used so that startup does not open a cursor on every table.
+    mutable AtomicBool _largestRecordIdLoaded{false};
+    mutable stdx::mutex _largestRecordIdMutex;
 
     WiredTigerSizeStorer* _sizeStorer;  // not owned, can be NULL
     std::shared_ptr<WiredTigerSizeStorer::SizeInfo> _sizeInfo;
@@ -408,6 +480,8 @@ public:
     virtual std::unique_ptr<RecordCursor> getRandomCursorWithOptions(
         OperationContext* opCtx, StringData extraConfig) const override;
 
+    virtual Status truncate(OperationContext* opCtx) override;
+
     virtual KVPrefix getPrefix() const {
         return _prefix;
     }
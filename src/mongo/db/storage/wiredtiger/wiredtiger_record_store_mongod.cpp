@@ -42,10 +42,12 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/background.h"
 #include "mongo/util/exit.h"
@@ -55,6 +57,19 @@ namespace mongo {
 
 namespace {
 
+// When positive, the OplogTruncaterThread truncates one oplog stone at a time and releases its
+// locks for this many milliseconds before truncating the next one. This spreads out the
+// truncation of a large backlog of stones, which otherwise competes with oplog inserts in one
+// burst.
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerOplogTruncationPauseMillis, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 60 * 1000) {
+            return Status(ErrorCodes::BadValue,
+                          "wiredTigerOplogTruncationPauseMillis must be between 0 and 60000");
+        }
+        return Status::OK();
+    });
+
 std::set<NamespaceString> _backgroundThreadNamespaces;
 stdx::mutex _backgroundThreadMutex;
 
@@ -70,9 +85,10 @@ public:
     }
 
     /**
-     * Returns true iff there was an oplog to delete from.
+     * Returns true iff there was an oplog to delete from. Sets 'pauseMillis' to how long to wait,
+     * with no locks held, before deleting again.
      */
-    bool _deleteExcessDocuments() {
+    bool _deleteExcessDocuments(int* pauseMillis) {
         if (!getGlobalServiceContext()->getStorageEngine()) {
             LOG(2) << "no global storage engine yet";
             return false;
@@ -114,7 +130,12 @@ public:
             if (!rs->yieldAndAwaitOplogDeletionRequest(opCtx.get())) {
                 return false;  // Oplog went away.
             }
-            rs->reclaimOplog(opCtx.get());
+            *pauseMillis = wiredTigerOplogTruncationPauseMillis.load();
+            if (*pauseMillis > 0) {
+                rs->reclaimOplog(opCtx.get(), rs->getPinnedOplog(), 1);
+            } else {
+                rs->reclaimOplog(opCtx.get());
+            }
         } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
             return false;
         } catch (const std::exception& e) {
@@ -131,8 +152,11 @@ public:
         ON_BLOCK_EXIT([] { Client::destroy(); });
 
         while (!globalInShutdownDeprecated()) {
-            if (!_deleteExcessDocuments()) {
+            int pauseMillis = 0;
+            if (!_deleteExcessDocuments(&pauseMillis)) {
                 sleepmillis(1000);  // Back off in case there were problems deleting.
+            } else if (pauseMillis > 0) {
+                sleepmillis(pauseMillis);
             }
         }
     }
@@ -171,5 +195,93 @@ MONGO_INITIALIZER(SetInitRsOplogBackgroundThreadCallback)(InitializerContext* co
     return Status::OK();
 }
 
+/**
+ * Removes the excess documents of the capped collections which support concurrent inserts, one
+ * collection at a time, as their inserts request it.
+ */
+class CappedReclaimerThread : public BackgroundJob {
+public:
+    CappedReclaimerThread() : BackgroundJob(false /* deleteSelf */) {}
+
+    virtual std::string name() const {
+        return "WT CappedReclaimerThread";
+    }
+
+    void request(const NamespaceString& ns) {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        if (_pending.insert(ns).second) {
+            _pendingChanged.notify_one();
+        }
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+        ON_BLOCK_EXIT([] { Client::destroy(); });
+
+        while (!globalInShutdownDeprecated()) {
+            std::set<NamespaceString> pending;
+            {
+                stdx::unique_lock<stdx::mutex> lock(_mutex);
+                // Wake up periodically to notice shutdown.
+                _pendingChanged.wait_for(lock, stdx::chrono::seconds(1), [&] {
+                    return !_pending.empty();
+                });
+                pending.swap(_pending);
+            }
+            for (auto&& ns : pending) {
+                _reclaim(ns);
+            }
+        }
+    }
+
+private:
+    void _reclaim(const NamespaceString& ns) {
+        if (!getGlobalServiceContext()->getStorageEngine()) {
+            return;
+        }
+
+        const ServiceContext::UniqueOperationContext opCtx = cc().makeOperationContext();
+        try {
+            AutoGetCollection autoColl(opCtx.get(), ns, MODE_IX);
+            Collection* collection = autoColl.getCollection();
+            if (!collection) {
+                LOG(2) << "no collection " << ns;
+                return;
+            }
+            checked_cast<WiredTigerRecordStore*>(collection->getRecordStore())
+                ->reclaimCapped(opCtx.get());
+        } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+            return;
+        } catch (const DBException& e) {
+            warning() << "error removing excess documents from " << ns << ": " << redact(e);
+        }
+    }
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _pendingChanged;
+    std::set<NamespaceString> _pending;
+};
+
+bool requestCappedReclaim(StringData ns) {
+    if (storageGlobalParams.repair || storageGlobalParams.readOnly) {
+        return false;
+    }
+
+    // Started on first use, and never destroyed so that it outlives every record store.
+    static CappedReclaimerThread* reclaimer = [] {
+        log() << "Starting CappedReclaimerThread";
+        auto thread = new CappedReclaimerThread();
+        thread->go();
+        return thread;
+    }();
+    reclaimer->request(NamespaceString(ns));
+    return true;
+}
+
+MONGO_INITIALIZER(SetRequestCappedReclaimCallback)(InitializerContext* context) {
+    WiredTigerKVEngine::setRequestCappedReclaimCallback(requestCappedReclaim);
+    return Status::OK();
+}
+
 }  // namespace
 }  // namespace mongo
@@ -101,6 +101,13 @@ TEST(WiredTigerRecordStoreTest, GenerateCreateStringValidConfigStringOption) {
               std::string("prefix_compression=true,"));
 }
 
+TEST(WiredTigerRecordStoreTest, GenerateCreateStringCacheResident) {
+    ASSERT_EQ(WiredTigerRecordStore::parseOptionsField(fromjson("{cacheResident: true}")),
+              std::string("cache_resident=true,"));
+    ASSERT_EQ(WiredTigerRecordStore::parseOptionsField(fromjson("{cacheResident: 'yes'}")),
+              ErrorCodes::TypeMismatch);
+}
+
 TEST(WiredTigerRecordStoreTest, Isolation1) {
     const auto harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
@@ -152,6 +159,40 @@ TEST(WiredTigerRecordStoreTest, Isolation1) {
     }
 }
 
+TEST(WiredTigerRecordStoreTest, UpdateLargeRecordWithSmallChanges) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const std::string original(4096, 'a');
+    std::string grown = original;
+    grown.insert(1000, "bbbb");
+    std::string shrunk = grown;
+    shrunk.erase(10, 20);
+    std::string rewritten(4096, 'c');
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    RecordId id;
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res =
+            rs->insertRecord(opCtx.get(), original.c_str(), original.size() + 1, Timestamp());
+        ASSERT_OK(res.getStatus());
+        id = res.getValue();
+        uow.commit();
+    }
+
+    for (auto&& value : {grown, shrunk, rewritten, original}) {
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            ASSERT_OK(rs->updateRecord(opCtx.get(), id, value.c_str(), value.size() + 1));
+            uow.commit();
+        }
+        RecordData data = rs->dataFor(opCtx.get(), id);
+        ASSERT_EQ(data.size(), static_cast<int>(value.size() + 1));
+        ASSERT_EQ(std::string(data.data()), value);
+    }
+}
+
 TEST(WiredTigerRecordStoreTest, Isolation2) {
     const auto harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
@@ -792,6 +833,19 @@ TEST(WiredTigerRecordStoreTest, OplogStones_ReclaimStones) {
         ASSERT_EQ(50, oplogStones->currentBytes());
     }
 
+    // Truncate no more stones than requested.
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        wtrs->reclaimOplog(opCtx.get(), Timestamp(1, 6), 1);
+
+        ASSERT_EQ(4, rs->numRecords(opCtx.get()));
+        ASSERT_EQ(440, rs->dataSize(opCtx.get()));
+        ASSERT_EQ(3U, oplogStones->numStones());
+        ASSERT_EQ(1, oplogStones->currentRecords());
+        ASSERT_EQ(50, oplogStones->currentBytes());
+    }
+
     // Truncate multiple stones if necessary.
     {
         ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
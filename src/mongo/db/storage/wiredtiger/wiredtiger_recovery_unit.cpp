@@ -292,9 +292,26 @@ void WiredTigerRecoveryUnit::_txnClose(bool commit) {
     _prepareTimestamp = Timestamp();
     _mySnapshotId = nextSnapshotId.fetchAndAdd(1);
     _isOplogReader = false;
+    _oplogReadTimestamp = Timestamp();
     _orderedCommit = true;  // Default value is true; we assume all writes are ordered.
 }
 
+boost::optional<Timestamp> WiredTigerRecoveryUnit::getOplogVisibilityTimestamp() const {
+    if (!_active) {
+        return boost::none;
+    }
+
+    // The majority committed snapshot never has holes behind it, and an oplog reader reads at the
+    // oplog read timestamp, which has none by construction.
+    if (_timestampReadSource == ReadSource::kMajorityCommitted) {
+        return _majorityCommittedSnapshot;
+    }
+    if (!_oplogReadTimestamp.isNull()) {
+        return _oplogReadTimestamp;
+    }
+    return boost::none;
+}
+
 SnapshotId WiredTigerRecoveryUnit::getSnapshotId() const {
     // TODO: use actual wiredtiger txn id
     return SnapshotId(_mySnapshotId);
@@ -347,9 +364,9 @@ void WiredTigerRecoveryUnit::_txnOpen() {
             WiredTigerBeginTxnBlock txnOpen(session, _ignorePrepared);
 
             if (_isOplogReader) {
-                auto status =
-                    txnOpen.setTimestamp(Timestamp(_oplogManager->getOplogReadTimestamp()),
-                                         WiredTigerBeginTxnBlock::RoundToOldest::kRound);
+                _oplogReadTimestamp = Timestamp(_oplogManager->getOplogReadTimestamp());
+                auto status = txnOpen.setTimestamp(_oplogReadTimestamp,
+                                                   WiredTigerBeginTxnBlock::RoundToOldest::kRound);
                 fassert(50771, status);
             }
             txnOpen.done();
@@ -81,6 +81,8 @@ public:
 
     boost::optional<Timestamp> getPointInTimeReadTimestamp() const override;
 
+    boost::optional<Timestamp> getOplogVisibilityTimestamp() const override;
+
     SnapshotId getSnapshotId() const override;
 
     Status setTimestamp(Timestamp timestamp) override;
@@ -194,6 +196,8 @@ private:
     Timestamp _readAtTimestamp;
     std::unique_ptr<Timer> _timer;
     bool _isOplogReader = false;
+    // The oplog read timestamp an oplog reader's transaction was opened at, if it is open.
+    Timestamp _oplogReadTimestamp;
     typedef std::vector<std::unique_ptr<Change>> Changes;
     Changes _changes;
 };
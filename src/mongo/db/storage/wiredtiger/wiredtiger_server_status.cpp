@@ -37,6 +37,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
@@ -78,6 +79,13 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
 
     WiredTigerKVEngine::appendGlobalStats(bob);
 
+    WiredTigerSessionCache::appendCursorCacheStats(&bob);
+
+    {
+        BSONObjBuilder oplogVisibility(bob.subobjStart("oplogVisibility"));
+        _engine->getOplogManager()->appendStats(&oplogVisibility);
+    }
+
     WiredTigerUtil::appendSnapshotWindowSettings(_engine, session, &bob);
 
     return bob.obj();
@@ -33,9 +33,14 @@
 
 #include "mongo/platform/basic.h"
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
 #include "mongo/base/error_codes.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
 #include "mongo/db/repl/repl_settings.h"
@@ -47,6 +52,7 @@
 #include "mongo/stdx/thread.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -86,6 +92,18 @@ ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>
                                      "wiredTigerCursorCacheSize",
                                      &kWiredTigerCursorCacheSize);
 
+// The longest a journal flush waits for more concurrent commits to join it, when other threads are
+// already waiting for durability. Zero flushes as soon as possible.
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerJournalCommitCoalescingDelayMicros, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 100'000) {
+            return Status(ErrorCodes::BadValue,
+                          "wiredTigerJournalCommitCoalescingDelayMicros must be between 0 and "
+                          "100000");
+        }
+        return Status::OK();
+    });
+
 WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn, uint64_t epoch, uint64_t cursorEpoch)
     : _epoch(epoch), _cursorEpoch(cursorEpoch), _session(NULL), _cursorGen(0), _cursorsOut(0) {
     invariantWTOK(conn->open_session(conn, NULL, "isolation=snapshot", &_session));
@@ -111,6 +129,10 @@ WiredTigerSession::~WiredTigerSession() {
 }
 
 namespace {
+AtomicUInt64 cursorCacheHits;
+AtomicUInt64 cursorCacheMisses;
+AtomicUInt64 sessionAffinityHits;
+
 void _openCursor(WT_SESSION* session,
                  const std::string& uri,
                  const char* config,
@@ -139,10 +161,12 @@ WT_CURSOR* WiredTigerSession::getCursor(const std::string& uri, uint64_t id, boo
             WT_CURSOR* c = i->_cursor;
             _cursors.erase(i);
             _cursorsOut++;
+            cursorCacheHits.fetchAndAdd(1);
             return c;
         }
     }
 
+    cursorCacheMisses.fetchAndAdd(1);
     WT_CURSOR* cursor = NULL;
     _openCursor(_session, uri, allowOverwrite ? "" : "overwrite=false", &cursor);
     _cursorsOut++;
@@ -216,6 +240,17 @@ void WiredTigerSession::closeCursorsForQueuedDrops(WiredTigerKVEngine* engine) {
 
 namespace {
 AtomicUInt64 nextTableId(1);
+
+// One session cache partition per CPU, rounded up to a power of two.
+unsigned computeNumSessionCachePartitions() {
+    const unsigned kMaxPartitions = 256;
+
+    unsigned numPartitions = 1;
+    while (numPartitions < stdx::thread::hardware_concurrency() && numPartitions < kMaxPartitions) {
+        numPartitions *= 2;
+    }
+    return numPartitions;
+}
 }
 // static
 uint64_t WiredTigerSession::genTableId() {
@@ -225,10 +260,18 @@ uint64_t WiredTigerSession::genTableId() {
 // -----------------------
 
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
-    : _engine(engine), _conn(engine->getConnection()), _shuttingDown(0) {}
+    : _engine(engine),
+      _conn(engine->getConnection()),
+      _shuttingDown(0),
+      _numPartitions(computeNumSessionCachePartitions()),
+      _partitions(new CacheAligned<Partition>[_numPartitions]) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn)
-    : _engine(NULL), _conn(conn), _shuttingDown(0) {}
+    : _engine(NULL),
+      _conn(conn),
+      _shuttingDown(0),
+      _numPartitions(computeNumSessionCachePartitions()),
+      _partitions(new CacheAligned<Partition>[_numPartitions]) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
     shuttingDown();
@@ -293,6 +336,9 @@ void WiredTigerSessionCache::waitUntilDurable(bool forceCheckpoint, bool stableC
         return;
     }
 
+    _durabilityWaiters.fetchAndAdd(1);
+    ON_BLOCK_EXIT([this] { _durabilityWaiters.fetchAndSubtract(1); });
+
     uint32_t start = _lastSyncTime.load();
     // Do the remainder in a critical section that ensures only a single thread at a time
     // will attempt to synchronize.
@@ -302,6 +348,15 @@ void WiredTigerSessionCache::waitUntilDurable(bool forceCheckpoint, bool stableC
         // Someone else synced already since we read lastSyncTime, so we're done!
         return;
     }
+
+    // If other commits are waiting for durability as well, more are likely to follow. Give them a
+    // chance to join this flush before starting it. Any thread which reads lastSyncTime before it
+    // is bumped below is covered by this flush, and returns as soon as it acquires the mutex.
+    const int coalescingDelayMicros = wiredTigerJournalCommitCoalescingDelayMicros.load();
+    if (coalescingDelayMicros > 0 && _durabilityWaiters.load() > 1) {
+        sleepmicros(coalescingDelayMicros);
+    }
+
     _lastSyncTime.store(current + 1);
 
     // Nobody has synched yet, so we have to sync ourselves.
@@ -348,9 +403,13 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (unsigned p = 0; p < _numPartitions; p++) {
+        auto& partition = _partitions[p];
+        stdx::lock_guard<stdx::mutex> lock(partition.mutex);
+        for (SessionCache::iterator i = partition.sessions.begin(); i != partition.sessions.end();
+             i++) {
+            (*i)->closeAllCursors(uri);
+        }
     }
 }
 
@@ -358,24 +417,34 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (unsigned p = 0; p < _numPartitions; p++) {
+        auto& partition = _partitions[p];
+        stdx::lock_guard<stdx::mutex> lock(partition.mutex);
+        for (SessionCache::iterator i = partition.sessions.begin(); i != partition.sessions.end();
+             i++) {
+            (*i)->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 void WiredTigerSessionCache::closeAll() {
     // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Sessions released after this point fail the epoch check in releaseSession, which is made
+    // under the partition mutex, so none can be cached in a partition once it has been emptied.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
-    }
+    for (unsigned p = 0; p < _numPartitions; p++) {
+        SessionCache swap;
 
-    for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
-        delete (*i);
+        {
+            auto& partition = _partitions[p];
+            stdx::lock_guard<stdx::mutex> lock(partition.mutex);
+            partition.sessions.swap(swap);
+        }
+
+        for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
+            delete (*i);
+        }
     }
 }
 
@@ -383,18 +452,70 @@ bool WiredTigerSessionCache::isEphemeral() {
     return _engine && _engine->isEphemeral();
 }
 
+unsigned WiredTigerSessionCache::_getPartitionIndex() const {
+#if defined(__linux__)
+    const int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return static_cast<unsigned>(cpu) % _numPartitions;
+    }
+#endif
+    return std::hash<stdx::thread::id>()(stdx::this_thread::get_id()) % _numPartitions;
+}
+
+WiredTigerSession* WiredTigerSessionCache::_takeSession_inlock(Partition* partition) {
+    auto& sessions = partition->sessions;
+    if (sessions.empty()) {
+        return nullptr;
+    }
+
+    // Get the most recently used session so that if we discard sessions, we're
+    // discarding older ones
+    auto it = sessions.end() - 1;
+
+    // When cursors stay cached in released sessions, prefer a recently used session that this
+    // thread released itself. A thread tends to keep serving the same workload, so that session
+    // most likely holds the cursors it is about to open.
+    if (kWiredTigerCursorCacheSize.load() > 0) {
+        const auto self = stdx::this_thread::get_id();
+        const auto scanEnd = sessions.size() > kSessionAffinityScanDepth
+            ? sessions.end() - kSessionAffinityScanDepth
+            : sessions.begin();
+        for (auto candidate = sessions.end(); candidate != scanEnd;) {
+            if ((*--candidate)->_lastReleasedBy == self) {
+                it = candidate;
+                sessionAffinityHits.fetchAndAdd(1);
+                break;
+            }
+        }
+    }
+
+    WiredTigerSession* cachedSession = *it;
+    sessions.erase(it);
+    return cachedSession;
+}
+
 UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // We should never be able to get here after _shuttingDown is set, because no new
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
+    // Look in this CPU's partition first, then fall back to any other partition that is not busy
+    // before creating a new session.
+    const unsigned home = _getPartitionIndex();
     {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        if (!_sessions.empty()) {
-            // Get the most recently used session so that if we discard sessions, we're
-            // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+        Partition* partition = &_partitions[home];
+        stdx::lock_guard<stdx::mutex> lock(partition->mutex);
+        if (auto cachedSession = _takeSession_inlock(partition)) {
+            return UniqueWiredTigerSession(cachedSession);
+        }
+    }
+    for (unsigned p = 1; p < _numPartitions; p++) {
+        Partition* partition = &_partitions[(home + p) % _numPartitions];
+        stdx::unique_lock<stdx::mutex> lock(partition->mutex, stdx::try_to_lock);
+        if (!lock.owns_lock()) {
+            continue;
+        }
+        if (auto cachedSession = _takeSession_inlock(partition)) {
             return UniqueWiredTigerSession(cachedSession);
         }
     }
@@ -453,10 +574,12 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->dropQueuedIdentsAtSessionEndAllowed(true);
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
+        Partition* partition = &_partitions[_getPartitionIndex()];
+        stdx::lock_guard<stdx::mutex> lock(partition->mutex);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            session->_lastReleasedBy = stdx::this_thread::get_id();
+            partition->sessions.push_back(session);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -468,6 +591,14 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
         _engine->dropSomeQueuedIdents();
 }
 
+void WiredTigerSessionCache::appendCursorCacheStats(BSONObjBuilder* builder) {
+    BSONObjBuilder bob(builder->subobjStart("cursorCache"));
+    bob.append("hits", static_cast<long long>(cursorCacheHits.load()));
+    bob.append("misses", static_cast<long long>(cursorCacheMisses.load()));
+    bob.append("sessionAffinityHits", static_cast<long long>(sessionAffinityHits.load()));
+    bob.done();
+}
+
 
 void WiredTigerSessionCache::setJournalListener(JournalListener* jl) {
     stdx::unique_lock<stdx::mutex> lk(_journalListenerMutex);
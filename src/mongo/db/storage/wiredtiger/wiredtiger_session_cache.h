@@ -32,6 +32,7 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <string>
 
 #include <wiredtiger.h>
@@ -40,10 +41,13 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerKVEngine;
 class WiredTigerSessionCache;
 
@@ -179,11 +183,15 @@ private:
     uint64_t _cursorGen;
     int _cursorsOut;
     bool _dropQueuedIdentsAtSessionEnd = true;
+
+    // The thread that last returned this session to the WiredTigerSessionCache.
+    stdx::thread::id _lastReleasedBy;
 };
 
 /**
  *  This cache implements a shared pool of WiredTiger sessions with the goal to amortize the
- *  cost of session creation and destruction over multiple uses.
+ *  cost of session creation and destruction over multiple uses. The pool is split into per-CPU
+ *  partitions, each with its own mutex, so that threads on different cores do not contend.
  */
 class WiredTigerSessionCache {
 public:
@@ -240,6 +248,11 @@ public:
      * Waits until all commits that happened before this call are durable, either by flushing
      * the log or forcing a checkpoint if forceCheckpoint is true or the journal is disabled.
      * Uses a temporary session. Safe to call without any locks, even during shutdown.
+     *
+     * Concurrent callers share journal flushes: a caller which arrives while another is flushing
+     * is covered by the next flush, which is issued once for all such callers. When other callers
+     * are waiting, the thread issuing a flush first waits up to
+     * wiredTigerJournalCommitCoalescingDelayMicros for more commits to join it.
      */
     void waitUntilDurable(bool forceCheckpoint, bool stableCheckpoint);
 
@@ -284,7 +297,17 @@ public:
         return _engine;
     }
 
+    /**
+     * Appends cursor cache hit and miss counts, and how often getSession() handed a thread back
+     * the session it had released, to 'builder'.
+     */
+    static void appendCursorCacheStats(BSONObjBuilder* builder);
+
 private:
+    // How many of the most recently released sessions getSession() searches for one released by
+    // the calling thread.
+    static constexpr size_t kSessionAffinityScanDepth = 16;
+
     WiredTigerKVEngine* _engine;  // not owned, might be NULL
     WT_CONNECTION* _conn;         // not owned
     WiredTigerSnapshotManager _snapshotManager;
@@ -295,9 +318,15 @@ private:
     AtomicUInt32 _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    stdx::mutex _cacheLock;
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    struct Partition {
+        stdx::mutex mutex;
+        SessionCache sessions;
+    };
+
+    const unsigned _numPartitions;
+    std::unique_ptr<CacheAligned<Partition>[]> _partitions;
 
     // Bumped when all open sessions need to be closed
     AtomicUInt64 _epoch;  // atomic so we can check it outside of the lock
@@ -309,6 +338,9 @@ private:
     AtomicUInt32 _lastSyncTime;
     stdx::mutex _lastSyncMutex;
 
+    // Number of threads currently waiting in waitUntilDurable for a journal flush
+    AtomicUInt32 _durabilityWaiters;
+
     // Mutex and cond var for waiting on prepare commit or abort.
     stdx::mutex _prepareCommittedOrAbortedMutex;
     stdx::condition_variable _prepareCommittedOrAbortedCond;
@@ -322,6 +354,17 @@ private:
     WT_SESSION* _waitUntilDurableSession = nullptr;  // owned, and never explicitly closed
                                                      // (uses connection close to clean up)
 
+    /**
+     * Returns the index of the partition for the CPU the calling thread is running on.
+     */
+    unsigned _getPartitionIndex() const;
+
+    /**
+     * Removes and returns a session from 'partition', preferring one that the calling thread
+     * released. Returns nullptr if the partition is empty. Must hold the partition's mutex.
+     */
+    WiredTigerSession* _takeSession_inlock(Partition* partition);
+
     /**
      * Returns a session to the cache for later reuse. If closeAll was called between getting this
      * session and releasing it, the session is directly released. This method is thread safe.
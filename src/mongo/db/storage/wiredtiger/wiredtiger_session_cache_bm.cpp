@@ -0,0 +1,87 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <wiredtiger.h>
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+const int kMaxPerfThreads = 128;  // max number of threads to use for session cache perf
+
+class WiredTigerSessionCacheTest : public benchmark::Fixture {
+public:
+    void setUpSessionCache() {
+        _dbpath = stdx::make_unique<unittest::TempDir>("wt_session_cache_bm");
+        invariantWTOK(wiredtiger_open(
+            _dbpath->path().c_str(), nullptr, "create,in_memory=true,session_max=1000", &_conn));
+        _sessionCache = stdx::make_unique<WiredTigerSessionCache>(_conn);
+    }
+
+    void tearDownSessionCache() {
+        _sessionCache.reset();
+        invariantWTOK(_conn->close(_conn, nullptr));
+        _conn = nullptr;
+        _dbpath.reset();
+    }
+
+protected:
+    std::unique_ptr<unittest::TempDir> _dbpath;
+    WT_CONNECTION* _conn = nullptr;
+    std::unique_ptr<WiredTigerSessionCache> _sessionCache;
+};
+
+BENCHMARK_DEFINE_F(WiredTigerSessionCacheTest, BM_GetAndReleaseSession)
+(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        setUpSessionCache();
+    }
+
+    for (auto keepRunning : state) {
+        auto session = _sessionCache->getSession();
+        benchmark::DoNotOptimize(session.get());
+    }
+
+    if (state.thread_index == 0) {
+        tearDownSessionCache();
+    }
+}
+
+BENCHMARK_REGISTER_F(WiredTigerSessionCacheTest, BM_GetAndReleaseSession)
+    ->ThreadRange(1, kMaxPerfThreads);
+
+}  // namespace
+}  // namespace mongo
@@ -46,19 +46,17 @@ namespace mongo {
 namespace {
 
 /**
- * Finds the host and port for a shard.
+ * Finds the host and port for a shard. Targeting completes asynchronously, so that a participant
+ * whose primary is not yet known does not hold up sending to the others.
  */
-StatusWith<HostAndPort> targetHost(OperationContext* opCtx,
-                                   const ShardId& shardId,
-                                   const ReadPreferenceSetting& readPref) {
+Future<HostAndPort> targetHost(const ShardId& shardId, const ReadPreferenceSetting& readPref) {
     auto shard = Grid::get(getGlobalServiceContext())->shardRegistry()->getShardNoReload(shardId);
     if (!shard) {
         return Status(ErrorCodes::ShardNotFound,
                       str::stream() << "Could not find shard " << shardId);
     }
 
-    auto targeter = shard->getTargeter();
-    return targeter->findHost(opCtx, readPref);
+    return shard->getTargeter()->findHostWithMaxWait(readPref, Seconds(20));
 }
 
 using CallbackFn = stdx::function<void(Status status, const ShardId& shardID)>;
@@ -67,44 +65,51 @@ using CallbackFn = stdx::function<void(Status status, const ShardId& shardID)>;
  * Sends the given command object to the given shard ID. If scheduling and running the command is
  * successful, calls the callback with the status of the command response and the shard ID.
  */
-void sendAsyncCommandToShard(OperationContext* opCtx,
-                             executor::TaskExecutor* executor,
+void sendAsyncCommandToShard(executor::TaskExecutor* executor,
                              const ShardId& shardId,
                              const BSONObj& commandObj,
                              CallbackFn callbackOnCommandResponse) {
     auto readPref = ReadPreferenceSetting(ReadPreference::PrimaryOnly);
-    auto swShardHostAndPort = targetHost(opCtx, shardId, readPref);
-    if (!swShardHostAndPort.isOK()) {
-        LOG(3) << "Coordinator shard failed to target primary host of participant shard for "
-               << commandObj << causedBy(swShardHostAndPort.getStatus());
-        return;
-    }
-
-    executor::RemoteCommandRequest request(
-        swShardHostAndPort.getValue(), "admin", commandObj, readPref.toContainingBSON(), nullptr);
-
-    auto swCallbackHandle = executor->scheduleRemoteCommand(
-        request,
-        [commandObj, shardId, callbackOnCommandResponse](
-            const executor::TaskExecutor::RemoteCommandCallbackArgs& args) {
-
-            auto status = (!args.response.isOK()) ? args.response.status
-                                                  : getStatusFromCommandResult(args.response.data);
-
-            LOG(3) << "Coordinator shard got response " << status << " for " << commandObj << " to "
-                   << shardId;
+    targetHost(shardId, readPref)
+        .getAsync([executor, readPref, shardId, commandObj, callbackOnCommandResponse](
+            StatusWith<HostAndPort> swShardHostAndPort) {
+            if (!swShardHostAndPort.isOK()) {
+                LOG(3) << "Coordinator shard failed to target primary host of participant shard "
+                          "for "
+                       << commandObj << causedBy(swShardHostAndPort.getStatus());
+                return;
+            }
 
-            // Only call callback if command successfully executed and got a response.
-            if (args.response.isOK()) {
-                callbackOnCommandResponse(status, shardId);
+            executor::RemoteCommandRequest request(swShardHostAndPort.getValue(),
+                                                   "admin",
+                                                   commandObj,
+                                                   readPref.toContainingBSON(),
+                                                   nullptr);
+
+            auto swCallbackHandle = executor->scheduleRemoteCommand(
+                request,
+                [commandObj, shardId, callbackOnCommandResponse](
+                    const executor::TaskExecutor::RemoteCommandCallbackArgs& args) {
+
+                    auto status = (!args.response.isOK())
+                        ? args.response.status
+                        : getStatusFromCommandResult(args.response.data);
+
+                    LOG(3) << "Coordinator shard got response " << status << " for "
+                           << commandObj << " to " << shardId;
+
+                    // Only call callback if command successfully executed and got a response.
+                    if (args.response.isOK()) {
+                        callbackOnCommandResponse(status, shardId);
+                    }
+                });
+
+            if (!swCallbackHandle.isOK()) {
+                LOG(3) << "Coordinator shard failed to schedule the task to send " << commandObj
+                       << " to shard " << shardId << causedBy(swCallbackHandle.getStatus());
             }
         });
 
-    if (!swCallbackHandle.isOK()) {
-        LOG(3) << "Coordinator shard failed to schedule the task to send " << commandObj
-               << " to shard " << shardId << causedBy(swCallbackHandle.getStatus());
-    }
-
     // Do not wait for the callback to run.
 }
 
@@ -126,7 +131,7 @@ void sendAsyncCommandToShards(OperationContext* opCtx,
     // For each non-acked participant, launch an async task to target its shard
     // and then asynchronously send the command.
     for (const auto& shardId : shardIds) {
-        sendAsyncCommandToShard(opCtx, exec, shardId, commandObj, callbackOnCommandResponse);
+        sendAsyncCommandToShard(exec, shardId, commandObj, callbackOnCommandResponse);
         ss << shardId << " ";
     }
 
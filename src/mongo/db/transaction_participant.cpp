@@ -238,13 +238,19 @@ void updateSessionEntry(OperationContext* opCtx, const UpdateRequest& updateRequ
     auto originalDoc = originalRecordData.toBson();
 
     invariant(collection->getDefaultCollator() == nullptr);
-    boost::intrusive_ptr<ExpressionContext> expCtx(new ExpressionContext(opCtx, nullptr));
 
-    auto matcher =
-        fassert(40673, MatchExpressionParser::parse(updateRequest.getQuery(), std::move(expCtx)));
-    if (!matcher->matchesBSON(originalDoc)) {
-        // Document no longer match what we expect so throw WCE to make the caller re-examine.
-        throw WriteConflictException();
+    // The document was found through the _id index in this same snapshot, so a query on the _id
+    // alone, which is what every caller passes, matches it without having to be parsed. This
+    // update happens once per retryable write, so it is worth skipping.
+    if (updateRequest.getQuery().nFields() > 1) {
+        boost::intrusive_ptr<ExpressionContext> expCtx(new ExpressionContext(opCtx, nullptr));
+
+        auto matcher = fassert(
+            40673, MatchExpressionParser::parse(updateRequest.getQuery(), std::move(expCtx)));
+        if (!matcher->matchesBSON(originalDoc)) {
+            // Document no longer match what we expect so throw WCE to make the caller re-examine.
+            throw WriteConflictException();
+        }
     }
 
     CollectionUpdateArgs args;
@@ -34,13 +34,17 @@
 
 #include "mongo/db/ttl.h"
 
+#include <map>
+
 #include "mongo/base/counter.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/user_name.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog_entry.h"
+#include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_catalog_entry.h"
 #include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/catalog/drop_collection.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands/fsync_locked.h"
@@ -53,10 +57,12 @@
 #include "mongo/db/ops/insert.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_options.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/ttl_collection_cache.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 
@@ -64,10 +70,13 @@ namespace mongo {
 
 Counter64 ttlPasses;
 Counter64 ttlDeletedDocuments;
+Counter64 ttlDroppedCollections;
 
 ServerStatusMetricField<Counter64> ttlPassesDisplay("ttl.passes", &ttlPasses);
 ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocuments",
                                                               &ttlDeletedDocuments);
+ServerStatusMetricField<Counter64> ttlDroppedCollectionsDisplay("ttl.droppedCollections",
+                                                                &ttlDroppedCollections);
 
 MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorEnabled, bool, true);
 MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorSleepSecs, int, 60)
@@ -77,6 +86,31 @@ MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorSleepSecs, int, 60)
         return Status::OK();
     });  // used for testing
 
+// Number of threads among which the collections with TTL indexes are divided on each pass.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ttlMonitorNumWorkers, int, 4)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0)
+            return Status(ErrorCodes::BadValue, "ttlMonitorNumWorkers must be strictly positive");
+        return Status::OK();
+    });
+
+// Maximum number of index keys whose documents are deleted while holding the collection lock.
+MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorBatchSize, int, 1000)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0)
+            return Status(ErrorCodes::BadValue, "ttlMonitorBatchSize must be strictly positive");
+        return Status::OK();
+    });
+
+// Maximum rate at which expired documents are deleted from each collection, 0 for no limit.
+MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorMaxDeletesPerSecondPerCollection, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0)
+            return Status(ErrorCodes::BadValue,
+                          "ttlMonitorMaxDeletesPerSecondPerCollection must not be negative");
+        return Status::OK();
+    });
+
 class TTLMonitor : public BackgroundJob {
 public:
     TTLMonitor() {}
@@ -93,6 +127,18 @@ public:
         ON_BLOCK_EXIT([] { Client::destroy(); });
         AuthorizationSession::get(cc())->grantInternalAuthorization();
 
+        ThreadPool::Options options;
+        options.poolName = "TTLMonitorWorkers";
+        options.threadNamePrefix = "TTLMonitorWorker-";
+        options.minThreads = 0;
+        options.maxThreads = static_cast<size_t>(ttlMonitorNumWorkers);
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName.c_str());
+            AuthorizationSession::get(cc())->grantInternalAuthorization();
+        };
+        _workers = stdx::make_unique<ThreadPool>(options);
+        _workers->startup();
+
         while (!globalInShutdownDeprecated()) {
             {
                 MONGO_IDLE_THREAD_BLOCK;
@@ -134,7 +180,7 @@ private:
 
         TTLCollectionCache& ttlCollectionCache = TTLCollectionCache::get(getGlobalServiceContext());
         std::vector<std::string> ttlCollections = ttlCollectionCache.getCollections();
-        std::vector<BSONObj> ttlIndexes;
+        std::map<std::string, std::vector<BSONObj>> ttlIndexesByCollection;
 
         ttlPasses.increment();
 
@@ -155,27 +201,43 @@ private:
             for (const std::string& name : indexNames) {
                 BSONObj spec = collEntry->getIndexSpec(&opCtx, name);
                 if (spec.hasField(secondsExpireField)) {
-                    ttlIndexes.push_back(spec.getOwned());
+                    ttlIndexesByCollection[collectionNS].push_back(spec.getOwned());
                 }
             }
         }
 
-        for (const BSONObj& idx : ttlIndexes) {
-            try {
-                doTTLForIndex(&opCtx, idx);
-            } catch (const DBException& dbex) {
-                error() << "Error processing ttl index: " << idx << " -- " << dbex.toString();
-                // Continue on to the next index.
-                continue;
-            }
+        // Each collection is processed by a single worker, so that the rate limit applies to it as
+        // a whole. A collection with a lot to delete is left for the next pass after a pass worth
+        // of time, so that it cannot hold up the collections queued behind it.
+        const Date_t deadline = Date_t::now() + Seconds(ttlMonitorSleepSecs.load());
+        for (auto& collectionAndIndexes : ttlIndexesByCollection) {
+            auto indexes = std::move(collectionAndIndexes.second);
+            invariant(_workers->schedule([ this, indexes = std::move(indexes), deadline ] {
+                const ServiceContext::UniqueOperationContext opCtx = cc().makeOperationContext();
+                for (const BSONObj& idx : indexes) {
+                    try {
+                        doTTLForIndex(opCtx.get(), idx, deadline);
+                    } catch (const DBException& dbex) {
+                        error() << "Error processing ttl index: " << idx << " -- "
+                                << dbex.toString();
+                        // Continue on to the next index.
+                        continue;
+                    }
+                }
+            }));
         }
+
+        _workers->waitForIdle();
     }
 
     /**
      * Remove documents from the collection using the specified TTL index after a sufficient amount
      * of time has passed according to its expiry specification.
+     *
+     * The documents are deleted in batches in the order of the index, re-acquiring the collection
+     * lock for each, until none are expired or 'deadline' is reached.
      */
-    void doTTLForIndex(OperationContext* opCtx, BSONObj idx) {
+    void doTTLForIndex(OperationContext* opCtx, BSONObj idx, Date_t deadline) {
         const NamespaceString collectionNSS(idx["ns"].String());
         if (collectionNSS.isDropPendingNamespace()) {
             return;
@@ -187,7 +249,7 @@ private:
         }
 
         const BSONObj key = idx["key"].Obj();
-        const StringData name = idx["name"].valueStringData();
+        const std::string name = idx["name"].str();
         if (key.nFields() != 1) {
             error() << "key for ttl index can only have 1 field, skipping ttl job for: " << idx;
             return;
@@ -195,31 +257,74 @@ private:
 
         LOG(1) << "ns: " << collectionNSS << " key: " << key << " name: " << name;
 
-        AutoGetCollection autoGetCollection(opCtx, collectionNSS, MODE_IX);
-        Collection* collection = autoGetCollection.getCollection();
+        long long numDeleted = 0;
+        while (true) {
+            const Date_t batchStart = Date_t::now();
+
+            auto batch = deleteExpiredBatch(opCtx, collectionNSS, name);
+            numDeleted += batch.numDeleted;
+            if (batch.done) {
+                break;
+            }
+
+            Date_t nextBatchStart = Date_t::now();
+            if (const int maxRate = ttlMonitorMaxDeletesPerSecondPerCollection.load()) {
+                nextBatchStart =
+                    std::max(nextBatchStart,
+                             batchStart + Milliseconds(batch.numDeleted * 1000 / maxRate));
+            }
+            if (nextBatchStart >= deadline) {
+                LOG(1) << "ns: " << collectionNSS << " still has expired documents, they will be "
+                       << "deleted on the next pass";
+                break;
+            }
+
+            opCtx->sleepUntil(nextBatchStart);
+        }
+
+        ttlDeletedDocuments.increment(numDeleted);
+        LOG(1) << "deleted: " << numDeleted;
+    }
+
+    struct BatchResult {
+        long long numDeleted = 0;
+
+        // Whether there are no documents left to delete, or they cannot be deleted
+        bool done = true;
+    };
+
+    BatchResult deleteExpiredBatch(OperationContext* opCtx,
+                                   const NamespaceString& collectionNSS,
+                                   const std::string& name) {
+        BatchResult batch;
+
+        boost::optional<AutoGetCollection> autoGetCollection;
+        autoGetCollection.emplace(opCtx, collectionNSS, MODE_IX);
+        Collection* collection = autoGetCollection->getCollection();
         if (!collection) {
             // Collection was dropped.
-            return;
+            return batch;
         }
 
         if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, collectionNSS)) {
-            return;
+            return batch;
         }
 
         IndexDescriptor* desc = collection->getIndexCatalog()->findIndexByName(opCtx, name);
         if (!desc) {
             LOG(1) << "index not found (index build in progress? index dropped?), skipping "
-                   << "ttl job for: " << idx;
-            return;
+                   << "ttl job for: " << collectionNSS << " index: " << name;
+            return batch;
         }
 
         // Re-read 'idx' from the descriptor, in case the collection or index definition changed
         // before we re-acquired the collection lock.
-        idx = desc->infoObj();
+        const BSONObj idx = desc->infoObj();
+        const BSONObj key = desc->keyPattern();
 
         if (IndexType::INDEX_BTREE != IndexNames::nameToType(desc->getAccessMethodName())) {
             error() << "special index can't be used as a ttl index, skipping ttl job for: " << idx;
-            return;
+            return batch;
         }
 
         BSONElement secondsExpireElt = idx[secondsExpireField];
@@ -227,26 +332,61 @@ private:
             error() << "ttl indexes require the " << secondsExpireField << " field to be "
                     << "numeric but received a type of " << typeName(secondsExpireElt.type())
                     << ", skipping ttl job for: " << idx;
-            return;
+            return batch;
         }
 
         const Date_t kDawnOfTime =
             Date_t::fromMillisSinceEpoch(std::numeric_limits<long long>::min());
         const Date_t expirationTime = Date_t::now() - Seconds(secondsExpireElt.numberLong());
         const BSONObj startKey = BSON("" << kDawnOfTime);
-        const BSONObj endKey = BSON("" << expirationTime);
         // The canonical check as to whether a key pattern element is "ascending" or
         // "descending" is (elt.number() >= 0).  This is defined by the Ordering class.
         const InternalPlanner::Direction direction = (key.firstElement().number() >= 0)
             ? InternalPlanner::Direction::FORWARD
             : InternalPlanner::Direction::BACKWARD;
 
+        if (idx[IndexDescriptor::kExpireCollectionFieldName].trueValue() &&
+            allDocumentsExpired(opCtx, collection, desc, direction, expirationTime)) {
+            const auto uuid = collection->uuid();
+            autoGetCollection.reset();
+            batch.numDeleted =
+                dropExpiredCollection(opCtx, collectionNSS, uuid, name, direction, expirationTime);
+            return batch;
+        }
+
+        // Stop the batch at the key of the last document it may delete, found by scanning the
+        // index alone.
+        Date_t batchEndTime = expirationTime;
+        {
+            auto exec = InternalPlanner::indexScan(opCtx,
+                                                   collection,
+                                                   desc,
+                                                   startKey,
+                                                   BSON("" << expirationTime),
+                                                   BoundInclusion::kIncludeBothStartAndEndKeys,
+                                                   PlanExecutor::YIELD_AUTO,
+                                                   direction);
+            const int batchSize = ttlMonitorBatchSize.load();
+            BSONObj indexKey;
+            int numKeys = 0;
+            while (numKeys < batchSize &&
+                   exec->getNext(&indexKey, nullptr) == PlanExecutor::ADVANCED) {
+                ++numKeys;
+                if (numKeys == batchSize) {
+                    batchEndTime = indexKey.firstElement().date();
+                    batch.done = false;
+                }
+            }
+            if (numKeys == 0) {
+                return batch;
+            }
+        }
+
         // We need to pass into the DeleteStageParams (below) a CanonicalQuery with a BSONObj that
         // queries for the expired documents correctly so that we do not delete documents that are
         // not actually expired when our snapshot changes during deletion.
         const char* keyFieldName = key.firstElement().fieldName();
-        BSONObj query =
-            BSON(keyFieldName << BSON("$gte" << kDawnOfTime << "$lte" << expirationTime));
+        BSONObj query = BSON(keyFieldName << BSON("$gte" << kDawnOfTime << "$lte" << batchEndTime));
         auto qr = stdx::make_unique<QueryRequest>(collectionNSS);
         qr->setFilter(query);
         auto canonicalQuery = CanonicalQuery::canonicalize(opCtx, std::move(qr));
@@ -262,7 +402,7 @@ private:
                                                  params,
                                                  desc,
                                                  startKey,
-                                                 endKey,
+                                                 BSON("" << batchEndTime),
                                                  BoundInclusion::kIncludeBothStartAndEndKeys,
                                                  PlanExecutor::YIELD_AUTO,
                                                  direction);
@@ -271,13 +411,107 @@ private:
         if (!result.isOK()) {
             error() << "ttl query execution for index " << idx
                     << " failed with status: " << redact(result);
-            return;
+            batch.done = true;
+            return batch;
         }
 
-        const long long numDeleted = DeleteStage::getNumDeleted(*exec);
-        ttlDeletedDocuments.increment(numDeleted);
-        LOG(1) << "deleted: " << numDeleted;
+        batch.numDeleted = DeleteStage::getNumDeleted(*exec);
+        return batch;
+    }
+
+    /**
+     * Returns whether the collection has documents, all of which are expired according to the
+     * given TTL index. Since the keys are ordered, it is enough that the smallest and the largest
+     * keys are expired dates.
+     */
+    static bool allDocumentsExpired(OperationContext* opCtx,
+                                    Collection* collection,
+                                    IndexDescriptor* desc,
+                                    InternalPlanner::Direction ascending,
+                                    Date_t expirationTime) {
+        // Documents without the indexed field would be missing from a sparse or partial index
+        if (desc->isSparse() || desc->isPartial()) {
+            return false;
+        }
+
+        const auto firstKey = [&](InternalPlanner::Direction direction) {
+            const bool fromMinKey = direction == ascending;
+            const BSONObj minKey = BSON("" << MINKEY);
+            const BSONObj maxKey = BSON("" << MAXKEY);
+            auto exec = InternalPlanner::indexScan(opCtx,
+                                                   collection,
+                                                   desc,
+                                                   fromMinKey ? minKey : maxKey,
+                                                   fromMinKey ? maxKey : minKey,
+                                                   BoundInclusion::kIncludeBothStartAndEndKeys,
+                                                   PlanExecutor::NO_YIELD,
+                                                   direction);
+            BSONObj indexKey;
+            if (exec->getNext(&indexKey, nullptr) != PlanExecutor::ADVANCED) {
+                return BSONObj();
+            }
+            return indexKey.getOwned();
+        };
+
+        const auto smallestKey = firstKey(ascending);
+        const auto largestKey = firstKey(ascending == InternalPlanner::Direction::FORWARD
+                                             ? InternalPlanner::Direction::BACKWARD
+                                             : InternalPlanner::Direction::FORWARD);
+        return !smallestKey.isEmpty() && smallestKey.firstElement().type() == BSONType::Date &&
+            largestKey.firstElement().type() == BSONType::Date &&
+            largestKey.firstElement().date() <= expirationTime;
     }
+
+    /**
+     * Drops a collection whose documents have all expired rather than deleting them one by one,
+     * and returns the number of documents it had. Collections of shards are left to be deleted
+     * from, since they can only be dropped through the config server.
+     */
+    static long long dropExpiredCollection(OperationContext* opCtx,
+                                           const NamespaceString& collectionNSS,
+                                           OptionalCollectionUUID uuid,
+                                           const std::string& indexName,
+                                           InternalPlanner::Direction ascending,
+                                           Date_t expirationTime) {
+        if (serverGlobalParams.clusterRole == ClusterRole::ShardServer) {
+            LOG(1) << "ns: " << collectionNSS << " has expired but is on a shard, deleting its "
+                   << "documents instead of dropping it";
+            return 0;
+        }
+
+        // Documents may have been inserted since the collection lock was released, so check again
+        // under a lock which keeps them out until the collection is dropped
+        Lock::DBLock dbLock(opCtx, collectionNSS.db(), MODE_X);
+        Database* const db = DatabaseHolder::getDatabaseHolder().get(opCtx, collectionNSS.db());
+        Collection* const collection = db ? db->getCollection(opCtx, collectionNSS) : nullptr;
+        if (!collection || collection->uuid() != uuid ||
+            !repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, collectionNSS)) {
+            return 0;
+        }
+
+        IndexDescriptor* const desc =
+            collection->getIndexCatalog()->findIndexByName(opCtx, indexName);
+        if (!desc || !allDocumentsExpired(opCtx, collection, desc, ascending, expirationTime)) {
+            return 0;
+        }
+
+        const long long numRecords = collection->numRecords(opCtx);
+
+        log() << "Dropping " << collectionNSS << " since all of its " << numRecords
+              << " documents have expired";
+
+        BSONObjBuilder unusedResult;
+        uassertStatusOK(
+            dropCollection(opCtx,
+                           collectionNSS,
+                           unusedResult,
+                           {},
+                           DropCollectionSystemCollectionMode::kDisallowSystemCollectionDrops));
+        ttlDroppedCollections.increment();
+        return numRecords;
+    }
+
+    std::unique_ptr<ThreadPool> _workers;
 };
 
 namespace {
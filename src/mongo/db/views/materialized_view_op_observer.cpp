@@ -0,0 +1,150 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/views/materialized_view_op_observer.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/views/materialized_view_registry.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Records the documents identified by 'ids' as changed in 'nss' once the current unit of work
+ * commits. Changes which roll back are never seen by the views.
+ */
+void recordChangesOnCommit(OperationContext* opCtx,
+                           const NamespaceString& nss,
+                           std::vector<BSONObj> ids) {
+    auto serviceContext = opCtx->getServiceContext();
+    opCtx->recoveryUnit()->onCommit(
+        [serviceContext, nss, ids = std::move(ids)](boost::optional<Timestamp>) {
+            MaterializedViewRegistry::get(serviceContext).recordChanges(nss, ids);
+        });
+}
+
+void markForFullRefreshOnCommit(OperationContext* opCtx, const NamespaceString& nss) {
+    auto& registry = MaterializedViewRegistry::get(opCtx->getServiceContext());
+    if (!registry.isTracked(nss)) {
+        return;
+    }
+    opCtx->recoveryUnit()->onCommit(
+        [&registry, nss](boost::optional<Timestamp>) { registry.markForFullRefresh(nss); });
+}
+
+}  // namespace
+
+MaterializedViewOpObserver::MaterializedViewOpObserver() = default;
+
+MaterializedViewOpObserver::~MaterializedViewOpObserver() = default;
+
+void MaterializedViewOpObserver::onInserts(OperationContext* opCtx,
+                                           const NamespaceString& nss,
+                                           OptionalCollectionUUID uuid,
+                                           std::vector<InsertStatement>::const_iterator begin,
+                                           std::vector<InsertStatement>::const_iterator end,
+                                           bool fromMigrate) {
+    if (!MaterializedViewRegistry::get(opCtx->getServiceContext()).isTracked(nss)) {
+        return;
+    }
+
+    std::vector<BSONObj> ids;
+    for (auto it = begin; it != end; ++it) {
+        ids.push_back(it->doc["_id"].wrap());
+    }
+    recordChangesOnCommit(opCtx, nss, std::move(ids));
+}
+
+void MaterializedViewOpObserver::onUpdate(OperationContext* opCtx,
+                                          const OplogUpdateEntryArgs& args) {
+    if (!MaterializedViewRegistry::get(opCtx->getServiceContext()).isTracked(args.nss)) {
+        return;
+    }
+
+    auto idElem = args.updateArgs.criteria["_id"];
+    if (idElem.eoo()) {
+        idElem = args.updateArgs.updatedDoc["_id"];
+    }
+    recordChangesOnCommit(opCtx, args.nss, {idElem.wrap()});
+}
+
+void MaterializedViewOpObserver::aboutToDelete(OperationContext* opCtx,
+                                               const NamespaceString& nss,
+                                               const BSONObj& doc) {
+    if (!MaterializedViewRegistry::get(opCtx->getServiceContext()).isTracked(nss)) {
+        return;
+    }
+
+    recordChangesOnCommit(opCtx, nss, {doc["_id"].wrap()});
+}
+
+void MaterializedViewOpObserver::onDropDatabase(OperationContext* opCtx,
+                                                const std::string& dbName) {
+    auto& registry = MaterializedViewRegistry::get(opCtx->getServiceContext());
+    opCtx->recoveryUnit()->onCommit([&registry, dbName](boost::optional<Timestamp>) {
+        registry.markDatabaseForFullRefresh(dbName);
+    });
+}
+
+repl::OpTime MaterializedViewOpObserver::onDropCollection(OperationContext* opCtx,
+                                                          const NamespaceString& collectionName,
+                                                          OptionalCollectionUUID uuid) {
+    markForFullRefreshOnCommit(opCtx, collectionName);
+    return {};
+}
+
+void MaterializedViewOpObserver::onRenameCollection(OperationContext* opCtx,
+                                                    const NamespaceString& fromCollection,
+                                                    const NamespaceString& toCollection,
+                                                    OptionalCollectionUUID uuid,
+                                                    OptionalCollectionUUID dropTargetUUID,
+                                                    bool stayTemp) {
+    markForFullRefreshOnCommit(opCtx, fromCollection);
+    markForFullRefreshOnCommit(opCtx, toCollection);
+}
+
+void MaterializedViewOpObserver::postRenameCollection(OperationContext* opCtx,
+                                                      const NamespaceString& fromCollection,
+                                                      const NamespaceString& toCollection,
+                                                      OptionalCollectionUUID uuid,
+                                                      OptionalCollectionUUID dropTargetUUID,
+                                                      bool stayTemp) {
+    markForFullRefreshOnCommit(opCtx, fromCollection);
+    markForFullRefreshOnCommit(opCtx, toCollection);
+}
+
+void MaterializedViewOpObserver::onEmptyCapped(OperationContext* opCtx,
+                                               const NamespaceString& collectionName,
+                                               OptionalCollectionUUID uuid) {
+    markForFullRefreshOnCommit(opCtx, collectionName);
+}
+
+}  // namespace mongo
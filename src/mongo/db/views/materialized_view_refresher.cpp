@@ -0,0 +1,721 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/views/materialized_view_refresher.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "mongo/base/counter.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/client/dbclient_cursor.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/database.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/fsync_locked.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/db/pipeline/aggregation_request.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/lite_parsed_pipeline.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/db/views/materialized_view_registry.h"
+#include "mongo/db/views/view.h"
+#include "mongo/db/views/view_catalog.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/util/background.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/exit.h"
+#include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+
+MONGO_EXPORT_SERVER_PARAMETER(materializedViewRefresherEnabled, bool, true);
+MONGO_EXPORT_SERVER_PARAMETER(materializedViewRefreshIntervalSecs, int, 10)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0)
+            return Status(ErrorCodes::BadValue,
+                          "materializedViewRefreshIntervalSecs must be strictly positive");
+        return Status::OK();
+    });
+
+namespace {
+
+Counter64 materializedViewPasses;
+Counter64 materializedViewFullRefreshes;
+Counter64 materializedViewIncrementalRefreshes;
+
+ServerStatusMetricField<Counter64> materializedViewPassesDisplay("materializedViews.passes",
+                                                                 &materializedViewPasses);
+ServerStatusMetricField<Counter64> materializedViewFullRefreshesDisplay(
+    "materializedViews.fullRefreshes", &materializedViewFullRefreshes);
+ServerStatusMetricField<Counter64> materializedViewIncrementalRefreshesDisplay(
+    "materializedViews.incrementalRefreshes", &materializedViewIncrementalRefreshes);
+
+// The number of changed documents whose results are recomputed with a single aggregation.
+const size_t kIdsPerBatch = 1000;
+
+// Upper bound on the size of the operations sent in a single write command.
+const int kMaxWriteBatchBytes = 8 * 1024 * 1024;
+
+const StringData kKeyField = "k"_sd;
+
+/**
+ * How the results of a materialized view are brought up to date when its source changes.
+ */
+enum class MaintenanceMode {
+    // Every stage maps a document to at most one result with the same _id, so only the results of
+    // the changed documents need to be recomputed.
+    kPerDocument,
+
+    // The stages before a final $group are per-document and the $group only computes $sum
+    // accumulators, so the contributions of the changed documents to their groups can be taken
+    // back out and added in again.
+    kGroup,
+
+    // The view is recomputed in full whenever its source changes.
+    kFullRefresh,
+};
+
+/**
+ * What the refresher derives from the definition of a materialized view.
+ */
+struct MaterializedView {
+    NamespaceString name;
+    NamespaceString materializedNss;
+    NamespaceString contributionsNss;
+
+    // The collection the view is computed from, the pipeline to run on it and its collation.
+    NamespaceString sourceNss;
+    std::vector<BSONObj> pipeline;
+    BSONObj collation;
+
+    // Namespaces other than 'sourceNss' which the pipeline reads from.
+    std::vector<NamespaceString> involvedNss;
+
+    MaintenanceMode mode = MaintenanceMode::kFullRefresh;
+
+    // For kGroup, the per-document stages before the $group, the $project which computes the
+    // contribution of a document to its group, the $group which combines the contributions and the
+    // names of the $sum accumulators.
+    std::vector<BSONObj> prefix;
+    BSONObj contributionProjection;
+    BSONObj regroup;
+    std::vector<std::string> sumFields;
+
+    // Identifies the resolved definition, so that changes to it can be detected.
+    BSONObj fingerprint;
+};
+
+bool specSetsId(const BSONObj& spec) {
+    for (auto&& elem : spec) {
+        auto fieldName = elem.fieldNameStringData();
+        if (fieldName == "_id" || fieldName.startsWith("_id.")) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns true if 'stage' outputs at most one document for each input document, with the same _id.
+ */
+bool isPerDocumentStage(const BSONObj& stage) {
+    auto spec = stage.firstElement();
+    auto name = spec.fieldNameStringData();
+    if (spec.type() != BSONType::Object) {
+        return false;
+    }
+    if (name == "$match") {
+        return !spec.Obj().hasField("$text");
+    }
+    if (name == "$project") {
+        auto idSpec = spec.Obj()["_id"];
+        if (!idSpec.eoo() && !((idSpec.isBoolean() || idSpec.isNumber()) && idSpec.trueValue())) {
+            return false;
+        }
+        return !specSetsId(spec.Obj().removeField("_id"));
+    }
+    if (name == "$addFields") {
+        return !specSetsId(spec.Obj());
+    }
+    return false;
+}
+
+BSONObj ifNullSpec(const BSONElement& expr) {
+    BSONArrayBuilder args;
+    args.append(expr);
+    args.appendNull();
+    return BSON("$ifNull" << args.arr());
+}
+
+/**
+ * Builds the expression which computes the group key of a document from the _id of a $group, such
+ * that missing values become null as they do in the $group.
+ */
+void appendKeySpec(const BSONElement& idSpec, BSONObjBuilder* builder) {
+    if (idSpec.type() == BSONType::Object && !idSpec.Obj().isEmpty() &&
+        idSpec.Obj().firstElement().fieldNameStringData()[0] != '$') {
+        BSONObjBuilder keyBuilder(builder->subobjStart(kKeyField));
+        for (auto&& elem : idSpec.Obj()) {
+            keyBuilder.append(elem.fieldNameStringData(), ifNullSpec(elem));
+        }
+        return;
+    }
+    if (idSpec.type() == BSONType::Object && idSpec.Obj().isEmpty()) {
+        builder->append(kKeyField, BSON("$literal" << BSONObj()));
+        return;
+    }
+    builder->append(kKeyField, ifNullSpec(idSpec));
+}
+
+/**
+ * Fills in the kGroup fields of 'view' and returns true if its pipeline can be maintained that
+ * way.
+ */
+bool prepareGroupMaintenance(MaterializedView* view) {
+    if (view->pipeline.empty() || !view->collation.isEmpty()) {
+        return false;
+    }
+    auto groupSpec = view->pipeline.back().firstElement();
+    if (groupSpec.fieldNameStringData() != "$group" || groupSpec.type() != BSONType::Object) {
+        return false;
+    }
+    std::vector<BSONObj> prefix(view->pipeline.begin(), view->pipeline.end() - 1);
+    for (auto&& stage : prefix) {
+        if (!isPerDocumentStage(stage)) {
+            return false;
+        }
+    }
+
+    BSONObjBuilder projection;
+    BSONObjBuilder regroup;
+    regroup.append("_id", "$" + kKeyField);
+    std::vector<std::string> sumFields;
+    for (auto&& elem : groupSpec.Obj()) {
+        auto fieldName = elem.fieldNameStringData();
+        if (fieldName == "_id") {
+            appendKeySpec(elem, &projection);
+            continue;
+        }
+        if (fieldName == ViewDefinition::kMaterializedCountField ||
+            elem.type() != BSONType::Object || elem.Obj().nFields() != 1 ||
+            elem.Obj().firstElement().fieldNameStringData() != "$sum") {
+            return false;
+        }
+        std::string contributionField = str::stream() << "v" << sumFields.size();
+        projection.append(contributionField, ifNullSpec(elem.Obj().firstElement()));
+        regroup.append(fieldName, BSON("$sum" << ("$" + contributionField)));
+        sumFields.push_back(fieldName.toString());
+    }
+    if (!projection.hasField(kKeyField)) {
+        return false;
+    }
+    regroup.append(ViewDefinition::kMaterializedCountField, BSON("$sum" << 1));
+
+    view->prefix = std::move(prefix);
+    view->contributionProjection = BSON("$project" << projection.obj());
+    view->regroup = BSON("$group" << regroup.obj());
+    view->sumFields = std::move(sumFields);
+    return true;
+}
+
+MaintenanceMode classify(MaterializedView* view) {
+    if (!view->involvedNss.empty()) {
+        return MaintenanceMode::kFullRefresh;
+    }
+    if (std::all_of(view->pipeline.begin(), view->pipeline.end(), isPerDocumentStage)) {
+        return MaintenanceMode::kPerDocument;
+    }
+    if (prepareGroupMaintenance(view)) {
+        return MaintenanceMode::kGroup;
+    }
+    return MaintenanceMode::kFullRefresh;
+}
+
+/**
+ * Resolves 'viewDef' into the collection and pipeline which compute its results. Must be called
+ * with the database locked.
+ */
+MaterializedView resolve(OperationContext* opCtx,
+                         ViewCatalog* viewCatalog,
+                         const ViewDefinition& viewDef) {
+    MaterializedView view;
+    view.name = viewDef.name();
+    view.materializedNss = viewDef.materializedNss();
+    view.contributionsNss = viewDef.materializedContributionsNss();
+    view.sourceNss = viewDef.viewOn();
+    if (viewCatalog->lookup(opCtx, viewDef.viewOn().ns())) {
+        auto resolved = uassertStatusOK(viewCatalog->resolveView(opCtx, viewDef.viewOn()));
+        view.sourceNss = resolved.getNamespace();
+        view.pipeline = resolved.getPipeline();
+    }
+    view.pipeline.insert(view.pipeline.end(), viewDef.pipeline().begin(), viewDef.pipeline().end());
+    if (viewDef.defaultCollator()) {
+        view.collation = viewDef.defaultCollator()->getSpec().toBSON();
+    }
+
+    const LiteParsedPipeline liteParsedPipeline(AggregationRequest(view.sourceNss, view.pipeline));
+    for (auto&& nss : liteParsedPipeline.getInvolvedNamespaces()) {
+        if (viewCatalog->lookup(opCtx, nss.ns())) {
+            view.involvedNss.push_back(
+                uassertStatusOK(viewCatalog->resolveView(opCtx, nss)).getNamespace());
+        } else {
+            view.involvedNss.push_back(nss);
+        }
+    }
+    view.mode = classify(&view);
+
+    view.fingerprint = BSON("source" << view.sourceNss.ns() << "pipeline" << view.pipeline
+                                     << "collation"
+                                     << view.collation);
+    return view;
+}
+
+/**
+ * Runs 'pipeline' on 'nss' and returns the documents it produces.
+ */
+std::vector<BSONObj> runAggregate(DBDirectClient* client,
+                                  const NamespaceString& nss,
+                                  const std::vector<BSONObj>& pipeline,
+                                  const BSONObj& collation) {
+    BSONObjBuilder cmd;
+    cmd.append("aggregate", nss.coll());
+    cmd.append("pipeline", pipeline);
+    cmd.append("cursor", BSONObj());
+    cmd.append("allowDiskUse", true);
+    if (!collation.isEmpty()) {
+        cmd.append("collation", collation);
+    }
+
+    BSONObj result;
+    client->runCommand(nss.db().toString(), cmd.obj(), result);
+    uassertStatusOK(getStatusFromCommandResult(result));
+
+    auto response = CursorResponse::parseFromBSONThrowing(result);
+    DBClientCursor cursor(
+        client, response.getNSS(), response.getCursorId(), 0, 0, response.releaseBatch());
+    std::vector<BSONObj> docs;
+    while (cursor.more()) {
+        docs.push_back(cursor.next().getOwned());
+    }
+    return docs;
+}
+
+BSONObj outStage(const NamespaceString& nss) {
+    return BSON("$out" << BSON("to" << nss.coll() << "mode"
+                                    << "replaceCollection"));
+}
+
+/**
+ * Sends the write operations 'ops' on 'nss' in as few write commands as possible. 'cmdName' is
+ * "update" or "delete", and 'opsField' the matching field which holds the operations.
+ */
+void runWrites(DBDirectClient* client,
+               const NamespaceString& nss,
+               StringData cmdName,
+               StringData opsField,
+               const std::vector<BSONObj>& ops) {
+    auto it = ops.begin();
+    while (it != ops.end()) {
+        BSONArrayBuilder batch;
+        do {
+            batch.append(*it++);
+        } while (it != ops.end() && batch.len() + it->objsize() < kMaxWriteBatchBytes &&
+                 batch.arrSize() < static_cast<int>(write_ops::kMaxWriteBatchSize));
+
+        BSONObj result;
+        client->runCommand(
+            nss.db().toString(),
+            BSON(cmdName << nss.coll() << opsField << batch.arr() << "ordered" << false),
+            result);
+        uassertStatusOK(getStatusFromWriteCommandReply(result));
+    }
+}
+
+BSONObj upsertOp(const BSONObj& query, const BSONObj& update) {
+    return BSON("q" << query << "u" << update << "upsert" << true);
+}
+
+BSONObj deleteOp(const BSONObj& query) {
+    return BSON("q" << query << "limit" << 1);
+}
+
+BSONObj matchIds(std::vector<BSONObj>::const_iterator begin,
+                 std::vector<BSONObj>::const_iterator end) {
+    BSONArrayBuilder ids;
+    for (auto it = begin; it != end; ++it) {
+        ids.append(it->firstElement());
+    }
+    return BSON("$match" << BSON("_id" << BSON("$in" << ids.arr())));
+}
+
+void fullRefresh(DBDirectClient* client, const MaterializedView& view) {
+    if (view.mode != MaintenanceMode::kGroup) {
+        auto pipeline = view.pipeline;
+        pipeline.push_back(outStage(view.materializedNss));
+        runAggregate(client, view.sourceNss, pipeline, view.collation);
+        return;
+    }
+
+    auto pipeline = view.prefix;
+    pipeline.push_back(view.contributionProjection);
+    pipeline.push_back(outStage(view.contributionsNss));
+    runAggregate(client, view.sourceNss, pipeline, view.collation);
+    runAggregate(client,
+                 view.contributionsNss,
+                 {view.regroup, outStage(view.materializedNss)},
+                 view.collation);
+}
+
+/**
+ * Recomputes the results of the changed documents whose _ids are in [begin, end). Applying the same
+ * changes twice leaves the view unchanged, so documents which change again while this runs are
+ * simply applied once more on the next pass.
+ */
+void refreshPerDocument(DBDirectClient* client,
+                        const MaterializedView& view,
+                        std::vector<BSONObj>::const_iterator begin,
+                        std::vector<BSONObj>::const_iterator end) {
+    std::vector<BSONObj> pipeline{matchIds(begin, end)};
+    pipeline.insert(pipeline.end(), view.pipeline.begin(), view.pipeline.end());
+
+    std::vector<BSONObj> upserts;
+    auto produced = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    for (auto&& doc : runAggregate(client, view.sourceNss, pipeline, view.collation)) {
+        auto id = doc["_id"].wrap();
+        upserts.push_back(upsertOp(id, doc));
+        produced.insert(id);
+    }
+
+    std::vector<BSONObj> deletes;
+    for (auto it = begin; it != end; ++it) {
+        if (!produced.count(*it)) {
+            deletes.push_back(deleteOp(*it));
+        }
+    }
+
+    runWrites(client, view.materializedNss, "update", "updates", upserts);
+    runWrites(client, view.materializedNss, "delete", "deletes", deletes);
+}
+
+/**
+ * Replaces the contributions of the changed documents whose _ids are in [begin, end) to their
+ * groups. The previous contributions are kept in the contributions collection, so that they can be
+ * subtracted out before the new ones are added in.
+ */
+void refreshGroup(DBDirectClient* client,
+                  const MaterializedView& view,
+                  std::vector<BSONObj>::const_iterator begin,
+                  std::vector<BSONObj>::const_iterator end) {
+    struct GroupDelta {
+        std::vector<Value> sums;
+        long long count = 0;
+    };
+    auto deltas = SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<GroupDelta>();
+    auto addContribution = [&](const BSONObj& contribution, bool subtract) {
+        auto& delta = deltas[BSON("_id" << contribution[kKeyField])];
+        delta.sums.resize(view.sumFields.size(), Value(0));
+        delta.count += subtract ? -1 : 1;
+        for (size_t i = 0; i < view.sumFields.size(); ++i) {
+            Value value(contribution[str::stream() << "v" << i]);
+            if (!value.numeric()) {
+                continue;
+            }
+            delta.sums[i] = subtract ? ExpressionSubtract::apply(delta.sums[i], value)
+                                     : ExpressionAdd::apply(delta.sums[i], value);
+        }
+    };
+
+    std::vector<BSONObj> pipeline{matchIds(begin, end)};
+    pipeline.insert(pipeline.end(), view.prefix.begin(), view.prefix.end());
+    pipeline.push_back(view.contributionProjection);
+    auto newContributions = runAggregate(client, view.sourceNss, pipeline, view.collation);
+    auto oldContributions =
+        runAggregate(client, view.contributionsNss, {matchIds(begin, end)}, view.collation);
+
+    std::vector<BSONObj> contributionUpserts;
+    auto produced = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    for (auto&& contribution : oldContributions) {
+        addContribution(contribution, true);
+    }
+    for (auto&& contribution : newContributions) {
+        addContribution(contribution, false);
+        auto id = contribution["_id"].wrap();
+        contributionUpserts.push_back(upsertOp(id, contribution));
+        produced.insert(id);
+    }
+
+    std::vector<BSONObj> contributionDeletes;
+    for (auto it = begin; it != end; ++it) {
+        if (!produced.count(*it)) {
+            contributionDeletes.push_back(deleteOp(*it));
+        }
+    }
+
+    std::vector<BSONObj> groupUpserts;
+    std::vector<BSONObj> groupDeletes;
+    for (auto&& keyAndDelta : deltas) {
+        BSONObjBuilder inc;
+        for (size_t i = 0; i < view.sumFields.size(); ++i) {
+            keyAndDelta.second.sums[i].addToBsonObj(&inc, view.sumFields[i]);
+        }
+        inc.append(ViewDefinition::kMaterializedCountField, keyAndDelta.second.count);
+        groupUpserts.push_back(upsertOp(keyAndDelta.first, BSON("$inc" << inc.obj())));
+        if (keyAndDelta.second.count < 0) {
+            groupDeletes.push_back(deleteOp(BSON(
+                "_id" << keyAndDelta.first.firstElement() << ViewDefinition::kMaterializedCountField
+                      << BSON("$lte" << 0))));
+        }
+    }
+
+    runWrites(client, view.materializedNss, "update", "updates", groupUpserts);
+    runWrites(client, view.materializedNss, "delete", "deletes", groupDeletes);
+    runWrites(client, view.contributionsNss, "update", "updates", contributionUpserts);
+    runWrites(client, view.contributionsNss, "delete", "deletes", contributionDeletes);
+}
+
+void incrementalRefresh(DBDirectClient* client,
+                        const MaterializedView& view,
+                        const std::vector<BSONObj>& ids) {
+    for (auto begin = ids.begin(); begin != ids.end();) {
+        auto end = ids.end() - begin > static_cast<std::ptrdiff_t>(kIdsPerBatch)
+            ? begin + kIdsPerBatch
+            : ids.end();
+        if (view.mode == MaintenanceMode::kGroup) {
+            refreshGroup(client, view, begin, end);
+        } else {
+            refreshPerDocument(client, view, begin, end);
+        }
+        begin = end;
+    }
+}
+
+class MaterializedViewRefresher : public BackgroundJob {
+public:
+    std::string name() const override {
+        return "MaterializedViewRefresher";
+    }
+
+    void run() override {
+        Client::initThread(name().c_str());
+        ON_BLOCK_EXIT([] { Client::destroy(); });
+        AuthorizationSession::get(cc())->grantInternalAuthorization();
+
+        while (!globalInShutdownDeprecated()) {
+            {
+                MONGO_IDLE_THREAD_BLOCK;
+                sleepsecs(materializedViewRefreshIntervalSecs.load());
+            }
+
+            if (!materializedViewRefresherEnabled.load() || lockedForWriting()) {
+                continue;
+            }
+
+            try {
+                doRefreshPass();
+            } catch (const DBException& ex) {
+                LOG(1) << "materialized view refresh pass failed: " << redact(ex);
+            }
+        }
+    }
+
+private:
+    /**
+     * What the refresher remembers about a view from one pass to the next.
+     */
+    struct KnownView {
+        BSONObj fingerprint;
+        bool needsFullRefresh = true;
+    };
+
+    void doRefreshPass() {
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext* opCtx = opCtxPtr.get();
+        auto& registry = MaterializedViewRegistry::get(opCtx->getServiceContext());
+
+        // Only the primary maintains the views. The writes it makes to the backing collections
+        // replicate like any other. A node which becomes primary starts by rebuilding every view.
+        auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+        if (replCoord->getReplicationMode() == repl::ReplicationCoordinator::modeReplSet &&
+            !replCoord->getMemberState().primary()) {
+            registry.clear();
+            _knownViews.clear();
+            return;
+        }
+
+        materializedViewPasses.increment();
+
+        std::set<NamespaceString> viewNames;
+        std::vector<MaterializedView> views = _findViews(opCtx, &viewNames);
+
+        // Start tracking changes to the sources before computing any results, so that no change
+        // made after a view's results are read can be missed.
+        std::vector<NamespaceString> sources;
+        for (auto&& view : views) {
+            sources.push_back(view.sourceNss);
+            sources.insert(sources.end(), view.involvedNss.begin(), view.involvedNss.end());
+        }
+        registry.setSources(sources);
+
+        DBDirectClient client(opCtx);
+        _forgetDroppedViews(&client, viewNames);
+
+        std::map<NamespaceString, MaterializedViewRegistry::PendingChanges> changes;
+        for (auto&& nss : sources) {
+            if (!changes.count(nss)) {
+                changes[nss] = registry.takeChanges(nss);
+            }
+        }
+
+        for (auto&& view : views) {
+            auto& known = _knownViews[view.name];
+            if (known.fingerprint.woCompare(view.fingerprint) != 0) {
+                known.fingerprint = view.fingerprint;
+                known.needsFullRefresh = true;
+            }
+
+            const auto& sourceChanges = changes[view.sourceNss];
+            bool needsFullRefresh = known.needsFullRefresh || sourceChanges.needsFullRefresh ||
+                (view.mode == MaintenanceMode::kFullRefresh && !sourceChanges.ids.empty());
+            for (auto&& nss : view.involvedNss) {
+                needsFullRefresh |= changes[nss].needsFullRefresh || !changes[nss].ids.empty();
+            }
+            if (!needsFullRefresh && sourceChanges.ids.empty()) {
+                continue;
+            }
+
+            try {
+                if (needsFullRefresh) {
+                    LOG(1) << "rebuilding materialized view " << view.name;
+                    fullRefresh(&client, view);
+                    materializedViewFullRefreshes.increment();
+                } else {
+                    incrementalRefresh(&client,
+                                       view,
+                                       std::vector<BSONObj>(sourceChanges.ids.begin(),
+                                                            sourceChanges.ids.end()));
+                    materializedViewIncrementalRefreshes.increment();
+                }
+                known.needsFullRefresh = false;
+            } catch (const DBException& ex) {
+                // The backing collections may now be partially updated, so start over from the
+                // source on the next pass.
+                warning() << "failed to refresh materialized view " << view.name << ": "
+                          << redact(ex);
+                known.needsFullRefresh = true;
+            }
+        }
+    }
+
+    /**
+     * Returns the materialized views of every database which can be maintained, and fills in
+     * 'viewNames' with the names of all of them.
+     */
+    std::vector<MaterializedView> _findViews(OperationContext* opCtx,
+                                             std::set<NamespaceString>* viewNames) {
+        std::vector<std::string> dbNames;
+        opCtx->getServiceContext()->getStorageEngine()->listDatabases(&dbNames);
+
+        std::vector<MaterializedView> views;
+        for (auto&& dbName : dbNames) {
+            if (dbName == NamespaceString::kLocalDb) {
+                continue;
+            }
+
+            AutoGetDb autoDb(opCtx, dbName, MODE_IS);
+            Database* db = autoDb.getDb();
+            if (!db) {
+                continue;
+            }
+
+            auto viewCatalog = db->getViewCatalog();
+            std::vector<ViewDefinition> viewDefs;
+            viewCatalog->iterate(opCtx, [&](const ViewDefinition& viewDef) {
+                if (viewDef.isMaterialized()) {
+                    viewDefs.push_back(viewDef);
+                    viewNames->insert(viewDef.name());
+                }
+            });
+            for (auto&& viewDef : viewDefs) {
+                try {
+                    views.push_back(resolve(opCtx, viewCatalog, viewDef));
+                } catch (const DBException& ex) {
+                    warning() << "cannot maintain materialized view " << viewDef.name() << ": "
+                              << redact(ex);
+                }
+            }
+        }
+        return views;
+    }
+
+    /**
+     * Drops what is left of the backing collections of the views which no longer exist.
+     */
+    void _forgetDroppedViews(DBDirectClient* client, const std::set<NamespaceString>& viewNames) {
+        for (auto it = _knownViews.begin(); it != _knownViews.end();) {
+            if (viewNames.count(it->first)) {
+                ++it;
+                continue;
+            }
+            ViewDefinition dropped(it->first.db(), it->first.coll(), "", BSONArray(), nullptr);
+            client->dropCollection(dropped.materializedNss().ns());
+            client->dropCollection(dropped.materializedContributionsNss().ns());
+            it = _knownViews.erase(it);
+        }
+    }
+
+    std::map<NamespaceString, KnownView> _knownViews;
+};
+
+MaterializedViewRefresher* materializedViewRefresher;
+
+}  // namespace
+
+void startMaterializedViewRefresher() {
+    materializedViewRefresher = new MaterializedViewRefresher();
+    materializedViewRefresher->go();
+}
+
+}  // namespace mongo
@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/views/materialized_view_registry.h"
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+
+namespace {
+const auto getMaterializedViewRegistry =
+    ServiceContext::declareDecoration<MaterializedViewRegistry>();
+
+MONGO_EXPORT_SERVER_PARAMETER(materializedViewMaxPendingChanges, int, 100000)
+    ->withValidator([](const int& newVal) {
+        if (newVal <= 0)
+            return Status(ErrorCodes::BadValue,
+                          "materializedViewMaxPendingChanges must be strictly positive");
+        return Status::OK();
+    });
+}  // namespace
+
+MaterializedViewRegistry::PendingChanges::PendingChanges()
+    : ids(SimpleBSONObjComparator::kInstance.makeBSONObjSet()) {}
+
+MaterializedViewRegistry& MaterializedViewRegistry::get(ServiceContext* serviceContext) {
+    return getMaterializedViewRegistry(serviceContext);
+}
+
+void MaterializedViewRegistry::setSources(const std::vector<NamespaceString>& sources) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    std::map<NamespaceString, PendingChanges> newSources;
+    for (auto&& nss : sources) {
+        auto it = _sources.find(nss);
+        newSources[nss] = it == _sources.end() ? PendingChanges() : std::move(it->second);
+    }
+    _sources = std::move(newSources);
+    _numSources.store(_sources.size());
+}
+
+void MaterializedViewRegistry::clear() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _sources.clear();
+    _numSources.store(0);
+}
+
+bool MaterializedViewRegistry::isTracked(const NamespaceString& nss) const {
+    if (_numSources.load() == 0) {
+        return false;
+    }
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _sources.count(nss) > 0;
+}
+
+void MaterializedViewRegistry::recordChanges(const NamespaceString& nss,
+                                             const std::vector<BSONObj>& ids) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _sources.find(nss);
+    if (it == _sources.end() || it->second.needsFullRefresh) {
+        return;
+    }
+
+    auto& pending = it->second;
+    for (auto&& id : ids) {
+        pending.ids.insert(id.getOwned());
+    }
+    if (pending.ids.size() > static_cast<size_t>(materializedViewMaxPendingChanges.load())) {
+        pending.ids.clear();
+        pending.needsFullRefresh = true;
+    }
+}
+
+void MaterializedViewRegistry::markForFullRefresh(const NamespaceString& nss) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _sources.find(nss);
+    if (it != _sources.end()) {
+        it->second.ids.clear();
+        it->second.needsFullRefresh = true;
+    }
+}
+
+void MaterializedViewRegistry::markDatabaseForFullRefresh(StringData dbName) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    for (auto&& source : _sources) {
+        if (source.first.db() == dbName) {
+            source.second.ids.clear();
+            source.second.needsFullRefresh = true;
+        }
+    }
+}
+
+MaterializedViewRegistry::PendingChanges MaterializedViewRegistry::takeChanges(
+    const NamespaceString& nss) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _sources.find(nss);
+    if (it == _sources.end()) {
+        return {};
+    }
+    PendingChanges changes = std::move(it->second);
+    it->second = PendingChanges();
+    return changes;
+}
+
+}  // namespace mongo
@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobj_comparator_interface.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * Tracks which documents of the collections that have materialized views defined on them changed
+ * since the views were last brought up to date. Writes record the _id of each document they touch
+ * as they commit, and the materialized view refresher consumes these changes to update only the
+ * affected parts of the views. Changes to collections which are not tracked are ignored.
+ *
+ * This class is thread safe.
+ */
+class MaterializedViewRegistry {
+public:
+    /**
+     * The changes to a source collection which have not yet been applied to its views.
+     */
+    struct PendingChanges {
+        PendingChanges();
+
+        // The _id of each document which was inserted, updated or deleted, in the form {_id: <v>}.
+        BSONObjSet ids;
+
+        // Set when the changes could not be tracked one document at a time, such as when the
+        // collection was dropped or too many documents changed, so the views must be rebuilt.
+        bool needsFullRefresh = false;
+    };
+
+    static MaterializedViewRegistry& get(ServiceContext* serviceContext);
+
+    /**
+     * Makes 'sources' the set of tracked collections. Pending changes are kept for the collections
+     * which were already tracked and discarded for those which no longer are.
+     */
+    void setSources(const std::vector<NamespaceString>& sources);
+
+    /**
+     * Stops tracking all collections, for example because this node is no longer primary.
+     */
+    void clear();
+
+    /**
+     * Returns true if changes to 'nss' should be recorded. This is cheap when no collection is
+     * tracked, so it can be called on every write.
+     */
+    bool isTracked(const NamespaceString& nss) const;
+
+    /**
+     * Records that the documents with the given _ids, each in the form {_id: <v>}, changed in
+     * 'nss'. Once more than 'materializedViewMaxPendingChanges' documents are pending, individual
+     * changes are no longer kept and the collection is marked as needing a full refresh instead.
+     */
+    void recordChanges(const NamespaceString& nss, const std::vector<BSONObj>& ids);
+
+    /**
+     * Marks 'nss' as needing a full refresh of its views.
+     */
+    void markForFullRefresh(const NamespaceString& nss);
+
+    /**
+     * Marks every tracked collection in 'dbName' as needing a full refresh of its views.
+     */
+    void markDatabaseForFullRefresh(StringData dbName);
+
+    /**
+     * Returns the changes pending for 'nss', which no longer are afterwards.
+     */
+    PendingChanges takeChanges(const NamespaceString& nss);
+
+private:
+    mutable stdx::mutex _mutex;
+    std::map<NamespaceString, PendingChanges> _sources;
+
+    // The number of entries in '_sources', readable without holding '_mutex'.
+    AtomicWord<long long> _numSources{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,122 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/views/materialized_view_registry.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kSourceNss("test.source");
+const NamespaceString kOtherNss("test.other");
+
+class MaterializedViewRegistryTest : public ServiceContextTest {
+public:
+    MaterializedViewRegistry& registry() {
+        return MaterializedViewRegistry::get(getServiceContext());
+    }
+};
+
+TEST_F(MaterializedViewRegistryTest, IgnoresChangesToUntrackedCollections) {
+    ASSERT_FALSE(registry().isTracked(kSourceNss));
+    registry().recordChanges(kSourceNss, {BSON("_id" << 1)});
+
+    registry().setSources({kSourceNss});
+    auto changes = registry().takeChanges(kSourceNss);
+    ASSERT_TRUE(changes.ids.empty());
+    ASSERT_FALSE(changes.needsFullRefresh);
+}
+
+TEST_F(MaterializedViewRegistryTest, RecordsEachChangedIdOnce) {
+    registry().setSources({kSourceNss});
+    ASSERT_TRUE(registry().isTracked(kSourceNss));
+    ASSERT_FALSE(registry().isTracked(kOtherNss));
+
+    registry().recordChanges(kSourceNss, {BSON("_id" << 1), BSON("_id" << 2)});
+    registry().recordChanges(kSourceNss, {BSON("_id" << 1)});
+
+    auto changes = registry().takeChanges(kSourceNss);
+    ASSERT_EQ(changes.ids.size(), 2U);
+    ASSERT_FALSE(changes.needsFullRefresh);
+
+    // Taking the changes clears them.
+    ASSERT_TRUE(registry().takeChanges(kSourceNss).ids.empty());
+}
+
+TEST_F(MaterializedViewRegistryTest, KeepsChangesOfSourcesWhichStayTracked) {
+    registry().setSources({kSourceNss, kOtherNss});
+    registry().recordChanges(kSourceNss, {BSON("_id" << 1)});
+    registry().recordChanges(kOtherNss, {BSON("_id" << 2)});
+
+    registry().setSources({kSourceNss});
+    ASSERT_FALSE(registry().isTracked(kOtherNss));
+    ASSERT_EQ(registry().takeChanges(kSourceNss).ids.size(), 1U);
+
+    registry().clear();
+    ASSERT_FALSE(registry().isTracked(kSourceNss));
+}
+
+TEST_F(MaterializedViewRegistryTest, FallsBackToFullRefreshWhenTooManyChangesArePending) {
+    auto param = ServerParameterSet::getGlobal()->getMap().find("materializedViewMaxPendingChanges");
+    ASSERT(param != ServerParameterSet::getGlobal()->getMap().end());
+    ASSERT_OK(param->second->setFromString("2"));
+    ON_BLOCK_EXIT([&] { ASSERT_OK(param->second->setFromString("100000")); });
+
+    registry().setSources({kSourceNss});
+    registry().recordChanges(kSourceNss, {BSON("_id" << 1), BSON("_id" << 2)});
+    registry().recordChanges(kSourceNss, {BSON("_id" << 3)});
+
+    auto changes = registry().takeChanges(kSourceNss);
+    ASSERT_TRUE(changes.ids.empty());
+    ASSERT_TRUE(changes.needsFullRefresh);
+}
+
+TEST_F(MaterializedViewRegistryTest, MarksCollectionsForFullRefresh) {
+    const NamespaceString otherDbNss("other.source");
+    registry().setSources({kSourceNss, kOtherNss, otherDbNss});
+    registry().recordChanges(kSourceNss, {BSON("_id" << 1)});
+
+    registry().markForFullRefresh(kOtherNss);
+    ASSERT_TRUE(registry().takeChanges(kOtherNss).needsFullRefresh);
+
+    registry().markDatabaseForFullRefresh("test");
+    auto changes = registry().takeChanges(kSourceNss);
+    ASSERT_TRUE(changes.ids.empty());
+    ASSERT_TRUE(changes.needsFullRefresh);
+    ASSERT_FALSE(registry().takeChanges(otherDbNss).needsFullRefresh);
+}
+
+}  // namespace
+}  // namespace mongo
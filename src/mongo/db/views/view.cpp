@@ -36,12 +36,18 @@
 
 namespace mongo {
 
+constexpr StringData ViewDefinition::kMaterializedCountField;
+
 ViewDefinition::ViewDefinition(StringData dbName,
                                StringData viewName,
                                StringData viewOnName,
                                const BSONObj& pipeline,
-                               std::unique_ptr<CollatorInterface> collator)
-    : _viewNss(dbName, viewName), _viewOnNss(dbName, viewOnName), _collator(std::move(collator)) {
+                               std::unique_ptr<CollatorInterface> collator,
+                               bool materialized)
+    : _viewNss(dbName, viewName),
+      _viewOnNss(dbName, viewOnName),
+      _collator(std::move(collator)),
+      _materialized(materialized) {
     for (BSONElement e : pipeline) {
         _pipeline.push_back(e.Obj().getOwned());
     }
@@ -51,17 +57,28 @@ ViewDefinition::ViewDefinition(const ViewDefinition& other)
     : _viewNss(other._viewNss),
       _viewOnNss(other._viewOnNss),
       _collator(CollatorInterface::cloneCollator(other._collator.get())),
-      _pipeline(other._pipeline) {}
+      _pipeline(other._pipeline),
+      _materialized(other._materialized) {}
 
 ViewDefinition& ViewDefinition::operator=(const ViewDefinition& other) {
     _viewNss = other._viewNss;
     _viewOnNss = other._viewOnNss;
     _collator = CollatorInterface::cloneCollator(other._collator.get());
     _pipeline = other._pipeline;
+    _materialized = other._materialized;
 
     return *this;
 }
 
+NamespaceString ViewDefinition::materializedNss() const {
+    return NamespaceString(_viewNss.db(), _viewNss.coll().toString() + ".materialized");
+}
+
+NamespaceString ViewDefinition::materializedContributionsNss() const {
+    return NamespaceString(_viewNss.db(),
+                           _viewNss.coll().toString() + ".materialized.contributions");
+}
+
 void ViewDefinition::setViewOn(const NamespaceString& viewOnNss) {
     invariant(_viewNss.db() == viewOnNss.db());
     _viewOnNss = viewOnNss;
@@ -43,15 +43,23 @@ namespace mongo {
  */
 class ViewDefinition {
 public:
+    /**
+     * Name of a field which the server adds to the documents in the backing collection of some
+     * materialized views for its own bookkeeping. It is never returned by reads on the view.
+     */
+    static constexpr StringData kMaterializedCountField = "__materializedCount"_sd;
+
     /**
      * In the database 'dbName', create a new view 'viewName' on the view or collection
      * 'viewOnName'. Neither 'viewName' nor 'viewOnName' should include the name of the database.
+     * If 'materialized' is true, the results of the view are stored in a backing collection.
      */
     ViewDefinition(StringData dbName,
                    StringData viewName,
                    StringData viewOnName,
                    const BSONObj& pipeline,
-                   std::unique_ptr<CollatorInterface> collation);
+                   std::unique_ptr<CollatorInterface> collation,
+                   bool materialized = false);
 
     /**
      * Copying a view 'other' clones its collator and does a simple copy of all other fields.
@@ -89,6 +97,25 @@ public:
         return _collator.get();
     }
 
+    /**
+     * Returns true if the results of this view are stored in a backing collection which is kept up
+     * to date in the background, rather than computed on each read.
+     */
+    bool isMaterialized() const {
+        return _materialized;
+    }
+
+    /**
+     * Returns the namespace of the collection which holds the results of a materialized view.
+     */
+    NamespaceString materializedNss() const;
+
+    /**
+     * Returns the namespace of the collection which holds the per-document state needed to
+     * maintain a materialized view that ends in a $group.
+     */
+    NamespaceString materializedContributionsNss() const;
+
     void setViewOn(const NamespaceString& viewOnNss);
 
     /**
@@ -101,5 +128,6 @@ private:
     NamespaceString _viewOnNss;
     std::unique_ptr<CollatorInterface> _collator;
     std::vector<BSONObj> _pipeline;
+    bool _materialized = false;
 };
 }  // namespace mongo
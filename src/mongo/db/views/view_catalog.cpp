@@ -84,6 +84,7 @@ Status ViewCatalog::_reloadIfNeeded_inlock(OperationContext* opCtx) {
 
     // Need to reload, first clear our cache.
     _viewMap.clear();
+    _resolvedViewCache.clear();
 
     Status status = _durable->iterate(opCtx, [&](const BSONObj& view) -> Status {
         BSONObj collationSpec = view.hasField("collation") ? view["collation"].Obj() : BSONObj();
@@ -105,11 +106,13 @@ Status ViewCatalog::_reloadIfNeeded_inlock(OperationContext* opCtx) {
             }
         }
 
-        _viewMap[viewName.ns()] = std::make_shared<ViewDefinition>(viewName.db(),
-                                                                   viewName.coll(),
-                                                                   view["viewOn"].str(),
-                                                                   pipeline,
-                                                                   std::move(collator.getValue()));
+        _viewMap[viewName.ns()] =
+            std::make_shared<ViewDefinition>(viewName.db(),
+                                             viewName.coll(),
+                                             view["viewOn"].str(),
+                                             pipeline,
+                                             std::move(collator.getValue()),
+                                             view["materialized"].trueValue());
         return Status::OK();
     });
     _valid.store(status.isOK());
@@ -134,7 +137,8 @@ Status ViewCatalog::_createOrUpdateView_inlock(OperationContext* opCtx,
                                                const NamespaceString& viewName,
                                                const NamespaceString& viewOn,
                                                const BSONArray& pipeline,
-                                               std::unique_ptr<CollatorInterface> collator) {
+                                               std::unique_ptr<CollatorInterface> collator,
+                                               bool materialized) {
     _requireValidCatalog_inlock(opCtx);
 
     // Build the BSON definition for this view to be saved in the durable view catalog. If the
@@ -146,10 +150,17 @@ Status ViewCatalog::_createOrUpdateView_inlock(OperationContext* opCtx,
     if (collator) {
         viewDefBuilder.append("collation", collator->getSpec().toBSON());
     }
+    if (materialized) {
+        viewDefBuilder.append("materialized", true);
+    }
 
     BSONObj ownedPipeline = pipeline.getOwned();
-    auto view = std::make_shared<ViewDefinition>(
-        viewName.db(), viewName.coll(), viewOn.coll(), ownedPipeline, std::move(collator));
+    auto view = std::make_shared<ViewDefinition>(viewName.db(),
+                                                 viewName.coll(),
+                                                 viewOn.coll(),
+                                                 ownedPipeline,
+                                                 std::move(collator),
+                                                 materialized);
 
     // Check that the resulting dependency graph is acyclic and within the maximum depth.
     Status graphStatus = _upsertIntoGraph(opCtx, *(view.get()));
@@ -313,7 +324,8 @@ Status ViewCatalog::createView(OperationContext* opCtx,
                                const NamespaceString& viewName,
                                const NamespaceString& viewOn,
                                const BSONArray& pipeline,
-                               const BSONObj& collation) {
+                               const BSONObj& collation,
+                               bool materialized) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
 
     if (viewName.db() != viewOn.db())
@@ -332,12 +344,20 @@ Status ViewCatalog::createView(OperationContext* opCtx,
             ErrorCodes::InvalidNamespace,
             "View name cannot start with 'system.', which is reserved for system namespaces");
 
+    // Materialized views are maintained by the server and their backing collections must keep
+    // working on binaries which know about them, so only create them once the FCV is 4.2.
+    if (materialized && serverGlobalParams.validateFeaturesAsMaster.load() &&
+        serverGlobalParams.featureCompatibility.getVersion() !=
+            ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo42)
+        return Status(ErrorCodes::QueryFeatureNotAllowed,
+                      "Materialized views require feature compatibility version 4.2");
+
     auto collator = parseCollator(opCtx, collation);
     if (!collator.isOK())
         return collator.getStatus();
 
     return _createOrUpdateView_inlock(
-        opCtx, viewName, viewOn, pipeline, std::move(collator.getValue()));
+        opCtx, viewName, viewOn, pipeline, std::move(collator.getValue()), materialized);
 }
 
 Status ViewCatalog::modifyView(OperationContext* opCtx,
@@ -369,7 +389,8 @@ Status ViewCatalog::modifyView(OperationContext* opCtx,
         viewName,
         viewOn,
         pipeline,
-        CollatorInterface::cloneCollator(savedDefinition.defaultCollator()));
+        CollatorInterface::cloneCollator(savedDefinition.defaultCollator()),
+        savedDefinition.isMaterialized());
 }
 
 Status ViewCatalog::dropView(OperationContext* opCtx, const NamespaceString& viewName) {
@@ -429,10 +450,38 @@ std::shared_ptr<ViewDefinition> ViewCatalog::lookup(OperationContext* opCtx, Str
     return _lookup_inlock(opCtx, ns);
 }
 
+boost::optional<ResolvedView> ViewCatalog::_lookupResolvedView_inlock(
+    const NamespaceString& nss) {
+    auto it = _resolvedViewCache.find(nss.ns());
+    if (it == _resolvedViewCache.end()) {
+        return boost::none;
+    }
+
+    const auto& cached = it->second;
+    for (auto&& view : cached.views) {
+        auto current = _viewMap.find(view->name().ns());
+        if (current == _viewMap.end() || current->second != view) {
+            _resolvedViewCache.erase(it);
+            return boost::none;
+        }
+    }
+    if (cached.endsAtNonView && _viewMap.count(cached.resolvedView->getNamespace().ns())) {
+        _resolvedViewCache.erase(it);
+        return boost::none;
+    }
+    return cached.resolvedView;
+}
+
 StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
                                                   const NamespaceString& nss) {
     stdx::unique_lock<stdx::mutex> lock(_mutex);
 
+    if (_valid.load() && !MONGO_FAIL_POINT(hangDuringViewResolution)) {
+        if (auto cached = _lookupResolvedView_inlock(nss)) {
+            return std::move(*cached);
+        }
+    }
+
     // Keep looping until the resolution completes. If the catalog is invalidated during the
     // resolution, we start over from the beginning.
     while (true) {
@@ -446,9 +495,20 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
         // the same collation. As an optimization, we fill out the collation spec only once.
         boost::optional<BSONObj> collation;
 
-        // The last seen view definition, which owns the NamespaceString pointed to by
+        // The views seen so far, the last of which owns the NamespaceString pointed to by
         // 'resolvedNss'.
-        std::shared_ptr<ViewDefinition> lastViewDefinition;
+        std::vector<std::shared_ptr<ViewDefinition>> walkedViews;
+
+        // Remembers a successful resolution so that later reads of the view can skip the walk.
+        auto cacheAndReturn = [&](ResolvedView resolvedView, bool endsAtNonView) {
+            if (!walkedViews.empty()) {
+                auto& cached = _resolvedViewCache[nss.ns()];
+                cached.views = std::move(walkedViews);
+                cached.endsAtNonView = endsAtNonView;
+                cached.resolvedView = resolvedView;
+            }
+            return StatusWith<ResolvedView>(std::move(resolvedView));
+        };
 
         int depth = 0;
         for (; depth < ViewGraph::kMaxViewDepth; depth++) {
@@ -477,24 +537,39 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
                             str::stream() << "View pipeline exceeds maximum size; maximum size is "
                                           << ViewGraph::kMaxViewPipelineSizeBytes};
                 }
-                return StatusWith<ResolvedView>(
-                    {*resolvedNss, std::move(resolvedPipeline), std::move(collation.get())});
+                return cacheAndReturn(
+                    {*resolvedNss, std::move(resolvedPipeline), std::move(collation.get())},
+                    true);
             }
 
+            walkedViews.push_back(view);
             resolvedNss = &view->viewOn();
             if (!collation) {
                 collation = view->defaultCollator() ? view->defaultCollator()->getSpec().toBSON()
                                                     : CollationSpec::kSimpleSpec;
             }
 
+            // The results of a materialized view are read from its backing collection, without
+            // the bookkeeping field the server may keep there.
+            if (view->isMaterialized()) {
+                resolvedPipeline.insert(
+                    resolvedPipeline.begin(),
+                    BSON("$project" << BSON(ViewDefinition::kMaterializedCountField << 0)));
+                return cacheAndReturn({view->materializedNss(),
+                                       std::move(resolvedPipeline),
+                                       std::move(collation.get())},
+                                      false);
+            }
+
             // Prepend the underlying view's pipeline to the current working pipeline.
             const std::vector<BSONObj>& toPrepend = view->pipeline();
             resolvedPipeline.insert(resolvedPipeline.begin(), toPrepend.begin(), toPrepend.end());
 
             // If the first stage is a $collStats, then we return early with the viewOn namespace.
             if (toPrepend.size() > 0 && !toPrepend[0]["$collStats"].eoo()) {
-                return StatusWith<ResolvedView>(
-                    {*resolvedNss, std::move(resolvedPipeline), std::move(collation.get())});
+                return cacheAndReturn(
+                    {*resolvedNss, std::move(resolvedPipeline), std::move(collation.get())},
+                    false);
             }
         }
 
@@ -34,6 +34,8 @@
 #include <tuple>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
 #include "mongo/base/string_data.h"
@@ -77,7 +79,8 @@ public:
      * 'pipeline' with collation 'collation' on a collection or view 'viewOn'. This method will
      * check correctness with respect to the view catalog, but will not check for conflicts with the
      * database's catalog, so the check for an existing collection with the same name must be done
-     * before calling createView.
+     * before calling createView. If 'materialized' is true, reads on the view are served from a
+     * backing collection which is kept up to date in the background.
      *
      * Must be in WriteUnitOfWork. View creation rolls back if the unit of work aborts.
      */
@@ -85,7 +88,8 @@ public:
                       const NamespaceString& viewName,
                       const NamespaceString& viewOn,
                       const BSONArray& pipeline,
-                      const BSONObj& collation);
+                      const BSONObj& collation,
+                      bool materialized = false);
 
     /**
      * Drop the view named 'viewName'.
@@ -113,7 +117,11 @@ public:
     /**
      * Resolve the views on 'nss', transforming the pipeline appropriately. This function returns a
      * fully-resolved view definition containing the backing namespace, the resolved pipeline and
-     * the collation to use for the operation.
+     * the collation to use for the operation. Resolution stops at the first materialized view,
+     * whose results are read from its backing collection.
+     *
+     * Resolutions are cached, and a cached one is reused for as long as every view it walked
+     * still has the same definition.
      */
     StatusWith<ResolvedView> resolveView(OperationContext* opCtx, const NamespaceString& nss);
 
@@ -140,7 +148,8 @@ private:
                                       const NamespaceString& viewName,
                                       const NamespaceString& viewOn,
                                       const BSONArray& pipeline,
-                                      std::unique_ptr<CollatorInterface> collator);
+                                      std::unique_ptr<CollatorInterface> collator,
+                                      bool materialized);
     /**
      * Parses the view definition pipeline, attempts to upsert into the view graph, and refreshes
      * the graph if necessary. Returns an error status if the resulting graph would be invalid.
@@ -163,6 +172,13 @@ private:
                                      const std::vector<NamespaceString>& refs);
 
     std::shared_ptr<ViewDefinition> _lookup_inlock(OperationContext* opCtx, StringData ns);
+
+    /**
+     * Returns the cached resolution of the view 'nss' if the definitions it was resolved from
+     * are all still current, and otherwise drops it from the cache. The catalog must be valid.
+     */
+    boost::optional<ResolvedView> _lookupResolvedView_inlock(const NamespaceString& nss);
+
     Status _reloadIfNeeded_inlock(OperationContext* opCtx);
 
     void _requireValidCatalog_inlock(OperationContext* opCtx) {
@@ -176,5 +192,18 @@ private:
     AtomicBool _valid;
     ViewGraph _viewGraph;
     bool _viewGraphNeedsRefresh = true;  // Defers initializing the graph until the first insert.
+
+    struct CachedResolvedView {
+        // The views walked by the resolution. A ViewDefinition is never changed in place, so the
+        // cached resolution is current while the catalog still holds these very definitions.
+        std::vector<std::shared_ptr<ViewDefinition>> views;
+
+        // Whether the resolution ended at a namespace that was not a view, and would walk further
+        // should a view of that name be created.
+        bool endsAtNonView = false;
+
+        boost::optional<ResolvedView> resolvedView;
+    };
+    StringMap<CachedResolvedView> _resolvedViewCache;
 };
 }  // namespace mongo
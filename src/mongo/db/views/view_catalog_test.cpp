@@ -561,6 +561,71 @@ TEST_F(ViewCatalogFixture, ResolveViewCorrectlyExtractsDefaultCollation) {
                       expectedCollation.getValue()->getSpec().toBSON());
 }
 
+TEST_F(ViewCatalogFixture, ResolveViewReflectsModificationOfUnderlyingView) {
+    const NamespaceString view1("db.view1");
+    const NamespaceString view2("db.view2");
+    const NamespaceString viewOn("db.coll");
+    const NamespaceString otherViewOn("db.otherColl");
+
+    ASSERT_OK(viewCatalog.createView(opCtx.get(),
+                                     view1,
+                                     viewOn,
+                                     BSON_ARRAY(BSON("$match" << BSON("foo" << 1))),
+                                     emptyCollation));
+    ASSERT_OK(viewCatalog.createView(opCtx.get(),
+                                     view2,
+                                     view1,
+                                     BSON_ARRAY(BSON("$match" << BSON("foo" << 2))),
+                                     emptyCollation));
+
+    // Resolving twice returns the same result, the second time from the cache.
+    for (int i = 0; i < 2; ++i) {
+        auto resolvedView = viewCatalog.resolveView(opCtx.get(), view2);
+        ASSERT_OK(resolvedView.getStatus());
+        ASSERT_EQ(viewOn, resolvedView.getValue().getNamespace());
+        ASSERT_EQ(2U, resolvedView.getValue().getPipeline().size());
+    }
+
+    ASSERT_OK(viewCatalog.modifyView(
+        opCtx.get(), view1, otherViewOn, BSON_ARRAY(BSON("$match" << BSON("foo" << 3)))));
+
+    auto resolvedView = viewCatalog.resolveView(opCtx.get(), view2);
+    ASSERT_OK(resolvedView.getStatus());
+    ASSERT_EQ(otherViewOn, resolvedView.getValue().getNamespace());
+    std::vector<BSONObj> expected = {BSON("$match" << BSON("foo" << 3)),
+                                     BSON("$match" << BSON("foo" << 2))};
+    std::vector<BSONObj> result = resolvedView.getValue().getPipeline();
+    ASSERT_EQ(expected.size(), result.size());
+    for (uint32_t i = 0; i < expected.size(); i++) {
+        ASSERT(SimpleBSONObjComparator::kInstance.evaluate(expected[i] == result[i]));
+    }
+}
+
+TEST_F(ViewCatalogFixture, ResolveViewWalksIntoViewCreatedOnResolvedNamespace) {
+    const NamespaceString view1("db.view1");
+    const NamespaceString view2("db.view2");
+    const NamespaceString viewOn("db.coll");
+
+    ASSERT_OK(viewCatalog.createView(opCtx.get(),
+                                     view2,
+                                     view1,
+                                     BSON_ARRAY(BSON("$match" << BSON("foo" << 2))),
+                                     emptyCollation));
+    auto resolvedView = viewCatalog.resolveView(opCtx.get(), view2);
+    ASSERT_OK(resolvedView.getStatus());
+    ASSERT_EQ(view1, resolvedView.getValue().getNamespace());
+
+    ASSERT_OK(viewCatalog.createView(opCtx.get(),
+                                     view1,
+                                     viewOn,
+                                     BSON_ARRAY(BSON("$match" << BSON("foo" << 1))),
+                                     emptyCollation));
+    resolvedView = viewCatalog.resolveView(opCtx.get(), view2);
+    ASSERT_OK(resolvedView.getStatus());
+    ASSERT_EQ(viewOn, resolvedView.getValue().getNamespace());
+    ASSERT_EQ(2U, resolvedView.getValue().getPipeline().size());
+}
+
 TEST_F(ViewCatalogFixture, InvalidateThenReload) {
     const NamespaceString viewName("db.view");
     const NamespaceString viewOn("db.coll");
@@ -46,6 +46,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/mock_yield_policies.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/stage_builder.h"
 #include "mongo/dbtests/dbtests.h"
@@ -248,6 +249,53 @@ TEST_F(DocumentSourceCursorTest, LimitCoalesce) {
     ASSERT(source()->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceCursorTest, ReadAheadReturnsEveryDocumentInOrder) {
+    const auto originalBatchSizeBytes = internalDocumentSourceCursorBatchSizeBytes.load();
+    ON_BLOCK_EXIT(
+        [&] { internalDocumentSourceCursorBatchSizeBytes.store(originalBatchSizeBytes); });
+    // Each batch holds a single document.
+    internalDocumentSourceCursorBatchSizeBytes.store(1);
+
+    for (int i = 0; i < 10; ++i) {
+        client.insert(nss.ns(), BSON("a" << i));
+    }
+    createSource(BSON("$natural" << 1));
+    source()->enableReadAhead();
+
+    for (int i = 0; i < 10; ++i) {
+        auto next = source()->getNext();
+        ASSERT(next.isAdvanced());
+        ASSERT_VALUE_EQ(Value(i), next.getDocument().getField("a"));
+    }
+    ASSERT(source()->getNext().isEOF());
+
+    // The OperationContext has been handed back, and no locks are held.
+    ASSERT_FALSE(ctx()->opCtxLent);
+    ASSERT(!opCtx()->lockState()->isReadLocked());
+}
+
+TEST_F(DocumentSourceCursorTest, DisposeWaitsForReadAhead) {
+    const auto originalBatchSizeBytes = internalDocumentSourceCursorBatchSizeBytes.load();
+    ON_BLOCK_EXIT(
+        [&] { internalDocumentSourceCursorBatchSizeBytes.store(originalBatchSizeBytes); });
+    internalDocumentSourceCursorBatchSizeBytes.store(1);
+
+    client.insert(nss.ns(), BSON("a" << 1));
+    client.insert(nss.ns(), BSON("a" << 2));
+    client.insert(nss.ns(), BSON("a" << 3));
+    createSource(BSON("$natural" << 1));
+    source()->enableReadAhead();
+
+    // Returning the first batch starts loading the second one.
+    ASSERT(source()->getNext().isAdvanced());
+    ASSERT(ctx()->opCtxLent);
+
+    source()->dispose();
+    ASSERT_FALSE(ctx()->opCtxLent);
+    ASSERT(!opCtx()->lockState()->isReadLocked());
+    ASSERT(source()->getNext().isEOF());
+}
+
 //
 // Test cursor output sort.
 //
@@ -35,6 +35,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/multi_index_block.h"
+#include "mongo/db/catalog/multi_index_block_impl.h"
 #include "mongo/db/client.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
@@ -42,6 +43,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/storage_engine_init.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/util/scopeguard.h"
 
 namespace IndexUpdateTests {
 
@@ -247,6 +249,133 @@ public:
     }
 };
 
+/** A foreground build of several indexes can generate each index's keys on its own thread. */
+class InsertBuildMultipleIndexesConcurrently : public IndexBuildBase {
+public:
+    void run() {
+        const int oldThreads = internalIndexBuildKeyGenerationThreads;
+        ON_BLOCK_EXIT([&] { internalIndexBuildKeyGenerationThreads = oldThreads; });
+        internalIndexBuildKeyGenerationThreads = 2;
+
+        Database* db = _ctx.db();
+        Collection* coll;
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            db->dropCollection(&_opCtx, _ns).transitional_ignore();
+            coll = db->createCollection(&_opCtx, _ns);
+            // Enough documents that the pending queue is flushed several times.
+            OpDebug* const nullOpDebug = nullptr;
+            for (int32_t i = 0; i < kNumDocs; ++i) {
+                const BSONObj doc =
+                    BSON("_id" << i << "a" << i << "b" << -i << "c" << BSON_ARRAY(i << i + 1));
+                coll->insertDocument(&_opCtx, InsertStatement(doc), nullOpDebug)
+                    .transitional_ignore();
+            }
+            wunit.commit();
+        }
+
+        {
+            auto indexerPtr = coll->createMultiIndexBlock(&_opCtx);
+            MultiIndexBlock& indexer(*indexerPtr);
+            const std::vector<BSONObj> specs{makeSpec("a"), makeSpec("b"), makeSpec("c")};
+            ASSERT_OK(indexer.init(specs).getStatus());
+            ASSERT_OK(indexer.insertAllDocumentsInCollection());
+            WriteUnitOfWork wunit(&_opCtx);
+            indexer.commit();
+            wunit.commit();
+        }
+
+        BSONObj result;
+        ASSERT(_client.runCommand("unittests", BSON("validate" << _ns << "full" << true), result));
+        ASSERT(result["valid"].trueValue()) << result;
+        const BSONObj keysPerIndex = result["keysPerIndex"].Obj();
+        const std::string indexNsPrefix = std::string(_ns) + ".$";
+        ASSERT_EQ(keysPerIndex[indexNsPrefix + "a_1"].numberLong(), kNumDocs) << result;
+        ASSERT_EQ(keysPerIndex[indexNsPrefix + "b_1"].numberLong(), kNumDocs) << result;
+        ASSERT_EQ(keysPerIndex[indexNsPrefix + "c_1"].numberLong(), 2 * kNumDocs) << result;
+        ASSERT(coll->getIndexCatalog()->findIndexByName(&_opCtx, "c_1")->isMultikey(&_opCtx));
+
+        // Key generation errors raised on the worker threads fail the build.
+        _client.insert(_ns, BSON("_id" << kNumDocs << "a" << BSON_ARRAY(1 << 2) << "b"
+                                      << BSON_ARRAY(1 << 2)));
+        auto indexerPtr = coll->createMultiIndexBlock(&_opCtx);
+        MultiIndexBlock& indexer(*indexerPtr);
+        const std::vector<BSONObj> specs{makeSpec("c", "_id"), makeSpec("a", "b")};
+        ASSERT_OK(indexer.init(specs).getStatus());
+        ASSERT_THROWS_CODE(indexer.insertAllDocumentsInCollection(),
+                           AssertionException,
+                           ErrorCodes::CannotIndexParallelArrays);
+    }
+
+private:
+    static const int32_t kNumDocs = 3000;
+
+    BSONObj makeSpec(const std::string& field, const std::string& secondField = "") {
+        BSONObjBuilder key;
+        key.append(field, 1);
+        if (!secondField.empty())
+            key.append(secondField, 1);
+        const std::string name = secondField.empty() ? field + "_1" : field + "_" + secondField;
+        return BSON("key" << key.obj() << "ns" << _ns << "name" << name << "v"
+                          << static_cast<int>(kIndexVersion));
+    }
+};
+
+/** A foreground build of a single text index generates its keys in document slices. */
+class InsertBuildTextIndexConcurrently : public IndexBuildBase {
+public:
+    void run() {
+        const int oldThreads = internalIndexBuildKeyGenerationThreads;
+        ON_BLOCK_EXIT([&] { internalIndexBuildKeyGenerationThreads = oldThreads; });
+        internalIndexBuildKeyGenerationThreads = 2;
+
+        Database* db = _ctx.db();
+        Collection* coll;
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            db->dropCollection(&_opCtx, _ns).transitional_ignore();
+            coll = db->createCollection(&_opCtx, _ns);
+            OpDebug* const nullOpDebug = nullptr;
+            for (int32_t i = 0; i < kNumDocs; ++i) {
+                // Each document has one term of its own and one term shared by every document.
+                const BSONObj doc =
+                    BSON("_id" << i << "t" << ("common word" + std::to_string(i)));
+                coll->insertDocument(&_opCtx, InsertStatement(doc), nullOpDebug)
+                    .transitional_ignore();
+            }
+            wunit.commit();
+        }
+
+        {
+            auto indexerPtr = coll->createMultiIndexBlock(&_opCtx);
+            MultiIndexBlock& indexer(*indexerPtr);
+            const BSONObj spec = BSON("key" << BSON("t"
+                                                    << "text")
+                                            << "ns"
+                                            << _ns
+                                            << "name"
+                                            << "t_text"
+                                            << "v"
+                                            << static_cast<int>(kIndexVersion));
+            ASSERT_OK(indexer.init(spec).getStatus());
+            ASSERT_OK(indexer.insertAllDocumentsInCollection());
+            WriteUnitOfWork wunit(&_opCtx);
+            indexer.commit();
+            wunit.commit();
+        }
+
+        BSONObj result;
+        ASSERT(_client.runCommand("unittests", BSON("validate" << _ns << "full" << true), result));
+        ASSERT(result["valid"].trueValue()) << result;
+        const BSONObj keysPerIndex = result["keysPerIndex"].Obj();
+        ASSERT_EQ(keysPerIndex[std::string(_ns) + ".$t_text"].numberLong(), 2 * kNumDocs)
+            << result;
+    }
+
+private:
+    static const int32_t kNumDocs = 3000;
+};
+
 /** Index creation is not killed if mayInterrupt is false. */
 class InsertBuildIndexInterruptDisallowed : public IndexBuildBase {
 public:
@@ -772,6 +901,8 @@ public:
         add<InsertBuildEnforceUnique<true>>();
         add<InsertBuildEnforceUnique<false>>();
         add<InsertBuildIndexInterrupt>();
+        add<InsertBuildMultipleIndexesConcurrently>();
+        add<InsertBuildTextIndexConcurrently>();
         add<InsertBuildIndexInterruptDisallowed>();
         add<InsertBuildIdIndexInterrupt>();
         add<InsertBuildIdIndexInterruptDisallowed>();
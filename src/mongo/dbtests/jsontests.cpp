@@ -781,6 +781,28 @@ class FancyNumber : public Base {
     }
 };
 
+class LargeIntegerNumber : public Base {
+    virtual BSONObj bson() const {
+        BSONObjBuilder b;
+        b.append("a", 9876543210LL);
+        return b.obj();
+    }
+    virtual string json() const {
+        return "{ \"a\" : 9876543210 }";
+    }
+};
+
+class UpperCaseExponentNumber : public Base {
+    virtual BSONObj bson() const {
+        BSONObjBuilder b;
+        b.append("a", 1000.0);
+        return b.obj();
+    }
+    virtual string json() const {
+        return "{ \"a\" : 1E3 }";
+    }
+};
+
 class TwoElements : public Base {
     virtual BSONObj bson() const {
         BSONObjBuilder b;
@@ -969,6 +991,17 @@ class NonEscapedCharacters : public Base {
     }
 };
 
+class LongStringWithEscapedCharacters : public Base {
+    virtual BSONObj bson() const {
+        BSONObjBuilder b;
+        b.append("a", "the first sixteen bytes \" then more \\ and the rest\n");
+        return b.obj();
+    }
+    virtual string json() const {
+        return "{ \"a\" : \"the first sixteen bytes \\\" then more \\\\ and the rest\\n\" }";
+    }
+};
+
 class AllowedControlCharacter : public Base {
     virtual BSONObj bson() const {
         BSONObjBuilder b;
@@ -986,6 +1019,12 @@ class InvalidControlCharacter : public Bad {
     }
 };
 
+class LateInvalidControlCharacter : public Bad {
+    virtual string json() const {
+        return "{ \"a\" : \"well past the first sixteen bytes \x1f\" }";
+    }
+};
+
 class NumbersInFieldName : public Base {
     virtual BSONObj bson() const {
         BSONObjBuilder b;
@@ -2753,6 +2792,8 @@ public:
         add<FromJsonTests::SingleNumber>();
         add<FromJsonTests::RealNumber>();
         add<FromJsonTests::FancyNumber>();
+        add<FromJsonTests::LargeIntegerNumber>();
+        add<FromJsonTests::UpperCaseExponentNumber>();
         add<FromJsonTests::TwoElements>();
         add<FromJsonTests::Subobject>();
         add<FromJsonTests::DeeplyNestedObject>();
@@ -2768,8 +2809,10 @@ public:
         add<FromJsonTests::UndefinedStrictBad>();
         add<FromJsonTests::EscapedCharacters>();
         add<FromJsonTests::NonEscapedCharacters>();
+        add<FromJsonTests::LongStringWithEscapedCharacters>();
         add<FromJsonTests::AllowedControlCharacter>();
         add<FromJsonTests::InvalidControlCharacter>();
+        add<FromJsonTests::LateInvalidControlCharacter>();
         add<FromJsonTests::NumbersInFieldName>();
         add<FromJsonTests::EscapeFieldName>();
         add<FromJsonTests::EscapedUnicodeToUtf8>();
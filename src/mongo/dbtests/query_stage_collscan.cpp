@@ -44,10 +44,12 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/fail_point_service.h"
+#include "mongo/util/scopeguard.h"
 
 namespace QueryStageCollectionScan {
 
@@ -390,6 +392,67 @@ public:
     }
 };
 
+//
+// Match documents on the filter worker threads, in batches spanning several worker tasks, and
+// expect the same results in the same order as a single-threaded scan.
+//
+
+class QueryStageCollscanConcurrentFilter : public QueryStageCollectionScanBase {
+public:
+    void run() {
+        const int numWorkersBefore = internalQueryCollScanFilterWorkerThreads;
+        const int batchSizeBefore = internalQueryCollScanFilterBatchSize.load();
+        ON_BLOCK_EXIT([&] {
+            internalQueryCollScanFilterWorkerThreads = numWorkersBefore;
+            internalQueryCollScanFilterBatchSize.store(batchSizeBefore);
+        });
+        internalQueryCollScanFilterWorkerThreads = 2;
+        internalQueryCollScanFilterBatchSize.store(300);
+
+        {
+            DBDirectClient client(&_opCtx);
+            for (int i = numObj(); i < numObj() + kExtraObjs; ++i) {
+                client.insert(nss.ns(), BSON("foo" << i));
+            }
+        }
+
+        AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+
+        CollectionScanParams params;
+        params.collection = ctx.getCollection();
+        params.direction = CollectionScanParams::FORWARD;
+        params.allowConcurrentFilterEvaluation = true;
+
+        const boost::intrusive_ptr<ExpressionContext> expCtx(
+            new ExpressionContext(&_opCtx, nullptr));
+        auto statusWithMatcher =
+            MatchExpressionParser::parse(fromjson("{foo: {$mod: [3, 0]}}"), expCtx);
+        ASSERT_OK(statusWithMatcher.getStatus());
+        unique_ptr<MatchExpression> filterExpr = std::move(statusWithMatcher.getValue());
+
+        unique_ptr<WorkingSet> ws = make_unique<WorkingSet>();
+        unique_ptr<PlanStage> ps =
+            make_unique<CollectionScan>(&_opCtx, params, ws.get(), filterExpr.get());
+
+        auto statusWithPlanExecutor = PlanExecutor::make(
+            &_opCtx, std::move(ws), std::move(ps), params.collection, PlanExecutor::NO_YIELD);
+        ASSERT_OK(statusWithPlanExecutor.getStatus());
+        auto exec = std::move(statusWithPlanExecutor.getValue());
+
+        int expected = 0;
+        PlanExecutor::ExecState state;
+        for (BSONObj obj; PlanExecutor::ADVANCED == (state = exec->getNext(&obj, NULL));) {
+            ASSERT_EQUALS(expected, obj["foo"].numberInt());
+            expected += 3;
+        }
+        ASSERT_EQUALS(PlanExecutor::IS_EOF, state);
+        ASSERT_EQUALS(numObj() + kExtraObjs, expected);
+    }
+
+private:
+    static const int kExtraObjs = 1000;
+};
+
 class All : public Suite {
 public:
     All() : Suite("QueryStageCollectionScan") {}
@@ -404,6 +467,7 @@ public:
         add<QueryStageCollscanObjectsInOrderBackward>();
         add<QueryStageCollscanDeleteUpcomingObject>();
         add<QueryStageCollscanDeleteUpcomingObjectBackward>();
+        add<QueryStageCollscanConcurrentFilter>();
     }
 };
 
@@ -176,6 +176,51 @@ public:
     }
 };
 
+//
+// Check that counting in batches examines at most the requested number of keys per batch and
+// counts each multikey document once
+//
+class QueryStageCountScanBatches : public CountBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+
+        // Insert some docs, each with two keys in the interval
+        for (int i = 0; i < 5; ++i) {
+            insert(BSON("a" << BSON_ARRAY(i << i + 10)));
+        }
+
+        // Add an index
+        addIndex(BSON("a" << 1));
+
+        // Set up the count stage
+        auto params = makeCountScanParams(&_opCtx, getIndex(ctx.db(), BSON("a" << 1)));
+        params.startKey = BSON("" << 0);
+        params.startKeyInclusive = true;
+        params.endKey = BSON("" << 20);
+        params.endKeyInclusive = true;
+
+        WorkingSet ws;
+        CountScan count(&_opCtx, params, &ws);
+
+        long long numCounted = 0;
+        int numBatches = 0;
+        PlanStage::StageState state = PlanStage::NEED_TIME;
+        while (PlanStage::IS_EOF != state) {
+            ASSERT_EQUALS(PlanStage::NEED_TIME, state);
+            state = count.countBatch(4, &numCounted);
+            ++numBatches;
+            auto stats = static_cast<const CountScanStats*>(count.getSpecificStats());
+            ASSERT_LTE(stats->keysExamined, 4U * numBatches);
+        }
+
+        // Ten keys in range fill two batches and a third batch sees the end of the range.
+        ASSERT_EQUALS(3, numBatches);
+        ASSERT_EQUALS(5, numCounted);
+        ASSERT(count.isEOF());
+    }
+};
+
 //
 // Check that expected results are returned with exclusive bounds
 //
@@ -583,6 +628,7 @@ public:
     void setupTests() {
         add<QueryStageCountScanDups>();
         add<QueryStageCountScanInclusiveBounds>();
+        add<QueryStageCountScanBatches>();
         add<QueryStageCountScanExclusiveBounds>();
         add<QueryStageCountScanLowerBound>();
         add<QueryStageCountScanNothingInInterval>();
@@ -87,6 +87,27 @@ int countResults(PlanStage* stage) {
     return count;
 }
 
+/**
+ * Like countResults(), but drives the stage with workBatch(). Also checks that the stage accounts
+ * for every unit of work, allowing for one trailing unit which hit EOF within the last batch.
+ */
+int countBatchedResults(PlanStage* stage, WorkingSet* ws, size_t batchSize) {
+    int count = 0;
+    while (!stage->isEOF()) {
+        std::vector<WorkingSetID> results;
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        stage->workBatch(batchSize, ws, &results, &id);
+        count += results.size();
+    }
+
+    const CommonStats* stats = stage->getCommonStats();
+    const size_t accountedWorks = stats->advanced + stats->needTime + stats->needYield;
+    ASSERT_EQUALS(static_cast<size_t>(count), stats->advanced);
+    ASSERT_LTE(accountedWorks, stats->works);
+    ASSERT_LTE(stats->works, accountedWorks + 1);
+    return count;
+}
+
 //
 // Insert 50 objects.  Filter/skip 0, 1, 2, ..., 100 objects and expect the right # of results.
 //
@@ -110,12 +131,35 @@ protected:
     OperationContext* const _opCtx = _uniqOpCtx.get();
 };
 
+//
+// Same as above, but pull the results through the stages in batches of several sizes.
+//
+class QueryStageLimitSkipBatchedTest : public QueryStageLimitSkipBasicTest {
+public:
+    void run() {
+        for (size_t batchSize : {1, 2, 7, 1000}) {
+            for (int i = 0; i < 2 * N; ++i) {
+                WorkingSet ws;
+
+                unique_ptr<PlanStage> skip =
+                    make_unique<SkipStage>(_opCtx, i, &ws, getMS(_opCtx, &ws));
+                ASSERT_EQUALS(max(0, N - i), countBatchedResults(skip.get(), &ws, batchSize));
+
+                unique_ptr<PlanStage> limit =
+                    make_unique<LimitStage>(_opCtx, i, &ws, getMS(_opCtx, &ws));
+                ASSERT_EQUALS(min(N, i), countBatchedResults(limit.get(), &ws, batchSize));
+            }
+        }
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_limit_skip") {}
 
     void setupTests() {
         add<QueryStageLimitSkipBasicTest>();
+        add<QueryStageLimitSkipBatchedTest>();
     }
 };
 
@@ -46,6 +46,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/mock_yield_policies.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/plan_pruner.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
@@ -275,6 +276,66 @@ TEST_F(QueryStageMultiPlanTest, MPSCollectionScanVsHighlySelectiveIXScan) {
     ASSERT_EQUALS(results, N / 10);
 }
 
+TEST_F(QueryStageMultiPlanTest, MPSWorksEachPlanSeveralTimesPerRound) {
+    const int N = 5000;
+    for (int i = 0; i < N; ++i) {
+        insert(BSON("foo" << (i % 10)));
+    }
+
+    addIndex(BSON("foo" << 1));
+
+    AutoGetCollectionForReadCommand ctx(_opCtx.get(), nss);
+    const Collection* coll = ctx.getCollection();
+
+    const int worksPerBatchOldValue = internalQueryPlanEvaluationWorksPerBatch.load();
+    internalQueryPlanEvaluationWorksPerBatch.store(16);
+    ON_BLOCK_EXIT([&] { internalQueryPlanEvaluationWorksPerBatch.store(worksPerBatchOldValue); });
+
+    unique_ptr<WorkingSet> sharedWs(new WorkingSet());
+    unique_ptr<PlanStage> ixScanRoot = getIxScanPlan(_opCtx.get(), coll, sharedWs.get(), 7);
+    BSONObj filterObj = BSON("foo" << 7);
+    unique_ptr<MatchExpression> filter = makeMatchExpressionFromFilter(_opCtx.get(), filterObj);
+    unique_ptr<PlanStage> collScanRoot =
+        getCollScanPlan(_opCtx.get(), coll, sharedWs.get(), filter.get());
+
+    auto cq = makeCanonicalQuery(_opCtx.get(), nss, filterObj);
+    unique_ptr<MultiPlanStage> mps =
+        make_unique<MultiPlanStage>(_opCtx.get(), ctx.getCollection(), cq.get());
+    mps->addPlan(createQuerySolution(), ixScanRoot.release(), sharedWs.get());
+    mps->addPlan(createQuerySolution(), collScanRoot.release(), sharedWs.get());
+
+    PlanYieldPolicy yieldPolicy(PlanExecutor::NO_YIELD, _clock);
+    ASSERT_OK(mps->pickBestPlan(&yieldPolicy));
+    ASSERT_EQUALS(0, mps->bestPlanIdx());
+
+    // The index scan stops as soon as it has produced a full batch of results, and both plans were
+    // worked in whole rounds of the batch size until then.
+    auto stats = mps->getStats();
+    ASSERT_EQUALS(stats->children.size(), 2U);
+    const size_t numResults = MultiPlanStage::getTrialPeriodNumToReturn(*cq);
+    ASSERT_EQUALS(stats->children[0]->common.advanced, numResults);
+    ASSERT_EQUALS(stats->children[1]->common.works % 16, 0U);
+
+    auto statusWithPlanExecutor = PlanExecutor::make(_opCtx.get(),
+                                                     std::move(sharedWs),
+                                                     std::move(mps),
+                                                     std::move(cq),
+                                                     coll,
+                                                     PlanExecutor::NO_YIELD);
+    ASSERT_OK(statusWithPlanExecutor.getStatus());
+    auto exec = std::move(statusWithPlanExecutor.getValue());
+
+    int results = 0;
+    BSONObj obj;
+    PlanExecutor::ExecState state;
+    while (PlanExecutor::ADVANCED == (state = exec->getNext(&obj, NULL))) {
+        ASSERT_EQUALS(obj["foo"].numberInt(), 7);
+        ++results;
+    }
+    ASSERT_EQUALS(PlanExecutor::IS_EOF, state);
+    ASSERT_EQUALS(results, N / 10);
+}
+
 TEST_F(QueryStageMultiPlanTest, MPSDoesNotCreateActiveCacheEntryImmediately) {
     const int N = 100;
     for (int i = 0; i < N; ++i) {
@@ -451,6 +512,45 @@ TEST_F(QueryStageMultiPlanTest, MPSBackupPlan) {
     internalQueryForceIntersectionPlans.store(forceIxisectOldValue);
 }
 
+TEST_F(QueryStageMultiPlanTest, PlanPrunerKeepsCheapestCandidates) {
+    // Every document matches on 'a' and 'b', but only one matches on 'c'.
+    const int N = 100;
+    for (int i = 0; i < N; ++i) {
+        insert(BSON("_id" << i << "a" << 1 << "b" << 1 << "c" << i));
+    }
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("b" << 1));
+    addIndex(BSON("c" << 1));
+
+    AutoGetCollectionForReadCommand ctx(_opCtx.get(), nss);
+    Collection* collection = ctx.getCollection();
+
+    auto cq = makeCanonicalQuery(_opCtx.get(), nss, BSON("a" << 1 << "b" << 1 << "c" << 7));
+    QueryPlannerParams plannerParams;
+    fillOutPlannerParams(_opCtx.get(), collection, cq.get(), &plannerParams);
+    auto solutions = uassertStatusOK(QueryPlanner::plan(*cq, plannerParams));
+    ASSERT_EQUALS(solutions.size(), 3U);
+
+    // The probe stops counting at the limit.
+    const long long probeLimit = 50;
+    for (auto&& soln : solutions) {
+        auto cost = PlanPruner::estimateCost(_opCtx.get(), collection, *soln, probeLimit);
+        ASSERT(cost);
+        ASSERT(*cost == 1 || *cost == probeLimit);
+    }
+
+    PlanPruner::prune(_opCtx.get(), collection, 2, probeLimit, &solutions);
+    ASSERT_EQUALS(solutions.size(), 2U);
+    size_t selectiveSolutions = 0;
+    for (auto&& soln : solutions) {
+        if (QueryPlannerTestLib::solutionMatches("{fetch: {node: {ixscan: {pattern: {c: 1}}}}}",
+                                                 soln->root.get())) {
+            ++selectiveSolutions;
+        }
+    }
+    ASSERT_EQUALS(selectiveSolutions, 1U);
+}
+
 /**
  * Allocates a new WorkingSetMember with data 'dataObj' in 'ws', and adds the WorkingSetMember
  * to 'qds'.
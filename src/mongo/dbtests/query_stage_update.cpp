@@ -49,10 +49,12 @@
 #include "mongo/db/ops/update_lifecycle_impl.h"
 #include "mongo/db/ops/update_request.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/update/update_driver.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/scopeguard.h"
 
 #define ASSERT_DOES_NOT_THROW(EXPRESSION)                                          \
     try {                                                                          \
@@ -365,6 +367,90 @@ public:
     }
 };
 
+/**
+ * Test that a multi-update applies several documents in each call to work() once batching is
+ * enabled, and still updates each matching document exactly once.
+ */
+class QueryStageUpdateBatchedMultiUpdate : public QueryStageUpdateBase {
+public:
+    void run() {
+        const int originalBatchSize = internalUpdateMaxBatchSize.load();
+        internalUpdateMaxBatchSize.store(4);
+        ON_BLOCK_EXIT([&] { internalUpdateMaxBatchSize.store(originalBatchSize); });
+
+        {
+            dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+
+            for (int i = 0; i < 10; ++i) {
+                insert(BSON("_id" << i << "foo" << i));
+            }
+            ASSERT_EQUALS(10U, count(BSONObj()));
+
+            CurOp& curOp = *CurOp::get(_opCtx);
+            OpDebug* opDebug = &curOp.debug();
+            const CollatorInterface* collator = nullptr;
+            UpdateDriver driver(new ExpressionContext(&_opCtx, collator));
+            Collection* coll = ctx.db()->getCollection(&_opCtx, nss);
+
+            UpdateRequest request(nss);
+            UpdateLifecycleImpl updateLifecycle(nss);
+            request.setLifecycle(&updateLifecycle);
+
+            BSONObj query = fromjson("{foo: {$lt: 5}}");
+            BSONObj updates = fromjson("{$inc: {bar: 1}}");
+            request.setMulti();
+            request.setQuery(query);
+            request.setUpdates(updates);
+
+            const std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+            ASSERT_DOES_NOT_THROW(
+                driver.parse(request.getUpdates(), arrayFilters, request.isMulti()));
+
+            CollectionScanParams collScanParams;
+            collScanParams.collection = coll;
+            collScanParams.direction = CollectionScanParams::FORWARD;
+            collScanParams.tailable = false;
+
+            UpdateStageParams updateParams(&request, &driver, opDebug);
+            unique_ptr<CanonicalQuery> cq(canonicalize(query));
+            updateParams.canonicalQuery = cq.get();
+
+            auto ws = make_unique<WorkingSet>();
+            auto cs = make_unique<CollectionScan>(&_opCtx, collScanParams, ws.get(), cq->root());
+            auto updateStage =
+                make_unique<UpdateStage>(&_opCtx, updateParams, ws.get(), coll, cs.release());
+            const UpdateStats* stats =
+                static_cast<const UpdateStats*>(updateStage->getSpecificStats());
+
+            // The first call updates a whole batch.
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            ASSERT_EQUALS(PlanStage::NEED_TIME, updateStage->work(&id));
+            ASSERT_EQUALS(4U, stats->nModified);
+
+            while (!updateStage->isEOF()) {
+                id = WorkingSet::INVALID_ID;
+                PlanStage::StageState state = updateStage->work(&id);
+                ASSERT(PlanStage::NEED_TIME == state || PlanStage::IS_EOF == state);
+            }
+
+            ASSERT_EQUALS(5U, stats->nModified);
+            ASSERT_EQUALS(5U, stats->nMatched);
+        }
+
+        {
+            AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+            vector<BSONObj> objs;
+            getCollContents(ctx.getCollection(), &objs);
+            ASSERT_EQUALS(10U, objs.size());
+            for (int i = 0; i < 10; ++i) {
+                assertHasDoc(objs,
+                             i < 5 ? BSON("_id" << i << "foo" << i << "bar" << 1)
+                                   : BSON("_id" << i << "foo" << i));
+            }
+        }
+    }
+};
+
 /**
  * Test that the update stage returns an owned copy of the original document if
  * ReturnDocOption::RETURN_OLD is specified.
@@ -555,6 +641,7 @@ public:
         // Stage-specific tests below.
         add<QueryStageUpdateUpsertEmptyColl>();
         add<QueryStageUpdateSkipDeletedDoc>();
+        add<QueryStageUpdateBatchedMultiUpdate>();
         add<QueryStageUpdateReturnOldDoc>();
         add<QueryStageUpdateReturnNewDoc>();
     }
@@ -37,8 +37,10 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/util/scopeguard.h"
 
 namespace ValidateTests {
 
@@ -1143,6 +1145,104 @@ public:
     }
 };
 
+/**
+ * Validates a collection whose records and index entries span several of the batches handed to
+ * the validation workers.
+ */
+template <bool full, bool background>
+class ValidateWithWorkers : public ValidateBase {
+public:
+    ValidateWithWorkers() : ValidateBase(full, background) {}
+
+    void run() {
+
+        // Can't do it in background if the RecordStore is not in RecordId order.
+        if (_background && !_isInRecordIdOrder) {
+            return;
+        }
+
+        auto workerThreads =
+            ServerParameterSet::getGlobal()->getMap().find("internalValidateWorkerThreads");
+        ASSERT(workerThreads != ServerParameterSet::getGlobal()->getMap().end());
+        ASSERT_OK(workerThreads->second->setFromString("4"));
+        ON_BLOCK_EXIT([&] { workerThreads->second->setFromString("0").ignore(); });
+
+        // Create a new collection with enough records for several batches and check it's valid.
+        lockDb(MODE_X);
+        OpDebug* const nullOpDebug = nullptr;
+        Collection* coll;
+        RecordId id1;
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            ASSERT_OK(_db->dropCollection(&_opCtx, _ns));
+            coll = _db->createCollection(&_opCtx, _ns);
+
+            for (int i = 1; i <= 3000; i++) {
+                ASSERT_OK(coll->insertDocument(
+                    &_opCtx, InsertStatement(BSON("_id" << i << "a" << i)), nullOpDebug, true));
+            }
+            id1 = coll->getCursor(&_opCtx)->next()->id;
+            wunit.commit();
+        }
+
+        const std::string indexName = "a";
+        auto status = dbtests::createIndexFromSpec(
+            &_opCtx,
+            coll->ns().ns(),
+            BSON("name" << indexName << "ns" << coll->ns().ns() << "key" << BSON("a" << 1) << "v"
+                        << static_cast<int>(kIndexVersion)
+                        << "background"
+                        << false));
+
+        ASSERT_OK(status);
+        ASSERT_TRUE(checkValid());
+
+        lockDb(MODE_X);
+
+        // Replace a correct index entry with a bad one and check it's invalid.
+        IndexCatalog* indexCatalog = coll->getIndexCatalog();
+        IndexDescriptor* descriptor = indexCatalog->findIndexByName(&_opCtx, indexName);
+        IndexAccessMethod* iam = indexCatalog->getIndex(descriptor);
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            int64_t numDeleted;
+            int64_t numInserted;
+            InsertDeleteOptions options;
+            options.dupsAllowed = true;
+            options.logIfError = true;
+            ASSERT_OK(iam->remove(&_opCtx, BSON("a" << 1), id1, options, &numDeleted));
+            ASSERT_OK(iam->insert(&_opCtx, BSON("a" << -1), id1, options, &numInserted));
+            ASSERT_EQUALS(numDeleted, 1);
+            ASSERT_EQUALS(numInserted, 1);
+            wunit.commit();
+        }
+
+        ASSERT_FALSE(checkValid());
+
+        lockDb(MODE_X);
+
+        // Restore the entry, then change the IndexDescriptor's keyPattern to descending so the
+        // index ordering appears wrong.
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            int64_t numDeleted;
+            int64_t numInserted;
+            InsertDeleteOptions options;
+            options.dupsAllowed = true;
+            options.logIfError = true;
+            ASSERT_OK(iam->remove(&_opCtx, BSON("a" << -1), id1, options, &numDeleted));
+            ASSERT_OK(iam->insert(&_opCtx, BSON("a" << 1), id1, options, &numInserted));
+            wunit.commit();
+        }
+        ASSERT_TRUE(checkValid());
+
+        lockDb(MODE_X);
+        descriptor->setKeyPatternForTest(BSON("a" << -1));
+
+        ASSERT_FALSE(checkValid());
+        releaseDb();
+    }
+};
 
 class ValidateTests : public Suite {
 public:
@@ -1180,6 +1280,10 @@ public:
         add<ValidateIndexEntry<false, true>>();
         add<ValidateIndexOrdering<false, false>>();
         add<ValidateIndexOrdering<false, true>>();
+
+        // Tests for validation by worker threads.
+        add<ValidateWithWorkers<false, false>>();
+        add<ValidateWithWorkers<false, true>>();
     }
 } validateTests;
 }  // namespace ValidateTests
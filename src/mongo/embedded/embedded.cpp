@@ -40,6 +40,7 @@
 #include "mongo/db/catalog/uuid_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands/feature_compatibility_version.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/commands/fsync_locked.h"
 #include "mongo/db/concurrency/lock_state.h"
 #include "mongo/db/dbdirectclient.h"
@@ -54,8 +55,10 @@
 #include "mongo/db/session_catalog.h"
 #include "mongo/db/session_killer.h"
 #include "mongo/db/storage/encryption_hooks.h"
+#include "mongo/db/storage/mobile/mobile_global_options.h"
 #include "mongo/db/storage/storage_engine_init.h"
 #include "mongo/db/ttl.h"
+#include "mongo/embedded/embedded_options.h"
 #include "mongo/embedded/logical_session_cache_factory_embedded.h"
 #include "mongo/embedded/periodic_runner_embedded.h"
 #include "mongo/embedded/replication_coordinator_embedded.h"
@@ -66,8 +69,10 @@
 #include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 #include "mongo/util/periodic_runner_factory.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/quick_exit.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 #include <boost/filesystem.hpp>
 
@@ -130,6 +135,39 @@ GlobalInitializerRegisterer filterAllowedIndexFieldNamesEmbeddedInitializer(
             };
         return Status::OK();
     });
+
+// How long each phase of initialize() took and how much memory the process held afterwards, kept
+// for tuning the footprint of the library.
+const auto getStartupReport = ServiceContext::declareDecoration<BSONObj>();
+
+class EmbeddedServerStatusSection : public ServerStatusSection {
+public:
+    EmbeddedServerStatusSection() : ServerStatusSection("embedded") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        builder.append("lowMemoryMode", embeddedGlobalParams.lowMemoryMode);
+        builder.append("startup", getStartupReport(opCtx->getServiceContext()));
+
+        ProcessInfo processInfo;
+        if (processInfo.supported()) {
+            builder.append("residentMB", processInfo.getResidentSize());
+        }
+
+        BSONObjBuilder mobileBuilder(builder.subobjStart("mobile"));
+        mobileBuilder.append("maxSessionPoolSize",
+                             static_cast<long long>(mobileGlobalOptions.maxSessionPoolSize));
+        mobileBuilder.append("sessionCacheSizeKB", mobileGlobalOptions.sessionCacheSizeKB);
+        mobileBuilder.append("releaseSessionMemory", mobileGlobalOptions.releaseSessionMemory);
+        mobileBuilder.doneFast();
+        return builder.obj();
+    }
+} embeddedServerStatusSection;
 }  // namespace
 
 using logger::LogComponent;
@@ -181,6 +219,14 @@ void shutdown(ServiceContext* srvContext) {
 ServiceContext* initialize(const char* yaml_config) {
     srand(static_cast<unsigned>(curTimeMicros64()));
 
+    Timer startupTimer;
+    Timer phaseTimer;
+    BSONObjBuilder phasesBuilder;
+    auto endPhase = [&](StringData phase) {
+        phasesBuilder.append(phase, phaseTimer.millis());
+        phaseTimer.reset();
+    };
+
     // yaml_config is passed to the options parser through the argc/argv interface that already
     // existed. If it is nullptr then use 0 count which will be interpreted as empty string.
     const char* argv[2] = {yaml_config, nullptr};
@@ -188,6 +234,7 @@ ServiceContext* initialize(const char* yaml_config) {
     Status status = mongo::runGlobalInitializers(yaml_config ? 1 : 0, argv, nullptr);
     uassertStatusOKWithContext(status, "Global initilization failed");
     setGlobalServiceContext(ServiceContext::make());
+    endPhase("globalInitializers"_sd);
 
     Client::initThread("initandlisten");
 
@@ -218,6 +265,7 @@ ServiceContext* initialize(const char* yaml_config) {
     DEV log(LogComponent::kControl) << "DEBUG build (which is slower)" << endl;
 
     initializeStorageEngine(serviceContext, StorageEngineInitFlags::kAllowNoLockFile);
+    endPhase("storageEngine"_sd);
 
     // Warn if we detect configurations for multiple registered storage engines in the same
     // configuration file/environment.
@@ -296,6 +344,7 @@ ServiceContext* initialize(const char* yaml_config) {
         log() << "finished checking dbs";
         exitCleanly(EXIT_CLEAN);
     }
+    endPhase("checkDatabases"_sd);
 
     // This is for security on certain platforms (nonce generation)
     srand((unsigned)(curTimeMicros64()) ^ (unsigned(uintptr_t(&startupOpCtx))));
@@ -303,6 +352,7 @@ ServiceContext* initialize(const char* yaml_config) {
     if (!storageGlobalParams.readOnly) {
         restartInProgressIndexesFromLastShutdown(startupOpCtx.get());
     }
+    endPhase("restartIndexBuilds"_sd);
 
     auto periodicRunner = std::make_unique<PeriodicRunnerEmbedded>(
         serviceContext, serviceContext->getPreciseClockSource());
@@ -312,6 +362,7 @@ ServiceContext* initialize(const char* yaml_config) {
     // Set up the logical session cache
     auto sessionCache = makeLogicalSessionCacheEmbedded();
     LogicalSessionCache::set(serviceContext, std::move(sessionCache));
+    endPhase("backgroundServices"_sd);
 
     // MessageServer::run will return when exit code closes its socket and we don't need the
     // operation context anymore
@@ -320,6 +371,19 @@ ServiceContext* initialize(const char* yaml_config) {
     // Make sure current thread have no client set in thread_local
     Client::releaseCurrent();
 
+    {
+        BSONObjBuilder reportBuilder;
+        reportBuilder.append("totalMillis", startupTimer.millis());
+        reportBuilder.append("phaseMillis", phasesBuilder.obj());
+        ProcessInfo processInfo;
+        if (processInfo.supported()) {
+            reportBuilder.append("residentMB", processInfo.getResidentSize());
+        }
+        getStartupReport(serviceContext) = reportBuilder.obj();
+        log(LogComponent::kControl) << "Embedded startup finished: "
+                                    << getStartupReport(serviceContext);
+    }
+
     serviceContext->notifyStartupComplete();
 
     return serviceContext;
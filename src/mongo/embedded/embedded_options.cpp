@@ -32,6 +32,7 @@
 
 #include "mongo/db/server_options.h"
 #include "mongo/db/server_options_helpers.h"
+#include "mongo/db/storage/mobile/mobile_global_options.h"
 #include "mongo/db/storage/storage_options.h"
 
 #include <boost/filesystem.hpp>
@@ -42,6 +43,8 @@ namespace embedded {
 
 using std::string;
 
+EmbeddedParams embeddedGlobalParams;
+
 Status addOptions(optionenvironment::OptionSection* options) {
     moe::OptionSection general_options("General options");
 
@@ -77,8 +80,28 @@ Status addOptions(optionenvironment::OptionSection* options) {
 
 #endif
 
+    storage_options.addOptionChaining("storage.mobile.maxSessionPoolSize",
+                                      "mobileMaxSessionPoolSize",
+                                      moe::Int,
+                                      "most SQLite connections the mobile engine keeps open");
+
+    storage_options.addOptionChaining("storage.mobile.sessionCacheSizeKB",
+                                      "mobileSessionCacheSizeKB",
+                                      moe::Int,
+                                      "page cache of each SQLite connection in KB, 0 for the "
+                                      "SQLite default");
+
+    moe::OptionSection embedded_options("Embedded options");
+
+    embedded_options.addOptionChaining("embedded.lowMemoryMode",
+                                       "lowMemoryMode",
+                                       moe::Switch,
+                                       "shrink caches and connection pools to reduce the memory "
+                                       "footprint at the cost of throughput");
+
     options->addSection(general_options).transitional_ignore();
     options->addSection(storage_options).transitional_ignore();
+    options->addSection(embedded_options).transitional_ignore();
 
     return Status::OK();
 }
@@ -107,6 +130,36 @@ Status storeOptions(const moe::Environment& params) {
     if (params.count("storage.dbPath")) {
         storageGlobalParams.dbpath = params["storage.dbPath"].as<string>();
     }
+
+    if (params.count("embedded.lowMemoryMode")) {
+        embeddedGlobalParams.lowMemoryMode = params["embedded.lowMemoryMode"].as<bool>();
+    }
+
+    if (embeddedGlobalParams.lowMemoryMode) {
+        // Few enough connections for a single application thread plus internal operations, each
+        // with a quarter of SQLite's default page cache that is given back between operations.
+        mobileGlobalOptions.maxSessionPoolSize = 8;
+        mobileGlobalOptions.sessionCacheSizeKB = 512;
+        mobileGlobalOptions.releaseSessionMemory = true;
+    }
+
+    if (params.count("storage.mobile.maxSessionPoolSize")) {
+        int maxSessionPoolSize = params["storage.mobile.maxSessionPoolSize"].as<int>();
+        if (maxSessionPoolSize < 1) {
+            return Status(ErrorCodes::BadValue,
+                          "storage.mobile.maxSessionPoolSize must be at least 1");
+        }
+        mobileGlobalOptions.maxSessionPoolSize = maxSessionPoolSize;
+    }
+
+    if (params.count("storage.mobile.sessionCacheSizeKB")) {
+        int sessionCacheSizeKB = params["storage.mobile.sessionCacheSizeKB"].as<int>();
+        if (sessionCacheSizeKB < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "storage.mobile.sessionCacheSizeKB cannot be negative");
+        }
+        mobileGlobalOptions.sessionCacheSizeKB = sessionCacheSizeKB;
+    }
 #ifdef _WIN32
     if (storageGlobalParams.dbpath.size() > 1 &&
         storageGlobalParams.dbpath[storageGlobalParams.dbpath.size() - 1] == '/') {
@@ -131,6 +184,8 @@ Status storeOptions(const moe::Environment& params) {
 
 void resetOptions() {
     storageGlobalParams.reset();
+    mobileGlobalOptions = MobileGlobalOptions();
+    embeddedGlobalParams = EmbeddedParams();
 }
 
 }  // namespace embedded
@@ -35,6 +35,14 @@
 namespace mongo {
 namespace embedded {
 
+struct EmbeddedParams {
+    // Trades throughput for a smaller memory footprint by shrinking the storage engine's
+    // connection pool and caches.
+    bool lowMemoryMode = false;
+};
+
+extern EmbeddedParams embeddedGlobalParams;
+
 Status addOptions(optionenvironment::OptionSection* options);
 
 /**
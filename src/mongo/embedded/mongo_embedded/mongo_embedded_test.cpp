@@ -305,6 +305,24 @@ TEST_F(MongodbCAPITest, TrimMemory) {
     performRpc(client, inputOpMsg);
 }
 
+TEST_F(MongodbCAPITest, ServerStatusReportsStartupAndFootprint) {
+    auto client = createClient();
+
+    mongo::BSONObj inputObj = mongo::fromjson("{serverStatus: 1}");
+    auto inputOpMsg = mongo::OpMsgRequest::fromDBAndBody("admin", inputObj);
+    auto output = performRpc(client, inputOpMsg);
+    ASSERT_EQUALS(1.0, output.getField("ok").numberDouble()) << output;
+
+    auto embedded = output.getObjectField("embedded");
+    ASSERT_FALSE(embedded.getBoolField("lowMemoryMode")) << embedded;
+    auto phases = embedded.getObjectField("startup").getObjectField("phaseMillis");
+    for (auto phase : {"globalInitializers", "storageEngine", "backgroundServices"}) {
+        ASSERT(phases.hasField(phase)) << phases;
+    }
+    ASSERT_EQUALS(80, embedded.getObjectField("mobile")["maxSessionPoolSize"].numberLong())
+        << embedded;
+}
+
 TEST_F(MongodbCAPITest, BatteryLevel) {
     // create the client object
     auto client = createClient();
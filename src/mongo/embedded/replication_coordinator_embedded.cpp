@@ -233,6 +233,11 @@ ReplicationCoordinator::StatusAndDuration ReplicationCoordinatorEmbedded::awaitR
     UASSERT_NOT_IMPLEMENTED;
 }
 
+Future<void> ReplicationCoordinatorEmbedded::awaitReplicationAsync(const OpTime&,
+                                                                   const WriteConcernOptions&) {
+    UASSERT_NOT_IMPLEMENTED;
+}
+
 void ReplicationCoordinatorEmbedded::stepDown(OperationContext*,
                                               const bool,
                                               const Milliseconds&,
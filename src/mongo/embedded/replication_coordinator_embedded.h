@@ -96,6 +96,7 @@ public:
 
     repl::ReplicationCoordinator::StatusAndDuration awaitReplication(
         OperationContext*, const repl::OpTime&, const WriteConcernOptions&) override;
+    Future<void> awaitReplicationAsync(const repl::OpTime&, const WriteConcernOptions&) override;
 
     void stepDown(OperationContext*, bool, const Milliseconds&, const Milliseconds&) override;
 
@@ -32,6 +32,8 @@
 
 #include "mongo/executor/connection_pool.h"
 
+#include <cmath>
+
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/executor/connection_pool_stats.h"
 #include "mongo/executor/remote_command_request.h"
@@ -123,6 +125,12 @@ public:
      */
     void processFailure(const Status& status, stdx::unique_lock<stdx::mutex> lk);
 
+    /**
+     * Opens connections until the pool holds at least Options::warmUpConnections of them, and
+     * keeps them open as long as the pool lives or until the next failure.
+     */
+    void warmUp(stdx::unique_lock<stdx::mutex> lk);
+
     /**
      * Returns a connection to a specific pool. Sinks a unique_lock from the
      * parent to preserve the lock on _mutex
@@ -190,6 +198,13 @@ private:
 
     void spawnConnections(stdx::unique_lock<stdx::mutex>& lk);
 
+    /**
+     * Returns the number of connections to keep open whether or not they are being used: the
+     * greater of minConnections and the warm up and predicted demand targets, which are capped by
+     * maxConnections.
+     */
+    size_t minimumConnections(const stdx::unique_lock<stdx::mutex>& lk) const;
+
     template <typename OwnershipPoolType>
     typename OwnershipPoolType::mapped_type takeFromPool(
         OwnershipPoolType& pool, typename OwnershipPoolType::key_type connPtr);
@@ -219,6 +234,13 @@ private:
 
     size_t _created;
 
+    // The number of connections warmUp() asked for, or zero if the pool was not warmed up.
+    size_t _warmUpTarget = 0;
+
+    // Exponentially weighted moving average of the requests and checked out connections seen by
+    // each getConnection(). Only maintained when Options::demandScalingFactor is positive.
+    double _demandAverage = 0.0;
+
     transport::Session::TagMask _tags = transport::Session::kPending;
 
     /**
@@ -257,6 +279,10 @@ constexpr Milliseconds ConnectionPool::kDefaultRefreshTimeout;
 const Status ConnectionPool::kConnectionStateUnknown =
     Status(ErrorCodes::InternalError, "Connection is in an unknown state");
 
+// How much each getConnection() moves a pool's moving average of demand. At this weight the
+// average mostly reflects the last few dozen checkouts.
+static constexpr double kDemandAverageWeight = 0.1;
+
 ConnectionPool::ConnectionPool(std::shared_ptr<DependentTypeFactoryInterface> impl,
                                std::string name,
                                Options options)
@@ -329,6 +355,26 @@ void ConnectionPool::dropConnections(transport::Session::TagMask tags) {
     }
 }
 
+void ConnectionPool::warmUpConnections(const HostAndPort& hostAndPort) {
+    if (!_options.warmUpConnections)
+        return;
+
+    std::shared_ptr<SpecificPool> pool;
+
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+
+    auto iter = _pools.find(hostAndPort);
+
+    if (iter == _pools.end()) {
+        pool = stdx::make_unique<SpecificPool>(this, hostAndPort);
+        _pools[hostAndPort] = pool;
+    } else {
+        pool = iter->second;
+    }
+
+    pool->warmUp(std::move(lk));
+}
+
 void ConnectionPool::mutateTags(
     const HostAndPort& hostAndPort,
     const stdx::function<transport::Session::TagMask(transport::Session::TagMask)>& mutateFunc) {
@@ -462,6 +508,11 @@ Future<ConnectionPool::ConnectionHandle> ConnectionPool::SpecificPool::getConnec
     _requests.push_back(make_pair(expiration, pf.promise.share()));
     std::push_heap(begin(_requests), end(_requests), RequestComparator{});
 
+    if (_parent->_options.demandScalingFactor > 0) {
+        const double demand = _requests.size() + _checkedOutPool.size();
+        _demandAverage += kDemandAverageWeight * (demand - _demandAverage);
+    }
+
     updateStateInLock();
 
     spawnConnections(lk);
@@ -496,8 +547,8 @@ void ConnectionPool::SpecificPool::returnConnection(ConnectionInterface* connPtr
         // If we need to refresh this connection
 
         if (_readyPool.size() + _processingPool.size() + _checkedOutPool.size() >=
-            _parent->_options.minConnections) {
-            // If we already have minConnections, just let the connection lapse
+            minimumConnections(lk)) {
+            // If we already have enough connections, just let the connection lapse
             log() << "Ending idle connection to host " << _hostAndPort
                   << " because the pool meets constraints; " << openConnections(lk)
                   << " connections to that host remain open";
@@ -596,6 +647,18 @@ void ConnectionPool::SpecificPool::triggerShutdown(const Status& status,
     processFailure(status, std::move(lk));
 }
 
+void ConnectionPool::SpecificPool::warmUp(stdx::unique_lock<stdx::mutex> lk) {
+    if (_state == State::kInShutdown)
+        return;
+
+    _warmUpTarget = std::max(_warmUpTarget, _parent->_options.warmUpConnections);
+
+    spawnConnections(lk);
+
+    // A newly created pool has to start its host timeout in case no requests ever arrive.
+    updateStateInLock();
+}
+
 // Drop connections and fail all requests
 void ConnectionPool::SpecificPool::processFailure(const Status& status,
                                                   stdx::unique_lock<stdx::mutex> lk) {
@@ -603,6 +666,11 @@ void ConnectionPool::SpecificPool::processFailure(const Status& status,
     // connections
     _generation++;
 
+    // The host may not come back, so stop holding connections open to it until it is warmed up or
+    // sees demand again.
+    _warmUpTarget = 0;
+    _demandAverage = 0.0;
+
     // When a connection enters the ready pool, its timer is set to eventually refresh the
     // connection. This requires a lifetime extension of the specific pool because the connection
     // timer is tied to the lifetime of the connection, not the pool. That said, we can destruct
@@ -715,10 +783,10 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
     _inSpawnConnections = true;
     auto guard = MakeGuard([&] { _inSpawnConnections = false; });
 
-    // We want minConnections <= outstanding requests <= maxConnections
+    // We want minimumConnections <= outstanding requests <= maxConnections
     auto target = [&] {
         return std::max(
-            _parent->_options.minConnections,
+            minimumConnections(lk),
             std::min(_requests.size() + _checkedOutPool.size(), _parent->_options.maxConnections));
     };
 
@@ -775,6 +843,17 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
     }
 }
 
+size_t ConnectionPool::SpecificPool::minimumConnections(
+    const stdx::unique_lock<stdx::mutex>& lk) const {
+    const auto& options = _parent->_options;
+
+    const auto predicted =
+        static_cast<size_t>(std::ceil(_demandAverage * options.demandScalingFactor));
+
+    return std::max(options.minConnections,
+                    std::min(std::max(_warmUpTarget, predicted), options.maxConnections));
+}
+
 template <typename OwnershipPoolType>
 typename OwnershipPoolType::mapped_type ConnectionPool::SpecificPool::takeFromPool(
     OwnershipPoolType& pool, typename OwnershipPoolType::key_type connPtr) {
@@ -122,6 +122,21 @@ public:
          */
         Milliseconds hostTimeout = kDefaultHostTimeout;
 
+        /**
+         * The number of connections warmUpConnections() opens to a host before any requests for
+         * them arrive. The pool keeps that many open, up to maxConnections, until it is dropped or
+         * times out. Zero disables warming up.
+         */
+        size_t warmUpConnections = 0;
+
+        /**
+         * When positive, each host's pool opens connections ahead of demand. It keeps a moving
+         * average of the connections wanted at each checkout, which is the checkout rate times how
+         * long checkouts wait for and then hold their connections, and keeps this multiple of the
+         * average open, up to maxConnections. Zero grows pools only as requests arrive.
+         */
+        double demandScalingFactor = 0.0;
+
         /**
          * An egress tag closer manager which will provide global access to this connection pool.
          * The manager set's tags and potentially drops connections that don't match those tags.
@@ -143,6 +158,12 @@ public:
 
     void dropConnections(transport::Session::TagMask tags) override;
 
+    /**
+     * Opens Options::warmUpConnections connections to the given host ahead of any requests, so
+     * that the first requests after a restart or a failover don't pay for connection setup.
+     */
+    void warmUpConnections(const HostAndPort& hostAndPort);
+
     void mutateTags(const HostAndPort& hostAndPort,
                     const stdx::function<transport::Session::TagMask(transport::Session::TagMask)>&
                         mutateFunc) override;
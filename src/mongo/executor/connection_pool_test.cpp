@@ -916,6 +916,87 @@ TEST_F(ConnectionPoolTest, minPoolRespected) {
 }
 
 
+/**
+ * Verify that warming up a host opens warmUpConnections connections before any requests, which
+ * then serve requests without further setup
+ */
+TEST_F(ConnectionPoolTest, warmUpOpensConnections) {
+    ConnectionPool::Options options;
+    options.warmUpConnections = 3;
+    ConnectionPool pool(stdx::make_unique<PoolImpl>(), "test pool", options);
+
+    pool.warmUpConnections(HostAndPort());
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 3u);
+
+    for (int i = 0; i < 3; ++i) {
+        ConnectionImpl::pushSetup(Status::OK());
+    }
+    ASSERT_EQ(pool.getNumConnectionsPerHost(HostAndPort()), 3u);
+
+    std::vector<ConnectionPool::ConnectionHandle> conns;
+    for (int i = 0; i < 3; ++i) {
+        pool.get(HostAndPort(),
+                 Milliseconds(5000),
+                 [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                     ASSERT(swConn.isOK());
+                     conns.push_back(std::move(swConn.getValue()));
+                 });
+    }
+
+    ASSERT_EQ(conns.size(), 3u);
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 0u);
+    ASSERT_EQ(pool.getNumConnectionsPerHost(HostAndPort()), 3u);
+
+    for (auto& conn : conns) {
+        doneWith(conn);
+    }
+}
+
+/**
+ * Verify that warming up does nothing unless warmUpConnections is set
+ */
+TEST_F(ConnectionPoolTest, warmUpDisabledByDefault) {
+    ConnectionPool pool(stdx::make_unique<PoolImpl>(), "test pool");
+
+    pool.warmUpConnections(HostAndPort());
+
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 0u);
+    ASSERT_EQ(pool.getNumConnectionsPerHost(HostAndPort()), 0u);
+}
+
+/**
+ * Verify that with a demandScalingFactor the pool opens more connections than are requested at
+ * once, up to maxConnections, as the moving average of demand builds up
+ */
+TEST_F(ConnectionPoolTest, demandScalingGrowsPoolAheadOfRequests) {
+    auto runRequests = [](ConnectionPool::Options options) {
+        ConnectionPool pool(stdx::make_unique<PoolImpl>(), "test pool", options);
+
+        // Serve one request at a time, so no more than one connection is ever in use.
+        for (int i = 0; i < 50; ++i) {
+            pool.get(HostAndPort(),
+                     Milliseconds(5000),
+                     [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                         ASSERT(swConn.isOK());
+                         doneWith(swConn.getValue());
+                     });
+            while (ConnectionImpl::setupQueueDepth()) {
+                ConnectionImpl::pushSetup(Status::OK());
+            }
+        }
+
+        return pool.getNumConnectionsPerHost(HostAndPort());
+    };
+
+    ConnectionPool::Options options;
+    options.maxConnections = 4;
+    ASSERT_EQ(runRequests(options), 1u);
+
+    options.demandScalingFactor = 20;
+    ASSERT_EQ(runRequests(options), 4u);
+}
+
+
 /**
  * Verify that the hostTimeout is respected. This implies that an idle
  * hostAndPort drops it's connections.
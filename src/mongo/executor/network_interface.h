@@ -206,6 +206,12 @@ public:
      */
     virtual void dropConnections(const HostAndPort& hostAndPort) = 0;
 
+    /**
+     * Opens connections to the given host ahead of any requests for them, if the connection pool
+     * is configured to warm up.
+     */
+    virtual void warmUpConnections(const HostAndPort& hostAndPort) = 0;
+
 protected:
     NetworkInterface();
 };
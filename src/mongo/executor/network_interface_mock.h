@@ -134,6 +134,8 @@ public:
 
     void dropConnections(const HostAndPort&) override {}
 
+    void warmUpConnections(const HostAndPort&) override {}
+
 
     ////////////////////////////////////////////////////////////////////////////////
     //
@@ -494,5 +494,15 @@ void NetworkInterfaceTL::dropConnections(const HostAndPort& hostAndPort) {
     _pool->dropConnections(hostAndPort);
 }
 
+void NetworkInterfaceTL::warmUpConnections(const HostAndPort& hostAndPort) {
+    // Primary changes may be reported before the interface has started up and made its pool.
+    auto pool = [&] {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        return _pool.get();
+    }();
+    if (pool)
+        pool->warmUpConnections(hostAndPort);
+}
+
 }  // namespace executor
 }  // namespace mongo
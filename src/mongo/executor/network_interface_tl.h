@@ -78,6 +78,8 @@ public:
 
     void dropConnections(const HostAndPort& hostAndPort) override;
 
+    void warmUpConnections(const HostAndPort& hostAndPort) override;
+
 private:
     struct CommandState {
         CommandState(RemoteCommandRequest request_,
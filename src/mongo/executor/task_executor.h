@@ -269,6 +269,12 @@ public:
      */
     virtual void appendConnectionStats(ConnectionPoolStats* stats) const = 0;
 
+    /**
+     * Opens connections to the given host on the underlying network interface ahead of any
+     * requests for them. Executors without a connection pool do nothing.
+     */
+    virtual void warmUpConnections(const HostAndPort& hostAndPort) {}
+
 protected:
     // Retrieves the Callback from a given CallbackHandle
     static CallbackState* getCallbackFromHandle(const CallbackHandle& cbHandle);
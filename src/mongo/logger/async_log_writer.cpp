@@ -0,0 +1,205 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/logger/async_log_writer.h"
+
+#include <algorithm>
+#include <ostream>
+
+#include "mongo/logger/rotatable_file_writer.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace logger {
+
+namespace {
+
+AtomicUInt64 nextWriterId;
+
+// The buffers this thread has registered with each writer it has logged to. A thread logs to very
+// few writers, so these are searched linearly.
+struct ThreadBufferRegistration {
+    std::uint64_t writerId;
+    std::shared_ptr<void> buffer;
+};
+thread_local std::vector<ThreadBufferRegistration> threadBufferRegistrations;
+
+}  // namespace
+
+constexpr Milliseconds AsyncLogWriter::kDrainInterval;
+
+AsyncLogWriter::AsyncLogWriter(RotatableFileWriter* writer, size_t maxBufferedBytesPerThread)
+    : _id(nextWriterId.fetchAndAdd(1)),
+      _writer(writer),
+      _maxBufferedBytesPerThread(maxBufferedBytesPerThread) {}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    shutdown();
+}
+
+void AsyncLogWriter::startup() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    invariant(!_thread.joinable() && !_shutdown);
+    _thread = stdx::thread([this] { _drainLoop(); });
+}
+
+void AsyncLogWriter::shutdown() {
+    stdx::thread thread;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _shutdown = true;
+        thread = std::move(_thread);
+    }
+    _shutdownCondition.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+
+    // Lines appended from here on are written synchronously, after whatever was still buffered.
+    _synchronous.store(true);
+    stdx::lock_guard<stdx::mutex> writeLk(_writeMutex);
+    _writeBuffered(writeLk).ignore();
+}
+
+bool AsyncLogWriter::append(StringData line) {
+    if (_synchronous.load()) {
+        stdx::lock_guard<stdx::mutex> writeLk(_writeMutex);
+        RotatableFileWriter::Use useWriter(_writer);
+        Status status = useWriter.status();
+        if (status.isOK()) {
+            useWriter.stream().write(line.rawData(), line.size()).flush();
+            status = useWriter.status();
+        }
+        if (!status.isOK()) {
+            _failedWrites.fetchAndAdd(1);
+        }
+        return true;
+    }
+
+    ThreadBuffer* buffer = _getThreadBuffer();
+    stdx::lock_guard<stdx::mutex> lk(buffer->mutex);
+    if (buffer->lines.size() + line.size() > _maxBufferedBytesPerThread) {
+        _droppedLines.fetchAndAdd(1);
+        return false;
+    }
+    buffer->lines.append(line.rawData(), line.size());
+    return true;
+}
+
+Status AsyncLogWriter::flush() {
+    stdx::lock_guard<stdx::mutex> writeLk(_writeMutex);
+    return _writeBuffered(writeLk);
+}
+
+AsyncLogWriter::ThreadBuffer* AsyncLogWriter::_getThreadBuffer() {
+    for (auto&& registration : threadBufferRegistrations) {
+        if (registration.writerId == _id) {
+            return static_cast<ThreadBuffer*>(registration.buffer.get());
+        }
+    }
+
+    // The buffer is shared with the writer so that lines buffered by a thread which exits are
+    // still written.
+    auto buffer = std::make_shared<ThreadBuffer>();
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _buffers.push_back(buffer);
+    }
+    threadBufferRegistrations.push_back({_id, buffer});
+    return buffer.get();
+}
+
+void AsyncLogWriter::_drainLoop() {
+    setThreadName("AsyncLogWriter");
+
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    while (!_shutdown) {
+        _shutdownCondition.wait_for(
+            lk, kDrainInterval.toSystemDuration(), [&] { return _shutdown; });
+
+        lk.unlock();
+        flush().ignore();
+        lk.lock();
+    }
+}
+
+Status AsyncLogWriter::_writeBuffered(WithLock) {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        // Forget the buffers of threads which have exited once their last lines are written.
+        _buffers.erase(std::remove_if(_buffers.begin(),
+                                      _buffers.end(),
+                                      [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                                          stdx::lock_guard<stdx::mutex> bufferLk(buffer->mutex);
+                                          return buffer.use_count() == 1 && buffer->lines.empty();
+                                      }),
+                       _buffers.end());
+        buffers = _buffers;
+    }
+
+    const long long droppedLines = _droppedLines.load();
+    bool wroteAny = false;
+    RotatableFileWriter::Use useWriter(_writer);
+    Status status = useWriter.status();
+    for (auto&& buffer : buffers) {
+        {
+            stdx::lock_guard<stdx::mutex> bufferLk(buffer->mutex);
+            buffer->lines.swap(_spare);
+        }
+        if (status.isOK() && !_spare.empty()) {
+            useWriter.stream().write(_spare.data(), _spare.size());
+            wroteAny = true;
+        }
+        _spare.clear();
+    }
+
+    if (status.isOK() && droppedLines != _droppedLinesReported) {
+        useWriter.stream() << (droppedLines - _droppedLinesReported)
+                           << " log lines were dropped because the log could not be written as "
+                              "quickly as they were logged"
+                           << std::endl;
+        _droppedLinesReported = droppedLines;
+        wroteAny = true;
+    }
+
+    if (status.isOK() && wroteAny) {
+        useWriter.stream().flush();
+        status = useWriter.status();
+    }
+    if (!status.isOK()) {
+        _failedWrites.fetchAndAdd(1);
+    }
+    return status;
+}
+
+}  // namespace logger
+}  // namespace mongo
@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
+#include "mongo/base/string_data.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+namespace logger {
+
+class RotatableFileWriter;
+
+/**
+ * Writes formatted log lines to a RotatableFileWriter from a background thread, so that the
+ * threads which log never wait on the file.
+ *
+ * Each logging thread appends its lines to a buffer of its own, which the background thread swaps
+ * out and writes every drain interval. A thread whose buffer already holds the configured maximum
+ * number of bytes drops the line and counts it rather than waiting, so a stalled disk can never
+ * block logging. Lines from one thread are written in the order they were appended; lines from
+ * different threads may be interleaved out of timestamp order.
+ */
+class AsyncLogWriter {
+    MONGO_DISALLOW_COPYING(AsyncLogWriter);
+
+public:
+    static constexpr Milliseconds kDrainInterval{100};
+
+    /**
+     * Constructs a writer for "writer", which must outlive it. Lines are only written by the
+     * background thread once startup() has been called, or by flush().
+     */
+    AsyncLogWriter(RotatableFileWriter* writer, size_t maxBufferedBytesPerThread);
+    ~AsyncLogWriter();
+
+    /**
+     * Starts the background thread.
+     */
+    void startup();
+
+    /**
+     * Writes every buffered line and stops the background thread. Lines appended afterwards are
+     * written synchronously.
+     */
+    void shutdown();
+
+    /**
+     * Buffers "line", which should include its trailing newline, for writing. Returns false if it
+     * was dropped because the calling thread's buffer is full.
+     */
+    bool append(StringData line);
+
+    /**
+     * Writes every line buffered by any thread before returning, along with a note of how many
+     * lines were dropped since the last write.
+     */
+    Status flush();
+
+    /**
+     * Returns the number of lines dropped because their thread's buffer was full.
+     */
+    long long getDroppedLines() const {
+        return _droppedLines.load();
+    }
+
+    /**
+     * Returns the number of times writing buffered lines to the file failed.
+     */
+    long long getFailedWrites() const {
+        return _failedWrites.load();
+    }
+
+private:
+    struct ThreadBuffer {
+        stdx::mutex mutex;
+        std::string lines;
+    };
+
+    ThreadBuffer* _getThreadBuffer();
+
+    void _drainLoop();
+
+    /**
+     * Swaps out and writes the contents of every thread's buffer. Must hold _writeMutex.
+     */
+    Status _writeBuffered(WithLock);
+
+    // Distinguishes this writer in the thread-local registrations of each thread's buffer, since
+    // the addresses of destroyed writers may be reused.
+    const std::uint64_t _id;
+    RotatableFileWriter* const _writer;
+    const size_t _maxBufferedBytesPerThread;
+
+    // Guards _buffers, _shutdown and the background thread.
+    stdx::mutex _mutex;
+    stdx::condition_variable _shutdownCondition;
+    std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+    bool _shutdown = false;
+    stdx::thread _thread;
+
+    // Serializes writing the buffered lines between the background thread and flush(). Taken
+    // before _mutex when both are held.
+    stdx::mutex _writeMutex;
+    // The buffer that each thread's lines are swapped into for writing, kept to reuse its memory.
+    std::string _spare;
+    long long _droppedLinesReported = 0;
+
+    AtomicWord<bool> _synchronous{false};
+    AtomicInt64 _droppedLines;
+    AtomicInt64 _failedWrites;
+};
+
+}  // namespace logger
+}  // namespace mongo
@@ -0,0 +1,147 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "mongo/logger/async_log_writer.h"
+#include "mongo/logger/rotatable_file_writer.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace {
+using namespace mongo;
+using namespace mongo::logger;
+
+const std::string logFileName("LogTest_AsyncLogWriter.txt");
+
+class AsyncLogWriterTest : public mongo::unittest::Test {
+public:
+    AsyncLogWriterTest() {
+        unlink(logFileName.c_str());
+        ASSERT_OK(RotatableFileWriter::Use(&_fileWriter).setFileName(logFileName, false));
+    }
+
+    virtual ~AsyncLogWriterTest() {
+        unlink(logFileName.c_str());
+    }
+
+protected:
+    std::vector<std::string> readLines() {
+        std::ifstream ifs(logFileName.c_str());
+        ASSERT_TRUE(ifs.is_open());
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(ifs, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    RotatableFileWriter _fileWriter;
+};
+
+TEST_F(AsyncLogWriterTest, WritesEachThreadsLinesInOrder) {
+    const int kNumThreads = 4;
+    const int kLinesPerThread = 1000;
+
+    AsyncLogWriter writer(&_fileWriter, 1024 * 1024);
+    writer.startup();
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kNumThreads; i++) {
+        threads.emplace_back([&writer, i] {
+            for (int j = 0; j < kLinesPerThread; j++) {
+                ASSERT_TRUE(writer.append(str::stream() << i << " " << j << "\n"));
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    writer.shutdown();
+
+    std::vector<int> nextLine(kNumThreads, 0);
+    for (auto&& line : readLines()) {
+        const int thread = std::stoi(line);
+        ASSERT_EQUALS(line, str::stream() << thread << " " << nextLine[thread]++);
+    }
+    for (int i = 0; i < kNumThreads; i++) {
+        ASSERT_EQUALS(nextLine[i], kLinesPerThread);
+    }
+    ASSERT_EQUALS(writer.getDroppedLines(), 0);
+    ASSERT_EQUALS(writer.getFailedWrites(), 0);
+}
+
+TEST_F(AsyncLogWriterTest, DropsLinesWhenThreadBufferIsFull) {
+    // Without the background thread running, lines are only written by flush().
+    AsyncLogWriter writer(&_fileWriter, 16);
+    ASSERT_TRUE(writer.append("first line\n"));
+    ASSERT_FALSE(writer.append("second line\n"));
+    ASSERT_FALSE(writer.append("third line\n"));
+    ASSERT_EQUALS(writer.getDroppedLines(), 2);
+
+    // Writing the buffered lines makes room again, and notes how many lines were dropped.
+    ASSERT_OK(writer.flush());
+    ASSERT_TRUE(writer.append("fourth line\n"));
+    ASSERT_OK(writer.flush());
+
+    const auto lines = readLines();
+    ASSERT_EQUALS(lines.size(), 3U);
+    ASSERT_EQUALS(lines[0], "first line");
+    ASSERT_EQUALS(lines[1].find("2 log lines were dropped"), 0U);
+    ASSERT_EQUALS(lines[2], "fourth line");
+}
+
+TEST_F(AsyncLogWriterTest, WritesLinesOfExitedThreads) {
+    AsyncLogWriter writer(&_fileWriter, 1024);
+    stdx::thread([&writer] { ASSERT_TRUE(writer.append("from an exited thread\n")); }).join();
+    ASSERT_OK(writer.flush());
+
+    const auto lines = readLines();
+    ASSERT_EQUALS(lines.size(), 1U);
+    ASSERT_EQUALS(lines[0], "from an exited thread");
+}
+
+TEST_F(AsyncLogWriterTest, WritesSynchronouslyAfterShutdown) {
+    AsyncLogWriter writer(&_fileWriter, 1024);
+    writer.startup();
+    ASSERT_TRUE(writer.append("buffered\n"));
+    writer.shutdown();
+    ASSERT_TRUE(writer.append("synchronous\n"));
+
+    const auto lines = readLines();
+    ASSERT_EQUALS(lines.size(), 2U);
+    ASSERT_EQUALS(lines[0], "buffered");
+    ASSERT_EQUALS(lines[1], "synchronous");
+}
+
+}  // namespace
@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <sstream>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
+#include "mongo/logger/appender.h"
+#include "mongo/logger/async_log_writer.h"
+#include "mongo/logger/encoder.h"
+#include "mongo/logger/log_severity.h"
+
+namespace mongo {
+namespace logger {
+
+/**
+ * Appender for writing to a RotatableFileWriter through an AsyncLogWriter.
+ *
+ * Events are encoded on the logging thread and handed to the AsyncLogWriter, which may drop them
+ * rather than wait when the file falls behind. Severe events additionally flush everything
+ * buffered before returning, since they commonly precede the process exiting.
+ */
+template <typename Event>
+class AsyncRotatableFileAppender : public Appender<Event> {
+    MONGO_DISALLOW_COPYING(AsyncRotatableFileAppender);
+
+public:
+    typedef Encoder<Event> EventEncoder;
+
+    /**
+     * Constructs an appender, that owns "encoder", but not "writer."  Caller must
+     * keep "writer" in scope at least as long as the constructed appender.
+     */
+    AsyncRotatableFileAppender(std::unique_ptr<EventEncoder> encoder, AsyncLogWriter* writer)
+        : _encoder(std::move(encoder)), _writer(writer) {}
+
+    Status append(const Event& event) override {
+        std::ostringstream os;
+        _encoder->encode(event, os);
+        _writer->append(os.str());
+        if (event.getSeverity() >= LogSeverity::Severe()) {
+            return _writer->flush();
+        }
+        return Status::OK();
+    }
+
+private:
+    std::unique_ptr<EventEncoder> _encoder;
+    AsyncLogWriter* _writer;
+};
+
+}  // namespace logger
+}  // namespace mongo
@@ -34,6 +34,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -173,13 +174,139 @@ BID_UINT128 decimal128ToLibraryType(Decimal128::Value value) {
     dec128.w[kHigh64] = value.high64;
     return dec128;
 }
+
+/**
+ * A finite decimal in the canonical encoding whose coefficient fits in 64 bits, which covers
+ * typical decimal data such as prices and quantities of up to 19 digits. Arithmetic on such values
+ * is often exact, in which case its IEEE 754 result is computed here directly rather than by the
+ * Intel library.
+ */
+struct SmallDecimal {
+    bool negative;
+    std::int32_t biasedExponent;
+    std::uint64_t coefficient;
+};
+
+const std::uint64_t kPowersOfTen[] = {1ull,
+                                      10ull,
+                                      100ull,
+                                      1000ull,
+                                      10000ull,
+                                      100000ull,
+                                      1000000ull,
+                                      10000000ull,
+                                      100000000ull,
+                                      1000000000ull,
+                                      10000000000ull,
+                                      100000000000ull,
+                                      1000000000000ull,
+                                      10000000000000ull,
+                                      100000000000000ull,
+                                      1000000000000000ull,
+                                      10000000000000000ull,
+                                      100000000000000000ull,
+                                      1000000000000000000ull,
+                                      10000000000000000000ull};
+
+bool toSmallDecimal(const Decimal128::Value& value, SmallDecimal* small) {
+    // The top two bits of the combination field are both set for NaN, infinity and the
+    // non-canonical encoding of large coefficients.
+    if (((value.high64 >> 61) & 3) == 3) {
+        return false;
+    }
+    // The high 49 bits of the coefficient must be clear.
+    if (value.high64 & ((1ull << 49) - 1)) {
+        return false;
+    }
+    small->negative = value.high64 >> 63;
+    small->biasedExponent = (value.high64 >> 49) & ((1 << 14) - 1);
+    small->coefficient = value.low64;
+    return true;
+}
+
+Decimal128 fromSmallDecimal(bool negative, std::int32_t biasedExponent, std::uint64_t coefficient) {
+    return Decimal128(negative, biasedExponent, 0, coefficient);
+}
+
+/**
+ * Computes lhs + rhs if the sum is exact in 64 bits. The result then takes the smaller of the two
+ * exponents, as IEEE 754 prefers for exact sums, and needs no rounding.
+ */
+bool addSmallDecimals(const SmallDecimal& lhs,
+                      const SmallDecimal& rhs,
+                      Decimal128::RoundingMode roundMode,
+                      Decimal128* result) {
+    const SmallDecimal& larger = lhs.biasedExponent >= rhs.biasedExponent ? lhs : rhs;
+    const SmallDecimal& smaller = lhs.biasedExponent >= rhs.biasedExponent ? rhs : lhs;
+
+    // Aligns the coefficient with the larger exponent to the smaller exponent.
+    std::uint64_t scaled = 0;
+    if (larger.coefficient != 0) {
+        const std::int32_t shift = larger.biasedExponent - smaller.biasedExponent;
+        if (shift >= static_cast<std::int32_t>(sizeof(kPowersOfTen) / sizeof(kPowersOfTen[0])) ||
+            larger.coefficient > std::numeric_limits<std::uint64_t>::max() / kPowersOfTen[shift]) {
+            return false;
+        }
+        scaled = larger.coefficient * kPowersOfTen[shift];
+    }
+
+    bool negative;
+    std::uint64_t coefficient;
+    if (larger.negative == smaller.negative) {
+        coefficient = scaled + smaller.coefficient;
+        if (coefficient < scaled) {
+            return false;
+        }
+        negative = larger.negative;
+    } else if (scaled >= smaller.coefficient) {
+        coefficient = scaled - smaller.coefficient;
+        negative = larger.negative;
+    } else {
+        coefficient = smaller.coefficient - scaled;
+        negative = smaller.negative;
+    }
+
+    // An exact zero sum of operands with opposite signs is negative only when rounding down.
+    if (coefficient == 0 && larger.negative != smaller.negative) {
+        negative = roundMode == Decimal128::kRoundTowardNegative;
+    }
+
+    *result = fromSmallDecimal(negative, smaller.biasedExponent, coefficient);
+    return true;
+}
+
+/**
+ * Computes lhs * rhs if the product is exact in 64 bits and its exponent, the sum of the operands'
+ * exponents, is in range.
+ */
+bool multiplySmallDecimals(const SmallDecimal& lhs, const SmallDecimal& rhs, Decimal128* result) {
+    if (lhs.coefficient != 0 &&
+        rhs.coefficient > std::numeric_limits<std::uint64_t>::max() / lhs.coefficient) {
+        return false;
+    }
+    const std::int32_t biasedExponent =
+        lhs.biasedExponent + rhs.biasedExponent - Decimal128::kExponentBias;
+    if (biasedExponent < 0 ||
+        biasedExponent > static_cast<std::int32_t>(Decimal128::kMaxBiasedExponent)) {
+        return false;
+    }
+    *result = fromSmallDecimal(
+        lhs.negative != rhs.negative, biasedExponent, lhs.coefficient * rhs.coefficient);
+    return true;
+}
 }  // namespace
 
 Decimal128::Decimal128(std::int32_t int32Value)
-    : _value(libraryTypeToValue(bid128_from_int32(int32Value))) {}
+    : Decimal128(static_cast<std::int64_t>(int32Value)) {}
 
-Decimal128::Decimal128(std::int64_t int64Value)
-    : _value(libraryTypeToValue(bid128_from_int64(int64Value))) {}
+Decimal128::Decimal128(std::int64_t int64Value) {
+    // An integer is its own coefficient with an exponent of zero. The negation is done unsigned so
+    // that it also holds the magnitude of the smallest int64_t.
+    const bool negative = int64Value < 0;
+    const std::uint64_t magnitude = negative ? ~static_cast<std::uint64_t>(int64Value) + 1
+                                             : static_cast<std::uint64_t>(int64Value);
+    _value = fromSmallDecimal(negative, kExponentBias, magnitude)._value;
+}
 
 /**
  * Quantize a doubleValue argument to a Decimal128 with exactly 15 digits
@@ -565,6 +692,14 @@ Decimal128 Decimal128::add(const Decimal128& other, RoundingMode roundMode) cons
 Decimal128 Decimal128::add(const Decimal128& other,
                            std::uint32_t* signalingFlags,
                            RoundingMode roundMode) const {
+    SmallDecimal lhs;
+    SmallDecimal rhs;
+    Decimal128 exactResult;
+    if (toSmallDecimal(_value, &lhs) && toSmallDecimal(other._value, &rhs) &&
+        addSmallDecimals(lhs, rhs, roundMode, &exactResult)) {
+        return exactResult;
+    }
+
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 addend = decimal128ToLibraryType(other.getValue());
     current = bid128_add(current, addend, roundMode, signalingFlags);
@@ -581,6 +716,16 @@ Decimal128 Decimal128::subtract(const Decimal128& other, RoundingMode roundMode)
 Decimal128 Decimal128::subtract(const Decimal128& other,
                                 std::uint32_t* signalingFlags,
                                 RoundingMode roundMode) const {
+    SmallDecimal lhs;
+    SmallDecimal rhs;
+    Decimal128 exactResult;
+    if (toSmallDecimal(_value, &lhs) && toSmallDecimal(other._value, &rhs)) {
+        rhs.negative = !rhs.negative;
+        if (addSmallDecimals(lhs, rhs, roundMode, &exactResult)) {
+            return exactResult;
+        }
+    }
+
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 sub = decimal128ToLibraryType(other.getValue());
     current = bid128_sub(current, sub, roundMode, signalingFlags);
@@ -597,6 +742,14 @@ Decimal128 Decimal128::multiply(const Decimal128& other, RoundingMode roundMode)
 Decimal128 Decimal128::multiply(const Decimal128& other,
                                 std::uint32_t* signalingFlags,
                                 RoundingMode roundMode) const {
+    SmallDecimal lhs;
+    SmallDecimal rhs;
+    Decimal128 exactResult;
+    if (toSmallDecimal(_value, &lhs) && toSmallDecimal(other._value, &rhs) &&
+        multiplySmallDecimals(lhs, rhs, &exactResult)) {
+        return exactResult;
+    }
+
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 factor = decimal128ToLibraryType(other.getValue());
     current = bid128_mul(current, factor, roundMode, signalingFlags);
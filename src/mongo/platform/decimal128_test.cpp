@@ -1045,6 +1045,69 @@ TEST(Decimal128Test, TestDecimal128MultiplicationCase2) {
     ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
 }
 
+TEST(Decimal128Test, TestDecimal128AdditionCoefficientCarriesPast64Bits) {
+    Decimal128 d1("18446744073709551615");
+    Decimal128 d2("1");
+    Decimal128 result = d1.add(d2);
+    Decimal128 expected("18446744073709551616");
+    ASSERT_EQUALS(result.getValue().low64, expected.getValue().low64);
+    ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
+}
+
+TEST(Decimal128Test, TestDecimal128AdditionDistantExponentsRounds) {
+    Decimal128 d1("1E30");
+    Decimal128 d2("1E-30");
+    uint32_t sigFlags = Decimal128::SignalingFlag::kNoFlag;
+    Decimal128 result = d1.add(d2, &sigFlags);
+    Decimal128 expected("1.000000000000000000000000000000000E30");
+    ASSERT_EQUALS(result.getValue().low64, expected.getValue().low64);
+    ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
+    ASSERT_TRUE(Decimal128::hasFlag(sigFlags, Decimal128::SignalingFlag::kInexact));
+}
+
+TEST(Decimal128Test, TestDecimal128AdditionOfZeroKeepsSmallerExponent) {
+    Decimal128 d1("0E40");
+    Decimal128 d2("-1.5");
+    Decimal128 result = d1.add(d2);
+    Decimal128 expected("-1.5");
+    ASSERT_EQUALS(result.getValue().low64, expected.getValue().low64);
+    ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
+}
+
+TEST(Decimal128Test, TestDecimal128SubtractionToZeroSignDependsOnRounding) {
+    Decimal128 d1("1.50");
+    Decimal128 d2("1.5");
+    uint32_t sigFlags = Decimal128::SignalingFlag::kNoFlag;
+    Decimal128 result = d1.subtract(d2, &sigFlags, Decimal128::kRoundTiesToEven);
+    Decimal128 expected("0.00");
+    ASSERT_EQUALS(result.getValue().low64, expected.getValue().low64);
+    ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
+
+    result = d1.subtract(d2, &sigFlags, Decimal128::kRoundTowardNegative);
+    expected = Decimal128("-0.00");
+    ASSERT_EQUALS(result.getValue().low64, expected.getValue().low64);
+    ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
+    ASSERT_EQUALS(sigFlags, Decimal128::SignalingFlag::kNoFlag);
+}
+
+TEST(Decimal128Test, TestDecimal128MultiplicationCoefficientPast64Bits) {
+    Decimal128 d1("4294967296");
+    Decimal128 d2("-4294967296.0");
+    Decimal128 result = d1.multiply(d2);
+    Decimal128 expected("-18446744073709551616.0");
+    ASSERT_EQUALS(result.getValue().low64, expected.getValue().low64);
+    ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
+}
+
+TEST(Decimal128Test, TestDecimal128MultiplicationExponentUnderflows) {
+    Decimal128 d1("1E-6000");
+    Decimal128 d2("1E-200");
+    uint32_t sigFlags = Decimal128::SignalingFlag::kNoFlag;
+    Decimal128 result = d1.multiply(d2, &sigFlags);
+    ASSERT_TRUE(result.isZero());
+    ASSERT_TRUE(Decimal128::hasFlag(sigFlags, Decimal128::SignalingFlag::kUnderflow));
+}
+
 TEST(Decimal128Test, TestDecimal128DivisionCase1) {
     Decimal128 d1("25.05E20");
     Decimal128 d2("-50.5218E19");
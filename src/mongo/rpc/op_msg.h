@@ -320,6 +320,13 @@ public:
         return BSONObjBuilder(*_buf);
     }
 
+    /**
+     * Returns the buffer this sequence is being built in.
+     */
+    BufBuilder& bb() {
+        return *_buf;
+    }
+
     int len() const {
         return _buf->len();
     }
@@ -33,11 +33,14 @@
 #include "mongo/s/async_requests_sender.h"
 
 #include "mongo/client/remote_command_targeter.h"
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/db/query/killcursors_request.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
+#include "mongo/s/hedged_read_latency_tracker.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/baton.h"
 #include "mongo/transport/transport_layer.h"
@@ -49,11 +52,49 @@ namespace mongo {
 
 MONGO_EXPORT_SERVER_PARAMETER(AsyncRequestsSenderUseBaton, bool, true);
 
+// Whether reads which may run on secondaries are sent to a second host when the first one is slow.
+MONGO_EXPORT_SERVER_PARAMETER(readHedgingEnabled, bool, false);
+
+// The percentile of the recent latencies of a shard after which a read to it is hedged.
+MONGO_EXPORT_SERVER_PARAMETER(readHedgingDelayPercentile, int, 95)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 100) {
+            return Status(ErrorCodes::BadValue,
+                          "readHedgingDelayPercentile must be between 1 and 100");
+        }
+        return Status::OK();
+    });
+
+// The minimum time to wait for a read before hedging it, however fast the shard usually answers.
+MONGO_EXPORT_SERVER_PARAMETER(readHedgingMinDelayMS, int, 5)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue, "readHedgingMinDelayMS must not be negative");
+        }
+        return Status::OK();
+    });
+
 namespace {
 
 // Maximum number of retries for network and replication notMaster errors (per host).
 const int kMaxNumFailedHostRetryAttempts = 3;
 
+// Maximum number of times the targeter is asked for a host other than the one the request was
+// sent to, when hedging it.
+const int kMaxHedgedHostSelectionAttempts = 3;
+
+/**
+ * Returns whether the command only reads, and has no effect other than the results it returns and,
+ * for find, the cursor it establishes, so that it is safe to send it to two hosts at once.
+ */
+bool isHedgeableCommand(const BSONObj& cmdObj) {
+    const auto cmdName = cmdObj.firstElementFieldName();
+    if (cmdName == StringData("find")) {
+        return !cmdObj["tailable"].trueValue();
+    }
+    return cmdName == StringData("count") || cmdName == StringData("distinct");
+}
+
 }  // namespace
 
 AsyncRequestsSender::AsyncRequestsSender(OperationContext* opCtx,
@@ -76,6 +117,12 @@ AsyncRequestsSender::AsyncRequestsSender(OperationContext* opCtx,
     // Initialize command metadata to handle the read preference.
     _metadataObj = readPreference.toContainingBSON();
 
+    _hedgeReads = readHedgingEnabled.load() && readPreference.pref != ReadPreference::PrimaryOnly &&
+        retryPolicy == Shard::RetryPolicy::kIdempotent &&
+        std::all_of(requests.begin(), requests.end(), [](const Request& request) {
+                      return isHedgeableCommand(request.cmdObj);
+                  });
+
     // Schedule the requests immediately.
     _scheduleRequests();
 }
@@ -87,6 +134,11 @@ AsyncRequestsSender::~AsyncRequestsSender() {
     while (!done()) {
         next();
     }
+
+    // The losing requests of hedged reads, which were canceled, may still call back into the ARS.
+    while (_hasOutstandingHedgedRequests()) {
+        _opCtx->runWithoutInterruption([&] { _makeProgress(); });
+    }
 }
 
 AsyncRequestsSender::Response AsyncRequestsSender::next() {
@@ -118,6 +170,21 @@ void AsyncRequestsSender::stopRetrying() {
     _stopRetrying = true;
 }
 
+void AsyncRequestsSender::addRequests(const std::vector<AsyncRequestsSender::Request>& requests) {
+    invariant(!_stopRetrying);
+
+    for (const auto& request : requests) {
+        _remotes.emplace_back(request.shardId, request.cmdObj);
+    }
+
+    _hedgeReads = _hedgeReads &&
+        std::all_of(requests.begin(), requests.end(), [](const Request& request) {
+                      return isHedgeableCommand(request.cmdObj);
+                  });
+
+    _scheduleRequests();
+}
+
 bool AsyncRequestsSender::done() {
     return std::all_of(
         _remotes.begin(), _remotes.end(), [](const RemoteData& remote) { return remote.done; });
@@ -131,6 +198,9 @@ void AsyncRequestsSender::_cancelPendingRequests() {
         if (remote.cbHandle.isValid()) {
             _executor->cancel(remote.cbHandle);
         }
+        if (remote.hedgedCbHandle.isValid()) {
+            _executor->cancel(remote.hedgedCbHandle);
+        }
     }
 }
 
@@ -146,7 +216,7 @@ boost::optional<AsyncRequestsSender::Response> AsyncRequestsSender::_ready() {
             remote.done = true;
             if (remote.swResponse->isOK()) {
                 invariant(remote.shardHostAndPort);
-                return Response(std::move(remote.shardId),
+                return Response(remote.shardId,
                                 std::move(remote.swResponse->getValue()),
                                 std::move(*remote.shardHostAndPort));
             } else {
@@ -155,7 +225,7 @@ boost::optional<AsyncRequestsSender::Response> AsyncRequestsSender::_ready() {
                     ErrorCodes::CallbackCanceled == remote.swResponse->getStatus().code()) {
                     remote.swResponse = _interruptStatus;
                 }
-                return Response(std::move(remote.shardId),
+                return Response(remote.shardId,
                                 std::move(remote.swResponse->getStatus()),
                                 std::move(remote.shardHostAndPort));
             }
@@ -205,7 +275,7 @@ void AsyncRequestsSender::_scheduleRequests() {
         }
 
         // If the remote does not have a response or pending request, schedule remote work for it.
-        if (!remote.swResponse && !remote.cbHandle.isValid()) {
+        if (!remote.swResponse && !remote.cbHandle.isValid() && !remote.hedgedCbHandle.isValid()) {
             auto scheduleStatus = _scheduleRequest(i);
             if (!scheduleStatus.isOK()) {
                 remote.swResponse = std::move(scheduleStatus);
@@ -215,6 +285,13 @@ void AsyncRequestsSender::_scheduleRequests() {
                 _responseQueue.push(boost::none);
             }
         }
+
+        // If the pending request has been outstanding for longer than the hedging delay, send it
+        // to a second host as well.
+        if (!remote.swResponse && remote.cbHandle.isValid() && remote.hedgeAt &&
+            *remote.hedgeAt <= Date_t::now()) {
+            _scheduleHedgedRequest(i);
+        }
     }
 }
 
@@ -243,23 +320,208 @@ Status AsyncRequestsSender::_scheduleRequest(size_t remoteIndex) {
     }
 
     remote.cbHandle = callbackStatus.getValue();
+    remote.requestSentAt = Date_t::now();
+    _markOperationStarted(remote, *remote.shardHostAndPort);
+    remote.hedgeAt.reset();
+    remote.hedgedHostAndPort.reset();
+
+    if (_hedgeReads) {
+        // Until enough latencies have been recorded for the shard, there is no telling whether the
+        // request is slow, so it is not hedged.
+        const auto delay = HedgedReadLatencyTracker::get().getPercentile(
+            remote.shardId, readHedgingDelayPercentile.load());
+        if (delay) {
+            remote.hedgeAt = remote.requestSentAt +
+                std::max(*delay, Milliseconds(readHedgingMinDelayMS.load()));
+        }
+    }
+
     return Status::OK();
 }
 
+void AsyncRequestsSender::_scheduleHedgedRequest(size_t remoteIndex) {
+    auto& remote = _remotes[remoteIndex];
+
+    invariant(remote.cbHandle.isValid());
+    invariant(!remote.hedgedCbHandle.isValid());
+    invariant(remote.shardHostAndPort);
+
+    // Requests are hedged at most once.
+    remote.hedgeAt.reset();
+
+    const auto shard = remote.getShard();
+    if (!shard) {
+        return;
+    }
+
+    // The targeter picks at random among the hosts within the latency window, so asking it again
+    // usually returns another one when there is one.
+    boost::optional<HostAndPort> hedgedHost;
+    for (int attempt = 0; attempt < kMaxHedgedHostSelectionAttempts && !hedgedHost; ++attempt) {
+        auto findHostStatus = _opCtx->runWithoutInterruption([&] {
+            return shard->getTargeter()
+                ->findHostWithMaxWait(_readPreference, Milliseconds(0))
+                .getNoThrow(_opCtx);
+        });
+        if (!findHostStatus.isOK()) {
+            return;
+        }
+        if (findHostStatus.getValue() != *remote.shardHostAndPort) {
+            hedgedHost = std::move(findHostStatus.getValue());
+        }
+    }
+
+    if (!hedgedHost) {
+        LOG(2) << "Not hedging the request to remote " << remote.shardId << " at host "
+               << *remote.shardHostAndPort << " because no other host matches the read preference";
+        return;
+    }
+
+    executor::RemoteCommandRequest request(*hedgedHost, _db, remote.cmdObj, _metadataObj, _opCtx);
+
+    auto callbackStatus = _executor->scheduleRemoteCommand(
+        request,
+        [remoteIndex, this](const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData) {
+            _responseQueue.push(Job{cbData, remoteIndex, true});
+        },
+        _baton);
+    if (!callbackStatus.isOK()) {
+        LOG(1) << "Failed to hedge the request to remote " << remote.shardId << " at host "
+               << *remote.shardHostAndPort << causedBy(redact(callbackStatus.getStatus()));
+        return;
+    }
+
+    LOG(1) << "Hedging the request to remote " << remote.shardId << " at host "
+           << *remote.shardHostAndPort << " to host " << *hedgedHost;
+
+    remote.hedgedHostAndPort = std::move(hedgedHost);
+    remote.hedgedCbHandle = callbackStatus.getValue();
+    remote.hedgedRequestSentAt = Date_t::now();
+    _markOperationStarted(remote, *remote.hedgedHostAndPort);
+}
+
+void AsyncRequestsSender::_markOperationStarted(RemoteData& remote, const HostAndPort& host) {
+    if (auto shard = remote.getShard()) {
+        shard->getTargeter()->markOperationStarted(host);
+    }
+}
+
+void AsyncRequestsSender::_markOperationFinished(RemoteData& remote,
+                                                 const HostAndPort& host,
+                                                 Date_t sentAt,
+                                                 const executor::RemoteCommandResponse& response) {
+    if (auto shard = remote.getShard()) {
+        shard->getTargeter()->markOperationFinished(
+            host, response.elapsedMillis.value_or(Date_t::now() - sentAt));
+    }
+}
+
+boost::optional<Date_t> AsyncRequestsSender::_nextHedgeAt() const {
+    boost::optional<Date_t> next;
+    for (const auto& remote : _remotes) {
+        if (remote.hedgeAt && !remote.swResponse && (!next || *remote.hedgeAt < *next)) {
+            next = remote.hedgeAt;
+        }
+    }
+    return next;
+}
+
+bool AsyncRequestsSender::_hasOutstandingHedgedRequests() const {
+    return std::any_of(_remotes.begin(), _remotes.end(), [](const RemoteData& remote) {
+        return remote.cbHandle.isValid() || remote.hedgedCbHandle.isValid();
+    });
+}
+
+void AsyncRequestsSender::_discardHedgeLoser(const HostAndPort& host,
+                                             const executor::RemoteCommandResponse& response) {
+    if (!response.isOK()) {
+        return;
+    }
+
+    auto swCursorResponse = CursorResponse::parseFromBSON(response.data);
+    if (!swCursorResponse.isOK() || !swCursorResponse.getValue().getCursorId()) {
+        return;
+    }
+
+    const auto& cursorResponse = swCursorResponse.getValue();
+    BSONObj cmdObj =
+        KillCursorsRequest(cursorResponse.getNSS(), {cursorResponse.getCursorId()}).toBSON();
+
+    executor::RemoteCommandRequest request(
+        host, cursorResponse.getNSS().db().toString(), cmdObj, nullptr);
+
+    // Send kill request; discard callback handle, if any, or failure report, if not.
+    _executor->scheduleRemoteCommand(request, [](auto const&) {}).getStatus().ignore();
+}
+
 // Passing opCtx means you'd like to opt into opCtx interruption.  During cleanup we actually don't.
 void AsyncRequestsSender::_makeProgress() {
-    auto job = _responseQueue.pop(_opCtx);
+    auto job = [&]() -> boost::optional<Job> {
+        const auto hedgeAt = _nextHedgeAt();
+        if (_stopRetrying || !hedgeAt) {
+            return _responseQueue.pop(_opCtx);
+        }
+
+        try {
+            return _opCtx->runWithDeadline(*hedgeAt, ErrorCodes::ExceededTimeLimit, [&] {
+                return _responseQueue.pop(_opCtx);
+            });
+        } catch (const ExceptionFor<ErrorCodes::ExceededTimeLimit>&) {
+            // Some request is due to be hedged, which the next call to _ready() does.
+            return boost::none;
+        }
+    }();
 
     if (!job) {
         return;
     }
 
     auto& remote = _remotes[job->remoteIndex];
-    invariant(!remote.swResponse);
 
     // Clear the callback handle. This indicates that we are no longer waiting on a response from
-    // 'remote'.
-    remote.cbHandle = executor::TaskExecutor::CallbackHandle();
+    // 'remote' to this request.
+    auto& cbHandle = job->hedged ? remote.hedgedCbHandle : remote.cbHandle;
+    auto& otherCbHandle = job->hedged ? remote.cbHandle : remote.hedgedCbHandle;
+    cbHandle = executor::TaskExecutor::CallbackHandle();
+
+    _markOperationFinished(remote,
+                           job->cbData.request.target,
+                           job->hedged ? remote.hedgedRequestSentAt : remote.requestSentAt,
+                           job->cbData.response);
+
+    if (remote.swResponse || remote.done) {
+        // The other request of this hedged read was answered first.
+        _discardHedgeLoser(job->cbData.request.target, job->cbData.response);
+        return;
+    }
+
+    if (otherCbHandle.isValid()) {
+        Status status = job->cbData.response.status;
+        if (status.isOK()) {
+            status = getStatusFromCommandResult(job->cbData.response.data);
+        }
+
+        // Rather than failing the read, or retrying it, wait for the other request of the hedged
+        // read, which may yet succeed.
+        if (!status.isOK()) {
+            LOG(1) << "Hedged request to remote " << remote.shardId << " at host "
+                   << job->cbData.request.target << " failed " << causedBy(redact(status));
+            return;
+        }
+
+        _executor->cancel(otherCbHandle);
+    }
+
+    // Track the latency of the read as seen from here, including any hedging delay.
+    if (_hedgeReads && job->cbData.response.isOK()) {
+        HedgedReadLatencyTracker::get().recordLatency(remote.shardId,
+                                                      Date_t::now() - remote.requestSentAt);
+    }
+
+    if (job->hedged) {
+        remote.shardHostAndPort = job->cbData.request.target;
+    }
+    remote.hedgeAt.reset();
 
     // Store the response or error.
     if (job->cbData.response.status.isOK()) {
@@ -77,6 +77,11 @@ namespace mongo {
  *     }
  * }
  *
+ * Reads which may run on secondaries can be hedged, by setting the 'readHedgingEnabled' server
+ * parameter: a request which has not been answered after the given percentile of the recent
+ * latencies of its shard is sent again to another eligible host, and whichever of the two requests
+ * answers first is returned while the other one is canceled.
+ *
  * Does not throw exceptions.
  */
 class AsyncRequestsSender {
@@ -159,6 +164,15 @@ public:
      */
     void stopRetrying();
 
+    /**
+     * Sends additional requests, whose responses are returned via next() like those of the
+     * requests the ARS was constructed with. This allows a caller to send a follow-up request to a
+     * remote as soon as it has answered, without waiting for the other remotes.
+     *
+     * Invalid to call once stopRetrying() has been called or the operation has been interrupted.
+     */
+    void addRequests(const std::vector<AsyncRequestsSender::Request>& requests);
+
 private:
     /**
      * We instantiate one of these per remote host.
@@ -200,6 +214,19 @@ private:
         // The callback handle to an outstanding request for this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
+        // When the outstanding request was sent.
+        Date_t requestSentAt;
+
+        // When to send the hedged request for the outstanding request, if it is to be hedged and
+        // the hedged request has not been sent yet.
+        boost::optional<Date_t> hedgeAt;
+
+        // The host to which the hedged request was sent, and the callback handle to it while it is
+        // outstanding.
+        boost::optional<HostAndPort> hedgedHostAndPort;
+        executor::TaskExecutor::CallbackHandle hedgedCbHandle;
+        Date_t hedgedRequestSentAt;
+
         // Whether this remote's result has been returned.
         bool done = false;
     };
@@ -211,6 +238,9 @@ private:
     struct Job {
         executor::TaskExecutor::RemoteCommandCallbackArgs cbData;
         size_t remoteIndex;
+
+        // Whether this is the response to the hedged request of the remote.
+        bool hedged = false;
     };
 
     /**
@@ -279,6 +309,40 @@ private:
      */
     Status _scheduleRequest(size_t remoteIndex);
 
+    /**
+     * Sends the hedged request of a remote whose request has been outstanding for longer than its
+     * hedging delay, to another host matching the read preference. Does nothing if there is no
+     * such host.
+     */
+    void _scheduleHedgedRequest(size_t remoteIndex);
+
+    /**
+     * Reports to the targeter of the remote's shard that a request was sent to 'host', or that one
+     * sent to it at 'sentAt' was answered with 'response', for it to balance reads across hosts.
+     */
+    void _markOperationStarted(RemoteData& remote, const HostAndPort& host);
+    void _markOperationFinished(RemoteData& remote,
+                                const HostAndPort& host,
+                                Date_t sentAt,
+                                const executor::RemoteCommandResponse& response);
+
+    /**
+     * Returns the earliest time at which an outstanding request is due to be hedged, if any.
+     */
+    boost::optional<Date_t> _nextHedgeAt() const;
+
+    /**
+     * Returns true if the losing request of some hedged read has not called back yet.
+     */
+    bool _hasOutstandingHedgedRequests() const;
+
+    /**
+     * Releases the resources held by 'response', the late response of the losing request of a
+     * hedged read to 'host', by killing the cursor it may have established.
+     */
+    void _discardHedgeLoser(const HostAndPort& host,
+                            const executor::RemoteCommandResponse& response);
+
     /**
      * Waits for forward progress in gathering responses from a remote.
      *
@@ -323,6 +387,9 @@ private:
     // Used to determine if the ARS should attempt to retry any requests. Is set to true when
     // stopRetrying() or cancelPendingRequests() is called.
     bool _stopRetrying = false;
+
+    // Whether the requests are reads which may be hedged.
+    bool _hedgeReads = false;
 };
 
 }  // namespace mongo
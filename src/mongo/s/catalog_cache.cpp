@@ -178,31 +178,20 @@ StatusWith<CachedDatabaseInfo> CatalogCache::getDatabase(OperationContext* opCtx
 
 StatusWith<CachedCollectionRoutingInfo> CatalogCache::getCollectionRoutingInfo(
     OperationContext* opCtx, const NamespaceString& nss) {
-    return _getCollectionRoutingInfo(opCtx, nss).statusWithInfo;
-}
-
-CatalogCache::RefreshResult CatalogCache::_getCollectionRoutingInfo(OperationContext* opCtx,
-                                                                    const NamespaceString& nss) {
     return _getCollectionRoutingInfoAt(opCtx, nss, boost::none);
 }
 
-
 StatusWith<CachedCollectionRoutingInfo> CatalogCache::getCollectionRoutingInfoAt(
     OperationContext* opCtx, const NamespaceString& nss, Timestamp atClusterTime) {
-    return _getCollectionRoutingInfoAt(opCtx, nss, atClusterTime).statusWithInfo;
+    return _getCollectionRoutingInfoAt(opCtx, nss, atClusterTime);
 }
 
-CatalogCache::RefreshResult CatalogCache::_getCollectionRoutingInfoAt(
+StatusWith<CachedCollectionRoutingInfo> CatalogCache::_getCollectionRoutingInfoAt(
     OperationContext* opCtx, const NamespaceString& nss, boost::optional<Timestamp> atClusterTime) {
-    // This default value can cause a single unnecessary extra refresh if this thread did do the
-    // refresh but the refresh failed, or if the database or collection was not found, but only if
-    // the caller is getCollectionRoutingInfoWithRefresh with the parameter
-    // forceRefreshFromThisThread set to true
-    RefreshAction refreshActionTaken(RefreshAction::kDidNotPerformRefresh);
     while (true) {
         const auto swDbInfo = getDatabase(opCtx, nss.db());
         if (!swDbInfo.isOK()) {
-            return {swDbInfo.getStatus(), refreshActionTaken};
+            return swDbInfo.getStatus();
         }
 
         const auto dbInfo = std::move(swDbInfo.getValue());
@@ -211,12 +200,12 @@ CatalogCache::RefreshResult CatalogCache::_getCollectionRoutingInfoAt(
 
         const auto itDb = _collectionsByDb.find(nss.db());
         if (itDb == _collectionsByDb.end()) {
-            return {CachedCollectionRoutingInfo(nss, dbInfo, nullptr), refreshActionTaken};
+            return CachedCollectionRoutingInfo(nss, dbInfo, nullptr);
         }
 
         const auto itColl = itDb->second.find(nss.ns());
         if (itColl == itDb->second.end()) {
-            return {CachedCollectionRoutingInfo(nss, dbInfo, nullptr), refreshActionTaken};
+            return CachedCollectionRoutingInfo(nss, dbInfo, nullptr);
         }
 
         auto& collEntry = itColl->second;
@@ -227,15 +216,21 @@ CatalogCache::RefreshResult CatalogCache::_getCollectionRoutingInfoAt(
                 refreshNotification = (collEntry->refreshCompletionNotification =
                                            std::make_shared<Notification<Status>>());
                 _scheduleCollectionRefresh(ul, collEntry, nss, 1);
-                refreshActionTaken = RefreshAction::kPerformedRefresh;
             }
 
+            ++collEntry->numRefreshWaiters;
+            _stats.countRefreshWaits.addAndFetch(1);
+
             // Wait on the notification outside of the mutex
             ul.unlock();
 
             auto refreshStatus = [&]() {
                 Timer t;
-                ON_BLOCK_EXIT([&] { _stats.totalRefreshWaitTimeMicros.addAndFetch(t.micros()); });
+                _stats.numActiveRefreshWaiters.addAndFetch(1);
+                ON_BLOCK_EXIT([&] {
+                    _stats.totalRefreshWaitTimeMicros.addAndFetch(t.micros());
+                    _stats.numActiveRefreshWaiters.subtractAndFetch(1);
+                });
 
                 try {
                     const Milliseconds kReportingInterval{250};
@@ -251,7 +246,7 @@ CatalogCache::RefreshResult CatalogCache::_getCollectionRoutingInfoAt(
             }();
 
             if (!refreshStatus.isOK()) {
-                return {refreshStatus, refreshActionTaken};
+                return refreshStatus;
             }
 
             // Once the refresh is complete, loop around to get the latest value
@@ -260,7 +255,7 @@ CatalogCache::RefreshResult CatalogCache::_getCollectionRoutingInfoAt(
 
         auto cm = std::make_shared<ChunkManager>(collEntry->routingInfo, atClusterTime);
 
-        return {CachedCollectionRoutingInfo(nss, dbInfo, std::move(cm)), refreshActionTaken};
+        return CachedCollectionRoutingInfo(nss, dbInfo, std::move(cm));
     }
 }
 
@@ -272,19 +267,14 @@ StatusWith<CachedDatabaseInfo> CatalogCache::getDatabaseWithRefresh(OperationCon
 
 StatusWith<CachedCollectionRoutingInfo> CatalogCache::getCollectionRoutingInfoWithRefresh(
     OperationContext* opCtx, const NamespaceString& nss, bool forceRefreshFromThisThread) {
+    // Joining an in-progress refresh could violate causal consistency for this client, since it
+    // may have read the routing table before the change this client knows about (see
+    // SERVER-33954). Invalidating the entry while a refresh is in progress makes another refresh
+    // follow it, so the routing info returned always comes from a refresh which began *after* this
+    // function is called, and the threads which invalidate the entry at the same time all share
+    // that single refresh rather than each triggering its own.
     invalidateShardedCollection(nss);
-    auto refreshResult = _getCollectionRoutingInfo(opCtx, nss);
-    // We want to ensure that we don't join an in-progress refresh because that
-    // could violate causal consistency for this client. We don't need to actually perform the
-    // refresh ourselves but we do need the refresh to begin *after* this function is
-    // called, so calling it twice is enough regardless of what happens the
-    // second time. See SERVER-33954 for reasoning.
-    if (forceRefreshFromThisThread &&
-        refreshResult.actionTaken == RefreshAction::kDidNotPerformRefresh) {
-        invalidateShardedCollection(nss);
-        refreshResult = _getCollectionRoutingInfo(opCtx, nss);
-    }
-    return refreshResult.statusWithInfo;
+    return getCollectionRoutingInfo(opCtx, nss);
 }
 
 StatusWith<CachedCollectionRoutingInfo> CatalogCache::getShardedCollectionRoutingInfoWithRefresh(
@@ -375,10 +365,44 @@ void CatalogCache::invalidateShardedCollection(const NamespaceString& nss) {
         return;
     }
 
-    if (itDb->second.find(nss.ns()) == itDb->second.end()) {
-        itDb->second[nss.ns()] = std::make_shared<CollectionRoutingInfoEntry>();
+    auto& collEntry = itDb->second[nss.ns()];
+    if (!collEntry) {
+        collEntry = std::make_shared<CollectionRoutingInfoEntry>();
+    }
+
+    collEntry->needsRefresh = true;
+    if (collEntry->refreshCompletionNotification) {
+        collEntry->invalidatedDuringRefresh = true;
     }
-    itDb->second[nss.ns()]->needsRefresh = true;
+}
+
+void CatalogCache::onRoutingTableChangeNotification(const NamespaceString& nss) {
+    stdx::lock_guard<stdx::mutex> lg(_mutex);
+
+    auto itDb = _collectionsByDb.find(nss.db());
+    if (itDb == _collectionsByDb.end()) {
+        return;
+    }
+
+    auto itColl = itDb->second.find(nss.ns());
+    if (itColl == itDb->second.end()) {
+        // The collection is not cached, so it will be loaded with its latest routing table when it
+        // is first used
+        return;
+    }
+
+    auto& collEntry = itColl->second;
+    if (collEntry->refreshCompletionNotification) {
+        // The refresh in progress may have read the routing table before the change
+        collEntry->invalidatedDuringRefresh = true;
+        return;
+    }
+
+    _stats.countRefreshesStartedByChangeNotifications.addAndFetch(1);
+
+    collEntry->needsRefresh = true;
+    collEntry->refreshCompletionNotification = std::make_shared<Notification<Status>>();
+    _scheduleCollectionRefresh(lg, collEntry, nss, 1);
 }
 
 void CatalogCache::purgeDatabase(StringData dbName) {
@@ -550,6 +574,9 @@ void CatalogCache::_scheduleCollectionRefresh(WithLock lk,
         } else {
             // Leave needsRefresh to true so that any subsequent get attempts will kick off
             // another round of refresh
+            collEntry->invalidatedDuringRefresh = false;
+            _stats.noteRefreshWaiters(collEntry->numRefreshWaiters);
+            collEntry->numRefreshWaiters = 0;
             collEntry->refreshCompletionNotification->set(status);
             collEntry->refreshCompletionNotification = nullptr;
         }
@@ -573,7 +600,12 @@ void CatalogCache::_scheduleCollectionRefresh(WithLock lk,
 
         stdx::lock_guard<stdx::mutex> lg(_mutex);
 
-        collEntry->needsRefresh = false;
+        // If the entry was invalidated during the refresh, the first thread to use it next starts
+        // the refresh which follows, and the others share it
+        collEntry->needsRefresh = collEntry->invalidatedDuringRefresh;
+        collEntry->invalidatedDuringRefresh = false;
+        _stats.noteRefreshWaiters(collEntry->numRefreshWaiters);
+        collEntry->numRefreshWaiters = 0;
         collEntry->refreshCompletionNotification->set(Status::OK());
         collEntry->refreshCompletionNotification = nullptr;
 
@@ -611,6 +643,17 @@ void CatalogCache::_scheduleCollectionRefresh(WithLock lk,
     }
 }
 
+void CatalogCache::Stats::noteRefreshWaiters(int64_t numWaiters) {
+    auto max = maxWaitersPerRefresh.load();
+    while (numWaiters > max) {
+        const auto previous = maxWaitersPerRefresh.compareAndSwap(max, numWaiters);
+        if (previous == max) {
+            break;
+        }
+        max = previous;
+    }
+}
+
 void CatalogCache::Stats::report(BSONObjBuilder* builder) const {
     builder->append("countStaleConfigErrors", countStaleConfigErrors.load());
 
@@ -623,6 +666,13 @@ void CatalogCache::Stats::report(BSONObjBuilder* builder) const {
     builder->append("countFullRefreshesStarted", countFullRefreshesStarted.load());
 
     builder->append("countFailedRefreshes", countFailedRefreshes.load());
+
+    builder->append("countRefreshesStartedByChangeNotifications",
+                    countRefreshesStartedByChangeNotifications.load());
+
+    builder->append("countRefreshWaits", countRefreshWaits.load());
+    builder->append("numActiveRefreshWaiters", numActiveRefreshWaiters.load());
+    builder->append("maxWaitersPerRefresh", maxWaitersPerRefresh.load());
 }
 
 CachedDatabaseInfo::CachedDatabaseInfo(DatabaseType dbt, std::shared_ptr<Shard> primaryShard)
@@ -165,15 +165,12 @@ public:
     /**
      * Same as getCollectionRoutingInfo above, but in addition causes the namespace to be refreshed.
      *
-     * When forceRefreshFromThisThread is false, it's possible for this call to
-     * join an ongoing refresh from another thread forceRefreshFromThisThread.
-     * forceRefreshFromThisThread checks whether it joined another thread and
-     * then forces it to try again, which is necessary in cases where calls to
-     * getCollectionRoutingInfoWithRefresh must be causally consistent
+     * The returned routing info always comes from a refresh which was started after this call,
+     * because an invalidation which arrives while a refresh is in progress makes another refresh
+     * follow it. All the threads which invalidated the namespace during the same refresh share the
+     * single refresh which follows it, whether or not forceRefreshFromThisThread is set.
      *
-     * TODO: Remove this parameter in favor of using collection creation time +
-     * collection version to decide when a refresh is necessary and provide
-     * proper causal consistency
+     * TODO: Remove the forceRefreshFromThisThread parameter, which is only kept for its callers
      */
     StatusWith<CachedCollectionRoutingInfo> getCollectionRoutingInfoWithRefresh(
         OperationContext* opCtx,
@@ -216,6 +213,13 @@ public:
      */
     void invalidateShardedCollection(const NamespaceString& nss);
 
+    /**
+     * Non-blocking method, which is called when the routing table of the specified namespace is
+     * known to have changed on the config server. If the collection is cached, starts refreshing
+     * it right away, so that the routing table is usually up to date by the time it is next used.
+     */
+    void onRoutingTableChangeNotification(const NamespaceString& nss);
+
     /**
      * Non-blocking method, which removes the entire specified database (including its collections)
      * from the cache.
@@ -247,9 +251,18 @@ private:
         bool needsRefresh{true};
 
         // Contains a notification to be waited on for the refresh to complete (only available if
-        // needsRefresh is true)
+        // needsRefresh is true). There is a single refresh in progress for a collection at any
+        // time, whose notification is shared by all the threads waiting for it.
         std::shared_ptr<Notification<Status>> refreshCompletionNotification;
 
+        // Set if the entry was invalidated while a refresh was in progress, which may have read
+        // the routing table before the change which caused the invalidation. The entry then still
+        // needs a refresh once the one in progress completes.
+        bool invalidatedDuringRefresh{false};
+
+        // Number of threads waiting for the refresh in progress
+        int numRefreshWaiters{0};
+
         // Contains the cached routing information (only available if needsRefresh is false)
         std::shared_ptr<RoutingTableHistory> routingInfo;
     };
@@ -291,40 +304,8 @@ private:
                                     std::shared_ptr<CollectionRoutingInfoEntry> collEntry,
                                     NamespaceString const& nss,
                                     int refreshAttempt);
-    /**
-     * Used as a flag to indicate whether or not this thread performed its own
-     * refresh for certain helper functions
-     *
-     * kPerformedRefresh is used only when the calling thread performed the
-     * refresh *itself*
-     *
-     * kDidNotPerformRefresh is used either when there was an error or when
-     * this thread joined an ongoing refresh
-     */
-    enum class RefreshAction {
-        kPerformedRefresh,
-        kDidNotPerformRefresh,
-    };
 
-    /**
-     * Return type for helper functions performing refreshes so that they can
-     * indicate both status and whether or not this thread performed its own
-     * refresh
-     */
-    struct RefreshResult {
-        // Status containing result of refresh
-        StatusWith<CachedCollectionRoutingInfo> statusWithInfo;
-        RefreshAction actionTaken;
-    };
-
-    /**
-     * Helper function used when we need the refresh action taken (e.g. when we
-     * want to force refresh)
-     */
-    CatalogCache::RefreshResult _getCollectionRoutingInfo(OperationContext* opCtx,
-                                                          const NamespaceString& nss);
-
-    CatalogCache::RefreshResult _getCollectionRoutingInfoAt(
+    StatusWith<CachedCollectionRoutingInfo> _getCollectionRoutingInfoAt(
         OperationContext* opCtx,
         const NamespaceString& nss,
         boost::optional<Timestamp> atClusterTime);
@@ -359,6 +340,25 @@ private:
         // for whatever reason
         AtomicInt64 countFailedRefreshes{0};
 
+        // Cumulative, always-increasing counter of how many refreshes were started because of a
+        // routing table change notification, rather than when the routing table was used
+        AtomicInt64 countRefreshesStartedByChangeNotifications{0};
+
+        // Cumulative, always-increasing counter of how many times threads waited for a collection
+        // refresh, either one they started or one already in progress
+        AtomicInt64 countRefreshWaits{0};
+
+        // Tracks how many threads are waiting for a collection refresh currently
+        AtomicInt64 numActiveRefreshWaiters{0};
+
+        // Largest number of threads which waited for the same collection refresh
+        AtomicInt64 maxWaitersPerRefresh{0};
+
+        /**
+         * Records the number of threads which waited for a collection refresh which completed.
+         */
+        void noteRefreshWaiters(int64_t numWaiters);
+
         /**
          * Reports the accumulated statistics for serverStatus.
          */
@@ -575,6 +575,58 @@ TEST_F(CatalogCacheRefreshTest, IncrementalLoadAfterMove) {
     ASSERT_EQ(expectedDestShardVersion, cm->getVersion({"1"}));
 }
 
+TEST_F(CatalogCacheRefreshTest, InvalidationsDuringRefreshShareTheRefreshWhichFollows) {
+    const ShardKeyPattern shardKeyPattern(BSON("_id" << 1));
+
+    auto initialRoutingInfo(makeChunkManager(kNss, shardKeyPattern, nullptr, true, {}));
+    const ChunkVersion version = initialRoutingInfo->getVersion();
+
+    auto const catalogCache = Grid::get(getServiceContext())->catalogCache();
+    auto incrementalRefreshesStarted = [&] {
+        BSONObjBuilder builder;
+        catalogCache->report(&builder);
+        return builder.obj()["catalogCache"]["countIncrementalRefreshesStarted"].numberLong();
+    };
+    const auto refreshesBefore = incrementalRefreshesStarted();
+
+    auto future = scheduleRoutingInfoRefresh(kNss);
+
+    const auto expectUnchangedChunks = [&] {
+        expectFindSendBSONObjVector(kConfigHostAndPort, [&] {
+            ChunkType chunk(kNss,
+                            {shardKeyPattern.getKeyPattern().globalMin(),
+                             shardKeyPattern.getKeyPattern().globalMax()},
+                            version,
+                            {"0"});
+            return std::vector<BSONObj>{chunk.toConfigBSON()};
+        }());
+    };
+
+    // Invalidations which arrive while the refresh is in progress, as from several threads which
+    // need a refresh started after they asked for it
+    onFindCommand([&](const RemoteCommandRequest& request) {
+        catalogCache->invalidateShardedCollection(kNss);
+        catalogCache->invalidateShardedCollection(kNss);
+
+        CollectionType collType;
+        collType.setNs(kNss);
+        collType.setEpoch(version.epoch());
+        collType.setKeyPattern(shardKeyPattern.toBSON());
+        collType.setUnique(false);
+        return std::vector<BSONObj>{collType.toBSON()};
+    });
+    expectUnchangedChunks();
+
+    // They are served by a single refresh following the one in progress
+    expectGetCollection(version.epoch(), shardKeyPattern);
+    expectUnchangedChunks();
+
+    auto routingInfo = future.timed_get(kFutureTimeout);
+    ASSERT(routingInfo->cm());
+    ASSERT_EQ(version, routingInfo->cm()->getVersion());
+    ASSERT_EQ(refreshesBefore + 2, incrementalRefreshesStarted());
+}
+
 TEST_F(CatalogCacheRefreshTest, IncrementalLoadAfterMoveLastChunk) {
     const ShardKeyPattern shardKeyPattern(BSON("_id" << 1));
 
@@ -0,0 +1,195 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/chunk_info_map.h"
+
+#include <algorithm>
+#include <boost/optional.hpp>
+
+namespace mongo {
+
+constexpr ChunkInfoMap::size_type ChunkInfoMap::kMaxBlockSize;
+
+namespace {
+
+bool keyLess(const ChunkInfoMap::value_type& entry, const ChunkInfoMap::key_type& key) {
+    return entry.first < key;
+}
+
+bool keyGreater(const ChunkInfoMap::key_type& key, const ChunkInfoMap::value_type& entry) {
+    return key < entry.first;
+}
+
+}  // namespace
+
+ChunkInfoMap::const_iterator ChunkInfoMap::lower_bound(const key_type& key) const {
+    // The first block whose last key is not less than 'key' holds the entry, if any does.
+    const auto block = std::lower_bound(
+        _blocks.begin(), _blocks.end(), key, [](const auto& block, const key_type& key) {
+            return block->back().first < key;
+        });
+    if (block == _blocks.end()) {
+        return end();
+    }
+    const auto entry = std::lower_bound((*block)->begin(), (*block)->end(), key, keyLess);
+    return {&_blocks,
+            static_cast<size_type>(block - _blocks.begin()),
+            static_cast<size_type>(entry - (*block)->begin())};
+}
+
+ChunkInfoMap::const_iterator ChunkInfoMap::upper_bound(const key_type& key) const {
+    // The first block whose last key is greater than 'key' holds the entry, if any does.
+    const auto block = std::upper_bound(
+        _blocks.begin(), _blocks.end(), key, [](const key_type& key, const auto& block) {
+            return key < block->back().first;
+        });
+    if (block == _blocks.end()) {
+        return end();
+    }
+    const auto entry = std::upper_bound((*block)->begin(), (*block)->end(), key, keyGreater);
+    return {&_blocks,
+            static_cast<size_type>(block - _blocks.begin()),
+            static_cast<size_type>(entry - (*block)->begin())};
+}
+
+void ChunkInfoMap::insert(value_type value) {
+    if (_blocks.empty()) {
+        _blocks.push_back(std::make_shared<Block>());
+        _blocks.back()->reserve(kMaxBlockSize);
+        _blocks.back()->push_back(std::move(value));
+        ++_size;
+        return;
+    }
+
+    auto position = lower_bound(value.first);
+    if (position != end() && position->first == value.first) {
+        return;
+    }
+
+    // Keys past the last one go at the end of the last block.
+    if (position == end()) {
+        position = {&_blocks, _blocks.size() - 1, _blocks.back()->size()};
+    }
+
+    auto& block = _getMutableBlock(position._block);
+    block.insert(block.begin() + position._entry, std::move(value));
+    ++_size;
+
+    if (block.size() > kMaxBlockSize) {
+        auto upperHalf = std::make_shared<Block>();
+        upperHalf->reserve(kMaxBlockSize);
+        const auto middle = block.begin() + block.size() / 2;
+        std::move(middle, block.end(), std::back_inserter(*upperHalf));
+        block.erase(middle, block.end());
+        _blocks.insert(_blocks.begin() + position._block + 1, std::move(upperHalf));
+    }
+}
+
+void ChunkInfoMap::erase(const_iterator first, const_iterator last) {
+    if (first == last) {
+        return;
+    }
+    invariant(first._block < _blocks.size());
+
+    if (first._block == last._block) {
+        auto& block = _getMutableBlock(first._block);
+        block.erase(block.begin() + first._entry, block.begin() + last._entry);
+        _size -= last._entry - first._entry;
+        _compactBlock(first._block);
+        return;
+    }
+
+    // Trim the first and last blocks of the range, then drop the blocks wholly within it.
+    auto& firstBlock = _getMutableBlock(first._block);
+    _size -= firstBlock.size() - first._entry;
+    firstBlock.erase(firstBlock.begin() + first._entry, firstBlock.end());
+
+    if (last._block < _blocks.size()) {
+        auto& lastBlock = _getMutableBlock(last._block);
+        _size -= last._entry;
+        lastBlock.erase(lastBlock.begin(), lastBlock.begin() + last._entry);
+    }
+
+    for (auto block = first._block + 1; block < last._block; ++block) {
+        _size -= _blocks[block]->size();
+    }
+    _blocks.erase(_blocks.begin() + first._block + 1, _blocks.begin() + last._block);
+
+    if (first._block + 1 < _blocks.size()) {
+        _compactBlock(first._block + 1);
+    }
+    _compactBlock(first._block);
+}
+
+ChunkInfoMap::Block& ChunkInfoMap::_getMutableBlock(size_type blockIndex) {
+    auto& block = _blocks[blockIndex];
+    if (block.use_count() > 1) {
+        auto copy = std::make_shared<Block>();
+        copy->reserve(kMaxBlockSize);
+        copy->insert(copy->end(), block->begin(), block->end());
+        block = std::move(copy);
+    }
+    return *block;
+}
+
+void ChunkInfoMap::_compactBlock(size_type blockIndex) {
+    if (_blocks[blockIndex]->empty()) {
+        _blocks.erase(_blocks.begin() + blockIndex);
+        return;
+    }
+    if (_blocks[blockIndex]->size() >= kMaxBlockSize / 4) {
+        return;
+    }
+
+    // Merge the block into the smaller of its neighbours which leaves the merged block no larger
+    // than kMaxBlockSize.
+    auto fitsWith = [&](size_type neighbour) {
+        return _blocks[blockIndex]->size() + _blocks[neighbour]->size() <= kMaxBlockSize;
+    };
+    boost::optional<size_type> target;
+    if (blockIndex > 0 && fitsWith(blockIndex - 1)) {
+        target = blockIndex - 1;
+    }
+    if (blockIndex + 1 < _blocks.size() && fitsWith(blockIndex + 1) &&
+        (!target || _blocks[blockIndex + 1]->size() < _blocks[*target]->size())) {
+        target = blockIndex + 1;
+    }
+    if (!target) {
+        return;
+    }
+
+    const auto lower = std::min(blockIndex, *target);
+    auto& merged = _getMutableBlock(lower);
+    const auto& upper = *_blocks[lower + 1];
+    merged.insert(merged.end(), upper.begin(), upper.end());
+    _blocks.erase(_blocks.begin() + lower + 1);
+}
+
+}  // namespace mongo
@@ -0,0 +1,197 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+class ChunkInfo;
+
+/**
+ * Ordered map from the max key string of each chunk of a collection to the entry describing the
+ * chunk, whose copies share the parts neither of them has modified.
+ *
+ * The entries are held in sorted blocks of at most kMaxBlockSize entries, which are shared between
+ * copies of the map and only copied by the first modification after they are shared. Copying the
+ * map therefore costs one reference per block rather than per chunk, and applying a change to a
+ * copy costs roughly a block for each chunk it changes.
+ *
+ * Only const access is thread safe. Iterators are invalidated by any modification.
+ */
+class ChunkInfoMap {
+public:
+    using key_type = std::string;
+    using mapped_type = std::shared_ptr<ChunkInfo>;
+    using value_type = std::pair<key_type, mapped_type>;
+    using size_type = std::size_t;
+
+    static constexpr size_type kMaxBlockSize = 64;
+
+private:
+    using Block = std::vector<value_type>;
+    using BlockVector = std::vector<std::shared_ptr<Block>>;
+
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = ChunkInfoMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return (*(*_blocks)[_block])[_entry];
+        }
+
+        pointer operator->() const {
+            return &**this;
+        }
+
+        const_iterator& operator++() {
+            if (++_entry == (*_blocks)[_block]->size()) {
+                ++_block;
+                _entry = 0;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        const_iterator& operator--() {
+            if (_entry == 0) {
+                --_block;
+                _entry = (*_blocks)[_block]->size();
+            }
+            --_entry;
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return _block == other._block && _entry == other._entry;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class ChunkInfoMap;
+
+        const_iterator(const BlockVector* blocks, size_type block, size_type entry)
+            : _blocks(blocks), _block(block), _entry(entry) {}
+
+        const BlockVector* _blocks = nullptr;
+
+        // The end iterator is one past the last block, at entry 0.
+        size_type _block = 0;
+        size_type _entry = 0;
+    };
+
+    const_iterator begin() const {
+        return {&_blocks, 0, 0};
+    }
+
+    const_iterator end() const {
+        return {&_blocks, _blocks.size(), 0};
+    }
+
+    const_iterator cbegin() const {
+        return begin();
+    }
+
+    const_iterator cend() const {
+        return end();
+    }
+
+    size_type size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Returns the first entry whose key is not less than 'key'.
+     */
+    const_iterator lower_bound(const key_type& key) const;
+
+    /**
+     * Returns the first entry whose key is greater than 'key'.
+     */
+    const_iterator upper_bound(const key_type& key) const;
+
+    /**
+     * Inserts 'value' unless there already is an entry with its key.
+     */
+    void insert(value_type value);
+
+    /**
+     * Removes the entries in [first, last).
+     */
+    void erase(const_iterator first, const_iterator last);
+
+private:
+    /**
+     * Returns the block at 'blockIndex' for modification, copying it first if it is shared.
+     */
+    Block& _getMutableBlock(size_type blockIndex);
+
+    /**
+     * Removes the block at 'blockIndex' if it is empty, or merges it into a neighbour if both are
+     * small enough, to keep the number of blocks proportional to the number of entries.
+     */
+    void _compactBlock(size_type blockIndex);
+
+    // Non-empty blocks, ordered by their keys.
+    BlockVector _blocks;
+    size_type _size = 0;
+};
+
+}  // namespace mongo
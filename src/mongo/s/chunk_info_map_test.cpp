@@ -0,0 +1,166 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/chunk_info_map.h"
+
+#include <map>
+
+#include "mongo/platform/random.h"
+#include "mongo/s/catalog/type_chunk.h"
+#include "mongo/s/chunk.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::string makeKey(int i) {
+    // Zero padded, so that the keys sort as the numbers do.
+    const auto digits = std::to_string(i);
+    return std::string(8 - digits.size(), '0') + digits;
+}
+
+void insert(ChunkInfoMap* map, int i) {
+    map->insert({makeKey(i), nullptr});
+}
+
+std::vector<std::string> keysOf(const ChunkInfoMap& map) {
+    std::vector<std::string> keys;
+    for (const auto& entry : map) {
+        keys.push_back(entry.first);
+    }
+    return keys;
+}
+
+TEST(ChunkInfoMapTest, FindsBounds) {
+    ChunkInfoMap map;
+    ASSERT(map.upper_bound(makeKey(0)) == map.end());
+
+    for (int i = 0; i < 1000; i += 2) {
+        insert(&map, i);
+    }
+    ASSERT_EQ(map.size(), 500U);
+
+    ASSERT_EQ(map.lower_bound(makeKey(10))->first, makeKey(10));
+    ASSERT_EQ(map.upper_bound(makeKey(10))->first, makeKey(12));
+    ASSERT_EQ(map.lower_bound(makeKey(11))->first, makeKey(12));
+    ASSERT_EQ(map.upper_bound(makeKey(11))->first, makeKey(12));
+    ASSERT(map.upper_bound(makeKey(998)) == map.end());
+    ASSERT_EQ(std::prev(map.end())->first, makeKey(998));
+    ASSERT_EQ(std::distance(map.begin(), map.end()), 500);
+}
+
+TEST(ChunkInfoMapTest, DoesNotReplaceEntriesWithTheSameKey) {
+    ChunkInfoMap map;
+    auto first = std::make_shared<ChunkInfo>(
+        ChunkType(NamespaceString("test.foo"),
+                  ChunkRange(BSON("a" << MINKEY), BSON("a" << MAXKEY)),
+                  ChunkVersion(1, 0, OID::gen()),
+                  ShardId("shard0")));
+    map.insert({makeKey(1), first});
+    map.insert({makeKey(1), nullptr});
+    ASSERT_EQ(map.size(), 1U);
+    ASSERT_EQ(map.begin()->second, first);
+}
+
+TEST(ChunkInfoMapTest, ErasesRangesSpanningBlocks) {
+    ChunkInfoMap map;
+    for (int i = 0; i < 1000; ++i) {
+        insert(&map, i);
+    }
+
+    map.erase(map.lower_bound(makeKey(100)), map.lower_bound(makeKey(900)));
+    ASSERT_EQ(map.size(), 200U);
+    ASSERT_EQ(map.lower_bound(makeKey(100))->first, makeKey(900));
+    ASSERT_EQ(std::prev(map.lower_bound(makeKey(900)))->first, makeKey(99));
+
+    map.erase(map.begin(), map.end());
+    ASSERT(map.empty());
+    ASSERT(map.begin() == map.end());
+}
+
+TEST(ChunkInfoMapTest, CopiesAreUnaffectedByChangesToEachOther) {
+    ChunkInfoMap original;
+    for (int i = 0; i < 1000; ++i) {
+        insert(&original, i);
+    }
+    const auto originalKeys = keysOf(original);
+
+    ChunkInfoMap copy = original;
+    copy.erase(copy.lower_bound(makeKey(500)), copy.upper_bound(makeKey(500)));
+    insert(&copy, 1500);
+    ASSERT_EQ(copy.size(), 1000U);
+    ASSERT(keysOf(original) == originalKeys);
+
+    insert(&original, 2000);
+    ASSERT_EQ(original.size(), 1001U);
+    ASSERT(copy.lower_bound(makeKey(2000)) == copy.end());
+}
+
+TEST(ChunkInfoMapTest, MatchesAnOrderedMapUnderRandomChanges) {
+    PseudoRandom random(1);
+    ChunkInfoMap map;
+    std::map<std::string, int> expected;
+    std::vector<std::pair<ChunkInfoMap, std::map<std::string, int>>> snapshots;
+
+    for (int op = 0; op < 20000; ++op) {
+        const int key = random.nextInt32(5000);
+        switch (random.nextInt32(4)) {
+            case 0:
+            case 1:
+                insert(&map, key);
+                expected.emplace(makeKey(key), 0);
+                break;
+            case 2: {
+                const auto end = makeKey(key + 1 + random.nextInt32(300));
+                map.erase(map.upper_bound(makeKey(key)), map.lower_bound(end));
+                expected.erase(expected.upper_bound(makeKey(key)), expected.lower_bound(end));
+                break;
+            }
+            case 3:
+                if (op % 100 == 0) {
+                    snapshots.emplace_back(map, expected);
+                }
+                break;
+        }
+        ASSERT_EQ(map.size(), expected.size());
+    }
+    snapshots.emplace_back(map, expected);
+
+    for (const auto& snapshot : snapshots) {
+        std::vector<std::string> expectedKeys;
+        for (const auto& entry : snapshot.second) {
+            expectedKeys.push_back(entry.first);
+        }
+        ASSERT(keysOf(snapshot.first) == expectedKeys);
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -32,6 +32,8 @@
 
 #include "mongo/s/chunk_manager.h"
 
+#include <numeric>
+
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
@@ -75,6 +77,7 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
                                          std::unique_ptr<CollatorInterface> defaultCollator,
                                          bool unique,
                                          ChunkInfoMap chunkMap,
+                                         ShardVersionMap shardVersions,
                                          ChunkVersion collectionVersion)
     : _sequenceNumber(nextCMSequenceNumber.addAndFetch(1)),
       _nss(std::move(nss)),
@@ -84,8 +87,7 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
       _defaultCollator(std::move(defaultCollator)),
       _unique(unique),
       _chunkMap(std::move(chunkMap)),
-      _shardVersions(
-          _constructShardVersionMap(collectionVersion.epoch(), _chunkMap, _shardKeyOrdering)),
+      _shardVersions(std::move(shardVersions)),
       _collectionVersion(collectionVersion) {}
 
 Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey, const BSONObj& collation) const {
@@ -108,6 +110,38 @@ Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey, const BSONObj
     return Chunk(*(it->second), _clusterTime);
 }
 
+std::vector<ShardId> ChunkManager::findShardIdsForShardKeys(
+    const std::vector<BSONObj>& shardKeys) const {
+    std::vector<std::string> keyStrings;
+    keyStrings.reserve(shardKeys.size());
+    for (const auto& shardKey : shardKeys) {
+        keyStrings.push_back(_rt->_extractKeyString(shardKey));
+    }
+
+    std::vector<size_t> order(shardKeys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&keyStrings](size_t lhs, size_t rhs) {
+        return keyStrings[lhs] < keyStrings[rhs];
+    });
+
+    const auto& chunkMap = _rt->getChunkMap();
+    std::vector<ShardId> shardIds(shardKeys.size());
+    auto it = chunkMap.end();
+    for (const auto i : order) {
+        // The chunk of the previous key also holds this one unless this key is past its max.
+        if (it == chunkMap.end() || !(keyStrings[i] < it->first)) {
+            it = chunkMap.upper_bound(keyStrings[i]);
+        }
+
+        uassert(ErrorCodes::ShardKeyNotFound,
+                str::stream() << "Cannot target single shard using key " << shardKeys[i],
+                it != chunkMap.end() && it->second->containsKey(shardKeys[i]));
+        shardIds[i] = it->second->getShardIdAt(_clusterTime);
+    }
+
+    return shardIds;
+}
+
 bool ChunkManager::keyBelongsToShard(const BSONObj& shardKey, const ShardId& shardId) const {
     if (shardKey.isEmpty())
         return false;
@@ -487,6 +521,44 @@ ShardVersionMap RoutingTableHistory::_constructShardVersionMap(const OID& epoch,
     return shardVersions;
 }
 
+void RoutingTableHistory::_checkChangedChunksAreContiguous(
+    const ChunkInfoMap& chunkMap, const std::vector<std::string>& changedMaxKeys) {
+    for (const auto& maxKey : changedMaxKeys) {
+        const auto it = chunkMap.lower_bound(maxKey);
+        if (it == chunkMap.end() || it->first != maxKey) {
+            // A later change replaced the chunk, and is checked instead.
+            continue;
+        }
+        const auto& chunk = it->second;
+
+        if (it == chunkMap.begin()) {
+            checkAllElementsAreOfType(MinKey, chunk->getMin());
+        } else {
+            const auto& prevChunk = std::prev(it)->second;
+            uassert(ErrorCodes::ConflictingOperationInProgress,
+                    str::stream() << "Gap or an overlap between ranges "
+                                  << ChunkRange(chunk->getMin(), chunk->getMax()).toString()
+                                  << " and "
+                                  << prevChunk->getMax(),
+                    SimpleBSONObjComparator::kInstance.evaluate(prevChunk->getMax() ==
+                                                                chunk->getMin()));
+        }
+
+        const auto next = std::next(it);
+        if (next == chunkMap.end()) {
+            checkAllElementsAreOfType(MaxKey, chunk->getMax());
+        } else {
+            uassert(ErrorCodes::ConflictingOperationInProgress,
+                    str::stream() << "Gap or an overlap between ranges "
+                                  << ChunkRange(chunk->getMin(), chunk->getMax()).toString()
+                                  << " and "
+                                  << next->second->getMin(),
+                    SimpleBSONObjComparator::kInstance.evaluate(chunk->getMax() ==
+                                                                next->second->getMin()));
+        }
+    }
+}
+
 std::string RoutingTableHistory::_extractKeyString(const BSONObj& shardKeyValue) const {
     return extractKeyStringInternal(shardKeyValue, _shardKeyOrdering);
 }
@@ -505,6 +577,7 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeNew(
                                std::move(defaultCollator),
                                std::move(unique),
                                {},
+                               {},
                                {0, 0, epoch})
         .makeUpdated(chunks);
 }
@@ -513,8 +586,20 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
     const std::vector<ChunkType>& changedChunks) {
 
     const auto startingCollectionVersion = getVersion();
+
+    // Copying the map only copies references to its blocks, which the changes copy as they modify
+    // them.
     auto chunkMap = _chunkMap;
 
+    // The shard versions are updated along with the chunks, so that the refresh does not need a
+    // pass over all of them. If the chunk with the max version of a shard is replaced by a chunk on
+    // another shard and the shard gets no newer chunk, its version can only be found by such a
+    // pass, as can the versions of the initial load.
+    auto shardVersions = _shardVersions;
+    std::set<ShardId> shardsWithUnknownVersion;
+    std::vector<std::string> changedMaxKeys;
+    changedMaxKeys.reserve(changedChunks.size());
+
     ChunkVersion collectionVersion = startingCollectionVersion;
     for (const auto& chunk : changedChunks) {
         const auto& chunkVersion = chunk.getVersion();
@@ -562,11 +647,26 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
             newChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
         }
 
+        for (auto it = low; it != high; ++it) {
+            const auto& replacedShardId = it->second->getShardIdAt(boost::none);
+            const auto shardVersionIt = shardVersions.find(replacedShardId);
+            if (shardVersionIt != shardVersions.end() &&
+                shardVersionIt->second == it->second->getLastmod()) {
+                shardsWithUnknownVersion.insert(replacedShardId);
+            }
+        }
+
         // Erase all chunks from the map, which overlap the chunk we got from the persistent store
         chunkMap.erase(low, high);
 
         // Insert only the chunk itself
         chunkMap.insert(std::make_pair(chunkMaxKeyString, newChunk));
+        changedMaxKeys.push_back(chunkMaxKeyString);
+
+        // The changes come in ascending order of version, so this is the max version of its shard.
+        const auto& shardId = newChunk->getShardIdAt(boost::none);
+        shardVersions[shardId] = chunkVersion;
+        shardsWithUnknownVersion.erase(shardId);
     }
 
     // If at least one diff was applied, the metadata is correct, but it might not have changed so
@@ -580,6 +680,13 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
         return shared_from_this();
     }
 
+    if (_chunkMap.empty() || !shardsWithUnknownVersion.empty()) {
+        shardVersions =
+            _constructShardVersionMap(collectionVersion.epoch(), chunkMap, _shardKeyOrdering);
+    } else {
+        _checkChangedChunksAreContiguous(chunkMap, changedMaxKeys);
+    }
+
     return std::shared_ptr<RoutingTableHistory>(
         new RoutingTableHistory(_nss,
                                 _uuid,
@@ -587,6 +694,7 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
                                 CollatorInterface::cloneCollator(getDefaultCollator()),
                                 isUnique(),
                                 std::move(chunkMap),
+                                std::move(shardVersions),
                                 collectionVersion));
 }
 
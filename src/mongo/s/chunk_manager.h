@@ -37,6 +37,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/s/chunk.h"
+#include "mongo/s/chunk_info_map.h"
 #include "mongo/s/chunk_version.h"
 #include "mongo/s/client/shard.h"
 #include "mongo/s/shard_key_pattern.h"
@@ -49,9 +50,6 @@ struct QuerySolutionNode;
 class OperationContext;
 class ChunkManager;
 
-// Ordered map from the max for each chunk to an entry describing the chunk
-using ChunkInfoMap = std::map<std::string, std::shared_ptr<ChunkInfo>>;
-
 // Map from a shard is to the max chunk version on that shard
 using ShardVersionMap = std::map<ShardId, ChunkVersion>;
 
@@ -157,12 +155,22 @@ private:
                                                      const ChunkInfoMap& chunkMap,
                                                      Ordering shardKeyOrdering);
 
+    /**
+     * Checks that each of the chunks with the max key strings in 'changedMaxKeys' which are still
+     * in 'chunkMap' is contiguous with its neighbours, and that the first and last chunks span the
+     * whole key space if they are among them. Applying changes to chunks whose ranges were
+     * contiguous only leaves gaps or overlaps next to the changed chunks.
+     */
+    static void _checkChangedChunksAreContiguous(const ChunkInfoMap& chunkMap,
+                                                 const std::vector<std::string>& changedMaxKeys);
+
     RoutingTableHistory(NamespaceString nss,
                         boost::optional<UUID> uuid,
                         KeyPattern shardKeyPattern,
                         std::unique_ptr<CollatorInterface> defaultCollator,
                         bool unique,
                         ChunkInfoMap chunkMap,
+                        ShardVersionMap shardVersions,
                         ChunkVersion collectionVersion);
 
     std::string _extractKeyString(const BSONObj& shardKeyValue) const;
@@ -189,7 +197,8 @@ private:
     const bool _unique;
 
     // Map from the max for each chunk to an entry describing the chunk. The union of all chunks'
-    // ranges must cover the complete space from [MinKey, MaxKey).
+    // ranges must cover the complete space from [MinKey, MaxKey). Successive routing tables share
+    // the parts of it which did not change between them.
     const ChunkInfoMap _chunkMap;
 
     // Map from shard id to the maximum chunk version for that shard. If a shard contains no
@@ -337,6 +346,17 @@ public:
         return findIntersectingChunk(shardKey, CollationSpec::kSimpleSpec);
     }
 
+    /**
+     * Returns the id of the shard which owns each of 'shardKeys', full shard keys extracted from
+     * documents, in the same order, assuming the simple collation. Looks the keys up in key order,
+     * so that keys which fall in the same chunk as the key before them are found without searching
+     * the chunk map again.
+     *
+     * Throws a DBException with the ShardKeyNotFound code if a key does not match the shard key
+     * pattern.
+     */
+    std::vector<ShardId> findShardIdsForShardKeys(const std::vector<BSONObj>& shardKeys) const;
+
     /**
      * Finds the shard IDs for a given filter and collation. If collation is empty, we use the
      * collection default collation for targeting.
@@ -487,5 +487,37 @@ TEST_F(ChunkManagerQueryTest, SimpleCollationNumbersMultiShard) {
         {ShardId("0")});
 }
 
+TEST_F(ChunkManagerQueryTest, FindShardIdsForShardKeysInAnyOrder) {
+    const ShardKeyPattern shardKeyPattern(BSON("a" << 1));
+    auto chunkManager = makeChunkManager(kNss,
+                                         shardKeyPattern,
+                                         nullptr,
+                                         false,
+                                         {BSON("a" << -100), BSON("a" << 0), BSON("a" << 100)});
+
+    const std::vector<BSONObj> shardKeys{BSON("a" << 150),
+                                         BSON("a" << -150),
+                                         BSON("a" << 0),
+                                         BSON("a" << 99),
+                                         BSON("a" << -100),
+                                         BSON("a" << 5),
+                                         BSON("a" << MINKEY)};
+    const std::vector<ShardId> expected{ShardId("3"),
+                                        ShardId("0"),
+                                        ShardId("2"),
+                                        ShardId("2"),
+                                        ShardId("1"),
+                                        ShardId("2"),
+                                        ShardId("0")};
+    ASSERT(chunkManager->findShardIdsForShardKeys(shardKeys) == expected);
+
+    for (size_t i = 0; i < shardKeys.size(); ++i) {
+        ASSERT_EQ(chunkManager->findIntersectingChunkWithSimpleCollation(shardKeys[i]).getShardId(),
+                  expected[i]);
+    }
+
+    ASSERT(chunkManager->findShardIdsForShardKeys({}).empty());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -386,6 +386,18 @@ void ShardRegistry::replicaSetChangeConfigServerUpdateHook(const std::string& se
     }
 }
 
+void ShardRegistry::replicaSetPrimaryChangeWarmUpHook(const std::string& setName,
+                                                      const HostAndPort& newPrimary) {
+    auto const grid = Grid::get(getGlobalServiceContext());
+
+    // The config server's primary is found while sharding is still being initialized.
+    if (!grid->isShardingInitialized())
+        return;
+
+    LOG(1) << "Warming up connections to " << newPrimary << ", the new primary of " << setName;
+    grid->getExecutorPool()->warmUpConnections(newPrimary);
+}
+
 ////////////// ShardRegistryData //////////////////
 
 ShardRegistryData::ShardRegistryData(OperationContext* opCtx, ShardFactory* shardFactory) {
@@ -275,6 +275,15 @@ public:
     static void replicaSetChangeConfigServerUpdateHook(const std::string& setName,
                                                        const std::string& newConnectionString);
 
+    /**
+     * For use in mongos which warms up the sharding task executors' connections to a shard or
+     * config server replica set as soon as a new primary is found for it.
+     *
+     * This is expected to be run in a brand new thread.
+     */
+    static void replicaSetPrimaryChangeWarmUpHook(const std::string& setName,
+                                                  const HostAndPort& newPrimary);
+
 private:
     /**
      * Factory to create shards.  Never changed after startup so safe to access outside of _mutex.
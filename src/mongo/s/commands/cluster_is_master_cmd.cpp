@@ -28,6 +28,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/db/auth/sasl_command_constants.h"
 #include "mongo/db/auth/sasl_mechanism_registry.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands.h"
@@ -72,6 +73,10 @@ public:
         return false;
     }
 
+    StringData sensitiveFieldName() const final {
+        return saslCommandSpeculativeAuthenticateFieldName;
+    }
+
     bool run(OperationContext* opCtx,
              const std::string& dbname,
              const BSONObj& cmdObj,
@@ -130,6 +135,7 @@ public:
 
         auto& saslMechanismRegistry = SASLServerMechanismRegistry::get(opCtx->getServiceContext());
         saslMechanismRegistry.advertiseMechanismNamesForUser(opCtx, cmdObj, &result);
+        speculativeSaslStart(opCtx, cmdObj, &result);
 
         return true;
     }
@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kCommand
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/auth/action_type.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/commands.h"
+#include "mongo/s/catalog_cache.h"
+#include "mongo/s/client/shard_registry.h"
+#include "mongo/s/grid.h"
+#include "mongo/s/request_types/reshard_collection_gen.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+class ReshardCollectionCmd : public BasicCommand {
+public:
+    ReshardCollectionCmd() : BasicCommand("reshardCollection") {}
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kAlways;
+    }
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return true;
+    }
+
+    std::string help() const override {
+        return "Changes the shard key of a sharded collection while it remains available for "
+               "reads and writes. Requires key. Optional numInitialChunks.\n"
+               "   { reshardCollection : \"<db>.<collection>\", key : <new shard key> }\n";
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override {
+        if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
+                ResourcePattern::forExactNamespace(NamespaceString(parseNs(dbname, cmdObj))),
+                ActionType::enableSharding)) {
+            return Status(ErrorCodes::Unauthorized, "Unauthorized");
+        }
+
+        return Status::OK();
+    }
+
+    std::string parseNs(const std::string& dbname, const BSONObj& cmdObj) const override {
+        return CommandHelpers::parseNsFullyQualified(cmdObj);
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const NamespaceString nss(parseNs(dbname, cmdObj));
+        const auto request =
+            ReshardCollection::parse(IDLParserErrorContext("reshardCollection"), cmdObj);
+
+        ConfigsvrReshardCollection configsvrRequest;
+        configsvrRequest.set_configsvrReshardCollection(nss);
+        configsvrRequest.setKey(request.getKey());
+        configsvrRequest.setNumInitialChunks(request.getNumInitialChunks());
+
+        // Invalidate the routing table cache entries for this collection and the temporary one
+        // so that we reload them the next time they're accessed, even if we receive a failure.
+        const NamespaceString tempNss(nss.db(), "tmp.reshard." + nss.coll());
+        ON_BLOCK_EXIT([opCtx, nss, tempNss] {
+            Grid::get(opCtx)->catalogCache()->invalidateShardedCollection(nss);
+            Grid::get(opCtx)->catalogCache()->invalidateShardedCollection(tempNss);
+        });
+
+        // Resharding cannot be retried once started, since it would find the temporary collection
+        auto configShard = Grid::get(opCtx)->shardRegistry()->getConfigShard();
+        auto cmdResponse = uassertStatusOK(configShard->runCommandWithFixedRetryAttempts(
+            opCtx,
+            ReadPreferenceSetting(ReadPreference::PrimaryOnly),
+            "admin",
+            CommandHelpers::appendMajorityWriteConcern(
+                CommandHelpers::appendPassthroughFields(cmdObj, configsvrRequest.toBSON())),
+            Shard::RetryPolicy::kNoRetry));
+
+        CommandHelpers::filterCommandReplyForPassthrough(cmdResponse.response, &result);
+        return true;
+    }
+
+} reshardCollectionCmd;
+
+}  // namespace
+}  // namespace mongo
@@ -78,6 +78,7 @@
 #include "mongo/s/stale_exception.h"
 #include "mongo/s/transaction_router.h"
 #include "mongo/util/fail_point_service.h"
+#include "mongo/util/heap_profiler_attribution.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
@@ -159,7 +160,7 @@ void invokeInTransactionRouter(OperationContext* opCtx,
                                TransactionRouter* txnRouter,
                                rpc::ReplyBuilderInterface* result) {
     try {
-        invocation->run(opCtx, result);
+        invocation->runAsync(opCtx, result).get();
     } catch (const DBException& e) {
         if (ErrorCodes::isSnapshotError(e.code()) ||
             ErrorCodes::isNeedRetargettingError(e.code()) ||
@@ -280,7 +281,7 @@ void execCommandClient(OperationContext* opCtx,
         if (txnRouter) {
             invokeInTransactionRouter(opCtx, invocation, txnRouter, result);
         } else {
-            invocation->run(opCtx, result);
+            invocation->runAsync(opCtx, result).get();
         }
     } else {
         // Change the write concern while running the command.
@@ -291,7 +292,7 @@ void execCommandClient(OperationContext* opCtx,
         if (txnRouter) {
             invokeInTransactionRouter(opCtx, invocation, txnRouter, result);
         } else {
-            invocation->run(opCtx, result);
+            invocation->runAsync(opCtx, result).get();
         }
     }
 
@@ -357,6 +358,9 @@ void runCommand(OperationContext* opCtx,
     std::string ns = invocation->ns().toString();
     auto nss = (request.getDatabase() == ns ? NamespaceString(ns, "$cmd") : NamespaceString(ns));
 
+    // Charge the memory the command allocates to it, if the heap profiler is enabled.
+    HeapProfilerAttribution heapProfilerAttribution(command->getName(), ns);
+
     // Fill out all currentOp details.
     CurOp::get(opCtx)->setGenericOpRequestDetails(opCtx, nss, command, request.body, opType);
 
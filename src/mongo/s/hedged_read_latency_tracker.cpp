@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/hedged_read_latency_tracker.h"
+
+#include <algorithm>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+HedgedReadLatencyTracker& HedgedReadLatencyTracker::get() {
+    static HedgedReadLatencyTracker tracker;
+    return tracker;
+}
+
+void HedgedReadLatencyTracker::recordLatency(const ShardId& shardId, Milliseconds latency) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    auto& window = _windows[shardId];
+    if (window.latencies.size() < kWindowSize) {
+        window.latencies.push_back(latency);
+        return;
+    }
+
+    window.latencies[window.next] = latency;
+    window.next = (window.next + 1) % kWindowSize;
+}
+
+boost::optional<Milliseconds> HedgedReadLatencyTracker::getPercentile(const ShardId& shardId,
+                                                                      int percentile) const {
+    invariant(percentile > 0 && percentile <= 100);
+
+    std::vector<Milliseconds> latencies;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+        auto it = _windows.find(shardId);
+        if (it == _windows.end() || it->second.latencies.size() < kMinSamples) {
+            return boost::none;
+        }
+        latencies = it->second.latencies;
+    }
+
+    // The nearest-rank percentile: the smallest latency which is at least as large as the given
+    // percentage of the recorded ones.
+    const size_t rank = (latencies.size() * percentile + 99) / 100;
+    const auto nth = latencies.begin() + (rank - 1);
+    std::nth_element(latencies.begin(), nth, latencies.end());
+    return *nth;
+}
+
+}  // namespace mongo
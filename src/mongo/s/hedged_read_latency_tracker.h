@@ -0,0 +1,94 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <map>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/s/shard_id.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+/**
+ * Keeps a window of the most recent response latencies of reads sent to each shard, from which
+ * the AsyncRequestsSender derives how long to wait for a read before hedging it to another host.
+ *
+ * Thread safe.
+ */
+class HedgedReadLatencyTracker {
+    MONGO_DISALLOW_COPYING(HedgedReadLatencyTracker);
+
+public:
+    /**
+     * Number of latencies remembered per shard.
+     */
+    static constexpr size_t kWindowSize = 128;
+
+    /**
+     * Number of latencies which must have been recorded for a shard before a percentile is
+     * reported for it.
+     */
+    static constexpr size_t kMinSamples = 16;
+
+    HedgedReadLatencyTracker() = default;
+
+    /**
+     * Returns the tracker shared by all the AsyncRequestsSenders of the process.
+     */
+    static HedgedReadLatencyTracker& get();
+
+    /**
+     * Records the latency of a read which was answered by 'shardId'.
+     */
+    void recordLatency(const ShardId& shardId, Milliseconds latency);
+
+    /**
+     * Returns the given percentile, in (0, 100], of the recent latencies of 'shardId', or
+     * boost::none if fewer than kMinSamples of them have been recorded.
+     */
+    boost::optional<Milliseconds> getPercentile(const ShardId& shardId, int percentile) const;
+
+private:
+    struct Window {
+        std::vector<Milliseconds> latencies;
+
+        // Position in 'latencies' of the oldest entry, once the window is full.
+        size_t next = 0;
+    };
+
+    mutable stdx::mutex _mutex;
+
+    std::map<ShardId, Window> _windows;
+};
+
+}  // namespace mongo
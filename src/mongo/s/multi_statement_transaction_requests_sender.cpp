@@ -80,4 +80,9 @@ void MultiStatementTransactionRequestsSender::stopRetrying() {
     _ars.stopRetrying();
 }
 
+void MultiStatementTransactionRequestsSender::addRequests(
+    const std::vector<AsyncRequestsSender::Request>& requests) {
+    _ars.addRequests(attachTxnDetails(_opCtx, requests));
+}
+
 }  // namespace mongo
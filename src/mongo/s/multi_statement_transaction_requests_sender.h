@@ -58,6 +58,8 @@ public:
 
     void stopRetrying();
 
+    void addRequests(const std::vector<AsyncRequestsSender::Request>& requests);
+
 private:
     OperationContext* _opCtx;
     AsyncRequestsSender _ars;
@@ -97,6 +97,20 @@ public:
     virtual StatusWith<ShardEndpoint> targetInsert(OperationContext* opCtx,
                                                    const BSONObj& doc) const = 0;
 
+    /**
+     * Returns the result of targetInsert for each of 'docs', in the same order. Targeters which can
+     * share work between the documents of a batch override this.
+     */
+    virtual std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+        std::vector<StatusWith<ShardEndpoint>> endpoints;
+        endpoints.reserve(docs.size());
+        for (const auto& doc : docs) {
+            endpoints.push_back(targetInsert(opCtx, doc));
+        }
+        return endpoints;
+    }
+
     /**
      * Returns a vector of ShardEndpoints for a potentially multi-shard update.
      *
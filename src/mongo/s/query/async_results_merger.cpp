@@ -38,6 +38,7 @@
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/killcursors_request.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/util/assert_util.h"
@@ -209,8 +210,23 @@ bool AsyncResultsMerger::_readySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode == TailableModeEnum::kNormal);
 
+    const bool streaming = internalQueryStreamSortedMerge.load();
+    boost::optional<BSONObj> keyWeWantToReturn;
     for (const auto& remote : _remotes) {
-        if (!remote.hasNext() && !remote.exhausted()) {
+        if (remote.hasNext() || remote.exhausted()) {
+            continue;
+        }
+        // Each remote returns its results in sort order, so nothing it has yet to return can sort
+        // before the last result it gave us. Until it has given us one, anything might.
+        if (!streaming || !remote.lastSortKey || _mergeQueue.empty()) {
+            return false;
+        }
+        if (!keyWeWantToReturn) {
+            keyWeWantToReturn =
+                extractSortKey(*_remotes[_mergeQueue.top()].docBuffer.front().getResult(),
+                               _params.getCompareWholeSortKey());
+        }
+        if (compareSortKeys(*keyWeWantToReturn, *remote.lastSortKey, *_params.getSort()) > 0) {
             return false;
         }
     }
@@ -276,7 +292,7 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
@@ -295,10 +311,19 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
 
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
     // next result.
-    if (!_remotes[smallestRemote].docBuffer.empty()) {
+    auto& remote = _remotes[smallestRemote];
+    if (!remote.docBuffer.empty()) {
         _mergeQueue.push(smallestRemote);
     }
 
+    // Ask for the next batch from 'smallestRemote' while the merge still has results from it to
+    // return, rather than once the merge is blocked waiting on it.
+    if (_tailableMode == TailableModeEnum::kNormal && internalQueryStreamSortedMerge.load() &&
+        remote.docBuffer.size() <= remote.lastBatchCount / 2 && remote.cursorId &&
+        !remote.cbHandle.isValid() && _opCtx) {
+        remote.status = _askForNextBatch(lk, smallestRemote);
+    }
+
     return front;
 }
 
@@ -348,6 +373,21 @@ Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
         adjustedBatchSize = *_params.getBatchSize() - remote.fetchedCount;
     }
 
+    // Without a client batchSize each remote would otherwise fill its getMore replies up to the
+    // maximum message size, however slowly the merge consumes its results. Instead, start small and
+    // grow each time the merge drains the remote's buffer, so that the remotes whose results are
+    // consumed fastest are fetched in the largest batches while the memory buffered per remote
+    // stays bounded.
+    const long long maxAdaptiveBatchSize = internalQueryAdaptiveGetMoreMaxBatchSize.load();
+    if (!_params.getBatchSize() && maxAdaptiveBatchSize > 0 &&
+        _tailableMode == TailableModeEnum::kNormal) {
+        remote.adaptiveBatchSize = remote.adaptiveBatchSize
+            ? std::min(remote.adaptiveBatchSize * 2, maxAdaptiveBatchSize)
+            : std::min<long long>(internalQueryAdaptiveGetMoreInitialBatchSize.load(),
+                                  maxAdaptiveBatchSize);
+        adjustedBatchSize = remote.adaptiveBatchSize;
+    }
+
     BSONObj cmdObj = GetMoreRequest(remote.cursorNss,
                                     remote.cursorId,
                                     adjustedBatchSize,
@@ -570,9 +610,8 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
     if (_params.getAllowPartialResults()) {
         remote.status = Status::OK();
 
-        // Clear the results buffer and cursor id.
-        std::queue<ClusterQueryResult> emptyBuffer;
-        std::swap(remote.docBuffer, emptyBuffer);
+        // Clear the cursor id. Any results already buffered from the remote are still returned,
+        // since a sorted merge may be holding its place in the merge queue.
         remote.cursorId = 0;
     }
 }
@@ -624,6 +663,7 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                            const CursorResponse& response) {
     auto& remote = _remotes[remoteIndex];
     updateRemoteMetadata(&remote, response);
+    const bool wasBuffering = remote.hasNext();
     for (const auto& obj : response.getBatch()) {
         // If there's a sort, we're expecting the remote node to have given us back a sort key.
         if (_params.getSort()) {
@@ -650,10 +690,20 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
         ++remote.fetchedCount;
     }
 
+    remote.lastBatchCount = response.getBatch().size();
+
     // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
-    // queue.
+    // queue. A remote which was asked for its next batch before its buffer drained is already on
+    // it.
     if (_params.getSort() && !response.getBatch().empty()) {
-        _mergeQueue.push(remoteIndex);
+        if (_tailableMode == TailableModeEnum::kNormal) {
+            remote.lastSortKey =
+                extractSortKey(response.getBatch().back(), _params.getCompareWholeSortKey())
+                    .getOwned();
+        }
+        if (!wasBuffering) {
+            _mergeQueue.push(remoteIndex);
+        }
     }
     return true;
 }
@@ -265,6 +265,10 @@ private:
         // result with a sort key lower than this.
         boost::optional<BSONObj> promisedMinSortKey;
 
+        // Used when merging non-tailable cursors in sorted order. The sort key of the last result
+        // received from the remote, which sorts no later than any result it has yet to return.
+        boost::optional<BSONObj> lastSortKey;
+
         // The cursor id for the remote cursor. If a remote cursor is not yet exhausted, this member
         // will be set to a valid non-zero cursor id. If a remote cursor is now exhausted, this
         // member will be set to zero.
@@ -293,6 +297,14 @@ private:
         // Count of fetched docs during ARM processing of the current batch. Used to reduce the
         // batchSize in getMore when mongod returned less docs than the requested batchSize.
         long long fetchedCount = 0;
+
+        // The batchSize of the last getMore sent to this remote when the client did not specify
+        // one and internalQueryAdaptiveGetMoreMaxBatchSize is enabled, or zero before the first.
+        long long adaptiveBatchSize = 0;
+
+        // The number of results in the last batch received from this remote. A streaming sorted
+        // merge asks for the next batch once fewer than half of these remain buffered.
+        size_t lastBatchCount = 0;
     };
 
     class MergingComparator {
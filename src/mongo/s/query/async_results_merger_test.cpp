@@ -33,6 +33,7 @@
 #include "mongo/db/json.h"
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_request.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/client/shard_registry.h"
@@ -40,6 +41,7 @@
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -368,6 +370,92 @@ TEST_F(AsyncResultsMergerTest, MultiShardMultipleGets) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, SortedMergeAsksForNextBatchBeforeBufferDrains) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<BSONObj> firstBatch = {fromjson("{$sortKey: {'': 1}}"),
+                                       fromjson("{$sortKey: {'': 2}}"),
+                                       fromjson("{$sortKey: {'': 3}}"),
+                                       fromjson("{$sortKey: {'': 4}}")};
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, std::move(firstBatch))));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    // Once half of the batch has been returned, the ARM asks for the next one.
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 2}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(networkHasReadyRequests());
+
+    // The next batch arrives while results from the previous one are still buffered.
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch = {fromjson("{$sortKey: {'': 5}}"),
+                                  fromjson("{$sortKey: {'': 6}}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch);
+    scheduleNetworkResponses(std::move(responses));
+
+    for (int i = 3; i <= 6; ++i) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(BSON("$sortKey" << BSON("" << i)),
+                          *unittest::assertGet(arm->nextReady()).getResult());
+    }
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(arm->remotesExhausted());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, SortedMergeReturnsResultsTiedWithRemoteAwaitingBatch) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<BSONObj> firstBatch1 = {fromjson("{$sortKey: {'': 1}}"),
+                                        fromjson("{$sortKey: {'': 3}}")};
+    std::vector<BSONObj> firstBatch2 = {fromjson("{$sortKey: {'': 3}}"),
+                                        fromjson("{$sortKey: {'': 9}}")};
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, std::move(firstBatch1))));
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, std::move(firstBatch2))));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // Both results with sort key 3 can be returned while the first shard's next batch is
+    // outstanding, since that batch cannot contain anything which sorts before 3.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 3}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 3}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+
+    // The result with sort key 9 must wait for the first shard.
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch = {fromjson("{$sortKey: {'': 4}}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch);
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 4}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 9}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+
+    // Required to kill the 'arm' before destruction, since the second shard was not exhausted.
+    auto killEvent = arm->kill(operationContext());
+    executor()->waitForEvent(killEvent);
+}
+
 TEST_F(AsyncResultsMergerTest, CompoundSortKey) {
     BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1, b: 1}}");
     std::vector<RemoteCursor> cursors;
@@ -1097,6 +1185,45 @@ TEST_F(AsyncResultsMergerTest, GetMoreBatchSizes) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, AdaptiveGetMoreBatchSizes) {
+    internalQueryAdaptiveGetMoreInitialBatchSize.store(2);
+    internalQueryAdaptiveGetMoreMaxBatchSize.store(3);
+    ON_BLOCK_EXIT([] {
+        internalQueryAdaptiveGetMoreInitialBatchSize.store(101);
+        internalQueryAdaptiveGetMoreMaxBatchSize.store(0);
+    });
+
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 1, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors));
+
+    // Each getMore to the remote is twice the size of the last, up to the maximum.
+    std::vector<long long> expectedBatchSizes = {2, 3, 3};
+    for (size_t i = 0; i < expectedBatchSizes.size(); ++i) {
+        ASSERT_FALSE(arm->ready());
+        auto readyEvent = unittest::assertGet(arm->nextEvent());
+
+        auto request = GetMoreRequest::parseFromBSON("anydbname", getNthPendingRequest(0).cmdObj);
+        ASSERT_OK(request.getStatus());
+        ASSERT_EQ(*request.getValue().batchSize, expectedBatchSizes[i]);
+
+        const bool last = (i + 1 == expectedBatchSizes.size());
+        std::vector<CursorResponse> responses;
+        std::vector<BSONObj> batch = {BSON("_id" << static_cast<int>(i))};
+        responses.emplace_back(kTestNss, CursorId(last ? 0 : 1), batch);
+        scheduleNetworkResponses(std::move(responses));
+        executor()->waitForEvent(readyEvent);
+
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(BSON("_id" << static_cast<int>(i)),
+                          *unittest::assertGet(arm->nextReady()).getResult());
+    }
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, AllowPartialResults) {
     BSONObj findCmd = fromjson("{find: 'testcoll', allowPartialResults: true}");
     std::vector<RemoteCursor> cursors;
@@ -443,6 +443,10 @@ DispatchShardPipelineResults dispatchShardPipeline(
 
         exchangeSpec = cluster_aggregation_planner::checkIfEligibleForExchange(
             opCtx, splitPipeline->mergePipeline.get());
+        if (!exchangeSpec) {
+            exchangeSpec = cluster_aggregation_planner::checkIfEligibleForGroupExchange(
+                opCtx, splitPipeline->mergePipeline.get(), shardIds);
+        }
     }
 
     // Generate the command object for the targeted shards.
@@ -547,6 +551,19 @@ DispatchShardPipelineResults dispatchExchangeConsumerPipeline(
     // For all consumers construct a request with appropriate cursor ids and send to shards.
     std::vector<std::pair<ShardId, BSONObj>> requests;
     auto numConsumers = shardDispatchResults->exchangeSpec->consumerShards.size();
+
+    // The consumers run the leading stages of the merge pipeline; the remaining stages, if any,
+    // merge the results of the consumers.
+    Pipeline::SourceContainer consumerStages =
+        shardDispatchResults->splitPipeline->mergePipeline->getSources();
+    Pipeline::SourceContainer remainingStages;
+    if (auto numConsumerStages = shardDispatchResults->exchangeSpec->numConsumerStages) {
+        invariant(*numConsumerStages <= consumerStages.size());
+        auto splitPoint = std::next(consumerStages.begin(), *numConsumerStages);
+        remainingStages.splice(
+            remainingStages.end(), consumerStages, splitPoint, consumerStages.end());
+    }
+
     std::vector<SplitPipeline> consumerPipelines;
     for (size_t idx = 0; idx < numConsumers; ++idx) {
         // Pick this consumer's cursors from producers.
@@ -557,8 +574,7 @@ DispatchShardPipelineResults dispatchExchangeConsumerPipeline(
         }
 
         // Create a pipeline for a consumer and add the merging stage.
-        auto consumerPipeline = uassertStatusOK(Pipeline::create(
-            shardDispatchResults->splitPipeline->mergePipeline->getSources(), expCtx));
+        auto consumerPipeline = uassertStatusOK(Pipeline::create(consumerStages, expCtx));
 
         cluster_aggregation_planner::addMergeCursorsSource(
             consumerPipeline.get(),
@@ -590,10 +606,11 @@ DispatchShardPipelineResults dispatchExchangeConsumerPipeline(
         ownedCursors.emplace_back(OwnedRemoteCursor(opCtx, std::move(cursor), executionNss));
     }
 
-    // The merging pipeline is just a union of the results from each of the shards involved on the
-    // consumer side of the exchange.
-    auto mergePipeline = uassertStatusOK(Pipeline::create({}, expCtx));
+    // The merging pipeline is a union of the results from each of the shards involved on the
+    // consumer side of the exchange, followed by any stages which the consumers did not run.
+    auto mergePipeline = uassertStatusOK(Pipeline::create(std::move(remainingStages), expCtx));
     mergePipeline->setSplitState(Pipeline::SplitState::kSplitForMerge);
+    const bool needsPrimaryShardMerge = mergePipeline->needsPrimaryShardMerger();
 
     SplitPipeline splitPipeline{nullptr, std::move(mergePipeline), boost::none};
 
@@ -604,7 +621,7 @@ DispatchShardPipelineResults dispatchExchangeConsumerPipeline(
             static_cast<DocumentSourceMergeCursors*>(pipeline.shardsPipeline->peekFront());
         mergeCursors->dismissCursorOwnership();
     }
-    return DispatchShardPipelineResults{false,
+    return DispatchShardPipelineResults{needsPrimaryShardMerge,
                                         std::move(ownedCursors),
                                         {} /*TODO SERVER-36279*/,
                                         std::move(splitPipeline),
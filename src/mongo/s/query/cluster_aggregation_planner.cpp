@@ -30,6 +30,9 @@
 
 #include "mongo/s/query/cluster_aggregation_planner.h"
 
+#include <limits>
+
+#include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_match.h"
@@ -100,11 +103,15 @@ boost::optional<BSONObj> findSplitPoint(Pipeline::SourceContainer* shardPipe, Pi
 
 /**
  * If the final stage on shards is to unwind an array, move that stage to the merger. This cuts down
- * on network traffic and allows us to take advantage of reduced copying in unwind.
+ * on network traffic and allows us to take advantage of reduced copying in unwind. An $unwind which
+ * has absorbed a $match may discard most of the unwound documents, so it is left on the shards.
  */
 void moveFinalUnwindFromShardsToMerger(Pipeline* shardPipe, Pipeline* mergePipe) {
-    while (!shardPipe->getSources().empty() &&
-           dynamic_cast<DocumentSourceUnwind*>(shardPipe->getSources().back().get())) {
+    while (!shardPipe->getSources().empty()) {
+        auto unwind = dynamic_cast<DocumentSourceUnwind*>(shardPipe->getSources().back().get());
+        if (!unwind || unwind->absorbedMatch()) {
+            break;
+        }
         mergePipe->addInitialSource(shardPipe->popBack());
     }
 }
@@ -348,6 +355,33 @@ boost::optional<ShardedExchangePolicy> walkPipelineBackwardsTrackingShardKey(
     return ShardedExchangePolicy{std::move(exchangeSpec), std::move(consumerShards)};
 }
 
+/**
+ * Returns the number of leading stages of 'mergePipeline' which can run independently on each
+ * partition of the partial groups when those are partitioned by their group key, or zero if the
+ * pipeline does not begin with the merging half of a $group. Every stage after the $group up to
+ * the next one which needs to see the whole stream, or which must run on a particular host,
+ * qualifies, since none of them can combine documents from different groups.
+ */
+size_t numStagesPartitionableByGroupKey(const Pipeline* mergePipeline) {
+    const auto& stages = mergePipeline->getSources();
+    const auto leadingGroup = dynamic_cast<DocumentSourceGroup*>(stages.front().get());
+    if (!leadingGroup || !leadingGroup->doingMerge()) {
+        return 0;
+    }
+
+    size_t numStages = 1;
+    for (auto it = std::next(stages.begin()); it != stages.end(); ++it, ++numStages) {
+        const auto& stage = *it;
+        if (dynamic_cast<NeedsMergerDocumentSource*>(stage.get()) ||
+            dynamic_cast<DocumentSourceOut*>(stage.get()) ||
+            stage->constraints(Pipeline::SplitState::kSplitForMerge).hostRequirement !=
+                StageConstraints::HostTypeRequirement::kNone) {
+            break;
+        }
+    }
+    return numStages;
+}
+
 }  // namespace
 
 SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
@@ -479,5 +513,66 @@ boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationConte
     return walkPipelineBackwardsTrackingShardKey(opCtx, outStage, mergePipeline, *routingInfo.cm());
 }
 
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    OperationContext* opCtx,
+    const Pipeline* mergePipeline,
+    const std::set<ShardId>& targetedShards) {
+    if (internalQueryDisableExchange.load() || mergePipeline->getSources().empty()) {
+        return boost::none;
+    }
+
+    const size_t numConsumers =
+        std::min({static_cast<size_t>(std::max(internalQueryMaxGroupExchangeConsumers.load(), 0)),
+                  targetedShards.size(),
+                  Exchange::kMaxNumberConsumers});
+    if (numConsumers < 2) {
+        return boost::none;
+    }
+
+    // Group keys which compare equal under a non-simple collation may hash differently, which
+    // would split a group across consumers.
+    const auto& expCtx = mergePipeline->getContext();
+    if (expCtx->getCollator() || expCtx->tailableMode != TailableModeEnum::kNormal ||
+        TransactionRouter::get(opCtx)) {
+        return boost::none;
+    }
+
+    const size_t numConsumerStages = numStagesPartitionableByGroupKey(mergePipeline);
+    if (numConsumerStages == 0) {
+        return boost::none;
+    }
+
+    // Every partial group carries its group key in '_id'. Equal keys hash equally, whatever their
+    // numeric types, so dividing the range of hashes evenly sends each group to exactly one
+    // consumer.
+    const auto kMinHash = std::numeric_limits<long long>::min();
+    const unsigned long long intervalSize =
+        std::numeric_limits<unsigned long long>::max() / numConsumers;
+    std::vector<BSONObj> boundaries;
+    std::vector<int> consumerIds;
+    boundaries.emplace_back(BSON("_id" << MINKEY));
+    for (size_t i = 1; i < numConsumers; ++i) {
+        boundaries.emplace_back(BSON(
+            "_id" << static_cast<long long>(static_cast<unsigned long long>(kMinHash) +
+                                            i * intervalSize)));
+        consumerIds.emplace_back(i - 1);
+    }
+    boundaries.emplace_back(BSON("_id" << MAXKEY));
+    consumerIds.emplace_back(numConsumers - 1);
+
+    ExchangeSpec exchangeSpec;
+    exchangeSpec.setPolicy(ExchangePolicyEnum::kKeyRange);
+    exchangeSpec.setKey(BSON("_id"
+                             << "hashed"));
+    exchangeSpec.setBoundaries(std::move(boundaries));
+    exchangeSpec.setConsumers(numConsumers);
+    exchangeSpec.setConsumerIds(std::move(consumerIds));
+
+    std::vector<ShardId> consumerShards(targetedShards.begin(),
+                                        std::next(targetedShards.begin(), numConsumers));
+    return ShardedExchangePolicy{
+        std::move(exchangeSpec), std::move(consumerShards), numConsumerStages};
+}
+
 }  // namespace cluster_aggregation_planner
 }  // namespace mongo
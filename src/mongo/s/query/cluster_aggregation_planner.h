@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <set>
+
 #include "mongo/db/pipeline/exchange_spec_gen.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
 #include "mongo/db/pipeline/pipeline.h"
@@ -100,6 +102,11 @@ struct ShardedExchangePolicy {
 
     // Shards that will run the consumer part of the exchange.
     std::vector<ShardId> consumerShards;
+
+    // If set, the consumers run only this many leading stages of the merge pipeline, and the rest
+    // of the merge pipeline merges the consumers' results as usual. Otherwise the consumers run the
+    // whole merge pipeline and their results are simply unioned.
+    boost::optional<size_t> numConsumerStages;
 };
 
 /**
@@ -108,5 +115,16 @@ struct ShardedExchangePolicy {
  */
 boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationContext* opCtx,
                                                                   const Pipeline* mergePipeline);
+
+/**
+ * If the merging pipeline begins with the merging half of a $group and
+ * internalQueryMaxGroupExchangeConsumers permits, returns the information required to hash
+ * partition the partial groups produced by 'targetedShards' by their group key across several of
+ * those shards, so that each completes the $group for its own partition in parallel.
+ */
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    OperationContext* opCtx,
+    const Pipeline* mergePipeline,
+    const std::set<ShardId>& targetedShards);
 }  // namespace cluster_aggregation_planner
 }  // namespace mongo
@@ -42,6 +42,7 @@
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/catalog_cache_test_fixture.h"
 #include "mongo/s/query/cluster_aggregation_planner.h"
+#include "mongo/s/query/cluster_query_knobs.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
 
@@ -595,5 +596,68 @@ TEST_F(ClusterExchangeTest, CompoundShardKeyThreeShards) {
 
     future.timed_get(kFutureTimeout);
 }
+
+TEST_F(ClusterExchangeTest, GroupIsEligibleForGroupExchangeAcrossTargetedShards) {
+    internalQueryMaxGroupExchangeConsumers.store(3);
+    ON_BLOCK_EXIT([] { internalQueryMaxGroupExchangeConsumers.store(0); });
+
+    auto mergePipe = unittest::assertGet(
+        Pipeline::create({parse("{$group: {_id: '$x', $doingMerge: true}}"),
+                          parse("{$project: {x: '$_id'}}"),
+                          parse("{$sort: {x: 1}}")},
+                         expCtx()));
+
+    const std::set<ShardId> targetedShards{ShardId("0"), ShardId("1"), ShardId("2"), ShardId("3")};
+    auto exchangeSpec = cluster_aggregation_planner::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), targetedShards);
+    ASSERT_TRUE(exchangeSpec);
+    ASSERT(exchangeSpec->exchangeSpec.getPolicy() == ExchangePolicyEnum::kKeyRange);
+    ASSERT_BSONOBJ_EQ(exchangeSpec->exchangeSpec.getKey(),
+                      BSON("_id"
+                           << "hashed"));
+
+    // The consumers run the $group and the $project, but leave the $sort to the final merge.
+    ASSERT_EQ(*exchangeSpec->numConsumerStages, 2UL);
+    ASSERT_EQ(exchangeSpec->consumerShards.size(), 3UL);
+    ASSERT_EQ(exchangeSpec->exchangeSpec.getConsumers(), 3);
+
+    // The range of hashes is divided evenly between the consumers.
+    const auto& boundaries = exchangeSpec->exchangeSpec.getBoundaries().get();
+    const auto& consumerIds = exchangeSpec->exchangeSpec.getConsumerIds().get();
+    ASSERT_EQ(boundaries.size(), 4UL);
+    ASSERT_BSONOBJ_EQ(boundaries[0], BSON("_id" << MINKEY));
+    ASSERT_LT(boundaries[1]["_id"].numberLong(), boundaries[2]["_id"].numberLong());
+    ASSERT_BSONOBJ_EQ(boundaries[3], BSON("_id" << MAXKEY));
+    ASSERT_EQ(consumerIds, std::vector<int>({0, 1, 2}));
+}
+
+TEST_F(ClusterExchangeTest, GroupExchangeRequiresLeadingMergingGroupAndSeveralConsumers) {
+    const std::set<ShardId> targetedShards{ShardId("0"), ShardId("1")};
+    auto mergePipe = unittest::assertGet(Pipeline::create(
+        {parse("{$group: {_id: '$x', $doingMerge: true}}")}, expCtx()));
+
+    // Disabled by default.
+    ASSERT_FALSE(cluster_aggregation_planner::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), targetedShards));
+
+    internalQueryMaxGroupExchangeConsumers.store(4);
+    ON_BLOCK_EXIT([] { internalQueryMaxGroupExchangeConsumers.store(0); });
+
+    auto exchangeSpec = cluster_aggregation_planner::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), targetedShards);
+    ASSERT_TRUE(exchangeSpec);
+    ASSERT_EQ(exchangeSpec->consumerShards.size(), 2UL);
+    ASSERT_EQ(*exchangeSpec->numConsumerStages, 1UL);
+
+    // A single targeted shard leaves nothing to parallelize.
+    ASSERT_FALSE(cluster_aggregation_planner::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), {ShardId("0")}));
+
+    mergePipe = unittest::assertGet(
+        Pipeline::create({parse("{$sort: {x: 1}}"), parse("{$group: {_id: '$x'}}")}, expCtx()));
+    ASSERT_FALSE(cluster_aggregation_planner::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), targetedShards));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -38,4 +38,13 @@ MONGO_EXPORT_SERVER_PARAMETER(internalQueryAlwaysMergeOnPrimaryShard, bool, fals
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryProhibitMergingOnMongoS, bool, false);
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryDisableExchange, bool, false);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryMaxGroupExchangeConsumers, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryMaxGroupExchangeConsumers must be >= 0");
+        }
+        return Status::OK();
+    });
+
 }  // namespace mongo
@@ -48,4 +48,10 @@ extern AtomicBool internalQueryProhibitMergingOnMongoS;
 // If set to true on mongos then the cluster query planner will not produce plans with the exchange.
 // False by default, so the queries run with exchanges.
 extern AtomicBool internalQueryDisableExchange;
+
+// When greater than one on mongos, an aggregation whose merging pipeline begins with a $group hash
+// partitions the partial groups from the shards across up to this many of the targeted shards,
+// each of which completes the $group for its partition. Zero by default, meaning that the $group is
+// always completed by a single merger.
+extern AtomicInt32 internalQueryMaxGroupExchangeConsumers;
 }  // namespace mongo
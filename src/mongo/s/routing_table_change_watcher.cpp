@@ -0,0 +1,262 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kSharding
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/routing_table_change_watcher.h"
+
+#include <set>
+
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/db/query/getmore_request.h"
+#include "mongo/db/repl/optime.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+#include "mongo/s/catalog/type_chunk.h"
+#include "mongo/s/catalog/type_collection.h"
+#include "mongo/s/catalog_cache.h"
+#include "mongo/s/client/shard_registry.h"
+#include "mongo/s/grid.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/exit.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+namespace {
+
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(routingTableChangeNotificationsEnabled, bool, false);
+
+const auto getRoutingTableChangeWatcher =
+    ServiceContext::declareDecoration<RoutingTableChangeWatcher>();
+
+const NamespaceString kConfigOplogNamespace("local.oplog.rs");
+
+// How long to wait before following the oplog of the config server again after an error
+const Seconds kRetryInterval(1);
+
+/**
+ * Selects the oplog entries after 'lastSeen' which write to the sharding catalog collections
+ * describing routing tables, directly or within an applyOps.
+ */
+BSONObj makeOplogFilter(Timestamp lastSeen) {
+    const auto namespaces = BSON_ARRAY(ChunkType::ConfigNS.ns() << CollectionType::ConfigNS.ns());
+    return BSON("ts" << BSON("$gt" << lastSeen) << "$or"
+                     << BSON_ARRAY(BSON("ns" << BSON("$in" << namespaces))
+                                   << BSON("o.applyOps.ns" << BSON("$in" << namespaces))));
+}
+
+/**
+ * Runs a cursor command against the oplog of the config server primary. The getMore commands must
+ * be run on the same host as the command which established the cursor, so if the primary changes
+ * they fail and the oplog is followed again from the new primary.
+ */
+std::pair<BSONObj, CursorResponse> runCursorCommandOnConfigPrimary(OperationContext* opCtx,
+                                                                   const BSONObj& cmdObj,
+                                                                   Shard::RetryPolicy retryPolicy) {
+    const auto configShard = Grid::get(opCtx)->shardRegistry()->getConfigShard();
+    auto swResponse = configShard->runCommand(opCtx,
+                                              ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+                                              kConfigOplogNamespace.db().toString(),
+                                              cmdObj,
+                                              retryPolicy);
+    uassertStatusOK(Shard::CommandResponse::getEffectiveStatus(swResponse));
+
+    // The entries of the batch point into the response, which must outlive them
+    auto response = std::move(swResponse.getValue().response);
+    auto cursorResponse = uassertStatusOK(CursorResponse::parseFromBSON(response));
+    return {std::move(response), std::move(cursorResponse)};
+}
+
+}  // namespace
+
+RoutingTableChangeWatcher& RoutingTableChangeWatcher::get(ServiceContext* serviceContext) {
+    return getRoutingTableChangeWatcher(serviceContext);
+}
+
+RoutingTableChangeWatcher& RoutingTableChangeWatcher::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void RoutingTableChangeWatcher::startThread() {
+    invariant(!_started);
+    _started = true;
+
+    if (!routingTableChangeNotificationsEnabled) {
+        return;
+    }
+
+    stdx::thread([this] {
+        Client::initThread("RoutingTableChangeWatcher");
+
+        while (!globalInShutdownDeprecated()) {
+            try {
+                auto opCtx = cc().makeOperationContext();
+                _tailConfigOplog(opCtx.get());
+            } catch (const DBException& ex) {
+                LOG(1) << "Stopped following the config server oplog for routing table changes"
+                       << causedBy(redact(ex.toStatus()));
+            }
+
+            MONGO_IDLE_THREAD_BLOCK;
+            sleepFor(kRetryInterval);
+        }
+    }).detach();
+}
+
+std::vector<NamespaceString> RoutingTableChangeWatcher::getNamespacesChangedByOplogEntry(
+    const BSONObj& entry) {
+    std::vector<NamespaceString> namespaces;
+
+    const auto addNamespace = [&namespaces](const BSONElement& nsElem) {
+        if (nsElem.type() != String) {
+            return;
+        }
+
+        NamespaceString nss(nsElem.valueStringData());
+        if (nss.isValid()) {
+            namespaces.push_back(std::move(nss));
+        }
+    };
+
+    const auto o = entry["o"].type() == Object ? entry["o"].Obj() : BSONObj();
+
+    if (entry["op"].str() == "c") {
+        const auto applyOps = o["applyOps"];
+        if (applyOps.type() != Array) {
+            return namespaces;
+        }
+
+        for (const auto& op : applyOps.Obj()) {
+            if (op.type() == Object) {
+                auto opNamespaces = getNamespacesChangedByOplogEntry(op.Obj());
+                namespaces.insert(namespaces.end(), opNamespaces.begin(), opNamespaces.end());
+            }
+        }
+        return namespaces;
+    }
+
+    const auto ns = entry["ns"].str();
+    if (ns == ChunkType::ConfigNS.ns()) {
+        // Chunks are inserted and replaced as a whole, so the entry contains their namespace.
+        // Chunks are only removed when their collection is dropped, which also updates its entry in
+        // config.collections.
+        addNamespace(o[ChunkType::ns.name()]);
+    } else if (ns == CollectionType::ConfigNS.ns()) {
+        // Collections are identified by their namespace
+        const auto o2 = entry["o2"];
+        addNamespace((o2.type() == Object ? o2.Obj() : o)["_id"]);
+    }
+
+    return namespaces;
+}
+
+void RoutingTableChangeWatcher::_tailConfigOplog(OperationContext* opCtx) {
+    if (_lastSeenTimestamp.isNull()) {
+        // The routing tables which are cached already are as recent as the last entry of the oplog
+        // or more, so only the changes made after it matter
+        const auto lastEntry = runCursorCommandOnConfigPrimary(
+            opCtx,
+            BSON("find" << kConfigOplogNamespace.coll() << "sort" << BSON("$natural" << -1)
+                        << "limit"
+                        << 1
+                        << "singleBatch"
+                        << true
+                        << "projection"
+                        << BSON("ts" << 1)),
+            Shard::RetryPolicy::kIdempotent);
+
+        const auto& batch = lastEntry.second.getBatch();
+        uassert(ErrorCodes::NoMatchingDocument,
+                "The oplog of the config server is empty",
+                !batch.empty());
+        _lastSeenTimestamp = batch.front()["ts"].timestamp();
+    }
+
+    auto response =
+        runCursorCommandOnConfigPrimary(opCtx,
+                                        BSON("find" << kConfigOplogNamespace.coll() << "filter"
+                                                    << makeOplogFilter(_lastSeenTimestamp)
+                                                    << "tailable"
+                                                    << true
+                                                    << "awaitData"
+                                                    << true
+                                                    << "oplogReplay"
+                                                    << true),
+                                        Shard::RetryPolicy::kIdempotent);
+
+    while (true) {
+        _processOplogEntries(opCtx, response.second.getBatch());
+
+        const auto cursorId = response.second.getCursorId();
+        if (cursorId == 0 || globalInShutdownDeprecated()) {
+            return;
+        }
+
+        // Without a maxTimeMS, the config server waits for up to a second for new oplog entries
+        // before returning an empty batch
+        const GetMoreRequest getMore(
+            kConfigOplogNamespace, cursorId, boost::none, boost::none, boost::none, boost::none);
+        response = runCursorCommandOnConfigPrimary(
+            opCtx, getMore.toBSON(), Shard::RetryPolicy::kNoRetry);
+    }
+}
+
+void RoutingTableChangeWatcher::_processOplogEntries(OperationContext* opCtx,
+                                                     const std::vector<BSONObj>& entries) {
+    if (entries.empty()) {
+        return;
+    }
+
+    std::set<NamespaceString> changedNamespaces;
+    for (const auto& entry : entries) {
+        for (auto& nss : getNamespacesChangedByOplogEntry(entry)) {
+            changedNamespaces.insert(std::move(nss));
+        }
+    }
+
+    const auto& lastEntry = entries.back();
+    _lastSeenTimestamp = lastEntry["ts"].timestamp();
+
+    // The refreshes read the sharding catalog at the optime of the last entry or later, so they
+    // see the changes even though they may not have been majority committed when returned here
+    Grid::get(opCtx)->advanceConfigOpTime(
+        uassertStatusOK(repl::OpTime::parseFromOplogEntry(lastEntry)));
+
+    const auto catalogCache = Grid::get(opCtx)->catalogCache();
+    for (const auto& nss : changedNamespaces) {
+        LOG(1) << "Routing table of " << nss << " changed on the config server, refreshing it";
+        catalogCache->onRoutingTableChangeNotification(nss);
+    }
+}
+
+}  // namespace mongo
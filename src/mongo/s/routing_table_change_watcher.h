@@ -0,0 +1,96 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/timestamp.h"
+#include "mongo/db/namespace_string.h"
+
+namespace mongo {
+
+class BSONObj;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Follows the oplog of the config server to learn as soon as the routing table of a sharded
+ * collection changes, for example because a chunk was migrated or split, and starts refreshing the
+ * cached routing table of the collection right away. This way the CatalogCache of mongos and of the
+ * shards is usually up to date before a request is routed with the stale routing table, so there
+ * are much fewer StaleConfig errors and concurrent refreshes after a migration.
+ *
+ * After an error, the watcher resumes from the last oplog entry it has processed. Changes it misses
+ * anyway, for example because that entry is no longer in the oplog, are still found out about
+ * through StaleConfig errors, as when the watcher is not running.
+ */
+class RoutingTableChangeWatcher {
+    MONGO_DISALLOW_COPYING(RoutingTableChangeWatcher);
+
+public:
+    RoutingTableChangeWatcher() = default;
+
+    static RoutingTableChangeWatcher& get(ServiceContext* serviceContext);
+    static RoutingTableChangeWatcher& get(OperationContext* opCtx);
+
+    /**
+     * Starts following the oplog of the config server, unless disabled with the
+     * 'routingTableChangeNotificationsEnabled' server parameter. The watcher thread stops on its
+     * own at shutdown.
+     *
+     * Must be called at most once, after sharding has been initialized.
+     */
+    void startThread();
+
+    /**
+     * Returns the namespaces whose routing table is changed by the given config server oplog
+     * entry, which may be an applyOps of several writes to the sharding catalog.
+     */
+    static std::vector<NamespaceString> getNamespacesChangedByOplogEntry(const BSONObj& entry);
+
+private:
+    /**
+     * Tails the oplog of the config server from '_lastSeenTimestamp' and notifies the CatalogCache
+     * of the changes of routing tables, until an error occurs or shutdown.
+     */
+    void _tailConfigOplog(OperationContext* opCtx);
+
+    /**
+     * Handles a batch of oplog entries returned by the config server.
+     */
+    void _processOplogEntries(OperationContext* opCtx, const std::vector<BSONObj>& entries);
+
+    // Timestamp of the last config server oplog entry processed; only accessed by the thread
+    Timestamp _lastSeenTimestamp;
+
+    bool _started{false};
+};
+
+}  // namespace mongo
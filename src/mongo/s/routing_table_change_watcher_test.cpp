@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/routing_table_change_watcher.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/s/catalog/type_chunk.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("TestDB.TestColl");
+const NamespaceString kOtherNss("TestDB.OtherColl");
+
+BSONObj makeChunkDoc(const NamespaceString& nss, int min, int max) {
+    return BSON("_id" << ChunkType::genID(nss, BSON("x" << min)) << "ns" << nss.ns() << "min"
+                      << BSON("x" << min)
+                      << "max"
+                      << BSON("x" << max)
+                      << "shard"
+                      << "shard0");
+}
+
+BSONObj makeChunkUpdate(const NamespaceString& nss, int min, int max) {
+    const auto chunk = makeChunkDoc(nss, min, max);
+    return BSON("op"
+                << "u"
+                << "ns"
+                << "config.chunks"
+                << "o2"
+                << BSON("_id" << chunk["_id"])
+                << "o"
+                << chunk);
+}
+
+TEST(RoutingTableChangeWatcherTest, ChunkInsert) {
+    const auto entry = BSON("op"
+                            << "i"
+                            << "ns"
+                            << "config.chunks"
+                            << "o"
+                            << makeChunkDoc(kNss, 0, 10));
+
+    const auto namespaces = RoutingTableChangeWatcher::getNamespacesChangedByOplogEntry(entry);
+    ASSERT_EQ(1U, namespaces.size());
+    ASSERT_EQ(kNss, namespaces[0]);
+}
+
+TEST(RoutingTableChangeWatcherTest, ChunkUpdatesWithinApplyOps) {
+    const auto applyOps =
+        BSON_ARRAY(makeChunkUpdate(kNss, 0, 5) << makeChunkUpdate(kOtherNss, 5, 10));
+    const auto entry = BSON("op"
+                            << "c"
+                            << "ns"
+                            << "admin.$cmd"
+                            << "o"
+                            << BSON("applyOps" << applyOps));
+
+    const auto namespaces = RoutingTableChangeWatcher::getNamespacesChangedByOplogEntry(entry);
+    ASSERT_EQ(2U, namespaces.size());
+    ASSERT_EQ(kNss, namespaces[0]);
+    ASSERT_EQ(kOtherNss, namespaces[1]);
+}
+
+TEST(RoutingTableChangeWatcherTest, CollectionUpdate) {
+    const auto entry = BSON("op"
+                            << "u"
+                            << "ns"
+                            << "config.collections"
+                            << "o2"
+                            << BSON("_id" << kNss.ns())
+                            << "o"
+                            << BSON("$set" << BSON("dropped" << true)));
+
+    const auto namespaces = RoutingTableChangeWatcher::getNamespacesChangedByOplogEntry(entry);
+    ASSERT_EQ(1U, namespaces.size());
+    ASSERT_EQ(kNss, namespaces[0]);
+}
+
+TEST(RoutingTableChangeWatcherTest, ChunkDeleteAndUnrelatedWritesAreIgnored) {
+    const auto chunkDelete = BSON("op"
+                                  << "d"
+                                  << "ns"
+                                  << "config.chunks"
+                                  << "o"
+                                  << BSON("_id" << ChunkType::genID(kNss, BSON("x" << 0))));
+    ASSERT(RoutingTableChangeWatcher::getNamespacesChangedByOplogEntry(chunkDelete).empty());
+
+    const auto unrelated = BSON("op"
+                                << "i"
+                                << "ns"
+                                << "config.changelog"
+                                << "o"
+                                << BSON("_id"
+                                        << "host-2018"
+                                        << "ns"
+                                        << kNss.ns()));
+    ASSERT(RoutingTableChangeWatcher::getNamespacesChangedByOplogEntry(unrelated).empty());
+
+    const auto noop = BSON("op"
+                           << "n"
+                           << "ns"
+                           << ""
+                           << "o"
+                           << BSON("msg"
+                                   << "periodic noop"));
+    ASSERT(RoutingTableChangeWatcher::getNamespacesChangedByOplogEntry(noop).empty());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -80,6 +80,7 @@
 #include "mongo/s/mongos_options.h"
 #include "mongo/s/query/cluster_cursor_cleanup_job.h"
 #include "mongo/s/query/cluster_cursor_manager.h"
+#include "mongo/s/routing_table_change_watcher.h"
 #include "mongo/s/service_entry_point_mongos.h"
 #include "mongo/s/sharding_egress_metadata_hook_for_mongos.h"
 #include "mongo/s/sharding_egress_metadata_hook_for_mongos.h"
@@ -317,6 +318,8 @@ Status initializeSharding(OperationContext* opCtx) {
 
     Grid::get(opCtx)->setShardingInitialized();
 
+    warmUpShardingConnections(opCtx);
+
     return Status::OK();
 }
 
@@ -373,6 +376,7 @@ ExitCode runMongosServer(ServiceContext* serviceContext) {
         &ShardRegistry::replicaSetChangeConfigServerUpdateHook);
     ReplicaSetMonitor::setSynchronousConfigChangeHook(
         &ShardRegistry::replicaSetChangeShardRegistryUpdateHook);
+    ReplicaSetMonitor::setPrimaryChangeHook(&ShardRegistry::replicaSetPrimaryChangeWarmUpHook);
 
     // Mongos connection pools already takes care of authenticating new connections so the
     // replica set connection shouldn't need to.
@@ -418,6 +422,8 @@ ExitCode runMongosServer(ServiceContext* serviceContext) {
     shardingUptimeReporter.emplace();
     shardingUptimeReporter->startPeriodicThread();
 
+    RoutingTableChangeWatcher::get(serviceContext).startThread();
+
     clusterCursorCleanupJob.go();
 
     UserCacheInvalidator cacheInvalidatorThread(AuthorizationManager::get(serviceContext));
@@ -32,9 +32,12 @@
 
 #include "mongo/s/sharding_initialization.h"
 
+#include <algorithm>
 #include <string>
 
 #include "mongo/base/status.h"
+#include "mongo/client/read_preference.h"
+#include "mongo/client/remote_command_targeter.h"
 #include "mongo/db/audit.h"
 #include "mongo/db/keys_collection_client_sharded.h"
 #include "mongo/db/keys_collection_manager.h"
@@ -79,6 +82,12 @@ MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolHostTimeoutMS,
                                       ConnectionPool::kDefaultHostTimeout.count());
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolMaxSize, int, -1);
 
+// Limits the connections to any one host from all the pools together, rather than from each of
+// them, since with taskExecutorPoolSize there may be one pool per core. The limit is divided evenly
+// among the pools, each of which then queues the requests to a host once it has its share of
+// connections open to it. -1 means no limit.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolMaxSizePerHost, int, -1);
+
 // By default, limit us to two concurrent pending connection attempts
 // in any one pool. Since pools are currently per-cpu, we still may
 // have something like 64 concurrent total connection attempts on a
@@ -96,6 +105,28 @@ MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolRefreshTimeoutMS,
                                       int,
                                       ConnectionPool::kDefaultRefreshTimeout.count());
 
+// The number of connections each pool opens to the primaries of the config server and shard
+// replica sets at startup, and to a new primary as soon as it is elected, so that the first wave of
+// requests doesn't wait for connection setup. Zero opens connections only on demand.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolWarmUpSize, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue, "ShardingTaskExecutorPoolWarmUpSize must be >= 0");
+        }
+        return Status::OK();
+    });
+
+// When positive, each pool keeps this multiple of the moving average of the connections in demand
+// to a host open, growing ahead of bursts of requests rather than in response to them.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(ShardingTaskExecutorPoolDemandScalingFactor, double, 0.0)
+    ->withValidator([](const double& newVal) {
+        if (newVal < 0.0) {
+            return Status(ErrorCodes::BadValue,
+                          "ShardingTaskExecutorPoolDemandScalingFactor must be >= 0");
+        }
+        return Status::OK();
+    });
+
 namespace {
 
 using executor::NetworkInterface;
@@ -127,6 +158,17 @@ std::unique_ptr<TaskExecutorPool> makeShardingTaskExecutorPool(
 
     const auto poolSize = taskExecutorPoolSize.value_or(TaskExecutorPool::getSuggestedPoolSize());
 
+    if (ShardingTaskExecutorPoolMaxSizePerHost != -1) {
+        // Every pool needs at least one connection to a host to make progress on its requests.
+        const size_t perHost = std::max(ShardingTaskExecutorPoolMaxSizePerHost, 1);
+        const size_t perPool = std::max<size_t>((perHost + poolSize - 1) / poolSize, 1);
+        if (perPool < connPoolOptions.maxConnections) {
+            connPoolOptions.maxConnections = perPool;
+        }
+        log() << "Limiting each of the " << poolSize << " sharding task executor pools to "
+              << connPoolOptions.maxConnections << " connections per host";
+    }
+
     for (size_t i = 0; i < poolSize; ++i) {
         auto exec = makeShardingTaskExecutor(
             executor::makeNetworkInterface("TaskExecutorPool-" + std::to_string(i),
@@ -191,6 +233,8 @@ Status initializeGlobalShardingState(OperationContext* opCtx,
     connPoolOptions.minConnections = ShardingTaskExecutorPoolMinSize;
     connPoolOptions.refreshRequirement = Milliseconds(ShardingTaskExecutorPoolRefreshRequirementMS);
     connPoolOptions.refreshTimeout = Milliseconds(ShardingTaskExecutorPoolRefreshTimeoutMS);
+    connPoolOptions.warmUpConnections = ShardingTaskExecutorPoolWarmUpSize;
+    connPoolOptions.demandScalingFactor = ShardingTaskExecutorPoolDemandScalingFactor;
 
     if (connPoolOptions.refreshRequirement <= connPoolOptions.refreshTimeout) {
         auto newRefreshTimeout = connPoolOptions.refreshRequirement - Milliseconds(1);
@@ -288,4 +332,31 @@ Status waitForShardRegistryReload(OperationContext* opCtx) {
     return {ErrorCodes::ShutdownInProgress, "aborting shard loading attempt"};
 }
 
+void warmUpShardingConnections(OperationContext* opCtx) {
+    if (!ShardingTaskExecutorPoolWarmUpSize) {
+        return;
+    }
+
+    auto const grid = Grid::get(opCtx);
+    auto const shardRegistry = grid->shardRegistry();
+
+    std::vector<std::shared_ptr<Shard>> shards{shardRegistry->getConfigShard()};
+    std::vector<ShardId> shardIds;
+    shardRegistry->getAllShardIdsNoReload(&shardIds);
+    for (const auto& shardId : shardIds) {
+        if (auto shard = shardRegistry->getShardNoReload(shardId)) {
+            shards.push_back(std::move(shard));
+        }
+    }
+
+    // Sets whose primary isn't known yet are warmed up once their ReplicaSetMonitor finds it.
+    const ReadPreferenceSetting primaryOnly{ReadPreference::PrimaryOnly};
+    for (const auto& shard : shards) {
+        auto swPrimary = shard->getTargeter()->findHostNoWait(primaryOnly);
+        if (swPrimary.isOK()) {
+            grid->getExecutorPool()->warmUpConnections(swPrimary.getValue());
+        }
+    }
+}
+
 }  // namespace mongo
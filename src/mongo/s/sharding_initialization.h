@@ -89,4 +89,10 @@ Status initializeGlobalShardingState(OperationContext* opCtx,
 
 Status waitForShardRegistryReload(OperationContext* opCtx);
 
+/**
+ * Warms up the sharding task executors' connections to the primaries of the config server and of
+ * every shard known to the Shard Registry, if ShardingTaskExecutorPoolWarmUpSize is set.
+ */
+void warmUpShardingConnections(OperationContext* opCtx);
+
 }  // namespace mongo
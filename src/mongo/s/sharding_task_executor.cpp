@@ -241,5 +241,9 @@ void ShardingTaskExecutor::appendConnectionStats(ConnectionPoolStats* stats) con
     _executor->appendConnectionStats(stats);
 }
 
+void ShardingTaskExecutor::warmUpConnections(const HostAndPort& hostAndPort) {
+    _executor->warmUpConnections(hostAndPort);
+}
+
 }  // namespace executor
 }  // namespace mongo
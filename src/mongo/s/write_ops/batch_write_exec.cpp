@@ -94,6 +94,36 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
 
     BatchWriteOp batchOp(opCtx, clientRequest);
 
+    // Unordered writes have no order to honor across shards, so outside of transactions the next
+    // write ops for a shard are sent as soon as it has answered, rather than once every shard
+    // targeted in the round has. Ordered writes stay sequential, since writes sent ahead of an
+    // earlier failing one could not be undone.
+    const bool streamUnorderedBatches =
+        !clientRequest.getWriteCommandBase().getOrdered() && !TransactionRouter::get(opCtx);
+
+    const auto buildShardRequest = [&](const TargetedWriteBatch& batch) {
+        const auto shardBatchRequest(batchOp.buildBatchRequest(batch));
+
+        BSONObjBuilder requestBuilder;
+        shardBatchRequest.serialize(&requestBuilder);
+
+        {
+            OperationSessionInfo sessionInfo;
+
+            if (opCtx->getLogicalSessionId()) {
+                sessionInfo.setSessionId(*opCtx->getLogicalSessionId());
+            }
+
+            sessionInfo.setTxnNumber(opCtx->getTxnNumber());
+            sessionInfo.serialize(&requestBuilder);
+        }
+
+        auto request = requestBuilder.obj();
+        LOG(4) << "Sending write batch to " << batch.getEndpoint().shardName << ": "
+               << redact(request);
+        return request;
+    };
+
     // Current batch status
     bool refreshedTargeter = false;
     int rounds = 0;
@@ -174,29 +204,7 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
 
                 stats->noteTargetedShard(targetShardId);
 
-                const auto request = [&] {
-                    const auto shardBatchRequest(batchOp.buildBatchRequest(*nextBatch));
-
-                    BSONObjBuilder requestBuilder;
-                    shardBatchRequest.serialize(&requestBuilder);
-
-                    {
-                        OperationSessionInfo sessionInfo;
-
-                        if (opCtx->getLogicalSessionId()) {
-                            sessionInfo.setSessionId(*opCtx->getLogicalSessionId());
-                        }
-
-                        sessionInfo.setTxnNumber(opCtx->getTxnNumber());
-                        sessionInfo.serialize(&requestBuilder);
-                    }
-
-                    return requestBuilder.obj();
-                }();
-
-                LOG(4) << "Sending write batch to " << targetShardId << ": " << redact(request);
-
-                requests.emplace_back(targetShardId, request);
+                requests.emplace_back(targetShardId, buildShardRequest(*nextBatch));
 
                 // Indicate we're done by setting the batch to nullptr. We'll only get duplicate
                 // hostEndpoints if we have broadcast and non-broadcast endpoints for the same host,
@@ -217,6 +225,10 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                                       : Shard::RetryPolicy::kNoRetry);
             numSent += pendingBatches.size();
 
+            // Stale responses make the targeter refresh before the next round, so nothing more is
+            // sent in this one once any has been received.
+            bool sawStaleResponses = false;
+
             //
             // Receive the responses.
             //
@@ -293,6 +305,7 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                     if (!staleErrors.empty()) {
                         noteStaleResponses(staleErrors, &targeter);
                         ++stats->numStaleBatches;
+                        sawStaleResponses = true;
                     }
 
                     const auto& cannotImplicitlyCreateErrors =
@@ -301,6 +314,7 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                         // This forces the chunk manager to reload so we can attach the correct
                         // version on retry and make sure we route to the correct shard.
                         targeter.noteCouldNotTarget();
+                        sawStaleResponses = true;
                     }
 
                     // Remember that we successfully wrote to this shard
@@ -313,6 +327,21 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                                        batchedCommandResponse.isElectionIdSet()
                                            ? batchedCommandResponse.getElectionId()
                                            : OID());
+
+                    if (streamUnorderedBatches && !sawStaleResponses &&
+                        opCtx->checkForInterruptNoAssert().isOK()) {
+                        const auto& shardId = response.shardId;
+                        if (auto nextBatch =
+                                batchOp.targetUnorderedBatchForShard(targeter, shardId)) {
+                            // The answered batch is replaced by the one sending the next write ops.
+                            auto it = pendingBatches.find(shardId);
+                            delete it->second;
+                            it->second = nextBatch;
+
+                            ars.addRequests({{shardId, buildShardRequest(*nextBatch)}});
+                            ++stats->numStreamedBatches;
+                        }
+                    }
                 } else {
                     // Error occurred dispatching, note it
                     const Status status = responseStatus.withContext(
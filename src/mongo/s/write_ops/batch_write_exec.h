@@ -85,7 +85,11 @@ typedef std::map<ConnectionString, HostOpTime> HostOpTimeMap;
 class BatchWriteExecStats {
 public:
     BatchWriteExecStats()
-        : numRounds(0), numTargetErrors(0), numResolveErrors(0), numStaleBatches(0) {}
+        : numRounds(0),
+          numTargetErrors(0),
+          numResolveErrors(0),
+          numStaleBatches(0),
+          numStreamedBatches(0) {}
 
     void noteWriteAt(const HostAndPort& host, repl::OpTime opTime, const OID& electionId);
     void noteTargetedShard(const ShardId& shardId);
@@ -103,6 +107,8 @@ public:
     int numResolveErrors;
     // Number of stale batches
     int numStaleBatches;
+    // Number of batches sent to a shard as soon as it answered, within a round
+    int numStreamedBatches;
 
 private:
     std::set<ShardId> _targetedShards;
@@ -30,6 +30,7 @@
 
 #include "mongo/s/write_ops/batch_write_op.h"
 
+#include <algorithm>
 #include <numeric>
 
 #include "mongo/base/error_codes.h"
@@ -256,6 +257,25 @@ BatchWriteOp::~BatchWriteOp() {
 Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
                                  bool recordTargetErrors,
                                  std::map<ShardId, TargetedWriteBatch*>* targetedBatches) {
+    return _targetBatch(targeter, recordTargetErrors, nullptr, targetedBatches);
+}
+
+TargetedWriteBatch* BatchWriteOp::targetUnorderedBatchForShard(const NSTargeter& targeter,
+                                                               const ShardId& shardId) {
+    invariant(!_clientRequest.getWriteCommandBase().getOrdered());
+
+    std::map<ShardId, TargetedWriteBatch*> targetedBatches;
+    const auto targetStatus = _targetBatch(targeter, false, &shardId, &targetedBatches);
+    invariant(targetStatus.isOK());
+    invariant(targetedBatches.size() <= 1u);
+
+    return targetedBatches.empty() ? nullptr : targetedBatches.begin()->second;
+}
+
+Status BatchWriteOp::_targetBatch(const NSTargeter& targeter,
+                                  bool recordTargetErrors,
+                                  const ShardId* onlyShard,
+                                  std::map<ShardId, TargetedWriteBatch*>* targetedBatches) {
     //
     // Targeting of unordered batches is fairly simple - each remaining write op is targeted,
     // and each of those targeted writes are grouped into a batch for a particular shard
@@ -298,6 +318,34 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    // Inserts are targeted a window of write ops at a time, so that the targeter can share work
+    // between their documents. The windows double in size as they are used up, so a batch which
+    // stops early targets at most twice as many inserts as it takes.
+    const bool isInsert = _clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert;
+    std::vector<boost::optional<StatusWith<ShardEndpoint>>> insertEndpoints;
+    size_t insertEndpointsBegin = 0;
+    size_t insertWindowSize = 1;
+    auto targetInsertWindow = [&](size_t begin) {
+        const size_t end = std::min(numWriteOps, begin + insertWindowSize);
+        std::vector<BSONObj> docs;
+        for (size_t j = begin; j < end; ++j) {
+            if (_writeOps[j].getWriteState() == WriteOpState_Ready) {
+                docs.push_back(_writeOps[j].getWriteItem().getDocument());
+            }
+        }
+        auto endpoints = targeter.targetInserts(_opCtx, docs);
+
+        insertEndpoints.assign(end - begin, boost::none);
+        auto endpoint = endpoints.begin();
+        for (size_t j = begin; j < end; ++j) {
+            if (_writeOps[j].getWriteState() == WriteOpState_Ready) {
+                insertEndpoints[j - begin] = std::move(*endpoint++);
+            }
+        }
+        insertEndpointsBegin = begin;
+        insertWindowSize *= 2;
+    };
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -313,7 +361,21 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         OwnedPointerVector<TargetedWrite> writesOwned;
         vector<TargetedWrite*>& writes = writesOwned.mutableVector();
 
-        Status targetStatus = writeOp.targetWrites(_opCtx, targeter, &writes);
+        Status targetStatus = Status::OK();
+        if (isInsert) {
+            if (i >= insertEndpointsBegin + insertEndpoints.size()) {
+                targetInsertWindow(i);
+            }
+            auto& swEndpoint = insertEndpoints[i - insertEndpointsBegin];
+            targetStatus = writeOp.targetInsert(std::move(*swEndpoint), &writes);
+        } else {
+            targetStatus = writeOp.targetWrites(_opCtx, targeter, &writes);
+        }
+
+        if (!targetStatus.isOK() && onlyShard) {
+            // Left for the next round, which records the error once the targeter is refreshed
+            continue;
+        }
 
         if (!targetStatus.isOK()) {
             WriteErrorDetail targetError;
@@ -343,6 +405,14 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
             }
         }
 
+        if (onlyShard &&
+            std::any_of(writes.begin(), writes.end(), [&](const TargetedWrite* write) {
+                return write->endpoint.shardName != *onlyShard;
+            })) {
+            writeOp.cancelWrites(nullptr);
+            continue;
+        }
+
         //
         // If ordered and we have a previous endpoint, make sure we don't need to send these
         // targeted writes to any other endpoints.
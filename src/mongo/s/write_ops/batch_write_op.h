@@ -141,6 +141,19 @@ public:
                        bool recordTargetErrors,
                        std::map<ShardId, TargetedWriteBatch*>* targetedBatches);
 
+    /**
+     * Targets the next write ops of an unordered batch op which go only to the shard 'shardId', so
+     * that they can be sent to it as soon as it has answered its previous batch instead of waiting
+     * for the other shards to answer theirs.
+     *
+     * Write ops which fail to target or which also go to other shards are left for the next call
+     * to targetBatch, so no targeting errors are ever recorded.
+     *
+     * Returns the TargetedWriteBatch, owned by the caller, or nullptr if no write op was targeted.
+     */
+    TargetedWriteBatch* targetUnorderedBatchForShard(const NSTargeter& targeter,
+                                                     const ShardId& shardId);
+
     /**
      * Fills a BatchCommandRequest from a TargetedWriteBatch for this BatchWriteOp.
      */
@@ -196,6 +209,15 @@ public:
     int numWriteOpsIn(WriteOpState state) const;
 
 private:
+    /**
+     * Implements targetBatch and targetUnorderedBatchForShard. If 'onlyShard' is set, skips the
+     * write ops which cannot be targeted or which do not go only to that shard.
+     */
+    Status _targetBatch(const NSTargeter& targeter,
+                        bool recordTargetErrors,
+                        const ShardId* onlyShard,
+                        std::map<ShardId, TargetedWriteBatch*>* targetedBatches);
+
     /**
      * Maintains the batch execution statistics when a response is received.
      */
@@ -313,6 +313,29 @@ bool wasMetadataRefreshed(const std::shared_ptr<ChunkManager>& managerA,
     return false;
 }
 
+/**
+ * Returns the shard key of 'doc', which is to be inserted in a collection sharded on
+ * 'shardKeyPattern'. Inserts must contain the exact shard key.
+ */
+StatusWith<BSONObj> extractInsertShardKey(const ShardKeyPattern& shardKeyPattern,
+                                          const BSONObj& doc) {
+    BSONObj shardKey = shardKeyPattern.extractShardKeyFromDoc(doc);
+
+    // Check shard key exists
+    if (shardKey.isEmpty()) {
+        return {ErrorCodes::ShardKeyNotFound,
+                str::stream() << "document " << doc << " does not contain shard key for pattern "
+                              << shardKeyPattern.toString()};
+    }
+
+    // Check shard key size on insert
+    Status status = ShardKeyPattern::checkShardKeySize(shardKey);
+    if (!status.isOK())
+        return status;
+
+    return shardKey;
+}
+
 }  // namespace
 
 ChunkManagerTargeter::ChunkManagerTargeter(const NamespaceString& nss)
@@ -342,45 +365,65 @@ const NamespaceString& ChunkManagerTargeter::getNS() const {
 
 StatusWith<ShardEndpoint> ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
                                                              const BSONObj& doc) const {
-    BSONObj shardKey;
+    if (!_routingInfo->cm()) {
+        return _targetUnshardedInsert();
+    }
 
-    if (_routingInfo->cm()) {
-        //
-        // Sharded collections have the following requirements for targeting:
-        //
-        // Inserts must contain the exact shard key.
-        //
+    auto swShardKey = extractInsertShardKey(_routingInfo->cm()->getShardKeyPattern(), doc);
+    if (!swShardKey.isOK()) {
+        return swShardKey.getStatus();
+    }
 
-        shardKey = _routingInfo->cm()->getShardKeyPattern().extractShardKeyFromDoc(doc);
+    // Target the shard key
+    return _targetShardKey(swShardKey.getValue(), CollationSpec::kSimpleSpec, doc.objsize());
+}
 
-        // Check shard key exists
-        if (shardKey.isEmpty()) {
-            return {ErrorCodes::ShardKeyNotFound,
-                    str::stream() << "document " << doc
-                                  << " does not contain shard key for pattern "
-                                  << _routingInfo->cm()->getShardKeyPattern().toString()};
+std::vector<StatusWith<ShardEndpoint>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    const auto cm = _routingInfo->cm();
+    if (!cm) {
+        return std::vector<StatusWith<ShardEndpoint>>(docs.size(), _targetUnshardedInsert());
+    }
+
+    std::vector<StatusWith<BSONObj>> swShardKeys;
+    swShardKeys.reserve(docs.size());
+    std::vector<BSONObj> shardKeys;
+    shardKeys.reserve(docs.size());
+    for (const auto& doc : docs) {
+        swShardKeys.push_back(extractInsertShardKey(cm->getShardKeyPattern(), doc));
+        if (swShardKeys.back().isOK()) {
+            shardKeys.push_back(swShardKeys.back().getValue());
         }
-
-        // Check shard key size on insert
-        Status status = ShardKeyPattern::checkShardKeySize(shardKey);
-        if (!status.isOK())
-            return status;
     }
 
-    // Target the shard key or database primary
-    if (!shardKey.isEmpty()) {
-        return _targetShardKey(shardKey, CollationSpec::kSimpleSpec, doc.objsize());
-    } else {
-        if (!_routingInfo->db().primary()) {
-            return Status(ErrorCodes::NamespaceNotFound,
-                          str::stream() << "could not target insert in collection " << getNS().ns()
-                                        << "; no metadata found");
+    std::vector<ShardId> shardIds;
+    try {
+        shardIds = cm->findShardIdsForShardKeys(shardKeys);
+    } catch (const DBException&) {
+        // Target the documents separately, to report the error for the document which caused it.
+        return NSTargeter::targetInserts(opCtx, docs);
+    }
+
+    std::vector<StatusWith<ShardEndpoint>> endpoints;
+    endpoints.reserve(docs.size());
+    auto shardId = shardIds.cbegin();
+    boost::optional<ShardEndpoint> lastEndpoint;
+    for (const auto& swShardKey : swShardKeys) {
+        if (!swShardKey.isOK()) {
+            endpoints.push_back(swShardKey.getStatus());
+            continue;
         }
 
-        return ShardEndpoint(_routingInfo->db().primary()->getId(), ChunkVersion::UNSHARDED());
+        // Successive documents usually go to the same shard, whose version need not be looked up
+        // again.
+        if (!lastEndpoint || lastEndpoint->shardName != *shardId) {
+            lastEndpoint.emplace(*shardId, cm->getVersion(*shardId));
+        }
+        endpoints.push_back(*lastEndpoint);
+        ++shardId;
     }
 
-    return Status::OK();
+    return endpoints;
 }
 
 StatusWith<std::vector<ShardEndpoint>> ChunkManagerTargeter::targetUpdate(
@@ -623,6 +666,16 @@ StatusWith<std::vector<ShardEndpoint>> ChunkManagerTargeter::_targetQuery(
     return endpoints;
 }
 
+StatusWith<ShardEndpoint> ChunkManagerTargeter::_targetUnshardedInsert() const {
+    if (!_routingInfo->db().primary()) {
+        return Status(ErrorCodes::NamespaceNotFound,
+                      str::stream() << "could not target insert in collection " << getNS().ns()
+                                    << "; no metadata found");
+    }
+
+    return ShardEndpoint(_routingInfo->db().primary()->getId(), ChunkVersion::UNSHARDED());
+}
+
 ShardEndpoint ChunkManagerTargeter::_targetShardKey(const BSONObj& shardKey,
                                                     const BSONObj& collation,
                                                     long long estDataSize) const {
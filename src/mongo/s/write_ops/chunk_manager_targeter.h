@@ -72,6 +72,11 @@ public:
     StatusWith<ShardEndpoint> targetInsert(OperationContext* opCtx,
                                            const BSONObj& doc) const override;
 
+    // Extracts the shard keys of all the documents before looking them up in the routing table in
+    // key order.
+    std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const override;
+
     // Returns ShardKeyNotFound if the update can't be targeted without a shard key.
     StatusWith<std::vector<ShardEndpoint>> targetUpdate(
         OperationContext* opCtx, const write_ops::UpdateOpEntry& updateDoc) const override;
@@ -155,6 +160,12 @@ private:
                                   const BSONObj& collation,
                                   long long estDataSize) const;
 
+    /**
+     * Returns the ShardEndpoint of the database primary, which inserts into an unsharded collection
+     * target.
+     */
+    StatusWith<ShardEndpoint> _targetUnshardedInsert() const;
+
     // Full namespace of the collection for this targeter
     const NamespaceString _nss;
 
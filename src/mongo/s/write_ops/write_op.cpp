@@ -78,6 +78,21 @@ Status WriteOp::targetWrites(OperationContext* opCtx,
         swEndpoints = targeter.targetAllShards(opCtx);
     }
 
+    return _addTargetedWrites(std::move(swEndpoints), targetedWrites);
+}
+
+Status WriteOp::targetInsert(StatusWith<ShardEndpoint> swEndpoint,
+                             std::vector<TargetedWrite*>* targetedWrites) {
+    invariant(_itemRef.getOpType() == BatchedCommandRequest::BatchType_Insert);
+    if (!swEndpoint.isOK())
+        return swEndpoint.getStatus();
+
+    return _addTargetedWrites(std::vector<ShardEndpoint>{std::move(swEndpoint.getValue())},
+                              targetedWrites);
+}
+
+Status WriteOp::_addTargetedWrites(StatusWith<std::vector<ShardEndpoint>> swEndpoints,
+                                   std::vector<TargetedWrite*>* targetedWrites) {
     // If we had an error, stop here
     if (!swEndpoints.isOK())
         return swEndpoints.getStatus();
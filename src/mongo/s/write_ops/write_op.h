@@ -121,6 +121,13 @@ public:
                         const NSTargeter& targeter,
                         std::vector<TargetedWrite*>* targetedWrites);
 
+    /**
+     * Same as targetWrites, for an insert whose ShardEndpoint the targeter already returned in
+     * 'swEndpoint', as targetInserts does for a whole batch.
+     */
+    Status targetInsert(StatusWith<ShardEndpoint> swEndpoint,
+                        std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Returns the number of child writes that were last targeted.
      */
@@ -159,6 +166,12 @@ public:
     void setOpError(const WriteErrorDetail& error);
 
 private:
+    /**
+     * Creates a TargetedWrite for each of the endpoints the write item was targeted to.
+     */
+    Status _addTargetedWrites(StatusWith<std::vector<ShardEndpoint>> swEndpoints,
+                              std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Updates the op state after new information is received.
      */
@@ -267,7 +267,11 @@ void Scope::loadStored(OperationContext* opCtx, bool ignoreNotConnected) {
     }
 }
 
-ScriptingFunction Scope::createFunction(const char* code) {
+namespace {
+/**
+ * Skips a leading block comment, which is not part of the function cache key.
+ */
+const char* skipLeadingComment(const char* code) {
     if (code[0] == '/' && code[1] == '*') {
         code += 2;
         while (code[0] && code[1]) {
@@ -278,6 +282,12 @@ ScriptingFunction Scope::createFunction(const char* code) {
             code++;
         }
     }
+    return code;
+}
+}  // namespace
+
+ScriptingFunction Scope::createFunction(const char* code) {
+    code = skipLeadingComment(code);
 
     FunctionCacheMap::iterator i = _cachedFunctions.find(code);
     if (i != _cachedFunctions.end())
@@ -289,6 +299,10 @@ ScriptingFunction Scope::createFunction(const char* code) {
     return functionNumber;
 }
 
+bool Scope::hasCachedFunction(const char* code) const {
+    return _cachedFunctions.count(skipLeadingComment(code)) > 0;
+}
+
 namespace JSFiles {
 extern const JSFile collection;
 extern const JSFile crud_api;
@@ -324,6 +338,24 @@ void Scope::execCoreFiles() {
 }
 
 namespace {
+// Note: if these numbers change, reconsider choice of datastructure for ScopeCache::_pools
+const unsigned kMaxPoolSize = 10;
+const int kMaxScopeReuse = 10;
+
+/**
+ * Returns true if a scope released by an operation may be handed out again.
+ */
+bool canReuseScope(const std::shared_ptr<Scope>& scope) {
+    if (scope->getTimesUsed() > kMaxScopeReuse)
+        return false;  // used too many times to save
+
+    if (!scope->getError().empty())
+        return false;  // not saving errored scopes
+
+    // An interrupted operation may have left its state behind in the scope.
+    return !scope->isKillPending();
+}
+
 class ScopeCache {
 public:
     void release(const string& poolName, const std::shared_ptr<Scope>& scope) {
@@ -336,11 +368,8 @@ public:
             return;
         }
 
-        if (scope->getTimesUsed() > kMaxScopeReuse)
-            return;  // used too many times to save
-
-        if (!scope->getError().empty())
-            return;  // not saving errored scopes
+        if (!canReuseScope(scope))
+            return;
 
         if (_pools.size() >= kMaxPoolSize) {
             // prefer to keep recently-used scopes
@@ -352,21 +381,36 @@ public:
         _pools.push_front(toStore);
     }
 
-    std::shared_ptr<Scope> tryAcquire(OperationContext* opCtx, const string& poolName) {
+    std::shared_ptr<Scope> tryAcquire(OperationContext* opCtx,
+                                      const string& poolName,
+                                      const string& functionCode) {
         stdx::lock_guard<stdx::mutex> lk(_mutex);
 
+        // Prefer the most recently used scope that already compiled the function, and otherwise
+        // fall back to the most recently used scope of the pool.
+        Pools::iterator found = _pools.end();
         for (Pools::iterator it = _pools.begin(); it != _pools.end(); ++it) {
-            if (it->poolName == poolName) {
-                std::shared_ptr<Scope> scope = it->scope;
-                _pools.erase(it);
-                scope->incTimesUsed();
-                scope->reset();
-                scope->registerOperation(opCtx);
-                return scope;
+            if (it->poolName != poolName)
+                continue;
+            if (found == _pools.end())
+                found = it;
+            if (functionCode.empty())
+                break;
+            if (it->scope->hasCachedFunction(functionCode.c_str())) {
+                found = it;
+                break;
             }
         }
 
-        return std::shared_ptr<Scope>();
+        if (found == _pools.end())
+            return std::shared_ptr<Scope>();
+
+        std::shared_ptr<Scope> scope = found->scope;
+        _pools.erase(found);
+        scope->incTimesUsed();
+        scope->reset();
+        scope->registerOperation(opCtx);
+        return scope;
     }
 
     void clear() {
@@ -381,29 +425,69 @@ private:
         string poolName;
     };
 
-    // Note: if these numbers change, reconsider choice of datastructure for _pools
-    static const unsigned kMaxPoolSize = 10;
-    static const int kMaxScopeReuse = 10;
-
     typedef std::deque<ScopeAndPool> Pools;  // More-recently used Scopes are kept at the front.
     Pools _pools;                            // protected by _mutex
     stdx::mutex _mutex;
 };
 
 ScopeCache scopeCache;
+
+/**
+ * The scope bound to the current thread that the last operation on this thread released, if any.
+ * It is only touched by its own thread, so there is nothing to lock.
+ */
+class ThreadScopeCache {
+public:
+    void release(const string& poolName, const std::shared_ptr<Scope>& scope) {
+        if (scope->hasOutOfMemoryException() || !canReuseScope(scope))
+            return;
+
+        scope->reset();
+        _scope = scope;
+        _poolName = poolName;
+    }
+
+    std::shared_ptr<Scope> tryAcquire(OperationContext* opCtx, const string& poolName) {
+        std::shared_ptr<Scope> scope = std::move(_scope);
+        if (!scope || _poolName != poolName) {
+            // The scope has to be destroyed before a new one can be created for this thread.
+            return std::shared_ptr<Scope>();
+        }
+
+        scope->incTimesUsed();
+        scope->reset();
+        scope->registerOperation(opCtx);
+        return scope;
+    }
+
+    void clear() {
+        _scope.reset();
+    }
+
+private:
+    std::shared_ptr<Scope> _scope;
+    string _poolName;
+};
+
+thread_local ThreadScopeCache threadScopeCache;
 }  // anonymous namespace
 
 void ScriptEngine::dropScopeCache() {
     scopeCache.clear();
+    threadScopeCache.clear();
 }
 
 class PooledScope : public Scope {
 public:
-    PooledScope(const std::string& pool, const std::shared_ptr<Scope>& real)
-        : _pool(pool), _real(real) {}
+    PooledScope(const std::string& pool, const std::shared_ptr<Scope>& real, bool currentThread)
+        : _pool(pool), _real(real), _currentThread(currentThread) {}
 
     virtual ~PooledScope() {
-        scopeCache.release(_pool, _real);
+        if (_currentThread) {
+            threadScopeCache.release(_pool, _real);
+        } else {
+            scopeCache.release(_pool, _real);
+        }
     }
 
     // wrappers for the derived (_real) scope
@@ -536,21 +620,40 @@ protected:
 private:
     string _pool;
     std::shared_ptr<Scope> _real;
+    bool _currentThread;
 };
 
 /** Get a scope from the pool of scopes matching the supplied pool name */
 unique_ptr<Scope> ScriptEngine::getPooledScope(OperationContext* opCtx,
                                                const string& db,
-                                               const string& scopeType) {
+                                               const string& scopeType,
+                                               const string& functionCode) {
     const string fullPoolName = db + scopeType;
-    std::shared_ptr<Scope> s = scopeCache.tryAcquire(opCtx, fullPoolName);
+    std::shared_ptr<Scope> s = scopeCache.tryAcquire(opCtx, fullPoolName, functionCode);
     if (!s) {
         s.reset(newScope());
         s->registerOperation(opCtx);
     }
 
     unique_ptr<Scope> p;
-    p.reset(new PooledScope(fullPoolName, s));
+    p.reset(new PooledScope(fullPoolName, s, false));
+    p->setLocalDB(db);
+    p->loadStored(opCtx, true);
+    return p;
+}
+
+unique_ptr<Scope> ScriptEngine::getPooledScopeForCurrentThread(OperationContext* opCtx,
+                                                               const string& db,
+                                                               const string& scopeType) {
+    const string fullPoolName = db + scopeType;
+    std::shared_ptr<Scope> s = threadScopeCache.tryAcquire(opCtx, fullPoolName);
+    if (!s) {
+        s.reset(newScopeForCurrentThread());
+        s->registerOperation(opCtx);
+    }
+
+    unique_ptr<Scope> p;
+    p.reset(new PooledScope(fullPoolName, s, true));
     p->setLocalDB(db);
     p->loadStored(opCtx, true);
     return p;
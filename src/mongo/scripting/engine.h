@@ -107,6 +107,11 @@ public:
 
     virtual ScriptingFunction createFunction(const char* code);
 
+    /**
+     * Returns true if createFunction() has already compiled 'code' in this scope.
+     */
+    bool hasCachedFunction(const char* code) const;
+
     /**
      * @return 0 on success
      */
@@ -257,11 +262,22 @@ public:
      * @param db The db name
      * @param scopeType A unique id to limit scope sharing.
      *                  This must include authenticated users.
+     * @param functionCode If not empty, a pooled scope that has already compiled this code is
+     *                     preferred over the other scopes of the pool.
      * @return the scope
      */
     std::unique_ptr<Scope> getPooledScope(OperationContext* opCtx,
                                           const std::string& db,
-                                          const std::string& scopeType);
+                                          const std::string& scopeType,
+                                          const std::string& functionCode = "");
+
+    /** Same as getPooledScope(), but the scope runs on the calling thread like the ones returned
+     * by newScopeForCurrentThread(). A thread can only host one such scope at a time, so each
+     * thread keeps at most one of them between operations.
+     */
+    std::unique_ptr<Scope> getPooledScopeForCurrentThread(OperationContext* opCtx,
+                                                          const std::string& db,
+                                                          const std::string& scopeType);
 
     void setScopeInitCallback(void (*func)(Scope&)) {
         _scopeInitCallback = func;
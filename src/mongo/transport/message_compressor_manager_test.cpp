@@ -30,6 +30,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/config.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/rpc/message.h"
 #include "mongo/stdx/memory.h"
@@ -38,6 +39,9 @@
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_snappy.h"
 #include "mongo/transport/message_compressor_zlib.h"
+#ifdef MONGO_CONFIG_HAVE_ZSTD
+#include "mongo/transport/message_compressor_zstd.h"
+#endif
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/log.h"
 
@@ -241,6 +245,24 @@ TEST(ZlibMessageCompressor, Overflow) {
     checkOverflow(stdx::make_unique<ZlibMessageCompressor>());
 }
 
+#ifdef MONGO_CONFIG_HAVE_ZSTD
+TEST(ZstdMessageCompressor, Fidelity) {
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage, stdx::make_unique<ZstdMessageCompressor>(3));
+}
+
+TEST(ZstdMessageCompressor, FidelityWithDictionary) {
+    auto testMessage = buildMessage();
+    const std::string dictionary(1024, 'a');
+    checkFidelity(testMessage,
+                  stdx::make_unique<ZstdMessageCompressor>(3, dictionary, 1024 * 1024));
+}
+
+TEST(ZstdMessageCompressor, Overflow) {
+    checkOverflow(stdx::make_unique<ZstdMessageCompressor>(3));
+}
+#endif
+
 TEST(MessageCompressorManager, SERVER_28008) {
 
     // Create a client and server that will negotiate the same compressors,
@@ -0,0 +1,219 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/message_compressor_zstd.h"
+
+#include <fstream>
+#include <sstream>
+#include <zstd.h>
+
+#include "mongo/base/init.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/transport/message_compressor_registry.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(zstdMessageCompressorLevel, int, ZSTD_CLEVEL_DEFAULT)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > ZSTD_maxCLevel()) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "zstdMessageCompressorLevel must be between 1 and "
+                                        << ZSTD_maxCLevel());
+        }
+        return Status::OK();
+    });
+
+// Path to a dictionary produced by 'zstd --train'. Empty means no dictionary.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(zstdMessageCompressorDictionaryFile, std::string, "");
+
+// Only messages up to this size are compressed with the dictionary; larger messages carry enough
+// redundancy of their own and are compressed without it.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(zstdMessageCompressorDictionaryMaxMessageBytes,
+                                      int,
+                                      16 * 1024)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "zstdMessageCompressorDictionaryMaxMessageBytes must not be negative");
+        }
+        return Status::OK();
+    });
+
+// Compression and decompression contexts are expensive to create, so each thread keeps one of
+// each for the lifetime of the thread.
+struct CCtxDeleter {
+    void operator()(ZSTD_CCtx* ctx) const {
+        ZSTD_freeCCtx(ctx);
+    }
+};
+
+struct DCtxDeleter {
+    void operator()(ZSTD_DCtx* ctx) const {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+
+ZSTD_CCtx* getThreadCCtx() {
+    static thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> ctx;
+    if (!ctx) {
+        ctx.reset(ZSTD_createCCtx());
+        invariant(ctx);
+    }
+    return ctx.get();
+}
+
+ZSTD_DCtx* getThreadDCtx() {
+    static thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> ctx;
+    if (!ctx) {
+        ctx.reset(ZSTD_createDCtx());
+        invariant(ctx);
+    }
+    return ctx.get();
+}
+
+}  // namespace
+
+void ZstdMessageCompressor::CDictDeleter::operator()(ZSTD_CDict* dict) const {
+    ZSTD_freeCDict(dict);
+}
+
+void ZstdMessageCompressor::DDictDeleter::operator()(ZSTD_DDict* dict) const {
+    ZSTD_freeDDict(dict);
+}
+
+ZstdMessageCompressor::ZstdMessageCompressor(int level,
+                                             const std::string& dictionary,
+                                             size_t maxDictionaryMessageBytes)
+    : MessageCompressorBase(MessageCompressor::kZstd),
+      _level(level),
+      _maxDictionaryMessageBytes(maxDictionaryMessageBytes) {
+    if (!dictionary.empty()) {
+        _cdict.reset(ZSTD_createCDict(dictionary.data(), dictionary.size(), _level));
+        _ddict.reset(ZSTD_createDDict(dictionary.data(), dictionary.size()));
+        invariant(_cdict && _ddict);
+    }
+}
+
+ZstdMessageCompressor::~ZstdMessageCompressor() = default;
+
+std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
+    return ZSTD_compressBound(inputSize);
+}
+
+StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
+                                                            DataRange output) {
+    auto cctx = getThreadCCtx();
+    auto out = const_cast<char*>(output.data());
+
+    size_t ret;
+    if (_cdict && input.length() <= _maxDictionaryMessageBytes) {
+        ret = ZSTD_compress_usingCDict(
+            cctx, out, output.length(), input.data(), input.length(), _cdict.get());
+    } else {
+        ret = ZSTD_compressCCtx(cctx, out, output.length(), input.data(), input.length(), _level);
+    }
+
+    if (ZSTD_isError(ret)) {
+        return Status{ErrorCodes::BadValue,
+                      str::stream() << "Could not compress input: " << ZSTD_getErrorName(ret)};
+    }
+    counterHitCompress(input.length(), ret);
+    return {ret};
+}
+
+StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
+                                                              DataRange output) {
+    auto dctx = getThreadDCtx();
+    auto out = const_cast<char*>(output.data());
+
+    // Frames compressed without a dictionary decode correctly with one, so the dictionary is only
+    // a problem when the frame names a different one.
+    const auto frameDictId = ZSTD_getDictID_fromFrame(input.data(), input.length());
+    if (frameDictId != 0 && (!_ddict || frameDictId != ZSTD_getDictID_fromDDict(_ddict.get()))) {
+        return Status{ErrorCodes::BadValue,
+                      str::stream() << "Compressed message uses unknown zstd dictionary "
+                                    << frameDictId};
+    }
+
+    size_t ret;
+    if (_ddict) {
+        ret = ZSTD_decompress_usingDDict(
+            dctx, out, output.length(), input.data(), input.length(), _ddict.get());
+    } else {
+        ret = ZSTD_decompressDCtx(dctx, out, output.length(), input.data(), input.length());
+    }
+
+    if (ZSTD_isError(ret) || ret != output.length()) {
+        return Status{ErrorCodes::BadValue, "Compressed message was invalid or corrupted"};
+    }
+
+    counterHitDecompress(input.length(), output.length());
+    return {output.length()};
+}
+
+
+MONGO_INITIALIZER_GENERAL(ZstdMessageCompressorInit,
+                          ("EndStartupOptionHandling"),
+                          ("AllCompressorsRegistered"))
+(InitializerContext* context) {
+    std::string dictionary;
+    if (!zstdMessageCompressorDictionaryFile.empty()) {
+        std::ifstream in(zstdMessageCompressorDictionaryFile, std::ios::binary);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        if (!in) {
+            return Status(ErrorCodes::FileOpenFailed,
+                          str::stream() << "Could not read zstd dictionary file "
+                                        << zstdMessageCompressorDictionaryFile);
+        }
+        dictionary = ss.str();
+
+        // Raw content dictionaries have no ID, so a mismatch between peers could not be detected.
+        if (ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size()) == 0) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << zstdMessageCompressorDictionaryFile
+                                        << " is not a trained zstd dictionary");
+        }
+    }
+
+    auto& compressorRegistry = MessageCompressorRegistry::get();
+    compressorRegistry.registerImplementation(stdx::make_unique<ZstdMessageCompressor>(
+        zstdMessageCompressorLevel,
+        dictionary,
+        static_cast<size_t>(zstdMessageCompressorDictionaryMaxMessageBytes)));
+    return Status::OK();
+}
+}  // namespace mongo
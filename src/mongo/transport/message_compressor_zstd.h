@@ -0,0 +1,74 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "mongo/transport/message_compressor_base.h"
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace mongo {
+class ZstdMessageCompressor final : public MessageCompressorBase {
+public:
+    /**
+     * Creates a compressor that uses the given compression level. If dictionary is non-empty it is
+     * used to compress messages of at most maxDictionaryMessageBytes bytes, and to decompress any
+     * message. Both ends of a connection must be configured with the same dictionary.
+     */
+    ZstdMessageCompressor(int level,
+                          const std::string& dictionary = "",
+                          size_t maxDictionaryMessageBytes = 0);
+
+    ~ZstdMessageCompressor();
+
+    std::size_t getMaxCompressedSize(size_t inputSize) override;
+
+    StatusWith<std::size_t> compressData(ConstDataRange input, DataRange output) override;
+
+    StatusWith<std::size_t> decompressData(ConstDataRange input, DataRange output) override;
+
+private:
+    struct CDictDeleter {
+        void operator()(ZSTD_CDict_s* dict) const;
+    };
+    struct DDictDeleter {
+        void operator()(ZSTD_DDict_s* dict) const;
+    };
+
+    const int _level;
+    const size_t _maxDictionaryMessageBytes;
+    std::unique_ptr<ZSTD_CDict_s, CDictDeleter> _cdict;
+    std::unique_ptr<ZSTD_DDict_s, DDictDeleter> _ddict;
+};
+
+
+}  // namespace mongo
@@ -33,7 +33,14 @@
 #include "mongo/transport/service_executor_adaptive.h"
 
 #include <array>
+#include <fstream>
 #include <random>
+#include <sstream>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #include "mongo/db/server_parameters.h"
 #include "mongo/transport/service_entry_point_utils.h"
@@ -42,6 +49,7 @@
 #include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/duration.h"
 #include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/stringutils.h"
@@ -79,6 +87,10 @@ MONGO_EXPORT_SERVER_PARAMETER(adaptiveServiceExecutorIdlePctThreshold, int, 60);
 // value.
 MONGO_EXPORT_SERVER_PARAMETER(adaptiveServiceExecutorRecursionLimit, int, 8);
 
+// On Linux hosts with more than one NUMA node, pin each worker thread to the CPUs of one node,
+// assigning threads to nodes round-robin.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(adaptiveServiceExecutorPinWorkersToNumaNodes, bool, false);
+
 constexpr auto kTotalQueued = "totalQueued"_sd;
 constexpr auto kTotalExecuted = "totalExecuted"_sd;
 constexpr auto kTotalTimeExecutingUs = "totalTimeExecutingMicros"_sd;
@@ -94,6 +106,88 @@ constexpr auto kStarvation = "starvation"_sd;
 constexpr auto kReserveMinimum = "belowReserveMinimum"_sd;
 constexpr auto kThreadReasons = "threadCreationCauses"_sd;
 
+#if defined(__linux__)
+/**
+ * Parses a sysfs CPU list such as "0-7,16-23" into 'cpus'. Returns false if it is malformed.
+ */
+bool parseCpuList(const std::string& cpuList, cpu_set_t* cpus) {
+    CPU_ZERO(cpus);
+    std::istringstream ranges(cpuList);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        int first, last;
+        const auto dash = range.find('-');
+        try {
+            first = std::stoi(range.substr(0, dash));
+            last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        } catch (const std::exception&) {
+            return false;
+        }
+        if (first < 0 || last < first || last >= CPU_SETSIZE) {
+            return false;
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            CPU_SET(cpu, cpus);
+        }
+    }
+    return CPU_COUNT(cpus) > 0;
+}
+
+/**
+ * Returns the CPUs of each NUMA node, read once from /sys/devices/system/node. Empty if there is
+ * only one node or the topology cannot be read, in which case threads are not pinned.
+ */
+const std::vector<cpu_set_t>& getNumaNodeCpuSets() {
+    static const std::vector<cpu_set_t> nodeCpuSets = [] {
+        std::vector<cpu_set_t> cpuSets;
+        for (int node = 0;; ++node) {
+            std::ifstream file(str::stream() << "/sys/devices/system/node/node" << node
+                                             << "/cpulist");
+            std::string cpuList;
+            if (!file || !std::getline(file, cpuList)) {
+                break;
+            }
+            cpu_set_t cpus;
+            if (!parseCpuList(cpuList, &cpus)) {
+                warning() << "Unable to parse CPU list of NUMA node " << node << ": " << cpuList;
+                return std::vector<cpu_set_t>();
+            }
+            cpuSets.push_back(cpus);
+        }
+        if (cpuSets.size() < 2) {
+            cpuSets.clear();
+        }
+        return cpuSets;
+    }();
+    return nodeCpuSets;
+}
+#endif
+
+/**
+ * Pins the calling worker thread to one NUMA node when
+ * adaptiveServiceExecutorPinWorkersToNumaNodes is set.
+ */
+void pinWorkerThreadToNumaNode(int threadId) {
+#if defined(__linux__)
+    if (!adaptiveServiceExecutorPinWorkersToNumaNodes) {
+        return;
+    }
+    const auto& nodeCpuSets = getNumaNodeCpuSets();
+    if (nodeCpuSets.empty()) {
+        return;
+    }
+    const auto node = threadId % nodeCpuSets.size();
+    const int ret =
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &nodeCpuSets[node]);
+    if (ret != 0) {
+        warning() << "Unable to pin worker thread " << threadId << " to NUMA node " << node
+                  << ": " << errnoWithDescription(ret);
+        return;
+    }
+    LOG(1) << "Pinned worker thread " << threadId << " to NUMA node " << node;
+#endif
+}
+
 int64_t ticksToMicros(TickSource::Tick ticks, TickSource* tickSource) {
     invariant(tickSource->getTicksPerSecond() >= 1000000);
     return tickSource->ticksTo<Microseconds>(ticks).count();
@@ -557,6 +651,7 @@ void ServiceExecutorAdaptive::_workerThreadRoutine(
         std::string threadName = str::stream() << "worker-" << threadId;
         setThreadName(threadName);
     }
+    pinWorkerThreadToNumaNode(threadId);
 
     log() << "Started new database worker thread " << threadId;
 
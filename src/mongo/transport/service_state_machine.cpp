@@ -35,6 +35,7 @@
 #include "mongo/config.h"
 #include "mongo/db/client.h"
 #include "mongo/db/dbmessage.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/rpc/message.h"
 #include "mongo/rpc/op_msg.h"
@@ -99,7 +100,8 @@ Message makeLegacyExhaustMessage(Message* m, const DbResponse& dbresponse) {
  * request message for it to be used as the subsequent, 'synthetic' exhaust request. Returns an
  * empty message if exhaust is not allowed.
  *
- * Currently only supports exhaust for 'getMore' commands.
+ * Supports exhaust for 'find' and 'getMore' commands. A 'find' request is turned into a 'getMore'
+ * on the cursor it established, so a client can stream an entire result set with one request.
  */
 Message makeExhaustMessage(Message requestMsg, DbResponse* dbresponse) {
     if (requestMsg.operation() == dbQuery) {
@@ -110,9 +112,10 @@ Message makeExhaustMessage(Message requestMsg, DbResponse* dbresponse) {
         return Message();
     }
 
-    // Only support exhaust for 'getMore' commands.
+    // Only support exhaust for 'find' and 'getMore' commands.
     auto request = OpMsgRequest::parse(requestMsg);
-    if (request.getCommandName() != "getMore"_sd) {
+    const auto commandName = request.getCommandName();
+    if (commandName != "getMore"_sd && commandName != "find"_sd) {
         return Message();
     }
 
@@ -134,10 +137,27 @@ Message makeExhaustMessage(Message requestMsg, DbResponse* dbresponse) {
     // should be terminated. Also make sure the cursor namespace is valid.
     auto cursorId = cursorObj.getField("id").numberLong();
     auto cursorNs = cursorObj.getField("ns").str();
-    if (cursorId == 0 || cursorNs.empty()) {
+    if (cursorId == 0 || cursorNs.empty() || cursorNs.find('.') == std::string::npos) {
         return Message();
     }
 
+    if (commandName == "find"_sd) {
+        // Synthesize the 'getMore' that continues the cursor. The batch size and the session
+        // fields of the 'find' carry over, since the cursor is bound to the find's session.
+        BSONObjBuilder getMoreBuilder;
+        getMoreBuilder.append("getMore", cursorId);
+        getMoreBuilder.append("collection", nsToCollectionSubstring(cursorNs));
+        for (auto&& fieldName : {"batchSize"_sd, "lsid"_sd, "txnNumber"_sd}) {
+            if (auto elem = request.body[fieldName]) {
+                getMoreBuilder.append(elem);
+            }
+        }
+        requestMsg =
+            OpMsgRequest::fromDBAndBody(nsToDatabaseSubstring(cursorNs), getMoreBuilder.obj())
+                .serialize();
+        OpMsg::setFlag(&requestMsg, OpMsg::kExhaustSupported);
+    }
+
     // Indicate that the response is part of an exhaust stream.
     OpMsg::setFlag(&dbresponse->response, OpMsg::kMoreToCome);
 
@@ -0,0 +1,250 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "mongo/base/data_view.h"
+#include "mongo/db/dbmessage.h"
+#include "mongo/db/server_options.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/stats/concurrent_latency_histogram.h"
+#include "mongo/rpc/op_msg.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/transport/service_entry_point_impl.h"
+#include "mongo/transport/service_executor_adaptive.h"
+#include "mongo/transport/service_executor_synchronous.h"
+#include "mongo/transport/transport_layer_asio.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/net/sock.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * A load generator for the ingress network path: a TransportLayerASIO listening on loopback
+ * hands each connection to a ServiceStateMachine, which runs on either the synchronous
+ * (thread-per-connection) or the adaptive service executor and answers every request with an
+ * echo of its payload.
+ *
+ * Each benchmark thread is one client connection in a closed loop: it sends a request, waits for
+ * the reply and then sleeps for the think time. The arguments are the request payload size in
+ * bytes and the think time in microseconds; the number of threads is the number of connections.
+ * Besides requests per second, the benchmarks report latency percentiles in microseconds and the
+ * context switches of the whole process per request.
+ */
+enum class ExecutorKind { kSynchronous, kAdaptive };
+
+class EchoServiceEntryPoint final : public ServiceEntryPointImpl {
+public:
+    explicit EchoServiceEntryPoint(ServiceContext* svcCtx) : ServiceEntryPointImpl(svcCtx) {}
+
+    DbResponse handleRequest(OperationContext* opCtx, const Message& request) final {
+        auto opMsg = OpMsgRequest::parse(request);
+        OpMsgBuilder reply;
+        reply.setBody(BSON("ok" << 1 << "payload" << opMsg.body["payload"]));
+        return DbResponse{reply.finish()};
+    }
+};
+
+/**
+ * A server with its own ServiceContext, so that each run gets a fresh service executor.
+ */
+class EchoServer {
+public:
+    explicit EchoServer(ExecutorKind kind) : _serviceContext(ServiceContext::make()) {
+        auto svcCtx = _serviceContext.get();
+        svcCtx->setServiceEntryPoint(stdx::make_unique<EchoServiceEntryPoint>(svcCtx));
+
+        ServerGlobalParams params;
+        params.noUnixSocket = true;
+        transport::TransportLayerASIO::Options opts(&params);
+        opts.port = 0;
+        opts.transportMode = kind == ExecutorKind::kAdaptive ? transport::Mode::kAsynchronous
+                                                             : transport::Mode::kSynchronous;
+        auto tl = stdx::make_unique<transport::TransportLayerASIO>(
+            opts, svcCtx->getServiceEntryPoint());
+
+        if (kind == ExecutorKind::kAdaptive) {
+            svcCtx->setServiceExecutor(stdx::make_unique<transport::ServiceExecutorAdaptive>(
+                svcCtx, tl->getReactor(transport::TransportLayer::kIngress)));
+        } else {
+            svcCtx->setServiceExecutor(
+                stdx::make_unique<transport::ServiceExecutorSynchronous>(svcCtx));
+        }
+        uassertStatusOK(svcCtx->getServiceExecutor()->start());
+
+        uassertStatusOK(tl->setup());
+        uassertStatusOK(tl->start());
+        _port = tl->listenerPort();
+        svcCtx->setTransportLayer(std::move(tl));
+    }
+
+    ~EchoServer() {
+        auto svcCtx = _serviceContext.get();
+        svcCtx->getTransportLayer()->shutdown();
+        svcCtx->getServiceEntryPoint()->endAllSessions(transport::Session::kEmptyTagMask);
+        svcCtx->getServiceEntryPoint()->shutdown(Seconds(10));
+        svcCtx->getServiceExecutor()->shutdown(Seconds(10)).ignore();
+    }
+
+    int port() const {
+        return _port;
+    }
+
+private:
+    ServiceContext::UniqueServiceContext _serviceContext;
+    int _port = 0;
+};
+
+/**
+ * A blocking client connection which sends echo requests and reads their replies.
+ */
+class EchoClient {
+public:
+    EchoClient(int port, int payloadBytes)
+        : _request(OpMsgRequest::fromDBAndBody(
+                       "admin", BSON("echo" << 1 << "payload" << std::string(payloadBytes, 'x')))
+                       .serialize()) {
+        SockAddr addr("localhost", port, AF_INET);
+        uassert(ErrorCodes::HostUnreachable,
+                "unable to connect to the benchmark server",
+                _socket.connect(addr));
+    }
+
+    void roundTrip() {
+        _request.header().setId(nextMessageId());
+        _socket.send(_request.buf(), _request.size(), "echo request");
+
+        char lengthBytes[sizeof(int32_t)];
+        _socket.recv(lengthBytes, sizeof(lengthBytes));
+        const auto length = ConstDataView(lengthBytes).read<LittleEndian<int32_t>>();
+        _reply.resize(length - sizeof(lengthBytes));
+        _socket.recv(_reply.data(), _reply.size());
+    }
+
+private:
+    Socket _socket;
+    Message _request;
+    std::vector<char> _reply;
+};
+
+long long contextSwitches() {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_nvcsw + usage.ru_nivcsw;
+    }
+#endif
+    return 0;
+}
+
+// Set up and torn down by thread 0. Benchmark threads synchronize at the start and the end of the
+// measurement loop, so the other threads only use these inside it.
+std::unique_ptr<EchoServer> server;
+std::unique_ptr<ConcurrentLatencyHistogram> latencies;
+long long contextSwitchesAtStart = 0;
+
+void runLoad(benchmark::State& state, ExecutorKind kind) {
+    const int payloadBytes = state.range(0);
+    const long long thinkMicros = state.range(1);
+
+    if (state.thread_index == 0) {
+        server = stdx::make_unique<EchoServer>(kind);
+        latencies = stdx::make_unique<ConcurrentLatencyHistogram>();
+        contextSwitchesAtStart = contextSwitches();
+    }
+
+    std::unique_ptr<EchoClient> client;
+    for (auto _ : state) {
+        if (!client) {
+            state.PauseTiming();
+            client = stdx::make_unique<EchoClient>(server->port(), payloadBytes);
+            state.ResumeTiming();
+        }
+
+        Timer timer;
+        client->roundTrip();
+        latencies->record(timer.micros());
+
+        if (thinkMicros > 0) {
+            sleepmicros(thinkMicros);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index == 0) {
+        const auto snapshot = latencies->snapshot();
+        state.counters["p50_us"] = snapshot.percentile(0.5);
+        state.counters["p95_us"] = snapshot.percentile(0.95);
+        state.counters["p99_us"] = snapshot.percentile(0.99);
+        state.counters["p999_us"] = snapshot.percentile(0.999);
+        if (snapshot.count() > 0) {
+            state.counters["ctxSwitchesPerRequest"] =
+                static_cast<double>(contextSwitches() - contextSwitchesAtStart) / snapshot.count();
+        }
+    }
+
+    // Every connection is closed before the server shuts down.
+    client.reset();
+    if (state.thread_index == 0) {
+        server.reset();
+        latencies.reset();
+    }
+}
+
+void BM_SynchronousExecutor(benchmark::State& state) {
+    runLoad(state, ExecutorKind::kSynchronous);
+}
+
+void BM_AdaptiveExecutor(benchmark::State& state) {
+    runLoad(state, ExecutorKind::kAdaptive);
+}
+
+void loadArgs(benchmark::internal::Benchmark* b) {
+    for (int payloadBytes : {64, 16 * 1024}) {
+        for (int thinkMicros : {0, 1000}) {
+            b->Args({payloadBytes, thinkMicros});
+        }
+    }
+    b->ThreadRange(1, 256)->UseRealTime();
+}
+
+BENCHMARK(BM_SynchronousExecutor)->Apply(loadArgs);
+BENCHMARK(BM_AdaptiveExecutor)->Apply(loadArgs);
+
+}  // namespace
+}  // namespace mongo
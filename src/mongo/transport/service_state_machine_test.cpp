@@ -73,6 +73,7 @@ public:
     DbResponse handleRequest(OperationContext* opCtx, const Message& request) override {
         log() << "In handleRequest";
         _ranHandler = true;
+        _lastRequest = request;
         ASSERT_TRUE(haveClient());
 
         // Build out a dummy OK response, if no custom response message was set. Otherwise, use the
@@ -120,10 +121,17 @@ public:
         return ret;
     }
 
+    const Message& getLastRequest() const {
+        return _lastRequest;
+    }
+
 private:
     bool _uassertInHandler = false;
     bool _ranHandler = false;
 
+    // The last request passed to 'handleRequest'.
+    Message _lastRequest;
+
     // A custom response message to return from 'handleRequest'.
     Message _responseMessage;
 };
@@ -476,6 +484,59 @@ TEST_F(ServiceStateMachineFixture, TestGetMoreWithExhaust) {
     ASSERT_EQ(firstResponseId, msg.header().getResponseToMsgId());
 }
 
+TEST_F(ServiceStateMachineFixture, TestFindWithExhaust) {
+    // Construct a 'find' OP_MSG request with the exhaust flag set.
+    const int32_t initRequestId = 1;
+    const long long cursorId = 42;
+    const std::string nss = "test.coll";
+    Message findWithExhaust = buildOpMsg(BSON("find"
+                                              << "coll"
+                                              << "batchSize"
+                                              << 2
+                                              << "$db"
+                                              << "test"));
+    findWithExhaust.header().setId(initRequestId);
+    OpMsg::setFlag(&findWithExhaust, OpMsg::kExhaustSupported);
+
+    // Construct a 'find' response that leaves the cursor open.
+    BSONObj findResBody =
+        BSON("ok" << 1 << "cursor"
+                  << BSON("id" << cursorId << "ns" << nss << "firstBatch" << BSONArray()));
+    Message findRes = buildOpMsg(findResBody);
+
+    // The 'find' response should start an exhaust stream.
+    runSourceAndSinkTest(_tl, _sep, findWithExhaust, findRes, State::Process, State::Process);
+
+    auto msg = _tl->getLastSunk();
+    ASSERT(!msg.empty());
+    ASSERT_EQ(initRequestId, msg.header().getResponseToMsgId());
+    ASSERT(OpMsg::isFlagSet(msg, OpMsg::kMoreToCome));
+    ASSERT_BSONOBJ_EQ(findResBody, OpMsg::parse(msg).body);
+
+    // End the stream with a terminal 'getMore' response.
+    BSONObj getMoreTerminalResBody =
+        BSON("ok" << 1 << "cursor" << BSON("id" << 0 << "ns" << nss << "nextBatch" << BSONArray()));
+    _sep->setResponseMessage(buildOpMsg(getMoreTerminalResBody));
+
+    log() << "runNext to process the synthesized getMore";
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::Source);
+
+    // The request processed by the database should have been a 'getMore' on the find's cursor.
+    const auto& getMoreMsg = _sep->getLastRequest();
+    ASSERT(OpMsg::isFlagSet(getMoreMsg, OpMsg::kExhaustSupported));
+    auto getMore = OpMsgRequest::parse(getMoreMsg);
+    ASSERT_EQ(getMore.getCommandName(), "getMore"_sd);
+    ASSERT_EQ(getMore.getDatabase(), "test"_sd);
+    ASSERT_EQ(getMore.body["getMore"].numberLong(), cursorId);
+    ASSERT_EQ(getMore.body["collection"].str(), "coll");
+    ASSERT_EQ(getMore.body["batchSize"].numberInt(), 2);
+
+    msg = _tl->getLastSunk();
+    ASSERT(!OpMsg::isFlagSet(msg, OpMsg::kMoreToCome));
+    ASSERT_BSONOBJ_EQ(getMoreTerminalResBody, OpMsg::parse(msg).body);
+}
+
 TEST_F(ServiceStateMachineFixture, TestGetMoreWithExhaustAndEmptyResponseNamespace) {
     // Construct a 'getMore' OP_MSG request with the exhaust flag set.
     const int32_t initRequestId = 1;
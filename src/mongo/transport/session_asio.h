@@ -53,6 +53,8 @@ namespace transport {
 
 MONGO_FAIL_POINT_DEFINE(transportLayerASIOshortOpportunisticReadWrite);
 
+extern int transportLayerASIOReadAheadBytes;
+
 template <typename SuccessValue>
 auto futurize(const std::error_code& ec, SuccessValue&& successValue) {
     using Result = Future<std::decay_t<SuccessValue>>;
@@ -91,6 +93,11 @@ public:
 
         _local = endpointToHostAndPort(_socket.local_endpoint());
         _remote = endpointToHostAndPort(_socket.remote_endpoint());
+
+        if (transportLayerASIOReadAheadBytes > 0) {
+            _readAheadCapacity = static_cast<size_t>(transportLayerASIOReadAheadBytes);
+            _readAheadBuffer = std::make_unique<char[]>(_readAheadCapacity);
+        }
     } catch (const DBException&) {
         throw;
     } catch (const asio::system_error& error) {
@@ -219,8 +226,11 @@ protected:
                                                   "SSL requested but SSL support is disabled"));
         }
 
+        // Bytes already pulled into the read-ahead buffer would bypass the TLS stream.
+        invariant(_readAheadBegin == _readAheadEnd);
         _sslSocket.emplace(
             std::move(_socket), *_tl->_egressSSLContext, removeFQDNRoot(target.host()));
+        getSSLManager()->setupEgressSessionResumption(_sslSocket->native_handle(), target);
         lk.unlock();
 
         auto doHandshake = [&] {
@@ -408,9 +418,63 @@ private:
                 });
         }
 #endif
+        if (_readAheadBuffer) {
+            return bufferedRead(buffers, baton);
+        }
         return opportunisticRead(_socket, buffers, baton);
     }
 
+    /**
+     * Reads into buffer from the plaintext socket through the session's read-ahead buffer.
+     *
+     * Each refill of the read-ahead buffer is a single read_some that picks up whatever the kernel
+     * has queued, so the header and body of a small message (and often the next message too) are
+     * consumed with one syscall instead of two. Reads at least as large as the read-ahead buffer
+     * go directly into the destination.
+     */
+    Future<void> bufferedRead(asio::mutable_buffer buffer, const transport::BatonHandle& baton) {
+        const auto buffered = std::min(_readAheadEnd - _readAheadBegin, buffer.size());
+        if (buffered) {
+            memcpy(buffer.data(), _readAheadBuffer.get() + _readAheadBegin, buffered);
+            _readAheadBegin += buffered;
+            buffer += buffered;
+        }
+
+        if (buffer.size() == 0) {
+            return Future<void>::makeReady();
+        }
+
+        if (buffer.size() >= _readAheadCapacity) {
+            return opportunisticRead(_socket, buffer, baton);
+        }
+
+        _readAheadBegin = _readAheadEnd = 0;
+        const auto readAhead = asio::buffer(_readAheadBuffer.get(), _readAheadCapacity);
+
+        std::error_code ec;
+        auto size = _socket.read_some(readAhead, ec);
+        if (!ec) {
+            _readAheadEnd = size;
+            return bufferedRead(buffer, baton);
+        }
+
+        if (((ec == asio::error::would_block) || (ec == asio::error::try_again)) &&
+            (_blockingMode == Async)) {
+            if (baton) {
+                return baton->addSession(*this, Baton::Type::In)
+                    .then([this, buffer, baton] { return bufferedRead(buffer, baton); });
+            }
+
+            return _socket.async_read_some(readAhead, UseFuture{})
+                .then([this, buffer, baton](size_t size) {
+                    _readAheadEnd = size;
+                    return bufferedRead(buffer, baton);
+                });
+        }
+
+        return futurize(ec);
+    }
+
     template <typename ConstBufferSequence>
     Future<void> write(const ConstBufferSequence& buffers,
                        const transport::BatonHandle& baton = nullptr) {
@@ -709,6 +773,13 @@ private:
     bool _ranHandshake = false;
 #endif
 
+    // Optional read-ahead buffer for plaintext sockets, see bufferedRead(). Bytes in
+    // [_readAheadBegin, _readAheadEnd) have been received but not yet consumed.
+    std::unique_ptr<char[]> _readAheadBuffer;
+    size_t _readAheadCapacity = 0;
+    size_t _readAheadBegin = 0;
+    size_t _readAheadEnd = 0;
+
     TransportLayerASIO* const _tl;
     bool _isIngressSession;
 };
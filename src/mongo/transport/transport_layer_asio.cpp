@@ -40,6 +40,7 @@
 
 #include "mongo/base/system_error.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/transport/asio_utils.h"
 #include "mongo/transport/service_entry_point.h"
@@ -64,6 +65,17 @@ namespace transport {
 
 MONGO_FAIL_POINT_DEFINE(transportLayerASIOasyncConnectTimesOut);
 
+// Size of the per-session read-ahead buffer used for plaintext sockets. When zero (the default)
+// every message is read with separate header and body reads.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(transportLayerASIOReadAheadBytes, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 16 * 1024 * 1024) {
+            return Status(ErrorCodes::BadValue,
+                          "transportLayerASIOReadAheadBytes must be between 0 and 16MB");
+        }
+        return Status::OK();
+    });
+
 class ASIOReactorTimer final : public ReactorTimer {
 public:
     explicit ASIOReactorTimer(asio::io_context& ctx)
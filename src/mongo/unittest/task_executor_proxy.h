@@ -73,6 +73,7 @@ public:
     virtual void wait(const CallbackHandle& cbHandle,
                       Interruptible* interruptible = Interruptible::notInterruptible()) override;
     virtual void appendConnectionStats(executor::ConnectionPoolStats* stats) const override;
+    virtual void warmUpConnections(const HostAndPort& hostAndPort) override;
 
 private:
     // Not owned by us.
@@ -0,0 +1,126 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
+
+namespace mongo {
+namespace {
+
+// Number of tasks each benchmark iteration schedules, from outside the pool or from its tasks.
+const int kNumTasks = 10000;
+
+template <typename Pool>
+void scheduleFromOutside(benchmark::State& state, Pool& pool) {
+    pool.startup();
+    AtomicWord<int> counter{0};
+    for (auto _ : state) {
+        for (int i = 0; i < kNumTasks; ++i) {
+            invariant(pool.schedule([&] { counter.fetchAndAdd(1); }));
+        }
+        pool.waitForIdle();
+    }
+    pool.shutdown();
+    pool.join();
+    state.SetItemsProcessed(state.iterations() * kNumTasks);
+}
+
+template <typename Pool>
+void scheduleFromTasks(benchmark::State& state, Pool& pool) {
+    pool.startup();
+    for (auto _ : state) {
+        // Each of the threads starts a chain of tasks which schedule their successors, much like
+        // network callbacks which schedule the next step of an operation.
+        AtomicWord<int> remaining{kNumTasks};
+        stdx::function<void()> task = [&] {
+            if (remaining.subtractAndFetch(1) > 0) {
+                invariant(pool.schedule(task));
+            }
+        };
+        for (int i = 0; i < state.range(0); ++i) {
+            invariant(pool.schedule(task));
+        }
+        pool.waitForIdle();
+    }
+    pool.shutdown();
+    pool.join();
+    state.SetItemsProcessed(state.iterations() * kNumTasks);
+}
+
+ThreadPool::Options threadPoolOptions(const benchmark::State& state) {
+    ThreadPool::Options options;
+    options.minThreads = state.range(0);
+    options.maxThreads = state.range(0);
+    return options;
+}
+
+WorkStealingThreadPool::Options workStealingThreadPoolOptions(const benchmark::State& state) {
+    WorkStealingThreadPool::Options options;
+    options.numThreads = state.range(0);
+    return options;
+}
+
+void BM_threadPoolScheduleFromOutside(benchmark::State& state) {
+    ThreadPool pool(threadPoolOptions(state));
+    scheduleFromOutside(state, pool);
+}
+
+void BM_workStealingThreadPoolScheduleFromOutside(benchmark::State& state) {
+    WorkStealingThreadPool pool(workStealingThreadPoolOptions(state));
+    scheduleFromOutside(state, pool);
+}
+
+void BM_threadPoolScheduleFromTasks(benchmark::State& state) {
+    ThreadPool pool(threadPoolOptions(state));
+    scheduleFromTasks(state, pool);
+}
+
+void BM_workStealingThreadPoolScheduleFromTasks(benchmark::State& state) {
+    WorkStealingThreadPool pool(workStealingThreadPoolOptions(state));
+    scheduleFromTasks(state, pool);
+}
+
+BENCHMARK(BM_threadPoolScheduleFromOutside)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK(BM_workStealingThreadPoolScheduleFromOutside)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+BENCHMARK(BM_threadPoolScheduleFromTasks)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK(BM_workStealingThreadPoolScheduleFromTasks)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace mongo
@@ -38,6 +38,47 @@
 
 namespace mongo {
 
+class TicketHolder::QueuedWaiter {
+public:
+    explicit QueuedWaiter(TicketHolder* holder) : _holder(holder) {
+        _holder->_normalPriorityWaiters.addAndFetch(1);
+    }
+
+    ~QueuedWaiter() {
+        _holder->_normalPriorityWaiters.subtractAndFetch(1);
+    }
+
+private:
+    TicketHolder* const _holder;
+};
+
+bool TicketHolder::waitForLowPriorityTicketUntil(OperationContext* opCtx,
+                                                 Date_t until,
+                                                 Milliseconds maxDeferral) {
+    const Milliseconds pollInterval(5);
+    const Date_t deferUntil = std::min(until, Date_t::now() + maxDeferral);
+
+    Date_t now = Date_t::now();
+    while (now < deferUntil) {
+        if (_normalPriorityWaiters.load() == 0 && tryAcquire()) {
+            return true;
+        }
+
+        const Milliseconds sleepTime = std::min(pollInterval, deferUntil - now);
+        if (opCtx) {
+            opCtx->sleepFor(sleepTime);
+        } else {
+            sleepmillis(durationCount<Milliseconds>(sleepTime));
+        }
+        now = Date_t::now();
+    }
+    if (until == Date_t::max()) {
+        waitForTicket(opCtx);
+        return true;
+    }
+    return waitForTicketUntil(opCtx, until);
+}
+
 #if defined(__linux__)
 namespace {
 
@@ -91,6 +132,11 @@ void TicketHolder::waitForTicket(OperationContext* opCtx) {
 }
 
 bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+    if (tryAcquire()) {
+        return true;
+    }
+    QueuedWaiter queuedWaiter(this);
+
     const Milliseconds intervalMs(500);
     struct timespec ts;
 
@@ -179,6 +225,10 @@ bool TicketHolder::tryAcquire() {
 
 void TicketHolder::waitForTicket(OperationContext* opCtx) {
     stdx::unique_lock<stdx::mutex> lk(_mutex);
+    if (_tryAcquire()) {
+        return;
+    }
+    QueuedWaiter queuedWaiter(this);
 
     if (opCtx) {
         opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
@@ -189,6 +239,10 @@ void TicketHolder::waitForTicket(OperationContext* opCtx) {
 
 bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
     stdx::unique_lock<stdx::mutex> lk(_mutex);
+    if (_tryAcquire()) {
+        return true;
+    }
+    QueuedWaiter queuedWaiter(this);
 
     if (opCtx) {
         return opCtx->waitForConditionOrInterruptUntil(
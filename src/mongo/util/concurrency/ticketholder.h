@@ -69,6 +69,17 @@ public:
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
+
+    /**
+     * Like waitForTicketUntil(), but for low priority operations: while operations are queued in
+     * waitForTicket() or waitForTicketUntil(), only takes a ticket after none of them are left
+     * waiting, checking for one every few milliseconds. After deferring for 'maxDeferral', waits
+     * in the same queue as every other operation so that low priority operations are not starved.
+     */
+    bool waitForLowPriorityTicketUntil(OperationContext* opCtx,
+                                       Date_t until,
+                                       Milliseconds maxDeferral);
+
     void release();
 
     Status resize(int newSize);
@@ -80,6 +91,14 @@ public:
     int outof() const;
 
 private:
+    /**
+     * Marks the calling thread as queued for a ticket at normal priority while in scope.
+     */
+    class QueuedWaiter;
+
+    // Number of threads blocked in waitForTicket() or waitForTicketUntil().
+    AtomicInt32 _normalPriorityWaiters;
+
 #if defined(__linux__)
     mutable sem_t _sem;
 
@@ -71,4 +71,26 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+TEST(TicketholderTest, LowPriorityTakesAvailableTicketWhenNothingIsQueued) {
+    TicketHolder holder(1);
+    ASSERT(holder.waitForLowPriorityTicketUntil(nullptr, Date_t::now(), Milliseconds(1000)));
+    ASSERT_EQ(holder.used(), 1);
+    holder.release();
+
+    ASSERT(holder.waitForLowPriorityTicketUntil(nullptr, Date_t::max(), Milliseconds(1000)));
+    ASSERT_EQ(holder.used(), 1);
+    holder.release();
+}
+
+TEST(TicketholderTest, LowPriorityTimesOutWhileTicketsAreHeld) {
+    TicketHolder holder(1);
+    ScopedTicket ticket(&holder);
+
+    ASSERT_FALSE(holder.waitForLowPriorityTicketUntil(
+        nullptr, Date_t::now() + Milliseconds(10), Milliseconds(1000)));
+    ASSERT_FALSE(holder.waitForLowPriorityTicketUntil(
+        nullptr, Date_t::now() + Milliseconds(10), Milliseconds(0)));
+    ASSERT_EQ(holder.used(), 1);
+}
 }  // namespace
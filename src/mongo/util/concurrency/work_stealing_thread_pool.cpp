@@ -0,0 +1,302 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
+
+#include "mongo/base/status.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+namespace {
+
+// Counter used to assign unique names to otherwise-unnamed thread pools.
+AtomicInt32 nextUnnamedPoolId{1};
+
+// The pool whose task this thread is running, and the queue the thread prefers, so that tasks
+// scheduled by a task go to the queue of the thread which scheduled them.
+thread_local const WorkStealingThreadPool* currentPool = nullptr;
+thread_local size_t currentQueueIndex = 0;
+
+WorkStealingThreadPool::Options cleanUpOptions(WorkStealingThreadPool::Options&& options) {
+    if (options.poolName.empty()) {
+        options.poolName = str::stream() << "WorkStealingThreadPool"
+                                         << nextUnnamedPoolId.fetchAndAdd(1);
+    }
+    if (options.threadNamePrefix.empty()) {
+        options.threadNamePrefix = str::stream() << options.poolName << '-';
+    }
+    if (options.numThreads < 1) {
+        severe() << "Tried to create pool " << options.poolName << " with "
+                 << options.numThreads << " threads, but it must have at least 1";
+        fassertFailed(51539);
+    }
+    return options;
+}
+
+}  // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(Options options)
+    : _options(cleanUpOptions(std::move(options))) {
+    for (size_t i = 0; i < _options.numThreads; ++i) {
+        _queues.push_back(stdx::make_unique<TaskQueue>());
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    shutdown();
+    bool joinRequired;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        joinRequired = _state != shutdownComplete;
+    }
+    if (joinRequired) {
+        join();
+    }
+    invariant(_threads.empty());
+    invariant(_numPendingTasks.load() == 0);
+}
+
+void WorkStealingThreadPool::startup() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_state != preStart) {
+        severe() << "Attempting to start pool " << _options.poolName
+                 << ", but it has already started";
+        fassertFailed(51540);
+    }
+    _setState_inlock(running);
+    for (size_t i = 0; i < _queues.size(); ++i) {
+        const std::string threadName = str::stream() << _options.threadNamePrefix
+                                                     << _nextThreadId++;
+        _threads.emplace_back([this, i, threadName] {
+            setThreadName(threadName);
+            _options.onCreateThread(threadName);
+            LOG(1) << "starting thread in pool " << _options.poolName;
+            _consumeTasks(i);
+            LOG(1) << "shutting down thread in pool " << _options.poolName;
+        });
+    }
+}
+
+void WorkStealingThreadPool::shutdown() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    switch (_state) {
+        case preStart:
+        case running:
+            break;
+        case joinRequired:
+        case joining:
+        case shutdownComplete:
+            return;
+    }
+
+    // Once every queue is closed no task can be added, so a thread which then finds no tasks left
+    // may exit.
+    for (auto&& queue : _queues) {
+        stdx::lock_guard<stdx::mutex> queueLock(queue->mutex);
+        queue->closed = true;
+    }
+    {
+        stdx::lock_guard<stdx::mutex> idleLock(_idleMutex);
+        _stopping = true;
+        _workAvailable.notify_all();
+    }
+    _setState_inlock(joinRequired);
+}
+
+void WorkStealingThreadPool::join() {
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    _stateChange.wait(lk, [this] {
+        switch (_state) {
+            case preStart:
+            case running:
+                return false;
+            case joinRequired:
+                return true;
+            case joining:
+            case shutdownComplete:
+                severe() << "Attempted to join pool " << _options.poolName << " more than once";
+                fassertFailed(51541);
+        }
+        MONGO_UNREACHABLE;
+    });
+    _setState_inlock(joining);
+
+    std::vector<stdx::thread> threadsToJoin;
+    swap(threadsToJoin, _threads);
+    const std::string drainThreadName = str::stream() << _options.threadNamePrefix
+                                                      << _nextThreadId++;
+    lk.unlock();
+    if (threadsToJoin.empty()) {
+        _drainPendingTasks(drainThreadName);
+    }
+    for (auto&& thread : threadsToJoin) {
+        thread.join();
+    }
+    lk.lock();
+    _setState_inlock(shutdownComplete);
+}
+
+void WorkStealingThreadPool::_drainPendingTasks(const std::string& threadName) {
+    // Tasks cannot be run inline because they can create OperationContexts and the join() caller
+    // may already have one associated with the thread.
+    stdx::thread cleanThread([this, threadName] {
+        setThreadName(threadName);
+        _options.onCreateThread(threadName);
+        _consumeTasks(0);
+    });
+    cleanThread.join();
+}
+
+Status WorkStealingThreadPool::schedule(Task task) {
+    const size_t queueIndex = currentPool == this
+        ? currentQueueIndex
+        : _nextQueue.fetchAndAdd(1) % _queues.size();
+    auto& queue = *_queues[queueIndex];
+    {
+        stdx::lock_guard<stdx::mutex> queueLock(queue.mutex);
+        if (queue.closed) {
+            return Status(ErrorCodes::ShutdownInProgress,
+                          str::stream() << "Shutdown of thread pool " << _options.poolName
+                                        << " in progress");
+        }
+        queue.tasks.emplace_back(std::move(task));
+        _numPendingTasks.fetchAndAdd(1);
+    }
+
+    // A thread going idle counts itself before checking for pending tasks, so either it sees this
+    // task or this sees it and wakes it up.
+    if (_numIdleThreads.load() > 0) {
+        stdx::lock_guard<stdx::mutex> idleLock(_idleMutex);
+        _workAvailable.notify_one();
+    }
+    return Status::OK();
+}
+
+void WorkStealingThreadPool::waitForIdle() {
+    stdx::unique_lock<stdx::mutex> lk(_idleMutex);
+    _poolIsIdle.wait(
+        lk, [this] { return _numPendingTasks.load() == 0 && _numRunningTasks.load() == 0; });
+}
+
+WorkStealingThreadPool::Stats WorkStealingThreadPool::getStats() const {
+    Stats result;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        result.numThreads = _threads.size();
+    }
+    result.numIdleThreads = _numIdleThreads.load();
+    result.numPendingTasks = _numPendingTasks.load();
+    result.numStolenTasks = _numStolenTasks.load();
+    return result;
+}
+
+void WorkStealingThreadPool::_consumeTasks(size_t queueIndex) {
+    currentPool = this;
+    currentQueueIndex = queueIndex;
+
+    Task task;
+    while (true) {
+        if (_takeTask(queueIndex, &task)) {
+            _runTask(std::move(task));
+            continue;
+        }
+
+        stdx::unique_lock<stdx::mutex> lk(_idleMutex);
+        _numIdleThreads.fetchAndAdd(1);
+        if (_numPendingTasks.load() == 0 && !_stopping) {
+            MONGO_IDLE_THREAD_BLOCK;
+            _workAvailable.wait(lk, [this] { return _numPendingTasks.load() > 0 || _stopping; });
+        }
+        _numIdleThreads.subtractAndFetch(1);
+        if (_numPendingTasks.load() == 0 && _stopping) {
+            break;
+        }
+    }
+
+    currentPool = nullptr;
+}
+
+bool WorkStealingThreadPool::_takeTask(size_t queueIndex, Task* task) {
+    for (size_t i = 0; i < _queues.size(); ++i) {
+        auto& queue = *_queues[(queueIndex + i) % _queues.size()];
+        stdx::lock_guard<stdx::mutex> queueLock(queue.mutex);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+
+        *task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+
+        // Count the task as running before it stops being pending, so that waitForIdle() never
+        // sees neither.
+        _numRunningTasks.fetchAndAdd(1);
+        _numPendingTasks.subtractAndFetch(1);
+        if (i != 0) {
+            _numStolenTasks.fetchAndAdd(1);
+        }
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingThreadPool::_runTask(Task task) {
+    try {
+        LOG(3) << "Executing a task on behalf of pool " << _options.poolName;
+        task();
+    } catch (...) {
+        severe() << "Exception escaped task in thread pool " << _options.poolName << ": "
+                 << exceptionToStatus();
+        std::terminate();
+    }
+    task = nullptr;
+
+    if (_numRunningTasks.subtractAndFetch(1) == 0 && _numPendingTasks.load() == 0) {
+        stdx::lock_guard<stdx::mutex> idleLock(_idleMutex);
+        _poolIsIdle.notify_all();
+    }
+}
+
+void WorkStealingThreadPool::_setState_inlock(const LifecycleState newState) {
+    if (newState == _state) {
+        return;
+    }
+    _state = newState;
+    _stateChange.notify_all();
+}
+
+}  // namespace mongo
@@ -0,0 +1,214 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/functional.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/thread_pool_interface.h"
+
+namespace mongo {
+
+/**
+ * A thread pool with a fixed number of threads, each of which has its own queue of tasks.
+ *
+ * Tasks scheduled from outside the pool are spread round-robin across the queues, and tasks
+ * scheduled by a task running in the pool go to the queue of the thread running it. A thread takes
+ * tasks from its own queue first, and when that is empty steals the oldest task of another queue.
+ * Scheduling and running a task therefore only locks one queue in the common case, rather than a
+ * mutex shared by all of the threads as in ThreadPool.
+ *
+ * Tasks on different queues may run in any order. Callers which need tasks run in the order they
+ * were scheduled should use ThreadPool.
+ */
+class WorkStealingThreadPool final : public ThreadPoolInterface {
+    MONGO_DISALLOW_COPYING(WorkStealingThreadPool);
+
+public:
+    /**
+     * Structure used to configure an instance of WorkStealingThreadPool.
+     */
+    struct Options {
+        // Name of the thread pool. If this string is empty, the pool will be assigned a
+        // name unique to the current process.
+        std::string poolName;
+
+        // Prefix used to name threads for logging purposes. An integer will be appended to this
+        // string to create the thread name for each thread in the pool. If you leave this empty,
+        // the prefix will be the pool name followed by a hyphen.
+        std::string threadNamePrefix;
+
+        // Number of threads in the pool, each with its own queue of tasks.
+        size_t numThreads = 8;
+
+        // This function is run before each worker thread begins consuming tasks.
+        using OnCreateThreadFn = stdx::function<void(const std::string& threadName)>;
+        OnCreateThreadFn onCreateThread = [](const std::string&) {};
+    };
+
+    /**
+     * Structure used to return information about the thread pool via getStats().
+     */
+    struct Stats {
+        // The number of threads currently in the pool, idle or active.
+        size_t numThreads;
+
+        // The number of threads waiting for work.
+        size_t numIdleThreads;
+
+        // The number of tasks waiting to be executed by the pool.
+        size_t numPendingTasks;
+
+        // The number of tasks a thread took from the queue of another thread.
+        long long numStolenTasks;
+    };
+
+    explicit WorkStealingThreadPool(Options options);
+
+    ~WorkStealingThreadPool() override;
+
+    void startup() override;
+    void shutdown() override;
+    void join() override;
+    Status schedule(Task task) override;
+
+    /**
+     * Blocks the caller until there are no pending or running tasks on this pool. The same caveats
+     * as for ThreadPool::waitForIdle() apply.
+     */
+    void waitForIdle();
+
+    /**
+     * Returns statistics about the thread pool's utilization.
+     */
+    Stats getStats() const;
+
+private:
+    /**
+     * Representation of the stage of life of a thread pool, with the same transitions as in
+     * ThreadPool.
+     */
+    enum LifecycleState { preStart, running, joinRequired, joining, shutdownComplete };
+
+    /**
+     * The tasks waiting to be run by one thread of the pool.
+     */
+    struct TaskQueue {
+        stdx::mutex mutex;
+        std::deque<Task> tasks;
+
+        // Set by shutdown(), after which no more tasks may be added.
+        bool closed = false;
+    };
+
+    /**
+     * Runs tasks until the pool is shut down and no tasks remain. 'queueIndex' is the queue this
+     * thread prefers to take its tasks from.
+     */
+    void _consumeTasks(size_t queueIndex);
+
+    /**
+     * Removes and returns a task for the thread preferring 'queueIndex', taking one from another
+     * queue if that one is empty. Returns false if no queue has any tasks.
+     */
+    bool _takeTask(size_t queueIndex, Task* task);
+
+    /**
+     * Runs 'task', which has been taken from a queue, and wakes waitForIdle() callers if the pool
+     * became idle.
+     */
+    void _runTask(Task task);
+
+    /**
+     * Runs the remaining tasks on a new thread as part of the join process, blocking until
+     * complete. Used when the pool was shut down without having been started.
+     */
+    void _drainPendingTasks(const std::string& threadName);
+
+    /**
+     * Changes the lifecycle state (_state) of the pool and wakes up any threads waiting for a state
+     * change. Has no effect if _state == newState.
+     */
+    void _setState_inlock(LifecycleState newState);
+
+    // These are the options with which the pool was configured at construction time.
+    const Options _options;
+
+    // One queue per thread. The vector itself is never modified after construction.
+    std::vector<std::unique_ptr<TaskQueue>> _queues;
+
+    // Queue to which the next task scheduled from outside the pool is added.
+    AtomicWord<unsigned long long> _nextQueue{0};
+
+    // Number of tasks in all the queues, and number of tasks currently running.
+    AtomicWord<long long> _numPendingTasks{0};
+    AtomicWord<long long> _numRunningTasks{0};
+
+    // Number of threads waiting on _workAvailable. Only threads which see that there are idle
+    // threads need to lock _idleMutex to wake one of them.
+    AtomicWord<long long> _numIdleThreads{0};
+
+    AtomicWord<long long> _numStolenTasks{0};
+
+    // Guards _stopping, and is held when waiting on or signaling _workAvailable and _poolIsIdle.
+    mutable stdx::mutex _idleMutex;
+
+    // Condition signaled when a task is added, or when the pool is shutting down.
+    stdx::condition_variable _workAvailable;
+
+    // Condition signaled when there are no pending or running tasks.
+    stdx::condition_variable _poolIsIdle;
+
+    // Set once shutdown() has closed all the queues, so threads exit once no tasks remain.
+    bool _stopping = false;
+
+    // Mutex guarding _state, _threads and _nextThreadId.
+    mutable stdx::mutex _mutex;
+
+    LifecycleState _state = preStart;
+
+    // Condition variable signaled whenever _state changes.
+    stdx::condition_variable _stateChange;
+
+    // The worker threads, one per queue.
+    std::vector<stdx::thread> _threads;
+
+    // Id counter for assigning thread names.
+    size_t _nextThreadId = 0;
+};
+
+}  // namespace mongo
@@ -35,6 +35,8 @@
 #include "mongo/config.h"
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/heap_profiler_attribution.h"
 #include "mongo/util/log.h"
 #include "mongo/util/stacktrace.h"
 
@@ -68,13 +70,25 @@
 //   * a stack trace is obtained, and entered in a stack hash table if it's a new stack trace
 //   * the number of active bytes charged to that stack trace is increased
 //   * the allocated object, stack trace, and number of bytes is recorded in an object hash table
+//   * the number of active bytes charged to the current attribution site, if any, is increased
 // For each free call if the freed object is in the object hash table.
 //   * the number of active bytes charged to the allocating stack trace is decreased
+//   * the number of active bytes charged to the allocating attribution site is decreased
 //   * the object is removed from the object hash table
 //
+// An attribution site is a (command, namespace) pair, established by a HeapProfilerAttribution
+// scope while a command runs. Sites are interned when the scope is entered, outside the allocator
+// hooks, and are never freed; past kMaxSites further pairs are charged as unattributed.
+//
 // Enable at startup time (only) with
 //     mongod --setParameter heapProfilingEnabled=true
 //
+// Adding
+//     --setParameter heapProfilingLowOverhead=true
+// skips the backtrace, which is most of the cost of a sample, and the stack hash table, and
+// tracks only the attribution sites. Together with a larger heapProfilingSampleIntervalBytes this
+// is cheap enough to remain enabled in production.
+//
 // If enabled, adds a heapProfile section to serverStatus as follows:
 //
 // heapProfile: {
@@ -91,6 +105,13 @@
 //            ]
 //        }
 //    }
+//    attributions: {
+//        _command_: {             // one for each command with an attribution site
+//            _ns_: ...,           // number of active bytes allocated by _command_ on _ns_
+//        }
+//    }
+//
+// The stacks subsection is omitted in low overhead mode.
 //
 // Each new stack encountered is also logged to mongod log with a message like
 //     .... stack_n_: {0: "frame0", 1: "frame1", ...}
@@ -103,7 +124,8 @@
 // will present one graph per stack, identified by the label stack_n_,
 // showing active bytes that were allocated by that stack at each
 // point in time. The mappings from stack_n_ to the actual stack can
-// be found in mongod log.
+// be found in mongod log. The attributions are recorded as
+// {_command_: {_ns_: activeBytes}}, and need no such mapping.
 //
 // Via serverStatus - the serverStatus section described above
 // contains complete information, including the stack trace.  It can
@@ -117,13 +139,23 @@
 //     sampleIntervalBytes = 256 * 1024
 // the following information is computed and logged on startup (see HeapProfiler()):
 //     maxActiveMemory 262144 MB
-//     objTableSize 72 MB
+//     objTableSize 80 MB
 //     stackTableSize 16.6321MB
 // So the defaults allow handling very large memories at a reasonable sampling interval
 // and acceptable size overhead for the hash tables.
 //
 
 namespace mongo {
+
+// HeapProfilerAttribution Site, defined here as only the heap profiler looks inside it.
+struct HeapProfilerAttribution::Site {
+    Site(StringData command, StringData ns) : command(command.toString()), ns(ns.toString()) {}
+
+    const std::string command;
+    const std::string ns;
+    size_t activeBytes = 0;  // number of live allocated bytes charged to this site
+};
+
 namespace {
 
 //
@@ -289,6 +321,9 @@ private:
     // estimated currently active bytes - sum of activeBytes for all stacks
     size_t totalActiveBytes = 0;
 
+    // false in low overhead mode, where we neither take backtraces nor keep the stack hash table
+    const bool collectStacks = !lowOverheadParameter;
+
     //
     // Hash table of stacks
     //
@@ -329,7 +364,9 @@ private:
     };
 
     // The stack HashTable itself.
-    HashTable<Stack, StackInfo> stackHashTable{kMaxStackInfos, kStackHashTableLoadFactor};
+    // It is left empty in low overhead mode, and is never used then.
+    HashTable<Stack, StackInfo> stackHashTable{collectStacks ? kMaxStackInfos : 0,
+                                               kStackHashTableLoadFactor};
 
     // frames to skip at top and bottom of backtrace when reporting stacks
     int skipStartFrames = 0;
@@ -360,12 +397,15 @@ private:
         }
     };
 
+    using Site = HeapProfilerAttribution::Site;
+
     // Obj HashTable Value.
     struct ObjInfo {
         size_t accountedLen = 0;
-        StackInfo* stackInfo = nullptr;
-        ObjInfo(size_t accountedLen, StackInfo* stackInfo)
-            : accountedLen(accountedLen), stackInfo(stackInfo) {}
+        StackInfo* stackInfo = nullptr;  // nullptr in low overhead mode
+        Site* site = nullptr;            // nullptr if unattributed
+        ObjInfo(size_t accountedLen, StackInfo* stackInfo, Site* site)
+            : accountedLen(accountedLen), stackInfo(stackInfo), site(site) {}
         ObjInfo() {}
     };
 
@@ -373,6 +413,45 @@ private:
     HashTable<Obj, ObjInfo> objHashTable{kMaxObjInfos, kObjHashTableLoadFactor};
 
 
+    //
+    // Attribution sites, by command and namespace.
+    //
+
+    static const int kMaxSites = 1000;  // max number of (command, namespace) pairs we handle
+
+    // Guards the sites map. Never acquired by the allocator hooks, so it may be held while
+    // allocating; we acquire it before hashtable_mutex, never after.
+    stdx::mutex sites_mutex;
+    std::map<std::pair<std::string, std::string>, std::unique_ptr<Site>> sites;
+
+    // estimated currently active bytes not charged to any site
+    size_t unattributedActiveBytes = 0;
+
+    // The active bytes counter of site, or the unattributed bytes if site is nullptr.
+    size_t& siteActiveBytes(Site* site) {
+        return site ? site->activeBytes : unattributedActiveBytes;
+    }
+
+    Site* _lookupSite(StringData command, StringData ns) {
+        // A thread tends to run the same command on the same namespace repeatedly, so we remember
+        // the last site it looked up. Sites are immutable and never freed, so this needs no lock.
+        static thread_local Site* lastSite = nullptr;
+        if (lastSite && lastSite->command == command && lastSite->ns == ns)
+            return lastSite;
+
+        stdx::lock_guard<stdx::mutex> lk(sites_mutex);
+        auto key = std::make_pair(command.toString(), ns.toString());
+        auto it = sites.find(key);
+        if (it == sites.end()) {
+            if (sites.size() >= kMaxSites)
+                return nullptr;
+            it = sites.emplace(std::move(key), stdx::make_unique<Site>(command, ns)).first;
+        }
+        lastSite = it->second.get();
+        return lastSite;
+    }
+
+
     // If we encounter an error that doesn't allow us to proceed, for
     // example out of space for new hash table entries, we internally
     // disable profiling and then log an error message.
@@ -400,36 +479,44 @@ private:
         if (accountedLen == 0)
             return;
 
-        // Get backtrace.
+        // Get backtrace and compute its hash, unless in low overhead mode.
         Stack tempStack;
-        tempStack.numFrames = backtrace(tempStack.frames.data(), kMaxFramesPerStack);
+        Hash stackHash = 0;
+        if (collectStacks) {
+            tempStack.numFrames = backtrace(tempStack.frames.data(), kMaxFramesPerStack);
+            stackHash = tempStack.hash();
+        }
 
-        // Compute backtrace hash.
-        Hash stackHash = tempStack.hash();
+        // The site of the operation running on this thread, if any.
+        Site* site = HeapProfilerAttribution::current();
 
         // Now acquire lock.
         stdx::lock_guard<stdx::mutex> lk(hashtable_mutex);
 
-        // Look up stack in stackHashTable.
-        StackInfo* stackInfo = stackHashTable.find(stackHash, tempStack);
+        StackInfo* stackInfo = nullptr;
+        if (collectStacks) {
+            // Look up stack in stackHashTable.
+            stackInfo = stackHashTable.find(stackHash, tempStack);
 
-        // If new stack, store in stackHashTable.
-        if (!stackInfo) {
-            StackInfo newStackInfo(stackHashTable.size() /*stackNum*/);
-            stackInfo = stackHashTable.insert(stackHash, tempStack, newStackInfo);
+            // If new stack, store in stackHashTable.
             if (!stackInfo) {
-                disable("too many stacks; disabling heap profiling");
-                return;
+                StackInfo newStackInfo(stackHashTable.size() /*stackNum*/);
+                stackInfo = stackHashTable.insert(stackHash, tempStack, newStackInfo);
+                if (!stackInfo) {
+                    disable("too many stacks; disabling heap profiling");
+                    return;
+                }
             }
+            stackInfo->activeBytes += accountedLen;
         }
 
         // Count the bytes.
         totalActiveBytes += accountedLen;
-        stackInfo->activeBytes += accountedLen;
+        siteActiveBytes(site) += accountedLen;
 
         // Enter obj in objHashTable.
         Obj obj(objPtr);
-        ObjInfo objInfo(accountedLen, stackInfo);
+        ObjInfo objInfo(accountedLen, stackInfo, site);
         if (!objHashTable.insert(obj.hash(), obj, objInfo)) {
             disable("too many live objects; disabling heap profiling");
             return;
@@ -460,7 +547,9 @@ private:
         ObjInfo* objInfo = objHashTable.find(objHash, obj);
         if (objInfo) {
             totalActiveBytes -= objInfo->accountedLen;
-            objInfo->stackInfo->activeBytes -= objInfo->accountedLen;
+            if (objInfo->stackInfo)
+                objInfo->stackInfo->activeBytes -= objInfo->accountedLen;
+            siteActiveBytes(objInfo->site) -= objInfo->accountedLen;
             objHashTable.remove(objHash, obj);
         }
     }
@@ -529,6 +618,7 @@ private:
             const size_t stackTableSize = stackHashTable.memorySizeBytes();
             const double MB = 1024 * 1024;
             log() << "sampleIntervalBytes " << sampleIntervalBytesParameter << "; "
+                  << "lowOverhead " << lowOverheadParameter << "; "
                   << "maxActiveMemory " << maxActiveMemory / MB << " MB; "
                   << "objTableSize " << objTableSize / MB << " MB; "
                   << "stackTableSize " << stackTableSize / MB << " MB";
@@ -542,11 +632,34 @@ private:
         BSONObjBuilder statsBuilder(builder.subobjStart("stats"));
         statsBuilder.appendNumber("totalActiveBytes", totalActiveBytes);
         statsBuilder.appendNumber("bytesAllocated", bytesAllocated);
+        statsBuilder.appendNumber("unattributedActiveBytes", unattributedActiveBytes);
         statsBuilder.appendNumber("numStacks", stackHashTable.size());
+        {
+            stdx::lock_guard<stdx::mutex> lk(sites_mutex);
+            statsBuilder.appendNumber("numAttributions", sites.size());
+        }
         statsBuilder.appendNumber("currentObjEntries", objHashTable.size());
         statsBuilder.appendNumber("maxObjEntriesUsed", objHashTable.maxSizeSeen());
         statsBuilder.doneFast();
 
+        if (collectStacks)
+            _generateStacksSection(builder);
+
+        // Build the attributions subsection, with one subobject per command keyed by namespace.
+        // Sites are never removed and the map keeps them sorted, so the set and order of fields
+        // only grows, which is what ftdc compresses best.
+        stdx::lock_guard<stdx::mutex> lk(sites_mutex);
+        BSONObjBuilder attributionsBuilder(builder.subobjStart("attributions"));
+        for (auto it = sites.begin(); it != sites.end();) {
+            const std::string& command = it->first.first;
+            BSONObjBuilder commandBuilder(attributionsBuilder.subobjStart(command));
+            for (; it != sites.end() && it->first.first == command; ++it)
+                commandBuilder.appendNumber(it->first.second, it->second->activeBytes);
+        }
+        attributionsBuilder.doneFast();
+    }
+
+    void _generateStacksSection(BSONObjBuilder& builder) {
         // Guard against races updating the StackInfo bson representation.
         stdx::lock_guard<stdx::mutex> lk(stackinfo_mutex);
 
@@ -611,10 +724,15 @@ private:
         heapProfiler->_free(obj);
     }
 
+    static Site* lookupSite(StringData command, StringData ns) {
+        return heapProfiler->_lookupSite(command, ns);
+    }
+
 public:
     static HeapProfiler* heapProfiler;
     static bool enabledParameter;
     static long long sampleIntervalBytesParameter;
+    static bool lowOverheadParameter;
 
     HeapProfiler() {
         // Set sample interval from the parameter.
@@ -628,6 +746,7 @@ public:
         skipEndFrames = 0;
         MallocHook::AddNewHook(alloc);
         MallocHook::AddDeleteHook(free);
+        HeapProfilerAttribution::setSiteLookupFn(lookupSite);
     }
 
     static void generateServerStatusSection(BSONObjBuilder& builder) {
@@ -663,6 +782,7 @@ public:
 HeapProfiler* HeapProfiler::heapProfiler;
 bool HeapProfiler::enabledParameter = false;
 long long HeapProfiler::sampleIntervalBytesParameter = 256 * 1024;
+bool HeapProfiler::lowOverheadParameter = false;
 
 ExportedServerParameter<bool, ServerParameterType::kStartupOnly> heapProfilingEnabledParameter(
     ServerParameterSet::getGlobal(), "heapProfilingEnabled", &HeapProfiler::enabledParameter);
@@ -672,6 +792,11 @@ ExportedServerParameter<long long, ServerParameterType::kStartupOnly>
                                      "heapProfilingSampleIntervalBytes",
                                      &HeapProfiler::sampleIntervalBytesParameter);
 
+ExportedServerParameter<bool, ServerParameterType::kStartupOnly> heapProfilingLowOverheadParameter(
+    ServerParameterSet::getGlobal(),
+    "heapProfilingLowOverhead",
+    &HeapProfiler::lowOverheadParameter);
+
 MONGO_INITIALIZER_GENERAL(StartHeapProfiling, ("EndStartupOptionHandling"), ("default"))
 (InitializerContext* context) {
     if (HeapProfiler::enabledParameter)
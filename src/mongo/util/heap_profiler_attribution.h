@@ -0,0 +1,77 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+
+/**
+ * While in scope, charges the allocations that the sampling heap profiler samples on this thread
+ * to the given command and namespace, in addition to the allocating stack. The attributions are
+ * reported in the heapProfile serverStatus section, and thereby in FTDC.
+ *
+ * Does nothing unless the server was started with heapProfilingEnabled. Scopes may be nested, the
+ * innermost one wins.
+ */
+class HeapProfilerAttribution {
+    MONGO_DISALLOW_COPYING(HeapProfilerAttribution);
+
+public:
+    /**
+     * The record of one (command, namespace) pair, owned by the heap profiler and never freed.
+     */
+    struct Site;
+
+    /**
+     * Looks up or creates the Site for a pair. May allocate, and may return nullptr.
+     */
+    using SiteLookupFn = Site* (*)(StringData command, StringData ns);
+
+    HeapProfilerAttribution(StringData command, StringData ns);
+    ~HeapProfilerAttribution();
+
+    /**
+     * Returns the Site that allocations on this thread are currently charged to, or nullptr.
+     * Never allocates, so it may be called from allocator hooks.
+     */
+    static Site* current();
+
+    /**
+     * Installs the lookup function. Called once by the heap profiler on startup, before there are
+     * threads that may construct a HeapProfilerAttribution.
+     */
+    static void setSiteLookupFn(SiteLookupFn fn);
+
+private:
+    Site* const _previous;
+};
+
+}  // namespace mongo
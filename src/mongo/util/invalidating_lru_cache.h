@@ -28,6 +28,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -358,4 +361,69 @@ private:
     Invalidator _invalidator;
 };
 
+/**
+ * An InvalidatingLRUCache split by the hash of the Key into a fixed number of partitions, each
+ * with its own mutex and an equal share of the capacity, so that concurrent lookups of different
+ * keys rarely contend with each other or with invalidations.
+ *
+ * Invalidations by predicate visit the partitions one at a time, so they are not atomic with
+ * respect to insertions into the partitions not yet visited.
+ */
+template <typename Key, typename Value, typename Invalidator, typename Hasher = std::hash<Key>>
+class PartitionedInvalidatingLRUCache {
+public:
+    using Partition = InvalidatingLRUCache<Key, Value, Invalidator>;
+    using CachedItemInfo = typename Partition::CachedItemInfo;
+
+    PartitionedInvalidatingLRUCache(size_t numPartitions,
+                                    size_t maxCacheSize,
+                                    Invalidator invalidator) {
+        invariant(numPartitions > 0);
+        const size_t maxPartitionSize = (maxCacheSize + numPartitions - 1) / numPartitions;
+        _partitions.reserve(numPartitions);
+        for (size_t i = 0; i < numPartitions; ++i) {
+            _partitions.push_back(std::make_unique<Partition>(maxPartitionSize, invalidator));
+        }
+    }
+
+    void insertOrAssign(const Key& key, std::unique_ptr<Value> value) {
+        _partitionFor(key).insertOrAssign(key, std::move(value));
+    }
+
+    std::shared_ptr<Value> insertOrAssignAndGet(const Key& key, std::unique_ptr<Value> value) {
+        return _partitionFor(key).insertOrAssignAndGet(key, std::move(value));
+    }
+
+    void invalidate(const Key& key) {
+        _partitionFor(key).invalidate(key);
+    }
+
+    template <typename Pred>
+    void invalidateIf(Pred predicate) {
+        for (auto& partition : _partitions) {
+            partition->invalidateIf(predicate);
+        }
+    }
+
+    boost::optional<std::shared_ptr<Value>> get(const Key& key) {
+        return _partitionFor(key).get(key);
+    }
+
+    std::vector<CachedItemInfo> getCacheInfo() const {
+        std::vector<CachedItemInfo> ret;
+        for (const auto& partition : _partitions) {
+            auto partitionInfo = partition->getCacheInfo();
+            std::move(partitionInfo.begin(), partitionInfo.end(), std::back_inserter(ret));
+        }
+        return ret;
+    }
+
+private:
+    Partition& _partitionFor(const Key& key) {
+        return *_partitions[Hasher()(key) % _partitions.size()];
+    }
+
+    std::vector<std::unique_ptr<Partition>> _partitions;
+};
+
 }  // namespace mongo
@@ -186,5 +186,55 @@ TEST(InvalidatingLRUCache, InvalidateIf) {
     ASSERT_EQ(cacheInfo.size(), static_cast<size_t>(cacheSize) - 1);
 }
 
+using PartitionedTestCache = PartitionedInvalidatingLRUCache<int, TestValue, TestValueInvalidator>;
+
+TEST(PartitionedInvalidatingLRUCache, SplitsCapacityAmongPartitions) {
+    constexpr int numPartitions = 4;
+    PartitionedTestCache cache(numPartitions, 2 * numPartitions, TestValueInvalidator{});
+
+    // Keys which differ by a multiple of the number of partitions land in the same partition,
+    // whose share of the capacity is 2.
+    for (int i = 0; i < 3; i++) {
+        cache.insertOrAssign(i * numPartitions, std::make_unique<TestValue>());
+    }
+    ASSERT_FALSE(cache.get(0));
+    ASSERT_TRUE(cache.get(numPartitions));
+    ASSERT_TRUE(cache.get(2 * numPartitions));
+
+    // The other partitions are unaffected.
+    for (int i = 1; i < numPartitions; i++) {
+        cache.insertOrAssign(i, std::make_unique<TestValue>());
+    }
+    for (int i = 1; i < numPartitions; i++) {
+        ASSERT_TRUE(cache.get(i));
+    }
+}
+
+TEST(PartitionedInvalidatingLRUCache, InvalidatesAcrossPartitions) {
+    constexpr int numItems = 10;
+    PartitionedTestCache cache(3, numItems, TestValueInvalidator{});
+
+    for (int i = 0; i < numItems; i++) {
+        cache.insertOrAssign(i, std::make_unique<TestValue>());
+    }
+
+    auto active = cache.get(4);
+    ASSERT_TRUE(active);
+    auto activeVal = std::move(*active);
+    ASSERT_EQ(cache.getCacheInfo().size(), static_cast<size_t>(numItems));
+
+    cache.invalidate(0);
+    ASSERT_FALSE(cache.get(0));
+
+    cache.invalidateIf([](const int& key, const TestValue*) { return key % 2 == 0; });
+    ASSERT_FALSE(activeVal->isValid());
+
+    const auto cacheInfo = cache.getCacheInfo();
+    ASSERT_EQ(cacheInfo.size(), static_cast<size_t>(numItems / 2));
+    for (const auto& info : cacheInfo) {
+        ASSERT_EQ(info.key % 2, 1);
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -207,6 +207,13 @@ public:
         SSLConnectionType ssl,
         const std::string& remoteHost,
         const HostAndPort& hostForLogging) = 0;
+
+    /**
+     * Offers a previously negotiated session for "target" to an outgoing connection that has not
+     * yet begun its handshake, so that the handshake can resume it instead of performing a full
+     * key exchange. Implementations without a client session cache do nothing.
+     */
+    virtual void setupEgressSessionResumption(SSLConnectionType ssl, const HostAndPort& target) {}
 };
 
 // Access SSL functions through this instance.
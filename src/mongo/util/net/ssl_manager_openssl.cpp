@@ -48,6 +48,8 @@
 #include "mongo/db/server_parameters.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/transport/session.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/debug_util.h"
@@ -142,6 +144,99 @@ UniqueBIO makeUniqueMemBio(std::vector<std::uint8_t>& v) {
     return rv;
 }
 
+// Maximum number of TLS sessions remembered for resuming outgoing connections. Zero disables
+// resumption of outgoing sessions.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(opensslEgressSessionCacheSize, int, 1024)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "opensslEgressSessionCacheSize must be greater than or equal to 0");
+        }
+        return Status::OK();
+    });
+
+struct SSLSessionFree {
+    void operator()(SSL_SESSION* const p) noexcept {
+        if (p) {
+            ::SSL_SESSION_free(p);
+        }
+    }
+};
+using UniqueSSLSession = std::unique_ptr<SSL_SESSION, SSLSessionFree>;
+
+/**
+ * Sessions negotiated by outgoing connections, keyed by the SSL_CTX and the remote host they were
+ * negotiated with. When the cache is full an arbitrary entry is evicted to make room.
+ */
+class EgressSessionCache {
+public:
+    /**
+     * Takes ownership of "session", replacing any session previously stored under "key".
+     */
+    void put(const std::string& key, SSL_SESSION* session) {
+        UniqueSSLSession owned(session);
+        UniqueSSLSession evicted;
+
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        auto it = _sessions.find(key);
+        if (it != _sessions.end()) {
+            evicted = std::move(it->second);
+            it->second = std::move(owned);
+            return;
+        }
+
+        const auto capacity = static_cast<size_t>(opensslEgressSessionCacheSize);
+        if (!_sessions.empty() && _sessions.size() >= capacity) {
+            evicted = std::move(_sessions.begin()->second);
+            _sessions.erase(_sessions.begin());
+        }
+        _sessions.emplace(key, std::move(owned));
+    }
+
+    /**
+     * Offers the session stored under "key", if any, to "ssl" for resumption. SSL_set_session
+     * takes its own reference, so the cache keeps the session for later connections.
+     */
+    void offer(SSL* ssl, const std::string& key) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        auto it = _sessions.find(key);
+        if (it != _sessions.end()) {
+            ::SSL_set_session(ssl, it->second.get());
+        }
+    }
+
+private:
+    stdx::mutex _mutex;
+    stdx::unordered_map<std::string, UniqueSSLSession> _sessions;
+};
+
+EgressSessionCache& egressSessionCache() {
+    static auto cache = new EgressSessionCache();
+    return *cache;
+}
+
+void freeEgressSessionKey(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+    delete static_cast<std::string*>(ptr);
+}
+
+// Index of the ex_data slot on an outgoing SSL object that holds its EgressSessionCache key.
+int egressSessionKeyIndex() {
+    static const int index =
+        ::SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, freeEgressSessionKey);
+    return index;
+}
+
+// Invoked by OpenSSL whenever an outgoing connection negotiates a session it may later resume.
+// Returning 1 tells OpenSSL that we have taken ownership of the session.
+int onNewEgressSession(SSL* ssl, SSL_SESSION* session) {
+    const auto key = static_cast<std::string*>(::SSL_get_ex_data(ssl, egressSessionKeyIndex()));
+    if (!key) {
+        return 0;
+    }
+    egressSessionCache().put(*key, session);
+    return 1;
+}
+
 // Old copies of OpenSSL will not have constants to disable protocols they don't support.
 // Define them to values we can OR together safely to generically disable these protocols across
 // all versions of OpenSSL.
@@ -356,6 +451,8 @@ public:
     StatusWith<boost::optional<SSLPeerInfo>> parseAndValidatePeerCertificate(
         SSL* conn, const std::string& remoteHost, const HostAndPort& hostForLogging) final;
 
+    void setupEgressSessionResumption(SSL* ssl, const HostAndPort& target) final;
+
     const SSLConfiguration& getSSLConfiguration() const final {
         return _sslConfiguration;
     }
@@ -756,6 +853,14 @@ Status SSLManagerOpenSSL::initSSLContext(SSL_CTX* context,
                                     << getSSLErrorMessage(ERR_get_error()));
     }
 
+    if (direction == ConnectionDirection::kOutgoing) {
+        // Clients only ever look sessions up by remote host, so keep them in EgressSessionCache
+        // rather than in OpenSSL's internal store, which is keyed by session id.
+        ::SSL_CTX_set_session_cache_mode(context,
+                                         SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        ::SSL_CTX_sess_set_new_cb(context, onNewEgressSession);
+    }
+
     if (direction == ConnectionDirection::kOutgoing && params.tlsWithholdClientCertificate) {
         // Do not send a client certificate if they have been suppressed.
 
@@ -1254,6 +1359,9 @@ SSLConnectionInterface* SSLManagerOpenSSL::connect(Socket* socket) {
     if (ret != 1)
         _handleSSLError(sslConn.get(), ret);
 
+    setupEgressSessionResumption(
+        sslConn->ssl, HostAndPort(socket->remoteAddr().hostOrIp(), socket->remoteAddr().getPort()));
+
     do {
         ret = ::SSL_connect(sslConn->ssl);
     } while (!_doneWithSSLOp(sslConn.get(), ret));
@@ -1264,6 +1372,20 @@ SSLConnectionInterface* SSLManagerOpenSSL::connect(Socket* socket) {
     return sslConn.release();
 }
 
+void SSLManagerOpenSSL::setupEgressSessionResumption(SSL* ssl, const HostAndPort& target) {
+    if (opensslEgressSessionCacheSize == 0) {
+        return;
+    }
+
+    // Sessions are only resumable through the context that negotiated them.
+    auto key = stdx::make_unique<std::string>(
+        str::stream() << static_cast<const void*>(::SSL_get_SSL_CTX(ssl)) << '/' << target);
+    egressSessionCache().offer(ssl, *key);
+    if (::SSL_set_ex_data(ssl, egressSessionKeyIndex(), key.get()) == 1) {
+        key.release();
+    }
+}
+
 SSLConnectionInterface* SSLManagerOpenSSL::accept(Socket* socket,
                                                   const char* initialBytes,
                                                   int len) {
@@ -57,6 +57,18 @@ public:
         _addend += x;                                  // Store away lowest part of sum
     }
 
+    /**
+     * Adds each of the 'count' doubles starting at 'x', in order. The result is identical to
+     * calling addDouble() on each of them, but the running sum stays in registers for the loop.
+     */
+    void addDoubles(const double* x, size_t count) {
+        DoubleDoubleSummation sum = *this;
+        for (size_t i = 0; i < count; ++i) {
+            sum.addDouble(x[i]);
+        }
+        *this = sum;
+    }
+
     /**
      * Adds x to internal sum. Extra precision guarantees that sum is exact, unless intermediate
      * sums exceed a magnitude of 2**106.
@@ -73,6 +73,7 @@ class UUID {
     friend class repl::OplogEntryBase;
     friend class repl::ReplOperation;
     friend class ResumeTokenInternal;
+    friend class ShardsvrReshardingCriticalSection;
 
 public:
     /**